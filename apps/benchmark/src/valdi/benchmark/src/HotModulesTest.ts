@@ -0,0 +1,38 @@
+import { now } from './cpp';
+import { layoutMasonryGrid } from './hot/LayoutHelpers';
+import { diffKeyedLists } from './hot/ListDiff';
+
+const ITEMS_COUNT = 1000;
+const ITERATIONS = 200;
+
+function makeKeys(count: number, offset: number): string[] {
+  const keys: string[] = [];
+  for (let i = 0; i < count; i++) {
+    keys.push(`item_${(i * 7 + offset) % count}`);
+  }
+  return keys;
+}
+
+function measure(iterations: number, body: () => void): number {
+  const start = now();
+  for (let i = 0; i < iterations; i++) {
+    body();
+  }
+  return (now() - start) / iterations;
+}
+
+/**
+ * Measure the modules under src/hot, which are compiled to native code when TSN is enabled.
+ * Run it with TSN enabled and disabled, and with each JS engine, to compare them.
+ */
+export function runHotModules(print: (s: string) => void): void {
+  const previousKeys = makeKeys(ITEMS_COUNT, 0);
+  const nextKeys = makeKeys(ITEMS_COUNT, 3).slice(ITEMS_COUNT / 10);
+  const itemHeights = previousKeys.map((_, i) => 40 + ((i * 13) % 120));
+
+  const diffTime = measure(ITERATIONS, () => diffKeyedLists(previousKeys, nextKeys));
+  const layoutTime = measure(ITERATIONS, () => layoutMasonryGrid(itemHeights, 3, 375, 8));
+
+  print(`List diff of ${ITEMS_COUNT} items: ${diffTime.toFixed(3)} ms`);
+  print(`Masonry layout of ${ITEMS_COUNT} items: ${layoutTime.toFixed(3)} ms`);
+}
@@ -0,0 +1,39 @@
+export interface ItemFrame {
+  x: number;
+  y: number;
+  width: number;
+  height: number;
+}
+
+/**
+ * Lay out items of the given heights in a grid with the given number of columns,
+ * placing each item in the shortest column.
+ */
+export function layoutMasonryGrid(
+  itemHeights: readonly number[],
+  columns: number,
+  width: number,
+  spacing: number,
+): ItemFrame[] {
+  const columnWidth = (width - spacing * (columns - 1)) / columns;
+  const columnHeights: number[] = [];
+  for (let i = 0; i < columns; i++) {
+    columnHeights.push(0);
+  }
+
+  const frames: ItemFrame[] = [];
+  for (const height of itemHeights) {
+    let column = 0;
+    for (let i = 1; i < columns; i++) {
+      if (columnHeights[i] < columnHeights[column]) {
+        column = i;
+      }
+    }
+
+    const y = columnHeights[column];
+    frames.push({ x: column * (columnWidth + spacing), y, width: columnWidth, height });
+    columnHeights[column] = y + height + spacing;
+  }
+
+  return frames;
+}
@@ -0,0 +1,53 @@
+export const enum ListChangeType {
+  Insert,
+  Remove,
+  Move,
+}
+
+export interface ListChange {
+  type: ListChangeType;
+  key: string;
+  index: number;
+}
+
+/**
+ * Compute the changes to apply on a list of keys to turn it into the next list of keys,
+ * the same way a list view reconciles its items.
+ */
+export function diffKeyedLists(previousKeys: readonly string[], nextKeys: readonly string[]): ListChange[] {
+  const changes: ListChange[] = [];
+  const nextIndexes = new Map<string, number>();
+  for (let i = 0; i < nextKeys.length; i++) {
+    nextIndexes.set(nextKeys[i], i);
+  }
+
+  const retainedKeys: string[] = [];
+  for (let i = 0; i < previousKeys.length; i++) {
+    const key = previousKeys[i];
+    if (nextIndexes.has(key)) {
+      retainedKeys.push(key);
+    } else {
+      changes.push({ type: ListChangeType.Remove, key, index: i });
+    }
+  }
+
+  const previousIndexes = new Map<string, number>();
+  for (let i = 0; i < retainedKeys.length; i++) {
+    previousIndexes.set(retainedKeys[i], i);
+  }
+
+  let retainedIndex = 0;
+  for (let i = 0; i < nextKeys.length; i++) {
+    const key = nextKeys[i];
+    const previousIndex = previousIndexes.get(key);
+    if (previousIndex === undefined) {
+      changes.push({ type: ListChangeType.Insert, key, index: i });
+    } else if (previousIndex !== retainedIndex) {
+      changes.push({ type: ListChangeType.Move, key, index: i });
+    } else {
+      retainedIndex++;
+    }
+  }
+
+  return changes;
+}
@@ -1,5 +1,6 @@
 import { question, print } from './cpp';
 import { runProtoImport } from './ProtoImportTest';
+import { runHotModules } from './HotModulesTest';
 
 import { RequireFunc } from 'valdi_core/src/IModuleLoader';
 declare const require: RequireFunc;
@@ -25,6 +26,12 @@ const tests = [
       print(`Proto (noindex) imported in ${importTimeNoIndex} ms`);
     },
   },
+  {
+    name: 'Hot Modules',
+    body: () => {
+      runHotModules(print);
+    },
+  },
 ];
 
 function readChoice(): string {
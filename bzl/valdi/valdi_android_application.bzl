@@ -96,6 +96,8 @@ def valdi_android_application(
         custom_package = package,
         manifest = resolved_app_manifest,
         multidex = "native",
+        # Keeping the Valdi modules uncompressed lets the runtime map them directly from the APK
+        nocompress_extensions = [".valdimodule"],
         assets = assets,
         assets_dir = assets_dir,
         resource_files = resource_files,
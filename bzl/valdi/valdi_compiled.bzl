@@ -280,6 +280,9 @@ valdi_compiled = rule(
         "exclude_globs": attr.string_list(
             doc = "Exclude files that match the listed globs",
         ),
+        "native_compilation_patterns": attr.string_list(
+            doc = "Compile the files that match the listed patterns to native code, regardless of the compilation mode",
+        ),
         # NOTE: Valdi base should probably be moved to its own directory
         "_valdi_base": attr.label(
             doc = "The base module that all Valdi modules depend on",
@@ -1179,14 +1182,14 @@ disable_dependency_verification: {disable_dependency_verification}
 {exclude_patterns}
 {exclude_globs}
 
-compilation_mode: {compilation_mode}
+{compilation_mode}
   """.format(
         name = name,
         ios_output_target = attr.ios_output_target,
         ios_module_name = attr.ios_module_name,
         android_output_target = attr.android_output_target,
         android_export_strings = "true" if attr.android_export_strings else "false",
-        compilation_mode = attr.compilation_mode,
+        compilation_mode = _yaml_compilation_mode(attr.compilation_mode, attr.native_compilation_patterns),
         single_file_codegen = "true" if attr.single_file_codegen else "false",
         disable_code_coverage = "true" if attr.disable_code_coverage else "false",
         disable_hotreload = "true" if attr.disable_hotreload else "false",
@@ -1211,6 +1214,22 @@ def _yaml_named_list(name, items):
 
     return "{name}:\n{list}".format(name = name, list = list)
 
+def _yaml_compilation_mode(compilation_mode, native_compilation_patterns):
+    if not native_compilation_patterns or compilation_mode == "native":
+        return "compilation_mode: {}".format(compilation_mode)
+
+    # Files are compiled natively if they match one of the native patterns,
+    # and use the compilation mode of the module otherwise
+    native_patterns = "\n".join(["      - '{}'".format(pattern.replace("'", "''")) for pattern in native_compilation_patterns])
+
+    return """compilation_mode:
+  {compilation_mode}:
+    include_patterns:
+      - '.*'
+  native:
+    include_patterns:
+{native_patterns}""".format(compilation_mode = compilation_mode, native_patterns = native_patterns)
+
 def _resolve_module_yaml(ctx, module_name):
     module_definition = _generate_module_definition(ctx, module_name)
 
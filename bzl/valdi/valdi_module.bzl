@@ -80,6 +80,7 @@ def valdi_module(
         web_deps = [],
         exclude_patterns = None,
         exclude_globs = None,
+        native_compilation_patterns = None,
         **kwargs):
     """ A convenient macro to wrap valdi_compiled rule. Use this macro instead of direct valdi_compiled rule invocation.
 
@@ -123,6 +124,8 @@ def valdi_module(
         ios_language: The language of the iOS target: "objc", "swift" or "objc, swift".
         exclude_patterns: file patterns to exclude from the module
         exclude_globs: glob patterns to exclude from the module
+        native_compilation_patterns: file patterns to compile to native code with TSN regardless of the compilation_mode,
+            typically for the hot modules of a module which uses "js_bytecode"
         **kwargs: Additional keyword arguments.
     """
     downloadable_assets = True if downloadable_assets == None else downloadable_assets
@@ -193,6 +196,7 @@ def valdi_module(
         disable_hotreload = disable_hotreload,
         exclude_patterns = exclude_patterns,
         exclude_globs = exclude_globs,
+        native_compilation_patterns = native_compilation_patterns,
         **kwargs
     )
 
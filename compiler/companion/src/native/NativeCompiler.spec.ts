@@ -3700,6 +3700,21 @@ function_end @1
     expect(c_code.includes('tsn_op_eq')).toBeFalsy();
   });
 
+  it('uses inline caches for property sets', () => {
+    const c_code = compileAsC(
+      `
+      function foo(o: any, v: number): void {
+        o.x = v;
+      }
+      `,
+      { optimizeSlots: true, optimizeVarRefs: true, inlinePropertyCache: true },
+      'foo',
+      undefined,
+    );
+    expect(c_code.includes('tsn_set_property_ic')).toBeTruthy();
+    expect(c_code.includes('module->setprop_cache + 0')).toBeTruthy();
+  });
+
   it('optimize boolean conditions', () => {
     const c_code = compileAsC(
       `
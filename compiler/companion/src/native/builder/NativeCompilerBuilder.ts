@@ -375,6 +375,7 @@ export class NativeCompilerBlockBuilder implements INativeCompilerBlockBuilder {
       object: object,
       properties: [property],
       values: [value],
+      setPropCacheSlot: 0,
     };
     this.ir.push(ir);
   }
@@ -393,6 +394,7 @@ export class NativeCompilerBlockBuilder implements INativeCompilerBlockBuilder {
       object: object,
       properties: properties,
       values: values,
+      setPropCacheSlot: 0,
     };
     this.ir.push(ir);
   }
@@ -1689,6 +1691,7 @@ export class NativeCompilerModuleBuilder {
   private functionBuilders = new Array<NativeCompilerFunctionBuilder>();
   private functionIdSequence = 0;
   private propCacheSlots = 0;
+  private setPropCacheSlots = 0;
 
   constructor(private moduleName: string, private modulePath: string) {
     this.moduleInitBuilder = new NativeCompilerInitModuleBuilder();
@@ -1749,7 +1752,8 @@ export class NativeCompilerModuleBuilder {
     };
   }
 
-  // go through the IR sequence and allocate a slot number for each get_property call
+  // go through the IR sequence and allocate a slot number for each get_property call,
+  // and for each set_property call which sets a single property
   private assignPropertyCacheSlots(irs: NativeCompilerIR.Base[]) {
     for (let i = 0; i < irs.length; ++i) {
       const ir = irs[i];
@@ -1761,6 +1765,12 @@ export class NativeCompilerModuleBuilder {
         const typedIR = ir as NativeCompilerIR.GetProperty;
         const newIR = { ...typedIR, propCacheSlot: this.propCacheSlots++ };
         irs[i] = newIR;
+      } else if (ir.kind === NativeCompilerIR.Kind.SetProperty) {
+        const typedIR = ir as NativeCompilerIR.SetProperty;
+        if (typedIR.properties.length === 1) {
+          const newIR = { ...typedIR, setPropCacheSlot: this.setPropCacheSlots++ };
+          irs[i] = newIR;
+        }
       }
     }
   }
@@ -1789,6 +1799,7 @@ export class NativeCompilerModuleBuilder {
       atoms: this.moduleInitBuilder.atoms,
       stringConstants: this.moduleInitBuilder.stringConstants,
       propCacheSlots: this.propCacheSlots,
+      setPropCacheSlots: this.setPropCacheSlots,
     };
 
     retval.push(epilogue);
@@ -240,6 +240,7 @@ export namespace NativeCompilerIR {
     readonly object: NativeCompilerBuilderVariableID;
     readonly properties: NativeCompilerBuilderAtomID[];
     readonly values: NativeCompilerBuilderVariableID[];
+    readonly setPropCacheSlot: number;
   }
 
   export interface SetPropertyValue extends BaseWithExceptionTarget {
@@ -594,6 +595,7 @@ export namespace NativeCompilerIR {
     readonly atoms: readonly NativeCompilerBuilderAtomID[];
     readonly stringConstants: readonly string[];
     readonly propCacheSlots: number;
+    readonly setPropCacheSlots: number;
   }
 
   export interface BoilerplatePrologue extends Base {
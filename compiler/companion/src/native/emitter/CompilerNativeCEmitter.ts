@@ -181,6 +181,7 @@ export class CompilerNativeCEmitter implements INativeCompilerIREmitter {
     atoms: readonly NativeCompilerBuilderAtomID[],
     stringConstants: readonly string[],
     propCacheSlots: number,
+    setPropCacheSlots: number,
   ) {
     this.writer.appendWithNewLine(`\n // BEGIN MODULE DEFINITION '${moduleName}'`);
     this.writer.append(`static const tsn_string_def ${moduleName}_module_atoms[] = `);
@@ -215,6 +216,7 @@ export class CompilerNativeCEmitter implements INativeCompilerIREmitter {
       atoms.length.toString(),
       stringConstants.length.toString(),
       propCacheSlots.toString(),
+      setPropCacheSlots.toString(),
     ]);
 
     this.writer.appendFunctionCall('tsn_assign_module_atoms', [
@@ -537,9 +539,22 @@ export class CompilerNativeCEmitter implements INativeCompilerIREmitter {
     object: NativeCompilerBuilderVariableID,
     properties: NativeCompilerBuilderAtomID[],
     values: NativeCompilerBuilderVariableID[],
+    setPropCacheSlot: number,
     exceptionTarget: NativeCompilerBuilderJumpTargetID,
   ) {
-    if (properties.length == 1) {
+    if (properties.length == 1 && this.options.inlinePropertyCache) {
+      this.appendCheckedFunctionCall(
+        'tsn_set_property_ic',
+        [
+          getNativeCompilerFunctionArgToString(NativeCompilerIR.FunctionTypeArgs.Context),
+          '&' + this.getVariableName(object),
+          this.resolveAtomString(properties[0]),
+          '&' + this.getVariableName(values[0]),
+          `module->setprop_cache + ${setPropCacheSlot}`,
+        ],
+        exceptionTarget,
+      );
+    } else if (properties.length == 1) {
       this.appendCheckedFunctionCall(
         'tsn_set_property',
         [
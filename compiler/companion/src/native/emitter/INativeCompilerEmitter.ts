@@ -15,6 +15,7 @@ export interface INativeCompilerIREmitter {
     atoms: readonly NativeCompilerBuilderAtomID[],
     stringConstants: readonly string[],
     propCacheSlots: number,
+    setPropCacheSlots: number,
   ): void;
 
   emitStartFunction(
@@ -50,6 +51,7 @@ export interface INativeCompilerIREmitter {
     object: NativeCompilerBuilderVariableID,
     properties: NativeCompilerBuilderAtomID[],
     valuees: NativeCompilerBuilderVariableID[],
+    setPropCacheSlot: number,
     exceptionTarget: NativeCompilerBuilderJumpTargetID,
   ): void;
 
@@ -376,6 +378,7 @@ export function emitterWalk(emitter: INativeCompilerIREmitter, ir: Array<NativeC
           ir.atoms,
           ir.stringConstants,
           ir.propCacheSlots,
+          ir.setPropCacheSlots,
         );
         break;
       }
@@ -431,7 +434,7 @@ export function emitterWalk(emitter: INativeCompilerIREmitter, ir: Array<NativeC
       }
       case NativeCompilerIR.Kind.SetProperty: {
         const ir = ir_ as NativeCompilerIR.SetProperty;
-        emitter.emitSetProperty(ir.object, ir.properties, ir.values, ir.exceptionTarget);
+        emitter.emitSetProperty(ir.object, ir.properties, ir.values, ir.setPropCacheSlot, ir.exceptionTarget);
         break;
       }
       case NativeCompilerIR.Kind.SetPropertyValue: {
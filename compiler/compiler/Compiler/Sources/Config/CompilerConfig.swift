@@ -76,6 +76,14 @@ struct CompilerConfig {
     /// Whether to output for release, debug or both
     let outputTarget: OutputTarget
 
+    /// When set, .valdimodule files are written as seekable archives whose entries are compressed individually,
+    /// instead of being compressed as a whole
+    let outputSeekableModules: Bool
+
+    /// When set, the entries of seekable modules are compressed with this dictionary, which the app
+    /// should ship as its valdi.zstddict resource
+    let zstdDictionary: ZstdDictionary?
+
     static func from(args: ValdiCompilerArguments, baseURL: URL, environment: [String: String]) throws -> CompilerConfig {
         let hotReloadingEnabled = args.monitor
 
@@ -99,6 +107,10 @@ struct CompilerConfig {
                 return try parsed.resolvingVariables(environment)
             }
 
+        let zstdDictionary = try args.zstdDictionary.map {
+            try ZstdDictionary(data: try File.url(baseURL.appendingPathComponent($0)).readData())
+        }
+
         return CompilerConfig(
             hotReloadingEnabled: hotReloadingEnabled,
             disableDiskCache: disableDiskCache,
@@ -122,7 +134,9 @@ struct CompilerConfig {
             outputForAndroid: args.android,
             outputForWeb: args.web,
             outputForCpp: args.cpp,
-            outputTarget: args.outputTarget ?? OutputTarget.all
+            outputTarget: args.outputTarget ?? OutputTarget.all,
+            outputSeekableModules: args.seekableModules,
+            zstdDictionary: zstdDictionary
         )
     }
 }
@@ -83,29 +83,48 @@ final class ImageConverter {
                     ])
     }
 
+    struct ImageConversionOutput {
+        let outputFileURL: URL
+        let conversionInfo: ImageConversionInfo
+    }
+
     public func convert(imageInfo: ImageInfo, filePath: String, outputFileURL: URL, conversionInfo: ImageConversionInfo) throws -> ImageInfo {
-        if conversionInfo.outputSize != conversionInfo.renderSize {
-            logger.warn("Image conversion outputSize doesn't match renderSize: \(filePath) -> \(outputFileURL.path)\nThis usually means that the original image is not divisible by its display scale (e.g. @3x image with the size of 62x47).")
-        }
+        return try convert(imageInfo: imageInfo, filePath: filePath, outputs: [ImageConversionOutput(outputFileURL: outputFileURL, conversionInfo: conversionInfo)])[0]
+    }
+
+    /// Converts the image into all the given outputs at once, so that the source image is only decoded once.
+    func convert(imageInfo: ImageInfo, filePath: String, outputs: [ImageConversionOutput]) throws -> [ImageInfo] {
+        var toolboxOutputs = [ToolboxExecutable.ImageConversionOutput]()
 
-        try fileManager.createDirectory(at: outputFileURL.deletingLastPathComponent())
+        for output in outputs {
+            let outputFileURL = output.outputFileURL
+            let conversionInfo = output.conversionInfo
 
-        var qualityRatio: Double?
-        if outputFileURL.pathExtension == "webp" {
-            // matching the default quality value previously used by cwebp
-            qualityRatio = 0.75
+            if conversionInfo.outputSize != conversionInfo.renderSize {
+                logger.warn("Image conversion outputSize doesn't match renderSize: \(filePath) -> \(outputFileURL.path)\nThis usually means that the original image is not divisible by its display scale (e.g. @3x image with the size of 62x47).")
+            }
+
+            try fileManager.createDirectory(at: outputFileURL.deletingLastPathComponent())
+
+            var qualityRatio: Double?
+            if outputFileURL.pathExtension == "webp" {
+                // matching the default quality value previously used by cwebp
+                qualityRatio = 0.75
+            }
+
+            toolboxOutputs.append(ToolboxExecutable.ImageConversionOutput(outputFilePath: outputFileURL.path,
+                                                                          outputWidth: conversionInfo.outputSize.width,
+                                                                          outputHeight: conversionInfo.outputSize.height,
+                                                                          qualityRatio: qualityRatio))
         }
-        try imageToolbox.convert(inputPath: filePath,
-                                 outputPath: outputFileURL.path,
-                                 outputWidth: conversionInfo.outputSize.width,
-                                 outputHeight: conversionInfo.outputSize.height,
-                                 qualityRatio: qualityRatio)
-
-        if outputFileURL.pathExtension == "png" {
-            try optimizePNG(outputFileURL: outputFileURL)
+
+        try imageToolbox.convert(inputPath: filePath, outputs: toolboxOutputs)
+
+        for output in outputs where output.outputFileURL.pathExtension == "png" {
+            try optimizePNG(outputFileURL: output.outputFileURL)
         }
 
-        return ImageInfo(size: conversionInfo.outputSize)
+        return outputs.map { ImageInfo(size: $0.conversionInfo.outputSize) }
     }
 
     private func run(logger: ILogger, command: [String]) throws -> String {
@@ -23,6 +23,10 @@ class ImageToolbox {
                                            qualityRatio: qualityRatio)
     }
 
+    func convert(inputPath: String, outputs: [ToolboxExecutable.ImageConversionOutput]) throws {
+        try toolboxExecutable.convertImage(inputFilePath: inputPath, outputs: outputs)
+    }
+
     func getInfo(inputPath: String) throws -> ToolboxExecutable.ImageInfoOutput {
         return try toolboxExecutable.getImageInfo(inputFilePath: inputPath)
     }
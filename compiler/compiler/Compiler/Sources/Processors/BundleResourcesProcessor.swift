@@ -144,13 +144,26 @@ class BundleResourcesProcessor: CompilationProcessor {
 
             let data = try moduleBuilder.build()
 
-            let cacheKey = getCacheKey(moduleName)
+            let outputSeekableModules = compilerConfig.outputSeekableModules
+            let zstdDictionary = outputSeekableModules ? compilerConfig.zstdDictionary : nil
+            var cacheKey = outputSeekableModules ? getCacheKey(moduleName) + ".seekable" : getCacheKey(moduleName)
+            if let zstdDictionary {
+                cacheKey += ".\(zstdDictionary.id)"
+            }
 
             if let cachedCompressed = diskCache?.getOutput(item: cacheKey, platform: platform, target: target, inputData: data) {
                 return cachedCompressed
             }
 
-            let compressedData = try ValdiModuleBuilder.compress(data: data)
+            let compressedData: Data
+            if outputSeekableModules {
+                // Entries are compressed individually so that they can be decompressed on demand
+                moduleBuilder.compress = true
+                moduleBuilder.dictionary = zstdDictionary
+                compressedData = try moduleBuilder.buildSeekable()
+            } else {
+                compressedData = try ValdiModuleBuilder.compress(data: data)
+            }
             try diskCache?.setOutput(item: cacheKey, platform: platform, target: target, inputData: data, outputData: compressedData)
 
             return compressedData
@@ -88,36 +88,65 @@ class ImageResourcesProcessor: CompilationProcessor {
         return outputData
     }
 
-    private func generateImage(fromImageAssetVariant: ImageAssetVariant, sourceItemProjectPath: String, inputImageURL: URL, inputImageData: Data, variantSpecs: ImageVariantSpecs) throws -> ImageAssetVariant {
-        let diskCache = try getDiskCache(forExtension: variantSpecs.fileExtension)
+    private struct PendingImageVariant {
+        let index: Int
+        let variantSpecs: ImageVariantSpecs
+        let cacheKey: String
+        let diskCache: DiskCache?
+        let output: ImageConverter.ImageConversionOutput
+    }
+
+    private func generateImages(fromImageAssetVariant: ImageAssetVariant, sourceItemProjectPath: String, inputImageURL: URL, inputImageData: Data, variantsSpecs: [ImageVariantSpecs]) throws -> [ImageAssetVariant] {
+        var generatedImages = [ImageAssetVariant?](repeating: nil, count: variantsSpecs.count)
+        var pendingVariants = [PendingImageVariant]()
+
+        defer {
+            for pendingVariant in pendingVariants {
+                _ = try? FileManager.default.removeItem(at: pendingVariant.output.outputFileURL)
+            }
+        }
+
+        for (index, variantSpecs) in variantsSpecs.enumerated() {
+            let diskCache = try getDiskCache(forExtension: variantSpecs.fileExtension)
 
-        let cacheKey = "\(variantSpecs.identifier)/\(sourceItemProjectPath)"
+            let cacheKey = "\(variantSpecs.identifier)/\(sourceItemProjectPath)"
 
-        let conversionInfo = imageConverter.getConversionInfo(sourceImage: fromImageAssetVariant, targetVariantSpecs: variantSpecs)
-        let outputImageInfo = ImageInfo(size: conversionInfo.outputSize)
+            let conversionInfo = imageConverter.getConversionInfo(sourceImage: fromImageAssetVariant, targetVariantSpecs: variantSpecs)
+            let outputImageInfo = ImageInfo(size: conversionInfo.outputSize)
 
-        if let diskCache = diskCache {
-            if let cachedImage = getGeneratedImageFromCache(cacheKey: cacheKey, inputImageData: inputImageData, cache: diskCache) {
-                logger.verbose("-- Using cached generated image from \(sourceItemProjectPath) with variant \(variantSpecs.identifier)")
+            if let diskCache = diskCache {
+                if let cachedImage = getGeneratedImageFromCache(cacheKey: cacheKey, inputImageData: inputImageData, cache: diskCache) {
+                    logger.verbose("-- Using cached generated image from \(sourceItemProjectPath) with variant \(variantSpecs.identifier)")
 
-                return ImageAssetVariant(imageInfo: outputImageInfo, file: .data(cachedImage), variantSpecs: variantSpecs)
+                    generatedImages[index] = ImageAssetVariant(imageInfo: outputImageInfo, file: .data(cachedImage), variantSpecs: variantSpecs)
+                    continue
+                }
             }
-        }
 
-        logger.debug("-- Generating image from \(sourceItemProjectPath) into variant \(variantSpecs.identifier)")
+            logger.debug("-- Generating image from \(sourceItemProjectPath) into variant \(variantSpecs.identifier)")
 
-        let outputFileURL = URL.randomFileURL(extension: variantSpecs.fileExtension)
-        defer {
-            _ = try? FileManager.default.removeItem(at: outputFileURL)
+            let outputFileURL = URL.randomFileURL(extension: variantSpecs.fileExtension)
+            pendingVariants.append(PendingImageVariant(index: index,
+                                                       variantSpecs: variantSpecs,
+                                                       cacheKey: cacheKey,
+                                                       diskCache: diskCache,
+                                                       output: ImageConverter.ImageConversionOutput(outputFileURL: outputFileURL, conversionInfo: conversionInfo)))
         }
 
-        let resultImageInfo = try imageConverter.convert(imageInfo: fromImageAssetVariant.imageInfo, filePath: inputImageURL.path, outputFileURL: outputFileURL, conversionInfo: conversionInfo)
+        if !pendingVariants.isEmpty {
+            // All the missing variants are generated at once, so that the source image is only decoded once
+            let resultImageInfos = try imageConverter.convert(imageInfo: fromImageAssetVariant.imageInfo, filePath: inputImageURL.path, outputs: pendingVariants.map { $0.output })
 
-        let outputData = try File.url(outputFileURL).readData()
+            for (pendingVariant, resultImageInfo) in zip(pendingVariants, resultImageInfos) {
+                let outputData = try File.url(pendingVariant.output.outputFileURL).readData()
 
-        try diskCache?.setOutput(item: cacheKey, inputData: inputImageData, outputData: outputData)
+                try pendingVariant.diskCache?.setOutput(item: pendingVariant.cacheKey, inputData: inputImageData, outputData: outputData)
+
+                generatedImages[pendingVariant.index] = ImageAssetVariant(imageInfo: resultImageInfo, file: .data(outputData), variantSpecs: pendingVariant.variantSpecs)
+            }
+        }
 
-        return ImageAssetVariant(imageInfo: resultImageInfo, file: .data(outputData), variantSpecs: variantSpecs)
+        return generatedImages.compactMap { $0 }
     }
 
     private func shouldInclude(variantSpecs: ImageVariantSpecs) -> Bool {
@@ -182,7 +211,7 @@ class ImageResourcesProcessor: CompilationProcessor {
             return try inputImage.withURL { url in
                 // Step 3: Generate all the missing variants
 
-                let generatedImages = try missingVariants.map { try generateImage(fromImageAssetVariant: bestVariant, sourceItemProjectPath: item.item.relativeProjectPath, inputImageURL: url, inputImageData: try inputImage.readData(), variantSpecs: $0) }
+                let generatedImages = try generateImages(fromImageAssetVariant: bestVariant, sourceItemProjectPath: item.item.relativeProjectPath, inputImageURL: url, inputImageData: try inputImage.readData(), variantsSpecs: missingVariants)
 
                 let allVariants = (item.data.variants + generatedImages).filter { variant in
                     return shouldInclude(variantSpecs: variant.variantSpecs)
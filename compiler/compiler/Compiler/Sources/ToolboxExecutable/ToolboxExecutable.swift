@@ -50,19 +50,50 @@ class ToolboxExecutable {
         return try ImageInfoOutput.fromJSON(try output.utf8Data(), keyDecodingStrategy: .convertFromSnakeCase)
     }
 
+    struct ImageConversionOutput {
+        var outputFilePath: String
+        var outputWidth: Int?
+        var outputHeight: Int?
+        var qualityRatio: Double?
+    }
+
     func convertImage(inputFilePath: String, outputFilePath: String, outputWidth: Int?, outputHeight: Int?, qualityRatio: Double?) throws {
-        var arguments = ["image_convert", "-i", inputFilePath, "-o", outputFilePath]
+        try convertImage(inputFilePath: inputFilePath, outputs: [
+            ImageConversionOutput(outputFilePath: outputFilePath, outputWidth: outputWidth, outputHeight: outputHeight, qualityRatio: qualityRatio)
+        ])
+    }
 
-        if let outputWidth = outputWidth {
-            arguments += ["-w", String(outputWidth)]
-        }
+    /// Converts the input image into all the given outputs with a single invocation of the toolbox,
+    /// which decodes the input once and produces the outputs in parallel.
+    func convertImage(inputFilePath: String, outputs: [ImageConversionOutput]) throws {
+        guard !outputs.isEmpty else { return }
+
+        var arguments = ["image_convert", "-i", inputFilePath]
+        // Per output arguments must be given for all the outputs, or not at all
+        let hasWidth = outputs.contains { $0.outputWidth != nil }
+        let hasHeight = outputs.contains { $0.outputHeight != nil }
+        let hasQualityRatio = outputs.contains { $0.qualityRatio != nil }
+
+        for output in outputs {
+            arguments += ["-o", output.outputFilePath]
+
+            if hasWidth {
+                guard let outputWidth = output.outputWidth else {
+                    throw CompilerError("Either all or none of the image outputs should have a width")
+                }
+                arguments += ["-w", String(outputWidth)]
+            }
 
-        if let outputHeight = outputHeight {
-            arguments += ["-h", String(outputHeight)]
-        }
+            if hasHeight {
+                guard let outputHeight = output.outputHeight else {
+                    throw CompilerError("Either all or none of the image outputs should have a height")
+                }
+                arguments += ["-h", String(outputHeight)]
+            }
 
-        if let qualityRatio = qualityRatio {
-            arguments += ["-q", String(qualityRatio)]
+            if hasQualityRatio {
+                arguments += ["-q", String(output.qualityRatio ?? 1.0)]
+            }
         }
 
         let output = try run(arguments: arguments)
@@ -45,6 +45,8 @@ class ValdiModuleBuilder {
 
     private let items: [ZippableItem]
     var compress = true
+    /// When set, the entries of seekable archives are compressed with this dictionary
+    var dictionary: ZstdDictionary?
 
     init(items: [ZippableItem]) {
         self.items = items
@@ -90,7 +92,136 @@ class ValdiModuleBuilder {
         return try ZstdCompressor.compress(data: data)
     }
 
-    static func unpack(module: Data) throws -> [ZippableItem] {
+    /// Builds the module as a seekable archive: an index of the entries followed by their data,
+    /// in which every entry is compressed on its own. This lets the runtime map the module in memory
+    /// and only decompress the entries that it uses.
+    /// Layout, all integers being UInt32:
+    /// magic | dictionary id | entries count | per entry: path length, path padded to 4 bytes, flags, data offset,
+    /// stored size, size | data
+    /// The dictionary id is 0 when the entries were compressed without a dictionary.
+    func buildSeekable() throws -> Data {
+        let sortedItems = items.sorted { (left, right) -> Bool in
+            return left.path > right.path
+        }
+
+        var filenames = [Data]()
+        var storedEntries = [(data: Data, isCompressed: Bool, size: Int)]()
+        var indexSize = 12
+
+        for item in sortedItems {
+            guard !item.path.hasPrefix("../") else {
+                throw CompilerError("Invalid path for entry '\(item.path)'")
+            }
+
+            let filename = try item.path.utf8Data()
+            let fileData = try item.file.readData()
+
+            var compressedData: Data?
+            if self.compress {
+                if let dictionary {
+                    compressedData = try ZstdCompressor.compress(data: fileData, dictionary: dictionary)
+                } else {
+                    compressedData = try ZstdCompressor.compress(data: fileData)
+                }
+            }
+            // Entries which do not compress well, like images, are stored as is
+            if let compressedData, compressedData.count < fileData.count {
+                storedEntries.append((data: compressedData, isCompressed: true, size: fileData.count))
+            } else {
+                storedEntries.append((data: fileData, isCompressed: false, size: fileData.count))
+            }
+
+            filenames.append(filename)
+            indexSize += 4 + filename.count + Int(Data.computePadding(size: UInt32(filename.count))) + 16
+        }
+
+        var out = Data()
+        out.append(Magic.valdiSeekableMagic)
+        out.append(integer: dictionary?.id ?? 0)
+        out.append(integer: UInt32(storedEntries.count))
+
+        var dataOffset = indexSize
+        for (filename, storedEntry) in zip(filenames, storedEntries) {
+            out.append(integer: UInt32(filename.count))
+            out.append(filename)
+            out.append(Data(count: Int(Data.computePadding(size: UInt32(filename.count)))))
+
+            out.append(integer: storedEntry.isCompressed ? ValdiModuleBuilder.seekableEntryFlagCompressed : 0)
+            out.append(integer: UInt32(dataOffset))
+            out.append(integer: UInt32(storedEntry.data.count))
+            out.append(integer: UInt32(storedEntry.size))
+
+            dataOffset += storedEntry.data.count + Int(Data.computePadding(size: UInt32(storedEntry.data.count)))
+        }
+
+        for storedEntry in storedEntries {
+            out.append(storedEntry.data)
+            out.append(Data(count: Int(Data.computePadding(size: UInt32(storedEntry.data.count)))))
+        }
+
+        return out
+    }
+
+    private static let seekableEntryFlagCompressed: UInt32 = 1
+
+    private static func unpackSeekable(module: Data, dictionary: ZstdDictionary?) throws -> [ZippableItem] {
+        let parser = Parser(sequence: module)
+
+        guard try parser.parse(subsequence: Magic.valdiSeekableMagic) else {
+            throw CompilerError("Did not find valdi seekable magic in module")
+        }
+
+        let dictionaryId = try parser.parseInt()
+        if dictionaryId != 0 && dictionaryId != dictionary?.id {
+            throw CompilerError("Module was compressed with zstd dictionary \(dictionaryId), which was not provided")
+        }
+
+        let entriesCount = try parser.parseInt()
+
+        var out = [ZippableItem]()
+
+        for _ in 0..<entriesCount {
+            let filenameLength = try parser.parseInt()
+            let filenameData = try parser.subsequence(length: Int(filenameLength))
+            let padding = Int(Data.computePadding(size: filenameLength))
+            if padding > 0 {
+                try parser.advance(distance: padding)
+            }
+
+            let flags = try parser.parseInt()
+            let offset = Int(try parser.parseInt())
+            let storedSize = Int(try parser.parseInt())
+            let size = Int(try parser.parseInt())
+
+            guard offset + storedSize <= module.count else {
+                throw CompilerError("Entry at offset \(offset) with size \(storedSize) is out of bounds")
+            }
+            guard let filename = String(data: filenameData, encoding: .utf8) else {
+                throw CompilerError("Could not extract file name")
+            }
+
+            let startIndex = module.startIndex + offset
+            let storedData = module.subdata(in: startIndex..<(startIndex + storedSize))
+            let fileData: Data
+            if (flags & seekableEntryFlagCompressed) == 0 {
+                fileData = storedData
+            } else if let dictionary, dictionaryId != 0 {
+                fileData = try ZstdCompressor.decompress(data: storedData, dictionary: dictionary, decompressedSize: size)
+            } else {
+                fileData = try ZstdCompressor.decompress(data: storedData)
+            }
+
+            out.append(ZippableItem(file: .data(fileData), path: filename))
+        }
+
+        return out
+    }
+
+    static func unpack(module: Data, dictionary: ZstdDictionary? = nil) throws -> [ZippableItem] {
+        if module.starts(with: Magic.valdiSeekableMagic) {
+            return try unpackSeekable(module: module, dictionary: dictionary)
+        }
+
         let moduleData = ZstdCompressor.isZstdCompressed(data: module) ? try ZstdCompressor.decompress(data: module) : module
 
         let parser = Parser(sequence: moduleData)
@@ -131,6 +131,59 @@ class ZstdCompressor {
         return output
     }
     
+    /// Compress the data as a single frame using a dictionary. The frame references the dictionary
+    /// by its ID, which the runtime uses to find the dictionary to decompress it with.
+    class func compress(data: Data, dictionary: ZstdDictionary) throws -> Data {
+        guard let context = ZSTD_createCCtx() else {
+            throw CompilerError("Failed to create compression context")
+        }
+        defer {
+            ZSTD_freeCCtx(context)
+        }
+
+        var output = Data(count: ZSTD_compressBound(data.count))
+        let outputCapacity = output.count
+
+        let result = output.withUnsafeMutableBytes { (outputBytes: UnsafeMutableRawBufferPointer) in
+            data.withUnsafeBytes { (inputBytes: UnsafeRawBufferPointer) in
+                ZSTD_compress_usingCDict(context, outputBytes.baseAddress, outputCapacity, inputBytes.baseAddress, data.count, dictionary.cdict)
+            }
+        }
+        guard ZSTD_isError(result) == 0 else {
+            throw CompilerError("zstd: \(String(cString: ZSTD_getErrorName(result)))")
+        }
+
+        output.count = result
+        return output
+    }
+
+    class func decompress(data: Data, dictionary: ZstdDictionary, decompressedSize: Int) throws -> Data {
+        guard let context = ZSTD_createDCtx() else {
+            throw CompilerError("Failed to create decompression context")
+        }
+        defer {
+            ZSTD_freeDCtx(context)
+        }
+
+        var output = Data(count: decompressedSize)
+
+        let result = output.withUnsafeMutableBytes { (outputBytes: UnsafeMutableRawBufferPointer) in
+            data.withUnsafeBytes { (inputBytes: UnsafeRawBufferPointer) in
+                dictionary.data.withUnsafeBytes { (dictionaryBytes: UnsafeRawBufferPointer) in
+                    ZSTD_decompress_usingDict(context, outputBytes.baseAddress, decompressedSize, inputBytes.baseAddress, data.count, dictionaryBytes.baseAddress, dictionary.data.count)
+                }
+            }
+        }
+        guard ZSTD_isError(result) == 0 else {
+            throw CompilerError("zstd: \(String(cString: ZSTD_getErrorName(result)))")
+        }
+        guard result == decompressedSize else {
+            throw CompilerError("Decompressed \(result) bytes, expected \(decompressedSize)")
+        }
+
+        return output
+    }
+
     class func isZstdCompressed(data: Data) -> Bool {
         guard data.count >= MemoryLayout<UInt32>.size else {
             return false
@@ -143,3 +196,36 @@ class ZstdCompressor {
         return magic == ZSTD_MAGICNUMBER
     }
 }
+
+/// A zstd dictionary, trained over the files of the modules with `zstd --train`.
+/// The runtime loads the same dictionary from the `valdi.zstddict` resource.
+class ZstdDictionary {
+
+    let data: Data
+    let id: UInt32
+    fileprivate let cdict: OpaquePointer
+
+    init(data: Data, compressionLevel: Int32 = 19) throws {
+        let id = data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+            ZSTD_getDictID_fromDict(bytes.baseAddress, data.count)
+        }
+        guard id != 0 else {
+            throw CompilerError("Invalid zstd dictionary: only dictionaries trained by zstd, which have an ID, are supported")
+        }
+
+        let cdict = data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+            ZSTD_createCDict(bytes.baseAddress, data.count, compressionLevel)
+        }
+        guard let cdict else {
+            throw CompilerError("Failed to digest zstd dictionary")
+        }
+
+        self.data = data
+        self.id = id
+        self.cdict = cdict
+    }
+
+    deinit {
+        ZSTD_freeCDict(cdict)
+    }
+}
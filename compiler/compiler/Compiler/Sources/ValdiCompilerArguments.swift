@@ -207,6 +207,12 @@ struct ValdiCompilerArguments: ParsableCommand {
     @Flag(help: "verify artifact files with uploaded signatures")
     var verifyDownloadableArtifacts = false
 
+    @Flag(help: "output modules as seekable archives whose entries are compressed individually and decompressed on demand")
+    var seekableModules = false
+
+    @Option(help: "path to a zstd dictionary trained over the module files, used to compress the entries of seekable modules")
+    var zstdDictionary: String?
+
     @Flag(help: "generate TS files from strings and resources")
     var generateTSResFiles = false
 
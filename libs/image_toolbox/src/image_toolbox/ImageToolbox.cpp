@@ -1,6 +1,7 @@
 #include "ImageToolbox.hpp"
 #include "SVGRenderer.hpp"
 #include "snap_drawing/cpp/Utils/Image.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/DiskUtils.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
@@ -34,20 +35,6 @@ static Valdi::Result<R> processImage(const Valdi::StringBox& imageFilePath,
     }
 }
 
-static Valdi::Result<Ref<Image>> loadImage(const Valdi::StringBox& imageFilePath,
-                                           const std::optional<int>& widthHint,
-                                           const std::optional<int>& heightHint) {
-    return processImage<Valdi::Ref<snap::drawing::Image>>(
-        imageFilePath,
-        [&](auto bytes) { return Image::make(bytes); },
-        [&](auto bytes) {
-            auto outputWidth = widthHint ? widthHint.value() : 0;
-            auto outputHeight = heightHint ? heightHint.value() : 0;
-
-            return SVGRenderer::render(bytes.data(), bytes.size(), outputWidth, outputHeight);
-        });
-}
-
 Valdi::Result<ImageInfo> getImageInfo(const Valdi::StringBox& imageFilePath) {
     auto imageSize = processImage<std::pair<int, int>>(
         imageFilePath,
@@ -85,61 +72,125 @@ Valdi::Result<Valdi::BytesView> outputImageInfo(const Valdi::StringBox& imageFil
     return Valdi::valueToJson(json)->toBytesView();
 }
 
-Valdi::Result<Valdi::BytesView> convertImage(const Valdi::StringBox& inputImageFilePath,
-                                             const Valdi::StringBox& outputImageFilePath,
-                                             const std::optional<int>& outputWidth,
-                                             const std::optional<int>& outputHeight,
-                                             double qualityRatio) {
+static Valdi::Result<EncodedImageFormat> resolveOutputFormat(const Valdi::StringBox& outputImageFilePath) {
     Valdi::Path outputPath(outputImageFilePath.toStringView());
-
-    snap::drawing::EncodedImageFormat outputFormat;
-
     auto outputFileExtension = outputPath.getFileExtension();
 
     if (outputFileExtension == "png") {
-        outputFormat = snap::drawing::EncodedImageFormatPNG;
+        return snap::drawing::EncodedImageFormatPNG;
     } else if (outputFileExtension == "webp") {
-        outputFormat = snap::drawing::EncodedImageFormatWebP;
+        return snap::drawing::EncodedImageFormatWebP;
     } else if (outputFileExtension == "jpg" || outputFileExtension == "jpeg") {
-        outputFormat = snap::drawing::EncodedImageFormatJPG;
+        return snap::drawing::EncodedImageFormatJPG;
     } else {
         return Valdi::Error(STRING_FORMAT(
             "Unsupported file extension '{}' for output file '{}'", outputFileExtension, outputImageFilePath));
     }
+}
 
-    auto imageResult = loadImage(inputImageFilePath, outputWidth, outputHeight);
-    if (!imageResult) {
-        return imageResult.moveError();
-    }
-    auto image = imageResult.moveValue();
-
+static Valdi::Result<Valdi::Void> resizeAndStore(Ref<Image> image,
+                                                 const ImageConversionOutput& output,
+                                                 EncodedImageFormat outputFormat) {
     int newWidth = image->width();
     int newHeight = image->height();
     auto ratio = static_cast<double>(newWidth) / static_cast<double>(newHeight);
 
-    if (outputWidth && outputHeight) {
-        newWidth = outputWidth.value();
-        newHeight = outputHeight.value();
-    } else if (outputWidth) {
-        newWidth = outputWidth.value();
+    if (output.width && output.height) {
+        newWidth = output.width.value();
+        newHeight = output.height.value();
+    } else if (output.width) {
+        newWidth = output.width.value();
         newHeight = static_cast<int>(round(newWidth / ratio));
-    } else if (outputHeight) {
-        newHeight = outputHeight.value();
+    } else if (output.height) {
+        newHeight = output.height.value();
         newWidth = static_cast<int>(round(newHeight * ratio));
     }
 
-    if (newWidth != image->width() && newHeight != image->height()) {
+    if (newWidth != image->width() || newHeight != image->height()) {
         image = image->resized(newWidth, newHeight);
     }
 
-    auto encodeResult = image->encode(outputFormat, qualityRatio);
+    auto encodeResult = image->encode(outputFormat, output.qualityRatio);
     if (!encodeResult) {
         return encodeResult.moveError();
     }
 
-    auto storeResult = Valdi::DiskUtils::store(outputPath, encodeResult.value());
-    if (!storeResult) {
-        return storeResult.moveError();
+    return Valdi::DiskUtils::store(Valdi::Path(output.filePath.toStringView()), encodeResult.value());
+}
+
+Valdi::Result<Valdi::BytesView> convertImage(const Valdi::StringBox& inputImageFilePath,
+                                             const Valdi::StringBox& outputImageFilePath,
+                                             const std::optional<int>& outputWidth,
+                                             const std::optional<int>& outputHeight,
+                                             double qualityRatio) {
+    ImageConversionOutput output;
+    output.filePath = outputImageFilePath;
+    output.width = outputWidth;
+    output.height = outputHeight;
+    output.qualityRatio = qualityRatio;
+
+    return convertImage(inputImageFilePath, {std::move(output)});
+}
+
+Valdi::Result<Valdi::BytesView> convertImage(const Valdi::StringBox& inputImageFilePath,
+                                             const std::vector<ImageConversionOutput>& outputs) {
+    std::vector<EncodedImageFormat> outputFormats;
+    outputFormats.reserve(outputs.size());
+    for (const auto& output : outputs) {
+        auto outputFormat = resolveOutputFormat(output.filePath);
+        if (!outputFormat) {
+            return outputFormat.moveError();
+        }
+        outputFormats.emplace_back(outputFormat.value());
+    }
+
+    Valdi::Path inputPath(inputImageFilePath.toStringView());
+    auto loadResult = Valdi::DiskUtils::load(inputPath);
+    if (!loadResult) {
+        return loadResult.moveError();
+    }
+    auto fileBytes = loadResult.moveValue();
+    auto isSVG = inputPath.getFileExtension() == "svg";
+
+    Ref<Image> decodedImage;
+    if (!isSVG) {
+        auto imageResult = Image::make(fileBytes);
+        if (!imageResult) {
+            return imageResult.moveError();
+        }
+        // Decode the pixels once upfront, instead of once per output when resizing the deferred image
+        auto rasterImage = imageResult.value()->getSkValue()->makeRasterImage();
+        if (rasterImage == nullptr) {
+            return Valdi::Error("Unable to decode image");
+        }
+        decodedImage = Valdi::makeShared<Image>(rasterImage);
+    }
+
+    std::vector<std::optional<Valdi::Error>> errors(outputs.size());
+    const auto& threadPool = Valdi::ThreadPool::getShared();
+    threadPool->parallelFor(outputs.size(), threadPool->getWorkersCount() + 1, [&](size_t index) {
+        const auto& output = outputs[index];
+        auto image = decodedImage;
+        if (isSVG) {
+            auto renderResult = SVGRenderer::render(
+                fileBytes.data(), fileBytes.size(), output.width.value_or(0), output.height.value_or(0));
+            if (!renderResult) {
+                errors[index] = {renderResult.moveError()};
+                return;
+            }
+            image = renderResult.moveValue();
+        }
+
+        auto result = resizeAndStore(image, output, outputFormats[index]);
+        if (!result) {
+            errors[index] = {result.moveError()};
+        }
+    });
+
+    for (auto& error : errors) {
+        if (error) {
+            return std::move(error.value());
+        }
     }
 
     return Valdi::BytesView();
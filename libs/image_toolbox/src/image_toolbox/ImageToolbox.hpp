@@ -3,6 +3,7 @@
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 
 #include <optional>
+#include <vector>
 
 namespace snap::imagetoolbox {
 
@@ -21,4 +22,19 @@ Valdi::Result<Valdi::BytesView> convertImage(const Valdi::StringBox& inputImageF
                                              const std::optional<int>& outputHeight,
                                              double qualityRatio);
 
+struct ImageConversionOutput {
+    Valdi::StringBox filePath;
+    std::optional<int> width;
+    std::optional<int> height;
+    double qualityRatio = 1.0;
+};
+
+/**
+ Convert an image into several outputs, for instance all the density variants of an image asset.
+ The input is read and decoded once, the outputs are then resized and encoded in parallel.
+ SVG inputs are rendered at the size of each output instead of being resized.
+ */
+Valdi::Result<Valdi::BytesView> convertImage(const Valdi::StringBox& inputImageFilePath,
+                                             const std::vector<ImageConversionOutput>& outputs);
+
 } // namespace snap::imagetoolbox
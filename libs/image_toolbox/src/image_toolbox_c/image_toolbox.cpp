@@ -3,6 +3,13 @@
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 
+static std::optional<int> toOptionalExtent(int extent) {
+    if (extent <= 0) {
+        return std::nullopt;
+    }
+    return {extent};
+}
+
 extern "C" {
 
 static void setAsError(char** error, const Valdi::StringBox& errorMessage) {
@@ -46,6 +53,31 @@ int imagetoolbox_convert(
     return -1;
 }
 
+int imagetoolbox_convert_batch(const char* input_path,
+                               const image_toolbox_output* outputs,
+                               int outputs_count,
+                               char** error) {
+    std::vector<snap::imagetoolbox::ImageConversionOutput> conversionOutputs;
+    conversionOutputs.reserve(static_cast<size_t>(std::max(outputs_count, 0)));
+    for (int i = 0; i < outputs_count; i++) {
+        auto& conversionOutput = conversionOutputs.emplace_back();
+        conversionOutput.filePath = Valdi::StringCache::getGlobal().makeStringFromLiteral(outputs[i].output_path);
+        conversionOutput.width = toOptionalExtent(outputs[i].output_width);
+        conversionOutput.height = toOptionalExtent(outputs[i].output_height);
+        conversionOutput.qualityRatio = outputs[i].quality_ratio;
+    }
+
+    auto result = snap::imagetoolbox::convertImage(Valdi::StringCache::getGlobal().makeStringFromLiteral(input_path),
+                                                   conversionOutputs);
+
+    if (result) {
+        return 0;
+    }
+
+    setAsError(error, result.error().getMessage());
+    return -1;
+}
+
 void imagetoolbox_free_error(char* error) {
     free(error);
 }
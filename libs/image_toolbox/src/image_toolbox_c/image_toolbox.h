@@ -9,9 +9,22 @@ typedef struct {
     int height;
 } image_toolbox_size;
 
+typedef struct {
+    const char* output_path;
+    // 0 to resolve the extent from the other one, preserving the aspect ratio
+    int output_width;
+    int output_height;
+    double quality_ratio;
+} image_toolbox_output;
+
 image_toolbox_size imagetoolbox_get_size(const char* input_path, char** error);
 int imagetoolbox_convert(
     const char* input_path, const char* output_path, int outputWidth, int outputHeight, char** error);
+// Decodes the input once and writes all the outputs in parallel
+int imagetoolbox_convert_batch(const char* input_path,
+                               const image_toolbox_output* outputs,
+                               int outputs_count,
+                               char** error);
 void imagetoolbox_free_error(char* error);
 
 #ifdef __cplusplus
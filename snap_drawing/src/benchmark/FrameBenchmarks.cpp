@@ -0,0 +1,148 @@
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/RasterContext.hpp"
+#include "snap_drawing/cpp/Layers/LayerRoot.hpp"
+#include "snap_drawing/cpp/Layers/ScrollLayer.hpp"
+#include "snap_drawing/cpp/Resources.hpp"
+#include "snap_drawing/cpp/Utils/Bitmap.hpp"
+
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+
+#include "utils/time/StopWatch.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace snap::drawing;
+
+/**
+ Headless frame benchmarks, which run the drawing pipeline of a scrolling list on every iteration:
+ scroll, LayerRoot::draw() into a DisplayList, and raster of the DisplayList into a bitmap.
+ Per phase p50/p95/p99 frame times are reported as counters, use --benchmark_format=json
+ to collect them for trend tracking. The first argument is the number of rows in the list.
+ The heap allocations made by the draw and raster phases are reported per frame, the benchmark
+ links the allocation profiler hooks so that the global operator new is counted as well.
+ */
+
+constexpr Scalar kViewportWidth = 400;
+constexpr Scalar kViewportHeight = 800;
+constexpr Scalar kRowHeight = 80;
+constexpr Scalar kScrollStep = 24;
+
+struct FramePhaseDurations {
+    std::vector<double> durationsMs;
+
+    void report(benchmark::State& state, const char* phaseName) {
+        if (durationsMs.empty()) {
+            return;
+        }
+
+        std::sort(durationsMs.begin(), durationsMs.end());
+        reportPercentile(state, phaseName, "P50Ms", 0.50);
+        reportPercentile(state, phaseName, "P95Ms", 0.95);
+        reportPercentile(state, phaseName, "P99Ms", 0.99);
+    }
+
+private:
+    void reportPercentile(benchmark::State& state, const char* phaseName, const char* suffix, double percentile) {
+        auto index = static_cast<size_t>(percentile * static_cast<double>(durationsMs.size() - 1));
+        state.counters[std::string(phaseName) + suffix] = benchmark::Counter(durationsMs[index]);
+    }
+};
+
+static Ref<ScrollLayer> makeScrollingList(const Ref<Resources>& resources, size_t rowsCount) {
+    auto scrollLayer = makeLayer<ScrollLayer>(resources);
+    scrollLayer->setFrame(Rect::makeXYWH(0, 0, kViewportWidth, kViewportHeight));
+    scrollLayer->setContentSize(Size::make(kViewportWidth, static_cast<Scalar>(rowsCount) * kRowHeight));
+
+    for (size_t i = 0; i < rowsCount; i++) {
+        auto row = makeLayer<Layer>(resources);
+        row->setFrame(Rect::makeXYWH(0, static_cast<Scalar>(i) * kRowHeight, kViewportWidth, kRowHeight));
+        row->setBackgroundColor(i % 2 == 0 ? Color::white() : Color::green());
+
+        auto card = makeLayer<Layer>(resources);
+        card->setFrame(Rect::makeXYWH(16, 8, kViewportWidth - 32, kRowHeight - 16));
+        card->setBackgroundColor(Color::blue());
+        card->setBorderRadius(BorderRadius::makeOval(12, false));
+        row->addChild(card);
+
+        scrollLayer->addChild(row);
+    }
+
+    return scrollLayer;
+}
+
+static void ScrollFrame(benchmark::State& state) {
+    auto rowsCount = static_cast<size_t>(state.range(0));
+    auto resources = Valdi::makeShared<Resources>(nullptr, 1.0f, Valdi::ConsoleLogger::getLogger());
+    auto layerRoot = makeLayer<LayerRoot>(resources);
+    layerRoot->setSize(Size::make(kViewportWidth, kViewportHeight), 1.0f);
+
+    auto scrollLayer = makeScrollingList(resources, rowsCount);
+    layerRoot->setContentLayer(scrollLayer, ContentLayerSizingModeMatchSize);
+
+    RasterContext rasterContext(resources->getLogger(), ExternalSurfaceRasterizationMethod::FAST, false);
+    auto bitmapInfo = Valdi::BitmapInfo(static_cast<int>(kViewportWidth),
+                                        static_cast<int>(kViewportHeight),
+                                        Valdi::ColorTypeRGBA8888,
+                                        Valdi::AlphaTypePremul,
+                                        static_cast<size_t>(kViewportWidth) * 4);
+    Ref<Valdi::IBitmap> bitmap = Bitmap::make(bitmapInfo).moveValue();
+
+    auto maxContentOffset = static_cast<Scalar>(rowsCount) * kRowHeight - kViewportHeight;
+    Scalar contentOffset = 0;
+    Scalar scrollDirection = 1;
+
+    FramePhaseDurations drawDurations;
+    FramePhaseDurations rasterDurations;
+    Valdi::AllocationCounters frameAllocations;
+
+    // Only counting is needed, keep the sampling and its backtraces out of the frame times
+    auto previousSamplingInterval = Valdi::AllocationProfiler::getSamplingInterval();
+    Valdi::AllocationProfiler::setSamplingInterval(std::numeric_limits<uint64_t>::max());
+    Valdi::AllocationProfiler::setEnabled(true);
+
+    for (auto _ : state) {
+        // Scripted scroll, going back and forth through the whole list
+        contentOffset += kScrollStep * scrollDirection;
+        if (contentOffset > maxContentOffset || contentOffset < 0) {
+            scrollDirection = -scrollDirection;
+            contentOffset = std::clamp(contentOffset, 0.0f, std::max(maxContentOffset, 0.0f));
+        }
+        scrollLayer->setContentOffset(Point::make(0, contentOffset), Vector(0, 0), false);
+
+        auto allocationsSnapshot = Valdi::AllocationCounters::current();
+        snap::utils::time::StopWatch sw;
+        sw.start();
+        auto displayList = layerRoot->draw();
+        drawDurations.durationsMs.emplace_back(sw.elapsed().milliseconds());
+
+        sw.reset();
+        sw.start();
+        benchmark::DoNotOptimize(rasterContext.raster(displayList, bitmap, true));
+        auto rasterDurationMs = sw.elapsed().milliseconds();
+        auto allocations = Valdi::AllocationCounters::current().since(allocationsSnapshot);
+        rasterDurations.durationsMs.emplace_back(rasterDurationMs);
+
+        for (size_t i = 0; i < Valdi::kAllocationSitesCount; i++) {
+            frameAllocations.counts[i] += allocations.counts[i];
+            frameAllocations.bytes[i] += allocations.bytes[i];
+        }
+    }
+
+    Valdi::AllocationProfiler::setEnabled(false);
+    Valdi::AllocationProfiler::shared().collect();
+    Valdi::AllocationProfiler::setSamplingInterval(previousSamplingInterval);
+
+    drawDurations.report(state, "Draw");
+    rasterDurations.report(state, "Raster");
+
+    state.counters["AllocationsPerFrame"] =
+        benchmark::Counter(static_cast<double>(frameAllocations.getTotalCount()), benchmark::Counter::kAvgIterations);
+    state.counters["AllocatedBytesPerFrame"] =
+        benchmark::Counter(static_cast<double>(frameAllocations.getTotalBytes()), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(ScrollFrame)->Arg(20)->Arg(200)->Arg(2000);
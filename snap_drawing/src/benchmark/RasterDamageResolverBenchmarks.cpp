@@ -0,0 +1,76 @@
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/DrawingContext.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/RasterDamageResolver.hpp"
+
+#include "benchmark/benchmark.h"
+
+using namespace snap::drawing;
+
+constexpr Scalar kSceneSize = 2000;
+constexpr Scalar kLayerSize = 20;
+constexpr Scalar kLayerSpacing = 25;
+
+static LayerContent makeRectangleContent() {
+    DrawingContext drawingContext(kLayerSize, kLayerSize);
+    Paint paint;
+    paint.setColor(Color::blue());
+    drawingContext.drawPaint(paint, drawingContext.drawBounds());
+    return drawingContext.finish();
+}
+
+/**
+ Make a scene of layersCount layers laid out in a grid, where one layer out of updatedLayersInterval
+ has updates.
+ */
+static Ref<DisplayList> makeGridDisplayList(size_t layersCount, size_t updatedLayersInterval) {
+    auto displayList = Valdi::makeShared<DisplayList>(Size(kSceneSize, kSceneSize), TimePoint(0.0));
+    auto content = makeRectangleContent();
+    auto columnsCount = static_cast<size_t>(kSceneSize / kLayerSpacing);
+
+    displayList->pushContext(Matrix(), 1.0, 1, false);
+    for (size_t i = 0; i < layersCount; i++) {
+        Matrix matrix;
+        matrix.setTranslateX(static_cast<Scalar>(i % columnsCount) * kLayerSpacing);
+        matrix.setTranslateY(static_cast<Scalar>(i / columnsCount) * kLayerSpacing);
+
+        displayList->pushContext(matrix, 1.0, i + 2, i % updatedLayersInterval == 0);
+        displayList->appendLayerContent(content, 1.0);
+        displayList->popContext();
+    }
+    displayList->popContext();
+
+    return displayList;
+}
+
+static void RasterDamageResolverGrid(benchmark::State& state) {
+    auto displayList =
+        makeGridDisplayList(static_cast<size_t>(state.range(0)), static_cast<size_t>(state.range(1)));
+    RasterDamageResolver damageResolver;
+
+    for (auto _ : state) {
+        damageResolver.beginUpdates(kSceneSize, kSceneSize);
+        damageResolver.addDamageFromDisplayListUpdates(*displayList);
+        benchmark::DoNotOptimize(damageResolver.endUpdates());
+    }
+}
+
+static void RasterDamageResolverMergeScatteredRects(benchmark::State& state) {
+    std::vector<Rect> damageRects;
+    auto rectsCount = static_cast<size_t>(state.range(0));
+    // Deterministic pseudo random positions, so that runs can be compared
+    uint32_t seed = 42;
+    for (size_t i = 0; i < rectsCount; i++) {
+        seed = seed * 1664525 + 1013904223;
+        auto x = static_cast<Scalar>(seed % static_cast<uint32_t>(kSceneSize));
+        seed = seed * 1664525 + 1013904223;
+        auto y = static_cast<Scalar>(seed % static_cast<uint32_t>(kSceneSize));
+        damageRects.emplace_back(Rect::makeXYWH(x, y, kLayerSize, kLayerSize));
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RasterDamageResolver::mergeDamageRects(damageRects));
+    }
+}
+
+BENCHMARK(RasterDamageResolverGrid)->Args({1000, 1})->Args({1000, 10})->Args({5000, 1})->Args({5000, 10});
+BENCHMARK(RasterDamageResolverMergeScatteredRects)->Arg(100)->Arg(1000)->Arg(5000);
@@ -0,0 +1,188 @@
+#include "snap_drawing/cpp/Text/FontManager.hpp"
+#include "snap_drawing/cpp/Text/SharedTextShaperCache.hpp"
+#include "snap_drawing/cpp/Text/TextLayoutBuilder.hpp"
+#include "snap_drawing/cpp/Text/TextShaperHarfbuzz.hpp"
+#include "snap_drawing/cpp/Text/WordCachingTextShaper.hpp"
+#include "snap_drawing/cpp/Utils/UTFUtils.hpp"
+
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include "benchmark/benchmark.h"
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
+#endif
+
+using namespace snap::drawing;
+
+/**
+ Text benchmarks. Unless specified otherwise, the first argument selects the state of the text shaper cache:
+ 0 disables the cache, 1 clears it after every iteration (cold), 2 keeps it across iterations (hot).
+ */
+
+constexpr const char* kLongText = "Hello World! This string might be pretty long, and because of that we will have to "
+                                  "lay it out on multiple lines. It keeps going for a while so that line breaking, "
+                                  "ellipsis and justification have enough words to work with.";
+
+static double getResidentMemoryMB() {
+#if defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) ==
+        KERN_SUCCESS) {
+        return static_cast<double>(info.resident_size) / (1024.0 * 1024.0);
+    }
+    return 0;
+#elif defined(__linux__)
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    auto* file = std::fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    long totalPages = 0;
+    long residentPages = 0;
+    auto read = std::fscanf(file, "%ld %ld", &totalPages, &residentPages);
+    std::fclose(file);
+    if (read != 2) {
+        return 0;
+    }
+    return static_cast<double>(residentPages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+#else
+    return 0;
+#endif
+}
+
+static void reportResidentMemory(benchmark::State& state) {
+    state.counters["ResidentMemoryMB"] = benchmark::Counter(getResidentMemoryMB());
+}
+
+static void doTextBenchmark(benchmark::State& state, Valdi::Function<void(const Ref<FontManager>&)>&& benchmarkFn) {
+    auto disableCache = state.range(0) == 0;
+    auto fontManager = Valdi::makeShared<FontManager>(Valdi::ConsoleLogger::getLogger(), !disableCache);
+    fontManager->load();
+
+    auto shouldClearCacheAfterEachIteration = state.range(0) == 1;
+    for (auto _ : state) {
+        benchmarkFn(fontManager);
+
+        if (shouldClearCacheAfterEachIteration) {
+            fontManager->getTextShaper()->clearCache();
+        }
+    }
+
+    reportResidentMemory(state);
+}
+
+static void buildTextLayout(const Ref<FontManager>& fontManager,
+                            const char* text,
+                            TextAlign textAlign,
+                            Size maxSize,
+                            int maxLinesCount,
+                            bool isRightToLeft) {
+    auto font = fontManager->getDefaultFont().moveValue();
+
+    TextLayoutBuilder builder(textAlign, TextOverflowEllipsis, maxSize, maxLinesCount, fontManager, isRightToLeft);
+    builder.setIncludeTextBlob(true);
+    builder.append(text, font, 1.0f, 0.0f, TextDecorationNone);
+
+    benchmark::DoNotOptimize(builder.build());
+}
+
+/**
+ Shapes a paragraph directly through a WordCachingTextShaper, with the strategy given as the first argument:
+ 0 is DisableCache, 1 is PrioritizeCacheHit, 2 is PrioritizeCorrectness.
+ */
+static void TextShaperWordCachingStrategy(benchmark::State& state) {
+    auto fontManager = Valdi::makeShared<FontManager>(Valdi::ConsoleLogger::getLogger(), false);
+    fontManager->load();
+    auto font = fontManager->getDefaultFont().moveValue();
+
+    auto strategy = static_cast<WordCachingTextShaperStrategy>(state.range(0));
+    auto shaper = Valdi::makeShared<WordCachingTextShaper>(Valdi::makeShared<TextShaperHarfbuzz>(),
+                                                           strategy,
+                                                           Valdi::makeShared<SharedTextShaperCache>(256 * 1024));
+    auto characters = utf8ToUnicode(kLongText);
+    std::vector<ShapedGlyph> glyphs;
+
+    for (auto _ : state) {
+        glyphs.clear();
+        shaper->shape(characters.data(), characters.size(), *font, false, 0.0f, TextScript::common(), glyphs);
+        benchmark::DoNotOptimize(glyphs.data());
+    }
+
+    reportResidentMemory(state);
+}
+
+static void TextLayoutBidiParagraphs(benchmark::State& state) {
+    doTextBenchmark(state, [&](const auto& fontManager) {
+        buildTextLayout(fontManager,
+                        "قرأ Wikipedia™ طوال اليوم. Then some English text with 123 numbers.\n"
+                        "فقرة ثانية مع some embedded English وعلامات ترقيم!\n"
+                        "A final left to right paragraph ending with عربي.",
+                        TextAlignLeft,
+                        Size::make(200, 5000),
+                        0,
+                        state.range(1) != 0);
+    });
+}
+
+static void TextLayoutEmojiZWJSequences(benchmark::State& state) {
+    doTextBenchmark(state, [&](const auto& fontManager) {
+        buildTextLayout(fontManager,
+                        "Family 👨‍👩‍👧‍👦 coder 👩🏽‍💻 flag 🏳️‍🌈 couple 👩‍❤️‍💋‍👨 and "
+                        "mechanic 🧑🏿‍🔧 with 👍🏻👍🏼👍🏽👍🏾👍🏿 skin tones.",
+                        TextAlignLeft,
+                        Size::make(5000, 5000),
+                        1,
+                        false);
+    });
+}
+
+static void TextLayoutMixedFontAttributedText(benchmark::State& state) {
+    doTextBenchmark(state, [&](const auto& fontManager) {
+        auto regularFont = fontManager->getDefaultFont().moveValue();
+        auto boldFont = fontManager->getFontForName(STRING_LITERAL("system-bold 17"), 1.0).moveValue();
+        auto smallFont = regularFont->withSize(10).moveValue();
+
+        TextLayoutBuilder builder(TextAlignLeft, TextOverflowEllipsis, Size::make(200, 5000), 0, fontManager, false);
+        builder.setIncludeTextBlob(true);
+
+        for (size_t i = 0; i < 4; i++) {
+            builder.append("@username ", boldFont, 1.0f, 0.0f, TextDecorationNone);
+            builder.append("replied to your story with ", regularFont, 1.0f, 0.0f, TextDecorationNone);
+            builder.append("a link", regularFont, 1.0f, 0.0f, TextDecorationUnderline, nullptr, Color::blue());
+            builder.append(" 2h ago ", smallFont, 1.0f, 0.0f, TextDecorationNone);
+        }
+
+        benchmark::DoNotOptimize(builder.build());
+    });
+}
+
+static void TextLayoutEllipsisLineClamp(benchmark::State& state) {
+    doTextBenchmark(state, [&](const auto& fontManager) {
+        buildTextLayout(fontManager,
+                        kLongText,
+                        TextAlignLeft,
+                        Size::make(150, 5000),
+                        static_cast<int>(state.range(1)),
+                        false);
+    });
+}
+
+static void TextLayoutJustify(benchmark::State& state) {
+    doTextBenchmark(state, [&](const auto& fontManager) {
+        buildTextLayout(fontManager, kLongText, TextAlignJustify, Size::make(150, 5000), 0, false);
+    });
+}
+
+BENCHMARK(TextShaperWordCachingStrategy)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(TextLayoutBidiParagraphs)->Args({0, 0})->Args({1, 0})->Args({2, 0})->Args({2, 1});
+BENCHMARK(TextLayoutEmojiZWJSequences)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(TextLayoutMixedFontAttributedText)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(TextLayoutEllipsisLineClamp)->Args({0, 3})->Args({1, 3})->Args({2, 1})->Args({2, 3});
+BENCHMARK(TextLayoutJustify)->Arg(0)->Arg(1)->Arg(2);
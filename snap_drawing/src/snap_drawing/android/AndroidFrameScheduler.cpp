@@ -17,6 +17,7 @@ AndroidFrameScheduler::AndroidFrameScheduler(const ValdiAndroid::GlobalRefJavaOb
     auto cls = frameSchedulerJavaObject.getClass();
     cls.getMethod("onNextVSync", _onNextVSyncMethod);
     cls.getMethod("onMainThread", _onMainThreadMethod);
+    cls.getMethod("onMainThreadAfter", _onMainThreadAfterMethod);
     cls.getMethod("stop", _stopMethod);
 }
 
@@ -34,6 +35,11 @@ void AndroidFrameScheduler::onMainThread(const Ref<IFrameCallback>& callback) {
     _onMainThreadMethod.call(_frameSchedulerJava.toObject(), ptr);
 }
 
+void AndroidFrameScheduler::onMainThreadAfter(const Ref<IFrameCallback>& callback, Duration delay) {
+    auto ptr = reinterpret_cast<int64_t>(Valdi::unsafeBridgeRetain(callback.get()));
+    _onMainThreadAfterMethod.call(_frameSchedulerJava.toObject(), ptr, static_cast<int64_t>(delay.milliseconds()));
+}
+
 void AndroidFrameScheduler::performCallback(int64_t callbackHandle, int64_t frameTimeNanos) {
     auto ref = Valdi::unsafeBridge<IFrameCallback>(reinterpret_cast<void*>(callbackHandle));
 
@@ -22,12 +22,15 @@ public:
 
     void onMainThread(const Ref<IFrameCallback>& callback) override;
 
+    void onMainThreadAfter(const Ref<IFrameCallback>& callback, Duration delay) override;
+
     static void performCallback(int64_t callbackHandle, int64_t frameTimeNanos);
 
 private:
     ValdiAndroid::GlobalRefJavaObjectBase _frameSchedulerJava;
     ValdiAndroid::JavaMethod<ValdiAndroid::VoidType, int64_t> _onNextVSyncMethod;
     ValdiAndroid::JavaMethod<ValdiAndroid::VoidType, int64_t> _onMainThreadMethod;
+    ValdiAndroid::JavaMethod<ValdiAndroid::VoidType, int64_t, int64_t> _onMainThreadAfterMethod;
     ValdiAndroid::JavaMethod<ValdiAndroid::VoidType> _stopMethod;
 };
 
@@ -28,6 +28,14 @@ struct MainQueueFlushTask {
         : time(time), frameScheduler(std::move(frameScheduler)) {}
 };
 
+struct MainQueueDelayedTask {
+    Ref<IFrameCallback> callback;
+    Ref<BaseDisplayLinkFrameScheduler> frameScheduler;
+
+    MainQueueDelayedTask(const Ref<IFrameCallback>& callback, Ref<BaseDisplayLinkFrameScheduler>&& frameScheduler)
+        : callback(callback), frameScheduler(std::move(frameScheduler)) {}
+};
+
 BaseDisplayLinkFrameScheduler::BaseDisplayLinkFrameScheduler(Valdi::ILogger& logger) : _logger(logger) {}
 
 BaseDisplayLinkFrameScheduler::~BaseDisplayLinkFrameScheduler() {}
@@ -48,6 +56,15 @@ void BaseDisplayLinkFrameScheduler::onMainThread(const Ref<IFrameCallback>& call
     updateDisplayLink(guard);
 }
 
+void BaseDisplayLinkFrameScheduler::onMainThreadAfter(const Ref<IFrameCallback>& callback, Duration delay) {
+    // The display link is left to pause until the delay has elapsed
+    auto delayTask = new MainQueueDelayedTask(callback, Valdi::strongSmallRef(this));
+    auto when = dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(delay.seconds() * NSEC_PER_SEC));
+
+    dispatch_after_f(
+        when, dispatch_get_main_queue(), delayTask, &BaseDisplayLinkFrameScheduler::delayedMainQueueCallback);
+}
+
 void BaseDisplayLinkFrameScheduler::flushMainThreadCallbacks(TimePoint time) {
     auto flushedCallbacksCount = flushCallbacks(_mainThreadCallbacks, time);
 
@@ -121,6 +138,12 @@ void BaseDisplayLinkFrameScheduler::mainQueueCallback(void* context) {
     delete task;
 }
 
+void BaseDisplayLinkFrameScheduler::delayedMainQueueCallback(void* context) {
+    auto delayTask = reinterpret_cast<MainQueueDelayedTask*>(context);
+    delayTask->frameScheduler->onMainThread(delayTask->callback);
+    delete delayTask;
+}
+
 } // namespace snap::drawing
 
 #endif
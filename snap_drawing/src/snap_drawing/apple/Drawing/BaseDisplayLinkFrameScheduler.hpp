@@ -32,6 +32,8 @@ public:
 
     void onMainThread(const Ref<IFrameCallback>& callback) override;
 
+    void onMainThreadAfter(const Ref<IFrameCallback>& callback, Duration delay) override;
+
     void onVSync();
 
     Valdi::ILogger& getLogger() const;
@@ -59,6 +61,7 @@ private:
     void flushVSyncCallbacks(TimePoint time);
 
     static void mainQueueCallback(void* context);
+    static void delayedMainQueueCallback(void* context);
 };
 
 } // namespace snap::drawing
@@ -22,6 +22,8 @@ public:
     explicit CADisplayLinkFrameScheduler(Valdi::ILogger& logger);
     ~CADisplayLinkFrameScheduler() override;
 
+    void setPreferredFrameRate(Scalar frameRate) override;
+
 protected:
     void onResume(std::unique_lock<Valdi::Mutex>& lock) override;
     void onPause(std::unique_lock<Valdi::Mutex>& lock) override;
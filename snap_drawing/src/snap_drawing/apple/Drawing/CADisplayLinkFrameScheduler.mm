@@ -49,6 +49,14 @@ CADisplayLinkFrameScheduler::~CADisplayLinkFrameScheduler() {
     _displayLink = nil;
 }
 
+void CADisplayLinkFrameScheduler::setPreferredFrameRate(Scalar frameRate) {
+    // Lets ProMotion displays lower their refresh rate while only slow content is updated
+    if (@available(iOS 15.0, *)) {
+        _displayLink.preferredFrameRateRange =
+            frameRate > 0 ? CAFrameRateRangeMake(frameRate, frameRate, frameRate) : CAFrameRateRangeDefault;
+    }
+}
+
 void CADisplayLinkFrameScheduler::onResume(std::unique_lock<Valdi::Mutex>& lock) {
     lock.unlock();
     [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
@@ -34,6 +34,51 @@ void MetalGraphicsContext::commitCommandBuffer(CFTypeRef mtlCommandBuffer) {
     [commandBuffer commit];
 }
 
+static Valdi::FrameDuration toFrameDuration(CFTimeInterval seconds) {
+    return std::chrono::duration_cast<Valdi::FrameDuration>(std::chrono::duration<double>(seconds));
+}
+
+void MetalGraphicsContext::observeGPUFrameTiming(const Ref<MetalGraphicsContext>& context,
+                                                 CFTypeRef mtlFrameStartCommandBuffer,
+                                                 CFTypeRef mtlFrameEndCommandBuffer) {
+    if (@available(iOS 10.3, macOS 10.15, *)) {
+        id<MTLCommandBuffer> frameStartCommandBuffer = (__bridge id<MTLCommandBuffer>)mtlFrameStartCommandBuffer;
+        id<MTLCommandBuffer> frameEndCommandBuffer = (__bridge id<MTLCommandBuffer>)mtlFrameEndCommandBuffer;
+        Ref<MetalGraphicsContext> strongContext = context;
+
+        [frameEndCommandBuffer addCompletedHandler:^(id<MTLCommandBuffer> completedCommandBuffer) {
+            if (completedCommandBuffer.status != MTLCommandBufferStatusCompleted ||
+                frameStartCommandBuffer.GPUStartTime <= 0) {
+                return;
+            }
+
+            Valdi::GPUFrameTiming timing;
+            timing.gpuDuration = toFrameDuration(completedCommandBuffer.GPUEndTime - frameStartCommandBuffer.GPUStartTime);
+            strongContext->onGPUFrameTiming(timing);
+        }];
+    }
+}
+
+void MetalGraphicsContext::observeDrawablePresentation(const Ref<MetalGraphicsContext>& context,
+                                                       CFTypeRef mtlDrawableHandle) {
+    if (@available(iOS 10.3, macOS 10.15.4, *)) {
+        id<CAMetalDrawable> drawable = (__bridge id<CAMetalDrawable>)mtlDrawableHandle;
+        Ref<MetalGraphicsContext> strongContext = context;
+        CFTimeInterval submitTime = CACurrentMediaTime();
+
+        [drawable addPresentedHandler:^(id<MTLDrawable> presentedDrawable) {
+            // A presented time of 0 means that the drawable was dropped
+            if (presentedDrawable.presentedTime <= 0) {
+                return;
+            }
+
+            Valdi::GPUFrameTiming timing;
+            timing.presentLatency = toFrameDuration(presentedDrawable.presentedTime - submitTime);
+            strongContext->onGPUFrameTiming(timing);
+        }];
+    }
+}
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wunguarded-availability-new"
 
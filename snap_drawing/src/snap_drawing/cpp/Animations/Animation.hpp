@@ -11,6 +11,7 @@
 #include "valdi_core/cpp/Utils/Shared.hpp"
 
 #include "snap_drawing/cpp/Animations/InterpolationFunction.hpp"
+#include "snap_drawing/cpp/Utils/Scalar.hpp"
 #include "snap_drawing/cpp/Utils/TimePoint.hpp"
 
 #include <vector>
@@ -45,6 +46,14 @@ public:
      A set of completion handlers to call when the animation completes or is cancelled
      */
     virtual void addCompletion(AnimationCompletion&& completion) = 0;
+
+    /**
+     The frame rate at which the animation should run, or 0 if it should run at the display's max rate.
+     The frames of the layer are processed at the highest frame rate of its animations.
+     */
+    virtual Scalar getPreferredFrameRate() const {
+        return 0;
+    }
 };
 
 class Animation : public IAnimation {
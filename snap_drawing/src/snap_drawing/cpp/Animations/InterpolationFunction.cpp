@@ -70,4 +70,9 @@ InterpolationFunction InterpolationFunctions::viscousFluid() {
     return [](double ratio) -> double { return getViscousFluidInterpolator().interpolate(ratio); };
 }
 
+InterpolationFunction InterpolationFunctions::cubicBezier(double p1x, double p1y, double p2x, double p2y) {
+    return makeInterpolationFunction(makeTimingCurve(
+        static_cast<float>(p1x), static_cast<float>(p1y), static_cast<float>(p2x), static_cast<float>(p2y)));
+}
+
 } // namespace snap::drawing
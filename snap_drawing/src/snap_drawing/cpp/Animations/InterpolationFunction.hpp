@@ -22,6 +22,12 @@ public:
     static InterpolationFunction easeOut();
     static InterpolationFunction strongEaseOut();
     static InterpolationFunction viscousFluid();
+
+    /**
+     Returns a timing curve defined by the two given control points,
+     like CoreAnimation's functionWithControlPoints.
+     */
+    static InterpolationFunction cubicBezier(double p1x, double p1y, double p2x, double p2y);
 };
 
 } // namespace snap::drawing
@@ -48,32 +48,34 @@ MassState SpringForce::updateValues(double lastDisplacement, double lastVelocity
     lastDisplacement -= _finalPosition;
     double displacement;
     double currentVelocity;
-    double e = M_E;
 
+    // Each exponential and trigonometric term is evaluated once per step, as they dominate
+    // the cost of stepping the springs when many of them are running at once.
     if (_dampingRatio > 1) {
         // Overdamped
-        double coeffA = lastDisplacement - (_gammaMinus * lastDisplacement - lastVelocity) / (_gammaMinus - _gammaPlus);
         double coeffB = (_gammaMinus * lastDisplacement - lastVelocity) / (_gammaMinus - _gammaPlus);
-        displacement = coeffA * pow(e, _gammaMinus * deltaT) + coeffB * pow(e, _gammaPlus * deltaT);
-        currentVelocity =
-            coeffA * _gammaMinus * pow(e, _gammaMinus * deltaT) + coeffB * _gammaPlus * pow(e, _gammaPlus * deltaT);
+        double coeffA = lastDisplacement - coeffB;
+        double expMinus = exp(_gammaMinus * deltaT);
+        double expPlus = exp(_gammaPlus * deltaT);
+        displacement = coeffA * expMinus + coeffB * expPlus;
+        currentVelocity = coeffA * _gammaMinus * expMinus + coeffB * _gammaPlus * expPlus;
     } else if (_dampingRatio == 1) {
         // Critically damped
         double coeffA = lastDisplacement;
         double coeffB = lastVelocity + _frequency * lastDisplacement;
-        displacement = (coeffA + coeffB * deltaT) * pow(e, -_frequency * deltaT);
-        currentVelocity = (coeffA + coeffB * deltaT) * pow(e, -_frequency * deltaT) * (-_frequency) +
-                          coeffB * pow(e, -_frequency * deltaT);
+        double decay = exp(-_frequency * deltaT);
+        displacement = (coeffA + coeffB * deltaT) * decay;
+        currentVelocity = displacement * (-_frequency) + coeffB * decay;
     } else {
         // Underdamped
         double cosCoeff = lastDisplacement;
         double sinCoeff = (1 / _dampedFreq) * (_dampingRatio * _frequency * lastDisplacement + lastVelocity);
-        displacement = pow(e, -_dampingRatio * _frequency * deltaT) *
-                       (cosCoeff * cos(_dampedFreq * deltaT) + sinCoeff * sin(_dampedFreq * deltaT));
-        currentVelocity =
-            displacement * (-_frequency) * _dampingRatio +
-            pow(e, -_dampingRatio * _frequency * deltaT) * (-_dampedFreq * cosCoeff * sin(_dampedFreq * deltaT) +
-                                                            _dampedFreq * sinCoeff * cos(_dampedFreq * deltaT));
+        double decay = exp(-_dampingRatio * _frequency * deltaT);
+        double cosValue = cos(_dampedFreq * deltaT);
+        double sinValue = sin(_dampedFreq * deltaT);
+        displacement = decay * (cosCoeff * cosValue + sinCoeff * sinValue);
+        currentVelocity = displacement * (-_frequency) * _dampingRatio +
+                          decay * (-_dampedFreq * cosCoeff * sinValue + _dampedFreq * sinCoeff * cosValue);
     }
     _massState.value = displacement + _finalPosition;
     _massState.velocity = currentVelocity;
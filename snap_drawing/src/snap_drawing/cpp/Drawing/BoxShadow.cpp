@@ -6,6 +6,7 @@
 //
 
 #include "snap_drawing/cpp/Drawing/BoxShadow.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/BoxShadowCache.hpp"
 
 #include "include/core/SkBlurTypes.h"
 #include "include/core/SkMaskFilter.h"
@@ -38,9 +39,20 @@ void BoxShadow::setColor(Color color) {
     _paint.setColor(color);
 }
 
-void BoxShadow::draw(DrawingContext& drawingContext, const BorderRadius& borderRadius) {
+void BoxShadow::draw(DrawingContext& drawingContext,
+                     const BorderRadius& borderRadius,
+                     BoxShadowCache* cache,
+                     Scalar rasterScale) {
     auto drawBounds = drawingContext.drawBounds().makeOffset(_offset.width, _offset.height);
 
+    if (cache != nullptr) {
+        auto ninePatch = cache->getOrRender(borderRadius, drawBounds, _blurAmount, _paint, rasterScale);
+        if (ninePatch != nullptr) {
+            ninePatch->draw(drawingContext.canvas(), drawBounds);
+            return;
+        }
+    }
+
     drawingContext.drawPaint(_paint, borderRadius, drawBounds, _lazyPath);
 }
 
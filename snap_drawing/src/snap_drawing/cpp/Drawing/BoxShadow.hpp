@@ -17,6 +17,7 @@
 namespace snap::drawing {
 
 class BorderRadius;
+class BoxShadowCache;
 
 class BoxShadow : public Valdi::SimpleRefCountable {
 public:
@@ -27,7 +28,14 @@ public:
     void setColor(Color color);
     void setBlurAmount(Scalar blurAmount);
 
-    void draw(DrawingContext& drawingContext, const BorderRadius& borderRadius);
+    /**
+     Draw the shadow of the draw bounds of the context. When a cache is given, the shadow is
+     drawn from a nine-patch shared with the other shadows of the same style.
+     */
+    void draw(DrawingContext& drawingContext,
+              const BorderRadius& borderRadius,
+              BoxShadowCache* cache,
+              Scalar rasterScale);
 
 private:
     Size _offset = Size::makeEmpty();
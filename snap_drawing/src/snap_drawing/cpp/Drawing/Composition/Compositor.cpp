@@ -111,6 +111,16 @@ public:
         appendDrawPictureToPlane(drawPicture, absoluteClippedPictureRect, resolvedPlane);
     }
 
+    void visit(const Operations::DrawAtlasSprite& drawAtlasSprite) {
+        auto absoluteClippedSpriteRect = resolveAbsoluteClippedRect(drawAtlasSprite.rect);
+
+        auto& resolvedPlane = resolveRegularPlane(absoluteClippedSpriteRect);
+        resolvedPlane.bbox->insert(absoluteClippedSpriteRect);
+
+        syncDisplayListWithPlaneIfNeeded(resolvedPlane);
+        _displayList.appendAtlasSprite(drawAtlasSprite.sprite, drawAtlasSprite.rect, drawAtlasSprite.opacity);
+    }
+
     void visit(const Operations::DrawExternalSurface& drawExternalSurface) {
         auto& current = getCurrentContext();
 
@@ -200,7 +210,7 @@ private:
         plane.bbox->insert(frame);
 
         syncDisplayListWithPlaneIfNeeded(plane);
-        _displayList.appendPicture(drawPicture.picture, drawPicture.opacity);
+        _displayList.appendPicture(drawPicture.picture, drawPicture.opacity, drawPicture.opaqueRect);
     }
 
     void setCurrentPlaneIndex(uint64_t planeIndex) {
@@ -9,6 +9,7 @@
 #include "include/core/SkPicture.h"
 
 #include "snap_drawing/cpp/Drawing/Mask/IMask.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/ExternalSurface.hpp"
 
 namespace snap::drawing {
@@ -45,4 +46,9 @@ void CleanUpDisplayListVisitor::visit(const Operations::ApplyMask& applyMask) {
     applyMask.mask->unsafeReleaseInner();
 }
 
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+void CleanUpDisplayListVisitor::visit(const Operations::DrawAtlasSprite& drawAtlasSprite) {
+    drawAtlasSprite.sprite->unsafeReleaseInner();
+}
+
 } // namespace snap::drawing
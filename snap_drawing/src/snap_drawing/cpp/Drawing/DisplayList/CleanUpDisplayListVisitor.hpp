@@ -32,6 +32,8 @@ public:
     void visit(const Operations::PrepareMask& prepareMask);
 
     void visit(const Operations::ApplyMask& applyMask);
+
+    void visit(const Operations::DrawAtlasSprite& drawAtlasSprite);
 };
 
 } // namespace snap::drawing
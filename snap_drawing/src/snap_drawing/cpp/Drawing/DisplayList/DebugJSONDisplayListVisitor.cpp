@@ -59,6 +59,16 @@ void DebugJSONDisplayListVisitor::visit(const Operations::ApplyMask& applyMask)
     op.setMapValue("description", Valdi::Value(applyMask.mask->getDescription()));
 }
 
+void DebugJSONDisplayListVisitor::visit(const Operations::DrawAtlasSprite& drawAtlasSprite) {
+    auto& op = append("drawAtlasSprite");
+    op.setMapValue("opacity", Valdi::Value(drawAtlasSprite.opacity));
+    op.setMapValue("x", Valdi::Value(drawAtlasSprite.rect.left));
+    op.setMapValue("y", Valdi::Value(drawAtlasSprite.rect.top));
+    op.setMapValue("width", Valdi::Value(drawAtlasSprite.rect.width()));
+    op.setMapValue("height", Valdi::Value(drawAtlasSprite.rect.height()));
+    op.setMapValue("spritePtr", Valdi::Value(reinterpret_cast<int64_t>(drawAtlasSprite.sprite)));
+}
+
 Valdi::Value& DebugJSONDisplayListVisitor::append(std::string_view type) {
     auto& value = _output.emplace_back();
     value.setMapValue("type", Valdi::Value(std::move(type)));
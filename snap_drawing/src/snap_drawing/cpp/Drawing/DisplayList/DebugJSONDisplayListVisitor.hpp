@@ -34,6 +34,8 @@ public:
 
     void visit(const Operations::ApplyMask& applyMask);
 
+    void visit(const Operations::DrawAtlasSprite& drawAtlasSprite);
+
 private:
     std::vector<Valdi::Value>& _output;
 
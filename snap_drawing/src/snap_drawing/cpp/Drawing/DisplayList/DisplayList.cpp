@@ -9,14 +9,19 @@
 #include "snap_drawing/cpp/Drawing/DisplayList/CleanUpDisplayListVisitor.hpp"
 #include "snap_drawing/cpp/Drawing/DisplayList/DebugJSONDisplayListVisitor.hpp"
 #include "snap_drawing/cpp/Drawing/DisplayList/DrawDisplayListVisitor.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/OcclusionDisplayListVisitor.hpp"
 #include "snap_drawing/cpp/Drawing/Mask/IMask.hpp"
 #include "snap_drawing/cpp/Drawing/Paint.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurfaceCanvas.hpp"
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 
 namespace snap::drawing {
 
@@ -28,7 +33,67 @@ DisplayListPlane::DisplayListPlane(PooledByteBuffer&& operations) : operations(s
 
 size_t kDisplayListAllPlaneIndexes = std::numeric_limits<size_t>::max();
 
-DisplayList::DisplayList(Size size, TimePoint frameTime) : _size(size), _frameTime(frameTime) {
+static uint64_t makeDisplayListId() {
+    static std::atomic<uint64_t> kDisplayListIdSequence = 0;
+    return ++kDisplayListIdSequence;
+}
+
+/**
+ Retains the references held by operations copied from another DisplayList.
+ */
+class RetainCopiedOperationsVisitor {
+public:
+    bool hasExternalSurfaces = false;
+    bool hasMask = false;
+
+    size_t visit(const Operations::PushContext& pushContext) {
+        // The copied bytes are owned by the destination DisplayList
+        const_cast<Operations::PushContext&>(pushContext).hasUpdates = false;
+        return sizeof(Operations::PushContext);
+    }
+
+    size_t visit(const Operations::PopContext& /*popContext*/) {
+        return sizeof(Operations::PopContext);
+    }
+
+    size_t visit(const Operations::DrawPicture& drawPicture) {
+        drawPicture.picture->ref();
+        return sizeof(Operations::DrawPicture);
+    }
+
+    size_t visit(const Operations::ClipRect& /*clipRect*/) {
+        return sizeof(Operations::ClipRect);
+    }
+
+    size_t visit(const Operations::ClipRound& /*clipRound*/) {
+        return sizeof(Operations::ClipRound);
+    }
+
+    size_t visit(const Operations::DrawExternalSurface& drawExternalSurface) {
+        drawExternalSurface.externalSurfaceSnapshot->unsafeRetainInner();
+        hasExternalSurfaces = true;
+        return sizeof(Operations::DrawExternalSurface);
+    }
+
+    size_t visit(const Operations::PrepareMask& prepareMask) {
+        prepareMask.mask->unsafeRetainInner();
+        hasMask = true;
+        return sizeof(Operations::PrepareMask);
+    }
+
+    size_t visit(const Operations::ApplyMask& applyMask) {
+        applyMask.mask->unsafeRetainInner();
+        return sizeof(Operations::ApplyMask);
+    }
+
+    size_t visit(const Operations::DrawAtlasSprite& drawAtlasSprite) {
+        drawAtlasSprite.sprite->unsafeRetainInner();
+        return sizeof(Operations::DrawAtlasSprite);
+    }
+};
+
+DisplayList::DisplayList(Size size, TimePoint frameTime)
+    : _size(size), _frameTime(frameTime), _id(makeDisplayListId()) {
     appendPlane();
 }
 
@@ -44,6 +109,10 @@ TimePoint DisplayList::getFrameTime() const {
     return _frameTime;
 }
 
+uint64_t DisplayList::getId() const {
+    return _id;
+}
+
 void DisplayList::pushContext(const Matrix& matrix, Scalar opacity, uint64_t layerId, bool hasUpdates) {
     auto* op = appendOperation<Operations::PushContext>();
     op->matrix = matrix;
@@ -58,7 +127,9 @@ void DisplayList::popContext() {
 
 void DisplayList::appendLayerContent(const LayerContent& layerContent, Scalar opacity) {
     if (layerContent.picture != nullptr) {
-        appendPicture(layerContent.picture.get(), opacity);
+        appendPicture(layerContent.picture.get(),
+                      opacity,
+                      opacity == 1.0f ? layerContent.opaqueRect : Rect::makeEmpty());
     }
 
     if (layerContent.externalSurface != nullptr) {
@@ -69,16 +140,30 @@ void DisplayList::appendLayerContent(const LayerContent& layerContent, Scalar op
         op->externalSurfaceSnapshot->unsafeRetainInner();
         _hasExternalSurfaces = true;
     }
+
+    if (layerContent.atlasSprite != nullptr) {
+        appendAtlasSprite(layerContent.atlasSprite.get(), layerContent.atlasSpriteRect, opacity);
+    }
 }
 
-void DisplayList::appendPicture(SkPicture* picture, Scalar opacity) {
+void DisplayList::appendPicture(SkPicture* picture, Scalar opacity, const Rect& opaqueRect) {
     auto* op = appendOperation<Operations::DrawPicture>();
     op->picture = picture;
     op->opacity = opacity;
+    op->opaqueRect = opaqueRect;
 
     op->picture->ref();
 }
 
+void DisplayList::appendAtlasSprite(ImageAtlasSprite* sprite, const Rect& rect, Scalar opacity) {
+    auto* op = appendOperation<Operations::DrawAtlasSprite>();
+    op->sprite = sprite;
+    op->rect = rect;
+    op->opacity = opacity;
+
+    op->sprite->unsafeRetainInner();
+}
+
 void DisplayList::appendClipRound(const BorderRadius& borderRadius, Scalar width, Scalar height) {
     if (borderRadius.isEmpty()) {
         appendClipRect(width, height);
@@ -110,6 +195,36 @@ void DisplayList::appendApplyMask(IMask* mask) {
     op->mask->unsafeRetainInner();
 }
 
+void DisplayList::appendOperations(const DisplayList& source, size_t planeIndex, size_t begin, size_t end) {
+    auto size = end - begin;
+    if (size == 0) {
+        return;
+    }
+
+    auto* output = _currentPlane->operations->appendWritable(size);
+    // Resolved after appending, as the source might be the current plane which was just resized
+    const auto* input = source.getBeginEndPtrs(planeIndex).first + begin;
+    std::memcpy(output, input, size);
+
+    RetainCopiedOperationsVisitor visitor;
+    const auto* current = output;
+    const auto* outputEnd = output + size;
+    while (current != outputEnd) {
+        current += Operations::visitOperation(*reinterpret_cast<const Operations::Operation*>(current), visitor);
+    }
+
+    _hasExternalSurfaces = _hasExternalSurfaces || visitor.hasExternalSurfaces;
+    _hasMask = _hasMask || visitor.hasMask;
+}
+
+void DisplayList::setPreviousDisplayList(const Ref<DisplayList>& previousDisplayList) {
+    _previousDisplayList = previousDisplayList;
+}
+
+const Ref<DisplayList>& DisplayList::getPreviousDisplayList() const {
+    return _previousDisplayList;
+}
+
 size_t DisplayList::getBytesUsed(size_t planeIndex) const {
     auto ptrs = getBeginEndPtrs(planeIndex);
 
@@ -128,6 +243,10 @@ void DisplayList::setCurrentPlane(size_t planeIndex) {
     _currentPlane = &_planes[planeIndex];
 }
 
+size_t DisplayList::getCurrentPlaneIndex() const {
+    return static_cast<size_t>(_currentPlane - _planes.data());
+}
+
 void DisplayList::removePlane(size_t planeIndex) {
     if (&_planes[planeIndex] == _currentPlane) {
         _currentPlane = nullptr;
@@ -205,8 +324,11 @@ static void prepareCanvas(SkCanvas* canvas, Scalar scaleX, Scalar scaleY, bool s
 
 void DisplayList::draw(
     DrawableSurfaceCanvas& canvas, size_t planeIndex, Scalar scaleX, Scalar scaleY, bool shouldClearCanvas) const {
-    auto* skiaCanvas = canvas.getSkiaCanvas();
+    drawInSkiaCanvas(canvas.getSkiaCanvas(), planeIndex, scaleX, scaleY, shouldClearCanvas);
+}
 
+void DisplayList::drawInSkiaCanvas(
+    SkCanvas* skiaCanvas, size_t planeIndex, Scalar scaleX, Scalar scaleY, bool shouldClearCanvas) const {
     auto saveCount = skiaCanvas->save();
 
     prepareCanvas(skiaCanvas, scaleX, scaleY, shouldClearCanvas);
@@ -216,8 +338,17 @@ void DisplayList::draw(
         skiaCanvas->saveLayer(nullptr, nullptr);
     }
 
+    // Pictures fully hidden by opaque content drawn above them are skipped
+    OcclusionDisplayListVisitor occlusionVisitor(scaleX, scaleY);
+    visitOperations(planeIndex, occlusionVisitor);
+    auto occludedPictures = occlusionVisitor.resolveOccludedPictures();
+
     DrawDisplayListVisitor visitor(skiaCanvas, scaleX, scaleY);
+    if (!occludedPictures.empty()) {
+        visitor.setOccludedPictures(&occludedPictures);
+    }
     visitOperations(planeIndex, visitor);
+    visitor.flush();
 
     skiaCanvas->restoreToCount(saveCount);
 }
@@ -232,4 +363,16 @@ void DisplayList::draw(DrawableSurfaceCanvas& canvas, size_t planeIndex, bool sh
     draw(canvas, planeIndex, scaleX, scaleY, shouldClearCanvas);
 }
 
+sk_sp<SkPicture> DisplayList::recordPlane(size_t planeIndex, int width, int height, bool shouldClearCanvas) const {
+    auto scaleX = static_cast<Scalar>(width) / _size.width;
+    auto scaleY = static_cast<Scalar>(height) / _size.height;
+
+    SkPictureRecorder recorder;
+    auto* recordingCanvas =
+        recorder.beginRecording(SkRect::MakeWH(static_cast<SkScalar>(width), static_cast<SkScalar>(height)));
+    drawInSkiaCanvas(recordingCanvas, planeIndex, scaleX, scaleY, shouldClearCanvas);
+
+    return recorder.finishRecordingAsPicture();
+}
+
 } // namespace snap::drawing
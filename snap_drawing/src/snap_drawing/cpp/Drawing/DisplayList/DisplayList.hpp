@@ -25,10 +25,13 @@
 
 #include <vector>
 
+class SkCanvas;
+
 namespace snap::drawing {
 
 class DrawableSurfaceCanvas;
 class IMask;
+class ImageAtlasSprite;
 
 extern size_t kDisplayListAllPlaneIndexes;
 
@@ -48,17 +51,37 @@ public:
     Size getSize() const;
     TimePoint getFrameTime() const;
 
+    /**
+     Returns an identifier which is unique to this DisplayList instance.
+     */
+    uint64_t getId() const;
+
     void pushContext(const Matrix& matrix, Scalar opacity, uint64_t layerId, bool hasUpdates);
     void popContext();
 
     void appendLayerContent(const LayerContent& layerContent, Scalar opacity);
-    void appendPicture(SkPicture* picture, Scalar opacity);
+    void appendPicture(SkPicture* picture, Scalar opacity, const Rect& opaqueRect = Rect::makeEmpty());
+    void appendAtlasSprite(ImageAtlasSprite* sprite, const Rect& rect, Scalar opacity);
     void appendClipRound(const BorderRadius& borderRadius, Scalar width, Scalar height);
     void appendClipRect(Scalar width, Scalar height);
 
     void appendPrepareMask(IMask* mask);
     void appendApplyMask(IMask* mask);
 
+    /**
+     Append a copy of the operations stored between the begin and end byte offsets of the given plane
+     of the source DisplayList. The references held by the operations are retained, and the copied
+     contexts are marked as having no updates, as they are unchanged since they were recorded.
+     */
+    void appendOperations(const DisplayList& source, size_t planeIndex, size_t begin, size_t end);
+
+    /**
+     Set the DisplayList recorded in the previous frame, from which the layers that did not change
+     can copy their operations instead of recording them again.
+     */
+    void setPreviousDisplayList(const Ref<DisplayList>& previousDisplayList);
+    const Ref<DisplayList>& getPreviousDisplayList() const;
+
     size_t getPlanesCount() const;
     bool hasExternalSurfaces() const;
 
@@ -68,6 +91,7 @@ public:
     void removePlane(size_t planeIndex);
 
     void setCurrentPlane(size_t planeIndex);
+    size_t getCurrentPlaneIndex() const;
 
     void removeEmptyPlanes();
     void removeAllPlanes();
@@ -79,6 +103,13 @@ public:
 
     void draw(DrawableSurfaceCanvas& canvas, size_t planeIndex, bool shouldClearCanvas = true) const;
 
+    /**
+     Record the given plane into a picture which draws the same content as draw() would on a
+     canvas of the given size in pixels. Recording does not use any GraphicsContext, and can
+     thus happen on any thread, as long as the DisplayList is not mutated concurrently.
+     */
+    sk_sp<SkPicture> recordPlane(size_t planeIndex, int width, int height, bool shouldClearCanvas) const;
+
     template<typename Visitor>
     void visitOperations(size_t planeIndex, Visitor& visitor) const {
         if (planeIndex == kDisplayListAllPlaneIndexes) {
@@ -94,13 +125,18 @@ public:
 private:
     Valdi::SmallVector<DisplayListPlane, 1> _planes;
     DisplayListPlane* _currentPlane = nullptr;
+    Ref<DisplayList> _previousDisplayList;
     Size _size;
     TimePoint _frameTime;
+    uint64_t _id;
     bool _hasExternalSurfaces = false;
     bool _hasMask = false;
 
     std::pair<Valdi::Byte*, Valdi::Byte*> getBeginEndPtrs(size_t planeIndex) const;
 
+    void drawInSkiaCanvas(
+        SkCanvas* skiaCanvas, size_t planeIndex, Scalar scaleX, Scalar scaleY, bool shouldClearCanvas) const;
+
     template<typename T>
     T* appendOperation() {
         auto* operation =
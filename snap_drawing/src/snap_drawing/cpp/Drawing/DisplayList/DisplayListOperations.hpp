@@ -17,6 +17,7 @@ namespace snap::drawing {
 
 class ExternalSurfaceSnapshot;
 class IMask;
+class ImageAtlasSprite;
 
 namespace Operations {
 
@@ -42,6 +43,8 @@ struct DrawPicture : public Operation {
 
     SkPicture* picture;
     Scalar opacity;
+    // Fully opaque area of the picture in local coordinates, empty if unknown
+    Rect opaqueRect;
 };
 
 struct ClipOperation : public Operation {
@@ -78,6 +81,15 @@ struct ApplyMask : public Operation {
     IMask* mask;
 };
 
+struct DrawAtlasSprite : public Operation {
+    constexpr static size_t kId = 9;
+
+    ImageAtlasSprite* sprite;
+    // Where the sprite is drawn in local coordinates
+    Rect rect;
+    Scalar opacity;
+};
+
 template<typename Visitor>
 inline auto visitOperation(const Operations::Operation& operation, Visitor& visitor) {
     switch (operation.type) {
@@ -97,6 +109,8 @@ inline auto visitOperation(const Operations::Operation& operation, Visitor& visi
             return visitor.visit(reinterpret_cast<const Operations::PrepareMask&>(operation));
         case Operations::ApplyMask::kId:
             return visitor.visit(reinterpret_cast<const Operations::ApplyMask&>(operation));
+        case Operations::DrawAtlasSprite::kId:
+            return visitor.visit(reinterpret_cast<const Operations::DrawAtlasSprite&>(operation));
         default:
             std::abort();
             break;
@@ -11,16 +11,39 @@
 
 #include "snap_drawing/cpp/Drawing/Mask/IMask.hpp"
 #include "snap_drawing/cpp/Drawing/Paint.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
 
 namespace snap::drawing {
 
+// Bounds the cost of the overlap checks, all the batches are drawn when reaching it
+constexpr size_t kMaxAtlasBatchesCount = 4;
+
+/**
+ Whether the matrix only rotates, uniformly scales and translates, which is what
+ a SkRSXform can represent.
+ */
+static bool isRotateScaleTranslate(const SkMatrix& matrix) {
+    return !matrix.hasPerspective() && SkScalarNearlyEqual(matrix.getScaleX(), matrix.getScaleY()) &&
+           SkScalarNearlyEqual(matrix.getSkewX(), -matrix.getSkewY());
+}
+
 DrawDisplayListVisitor::DrawDisplayListVisitor(SkCanvas* canvas, Scalar scaleX, Scalar scaleY)
     : _canvas(canvas), _scaleX(scaleX), _scaleY(scaleY), _tempRect(Rect::makeEmpty()) {}
 
+void DrawDisplayListVisitor::setOccludedPictures(const std::vector<bool>* occludedPictures) {
+    _occludedPictures = occludedPictures;
+    _pictureIndex = 0;
+}
+
 void DrawDisplayListVisitor::visit(const Operations::PushContext& pushContext) {
     if (pushContext.opacity == 1.0f) {
         _canvas->save();
+        _flushOnPopStack.emplace_back(false);
     } else {
+        // The batched sprites are drawn below the layer
+        flush();
+        _flushOnPopStack.emplace_back(true);
+
         Paint paint;
         paint.setAlpha(pushContext.opacity);
         _canvas->saveLayer(nullptr, &paint.getSkValue());
@@ -35,10 +58,26 @@ void DrawDisplayListVisitor::visit(const Operations::PushContext& pushContext) {
 }
 
 void DrawDisplayListVisitor::visit(const Operations::PopContext& /*popContext*/) {
+    if (!_flushOnPopStack.empty()) {
+        if (_flushOnPopStack[_flushOnPopStack.size() - 1]) {
+            flush();
+        }
+        _flushOnPopStack.pop_back();
+    }
+
     _canvas->restore();
 }
 
 void DrawDisplayListVisitor::visit(const Operations::DrawPicture& drawPicture) {
+    if (_occludedPictures != nullptr) {
+        auto pictureIndex = _pictureIndex++;
+        if (pictureIndex < _occludedPictures->size() && (*_occludedPictures)[pictureIndex]) {
+            return;
+        }
+    }
+
+    flushIfOverlapping(_canvas->getTotalMatrix().mapRect(drawPicture.picture->cullRect()));
+
     if (drawPicture.opacity == 1.0f) {
         _canvas->drawPicture(drawPicture.picture);
     } else {
@@ -49,6 +88,9 @@ void DrawDisplayListVisitor::visit(const Operations::DrawPicture& drawPicture) {
 }
 
 void DrawDisplayListVisitor::visit(const Operations::ClipRect& clipRect) {
+    flush();
+    setNeedsFlushOnPop();
+
     _tempRect.right = clipRect.width;
     _tempRect.bottom = clipRect.height;
 
@@ -56,6 +98,9 @@ void DrawDisplayListVisitor::visit(const Operations::ClipRect& clipRect) {
 }
 
 void DrawDisplayListVisitor::visit(const Operations::ClipRound& clipRound) {
+    flush();
+    setNeedsFlushOnPop();
+
     _tempRect.right = clipRound.width;
     _tempRect.bottom = clipRound.height;
 
@@ -69,11 +114,131 @@ void DrawDisplayListVisitor::visit(const Operations::ClipRound& clipRound) {
 void DrawDisplayListVisitor::visit(const Operations::DrawExternalSurface& /*drawExternalSurface*/) {}
 
 void DrawDisplayListVisitor::visit(const Operations::PrepareMask& prepareMask) {
+    flush();
     prepareMask.mask->prepare(_canvas);
 }
 
 void DrawDisplayListVisitor::visit(const Operations::ApplyMask& applyMask) {
+    flush();
     applyMask.mask->apply(_canvas);
 }
 
+void DrawDisplayListVisitor::visit(const Operations::DrawAtlasSprite& drawAtlasSprite) {
+    const auto& sprite = *drawAtlasSprite.sprite;
+    const auto& rect = drawAtlasSprite.rect;
+    auto matrix = _canvas->getTotalMatrix();
+
+    auto deviceBounds = matrix.mapRect(rect.getSkValue());
+    // Edges are antialiased
+    deviceBounds.outset(1.0f, 1.0f);
+
+    sk_sp<SkImage> pageImage;
+    Rect textureRect;
+    if (!isRotateScaleTranslate(matrix) || !sprite.getAtlas()->resolve(sprite, pageImage, textureRect)) {
+        flushIfOverlapping(deviceBounds);
+        drawSpriteImage(drawAtlasSprite);
+        return;
+    }
+
+    auto scale = rect.width() / textureRect.width();
+    if (!SkScalarNearlyEqual(scale, rect.height() / textureRect.height())) {
+        flushIfOverlapping(deviceBounds);
+        drawSpriteImage(drawAtlasSprite);
+        return;
+    }
+
+    auto& batch = resolveAtlasBatch(pageImage, deviceBounds);
+
+    // The batch is drawn in device coordinates, as the sprites might have been visited in different contexts
+    auto origin = matrix.mapXY(rect.left, rect.top);
+    batch.transforms.emplace_back(
+        SkRSXform::Make(matrix.getScaleX() * scale, matrix.getSkewY() * scale, origin.x(), origin.y()));
+    batch.textureRects.emplace_back(textureRect.getSkValue());
+    batch.colors.emplace_back(SkColorSetA(SK_ColorWHITE, static_cast<U8CPU>(drawAtlasSprite.opacity * 255.0f)));
+    batch.hasColors = batch.hasColors || drawAtlasSprite.opacity != 1.0f;
+    batch.bounds.join(deviceBounds);
+}
+
+DrawDisplayListVisitor::AtlasBatch& DrawDisplayListVisitor::resolveAtlasBatch(const sk_sp<SkImage>& pageImage,
+                                                                              const SkRect& deviceBounds) {
+    // The sprite can be moved into an earlier batch of its page, as long as it does not
+    // overlap anything drawn by the batches in between
+    auto index = _atlasBatches.size();
+    while (index > 0) {
+        index--;
+        auto& batch = _atlasBatches[index];
+
+        if (batch.pageImage == pageImage) {
+            return batch;
+        }
+
+        if (SkRect::Intersects(batch.bounds, deviceBounds)) {
+            break;
+        }
+    }
+
+    if (_atlasBatches.size() == kMaxAtlasBatchesCount) {
+        flush();
+    }
+
+    auto& batch = _atlasBatches.emplace_back();
+    batch.pageImage = pageImage;
+    return batch;
+}
+
+void DrawDisplayListVisitor::flushIfOverlapping(const SkRect& deviceBounds) {
+    for (const auto& batch : _atlasBatches) {
+        if (SkRect::Intersects(batch.bounds, deviceBounds)) {
+            flush();
+            return;
+        }
+    }
+}
+
+void DrawDisplayListVisitor::flush() {
+    if (_atlasBatches.empty()) {
+        return;
+    }
+
+    _canvas->save();
+    _canvas->resetMatrix();
+    for (const auto& batch : _atlasBatches) {
+        // The colors only carry the opacity of the sprites, modulating the alpha of the sampled pixels
+        _canvas->drawAtlas(batch.pageImage.get(),
+                           batch.transforms.data(),
+                           batch.textureRects.data(),
+                           batch.hasColors ? batch.colors.data() : nullptr,
+                           static_cast<int>(batch.transforms.size()),
+                           SkBlendMode::kModulate,
+                           SkSamplingOptions(SkFilterMode::kLinear),
+                           nullptr,
+                           nullptr);
+        _atlasDrawsCount++;
+    }
+    _canvas->restore();
+
+    _atlasBatches.clear();
+}
+
+size_t DrawDisplayListVisitor::getAtlasDrawsCount() const {
+    return _atlasDrawsCount;
+}
+
+void DrawDisplayListVisitor::setNeedsFlushOnPop() {
+    if (!_flushOnPopStack.empty()) {
+        _flushOnPopStack[_flushOnPopStack.size() - 1] = true;
+    }
+}
+
+void DrawDisplayListVisitor::drawSpriteImage(const Operations::DrawAtlasSprite& drawAtlasSprite) {
+    Paint paint;
+    paint.setAntiAlias(true);
+    paint.setAlpha(drawAtlasSprite.opacity);
+
+    _canvas->drawImageRect(drawAtlasSprite.sprite->getImage(),
+                           drawAtlasSprite.rect.getSkValue(),
+                           SkSamplingOptions(SkFilterMode::kLinear),
+                           &paint.getSkValue());
+}
+
 } // namespace snap::drawing
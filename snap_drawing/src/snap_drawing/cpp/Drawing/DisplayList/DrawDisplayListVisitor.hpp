@@ -8,18 +8,38 @@
 #pragma once
 
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayListOperations.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkRSXform.h"
+#include "include/core/SkRect.h"
+
+#include <vector>
 
 class SkCanvas;
 
 namespace snap::drawing {
 
 /**
- DisplayList visitor which draws into a canvas
+ DisplayList visitor which draws into a canvas.
+ Atlas sprites are batched per atlas page into drawAtlas() calls, which are deferred until
+ an operation could alter how the sprites composite, like changing the clip, compositing
+ a layer, or drawing content overlapping a batch. Operations are reordered only when their
+ device bounds do not overlap: a sprite can join the batch of its page if it does not
+ overlap the batches created after it, and pictures which do not overlap any batch are
+ drawn right away.
  */
 class DrawDisplayListVisitor {
 public:
     DrawDisplayListVisitor(SkCanvas* canvas, Scalar scaleX, Scalar scaleY);
 
+    /**
+     Set which DrawPicture operations, in visit order, should be skipped because
+     they are occluded. The vector must outlive the visit.
+     */
+    void setOccludedPictures(const std::vector<bool>* occludedPictures);
+
     void visit(const Operations::PushContext& pushContext);
 
     void visit(const Operations::PopContext& popContext);
@@ -36,11 +56,47 @@ public:
 
     void visit(const Operations::ApplyMask& applyMask);
 
+    void visit(const Operations::DrawAtlasSprite& drawAtlasSprite);
+
+    /**
+     Draw the atlas sprites batched so far. Must be called after visiting the operations.
+     */
+    void flush();
+
+    /**
+     Returns how many drawAtlas() calls were issued so far.
+     */
+    size_t getAtlasDrawsCount() const;
+
 private:
     SkCanvas* _canvas;
     Scalar _scaleX;
     Scalar _scaleY;
     Rect _tempRect;
+    const std::vector<bool>* _occludedPictures = nullptr;
+    size_t _pictureIndex = 0;
+
+    struct AtlasBatch {
+        sk_sp<SkImage> pageImage;
+        std::vector<SkRSXform> transforms;
+        std::vector<SkRect> textureRects;
+        std::vector<SkColor> colors;
+        // Union of the device bounds of the sprites
+        SkRect bounds = SkRect::MakeEmpty();
+        bool hasColors = false;
+    };
+
+    // Batches in draw order
+    std::vector<AtlasBatch> _atlasBatches;
+    size_t _atlasDrawsCount = 0;
+    // Whether the batches must be drawn before popping each context, because the pop
+    // restores a clip or composites a layer
+    Valdi::SmallVector<bool, 16> _flushOnPopStack;
+
+    void setNeedsFlushOnPop();
+    void flushIfOverlapping(const SkRect& deviceBounds);
+    AtlasBatch& resolveAtlasBatch(const sk_sp<SkImage>& pageImage, const SkRect& deviceBounds);
+    void drawSpriteImage(const Operations::DrawAtlasSprite& drawAtlasSprite);
 };
 
 } // namespace snap::drawing
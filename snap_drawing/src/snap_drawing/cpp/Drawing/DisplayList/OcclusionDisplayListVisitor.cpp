@@ -0,0 +1,159 @@
+#include "snap_drawing/cpp/Drawing/DisplayList/OcclusionDisplayListVisitor.hpp"
+
+#include "include/core/SkPicture.h"
+
+namespace snap::drawing {
+
+// Bounds the cost of the front to back pass, the largest occluders are kept
+constexpr size_t kMaxOccludersCount = 16;
+
+OcclusionDisplayListVisitor::OcclusionDisplayListVisitor(Scalar scaleX, Scalar scaleY)
+    : _scaleX(scaleX), _scaleY(scaleY) {
+    _contextStack.emplace_back(Context{SkMatrix::Scale(scaleX, scaleY), SkRect::MakeLargest(), true});
+}
+
+OcclusionDisplayListVisitor::~OcclusionDisplayListVisitor() = default;
+
+OcclusionDisplayListVisitor::Context& OcclusionDisplayListVisitor::getCurrentContext() {
+    return _contextStack[_contextStack.size() - 1];
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::PushContext& pushContext) {
+    auto context = getCurrentContext();
+
+    // Translations are snapped the same way DrawDisplayListVisitor does
+    auto matrix = pushContext.matrix;
+    matrix.setTranslateX(sanitizeScalarFromScale(matrix.getTranslateX(), _scaleX));
+    matrix.setTranslateY(sanitizeScalarFromScale(matrix.getTranslateY(), _scaleY));
+
+    context.matrix = SkMatrix::Concat(context.matrix, matrix.getSkValue());
+    // Contexts with an opacity are composited through a layer which lets the content below show through
+    context.canOcclude = context.canOcclude && pushContext.opacity == 1.0f;
+
+    _contextStack.emplace_back(context);
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::PopContext& /*popContext*/) {
+    _contextStack.pop_back();
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::DrawPicture& drawPicture) {
+    const auto& context = getCurrentContext();
+
+    auto& picture = _pictures.emplace_back();
+    picture.bounds = context.matrix.mapRect(drawPicture.picture->cullRect());
+    if (!picture.bounds.intersect(context.clipBounds)) {
+        picture.bounds.setEmpty();
+    }
+    picture.opaqueBounds.setEmpty();
+
+    if (!context.canOcclude || _masksDepth > 0 || drawPicture.opacity != 1.0f || drawPicture.opaqueRect.isEmpty() ||
+        !context.matrix.rectStaysRect()) {
+        return;
+    }
+
+    auto opaqueBounds = context.matrix.mapRect(drawPicture.opaqueRect.getSkValue());
+    if (!opaqueBounds.intersect(context.clipBounds)) {
+        return;
+    }
+
+    // Edges might be antialiased, or shifted by the snapping of translations
+    opaqueBounds.inset(1.0f, 1.0f);
+    if (!opaqueBounds.isEmpty()) {
+        picture.opaqueBounds = opaqueBounds;
+        _hasOccluders = true;
+    }
+}
+
+void OcclusionDisplayListVisitor::clip(Scalar width, Scalar height, bool isExact) {
+    auto& context = getCurrentContext();
+
+    auto clipBounds = context.matrix.mapRect(SkRect::MakeWH(width, height));
+    if (!context.clipBounds.intersect(clipBounds)) {
+        context.clipBounds.setEmpty();
+    }
+
+    if (!isExact || !context.matrix.rectStaysRect()) {
+        // clipBounds is now only an approximation of the clip, which can be used
+        // to cull pictures but not to resolve what the content inside can occlude
+        context.canOcclude = false;
+    }
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::ClipRect& clipRect) {
+    clip(clipRect.width, clipRect.height, true);
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::ClipRound& clipRound) {
+    clip(clipRound.width, clipRound.height, false);
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::DrawExternalSurface& /*drawExternalSurface*/) {}
+
+void OcclusionDisplayListVisitor::visit(const Operations::PrepareMask& /*prepareMask*/) {
+    _masksDepth++;
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::ApplyMask& /*applyMask*/) {
+    if (_masksDepth > 0) {
+        _masksDepth--;
+    }
+}
+
+void OcclusionDisplayListVisitor::visit(const Operations::DrawAtlasSprite& /*drawAtlasSprite*/) {}
+
+std::vector<bool> OcclusionDisplayListVisitor::resolveOccludedPictures() const {
+    if (!_hasOccluders) {
+        return {};
+    }
+
+    std::vector<bool> occludedPictures(_pictures.size(), false);
+    Valdi::SmallVector<SkRect, kMaxOccludersCount> occluders;
+    auto hasOccludedPictures = false;
+
+    // Front to back, the occluders are the opaque pictures drawn after the current one
+    for (size_t i = _pictures.size(); i > 0; i--) {
+        const auto& picture = _pictures[i - 1];
+
+        auto isOccluded = picture.bounds.isEmpty();
+        for (size_t j = 0; !isOccluded && j < occluders.size(); j++) {
+            isOccluded = occluders[j].contains(picture.bounds);
+        }
+
+        if (isOccluded) {
+            occludedPictures[i - 1] = true;
+            hasOccludedPictures = true;
+            continue;
+        }
+
+        if (picture.opaqueBounds.isEmpty()) {
+            continue;
+        }
+
+        if (occluders.size() < kMaxOccludersCount) {
+            occluders.emplace_back(picture.opaqueBounds);
+            continue;
+        }
+
+        size_t smallestIndex = 0;
+        for (size_t j = 1; j < occluders.size(); j++) {
+            if (occluders[j].width() * occluders[j].height() <
+                occluders[smallestIndex].width() * occluders[smallestIndex].height()) {
+                smallestIndex = j;
+            }
+        }
+
+        const auto& smallest = occluders[smallestIndex];
+        if (picture.opaqueBounds.width() * picture.opaqueBounds.height() > smallest.width() * smallest.height()) {
+            occluders[smallestIndex] = picture.opaqueBounds;
+        }
+    }
+
+    if (!hasOccludedPictures) {
+        return {};
+    }
+
+    return occludedPictures;
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayListOperations.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkRect.h"
+
+#include <vector>
+
+namespace snap::drawing {
+
+/**
+ DisplayList visitor which resolves the DrawPicture operations that are fully covered
+ by opaque pictures drawn after them, so that drawing them can be skipped.
+ The visitor collects the absolute bounds of the pictures while visiting, using the same
+ transforms as DrawDisplayListVisitor. resolveOccludedPictures() then walks the pictures
+ front to back. A picture only occludes when its opaque rect is known, and when it is not
+ drawn within a context with an opacity, a rounded or non axis aligned clip, or a mask.
+ */
+class OcclusionDisplayListVisitor {
+public:
+    OcclusionDisplayListVisitor(Scalar scaleX, Scalar scaleY);
+    ~OcclusionDisplayListVisitor();
+
+    void visit(const Operations::PushContext& pushContext);
+
+    void visit(const Operations::PopContext& popContext);
+
+    void visit(const Operations::DrawPicture& drawPicture);
+
+    void visit(const Operations::ClipRect& clipRect);
+
+    void visit(const Operations::ClipRound& clipRound);
+
+    void visit(const Operations::DrawExternalSurface& drawExternalSurface);
+
+    void visit(const Operations::PrepareMask& prepareMask);
+
+    void visit(const Operations::ApplyMask& applyMask);
+
+    void visit(const Operations::DrawAtlasSprite& drawAtlasSprite);
+
+    /**
+     Returns whether each visited DrawPicture operation is occluded, in visit order.
+     Returns an empty vector if none of them are.
+     */
+    std::vector<bool> resolveOccludedPictures() const;
+
+private:
+    struct Context {
+        SkMatrix matrix;
+        SkRect clipBounds;
+        // Whether content drawn in this context is composited as is, such that opaque
+        // pictures fully replace the pixels below them within clipBounds
+        bool canOcclude;
+    };
+
+    struct Picture {
+        SkRect bounds;
+        SkRect opaqueBounds;
+    };
+
+    Scalar _scaleX;
+    Scalar _scaleY;
+    Valdi::SmallVector<Context, 16> _contextStack;
+    std::vector<Picture> _pictures;
+    size_t _masksDepth = 0;
+    bool _hasOccluders = false;
+
+    Context& getCurrentContext();
+    void clip(Scalar width, Scalar height, bool isExact);
+};
+
+} // namespace snap::drawing
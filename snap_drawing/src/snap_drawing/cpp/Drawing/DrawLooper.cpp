@@ -9,9 +9,14 @@
 #include "snap_drawing/cpp/Drawing/DrawOperation.hpp"
 #include "utils/debugging/Assert.hpp"
 
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
+#include <algorithm>
+
 namespace snap::drawing {
 
 /**
@@ -26,6 +31,12 @@ static constexpr size_t kMaxGpuCacheSize = 128 * 1024 * 1024;
 static constexpr size_t kMaxGpuCacheSizeInBackground = kMaxGpuCacheSize / 4;
 static constexpr std::chrono::seconds kCacheExpirationSeconds = std::chrono::seconds(10);
 
+/**
+ Frame rate hinted to the FrameScheduler while the only pending work are events
+ which are at least that far apart, like the frames of a spinner.
+ */
+static constexpr Scalar kThrottledFrameRate = 30;
+
 class DrawLooperFrameCallback : public IFrameCallback {
 public:
     explicit DrawLooperFrameCallback(DrawLooper* looper) : _drawLooper(Valdi::strongSmallRef(looper)) {}
@@ -53,6 +64,19 @@ public:
     }
 };
 
+class DelayedProcessFramesCallback : public DrawLooperFrameCallback {
+public:
+    DelayedProcessFramesCallback(DrawLooper* looper, TimePoint wakeUpTime)
+        : DrawLooperFrameCallback(looper), _wakeUpTime(wakeUpTime) {}
+
+    void onFrame(TimePoint time) override {
+        _drawLooper->processDelayedFrames(time, _wakeUpTime);
+    }
+
+private:
+    TimePoint _wakeUpTime;
+};
+
 class PerformCleanupCallback : public DrawLooperFrameCallback {
 public:
     PerformCleanupCallback(DrawLooper* looper, DrawLooper::CleanUpMode cleanUpMode)
@@ -96,6 +120,8 @@ void DrawLooper::addLayerRoot(const Ref<LayerRoot>& layerRoot,
 
     {
         auto lock = getEntriesLock();
+        entry->setResolvesDamageOnDrawThread(_resolvesDamageOnDrawThread);
+        entry->setRecordsPlanesInParallel(_recordsPlanesInParallel);
         SC_ASSERT(getEntryForLayer(*layerRoot) == nullptr);
 
         _entries.emplace_back(entry);
@@ -106,6 +132,16 @@ void DrawLooper::addLayerRoot(const Ref<LayerRoot>& layerRoot,
     layerRoot->setChildNeedsDisplay();
 }
 
+void DrawLooper::setResolvesDamageOnDrawThread(bool resolvesDamageOnDrawThread) {
+    auto lock = getEntriesLock();
+    _resolvesDamageOnDrawThread = resolvesDamageOnDrawThread;
+}
+
+void DrawLooper::setRecordsPlanesInParallel(bool recordsPlanesInParallel) {
+    auto lock = getEntriesLock();
+    _recordsPlanesInParallel = recordsPlanesInParallel;
+}
+
 void DrawLooper::removeLayerRoot(const Ref<LayerRoot>& layerRoot) {
     Ref<DrawLooperEntry> entry;
     auto drawLock = getDrawLock();
@@ -274,7 +310,17 @@ DrawOperationsBatch DrawLooper::collectDrawOperations() {
     return drawOperations;
 }
 
+static const Valdi::StringBox& getFrameMetricsModuleName() {
+    static auto kModuleName = STRING_LITERAL("SnapDrawing");
+    return kModuleName;
+}
+
 void DrawLooper::drawOperationsBatch(const DrawOperationsBatch& drawOperations) {
+    auto& startupTimeline = Valdi::StartupTimeline::shared();
+    auto isRecordingStartup = startupTimeline.isRecording();
+    auto startupDrawStartTime =
+        isRecordingStartup ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
     Valdi::SmallVector<GraphicsContext*, 2> graphicsContexts;
 
     for (const auto& drawOperation : drawOperations) {
@@ -294,12 +340,29 @@ void DrawLooper::drawOperationsBatch(const DrawOperationsBatch& drawOperations)
         }
     }
 
+    auto& frameMetricsAggregator = Valdi::FrameMetricsAggregator::shared();
+    auto gpuFrameTimingEnabled = frameMetricsAggregator.isEnabled();
     for (auto* graphicsContext : graphicsContexts) {
         graphicsContext->commit();
+
+        // The GPU timings are only measured while frame metrics are collected
+        graphicsContext->setGPUFrameTimingEnabled(gpuFrameTimingEnabled);
+        for (const auto& timing : graphicsContext->consumeGPUFrameTimings()) {
+            frameMetricsAggregator.recordGPUFrame(getFrameMetricsModuleName(), timing);
+        }
+    }
+
+    if (isRecordingStartup && !graphicsContexts.empty()) {
+        auto startupDrawEndTime = std::chrono::steady_clock::now();
+        startupTimeline.recordSpan(
+            Valdi::StartupSpanType::Draw, Valdi::StringBox(), startupDrawStartTime, startupDrawEndTime);
+        startupTimeline.markMilestone(Valdi::StartupMilestone::FirstDraw, startupDrawEndTime);
     }
 }
 
 void DrawLooper::drawFrames(TimePoint /*time*/) {
+    Valdi::ScopedFrameMetrics frameMetrics(
+        Valdi::FrameMetricsAggregator::shared(), getFrameMetricsModuleName(), Valdi::FramePhase::Raster);
     auto drawLock = getDrawLock();
     auto drawOperations = collectDrawOperations();
     drawOperationsBatch(drawOperations);
@@ -317,6 +380,8 @@ void DrawLooper::drawFrames(TimePoint /*time*/) {
 }
 
 void DrawLooper::processFrames(TimePoint time) {
+    Valdi::ScopedFrameMetrics frameMetrics(
+        Valdi::FrameMetricsAggregator::shared(), getFrameMetricsModuleName(), Valdi::FramePhase::Draw);
     _processingFrames = true;
 
     while (processFrameForNextLayer(time)) {
@@ -324,11 +389,18 @@ void DrawLooper::processFrames(TimePoint time) {
 
     bool needScheduleDraw = false;
     bool needScheduleProcessFrame = false;
+    std::optional<TimePoint> nextWakeUpTime;
     auto entriesLock = getEntriesLock();
 
     for (const auto& it : _entries) {
-        if (it->getLayerRoot()->needsProcessFrame()) {
+        const auto& layerRoot = it->getLayerRoot();
+        if (layerRoot->needsProcessFrameAtTime(time)) {
             needScheduleProcessFrame = true;
+        } else {
+            auto nextEventTime = layerRoot->getNextEventAbsoluteTime();
+            if (nextEventTime && (!nextWakeUpTime || nextEventTime.value() < nextWakeUpTime.value())) {
+                nextWakeUpTime = nextEventTime;
+            }
         }
         if (it->getDrawState().needsDraw) {
             needScheduleDraw = true;
@@ -339,7 +411,15 @@ void DrawLooper::processFrames(TimePoint time) {
     _processFrameScheduled = false;
 
     if (needScheduleProcessFrame) {
+        updatePreferredFrameRate(0);
         doScheduleProcessFrame();
+    } else if (nextWakeUpTime) {
+        // Nothing is due before the next event, the FrameScheduler can idle until then
+        auto delay = nextWakeUpTime.value() - time;
+        updatePreferredFrameRate(delay >= Duration(1.0 / kThrottledFrameRate) - LayerRoot::kEventCoalescingWindow ?
+                                     kThrottledFrameRate :
+                                     0);
+        scheduleDelayedProcessFrame(nextWakeUpTime.value(), time);
     }
 
     if (needScheduleDraw && !_drawScheduled && !_inBackground) {
@@ -347,6 +427,25 @@ void DrawLooper::processFrames(TimePoint time) {
     }
 }
 
+void DrawLooper::processDelayedFrames(TimePoint time, TimePoint wakeUpTime) {
+    {
+        auto entriesLock = getEntriesLock();
+        if (_scheduledWakeUpTime != wakeUpTime) {
+            // Superseded by an earlier wake up
+            return;
+        }
+        _scheduledWakeUpTime = std::nullopt;
+
+        if (_processingFrames || _processFrameScheduled) {
+            // The frames are already going to be processed
+            return;
+        }
+        _processFrameScheduled = true;
+    }
+
+    processFrames(time);
+}
+
 void DrawLooper::performCleanup(DrawLooper::CleanUpMode cleanUpMode) {
     for (const auto& managedGraphicsContext : _managedGraphicsContexts) {
         switch (cleanUpMode) {
@@ -385,10 +484,31 @@ void DrawLooper::scheduleProcessFrame(EntriesLock& entriesLock) {
     if (_processingFrames || _processFrameScheduled) {
         return;
     }
+    // Updates like touches should not wait for a throttled VSYNC
+    updatePreferredFrameRate(0);
     doScheduleProcessFrame();
     entriesLock.unlock();
 }
 
+void DrawLooper::scheduleDelayedProcessFrame(TimePoint wakeUpTime, TimePoint currentTime) {
+    if (_scheduledWakeUpTime && _scheduledWakeUpTime.value() <= wakeUpTime) {
+        return;
+    }
+    _scheduledWakeUpTime = {wakeUpTime};
+
+    // Events due within the coalescing window of a frame are processed with it
+    auto delay = std::max(Duration(), (wakeUpTime - currentTime) - LayerRoot::kEventCoalescingWindow);
+    _frameScheduler->onMainThreadAfter(Valdi::makeShared<DelayedProcessFramesCallback>(this, wakeUpTime), delay);
+}
+
+void DrawLooper::updatePreferredFrameRate(Scalar frameRate) {
+    if (_preferredFrameRate == frameRate) {
+        return;
+    }
+    _preferredFrameRate = frameRate;
+    _frameScheduler->setPreferredFrameRate(frameRate);
+}
+
 void DrawLooper::scheduleDraw(EntriesLock& entriesLock) {
     if (_drawScheduled) {
         return;
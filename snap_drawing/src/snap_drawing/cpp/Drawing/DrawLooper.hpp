@@ -16,6 +16,7 @@
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 
+#include <optional>
 #include <vector>
 
 namespace snap::drawing {
@@ -24,6 +25,7 @@ using EntriesLock = std::unique_lock<std::recursive_mutex>;
 using DrawLock = std::unique_lock<std::recursive_mutex>;
 using DrawOperationsBatch = Valdi::SmallVector<Ref<DrawOperation>, 8>;
 
+class DelayedProcessFramesCallback;
 class PerformCleanupCallback;
 class ConfigureCacheSizeCallback;
 
@@ -37,6 +39,12 @@ class ConfigureCacheSizeCallback;
  gestures, or any external updates to the Layer tree. The FrameScheduler can dequeue those
  callbacks as fast it wants.
 
+ When the LayerRoots only have events scheduled later on, like timers or animations running below
+ the display rate, the DrawLooper instead enqueues a single delayed callback into the main thread for the
+ earliest of them, so that the FrameScheduler can idle in between. Events due around the same time are
+ processed in the same frame. The FrameScheduler is also hinted to lower its frame rate while the events
+ are far enough apart.
+
  Similarly, the DrawLooper will keep enqueueing callbacks into the draw thread on VSync as long
  as there are pending frames to be dequeued.
 
@@ -70,6 +78,22 @@ public:
                       const Ref<SurfacePresenterManager>& surfacePresenterManager,
                       bool disallowSynchronousDraw);
 
+    /**
+     Set whether the damage of the DisplayLists emitted by the LayerRoots added from now on
+     should be resolved on the draw thread instead of the main thread. The main thread then only
+     produces the DisplayLists, the entries hold up to 3 of them until they are drawn.
+     Disabled by default.
+     */
+    void setResolvesDamageOnDrawThread(bool resolvesDamageOnDrawThread);
+
+    /**
+     Set whether the LayerRoots added from now on which are presented in more than one drawable
+     surface should have the planes of their DisplayLists recorded concurrently on the shared
+     ThreadPool, leaving only the replay and submission of the recorded pictures to the draw thread.
+     This requires the content of the layers to be safe to draw concurrently. Disabled by default.
+     */
+    void setRecordsPlanesInParallel(bool recordsPlanesInParallel);
+
     /**
      Remove a LayerRoot from the looper, which will stop the looper from calling LayerRoot::processFrame()
      and will remove all previously created presenters.
@@ -159,6 +183,7 @@ protected:
     SurfacePresenterId createSurfacePresenterId() override;
 
 private:
+    friend DelayedProcessFramesCallback;
     friend PerformCleanupCallback;
     friend ConfigureCacheSizeCallback;
 
@@ -177,8 +202,12 @@ private:
     SurfacePresenterId _surfacePresenterIdSequence = 0;
     bool _processingFrames = false;
     bool _processFrameScheduled = false;
+    std::optional<TimePoint> _scheduledWakeUpTime;
+    Scalar _preferredFrameRate = 0;
     bool _drawScheduled = false;
     bool _inBackground = false;
+    bool _resolvesDamageOnDrawThread = false;
+    bool _recordsPlanesInParallel = false;
 
     Ref<DrawLooperEntry> getEntryForLayer(LayerRoot& layerRoot) const;
     Ref<DrawLooperEntry> mustGetEntryForLayer(LayerRoot& layerRoot) const;
@@ -187,6 +216,9 @@ private:
 
     void scheduleDraw(EntriesLock& entriesLock);
     void scheduleProcessFrame(EntriesLock& entriesLock);
+    void scheduleDelayedProcessFrame(TimePoint wakeUpTime, TimePoint currentTime);
+    void processDelayedFrames(TimePoint time, TimePoint wakeUpTime);
+    void updatePreferredFrameRate(Scalar frameRate);
     void schedulePerformCleanup(CleanUpMode cleanUpMode);
 
     void doScheduleDraw();
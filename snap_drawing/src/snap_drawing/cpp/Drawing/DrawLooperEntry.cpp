@@ -12,10 +12,17 @@
 
 namespace snap::drawing {
 
+// Display lists held while waiting for the draw thread, beyond which the oldest ones
+// are dropped and the next draw redraws the whole surface
+constexpr size_t kMaxUndrawnDisplayListsCount = 3;
+
 DrawLooperEntry::DrawLooperEntry(const Ref<LayerRoot>& layerRoot,
                                  const Ref<SurfacePresenterManager>& surfacePresenterManager,
                                  DrawLooperEntryListener* listener)
-    : _layerRoot(layerRoot), _surfacePresenterManager(surfacePresenterManager), _listener(listener) {}
+    : _layerRoot(layerRoot),
+      _surfacePresenterManager(surfacePresenterManager),
+      _listener(listener),
+      _damageTracker(Valdi::makeShared<RasterDamageTracker>()) {}
 
 DrawLooperEntry::~DrawLooperEntry() = default;
 
@@ -40,22 +47,77 @@ DrawLooperEntryDrawState DrawLooperEntry::getDrawState() const {
 }
 
 bool DrawLooperEntry::needsProcessFrameAtTime(TimePoint frameTime) const {
-    return _layerRoot->needsProcessFrame() &&
+    return _layerRoot->needsProcessFrameAtTime(frameTime) &&
            (!_layerRoot->getLastAbsoluteFrameTime() || _layerRoot->getLastAbsoluteFrameTime().value() != frameTime);
 }
 
 void DrawLooperEntry::enqueueDisplayList(const Ref<DisplayList>& displayList) {
     _displayList = displayList;
+
+    if (displayList == nullptr) {
+        return;
+    }
+
+    if (!_resolvesDamageOnDrawThread) {
+        _damageTracker->trackDamage(*displayList, surfaceSupportsPartialRedraw());
+        return;
+    }
+
+    if (_undrawnDisplayLists.size() == kMaxUndrawnDisplayListsCount) {
+        // The damage of the dropped display list can no longer be resolved
+        _undrawnDisplayLists.erase(_undrawnDisplayLists.begin());
+        _needsResetDamage = true;
+    }
+    _undrawnDisplayLists.emplace_back(displayList);
+}
+
+bool DrawLooperEntry::surfaceSupportsPartialRedraw() const {
+    if (_surfacePresenters.size() != 1) {
+        return false;
+    }
+
+    auto* drawableSurface = _surfacePresenters[0].getDrawableSurface();
+    return drawableSurface != nullptr && drawableSurface->supportsPartialRedraw();
+}
+
+void DrawLooperEntry::invalidateDamage() {
+    if (_resolvesDamageOnDrawThread) {
+        // The tracker is owned by the draw thread
+        _needsInvalidateDamage = true;
+    } else {
+        _damageTracker->invalidate();
+    }
+}
+
+void DrawLooperEntry::setResolvesDamageOnDrawThread(bool resolvesDamageOnDrawThread) {
+    if (_resolvesDamageOnDrawThread != resolvesDamageOnDrawThread) {
+        _resolvesDamageOnDrawThread = resolvesDamageOnDrawThread;
+        _undrawnDisplayLists.clear();
+        _needsInvalidateDamage = false;
+        _needsResetDamage = false;
+        _damageTracker = Valdi::makeShared<RasterDamageTracker>();
+    }
+}
+
+void DrawLooperEntry::setRecordsPlanesInParallel(bool recordsPlanesInParallel) {
+    _recordsPlanesInParallel = recordsPlanesInParallel;
 }
 
 Ref<DrawOperation> DrawLooperEntry::makeDrawOperation(bool shouldSwapToNextFrame) {
     SurfacePresenterList surfacePresenters;
+    std::optional<std::vector<Rect>> damageRects;
+    std::optional<DeferredDamage> deferredDamage;
 
     if (shouldSwapToNextFrame) {
         if (_displayList != nullptr) {
             auto frameTime = _displayList->getFrameTime();
             for (auto& presenter : _surfacePresenters) {
                 if (presenter.needsDrawForFrameTime(frameTime)) {
+                    if (!presenter.getLastDrawnFrameTime()) {
+                        // The presenter was explicitly invalidated
+                        invalidateDamage();
+                    }
+
                     presenter.setLastDrawnFrameTime({frameTime});
                     presenter.setNeedsSynchronousDraw(false);
 
@@ -63,12 +125,36 @@ Ref<DrawOperation> DrawLooperEntry::makeDrawOperation(bool shouldSwapToNextFrame
                     presenterToDraw = presenter;
                 }
             }
+
+            if (surfacePresenters.size() > 0) {
+                if (_resolvesDamageOnDrawThread) {
+                    auto& damage = deferredDamage.emplace();
+                    damage.tracker = _damageTracker;
+                    damage.displayLists = std::move(_undrawnDisplayLists);
+                    damage.shouldReset = _needsResetDamage;
+                    damage.shouldInvalidate = _needsInvalidateDamage;
+                    damage.surfaceSupportsPartialRedraw = surfaceSupportsPartialRedraw();
+
+                    _undrawnDisplayLists = std::vector<Ref<DisplayList>>();
+                    _needsResetDamage = false;
+                    _needsInvalidateDamage = false;
+                } else {
+                    damageRects = _damageTracker->takeDamageRects();
+                }
+            }
         }
     } else {
         surfacePresenters = _surfacePresenters;
     }
 
-    return Valdi::makeShared<DrawOperation>(_displayList, _surfacePresenterManager, std::move(surfacePresenters));
+    auto drawOperation = Valdi::makeShared<DrawOperation>(
+        _displayList, _surfacePresenterManager, std::move(surfacePresenters), std::move(damageRects));
+    if (deferredDamage) {
+        drawOperation->setDeferredDamage(std::move(deferredDamage.value()));
+    }
+    drawOperation->setRecordsPlanesInParallel(_recordsPlanesInParallel);
+
+    return drawOperation;
 }
 
 const Ref<LayerRoot>& DrawLooperEntry::getLayerRoot() const {
@@ -114,6 +200,7 @@ bool DrawLooperEntry::setPresenterNeedsDraw(SurfacePresenterId id) {
     }
 
     presenter->setLastDrawnFrameTime(std::nullopt);
+    invalidateDamage();
 
     return true;
 }
@@ -131,6 +218,8 @@ void DrawLooperEntry::updateSurfacePresenters(const CompositorPlaneList& planeLi
     size_t displayListPlaneIndex = 0;
     bool needSynchronousDraw = false;
 
+    invalidateDamage();
+
     for (size_t i = 0; i < newPlanesCount; i++) {
         const auto& plane = planeList.getPlaneAtIndex(i);
         updateSurfaceForPlane(plane, i, &needSynchronousDraw, &displayListPlaneIndex);
@@ -167,6 +256,7 @@ bool DrawLooperEntry::setDrawableSurfaceForPresenterId(SurfacePresenterId id,
     if (surfacePresenter->getDrawableSurface() != drawableSurface.get()) {
         surfacePresenter->setSurface(drawableSurface.get());
         surfacePresenter->setLastDrawnFrameTime(std::nullopt);
+        invalidateDamage();
     }
 
     return true;
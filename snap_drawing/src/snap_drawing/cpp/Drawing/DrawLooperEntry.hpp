@@ -8,11 +8,14 @@
 #pragma once
 
 #include "snap_drawing/cpp/Drawing/Composition/CompositorPlaneList.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/RasterDamageTracker.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurface.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterList.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterManager.hpp"
 #include "snap_drawing/cpp/Layers/LayerRoot.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include <memory>
+#include <optional>
 
 namespace snap::drawing {
 
@@ -49,6 +52,11 @@ struct DrawLooperEntryDrawState {
  The entry manages the presenters for the LayerRoot. It will call into the
  SurfacePresenterManager to create or update presenters when needed.
  The entry holds the display list that should be drawn next into the presenter.
+ When the LayerRoot is presented in a single surface that supports partial redraw, the entry
+ also accumulates the damage of the enqueued display lists since the last draw, so that only
+ the regions that changed are redrawn. The damage is resolved when enqueueing the display lists,
+ or on the draw thread when setResolvesDamageOnDrawThread() is enabled, in which case the entry
+ holds the display lists enqueued since the last draw.
  */
 class DrawLooperEntry : public Valdi::SimpleRefCountable, public LayerRootListener {
 public:
@@ -63,6 +71,18 @@ public:
 
     void setDisallowSynchronousDraw(bool disallowSynchronousDraw);
 
+    /**
+     Set whether the damage of the enqueued display lists should be resolved by the draw
+     operations on the draw thread, instead of when enqueueing them on the main thread.
+     */
+    void setResolvesDamageOnDrawThread(bool resolvesDamageOnDrawThread);
+
+    /**
+     Set whether the draw operations should record the planes of the display list concurrently
+     when drawing into more than one surface.
+     */
+    void setRecordsPlanesInParallel(bool recordsPlanesInParallel);
+
     void enqueueDisplayList(const Ref<DisplayList>& displayList);
 
     Ref<DrawOperation> makeDrawOperation(bool shouldSwapToNextFrame);
@@ -88,6 +108,17 @@ private:
     SurfacePresenterList _surfacePresenters;
     Ref<DisplayList> _displayList;
     bool _disallowSynchronousDraw = false;
+    bool _resolvesDamageOnDrawThread = false;
+    bool _recordsPlanesInParallel = false;
+    Ref<RasterDamageTracker> _damageTracker;
+    // Display lists enqueued since the last draw, when the damage is resolved on the draw thread
+    std::vector<Ref<DisplayList>> _undrawnDisplayLists;
+    // Invalidations of the damage tracker to apply on the draw thread
+    bool _needsInvalidateDamage = false;
+    bool _needsResetDamage = false;
+
+    bool surfaceSupportsPartialRedraw() const;
+    void invalidateDamage();
 
     void updateSurfaceForPlane(const CompositorPlane& plane,
                                size_t zIndex,
@@ -7,17 +7,23 @@
 
 #include "snap_drawing/cpp/Drawing/DrawOperation.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterManager.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
+#include "include/core/SkCanvas.h"
+#include "include/core/SkRegion.h"
+
 namespace snap::drawing {
 
 DrawOperation::DrawOperation(const Ref<DisplayList>& displayList,
                              const Ref<SurfacePresenterManager>& surfacePresenterManager,
-                             SurfacePresenterList&& surfacePresenters)
+                             SurfacePresenterList&& surfacePresenters,
+                             std::optional<std::vector<Rect>>&& damageRects)
     : _displayList(displayList),
       _surfacePresenterManager(surfacePresenterManager),
       _surfacePresenters(std::move(surfacePresenters)),
-      _current(_surfacePresenters.begin()) {
+      _current(_surfacePresenters.begin()),
+      _damageRects(std::move(damageRects)) {
     advance();
 }
 
@@ -34,7 +40,37 @@ bool DrawOperation::drawForPresenterId(SurfacePresenterId presenterId, DrawableS
     return true;
 }
 
+void DrawOperation::setDeferredDamage(DeferredDamage&& deferredDamage) {
+    _deferredDamage = std::move(deferredDamage);
+}
+
+void DrawOperation::setRecordsPlanesInParallel(bool recordsPlanesInParallel) {
+    _recordsPlanesInParallel = recordsPlanesInParallel;
+}
+
+void DrawOperation::resolveDeferredDamage() {
+    auto& deferredDamage = _deferredDamage.value();
+    auto& tracker = *deferredDamage.tracker;
+
+    if (deferredDamage.shouldReset) {
+        tracker.reset();
+    } else if (deferredDamage.shouldInvalidate) {
+        tracker.invalidate();
+    }
+
+    for (const auto& displayList : deferredDamage.displayLists) {
+        tracker.trackDamage(*displayList, deferredDamage.surfaceSupportsPartialRedraw);
+    }
+
+    _damageRects = tracker.takeDamageRects();
+    _deferredDamage = std::nullopt;
+}
+
 Valdi::Result<snap::drawing::GraphicsContext*> DrawOperation::drawNext() {
+    if (_deferredDamage) {
+        resolveDeferredDamage();
+    }
+
     const auto& surfacePresenter = *_current;
     _current++;
 
@@ -46,6 +82,11 @@ Valdi::Result<snap::drawing::GraphicsContext*> DrawOperation::drawNext() {
         return nullptr;
     }
 
+    if (_damageRects && _damageRects.value().empty()) {
+        // Nothing changed since the last frame that was presented
+        return drawableSurface->getGraphicsContext();
+    }
+
     VALDI_TRACE("SnapDrawing.drawSurface");
 
     auto canvasResult = drawableSurface->prepareCanvas();
@@ -54,15 +95,46 @@ Valdi::Result<snap::drawing::GraphicsContext*> DrawOperation::drawNext() {
         return canvasResult.error().rethrow("Failed to prepare canvas on GraphicsContext");
     }
 
+    auto& canvas = canvasResult.value();
     auto displayListSize = _displayList->getSize();
-    auto scaleX = static_cast<Scalar>(canvasResult.value().getWidth()) / displayListSize.width;
-    auto scaleY = static_cast<Scalar>(canvasResult.value().getHeight()) / displayListSize.height;
+    auto scaleX = static_cast<Scalar>(canvas.getWidth()) / displayListSize.width;
+    auto scaleY = static_cast<Scalar>(canvas.getHeight()) / displayListSize.height;
+
+    auto redrawRects = drawableSurface->resolveRedrawRects(canvas, resolveCanvasDamageRects(canvas, scaleX, scaleY));
+
+    auto* skiaCanvas = canvas.getSkiaCanvas();
+    auto saveCount = skiaCanvas->save();
+
+    if (redrawRects.size() != 1 || redrawRects[0] != Rect::makeXYWH(0,
+                                                                     0,
+                                                                     static_cast<Scalar>(canvas.getWidth()),
+                                                                     static_cast<Scalar>(canvas.getHeight()))) {
+        VALDI_TRACE("SnapDrawing.drawSurfacePartially");
+        SkRegion redrawRegion;
+        for (const auto& redrawRect : redrawRects) {
+            redrawRegion.op(redrawRect.getSkValue().roundOut(), SkRegion::kUnion_Op);
+        }
+        skiaCanvas->clipRegion(redrawRegion);
+    }
+
+    if (_recordsPlanesInParallel && !_didRecordPlanes) {
+        // The surfaces of a LayerRoot are all sized from it, the first canvas gives the size of the others
+        _didRecordPlanes = true;
+        recordPlanes(&surfacePresenter, canvas.getWidth(), canvas.getHeight());
+    }
+
+    auto* recordedPlane = getRecordedPlane(surfacePresenter.getId(), canvas.getWidth(), canvas.getHeight());
+    if (recordedPlane != nullptr) {
+        skiaCanvas->drawPicture(recordedPlane);
+    } else {
+        _displayList->draw(canvas,
+                           surfacePresenter.getDisplayListPlaneIndex(),
+                           scaleX,
+                           scaleY,
+                           /* shouldClearCanvas */ true);
+    }
 
-    _displayList->draw(canvasResult.value(),
-                       surfacePresenter.getDisplayListPlaneIndex(),
-                       scaleX,
-                       scaleY,
-                       /* shouldClearCanvas */ true);
+    skiaCanvas->restoreToCount(saveCount);
 
     drawableSurface->flush();
 
@@ -75,6 +147,66 @@ bool DrawOperation::hasNext() {
     return _current != _surfacePresenters.end();
 }
 
+std::vector<Rect> DrawOperation::resolveCanvasDamageRects(const DrawableSurfaceCanvas& canvas,
+                                                          Scalar scaleX,
+                                                          Scalar scaleY) const {
+    if (!_damageRects) {
+        return {Rect::makeXYWH(0, 0, static_cast<Scalar>(canvas.getWidth()), static_cast<Scalar>(canvas.getHeight()))};
+    }
+
+    std::vector<Rect> canvasDamageRects;
+    canvasDamageRects.reserve(_damageRects.value().size());
+    for (const auto& damageRect : _damageRects.value()) {
+        canvasDamageRects.emplace_back(Rect::makeLTRB(
+            damageRect.left * scaleX, damageRect.top * scaleY, damageRect.right * scaleX, damageRect.bottom * scaleY));
+    }
+
+    return canvasDamageRects;
+}
+
+void DrawOperation::recordPlanes(const SurfacePresenter* firstPresenter, int width, int height) {
+    std::vector<const SurfacePresenter*> presenters;
+    for (const auto* it = firstPresenter; it != _surfacePresenters.end(); it++) {
+        if (it->isDrawable() && it->getDrawableSurface() != nullptr) {
+            presenters.emplace_back(it);
+        }
+    }
+
+    if (presenters.size() < 2) {
+        // Nothing to draw concurrently, recording would only add a replay
+        return;
+    }
+
+    VALDI_TRACE("SnapDrawing.recordPlanes");
+
+    _recordedPlanes.resize(presenters.size());
+    _recordedPlanesWidth = width;
+    _recordedPlanesHeight = height;
+
+    Valdi::ThreadPool::getShared()->parallelFor(presenters.size(), presenters.size(), [&](size_t index) {
+        VALDI_TRACE("SnapDrawing.recordPlane");
+        const auto& presenter = *presenters[index];
+        auto& recordedPlane = _recordedPlanes[index];
+        recordedPlane.presenterId = presenter.getId();
+        recordedPlane.picture =
+            _displayList->recordPlane(presenter.getDisplayListPlaneIndex(), width, height, /* shouldClearCanvas */ true);
+    });
+}
+
+SkPicture* DrawOperation::getRecordedPlane(SurfacePresenterId presenterId, int width, int height) const {
+    if (width != _recordedPlanesWidth || height != _recordedPlanesHeight) {
+        return nullptr;
+    }
+
+    for (const auto& recordedPlane : _recordedPlanes) {
+        if (recordedPlane.presenterId == presenterId) {
+            return recordedPlane.picture.get();
+        }
+    }
+
+    return nullptr;
+}
+
 void DrawOperation::advance() {
     while (_current != _surfacePresenters.end() && !_current->isDrawable()) {
         _current++;
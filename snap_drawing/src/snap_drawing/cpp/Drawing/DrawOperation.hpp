@@ -8,21 +8,53 @@
 #pragma once
 
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/RasterDamageTracker.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/SurfacePresenterList.hpp"
+#include <optional>
+#include <vector>
 
 namespace snap::drawing {
 
 class SurfacePresenterManager;
 
+/**
+ The display lists enqueued since the last draw, from which the damage rects of a draw
+ operation are resolved on the draw thread.
+ */
+struct DeferredDamage {
+    Ref<RasterDamageTracker> tracker;
+    std::vector<Ref<DisplayList>> displayLists;
+    // Whether display lists were dropped since the last draw
+    bool shouldReset = false;
+    // Whether the surfaces were invalidated since the last draw
+    bool shouldInvalidate = false;
+    bool surfaceSupportsPartialRedraw = false;
+};
+
 class DrawOperation : public Valdi::SimpleRefCountable {
 public:
     DrawOperation(const Ref<DisplayList>& displayList,
                   const Ref<SurfacePresenterManager>& presenterManager,
-                  SurfacePresenterList&& surfacePresenters);
+                  SurfacePresenterList&& surfacePresenters,
+                  std::optional<std::vector<Rect>>&& damageRects = std::nullopt);
     ~DrawOperation() override;
 
     bool drawForPresenterId(SurfacePresenterId presenterId, DrawableSurfaceCanvas& canvas);
 
+    /**
+     Resolve the damage rects from the given display lists when drawing the operation,
+     instead of using the damage rects given at construction.
+     */
+    void setDeferredDamage(DeferredDamage&& deferredDamage);
+
+    /**
+     Set whether the planes of the display list should be recorded concurrently on the shared
+     ThreadPool when drawing more than one drawable surface. Only the replay of the recorded
+     pictures then happens on the draw thread. This requires the content of the display list
+     to be safe to draw concurrently.
+     */
+    void setRecordsPlanesInParallel(bool recordsPlanesInParallel);
+
     Valdi::Result<snap::drawing::GraphicsContext*> drawNext();
     bool hasNext();
 
@@ -31,8 +63,30 @@ private:
     Ref<SurfacePresenterManager> _surfacePresenterManager;
     SurfacePresenterList _surfacePresenters;
     const SurfacePresenter* _current;
+    // Damage in display list points since the last draw, or std::nullopt if the surfaces
+    // must be entirely redrawn.
+    std::optional<std::vector<Rect>> _damageRects;
+    std::optional<DeferredDamage> _deferredDamage;
+
+    struct RecordedPlane {
+        SurfacePresenterId presenterId;
+        sk_sp<SkPicture> picture;
+    };
+
+    // Pictures of the planes recorded for canvases of the given size
+    std::vector<RecordedPlane> _recordedPlanes;
+    int _recordedPlanesWidth = 0;
+    int _recordedPlanesHeight = 0;
+    bool _recordsPlanesInParallel = false;
+    bool _didRecordPlanes = false;
 
     void advance();
+    void resolveDeferredDamage();
+
+    void recordPlanes(const SurfacePresenter* firstPresenter, int width, int height);
+    SkPicture* getRecordedPlane(SurfacePresenterId presenterId, int width, int height) const;
+
+    std::vector<Rect> resolveCanvasDamageRects(const DrawableSurfaceCanvas& canvas, Scalar scaleX, Scalar scaleY) const;
 };
 
 } // namespace snap::drawing
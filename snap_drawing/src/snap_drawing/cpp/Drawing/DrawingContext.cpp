@@ -29,6 +29,11 @@ LayerContent DrawingContext::finish() {
         content.picture = _recorder.finishRecordingAsPicture();
     }
 
+    if (_atlasSprite != nullptr) {
+        content.atlasSprite = std::move(_atlasSprite);
+        content.atlasSpriteRect = _atlasSpriteRect;
+    }
+
     return content;
 }
 
@@ -75,6 +80,21 @@ void DrawingContext::drawBitmap(const Valdi::Ref<Valdi::IBitmap>& bitmap, Fittin
 }
 
 void DrawingContext::drawImage(const Image& image, const Rect& imageRect, const Rect& targetRect, const Paint* paint) {
+    const auto& picture = image.getPicture();
+    if (picture != nullptr) {
+        // Vector images are drawn from their picture at the target scale, mapping the image rect
+        // from image coordinates back into the coordinates the picture was recorded in
+        auto cullRect = picture->cullRect();
+        auto toPicture = SkMatrix::RectToRect(SkRect::MakeIWH(image.width(), image.height()), cullRect);
+        auto matrix = SkMatrix::RectToRect(toPicture.mapRect(imageRect.getSkValue()), targetRect.getSkValue());
+
+        canvas()->save();
+        canvas()->clipRect(targetRect.getSkValue(), true);
+        canvas()->drawPicture(picture, &matrix, paint != nullptr ? &paint->getSkValue() : nullptr);
+        canvas()->restore();
+        return;
+    }
+
     canvas()->drawImageRect(image.getSkValue(),
                             imageRect.getSkValue(),
                             targetRect.getSkValue(),
@@ -104,6 +124,12 @@ void DrawingContext::drawExternalSurface(const Ref<ExternalSurface>& externalSur
     _externalSurface = externalSurface;
 }
 
+void DrawingContext::drawAtlasSprite(const Ref<ImageAtlasSprite>& sprite, const Rect& targetRect) {
+    SC_ASSERT(_atlasSprite == nullptr);
+    _atlasSprite = sprite;
+    _atlasSpriteRect = targetRect;
+}
+
 int DrawingContext::save() {
     return canvas()->save();
 }
@@ -71,6 +71,12 @@ public:
 
     void drawExternalSurface(const Ref<ExternalSurface>& externalSurface);
 
+    /**
+     Draw the atlas sprite into the given target rect. The sprite is drawn after
+     the content drawn into the canvas, and at most one sprite can be drawn.
+     */
+    void drawAtlasSprite(const Ref<ImageAtlasSprite>& sprite, const Rect& targetRect);
+
     void clipPath(const Path& path);
 
     void clipRect(const Rect& rect);
@@ -89,6 +95,8 @@ private:
     Rect _drawBounds;
     SkPictureRecorder _recorder;
     Ref<ExternalSurface> _externalSurface;
+    Ref<ImageAtlasSprite> _atlasSprite;
+    Rect _atlasSpriteRect;
     SkCanvas* _canvas = nullptr;
 };
 
@@ -0,0 +1,73 @@
+//
+//  GradientShaderCache.cpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "snap_drawing/cpp/Drawing/GradientShaderCache.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace snap::drawing {
+
+bool GradientShaderCacheKey::operator==(const GradientShaderCacheKey& other) const {
+    return type == other.type && orientation == other.orientation && aspectRatio == other.aspectRatio &&
+           colors == other.colors && locations == other.locations;
+}
+
+bool GradientShaderCacheKey::operator!=(const GradientShaderCacheKey& other) const {
+    return !(*this == other);
+}
+
+size_t GradientShaderCacheKey::hash() const {
+    auto hash = static_cast<size_t>(type);
+    boost::hash_combine(hash, orientation);
+    boost::hash_combine(hash, std::hash<Scalar>()(aspectRatio));
+    for (const auto& color : colors) {
+        boost::hash_combine(hash, color.value);
+    }
+    for (auto location : locations) {
+        boost::hash_combine(hash, std::hash<Scalar>()(location));
+    }
+    return hash;
+}
+
+GradientShaderCache::GradientShaderCache(size_t capacity) : _cache(capacity) {}
+GradientShaderCache::~GradientShaderCache() = default;
+
+sk_sp<SkShader> GradientShaderCache::find(const GradientShaderCacheKey& key) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    const auto& it = _cache.find(key);
+    if (it == _cache.end()) {
+        return nullptr;
+    }
+
+    return it->value();
+}
+
+void GradientShaderCache::insert(GradientShaderCacheKey key, const sk_sp<SkShader>& shader) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _cache.insert(std::move(key), sk_sp<SkShader>(shader));
+}
+
+void GradientShaderCache::clear() {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _cache.clear();
+}
+
+size_t GradientShaderCache::size() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    return _cache.size();
+}
+
+} // namespace snap::drawing
+
+namespace std {
+
+std::size_t hash<snap::drawing::GradientShaderCacheKey>::operator()(
+    const snap::drawing::GradientShaderCacheKey& k) const noexcept {
+    return k.hash();
+}
+
+} // namespace std
@@ -0,0 +1,82 @@
+//
+//  GradientShaderCache.hpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Color.hpp"
+#include "snap_drawing/cpp/Utils/Scalar.hpp"
+
+#include "valdi_core/cpp/Utils/LRUCache.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include "include/core/SkShader.h"
+
+#include <vector>
+
+namespace snap::drawing {
+
+enum class GradientShaderType : uint8_t {
+    Linear,
+    Radial,
+};
+
+/**
+ Identifies a gradient shader built for normalized bounds, which has a width of 1. The aspect
+ ratio is the height of the normalized bounds, or 0 when the gradient can be stretched to any
+ bounds. The locations are empty when the colors are distributed evenly.
+ */
+struct GradientShaderCacheKey {
+    GradientShaderType type = GradientShaderType::Linear;
+    int orientation = 0;
+    Scalar aspectRatio = 0;
+    std::vector<Color> colors;
+    std::vector<Scalar> locations;
+
+    bool operator==(const GradientShaderCacheKey& other) const;
+    bool operator!=(const GradientShaderCacheKey& other) const;
+
+    size_t hash() const;
+};
+
+} // namespace snap::drawing
+
+namespace std {
+
+template<>
+struct hash<snap::drawing::GradientShaderCacheKey> {
+    std::size_t operator()(const snap::drawing::GradientShaderCacheKey& k) const noexcept;
+};
+
+} // namespace std
+
+namespace snap::drawing {
+
+/**
+ A thread safe LRU cache of gradient shaders, shared between the layers of a Resources instance.
+ Shaders are built for normalized bounds and mapped to the bounds of each layer through a local
+ matrix, so that layers with the same gradient style, like the cells of a list, share a single
+ gradient shader regardless of their size.
+ */
+class GradientShaderCache : public Valdi::SimpleRefCountable {
+public:
+    explicit GradientShaderCache(size_t capacity);
+    ~GradientShaderCache() override;
+
+    sk_sp<SkShader> find(const GradientShaderCacheKey& key);
+    void insert(GradientShaderCacheKey key, const sk_sp<SkShader>& shader);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    mutable Valdi::Mutex _mutex;
+    Valdi::LRUCache<GradientShaderCacheKey, sk_sp<SkShader>> _cache;
+};
+
+} // namespace snap::drawing
@@ -9,9 +9,13 @@
 
 #include "snap_drawing/cpp/Drawing/GraphicsContext/ANativeWindowGraphicsContext.hpp"
 #include "snap_drawing/cpp/Drawing/GraphicsContext/EGLUtils.hpp"
+#include "snap_drawing/cpp/Drawing/Surface/SurfaceDamageHistory.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include <GLES/glext.h>
+#include <atomic>
+#include <deque>
+#include <string_view>
 
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkSurface.h"
@@ -23,6 +27,40 @@
 
 namespace snap::drawing {
 
+// Android surfaces are at most triple buffered, a buffer older than that is redrawn entirely
+constexpr size_t kMaxBufferAge = 3;
+constexpr size_t kMaxEGLDamageRectsCount = 8;
+// EGL only keeps the timestamps of the most recent frames
+constexpr size_t kMaxPendingPresentedFrames = 8;
+
+static std::vector<EGLint> toEGLRects(const std::vector<Rect>& rects, int surfaceHeight) {
+    std::vector<EGLint> eglRects;
+    eglRects.reserve(rects.size() * 4);
+    for (const auto& rect : rects) {
+        // EGL rects have their origin at the bottom left of the surface
+        eglRects.emplace_back(static_cast<EGLint>(rect.left));
+        eglRects.emplace_back(static_cast<EGLint>(static_cast<Scalar>(surfaceHeight) - rect.bottom));
+        eglRects.emplace_back(static_cast<EGLint>(rect.width()));
+        eglRects.emplace_back(static_cast<EGLint>(rect.height()));
+    }
+    return eglRects;
+}
+
+static bool hasExtension(std::string_view extensions, std::string_view extension) {
+    size_t start = 0;
+    while (start < extensions.size()) {
+        auto end = extensions.find(' ', start);
+        if (end == std::string_view::npos) {
+            end = extensions.size();
+        }
+        if (extensions.substr(start, end - start) == extension) {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
 class ANativeWindowDrawableSurface : public DrawableSurface {
 public:
     ANativeWindowDrawableSurface(const Ref<ANativeWindowGraphicsContext>& context, ANativeWindow* nativeWindow)
@@ -59,6 +97,13 @@ public:
 
         auto glObjects = glObjectsResult.moveValue();
 
+        _supportsBufferAge = glObjects.supportsBufferAge;
+        _setDamageRegion = glObjects.setDamageRegion;
+        _swapBuffersWithDamage = glObjects.swapBuffersWithDamage;
+        _getNextFrameId = glObjects.getNextFrameId;
+        _getFrameTimestamps = glObjects.getFrameTimestamps;
+        _frameDamageRects = std::nullopt;
+
         _eglContext.setDisplay(glObjects.eGLDisplay);
         _eglContext.setContext(glObjects.eGLContext);
 
@@ -104,15 +149,69 @@ public:
     }
 
     void flush() override {
+        auto gpuFrameTimingEnabled = _context->isGPUFrameTimingEnabled();
+        auto& gpuFrameTimer = _context->_gpuFrameTimer;
+
+        if (gpuFrameTimingEnabled) {
+            // Skia issues the GL commands of the frame when flushing
+            gpuFrameTimer.beginFrame();
+        }
+
         if (_surface != nullptr) {
             GLDrawableSurface::flushSurface(_surface.get());
         }
 
-        swapBuffers();
+        if (gpuFrameTimingEnabled) {
+            gpuFrameTimer.endFrame();
+            for (auto gpuDuration : gpuFrameTimer.collectCompletedFrames()) {
+                Valdi::GPUFrameTiming timing;
+                timing.gpuDuration = gpuDuration;
+                _context->onGPUFrameTiming(timing);
+            }
+        }
+
+        swapBuffers(gpuFrameTimingEnabled);
+
+        if (gpuFrameTimingEnabled) {
+            collectPresentedFrames();
+        }
 
         releaseCurrent();
     }
 
+    bool supportsPartialRedraw() const override {
+        return _supportsBufferAge;
+    }
+
+    std::vector<Rect> resolveRedrawRects(const DrawableSurfaceCanvas& canvas,
+                                         const std::vector<Rect>& damageRects) override {
+        _frameDamageRects = SurfaceDamageHistory::normalizeRects(damageRects, _width, _height, kMaxEGLDamageRectsCount);
+
+        if (!_supportsBufferAge || _eglContext.getDrawSurface() == EGL_NO_SURFACE) {
+            return DrawableSurface::resolveRedrawRects(canvas, damageRects);
+        }
+
+        EGLint bufferAge = 0;
+        if (eglQuerySurface(_eglContext.getDisplay(), _eglContext.getDrawSurface(), EGL_BUFFER_AGE_EXT, &bufferAge) ==
+            EGL_FALSE) {
+            bufferAge = 0;
+        }
+
+        auto redrawRects = _damageHistory.resolveRedrawRects(
+            _frameDamageRects.value(), _width, _height, static_cast<size_t>(std::max(bufferAge, 0)));
+
+        if (_setDamageRegion != nullptr) {
+            // Lets tiled GPUs skip loading and storing the regions we won't draw into
+            auto eglRects = toEGLRects(redrawRects, _height);
+            _setDamageRegion(_eglContext.getDisplay(),
+                             _eglContext.getDrawSurface(),
+                             eglRects.data(),
+                             static_cast<EGLint>(redrawRects.size()));
+        }
+
+        return redrawRects;
+    }
+
     Valdi::Result<Valdi::Void> makeCurrent() {
         if (!_eglContext.makeCurrent()) {
             return EGLContextWrapper::getLastError("Failed to make EGL context current");
@@ -124,10 +223,101 @@ public:
         return _eglContext.releaseCurrent();
     }
 
-    void swapBuffers() {
-        if (_eglContext.getDrawSurface() != EGL_NO_SURFACE) {
+    void swapBuffers(bool gpuFrameTimingEnabled) {
+        if (_eglContext.getDrawSurface() == EGL_NO_SURFACE) {
+            return;
+        }
+
+        std::optional<EGLuint64KHR> frameId;
+        if (gpuFrameTimingEnabled) {
+            frameId = getNextFrameId();
+        }
+        auto submitTime = std::chrono::steady_clock::now();
+
+        std::vector<Rect> frameDamageRects;
+        if (_frameDamageRects) {
+            frameDamageRects = std::move(_frameDamageRects.value());
+            _frameDamageRects = std::nullopt;
+        } else {
+            frameDamageRects = {
+                Rect::makeXYWH(0, 0, static_cast<Scalar>(_width), static_cast<Scalar>(_height))};
+        }
+
+        if (_swapBuffersWithDamage != nullptr) {
+            // Lets the compositor only recompose the regions that changed
+            auto eglRects = toEGLRects(frameDamageRects, _height);
+            _swapBuffersWithDamage(_eglContext.getDisplay(),
+                                   _eglContext.getDrawSurface(),
+                                   eglRects.data(),
+                                   static_cast<EGLint>(frameDamageRects.size()));
+        } else {
             eglSwapBuffers(_eglContext.getDisplay(), _eglContext.getDrawSurface());
         }
+
+        _damageHistory.onFramePresented(frameDamageRects, _width, _height);
+
+        if (frameId) {
+            if (_pendingPresentedFrames.size() >= kMaxPendingPresentedFrames) {
+                _pendingPresentedFrames.pop_front();
+            }
+            _pendingPresentedFrames.emplace_back(PendingPresentedFrame{frameId.value(), submitTime});
+        }
+    }
+
+    std::optional<EGLuint64KHR> getNextFrameId() {
+        if (_getNextFrameId == nullptr || _getFrameTimestamps == nullptr) {
+            return std::nullopt;
+        }
+
+        auto display = _eglContext.getDisplay();
+        auto surface = _eglContext.getDrawSurface();
+        if (!_frameTimestampsEnabled) {
+            if (eglSurfaceAttrib(display, surface, EGL_TIMESTAMPS_ANDROID, EGL_TRUE) == EGL_FALSE) {
+                return std::nullopt;
+            }
+            _frameTimestampsEnabled = true;
+        }
+
+        EGLuint64KHR frameId = 0;
+        if (_getNextFrameId(display, surface, &frameId) == EGL_FALSE) {
+            return std::nullopt;
+        }
+        return {frameId};
+    }
+
+    void collectPresentedFrames() {
+        static const EGLint kTimestampNames[] = {EGL_DISPLAY_PRESENT_TIME_ANDROID};
+
+        while (!_pendingPresentedFrames.empty()) {
+            const auto& frame = _pendingPresentedFrames.front();
+            EGLnsecsANDROID presentTime = EGL_TIMESTAMP_INVALID_ANDROID;
+            if (_getFrameTimestamps(_eglContext.getDisplay(),
+                                    _eglContext.getDrawSurface(),
+                                    frame.frameId,
+                                    1,
+                                    kTimestampNames,
+                                    &presentTime) == EGL_FALSE) {
+                presentTime = EGL_TIMESTAMP_INVALID_ANDROID;
+            }
+
+            // Frames are presented in order
+            if (presentTime == EGL_TIMESTAMP_PENDING_ANDROID) {
+                break;
+            }
+
+            if (presentTime != EGL_TIMESTAMP_INVALID_ANDROID) {
+                // Frame timestamps are in the CLOCK_MONOTONIC time base, like the steady clock on Android
+                auto presentTimePoint = std::chrono::steady_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::nanoseconds(presentTime)));
+
+                Valdi::GPUFrameTiming timing;
+                timing.presentLatency = presentTimePoint - frame.submitTime;
+                _context->onGPUFrameTiming(timing);
+            }
+
+            _pendingPresentedFrames.pop_front();
+        }
     }
 
 private:
@@ -135,6 +325,22 @@ private:
     ANativeWindow* _nativeWindow;
     EGLContextWrapper _eglContext;
     sk_sp<SkSurface> _surface;
+    SurfaceDamageHistory _damageHistory = SurfaceDamageHistory(kMaxBufferAge);
+    // Damage of the frame being drawn in pixels, set when the frame is drawn partially
+    std::optional<std::vector<Rect>> _frameDamageRects;
+    std::atomic_bool _supportsBufferAge = false;
+    PFNEGLSETDAMAGEREGIONKHRPROC _setDamageRegion = nullptr;
+    PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC _swapBuffersWithDamage = nullptr;
+    PFNEGLGETNEXTFRAMEIDANDROIDPROC _getNextFrameId = nullptr;
+    PFNEGLGETFRAMETIMESTAMPSANDROIDPROC _getFrameTimestamps = nullptr;
+    bool _frameTimestampsEnabled = false;
+
+    struct PendingPresentedFrame {
+        EGLuint64KHR frameId;
+        std::chrono::steady_clock::time_point submitTime;
+    };
+    // Frames which were swapped but whose present time is not known yet
+    std::deque<PendingPresentedFrame> _pendingPresentedFrames;
 
     int _width;
     int _height;
@@ -283,6 +489,30 @@ Valdi::Result<ANativeWindowGraphicsContext::GLObjects> ANativeWindowGraphicsCont
         return onInitializeError(glObjects);
     }
 
+    const auto* extensions = eglQueryString(glObjects.eGLDisplay, EGL_EXTENSIONS);
+    if (extensions != nullptr) {
+        glObjects.supportsBufferAge = hasExtension(extensions, "EGL_EXT_buffer_age") ||
+                                      hasExtension(extensions, "EGL_KHR_partial_update");
+        if (hasExtension(extensions, "EGL_KHR_partial_update")) {
+            glObjects.setDamageRegion =
+                reinterpret_cast<PFNEGLSETDAMAGEREGIONKHRPROC>(eglGetProcAddress("eglSetDamageRegionKHR"));
+        }
+        if (hasExtension(extensions, "EGL_KHR_swap_buffers_with_damage")) {
+            glObjects.swapBuffersWithDamage =
+                reinterpret_cast<PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC>(eglGetProcAddress("eglSwapBuffersWithDamageKHR"));
+        } else if (hasExtension(extensions, "EGL_EXT_swap_buffers_with_damage")) {
+            // Same signature as the KHR variant
+            glObjects.swapBuffersWithDamage =
+                reinterpret_cast<PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC>(eglGetProcAddress("eglSwapBuffersWithDamageEXT"));
+        }
+        if (hasExtension(extensions, "EGL_ANDROID_get_frame_timestamps")) {
+            glObjects.getNextFrameId =
+                reinterpret_cast<PFNEGLGETNEXTFRAMEIDANDROIDPROC>(eglGetProcAddress("eglGetNextFrameIdANDROID"));
+            glObjects.getFrameTimestamps = reinterpret_cast<PFNEGLGETFRAMETIMESTAMPSANDROIDPROC>(
+                eglGetProcAddress("eglGetFrameTimestampsANDROID"));
+        }
+    }
+
     EGLint numConfigs = 0;
     EGLint eglSampleCnt = _displayParams.mSAASampleCount > 1 ? static_cast<EGLint>(_displayParams.mSAASampleCount) : 0;
 
@@ -344,6 +574,14 @@ Valdi::Result<ANativeWindowGraphicsContext::GLObjects> ANativeWindowGraphicsCont
     }
 
     glObjects.grContext = GrDirectContexts::MakeGL(std::move(glInterface), _options->getGrContextOptions());
+    if (glObjects.grContext != nullptr) {
+        _options->warmUpShaders(*glObjects.grContext);
+    }
+
+    const auto* glExtensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (glExtensions != nullptr && hasExtension(glExtensions, "GL_EXT_disjoint_timer_query")) {
+        _gpuFrameTimer.initialize();
+    }
 
     eglMakeCurrent(glObjects.eGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
 
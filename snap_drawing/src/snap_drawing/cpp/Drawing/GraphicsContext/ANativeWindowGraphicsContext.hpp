@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <android/native_window_jni.h>
 
+#include "snap_drawing/cpp/Drawing/GraphicsContext/GLFrameTimer.hpp"
 #include "snap_drawing/cpp/Drawing/GraphicsContext/GLGraphicsContext.hpp"
 #include "snap_drawing/cpp/Drawing/GraphicsContext/GrGraphicsContext.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurface.hpp"
@@ -55,6 +58,14 @@ private:
         int sampleCount = 0;
         int stencilBits = 0;
         sk_sp<GrDirectContext> grContext;
+        // Resolved from EGL_EXT_buffer_age, EGL_KHR_partial_update and
+        // EGL_KHR_swap_buffers_with_damage when the display supports them
+        bool supportsBufferAge = false;
+        PFNEGLSETDAMAGEREGIONKHRPROC setDamageRegion = nullptr;
+        PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC swapBuffersWithDamage = nullptr;
+        // Resolved from EGL_ANDROID_get_frame_timestamps, used to measure when frames get presented
+        PFNEGLGETNEXTFRAMEIDANDROIDPROC getNextFrameId = nullptr;
+        PFNEGLGETFRAMETIMESTAMPSANDROIDPROC getFrameTimestamps = nullptr;
 
         GLObjects();
     };
@@ -63,6 +74,8 @@ private:
     DisplayParams _displayParams;
     Ref<GrGraphicsContextOptions> _options;
     std::optional<GLObjects> _glObjects;
+    // Shared by the surfaces, which are drawn one at a time in the context
+    GLFrameTimer _gpuFrameTimer;
 
     Valdi::Result<GLObjects> getGLObjects();
     static Valdi::Error onGLObjectsError(GLObjects& glObjects, const char* message);
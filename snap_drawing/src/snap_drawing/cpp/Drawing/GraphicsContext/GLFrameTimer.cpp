@@ -0,0 +1,124 @@
+//
+//  GLFrameTimer.cpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#if __ANDROID__
+
+#include "snap_drawing/cpp/Drawing/GraphicsContext/GLFrameTimer.hpp"
+
+#include <cstdint>
+
+namespace snap::drawing {
+
+// From GL_EXT_disjoint_timer_query, which the GLES 1 headers don't declare
+constexpr GLenum kGLTimeElapsed = 0x88BF;
+constexpr GLenum kGLQueryResult = 0x8866;
+constexpr GLenum kGLQueryResultAvailable = 0x8867;
+constexpr GLenum kGLGPUDisjoint = 0x8FBB;
+
+struct GLFrameTimer::Functions {
+    void(GL_APIENTRY* genQueries)(GLsizei n, GLuint* ids) = nullptr;
+    void(GL_APIENTRY* beginQuery)(GLenum target, GLuint id) = nullptr;
+    void(GL_APIENTRY* endQuery)(GLenum target) = nullptr;
+    void(GL_APIENTRY* getQueryObjectuiv)(GLuint id, GLenum pname, GLuint* params) = nullptr;
+    void(GL_APIENTRY* getQueryObjectui64v)(GLuint id, GLenum pname, uint64_t* params) = nullptr;
+};
+
+template<typename T>
+static bool resolveFunction(T& function, const char* name) {
+    function = reinterpret_cast<T>(eglGetProcAddress(name));
+    return function != nullptr;
+}
+
+GLFrameTimer::GLFrameTimer() = default;
+GLFrameTimer::~GLFrameTimer() = default;
+
+bool GLFrameTimer::initialize() {
+    auto functions = std::make_unique<Functions>();
+    if (!resolveFunction(functions->genQueries, "glGenQueriesEXT") ||
+        !resolveFunction(functions->beginQuery, "glBeginQueryEXT") ||
+        !resolveFunction(functions->endQuery, "glEndQueryEXT") ||
+        !resolveFunction(functions->getQueryObjectuiv, "glGetQueryObjectuivEXT") ||
+        !resolveFunction(functions->getQueryObjectui64v, "glGetQueryObjectui64vEXT")) {
+        return false;
+    }
+
+    _functions = std::move(functions);
+    return true;
+}
+
+bool GLFrameTimer::isInitialized() const {
+    return _functions != nullptr;
+}
+
+void GLFrameTimer::beginFrame() {
+    if (_functions == nullptr || _frameActive || _pendingQueries.size() >= kMaxPendingQueries) {
+        return;
+    }
+
+    GLuint query;
+    if (!_freeQueries.empty()) {
+        query = _freeQueries.back();
+        _freeQueries.pop_back();
+    } else {
+        _functions->genQueries(1, &query);
+    }
+
+    _functions->beginQuery(kGLTimeElapsed, query);
+    _pendingQueries.emplace_back(query);
+    _frameActive = true;
+}
+
+void GLFrameTimer::endFrame() {
+    if (!_frameActive) {
+        return;
+    }
+
+    _functions->endQuery(kGLTimeElapsed);
+    _frameActive = false;
+}
+
+std::vector<Valdi::FrameDuration> GLFrameTimer::collectCompletedFrames() {
+    std::vector<Valdi::FrameDuration> frameTimes;
+    if (_functions == nullptr) {
+        return frameTimes;
+    }
+
+    // Reading the flag also resets it. When set, the results of the pending queries are undefined
+    GLint disjoint = 0;
+    glGetIntegerv(kGLGPUDisjoint, &disjoint);
+
+    while (!_pendingQueries.empty()) {
+        if (_frameActive && _pendingQueries.size() == 1) {
+            // The query of the frame being drawn is still running
+            break;
+        }
+
+        auto query = _pendingQueries.front();
+        GLuint available = 0;
+        _functions->getQueryObjectuiv(query, kGLQueryResultAvailable, &available);
+        // Queries complete in order
+        if (available == 0) {
+            break;
+        }
+
+        uint64_t elapsedNs = 0;
+        _functions->getQueryObjectui64v(query, kGLQueryResult, &elapsedNs);
+        if (disjoint == 0) {
+            frameTimes.emplace_back(
+                std::chrono::duration_cast<Valdi::FrameDuration>(std::chrono::nanoseconds(elapsedNs)));
+        }
+
+        _pendingQueries.pop_front();
+        _freeQueries.emplace_back(query);
+    }
+
+    return frameTimes;
+}
+
+} // namespace snap::drawing
+
+#endif
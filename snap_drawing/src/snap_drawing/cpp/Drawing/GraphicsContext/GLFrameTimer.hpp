@@ -0,0 +1,62 @@
+//
+//  GLFrameTimer.hpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include <EGL/egl.h>
+#include <GLES/gl.h>
+
+#include "utils/base/NonCopyable.hpp"
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace snap::drawing {
+
+/**
+ * Measures the GPU time of the frames drawn in a GL context using GL_EXT_disjoint_timer_query.
+ * Query results are read back once the GPU made them available, without stalling the pipeline,
+ * which means the timing of a frame is usually known a couple of frames after it was drawn.
+ * All the methods must be called with the GL context current.
+ */
+class GLFrameTimer : public snap::NonCopyable {
+public:
+    GLFrameTimer();
+    ~GLFrameTimer();
+
+    /**
+     * Resolve the timer query functions. The caller is responsible for checking
+     * that the context supports GL_EXT_disjoint_timer_query.
+     */
+    bool initialize();
+
+    bool isInitialized() const;
+
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * Returns the GPU times of the frames whose results became available since the last call.
+     */
+    std::vector<Valdi::FrameDuration> collectCompletedFrames();
+
+    // Frames are not measured while that many of them are still waiting for their results
+    static constexpr size_t kMaxPendingQueries = 4;
+
+private:
+    struct Functions;
+
+    std::unique_ptr<Functions> _functions;
+    // The queries are freed along with the GL context
+    std::deque<GLuint> _pendingQueries;
+    std::vector<GLuint> _freeQueries;
+    bool _frameActive = false;
+};
+
+} // namespace snap::drawing
@@ -16,6 +16,7 @@
 
 #include "snap_drawing/cpp/Drawing/GraphicsContext/EGLUtils.hpp"
 #include "snap_drawing/cpp/Drawing/GraphicsContext/GLGraphicsContext.hpp"
+#include "snap_drawing/cpp/Drawing/Surface/SurfaceDamageHistory.hpp"
 
 #include "snap_drawing/cpp/Utils/BitmapUtils.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
@@ -29,6 +30,8 @@
 
 namespace snap::drawing {
 
+constexpr size_t kMaxGLRedrawRectsCount = 8;
+
 GLDrawableSurface::GLDrawableSurface(const Ref<GLGraphicsContext>& context,
                                      const GrBackendTexture& backendTexture,
                                      int sampleCount,
@@ -76,9 +79,27 @@ void GLDrawableSurface::flush() {
     if (_surface != nullptr) {
         GLDrawableSurface::flushSurface(_surface.get());
         _surface = nullptr;
+        _hasContent = true;
     }
 }
 
+bool GLDrawableSurface::supportsPartialRedraw() const {
+    // The texture keeps its content between frames, unless it is multisampled in which case
+    // Skia renders into a separate buffer that gets resolved into the texture.
+    // Textures we don't own might be written by someone else between frames.
+    return _owned && _sampleCount <= 1;
+}
+
+std::vector<Rect> GLDrawableSurface::resolveRedrawRects(const DrawableSurfaceCanvas& canvas,
+                                                        const std::vector<Rect>& damageRects) {
+    if (!_hasContent || !supportsPartialRedraw()) {
+        return DrawableSurface::resolveRedrawRects(canvas, damageRects);
+    }
+
+    return SurfaceDamageHistory::normalizeRects(
+        damageRects, canvas.getWidth(), canvas.getHeight(), kMaxGLRedrawRectsCount);
+}
+
 void GLDrawableSurface::flushSurface(SkSurface* surface) {
     auto direct = surface->recordingContext() ? surface->recordingContext()->asDirectContext() : nullptr;
     if (!direct) {
@@ -35,6 +35,11 @@ public:
 
     void flush() override;
 
+    bool supportsPartialRedraw() const override;
+
+    std::vector<Rect> resolveRedrawRects(const DrawableSurfaceCanvas& canvas,
+                                         const std::vector<Rect>& damageRects) override;
+
     GrGLuint getTextureId() const;
     int getTextureWidth() const;
     int getTextureHeight() const;
@@ -48,6 +53,7 @@ private:
     int _sampleCount;
     SkColorType _colorType;
     bool _owned;
+    bool _hasContent = false;
 };
 
 class GLGraphicsContext : public GrGraphicsContext {
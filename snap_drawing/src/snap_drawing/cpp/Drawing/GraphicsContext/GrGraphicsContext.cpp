@@ -9,10 +9,15 @@
 
 #include "snap_drawing/cpp/Drawing/GraphicsContext/GrGraphicsContext.hpp"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkGraphics.h"
+#include "utils/time/StopWatch.hpp"
 #include <iostream>
 
 namespace snap::drawing {
 
+// Warm up happens before the first frame, so it should not take longer than drawing a few of them
+constexpr double kShaderWarmUpBudgetMs = 32;
+
 GrGraphicsContextOptions::GrGraphicsContextOptions() : GrGraphicsContextOptions(nullptr) {};
 
 GrGraphicsContextOptions::~GrGraphicsContextOptions() = default;
@@ -29,12 +34,54 @@ GrContextOptions GrGraphicsContextOptions::getGrContextOptions() const {
         options.fPersistentCache = _cache.get();
         options.fShaderCacheStrategy = GrContextOptions::ShaderCacheStrategy::kBackendBinary;
     }
+
+    if (_glyphAtlasBudgetBytes != 0) {
+        options.fGlyphCacheTextureMaximumBytes = _glyphAtlasBudgetBytes;
+    }
     return options;
 }
 
+void GrGraphicsContextOptions::setGlyphAtlasBudget(size_t glyphAtlasBudgetBytes) {
+    _glyphAtlasBudgetBytes = glyphAtlasBudgetBytes;
+}
+
+void GrGraphicsContextOptions::setSharedGlyphCacheBudget(size_t glyphCacheBudgetBytes) {
+    SkGraphics::SetFontCacheLimit(glyphCacheBudgetBytes);
+}
+
+void GrGraphicsContextOptions::warmUpShaders(GrDirectContext& grContext) const {
+    if (_cache == nullptr) {
+        return;
+    }
+
+    auto shaders = _cache->getWarmUpShaders();
+    if (shaders.empty()) {
+        return;
+    }
+
+    snap::utils::time::StopWatch sw;
+    sw.start();
+
+    for (const auto& shader : shaders) {
+        if (!grContext.precompileShader(*shader.key, *shader.data)) {
+            // The backend cannot compile shaders stored in this format ahead of time, they will
+            // still be loaded from the cache on first use.
+            return;
+        }
+
+        if (sw.elapsed().milliseconds() >= kShaderWarmUpBudgetMs) {
+            return;
+        }
+    }
+}
+
 GrGraphicsContext::GrGraphicsContext(const sk_sp<GrDirectContext>& grContext,
                                      const Ref<GrGraphicsContextOptions>& options)
-    : _grContext(grContext), _options(options) {}
+    : _grContext(grContext), _options(options) {
+    if (_grContext != nullptr && _options != nullptr) {
+        _options->warmUpShaders(*_grContext);
+    }
+}
 
 GrGraphicsContext::~GrGraphicsContext() {
     if (_grContext != nullptr) {
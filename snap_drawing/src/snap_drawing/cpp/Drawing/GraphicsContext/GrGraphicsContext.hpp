@@ -31,9 +31,29 @@ public:
 
     GrContextOptions getGrContextOptions() const;
 
+    /**
+     Set the maximum size in bytes of the GPU glyph atlas textures of the contexts created
+     with these options. 0 keeps the Skia default.
+     */
+    void setGlyphAtlasBudget(size_t glyphAtlasBudgetBytes);
+
+    /**
+     Set the budget of the process wide cache of rasterized glyphs and glyph paths.
+     This cache is shared by every GraphicsContext and runtime in the process, so that
+     a glyph rasterized for one root only needs to be uploaded when drawn by another.
+     */
+    static void setSharedGlyphCacheBudget(size_t glyphCacheBudgetBytes);
+
+    /**
+     Compile the shaders used in previous sessions on the given context, until the time budget
+     is exhausted. Must be called while the context can be used from the calling thread.
+     */
+    void warmUpShaders(GrDirectContext& grContext) const;
+
 private:
     std::unique_ptr<SkExecutor> _executor;
     Valdi::Ref<IShaderCache> _cache;
+    size_t _glyphAtlasBudgetBytes = 0;
 };
 
 class GrGraphicsContext : public GraphicsContext {
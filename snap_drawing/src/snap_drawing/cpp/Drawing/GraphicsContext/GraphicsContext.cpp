@@ -11,4 +11,28 @@ namespace snap::drawing {
 
 void GraphicsContext::commit() {}
 
+void GraphicsContext::setGPUFrameTimingEnabled(bool gpuFrameTimingEnabled) {
+    _gpuFrameTimingEnabled.store(gpuFrameTimingEnabled, std::memory_order_relaxed);
+}
+
+bool GraphicsContext::isGPUFrameTimingEnabled() const {
+    return _gpuFrameTimingEnabled.load(std::memory_order_relaxed);
+}
+
+std::vector<Valdi::GPUFrameTiming> GraphicsContext::consumeGPUFrameTimings() {
+    std::lock_guard<Valdi::Mutex> lock(_gpuFrameTimingsMutex);
+    auto timings = std::move(_gpuFrameTimings);
+    _gpuFrameTimings.clear();
+    return timings;
+}
+
+void GraphicsContext::onGPUFrameTiming(const Valdi::GPUFrameTiming& timing) {
+    std::lock_guard<Valdi::Mutex> lock(_gpuFrameTimingsMutex);
+    // Timings are dropped if nobody consumes them
+    if (_gpuFrameTimings.size() >= kMaxPendingGPUFrameTimings) {
+        _gpuFrameTimings.erase(_gpuFrameTimings.begin());
+    }
+    _gpuFrameTimings.emplace_back(timing);
+}
+
 } // namespace snap::drawing
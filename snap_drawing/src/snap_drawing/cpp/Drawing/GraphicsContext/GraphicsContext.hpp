@@ -8,9 +8,13 @@
 #pragma once
 
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <vector>
 
 namespace snap::drawing {
 
@@ -21,6 +25,32 @@ public:
     virtual void performCleanup(bool shouldPurgeScratchResources, std::chrono::seconds secondsNotUsed) = 0;
 
     virtual void commit();
+
+    /**
+     * Sets whether the context should measure the GPU time and present latency of the frames it draws,
+     * on the backends which support it. Measuring is disabled by default as it has a small GPU cost.
+     */
+    void setGPUFrameTimingEnabled(bool gpuFrameTimingEnabled);
+    bool isGPUFrameTimingEnabled() const;
+
+    /**
+     * Returns and clears the GPU timings of the frames which completed since the last call.
+     * As they become available asynchronously, the timings are usually those of previously drawn frames.
+     */
+    std::vector<Valdi::GPUFrameTiming> consumeGPUFrameTimings();
+
+    static constexpr size_t kMaxPendingGPUFrameTimings = 32;
+
+protected:
+    /**
+     * Called by the implementations when the timing of a frame becomes available, from any thread.
+     */
+    void onGPUFrameTiming(const Valdi::GPUFrameTiming& timing);
+
+private:
+    std::atomic_bool _gpuFrameTimingEnabled = false;
+    Valdi::Mutex _gpuFrameTimingsMutex;
+    std::vector<Valdi::GPUFrameTiming> _gpuFrameTimings;
 };
 
 } // namespace snap::drawing
@@ -2,13 +2,27 @@
 
 #include "valdi_core/cpp/Utils/Shared.hpp"
 
+#include <vector>
+
 #ifdef SK_GANESH
 
 #include "include/gpu/ganesh/GrDirectContext.h"
 
 namespace snap::drawing {
 
-class IShaderCache : public GrContextOptions::PersistentCache, public Valdi::SharedPtrRefCountable {};
+struct ShaderCacheEntry {
+    sk_sp<SkData> key;
+    sk_sp<SkData> data;
+};
+
+class IShaderCache : public GrContextOptions::PersistentCache, public Valdi::SharedPtrRefCountable {
+public:
+    /**
+     Returns the shaders which were used in previous sessions and which are already loaded in memory,
+     in the order they were first used. They can be compiled ahead of their first use.
+     */
+    virtual std::vector<ShaderCacheEntry> getWarmUpShaders() = 0;
+};
 
 } // namespace snap::drawing
 
@@ -18,12 +32,18 @@ class IShaderCache : public GrContextOptions::PersistentCache, public Valdi::Sha
 
 namespace snap::drawing {
 
+struct ShaderCacheEntry {
+    sk_sp<SkData> key;
+    sk_sp<SkData> data;
+};
+
 class IShaderCache : public Valdi::SharedPtrRefCountable {
 public:
     virtual sk_sp<SkData> load(const SkData& key) = 0;
     virtual void store(const SkData& key, const SkData& data) = 0;
+    virtual std::vector<ShaderCacheEntry> getWarmUpShaders() = 0;
 };
 
 } // namespace snap::drawing
 
-#endif
\ No newline at end of file
+#endif
@@ -57,14 +57,34 @@ void MetalDrawableSurface::flush() {
         return;
     }
 
+    auto gpuFrameTimingEnabled = _context->isGPUFrameTimingEnabled();
+    CFTypeRef mtlFrameStartCommandBuffer = nullptr;
+    if (gpuFrameTimingEnabled) {
+        // Skia submits its own command buffers. As the command buffers of a queue execute in order,
+        // the ones we commit around the flush bound the GPU execution of the frame.
+        mtlFrameStartCommandBuffer = MetalGraphicsContext::createCommandBuffer(_context->getMTLCommandQueue());
+        MetalGraphicsContext::commitCommandBuffer(mtlFrameStartCommandBuffer);
+    }
+
     skgpu::ganesh::FlushAndSubmit(_surface);
     _surface = nullptr;
 
+    if (mtlFrameStartCommandBuffer != nullptr) {
+        auto mtlFrameEndCommandBuffer = MetalGraphicsContext::createCommandBuffer(_context->getMTLCommandQueue());
+        MetalGraphicsContext::observeGPUFrameTiming(_context, mtlFrameStartCommandBuffer, mtlFrameEndCommandBuffer);
+        MetalGraphicsContext::commitCommandBuffer(mtlFrameEndCommandBuffer);
+        CFRelease(mtlFrameEndCommandBuffer);
+        CFRelease(mtlFrameStartCommandBuffer);
+    }
+
     CFTypeRef mtlDrawableHandle = _mtlDrawableHandle;
 
     _mtlDrawableHandle = nullptr;
 
     if (mtlDrawableHandle != nullptr) {
+        if (gpuFrameTimingEnabled) {
+            MetalGraphicsContext::observeDrawablePresentation(_context, mtlDrawableHandle);
+        }
         _context->presentMetalDrawable(mtlDrawableHandle);
         CFRelease(mtlDrawableHandle);
     }
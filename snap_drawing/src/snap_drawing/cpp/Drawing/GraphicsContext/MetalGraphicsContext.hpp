@@ -70,6 +70,10 @@ private:
     static CFTypeRef createCommandBuffer(CFTypeRef mtlCommandQueue);
     static void presentMetalDrawable(CFTypeRef mtlCommandBuffer, CFTypeRef mtlDrawableHandle);
     static void commitCommandBuffer(CFTypeRef mtlCommandBuffer);
+    static void observeGPUFrameTiming(const Ref<MetalGraphicsContext>& context,
+                                      CFTypeRef mtlFrameStartCommandBuffer,
+                                      CFTypeRef mtlFrameEndCommandBuffer);
+    static void observeDrawablePresentation(const Ref<MetalGraphicsContext>& context, CFTypeRef mtlDrawableHandle);
     static MetalLayerSize getMetalLayerSize(CFTypeRef mtlLayer);
 
     static sk_sp<GrDirectContext> makeContext(void* mtlDevice, void* mtlCommandQueue, const GrContextOptions& options);
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Scalar.hpp"
 #include "snap_drawing/cpp/Utils/TimePoint.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
@@ -27,6 +28,19 @@ public:
     virtual void onNextVSync(const Ref<IFrameCallback>& callback) = 0;
 
     virtual void onMainThread(const Ref<IFrameCallback>& callback) = 0;
+
+    /**
+     Schedule a function to be executed on the main thread on the first VSYNC of the display
+     which happens after the given delay. This lets the scheduler stay idle until then.
+     */
+    virtual void onMainThreadAfter(const Ref<IFrameCallback>& callback, Duration delay) = 0;
+
+    /**
+     Hint the frame rate at which the main thread callbacks are expected to be scheduled,
+     which the scheduler can use to lower the refresh rate of the display.
+     A frame rate of 0 means that the content should be updated at the display's max rate.
+     */
+    virtual void setPreferredFrameRate(Scalar /*frameRate*/) {}
 };
 
 } // namespace snap::drawing
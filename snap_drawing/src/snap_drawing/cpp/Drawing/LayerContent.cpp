@@ -15,12 +15,15 @@ LayerContent::LayerContent() = default;
 LayerContent::~LayerContent() = default;
 
 bool LayerContent::isEmpty() const {
-    return picture == nullptr && externalSurface == nullptr;
+    return picture == nullptr && externalSurface == nullptr && atlasSprite == nullptr;
 }
 
 void LayerContent::clear() {
     picture = nullptr;
     externalSurface = nullptr;
+    opaqueRect = Rect::makeEmpty();
+    atlasSprite = nullptr;
+    atlasSpriteRect = Rect::makeEmpty();
 }
 
 } // namespace snap::drawing
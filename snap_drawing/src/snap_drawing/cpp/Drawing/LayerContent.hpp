@@ -8,20 +8,28 @@
 #pragma once
 
 #include "include/core/SkPicture.h"
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/ExternalSurface.hpp"
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
 
 namespace snap::drawing {
 
 /**
  LayerContent is a wrapper around a recorded list of draw commands through SkPicture,
- or a ExternalSurface reference. The LayerContent might hold the picture representing the
- background and result of the onDraw() call, or the foreground picture.
+ a ExternalSurface reference, or an ImageAtlas sprite drawn after the picture.
+ The LayerContent might hold the picture representing the background and result of the onDraw() call, or the foreground picture.
  It is created by the DrawingContext.
  */
 struct LayerContent {
     sk_sp<SkPicture> picture;
     Ref<ExternalSurfaceSnapshot> externalSurface;
+    // Area of the picture which is guaranteed to be filled with a single opaque color, used
+    // to skip drawing the content it occludes. Empty if unknown.
+    Rect opaqueRect = Rect::makeEmpty();
+    Ref<ImageAtlasSprite> atlasSprite;
+    // Where the atlas sprite is drawn in local coordinates
+    Rect atlasSpriteRect = Rect::makeEmpty();
 
     LayerContent(const sk_sp<SkPicture>& picture, const Ref<ExternalSurfaceSnapshot>& externalSurface);
     LayerContent();
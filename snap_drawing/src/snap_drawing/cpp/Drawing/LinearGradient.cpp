@@ -6,6 +6,8 @@
 //
 
 #include "snap_drawing/cpp/Drawing/LinearGradient.hpp"
+#include "snap_drawing/cpp/Drawing/GradientShaderCache.hpp"
+#include "include/core/SkMatrix.h"
 #include "include/effects/SkGradientShader.h"
 #include <cmath>
 
@@ -44,87 +46,138 @@ void LinearGradient::setOrientation(LinearGradientOrientation orientation) {
     }
 }
 
-void LinearGradient::updateShader(const Rect& bounds) {
+static bool isDiagonalOrientation(LinearGradientOrientation orientation) {
+    switch (orientation) {
+        case LinearGradientOrientationTopRightBottomLeft:
+        case LinearGradientOrientationBottomRightTopLeft:
+        case LinearGradientOrientationBottomLeftTopRight:
+        case LinearGradientOrientationTopLeftBottomRight:
+            return true;
+        default:
+            return false;
+    }
+}
+
+sk_sp<SkShader> LinearGradient::makeShader(const Rect& bounds) const {
+    auto halfWidth = bounds.x() + (bounds.width() / 2);
+    auto halfHeight = bounds.y() + (bounds.height() / 2);
+
+    Point points[2];
+
+    switch (_orientation) {
+        case LinearGradientOrientationTopBottom:
+            points[0] = Point::make(halfWidth, bounds.top);
+            points[1] = Point::make(halfWidth, bounds.bottom);
+            break;
+        case LinearGradientOrientationTopRightBottomLeft:
+            points[0] = Point::make(bounds.right, bounds.top);
+            points[1] = Point::make(bounds.left, bounds.bottom);
+            break;
+        case LinearGradientOrientationRightLeft:
+            points[0] = Point::make(bounds.right, halfHeight);
+            points[1] = Point::make(bounds.left, halfHeight);
+            break;
+        case LinearGradientOrientationBottomRightTopLeft:
+            points[0] = Point::make(bounds.right, bounds.bottom);
+            points[1] = Point::make(bounds.left, bounds.top);
+            break;
+        case LinearGradientOrientationBottomTop:
+            points[0] = Point::make(halfWidth, bounds.bottom);
+            points[1] = Point::make(halfWidth, bounds.top);
+            break;
+        case LinearGradientOrientationBottomLeftTopRight:
+            points[0] = Point::make(bounds.left, bounds.bottom);
+            points[1] = Point::make(bounds.right, bounds.top);
+            break;
+        case LinearGradientOrientationLeftRight:
+            points[0] = Point::make(bounds.left, halfHeight);
+            points[1] = Point::make(bounds.right, halfHeight);
+            break;
+        case LinearGradientOrientationTopLeftBottomRight:
+            points[0] = Point::make(bounds.left, bounds.top);
+            points[1] = Point::make(bounds.right, bounds.bottom);
+            break;
+        default:
+            points[0] = Point::make(halfWidth, bounds.top);
+            points[1] = Point::make(halfWidth, bounds.bottom);
+    }
+
+    const auto* colorsData = reinterpret_cast<const SkColor*>(_colors.data());
+
+    if (_colors.size() == _locations.size()) {
+        // User provided color distribution
+        return SkGradientShader::MakeLinear(&points[0].getSkValue(),
+                                            colorsData,
+                                            _locations.data(),
+                                            static_cast<int>(_colors.size()),
+                                            SkTileMode::kClamp);
+    }
+
+    // Distribute colors evenly
+    return SkGradientShader::MakeLinear(
+        &points[0].getSkValue(), colorsData, nullptr, static_cast<int>(_colors.size()), SkTileMode::kClamp);
+}
+
+void LinearGradient::updateShader(const Rect& bounds, GradientShaderCache* shaderCache) {
     if (isEmpty()) {
         _shader = nullptr;
-    } else {
-        auto halfWidth = bounds.x() + (bounds.width() / 2);
-        auto halfHeight = bounds.y() + (bounds.height() / 2);
-
-        Point points[2];
-
-        switch (_orientation) {
-            case LinearGradientOrientationTopBottom:
-                points[0] = Point::make(halfWidth, bounds.top);
-                points[1] = Point::make(halfWidth, bounds.bottom);
-                break;
-            case LinearGradientOrientationTopRightBottomLeft:
-                points[0] = Point::make(bounds.right, bounds.top);
-                points[1] = Point::make(bounds.left, bounds.bottom);
-                break;
-            case LinearGradientOrientationRightLeft:
-                points[0] = Point::make(bounds.right, halfHeight);
-                points[1] = Point::make(bounds.left, halfHeight);
-                break;
-            case LinearGradientOrientationBottomRightTopLeft:
-                points[0] = Point::make(bounds.right, bounds.bottom);
-                points[1] = Point::make(bounds.left, bounds.top);
-                break;
-            case LinearGradientOrientationBottomTop:
-                points[0] = Point::make(halfWidth, bounds.bottom);
-                points[1] = Point::make(halfWidth, bounds.top);
-                break;
-            case LinearGradientOrientationBottomLeftTopRight:
-                points[0] = Point::make(bounds.left, bounds.bottom);
-                points[1] = Point::make(bounds.right, bounds.top);
-                break;
-            case LinearGradientOrientationLeftRight:
-                points[0] = Point::make(bounds.left, halfHeight);
-                points[1] = Point::make(bounds.right, halfHeight);
-                break;
-            case LinearGradientOrientationTopLeftBottomRight:
-                points[0] = Point::make(bounds.left, bounds.top);
-                points[1] = Point::make(bounds.right, bounds.bottom);
-                break;
-            default:
-                points[0] = Point::make(halfWidth, bounds.top);
-                points[1] = Point::make(halfWidth, bounds.bottom);
-        }
+        return;
+    }
+
+    if (shaderCache == nullptr || bounds.width() <= 0 || bounds.height() <= 0) {
+        _shader = makeShader(bounds);
+        return;
+    }
 
-        const auto* colorsData = reinterpret_cast<const SkColor*>(_colors.data());
-
-        sk_sp<SkShader> shader;
-        if (_colors.size() == _locations.size()) {
-            // User provided color distribution
-
-            _shader = SkGradientShader::MakeLinear(&points[0].getSkValue(),
-                                                   colorsData,
-                                                   _locations.data(),
-                                                   static_cast<int>(_colors.size()),
-                                                   SkTileMode::kClamp);
-        } else {
-            // Distribute colors evenly
-            _shader = SkGradientShader::MakeLinear(
-                &points[0].getSkValue(), colorsData, nullptr, static_cast<int>(_colors.size()), SkTileMode::kClamp);
+    GradientShaderCacheKey key;
+    key.type = GradientShaderType::Linear;
+    key.orientation = static_cast<int>(_orientation);
+    key.colors = _colors;
+    if (_colors.size() == _locations.size()) {
+        key.locations = _locations;
+    }
+
+    SkMatrix localMatrix;
+    if (isDiagonalOrientation(_orientation)) {
+        // The isolines of a diagonal gradient are perpendicular to the diagonal, which is only
+        // preserved by a uniform scale
+        key.aspectRatio = bounds.height() / bounds.width();
+        localMatrix.setScale(bounds.width(), bounds.width());
+    } else {
+        localMatrix.setScale(bounds.width(), bounds.height());
+    }
+    localMatrix.postTranslate(bounds.x(), bounds.y());
+
+    auto shader = shaderCache->find(key);
+    if (shader == nullptr) {
+        shader = makeShader(Rect::makeXYWH(0, 0, 1, key.aspectRatio != 0 ? key.aspectRatio : 1));
+        if (shader == nullptr) {
+            _shader = nullptr;
+            return;
         }
+        shaderCache->insert(key, shader);
     }
+
+    _shader = shader->makeWithLocalMatrix(localMatrix);
 }
 
 void LinearGradient::applyToPaint(Paint& paint) const {
     paint.getSkValue().setShader(_shader);
 }
 
-void LinearGradient::update(const Rect& bounds) {
+void LinearGradient::update(const Rect& bounds, GradientShaderCache* shaderCache) {
     if (_dirty || _lastDrawBounds != bounds) {
-        updateShader(bounds);
+        updateShader(bounds, shaderCache);
 
         _lastDrawBounds = bounds;
         _dirty = false;
     }
 }
 
-void LinearGradient::draw(DrawingContext& drawingContext, const BorderRadius& borderRadius) {
-    update(drawingContext.drawBounds());
+void LinearGradient::draw(DrawingContext& drawingContext,
+                          const BorderRadius& borderRadius,
+                          GradientShaderCache* shaderCache) {
+    update(drawingContext.drawBounds(), shaderCache);
 
     if (isEmpty()) {
         return;
@@ -17,6 +17,7 @@
 namespace snap::drawing {
 
 class BorderRadius;
+class GradientShaderCache;
 
 enum LinearGradientOrientation {
     /** draw the gradient from the top to the bottom */
@@ -49,11 +50,16 @@ public:
     void setColors(std::vector<Color>&& colors);
     void setOrientation(LinearGradientOrientation orientation);
 
-    void update(const Rect& bounds);
+    /**
+     Update the shader for the given bounds. When a cache is given, the shader is resolved from
+     the gradient shader built for normalized bounds, which is shared with the other gradients
+     of the same style.
+     */
+    void update(const Rect& bounds, GradientShaderCache* shaderCache);
 
     void applyToPaint(Paint& paint) const;
 
-    void draw(DrawingContext& drawingContext, const BorderRadius& borderRadius);
+    void draw(DrawingContext& drawingContext, const BorderRadius& borderRadius, GradientShaderCache* shaderCache);
 
 private:
     sk_sp<SkShader> _shader;
@@ -64,7 +70,8 @@ private:
     LazyPath _lazyPath;
     bool _dirty = true;
 
-    void updateShader(const Rect& bounds);
+    void updateShader(const Rect& bounds, GradientShaderCache* shaderCache);
+    sk_sp<SkShader> makeShader(const Rect& bounds) const;
 };
 
 } // namespace snap::drawing
@@ -0,0 +1,170 @@
+//
+//  PerformanceOverlay.cpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "snap_drawing/cpp/Drawing/PerformanceOverlay.hpp"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPictureRecorder.h"
+
+#include <algorithm>
+#include <array>
+
+namespace snap::drawing {
+
+constexpr Scalar kGraphHeight = 80;
+constexpr Scalar kGraphMargin = 8;
+constexpr Scalar kBridgeCrossingTickHeight = 3;
+// The graph goes up to twice the frame budget, the bars of slower frames are clamped
+constexpr Scalar kGraphBudgetsCount = 2;
+
+// Indexed by FramePhase
+constexpr std::array<SkColor, Valdi::kFramePhasesCount> kPhaseColors = {
+    0xFFF2C94C, // JSRender
+    0xFFF2994A, // Render
+    0xFF6FCF97, // Layout
+    0xFF56CCF2, // ViewTreeUpdate
+    0xFF2F80ED, // Draw
+    0xFFBB6BD9, // Raster
+};
+constexpr SkColor kBackgroundColor = 0xB0000000;
+constexpr SkColor kBudgetLineColor = 0xFFEB5757;
+constexpr SkColor kBridgeCrossingColor = 0xFFFFFFFF;
+
+static Scalar toMilliseconds(Valdi::FrameDuration duration) {
+    return std::chrono::duration<Scalar, std::milli>(duration).count();
+}
+
+PerformanceOverlay::PerformanceOverlay(size_t maxFramesCount, Valdi::FrameDuration frameBudget)
+    : _frameBudget(frameBudget), _maxFramesCount(std::max(maxFramesCount, static_cast<size_t>(1))) {
+}
+
+PerformanceOverlay::~PerformanceOverlay() = default;
+
+void PerformanceOverlay::onFrameRecorded(const Valdi::StringBox& /*module*/, const Valdi::FrameTimings& timings) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    if (_frames.size() < _maxFramesCount) {
+        _frames.emplace_back(timings);
+    } else {
+        _frames[_nextFrameIndex] = timings;
+    }
+    _nextFrameIndex = (_nextFrameIndex + 1) % _maxFramesCount;
+    _sequence++;
+}
+
+void PerformanceOverlay::setEnabled(bool enabled) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _enabled = enabled;
+    if (!enabled) {
+        _frames = std::vector<Valdi::FrameTimings>();
+        _nextFrameIndex = 0;
+        _picture = nullptr;
+        _sequence++;
+    }
+}
+
+bool PerformanceOverlay::isEnabled() const {
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+std::vector<Valdi::FrameTimings> PerformanceOverlay::getFrames() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    return lockFreeGetFrames();
+}
+
+std::vector<Valdi::FrameTimings> PerformanceOverlay::lockFreeGetFrames() const {
+    std::vector<Valdi::FrameTimings> frames;
+    frames.reserve(_frames.size());
+
+    // Until the ring buffer is full, the next frame index is the end of the frames
+    auto oldestIndex = _frames.size() < _maxFramesCount ? 0 : _nextFrameIndex;
+    for (size_t i = 0; i < _frames.size(); i++) {
+        frames.emplace_back(_frames[(oldestIndex + i) % _frames.size()]);
+    }
+
+    return frames;
+}
+
+sk_sp<SkPicture> PerformanceOverlay::getPicture(const Size& surfaceSize) {
+    std::vector<Valdi::FrameTimings> frames;
+    {
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        if (_picture != nullptr && _pictureSequence == _sequence && _pictureSurfaceSize == surfaceSize) {
+            return _picture;
+        }
+        _pictureSequence = _sequence;
+        frames = lockFreeGetFrames();
+    }
+
+    // Recorded outside of the lock, so that frames being recorded on other threads are not blocked
+    auto picture = makePicture(frames, surfaceSize);
+
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _picture = picture;
+    _pictureSurfaceSize = surfaceSize;
+    return picture;
+}
+
+sk_sp<SkPicture> PerformanceOverlay::makePicture(const std::vector<Valdi::FrameTimings>& frames,
+                                                 const Size& surfaceSize) const {
+    auto graphWidth = surfaceSize.width - kGraphMargin * 2;
+    auto graphHeight = std::min(kGraphHeight, surfaceSize.height - kGraphMargin * 2);
+    if (graphWidth <= 0 || graphHeight <= 0) {
+        return nullptr;
+    }
+
+    auto graphRect = SkRect::MakeXYWH(
+        kGraphMargin, surfaceSize.height - kGraphMargin - graphHeight, graphWidth, graphHeight);
+
+    SkPictureRecorder recorder;
+    auto* canvas = recorder.beginRecording(SkRect::MakeWH(surfaceSize.width, surfaceSize.height));
+
+    SkPaint paint;
+    paint.setColor(kBackgroundColor);
+    canvas->drawRect(graphRect, paint);
+
+    auto maxMilliseconds = toMilliseconds(_frameBudget) * kGraphBudgetsCount;
+    auto pointsPerMillisecond = graphHeight / maxMilliseconds;
+    auto barWidth = graphWidth / static_cast<Scalar>(_maxFramesCount);
+
+    for (size_t i = 0; i < frames.size(); i++) {
+        const auto& frame = frames[i];
+        auto left = graphRect.left() + barWidth * static_cast<Scalar>(i);
+        auto bottom = graphRect.bottom();
+
+        for (size_t phaseIndex = 0; phaseIndex < Valdi::kFramePhasesCount; phaseIndex++) {
+            auto barHeight = toMilliseconds(frame.get(static_cast<Valdi::FramePhase>(phaseIndex))) *
+                             pointsPerMillisecond;
+            barHeight = std::min(barHeight, bottom - graphRect.top());
+            if (barHeight <= 0) {
+                continue;
+            }
+
+            paint.setColor(kPhaseColors[phaseIndex]);
+            canvas->drawRect(SkRect::MakeLTRB(left, bottom - barHeight, left + barWidth, bottom), paint);
+            bottom -= barHeight;
+        }
+
+        if (!frame.getBridgeCrossings().empty()) {
+            paint.setColor(kBridgeCrossingColor);
+            auto tickBottom = graphRect.top() + kBridgeCrossingTickHeight;
+            canvas->drawRect(SkRect::MakeLTRB(left, graphRect.top(), left + barWidth, tickBottom), paint);
+        }
+    }
+
+    auto budgetY = graphRect.bottom() - toMilliseconds(_frameBudget) * pointsPerMillisecond;
+    paint.setColor(kBudgetLineColor);
+    canvas->drawRect(SkRect::MakeLTRB(graphRect.left(), budgetY - 0.5f, graphRect.right(), budgetY + 0.5f), paint);
+
+    return recorder.finishRecordingAsPicture();
+}
+
+} // namespace snap::drawing
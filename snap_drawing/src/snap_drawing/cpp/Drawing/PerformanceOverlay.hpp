@@ -0,0 +1,74 @@
+//
+//  PerformanceOverlay.hpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include "include/core/SkPicture.h"
+
+#include <atomic>
+#include <vector>
+
+namespace snap::drawing {
+
+/**
+ A live overlay displaying the timings of the most recent frames, as a graph of bars stacked by
+ frame phase, with a line at the frame budget and a tick above the frames which crossed the bridge.
+ It receives the frames by observing a FrameMetricsAggregator, and is drawn on top of the content
+ of the layer roots whose Resources hold it, as long as it is enabled.
+ */
+class PerformanceOverlay : public Valdi::IFrameMetricsObserver {
+public:
+    explicit PerformanceOverlay(size_t maxFramesCount = kDefaultMaxFramesCount,
+                                Valdi::FrameDuration frameBudget = Valdi::FrameMetricsAggregator::kDefaultFrameBudget);
+    ~PerformanceOverlay() override;
+
+    void onFrameRecorded(const Valdi::StringBox& module, const Valdi::FrameTimings& timings) override;
+
+    /**
+     Set whether the overlay should be drawn, which is the case by default.
+     Disabling the overlay drops the recorded frames.
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     Returns the recorded frames, from the oldest to the most recent one.
+     */
+    std::vector<Valdi::FrameTimings> getFrames() const;
+
+    /**
+     Returns a picture of the graph, laid out at the bottom of a surface of the given size.
+     The picture is re-recorded only when a frame was recorded since the last call.
+     */
+    sk_sp<SkPicture> getPicture(const Size& surfaceSize);
+
+    static constexpr size_t kDefaultMaxFramesCount = 120;
+
+private:
+    mutable Valdi::Mutex _mutex;
+    Valdi::FrameDuration _frameBudget;
+    std::vector<Valdi::FrameTimings> _frames;
+    size_t _nextFrameIndex = 0;
+    size_t _maxFramesCount;
+    uint64_t _sequence = 0;
+    std::atomic_bool _enabled = true;
+
+    sk_sp<SkPicture> _picture;
+    uint64_t _pictureSequence = 0;
+    Size _pictureSurfaceSize;
+
+    std::vector<Valdi::FrameTimings> lockFreeGetFrames() const;
+    sk_sp<SkPicture> makePicture(const std::vector<Valdi::FrameTimings>& frames, const Size& surfaceSize) const;
+};
+
+} // namespace snap::drawing
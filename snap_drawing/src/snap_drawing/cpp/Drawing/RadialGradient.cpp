@@ -6,6 +6,7 @@
 //
 
 #include "snap_drawing/cpp/Drawing/RadialGradient.hpp"
+#include "snap_drawing/cpp/Drawing/GradientShaderCache.hpp"
 #include "include/effects/SkGradientShader.h"
 #include <cmath>
 
@@ -37,63 +38,96 @@ void RadialGradient::setColors(std::vector<Color>&& colors) {
     }
 }
 
-void RadialGradient::updateShader(const Rect& bounds) {
+sk_sp<SkShader> RadialGradient::makeShader(const Rect& bounds) const {
+    auto width = bounds.width();
+    auto height = bounds.height();
+    auto radius = std::min(width / 2, height / 2);
+
+    const auto* colorsData = reinterpret_cast<const SkColor*>(_colors.data());
+
+    SkMatrix localMatrix;
+    if (width != height) {
+        localMatrix.postScale(width / height, 1);
+    }
+    localMatrix.postTranslate(bounds.x() + (width / 2), bounds.y() + (height / 2));
+
+    if (_colors.size() == _locations.size()) {
+        // User provided color distribution
+        return SkGradientShader::MakeRadial(Point::make(0, 0).getSkValue(),
+                                            radius,
+                                            colorsData,
+                                            _locations.data(),
+                                            static_cast<int>(_colors.size()),
+                                            SkTileMode::kClamp,
+                                            0,
+                                            &localMatrix);
+    }
+
+    // Distribute colors evenly
+    return SkGradientShader::MakeRadial(Point::make(0, 0).getSkValue(),
+                                        radius,
+                                        colorsData,
+                                        nullptr,
+                                        static_cast<int>(_colors.size()),
+                                        SkTileMode::kClamp,
+                                        0,
+                                        &localMatrix);
+}
+
+void RadialGradient::updateShader(const Rect& bounds, GradientShaderCache* shaderCache) {
     if (isEmpty()) {
         _shader = nullptr;
-    } else {
-        auto width = bounds.width();
-        auto height = bounds.height();
-        auto radius = std::min(width / 2, height / 2);
+        return;
+    }
 
-        const auto* colorsData = reinterpret_cast<const SkColor*>(_colors.data());
+    if (shaderCache == nullptr || bounds.width() <= 0 || bounds.height() <= 0) {
+        _shader = makeShader(bounds);
+        return;
+    }
 
-        SkMatrix localMatrix;
-        if (width != height) {
-            localMatrix.postScale(width / height, 1);
-        }
-        localMatrix.postTranslate(bounds.x() + (width / 2), bounds.y() + (height / 2));
-
-        sk_sp<SkShader> shader;
-        if (_colors.size() == _locations.size()) {
-            // User provided color distribution
-
-            _shader = SkGradientShader::MakeRadial(Point::make(0, 0).getSkValue(),
-                                                   radius,
-                                                   colorsData,
-                                                   _locations.data(),
-                                                   static_cast<int>(_colors.size()),
-                                                   SkTileMode::kClamp,
-                                                   0,
-                                                   &localMatrix);
-        } else {
-            // Distribute colors evenly
-            _shader = SkGradientShader::MakeRadial(Point::make(0, 0).getSkValue(),
-                                                   radius,
-                                                   colorsData,
-                                                   nullptr,
-                                                   static_cast<int>(_colors.size()),
-                                                   SkTileMode::kClamp,
-                                                   0,
-                                                   &localMatrix);
+    // The radius depends on the smallest side, the gradient can only be scaled uniformly
+    GradientShaderCacheKey key;
+    key.type = GradientShaderType::Radial;
+    key.aspectRatio = bounds.height() / bounds.width();
+    key.colors = _colors;
+    if (_colors.size() == _locations.size()) {
+        key.locations = _locations;
+    }
+
+    auto shader = shaderCache->find(key);
+    if (shader == nullptr) {
+        shader = makeShader(Rect::makeXYWH(0, 0, 1, key.aspectRatio));
+        if (shader == nullptr) {
+            _shader = nullptr;
+            return;
         }
+        shaderCache->insert(key, shader);
     }
+
+    SkMatrix localMatrix;
+    localMatrix.setScale(bounds.width(), bounds.width());
+    localMatrix.postTranslate(bounds.x(), bounds.y());
+
+    _shader = shader->makeWithLocalMatrix(localMatrix);
 }
 
 void RadialGradient::applyToPaint(Paint& paint) const {
     paint.getSkValue().setShader(_shader);
 }
 
-void RadialGradient::update(const Rect& bounds) {
+void RadialGradient::update(const Rect& bounds, GradientShaderCache* shaderCache) {
     if (_dirty || _lastDrawBounds != bounds) {
-        updateShader(bounds);
+        updateShader(bounds, shaderCache);
 
         _lastDrawBounds = bounds;
         _dirty = false;
     }
 }
 
-void RadialGradient::draw(DrawingContext& drawingContext, const BorderRadius& borderRadius) {
-    update(drawingContext.drawBounds());
+void RadialGradient::draw(DrawingContext& drawingContext,
+                          const BorderRadius& borderRadius,
+                          GradientShaderCache* shaderCache) {
+    update(drawingContext.drawBounds(), shaderCache);
 
     if (isEmpty()) {
         return;
@@ -0,0 +1,205 @@
+//
+//  BoxShadowCache.cpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "snap_drawing/cpp/Drawing/Raster/BoxShadowCache.hpp"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkPictureRecorder.h"
+#include "valdi_core/cpp/Utils/Trace.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace snap::drawing {
+
+// BoxShadow blurs with a sigma of twice the blur amount, and a gaussian blur
+// is considered to fade out after 3 sigmas
+static Scalar getBlurExtent(Scalar blurAmount) {
+    return std::ceil(blurAmount * 2.0f * 3.0f);
+}
+
+static Scalar getCornerExtent(const BoxShadowCacheKey& key) {
+    return std::ceil(std::max({key.topLeft, key.topRight, key.bottomRight, key.bottomLeft}));
+}
+
+// The center row and column of the image must be far enough from the corners and from
+// the edges that neither the corners nor the blur of the opposite edge reach them
+static int getPatchPixels(const BoxShadowCacheKey& key) {
+    auto patchPoints = getBlurExtent(key.blurAmount) * 2 + getCornerExtent(key);
+    return static_cast<int>(std::ceil(patchPoints * key.rasterScale));
+}
+
+static Scalar getImagePoints(int patchPixels, Scalar rasterScale) {
+    return static_cast<Scalar>(patchPixels * 2 + 1) / rasterScale;
+}
+
+static Scalar resolveRadius(Scalar radius, bool isPercent, Scalar sizeRatio) {
+    return isPercent ? radius * sizeRatio : radius;
+}
+
+bool BoxShadowCacheKey::operator==(const BoxShadowCacheKey& other) const {
+    return topLeft == other.topLeft && topRight == other.topRight && bottomRight == other.bottomRight &&
+           bottomLeft == other.bottomLeft && blurAmount == other.blurAmount && color == other.color &&
+           rasterScale == other.rasterScale;
+}
+
+bool BoxShadowCacheKey::operator!=(const BoxShadowCacheKey& other) const {
+    return !(*this == other);
+}
+
+size_t BoxShadowCacheKey::hash() const {
+    auto hash = std::hash<Scalar>()(topLeft);
+    boost::hash_combine(hash, std::hash<Scalar>()(topRight));
+    boost::hash_combine(hash, std::hash<Scalar>()(bottomRight));
+    boost::hash_combine(hash, std::hash<Scalar>()(bottomLeft));
+    boost::hash_combine(hash, std::hash<Scalar>()(blurAmount));
+    boost::hash_combine(hash, color.value);
+    boost::hash_combine(hash, std::hash<Scalar>()(rasterScale));
+    return hash;
+}
+
+BoxShadowNinePatch::BoxShadowNinePatch(sk_sp<SkImage> image, int patchPixels, Scalar blurExtent, Scalar rasterScale)
+    : _image(std::move(image)), _patchPixels(patchPixels), _blurExtent(blurExtent), _rasterScale(rasterScale) {}
+
+BoxShadowNinePatch::~BoxShadowNinePatch() = default;
+
+bool BoxShadowNinePatch::canDraw(const Rect& boxBounds) const {
+    auto minSize = getImagePoints(_patchPixels, _rasterScale) - _blurExtent * 2;
+    return boxBounds.width() >= minSize && boxBounds.height() >= minSize;
+}
+
+void BoxShadowNinePatch::draw(SkCanvas* canvas, const Rect& boxBounds) const {
+    // The corners are drawn at their pixel size, so the nine-patch is drawn in pixel coordinates
+    auto targetRect = SkRect::MakeLTRB((boxBounds.left - _blurExtent) * _rasterScale,
+                                       (boxBounds.top - _blurExtent) * _rasterScale,
+                                       (boxBounds.right + _blurExtent) * _rasterScale,
+                                       (boxBounds.bottom + _blurExtent) * _rasterScale);
+    auto center = SkIRect::MakeLTRB(_patchPixels, _patchPixels, _patchPixels + 1, _patchPixels + 1);
+
+    canvas->save();
+    canvas->scale(1.0f / _rasterScale, 1.0f / _rasterScale);
+    canvas->drawImageNine(_image.get(), center, targetRect, SkFilterMode::kLinear);
+    canvas->restore();
+}
+
+BoxShadowCache::BoxShadowCache(size_t capacity) : _cache(capacity) {}
+BoxShadowCache::~BoxShadowCache() = default;
+
+BoxShadowCacheKey BoxShadowCache::makeKey(
+    const BorderRadius& borderRadius, const Rect& boxBounds, Scalar blurAmount, Color color, Scalar rasterScale) {
+    auto sizeRatio = BorderRadius::sideLengthForPercentages(boxBounds) / 100;
+
+    BoxShadowCacheKey key;
+    key.topLeft = resolveRadius(borderRadius.topLeft(), borderRadius.topLeftIsPercent(), sizeRatio);
+    key.topRight = resolveRadius(borderRadius.topRight(), borderRadius.topRightIsPercent(), sizeRatio);
+    key.bottomRight = resolveRadius(borderRadius.bottomRight(), borderRadius.bottomRightIsPercent(), sizeRatio);
+    key.bottomLeft = resolveRadius(borderRadius.bottomLeft(), borderRadius.bottomLeftIsPercent(), sizeRatio);
+    key.blurAmount = blurAmount;
+    key.color = color;
+    key.rasterScale = rasterScale;
+    return key;
+}
+
+Ref<BoxShadowNinePatch> BoxShadowCache::getOrRender(const BorderRadius& borderRadius,
+                                                    const Rect& boxBounds,
+                                                    Scalar blurAmount,
+                                                    const Paint& paint,
+                                                    Scalar rasterScale) {
+    if (blurAmount <= 0 || rasterScale <= 0) {
+        return nullptr;
+    }
+
+    auto key = makeKey(borderRadius, boxBounds, blurAmount, paint.getColor(), rasterScale);
+
+    Ref<BoxShadowNinePatch> ninePatch;
+    {
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        const auto& it = _cache.find(key);
+        if (it != _cache.end()) {
+            ninePatch = it->value();
+        }
+    }
+
+    if (ninePatch == nullptr) {
+        // Don't render nine-patches for boxes too small to be drawn from them
+        auto minSize = getImagePoints(getPatchPixels(key), rasterScale) - getBlurExtent(blurAmount) * 2;
+        if (boxBounds.width() < minSize || boxBounds.height() < minSize) {
+            return nullptr;
+        }
+
+        ninePatch = render(key, paint);
+        if (ninePatch == nullptr) {
+            return nullptr;
+        }
+
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        _cache.insert(BoxShadowCacheKey(key), Ref<BoxShadowNinePatch>(ninePatch));
+    }
+
+    return ninePatch->canDraw(boxBounds) ? ninePatch : nullptr;
+}
+
+Ref<BoxShadowNinePatch> BoxShadowCache::render(const BoxShadowCacheKey& key, const Paint& paint) {
+    VALDI_TRACE("SnapDrawing.boxShadowCache.render");
+
+    auto blurExtent = getBlurExtent(key.blurAmount);
+    auto patchPixels = getPatchPixels(key);
+    auto imagePixels = patchPixels * 2 + 1;
+    auto imagePoints = getImagePoints(patchPixels, key.rasterScale);
+
+    auto boxBounds =
+        Rect::makeXYWH(blurExtent, blurExtent, imagePoints - blurExtent * 2, imagePoints - blurExtent * 2);
+    auto borderRadius =
+        BorderRadius(key.topLeft, key.topRight, key.bottomRight, key.bottomLeft, false, false, false, false);
+
+    SkPictureRecorder recorder;
+    auto* canvas = recorder.beginRecording(SkRect::MakeWH(imagePoints, imagePoints));
+    if (borderRadius.isEmpty()) {
+        canvas->drawRect(boxBounds.getSkValue(), paint.getSkValue());
+    } else {
+        canvas->drawPath(borderRadius.getPath(boxBounds).getSkValue(), paint.getSkValue());
+    }
+
+    auto matrix = SkMatrix::Scale(key.rasterScale, key.rasterScale);
+
+    // Like the LayerRasterCache, the image is generated on first draw by the raster thread
+    auto image = SkImages::DeferredFromPicture(recorder.finishRecordingAsPicture(),
+                                               SkISize::Make(imagePixels, imagePixels),
+                                               &matrix,
+                                               nullptr,
+                                               SkImages::BitDepth::kU8,
+                                               SkColorSpace::MakeSRGB());
+    if (image == nullptr) {
+        return nullptr;
+    }
+
+    return Valdi::makeShared<BoxShadowNinePatch>(std::move(image), patchPixels, blurExtent, key.rasterScale);
+}
+
+void BoxShadowCache::clear() {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _cache.clear();
+}
+
+size_t BoxShadowCache::size() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    return _cache.size();
+}
+
+} // namespace snap::drawing
+
+namespace std {
+
+std::size_t hash<snap::drawing::BoxShadowCacheKey>::operator()(
+    const snap::drawing::BoxShadowCacheKey& k) const noexcept {
+    return k.hash();
+}
+
+} // namespace std
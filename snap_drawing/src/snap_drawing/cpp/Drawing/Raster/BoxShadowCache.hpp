@@ -0,0 +1,123 @@
+//
+//  BoxShadowCache.hpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Drawing/Paint.hpp"
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/BorderRadius.hpp"
+#include "snap_drawing/cpp/Utils/Color.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+
+#include "valdi_core/cpp/Utils/LRUCache.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include "include/core/SkImage.h"
+#include "include/core/SkRect.h"
+
+class SkCanvas;
+
+namespace snap::drawing {
+
+/**
+ Identifies a rendered box shadow from its style. The corner radii are resolved,
+ so that percent based radii match the absolute radii they resolve to.
+ */
+struct BoxShadowCacheKey {
+    Scalar topLeft = 0;
+    Scalar topRight = 0;
+    Scalar bottomRight = 0;
+    Scalar bottomLeft = 0;
+    Scalar blurAmount = 0;
+    Color color;
+    Scalar rasterScale = 0;
+
+    bool operator==(const BoxShadowCacheKey& other) const;
+    bool operator!=(const BoxShadowCacheKey& other) const;
+
+    size_t hash() const;
+};
+
+} // namespace snap::drawing
+
+namespace std {
+
+template<>
+struct hash<snap::drawing::BoxShadowCacheKey> {
+    std::size_t operator()(const snap::drawing::BoxShadowCacheKey& k) const noexcept;
+};
+
+} // namespace std
+
+namespace snap::drawing {
+
+/**
+ The image of a blurred rounded rect of the smallest size where the corners and the blur
+ don't overlap. It is drawn as a nine-patch, stretching its center row and column.
+ */
+class BoxShadowNinePatch : public Valdi::SimpleRefCountable {
+public:
+    BoxShadowNinePatch(sk_sp<SkImage> image, int patchPixels, Scalar blurExtent, Scalar rasterScale);
+    ~BoxShadowNinePatch() override;
+
+    /**
+     Whether the shadow of a box with the given bounds can be drawn from the nine-patch,
+     which requires the box to be at least as large as the corners of the nine-patch.
+     */
+    bool canDraw(const Rect& boxBounds) const;
+
+    /**
+     Draw the shadow of a box with the given bounds.
+     */
+    void draw(SkCanvas* canvas, const Rect& boxBounds) const;
+
+private:
+    sk_sp<SkImage> _image;
+    int _patchPixels;
+    Scalar _blurExtent;
+    Scalar _rasterScale;
+};
+
+/**
+ A thread safe LRU cache of rendered box shadows, shared between the layers of a Resources
+ instance. Layers with the same shadow style draw it from the same nine-patch, stretched to
+ their size, instead of each blurring their own rounded rect at raster time.
+ */
+class BoxShadowCache : public Valdi::SimpleRefCountable {
+public:
+    explicit BoxShadowCache(size_t capacity);
+    ~BoxShadowCache() override;
+
+    /**
+     Returns the nine-patch to draw the shadow of a box with the given bounds and border radius,
+     rendering it with the given paint if it is not in the cache. Returns null if the shadow
+     cannot be drawn from a nine-patch, in which case it should be drawn directly.
+     */
+    Ref<BoxShadowNinePatch> getOrRender(const BorderRadius& borderRadius,
+                                        const Rect& boxBounds,
+                                        Scalar blurAmount,
+                                        const Paint& paint,
+                                        Scalar rasterScale);
+
+    void clear();
+
+    size_t size() const;
+
+    static BoxShadowCacheKey makeKey(const BorderRadius& borderRadius,
+                                     const Rect& boxBounds,
+                                     Scalar blurAmount,
+                                     Color color,
+                                     Scalar rasterScale);
+
+private:
+    mutable Valdi::Mutex _mutex;
+    Valdi::LRUCache<BoxShadowCacheKey, Ref<BoxShadowNinePatch>> _cache;
+
+    static Ref<BoxShadowNinePatch> render(const BoxShadowCacheKey& key, const Paint& paint);
+};
+
+} // namespace snap::drawing
@@ -0,0 +1,251 @@
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "valdi_core/cpp/Utils/Trace.hpp"
+
+#include <algorithm>
+#include <optional>
+
+namespace snap::drawing {
+
+// Size classes of the cells, each page only holds cells of a single size class
+constexpr int kSpriteSizeClasses[] = {32, 64, ImageAtlas::kMaxSpriteSize};
+// Each cell is surrounded by a copy of the edge pixels of its image, so that sampling
+// at the edges does not bleed into the neighbouring cells.
+constexpr int kCellGutter = 1;
+
+ImageAtlasSprite::ImageAtlasSprite(const Ref<ImageAtlas>& atlas,
+                                   const sk_sp<SkImage>& image,
+                                   size_t pageIndex,
+                                   size_t slotIndex,
+                                   uint64_t generation)
+    : _atlas(atlas), _image(image), _pageIndex(pageIndex), _slotIndex(slotIndex), _generation(generation) {}
+
+ImageAtlasSprite::~ImageAtlasSprite() = default;
+
+const Ref<ImageAtlas>& ImageAtlasSprite::getAtlas() const {
+    return _atlas;
+}
+
+const sk_sp<SkImage>& ImageAtlasSprite::getImage() const {
+    return _image;
+}
+
+size_t ImageAtlasSprite::getPageIndex() const {
+    return _pageIndex;
+}
+
+size_t ImageAtlasSprite::getSlotIndex() const {
+    return _slotIndex;
+}
+
+uint64_t ImageAtlasSprite::getGeneration() const {
+    return _generation;
+}
+
+ImageAtlas::ImageAtlas(int pageSize, size_t maxPagesCount) : _pageSize(pageSize), _maxPagesCount(maxPagesCount) {}
+
+ImageAtlas::~ImageAtlas() = default;
+
+Ref<ImageAtlasSprite> ImageAtlas::getOrInsert(const sk_sp<SkImage>& image) {
+    if (image == nullptr || image->isTextureBacked()) {
+        return nullptr;
+    }
+
+    auto width = image->width();
+    auto height = image->height();
+    if (width <= 0 || height <= 0 || width > kMaxSpriteSize || height > kMaxSpriteSize) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const auto& it = _slotsByImageId.find(image->uniqueID());
+    if (it != _slotsByImageId.end()) {
+        const auto& slot = _pages[it->second.pageIndex].slots[it->second.slotIndex];
+        return Valdi::makeShared<ImageAtlasSprite>(
+            Valdi::strongSmallRef(this), image, it->second.pageIndex, it->second.slotIndex, slot.generation);
+    }
+
+    auto spriteSize = std::max(width, height);
+    auto cellSize = 0;
+    for (auto sizeClass : kSpriteSizeClasses) {
+        if (spriteSize <= sizeClass) {
+            cellSize = sizeClass + kCellGutter * 2;
+            break;
+        }
+    }
+
+    SlotLocation location;
+    if (!allocateSlot(cellSize, location)) {
+        return nullptr;
+    }
+
+    auto& page = _pages[location.pageIndex];
+    auto& slot = page.slots[location.slotIndex];
+    slot.imageId = image->uniqueID();
+    slot.generation = ++_generationSequence;
+    slot.lastUsedSequence = ++_sequence;
+    slot.width = width;
+    slot.height = height;
+
+    copyImageToSlot(image, page, location.slotIndex);
+    _slotsByImageId[slot.imageId] = location;
+
+    return Valdi::makeShared<ImageAtlasSprite>(
+        Valdi::strongSmallRef(this), image, location.pageIndex, location.slotIndex, slot.generation);
+}
+
+bool ImageAtlas::resolve(const ImageAtlasSprite& sprite, sk_sp<SkImage>& pageImage, Rect& textureRect) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (sprite.getPageIndex() >= _pages.size()) {
+        return false;
+    }
+
+    auto& page = _pages[sprite.getPageIndex()];
+    auto& slot = page.slots[sprite.getSlotIndex()];
+    if (slot.generation != sprite.getGeneration()) {
+        return false;
+    }
+
+    slot.lastUsedSequence = ++_sequence;
+
+    if (page.image == nullptr) {
+        VALDI_TRACE("SnapDrawing.imageAtlas.snapshotPage");
+        page.image = page.bitmap.asImage();
+    }
+
+    auto slotRect = getSlotRect(page, sprite.getSlotIndex());
+    pageImage = page.image;
+    textureRect = Rect::makeXYWH(static_cast<Scalar>(slotRect.x() + kCellGutter),
+                                 static_cast<Scalar>(slotRect.y() + kCellGutter),
+                                 static_cast<Scalar>(slot.width),
+                                 static_cast<Scalar>(slot.height));
+
+    return pageImage != nullptr;
+}
+
+size_t ImageAtlas::getPagesCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pages.size();
+}
+
+size_t ImageAtlas::getSpritesCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _slotsByImageId.size();
+}
+
+void ImageAtlas::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Generations are not reset, so that sprites of the cleared pages cannot resolve to new slots
+    _pages.clear();
+    _slotsByImageId.clear();
+}
+
+bool ImageAtlas::allocateSlot(int cellSize, SlotLocation& location) {
+    for (size_t pageIndex = 0; pageIndex < _pages.size(); pageIndex++) {
+        const auto& page = _pages[pageIndex];
+        if (page.cellSize != cellSize) {
+            continue;
+        }
+
+        for (size_t slotIndex = 0; slotIndex < page.slots.size(); slotIndex++) {
+            if (page.slots[slotIndex].imageId == 0) {
+                location = SlotLocation{pageIndex, slotIndex};
+                return true;
+            }
+        }
+    }
+
+    auto cellsPerRow = _pageSize / cellSize;
+    if (_pages.size() < _maxPagesCount && cellsPerRow > 0) {
+        VALDI_TRACE("SnapDrawing.imageAtlas.allocatePage");
+
+        auto& page = _pages.emplace_back();
+        page.cellSize = cellSize;
+        page.cellsPerRow = cellsPerRow;
+        page.slots.resize(static_cast<size_t>(cellsPerRow * cellsPerRow));
+        if (!page.bitmap.tryAllocPixels(SkImageInfo::MakeN32Premul(_pageSize, _pageSize))) {
+            _pages.pop_back();
+            return false;
+        }
+        page.bitmap.eraseColor(SK_ColorTRANSPARENT);
+
+        location = SlotLocation{_pages.size() - 1, 0};
+        return true;
+    }
+
+    // Evict the least recently used sprite of the same size class
+    std::optional<SlotLocation> leastRecentlyUsed;
+    uint64_t leastRecentlyUsedSequence = 0;
+    for (size_t pageIndex = 0; pageIndex < _pages.size(); pageIndex++) {
+        const auto& page = _pages[pageIndex];
+        if (page.cellSize != cellSize) {
+            continue;
+        }
+
+        for (size_t slotIndex = 0; slotIndex < page.slots.size(); slotIndex++) {
+            const auto& slot = page.slots[slotIndex];
+            if (!leastRecentlyUsed || slot.lastUsedSequence < leastRecentlyUsedSequence) {
+                leastRecentlyUsed = SlotLocation{pageIndex, slotIndex};
+                leastRecentlyUsedSequence = slot.lastUsedSequence;
+            }
+        }
+    }
+
+    if (!leastRecentlyUsed) {
+        return false;
+    }
+
+    location = leastRecentlyUsed.value();
+    auto& slot = _pages[location.pageIndex].slots[location.slotIndex];
+    _slotsByImageId.erase(slot.imageId);
+    slot = Slot();
+
+    return true;
+}
+
+void ImageAtlas::copyImageToSlot(const sk_sp<SkImage>& image, Page& page, size_t slotIndex) {
+    VALDI_TRACE("SnapDrawing.imageAtlas.copyImage");
+
+    auto slotRect = getSlotRect(page, slotIndex);
+    auto x = static_cast<Scalar>(slotRect.x() + kCellGutter);
+    auto y = static_cast<Scalar>(slotRect.y() + kCellGutter);
+    auto width = static_cast<Scalar>(image->width());
+    auto height = static_cast<Scalar>(image->height());
+
+    SkCanvas canvas(page.bitmap);
+    canvas.clipIRect(slotRect);
+
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    SkSamplingOptions sampling(SkFilterMode::kNearest);
+
+    canvas.drawImage(image, x, y, sampling, &paint);
+
+    // Extrude the edges into the gutter
+    auto drawEdge = [&](const SkRect& src, const SkRect& dst) {
+        canvas.drawImageRect(image, src, dst, sampling, &paint, SkCanvas::kStrict_SrcRectConstraint);
+    };
+    drawEdge(SkRect::MakeXYWH(0, 0, width, 1), SkRect::MakeXYWH(x, y - 1, width, 1));
+    drawEdge(SkRect::MakeXYWH(0, height - 1, width, 1), SkRect::MakeXYWH(x, y + height, width, 1));
+    drawEdge(SkRect::MakeXYWH(0, 0, 1, height), SkRect::MakeXYWH(x - 1, y, 1, height));
+    drawEdge(SkRect::MakeXYWH(width - 1, 0, 1, height), SkRect::MakeXYWH(x + width, y, 1, height));
+    drawEdge(SkRect::MakeXYWH(0, 0, 1, 1), SkRect::MakeXYWH(x - 1, y - 1, 1, 1));
+    drawEdge(SkRect::MakeXYWH(width - 1, 0, 1, 1), SkRect::MakeXYWH(x + width, y - 1, 1, 1));
+    drawEdge(SkRect::MakeXYWH(0, height - 1, 1, 1), SkRect::MakeXYWH(x - 1, y + height, 1, 1));
+    drawEdge(SkRect::MakeXYWH(width - 1, height - 1, 1, 1), SkRect::MakeXYWH(x + width, y + height, 1, 1));
+
+    // The page changed, its image needs to be created again
+    page.image = nullptr;
+}
+
+SkIRect ImageAtlas::getSlotRect(const Page& page, size_t slotIndex) const {
+    auto column = static_cast<int>(slotIndex) % page.cellsPerRow;
+    auto row = static_cast<int>(slotIndex) / page.cellsPerRow;
+
+    return SkIRect::MakeXYWH(column * page.cellSize, row * page.cellSize, page.cellSize, page.cellSize);
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
+
+#include <mutex>
+#include <vector>
+
+namespace snap::drawing {
+
+class ImageAtlas;
+
+/**
+ A copy of an image stored within a page of an ImageAtlas. The slot holding the copy can be
+ evicted at any time to make room for other images. The sprite keeps a reference to the
+ original image, which is drawn instead when it is no longer in the atlas.
+ */
+class ImageAtlasSprite : public Valdi::SimpleRefCountable {
+public:
+    ImageAtlasSprite(const Ref<ImageAtlas>& atlas,
+                     const sk_sp<SkImage>& image,
+                     size_t pageIndex,
+                     size_t slotIndex,
+                     uint64_t generation);
+    ~ImageAtlasSprite() override;
+
+    const Ref<ImageAtlas>& getAtlas() const;
+    const sk_sp<SkImage>& getImage() const;
+    size_t getPageIndex() const;
+    size_t getSlotIndex() const;
+    uint64_t getGeneration() const;
+
+private:
+    Ref<ImageAtlas> _atlas;
+    sk_sp<SkImage> _image;
+    size_t _pageIndex;
+    size_t _slotIndex;
+    uint64_t _generation;
+};
+
+/**
+ ImageAtlas packs small images into a few shared pages, so that many of them can be drawn
+ with a single drawAtlas() call sourcing from the same texture. Pages are split into cells
+ of a single size class. When no cell of the right size class is available and the pages
+ limit is reached, the least recently drawn sprite of that size class is evicted.
+ Sprites are inserted when recording layers, and resolved from the raster thread.
+ */
+class ImageAtlas : public Valdi::SimpleRefCountable {
+public:
+    /**
+     Images with a width or height above this size are never stored in the atlas.
+     */
+    static constexpr int kMaxSpriteSize = 128;
+
+    ImageAtlas(int pageSize, size_t maxPagesCount);
+    ~ImageAtlas() override;
+
+    /**
+     Returns the sprite holding a copy of the given image, copying the image into the atlas
+     if needed. Returns null if the image cannot be stored in the atlas.
+     */
+    Ref<ImageAtlasSprite> getOrInsert(const sk_sp<SkImage>& image);
+
+    /**
+     Resolve the page image and the rect within it where the sprite is stored, and mark the
+     sprite as used. Returns false if the sprite was evicted.
+     */
+    bool resolve(const ImageAtlasSprite& sprite, sk_sp<SkImage>& pageImage, Rect& textureRect);
+
+    size_t getPagesCount() const;
+    size_t getSpritesCount() const;
+
+    void clear();
+
+private:
+    struct Slot {
+        uint32_t imageId = 0;
+        uint64_t generation = 0;
+        uint64_t lastUsedSequence = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    struct Page {
+        int cellSize;
+        int cellsPerRow;
+        SkBitmap bitmap;
+        // Immutable copy of the bitmap, recreated when the bitmap changed since the last draw
+        sk_sp<SkImage> image;
+        std::vector<Slot> slots;
+    };
+
+    struct SlotLocation {
+        size_t pageIndex;
+        size_t slotIndex;
+    };
+
+    mutable std::mutex _mutex;
+    std::vector<Page> _pages;
+    Valdi::FlatMap<uint32_t, SlotLocation> _slotsByImageId;
+    int _pageSize;
+    size_t _maxPagesCount;
+    uint64_t _sequence = 0;
+    uint64_t _generationSequence = 0;
+
+    bool allocateSlot(int cellSize, SlotLocation& location);
+    void copyImageToSlot(const sk_sp<SkImage>& image, Page& page, size_t slotIndex);
+    SkIRect getSlotRect(const Page& page, size_t slotIndex) const;
+};
+
+} // namespace snap::drawing
@@ -0,0 +1,139 @@
+#include "snap_drawing/cpp/Drawing/Raster/LayerRasterCache.hpp"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPictureRecorder.h"
+#include "valdi_core/cpp/Utils/Trace.hpp"
+#include <cmath>
+
+namespace snap::drawing {
+
+// Matches the 4 bytes per pixel of the N32 images Skia generates from pictures
+constexpr size_t kRasterBytesPerPixel = 4;
+
+LayerRasterCache::LayerRasterCache(size_t memoryBudgetBytes, size_t minStableFrames)
+    : _memoryBudgetBytes(memoryBudgetBytes), _minStableFrames(minStableFrames) {}
+
+LayerRasterCache::~LayerRasterCache() = default;
+
+size_t LayerRasterCache::getMinStableFrames() const {
+    return _minStableFrames;
+}
+
+size_t LayerRasterCache::getMemoryBudgetBytes() const {
+    return _memoryBudgetBytes;
+}
+
+size_t LayerRasterCache::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _usedBytes;
+}
+
+size_t LayerRasterCache::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+LayerContent LayerRasterCache::find(LayerId layerId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& entry : _entries) {
+        if (entry.layerId == layerId) {
+            entry.lastUsedSequence = ++_sequence;
+            return entry.content;
+        }
+    }
+
+    return LayerContent();
+}
+
+LayerContent LayerRasterCache::insert(LayerId layerId,
+                                      const sk_sp<SkPicture>& picture,
+                                      const Rect& bounds,
+                                      Scalar rasterScale) {
+    auto pixelWidth = static_cast<int>(std::ceil(bounds.width() * rasterScale));
+    auto pixelHeight = static_cast<int>(std::ceil(bounds.height() * rasterScale));
+    if (pixelWidth <= 0 || pixelHeight <= 0) {
+        return LayerContent();
+    }
+
+    auto bytes = static_cast<size_t>(pixelWidth) * static_cast<size_t>(pixelHeight) * kRasterBytesPerPixel;
+    if (bytes > _memoryBudgetBytes) {
+        return LayerContent();
+    }
+
+    VALDI_TRACE("SnapDrawing.layerRasterCache.insert");
+
+    auto matrix = SkMatrix::Scale(rasterScale, rasterScale);
+    matrix.preTranslate(-bounds.left, -bounds.top);
+
+    // The image is generated on first draw and is then kept in the Skia resource cache,
+    // which can purge it and regenerate it from the picture under memory pressure.
+    auto image = SkImages::DeferredFromPicture(picture,
+                                               SkISize::Make(pixelWidth, pixelHeight),
+                                               &matrix,
+                                               nullptr,
+                                               SkImages::BitDepth::kU8,
+                                               SkColorSpace::MakeSRGB());
+    if (image == nullptr) {
+        return LayerContent();
+    }
+
+    SkPictureRecorder recorder;
+    auto* canvas = recorder.beginRecording(bounds.getSkValue());
+    canvas->drawImageRect(image, bounds.getSkValue(), SkSamplingOptions(SkFilterMode::kLinear));
+
+    LayerContent content(recorder.finishRecordingAsPicture(), nullptr);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto it = _entries.begin(); it != _entries.end(); it++) {
+        if (it->layerId == layerId) {
+            _usedBytes -= it->bytes;
+            _entries.erase(it);
+            break;
+        }
+    }
+
+    while (!_entries.empty() && _usedBytes + bytes > _memoryBudgetBytes) {
+        evictLeastRecentlyUsed();
+    }
+
+    auto& entry = _entries.emplace_back();
+    entry.layerId = layerId;
+    entry.content = content;
+    entry.bytes = bytes;
+    entry.lastUsedSequence = ++_sequence;
+    _usedBytes += bytes;
+
+    return content;
+}
+
+void LayerRasterCache::remove(LayerId layerId) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto it = _entries.begin(); it != _entries.end(); it++) {
+        if (it->layerId == layerId) {
+            _usedBytes -= it->bytes;
+            _entries.erase(it);
+            return;
+        }
+    }
+}
+
+void LayerRasterCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _usedBytes = 0;
+}
+
+void LayerRasterCache::evictLeastRecentlyUsed() {
+    auto leastRecentlyUsed = _entries.begin();
+    for (auto it = _entries.begin(); it != _entries.end(); it++) {
+        if (it->lastUsedSequence < leastRecentlyUsed->lastUsedSequence) {
+            leastRecentlyUsed = it;
+        }
+    }
+
+    _usedBytes -= leastRecentlyUsed->bytes;
+    _entries.erase(leastRecentlyUsed);
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "snap_drawing/cpp/Drawing/LayerContent.hpp"
+#include "snap_drawing/cpp/Layers/Interfaces/ILayer.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+#include "snap_drawing/cpp/Utils/Scalar.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include <mutex>
+#include <vector>
+
+namespace snap::drawing {
+
+/**
+LayerRasterCache retains rasterized images of layer subtrees which did not change for a number of
+frames, so that they can be drawn as a single image instead of replaying all their draw operations.
+The images are rasterized lazily by Skia the first time they are drawn. Entries are evicted in least
+recently used order when the total size of the images would go above the memory budget.
+ */
+class LayerRasterCache : public Valdi::SimpleRefCountable {
+public:
+    LayerRasterCache(size_t memoryBudgetBytes, size_t minStableFrames);
+    ~LayerRasterCache() override;
+
+    /**
+    Returns how many consecutive frames a layer subtree must be drawn without any changes
+    before it gets rasterized.
+     */
+    size_t getMinStableFrames() const;
+
+    size_t getMemoryBudgetBytes() const;
+    size_t getUsedBytes() const;
+    size_t size() const;
+
+    /**
+    Returns the cached content for the given layer, or an empty content if the layer is not in the cache.
+     */
+    LayerContent find(LayerId layerId);
+
+    /**
+    Rasterize the picture representing the subtree of the given layer within the given bounds,
+    and store the result in the cache. Returns the content to draw in place of the subtree, or an
+    empty content if the image does not fit in the memory budget.
+     */
+    LayerContent insert(LayerId layerId, const sk_sp<SkPicture>& picture, const Rect& bounds, Scalar rasterScale);
+
+    void remove(LayerId layerId);
+
+    void clear();
+
+private:
+    struct Entry {
+        LayerId layerId;
+        LayerContent content;
+        size_t bytes;
+        uint64_t lastUsedSequence;
+    };
+
+    mutable std::mutex _mutex;
+    std::vector<Entry> _entries;
+    size_t _memoryBudgetBytes;
+    size_t _minStableFrames;
+    size_t _usedBytes = 0;
+    uint64_t _sequence = 0;
+
+    void evictLeastRecentlyUsed();
+};
+
+} // namespace snap::drawing
@@ -9,13 +9,16 @@
 #include "snap_drawing/cpp/Drawing/Raster/RasterDamageResolver.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/ExternalSurface.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/ExternalSurfacePresenterState.hpp"
-#include "snap_drawing/cpp/Utils/Bitmap.hpp"
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
 #include "valdi_core/cpp/Interfaces/IBitmap.hpp"
 #include "valdi_core/cpp/Interfaces/IBitmapFactory.hpp"
 #include "valdi_core/cpp/Interfaces/ILogger.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 // These come from Skia SkBlitRow.h .
 // We use them for blending rows. They are highly optimized under the hood,
@@ -34,6 +37,9 @@ public:
 
 namespace snap::drawing {
 
+// Below this height, the cost of dispatching a band outweighs the cost of rasterizing it
+constexpr int kMinRasterBandHeight = 128;
+
 struct RasterContext::CompositionResult {
     CompositorPlaneList planeList;
     Ref<DisplayList> displayList;
@@ -44,9 +50,21 @@ RasterContext::RasterContext(Valdi::ILogger& logger,
                              bool enableDeltaRasterization)
     : _logger(logger),
       _externalSurfaceRasterizationMethod(externalSurfaceRasterizationMethod),
-      _deltaRasterizationEnabled(enableDeltaRasterization) {}
+      _deltaRasterizationEnabled(enableDeltaRasterization) {
+    // The damage is always resolved against a bitmap holding the last rasterized frame,
+    // on which scrolled content can be shifted
+    _rasterDamageResolver.setContentShiftEnabled(true);
+}
 RasterContext::~RasterContext() = default;
 
+void RasterContext::setParallelRasterizationEnabled(bool parallelRasterizationEnabled) {
+    _parallelRasterizationEnabled = parallelRasterizationEnabled;
+}
+
+bool RasterContext::isParallelRasterizationEnabled() const {
+    return _parallelRasterizationEnabled;
+}
+
 RasterContext::CompositionResult RasterContext::performCompositionIfNeeded(const Ref<DisplayList>& displayList) const {
     CompositionResult result;
 
@@ -85,7 +103,7 @@ Valdi::Result<RasterContext::RasterResult> RasterContext::raster(const Ref<Displ
 
             {
                 VALDI_TRACE("SnapDrawing.rasterContext.allocateDeltaBitmap");
-                auto newBitmap = Bitmap::make(inputBitmapInfo);
+                auto newBitmap = BitmapPool::getShared()->allocateBitmap(inputBitmapInfo);
                 if (!newBitmap) {
                     return newBitmap.moveError();
                 }
@@ -93,17 +111,24 @@ Valdi::Result<RasterContext::RasterResult> RasterContext::raster(const Ref<Displ
                 _lastBitmap = newBitmap.value();
             }
 
+            // Pooled bitmaps are not zeroed, the delta bitmap is always cleared since it might be blended
+            // into the output bitmap
             auto result = rasterNonDelta(_lastBitmap,
                                          *composition.displayList,
                                          composition.planeList,
                                          inputBitmapInfo,
-                                         shouldClearBitmapBeforeDrawing,
+                                         /* shouldClearBitmapBeforeDrawing */ true,
                                          rasterId);
             if (!result) {
                 return result.moveError();
             }
         } else {
-            auto result = doRasterDelta(composition, _lastBitmap, inputBitmapInfo, damageRects, rasterId);
+            auto result = doRasterDelta(composition,
+                                        _lastBitmap,
+                                        inputBitmapInfo,
+                                        damageRects,
+                                        _rasterDamageResolver.getContentShift(),
+                                        rasterId);
             if (!result) {
                 return result.moveError();
             }
@@ -203,18 +228,50 @@ Valdi::Result<RasterContext::RasterResult> RasterContext::rasterDelta(const Ref<
     auto damageRects = computeDamageRects(displayList, inputBitmapInfo);
 
     auto composition = performCompositionIfNeeded(displayList);
-    auto result = doRasterDelta(composition, bitmap, bitmap->getInfo(), damageRects, rasterId);
+    auto result = doRasterDelta(
+        composition, bitmap, bitmap->getInfo(), damageRects, _rasterDamageResolver.getContentShift(), rasterId);
 
     removeUnusedCachedRasterizedExternalSurfaces(rasterId);
 
     return result;
 }
 
-Valdi::Result<RasterContext::RasterResult> RasterContext::doRasterDelta(const CompositionResult& compositionResult,
-                                                                        const Ref<Valdi::IBitmap>& bitmap,
-                                                                        const Valdi::BitmapInfo& bitmapInfo,
-                                                                        const std::vector<Rect>& damageRects,
-                                                                        size_t rasterId) {
+Valdi::Result<RasterContext::RasterResult> RasterContext::doRasterDelta(
+    const CompositionResult& compositionResult,
+    const Ref<Valdi::IBitmap>& bitmap,
+    const Valdi::BitmapInfo& bitmapInfo,
+    const std::vector<Rect>& damageRects,
+    const std::optional<RasterContentShift>& contentShift,
+    size_t rasterId) {
+    if (contentShift) {
+        auto result = applyContentShift(bitmap, bitmapInfo, contentShift.value());
+        if (!result) {
+            return result.moveError();
+        }
+    }
+
+    auto bandsCount = resolveRasterBandsCount(compositionResult.planeList, bitmapInfo);
+    if (bandsCount > 1) {
+        auto result = rasterInBands(bitmap,
+                                    *compositionResult.displayList,
+                                    compositionResult.planeList,
+                                    bitmapInfo,
+                                    damageRects,
+                                    true,
+                                    bandsCount,
+                                    rasterId);
+        if (!result) {
+            return result.moveError();
+        }
+
+        RasterResult output;
+        for (const auto& damageRect : damageRects) {
+            output.renderedPixelsCount +=
+                static_cast<size_t>(damageRect.width()) * static_cast<size_t>(damageRect.height());
+        }
+        return output;
+    }
+
     BitmapGraphicsContext graphicsContext;
     auto surface = graphicsContext.createBitmapSurface(bitmap);
 
@@ -250,6 +307,53 @@ Valdi::Result<RasterContext::RasterResult> RasterContext::doRasterDelta(const Co
     return output;
 }
 
+Valdi::Result<Valdi::Void> RasterContext::applyContentShift(const Ref<Valdi::IBitmap>& bitmap,
+                                                            const Valdi::BitmapInfo& bitmapInfo,
+                                                            const RasterContentShift& contentShift) {
+    VALDI_TRACE("SnapDrawing.rasterContext.applyContentShift");
+    auto bytesPerPixel = Valdi::BitmapInfo::bytesPerPixelForColorType(bitmapInfo.colorType);
+
+    // Destination of the pixels which stay within the region once shifted
+    auto left = static_cast<int>(contentShift.region.left) + std::max(contentShift.dx, 0);
+    auto right = static_cast<int>(contentShift.region.right) + std::min(contentShift.dx, 0);
+    auto top = static_cast<int>(contentShift.region.top) + std::max(contentShift.dy, 0);
+    auto bottom = static_cast<int>(contentShift.region.bottom) + std::min(contentShift.dy, 0);
+    left = std::max(left, 0);
+    top = std::max(top, 0);
+    right = std::min(right, bitmapInfo.width);
+    bottom = std::min(bottom, bitmapInfo.height);
+    if (left >= right || top >= bottom) {
+        return Valdi::Void();
+    }
+
+    auto* bytes = reinterpret_cast<uint8_t*>(bitmap->lockBytes());
+    if (bytes == nullptr) {
+        return Valdi::Error("Failed to lock bytes");
+    }
+
+    auto rowLength = static_cast<size_t>(right - left) * bytesPerPixel;
+    auto moveRow = [&](int y) {
+        auto* dst = bytes + static_cast<size_t>(y) * bitmapInfo.rowBytes + static_cast<size_t>(left) * bytesPerPixel;
+        const auto* src = bytes + static_cast<size_t>(y - contentShift.dy) * bitmapInfo.rowBytes +
+                          static_cast<size_t>(left - contentShift.dx) * bytesPerPixel;
+        std::memmove(dst, src, rowLength);
+    };
+
+    // Rows are moved in the order that doesn't overwrite the rows that still need to be moved
+    if (contentShift.dy > 0) {
+        for (auto y = bottom - 1; y >= top; y--) {
+            moveRow(y);
+        }
+    } else {
+        for (auto y = top; y < bottom; y++) {
+            moveRow(y);
+        }
+    }
+
+    bitmap->unlockBytes();
+    return Valdi::Void();
+}
+
 Valdi::Result<Valdi::Void> RasterContext::rasterNonDelta(const Ref<Valdi::IBitmap>& bitmap,
                                                          const DisplayList& displayList,
                                                          const CompositorPlaneList& planeList,
@@ -257,6 +361,22 @@ Valdi::Result<Valdi::Void> RasterContext::rasterNonDelta(const Ref<Valdi::IBitma
                                                          bool shouldClearBitmapBeforeDrawing,
                                                          size_t rasterId) {
     VALDI_TRACE("SnapDrawing.rasterContext.rasterNonDelta");
+    auto bandsCount = resolveRasterBandsCount(planeList, bitmapInfo);
+    if (bandsCount > 1) {
+        std::vector<Rect> clipRects = {Rect::makeXYWH(0,
+                                                      0,
+                                                      static_cast<Scalar>(bitmapInfo.width),
+                                                      static_cast<Scalar>(bitmapInfo.height))};
+        return rasterInBands(bitmap,
+                             displayList,
+                             planeList,
+                             bitmapInfo,
+                             clipRects,
+                             shouldClearBitmapBeforeDrawing,
+                             bandsCount,
+                             rasterId);
+    }
+
     BitmapGraphicsContext graphicsContext;
     auto surface = graphicsContext.createBitmapSurface(bitmap);
 
@@ -273,6 +393,93 @@ Valdi::Result<Valdi::Void> RasterContext::rasterNonDelta(const Ref<Valdi::IBitma
     return doRasterResult;
 }
 
+size_t RasterContext::resolveRasterBandsCount(const CompositorPlaneList& planeList,
+                                              const Valdi::BitmapInfo& bitmapInfo) const {
+    if (!_parallelRasterizationEnabled) {
+        return 1;
+    }
+
+    for (const auto& plane : planeList) {
+        if (plane.getType() == CompositorPlaneTypeExternal) {
+            // External surfaces are rasterized through the platform and share the cache, keep them serial
+            return 1;
+        }
+    }
+
+    auto maxBandsCount = static_cast<size_t>(std::max(bitmapInfo.height / kMinRasterBandHeight, 1));
+    return std::min(maxBandsCount, Valdi::ThreadPool::getShared()->getWorkersCount() + 1);
+}
+
+Valdi::Result<Valdi::Void> RasterContext::rasterInBands(const Ref<Valdi::IBitmap>& bitmap,
+                                                        const DisplayList& displayList,
+                                                        const CompositorPlaneList& planeList,
+                                                        const Valdi::BitmapInfo& bitmapInfo,
+                                                        const std::vector<Rect>& clipRects,
+                                                        bool shouldClearBitmapBeforeDrawing,
+                                                        size_t bandsCount,
+                                                        size_t rasterId) {
+    VALDI_TRACE("SnapDrawing.rasterContext.rasterInBands");
+    auto* bytes = bitmap->lockBytes();
+    if (bytes == nullptr) {
+        return Valdi::Error("Failed to lock bytes");
+    }
+
+    auto bandHeight = (bitmapInfo.height + static_cast<int>(bandsCount) - 1) / static_cast<int>(bandsCount);
+    std::vector<Valdi::Result<Valdi::Void>> results(bandsCount);
+
+    Valdi::ThreadPool::getShared()->parallelFor(bandsCount, bandsCount, [&](size_t index) {
+        VALDI_TRACE("SnapDrawing.rasterContext.rasterBand");
+        auto top = static_cast<int>(index) * bandHeight;
+        auto bottom = std::min(top + bandHeight, bitmapInfo.height);
+        auto bandRect = Rect::makeLTRB(
+            0, static_cast<Scalar>(top), static_cast<Scalar>(bitmapInfo.width), static_cast<Scalar>(bottom));
+
+        // Each band wraps the pixels in its own surface. The bands are clipped on integer
+        // boundaries, so they never write to the same pixels.
+        BitmapGraphicsContext graphicsContext;
+        auto surface = graphicsContext.createBitmapSurface(bitmapInfo, bytes);
+
+        auto canvas = surface->prepareCanvas();
+        if (!canvas) {
+            results[index] = canvas.moveError();
+            return;
+        }
+
+        auto* skiaCanvas = canvas.value().getSkiaCanvas();
+        for (const auto& clipRect : clipRects) {
+            if (!clipRect.intersects(bandRect)) {
+                continue;
+            }
+
+            auto saveCount = skiaCanvas->save();
+            skiaCanvas->clipRect(clipRect.intersection(bandRect).getSkValue());
+
+            auto doRasterResult =
+                doRaster(canvas.value(), displayList, planeList, bitmapInfo, shouldClearBitmapBeforeDrawing, rasterId);
+
+            skiaCanvas->restoreToCount(saveCount);
+
+            if (!doRasterResult) {
+                results[index] = doRasterResult.moveError();
+                return;
+            }
+        }
+
+        surface->flush();
+        results[index] = Valdi::Void();
+    });
+
+    bitmap->unlockBytes();
+
+    for (auto& result : results) {
+        if (!result) {
+            return result.moveError();
+        }
+    }
+
+    return Valdi::Void();
+}
+
 Valdi::Result<Valdi::Void> RasterContext::doRaster(DrawableSurfaceCanvas& canvas,
                                                    const DisplayList& displayList,
                                                    const CompositorPlaneList& planeList,
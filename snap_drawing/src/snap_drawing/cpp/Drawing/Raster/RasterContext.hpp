@@ -6,6 +6,7 @@
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace Valdi {
@@ -52,7 +53,13 @@ them into bitmaps and compositing them into the final bitmap. The raster context
 avoid re-rasterizing external surfaces for each frame if they don't change.
 
 If "enableDeltaRasterization" is true, all the raster operations will be delta rasterized, with the
-RasterContext keeping a bitmap cache of the last raster pass.
+RasterContext keeping a bitmap cache of the last raster pass. When content scrolled by whole pixels
+since the last pass, the pixels of the scrolled region are moved in place within the bitmap, so that
+only the newly exposed area and the layers which changed are rasterized again.
+
+If parallel rasterization is enabled, the output bitmap is split into horizontal bands which are
+rasterized concurrently on the shared ThreadPool, each band replaying the display list with its own
+clip. Display lists with external surfaces are always rasterized on the calling thread.
  */
 class RasterContext : public Valdi::SimpleRefCountable {
 public:
@@ -74,6 +81,13 @@ public:
      */
     Valdi::Result<RasterResult> rasterDelta(const Ref<DisplayList>& displayList, const Ref<Valdi::IBitmap>& bitmap);
 
+    /**
+    Set whether large bitmaps should be rasterized using multiple threads.
+    This requires the content of the display lists to be safe to draw concurrently.
+     */
+    void setParallelRasterizationEnabled(bool parallelRasterizationEnabled);
+    bool isParallelRasterizationEnabled() const;
+
 private:
     struct CachedRasterizedExternalSurface {
         Ref<Image> image;
@@ -96,6 +110,7 @@ private:
     Ref<Valdi::IBitmap> _lastBitmap;
     RasterDamageResolver _rasterDamageResolver;
     bool _deltaRasterizationEnabled;
+    std::atomic_bool _parallelRasterizationEnabled = false;
 
     CompositionResult performCompositionIfNeeded(const Ref<DisplayList>& displayList) const;
 
@@ -110,8 +125,13 @@ private:
                                               const Ref<Valdi::IBitmap>& bitmap,
                                               const Valdi::BitmapInfo& bitmapInfo,
                                               const std::vector<Rect>& damageRects,
+                                              const std::optional<RasterContentShift>& contentShift,
                                               size_t rasterId);
 
+    static Valdi::Result<Valdi::Void> applyContentShift(const Ref<Valdi::IBitmap>& bitmap,
+                                                        const Valdi::BitmapInfo& bitmapInfo,
+                                                        const RasterContentShift& contentShift);
+
     Valdi::Result<Valdi::Void> rasterNonDelta(const Ref<Valdi::IBitmap>& bitmap,
                                               const DisplayList& displayList,
                                               const CompositorPlaneList& planeList,
@@ -119,6 +139,17 @@ private:
                                               bool shouldClearBitmapBeforeDrawing,
                                               size_t rasterId);
 
+    Valdi::Result<Valdi::Void> rasterInBands(const Ref<Valdi::IBitmap>& bitmap,
+                                             const DisplayList& displayList,
+                                             const CompositorPlaneList& planeList,
+                                             const Valdi::BitmapInfo& bitmapInfo,
+                                             const std::vector<Rect>& clipRects,
+                                             bool shouldClearBitmapBeforeDrawing,
+                                             size_t bandsCount,
+                                             size_t rasterId);
+
+    size_t resolveRasterBandsCount(const CompositorPlaneList& planeList, const Valdi::BitmapInfo& bitmapInfo) const;
+
     Valdi::Result<Ref<Image>> getOrCreateRasterImageForExternalSurfaceSnapshot(
         ExternalSurfaceSnapshot* externalSurfaceSnapshot,
         const Rect& frame,
@@ -3,6 +3,8 @@
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
 #include "snap_drawing/cpp/Drawing/Mask/IMask.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace snap::drawing {
 
@@ -40,7 +42,16 @@ struct ComputeDamageVisitor {
     }
 
     void visit(const Operations::DrawPicture& drawPicture) {
-        addDamageIfNeeded(fromSkValue<Rect>(drawPicture.picture->cullRect()));
+        const auto& compositionState = getCurrentContext().compositionState;
+        auto uniformRect = Rect::makeEmpty();
+        // The opaque rect of a picture is only set from a solid background color
+        if (!drawPicture.opaqueRect.isEmpty() && drawPicture.opacity == 1.0f &&
+            compositionState.getAbsoluteOpacity() == 1.0f &&
+            compositionState.getAbsoluteMatrix().getSkValue().rectStaysRect()) {
+            uniformRect = compositionState.getAbsoluteClippedRect(drawPicture.opaqueRect);
+        }
+
+        addDamageIfNeeded(fromSkValue<Rect>(drawPicture.picture->cullRect()), uniformRect);
     }
 
     void visit(const Operations::DrawExternalSurface& drawExternalSurface) {
@@ -49,6 +60,10 @@ struct ComputeDamageVisitor {
         addDamageIfNeeded(Rect::makeXYWH(0, 0, size.width, size.height));
     }
 
+    void visit(const Operations::DrawAtlasSprite& drawAtlasSprite) {
+        addDamageIfNeeded(drawAtlasSprite.rect);
+    }
+
     void visit(const Operations::PrepareMask& prepareMask) {
         addDamageIfNeeded(prepareMask.mask->getBounds());
     }
@@ -72,7 +87,7 @@ private:
         return _contextStack[_contextStack.size() - 1];
     }
 
-    void addDamageIfNeeded(const Rect& bounds) {
+    void addDamageIfNeeded(const Rect& bounds, const Rect& uniformRect = Rect::makeEmpty()) {
         const auto& context = getCurrentContext();
         auto absoluteRect = context.compositionState.getAbsoluteClippedRect(bounds);
         _rasterDamageResolver.addNonTransparentLayerInRect(context.layerId,
@@ -80,34 +95,268 @@ private:
                                                            context.compositionState.getAbsoluteMatrix(),
                                                            context.compositionState.getAbsoluteClipPath(),
                                                            context.compositionState.getAbsoluteOpacity(),
+                                                           uniformRect,
                                                            context.hasUpdates);
     }
 };
 
+// Tolerance of the float computations on values which land on whole pixels
+constexpr Scalar kPixelEpsilon = 0.001f;
+
+static bool isWholePixel(Scalar value) {
+    return std::abs(value - std::round(value)) < kPixelEpsilon;
+}
+
+static Scalar getRectArea(const Rect& rect) {
+    return rect.width() * rect.height();
+}
+
+static Scalar getRectsArea(const std::vector<Rect>& rects) {
+    Scalar area = 0;
+    for (const auto& rect : rects) {
+        area += getRectArea(rect);
+    }
+    return area;
+}
+
+static bool rectContainsRect(const Rect& rect, const Rect& otherRect) {
+    return !rect.isEmpty() && rect.left <= otherRect.left && rect.top <= otherRect.top &&
+           rect.right >= otherRect.right && rect.bottom >= otherRect.bottom;
+}
+
+static bool areSameContentShifts(const RasterContentShift& left, const RasterContentShift& right) {
+    return left.dx == right.dx && left.dy == right.dy && left.region == right.region;
+}
+
+/**
+Resolve the translation in whole pixels that transforms the "from" matrix into the "to" matrix.
+Returns false if the matrices differ by anything else than such a translation.
+ */
+static bool resolvePixelTranslation(const Matrix& from, const Matrix& to, int& dx, int& dy) {
+    if (from.getSkValue().hasPerspective() || to.getSkValue().hasPerspective() ||
+        from.getScaleX() != to.getScaleX() || from.getScaleY() != to.getScaleY() ||
+        from.getSkewX() != to.getSkewX() || from.getSkewY() != to.getSkewY()) {
+        return false;
+    }
+
+    auto translateX = to.getTranslateX() - from.getTranslateX();
+    auto translateY = to.getTranslateY() - from.getTranslateY();
+    if (!isWholePixel(translateX) || !isWholePixel(translateY)) {
+        return false;
+    }
+
+    dx = static_cast<int>(std::round(translateX));
+    dy = static_cast<int>(std::round(translateY));
+    return true;
+}
+
+bool RasterDamageResolver::LayerContent::hasChangedSince(const LayerContent& previous) const {
+    return hasUpdates || absoluteMatrix != previous.absoluteMatrix || clipPath != previous.clipPath ||
+           absoluteRect != previous.absoluteRect || absoluteOpacity != previous.absoluteOpacity;
+}
+
 RasterDamageResolver::RasterDamageResolver() = default;
 RasterDamageResolver::~RasterDamageResolver() = default;
 
 void RasterDamageResolver::beginUpdates(Scalar surfaceWidth, Scalar surfaceHeight) {
-    auto changed = _width != surfaceWidth || _height != surfaceHeight;
+    _sizeChanged = _width != surfaceWidth || _height != surfaceHeight;
     _width = surfaceWidth;
     _height = surfaceHeight;
 
-    if (changed) {
+    if (_sizeChanged) {
         addDamageInRect(Rect::makeXYWH(0, 0, surfaceWidth, surfaceHeight));
     }
 }
 
 std::vector<Rect> RasterDamageResolver::endUpdates() {
+    _contentShift = std::nullopt;
+    if (_contentShiftEnabled && !_sizeChanged) {
+        _contentShift = resolveContentShift();
+    }
+
+    std::vector<Rect> shiftedDamageRects;
+    if (_contentShift) {
+        // Resolved first, since resolveDamage() consumes the hasUpdates flags
+        shiftedDamageRects = _damageRects;
+        resolveDamageWithContentShift(_contentShift.value(), shiftedDamageRects);
+        shiftedDamageRects = mergeDamageRects(std::move(shiftedDamageRects));
+    }
+
     resolveDamage();
 
     std::swap(_previousLayerContents, _layerContents);
     _layerContents.clear();
-    auto damageRects = std::move(_damageRects);
+    auto damageRects = mergeDamageRects(std::move(_damageRects));
     _damageRects = std::vector<Rect>();
 
+    if (_contentShift) {
+        if (getRectsArea(shiftedDamageRects) < getRectsArea(damageRects)) {
+            return shiftedDamageRects;
+        }
+        _contentShift = std::nullopt;
+    }
+
     return damageRects;
 }
 
+void RasterDamageResolver::setContentShiftEnabled(bool contentShiftEnabled) {
+    _contentShiftEnabled = contentShiftEnabled;
+}
+
+const std::optional<RasterContentShift>& RasterDamageResolver::getContentShift() const {
+    return _contentShift;
+}
+
+std::optional<RasterContentShift> RasterDamageResolver::getLayerContentShift(const LayerContent& previous,
+                                                                            const LayerContent& current) const {
+    // Only unchanged content clipped by a rect that did not move can be shifted as a block,
+    // which is what the descendants of a ScrollLayer look like while it scrolls
+    if (current.hasUpdates || current.absoluteOpacity != previous.absoluteOpacity ||
+        current.clipPath != previous.clipPath || !current.clipPath.getSkValue().isRect(nullptr)) {
+        return std::nullopt;
+    }
+
+    RasterContentShift contentShift;
+    if (!resolvePixelTranslation(previous.absoluteMatrix, current.absoluteMatrix, contentShift.dx, contentShift.dy) ||
+        (contentShift.dx == 0 && contentShift.dy == 0)) {
+        return std::nullopt;
+    }
+
+    auto clipBounds = current.clipPath.getBounds();
+    if (!clipBounds) {
+        return std::nullopt;
+    }
+
+    auto region = clipBounds.value().intersection(Rect::makeXYWH(0, 0, _width, _height));
+    if (!isWholePixel(region.left) || !isWholePixel(region.top) || !isWholePixel(region.right) ||
+        !isWholePixel(region.bottom)) {
+        return std::nullopt;
+    }
+
+    contentShift.region = Rect::makeLTRB(
+        std::round(region.left), std::round(region.top), std::round(region.right), std::round(region.bottom));
+    if (std::abs(contentShift.dx) >= contentShift.region.width() ||
+        std::abs(contentShift.dy) >= contentShift.region.height()) {
+        return std::nullopt;
+    }
+
+    return contentShift;
+}
+
+std::optional<RasterContentShift> RasterDamageResolver::resolveContentShift() const {
+    struct Candidate {
+        RasterContentShift contentShift;
+        Scalar area = 0;
+    };
+
+    // Group the layers by the shift they moved with, the shift moving the most content wins
+    Valdi::SmallVector<Candidate, 4> candidates;
+    for (const auto& [layerId, layerContent] : _layerContents) {
+        const auto& it = _previousLayerContents.find(layerId);
+        if (it == _previousLayerContents.end()) {
+            continue;
+        }
+
+        auto contentShift = getLayerContentShift(it->second, layerContent);
+        if (!contentShift) {
+            continue;
+        }
+
+        Candidate* candidate = nullptr;
+        for (auto& existingCandidate : candidates) {
+            if (areSameContentShifts(existingCandidate.contentShift, contentShift.value())) {
+                candidate = &existingCandidate;
+                break;
+            }
+        }
+        if (candidate == nullptr) {
+            candidate = &candidates.emplace_back();
+            candidate->contentShift = contentShift.value();
+        }
+
+        candidate->area += getRectArea(layerContent.absoluteRect);
+    }
+
+    std::optional<RasterContentShift> bestContentShift;
+    Scalar bestArea = 0;
+    for (const auto& candidate : candidates) {
+        if (candidate.area > bestArea) {
+            bestArea = candidate.area;
+            bestContentShift = {candidate.contentShift};
+        }
+    }
+
+    return bestContentShift;
+}
+
+void RasterDamageResolver::resolveDamageWithContentShift(const RasterContentShift& contentShift,
+                                                         std::vector<Rect>& damageRects) const {
+    const auto& region = contentShift.region;
+    auto dx = static_cast<Scalar>(contentShift.dx);
+    auto dy = static_cast<Scalar>(contentShift.dy);
+
+    auto addDamage = [&](const Rect& rect) {
+        if (!rect.isEmpty()) {
+            damageRects.emplace_back(rect);
+        }
+    };
+    // Where the pixels that were in the given rect in the last frame end up after the shift
+    auto addShiftedDamage = [&](const Rect& rect) {
+        addDamage(rect.intersection(region).makeOffset(dx, dy).intersection(region));
+    };
+
+    for (const auto& [layerId, layerContent] : _previousLayerContents) {
+        const auto& it = _layerContents.find(layerId);
+        if (it == _layerContents.end()) {
+            addDamage(layerContent.absoluteRect);
+            addShiftedDamage(layerContent.absoluteRect);
+            continue;
+        }
+
+        const auto& newLayerContent = it->second;
+        auto layerContentShift = getLayerContentShift(layerContent, newLayerContent);
+        if (layerContentShift && areSameContentShifts(layerContentShift.value(), contentShift)) {
+            // The layer moved along with the shifted pixels
+            continue;
+        }
+
+        if (newLayerContent.hasChangedSince(layerContent)) {
+            addDamage(layerContent.absoluteRect);
+            addShiftedDamage(layerContent.absoluteRect);
+            addDamage(newLayerContent.absoluteRect);
+            continue;
+        }
+
+        // The layer did not move, but the pixels of the region were shifted over it. This is
+        // invisible for a layer drawing a single color over the whole region, like the background
+        // of a ScrollLayer.
+        if (layerContent.absoluteRect.intersects(region) &&
+            (!rectContainsRect(layerContent.uniformRect, region) ||
+             !rectContainsRect(newLayerContent.uniformRect, region))) {
+            addDamage(layerContent.absoluteRect.intersection(region));
+            addShiftedDamage(layerContent.absoluteRect);
+        }
+    }
+
+    for (const auto& [layerId, layerContent] : _layerContents) {
+        if (layerContent.hasUpdates && _previousLayerContents.find(layerId) == _previousLayerContents.end()) {
+            addDamage(layerContent.absoluteRect);
+        }
+    }
+
+    // The area of the region that no pixels were shifted into
+    if (contentShift.dy > 0) {
+        addDamage(Rect::makeLTRB(region.left, region.top, region.right, region.top + dy));
+    } else if (contentShift.dy < 0) {
+        addDamage(Rect::makeLTRB(region.left, region.bottom + dy, region.right, region.bottom));
+    }
+    if (contentShift.dx > 0) {
+        addDamage(Rect::makeLTRB(region.left, region.top, region.left + dx, region.bottom));
+    } else if (contentShift.dx < 0) {
+        addDamage(Rect::makeLTRB(region.right + dx, region.top, region.right, region.bottom));
+    }
+}
+
 void RasterDamageResolver::resolveDamage() {
     // Iterate over all previous layer contents, and add damage if the layer was removed, or has updates of any kind.
     for (const auto& [layerId, layerContent] : _previousLayerContents) {
@@ -120,10 +369,7 @@ void RasterDamageResolver::resolveDamage() {
 
         auto& newLayerContent = it->second;
 
-        if (newLayerContent.hasUpdates || newLayerContent.absoluteMatrix != layerContent.absoluteMatrix ||
-            newLayerContent.clipPath != layerContent.clipPath ||
-            newLayerContent.absoluteRect != layerContent.absoluteRect ||
-            newLayerContent.absoluteOpacity != layerContent.absoluteOpacity) {
+        if (newLayerContent.hasChangedSince(layerContent)) {
             newLayerContent.hasUpdates = false;
 
             addDamageInRect(layerContent.absoluteRect);
@@ -150,26 +396,89 @@ void RasterDamageResolver::addDamageFromDisplayListUpdates(const DisplayList& di
 }
 
 void RasterDamageResolver::addDamageInRect(const Rect& rect) {
-    auto damageToAdd = rect;
+    if (!rect.isEmpty()) {
+        _damageRects.emplace_back(rect);
+    }
+}
+
+static bool shouldMergeDamageRects(const Rect& left, const Rect& right) {
+    if (left.intersects(right)) {
+        return true;
+    }
+
+    // The rects are disjoint, merge them if the pixels that their bounds would redraw
+    // needlessly cost less than rasterizing the additional damage rect
+    auto bounds = left;
+    bounds.join(right);
+    auto overdraw = getRectArea(bounds) - getRectArea(left) - getRectArea(right);
+
+    return overdraw <= RasterDamageResolver::kDamageRectCostInPixels;
+}
 
+std::vector<Rect> RasterDamageResolver::mergeDamageRects(std::vector<Rect> damageRects) {
     /**
-    TODO(simon): This is a simple and inefficient implementation which removes the
-    intersected damage rects and adds a new damage rect that is the union of all
-    the intersected damage rects.
+    Sweep and prune: the rects are sorted by their left edge, so that each rect is
+    only compared with the rects that start before it ends horizontally, plus a distance
+    past which merging cannot be cheaper. Two rects at a horizontal distance d of each
+    other have bounds that redraw at least d * max(height) needless pixels.
+    Merging grows rects, which can make them mergeable with rects they were previously
+    compared against, so we sweep again until a pass does not merge anything.
      */
-    auto it = _damageRects.begin();
-    while (it != _damageRects.end()) {
-        if (it->intersects(damageToAdd)) {
-            damageToAdd.join(*it);
-            _damageRects.erase(it);
-            it = _damageRects.begin();
-            break;
-        } else {
-            it++;
+    auto merged = true;
+    std::vector<size_t> sortedIndexes;
+    std::vector<bool> absorbed;
+
+    while (merged && damageRects.size() > 1) {
+        merged = false;
+
+        // Sorting indexes allows to return the rects in the order they were added
+        sortedIndexes.resize(damageRects.size());
+        for (size_t i = 0; i < sortedIndexes.size(); i++) {
+            sortedIndexes[i] = i;
+        }
+        std::sort(sortedIndexes.begin(), sortedIndexes.end(), [&](size_t left, size_t right) {
+            return damageRects[left].left < damageRects[right].left;
+        });
+
+        absorbed.assign(damageRects.size(), false);
+
+        for (size_t i = 0; i < sortedIndexes.size(); i++) {
+            if (absorbed[sortedIndexes[i]]) {
+                continue;
+            }
+
+            auto& damageRect = damageRects[sortedIndexes[i]];
+
+            for (size_t j = i + 1; j < sortedIndexes.size(); j++) {
+                auto otherIndex = sortedIndexes[j];
+                const auto& otherDamageRect = damageRects[otherIndex];
+                auto maxMergeDistance = kDamageRectCostInPixels / std::max(damageRect.height(), 1.0f);
+                if (otherDamageRect.left - damageRect.right > maxMergeDistance) {
+                    break;
+                }
+
+                if (absorbed[otherIndex] || !shouldMergeDamageRects(damageRect, otherDamageRect)) {
+                    continue;
+                }
+
+                damageRect.join(otherDamageRect);
+                absorbed[otherIndex] = true;
+                merged = true;
+            }
+        }
+
+        if (merged) {
+            size_t outputIndex = 0;
+            for (size_t i = 0; i < damageRects.size(); i++) {
+                if (!absorbed[i]) {
+                    damageRects[outputIndex++] = damageRects[i];
+                }
+            }
+            damageRects.resize(outputIndex);
         }
     }
 
-    _damageRects.emplace_back(damageToAdd);
+    return damageRects;
 }
 
 void RasterDamageResolver::addNonTransparentLayerInRect(uint64_t layerId,
@@ -177,12 +486,16 @@ void RasterDamageResolver::addNonTransparentLayerInRect(uint64_t layerId,
                                                         const Matrix& absoluteMatrix,
                                                         const Path& clipPath,
                                                         Scalar absoluteOpacity,
+                                                        const Rect& uniformRect,
                                                         bool hasUpdates) {
+    auto isFirstContent = _layerContents.find(layerId) == _layerContents.end();
     auto& layerContent = _layerContents[layerId];
     layerContent.absoluteRect = rect;
     layerContent.absoluteMatrix = absoluteMatrix;
     layerContent.clipPath = clipPath;
     layerContent.absoluteOpacity = absoluteOpacity;
+    // Only the last content of a layer is kept, which is only known to be uniform if it is the only one
+    layerContent.uniformRect = isFirstContent ? uniformRect : Rect::makeEmpty();
     layerContent.hasUpdates = hasUpdates;
 }
 
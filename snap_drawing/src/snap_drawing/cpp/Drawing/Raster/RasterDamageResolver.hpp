@@ -5,6 +5,7 @@
 #include "snap_drawing/cpp/Utils/Path.hpp"
 #include "snap_drawing/cpp/Utils/Scalar.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include <optional>
 #include <vector>
 
 namespace snap::drawing {
@@ -12,6 +13,18 @@ namespace snap::drawing {
 class DisplayList;
 struct ComputeDamageVisitor;
 
+/**
+A translation by a whole number of pixels of the content rasterized in the last frame
+inside a region of the surface, resulting from a scroll. Once applied on the last
+rasterized bitmap, only the damage rects need to be rasterized.
+ */
+struct RasterContentShift {
+    // Region of the surface in which the content moved, in pixels
+    Rect region;
+    int dx = 0;
+    int dy = 0;
+};
+
 /**
 RasterDamageResolver helps with resolving dirty rects from a display list. It is used to
 implement delta rasterization, so that only the areas that have changed since the last
@@ -19,6 +32,13 @@ drawn frame are rasterized.
  */
 class RasterDamageResolver {
 public:
+    /**
+    Estimated cost of rasterizing one more damage rect, expressed in pixels. Each damage rect
+    replays the display list clipped to it, so two disjoint rects are merged into their bounds
+    when the bounds redraw fewer needless pixels than that.
+     */
+    static constexpr Scalar kDamageRectCostInPixels = 1024;
+
     RasterDamageResolver();
     ~RasterDamageResolver();
 
@@ -29,6 +49,25 @@ public:
 
     void addDamageInRect(const Rect& rect);
 
+    /**
+    Set whether the resolver can resolve the damage of a frame against the content of the
+    last frame shifted by a scroll. When a shift is resolved by endUpdates(), the caller must
+    apply it on its last rasterized bitmap before rasterizing the damage rects.
+     */
+    void setContentShiftEnabled(bool contentShiftEnabled);
+
+    /**
+    Returns the shift to apply on the last rasterized content for the damage rects
+    returned by the last endUpdates() call to be valid.
+     */
+    const std::optional<RasterContentShift>& getContentShift() const;
+
+    /**
+    Merge the intersecting rects together, and the disjoint rects that are cheaper to
+    rasterize as one rect. The returned rects do not intersect each other.
+     */
+    static std::vector<Rect> mergeDamageRects(std::vector<Rect> damageRects);
+
 private:
     friend ComputeDamageVisitor;
     struct LayerContent {
@@ -36,22 +75,35 @@ private:
         Matrix absoluteMatrix;
         Scalar absoluteOpacity;
         Path clipPath;
+        // Area within which the layer is drawn with a single opaque color, empty if unknown
+        Rect uniformRect;
         bool hasUpdates;
+
+        bool hasChangedSince(const LayerContent& previous) const;
     };
 
     Scalar _width = 0;
     Scalar _height = 0;
+    bool _sizeChanged = false;
+    bool _contentShiftEnabled = false;
+    std::optional<RasterContentShift> _contentShift;
     std::vector<Rect> _damageRects;
     Valdi::FlatMap<uint64_t, LayerContent> _previousLayerContents;
     Valdi::FlatMap<uint64_t, LayerContent> _layerContents;
 
     void resolveDamage();
 
+    std::optional<RasterContentShift> resolveContentShift() const;
+    std::optional<RasterContentShift> getLayerContentShift(const LayerContent& previous,
+                                                           const LayerContent& current) const;
+    void resolveDamageWithContentShift(const RasterContentShift& contentShift, std::vector<Rect>& damageRects) const;
+
     void addNonTransparentLayerInRect(uint64_t layerId,
                                       const Rect& rect,
                                       const Matrix& absoluteMatrix,
                                       const Path& clipPath,
                                       Scalar absoluteOpacity,
+                                      const Rect& uniformRect,
                                       bool hasUpdates);
 };
 
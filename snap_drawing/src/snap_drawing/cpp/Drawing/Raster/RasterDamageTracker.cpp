@@ -0,0 +1,56 @@
+#include "snap_drawing/cpp/Drawing/Raster/RasterDamageTracker.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "valdi_core/cpp/Utils/Trace.hpp"
+
+namespace snap::drawing {
+
+constexpr size_t kMaxPendingDamageRectsCount = 64;
+
+RasterDamageTracker::RasterDamageTracker() = default;
+RasterDamageTracker::~RasterDamageTracker() = default;
+
+void RasterDamageTracker::trackDamage(const DisplayList& displayList, bool surfaceSupportsPartialRedraw) {
+    if (!surfaceSupportsPartialRedraw || displayList.getPlanesCount() != 1) {
+        // The damage resolver will need to start over from a full frame once
+        // damage can be tracked again.
+        reset();
+        return;
+    }
+
+    if (_damageResolver == nullptr) {
+        _damageResolver = std::make_unique<RasterDamageResolver>();
+    }
+
+    VALDI_TRACE("SnapDrawing.computeDamageRects");
+    // Damage is computed in display list points, it is scaled to the surface when drawing
+    auto size = displayList.getSize();
+    _damageResolver->beginUpdates(size.width, size.height);
+    _damageResolver->addDamageFromDisplayListUpdates(displayList);
+    auto damageRects = _damageResolver->endUpdates();
+
+    if (_pendingDamageRects) {
+        auto& pendingDamageRects = _pendingDamageRects.value();
+        pendingDamageRects.insert(pendingDamageRects.end(), damageRects.begin(), damageRects.end());
+        if (pendingDamageRects.size() > kMaxPendingDamageRectsCount) {
+            // Display lists are being enqueued without being drawn, stop accumulating
+            invalidate();
+        }
+    }
+}
+
+void RasterDamageTracker::invalidate() {
+    _pendingDamageRects = std::nullopt;
+}
+
+void RasterDamageTracker::reset() {
+    _damageResolver = nullptr;
+    invalidate();
+}
+
+std::optional<std::vector<Rect>> RasterDamageTracker::takeDamageRects() {
+    auto damageRects = std::move(_pendingDamageRects);
+    _pendingDamageRects = std::vector<Rect>();
+    return damageRects;
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "snap_drawing/cpp/Drawing/Raster/RasterDamageResolver.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace snap::drawing {
+
+/**
+ RasterDamageTracker accumulates the damage of the display lists presented in a single
+ surface which supports partial redraw, from the moment they are enqueued until the surface
+ is drawn. It is not thread safe, callers serialize the calls.
+ */
+class RasterDamageTracker : public Valdi::SimpleRefCountable {
+public:
+    RasterDamageTracker();
+    ~RasterDamageTracker() override;
+
+    /**
+     Accumulate the damage of the given display list, compared to the previously tracked one.
+     When the surface does not support partial redraw, the tracker starts over and the next
+     draw redraws the whole surface.
+     */
+    void trackDamage(const DisplayList& displayList, bool surfaceSupportsPartialRedraw);
+
+    /**
+     Make the next draw redraw the whole surface.
+     */
+    void invalidate();
+
+    /**
+     Forget the previously tracked display list, the damage is resolved from a full frame
+     on the next tracked display list.
+     */
+    void reset();
+
+    /**
+     Returns the damage accumulated since the last call, or std::nullopt if the whole surface
+     should be redrawn.
+     */
+    std::optional<std::vector<Rect>> takeDamageRects();
+
+private:
+    std::unique_ptr<RasterDamageResolver> _damageResolver;
+    // Damage in display list points since the last draw, or std::nullopt if the next
+    // draw should redraw the whole surface.
+    std::optional<std::vector<Rect>> _pendingDamageRects;
+};
+
+} // namespace snap::drawing
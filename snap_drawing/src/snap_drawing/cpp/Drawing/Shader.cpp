@@ -6,6 +6,7 @@
 //
 
 #include "snap_drawing/cpp/Drawing/Shader.hpp"
+#include "include/core/SkPicture.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkTileMode.h"
 #include "snap_drawing/cpp/Utils/Image.hpp"
@@ -49,6 +50,20 @@ Shader Shader::makeBlend(BlendMode mode, Shader dst, Shader src) {
 Shader Shader::makeImage(const Ref<Image>& image, const Matrix* localMatrix, FilterQuality filterQuality) {
     auto samplingOptions = makeSmaplingOptions(filterQuality);
     const auto* skMatrix = localMatrix != nullptr ? &localMatrix->getSkValue() : nullptr;
+
+    const auto& picture = image->getPicture();
+    if (picture != nullptr) {
+        // Vector images are replayed at the scale they are drawn at, mapping the picture into
+        // the bounds of the image
+        auto cullRect = picture->cullRect();
+        auto pictureMatrix = SkMatrix::RectToRect(cullRect, SkRect::MakeIWH(image->width(), image->height()));
+        if (skMatrix != nullptr) {
+            pictureMatrix.postConcat(*skMatrix);
+        }
+        return Shader(picture->makeShader(
+            SkTileMode::kClamp, SkTileMode::kClamp, samplingOptions.filter, &pictureMatrix, &cullRect));
+    }
+
     return Shader(image->getSkValue()->makeShader(SkTileMode::kClamp, SkTileMode::kClamp, samplingOptions, skMatrix));
 }
 
@@ -7,4 +7,15 @@
 
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurface.hpp"
 
-namespace snap::drawing {} // namespace snap::drawing
+namespace snap::drawing {
+
+bool DrawableSurface::supportsPartialRedraw() const {
+    return false;
+}
+
+std::vector<Rect> DrawableSurface::resolveRedrawRects(const DrawableSurfaceCanvas& canvas,
+                                                      const std::vector<Rect>& /*damageRects*/) {
+    return {Rect::makeXYWH(0, 0, static_cast<Scalar>(canvas.getWidth()), static_cast<Scalar>(canvas.getHeight()))};
+}
+
+} // namespace snap::drawing
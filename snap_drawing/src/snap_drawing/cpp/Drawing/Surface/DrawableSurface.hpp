@@ -11,9 +11,12 @@
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurfaceCanvas.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/Surface.hpp"
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
 
 #include "valdi_core/cpp/Utils/Result.hpp"
 
+#include <vector>
+
 namespace snap::drawing {
 
 class DrawableSurface : public Surface {
@@ -22,6 +25,22 @@ public:
 
     virtual Valdi::Result<DrawableSurfaceCanvas> prepareCanvas() = 0;
     virtual void flush() = 0;
+
+    /**
+     Whether the surface retains the content of its previous frames, so that it can be
+     updated by redrawing only the regions that changed. Returns false by default.
+     */
+    virtual bool supportsPartialRedraw() const;
+
+    /**
+     Returns the regions of the canvas returned by the last prepareCanvas() call that must be
+     drawn before the next flush(), given the regions in pixels that changed since the last frame
+     presented by this surface. Surfaces that support partial redraw can return a subset of the
+     canvas, and forward the damage to the compositor when flushing. The default implementation
+     returns the whole canvas.
+     */
+    virtual std::vector<Rect> resolveRedrawRects(const DrawableSurfaceCanvas& canvas,
+                                                 const std::vector<Rect>& damageRects);
 };
 
 } // namespace snap::drawing
@@ -0,0 +1,99 @@
+#include "snap_drawing/cpp/Drawing/Surface/SurfaceDamageHistory.hpp"
+#include <cmath>
+
+namespace snap::drawing {
+
+// Past this count, redrawing the bounds of the rects is usually cheaper than
+// replaying the display list clipped to a complex region.
+constexpr size_t kMaxRedrawRectsCount = 8;
+
+SurfaceDamageHistory::SurfaceDamageHistory(size_t maxBufferAge) : _maxBufferAge(maxBufferAge) {}
+
+SurfaceDamageHistory::~SurfaceDamageHistory() = default;
+
+std::vector<Rect> SurfaceDamageHistory::resolveRedrawRects(const std::vector<Rect>& damageRects,
+                                                           int width,
+                                                           int height,
+                                                           size_t bufferAge) const {
+    auto fullRect = Rect::makeXYWH(0, 0, static_cast<Scalar>(width), static_cast<Scalar>(height));
+
+    // The frames presented since the buffer was last drawn, excluding the frame being drawn
+    auto missedFramesCount = bufferAge > 0 ? bufferAge - 1 : 0;
+    if (bufferAge == 0 || bufferAge > _maxBufferAge || missedFramesCount > _presentedFrames.size() ||
+        width != _width || height != _height) {
+        return {fullRect};
+    }
+
+    auto rects = damageRects;
+    for (size_t i = 0; i < missedFramesCount; i++) {
+        const auto& frameDamageRects = _presentedFrames[i];
+        rects.insert(rects.end(), frameDamageRects.begin(), frameDamageRects.end());
+    }
+
+    return normalizeRects(rects, width, height, kMaxRedrawRectsCount);
+}
+
+void SurfaceDamageHistory::onFramePresented(const std::vector<Rect>& damageRects, int width, int height) {
+    if (width != _width || height != _height) {
+        _presentedFrames.clear();
+        _width = width;
+        _height = height;
+    }
+
+    _presentedFrames.emplace_front(normalizeRects(damageRects, width, height, kMaxRedrawRectsCount));
+    while (_presentedFrames.size() > _maxBufferAge) {
+        _presentedFrames.pop_back();
+    }
+}
+
+void SurfaceDamageHistory::clear() {
+    _presentedFrames.clear();
+    _width = 0;
+    _height = 0;
+}
+
+std::vector<Rect> SurfaceDamageHistory::normalizeRects(const std::vector<Rect>& rects,
+                                                       int width,
+                                                       int height,
+                                                       size_t maxRectsCount) {
+    auto bounds = Rect::makeXYWH(0, 0, static_cast<Scalar>(width), static_cast<Scalar>(height));
+    std::vector<Rect> output;
+
+    for (const auto& rect : rects) {
+        auto rectToAdd = Rect::makeLTRB(std::floor(rect.left),
+                                        std::floor(rect.top),
+                                        std::ceil(rect.right),
+                                        std::ceil(rect.bottom))
+                             .intersection(bounds);
+        if (rectToAdd.isEmpty()) {
+            continue;
+        }
+
+        // Merging two rects can make the result intersect with rects that were checked before,
+        // so we scan again from the start until no rect intersects.
+        auto it = output.begin();
+        while (it != output.end()) {
+            if (it->intersects(rectToAdd)) {
+                rectToAdd.join(*it);
+                output.erase(it);
+                it = output.begin();
+            } else {
+                it++;
+            }
+        }
+
+        output.emplace_back(rectToAdd);
+    }
+
+    if (output.size() > maxRectsCount) {
+        auto rectsBounds = Rect::makeEmpty();
+        for (const auto& rect : output) {
+            rectsBounds.join(rect);
+        }
+        output = {rectsBounds};
+    }
+
+    return output;
+}
+
+} // namespace snap::drawing
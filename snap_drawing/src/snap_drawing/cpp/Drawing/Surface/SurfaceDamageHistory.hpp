@@ -0,0 +1,54 @@
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+#include <deque>
+#include <vector>
+
+namespace snap::drawing {
+
+/**
+SurfaceDamageHistory keeps the damage rects of the last frames presented by a surface,
+so that a surface whose buffers retain their content can redraw only the regions that changed
+since the buffer it is about to draw into was last presented. The buffer age follows the
+EGL_EXT_buffer_age semantics: 0 means the buffer content is undefined, 1 means the buffer holds
+the previous frame, 2 the frame before it, and so on.
+ */
+class SurfaceDamageHistory {
+public:
+    explicit SurfaceDamageHistory(size_t maxBufferAge);
+    ~SurfaceDamageHistory();
+
+    /**
+    Returns the rects, in pixels, which must be redrawn into a buffer of the given age for it to
+    display a frame that changed in the given damage rects since the previously presented frame.
+    Returns a single rect covering the surface when the buffer content cannot be reused.
+     */
+    std::vector<Rect> resolveRedrawRects(const std::vector<Rect>& damageRects,
+                                         int width,
+                                         int height,
+                                         size_t bufferAge) const;
+
+    /**
+    Record the damage rects of a frame that was presented by the surface.
+     */
+    void onFramePresented(const std::vector<Rect>& damageRects, int width, int height);
+
+    void clear();
+
+    /**
+    Round out the given rects to pixels, clip them to the surface, and merge the intersecting ones.
+    The rects are merged into their bounds if there are more than maxRectsCount of them.
+     */
+    static std::vector<Rect> normalizeRects(const std::vector<Rect>& rects,
+                                            int width,
+                                            int height,
+                                            size_t maxRectsCount);
+
+private:
+    size_t _maxBufferAge;
+    int _width = 0;
+    int _height = 0;
+    std::deque<std::vector<Rect>> _presentedFrames;
+};
+
+} // namespace snap::drawing
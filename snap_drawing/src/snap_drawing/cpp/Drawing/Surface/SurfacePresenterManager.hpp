@@ -32,6 +32,8 @@ public:
 
     /**
      Create a presenter wrapping an ExternalSurface for the given id, inserted at the given zIndex.
+     When the LayerRoot presents videos in their own compositor plane, the ExternalSurface can be
+     a VideoSurface, whose frames should be dequeued and handed to the OS compositor directly.
      */
     virtual void createPresenterForExternalSurface(SurfacePresenterId presenterId,
                                                    size_t zIndex,
@@ -0,0 +1,30 @@
+//
+//  VideoSurface.cpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "snap_drawing/cpp/Drawing/Surface/VideoSurface.hpp"
+#include "snap_drawing/cpp/Utils/ImageQueue.hpp"
+
+namespace snap::drawing {
+
+VideoSurface::VideoSurface(const Ref<ImageQueue>& imageQueue, FittingSizeMode fittingSizeMode)
+    : _imageQueue(imageQueue), _fittingSizeMode(fittingSizeMode) {}
+
+VideoSurface::~VideoSurface() = default;
+
+const Ref<ImageQueue>& VideoSurface::getImageQueue() const {
+    return _imageQueue;
+}
+
+FittingSizeMode VideoSurface::getFittingSizeMode() const {
+    return _fittingSizeMode;
+}
+
+void VideoSurface::setFittingSizeMode(FittingSizeMode fittingSizeMode) {
+    _fittingSizeMode = fittingSizeMode;
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,38 @@
+//
+//  VideoSurface.hpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Drawing/Surface/ExternalSurface.hpp"
+
+namespace snap::drawing {
+
+class ImageQueue;
+
+/**
+ A VideoSurface is an ExternalSurface which presents the frames of an ImageQueue.
+ It is used by the VideoLayer when the LayerRoot presents videos in their own compositor
+ plane: the SurfacePresenterManager then receives it in createPresenterForExternalSurface()
+ and is expected to dequeue the frames and hand them to the OS compositor directly,
+ z-ordered like any other presenter, without the frames being drawn into a DrawableSurface.
+ */
+class VideoSurface : public ExternalSurface {
+public:
+    VideoSurface(const Ref<ImageQueue>& imageQueue, FittingSizeMode fittingSizeMode);
+    ~VideoSurface() override;
+
+    const Ref<ImageQueue>& getImageQueue() const;
+
+    FittingSizeMode getFittingSizeMode() const;
+    void setFittingSizeMode(FittingSizeMode fittingSizeMode);
+
+private:
+    Ref<ImageQueue> _imageQueue;
+    FittingSizeMode _fittingSizeMode;
+};
+
+} // namespace snap::drawing
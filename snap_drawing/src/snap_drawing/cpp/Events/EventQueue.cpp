@@ -6,7 +6,6 @@
 //
 
 #include "snap_drawing/cpp/Events/EventQueue.hpp"
-#include <algorithm>
 
 #include "utils/debugging/Assert.hpp"
 
@@ -15,11 +14,15 @@ namespace snap::drawing {
 EventQueue::EventQueue(TimePoint initialTime) : _lastTime(initialTime) {}
 
 void EventQueue::flush(TimePoint currentTime) {
+    flush(currentTime, Duration());
+}
+
+void EventQueue::flush(TimePoint currentTime, Duration tolerance) {
     auto delta = currentTime - _lastTime;
     SC_ASSERT(delta.seconds() >= 0);
     _lastTime = currentTime;
 
-    collectNextEvents(currentTime);
+    collectNextEvents(currentTime + tolerance);
 
     for (const auto& event : _nextEvents) {
         if (event.callback) {
@@ -35,18 +38,9 @@ EventId EventQueue::enqueue(Duration delay, EventCallback&& callback) {
 }
 
 EventId EventQueue::enqueue(TimePoint time, EventCallback&& callback) {
-    auto sequence = ++_sequence;
-    Event event(EventId(), time, std::move(callback));
-
-    auto it =
-        std::upper_bound(_pendingEvents.begin(), _pendingEvents.end(), event, [=](const Event& a, const Event& b) {
-            return a.time < b.time;
-        });
-    auto index = it - _pendingEvents.begin();
-    auto enqueuedEvent = _pendingEvents.emplace(it, std::move(event));
-
-    auto eventId = EventId(static_cast<uint32_t>(index), sequence);
-    enqueuedEvent->id = eventId;
+    auto handle = _pendingEvents.insert(time, Event(EventId(), time, std::move(callback)));
+    auto eventId = EventId(handle.slot, handle.generation);
+    _pendingEvents.get(handle)->id = eventId;
 
     return eventId;
 }
@@ -56,17 +50,8 @@ bool EventQueue::cancel(EventId eventId) {
 }
 
 bool EventQueue::cancelFromPendingEvents(EventId eventId) {
-    auto index = static_cast<size_t>(eventId.index);
-    if (index >= _pendingEvents.size()) {
-        return false;
-    }
-
-    auto& event = _pendingEvents[index];
-    if (event.id != eventId) {
-        return false;
-    }
-
-    return event.cancel();
+    auto event = _pendingEvents.remove(Valdi::TimerHeapHandle(eventId.index, eventId.sequence));
+    return event && event->cancel();
 }
 
 bool EventQueue::cancelFromProcessingEvents(EventId eventId) {
@@ -79,10 +64,9 @@ bool EventQueue::cancelFromProcessingEvents(EventId eventId) {
     return false;
 }
 
-void EventQueue::collectNextEvents(TimePoint currentTime) {
-    while (!_pendingEvents.empty() && currentTime >= _pendingEvents.front().time) {
-        _nextEvents.emplace_back(std::move(_pendingEvents.front()));
-        _pendingEvents.pop_front();
+void EventQueue::collectNextEvents(TimePoint maxTime) {
+    while (!_pendingEvents.empty() && maxTime >= _pendingEvents.topTime()) {
+        _nextEvents.emplace_back(_pendingEvents.pop());
     }
 }
 
@@ -95,4 +79,11 @@ bool EventQueue::isEmpty() const {
     return _pendingEvents.empty();
 }
 
+std::optional<TimePoint> EventQueue::getNextEventTime() const {
+    if (_pendingEvents.empty()) {
+        return std::nullopt;
+    }
+    return {_pendingEvents.topTime()};
+}
+
 } // namespace snap::drawing
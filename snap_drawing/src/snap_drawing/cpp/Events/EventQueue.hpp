@@ -8,8 +8,9 @@
 #pragma once
 
 #include "snap_drawing/cpp/Events/Event.hpp"
+#include "valdi_core/cpp/Utils/TimerHeap.hpp"
 
-#include <deque>
+#include <optional>
 #include <vector>
 
 namespace snap::drawing {
@@ -20,6 +21,12 @@ public:
 
     void flush(TimePoint currentTime);
 
+    /**
+     Flush the events scheduled up to the given time plus the tolerance, so that events
+     scheduled slightly after the current time are processed with it instead of on their own.
+     */
+    void flush(TimePoint currentTime, Duration tolerance);
+
     EventId enqueue(Duration delay, EventCallback&& callback);
     EventId enqueue(TimePoint time, EventCallback&& callback);
     bool cancel(EventId eventId);
@@ -28,13 +35,17 @@ public:
 
     bool isEmpty() const;
 
+    /**
+     Returns the time of the earliest pending event, if any.
+     */
+    std::optional<TimePoint> getNextEventTime() const;
+
 private:
     std::vector<Event> _nextEvents;
-    std::deque<Event> _pendingEvents;
+    Valdi::TimerHeap<TimePoint, Event> _pendingEvents;
     TimePoint _lastTime;
-    uint32_t _sequence = 0;
 
-    void collectNextEvents(TimePoint currentTime);
+    void collectNextEvents(TimePoint maxTime);
 
     bool cancelFromPendingEvents(EventId eventId);
     bool cancelFromProcessingEvents(EventId eventId);
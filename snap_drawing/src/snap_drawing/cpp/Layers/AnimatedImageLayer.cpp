@@ -7,6 +7,7 @@
 
 #include "snap_drawing/cpp/Layers/AnimatedImageLayer.hpp"
 #include "snap_drawing/cpp/Utils/AnimatedImage.hpp"
+#include "snap_drawing/cpp/Utils/AnimatedImageScheduler.hpp"
 
 namespace snap::drawing {
 
@@ -55,7 +56,17 @@ void AnimatedImageLayer::onDraw(DrawingContext& drawingContext) {
         drawingContext.concat(Matrix::makeScaleTranslate(-1, 1, imageDrawBounds.width(), 0));
     }
 
-    _image->draw(drawingContext.canvas(), imageDrawBounds, _currentTime, _fittingSizeMode);
+    _image->draw(drawingContext.canvas(),
+                 imageDrawBounds,
+                 _currentTime,
+                 _fittingSizeMode,
+                 getResources()->getDisplayScale());
+
+    // Only layers attached to a root are drawn, which excludes the views that the
+    // viewport has detached: animations which are not visible don't prepare frames.
+    if (getRoot() != nullptr && _advanceRate != 0.0) {
+        AnimatedImageScheduler::getShared()->scheduleFramesAhead(_image, _currentTime);
+    }
 }
 
 void AnimatedImageLayer::onLoadedAssetChanged(const Ref<Valdi::LoadedAsset>& loadedAsset, bool shouldDrawFlipped) {
@@ -74,6 +85,7 @@ void AnimatedImageLayer::setImage(const Ref<AnimatedImage>& image) {
     if (_image != image) {
         auto hadImage = _image != nullptr;
         _image = image;
+        _displayedFrameIndex = -1;
 
         updateAnimationTimeWindow();
         updateActiveAnimation();
@@ -138,7 +150,9 @@ void AnimatedImageLayer::setCurrentTime(const Duration& currentTime, bool relati
     if (_currentTime != newTime) {
         _currentTime = newTime;
         shouldNotify = true;
-        setNeedsDisplay();
+        if (updateDisplayedFrameIndex()) {
+            setNeedsDisplay();
+        }
     }
     if (_listener != nullptr && shouldNotify) {
         _listener->onProgress(*this, _currentTime, getDuration());
@@ -225,6 +239,25 @@ void AnimatedImageLayer::updateAnimationTimeWindow() {
     }
 }
 
+bool AnimatedImageLayer::updateDisplayedFrameIndex() {
+    if (_image == nullptr) {
+        return true;
+    }
+
+    auto frameIndex = _image->getFrameIndex(_currentTime);
+    if (frameIndex < 0) {
+        return true;
+    }
+
+    // Under load, the scheduler asks animations to skip frames
+    frameIndex /= AnimatedImageScheduler::getShared()->getFrameRateDivisor();
+    if (frameIndex == _displayedFrameIndex) {
+        return false;
+    }
+    _displayedFrameIndex = frameIndex;
+    return true;
+}
+
 Duration AnimatedImageLayer::getDuration() const {
     return _image != nullptr ? _image->getDuration() : Duration();
 }
@@ -79,6 +79,7 @@ private:
     bool _shouldLoop = false;
     bool _shouldFlip = false;
     double _advanceRate = 0.0;
+    int _displayedFrameIndex = -1;
     FittingSizeMode _fittingSizeMode = FittingSizeModeCenterScaleFit;
 
     void updateActiveAnimation();
@@ -86,6 +87,7 @@ private:
 
     Duration getDuration() const;
     void updateAnimationTimeWindow();
+    bool updateDisplayedFrameIndex();
 };
 
 } // namespace snap::drawing
@@ -7,6 +7,7 @@
 
 #include "snap_drawing/cpp/Layers/ImageLayer.hpp"
 
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
 #include "snap_drawing/cpp/Drawing/Shader.hpp"
 #include "snap_drawing/cpp/Utils/Image.hpp"
 
@@ -20,9 +21,9 @@
 #include "include/core/SkColorFilter.h"
 #include "include/effects/SkImageFilters.h"
 
-namespace snap::drawing {
+#include <cmath>
 
-constexpr Scalar kUIKitToSkiaBlurRatio = 2.0f;
+namespace snap::drawing {
 
 ImageLayer::ImageLayer(const Ref<Resources>& resources) : Layer(resources), _tintColor(Color::transparent()) {
     _imagePaint.setAntiAlias(true);
@@ -30,13 +31,6 @@ ImageLayer::ImageLayer(const Ref<Resources>& resources) : Layer(resources), _tin
 
 ImageLayer::~ImageLayer() = default;
 
-// From https://github.com/servo/skia/blob/master/src/effects/SkBlurMask.cpp#L23
-static const SkScalar kBlurSigmaScale = 0.57735f;
-
-static Scalar radiusToSigma(Scalar radius) {
-    return radius > 0 ? kBlurSigmaScale * radius + 0.5f : 0.0f;
-}
-
 void ImageLayer::onDraw(DrawingContext& drawingContext) {
     Layer::onDraw(drawingContext);
 
@@ -46,8 +40,12 @@ void ImageLayer::onDraw(DrawingContext& drawingContext) {
 
     auto drawBounds = drawingContext.drawBounds();
 
-    auto imageWidth = static_cast<Scalar>(_image->width());
-    auto imageHeight = static_cast<Scalar>(_image->height());
+    // Images filtered ahead of time are drawn as is
+    auto image = _image->getFilteredImage() != nullptr ? _image->getFilteredImage() : _image;
+    const auto* filter = image == _image ? _image->getFilter().get() : nullptr;
+
+    auto imageWidth = static_cast<Scalar>(image->width());
+    auto imageHeight = static_cast<Scalar>(image->height());
 
     if (imageWidth == 0 || imageHeight == 0) {
         return;
@@ -70,6 +68,29 @@ void ImageLayer::onDraw(DrawingContext& drawingContext) {
         imageDrawBounds.bottom -= offsetY;
     }
 
+    if (image->isVector() && filter == nullptr) {
+        // Vector images are replayed at any scale, sizes which are drawn repeatedly use a raster instead.
+        // Filtered images keep the picture, as their blur radius is relative to the image size.
+        auto displayScale = _resources->getDisplayScale();
+        auto rasterizedImage =
+            image->getRasterizedIfHot(static_cast<int>(std::ceil(imageDrawBounds.width() * displayScale)),
+                                      static_cast<int>(std::ceil(imageDrawBounds.height() * displayScale)));
+        if (rasterizedImage != nullptr) {
+            image = rasterizedImage;
+            imageWidth = static_cast<Scalar>(image->width());
+            imageHeight = static_cast<Scalar>(image->height());
+            imageRect = Rect::makeLTRB(0, 0, imageWidth, imageHeight);
+        }
+    }
+
+    if (!image->isVector() && canDrawFromImageAtlas(drawBounds, imageDrawBounds)) {
+        auto sprite = _resources->getImageAtlas()->getOrInsert(image->getSkValue());
+        if (sprite != nullptr) {
+            drawingContext.drawAtlasSprite(sprite, imageDrawBounds);
+            return;
+        }
+    }
+
     auto drawRect = imageDrawBounds.intersection(drawBounds);
 
     auto drawWidth = imageDrawBounds.width();
@@ -95,21 +116,19 @@ void ImageLayer::onDraw(DrawingContext& drawingContext) {
 
     auto imagePaint = _imagePaint;
 
-    const auto& filter = _image->getFilter();
-
     if (filter != nullptr) {
         auto& skPaint = imagePaint.getSkValue();
-        if (!filter->isIdentityColorMatrix()) {
-            auto colorMatrixFilter = SkColorFilters::Matrix(filter->getColorMatrix());
+        const auto& colorMatrixFilter = _image->getFilterColorFilter();
+        if (colorMatrixFilter != nullptr) {
             if (skPaint.getColorFilter() == nullptr) {
-                skPaint.setColorFilter(std::move(colorMatrixFilter));
+                skPaint.setColorFilter(colorMatrixFilter);
             } else {
-                skPaint.setColorFilter(SkColorFilters::Compose(std::move(colorMatrixFilter), skPaint.refColorFilter()));
+                skPaint.setColorFilter(SkColorFilters::Compose(colorMatrixFilter, skPaint.refColorFilter()));
             }
         }
 
-        if (filter->getBlurRadius() != 0.0f) {
-            auto blurSigma = radiusToSigma(filter->getBlurRadius()) * kUIKitToSkiaBlurRatio;
+        auto blurSigma = _image->getFilterBlurSigma();
+        if (blurSigma != 0.0f) {
             auto xScaleRatio = drawRect.width() / imageWidth;
             auto yScaleRatio = drawRect.height() / imageHeight;
             skPaint.setImageFilter(
@@ -124,9 +143,9 @@ void ImageLayer::onDraw(DrawingContext& drawingContext) {
         } else {
             drawingContext.clipRect(drawBounds);
         }
-        drawingContext.drawImage(*_image, imageRect, imageDrawBounds, &imagePaint);
+        drawingContext.drawImage(*image, imageRect, imageDrawBounds, &imagePaint);
     } else {
-        imagePaint.setShader(Shader::makeImage(_image, &localMatrix, FilterQualityLow));
+        imagePaint.setShader(Shader::makeImage(image, &localMatrix, FilterQualityLow));
 
         if (!getBorderRadius().isEmpty()) {
             auto drawPath = getBorderRadius().getPath(drawBounds);
@@ -141,6 +160,15 @@ void ImageLayer::onDraw(DrawingContext& drawingContext) {
     }
 }
 
+bool ImageLayer::canDrawFromImageAtlas(const Rect& drawBounds, const Rect& imageDrawBounds) const {
+    // Sprites are drawn as is, without clipping nor effects. Transforms of the layer itself are
+    // handled when drawing the display list.
+    return _resources->getImageAtlas() != nullptr &&
+           (_image->getFilter() == nullptr || _image->getFilteredImage() != nullptr) &&
+           _imagePaint.getSkValue().getColorFilter() == nullptr && getBorderRadius().isEmpty() && !_shouldFlip &&
+           _contentRotation == 0.0f && drawBounds.getSkValue().contains(imageDrawBounds.getSkValue());
+}
+
 void ImageLayer::onLoadedAssetChanged(const Ref<Valdi::LoadedAsset>& loadedAsset, bool shouldDrawFlipped) {
     setImage(Valdi::castOrNull<Image>(loadedAsset));
     setShouldFlip(shouldDrawFlipped);
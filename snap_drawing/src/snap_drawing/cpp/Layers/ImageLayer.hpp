@@ -54,6 +54,7 @@ private:
     Scalar _contentRotation = 0;
 
     void handleAssetLoaded(const Ref<Valdi::Asset>& asset, const Valdi::Result<Ref<Image>>& result);
+    bool canDrawFromImageAtlas(const Rect& drawBounds, const Rect& imageDrawBounds) const;
 };
 
 } // namespace snap::drawing
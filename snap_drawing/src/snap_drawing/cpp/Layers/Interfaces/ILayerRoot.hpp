@@ -26,6 +26,19 @@ public:
     }
 
     virtual bool shouldRasterizeExternalSurface() const = 0;
+
+    /**
+     Whether video layers should present their frames in a dedicated compositor plane
+     through a VideoSurface, instead of drawing them into the layer tree.
+     */
+    virtual bool shouldPresentVideoInCompositorPlane() const = 0;
+
+    /**
+     Whether the frame being processed has not yet reached its deadline. Work which can be
+     split across frames should check it, and enqueue the rest of the work for the next frame
+     once it returns false.
+     */
+    virtual bool hasTimeRemainingInFrame() const = 0;
 };
 
 } // namespace snap::drawing
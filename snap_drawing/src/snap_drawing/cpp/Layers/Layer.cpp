@@ -18,9 +18,14 @@
 
 #include "snap_drawing/cpp/Drawing/BoxShadow.hpp"
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DrawDisplayListVisitor.hpp"
 #include "snap_drawing/cpp/Drawing/LinearGradient.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/LayerRasterCache.hpp"
+#include "snap_drawing/cpp/Utils/BoundingBoxHierarchy.hpp"
 #include "snap_drawing/cpp/Utils/GradientWrapper.hpp"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
 
 namespace snap::drawing {
@@ -32,6 +37,10 @@ Layer::Layer(const Ref<Resources>& resources)
       _translation(Size::makeEmpty()) {}
 
 Layer::~Layer() {
+    if (_hasRasterCache && _resources->getLayerRasterCache() != nullptr) {
+        _resources->getLayerRasterCache()->remove(_layerId);
+    }
+
     for (const auto& gestureRecognizer : _gestureRecognizers.readAccess()) {
         gestureRecognizer->setLayer(nullptr);
     }
@@ -58,23 +67,37 @@ void Layer::draw(DisplayList& displayList, DrawMetrics& metrics) {
 
     _isDrawing = true;
 
-    Scalar resolvedContextOpacity;
-    Scalar resolvedPictureOpacity;
-
-    if (_opacity == 1.0f || !hasOverlappingRendering()) {
-        resolvedContextOpacity = 1.0f;
-        resolvedPictureOpacity = _opacity;
-    } else {
-        resolvedContextOpacity = _opacity;
-        resolvedPictureOpacity = 1.0f;
-    }
+    auto resolvedPictureOpacity = resolvePictureOpacity(_opacity);
+    auto resolvedContextOpacity = resolvedPictureOpacity == _opacity ? 1.0f : _opacity;
 
     if (_layerId == kLayerIdNone && _root != nullptr) {
         _layerId = _root->allocateLayerId();
     }
 
+    if (drawFromRasterCache(displayList, metrics, width, height, resolvedContextOpacity, resolvedPictureOpacity)) {
+        _isDrawing = false;
+        return;
+    }
+
     displayList.pushContext(_matrix, resolvedContextOpacity, _layerId, _needsDisplay);
+    auto planeIndex = displayList.getCurrentPlaneIndex();
+    auto begin = displayList.getBytesUsed(planeIndex);
 
+    if (!drawFromPreviousDisplayList(displayList, metrics, resolvedPictureOpacity)) {
+        drawSubtree(displayList, metrics, width, height, resolvedPictureOpacity);
+    }
+
+    _recordedDisplayListId = displayList.getId();
+    _recordedPictureOpacity = resolvedPictureOpacity;
+    _recordedPlaneIndex = planeIndex;
+    _recordedOperationsBegin = begin;
+    _recordedOperationsEnd = displayList.getBytesUsed(planeIndex);
+    _isDrawing = false;
+    displayList.popContext();
+}
+
+void Layer::drawSubtree(
+    DisplayList& displayList, DrawMetrics& metrics, Scalar width, Scalar height, Scalar resolvedPictureOpacity) {
     if (_needsDisplay) {
         drawBackground(width, height);
         drawContent(width, height);
@@ -129,9 +152,102 @@ void Layer::draw(DisplayList& displayList, DrawMetrics& metrics) {
     }
 
     _childNeedsDisplay = false;
-    _isDrawing = false;
+}
+
+bool Layer::drawFromRasterCache(DisplayList& displayList,
+                                DrawMetrics& metrics,
+                                Scalar width,
+                                Scalar height,
+                                Scalar resolvedContextOpacity,
+                                Scalar resolvedPictureOpacity) {
+    const auto& rasterCache = _resources->getLayerRasterCache();
+    if (rasterCache == nullptr) {
+        return false;
+    }
+
+    if (_needsDisplay || _childNeedsDisplay || !canUseRasterCache()) {
+        _stableFramesCount = 0;
+        if (_hasRasterCache) {
+            _hasRasterCache = false;
+            rasterCache->remove(_layerId);
+        }
+        return false;
+    }
 
+    if (_stableFramesCount < rasterCache->getMinStableFrames()) {
+        _stableFramesCount++;
+        return false;
+    }
+
+    LayerContent content;
+    if (_hasRasterCache) {
+        content = rasterCache->find(_layerId);
+    } else {
+        content = rasterizeSubtree(*rasterCache, metrics, width, height, resolvedPictureOpacity);
+    }
+
+    _hasRasterCache = !content.isEmpty();
+    if (!_hasRasterCache) {
+        // Either evicted or not cacheable, wait for another stable period before trying again
+        _stableFramesCount = 0;
+        return false;
+    }
+
+    displayList.pushContext(_matrix, resolvedContextOpacity, _layerId, false);
+    displayList.appendLayerContent(content, 1.0f);
     displayList.popContext();
+
+    return true;
+}
+
+bool Layer::drawFromPreviousDisplayList(DisplayList& displayList,
+                                        DrawMetrics& metrics,
+                                        Scalar resolvedPictureOpacity) {
+    // The operations of the subtree are only relative to the layer, they can be copied as long as
+    // neither the layer nor its descendants changed since they were recorded. The matrix and the
+    // context opacity of the layer are pushed outside of them, so they can change in between.
+    const auto& previousDisplayList = displayList.getPreviousDisplayList();
+    if (_needsDisplay || _childNeedsDisplay || previousDisplayList == nullptr ||
+        previousDisplayList->getId() != _recordedDisplayListId || resolvedPictureOpacity != _recordedPictureOpacity) {
+        return false;
+    }
+
+    displayList.appendOperations(
+        *previousDisplayList, _recordedPlaneIndex, _recordedOperationsBegin, _recordedOperationsEnd);
+    metrics.reusedSubtrees++;
+
+    return true;
+}
+
+LayerContent Layer::rasterizeSubtree(LayerRasterCache& rasterCache,
+                                     DrawMetrics& metrics,
+                                     Scalar width,
+                                     Scalar height,
+                                     Scalar resolvedPictureOpacity) {
+    auto bounds = Rect::makeXYWH(0, 0, width, height);
+    auto subtreeDisplayList = Valdi::makeShared<DisplayList>(bounds.size(), TimePoint(0.0));
+    drawSubtree(*subtreeDisplayList, metrics, width, height, resolvedPictureOpacity);
+
+    if (subtreeDisplayList->hasExternalSurfaces()) {
+        // External surfaces are composited by the platform and cannot be part of an image
+        return LayerContent();
+    }
+
+    // Translations are snapped to the pixels of the image, as they would be on the final surface
+    auto rasterScale = _resources->getDisplayScale();
+    SkPictureRecorder recorder;
+    auto* canvas = recorder.beginRecording(bounds.getSkValue());
+    DrawDisplayListVisitor visitor(canvas, rasterScale, rasterScale);
+    subtreeDisplayList->visitOperations(0, visitor);
+    visitor.flush();
+
+    return rasterCache.insert(_layerId, recorder.finishRecordingAsPicture(), bounds, rasterScale);
+}
+
+bool Layer::canUseRasterCache() const {
+    // The image only covers the bounds of the layer, so the content of the subtree must be
+    // guaranteed to not overflow them.
+    return _layerId != kLayerIdNone && _clipsToBounds && _boxShadow == nullptr && !_children.readAccess()->empty();
 }
 
 void Layer::onDraw(DrawingContext& drawingContext) {}
@@ -148,11 +264,12 @@ void Layer::drawBackground(Scalar width, Scalar height) {
     DrawingContext drawingContext(width, height);
 
     if (_boxShadow != nullptr) {
-        _boxShadow->draw(drawingContext, _borderRadius);
+        _boxShadow->draw(
+            drawingContext, _borderRadius, _resources->getBoxShadowCache().get(), _resources->getDisplayScale());
     }
 
     if (_gradientWrapper.hasGradient()) {
-        _gradientWrapper.draw(drawingContext, _borderRadius);
+        _gradientWrapper.draw(drawingContext, _borderRadius, _resources->getGradientShaderCache().get());
     } else if (_backgroundColor != Color::transparent()) {
         Paint paint;
         paint.setColor(_backgroundColor);
@@ -162,6 +279,11 @@ void Layer::drawBackground(Scalar width, Scalar height) {
     }
 
     _cachedBackground = drawingContext.finish();
+
+    auto isOpaqueColor = !_gradientWrapper.hasGradient() && _backgroundColor.getAlpha() == 0xFF;
+    if (_cachedBackground.picture != nullptr && isOpaqueColor && _borderRadius.isEmpty()) {
+        _cachedBackground.opaqueRect = Rect::makeXYWH(0, 0, width, height);
+    }
 }
 
 void Layer::drawForeground(Scalar width, Scalar height) {
@@ -212,6 +334,7 @@ void Layer::insertChild(const Valdi::Ref<Layer>& childLayer, size_t index) {
 
     childLayer->onParentChanged(Valdi::strongSmallRef(this));
 
+    _childrenHitTestIndexDirty = true;
     setChildNeedsDisplay();
 
     onChildInserted(childLayer.get(), index);
@@ -242,6 +365,7 @@ void Layer::removeChild(Layer* childLayer, bool shouldNotify) {
     }
 
     if (erased) {
+        _childrenHitTestIndexDirty = true;
         if (shouldNotify) {
             onChildRemoved(childLayer);
         }
@@ -303,22 +427,116 @@ Ref<Layer> Layer::getLayerAtPoint(const Point& point) {
         return nullptr;
     }
 
-    // Dispatch touches to children, starting from the last child.
+    auto child = getChildAtPoint(point);
+    if (child != nullptr) {
+        return child->getLayerAtPoint(child->convertPointFromParent(point));
+    }
+
+    return Valdi::strongSmallRef(this);
+}
+
+Rect Layer::getHitTestBounds() const {
+    return Rect::makeLTRB(-_touchAreaExtensionLeft,
+                          -_touchAreaExtensionTop,
+                          _frame.width() + _touchAreaExtensionRight,
+                          _frame.height() + _touchAreaExtensionBottom);
+}
+
+bool Layer::canBeHitOutsideOfHitTestBounds() const {
+    return false;
+}
+
+// Below this number of children, testing every child is cheaper than looking up the hit test index
+constexpr size_t kMinChildrenForHitTestIndex = 16;
+// Hit test bounds are inclusive and may be empty, while the index only returns boxes
+// intersecting with a non empty query box
+constexpr Scalar kHitTestIndexOutset = 0.01f;
+
+Ref<Layer> Layer::getChildAtPoint(const Point& point) {
     auto children = _children.readAccess();
-    auto i = children->size();
-    while (i > 0) {
-        i--;
 
-        const auto& child = (*children)[i];
-        auto childPoint = child->convertPointFromParent(point);
+    if (children->size() < kMinChildrenForHitTestIndex) {
+        // Among siblings, the last child is on top
+        auto i = children->size();
+        while (i > 0) {
+            i--;
 
-        auto hitChild = child->getLayerAtPoint(childPoint);
-        if (hitChild != nullptr) {
-            return hitChild;
+            const auto& child = (*children)[i];
+            if (child->hitTest(child->convertPointFromParent(point))) {
+                return child;
+            }
         }
+
+        return nullptr;
     }
 
-    return Valdi::strongSmallRef(this);
+    updateChildrenHitTestIndexIfNeeded(*children);
+
+    _hitTestCandidates.clear();
+    _childrenHitTestIndex->search(Rect::makeLTRB(point.x - kHitTestIndexOutset,
+                                                 point.y - kHitTestIndexOutset,
+                                                 point.x + kHitTestIndexOutset,
+                                                 point.y + kHitTestIndexOutset),
+                                  _hitTestCandidates);
+    _hitTestCandidates.insert(
+        _hitTestCandidates.end(), _unindexedHitTestChildren.begin(), _unindexedHitTestChildren.end());
+    std::sort(_hitTestCandidates.begin(), _hitTestCandidates.end(), std::greater<>());
+
+    for (auto index : _hitTestCandidates) {
+        const auto& child = (*children)[static_cast<size_t>(index)];
+        if (child->hitTest(child->convertPointFromParent(point))) {
+            return child;
+        }
+    }
+
+    return nullptr;
+}
+
+void Layer::updateChildrenHitTestIndexIfNeeded(const std::vector<Valdi::Ref<Layer>>& children) {
+    if (!_childrenHitTestIndexDirty && _childrenHitTestIndex != nullptr) {
+        return;
+    }
+    _childrenHitTestIndexDirty = false;
+
+    if (_childrenHitTestIndex == nullptr) {
+        _childrenHitTestIndex = Valdi::makeShared<BoundingBoxHierarchy>();
+    } else {
+        _childrenHitTestIndex->clear();
+    }
+    _unindexedHitTestChildren.clear();
+
+    // The index refers to the children by their position in the index, which must match their
+    // position in children
+    for (size_t i = 0; i < children.size(); i++) {
+        const auto& child = children[i];
+        child->_isInParentHitTestIndex = true;
+
+        // A zero scale maps every point of the parent onto the same point of the child
+        if (child->canBeHitOutsideOfHitTestBounds() || child->_scaleX == 0 || child->_scaleY == 0) {
+            _unindexedHitTestChildren.emplace_back(static_cast<int>(i));
+            _childrenHitTestIndex->insert(Rect::makeEmpty());
+            continue;
+        }
+
+        auto bounds = child->convertRectToParent(child->getHitTestBounds());
+        // Negative scales flip the bounds
+        _childrenHitTestIndex->insert(Rect::makeLTRB(std::min(bounds.left, bounds.right) - kHitTestIndexOutset,
+                                                     std::min(bounds.top, bounds.bottom) - kHitTestIndexOutset,
+                                                     std::max(bounds.left, bounds.right) + kHitTestIndexOutset,
+                                                     std::max(bounds.top, bounds.bottom) + kHitTestIndexOutset));
+    }
+}
+
+void Layer::setHitTestBoundsChanged() {
+    if (!_isInParentHitTestIndex) {
+        return;
+    }
+    _isInParentHitTestIndex = false;
+
+    auto parent = Valdi::castOrNull<Layer>(_parent.lock());
+    if (parent != nullptr) {
+        parent->_childrenHitTestIndexDirty = true;
+    }
 }
 
 void Layer::updateMatrix(Scalar width, Scalar height) {
@@ -359,6 +577,7 @@ void Layer::setTouchAreaExtension(Scalar left, Scalar right, Scalar top, Scalar
     _touchAreaExtensionRight = right;
     _touchAreaExtensionTop = top;
     _touchAreaExtensionBottom = bottom;
+    setHitTestBoundsChanged();
 }
 
 void Layer::setBackgroundColor(Color backgroundColor) {
@@ -445,12 +664,22 @@ void Layer::setOpacity(Scalar opacity) {
             // We also should force notify our parent since our needsDisplay/childNeedsDisplay
             // flags might be out of sync, since we are not visited when not visible.
             notifyParentSetChildNeedsDisplay();
+        } else if (resolvePictureOpacity(_opacity) == _recordedPictureOpacity) {
+            // The opacity is only applied on the context of the layer
+            setNeedsRecomposite();
         } else {
             setChildNeedsDisplay();
         }
     }
 }
 
+Scalar Layer::resolvePictureOpacity(Scalar opacity) const {
+    if (opacity == 1.0f || !hasOverlappingRendering()) {
+        return opacity;
+    }
+    return 1.0f;
+}
+
 Scalar Layer::getOpacity() const {
     return _opacity;
 }
@@ -520,7 +749,7 @@ void Layer::setFrame(const Rect& frame) {
             setNeedsDisplay();
             onBoundsChanged();
         } else {
-            setChildNeedsDisplay();
+            setNeedsRecomposite();
         }
     }
 }
@@ -567,6 +796,17 @@ void Layer::requestFocus(ILayer* layer) {
     }
 }
 
+void Layer::setNeedsRecomposite() {
+    // The recorded operations of the layer stay valid, only the ancestors need to draw again
+    // to push the new matrix or opacity of the layer
+    if (_parent.lock() == nullptr) {
+        // The root layer is drawn again as long as it or its children need display
+        setChildNeedsDisplay();
+    } else {
+        notifyParentSetChildNeedsDisplay();
+    }
+}
+
 void Layer::notifyParentSetChildNeedsDisplay() {
     auto parent = _parent.lock();
     if (parent != nullptr) {
@@ -669,21 +909,44 @@ bool Layer::needsProcessAnimations() const {
 }
 
 void Layer::scheduleProcessAnimationsIfNeeded() {
+    scheduleProcessAnimationsIfNeeded(std::nullopt);
+}
+
+void Layer::scheduleProcessAnimationsIfNeeded(std::optional<TimePoint> lastProcessTime) {
     if (_enqueuedFrame || _animations.empty() || _root == nullptr) {
         return;
     }
 
+    // Animations which don't need the display rate are processed on their own frames, which lets
+    // the frame scheduler idle in between. New animations always start on the next frame.
+    auto delay = lastProcessTime ? getProcessAnimationsInterval() : Duration();
+
     auto weakSelf = Valdi::weakRef(this);
-    auto eventId = onNextFrame([weakSelf](auto /*timePoint*/, auto delta) {
+    auto eventId = onFrameAfter(delay, [weakSelf, lastProcessTime](auto timePoint, auto delta) {
         auto strongSelf = weakSelf.lock();
         if (strongSelf != nullptr) {
-            strongSelf->processAnimations(delta);
+            strongSelf->processAnimations(timePoint, lastProcessTime ? timePoint - lastProcessTime.value() : delta);
         }
     });
 
     _enqueuedFrame = {eventId};
 }
 
+Duration Layer::getProcessAnimationsInterval() const {
+    Scalar maxFrameRate = 0;
+
+    auto animations = _animations.readAccess();
+    for (const auto& it : animations) {
+        auto frameRate = it.second->getPreferredFrameRate();
+        if (frameRate <= 0) {
+            return Duration();
+        }
+        maxFrameRate = std::max(maxFrameRate, frameRate);
+    }
+
+    return maxFrameRate > 0 ? Duration(1.0 / static_cast<double>(maxFrameRate)) : Duration();
+}
+
 bool Layer::cancelProcessAnimations() {
     if (!_enqueuedFrame || _root == nullptr) {
         return false;
@@ -693,12 +956,12 @@ bool Layer::cancelProcessAnimations() {
     return _root->cancelEvent(eventId);
 }
 
-EventId Layer::onNextFrame(EventCallback&& eventCallback) {
+EventId Layer::onFrameAfter(Duration delay, EventCallback&& eventCallback) {
     if (_root == nullptr) {
         return EventId();
     }
 
-    return _root->enqueueEvent(std::move(eventCallback), Duration(0));
+    return _root->enqueueEvent(std::move(eventCallback), delay);
 }
 
 struct AnimationToProcess {
@@ -708,7 +971,7 @@ struct AnimationToProcess {
     inline AnimationToProcess(const String& key, const Ref<IAnimation>& animation) : key(key), animation(animation) {}
 };
 
-void Layer::processAnimations(Duration delta) {
+void Layer::processAnimations(TimePoint time, Duration delta) {
     _enqueuedFrame = std::nullopt;
 
     if (_animations.empty()) {
@@ -741,7 +1004,7 @@ void Layer::processAnimations(Duration delta) {
         }
     }
 
-    scheduleProcessAnimationsIfNeeded();
+    scheduleProcessAnimationsIfNeeded(time);
 }
 
 std::optional<Point> Layer::convertPointToLayer(Point point, const Valdi::Ref<Layer>& childLayer) const {
@@ -851,6 +1114,7 @@ Point Layer::convertPointToParent(const Point& point) {
 void Layer::setVisualFrameDirty() {
     _visualFrameDirty = true;
     _matrixDirty = true;
+    setHitTestBoundsChanged();
 }
 
 Rect Layer::getAbsoluteVisualFrame() {
@@ -891,7 +1155,7 @@ Scalar Layer::getTranslationX() const {
 void Layer::setTranslationX(Scalar translationX) {
     if (_translation.width != translationX) {
         _translation.width = translationX;
-        setChildNeedsDisplay();
+        setNeedsRecomposite();
         setVisualFrameDirty();
     }
 }
@@ -903,7 +1167,7 @@ Scalar Layer::getTranslationY() const {
 void Layer::setTranslationY(Scalar translationY) {
     if (_translation.height != translationY) {
         _translation.height = translationY;
-        setChildNeedsDisplay();
+        setNeedsRecomposite();
         setVisualFrameDirty();
     }
 }
@@ -916,7 +1180,7 @@ void Layer::setScaleX(Scalar scaleX) {
     if (_scaleX != scaleX) {
         _scaleX = scaleX;
         _hasScale = (_scaleX != 1) || (_scaleY != 1);
-        setChildNeedsDisplay();
+        setNeedsRecomposite();
         setVisualFrameDirty();
     }
 }
@@ -929,7 +1193,7 @@ void Layer::setScaleY(Scalar scaleY) {
     if (_scaleY != scaleY) {
         _scaleY = scaleY;
         _hasScale = (_scaleX != 1) || (_scaleY != 1);
-        setChildNeedsDisplay();
+        setNeedsRecomposite();
         setVisualFrameDirty();
     }
 }
@@ -941,7 +1205,7 @@ Scalar Layer::getRotation() const {
 void Layer::setRotation(Scalar rotation) {
     if (_rotation != rotation) {
         _rotation = rotation;
-        setChildNeedsDisplay();
+        setNeedsRecomposite();
         setVisualFrameDirty();
     }
 }
@@ -949,6 +1213,7 @@ void Layer::setRotation(Scalar rotation) {
 void Layer::onParentChanged(const Valdi::Ref<ILayer>& parent) {
     _parent = parent;
     _hasParent = parent != nullptr;
+    _isInParentHitTestIndex = false;
 
     if (_hasParent) {
         auto parentAsLayer = Valdi::castOrNull<Layer>(parent);
@@ -984,6 +1249,8 @@ void Layer::onRootChanged(ILayerRoot* root) {
 
     _root = root;
     _layerId = kLayerIdNone;
+    // The recorded operations reference the previous layer ids
+    _recordedDisplayListId = 0;
     {
         for (const auto& child : _children.readAccess()) {
             child->onRootChanged(root);
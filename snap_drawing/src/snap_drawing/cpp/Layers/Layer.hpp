@@ -53,6 +53,7 @@ class Layer;
 class ILayerRoot;
 class IAnimation;
 class IMaskLayer;
+class LayerRasterCache;
 
 class BoxShadow;
 class LinearGradient;
@@ -60,11 +61,13 @@ class RadialGradient;
 struct AttributeContext;
 
 class DisplayList;
+class BoundingBoxHierarchy;
 
 struct DrawMetrics {
     int drawCacheMiss = 0;
     int matrixCacheMiss = 0;
     int visitedLayers = 0;
+    int reusedSubtrees = 0;
 };
 
 template<typename T, typename std::enable_if<std::is_convertible<T*, ILayer*>::value, int>::type = 0, typename... Args>
@@ -144,6 +147,26 @@ public:
     virtual bool hitTest(const Point& point) const;
     Ref<Layer> getLayerAtPoint(const Point& point);
 
+    /**
+     Returns the bounds in this layer's coordinates within which the default hitTest() succeeds,
+     which are the bounds of the layer expanded by its touch area extension.
+     */
+    Rect getHitTestBounds() const;
+
+    /**
+     Whether hitTest() can succeed outside of getHitTestBounds(). Such layers are tested on every
+     hit test of their parent, instead of being looked up in the hit test index of their parent.
+     */
+    virtual bool canBeHitOutsideOfHitTestBounds() const;
+
+    /**
+     Returns the last child which is hit by the given point in this layer's coordinates, which is
+     the child drawn on top of its siblings at that point. Layers with many children look up the hit
+     candidates in a spatial index of the hit test bounds of their children, which is only rebuilt
+     when a child is inserted, removed or moved.
+     */
+    Ref<Layer> getChildAtPoint(const Point& point);
+
     void layoutIfNeeded();
 
     bool needsDisplay() const;
@@ -272,6 +295,14 @@ private:
     LayerContent _cachedForeground;
     LazyPath _lazyPath;
     Matrix _matrix;
+    // Location of the operations of the subtree within the last DisplayList the layer was drawn into
+    uint64_t _recordedDisplayListId = 0;
+    size_t _recordedPlaneIndex = 0;
+    size_t _recordedOperationsBegin = 0;
+    size_t _recordedOperationsEnd = 0;
+    // The opacity baked into the recorded operations of the layer
+    Scalar _recordedPictureOpacity = 1.0f;
+    size_t _stableFramesCount = 0;
     bool _needsDisplay = true;
     bool _childNeedsDisplay = true;
     bool _touchEnabled = true;
@@ -283,10 +314,19 @@ private:
     bool _visualFrameDirty = true;
     bool _matrixDirty = true;
     bool _isRightToLeft = false;
+    bool _hasRasterCache = false;
     std::optional<EventId> _enqueuedFrame;
     Valdi::StringBox _accessibilityId;
+    // Hit test bounds of the children in this layer's coordinates, built lazily on hit test
+    Ref<BoundingBoxHierarchy> _childrenHitTestIndex;
+    // Indexes of the children which are not in _childrenHitTestIndex and are always tested
+    std::vector<int> _unindexedHitTestChildren;
+    std::vector<int> _hitTestCandidates;
+    bool _childrenHitTestIndexDirty = true;
+    // Whether the parent built its hit test index from the current hit test bounds of this layer
+    bool _isInParentHitTestIndex = false;
 
-    EventId onNextFrame(EventCallback&& eventCallback);
+    EventId onFrameAfter(Duration delay, EventCallback&& eventCallback);
 
     Point getOffsetInParent() const;
 
@@ -297,17 +337,49 @@ private:
     void drawContent(Scalar width, Scalar height);
     void drawForeground(Scalar width, Scalar height);
 
+    void drawSubtree(
+        DisplayList& displayList, DrawMetrics& metrics, Scalar width, Scalar height, Scalar resolvedPictureOpacity);
+    bool drawFromRasterCache(DisplayList& displayList,
+                             DrawMetrics& metrics,
+                             Scalar width,
+                             Scalar height,
+                             Scalar resolvedContextOpacity,
+                             Scalar resolvedPictureOpacity);
+    bool drawFromPreviousDisplayList(DisplayList& displayList, DrawMetrics& metrics, Scalar resolvedPictureOpacity);
+    LayerContent rasterizeSubtree(LayerRasterCache& rasterCache,
+                                  DrawMetrics& metrics,
+                                  Scalar width,
+                                  Scalar height,
+                                  Scalar resolvedPictureOpacity);
+    bool canUseRasterCache() const;
+
     void setVisualFrameDirty();
 
+    void setHitTestBoundsChanged();
+    void updateChildrenHitTestIndexIfNeeded(const std::vector<Valdi::Ref<Layer>>& children);
+
+    /**
+     Called when only the matrix or the context opacity of the layer changed. The recorded
+     operations of the layer can be reused as is, only its ancestors need to be drawn again.
+     */
+    void setNeedsRecomposite();
     void notifyParentSetChildNeedsDisplay();
 
     void updateMatrix(Scalar width, Scalar height);
 
     void scheduleProcessAnimationsIfNeeded();
+    void scheduleProcessAnimationsIfNeeded(std::optional<TimePoint> lastProcessTime);
     bool cancelProcessAnimations();
-    void processAnimations(Duration delta);
+    void processAnimations(TimePoint time, Duration delta);
+
+    /**
+     Returns the interval at which the animations need to be processed, which is 0 if any
+     of them needs to run at the display rate.
+     */
+    Duration getProcessAnimationsInterval() const;
 
     bool hasOverlappingRendering() const;
+    Scalar resolvePictureOpacity(Scalar opacity) const;
 
     void outputDebugDescription(std::string& out, int indent, bool recursive) const;
 };
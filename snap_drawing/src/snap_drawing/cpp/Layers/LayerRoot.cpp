@@ -13,6 +13,7 @@
 
 #include "snap_drawing/cpp/Drawing/Composition/Compositor.hpp"
 #include "snap_drawing/cpp/Drawing/Composition/CompositorPlaneList.hpp"
+#include "snap_drawing/cpp/Drawing/PerformanceOverlay.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurfaceCanvas.hpp"
 
 #include "snap_drawing/cpp/Touches/DragGestureRecognizer.hpp"
@@ -47,6 +48,7 @@ LayerRootListener* LayerRoot::getListener() const {
 void LayerRoot::setContentLayer(const Valdi::Ref<Layer>& contentLayer, ContentLayerSizingMode sizingMode) {
     if (_contentLayer != contentLayer || _sizingMode != sizingMode) {
         _touchDispatcher.cancelAllGestures();
+        _touchEventResampler.reset();
 
         if (_contentLayer != nullptr) {
             _contentLayer->onParentChanged(nullptr);
@@ -72,6 +74,7 @@ void LayerRoot::destroy() {
     _listener = nullptr;
     _destroyed = true;
     setContentLayer(nullptr, _sizingMode);
+    _previousDisplayList = nullptr;
     _eventQueue.clear();
 }
 
@@ -128,8 +131,12 @@ Ref<DisplayList> LayerRoot::doDraw(DrawMetrics& metrics) {
         Valdi::makeShared<DisplayList>(_size, _lastAbsoluteFrameTime ? _lastAbsoluteFrameTime.value() : TimePoint(0.0));
 
     if (_contentLayer != nullptr) {
+        // Layers which did not change since the previous frame copy their operations from it
+        displayList->setPreviousDisplayList(_previousDisplayList);
         _contentLayer->draw(*displayList, metrics);
+        displayList->setPreviousDisplayList(nullptr);
     }
+    _previousDisplayList = displayList;
 
     if (_planeList == nullptr) {
         _planeList = std::make_unique<CompositorPlaneList>();
@@ -138,7 +145,37 @@ Ref<DisplayList> LayerRoot::doDraw(DrawMetrics& metrics) {
     }
 
     Compositor compositor(_resources->getLogger());
-    return compositor.performComposition(*displayList, *_planeList);
+    auto outputDisplayList = compositor.performComposition(*displayList, *_planeList);
+
+    const auto& performanceOverlay = _resources->getPerformanceOverlay();
+    if (performanceOverlay != nullptr && performanceOverlay->isEnabled()) {
+        appendPerformanceOverlay(*outputDisplayList);
+    }
+
+    return outputDisplayList;
+}
+
+void LayerRoot::appendPerformanceOverlay(DisplayList& displayList) {
+    auto planesCount = displayList.getPlanesCount();
+    if (planesCount == 0) {
+        return;
+    }
+
+    auto picture = _resources->getPerformanceOverlay()->getPicture(_size);
+    if (picture == nullptr) {
+        return;
+    }
+
+    if (_performanceOverlayLayerId == kLayerIdNone) {
+        _performanceOverlayLayerId = allocateLayerId();
+    }
+
+    // The overlay is drawn on top of everything else, in the last plane. It is only refreshed
+    // when the root draws, so that showing it does not schedule frames by itself.
+    displayList.setCurrentPlane(planesCount - 1);
+    displayList.pushContext(Matrix(), 1.0f, _performanceOverlayLayerId, true);
+    displayList.appendPicture(picture.get(), 1.0f);
+    displayList.popContext();
 }
 
 void LayerRoot::setChildNeedsDisplay() {
@@ -168,6 +205,56 @@ bool LayerRoot::dispatchTouchEvent(const TouchEvent& event) {
         return false;
     }
 
+    if (_touchEventBatchingEnabled) {
+        if (event.getType() == TouchEventTypeMoved && !_touchDispatcher.isEmpty()) {
+            // Dispatched on the next frame, the active gestures keep processing the touch until then
+            _touchEventResampler.addMovedEvent(event);
+            enqueueFrame();
+            return true;
+        }
+
+        // The gestures need to see the last received location before the event which ends or changes the touch
+        auto pendingEvent = _touchEventResampler.flushWithoutResampling();
+        if (pendingEvent) {
+            doDispatchTouchEvent(pendingEvent.value());
+        }
+
+        if (event.getType() != TouchEventTypeIdle) {
+            _touchEventResampler.reset();
+        }
+    }
+
+    return doDispatchTouchEvent(event);
+}
+
+void LayerRoot::flushBatchedTouchEvents(const TimePoint& frameTime) {
+    auto event = _touchEventResampler.flush(frameTime);
+    if (event) {
+        VALDI_TRACE("SnapDrawing.dispatchBatchedTouchEvent");
+        doDispatchTouchEvent(event.value());
+    }
+}
+
+void LayerRoot::setTouchEventBatchingEnabled(bool touchEventBatchingEnabled) {
+    if (_touchEventBatchingEnabled == touchEventBatchingEnabled) {
+        return;
+    }
+    _touchEventBatchingEnabled = touchEventBatchingEnabled;
+
+    if (!touchEventBatchingEnabled) {
+        auto pendingEvent = _touchEventResampler.flushWithoutResampling();
+        if (pendingEvent && _contentLayer != nullptr && !_touchDispatcher.isDispatchingEvent()) {
+            doDispatchTouchEvent(pendingEvent.value());
+        }
+        _touchEventResampler.reset();
+    }
+}
+
+bool LayerRoot::isTouchEventBatchingEnabled() const {
+    return _touchEventBatchingEnabled;
+}
+
+bool LayerRoot::doDispatchTouchEvent(const TouchEvent& event) {
     auto processed = _touchDispatcher.dispatchEvent(event, _contentLayer);
 
     if (!_touchDispatcher.isEmpty()) {
@@ -306,8 +393,9 @@ void LayerRoot::processFrame(TimePoint absoluteFrameTime) {
 
     {
         VALDI_TRACE("SnapDrawing.flushEvents");
+        flushBatchedTouchEvents(frameTime);
         refreshTouches(frameTime);
-        _eventQueue.flush(frameTime);
+        _eventQueue.flush(frameTime, kEventCoalescingWindow);
     }
 
     Ref<DisplayList> displayList;
@@ -325,13 +413,59 @@ void LayerRoot::processFrame(TimePoint absoluteFrameTime) {
         _listener->onDidDraw(*this, displayList, _planeList.get());
     }
 
-    if (needsProcessFrame()) {
+    // The listener resolves when the events that are not due yet should be processed
+    if (needsProcessFrameAtTime(absoluteFrameTime)) {
         enqueueFrame();
     }
 }
 
 bool LayerRoot::needsProcessFrame() const {
-    return _didEnqueueFrame || _needsDisplay || needsLayout() || !_eventQueue.isEmpty() || !_touchDispatcher.isEmpty();
+    return needsProcessFrameIgnoringEvents() || !_eventQueue.isEmpty();
+}
+
+bool LayerRoot::needsProcessFrameAtTime(TimePoint absoluteFrameTime) const {
+    if (needsProcessFrameIgnoringEvents()) {
+        return true;
+    }
+    if (!_initialAbsoluteFrameTime) {
+        // The events are relative to the first processed frame
+        return !_eventQueue.isEmpty();
+    }
+
+    auto nextEventTime = getNextEventAbsoluteTime();
+    return nextEventTime && nextEventTime.value() <= absoluteFrameTime + kEventCoalescingWindow;
+}
+
+bool LayerRoot::needsProcessFrameIgnoringEvents() const {
+    return _didEnqueueFrame || _needsDisplay || needsLayout() || !_touchDispatcher.isEmpty() ||
+           _touchEventResampler.hasPendingEvent();
+}
+
+std::optional<TimePoint> LayerRoot::getNextEventAbsoluteTime() const {
+    auto nextEventTime = _eventQueue.getNextEventTime();
+    if (!nextEventTime || !_initialAbsoluteFrameTime) {
+        return std::nullopt;
+    }
+
+    return {_initialAbsoluteFrameTime.value() + Duration(nextEventTime.value().getTime())};
+}
+
+void LayerRoot::setFrameBudget(Duration frameBudget) {
+    _frameBudget = frameBudget;
+}
+
+TimePoint LayerRoot::getFrameDeadline() const {
+    if (!_lastAbsoluteFrameTime) {
+        return TimePoint::now() + _frameBudget;
+    }
+    return _lastAbsoluteFrameTime.value() + _frameBudget;
+}
+
+bool LayerRoot::hasTimeRemainingInFrame() const {
+    if (!_processingFrame) {
+        return true;
+    }
+    return TimePoint::now() < getFrameDeadline();
 }
 
 bool LayerRoot::needsLayout() const {
@@ -366,4 +500,12 @@ bool LayerRoot::shouldRasterizeExternalSurface() const {
     return false;
 }
 
+bool LayerRoot::shouldPresentVideoInCompositorPlane() const {
+    return _presentsVideoInCompositorPlane;
+}
+
+void LayerRoot::setPresentsVideoInCompositorPlane(bool presentsVideoInCompositorPlane) {
+    _presentsVideoInCompositorPlane = presentsVideoInCompositorPlane;
+}
+
 } // namespace snap::drawing
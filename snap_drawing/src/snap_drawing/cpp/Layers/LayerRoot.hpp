@@ -17,6 +17,7 @@
 #include "snap_drawing/cpp/Layers/Layer.hpp"
 #include "snap_drawing/cpp/Touches/TouchDispatcher.hpp"
 #include "snap_drawing/cpp/Touches/TouchEvent.hpp"
+#include "snap_drawing/cpp/Touches/TouchEventResampler.hpp"
 #include "snap_drawing/cpp/Utils/TimePoint.hpp"
 
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
@@ -76,6 +77,14 @@ public:
     GestureTypes getGesturesTypesForTouchEvent(const TouchEvent& event) const;
     bool refreshTouches(const TimePoint& currentTime);
 
+    /**
+     When enabled, the moved touch events received while gestures are active are coalesced
+     and dispatched once per frame, resampled at the frame time. Other touch events are
+     dispatched right away, after the pending moved event. Disabled by default.
+     */
+    void setTouchEventBatchingEnabled(bool touchEventBatchingEnabled);
+    bool isTouchEventBatchingEnabled() const;
+
     void setSize(Size size, Scalar scale);
 
     void setListener(LayerRootListener* listener);
@@ -109,9 +118,41 @@ public:
 
     bool needsProcessFrame() const;
 
+    /**
+     Whether processFrame() should be called for a frame at the given absolute time.
+     Unlike needsProcessFrame(), this ignores the pending events which are not due by then.
+     */
+    bool needsProcessFrameAtTime(TimePoint absoluteFrameTime) const;
+
+    /**
+     Returns the absolute time at which the earliest pending event is due, if any.
+     */
+    std::optional<TimePoint> getNextEventAbsoluteTime() const;
+
+    /**
+     Set the duration after the frame time within which processFrame() is expected to complete,
+     used to resolve the deadline returned by getFrameDeadline(). Defaults to 1/60s.
+     */
+    void setFrameBudget(Duration frameBudget);
+
+    /**
+     Returns the absolute time by which the last processed frame should have completed.
+     */
+    TimePoint getFrameDeadline() const;
+
+    bool hasTimeRemainingInFrame() const override;
+
     const Ref<Resources>& getResources() const;
 
     bool shouldRasterizeExternalSurface() const override;
+    bool shouldPresentVideoInCompositorPlane() const override;
+
+    /**
+     Set whether the video layers of the tree present their frames in a dedicated compositor plane.
+     This requires the SurfacePresenterManager of the host to be able to present a VideoSurface.
+     Disabled by default, and only applies to the video layers which are attached afterwards.
+     */
+    void setPresentsVideoInCompositorPlane(bool presentsVideoInCompositorPlane);
 
     inline Scalar sanitizeCoordinate(Scalar value) const {
         return snap::drawing::sanitizeScalarFromScale(value, _scale);
@@ -119,27 +160,43 @@ public:
 
     TimePoint getFrameTimeForAbsoluteFrameTime(TimePoint absoluteFrameTime) const;
 
+    /**
+     Events due within this duration after a frame time are processed in that frame, which lets
+     timers scheduled around the same time be batched into the same VSYNC.
+     */
+    static constexpr Duration kEventCoalescingWindow = Duration(0.004);
+
 private:
     Ref<Resources> _resources;
     LayerRootListener* _listener = nullptr;
     TouchDispatcher _touchDispatcher;
+    TouchEventResampler _touchEventResampler;
     Valdi::Ref<Layer> _contentLayer;
     EventQueue _eventQueue;
     Size _size = Size::makeEmpty();
     Scalar _scale = 1;
     uint64_t _layerIdSequence = 0;
+    uint64_t _performanceOverlayLayerId = kLayerIdNone;
     bool _needsDisplay = false;
     bool _needsLayout = true;
     bool _didEnqueueFrame = false;
     bool _destroyed = false;
     bool _processingFrame = false;
+    bool _touchEventBatchingEnabled = false;
+    bool _presentsVideoInCompositorPlane = false;
     ContentLayerSizingMode _sizingMode = ContentLayerSizingModeMinSize;
+    Duration _frameBudget = Duration(1.0 / 60.0);
     std::optional<TimePoint> _initialAbsoluteFrameTime;
     std::optional<TimePoint> _lastAbsoluteFrameTime;
     std::unique_ptr<CompositorPlaneList> _planeList;
     Ref<DisplayList> _lastDrawnFrame;
+    Ref<DisplayList> _previousDisplayList;
 
     bool needsLayout() const;
+    bool needsProcessFrameIgnoringEvents() const;
+
+    bool doDispatchTouchEvent(const TouchEvent& event);
+    void flushBatchedTouchEvents(const TimePoint& frameTime);
 
     void enqueueFrame();
 
@@ -148,6 +205,7 @@ private:
     bool canEnqueueFrame() const;
 
     Ref<DisplayList> doDraw(DrawMetrics& metrics);
+    void appendPerformanceOverlay(DisplayList& displayList);
 
     TimePoint updateFrameTime(TimePoint absoluteFrameTime);
 };
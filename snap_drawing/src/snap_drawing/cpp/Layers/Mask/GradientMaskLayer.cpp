@@ -17,6 +17,8 @@ const LinearGradient& GradientMaskLayer::getGradient() const {
 }
 
 LinearGradient& GradientMaskLayer::getGradient() {
+    // The gradient is about to be mutated
+    setNeedsUpdateMask();
     return _gradient;
 }
 
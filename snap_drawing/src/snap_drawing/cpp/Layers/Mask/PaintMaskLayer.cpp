@@ -16,6 +16,7 @@ PaintMaskLayer::~PaintMaskLayer() = default;
 void PaintMaskLayer::setPath(const Path& path) {
     _path = path;
     _rect = Rect::makeEmpty();
+    setNeedsUpdateMask();
 }
 
 void PaintMaskLayer::setRect(const Rect& rect) {
@@ -24,10 +25,12 @@ void PaintMaskLayer::setRect(const Rect& rect) {
     if (!_path.isEmpty()) {
         _path.reset();
     }
+    setNeedsUpdateMask();
 }
 
 void PaintMaskLayer::setColor(Color color) {
     _color = color;
+    setNeedsUpdateMask();
 }
 
 Color PaintMaskLayer::getColor() const {
@@ -36,6 +39,11 @@ Color PaintMaskLayer::getColor() const {
 
 void PaintMaskLayer::setBlendMode(SkBlendMode blendMode) {
     _blendMode = blendMode;
+    setNeedsUpdateMask();
+}
+
+void PaintMaskLayer::setNeedsUpdateMask() {
+    _cachedMask = nullptr;
 }
 
 Rect PaintMaskLayer::getBounds() const {
@@ -44,6 +52,10 @@ Rect PaintMaskLayer::getBounds() const {
 }
 
 Ref<IMask> PaintMaskLayer::createMask(const Rect& /*bounds*/) {
+    if (_cachedMask != nullptr) {
+        return _cachedMask;
+    }
+
     auto pathBounds = getBounds();
     if (pathBounds.isEmpty()) {
         return nullptr;
@@ -52,7 +64,8 @@ Ref<IMask> PaintMaskLayer::createMask(const Rect& /*bounds*/) {
     Paint paint;
     onConfigurePaint(paint, pathBounds);
 
-    return Valdi::makeShared<PaintMask>(paint, _path, _rect);
+    _cachedMask = Valdi::makeShared<PaintMask>(paint, _path, _rect);
+    return _cachedMask;
 }
 
 MaskLayerPositioning PaintMaskLayer::getPositioning() {
@@ -61,12 +61,20 @@ public:
 protected:
     virtual void onConfigurePaint(Paint& paint, const Rect& bounds);
 
+    /**
+     Discard the mask created from the current configuration, so that the next
+     createMask() call creates a new one. Called by every setter.
+     */
+    void setNeedsUpdateMask();
+
 private:
     Rect _rect;
     Path _path;
     Color _color = Color::black();
     SkBlendMode _blendMode = SkBlendMode::kDstOut;
     MaskLayerPositioning _positioning = MaskLayerPositioning::BelowBackground;
+    // The mask is immutable, it is reused across draws as long as the configuration is unchanged
+    Ref<IMask> _cachedMask;
 };
 
 } // namespace snap::drawing
@@ -45,6 +45,10 @@ const Path& ShapeLayer::getActivePath() {
 }
 
 void ShapeLayer::setPath(Path&& path) {
+    if (path.getGenerationId() == _path.getGenerationId()) {
+        // Same geometry, which happens when the path is resolved again from the PathCache
+        return;
+    }
     _path = std::move(path);
     _pathInterpolator = std::nullopt;
     setNeedsDisplay();
@@ -17,6 +17,8 @@ constexpr Scalar kLineThickness = 1.5;
 constexpr Scalar kLineSweepRatio = 0.6;
 constexpr Scalar kInnerCircleOffset = 3.0;
 constexpr Scalar kInnerCircleRotationOffset = 0.5;
+// The spinner is slow and thin enough to not need the display's max rate
+constexpr Scalar kSpinnerFrameRate = 30;
 
 class SpinnerAnimation : public IAnimation {
 public:
@@ -52,6 +54,10 @@ public:
 
     void addCompletion(AnimationCompletion&& completion) override {}
 
+    Scalar getPreferredFrameRate() const override {
+        return kSpinnerFrameRate;
+    }
+
 private:
     bool _started = false;
     TimeInterval _animationTime = 0;
@@ -15,6 +15,7 @@
 #include "include/effects/SkGradientShader.h"
 #include "snap_drawing/cpp/Text/FontManager.hpp"
 #include "snap_drawing/cpp/Text/TextLayoutBuilder.hpp"
+#include "snap_drawing/cpp/Text/TextLayoutCache.hpp"
 #include "snap_drawing/cpp/Touches/AttributedTextOnTapGestureRecognizer.hpp"
 #include "snap_drawing/cpp/Utils/GradientWrapper.hpp"
 
@@ -127,7 +128,7 @@ void TextLayer::drawText(DrawingContext& drawingContext,
 
 void TextLayer::applyGradientToTextPaint(Paint& paint) {
     if (_textLayout != nullptr) {
-        _gradientWrapper.update(_textLayout->getBounds());
+        _gradientWrapper.update(_textLayout->getBounds(), getResources()->getGradientShaderCache().get());
         _gradientWrapper.applyToPaint(paint);
     }
 }
@@ -383,25 +384,55 @@ TextLayout& TextLayer::getTextLayout(Size size, bool respectDynamicType, Scalar
     }
 
     if (_textLayout == nullptr) {
-        VALDI_TRACE("SnapDrawing.makeTextLayout");
-        _textLayout = TextLayer::makeTextLayout(maxSize,
-                                                _text,
-                                                _attributedText,
-                                                _textFont,
-                                                _textAlign,
-                                                _textDecoration,
-                                                _textOverflow,
-                                                _numberOfLines,
-                                                _lineHeightMultiple,
-                                                _letterSpacing,
-                                                isRightToLeft(),
-                                                _adjustsFontSizeToFitWidth,
-                                                _minimumScaleFactor,
-                                                respectDynamicType,
-                                                /* includeTextBlob*/ true,
-                                                displayScale,
-                                                dynamicTypeScale,
-                                                getResources()->getFontManager());
+        const auto& textLayoutCache = getResources()->getTextLayoutCache();
+        TextLayoutCacheKey cacheKey;
+        if (textLayoutCache != nullptr) {
+            cacheKey.maxSize = maxSize;
+            cacheKey.text = _text;
+            cacheKey.attributedText = _attributedText;
+            cacheKey.font = _textFont;
+            cacheKey.textAlign = _textAlign;
+            cacheKey.textDecoration = _textDecoration;
+            cacheKey.textOverflow = _textOverflow;
+            cacheKey.numberOfLines = _numberOfLines;
+            cacheKey.lineHeightMultiple = _lineHeightMultiple;
+            cacheKey.letterSpacing = _letterSpacing;
+            cacheKey.isRightToLeft = isRightToLeft();
+            cacheKey.adjustsFontSizeToFitWidth = _adjustsFontSizeToFitWidth;
+            cacheKey.minimumScaleFactor = _minimumScaleFactor;
+            cacheKey.respectDynamicType = respectDynamicType;
+            cacheKey.includeTextBlob = true;
+            cacheKey.displayScale = displayScale;
+            cacheKey.dynamicTypeScale = dynamicTypeScale;
+
+            _textLayout = textLayoutCache->find(cacheKey);
+        }
+
+        if (_textLayout == nullptr) {
+            VALDI_TRACE("SnapDrawing.makeTextLayout");
+            _textLayout = TextLayer::makeTextLayout(maxSize,
+                                                    _text,
+                                                    _attributedText,
+                                                    _textFont,
+                                                    _textAlign,
+                                                    _textDecoration,
+                                                    _textOverflow,
+                                                    _numberOfLines,
+                                                    _lineHeightMultiple,
+                                                    _letterSpacing,
+                                                    isRightToLeft(),
+                                                    _adjustsFontSizeToFitWidth,
+                                                    _minimumScaleFactor,
+                                                    respectDynamicType,
+                                                    /* includeTextBlob*/ true,
+                                                    displayScale,
+                                                    dynamicTypeScale,
+                                                    getResources()->getFontManager());
+
+            if (textLayoutCache != nullptr) {
+                textLayoutCache->insert(std::move(cacheKey), _textLayout);
+            }
+        }
 
         if (hasOnTapAttributeInTextLayout(*_textLayout)) {
             addOnTapGestureRecognizer();
@@ -6,6 +6,8 @@
 //
 
 #include "snap_drawing/cpp/Layers/VideoLayer.hpp"
+#include "snap_drawing/cpp/Drawing/Surface/VideoSurface.hpp"
+#include "snap_drawing/cpp/Layers/Interfaces/ILayerRoot.hpp"
 #include "snap_drawing/cpp/Utils/ImageQueue.hpp"
 
 namespace snap::drawing {
@@ -51,15 +53,57 @@ void VideoLayer::onBoundsChanged() {
     Layer::onBoundsChanged();
 
     _imageLayer->setFrame(Rect::makeXYWH(0, 0, getFrame().width(), getFrame().height()));
+    if (_videoSurfaceLayer != nullptr) {
+        _videoSurfaceLayer->setFrame(Rect::makeXYWH(0, 0, getFrame().width(), getFrame().height()));
+    }
 }
 
 void VideoLayer::setFittingSizeMode(FittingSizeMode fittingSizeMode) {
+    _fittingSizeMode = fittingSizeMode;
     _imageLayer->setFittingSizeMode(fittingSizeMode);
+    if (_videoSurface != nullptr) {
+        _videoSurface->setFittingSizeMode(fittingSizeMode);
+    }
+}
+
+bool VideoLayer::shouldPresentInCompositorPlane() const {
+    auto* root = getRoot();
+    return root != nullptr && _imageQueue != nullptr && root->shouldPresentVideoInCompositorPlane() &&
+           !root->shouldRasterizeExternalSurface();
 }
 
 void VideoLayer::updatePlaybackAnimation() {
     static auto kAnimationKey = STRING_LITERAL("videoPlayback");
 
+    if (shouldPresentInCompositorPlane()) {
+        // The frames are dequeued by the presenter of the VideoSurface, the layer tree
+        // no longer needs to process and draw a frame for every video frame
+        removeAnimation(kAnimationKey);
+
+        if (_videoSurface == nullptr || _videoSurface->getImageQueue() != _imageQueue) {
+            _videoSurface = Valdi::makeShared<VideoSurface>(_imageQueue, _fittingSizeMode);
+        }
+        if (_videoSurfaceLayer == nullptr) {
+            _videoSurfaceLayer = makeLayer<ExternalLayer>(getResources());
+            _videoSurfaceLayer->setFrame(Rect::makeXYWH(0, 0, getFrame().width(), getFrame().height()));
+        }
+        _videoSurfaceLayer->setExternalSurface(_videoSurface);
+
+        if (_imageLayer->getParent() != nullptr) {
+            _imageLayer->removeFromParent();
+            _imageLayer->setImage(nullptr);
+            addChild(_videoSurfaceLayer);
+        }
+        return;
+    }
+
+    if (_videoSurfaceLayer != nullptr && _videoSurfaceLayer->getParent() != nullptr) {
+        _videoSurfaceLayer->removeFromParent();
+        insertChild(_imageLayer, 0);
+    }
+    _videoSurfaceLayer = nullptr;
+    _videoSurface = nullptr;
+
     if (getRoot() != nullptr && _imageQueue != nullptr) {
         addAnimation(kAnimationKey, Valdi::makeShared<VideoPlaybackAnimation>(_imageQueue, _imageLayer));
     } else {
@@ -8,12 +8,14 @@
 #pragma once
 
 #include "snap_drawing/cpp/Animations/Animation.hpp"
+#include "snap_drawing/cpp/Layers/ExternalLayer.hpp"
 #include "snap_drawing/cpp/Layers/ImageLayer.hpp"
 #include "snap_drawing/cpp/Layers/Layer.hpp"
 
 namespace snap::drawing {
 
 class ImageQueue;
+class VideoSurface;
 
 class VideoPlaybackAnimation : public IAnimation {
 public:
@@ -52,8 +54,13 @@ protected:
 private:
     Ref<ImageLayer> _imageLayer;
     Ref<ImageQueue> _imageQueue;
+    // Present the frames when the root presents videos in their own compositor plane
+    Ref<ExternalLayer> _videoSurfaceLayer;
+    Ref<VideoSurface> _videoSurface;
+    FittingSizeMode _fittingSizeMode = FittingSizeModeFill;
 
     void updatePlaybackAnimation();
+    bool shouldPresentInCompositorPlane() const;
 };
 
 } // namespace snap::drawing
@@ -7,7 +7,14 @@
 
 #include "snap_drawing/cpp/Resources.hpp"
 #include "include/core/SkGraphics.h"
+#include "snap_drawing/cpp/Drawing/GradientShaderCache.hpp"
+#include "snap_drawing/cpp/Drawing/PerformanceOverlay.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/BoxShadowCache.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/LayerRasterCache.hpp"
+#include "snap_drawing/cpp/Text/TextLayoutCache.hpp"
 #include "snap_drawing/cpp/Utils/Image.hpp"
+#include "snap_drawing/cpp/Utils/PathCache.hpp"
 #include "valdi_core/cpp/Interfaces/ILogger.hpp"
 
 namespace snap::drawing {
@@ -69,4 +76,60 @@ Valdi::ILogger& Resources::getLogger() const {
     return *_logger;
 }
 
+void Resources::setLayerRasterCache(const Ref<LayerRasterCache>& layerRasterCache) {
+    _layerRasterCache = layerRasterCache;
+}
+
+const Ref<LayerRasterCache>& Resources::getLayerRasterCache() const {
+    return _layerRasterCache;
+}
+
+void Resources::setImageAtlas(const Ref<ImageAtlas>& imageAtlas) {
+    _imageAtlas = imageAtlas;
+}
+
+const Ref<ImageAtlas>& Resources::getImageAtlas() const {
+    return _imageAtlas;
+}
+
+void Resources::setTextLayoutCache(const Ref<TextLayoutCache>& textLayoutCache) {
+    _textLayoutCache = textLayoutCache;
+}
+
+const Ref<TextLayoutCache>& Resources::getTextLayoutCache() const {
+    return _textLayoutCache;
+}
+
+void Resources::setBoxShadowCache(const Ref<BoxShadowCache>& boxShadowCache) {
+    _boxShadowCache = boxShadowCache;
+}
+
+const Ref<BoxShadowCache>& Resources::getBoxShadowCache() const {
+    return _boxShadowCache;
+}
+
+void Resources::setPathCache(const Ref<PathCache>& pathCache) {
+    _pathCache = pathCache;
+}
+
+const Ref<PathCache>& Resources::getPathCache() const {
+    return _pathCache;
+}
+
+void Resources::setGradientShaderCache(const Ref<GradientShaderCache>& gradientShaderCache) {
+    _gradientShaderCache = gradientShaderCache;
+}
+
+const Ref<GradientShaderCache>& Resources::getGradientShaderCache() const {
+    return _gradientShaderCache;
+}
+
+void Resources::setPerformanceOverlay(const Ref<PerformanceOverlay>& performanceOverlay) {
+    _performanceOverlay = performanceOverlay;
+}
+
+const Ref<PerformanceOverlay>& Resources::getPerformanceOverlay() const {
+    return _performanceOverlay;
+}
+
 } // namespace snap::drawing
@@ -22,6 +22,14 @@ class ILogger;
 
 namespace snap::drawing {
 
+class BoxShadowCache;
+class GradientShaderCache;
+class ImageAtlas;
+class LayerRasterCache;
+class PathCache;
+class PerformanceOverlay;
+class TextLayoutCache;
+
 class Resources : public Valdi::SimpleRefCountable {
 public:
     Resources(const Ref<FontManager>& fontManager,
@@ -47,6 +55,62 @@ public:
 
     const GesturesConfiguration& getGesturesConfiguration() const;
 
+    /**
+     Set the cache used by the layers to retain rasterized images of their subtrees
+     when they don't change over multiple frames. Layers are always fully drawn when
+     no raster cache is set, which is the default.
+     */
+    void setLayerRasterCache(const Ref<LayerRasterCache>& layerRasterCache);
+    const Ref<LayerRasterCache>& getLayerRasterCache() const;
+
+    /**
+     Set the atlas into which image layers copy their small images, so that they can be
+     drawn in batches. Images are drawn individually when no atlas is set, which is the default.
+     */
+    void setImageAtlas(const Ref<ImageAtlas>& imageAtlas);
+    const Ref<ImageAtlas>& getImageAtlas() const;
+
+    /**
+     Set the cache from which text layers resolve their TextLayout, so that layers displaying
+     the same text with the same parameters share it. Text layers always build their own
+     TextLayout when no cache is set, which is the default.
+     */
+    void setTextLayoutCache(const Ref<TextLayoutCache>& textLayoutCache);
+    const Ref<TextLayoutCache>& getTextLayoutCache() const;
+
+    /**
+     Set the cache from which layers draw their box shadows, so that layers with the same
+     shadow style share a single pre-rendered nine-patch. Box shadows are blurred by each
+     layer when no cache is set, which is the default.
+     */
+    void setBoxShadowCache(const Ref<BoxShadowCache>& boxShadowCache);
+    const Ref<BoxShadowCache>& getBoxShadowCache() const;
+
+    /**
+     Set the cache from which shape layers resolve the Path of their path data, so that layers
+     displaying the same path at the same size share it. Shape layers always build their own
+     Path when no cache is set, which is the default.
+     */
+    void setPathCache(const Ref<PathCache>& pathCache);
+    const Ref<PathCache>& getPathCache() const;
+
+    /**
+     Set the cache from which layers resolve the shaders of their gradients, so that layers with
+     the same gradient style share a single gradient shader, mapped to their bounds. Each layer
+     builds its own gradient shader when no cache is set, which is the default.
+     */
+    void setGradientShaderCache(const Ref<GradientShaderCache>& gradientShaderCache);
+    const Ref<GradientShaderCache>& getGradientShaderCache() const;
+
+    /**
+     Set the overlay which layer roots draw on top of their content, showing the timings of the
+     most recent frames. The overlay should be set before the layer roots start drawing, and
+     toggled afterwards through PerformanceOverlay::setEnabled(). No overlay is drawn when none
+     is set, which is the default.
+     */
+    void setPerformanceOverlay(const Ref<PerformanceOverlay>& performanceOverlay);
+    const Ref<PerformanceOverlay>& getPerformanceOverlay() const;
+
 private:
     Ref<FontManager> _fontManager;
     bool _respectDynamicType;
@@ -54,6 +118,13 @@ private:
     Scalar _dynamicTypeScale;
     GesturesConfiguration _gesturesConfiguration;
     Ref<Valdi::ILogger> _logger;
+    Ref<LayerRasterCache> _layerRasterCache;
+    Ref<ImageAtlas> _imageAtlas;
+    Ref<TextLayoutCache> _textLayoutCache;
+    Ref<BoxShadowCache> _boxShadowCache;
+    Ref<PathCache> _pathCache;
+    Ref<GradientShaderCache> _gradientShaderCache;
+    Ref<PerformanceOverlay> _performanceOverlay;
 };
 
 } // namespace snap::drawing
@@ -284,6 +284,18 @@ Ref<FontFamily> FontManager::resolveFallbackFontFamilyForCharacter(std::unique_l
         return fontFamily;
     }
 
+    // Characters from the same Unicode block are very likely to be supported by the same
+    // font family, most notably emojis and CJK characters. Try the family we last resolved
+    // from the system for this block before doing a full search through SkFontMgr.
+    auto block = getFallbackBlock(character);
+    const auto& blockIt = _fallbackFontFamiliesByBlock.find(block);
+    if (blockIt != _fallbackFontFamiliesByBlock.end()) {
+        auto typeface = _typefaceRegistry.getTypefaceFromFamily(*_fontManager, blockIt->second, _defaultFontStyle);
+        if (typeface && typeface.value()->supportsCharacter(character)) {
+            return blockIt->second;
+        }
+    }
+
     VALDI_TRACE("SnapDrawing.matchFamilyStyleCharacter");
     auto skTypeface =
         sk_sp<SkTypeface>(_fontManager->matchFamilyStyleCharacter(nullptr, SkFontStyle(), nullptr, 0, character));
@@ -295,7 +307,16 @@ Ref<FontFamily> FontManager::resolveFallbackFontFamilyForCharacter(std::unique_l
     skTypeface->getFamilyName(&skFamilyName);
     auto resolvedFamilyname = Valdi::StringCache::getGlobal().makeStringFromLiteral(skFamilyName.c_str());
 
-    return _typefaceRegistry.getFontFamilyByFamilyName(resolvedFamilyname);
+    fontFamily = _typefaceRegistry.getFontFamilyByFamilyName(resolvedFamilyname);
+    if (fontFamily != nullptr) {
+        _fallbackFontFamiliesByBlock[block] = fontFamily;
+    }
+
+    return fontFamily;
+}
+
+Character FontManager::getFallbackBlock(Character character) {
+    return character >> 7;
 }
 
 Valdi::Result<Valdi::Ref<Font>> FontManager::getCompatibleFont(const String& /*familyName*/,
@@ -394,8 +415,9 @@ void FontManager::registerTypeface(const String& fontFamilyName,
                                    const Ref<LoadableTypeface>& loadableTypeface) {
     auto guard = lock(/* shouldInitIfNeeded */ false, nullptr);
     _typefaceRegistry.registerTypeface(fontFamilyName, fontStyle, canUseAsFallback, loadableTypeface);
-    // Clear fallback font family cache, so that we can pickup our new typeface
+    // Clear fallback font family caches, so that we can pickup our new typeface
     _fallbackFontFamilies.clear();
+    _fallbackFontFamiliesByBlock.clear();
 }
 
 void FontManager::onFontResolveFailed(const String& fontName, const Valdi::Error& error) {
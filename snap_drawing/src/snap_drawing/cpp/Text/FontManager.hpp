@@ -125,6 +125,7 @@ private:
 
     TypefaceRegistry _typefaceRegistry;
     Valdi::FlatMap<Character, Ref<FontFamily>> _fallbackFontFamilies;
+    Valdi::FlatMap<Character, Ref<FontFamily>> _fallbackFontFamiliesByBlock;
     FontStyle _defaultFontStyle;
     Ref<TextShaper> _textShaper;
     Valdi::StringBox _defaultFontFamilyName;
@@ -139,6 +140,7 @@ private:
                                                             double scale);
 
     Ref<FontFamily> resolveFallbackFontFamilyForCharacter(std::unique_lock<Valdi::Mutex>& lock, Character character);
+    static Character getFallbackBlock(Character character);
     Valdi::Result<Valdi::Ref<Font>> getFontFromFamily(std::unique_lock<Valdi::Mutex>& lock,
                                                       const Ref<FontFamily>& fontFamily,
                                                       FontStyle fontStyle,
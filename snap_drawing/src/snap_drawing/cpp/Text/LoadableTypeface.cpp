@@ -8,8 +8,11 @@
 #include "snap_drawing/cpp/Text/LoadableTypeface.hpp"
 #include "include/core/SkData.h"
 #include "include/core/SkFontMgr.h"
+#include "snap_drawing/cpp/Text/SkFontMgrSingleton.hpp"
 #include "snap_drawing/cpp/Utils/BytesUtils.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/DiskUtils.hpp"
+#include "valdi_core/cpp/Utils/Trace.hpp"
 
 namespace snap::drawing {
 
@@ -39,6 +42,16 @@ protected:
         return Valdi::DiskUtils::load(path);
     }
 
+    Valdi::Result<sk_sp<SkData>> loadFontSkData() override {
+        // Map the file instead of reading it, so that the font data can be paged out by the
+        // kernel and shared between processes rather than counted in our heap.
+        auto skData = SkData::MakeFromFileName(_path.getCStr());
+        if (skData == nullptr) {
+            return LoadableTypeface::loadFontSkData();
+        }
+        return skData;
+    }
+
 private:
     Valdi::StringBox _path;
 };
@@ -47,25 +60,52 @@ LoadableTypeface::LoadableTypeface(const String& fontName) : _fontName(fontName)
 LoadableTypeface::~LoadableTypeface() = default;
 
 const Valdi::Result<Ref<Typeface>>& LoadableTypeface::get(SkFontMgr& fontMgr) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
     if (_loadedTypeface.empty()) {
         _loadedTypeface = loadTypeface(fontMgr);
     }
+    // The result is never changed once set, so it can be safely read outside of the lock
     return _loadedTypeface;
 }
 
+void LoadableTypeface::prefetch() {
+    if (isLoaded()) {
+        return;
+    }
+
+    Valdi::ThreadPool::getShared()->submit([self = Valdi::strongSmallRef(this)]() {
+        VALDI_TRACE("SnapDrawing.prefetchTypeface");
+        auto fontMgr = snap_drawing::getSkFontMgrSingleton();
+        self->get(*fontMgr);
+    });
+}
+
+bool LoadableTypeface::isLoaded() const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    return !_loadedTypeface.empty();
+}
+
 const String& LoadableTypeface::getName() const {
     return _fontName;
 }
 
-Valdi::Result<Ref<Typeface>> LoadableTypeface::loadTypeface(SkFontMgr& fontMgr) {
+Valdi::Result<sk_sp<SkData>> LoadableTypeface::loadFontSkData() {
     auto fontDataResult = loadFontData();
     if (!fontDataResult) {
-        return fontDataResult.error().rethrow("Could not load typeface data");
+        return fontDataResult.moveError();
     }
 
     auto fontData = fontDataResult.moveValue();
-    auto skData = skDataFromBytes(fontData, DataConversionModeCopyIfUnsafe);
-    auto skTypeface = fontMgr.makeFromData(skData);
+    return skDataFromBytes(fontData, DataConversionModeCopyIfUnsafe);
+}
+
+Valdi::Result<Ref<Typeface>> LoadableTypeface::loadTypeface(SkFontMgr& fontMgr) {
+    auto skDataResult = loadFontSkData();
+    if (!skDataResult) {
+        return skDataResult.error().rethrow("Could not load typeface data");
+    }
+
+    auto skTypeface = fontMgr.makeFromData(skDataResult.moveValue());
 
     if (skTypeface == nullptr) {
         return Valdi::Error("Could not load typeface from data");
@@ -9,7 +9,10 @@
 
 #include "snap_drawing/cpp/Text/Typeface.hpp"
 
+#include "include/core/SkData.h"
+
 #include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 
 class SkFontMgr;
@@ -27,6 +30,15 @@ public:
 
     const Valdi::Result<Ref<Typeface>>& get(SkFontMgr& fontMgr);
 
+    /**
+     Load and parse the typeface on the shared ThreadPool, so that the first measure pass
+     using it does not have to. A get() call made while the prefetch is in progress waits
+     for it to complete instead of loading the typeface a second time.
+     */
+    void prefetch();
+
+    bool isLoaded() const;
+
     const String& getName() const;
 
     static Ref<LoadableTypeface> fromBytes(const String& fontName, const Valdi::BytesView& bytes);
@@ -35,7 +47,15 @@ public:
 protected:
     virtual Valdi::Result<Valdi::BytesView> loadFontData() = 0;
 
+    /**
+     Returns the font data to hand to Skia. The default implementation wraps the bytes
+     returned by loadFontData(), subclasses can override it to provide data that is not
+     backed by the heap.
+     */
+    virtual Valdi::Result<sk_sp<SkData>> loadFontSkData();
+
 private:
+    mutable Valdi::Mutex _mutex;
     Valdi::Result<Ref<Typeface>> _loadedTypeface;
     String _fontName;
 
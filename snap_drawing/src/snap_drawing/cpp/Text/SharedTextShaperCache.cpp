@@ -0,0 +1,120 @@
+#include "snap_drawing/cpp/Text/SharedTextShaperCache.hpp"
+
+#include <limits>
+
+namespace snap::drawing {
+
+constexpr size_t kGlobalCacheMaxSizeInBytes = 1024 * 1024;
+
+SharedTextShaperCache::Shard::Shard() : cache(std::numeric_limits<size_t>::max()) {}
+
+SharedTextShaperCache::SharedTextShaperCache(size_t maxSizeInBytes)
+    : _maxShardSizeInBytes(maxSizeInBytes / kShardsCount) {}
+
+SharedTextShaperCache::~SharedTextShaperCache() = default;
+
+const Ref<SharedTextShaperCache>& SharedTextShaperCache::getGlobal() {
+    static auto kCache = Valdi::makeShared<SharedTextShaperCache>(kGlobalCacheMaxSizeInBytes);
+    return kCache;
+}
+
+void SharedTextShaperCache::clear() {
+    for (auto& shard : _shards) {
+        std::lock_guard<Valdi::Mutex> lock(shard.mutex);
+        shard.cache.clear();
+        shard.sizeInBytes = 0;
+    }
+}
+
+bool SharedTextShaperCache::contains(const TextShaperCacheKey& key) const {
+    const auto& shard = getShard(key);
+    std::lock_guard<Valdi::Mutex> lock(shard.mutex);
+    return shard.cache.contains(key);
+}
+
+bool SharedTextShaperCache::find(const TextShaperCacheKey& key, std::vector<ShapedGlyph>& out) {
+    auto& shard = getShard(key);
+
+    {
+        std::lock_guard<Valdi::Mutex> lock(shard.mutex);
+        const auto& it = shard.cache.find(key);
+        if (it != shard.cache.end()) {
+            // The glyphs are copied while holding the lock, as the entry might be evicted
+            // by another thread right after.
+            const auto& value = it->value();
+            out.insert(out.end(), value.glyphs, value.glyphs + value.length);
+            _hitsCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    _missesCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void SharedTextShaperCache::insert(const TextShaperCacheKey& key, const ShapedGlyph* glyphs, size_t glyphsLength) {
+    auto entrySize = getEntrySizeInBytes(key.length, glyphsLength);
+    if (entrySize > _maxShardSizeInBytes) {
+        return;
+    }
+
+    // Allocate the node outside of the lock
+    auto node = TextShaperCacheNode::make(key.fontId,
+                                          key.letterSpacing,
+                                          key.script,
+                                          key.isRightToLeft,
+                                          key.characters,
+                                          key.length,
+                                          glyphs,
+                                          glyphsLength,
+                                          key.hash());
+
+    auto& shard = getShard(key);
+    std::lock_guard<Valdi::Mutex> lock(shard.mutex);
+
+    if (shard.cache.contains(key)) {
+        // Another thread shaped the same word concurrently
+        return;
+    }
+
+    while (shard.sizeInBytes + entrySize > _maxShardSizeInBytes) {
+        auto last = shard.cache.last();
+        shard.sizeInBytes -= getEntrySizeInBytes(last->key().length, last->value().length);
+        shard.evictionsCount++;
+        shard.cache.remove(last->key());
+    }
+
+    shard.cache.insert(node);
+    shard.sizeInBytes += entrySize;
+}
+
+SharedTextShaperCacheStats SharedTextShaperCache::getStats() const {
+    SharedTextShaperCacheStats stats;
+    stats.maxSizeInBytes = _maxShardSizeInBytes * kShardsCount;
+    stats.hitsCount = _hitsCount.load(std::memory_order_relaxed);
+    stats.missesCount = _missesCount.load(std::memory_order_relaxed);
+
+    for (const auto& shard : _shards) {
+        std::lock_guard<Valdi::Mutex> lock(shard.mutex);
+        stats.entriesCount += shard.cache.size();
+        stats.sizeInBytes += shard.sizeInBytes;
+        stats.evictionsCount += shard.evictionsCount;
+    }
+
+    return stats;
+}
+
+SharedTextShaperCache::Shard& SharedTextShaperCache::getShard(const TextShaperCacheKey& key) {
+    // The low bits of the hash are used by the FlatMap of the shard
+    return _shards[(key.hash() >> 16) % kShardsCount];
+}
+
+const SharedTextShaperCache::Shard& SharedTextShaperCache::getShard(const TextShaperCacheKey& key) const {
+    return _shards[(key.hash() >> 16) % kShardsCount];
+}
+
+size_t SharedTextShaperCache::getEntrySizeInBytes(size_t charactersLength, size_t glyphsLength) {
+    return sizeof(TextShaperCacheNode) + charactersLength * sizeof(Character) + glyphsLength * sizeof(ShapedGlyph);
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "snap_drawing/cpp/Text/TextShaperCache.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace snap::drawing {
+
+struct SharedTextShaperCacheStats {
+    size_t entriesCount = 0;
+    size_t sizeInBytes = 0;
+    size_t maxSizeInBytes = 0;
+    uint64_t hitsCount = 0;
+    uint64_t missesCount = 0;
+    uint64_t evictionsCount = 0;
+};
+
+/**
+ * A thread safe cache of shape results, which can be shared between FontManager instances
+ * and used concurrently from the main thread, the draw thread and background prelayout.
+ * Entries are distributed into shards by their key hash, each shard having its own lock and
+ * LRU list, so that concurrent lookups rarely contend. The cache is bounded by the total
+ * size in bytes of its entries, split evenly between the shards.
+ */
+class SharedTextShaperCache : public Valdi::SimpleRefCountable {
+public:
+    static constexpr size_t kShardsCount = 8;
+
+    explicit SharedTextShaperCache(size_t maxSizeInBytes);
+    ~SharedTextShaperCache() override;
+
+    /**
+     * Returns the process wide cache used by the TextShaper instances created through TextShaper::make().
+     */
+    static const Ref<SharedTextShaperCache>& getGlobal();
+
+    void clear();
+
+    bool contains(const TextShaperCacheKey& key) const;
+
+    /**
+     * Append the shaped glyphs stored for the given key into out.
+     * Returns false if the key is not in the cache.
+     */
+    bool find(const TextShaperCacheKey& key, std::vector<ShapedGlyph>& out);
+
+    void insert(const TextShaperCacheKey& key, const ShapedGlyph* glyphs, size_t glyphsLength);
+
+    SharedTextShaperCacheStats getStats() const;
+
+private:
+    struct Shard {
+        mutable Valdi::Mutex mutex;
+        Valdi::LRUCache<TextShaperCacheKey, TextShaperCacheValue> cache;
+        size_t sizeInBytes = 0;
+        uint64_t evictionsCount = 0;
+
+        Shard();
+    };
+
+    std::array<Shard, kShardsCount> _shards;
+    size_t _maxShardSizeInBytes;
+    std::atomic<uint64_t> _hitsCount = 0;
+    std::atomic<uint64_t> _missesCount = 0;
+
+    Shard& getShard(const TextShaperCacheKey& key);
+    const Shard& getShard(const TextShaperCacheKey& key) const;
+
+    static size_t getEntrySizeInBytes(size_t charactersLength, size_t glyphsLength);
+};
+
+} // namespace snap::drawing
@@ -0,0 +1,143 @@
+#include "snap_drawing/cpp/Text/TextLayoutCache.hpp"
+#include "snap_drawing/cpp/Text/Typeface.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace snap::drawing {
+
+static bool fontsEqual(const Ref<Font>& left, const Ref<Font>& right) {
+    if (left == right) {
+        return true;
+    }
+    if (left == nullptr || right == nullptr) {
+        return false;
+    }
+
+    return left->typeface()->getId() == right->typeface()->getId() && left->size() == right->size() &&
+           left->scale() == right->scale() && left->respectDynamicType() == right->respectDynamicType();
+}
+
+static void hashFont(size_t& hash, const Ref<Font>& font) {
+    if (font == nullptr) {
+        boost::hash_combine(hash, 0);
+        return;
+    }
+
+    boost::hash_combine(hash, font->typeface()->getId());
+    boost::hash_combine(hash, std::hash<Scalar>()(font->size()));
+    boost::hash_combine(hash, std::hash<double>()(font->scale()));
+}
+
+static bool attributedTextsEqual(const Ref<AttributedText>& left, const Ref<AttributedText>& right) {
+    if (left == right) {
+        return true;
+    }
+    if (left == nullptr || right == nullptr || left->getPartsSize() != right->getPartsSize()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < left->getPartsSize(); i++) {
+        const auto& leftStyle = left->getStyleAtIndex(i);
+        const auto& rightStyle = right->getStyleAtIndex(i);
+
+        if (left->getContentAtIndex(i) != right->getContentAtIndex(i) || !fontsEqual(leftStyle.font, rightStyle.font) ||
+            leftStyle.color != rightStyle.color || leftStyle.textDecoration != rightStyle.textDecoration ||
+            leftStyle.onTap != rightStyle.onTap) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+TextLayoutCacheKey::TextLayoutCacheKey() = default;
+TextLayoutCacheKey::~TextLayoutCacheKey() = default;
+
+bool TextLayoutCacheKey::operator==(const TextLayoutCacheKey& other) const {
+    return maxSize == other.maxSize && textAlign == other.textAlign && textDecoration == other.textDecoration &&
+           textOverflow == other.textOverflow && numberOfLines == other.numberOfLines &&
+           lineHeightMultiple == other.lineHeightMultiple && letterSpacing == other.letterSpacing &&
+           isRightToLeft == other.isRightToLeft && adjustsFontSizeToFitWidth == other.adjustsFontSizeToFitWidth &&
+           minimumScaleFactor == other.minimumScaleFactor && respectDynamicType == other.respectDynamicType &&
+           includeTextBlob == other.includeTextBlob && displayScale == other.displayScale &&
+           dynamicTypeScale == other.dynamicTypeScale && text == other.text && fontsEqual(font, other.font) &&
+           attributedTextsEqual(attributedText, other.attributedText);
+}
+
+bool TextLayoutCacheKey::operator!=(const TextLayoutCacheKey& other) const {
+    return !(*this == other);
+}
+
+size_t TextLayoutCacheKey::hash() const {
+    auto hash = text.hash();
+    boost::hash_combine(hash, std::hash<Scalar>()(maxSize.width));
+    boost::hash_combine(hash, std::hash<Scalar>()(maxSize.height));
+    boost::hash_combine(hash, static_cast<size_t>(textAlign));
+    boost::hash_combine(hash, static_cast<size_t>(numberOfLines));
+    boost::hash_combine(hash, std::hash<Scalar>()(letterSpacing));
+    boost::hash_combine(hash, std::hash<Scalar>()(displayScale));
+    hashFont(hash, font);
+
+    if (attributedText != nullptr) {
+        for (size_t i = 0; i < attributedText->getPartsSize(); i++) {
+            boost::hash_combine(hash, attributedText->getContentAtIndex(i).hash());
+            hashFont(hash, attributedText->getStyleAtIndex(i).font);
+        }
+    }
+
+    return hash;
+}
+
+TextLayoutCache::TextLayoutCache(size_t capacity) : _cache(capacity) {}
+TextLayoutCache::~TextLayoutCache() = default;
+
+Ref<TextLayout> TextLayoutCache::find(const TextLayoutCacheKey& key) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    const auto& it = _cache.find(key);
+    if (it == _cache.end()) {
+        return nullptr;
+    }
+
+    return it->value();
+}
+
+void TextLayoutCache::insert(TextLayoutCacheKey key, const Ref<TextLayout>& textLayout) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _cache.insert(std::move(key), Ref<TextLayout>(textLayout));
+}
+
+void TextLayoutCache::purgeUnused() {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+
+    std::vector<TextLayoutCacheKey> unusedKeys;
+    for (const auto& node : _cache) {
+        if (node->value().use_count() == 1) {
+            unusedKeys.emplace_back(node->key());
+        }
+    }
+
+    for (const auto& key : unusedKeys) {
+        _cache.remove(key);
+    }
+}
+
+void TextLayoutCache::clear() {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _cache.clear();
+}
+
+size_t TextLayoutCache::size() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    return _cache.size();
+}
+
+} // namespace snap::drawing
+
+namespace std {
+
+std::size_t hash<snap::drawing::TextLayoutCacheKey>::operator()(
+    const snap::drawing::TextLayoutCacheKey& k) const noexcept {
+    return k.hash();
+}
+
+} // namespace std
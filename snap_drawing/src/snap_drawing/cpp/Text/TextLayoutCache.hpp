@@ -0,0 +1,88 @@
+#pragma once
+
+#include "snap_drawing/cpp/Text/AttributedText.hpp"
+#include "snap_drawing/cpp/Text/Font.hpp"
+#include "snap_drawing/cpp/Text/TextLayout.hpp"
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+
+#include "valdi_core/cpp/Utils/LRUCache.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+namespace snap::drawing {
+
+/**
+ Identifies a TextLayout from the content of its text and all the parameters it is built with.
+ Attributed texts and fonts are compared by value, so that two layers which were given
+ equal texts from different sources resolve to the same TextLayout.
+ */
+struct TextLayoutCacheKey {
+    Size maxSize;
+    String text;
+    Ref<AttributedText> attributedText;
+    Ref<Font> font;
+    TextAlign textAlign = TextAlignLeft;
+    TextDecoration textDecoration = TextDecorationNone;
+    TextOverflow textOverflow = TextOverflowEllipsis;
+    int numberOfLines = 0;
+    Scalar lineHeightMultiple = 0.0f;
+    Scalar letterSpacing = 0.0f;
+    bool isRightToLeft = false;
+    bool adjustsFontSizeToFitWidth = false;
+    double minimumScaleFactor = 0.0;
+    bool respectDynamicType = false;
+    bool includeTextBlob = false;
+    Scalar displayScale = 0.0f;
+    Scalar dynamicTypeScale = 0.0f;
+
+    TextLayoutCacheKey();
+    ~TextLayoutCacheKey();
+
+    bool operator==(const TextLayoutCacheKey& other) const;
+    bool operator!=(const TextLayoutCacheKey& other) const;
+
+    size_t hash() const;
+};
+
+} // namespace snap::drawing
+
+namespace std {
+
+template<>
+struct hash<snap::drawing::TextLayoutCacheKey> {
+    std::size_t operator()(const snap::drawing::TextLayoutCacheKey& k) const noexcept;
+};
+
+} // namespace std
+
+namespace snap::drawing {
+
+/**
+ A thread safe LRU cache of built TextLayouts, including their text blobs and decorations,
+ shared between the TextLayers of a Resources instance. This allows recycled layers which
+ display the same text with the same parameters to skip layout entirely.
+ */
+class TextLayoutCache : public Valdi::SimpleRefCountable {
+public:
+    explicit TextLayoutCache(size_t capacity);
+    ~TextLayoutCache() override;
+
+    Ref<TextLayout> find(const TextLayoutCacheKey& key);
+    void insert(TextLayoutCacheKey key, const Ref<TextLayout>& textLayout);
+
+    /**
+     Remove the TextLayouts which are only retained by the cache, keeping the ones that
+     layers are currently displaying.
+     */
+    void purgeUnused();
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    mutable Valdi::Mutex _mutex;
+    Valdi::LRUCache<TextLayoutCacheKey, Ref<TextLayout>> _cache;
+};
+
+} // namespace snap::drawing
@@ -6,6 +6,7 @@
 //
 
 #include "snap_drawing/cpp/Text/TextShaper.hpp"
+#include "snap_drawing/cpp/Text/SharedTextShaperCache.hpp"
 #include "snap_drawing/cpp/Text/TextShaperHarfbuzz.hpp"
 #include "snap_drawing/cpp/Text/WordCachingTextShaper.hpp"
 
@@ -15,7 +16,7 @@ Ref<TextShaper> TextShaper::make(bool enableCache) {
     auto strategy = enableCache ? WordCachingTextShaperStrategy::PrioritizeCorrectness :
                                   WordCachingTextShaperStrategy::DisableCache;
     auto harfbuzzShaper = Valdi::makeShared<TextShaperHarfbuzz>();
-    return Valdi::makeShared<WordCachingTextShaper>(harfbuzzShaper, strategy);
+    return Valdi::makeShared<WordCachingTextShaper>(harfbuzzShaper, strategy, SharedTextShaperCache::getGlobal());
 }
 
 } // namespace snap::drawing
@@ -44,7 +44,7 @@ TextShaperCacheKey::TextShaperCacheKey(FontId fontId,
 
 bool TextShaperCacheKey::operator==(const TextShaperCacheKey& other) const {
     if (fontId != other.fontId || letterSpacing != other.letterSpacing ||
-        script != other.script != isRightToLeft != other.isRightToLeft || length != other.length) {
+        script != other.script || isRightToLeft != other.isRightToLeft || length != other.length) {
         return false;
     }
 
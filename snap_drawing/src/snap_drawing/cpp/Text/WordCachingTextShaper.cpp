@@ -6,21 +6,26 @@
 //
 
 #include "snap_drawing/cpp/Text/WordCachingTextShaper.hpp"
-#include "snap_drawing/cpp/Text/CharactersIterator.hpp"
 #include "snap_drawing/cpp/Text/Typeface.hpp"
 
 namespace snap::drawing {
 
-constexpr size_t kWordCacheSize = 1000;
+constexpr size_t kWordCacheSizeInBytes = 256 * 1024;
 constexpr Scalar kUniformFontSize = 12;
 
 WordCachingTextShaper::WordCachingTextShaper(const Ref<TextShaper>& innerShaper, WordCachingTextShaperStrategy strategy)
-    : _innerShaper(innerShaper), _cache(kWordCacheSize), _strategy(strategy) {}
+    : WordCachingTextShaper(
+          innerShaper, strategy, Valdi::makeShared<SharedTextShaperCache>(kWordCacheSizeInBytes)) {}
+
+WordCachingTextShaper::WordCachingTextShaper(const Ref<TextShaper>& innerShaper,
+                                             WordCachingTextShaperStrategy strategy,
+                                             const Ref<SharedTextShaperCache>& cache)
+    : _innerShaper(innerShaper), _cache(cache), _strategy(strategy) {}
+
 WordCachingTextShaper::~WordCachingTextShaper() = default;
 
 void WordCachingTextShaper::clearCache() {
-    std::lock_guard<Valdi::Mutex> lock(_mutex);
-    _cache.clear();
+    _cache->clear();
 }
 
 TextParagraphList WordCachingTextShaper::resolveParagraphs(const Character* unicodeText,
@@ -36,8 +41,6 @@ size_t WordCachingTextShaper::shape(const Character* unicodeText,
                                     Scalar letterSpacing,
                                     TextScript script,
                                     std::vector<ShapedGlyph>& out) {
-    std::lock_guard<Valdi::Mutex> lock(_mutex);
-
     if (font.typeface()->hasSpaceInLigaturesOrKerning()) {
         return _innerShaper->shape(unicodeText, length, font, isRightToLeft, letterSpacing, script, out);
     }
@@ -80,6 +83,32 @@ size_t WordCachingTextShaper::shapeUsingUniformFont(const Character* unicodeText
     return written;
 }
 
+/**
+ Returns the index of the next space character at or after start, or end if there is none.
+ Characters are checked in blocks of 4 with a branchless comparison, which compilers lower
+ to a single vector compare on NEON and SSE targets.
+ */
+static size_t findNextSpace(const Character* characters, size_t start, size_t end) {
+    constexpr Character kSpace = static_cast<Character>(' ');
+    auto i = start;
+
+    while (i + 4 <= end) {
+        auto hasSpace = static_cast<int>(characters[i] == kSpace) | static_cast<int>(characters[i + 1] == kSpace) |
+                        static_cast<int>(characters[i + 2] == kSpace) |
+                        static_cast<int>(characters[i + 3] == kSpace);
+        if (hasSpace != 0) {
+            break;
+        }
+        i += 4;
+    }
+
+    while (i < end && characters[i] != kSpace) {
+        i++;
+    }
+
+    return i;
+}
+
 size_t WordCachingTextShaper::breakdownByWordAndShape(const Character* unicodeText,
                                                       size_t length,
                                                       Font& font,
@@ -93,45 +122,32 @@ size_t WordCachingTextShaper::breakdownByWordAndShape(const Character* unicodeTe
 
     std::optional<ShapedGlyph> spaceGlyph;
 
-    CharactersIterator iterator(unicodeText, length);
-
-    while (!iterator.isAtEnd()) {
-        auto c = iterator.current();
-
-        if (c == static_cast<Character>(' ')) {
-            if (iterator.hasRange()) {
-                shapeWord(&unicodeText[iterator.rangeStart()],
-                          iterator.rangeLength(),
-                          fontId,
-                          font,
-                          isRightToLeft,
-                          letterSpacing,
-                          script,
-                          out);
-            }
-
-            iterator.advance();
-            iterator.resetRange();
-
-            if (!spaceGlyph) {
-                spaceGlyph = {getSpaceGlyphForFont(fontId, font)};
-            }
-
-            out.emplace_back(spaceGlyph.value());
-        } else {
-            iterator.advance();
+    size_t wordStart = 0;
+
+    while (wordStart < length) {
+        auto spaceIndex = findNextSpace(unicodeText, wordStart, length);
+
+        if (spaceIndex > wordStart) {
+            shapeWord(&unicodeText[wordStart],
+                      spaceIndex - wordStart,
+                      fontId,
+                      font,
+                      isRightToLeft,
+                      letterSpacing,
+                      script,
+                      out);
+        }
+
+        if (spaceIndex == length) {
+            break;
+        }
+
+        if (!spaceGlyph) {
+            spaceGlyph = {getSpaceGlyphForFont(fontId, font)};
         }
-    }
 
-    if (iterator.hasRange()) {
-        shapeWord(&unicodeText[iterator.rangeStart()],
-                  iterator.rangeLength(),
-                  fontId,
-                  font,
-                  isRightToLeft,
-                  letterSpacing,
-                  script,
-                  out);
+        out.emplace_back(spaceGlyph.value());
+        wordStart = spaceIndex + 1;
     }
 
     auto outputSize = out.size();
@@ -152,28 +168,26 @@ void WordCachingTextShaper::shapeWord(const Character* unicodeText,
                                       TextScript script,
                                       std::vector<ShapedGlyph>& out) {
     auto cacheKey = TextShaperCacheKey(fontId, letterSpacing, script, isRightToLeft, unicodeText, length);
-    auto cacheResult = _cache.find(cacheKey);
-
-    if (cacheResult) {
-        copyGlyphs(cacheResult.value().glyphs, cacheResult.value().length, out);
+    if (_cache->find(cacheKey, out)) {
         return;
     }
 
+    std::vector<ShapedGlyph> glyphs;
     auto writtenGlyphsLength =
-        _innerShaper->shape(unicodeText, length, font, isRightToLeft, letterSpacing, script, _tmp);
+        _innerShaper->shape(unicodeText, length, font, isRightToLeft, letterSpacing, script, glyphs);
 
-    auto* writtenGlyphs = _tmp.data();
+    auto* writtenGlyphs = glyphs.data();
 
     if (isRightToLeft) {
         std::reverse(writtenGlyphs, writtenGlyphs + writtenGlyphsLength);
     }
 
-    _cache.insert(cacheKey, writtenGlyphs, writtenGlyphsLength);
+    _cache->insert(cacheKey, writtenGlyphs, writtenGlyphsLength);
     copyGlyphs(writtenGlyphs, writtenGlyphsLength, out);
-    _tmp.clear();
 }
 
 Ref<Font> WordCachingTextShaper::getUniformFont(const Ref<Typeface>& typeface) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
     const auto& it = _uniformFonts.find(typeface->getId());
     if (it != _uniformFonts.end()) {
         return it->second;
@@ -199,9 +213,9 @@ ShapedGlyph WordCachingTextShaper::getSpaceGlyphForFont(FontId fontId, Font& fon
     auto text = static_cast<Character>(' ');
     auto cacheKey = TextShaperCacheKey(fontId, 0.0f, TextScript::common(), false, &text, 1);
 
-    auto cacheResult = _cache.find(cacheKey);
-    if (cacheResult && cacheResult.value().length == 1) {
-        return cacheResult.value().glyphs[0];
+    std::vector<ShapedGlyph> cachedGlyphs;
+    if (_cache->find(cacheKey, cachedGlyphs) && cachedGlyphs.size() == 1) {
+        return cachedGlyphs[0];
     }
 
     auto spaceGlyphId = font.getSkValue().unicharToGlyph(static_cast<SkUnichar>(text));
@@ -215,7 +229,7 @@ ShapedGlyph WordCachingTextShaper::getSpaceGlyphForFont(FontId fontId, Font& fon
     glyph.advanceX = width;
     glyph.setCharacter(text, false);
 
-    _cache.insert(cacheKey, &glyph, 1);
+    _cache->insert(cacheKey, &glyph, 1);
 
     return glyph;
 }
@@ -8,7 +8,7 @@
 #pragma once
 
 #include "snap_drawing/cpp/Text/TextShaper.hpp"
-#include "snap_drawing/cpp/Text/TextShaperCache.hpp"
+#include "snap_drawing/cpp/Text/SharedTextShaperCache.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 
 namespace snap::drawing {
@@ -18,10 +18,14 @@ enum class WordCachingTextShaperStrategy { DisableCache, PrioritizeCacheHit, Pri
 /**
  * A TextShaper implementation that breaks down shaping by words and use a cache.
  * The given innerShaper will be used to shape the individual words on a cache miss.
+ * The cache can be shared between multiple shapers, and shaping can happen from any thread.
  */
 class WordCachingTextShaper : public TextShaper {
 public:
     WordCachingTextShaper(const Ref<TextShaper>& innerShaper, WordCachingTextShaperStrategy strategy);
+    WordCachingTextShaper(const Ref<TextShaper>& innerShaper,
+                          WordCachingTextShaperStrategy strategy,
+                          const Ref<SharedTextShaperCache>& cache);
     ~WordCachingTextShaper() override;
 
     void clearCache() override;
@@ -39,10 +43,9 @@ public:
 private:
     Valdi::Mutex _mutex;
     Ref<TextShaper> _innerShaper;
-    TextShaperCache _cache;
+    Ref<SharedTextShaperCache> _cache;
     WordCachingTextShaperStrategy _strategy;
     Valdi::FlatMap<uint32_t, Ref<Font>> _uniformFonts;
-    std::vector<ShapedGlyph> _tmp;
 
     size_t shapeUsingUniformFont(const Character* unicodeText,
                                  size_t length,
@@ -107,19 +107,11 @@ bool TouchDispatcher::captureCandidates(const TouchEvent& event,
         }
     }
 
-    // Dispatch touches to children, starting from the last child.
-    auto i = layer->getChildrenSize();
-    while (i > 0) {
-        i--;
-
-        auto child = layer->getChild(i);
-
-        auto childPoint = child->convertPointFromParent(event.getLocation());
-
-        if (captureCandidates(event.withLocation(childPoint), child, candidateGestureRecognizers)) {
-            // Among siblings, we only capture the first sibling which is hit.
-            break;
-        }
+    // Among siblings, we only capture the last sibling which is hit.
+    auto child = layer->getChildAtPoint(event.getLocation());
+    if (child != nullptr) {
+        captureCandidates(
+            event.withLocation(child->convertPointFromParent(event.getLocation())), child, candidateGestureRecognizers);
     }
 
     return true;
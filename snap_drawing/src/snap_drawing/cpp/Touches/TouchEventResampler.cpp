@@ -0,0 +1,107 @@
+//
+//  TouchEventResampler.cpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "snap_drawing/cpp/Touches/TouchEventResampler.hpp"
+
+#include <algorithm>
+
+namespace snap::drawing {
+
+TouchEventResampler::TouchEventResampler() = default;
+TouchEventResampler::~TouchEventResampler() = default;
+
+void TouchEventResampler::addMovedEvent(const TouchEvent& event) {
+    _previousEvent = std::move(_lastEvent);
+    _lastEvent = {event};
+    _velocityTrackerX.addSample(event.getTime(), event.getLocation().x);
+    _velocityTrackerY.addSample(event.getTime(), event.getLocation().y);
+    _hasPendingEvent = true;
+}
+
+bool TouchEventResampler::hasPendingEvent() const {
+    return _hasPendingEvent;
+}
+
+std::optional<TouchEvent> TouchEventResampler::flush(const TimePoint& frameTime) {
+    if (!_hasPendingEvent) {
+        return std::nullopt;
+    }
+    _hasPendingEvent = false;
+
+    const auto& lastEvent = _lastEvent.value();
+    auto sampleTime = frameTime + Duration(-kResampleLatency.seconds());
+
+    // Pointers are not identified across events, so only single pointer events are resampled
+    auto canResample = lastEvent.getPointerCount() <= 1 && (!_lastFlushedTime || sampleTime > _lastFlushedTime.value());
+
+    auto prediction = std::min(sampleTime - lastEvent.getTime(), kMaxPrediction);
+    if (canResample && sampleTime > lastEvent.getTime() &&
+        (!_lastFlushedTime || lastEvent.getTime() + prediction > _lastFlushedTime.value())) {
+        auto predictionSeconds = static_cast<Scalar>(prediction.seconds());
+        auto offset = Vector::make(_velocityTrackerX.computeVelocity() * predictionSeconds,
+                                   _velocityTrackerY.computeVelocity() * predictionSeconds);
+        auto resampledEvent = makeResampledEvent(lastEvent, lastEvent.getTime() + prediction, offset);
+        _lastFlushedTime = {resampledEvent.getTime()};
+        return {std::move(resampledEvent)};
+    }
+
+    if (canResample && _previousEvent && _previousEvent.value().getPointerCount() == lastEvent.getPointerCount() &&
+        sampleTime > _previousEvent.value().getTime() && sampleTime < lastEvent.getTime()) {
+        const auto& previousEvent = _previousEvent.value();
+        auto alpha = static_cast<Scalar>((sampleTime - previousEvent.getTime()).seconds() /
+                                         (lastEvent.getTime() - previousEvent.getTime()).seconds());
+        auto offset = Vector::make((previousEvent.getLocation().x - lastEvent.getLocation().x) * (1.0f - alpha),
+                                   (previousEvent.getLocation().y - lastEvent.getLocation().y) * (1.0f - alpha));
+        auto resampledEvent = makeResampledEvent(lastEvent, sampleTime, offset);
+        _lastFlushedTime = {resampledEvent.getTime()};
+        return {std::move(resampledEvent)};
+    }
+
+    _lastFlushedTime = {lastEvent.getTime()};
+    return _lastEvent;
+}
+
+std::optional<TouchEvent> TouchEventResampler::flushWithoutResampling() {
+    if (!_hasPendingEvent) {
+        return std::nullopt;
+    }
+    _hasPendingEvent = false;
+    _lastFlushedTime = {_lastEvent.value().getTime()};
+
+    return _lastEvent;
+}
+
+void TouchEventResampler::reset() {
+    _previousEvent = std::nullopt;
+    _lastEvent = std::nullopt;
+    _lastFlushedTime = std::nullopt;
+    _velocityTrackerX.clear();
+    _velocityTrackerY.clear();
+    _hasPendingEvent = false;
+}
+
+TouchEvent TouchEventResampler::makeResampledEvent(const TouchEvent& event,
+                                                   const TimePoint& time,
+                                                   const Vector& offset) const {
+    auto pointerLocations = event.getPointerLocations();
+    for (auto& pointerLocation : pointerLocations) {
+        pointerLocation = pointerLocation.makeOffset(offset.dx, offset.dy);
+    }
+
+    return TouchEvent(TouchEventTypeMoved,
+                      event.getLocationInWindow().makeOffset(offset.dx, offset.dy),
+                      event.getLocation().makeOffset(offset.dx, offset.dy),
+                      event.getDirection(),
+                      event.getPointerCount(),
+                      event.getActionIndex(),
+                      std::move(pointerLocations),
+                      time,
+                      event.getOffsetSinceSource() + (time - event.getTime()),
+                      event.getSource());
+}
+
+} // namespace snap::drawing
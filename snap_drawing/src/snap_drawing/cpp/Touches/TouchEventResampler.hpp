@@ -0,0 +1,79 @@
+//
+//  TouchEventResampler.hpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Touches/TouchEvent.hpp"
+#include "snap_drawing/cpp/Utils/VelocityTracker.hpp"
+
+#include <optional>
+
+namespace snap::drawing {
+
+/**
+ Coalesces the moved touch events received between two frames into a single event,
+ resampled at the frame time. Touch screens can sample faster than the display refreshes,
+ in which case dispatching every sample runs the gesture recognizers several times per frame.
+
+ The location is sampled slightly before the frame time, so that it can usually be interpolated
+ between two received samples. When the last sample is older than that, the location is
+ extrapolated from the velocity of the touch, by a bounded amount of time.
+ */
+class TouchEventResampler {
+public:
+    TouchEventResampler();
+    ~TouchEventResampler();
+
+    /**
+     Add a moved event to coalesce until the next flush.
+     */
+    void addMovedEvent(const TouchEvent& event);
+
+    bool hasPendingEvent() const;
+
+    /**
+     Returns the pending moved events coalesced into one event resampled for the given frame time,
+     or nothing if there is no pending event.
+     */
+    std::optional<TouchEvent> flush(const TimePoint& frameTime);
+
+    /**
+     Returns the last pending moved event as it was received, or nothing if there is no pending event.
+     Used to deliver the last received location before dispatching an event which cannot be coalesced.
+     */
+    std::optional<TouchEvent> flushWithoutResampling();
+
+    /**
+     Forget about the received samples. Should be called whenever the touch sequence or
+     its pointers change.
+     */
+    void reset();
+
+    /**
+     How long before the frame time the location is sampled.
+     */
+    static constexpr Duration kResampleLatency = Duration(0.005);
+
+    /**
+     The maximum amount of time by which the location can be extrapolated.
+     */
+    static constexpr Duration kMaxPrediction = Duration(0.008);
+
+private:
+    // The last two received samples, the most recent one being _lastEvent
+    std::optional<TouchEvent> _previousEvent;
+    std::optional<TouchEvent> _lastEvent;
+    // The time of the last event returned by a flush, resampled events never go back before it
+    std::optional<TimePoint> _lastFlushedTime;
+    VelocityTracker _velocityTrackerX;
+    VelocityTracker _velocityTrackerY;
+    bool _hasPendingEvent = false;
+
+    TouchEvent makeResampledEvent(const TouchEvent& event, const TimePoint& time, const Vector& offset) const;
+};
+
+} // namespace snap::drawing
@@ -8,6 +8,8 @@
 #include "snap_drawing/cpp/Utils/SkCodecAnimatedImage.hpp"
 #include "valdi_core/cpp/Utils/JSONReader.hpp"
 
+#include <cmath>
+
 namespace snap::drawing {
 
 AnimatedImage::AnimatedImage() = default;
@@ -16,15 +18,31 @@ AnimatedImage::~AnimatedImage() = default;
 void AnimatedImage::draw(SkCanvas* canvas,
                          const Rect& drawBounds,
                          const Duration& time,
-                         FittingSizeMode fittingSizeMode) {
-    doDraw(canvas, drawBounds, time, fittingSizeMode);
+                         FittingSizeMode fittingSizeMode,
+                         Scalar rasterScale) {
+    doDraw(canvas, drawBounds, time, fittingSizeMode, rasterScale);
 }
 
 void AnimatedImage::drawInCanvas(const DrawableSurfaceCanvas& canvas,
                                  const Rect& drawBounds,
                                  const Duration& time,
                                  FittingSizeMode fittingSizeMode) {
-    doDraw(canvas.getSkiaCanvas(), drawBounds, time, fittingSizeMode);
+    // Surface canvases are already in pixels
+    doDraw(canvas.getSkiaCanvas(), drawBounds, time, fittingSizeMode, 1.0f);
+}
+
+int AnimatedImage::getFrameIndex(const Duration& time) const {
+    auto frameRate = getFrameRate();
+    if (!std::isfinite(frameRate) || frameRate <= 0) {
+        return -1;
+    }
+    return static_cast<int>(time.seconds() * frameRate);
+}
+
+void AnimatedImage::prepareFrames(const Duration& /*time*/, size_t /*framesCount*/) {}
+
+size_t AnimatedImage::getFrameSizeInBytes() const {
+    return 0;
 }
 
 Valdi::Result<Ref<AnimatedImage>> AnimatedImage::make(const Ref<IFontManager>& fontManager,
@@ -28,10 +28,16 @@ public:
     AnimatedImage();
     ~AnimatedImage() override;
 
+    /**
+     Draw the frame at the given time. rasterScale is the scale from the canvas coordinates
+     to the pixels the canvas will eventually be rasterized into, for images which cache
+     their rendered frames.
+     */
     void draw(SkCanvas* canvas,
               const Rect& drawBounds,
               const Duration& time,
-              FittingSizeMode fittingSizeMode = snap::drawing::FittingSizeModeCenterScaleFit);
+              FittingSizeMode fittingSizeMode = snap::drawing::FittingSizeModeCenterScaleFit,
+              Scalar rasterScale = 1.0f);
     void drawInCanvas(const DrawableSurfaceCanvas& canvas,
                       const Rect& drawBounds,
                       const Duration& time,
@@ -42,6 +48,25 @@ public:
     virtual const Size& getSize() const = 0;
     virtual double getFrameRate() const = 0;
 
+    /**
+     Returns the index of the frame displayed at the given time, so that layers only redraw
+     when it changes, or -1 if the image should be redrawn for every time.
+     */
+    virtual int getFrameIndex(const Duration& time) const;
+
+    /**
+     Prepare up to framesCount frames following the given time, so that drawing them later
+     does not have to decode or render them. Called by the AnimatedImageScheduler from
+     a worker thread.
+     */
+    virtual void prepareFrames(const Duration& time, size_t framesCount);
+
+    /**
+     Returns the memory used by each frame prepared ahead, or 0 if the prepared frames are already
+     accounted for by the image.
+     */
+    virtual size_t getFrameSizeInBytes() const;
+
     static Valdi::Result<Ref<AnimatedImage>> make(const Ref<IFontManager>& fontManager,
                                                   const Valdi::Byte* data,
                                                   size_t length);
@@ -50,7 +75,8 @@ protected:
     virtual void doDraw(SkCanvas* canvas,
                         const Rect& drawBounds,
                         const Duration& time,
-                        FittingSizeMode fittingSizeMode) = 0;
+                        FittingSizeMode fittingSizeMode,
+                        Scalar rasterScale) = 0;
 
 private:
     static bool isJsonObject(const Valdi::Byte* data, size_t length);
@@ -0,0 +1,146 @@
+#include "snap_drawing/cpp/Utils/AnimatedImageScheduler.hpp"
+#include "snap_drawing/cpp/Utils/AnimatedImage.hpp"
+
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
+
+namespace snap::drawing {
+
+constexpr size_t kSharedMaxFramesAheadCount = 4;
+constexpr size_t kSharedMaxSizeInBytes = 32 * 1024 * 1024;
+constexpr int kMaxFrameRateDivisor = 4;
+
+AnimatedImageScheduler::AnimatedImageScheduler(size_t maxFramesAheadCount,
+                                               size_t maxSizeInBytes,
+                                               Duration frameTimeBudgetPerSecond)
+    : _maxWorkersCount(std::max(static_cast<size_t>(1), Valdi::ThreadPool::getShared()->getWorkersCount() / 4)),
+      _maxFramesAheadCount(maxFramesAheadCount),
+      _maxSizeInBytes(maxSizeInBytes),
+      _frameTimeBudgetPerSecond(frameTimeBudgetPerSecond),
+      _windowStartTime(TimePoint::now()) {}
+
+AnimatedImageScheduler::~AnimatedImageScheduler() = default;
+
+void AnimatedImageScheduler::scheduleFramesAhead(const Ref<AnimatedImage>& image, const Duration& time) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    updateWindowIfNeeded(TimePoint::now());
+    _imagesInWindow.insert(image.get());
+
+    auto it = std::find_if(_pendingFrames.begin(), _pendingFrames.end(), [&](const auto& pendingFrames) {
+        return pendingFrames.image == image;
+    });
+    if (it != _pendingFrames.end()) {
+        it->time = time;
+        return;
+    }
+
+    _pendingFrames.emplace_back(PendingFrames{image, time});
+
+    if (_activeWorkersCount < _maxWorkersCount) {
+        _activeWorkersCount++;
+        Valdi::ThreadPool::getShared()->submit([weakThis = Valdi::weakRef(this)]() {
+            if (auto strongThis = weakThis.lock()) {
+                strongThis->runWorker();
+            }
+        });
+    }
+}
+
+void AnimatedImageScheduler::runWorker() {
+    for (;;) {
+        PendingFrames pendingFrames;
+        {
+            std::lock_guard<Valdi::Mutex> lock(_mutex);
+            if (_pendingFrames.empty()) {
+                _activeWorkersCount--;
+                return;
+            }
+            pendingFrames = std::move(_pendingFrames.front());
+            _pendingFrames.pop_front();
+        }
+
+        auto framesAheadCount = getFramesAheadCount(pendingFrames.image->getFrameSizeInBytes());
+        if (framesAheadCount == 0) {
+            continue;
+        }
+
+        auto startTime = TimePoint::now();
+        pendingFrames.image->prepareFrames(pendingFrames.time, framesAheadCount);
+        recordFrameTime(TimePoint::now() - startTime, pendingFrames.image.get());
+    }
+}
+
+void AnimatedImageScheduler::reportFrameTime(const Duration& duration) {
+    recordFrameTime(duration, nullptr);
+}
+
+void AnimatedImageScheduler::recordFrameTime(const Duration& duration, const AnimatedImage* image) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    updateWindowIfNeeded(TimePoint::now());
+    _frameTimeInWindow += duration;
+    if (image != nullptr) {
+        _imagesInWindow.insert(image);
+    }
+}
+
+void AnimatedImageScheduler::updateWindowIfNeeded(const TimePoint& now) {
+    auto elapsed = now - _windowStartTime;
+    if (elapsed < Duration::fromSeconds(1)) {
+        return;
+    }
+
+    // The budget is per second, scale it to the actual length of the window since
+    // windows are only rolled when the scheduler is used.
+    auto budget = Duration::fromSeconds(_frameTimeBudgetPerSecond.seconds() * std::min(elapsed.seconds(), 2.0));
+    auto frameRateDivisor = _frameRateDivisor.load();
+    if (_frameTimeInWindow > budget) {
+        frameRateDivisor = std::min(frameRateDivisor * 2, kMaxFrameRateDivisor);
+    } else if (_frameTimeInWindow.seconds() < budget.seconds() / 2 && frameRateDivisor > 1) {
+        frameRateDivisor /= 2;
+    }
+    _frameRateDivisor = frameRateDivisor;
+
+    _runningAnimationsCount = _imagesInWindow.size();
+    _imagesInWindow.clear();
+    _frameTimeInWindow = Duration();
+    _windowStartTime = now;
+}
+
+bool AnimatedImageScheduler::reserveCachedFramesSize(size_t sizeInBytes) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    // Cached frames can take up to half of the budget, the rest is left for the frames prepared ahead
+    if (_reservedSizeInBytes + sizeInBytes > _maxSizeInBytes / 2) {
+        return false;
+    }
+    _reservedSizeInBytes += sizeInBytes;
+    return true;
+}
+
+void AnimatedImageScheduler::releaseCachedFramesSize(size_t sizeInBytes) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _reservedSizeInBytes -= std::min(sizeInBytes, _reservedSizeInBytes);
+}
+
+int AnimatedImageScheduler::getFrameRateDivisor() const {
+    return _frameRateDivisor;
+}
+
+size_t AnimatedImageScheduler::getFramesAheadCount(size_t frameSizeInBytes) const {
+    if (frameSizeInBytes == 0) {
+        return _maxFramesAheadCount;
+    }
+
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    auto runningAnimationsCount =
+        std::max(std::max(_runningAnimationsCount, _imagesInWindow.size()), static_cast<size_t>(1));
+    auto availableSize = _maxSizeInBytes - _reservedSizeInBytes;
+
+    return std::min(availableSize / (runningAnimationsCount * frameSizeInBytes), _maxFramesAheadCount);
+}
+
+const Ref<AnimatedImageScheduler>& AnimatedImageScheduler::getShared() {
+    static auto kScheduler = Valdi::makeShared<AnimatedImageScheduler>(
+        kSharedMaxFramesAheadCount, kSharedMaxSizeInBytes, Duration::fromMilliseconds(250));
+    return kScheduler;
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Duration.hpp"
+#include "snap_drawing/cpp/Utils/TimePoint.hpp"
+
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <atomic>
+#include <deque>
+#include <unordered_set>
+
+namespace snap::drawing {
+
+class AnimatedImage;
+
+/**
+ Prepares the upcoming frames of the animated images being displayed on a few workers
+ of the shared ThreadPool, so that drawing an animation does not have to decode or render
+ its frames inline. The frames prepared ahead for all the animations are kept within
+ a global memory budget, and the time spent preparing frames within a global time budget
+ per second: when it goes over, animations are asked to lower their frame rate.
+ */
+class AnimatedImageScheduler : public Valdi::SharedPtrRefCountable {
+public:
+    AnimatedImageScheduler(size_t maxFramesAheadCount, size_t maxSizeInBytes, Duration frameTimeBudgetPerSecond);
+    ~AnimatedImageScheduler() override;
+
+    /**
+     Request the frames following the given time to be prepared ahead. Requests for an
+     image which already has a pending request replace it.
+     */
+    void scheduleFramesAhead(const Ref<AnimatedImage>& image, const Duration& time);
+
+    /**
+     Report time spent preparing a frame outside of the scheduler, for instance when a frame
+     which was not prepared ahead had to be decoded while drawing.
+     */
+    void reportFrameTime(const Duration& duration);
+
+    /**
+     Reserve memory for frames that an image keeps rendered for as long as it is displayed, out of
+     the same budget as the frames prepared ahead. Returns false if the budget does not allow it.
+     */
+    bool reserveCachedFramesSize(size_t sizeInBytes);
+    void releaseCachedFramesSize(size_t sizeInBytes);
+
+    /**
+     Returns by how much animations should divide their frame rate, 1 when the frames
+     are prepared within the time budget.
+     */
+    int getFrameRateDivisor() const;
+
+    /**
+     Returns how many frames should be prepared ahead for an animation whose frames use
+     the given size, given the number of animations currently running.
+     */
+    size_t getFramesAheadCount(size_t frameSizeInBytes) const;
+
+    static const Ref<AnimatedImageScheduler>& getShared();
+
+private:
+    struct PendingFrames {
+        Ref<AnimatedImage> image;
+        Duration time;
+    };
+
+    mutable Valdi::Mutex _mutex;
+    std::deque<PendingFrames> _pendingFrames;
+    size_t _activeWorkersCount = 0;
+    size_t _maxWorkersCount;
+    size_t _maxFramesAheadCount;
+    size_t _maxSizeInBytes;
+    size_t _reservedSizeInBytes = 0;
+    Duration _frameTimeBudgetPerSecond;
+
+    TimePoint _windowStartTime;
+    Duration _frameTimeInWindow;
+    std::unordered_set<const AnimatedImage*> _imagesInWindow;
+    size_t _runningAnimationsCount = 0;
+    std::atomic<int> _frameRateDivisor = 1;
+
+    void runWorker();
+    void recordFrameTime(const Duration& duration, const AnimatedImage* image);
+    void updateWindowIfNeeded(const TimePoint& now);
+};
+
+} // namespace snap::drawing
@@ -1,5 +1,5 @@
 #include "snap_drawing/cpp/Utils/BitmapFactory.hpp"
-#include "snap_drawing/cpp/Utils/Bitmap.hpp"
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
 
 namespace snap::drawing {
 
@@ -12,11 +12,7 @@ Valdi::Result<Ref<Valdi::IBitmap>> BitmapFactory::createBitmap(int width, int he
                                   _colorType,
                                   Valdi::AlphaType::AlphaTypePremul,
                                   width * Valdi::BitmapInfo::bytesPerPixelForColorType(_colorType));
-    auto result = Bitmap::make(info);
-    if (!result) {
-        return result.moveError();
-    }
-    return Ref<Valdi::IBitmap>(result.moveValue());
+    return BitmapPool::getShared()->allocateBitmap(info);
 }
 
 const Ref<BitmapFactory>& BitmapFactory::getInstance(Valdi::ColorType colorType) {
@@ -0,0 +1,181 @@
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
+#include "snap_drawing/cpp/Utils/Bitmap.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace snap::drawing {
+
+constexpr size_t kSharedBitmapPoolMaxSizeInBytes = 16 * 1024 * 1024;
+
+class BitmapPoolLease : public Valdi::IBitmap {
+public:
+    BitmapPoolLease(BitmapPool* pool, Ref<Bitmap> bitmap) : _pool(Valdi::weakRef(pool)), _bitmap(std::move(bitmap)) {}
+
+    ~BitmapPoolLease() override {
+        doDispose();
+    }
+
+    void dispose() override {
+        doDispose();
+    }
+
+    Valdi::BitmapInfo getInfo() const override {
+        return _bitmap->getInfo();
+    }
+
+    void* lockBytes() override {
+        return _bitmap->lockBytes();
+    }
+
+    void unlockBytes() override {
+        _bitmap->unlockBytes();
+    }
+
+private:
+    Valdi::Weak<BitmapPool> _pool;
+    Ref<Bitmap> _bitmap;
+
+    void doDispose() {
+        if (_bitmap == nullptr) {
+            return;
+        }
+
+        auto pool = _pool.lock();
+        if (pool != nullptr) {
+            pool->release(std::move(_bitmap));
+        }
+        _bitmap = nullptr;
+    }
+};
+
+bool BitmapPool::Key::operator==(const Key& other) const {
+    return width == other.width && height == other.height && colorType == other.colorType &&
+           alphaType == other.alphaType;
+}
+
+size_t BitmapPool::KeyHash::operator()(const Key& key) const {
+    size_t hash = 0;
+    boost::hash_combine(hash, key.width);
+    boost::hash_combine(hash, key.height);
+    boost::hash_combine(hash, static_cast<size_t>(key.colorType));
+    boost::hash_combine(hash, static_cast<size_t>(key.alphaType));
+    return hash;
+}
+
+BitmapPool::BitmapPool(size_t maxSizeInBytes) : _maxSizeInBytes(maxSizeInBytes) {}
+
+BitmapPool::~BitmapPool() = default;
+
+BitmapPool::Key BitmapPool::makeKey(const Valdi::BitmapInfo& info) {
+    return Key{.width = info.width, .height = info.height, .colorType = info.colorType, .alphaType = info.alphaType};
+}
+
+Valdi::Result<Ref<Valdi::IBitmap>> BitmapPool::allocateBitmap(const Valdi::BitmapInfo& info) {
+    Ref<Bitmap> bitmap;
+
+    {
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        const auto& it = _buckets.find(makeKey(info));
+        if (it != _buckets.end() && !it->second.bitmaps.empty()) {
+            bitmap = std::move(it->second.bitmaps.back());
+            it->second.bitmaps.pop_back();
+            it->second.lastUseSequence = ++_useSequence;
+            _sizeInBytes -= bitmap->getInfo().bytesLength();
+        }
+    }
+
+    if (bitmap == nullptr) {
+        auto result = Bitmap::make(info);
+        if (!result) {
+            return result.moveError();
+        }
+        bitmap = result.moveValue();
+    }
+
+    Ref<Valdi::IBitmap> lease = Valdi::makeShared<BitmapPoolLease>(this, std::move(bitmap));
+    return lease;
+}
+
+void BitmapPool::release(Ref<Bitmap> bitmap) {
+    auto info = bitmap->getInfo();
+    auto size = info.bytesLength();
+
+    std::vector<Ref<Bitmap>> evictedBitmaps;
+    {
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        if (size > _maxSizeInBytes) {
+            return;
+        }
+
+        auto& bucket = _buckets[makeKey(info)];
+        bucket.bitmaps.emplace_back(std::move(bitmap));
+        bucket.lastUseSequence = ++_useSequence;
+        _sizeInBytes += size;
+
+        evictUpToSize(_maxSizeInBytes, evictedBitmaps);
+    }
+
+    // evictedBitmaps are freed outside of the lock
+}
+
+void BitmapPool::evictUpToSize(size_t maxSizeInBytes, std::vector<Ref<Bitmap>>& evictedBitmaps) {
+    while (_sizeInBytes > maxSizeInBytes) {
+        auto leastRecentlyUsed = _buckets.end();
+        for (auto it = _buckets.begin(); it != _buckets.end(); ++it) {
+            if (leastRecentlyUsed == _buckets.end() ||
+                it->second.lastUseSequence < leastRecentlyUsed->second.lastUseSequence) {
+                leastRecentlyUsed = it;
+            }
+        }
+
+        if (leastRecentlyUsed == _buckets.end()) {
+            return;
+        }
+
+        auto& bitmaps = leastRecentlyUsed->second.bitmaps;
+        while (!bitmaps.empty() && _sizeInBytes > maxSizeInBytes) {
+            _sizeInBytes -= bitmaps.back()->getInfo().bytesLength();
+            evictedBitmaps.emplace_back(std::move(bitmaps.back()));
+            bitmaps.pop_back();
+        }
+
+        if (bitmaps.empty()) {
+            _buckets.erase(leastRecentlyUsed);
+        }
+    }
+}
+
+void BitmapPool::trimToSize(size_t maxSizeInBytes) {
+    std::vector<Ref<Bitmap>> evictedBitmaps;
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    evictUpToSize(maxSizeInBytes, evictedBitmaps);
+}
+
+void BitmapPool::clear() {
+    trimToSize(0);
+}
+
+size_t BitmapPool::getSizeInBytes() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    return _sizeInBytes;
+}
+
+size_t BitmapPool::getMaxSizeInBytes() const {
+    return _maxSizeInBytes;
+}
+
+size_t BitmapPool::getPooledBitmapsCount() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    size_t count = 0;
+    for (const auto& it : _buckets) {
+        count += it.second.bitmaps.size();
+    }
+    return count;
+}
+
+const Ref<BitmapPool>& BitmapPool::getShared() {
+    static auto kPool = Valdi::makeShared<BitmapPool>(kSharedBitmapPoolMaxSizeInBytes);
+    return kPool;
+}
+
+} // namespace snap::drawing
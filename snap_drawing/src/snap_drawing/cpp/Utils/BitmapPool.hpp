@@ -0,0 +1,81 @@
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+
+#include "valdi_core/cpp/Interfaces/IBitmap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace snap::drawing {
+
+class Bitmap;
+class BitmapPoolLease;
+
+/**
+ A pool of CPU bitmaps, bucketed by width, height, color type and alpha type.
+ Bitmaps handed out by the pool give their pixels back to it when they are destroyed,
+ so that the next allocation of the same shape skips the allocation and the page faults
+ of touching freshly mapped memory. The pool keeps at most maxSizeInBytes of unused bitmaps,
+ and evicts the buckets which were least recently used first.
+ */
+class BitmapPool : public Valdi::SharedPtrRefCountable {
+public:
+    explicit BitmapPool(size_t maxSizeInBytes);
+    ~BitmapPool() override;
+
+    /**
+     Returns a bitmap matching the given info, with unspecified content. The rowBytes of the info
+     is ignored, bitmaps always use the minimum row bytes.
+     */
+    Valdi::Result<Ref<Valdi::IBitmap>> allocateBitmap(const Valdi::BitmapInfo& info);
+
+    /**
+     Evict unused bitmaps until the pool holds at most the given size.
+     */
+    void trimToSize(size_t maxSizeInBytes);
+    void clear();
+
+    size_t getSizeInBytes() const;
+    size_t getMaxSizeInBytes() const;
+    size_t getPooledBitmapsCount() const;
+
+    static const Ref<BitmapPool>& getShared();
+
+private:
+    struct Key {
+        int width;
+        int height;
+        Valdi::ColorType colorType;
+        Valdi::AlphaType alphaType;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Bucket {
+        std::vector<Ref<Bitmap>> bitmaps;
+        uint64_t lastUseSequence = 0;
+    };
+
+    mutable Valdi::Mutex _mutex;
+    std::unordered_map<Key, Bucket, KeyHash> _buckets;
+    size_t _sizeInBytes = 0;
+    size_t _maxSizeInBytes;
+    uint64_t _useSequence = 0;
+
+    friend BitmapPoolLease;
+
+    void release(Ref<Bitmap> bitmap);
+    void evictUpToSize(size_t maxSizeInBytes, std::vector<Ref<Bitmap>>& evictedBitmaps);
+
+    static Key makeKey(const Valdi::BitmapInfo& info);
+};
+
+} // namespace snap::drawing
@@ -26,10 +26,21 @@ public:
     void insert(const Rect& box);
     bool contains(const Rect& box);
 
+    /**
+     Append into the given output the insertion indexes of the inserted boxes
+     which intersect with the given box. The output is not sorted.
+     */
+    void search(const Rect& box, std::vector<int>& output);
+
+    void clear();
+    size_t size() const;
+
 private:
     std::vector<SkRect> _frames;
     std::vector<int> _rTreeOutput;
     sk_sp<SkBBoxHierarchy> _rTree;
+
+    void buildIfNeeded();
 };
 
 } // namespace snap::drawing
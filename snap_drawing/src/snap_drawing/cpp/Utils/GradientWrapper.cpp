@@ -4,11 +4,11 @@ namespace snap::drawing {
 
 GradientWrapper::GradientWrapper() = default;
 
-void GradientWrapper::update(const Rect& bounds) {
+void GradientWrapper::update(const Rect& bounds, GradientShaderCache* shaderCache) {
     if (_linearGradient != nullptr) {
-        _linearGradient->update(bounds);
+        _linearGradient->update(bounds, shaderCache);
     } else if (_radialGradient != nullptr) {
-        _radialGradient->update(bounds);
+        _radialGradient->update(bounds, shaderCache);
     }
 }
 
@@ -20,11 +20,13 @@ void GradientWrapper::applyToPaint(Paint& paint) const {
     }
 }
 
-void GradientWrapper::draw(DrawingContext& drawingContext, const BorderRadius& borderRadius) {
+void GradientWrapper::draw(DrawingContext& drawingContext,
+                           const BorderRadius& borderRadius,
+                           GradientShaderCache* shaderCache) {
     if (_linearGradient != nullptr) {
-        _linearGradient->draw(drawingContext, borderRadius);
+        _linearGradient->draw(drawingContext, borderRadius, shaderCache);
     } else if (_radialGradient != nullptr) {
-        _radialGradient->draw(drawingContext, borderRadius);
+        _radialGradient->draw(drawingContext, borderRadius, shaderCache);
     }
 }
 
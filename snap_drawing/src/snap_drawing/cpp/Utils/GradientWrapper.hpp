@@ -17,11 +17,11 @@ public:
 
     GradientWrapper();
 
-    void update(const Rect& bounds);
+    void update(const Rect& bounds, GradientShaderCache* shaderCache);
 
     void applyToPaint(Paint& paint) const;
 
-    void draw(DrawingContext& drawingContext, const BorderRadius& borderRadius);
+    void draw(DrawingContext& drawingContext, const BorderRadius& borderRadius, GradientShaderCache* shaderCache);
 
     void setAsLinear(std::vector<Scalar>&& locations,
                      std::vector<Color>&& colors,
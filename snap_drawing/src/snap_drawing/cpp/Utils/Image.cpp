@@ -9,24 +9,52 @@
 #include "snap_drawing/cpp/Utils/BytesUtils.hpp"
 
 #include "snap_drawing/cpp/Utils/Bitmap.hpp"
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
 
 #include "valdi_core/cpp/Interfaces/IBitmap.hpp"
 #include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
 
 #include "snap_drawing/cpp/Utils/BitmapUtils.hpp"
 
+#include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedImageFormat.h"
 #include "include/codec/SkJpegDecoder.h"
 #include "include/codec/SkPngDecoder.h"
 #include "include/codec/SkWebpDecoder.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
+#include "include/effects/SkImageFilters.h"
 #include "include/encode/SkWebpEncoder.h"
 #include "src/image/SkImage_Base.h"
 
+#if __ANDROID__ && __ANDROID_API__ >= 26
+#include "include/android/SkImageAndroid.h"
+#include <android/hardware_buffer.h>
+#endif
+
+#ifdef SNAP_DRAWING_SVG_ENABLED
+#include "modules/svg/include/SkSVGDOM.h"
+#endif
+
+#include <cstring>
+
 namespace snap::drawing {
 
+// The blur radius of filters is expressed like in UIKit, where it is about twice the Skia sigma
+constexpr Scalar kUIKitToSkiaBlurRatio = 2.0f;
+// From https://github.com/servo/skia/blob/master/src/effects/SkBlurMask.cpp#L23
+constexpr Scalar kBlurSigmaScale = 0.57735f;
+
+// How many times a vector Image must be drawn at the same pixel size before a raster of it is kept
+constexpr int kRasterizedPictureHotDrawsCount = 3;
+constexpr size_t kMaxRasterizedPicturesCount = 2;
+constexpr size_t kMaxTrackedPictureSizesCount = 8;
+
 Image::Image(const sk_sp<SkImage>& skImage) : _skImage(skImage) {}
 
 Image::~Image() = default;
@@ -44,6 +72,100 @@ const sk_sp<SkImage>& Image::getSkValue() const {
     return _skImage;
 }
 
+const sk_sp<SkPicture>& Image::getPicture() const {
+    return _picture;
+}
+
+bool Image::isVector() const {
+    return _picture != nullptr;
+}
+
+Ref<Image> Image::getRasterizedIfHot(int pixelWidth, int pixelHeight) {
+    if (_picture == nullptr || pixelWidth <= 0 || pixelHeight <= 0) {
+        return nullptr;
+    }
+
+    auto size = SkISize::Make(pixelWidth, pixelHeight);
+    RasterizedPicture* rasterizedPicture = nullptr;
+
+    {
+        std::lock_guard<Valdi::Mutex> lock(_rasterizedPicturesMutex);
+        auto sequence = ++_rasterizedPicturesSequence;
+        for (auto& it : _rasterizedPictures) {
+            if (it.size == size) {
+                rasterizedPicture = &it;
+                break;
+            }
+        }
+
+        if (rasterizedPicture == nullptr) {
+            if (_rasterizedPictures.size() >= kMaxTrackedPictureSizesCount) {
+                // Forget about the least recently drawn size
+                auto leastRecentlyUsed = std::min_element(
+                    _rasterizedPictures.begin(), _rasterizedPictures.end(), [](const auto& left, const auto& right) {
+                        return left.lastUseSequence < right.lastUseSequence;
+                    });
+                _rasterizedPictures.erase(leastRecentlyUsed);
+            }
+            rasterizedPicture = &_rasterizedPictures.emplace_back();
+            rasterizedPicture->size = size;
+        }
+
+        rasterizedPicture->lastUseSequence = sequence;
+        rasterizedPicture->drawsCount++;
+
+        if (rasterizedPicture->image != nullptr || rasterizedPicture->drawsCount < kRasterizedPictureHotDrawsCount) {
+            return rasterizedPicture->image;
+        }
+    }
+
+    auto imageInfo = SkImageInfo::MakeN32Premul(size);
+    auto cullRect = _picture->cullRect();
+    auto skImage = makePooledRasterImage(imageInfo, [&](const SkPixmap& pixmap) {
+        auto canvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+        if (canvas == nullptr) {
+            return false;
+        }
+        canvas->clear(SK_ColorTRANSPARENT);
+        canvas->scale(static_cast<SkScalar>(pixelWidth) / cullRect.width(),
+                      static_cast<SkScalar>(pixelHeight) / cullRect.height());
+        canvas->translate(-cullRect.left(), -cullRect.top());
+        canvas->drawPicture(_picture);
+        return true;
+    });
+    if (skImage == nullptr) {
+        return nullptr;
+    }
+
+    auto image = Valdi::makeShared<Image>(skImage);
+
+    std::lock_guard<Valdi::Mutex> lock(_rasterizedPicturesMutex);
+    RasterizedPicture* leastRecentlyUsed = nullptr;
+    size_t rasterizedCount = 0;
+    rasterizedPicture = nullptr;
+    for (auto& it : _rasterizedPictures) {
+        if (it.size == size) {
+            rasterizedPicture = &it;
+        } else if (it.image != nullptr) {
+            rasterizedCount++;
+            if (leastRecentlyUsed == nullptr || it.lastUseSequence < leastRecentlyUsed->lastUseSequence) {
+                leastRecentlyUsed = &it;
+            }
+        }
+    }
+
+    // The size might have been forgotten while rasterizing, the raster is then only used for this draw
+    if (rasterizedPicture != nullptr) {
+        if (rasterizedCount >= kMaxRasterizedPicturesCount) {
+            leastRecentlyUsed->image = nullptr;
+            leastRecentlyUsed->drawsCount = 0;
+        }
+        rasterizedPicture->image = image;
+    }
+
+    return image;
+}
+
 int Image::width() const {
     return _skImage->width();
 }
@@ -123,10 +245,49 @@ Valdi::Result<Valdi::BytesView> Image::encode(EncodedImageFormat format, double
     return bytesFromSkData(encoded);
 }
 
+sk_sp<SkImage> Image::makePooledRasterImage(const SkImageInfo& imageInfo,
+                                            const Valdi::Function<bool(const SkPixmap&)>& fillPixels) {
+    auto bitmapInfo = toBitmapInfo(imageInfo);
+    if (bitmapInfo.colorType == Valdi::ColorTypeUnknown) {
+        return nullptr;
+    }
+
+    auto bitmap = BitmapPool::getShared()->allocateBitmap(bitmapInfo);
+    if (!bitmap) {
+        return nullptr;
+    }
+
+    auto data = bitmapToData(bitmap.value(), bitmapInfo, false);
+    if (!data) {
+        return nullptr;
+    }
+
+    SkPixmap pixmap(imageInfo, data.value()->data(), bitmapInfo.rowBytes);
+    if (!fillPixels(pixmap)) {
+        return nullptr;
+    }
+
+    return SkImages::RasterFromData(imageInfo, data.value(), bitmapInfo.rowBytes);
+}
+
 Ref<Image> Image::resized(int width, int height) const {
-    SkBitmap bitmap;
+    if (_picture != nullptr) {
+        // Vector images are resized by drawing their picture at a different scale
+        auto result = makeFromPicture(_picture, width, height);
+        return result ? result.value() : nullptr;
+    }
 
     SkImageInfo imageInfo = SkImageInfo::Make(width, height, _skImage->colorType(), _skImage->alphaType());
+
+    auto pooledImage = makePooledRasterImage(imageInfo, [&](const SkPixmap& pixmap) {
+        _skImage->scalePixels(pixmap, SkSamplingOptions(SkCubicResampler::Mitchell()));
+        return true;
+    });
+    if (pooledImage != nullptr) {
+        return Ref<Image>(Valdi::makeShared<Image>(pooledImage));
+    }
+
+    SkBitmap bitmap;
     bitmap.allocPixels(imageInfo, imageInfo.minRowBytes());
 
     _skImage->scalePixels(bitmap.pixmap(), SkSamplingOptions(SkCubicResampler::Mitchell()));
@@ -142,9 +303,25 @@ void Image::draw(const Valdi::BitmapInfo& bitmapInfo, void* bytes) {
     _skImage->scalePixels(pixmap, SkSamplingOptions(SkCubicResampler::Mitchell()));
 }
 
-Ref<Image> Image::withFilter(const Ref<Valdi::ImageFilter>& filter) {
+static sk_sp<SkColorFilter> makeColorFilter(const Valdi::ImageFilter& filter) {
+    if (filter.isIdentityColorMatrix()) {
+        return nullptr;
+    }
+    return SkColorFilters::Matrix(filter.getColorMatrix());
+}
+
+static Scalar blurRadiusToSigma(Scalar radius) {
+    return radius > 0 ? kBlurSigmaScale * radius + 0.5f : 0.0f;
+}
+
+Ref<Image> Image::withFilter(const Ref<Valdi::ImageFilter>& filter, const Ref<Image>& filteredImage) {
     auto copiedImage = Valdi::makeShared<Image>(_skImage);
     copiedImage->_filter = filter;
+    copiedImage->_filteredImage = filteredImage;
+    // Built once here rather than on every draw
+    copiedImage->_filterColorFilter = filter != nullptr ? makeColorFilter(*filter) : nullptr;
+    copiedImage->_picture = _picture;
+    copiedImage->_downsampleScale = _downsampleScale;
     copiedImage->_sourceImage = Valdi::strongSmallRef(this);
     return copiedImage;
 }
@@ -153,7 +330,67 @@ const Ref<Valdi::ImageFilter>& Image::getFilter() const {
     return _filter;
 }
 
+const Ref<Image>& Image::getFilteredImage() const {
+    return _filteredImage;
+}
+
+const sk_sp<SkColorFilter>& Image::getFilterColorFilter() const {
+    return _filterColorFilter;
+}
+
+Scalar Image::getFilterBlurSigma() const {
+    if (_filter == nullptr) {
+        return 0.0f;
+    }
+    return blurRadiusToSigma(_filter->getBlurRadius()) * kUIKitToSkiaBlurRatio;
+}
+
+Ref<Image> Image::makeFiltered(const Valdi::ImageFilter& filter) const {
+    if (_picture != nullptr) {
+        return nullptr;
+    }
+
+    SkPaint paint;
+    paint.setColorFilter(makeColorFilter(filter));
+    auto blurSigma = blurRadiusToSigma(filter.getBlurRadius()) * kUIKitToSkiaBlurRatio;
+    if (blurSigma != 0.0f) {
+        paint.setImageFilter(SkImageFilters::Blur(blurSigma, blurSigma, SkTileMode::kClamp, nullptr));
+    }
+
+    auto imageInfo = SkImageInfo::MakeN32Premul(_skImage->width(), _skImage->height());
+    auto skImage = makePooledRasterImage(imageInfo, [&](const SkPixmap& pixmap) {
+        auto canvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+        if (canvas == nullptr) {
+            return false;
+        }
+        canvas->clear(SK_ColorTRANSPARENT);
+        canvas->drawImage(_skImage, 0, 0, SkSamplingOptions(), &paint);
+        return true;
+    });
+    if (skImage == nullptr) {
+        return nullptr;
+    }
+
+    return Ref<Image>(Valdi::makeShared<Image>(skImage));
+}
+
+bool Image::isDownsampled() const {
+    return _downsampleScale > 1.0f;
+}
+
+float Image::getDownsampleScale() const {
+    return _downsampleScale;
+}
+
+void Image::setDownsampleScale(float downsampleScale) {
+    _downsampleScale = downsampleScale;
+}
+
 Valdi::Result<Ref<Image>> Image::make(const Valdi::BytesView& data) {
+    if (isSVG(data)) {
+        return makeFromSVG(data, 0, 0);
+    }
+
     Image::initializeCodecs();
     auto skData = skDataFromBytes(data, DataConversionModeNeverCopy);
 
@@ -166,6 +403,157 @@ Valdi::Result<Ref<Image>> Image::make(const Valdi::BytesView& data) {
     return Ref<Image>(Valdi::makeShared<Image>(skImage));
 }
 
+static bool coversTarget(const SkISize& dimensions, int targetWidth, int targetHeight) {
+    if (targetWidth >= targetHeight) {
+        return dimensions.width() >= targetWidth;
+    } else {
+        return dimensions.height() >= targetHeight;
+    }
+}
+
+static sk_sp<SkImage> decodeDownsampled(const sk_sp<SkData>& skData,
+                                        int targetWidth,
+                                        int targetHeight,
+                                        float& outDownsampleScale) {
+    auto codec = SkCodec::MakeFromData(skData);
+    if (codec == nullptr || codec->getFrameCount() > 1 || codec->getOrigin() != kTopLeft_SkEncodedOrigin) {
+        return nullptr;
+    }
+
+    auto dimensions = codec->dimensions();
+    auto targetSize = targetWidth >= targetHeight ? targetWidth : targetHeight;
+    auto sourceSize = targetWidth >= targetHeight ? dimensions.width() : dimensions.height();
+    if (targetSize <= 0 || targetSize >= sourceSize) {
+        return nullptr;
+    }
+
+    auto scaledDimensions =
+        codec->getScaledDimensions(static_cast<float>(targetSize) / static_cast<float>(sourceSize));
+    if (scaledDimensions == dimensions || scaledDimensions.isEmpty() ||
+        !coversTarget(scaledDimensions, targetWidth, targetHeight)) {
+        return nullptr;
+    }
+
+    auto imageInfo = codec->getInfo().makeDimensions(scaledDimensions).makeColorType(kN32_SkColorType);
+    if (imageInfo.alphaType() == kUnpremul_SkAlphaType) {
+        imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
+    }
+
+    auto skImage = makePooledRasterImage(imageInfo, [&](const SkPixmap& pixmap) {
+        // Incomplete inputs have their missing rows filled by the codec
+        auto result = codec->getPixels(pixmap);
+        return result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput;
+    });
+    if (skImage == nullptr) {
+        return nullptr;
+    }
+
+    auto scaledSize = targetWidth >= targetHeight ? scaledDimensions.width() : scaledDimensions.height();
+    outDownsampleScale = static_cast<float>(sourceSize) / static_cast<float>(scaledSize);
+    return skImage;
+}
+
+Valdi::Result<Ref<Image>> Image::make(const Valdi::BytesView& data, int targetWidth, int targetHeight) {
+    if (targetWidth <= 0 && targetHeight <= 0) {
+        return make(data);
+    }
+
+    if (isSVG(data)) {
+        return makeFromSVG(data, targetWidth, targetHeight);
+    }
+
+    Image::initializeCodecs();
+    auto skData = skDataFromBytes(data, DataConversionModeNeverCopy);
+
+    float downsampleScale = 1.0f;
+    auto skImage = decodeDownsampled(skData, targetWidth, targetHeight, downsampleScale);
+    if (skImage == nullptr) {
+        return make(data);
+    }
+
+    auto image = Valdi::makeShared<Image>(skImage);
+    image->_downsampleScale = downsampleScale;
+    return Ref<Image>(image);
+}
+
+Valdi::Result<Ref<Image>> Image::makeFromPicture(const sk_sp<SkPicture>& picture, int width, int height) {
+    auto cullRect = picture->cullRect();
+    if (width <= 0 || height <= 0 || cullRect.isEmpty()) {
+        return Valdi::Error("Cannot make an empty vector image");
+    }
+
+    auto matrix = SkMatrix::RectToRect(cullRect, SkRect::MakeIWH(width, height));
+    auto skImage = SkImages::DeferredFromPicture(
+        picture, SkISize::Make(width, height), &matrix, nullptr, SkImages::BitDepth::kU8, SkColorSpace::MakeSRGB());
+    if (skImage == nullptr) {
+        return Valdi::Error("Unable to create vector image");
+    }
+
+    auto image = Valdi::makeShared<Image>(skImage);
+    image->_picture = picture;
+    return Ref<Image>(image);
+}
+
+bool Image::isSVG(const Valdi::BytesView& data) {
+    constexpr size_t kMaxPrologLength = 1024;
+    std::string_view content(reinterpret_cast<const char*>(data.data()), std::min(data.size(), kMaxPrologLength));
+    auto start = content.find_first_not_of(" \t\r\n\xEF\xBB\xBF");
+    if (start == std::string_view::npos) {
+        return false;
+    }
+
+    content = content.substr(start);
+    if (content.substr(0, 4) == "<svg") {
+        return true;
+    }
+
+    // An XML prolog, a doctype or comments can precede the svg element
+    return (content.substr(0, 2) == "<?" || content.substr(0, 2) == "<!") &&
+           content.find("<svg") != std::string_view::npos;
+}
+
+#ifdef SNAP_DRAWING_SVG_ENABLED
+
+Valdi::Result<Ref<Image>> Image::makeFromSVG(const Valdi::BytesView& data, int targetWidth, int targetHeight) {
+    SkMemoryStream stream(data.data(), data.size(), /* copyData */ false);
+    auto dom = SkSVGDOM::MakeFromStream(stream);
+    if (dom == nullptr) {
+        return Valdi::Error("Unable to parse SVG");
+    }
+
+    auto containerSize = dom->containerSize();
+    if (containerSize.isEmpty()) {
+        // Documents without an intrinsic size take the size they are requested at
+        containerSize = SkSize::Make(static_cast<SkScalar>(targetWidth), static_cast<SkScalar>(targetHeight));
+        if (containerSize.isEmpty()) {
+            return Valdi::Error("SVG has no intrinsic size");
+        }
+        dom->setContainerSize(containerSize);
+    }
+
+    // The DOM is only used to record a picture once, which is then replayed at any scale
+    SkPictureRecorder recorder;
+    dom->render(recorder.beginRecording(SkRect::MakeSize(containerSize)));
+    auto picture = recorder.finishRecordingAsPicture();
+    if (picture == nullptr) {
+        return Valdi::Error("Unable to record SVG");
+    }
+
+    return makeFromPicture(picture,
+                           static_cast<int>(std::ceil(containerSize.width())),
+                           static_cast<int>(std::ceil(containerSize.height())));
+}
+
+#else
+
+Valdi::Result<Ref<Image>> Image::makeFromSVG(const Valdi::BytesView& /*data*/,
+                                             int /*targetWidth*/,
+                                             int /*targetHeight*/) {
+    return Valdi::Error("SVG was not enabled in the build");
+}
+
+#endif
+
 Valdi::Result<Ref<Image>> Image::makeFromPixelsData(const Valdi::BitmapInfo& bitmapInfo,
                                                     const Valdi::BytesView& pixelsData,
                                                     bool shouldCopy) {
@@ -190,6 +578,18 @@ Valdi::Result<Ref<Image>> Image::makeFromPixelsData(const Valdi::BitmapInfo& bit
 Valdi::Result<Ref<Image>> Image::makeFromBitmap(const Valdi::Ref<Valdi::IBitmap>& bitmap, bool shouldCopy) {
     auto info = bitmap->getInfo();
 
+#if __ANDROID__ && __ANDROID_API__ >= 26
+    auto* hardwareBuffer = static_cast<AHardwareBuffer*>(bitmap->getHardwareBuffer());
+    if (hardwareBuffer != nullptr) {
+        // The pixels stay in GPU memory, the buffer is imported as a texture when the image is drawn
+        auto skImage = SkImages::DeferredFromAHardwareBuffer(hardwareBuffer, toSkiaImageInfo(info).alphaType());
+        if (skImage == nullptr) {
+            return Valdi::Error("Unable to create image from hardware buffer");
+        }
+        return Ref<Image>(Valdi::makeShared<Image>(skImage));
+    }
+#endif
+
     auto data = bitmapToData(bitmap, info, shouldCopy);
     if (!data) {
         return data.moveError();
@@ -11,12 +11,19 @@
 #include "valdi_core/cpp/Interfaces/IBitmap.hpp"
 #include "valdi_core/cpp/Resources/LoadedAsset.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/ValdiObject.hpp"
 
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Scalar.hpp"
 
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkPicture.h"
+
+#include <vector>
 
 namespace snap::drawing {
 
@@ -47,11 +54,31 @@ public:
     void draw(const Valdi::BitmapInfo& bitmapInfo, void* bytes);
 
     /**
-     Returns a new Image which will be displayed with the given filter when drawn
+     Returns a new Image which will be displayed with the given filter when drawn.
+     The filtered image, when given, holds the result of applying the filter to this Image
+     and is drawn as is, instead of applying the filter on every draw.
      */
-    Ref<Image> withFilter(const Ref<Valdi::ImageFilter>& filter);
+    Ref<Image> withFilter(const Ref<Valdi::ImageFilter>& filter, const Ref<Image>& filteredImage = nullptr);
 
     const Ref<Valdi::ImageFilter>& getFilter() const;
+    const Ref<Image>& getFilteredImage() const;
+
+    /**
+     The Skia color filter applying the color matrix of the filter of this Image,
+     nullptr if the Image has no filter or if its color matrix is the identity.
+     */
+    const sk_sp<SkColorFilter>& getFilterColorFilter() const;
+
+    /**
+     The sigma of the blur of the filter of this Image, in pixels of the Image.
+     */
+    Scalar getFilterBlurSigma() const;
+
+    /**
+     Returns a raster Image of the same size, with the given filter applied to its pixels.
+     Returns nullptr for vector images, whose filter is applied at the scale they are drawn at.
+     */
+    Ref<Image> makeFiltered(const Valdi::ImageFilter& filter) const;
 
     Valdi::Result<Valdi::BytesView> toPNG() const;
 
@@ -59,13 +86,49 @@ public:
 
     const sk_sp<SkImage>& getSkValue() const;
 
+    /**
+     The vector content of the Image when it was made from an SVG, nullptr for raster images.
+     Vector images can be drawn at any scale through their picture. Their SkImage rasterizes
+     the picture lazily at the size of the Image, for the code paths which need pixels.
+     */
+    const sk_sp<SkPicture>& getPicture() const;
+    bool isVector() const;
+
+    /**
+     Returns a raster of this vector Image at the given pixel size once that size was drawn often
+     enough to be worth keeping, or nullptr, in which case the picture should be drawn instead.
+     Only the few most recently hot sizes are kept.
+     */
+    Ref<Image> getRasterizedIfHot(int pixelWidth, int pixelHeight);
+
     Valdi::Ref<Valdi::IBitmap> getBitmap();
 
+    /**
+     Whether this Image was decoded at a lower resolution than its source.
+     */
+    bool isDownsampled() const;
+
+    /**
+     Ratio between the size of the source of this Image and its decoded size, 1 when decoded at full resolution.
+     */
+    float getDownsampleScale() const;
+    void setDownsampleScale(float downsampleScale);
+
     /**
      Make an Image from bytes representing an encoded image, like in PNG or JPG format.
+     SVG documents are parsed once into a vector Image, when SVG support is enabled in the build.
      */
     static Valdi::Result<Ref<Image>> make(const Valdi::BytesView& data);
 
+    /**
+     Make an Image from bytes representing an encoded image, decoding it directly at a reduced
+     size when the codec supports it (JPEG DCT scaling, WebP scaled decoding). The decoded image
+     is the smallest supported size that still covers the target width when targetWidth >= targetHeight,
+     or the target height otherwise. Falls back to a full resolution deferred decode when the codec
+     cannot downscale, or when the image is animated or has a non default EXIF orientation.
+     */
+    static Valdi::Result<Ref<Image>> make(const Valdi::BytesView& data, int targetWidth, int targetHeight);
+
     /**
      Make an Image with the raw pixels data in the format specified in the BitmapInfo.
      If shouldCopy is false, the returned Image will use the bytes from the attached BytesView
@@ -80,17 +143,49 @@ public:
      Make an Image with the raw pixels data provided from the given Bitmap.
      If shouldCopy is false, the returned Image will retain the Bitmap and use its underlying
      buffer directly. Otherwise, the bytes will be copied.
+     Bitmaps backed by a hardware buffer are always wrapped without copying.
      */
     static Valdi::Result<Ref<Image>> makeFromBitmap(const Valdi::Ref<Valdi::IBitmap>& bitmap, bool shouldCopy);
 
+    /**
+     Make a vector Image of the given size, drawing the given picture scaled from its cull rect.
+     */
+    static Valdi::Result<Ref<Image>> makeFromPicture(const sk_sp<SkPicture>& picture, int width, int height);
+
     static sk_sp<SkData> encodeSKImageToSKData(SkImage& image, EncodedImageFormat format, int quality);
 
+    /**
+     Creates a raster image whose pixels are taken from the shared BitmapPool, and given back to it
+     once the image is destroyed. fillPixels is expected to write every pixel of the given pixmap,
+     as pooled pixels are not zeroed. Returns nullptr if the pixels could not be allocated or filled.
+     */
+    static sk_sp<SkImage> makePooledRasterImage(const SkImageInfo& imageInfo,
+                                                const Valdi::Function<bool(const SkPixmap&)>& fillPixels);
+
     VALDI_CLASS_HEADER(Image)
 
 private:
     sk_sp<SkImage> _skImage;
     Ref<Image> _sourceImage;
     Ref<Valdi::ImageFilter> _filter;
+    Ref<Image> _filteredImage;
+    sk_sp<SkColorFilter> _filterColorFilter;
+    float _downsampleScale = 1.0f;
+    sk_sp<SkPicture> _picture;
+
+    struct RasterizedPicture {
+        SkISize size;
+        int drawsCount = 0;
+        uint64_t lastUseSequence = 0;
+        Ref<Image> image;
+    };
+
+    Valdi::Mutex _rasterizedPicturesMutex;
+    std::vector<RasterizedPicture> _rasterizedPictures;
+    uint64_t _rasterizedPicturesSequence = 0;
+
+    static bool isSVG(const Valdi::BytesView& data);
+    static Valdi::Result<Ref<Image>> makeFromSVG(const Valdi::BytesView& data, int targetWidth, int targetHeight);
 
     static Valdi::Result<Ref<Image>> makeFromPixelsData(const Valdi::BitmapInfo& bitmapInfo,
                                                         const sk_sp<SkData>& pixelsData);
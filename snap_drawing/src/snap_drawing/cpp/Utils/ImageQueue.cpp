@@ -6,7 +6,7 @@
 //
 
 #include "snap_drawing/cpp/Utils/ImageQueue.hpp"
-#include "snap_drawing/cpp/Utils/Bitmap.hpp"
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
 
 namespace snap::drawing {
 
@@ -109,9 +109,10 @@ Valdi::Result<Ref<Valdi::IBitmap>> ImageQueue::allocateBitmap(int width, int hei
         }
     }
 
-    // Cache is empty, allocating the bitmap
+    // Cache is empty, allocating the bitmap from the shared pool, which gets it back
+    // once this queue drops it
 
-    auto bitmap = Bitmap::make(bitmapInfo);
+    auto bitmap = BitmapPool::getShared()->allocateBitmap(bitmapInfo);
     if (!bitmap) {
         return bitmap.moveError();
     }
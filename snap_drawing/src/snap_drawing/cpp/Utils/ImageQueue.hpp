@@ -58,7 +58,7 @@ public:
     size_t getPoolSize() const;
 
 private:
-    mutable Valdi::Mutex _mutex;
+    mutable Valdi::Mutex _mutex{"ImageQueue"};
     std::deque<Ref<Image>> _queue;
     std::vector<Ref<Valdi::IBitmap>> _cachedBitmaps;
     std::optional<Valdi::BitmapInfo> _cacheBitmapInfo;
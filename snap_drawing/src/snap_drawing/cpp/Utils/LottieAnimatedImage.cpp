@@ -10,6 +10,13 @@
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurfaceCanvas.hpp"
 #include "snap_drawing/cpp/Resources.hpp"
 #include "snap_drawing/cpp/Utils/AnimatedImage.hpp"
+#include "snap_drawing/cpp/Utils/AnimatedImageScheduler.hpp"
+#include "snap_drawing/cpp/Utils/Image.hpp"
+#include "snap_drawing/cpp/Utils/TimePoint.hpp"
+
+#include "include/core/SkPixmap.h"
+
+#include <cstring>
 
 namespace skresources {
 class DelegatedTypefaceResourceProvider : public ResourceProvider {
@@ -40,7 +47,11 @@ sk_sp<SkTypeface> DelegatedTypefaceResourceProvider::loadTypeface(const char* na
 
 namespace snap::drawing {
 
-LottieAnimatedImage::~LottieAnimatedImage() = default;
+constexpr int kMaxCachedFramesCount = 90;
+
+LottieAnimatedImage::~LottieAnimatedImage() {
+    clearFramesCache();
+}
 
 const Duration& LottieAnimatedImage::getDuration() const {
     return _duration;
@@ -59,6 +70,45 @@ double LottieAnimatedImage::getFrameRate() const {
     return _frameRate;
 }
 
+int LottieAnimatedImage::getFramesCount() const {
+    return static_cast<int>(std::ceil(_duration.seconds() * _frameRate));
+}
+
+int LottieAnimatedImage::getFrameIndex(const Duration& time) const {
+    auto framesCount = getFramesCount();
+    if (framesCount <= 0) {
+        return -1;
+    }
+    auto frameIndex = std::clamp(static_cast<int>(time.seconds() * _frameRate), 0, framesCount - 1);
+
+    std::lock_guard<Valdi::Mutex> lock(_distinctFrameIndexesMutex);
+    if (static_cast<size_t>(frameIndex) < _distinctFrameIndexes.size()) {
+        return _distinctFrameIndexes[frameIndex];
+    }
+    return frameIndex;
+}
+
+void LottieAnimatedImage::setShouldCacheFrames(bool shouldCacheFrames) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _shouldCacheFrames = shouldCacheFrames;
+    if (!shouldCacheFrames) {
+        clearFramesCache();
+        _cachedFramesPixelSize = SkISize::MakeEmpty();
+    }
+}
+
+void LottieAnimatedImage::clearFramesCache() {
+    _cachedFrames.clear();
+    {
+        std::lock_guard<Valdi::Mutex> lock(_distinctFrameIndexesMutex);
+        _distinctFrameIndexes.clear();
+    }
+    if (_cachedFramesReservedSize > 0) {
+        AnimatedImageScheduler::getShared()->releaseCachedFramesSize(_cachedFramesReservedSize);
+        _cachedFramesReservedSize = 0;
+    }
+}
+
 Valdi::Result<Ref<LottieAnimatedImage>> LottieAnimatedImage::make(const Ref<Resources>& resources,
                                                                   const Valdi::Byte* data,
                                                                   size_t length) {
@@ -73,14 +123,7 @@ LottieAnimatedImage::LottieAnimatedImage(const sk_sp<skottie::Animation>& animat
       _size(Size(animation->size().width(), animation->size().height())),
       _frameRate(animation->fps()) {}
 
-void LottieAnimatedImage::doDraw(SkCanvas* canvas,
-                                 const Rect& drawBounds,
-                                 const Duration& time,
-                                 FittingSizeMode fittingSizeMode) {
-    std::lock_guard<Valdi::Mutex> lock(_mutex);
-    _currentTime = std::clamp(time, Duration(), _duration);
-    _animation->seekFrameTime(_currentTime.seconds());
-
+void LottieAnimatedImage::render(SkCanvas* canvas, const Rect& drawBounds, FittingSizeMode fittingSizeMode) {
     // If fittingSizeMode is fill need to apply transform since
     // Skottie does not render with 'fill' mode by default
     if (fittingSizeMode == FittingSizeModeFill) {
@@ -96,6 +139,168 @@ void LottieAnimatedImage::doDraw(SkCanvas* canvas,
     }
 }
 
+bool LottieAnimatedImage::prepareFramesCache(const Rect& drawBounds,
+                                             FittingSizeMode fittingSizeMode,
+                                             Scalar pixelScale) {
+    // Fill renders from the origin of the canvas
+    auto framesRect = fittingSizeMode == FittingSizeModeFill
+                          ? Rect::makeXYWH(0, 0, drawBounds.width(), drawBounds.height())
+                          : drawBounds;
+    auto pixelSize = SkISize::Make(static_cast<int>(std::ceil(framesRect.width() * pixelScale)),
+                                   static_cast<int>(std::ceil(framesRect.height() * pixelScale)));
+
+    if (pixelSize == _cachedFramesPixelSize && drawBounds == _cachedFramesDrawBounds &&
+        fittingSizeMode == _cachedFramesFittingSizeMode) {
+        return _cachedFramesReservedSize > 0;
+    }
+
+    clearFramesCache();
+    _cachedFramesDrawBounds = drawBounds;
+    _cachedFramesRect = framesRect;
+    _cachedFramesPixelSize = pixelSize;
+    _cachedFramesFittingSizeMode = fittingSizeMode;
+
+    auto framesCount = getFramesCount();
+    if (!_shouldCacheFrames || framesCount <= 0 || framesCount > kMaxCachedFramesCount || pixelSize.isEmpty()) {
+        return false;
+    }
+
+    auto reservedSize =
+        SkImageInfo::MakeN32Premul(pixelSize).computeMinByteSize() * static_cast<size_t>(framesCount);
+    if (!AnimatedImageScheduler::getShared()->reserveCachedFramesSize(reservedSize)) {
+        return false;
+    }
+
+    _cachedFramesReservedSize = reservedSize;
+
+    std::lock_guard<Valdi::Mutex> lock(_distinctFrameIndexesMutex);
+    _distinctFrameIndexes.resize(static_cast<size_t>(framesCount));
+    for (int i = 0; i < framesCount; i++) {
+        _distinctFrameIndexes[i] = i;
+    }
+
+    return true;
+}
+
+static bool hasSamePixels(const sk_sp<SkImage>& left, const sk_sp<SkImage>& right) {
+    SkPixmap leftPixmap;
+    SkPixmap rightPixmap;
+    if (!left->peekPixels(&leftPixmap) || !right->peekPixels(&rightPixmap) ||
+        leftPixmap.info() != rightPixmap.info()) {
+        return false;
+    }
+
+    auto rowLength = leftPixmap.info().minRowBytes();
+    for (int y = 0; y < leftPixmap.height(); y++) {
+        if (std::memcmp(leftPixmap.addr(0, y), rightPixmap.addr(0, y), rowLength) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LottieAnimatedImage::mergeIdenticalNeighbors(int frameIndex) {
+    auto& frame = _cachedFrames[frameIndex];
+
+    // Identical frames share the same image, and report the same index for the whole span
+    const auto& previous = _cachedFrames.find(frameIndex - 1);
+    if (previous != _cachedFrames.end() && hasSamePixels(previous->second, frame)) {
+        frame = previous->second;
+        std::lock_guard<Valdi::Mutex> lock(_distinctFrameIndexesMutex);
+        _distinctFrameIndexes[frameIndex] = _distinctFrameIndexes[frameIndex - 1];
+    }
+
+    const auto& next = _cachedFrames.find(frameIndex + 1);
+    if (next != _cachedFrames.end() && hasSamePixels(frame, next->second)) {
+        std::lock_guard<Valdi::Mutex> lock(_distinctFrameIndexesMutex);
+        auto spanIndex = _distinctFrameIndexes[frameIndex + 1];
+        for (auto i = static_cast<size_t>(frameIndex + 1);
+             i < _distinctFrameIndexes.size() && _distinctFrameIndexes[i] == spanIndex;
+             i++) {
+            _distinctFrameIndexes[i] = _distinctFrameIndexes[frameIndex];
+            _cachedFrames[static_cast<int>(i)] = frame;
+        }
+    }
+}
+
+sk_sp<SkImage> LottieAnimatedImage::getOrRenderCachedFrame(int frameIndex) {
+    const auto& it = _cachedFrames.find(frameIndex);
+    if (it != _cachedFrames.end()) {
+        return it->second;
+    }
+
+    _animation->seekFrameTime(static_cast<double>(frameIndex) / _frameRate);
+
+    auto frame = Image::makePooledRasterImage(
+        SkImageInfo::MakeN32Premul(_cachedFramesPixelSize), [&](const SkPixmap& pixmap) {
+            auto frameCanvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+            if (frameCanvas == nullptr) {
+                return false;
+            }
+
+            frameCanvas->clear(SK_ColorTRANSPARENT);
+            frameCanvas->scale(static_cast<Scalar>(_cachedFramesPixelSize.width()) / _cachedFramesRect.width(),
+                               static_cast<Scalar>(_cachedFramesPixelSize.height()) / _cachedFramesRect.height());
+            frameCanvas->translate(-_cachedFramesRect.left, -_cachedFramesRect.top);
+            render(frameCanvas.get(), _cachedFramesDrawBounds, _cachedFramesFittingSizeMode);
+            return true;
+        });
+
+    if (frame == nullptr) {
+        return nullptr;
+    }
+
+    _cachedFrames[frameIndex] = std::move(frame);
+    mergeIdenticalNeighbors(frameIndex);
+
+    return _cachedFrames[frameIndex];
+}
+
+void LottieAnimatedImage::prepareFrames(const Duration& time, size_t framesCount) {
+    auto totalFrames = getFramesCount();
+    auto currentFrameIndex = getFrameIndex(std::clamp(time, Duration(), _duration));
+
+    for (size_t i = 1; i <= framesCount && static_cast<int>(i) < totalFrames; i++) {
+        // The lock is taken for each frame, so that drawing can happen in between
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        if (_cachedFramesReservedSize == 0) {
+            return;
+        }
+        getOrRenderCachedFrame((currentFrameIndex + static_cast<int>(i)) % totalFrames);
+    }
+}
+
+void LottieAnimatedImage::doDraw(SkCanvas* canvas,
+                                 const Rect& drawBounds,
+                                 const Duration& time,
+                                 FittingSizeMode fittingSizeMode,
+                                 Scalar rasterScale) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _currentTime = std::clamp(time, Duration(), _duration);
+
+    auto canvasScale = canvas->getTotalMatrix().getMaxScale();
+    auto pixelScale = rasterScale * (canvasScale > 0 ? canvasScale : 1.0f);
+
+    if (prepareFramesCache(drawBounds, fittingSizeMode, pixelScale)) {
+        auto frameIndex = getFrameIndex(_currentTime);
+        auto wasPrepared = _cachedFrames.find(frameIndex) != _cachedFrames.end();
+        auto startTime = TimePoint::now();
+        auto frame = getOrRenderCachedFrame(frameIndex);
+        if (!wasPrepared) {
+            // The frame was not prepared ahead and had to be rendered inline
+            AnimatedImageScheduler::getShared()->reportFrameTime(TimePoint::now() - startTime);
+        }
+
+        if (frame != nullptr) {
+            canvas->drawImageRect(frame, _cachedFramesRect.getSkValue(), SkSamplingOptions(SkFilterMode::kLinear));
+            return;
+        }
+    }
+
+    _animation->seekFrameTime(_currentTime.seconds());
+    render(canvas, drawBounds, fittingSizeMode);
+}
+
 static sk_sp<SkTypeface> loadTypeface(const Ref<IFontManager>& fontManager, const char* name, const char* /*url*/) {
     if (name == nullptr) {
         return nullptr;
@@ -18,8 +18,12 @@
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 
+#include "include/core/SkImage.h"
 #include "modules/skottie/include/Skottie.h"
 
+#include <map>
+#include <vector>
+
 namespace snap::drawing {
 
 class Resources;
@@ -35,6 +39,15 @@ public:
     const Duration& getDuration() const override;
     const Size& getSize() const override;
     double getFrameRate() const override;
+    int getFrameIndex(const Duration& time) const override;
+
+    void prepareFrames(const Duration& time, size_t framesCount) override;
+
+    /**
+     Set whether short animations should keep their frames rendered into bitmaps,
+     instead of rendering the animation again every time it is drawn. Enabled by default.
+     */
+    void setShouldCacheFrames(bool shouldCacheFrames);
 
     static Valdi::Result<Ref<LottieAnimatedImage>> make(const Ref<Resources>& resources,
                                                         const Valdi::Byte* data,
@@ -50,7 +63,8 @@ protected:
     void doDraw(SkCanvas* canvas,
                 const Rect& drawBounds,
                 const Duration& time,
-                FittingSizeMode fittingSizeMode) override;
+                FittingSizeMode fittingSizeMode,
+                Scalar rasterScale) override;
 
 private:
     mutable Valdi::Mutex _mutex;
@@ -61,6 +75,28 @@ private:
     Duration _currentTime;
     Size _size;
     double _frameRate;
+
+    // Short loops keep all their frames rendered at the size they were last drawn at,
+    // within the memory budget of the AnimatedImageScheduler
+    std::map<int, sk_sp<SkImage>> _cachedFrames;
+    Rect _cachedFramesDrawBounds;
+    Rect _cachedFramesRect;
+    SkISize _cachedFramesPixelSize = SkISize::MakeEmpty();
+    FittingSizeMode _cachedFramesFittingSizeMode = FittingSizeModeCenterScaleFit;
+    size_t _cachedFramesReservedSize = 0;
+    bool _shouldCacheFrames = true;
+
+    // For each frame, the index of the first frame of the span of identical frames it
+    // belongs to, as detected when caching frames. Layers only redraw when it changes.
+    mutable Valdi::Mutex _distinctFrameIndexesMutex;
+    std::vector<int> _distinctFrameIndexes;
+
+    int getFramesCount() const;
+    void render(SkCanvas* canvas, const Rect& drawBounds, FittingSizeMode fittingSizeMode);
+    bool prepareFramesCache(const Rect& drawBounds, FittingSizeMode fittingSizeMode, Scalar pixelScale);
+    sk_sp<SkImage> getOrRenderCachedFrame(int frameIndex);
+    void mergeIdenticalNeighbors(int frameIndex);
+    void clearFramesCache();
 };
 
 } // namespace snap::drawing
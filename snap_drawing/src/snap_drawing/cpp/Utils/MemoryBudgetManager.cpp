@@ -0,0 +1,65 @@
+#include "snap_drawing/cpp/Utils/MemoryBudgetManager.hpp"
+
+#include "valdi_core/cpp/Utils/Trace.hpp"
+
+#include <algorithm>
+
+namespace snap::drawing {
+
+MemoryBudgetManager::MemoryBudgetManager() = default;
+MemoryBudgetManager::~MemoryBudgetManager() = default;
+
+void MemoryBudgetManager::registerConsumer(const String& name,
+                                           GetSizeInBytesFunction getSizeInBytes,
+                                           OnMemoryPressureFunction onMemoryPressure) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    for (auto& consumer : _consumers) {
+        if (consumer.name == name) {
+            consumer.getSizeInBytes = std::move(getSizeInBytes);
+            consumer.onMemoryPressure = std::move(onMemoryPressure);
+            return;
+        }
+    }
+
+    _consumers.emplace_back(Consumer{name, std::move(getSizeInBytes), std::move(onMemoryPressure)});
+}
+
+void MemoryBudgetManager::unregisterConsumer(const String& name) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _consumers.erase(std::remove_if(_consumers.begin(),
+                                    _consumers.end(),
+                                    [&](const auto& consumer) { return consumer.name == name; }),
+                     _consumers.end());
+}
+
+std::vector<MemoryBudgetManager::Consumer> MemoryBudgetManager::getConsumers() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    return _consumers;
+}
+
+void MemoryBudgetManager::onMemoryPressure(MemoryPressureLevel level) {
+    VALDI_TRACE("SnapDrawing.onMemoryPressure");
+
+    // The consumers are called outside of the lock, as they might take their own locks
+    for (const auto& consumer : getConsumers()) {
+        consumer.onMemoryPressure(level);
+    }
+}
+
+std::vector<MemoryConsumerUsage> MemoryBudgetManager::getMemoryUsage() const {
+    std::vector<MemoryConsumerUsage> output;
+    for (const auto& consumer : getConsumers()) {
+        output.emplace_back(MemoryConsumerUsage{consumer.name, consumer.getSizeInBytes()});
+    }
+    return output;
+}
+
+size_t MemoryBudgetManager::getTotalSizeInBytes() const {
+    size_t total = 0;
+    for (const auto& usage : getMemoryUsage()) {
+        total += usage.sizeInBytes;
+    }
+    return total;
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include <vector>
+
+namespace snap::drawing {
+
+/**
+ How aggressively caches should release memory, from the OS memory warnings.
+ */
+enum class MemoryPressureLevel {
+    // Release the entries that are not in use and over a reduced budget
+    Moderate,
+    // Release most of the entries that are not in use
+    High,
+    // Release everything which can be recreated
+    Critical,
+};
+
+struct MemoryConsumerUsage {
+    String name;
+    size_t sizeInBytes;
+};
+
+/**
+ Central registry of the caches of a snap_drawing Runtime. It tracks how much memory each
+ of them holds, and dispatches the OS memory warnings to all of them so that they can
+ evict according to the pressure level.
+ */
+class MemoryBudgetManager : public Valdi::SimpleRefCountable {
+public:
+    using GetSizeInBytesFunction = Valdi::Function<size_t()>;
+    using OnMemoryPressureFunction = Valdi::Function<void(MemoryPressureLevel)>;
+
+    MemoryBudgetManager();
+    ~MemoryBudgetManager() override;
+
+    /**
+     Register a cache under the given name. The functions can be called from any thread,
+     and should not retain the cache strongly.
+     */
+    void registerConsumer(const String& name,
+                          GetSizeInBytesFunction getSizeInBytes,
+                          OnMemoryPressureFunction onMemoryPressure);
+    void unregisterConsumer(const String& name);
+
+    void onMemoryPressure(MemoryPressureLevel level);
+
+    /**
+     Returns the memory currently held by each of the registered caches.
+     */
+    std::vector<MemoryConsumerUsage> getMemoryUsage() const;
+
+    size_t getTotalSizeInBytes() const;
+
+private:
+    struct Consumer {
+        String name;
+        GetSizeInBytesFunction getSizeInBytes;
+        OnMemoryPressureFunction onMemoryPressure;
+    };
+
+    mutable Valdi::Mutex _mutex;
+    std::vector<Consumer> _consumers;
+
+    std::vector<Consumer> getConsumers() const;
+};
+
+} // namespace snap::drawing
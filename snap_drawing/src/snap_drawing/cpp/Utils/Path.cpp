@@ -60,6 +60,14 @@ void Path::reset() {
     getSkValue().reset();
 }
 
+void Path::rewind() {
+    getSkValue().rewind();
+}
+
+uint32_t Path::getGenerationId() const {
+    return getSkValue().getGenerationID();
+}
+
 void Path::moveTo(Scalar x, Scalar y) {
     getSkValue().moveTo(x, y);
 }
@@ -35,6 +35,18 @@ public:
 
     void reset();
 
+    /**
+     Remove all the contours like reset(), but keep the allocated storage
+     so that the path can be rebuilt without reallocating.
+     */
+    void rewind();
+
+    /**
+     Returns an id which changes whenever the geometry of the path changes. Copies of
+     a path share its id, which Skia uses to key the tessellations it caches on the GPU.
+     */
+    uint32_t getGenerationId() const;
+
     void addRoundRect(const Rect& bounds, Scalar radii[8], bool clockwise);
 
     void addRoundRect(const Rect& bounds, Scalar rx, Scalar ry, bool clockwise);
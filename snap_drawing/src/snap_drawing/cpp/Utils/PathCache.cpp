@@ -0,0 +1,69 @@
+//
+//  PathCache.cpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "snap_drawing/cpp/Utils/PathCache.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace snap::drawing {
+
+PathCacheKey::PathCacheKey() = default;
+PathCacheKey::PathCacheKey(const Valdi::BytesView& pathData, Size size) : pathData(pathData), size(size) {}
+PathCacheKey::~PathCacheKey() = default;
+
+bool PathCacheKey::operator==(const PathCacheKey& other) const {
+    return size == other.size && pathData == other.pathData;
+}
+
+bool PathCacheKey::operator!=(const PathCacheKey& other) const {
+    return !(*this == other);
+}
+
+size_t PathCacheKey::hash() const {
+    auto hash = pathData.hash();
+    boost::hash_combine(hash, std::hash<Scalar>()(size.width));
+    boost::hash_combine(hash, std::hash<Scalar>()(size.height));
+    return hash;
+}
+
+PathCache::PathCache(size_t capacity) : _cache(capacity) {}
+PathCache::~PathCache() = default;
+
+std::optional<Path> PathCache::find(const PathCacheKey& key) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    const auto& it = _cache.find(key);
+    if (it == _cache.end()) {
+        return std::nullopt;
+    }
+
+    return {it->value()};
+}
+
+void PathCache::insert(PathCacheKey key, const Path& path) {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _cache.insert(std::move(key), Path(path));
+}
+
+void PathCache::clear() {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    _cache.clear();
+}
+
+size_t PathCache::size() const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    return _cache.size();
+}
+
+} // namespace snap::drawing
+
+namespace std {
+
+std::size_t hash<snap::drawing::PathCacheKey>::operator()(const snap::drawing::PathCacheKey& k) const noexcept {
+    return k.hash();
+}
+
+} // namespace std
@@ -0,0 +1,76 @@
+//
+//  PathCache.hpp
+//  snap_drawing
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/Geometry.hpp"
+#include "snap_drawing/cpp/Utils/Path.hpp"
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/LRUCache.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include <optional>
+
+namespace snap::drawing {
+
+/**
+ Identifies a Path from the serialized path data it is built from and the size the path
+ data is resolved against. The path data is compared by value.
+ */
+struct PathCacheKey {
+    Valdi::BytesView pathData;
+    Size size;
+
+    PathCacheKey();
+    PathCacheKey(const Valdi::BytesView& pathData, Size size);
+    ~PathCacheKey();
+
+    bool operator==(const PathCacheKey& other) const;
+    bool operator!=(const PathCacheKey& other) const;
+
+    size_t hash() const;
+};
+
+} // namespace snap::drawing
+
+namespace std {
+
+template<>
+struct hash<snap::drawing::PathCacheKey> {
+    std::size_t operator()(const snap::drawing::PathCacheKey& k) const noexcept;
+};
+
+} // namespace std
+
+namespace snap::drawing {
+
+/**
+ A thread safe LRU cache of built Paths, shared between the layers of a Resources instance.
+ Layers which display the same path data at the same size, like the icons of a grid, share
+ a single Path. Copies of a Path share its geometry and its generation id, which lets Skia
+ reuse the tessellation it cached for the path on the GPU backend.
+ */
+class PathCache : public Valdi::SimpleRefCountable {
+public:
+    explicit PathCache(size_t capacity);
+    ~PathCache() override;
+
+    std::optional<Path> find(const PathCacheKey& key);
+    void insert(PathCacheKey key, const Path& path);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    mutable Valdi::Mutex _mutex;
+    Valdi::LRUCache<PathCacheKey, Path> _cache;
+};
+
+} // namespace snap::drawing
@@ -22,7 +22,7 @@ PathInterpolator::PathInterpolator(const Path& path) {
 PathInterpolator::~PathInterpolator() = default;
 
 const Path& PathInterpolator::interpolate(Scalar start, Scalar end) {
-    _interpolatedPath.reset();
+    _interpolatedPath.rewind();
 
     auto absoluteStart = start * _totalLength;
     auto absoluteEnd = end * _totalLength;
@@ -9,6 +9,9 @@
 #include "include/core/SkCanvas.h"
 #include "snap_drawing/cpp/Drawing/DrawingContext.hpp"
 #include "snap_drawing/cpp/Drawing/Surface/DrawableSurfaceCanvas.hpp"
+#include "snap_drawing/cpp/Utils/AnimatedImageScheduler.hpp"
+#include "snap_drawing/cpp/Utils/Image.hpp"
+#include "snap_drawing/cpp/Utils/TimePoint.hpp"
 
 namespace snap::drawing {
 
@@ -32,31 +35,163 @@ double SkCodecAnimatedImage::getFrameRate() const {
 }
 
 SkCodecAnimatedImage::SkCodecAnimatedImage(std::unique_ptr<SkCodec> codec)
-    : _size(Size(codec->dimensions().width(), codec->dimensions().height())) {
-    SkImageInfo imageInfo = codec->getInfo().makeColorType(kN32_SkColorType);
-    std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
-    const auto totalFrames = frameInfos.size();
+    : _codec(std::move(codec)), _size(Size(_codec->dimensions().width(), _codec->dimensions().height())) {
+    _imageInfo = _codec->getInfo().makeColorType(kN32_SkColorType);
+    if (_imageInfo.alphaType() == kUnpremul_SkAlphaType) {
+        _imageInfo = _imageInfo.makeAlphaType(kPremul_SkAlphaType);
+    }
+
+    _frameInfos = _codec->getFrameInfo();
+    const auto totalFrames = _frameInfos.size();
     long totalAnimationDurationMs = 0u;
+    _frameEndTimes.reserve(totalFrames);
     for (size_t i = 0; i < totalFrames; i++) {
-        totalAnimationDurationMs += frameInfos[i].fDuration;
+        totalAnimationDurationMs += _frameInfos[i].fDuration;
+        _frameEndTimes.emplace_back(Duration::fromMilliseconds(totalAnimationDurationMs));
     }
     _duration = Duration::fromMilliseconds(totalAnimationDurationMs);
-    _frameRate = _frameRate = codec->getFrameCount() / _duration.seconds();
-    _player = std::make_unique<SkAnimCodecPlayer>(std::move(codec));
+    _frameRate = _codec->getFrameCount() / _duration.seconds();
+}
+
+int SkCodecAnimatedImage::getFrameIndex(const Duration& time) const {
+    if (_frameEndTimes.empty()) {
+        return 0;
+    }
+
+    auto it = std::upper_bound(_frameEndTimes.begin(), _frameEndTimes.end(), time);
+    auto index = static_cast<int>(it - _frameEndTimes.begin());
+    return std::min(index, static_cast<int>(_frameEndTimes.size()) - 1);
+}
+
+sk_sp<SkImage> SkCodecAnimatedImage::getCachedFrame(int frameIndex) const {
+    std::lock_guard<Valdi::Mutex> lock(_mutex);
+    const auto& it = _frames.find(frameIndex);
+    if (it == _frames.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+sk_sp<SkImage> SkCodecAnimatedImage::getOrDecodeFrame(int frameIndex) {
+    auto frame = getCachedFrame(frameIndex);
+    if (frame != nullptr) {
+        return frame;
+    }
+
+    std::lock_guard<Valdi::Mutex> lock(_decodeMutex);
+    return decodeFrame(frameIndex);
+}
+
+sk_sp<SkImage> SkCodecAnimatedImage::decodeFrame(int frameIndex) {
+    // The frame might have been decoded by another thread while we were waiting for the codec
+    auto frame = getCachedFrame(frameIndex);
+    if (frame != nullptr) {
+        return frame;
+    }
+
+    SkCodec::Options options;
+    options.fFrameIndex = frameIndex;
+
+    sk_sp<SkImage> requiredFrame;
+    if (frameIndex >= 0 && static_cast<size_t>(frameIndex) < _frameInfos.size()) {
+        auto requiredFrameIndex = _frameInfos[frameIndex].fRequiredFrame;
+        if (requiredFrameIndex != SkCodec::kNoFrame) {
+            requiredFrame = decodeFrame(requiredFrameIndex);
+            if (requiredFrame == nullptr) {
+                return nullptr;
+            }
+            options.fPriorFrame = requiredFrameIndex;
+        }
+    }
+
+    frame = Image::makePooledRasterImage(_imageInfo, [&](const SkPixmap& pixmap) {
+        // Frames which depend on a prior frame are decoded on top of it, the others are fully
+        // written by the codec
+        if (requiredFrame != nullptr &&
+            !requiredFrame->readPixels(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes(), 0, 0)) {
+            return false;
+        }
+        auto result = _codec->getPixels(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes(), &options);
+        return result == SkCodec::kSuccess || result == SkCodec::kIncompleteInput;
+    });
+
+    if (frame != nullptr) {
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        _frames[frameIndex] = frame;
+    }
+
+    return frame;
+}
+
+void SkCodecAnimatedImage::evictFramesOutsideWindow(int currentFrameIndex) {
+    auto framesCount = static_cast<int>(_frameInfos.size());
+    if (framesCount == 0) {
+        return;
+    }
+
+    auto requiredFrameIndex = _frameInfos[currentFrameIndex].fRequiredFrame;
+    for (auto it = _frames.begin(); it != _frames.end();) {
+        auto distance = (it->first - currentFrameIndex + framesCount) % framesCount;
+        auto isPreviousFrame = distance == framesCount - 1;
+        if (static_cast<size_t>(distance) <= _framesAheadCount || isPreviousFrame || it->first == requiredFrameIndex) {
+            ++it;
+        } else {
+            it = _frames.erase(it);
+        }
+    }
+}
+
+void SkCodecAnimatedImage::prepareFrames(const Duration& time, size_t framesCount) {
+    auto currentFrameIndex = getFrameIndex(std::clamp(time, Duration(), _duration));
+    auto totalFrames = _frameInfos.size();
+
+    {
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        _framesAheadCount = std::min(framesCount, totalFrames > 0 ? totalFrames - 1 : 0);
+        framesCount = _framesAheadCount;
+    }
+
+    for (size_t i = 1; i <= framesCount; i++) {
+        auto frameIndex = static_cast<int>((currentFrameIndex + i) % totalFrames);
+        // The codec lock is taken for each frame, so that drawing can get a frame in between
+        std::lock_guard<Valdi::Mutex> lock(_decodeMutex);
+        decodeFrame(frameIndex);
+    }
+}
+
+size_t SkCodecAnimatedImage::getFrameSizeInBytes() const {
+    return _imageInfo.computeMinByteSize();
 }
 
 void SkCodecAnimatedImage::doDraw(SkCanvas* canvas,
                                   const Rect& drawBounds,
                                   const Duration& time,
-                                  FittingSizeMode fittingSizeMode) {
-    std::lock_guard<Valdi::Mutex> lock(_mutex);
-    _currentTime = std::clamp(time, Duration(), _duration);
+                                  FittingSizeMode /*fittingSizeMode*/,
+                                  Scalar /*rasterScale*/) {
+    auto currentTime = std::clamp(time, Duration(), _duration);
+    auto frameIndex = getFrameIndex(currentTime);
+
+    {
+        std::lock_guard<Valdi::Mutex> lock(_mutex);
+        _currentTime = currentTime;
+        evictFramesOutsideWindow(frameIndex);
+    }
+
+    auto frame = getCachedFrame(frameIndex);
+    if (frame == nullptr) {
+        // The frame was not prepared ahead, it has to be decoded inline
+        auto startTime = TimePoint::now();
+        frame = getOrDecodeFrame(frameIndex);
+        AnimatedImageScheduler::getShared()->reportFrameTime(TimePoint::now() - startTime);
+    }
+
+    if (frame == nullptr) {
+        return;
+    }
 
-    _player->seek(_currentTime.milliseconds());
-    const auto& image = _player->getFrame();
     const SkRect srcR = SkRect::MakeWH(_size.width, _size.height);
     canvas->drawImageRect(
-        image, srcR, drawBounds.getSkValue(), SkSamplingOptions(), nullptr, SkCanvas::kStrict_SrcRectConstraint);
+        frame, srcR, drawBounds.getSkValue(), SkSamplingOptions(), nullptr, SkCanvas::kStrict_SrcRectConstraint);
 }
 
 Valdi::Result<Ref<SkCodecAnimatedImage>> SkCodecAnimatedImage::make(std::unique_ptr<SkCodec> codec) {
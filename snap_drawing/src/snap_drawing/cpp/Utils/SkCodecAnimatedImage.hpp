@@ -19,8 +19,10 @@
 #include "valdi_core/cpp/Utils/Result.hpp"
 
 #include "include/codec/SkCodec.h"
-#include "modules/skottie/include/Skottie.h"
-#include "modules/skresources/src/SkAnimCodecPlayer.h"
+#include "include/core/SkImage.h"
+
+#include <map>
+#include <vector>
 
 namespace snap::drawing {
 
@@ -28,6 +30,11 @@ class Resources;
 class DrawingContext;
 class IFontManager;
 
+/**
+ An AnimatedImage backed by an SkCodec (GIF, animated WebP). Only a window of decoded frames
+ is kept around the current one: the frames which were prepared ahead by the AnimatedImageScheduler,
+ and the previous frame which the next one is most often decoded on top of.
+ */
 class SkCodecAnimatedImage : public AnimatedImage {
 public:
     explicit SkCodecAnimatedImage(std::unique_ptr<SkCodec> codec);
@@ -37,6 +44,10 @@ public:
     const Duration& getDuration() const override;
     const Size& getSize() const override;
     double getFrameRate() const override;
+    int getFrameIndex(const Duration& time) const override;
+
+    void prepareFrames(const Duration& time, size_t framesCount) override;
+    size_t getFrameSizeInBytes() const override;
 
     static Valdi::Result<Ref<SkCodecAnimatedImage>> make(std::unique_ptr<SkCodec> codec);
 
@@ -46,15 +57,29 @@ protected:
     void doDraw(SkCanvas* canvas,
                 const Rect& drawBounds,
                 const Duration& time,
-                FittingSizeMode fittingSizeMode) override;
+                FittingSizeMode fittingSizeMode,
+                Scalar rasterScale) override;
 
 private:
+    // Protects _frames, _framesAheadCount and _currentTime
     mutable Valdi::Mutex _mutex;
-    std::unique_ptr<SkAnimCodecPlayer> _player;
+    // Protects _codec, held while decoding a frame
+    Valdi::Mutex _decodeMutex;
+    std::unique_ptr<SkCodec> _codec;
+    SkImageInfo _imageInfo;
+    std::vector<SkCodec::FrameInfo> _frameInfos;
+    std::vector<Duration> _frameEndTimes;
+    std::map<int, sk_sp<SkImage>> _frames;
+    size_t _framesAheadCount = 0;
     Duration _duration;
     Duration _currentTime;
     Size _size;
     double _frameRate;
+
+    sk_sp<SkImage> getCachedFrame(int frameIndex) const;
+    sk_sp<SkImage> getOrDecodeFrame(int frameIndex);
+    sk_sp<SkImage> decodeFrame(int frameIndex);
+    void evictFramesOutsideWindow(int currentFrameIndex);
 };
 
 } // namespace snap::drawing
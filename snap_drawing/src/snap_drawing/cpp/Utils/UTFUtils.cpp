@@ -7,6 +7,9 @@
 
 #include "snap_drawing/cpp/Utils/UTFUtils.hpp"
 #include "include/core/SkTypes.h"
+#include "valdi_core/cpp/Text/UTF16Utils.hpp"
+
+#include <algorithm>
 
 namespace SkUTF {
 
@@ -28,6 +31,13 @@ std::vector<Character> utf8ToUnicode(std::string_view utf8) {
 size_t utf8ToUnicode(std::string_view utf8, std::vector<Character>& output) {
     const auto* utf8Start = utf8.data();
 
+    auto asciiLength = Valdi::countLeadingASCII(utf8Start, utf8.size());
+    if (asciiLength == utf8.size()) {
+        // Fast path: every byte is a code point
+        output.insert(output.end(), utf8Start, utf8Start + asciiLength);
+        return asciiLength;
+    }
+
     auto unicodeCount = SkUTF::CountUTF8(utf8Start, utf8.size());
     if (unicodeCount <= 0) {
         return 0;
@@ -41,6 +51,13 @@ size_t utf8ToUnicode(std::string_view utf8, std::vector<Character>& output) {
     const auto* utf8End = utf8Start + utf8.size();
 
     while (utf8Start < utf8End) {
+        asciiLength = Valdi::countLeadingASCII(utf8Start, static_cast<size_t>(utf8End - utf8Start));
+        if (asciiLength > 0) {
+            unicodePtr = std::copy(utf8Start, utf8Start + asciiLength, unicodePtr);
+            utf8Start += asciiLength;
+            continue;
+        }
+
         (*unicodePtr) = SkUTF::NextUTF8(&utf8Start, utf8End);
         unicodePtr++;
     }
@@ -50,11 +67,17 @@ size_t utf8ToUnicode(std::string_view utf8, std::vector<Character>& output) {
 
 std::string unicodeToUtf8(const Character* unicode, size_t length) {
     std::string characters;
+    characters.reserve(length);
     char buffer[4];
 
     const auto* skCharactersPtr = reinterpret_cast<const SkUnichar*>(unicode);
 
     for (size_t i = 0; i < length; i++) {
+        if (unicode[i] < 0x80) {
+            characters.push_back(static_cast<char>(unicode[i]));
+            continue;
+        }
+
         size_t written = SkUTF::ToUTF8(skCharactersPtr[i], buffer);
         characters.append(buffer, written);
     }
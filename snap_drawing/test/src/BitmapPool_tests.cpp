@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static BitmapInfo makeBitmapInfo(int width, int height, ColorType colorType) {
+    return BitmapInfo(width, height, colorType, AlphaTypePremul, 0);
+}
+
+TEST(BitmapPool, reusesReleasedBitmaps) {
+    auto pool = makeShared<BitmapPool>(1024 * 1024);
+
+    auto bitmap = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888)).moveValue();
+    void* bytes = bitmap->lockBytes();
+    bitmap->unlockBytes();
+
+    ASSERT_EQ(static_cast<size_t>(0), pool->getPooledBitmapsCount());
+
+    bitmap = nullptr;
+
+    ASSERT_EQ(static_cast<size_t>(1), pool->getPooledBitmapsCount());
+    ASSERT_EQ(static_cast<size_t>(4 * 4 * 4), pool->getSizeInBytes());
+
+    bitmap = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888)).moveValue();
+
+    ASSERT_EQ(static_cast<size_t>(0), pool->getPooledBitmapsCount());
+    ASSERT_EQ(static_cast<size_t>(0), pool->getSizeInBytes());
+    ASSERT_EQ(bytes, bitmap->lockBytes());
+    bitmap->unlockBytes();
+}
+
+TEST(BitmapPool, bucketsBySizeAndColorType) {
+    auto pool = makeShared<BitmapPool>(1024 * 1024);
+
+    pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888));
+    ASSERT_EQ(static_cast<size_t>(1), pool->getPooledBitmapsCount());
+
+    auto otherSize = pool->allocateBitmap(makeBitmapInfo(4, 2, ColorTypeRGBA8888)).moveValue();
+    ASSERT_EQ(static_cast<size_t>(1), pool->getPooledBitmapsCount());
+
+    auto otherColorType = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeAlpha8)).moveValue();
+    ASSERT_EQ(static_cast<size_t>(1), pool->getPooledBitmapsCount());
+    ASSERT_EQ(ColorTypeAlpha8, otherColorType->getInfo().colorType);
+
+    auto sameShape = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888)).moveValue();
+    ASSERT_EQ(static_cast<size_t>(0), pool->getPooledBitmapsCount());
+}
+
+TEST(BitmapPool, staysWithinBudget) {
+    // Room for two 4x4 RGBA bitmaps
+    auto pool = makeShared<BitmapPool>(2 * 4 * 4 * 4);
+
+    auto bitmap1 = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888)).moveValue();
+    auto bitmap2 = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888)).moveValue();
+    auto bitmap3 = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888)).moveValue();
+    auto tooLarge = pool->allocateBitmap(makeBitmapInfo(32, 32, ColorTypeRGBA8888)).moveValue();
+
+    tooLarge = nullptr;
+    ASSERT_EQ(static_cast<size_t>(0), pool->getPooledBitmapsCount());
+
+    bitmap1 = nullptr;
+    bitmap2 = nullptr;
+    bitmap3 = nullptr;
+
+    ASSERT_EQ(static_cast<size_t>(2), pool->getPooledBitmapsCount());
+    ASSERT_EQ(pool->getMaxSizeInBytes(), pool->getSizeInBytes());
+}
+
+TEST(BitmapPool, evictsLeastRecentlyUsedBucketsWhenTrimming) {
+    auto pool = makeShared<BitmapPool>(1024 * 1024);
+
+    auto small = pool->allocateBitmap(makeBitmapInfo(2, 2, ColorTypeRGBA8888)).moveValue();
+    auto large = pool->allocateBitmap(makeBitmapInfo(4, 4, ColorTypeRGBA8888)).moveValue();
+
+    large = nullptr;
+    small = nullptr;
+
+    ASSERT_EQ(static_cast<size_t>(2), pool->getPooledBitmapsCount());
+
+    pool->trimToSize(2 * 2 * 4);
+
+    // The 4x4 bucket was released first, it should be the one evicted
+    ASSERT_EQ(static_cast<size_t>(1), pool->getPooledBitmapsCount());
+    ASSERT_EQ(static_cast<size_t>(2 * 2 * 4), pool->getSizeInBytes());
+
+    pool->clear();
+
+    ASSERT_EQ(static_cast<size_t>(0), pool->getPooledBitmapsCount());
+    ASSERT_EQ(static_cast<size_t>(0), pool->getSizeInBytes());
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Drawing/MaskFilter.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/BoxShadowCache.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static Paint makeShadowPaint(Color color, Scalar blurAmount) {
+    Paint paint;
+    paint.setColor(color);
+    paint.setMaskFilter(MaskFilter::makeBlur(BlurStyleNormal, blurAmount * 2));
+    return paint;
+}
+
+TEST(BoxShadowCache, sharesNinePatchBetweenBoxesOfSameStyle) {
+    auto cache = makeShared<BoxShadowCache>(16);
+    auto paint = makeShadowPaint(Color::black(), 2);
+
+    auto ninePatch =
+        cache->getOrRender(BorderRadius::makeOval(8, false), Rect::makeXYWH(0, 0, 100, 60), 2, paint, 2.0f);
+    ASSERT_NE(nullptr, ninePatch);
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+
+    // Same style at a different size and position
+    ASSERT_EQ(ninePatch,
+              cache->getOrRender(BorderRadius::makeOval(8, false), Rect::makeXYWH(10, 20, 300, 80), 2, paint, 2.0f));
+    // Percent radius resolving to the same absolute radius
+    ASSERT_EQ(ninePatch,
+              cache->getOrRender(BorderRadius::makeOval(10, true), Rect::makeXYWH(0, 0, 100, 80), 2, paint, 2.0f));
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+
+    auto otherPaint = makeShadowPaint(Color::red(), 2);
+    auto otherNinePatch =
+        cache->getOrRender(BorderRadius::makeOval(8, false), Rect::makeXYWH(0, 0, 100, 60), 2, otherPaint, 2.0f);
+    ASSERT_NE(nullptr, otherNinePatch);
+    ASSERT_NE(ninePatch, otherNinePatch);
+
+    ASSERT_NE(ninePatch,
+              cache->getOrRender(BorderRadius::makeOval(8, false), Rect::makeXYWH(0, 0, 100, 60), 2, paint, 3.0f));
+    ASSERT_EQ(static_cast<size_t>(3), cache->size());
+}
+
+TEST(BoxShadowCache, doesNotRenderBoxesSmallerThanNinePatch) {
+    auto cache = makeShared<BoxShadowCache>(16);
+    auto paint = makeShadowPaint(Color::black(), 4);
+
+    // The corners and the blur of opposite edges overlap
+    ASSERT_EQ(nullptr,
+              cache->getOrRender(BorderRadius::makeOval(8, false), Rect::makeXYWH(0, 0, 20, 100), 4, paint, 1.0f));
+    ASSERT_EQ(static_cast<size_t>(0), cache->size());
+
+    ASSERT_NE(nullptr,
+              cache->getOrRender(BorderRadius::makeOval(8, false), Rect::makeXYWH(0, 0, 100, 100), 4, paint, 1.0f));
+    ASSERT_EQ(nullptr,
+              cache->getOrRender(BorderRadius::makeOval(8, false), Rect::makeXYWH(0, 0, 20, 100), 4, paint, 1.0f));
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+}
+
+TEST(BoxShadowCache, doesNotCacheUnblurredShadows) {
+    auto cache = makeShared<BoxShadowCache>(16);
+    Paint paint;
+    paint.setColor(Color::black());
+
+    ASSERT_EQ(nullptr, cache->getOrRender(BorderRadius(), Rect::makeXYWH(0, 0, 100, 100), 0, paint, 1.0f));
+    ASSERT_EQ(static_cast<size_t>(0), cache->size());
+}
+
+} // namespace snap::drawing
@@ -2,6 +2,13 @@
 
 #include "DisplayListBuilder.hpp"
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/DrawDisplayListVisitor.hpp"
+#include "snap_drawing/cpp/Drawing/DisplayList/OcclusionDisplayListVisitor.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+
 #include <vector>
 
 using namespace Valdi;
@@ -19,6 +26,43 @@ static LayerContent makeRectangle(Size size) {
     return ctx.finish();
 }
 
+static LayerContent makeOpaqueRectangle(Size size) {
+    auto content = makeRectangle(size);
+    content.opaqueRect = Rect::makeXYWH(0, 0, size.width, size.height);
+    return content;
+}
+
+static Ref<ImageAtlasSprite> makeRedSprite(ImageAtlas& atlas, int size) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(size, size);
+    bitmap.eraseColor(SK_ColorRED);
+    bitmap.setImmutable();
+
+    return atlas.getOrInsert(bitmap.asImage());
+}
+
+/**
+ Draw the DisplayList into the given bitmap and returns the number of drawAtlas() calls
+ */
+static size_t drawIntoBitmap(const Ref<DisplayList>& displayList, SkBitmap& bitmap) {
+    bitmap.allocN32Pixels(static_cast<int>(displayList->getSize().width),
+                          static_cast<int>(displayList->getSize().height));
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+
+    SkCanvas canvas(bitmap);
+    DrawDisplayListVisitor visitor(&canvas, 1, 1);
+    displayList->visitOperations(0, visitor);
+    visitor.flush();
+
+    return visitor.getAtlasDrawsCount();
+}
+
+static std::vector<bool> resolveOccludedPictures(const Ref<DisplayList>& displayList) {
+    OcclusionDisplayListVisitor visitor(1, 1);
+    displayList->visitOperations(0, visitor);
+    return visitor.resolveOccludedPictures();
+}
+
 TEST(DisplayList, canRecordAndVisitCommands) {
     auto displayList = makeShared<DisplayList>(Size(100, 100), TimePoint(0));
 
@@ -227,4 +271,105 @@ TEST(DisplayList, canRemoveEmptySurfaces) {
     ASSERT_EQ(70, clipRect->height);
 }
 
+TEST(DisplayList, resolvesPicturesOccludedByOpaqueContent) {
+    auto displayList = makeShared<DisplayList>(Size(100, 100), TimePoint(0));
+
+    Matrix matrix;
+    matrix.setTranslateX(10);
+    matrix.setTranslateY(10);
+
+    displayList->pushContext(Matrix(), 1, 1, true);
+    displayList->appendLayerContent(makeRectangle(Size(100, 100)), 1);
+    displayList->pushContext(matrix, 1, 2, true);
+    displayList->appendLayerContent(makeRectangle(Size(20, 20)), 1);
+    displayList->popContext();
+    // Opaque content covering the whole display list, except for its edges
+    displayList->appendLayerContent(makeOpaqueRectangle(Size(100, 100)), 1);
+    displayList->popContext();
+
+    auto occludedPictures = resolveOccludedPictures(displayList);
+
+    ASSERT_EQ(std::vector<bool>({false, true, false}), occludedPictures);
+}
+
+TEST(DisplayList, doesNotOccludeWithTranslucentContent) {
+    auto displayList = makeShared<DisplayList>(Size(100, 100), TimePoint(0));
+
+    displayList->pushContext(Matrix(), 1, 1, true);
+    displayList->appendLayerContent(makeRectangle(Size(50, 50)), 1);
+    displayList->appendLayerContent(makeOpaqueRectangle(Size(100, 100)), 0.5);
+    displayList->pushContext(Matrix(), 0.5, 2, true);
+    displayList->appendLayerContent(makeOpaqueRectangle(Size(100, 100)), 1);
+    displayList->popContext();
+    displayList->popContext();
+
+    ASSERT_TRUE(resolveOccludedPictures(displayList).empty());
+}
+
+TEST(DisplayList, doesNotOccludeWithRoundedClip) {
+    auto displayList = makeShared<DisplayList>(Size(100, 100), TimePoint(0));
+
+    displayList->pushContext(Matrix(), 1, 1, true);
+    displayList->appendLayerContent(makeRectangle(Size(50, 50)), 1);
+    displayList->pushContext(Matrix(), 1, 2, true);
+    displayList->appendClipRound(BorderRadius::makeOval(25, true), 100, 100);
+    displayList->appendLayerContent(makeOpaqueRectangle(Size(100, 100)), 1);
+    displayList->popContext();
+    displayList->popContext();
+
+    ASSERT_TRUE(resolveOccludedPictures(displayList).empty());
+}
+
+TEST(DisplayList, batchesAtlasSpritesAroundNonOverlappingPictures) {
+    auto atlas = makeShared<ImageAtlas>(256, 1);
+    auto sprite = makeRedSprite(*atlas, 10);
+    auto otherSprite = makeRedSprite(*atlas, 10);
+    auto displayList = makeShared<DisplayList>(Size(100, 100), TimePoint(0));
+
+    Matrix matrix;
+    matrix.setTranslateX(50);
+    matrix.setTranslateY(50);
+
+    displayList->pushContext(Matrix(), 1, 1, true);
+    displayList->appendAtlasSprite(sprite.get(), Rect::makeXYWH(0, 0, 10, 10), 1);
+    displayList->pushContext(matrix, 1, 2, true);
+    displayList->appendLayerContent(makeRectangle(Size(20, 20)), 1);
+    displayList->popContext();
+    displayList->appendAtlasSprite(otherSprite.get(), Rect::makeXYWH(20, 0, 10, 10), 1);
+    displayList->popContext();
+
+    SkBitmap bitmap;
+    ASSERT_EQ(static_cast<size_t>(1), drawIntoBitmap(displayList, bitmap));
+
+    ASSERT_EQ(SK_ColorRED, bitmap.getColor(5, 5));
+    ASSERT_EQ(SK_ColorRED, bitmap.getColor(25, 5));
+    ASSERT_EQ(SK_ColorBLUE, bitmap.getColor(60, 60));
+}
+
+TEST(DisplayList, preservesOrderOfOverlappingAtlasSpritesAndPictures) {
+    auto atlas = makeShared<ImageAtlas>(256, 1);
+    auto sprite = makeRedSprite(*atlas, 10);
+    auto displayList = makeShared<DisplayList>(Size(100, 100), TimePoint(0));
+
+    Matrix matrix;
+    matrix.setTranslateX(50);
+
+    displayList->pushContext(Matrix(), 1, 1, true);
+    // Sprite below a picture
+    displayList->appendAtlasSprite(sprite.get(), Rect::makeXYWH(0, 0, 10, 10), 1);
+    displayList->appendLayerContent(makeRectangle(Size(20, 20)), 1);
+    // Sprite above a picture
+    displayList->pushContext(matrix, 1, 2, true);
+    displayList->appendLayerContent(makeRectangle(Size(20, 20)), 1);
+    displayList->appendAtlasSprite(sprite.get(), Rect::makeXYWH(0, 0, 10, 10), 1);
+    displayList->popContext();
+    displayList->popContext();
+
+    SkBitmap bitmap;
+    ASSERT_EQ(static_cast<size_t>(2), drawIntoBitmap(displayList, bitmap));
+
+    ASSERT_EQ(SK_ColorBLUE, bitmap.getColor(5, 5));
+    ASSERT_EQ(SK_ColorRED, bitmap.getColor(55, 5));
+}
+
 } // namespace snap::drawing
@@ -30,6 +30,16 @@ public:
     }
 
     bool runNextMainThreadCallback() {
+        auto it = _delayedMainThreadCallbacks.begin();
+        while (it != _delayedMainThreadCallbacks.end()) {
+            if (it->first <= _currentTime) {
+                _mainThreadCallbacks.emplace_back(std::move(it->second));
+                it = _delayedMainThreadCallbacks.erase(it);
+            } else {
+                it++;
+            }
+        }
+
         return runNextCallback(_mainThreadCallbacks);
     }
 
@@ -37,6 +47,14 @@ public:
         return _mainThreadCallbacks.size();
     }
 
+    size_t getDelayedMainThreadCallbacksSize() const {
+        return _delayedMainThreadCallbacks.size();
+    }
+
+    Scalar getPreferredFrameRate() const {
+        return _preferredFrameRate;
+    }
+
     void onNextVSync(const Ref<IFrameCallback>& callback) override {
         _vsyncCallbacks.emplace_back(callback);
     }
@@ -45,9 +63,19 @@ public:
         _mainThreadCallbacks.emplace_back(callback);
     }
 
+    void onMainThreadAfter(const Ref<IFrameCallback>& callback, Duration delay) override {
+        _delayedMainThreadCallbacks.emplace_back(_currentTime + delay, callback);
+    }
+
+    void setPreferredFrameRate(Scalar frameRate) override {
+        _preferredFrameRate = frameRate;
+    }
+
 private:
     std::deque<Ref<IFrameCallback>> _vsyncCallbacks;
     std::deque<Ref<IFrameCallback>> _mainThreadCallbacks;
+    std::deque<std::pair<TimePoint, Ref<IFrameCallback>>> _delayedMainThreadCallbacks;
+    Scalar _preferredFrameRate = 0;
     TimePoint _currentTime = TimePoint(0.0);
 
     bool runNextCallback(std::deque<Ref<IFrameCallback>>& callbacks) {
@@ -458,6 +486,52 @@ TEST(DrawLooper, repeatedlyProcessesFramesWhenLayerNeedsProcessFrame) {
     ASSERT_FALSE(container.frameScheduler->runNextMainThreadCallback());
 };
 
+TEST(DrawLooper, waitsForDelayedEventsInsteadOfProcessingEveryFrame) {
+    DrawLooperTestContainer container;
+
+    container.addLayerRootToLooper(container.layerRoot);
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+
+    std::vector<TimePoint> eventTimes;
+    container.layerRoot->enqueueEvent([&](TimePoint time, Duration /*delta*/) { eventTimes.emplace_back(time); },
+                                      Duration(1.0));
+    container.layerRoot->enqueueEvent([&](TimePoint time, Duration /*delta*/) { eventTimes.emplace_back(time); },
+                                      Duration(1.003));
+
+    container.frameScheduler->advanceTime(0.016);
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+
+    // Only the events are pending, which are not due yet
+    ASSERT_TRUE(container.layerRoot->needsProcessFrame());
+    ASSERT_FALSE(container.layerRoot->needsProcessFrameAtTime(TimePoint(0.5)));
+    ASSERT_TRUE(container.layerRoot->needsProcessFrameAtTime(TimePoint(1.0)));
+
+    ASSERT_FALSE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_EQ(static_cast<size_t>(1), container.frameScheduler->getDelayedMainThreadCallbacksSize());
+    ASSERT_EQ(static_cast<Scalar>(30), container.frameScheduler->getPreferredFrameRate());
+
+    container.frameScheduler->advanceTime(0.5);
+    ASSERT_FALSE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_TRUE(eventTimes.empty());
+
+    container.frameScheduler->advanceTime(0.484);
+
+    // Both events are processed in the same frame
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_EQ(static_cast<size_t>(2), eventTimes.size());
+    ASSERT_NEAR(1.0, eventTimes[0].getTime(), 0.0001);
+    ASSERT_NEAR(1.0, eventTimes[1].getTime(), 0.0001);
+
+    ASSERT_FALSE(container.layerRoot->needsProcessFrame());
+    ASSERT_FALSE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_EQ(static_cast<size_t>(0), container.frameScheduler->getDelayedMainThreadCallbacksSize());
+
+    // Updates are processed on the next frame at the display rate
+    container.layerRoot->getContentLayer()->setBackgroundColor(Color::white());
+    ASSERT_EQ(static_cast<Scalar>(0), container.frameScheduler->getPreferredFrameRate());
+    ASSERT_EQ(static_cast<size_t>(1), container.frameScheduler->getMainThreadCallbacksSize());
+}
+
 TEST(DrawLooper, schedulesDraw) {
     DrawLooperTestContainer container;
 
@@ -493,6 +567,36 @@ TEST(DrawLooper, schedulesDraw) {
     ASSERT_FALSE(container.frameScheduler->runNextVSyncCallback());
 }
 
+TEST(DrawLooper, drawsWhenResolvingDamageOnDrawThread) {
+    DrawLooperTestContainer container;
+    container.drawLooper->setResolvesDamageOnDrawThread(true);
+
+    auto surfacePresenterManager = container.addLayerRootToLooper(container.layerRoot);
+
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    auto pixelBitmap = surfacePresenterManager->getSurfaceSinglePixelBitmap(0);
+
+    ASSERT_TRUE(pixelBitmap != nullptr);
+    ASSERT_EQ(Color::black(), pixelBitmap->getPixel());
+
+    // Emit more display lists than the entry holds before drawing
+    std::vector<Color> colors = {Color::red(), Color::green(), Color::blue(), Color::white(), Color::red()};
+    for (auto color : colors) {
+        container.frameScheduler->advanceTime(1.0);
+        container.layerRoot->getContentLayer()->setBackgroundColor(color);
+        ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    }
+
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+    ASSERT_EQ(Color::red(), pixelBitmap->getPixel());
+
+    container.frameScheduler->advanceTime(1.0);
+    ASSERT_FALSE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_FALSE(container.frameScheduler->runNextVSyncCallback());
+}
+
 TEST(DrawLooper, redrawsOnDrawableSurfaceChange) {
     DrawLooperTestContainer container;
 
@@ -756,6 +860,65 @@ TEST(DrawLooper, canSplitDrawingWhenUsingExternalSurface) {
     ASSERT_EQ(1.0, externalSurface->presenterState.value().opacity);
 }
 
+TEST(DrawLooper, canRecordPlanesInParallel) {
+    DrawLooperTestContainer container;
+    container.drawLooper->setRecordsPlanesInParallel(true);
+
+    auto surfacePresenterManager = makeShared<Test4PixelsBitmapSurfacePresenterManager>();
+    container.drawLooper->addLayerRoot(container.layerRoot, surfacePresenterManager, false);
+    container.layerRoot->getContentLayer()->setBackgroundColor(Color::blue());
+
+    auto beforeSiblingLayer = makeLayer<Layer>(container.resources);
+    beforeSiblingLayer->setBackgroundColor(Color::green());
+    beforeSiblingLayer->setFrame(Rect::makeXYWH(1, 1, 1, 1));
+
+    auto externalLayer = makeLayer<ExternalLayer>(container.resources);
+    externalLayer->setFrame(Rect::makeXYWH(1, 1, 2, 2));
+
+    auto afterSiblingLayer = makeLayer<Layer>(container.resources);
+    afterSiblingLayer->setBackgroundColor(Color::red());
+    afterSiblingLayer->setFrame(Rect::makeXYWH(2, 2, 1, 1));
+
+    container.layerRoot->getContentLayer()->addChild(beforeSiblingLayer);
+    container.layerRoot->getContentLayer()->addChild(externalLayer);
+    container.layerRoot->getContentLayer()->addChild(afterSiblingLayer);
+
+    container.layerRoot->setSize(Size::make(4, 4), 1);
+
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+    ASSERT_TRUE(container.frameScheduler->runNextVSyncCallback());
+
+    externalLayer->setExternalSurface(makeShared<TestExternalSurface>());
+    container.frameScheduler->advanceTime(1.0);
+
+    // Drawing is synchronous when the external surface is added
+    ASSERT_TRUE(container.frameScheduler->runNextMainThreadCallback());
+
+    ASSERT_EQ(static_cast<size_t>(3), surfacePresenterManager->getSurfaces().size());
+
+    auto backgroundBitmap = surfacePresenterManager->getSurfaceBitmap(0);
+    auto foregroundBitmap = surfacePresenterManager->getSurfaceBitmap(2);
+    ASSERT_TRUE(backgroundBitmap != nullptr);
+    ASSERT_TRUE(foregroundBitmap != nullptr);
+
+    // Each plane should only have its own content, as when drawn directly
+    ASSERT_EQ(*BitmapBuilder(4, 4)
+                   .row({Color::blue(), Color::blue(), Color::blue(), Color::blue()})
+                   .row({Color::blue(), Color::green(), Color::blue(), Color::blue()})
+                   .row({Color::blue(), Color::blue(), Color::blue(), Color::blue()})
+                   .row({Color::blue(), Color::blue(), Color::blue(), Color::blue()})
+                   .build(),
+              *backgroundBitmap);
+
+    ASSERT_EQ(*BitmapBuilder(4, 4)
+                   .row({Color::transparent(), Color::transparent(), Color::transparent(), Color::transparent()})
+                   .row({Color::transparent(), Color::transparent(), Color::transparent(), Color::transparent()})
+                   .row({Color::transparent(), Color::transparent(), Color::red(), Color::transparent()})
+                   .row({Color::transparent(), Color::transparent(), Color::transparent(), Color::transparent()})
+                   .build(),
+              *foregroundBitmap);
+}
+
 TEST(DrawLooper, drawsSynchronouslyWhenUpdatingPresenters) {
     DrawLooperTestContainer container;
 
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include "TestBitmap.hpp"
+#include "snap_drawing/cpp/Drawing/GradientShaderCache.hpp"
+#include "snap_drawing/cpp/Drawing/GraphicsContext/BitmapGraphicsContext.hpp"
+#include "snap_drawing/cpp/Drawing/LinearGradient.hpp"
+#include "snap_drawing/cpp/Drawing/RadialGradient.hpp"
+
+#include "include/core/SkCanvas.h"
+
+#include <cstdlib>
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static Ref<LinearGradient> makeLinearGradient(LinearGradientOrientation orientation, std::vector<Color> colors) {
+    auto gradient = makeShared<LinearGradient>();
+    gradient->setColors(std::move(colors));
+    gradient->setOrientation(orientation);
+    return gradient;
+}
+
+static Ref<RadialGradient> makeRadialGradient(std::vector<Color> colors, std::vector<Scalar> locations) {
+    auto gradient = makeShared<RadialGradient>();
+    gradient->setColors(std::move(colors));
+    gradient->setLocations(std::move(locations));
+    return gradient;
+}
+
+template<typename T>
+static Ref<TestBitmap> drawGradient(T& gradient, const Rect& bounds, GradientShaderCache* shaderCache) {
+    auto bitmap = makeShared<TestBitmap>(32, 32);
+    BitmapGraphicsContext graphicsContext;
+    auto surface = graphicsContext.createBitmapSurface(bitmap);
+    auto canvas = surface->prepareCanvas();
+    SC_ASSERT(canvas);
+
+    gradient.update(bounds, shaderCache);
+    Paint paint;
+    gradient.applyToPaint(paint);
+    canvas.value().getSkiaCanvas()->drawRect(bounds.getSkValue(), paint.getSkValue());
+    surface->flush();
+
+    return bitmap;
+}
+
+static bool isSameColor(Color left, Color right) {
+    // Allow for rounding differences from mapping the normalized shader to the bounds
+    return std::abs(left.getRed() - right.getRed()) <= 1 && std::abs(left.getGreen() - right.getGreen()) <= 1 &&
+           std::abs(left.getBlue() - right.getBlue()) <= 1 && std::abs(left.getAlpha() - right.getAlpha()) <= 1;
+}
+
+static void checkSameBitmaps(const TestBitmap& expected, const TestBitmap& actual) {
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            ASSERT_TRUE(isSameColor(expected.getPixel(x, y), actual.getPixel(x, y))) << "at " << x << "," << y;
+        }
+    }
+}
+
+TEST(GradientShaderCache, sharesShaderBetweenGradientsOfSameStyle) {
+    auto cache = makeShared<GradientShaderCache>(16);
+
+    auto gradient = makeLinearGradient(LinearGradientOrientationTopBottom, {Color::red(), Color::blue()});
+    gradient->update(Rect::makeXYWH(0, 0, 100, 40), cache.get());
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+
+    // Same style at a different size and position
+    auto otherGradient = makeLinearGradient(LinearGradientOrientationTopBottom, {Color::red(), Color::blue()});
+    otherGradient->update(Rect::makeXYWH(10, 20, 50, 200), cache.get());
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+
+    otherGradient->setColors({Color::red(), Color::green()});
+    otherGradient->update(Rect::makeXYWH(10, 20, 50, 200), cache.get());
+    ASSERT_EQ(static_cast<size_t>(2), cache->size());
+
+    otherGradient->setOrientation(LinearGradientOrientationLeftRight);
+    otherGradient->update(Rect::makeXYWH(10, 20, 50, 200), cache.get());
+    ASSERT_EQ(static_cast<size_t>(3), cache->size());
+}
+
+TEST(GradientShaderCache, keysDiagonalAndRadialGradientsByAspectRatio) {
+    auto cache = makeShared<GradientShaderCache>(16);
+
+    auto linearGradient =
+        makeLinearGradient(LinearGradientOrientationTopLeftBottomRight, {Color::red(), Color::blue()});
+    linearGradient->update(Rect::makeXYWH(0, 0, 100, 50), cache.get());
+    linearGradient->update(Rect::makeXYWH(0, 0, 200, 100), cache.get());
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+
+    linearGradient->update(Rect::makeXYWH(0, 0, 100, 100), cache.get());
+    ASSERT_EQ(static_cast<size_t>(2), cache->size());
+
+    auto radialGradient = makeRadialGradient({Color::red(), Color::blue()}, {0, 1});
+    radialGradient->update(Rect::makeXYWH(0, 0, 100, 50), cache.get());
+    radialGradient->update(Rect::makeXYWH(0, 0, 200, 100), cache.get());
+    ASSERT_EQ(static_cast<size_t>(3), cache->size());
+
+    radialGradient->update(Rect::makeXYWH(0, 0, 50, 100), cache.get());
+    ASSERT_EQ(static_cast<size_t>(4), cache->size());
+}
+
+TEST(GradientShaderCache, drawsSameLinearGradientsAsWithoutCache) {
+    auto cache = makeShared<GradientShaderCache>(16);
+    auto bounds = Rect::makeXYWH(3, 5, 24, 12);
+
+    for (int orientation = 0; orientation <= LinearGradientOrientationTopLeftBottomRight; orientation++) {
+        auto gradient = makeLinearGradient(static_cast<LinearGradientOrientation>(orientation),
+                                           {Color::red(), Color::green(), Color::blue()});
+        auto expectedBitmap = drawGradient(*gradient, bounds, nullptr);
+
+        auto cachedGradient = makeLinearGradient(static_cast<LinearGradientOrientation>(orientation),
+                                                 {Color::red(), Color::green(), Color::blue()});
+        auto bitmap = drawGradient(*cachedGradient, bounds, cache.get());
+
+        checkSameBitmaps(*expectedBitmap, *bitmap);
+    }
+}
+
+TEST(GradientShaderCache, drawsSameRadialGradientsAsWithoutCache) {
+    auto cache = makeShared<GradientShaderCache>(16);
+
+    for (const auto& bounds : {Rect::makeXYWH(3, 5, 24, 12), Rect::makeXYWH(5, 3, 12, 24)}) {
+        auto gradient = makeRadialGradient({Color::red(), Color::green(), Color::blue()}, {0, 0.3f, 1});
+        auto expectedBitmap = drawGradient(*gradient, bounds, nullptr);
+
+        auto cachedGradient = makeRadialGradient({Color::red(), Color::green(), Color::blue()}, {0, 0.3f, 1});
+        auto bitmap = drawGradient(*cachedGradient, bounds, cache.get());
+
+        checkSameBitmaps(*expectedBitmap, *bitmap);
+    }
+}
+
+TEST(GradientShaderCache, evictsLeastRecentlyUsed) {
+    auto cache = makeShared<GradientShaderCache>(2);
+
+    makeLinearGradient(LinearGradientOrientationTopBottom, {Color::red()})
+        ->update(Rect::makeXYWH(0, 0, 10, 10), cache.get());
+    makeLinearGradient(LinearGradientOrientationTopBottom, {Color::green()})
+        ->update(Rect::makeXYWH(0, 0, 10, 10), cache.get());
+    makeLinearGradient(LinearGradientOrientationTopBottom, {Color::blue()})
+        ->update(Rect::makeXYWH(0, 0, 10, 10), cache.get());
+
+    ASSERT_EQ(static_cast<size_t>(2), cache->size());
+
+    GradientShaderCacheKey key;
+    key.colors = {Color::red()};
+    ASSERT_EQ(nullptr, cache->find(key));
+
+    key.colors = {Color::blue()};
+    ASSERT_NE(nullptr, cache->find(key));
+}
+
+} // namespace snap::drawing
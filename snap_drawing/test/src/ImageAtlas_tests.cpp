@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Drawing/Raster/ImageAtlas.hpp"
+
+#include "include/core/SkPixmap.h"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static sk_sp<SkImage> makeImage(int width, int height, SkColor color) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(width, height);
+    bitmap.eraseColor(color);
+    bitmap.setImmutable();
+
+    return bitmap.asImage();
+}
+
+static SkColor getPageColor(const sk_sp<SkImage>& pageImage, Scalar x, Scalar y) {
+    SkPixmap pixmap;
+    if (!pageImage->peekPixels(&pixmap)) {
+        return SK_ColorTRANSPARENT;
+    }
+
+    return pixmap.getColor(static_cast<int>(x), static_cast<int>(y));
+}
+
+TEST(ImageAtlas, reusesSpriteOfSameImage) {
+    auto atlas = makeShared<ImageAtlas>(256, 2);
+    auto image = makeImage(16, 16, SK_ColorRED);
+
+    auto sprite1 = atlas->getOrInsert(image);
+    auto sprite2 = atlas->getOrInsert(image);
+
+    ASSERT_TRUE(sprite1 != nullptr);
+    ASSERT_TRUE(sprite2 != nullptr);
+    ASSERT_EQ(sprite1->getPageIndex(), sprite2->getPageIndex());
+    ASSERT_EQ(sprite1->getSlotIndex(), sprite2->getSlotIndex());
+    ASSERT_EQ(sprite1->getGeneration(), sprite2->getGeneration());
+    ASSERT_EQ(static_cast<size_t>(1), atlas->getSpritesCount());
+    ASSERT_EQ(static_cast<size_t>(1), atlas->getPagesCount());
+
+    auto sprite3 = atlas->getOrInsert(makeImage(16, 16, SK_ColorBLUE));
+
+    ASSERT_TRUE(sprite3 != nullptr);
+    ASSERT_EQ(sprite1->getPageIndex(), sprite3->getPageIndex());
+    ASSERT_NE(sprite1->getSlotIndex(), sprite3->getSlotIndex());
+    ASSERT_EQ(static_cast<size_t>(2), atlas->getSpritesCount());
+    ASSERT_EQ(static_cast<size_t>(1), atlas->getPagesCount());
+}
+
+TEST(ImageAtlas, rejectsLargeImages) {
+    auto atlas = makeShared<ImageAtlas>(256, 2);
+
+    ASSERT_TRUE(atlas->getOrInsert(makeImage(ImageAtlas::kMaxSpriteSize + 1, 8, SK_ColorRED)) == nullptr);
+    ASSERT_TRUE(atlas->getOrInsert(makeImage(8, ImageAtlas::kMaxSpriteSize + 1, SK_ColorRED)) == nullptr);
+    ASSERT_TRUE(atlas->getOrInsert(makeImage(ImageAtlas::kMaxSpriteSize, 8, SK_ColorRED)) != nullptr);
+}
+
+TEST(ImageAtlas, copiesImageWithExtrudedEdges) {
+    auto atlas = makeShared<ImageAtlas>(256, 2);
+    auto sprite = atlas->getOrInsert(makeImage(10, 20, SK_ColorRED));
+
+    ASSERT_TRUE(sprite != nullptr);
+
+    sk_sp<SkImage> pageImage;
+    Rect textureRect;
+    ASSERT_TRUE(atlas->resolve(*sprite, pageImage, textureRect));
+    ASSERT_TRUE(pageImage != nullptr);
+
+    ASSERT_EQ(10.0f, textureRect.width());
+    ASSERT_EQ(20.0f, textureRect.height());
+
+    ASSERT_EQ(SK_ColorRED, getPageColor(pageImage, textureRect.left, textureRect.top));
+    ASSERT_EQ(SK_ColorRED, getPageColor(pageImage, textureRect.right - 1, textureRect.bottom - 1));
+    // Gutter
+    ASSERT_EQ(SK_ColorRED, getPageColor(pageImage, textureRect.left - 1, textureRect.top - 1));
+    ASSERT_EQ(SK_ColorRED, getPageColor(pageImage, textureRect.right, textureRect.bottom));
+    // Outside of the cell
+    ASSERT_EQ(SK_ColorTRANSPARENT, getPageColor(pageImage, textureRect.right + 1, textureRect.top));
+}
+
+TEST(ImageAtlas, evictsLeastRecentlyUsedSprite) {
+    // Fits 2x2 cells of the smallest size class
+    auto atlas = makeShared<ImageAtlas>(68, 1);
+
+    std::vector<Ref<ImageAtlasSprite>> sprites;
+    for (size_t i = 0; i < 4; i++) {
+        auto sprite = atlas->getOrInsert(makeImage(32, 32, SK_ColorRED));
+        ASSERT_TRUE(sprite != nullptr);
+        sprites.emplace_back(sprite);
+    }
+    ASSERT_EQ(static_cast<size_t>(4), atlas->getSpritesCount());
+
+    sk_sp<SkImage> pageImage;
+    Rect textureRect;
+    // Mark the first sprite as used, which makes the second one the least recently used
+    ASSERT_TRUE(atlas->resolve(*sprites[0], pageImage, textureRect));
+
+    auto newSprite = atlas->getOrInsert(makeImage(32, 32, SK_ColorBLUE));
+
+    ASSERT_TRUE(newSprite != nullptr);
+    ASSERT_EQ(sprites[1]->getSlotIndex(), newSprite->getSlotIndex());
+    ASSERT_EQ(static_cast<size_t>(4), atlas->getSpritesCount());
+    ASSERT_EQ(static_cast<size_t>(1), atlas->getPagesCount());
+
+    ASSERT_TRUE(atlas->resolve(*sprites[0], pageImage, textureRect));
+    ASSERT_FALSE(atlas->resolve(*sprites[1], pageImage, textureRect));
+    ASSERT_TRUE(atlas->resolve(*newSprite, pageImage, textureRect));
+    ASSERT_EQ(SK_ColorBLUE, getPageColor(pageImage, textureRect.left, textureRect.top));
+}
+
+TEST(ImageAtlas, clearInvalidatesSprites) {
+    auto atlas = makeShared<ImageAtlas>(256, 2);
+    auto sprite = atlas->getOrInsert(makeImage(16, 16, SK_ColorRED));
+
+    ASSERT_TRUE(sprite != nullptr);
+
+    atlas->clear();
+
+    ASSERT_EQ(static_cast<size_t>(0), atlas->getSpritesCount());
+    ASSERT_EQ(static_cast<size_t>(0), atlas->getPagesCount());
+
+    auto newSprite = atlas->getOrInsert(makeImage(16, 16, SK_ColorBLUE));
+    ASSERT_TRUE(newSprite != nullptr);
+    ASSERT_EQ(sprite->getPageIndex(), newSprite->getPageIndex());
+    ASSERT_EQ(sprite->getSlotIndex(), newSprite->getSlotIndex());
+
+    sk_sp<SkImage> pageImage;
+    Rect textureRect;
+    ASSERT_FALSE(atlas->resolve(*sprite, pageImage, textureRect));
+    ASSERT_TRUE(atlas->resolve(*newSprite, pageImage, textureRect));
+}
+
+} // namespace snap::drawing
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "snap_drawing/cpp/Animations/InterpolationFunction.hpp"
 #include "snap_drawing/cpp/Animations/ValueInterpolators.hpp"
 #include "snap_drawing/cpp/Utils/BorderRadius.hpp"
 
@@ -65,4 +66,16 @@ TEST(InterpolatorTest, canInterpolatePointToPercentBorderRadius) {
     ASSERT_EQ("[17.5%, 26.2%, 35.0%, 43.8%]", threeQuartersProgressInterpolated.toString());
 }
 
+TEST(InterpolatorTest, cubicBezierMatchesPresetCurveWithSameControlPoints) {
+    auto customCurve = InterpolationFunctions::cubicBezier(0.42, 0.0, 0.58, 1.0);
+    auto presetCurve = InterpolationFunctions::easeInOut();
+
+    for (auto ratio : {0.0, 0.25, 0.5, 0.75, 1.0}) {
+        ASSERT_DOUBLE_EQ(presetCurve(ratio), customCurve(ratio));
+    }
+
+    ASSERT_NEAR(0.0, customCurve(0.0), 0.0001);
+    ASSERT_NEAR(1.0, customCurve(1.0), 0.0001);
+}
+
 } // namespace snap::drawing
@@ -399,4 +399,197 @@ TEST_F(LayerTests, canDrawMaskAboveBackground) {
     ASSERT_EQ(Operations::ApplyMask::kId, operations[3]->type);
 }
 
+TEST_F(LayerTests, reusesOperationsOfUnchangedSubtreeFromPreviousDisplayList) {
+    auto container1 = createLayer();
+    auto child1 = createLayer();
+    auto container2 = createLayer();
+
+    _root->setFrame(Rect::makeXYWH(0, 0, 40, 40));
+    container1->setFrame(Rect::makeXYWH(0, 0, 20, 20));
+    child1->setFrame(Rect::makeXYWH(0, 0, 10, 10));
+    child1->setBackgroundColor(Color::red());
+    container2->setFrame(Rect::makeXYWH(20, 20, 20, 20));
+    container2->setBackgroundColor(Color::blue());
+
+    _root->addChild(container1);
+    container1->addChild(child1);
+    _root->addChild(container2);
+
+    auto previousDisplayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    DrawMetrics metrics;
+    _root->draw(*previousDisplayList, metrics);
+
+    ASSERT_EQ(0, metrics.reusedSubtrees);
+    ASSERT_EQ(4, metrics.visitedLayers);
+
+    container2->setBackgroundColor(Color::green());
+
+    auto displayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    displayList->setPreviousDisplayList(previousDisplayList);
+    metrics = DrawMetrics();
+    _root->draw(*displayList, metrics);
+
+    ASSERT_EQ(1, metrics.reusedSubtrees);
+    ASSERT_EQ(3, metrics.visitedLayers);
+    ASSERT_EQ(1, metrics.drawCacheMiss);
+
+    auto previousOperations = getOperationsFromDisplayList(previousDisplayList, 0);
+    auto operations = getOperationsFromDisplayList(displayList, 0);
+
+    ASSERT_EQ(static_cast<size_t>(10), operations.size());
+    ASSERT_EQ(previousOperations.size(), operations.size());
+    for (size_t i = 0; i < operations.size(); i++) {
+        ASSERT_EQ(previousOperations[i]->type, operations[i]->type);
+    }
+
+    // The operations of the child were copied from the previous DisplayList
+    ASSERT_FALSE(reinterpret_cast<const Operations::PushContext*>(operations[2])->hasUpdates);
+    ASSERT_EQ(reinterpret_cast<const Operations::DrawPicture*>(previousOperations[3])->picture,
+              reinterpret_cast<const Operations::DrawPicture*>(operations[3])->picture);
+
+    // The operations of the changed layer were recorded again
+    ASSERT_TRUE(reinterpret_cast<const Operations::PushContext*>(operations[6])->hasUpdates);
+    ASSERT_NE(reinterpret_cast<const Operations::DrawPicture*>(previousOperations[7])->picture,
+              reinterpret_cast<const Operations::DrawPicture*>(operations[7])->picture);
+
+    // The copied operations retained their pictures, and can be copied again
+    displayList->setPreviousDisplayList(nullptr);
+    previousDisplayList = nullptr;
+    previousOperations.clear();
+    container2->setBackgroundColor(Color::red());
+
+    auto nextDisplayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    nextDisplayList->setPreviousDisplayList(displayList);
+    metrics = DrawMetrics();
+    _root->draw(*nextDisplayList, metrics);
+
+    ASSERT_EQ(1, metrics.reusedSubtrees);
+    auto nextOperations = getOperationsFromDisplayList(nextDisplayList, 0);
+    ASSERT_EQ(reinterpret_cast<const Operations::DrawPicture*>(operations[3])->picture,
+              reinterpret_cast<const Operations::DrawPicture*>(nextOperations[3])->picture);
+}
+
+TEST_F(LayerTests, reusesOperationsOfLayerWithOnlyTransformOrOpacityChanges) {
+    auto container = createLayer();
+    auto child = createLayer();
+
+    _root->setFrame(Rect::makeXYWH(0, 0, 40, 40));
+    container->setFrame(Rect::makeXYWH(0, 0, 20, 20));
+    container->setBackgroundColor(Color::blue());
+    child->setFrame(Rect::makeXYWH(0, 0, 10, 10));
+    child->setBackgroundColor(Color::red());
+
+    _root->addChild(container);
+    container->addChild(child);
+
+    auto previousDisplayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    DrawMetrics metrics;
+    _root->draw(*previousDisplayList, metrics);
+
+    container->setTranslationX(5);
+    container->setRotation(0.5);
+    container->setFrame(Rect::makeXYWH(10, 10, 20, 20));
+    ASSERT_FALSE(container->needsDisplay());
+    ASSERT_FALSE(container->childNeedsDisplay());
+    ASSERT_TRUE(_root->childNeedsDisplay());
+
+    auto displayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    displayList->setPreviousDisplayList(previousDisplayList);
+    metrics = DrawMetrics();
+    _root->draw(*displayList, metrics);
+
+    ASSERT_EQ(1, metrics.reusedSubtrees);
+    ASSERT_EQ(2, metrics.visitedLayers);
+    ASSERT_EQ(0, metrics.drawCacheMiss);
+
+    // The opacity of a layer with children is applied on its context
+    container->setOpacity(0.5f);
+    ASSERT_FALSE(container->childNeedsDisplay());
+
+    auto nextDisplayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    nextDisplayList->setPreviousDisplayList(displayList);
+    metrics = DrawMetrics();
+    _root->draw(*nextDisplayList, metrics);
+
+    ASSERT_EQ(1, metrics.reusedSubtrees);
+    ASSERT_EQ(0, metrics.drawCacheMiss);
+
+    // The opacity of a leaf layer is baked into its pictures
+    child->setOpacity(0.5f);
+    ASSERT_TRUE(child->childNeedsDisplay());
+}
+
+TEST_F(LayerTests, doesNotReuseOperationsFromUnrelatedDisplayList) {
+    auto child = createLayer();
+    child->setFrame(Rect::makeXYWH(0, 0, 10, 10));
+    child->setBackgroundColor(Color::red());
+    _root->setFrame(Rect::makeXYWH(0, 0, 20, 20));
+    _root->addChild(child);
+
+    auto displayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    DrawMetrics metrics;
+    _root->draw(*displayList, metrics);
+
+    _root->setBackgroundColor(Color::blue());
+
+    auto nextDisplayList = makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0));
+    nextDisplayList->setPreviousDisplayList(makeShared<DisplayList>(Size(), TimePoint::fromSeconds(0.0)));
+    metrics = DrawMetrics();
+    _root->draw(*nextDisplayList, metrics);
+
+    ASSERT_EQ(0, metrics.reusedSubtrees);
+    ASSERT_EQ(2, metrics.visitedLayers);
+}
+
+TEST_F(LayerTests, findsHitChildWithManyChildren) {
+    _root->setFrame(Rect::makeXYWH(0, 0, 1000, 1000));
+
+    // Enough children for the layer to look them up from its hit test index
+    std::vector<Ref<Layer>> children;
+    for (size_t i = 0; i < 32; i++) {
+        auto child = createLayer();
+        child->setFrame(Rect::makeXYWH(static_cast<Scalar>(i) * 20, 0, 20, 20));
+        _root->addChild(child);
+        children.emplace_back(child);
+    }
+
+    ASSERT_EQ(children[0], _root->getChildAtPoint(Point::make(10, 10)));
+    ASSERT_EQ(children[5], _root->getChildAtPoint(Point::make(110, 10)));
+    ASSERT_EQ(nullptr, _root->getChildAtPoint(Point::make(110, 30)));
+
+    // Bounds are inclusive, the last sibling is on top
+    ASSERT_EQ(children[6], _root->getChildAtPoint(Point::make(120, 10)));
+
+    // Moving a child updates the index
+    children[5]->setFrame(Rect::makeXYWH(100, 100, 20, 20));
+    ASSERT_EQ(nullptr, _root->getChildAtPoint(Point::make(105, 10)));
+    ASSERT_EQ(children[5], _root->getChildAtPoint(Point::make(110, 110)));
+
+    children[5]->setTranslationY(100);
+    ASSERT_EQ(nullptr, _root->getChildAtPoint(Point::make(110, 110)));
+    ASSERT_EQ(children[5], _root->getChildAtPoint(Point::make(110, 210)));
+
+    children[5]->setTouchAreaExtension(0, 0, 0, 20);
+    ASSERT_EQ(children[5], _root->getChildAtPoint(Point::make(110, 235)));
+
+    // Hit tests are still exact for the layers which are in the index
+    children[5]->setTouchEnabled(false);
+    ASSERT_EQ(nullptr, _root->getChildAtPoint(Point::make(110, 210)));
+
+    // Inserting and removing children updates the index
+    auto topChild = createLayer();
+    topChild->setFrame(Rect::makeXYWH(0, 0, 40, 40));
+    _root->addChild(topChild);
+    ASSERT_EQ(topChild, _root->getChildAtPoint(Point::make(10, 10)));
+
+    topChild->removeFromParent();
+    ASSERT_EQ(children[0], _root->getChildAtPoint(Point::make(10, 10)));
+
+    children[0]->removeFromParent();
+    ASSERT_EQ(nullptr, _root->getChildAtPoint(Point::make(10, 10)));
+    ASSERT_EQ(children[1], _root->getChildAtPoint(Point::make(30, 10)));
+
+    ASSERT_EQ(children[1], _root->getLayerAtPoint(Point::make(30, 10)));
+}
+
 } // namespace snap::drawing
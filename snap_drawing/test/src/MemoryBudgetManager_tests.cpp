@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Utils/MemoryBudgetManager.hpp"
+
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+namespace snap::drawing {
+
+TEST(MemoryBudgetManager, reportsUsageOfRegisteredConsumers) {
+    auto manager = Valdi::makeShared<MemoryBudgetManager>();
+
+    manager->registerConsumer(
+        STRING_LITERAL("images"), []() -> size_t { return 100; }, [](MemoryPressureLevel /*level*/) {});
+    manager->registerConsumer(
+        STRING_LITERAL("text"), []() -> size_t { return 20; }, [](MemoryPressureLevel /*level*/) {});
+
+    auto usage = manager->getMemoryUsage();
+    ASSERT_EQ(static_cast<size_t>(2), usage.size());
+    ASSERT_EQ(STRING_LITERAL("images"), usage[0].name);
+    ASSERT_EQ(static_cast<size_t>(100), usage[0].sizeInBytes);
+    ASSERT_EQ(STRING_LITERAL("text"), usage[1].name);
+    ASSERT_EQ(static_cast<size_t>(20), usage[1].sizeInBytes);
+    ASSERT_EQ(static_cast<size_t>(120), manager->getTotalSizeInBytes());
+
+    manager->unregisterConsumer(STRING_LITERAL("images"));
+    ASSERT_EQ(static_cast<size_t>(20), manager->getTotalSizeInBytes());
+}
+
+TEST(MemoryBudgetManager, dispatchesMemoryPressureToConsumers) {
+    auto manager = Valdi::makeShared<MemoryBudgetManager>();
+    size_t sizeInBytes = 100;
+    std::vector<MemoryPressureLevel> levels;
+
+    manager->registerConsumer(
+        STRING_LITERAL("images"),
+        [&]() { return sizeInBytes; },
+        [&](MemoryPressureLevel level) {
+            levels.emplace_back(level);
+            sizeInBytes = level == MemoryPressureLevel::Critical ? 0 : sizeInBytes / 2;
+        });
+
+    manager->onMemoryPressure(MemoryPressureLevel::Moderate);
+    ASSERT_EQ(static_cast<size_t>(50), manager->getTotalSizeInBytes());
+
+    manager->onMemoryPressure(MemoryPressureLevel::Critical);
+    ASSERT_EQ(static_cast<size_t>(0), manager->getTotalSizeInBytes());
+
+    std::vector<MemoryPressureLevel> expectedLevels = {MemoryPressureLevel::Moderate, MemoryPressureLevel::Critical};
+    ASSERT_EQ(expectedLevels, levels);
+}
+
+TEST(MemoryBudgetManager, registeringTwiceReplacesConsumer) {
+    auto manager = Valdi::makeShared<MemoryBudgetManager>();
+
+    manager->registerConsumer(
+        STRING_LITERAL("images"), []() -> size_t { return 100; }, [](MemoryPressureLevel /*level*/) {});
+    manager->registerConsumer(
+        STRING_LITERAL("images"), []() -> size_t { return 10; }, [](MemoryPressureLevel /*level*/) {});
+
+    ASSERT_EQ(static_cast<size_t>(1), manager->getMemoryUsage().size());
+    ASSERT_EQ(static_cast<size_t>(10), manager->getTotalSizeInBytes());
+}
+
+} // namespace snap::drawing
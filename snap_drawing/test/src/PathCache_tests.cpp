@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Utils/PathCache.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static BytesView makePathData(std::initializer_list<Byte> bytes) {
+    auto data = makeShared<Bytes>();
+    data->assignData(bytes.begin(), bytes.size());
+    return BytesView(data);
+}
+
+static Path makeTrianglePath() {
+    Path path;
+    path.moveTo(0, 0);
+    path.lineTo(10, 0);
+    path.lineTo(10, 10);
+    path.close();
+    return path;
+}
+
+TEST(PathCache, canInsertAndFind) {
+    auto cache = makeShared<PathCache>(16);
+    auto key = PathCacheKey(makePathData({1, 2, 3}), Size::make(10, 10));
+
+    ASSERT_FALSE(cache->find(key).has_value());
+
+    cache->insert(key, makeTrianglePath());
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+
+    auto path = cache->find(key);
+    ASSERT_TRUE(path.has_value());
+    ASSERT_EQ(makeTrianglePath(), path.value());
+
+    ASSERT_FALSE(cache->find(PathCacheKey(makePathData({1, 2, 3}), Size::make(20, 10))).has_value());
+    ASSERT_FALSE(cache->find(PathCacheKey(makePathData({1, 2, 4}), Size::make(10, 10))).has_value());
+}
+
+TEST(PathCache, sharesGeometryBetweenEqualPathData) {
+    auto cache = makeShared<PathCache>(16);
+    cache->insert(PathCacheKey(makePathData({1, 2, 3}), Size::make(10, 10)), makeTrianglePath());
+
+    // Equal path data coming from a different buffer
+    auto first = cache->find(PathCacheKey(makePathData({1, 2, 3}), Size::make(10, 10)));
+    auto second = cache->find(PathCacheKey(makePathData({1, 2, 3}), Size::make(10, 10)));
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+
+    ASSERT_EQ(first.value().getGenerationId(), second.value().getGenerationId());
+    ASSERT_NE(makeTrianglePath().getGenerationId(), first.value().getGenerationId());
+}
+
+TEST(PathCache, evictsLeastRecentlyUsed) {
+    auto cache = makeShared<PathCache>(2);
+    cache->insert(PathCacheKey(makePathData({1}), Size::make(10, 10)), makeTrianglePath());
+    cache->insert(PathCacheKey(makePathData({2}), Size::make(10, 10)), makeTrianglePath());
+
+    ASSERT_TRUE(cache->find(PathCacheKey(makePathData({1}), Size::make(10, 10))).has_value());
+
+    cache->insert(PathCacheKey(makePathData({3}), Size::make(10, 10)), makeTrianglePath());
+
+    ASSERT_EQ(static_cast<size_t>(2), cache->size());
+    ASSERT_TRUE(cache->find(PathCacheKey(makePathData({1}), Size::make(10, 10))).has_value());
+    ASSERT_FALSE(cache->find(PathCacheKey(makePathData({2}), Size::make(10, 10))).has_value());
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Drawing/PerformanceOverlay.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static FrameTimings makeFrame(int drawMs) {
+    FrameTimings timings;
+    timings.add(FramePhase::Draw, std::chrono::milliseconds(drawMs));
+    return timings;
+}
+
+TEST(PerformanceOverlay, keepsMostRecentFramesInOrder) {
+    auto overlay = makeShared<PerformanceOverlay>(3);
+
+    for (int i = 1; i <= 5; i++) {
+        overlay->onFrameRecorded(StringBox(), makeFrame(i));
+    }
+
+    auto frames = overlay->getFrames();
+    ASSERT_EQ(static_cast<size_t>(3), frames.size());
+    ASSERT_EQ(FrameDuration(std::chrono::milliseconds(3)), frames[0].get(FramePhase::Draw));
+    ASSERT_EQ(FrameDuration(std::chrono::milliseconds(4)), frames[1].get(FramePhase::Draw));
+    ASSERT_EQ(FrameDuration(std::chrono::milliseconds(5)), frames[2].get(FramePhase::Draw));
+}
+
+TEST(PerformanceOverlay, dropsFramesWhenDisabled) {
+    auto overlay = makeShared<PerformanceOverlay>(3);
+    overlay->onFrameRecorded(StringBox(), makeFrame(1));
+
+    overlay->setEnabled(false);
+    ASSERT_TRUE(overlay->getFrames().empty());
+
+    overlay->onFrameRecorded(StringBox(), makeFrame(2));
+    ASSERT_TRUE(overlay->getFrames().empty());
+
+    overlay->setEnabled(true);
+    overlay->onFrameRecorded(StringBox(), makeFrame(3));
+    ASSERT_EQ(static_cast<size_t>(1), overlay->getFrames().size());
+}
+
+TEST(PerformanceOverlay, rerecordsPictureOnlyWhenFramesOrSizeChange) {
+    auto overlay = makeShared<PerformanceOverlay>();
+    overlay->onFrameRecorded(StringBox(), makeFrame(20));
+
+    auto picture = overlay->getPicture(Size::make(200, 400));
+    ASSERT_TRUE(picture != nullptr);
+    ASSERT_EQ(picture.get(), overlay->getPicture(Size::make(200, 400)).get());
+
+    auto resizedPicture = overlay->getPicture(Size::make(300, 400));
+    ASSERT_NE(picture.get(), resizedPicture.get());
+
+    overlay->onFrameRecorded(StringBox(), makeFrame(4));
+    ASSERT_NE(resizedPicture.get(), overlay->getPicture(Size::make(300, 400)).get());
+
+    // Nothing to draw in a surface smaller than the margins
+    ASSERT_TRUE(overlay->getPicture(Size::make(10, 10)) == nullptr);
+}
+
+} // namespace snap::drawing
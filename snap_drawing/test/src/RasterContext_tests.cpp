@@ -5,6 +5,7 @@
 #include "TestBitmap.hpp"
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
 #include "snap_drawing/cpp/Drawing/GraphicsContext/BitmapGraphicsContext.hpp"
+#include "snap_drawing/cpp/Drawing/Raster/LayerRasterCache.hpp"
 #include "snap_drawing/cpp/Drawing/Raster/RasterContext.hpp"
 #include "snap_drawing/cpp/Layers/ExternalLayer.hpp"
 #include "snap_drawing/cpp/Layers/Interfaces/ILayerRoot.hpp"
@@ -49,6 +50,14 @@ public:
         return false;
     }
 
+    bool shouldPresentVideoInCompositorPlane() const final {
+        return false;
+    }
+
+    bool hasTimeRemainingInFrame() const final {
+        return true;
+    }
+
     void onInitialize() final {}
     void setChildNeedsDisplay() final {}
     void requestLayout(ILayer* layer) final {}
@@ -670,4 +679,212 @@ TEST_F(RasterContextTests, canRasterWithInternalDeltaModeAndNoClear) {
     ASSERT_EQ(9, result.value().renderedPixelsCount);
 }
 
-} // namespace snap::drawing
\ No newline at end of file
+TEST_F(RasterContextTests, canRasterInParallelBands) {
+    _contentLayer->setBackgroundColor(Color::red());
+
+    auto centerLayer = makeLayer<Layer>(_resources);
+    centerLayer->setBackgroundColor(Color::blue());
+    centerLayer->setFrame(Rect::makeXYWH(1, 1, 2, 2));
+    _contentLayer->addChild(centerLayer);
+
+    // Overlaps all the bands and goes through a save layer
+    auto translucentLayer = makeLayer<Layer>(_resources);
+    translucentLayer->setBackgroundColor(Color::green());
+    translucentLayer->setOpacity(0.5f);
+    translucentLayer->setFrame(Rect::makeXYWH(0.5f, 0.5f, 1, 3));
+    _contentLayer->addChild(translucentLayer);
+    _contentLayer->setFrame(Rect::makeXYWH(0, 0, 4, 4));
+
+    auto expectedBitmap = makeShared<TestBitmap>(512, 512);
+    auto result = rasterInto(expectedBitmap);
+    ASSERT_TRUE(result) << result.description();
+
+    _rasterContext->setParallelRasterizationEnabled(true);
+
+    auto outputBitmap = makeShared<TestBitmap>(512, 512);
+    result = rasterInto(outputBitmap);
+    ASSERT_TRUE(result) << result.description();
+
+    ASSERT_EQ(*expectedBitmap, *outputBitmap);
+    ASSERT_EQ(Color::blue(), outputBitmap->getPixel(256, 256));
+    ASSERT_EQ(512 * 512, result.value().renderedPixelsCount);
+}
+
+TEST_F(RasterContextTests, canRasterDeltaInParallelBands) {
+    _contentLayer->setBackgroundColor(Color::red());
+
+    auto centerLayer = makeLayer<Layer>(_resources);
+    centerLayer->setBackgroundColor(Color::blue());
+    centerLayer->setFrame(Rect::makeXYWH(1, 1, 2, 2));
+    _contentLayer->addChild(centerLayer);
+    _contentLayer->setFrame(Rect::makeXYWH(0, 0, 4, 4));
+
+    auto serialRasterContext =
+        makeShared<RasterContext>(_resources->getLogger(), ExternalSurfaceRasterizationMethod::ACCURATE, false);
+    _rasterContext->setParallelRasterizationEnabled(true);
+
+    auto expectedBitmap = makeShared<TestBitmap>(512, 512);
+    auto outputBitmap = makeShared<TestBitmap>(512, 512);
+
+    auto rasterBoth = [&]() {
+        auto displayList = Valdi::makeShared<DisplayList>(_contentLayer->getFrame().size(), TimePoint(0.0));
+        DrawMetrics metrics;
+        _contentLayer->draw(*displayList, metrics);
+
+        auto expectedResult = serialRasterContext->rasterDelta(displayList, expectedBitmap);
+        auto result = _rasterContext->rasterDelta(displayList, outputBitmap);
+        ASSERT_TRUE(expectedResult) << expectedResult.description();
+        ASSERT_TRUE(result) << result.description();
+        ASSERT_EQ(expectedResult.value().renderedPixelsCount, result.value().renderedPixelsCount);
+    };
+
+    rasterBoth();
+    ASSERT_EQ(*expectedBitmap, *outputBitmap);
+
+    // Only the center layer is damaged, the rest of the bitmap must be left untouched
+    auto blackRow = std::vector<Color>(512, Color::black());
+    for (int y = 0; y < 512; y++) {
+        expectedBitmap->setPixelsRow(y, blackRow.data());
+        outputBitmap->setPixelsRow(y, blackRow.data());
+    }
+    centerLayer->setBackgroundColor(Color::green());
+
+    rasterBoth();
+    ASSERT_EQ(*expectedBitmap, *outputBitmap);
+    ASSERT_EQ(Color::green(), outputBitmap->getPixel(256, 256));
+    ASSERT_EQ(Color::black(), outputBitmap->getPixel(0, 0));
+}
+
+TEST_F(RasterContextTests, canRasterFromLayerRasterCache) {
+    auto layerRasterCache = makeShared<LayerRasterCache>(1024 * 1024, 2);
+    _resources->setLayerRasterCache(layerRasterCache);
+
+    _contentLayer->setBackgroundColor(Color::red());
+
+    auto containerLayer = makeLayer<Layer>(_resources);
+    containerLayer->setClipsToBounds(true);
+    containerLayer->setFrame(Rect::makeXYWH(0, 0, 4, 4));
+    _contentLayer->addChild(containerLayer);
+
+    auto centerLayer = makeLayer<Layer>(_resources);
+    centerLayer->setBackgroundColor(Color::blue());
+    centerLayer->setFrame(Rect::makeXYWH(1, 1, 2, 2));
+    containerLayer->addChild(centerLayer);
+    _contentLayer->setFrame(Rect::makeXYWH(0, 0, 4, 4));
+
+    auto expectedPixels = std::initializer_list<Color>({
+        // clang-format off
+        Color::red(), Color::red(), Color::red(), Color::red(),
+        Color::red(), Color::blue(), Color::blue(), Color::red(),
+        Color::red(), Color::blue(), Color::blue(), Color::red(),
+        Color::red(), Color::red(), Color::red(), Color::red(),
+        // clang-format on
+    });
+
+    for (size_t i = 0; i < 5; i++) {
+        auto result = raster();
+        ASSERT_TRUE(result) << result.description();
+        ASSERT_EQ(*result.value(), expectedPixels);
+    }
+
+    // Only the clipped container is eligible
+    ASSERT_EQ(static_cast<size_t>(1), layerRasterCache->size());
+    ASSERT_EQ(static_cast<size_t>(4 * 4 * 4), layerRasterCache->getUsedBytes());
+
+    centerLayer->setBackgroundColor(Color::green());
+
+    auto result = raster();
+    ASSERT_TRUE(result) << result.description();
+    ASSERT_EQ(*result.value(),
+              std::initializer_list<Color>({
+                  // clang-format off
+                  Color::red(), Color::red(), Color::red(), Color::red(),
+                  Color::red(), Color::green(), Color::green(), Color::red(),
+                  Color::red(), Color::green(), Color::green(), Color::red(),
+                  Color::red(), Color::red(), Color::red(), Color::red(),
+                  // clang-format on
+              }));
+
+    ASSERT_EQ(static_cast<size_t>(0), layerRasterCache->size());
+}
+
+TEST_F(RasterContextTests, layerRasterCacheEvictsLeastRecentlyUsed) {
+    // Room for two 4x4 images
+    LayerRasterCache layerRasterCache(2 * 4 * 4 * 4, 0);
+    auto bounds = Rect::makeXYWH(0, 0, 4, 4);
+
+    SkPictureRecorder recorder;
+    recorder.beginRecording(bounds.getSkValue());
+    auto picture = recorder.finishRecordingAsPicture();
+
+    ASSERT_FALSE(layerRasterCache.insert(1, picture, bounds, 1.0f).isEmpty());
+    ASSERT_FALSE(layerRasterCache.insert(2, picture, bounds, 1.0f).isEmpty());
+    ASSERT_FALSE(layerRasterCache.find(1).isEmpty());
+    ASSERT_FALSE(layerRasterCache.insert(3, picture, bounds, 1.0f).isEmpty());
+
+    ASSERT_FALSE(layerRasterCache.find(1).isEmpty());
+    ASSERT_TRUE(layerRasterCache.find(2).isEmpty());
+    ASSERT_FALSE(layerRasterCache.find(3).isEmpty());
+
+    // Larger than the whole budget
+    ASSERT_TRUE(layerRasterCache.insert(4, picture, bounds, 2.0f).isEmpty());
+    ASSERT_EQ(static_cast<size_t>(2), layerRasterCache.size());
+}
+
+TEST_F(RasterContextTests, shiftsScrolledContentWithInternalDeltaMode) {
+    _rasterContext =
+        makeShared<RasterContext>(_resources->getLogger(), ExternalSurfaceRasterizationMethod::ACCURATE, true);
+
+    auto outputBitmap = makeShared<TestBitmap>(4, 4);
+
+    _contentLayer->setBackgroundColor(Color::red());
+    _contentLayer->setClipsToBounds(true);
+    _contentLayer->setFrame(Rect::makeXYWH(0, 0, 4, 4));
+
+    auto scrollContentLayer = makeLayer<Layer>(_resources);
+    scrollContentLayer->setFrame(Rect::makeXYWH(0, 0, 4, 8));
+    _contentLayer->addChild(scrollContentLayer);
+
+    auto addRow = [&](Scalar y, Color color) {
+        auto row = makeLayer<Layer>(_resources);
+        row->setBackgroundColor(color);
+        row->setFrame(Rect::makeXYWH(0, y, 4, 1));
+        scrollContentLayer->addChild(row);
+    };
+    addRow(0, Color::blue());
+    addRow(2, Color::green());
+    addRow(4, Color::blue());
+
+    auto result = rasterInto(outputBitmap);
+    ASSERT_TRUE(result) << result.description();
+
+    ASSERT_EQ(*outputBitmap,
+              std::initializer_list<Color>({
+                  // clang-format off
+                Color::blue(), Color::blue(), Color::blue(), Color::blue(),
+                Color::red(), Color::red(), Color::red(), Color::red(),
+                Color::green(), Color::green(), Color::green(), Color::green(),
+                Color::red(), Color::red(), Color::red(), Color::red(),
+                  // clang-format on
+              }));
+
+    // Scroll by one pixel, only the exposed row should be rasterized
+    scrollContentLayer->setFrame(Rect::makeXYWH(0, -1, 4, 8));
+
+    result = rasterInto(outputBitmap);
+    ASSERT_TRUE(result) << result.description();
+
+    ASSERT_EQ(*outputBitmap,
+              std::initializer_list<Color>({
+                  // clang-format off
+                Color::red(), Color::red(), Color::red(), Color::red(),
+                Color::green(), Color::green(), Color::green(), Color::green(),
+                Color::red(), Color::red(), Color::red(), Color::red(),
+                Color::blue(), Color::blue(), Color::blue(), Color::blue(),
+                  // clang-format on
+              }));
+
+    ASSERT_EQ(4, result.value().renderedPixelsCount);
+}
+
+} // namespace snap::drawing
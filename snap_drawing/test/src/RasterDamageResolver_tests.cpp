@@ -21,6 +21,33 @@ protected:
         _damageResolver.addDamageFromDisplayListUpdates(*_builder.displayList);
         return _damageResolver.endUpdates();
     }
+
+    void background(Size size) {
+        DrawingContext drawingContext(size.width, size.height);
+        Paint paint;
+        paint.setColor(Color::red());
+        drawingContext.drawPaint(paint, drawingContext.drawBounds());
+
+        auto content = drawingContext.finish();
+        content.opaqueRect = Rect::makeXYWH(0, 0, size.width, size.height);
+        _builder.layerContent(content, 1.0);
+    }
+
+    // A scroll layer of 100x80 with two items, above a layer outside of it
+    void drawScrollScene(Scalar contentOffset, bool firstItemHasUpdates) {
+        _builder = DisplayListBuilder(100, 100);
+        _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+            background(Size(100, 80));
+            _builder.clip(Size(100, 80));
+            _builder.context(Vector(0, -contentOffset), 1.0, 2, false, [&]() {
+                _builder.context(Vector(10, 10), 1.0, 3, firstItemHasUpdates, [&]() {
+                    _builder.rectangle(Size(80, 40), 1.0);
+                });
+                _builder.context(Vector(10, 60), 1.0, 4, false, [&]() { _builder.rectangle(Size(80, 40), 1.0); });
+            });
+        });
+        _builder.context(Vector(0, 80), 1.0, 5, false, [&]() { _builder.rectangle(Size(20, 20), 1.0); });
+    }
 };
 
 TEST_F(RasterDamageResolverTests, returnsFullRectOnInInitialDraw) {
@@ -163,4 +190,98 @@ TEST_F(RasterDamageResolverTests, returnsDamageOnMovedLayer) {
     ASSERT_EQ(Rect::makeXYWH(10, 10, 10, 10), damageRects[1]);
 }
 
-} // namespace snap::drawing
\ No newline at end of file
+TEST_F(RasterDamageResolverTests, mergesDisjointDamageRectsWhenCheaper) {
+    auto damageRects = RasterDamageResolver::mergeDamageRects(
+        {Rect::makeXYWH(0, 0, 10, 10), Rect::makeXYWH(12, 0, 10, 10), Rect::makeXYWH(80, 80, 10, 10)});
+
+    ASSERT_EQ(static_cast<size_t>(2), damageRects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 22, 10), damageRects[0]);
+    ASSERT_EQ(Rect::makeXYWH(80, 80, 10, 10), damageRects[1]);
+}
+
+TEST_F(RasterDamageResolverTests, mergesDamageRectsTransitively) {
+    // The last rect bridges the first two, which are too far apart to be merged on their own
+    auto damageRects = RasterDamageResolver::mergeDamageRects(
+        {Rect::makeXYWH(0, 0, 100, 10), Rect::makeXYWH(0, 90, 100, 10), Rect::makeXYWH(0, 5, 10, 90)});
+
+    ASSERT_EQ(static_cast<size_t>(1), damageRects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 100, 100), damageRects[0]);
+}
+
+TEST_F(RasterDamageResolverTests, resolvesDisjointDamageRectsOnManyLayers) {
+    _builder = DisplayListBuilder(1000, 1000);
+    _builder.context(Vector(0, 0), 1.0, 1, false, [&]() {
+        for (size_t i = 0; i < 1000; i++) {
+            auto x = static_cast<Scalar>((i % 40) * 25);
+            auto y = static_cast<Scalar>((i / 40) * 25);
+            _builder.context(Vector(x, y), 1.0, i + 2, i % 3 == 0, [&]() { _builder.rectangle(Size(8, 8), 1.0); });
+        }
+    });
+
+    _damageResolver.beginUpdates(1000, 1000);
+    _damageResolver.addDamageFromDisplayListUpdates(*_builder.displayList);
+    _damageResolver.endUpdates();
+
+    _damageResolver.beginUpdates(1000, 1000);
+    _damageResolver.addDamageFromDisplayListUpdates(*_builder.displayList);
+    auto damageRects = _damageResolver.endUpdates();
+
+    ASSERT_FALSE(damageRects.empty());
+    for (size_t i = 0; i < damageRects.size(); i++) {
+        for (size_t j = i + 1; j < damageRects.size(); j++) {
+            ASSERT_FALSE(damageRects[i].intersects(damageRects[j]));
+        }
+    }
+}
+
+TEST_F(RasterDamageResolverTests, shiftsScrolledContent) {
+    _damageResolver.setContentShiftEnabled(true);
+
+    drawScrollScene(0, false);
+    resolveDamage();
+    ASSERT_FALSE(_damageResolver.getContentShift().has_value());
+
+    drawScrollScene(10, false);
+    auto damageRects = resolveDamage();
+
+    const auto& contentShift = _damageResolver.getContentShift();
+    ASSERT_TRUE(contentShift.has_value());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 100, 80), contentShift.value().region);
+    ASSERT_EQ(0, contentShift.value().dx);
+    ASSERT_EQ(-10, contentShift.value().dy);
+
+    // Only the area exposed at the bottom of the scroll layer needs to be drawn
+    ASSERT_EQ(static_cast<size_t>(1), damageRects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 70, 100, 10), damageRects[0]);
+}
+
+TEST_F(RasterDamageResolverTests, returnsDamageOnUpdatedLayersWithinShiftedContent) {
+    _damageResolver.setContentShiftEnabled(true);
+
+    drawScrollScene(0, false);
+    resolveDamage();
+
+    drawScrollScene(10, true);
+    auto damageRects = resolveDamage();
+
+    ASSERT_TRUE(_damageResolver.getContentShift().has_value());
+
+    // The previous and new rects of the updated item, and the exposed area
+    ASSERT_EQ(static_cast<size_t>(2), damageRects.size());
+    ASSERT_EQ(Rect::makeXYWH(10, 0, 80, 50), damageRects[0]);
+    ASSERT_EQ(Rect::makeXYWH(0, 70, 100, 10), damageRects[1]);
+}
+
+TEST_F(RasterDamageResolverTests, doesNotShiftContentScrolledByPartialPixels) {
+    _damageResolver.setContentShiftEnabled(true);
+
+    drawScrollScene(0, false);
+    resolveDamage();
+
+    drawScrollScene(10.5, false);
+    resolveDamage();
+
+    ASSERT_FALSE(_damageResolver.getContentShift().has_value());
+}
+
+} // namespace snap::drawing
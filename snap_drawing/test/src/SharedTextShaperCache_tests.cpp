@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Text/SharedTextShaperCache.hpp"
+#include "snap_drawing/cpp/Utils/UTFUtils.hpp"
+
+#include <thread>
+
+namespace snap::drawing {
+
+static std::vector<ShapedGlyph> generateGlyphVec(const std::vector<Character>& characters) {
+    std::vector<ShapedGlyph> out;
+    out.resize(characters.size());
+
+    for (size_t i = 0; i < characters.size(); i++) {
+        auto& glyph = out[i];
+        glyph.offsetX = static_cast<Scalar>(i);
+        glyph.advanceX = static_cast<Scalar>(i) * 2.0f;
+        glyph.glyphID = static_cast<uint32_t>(i);
+
+        glyph.setCharacter(characters[i], false);
+    }
+
+    return out;
+}
+
+static TextShaperCacheKey makeCacheKey(FontId fontId, const std::vector<Character>& characters) {
+    return TextShaperCacheKey(fontId, 0.0f, TextScript::invalid(), false, characters.data(), characters.size());
+}
+
+TEST(SharedTextShaperCache, canInsertAndFind) {
+    auto cache = Valdi::makeShared<SharedTextShaperCache>(64 * 1024);
+
+    auto characters = utf8ToUnicode("Hello");
+    auto shapedGlyphs = generateGlyphVec(characters);
+
+    std::vector<ShapedGlyph> out;
+    ASSERT_FALSE(cache->find(makeCacheKey(1, characters), out));
+    ASSERT_TRUE(out.empty());
+
+    cache->insert(makeCacheKey(1, characters), shapedGlyphs.data(), shapedGlyphs.size());
+
+    ASSERT_TRUE(cache->find(makeCacheKey(1, characters), out));
+    ASSERT_EQ(shapedGlyphs, out);
+    ASSERT_FALSE(cache->contains(makeCacheKey(2, characters)));
+
+    auto stats = cache->getStats();
+    ASSERT_EQ(static_cast<size_t>(1), stats.entriesCount);
+    ASSERT_EQ(static_cast<uint64_t>(1), stats.hitsCount);
+    ASSERT_EQ(static_cast<uint64_t>(1), stats.missesCount);
+    ASSERT_GT(stats.sizeInBytes, static_cast<size_t>(0));
+
+    cache->clear();
+
+    ASSERT_FALSE(cache->contains(makeCacheKey(1, characters)));
+    ASSERT_EQ(static_cast<size_t>(0), cache->getStats().sizeInBytes);
+}
+
+TEST(SharedTextShaperCache, staysWithinSizeBudget) {
+    constexpr size_t kMaxSizeInBytes = 16 * 1024;
+    auto cache = Valdi::makeShared<SharedTextShaperCache>(kMaxSizeInBytes);
+
+    for (size_t i = 0; i < 1000; i++) {
+        auto characters = utf8ToUnicode("word" + std::to_string(i));
+        auto shapedGlyphs = generateGlyphVec(characters);
+        cache->insert(makeCacheKey(1, characters), shapedGlyphs.data(), shapedGlyphs.size());
+    }
+
+    auto stats = cache->getStats();
+    ASSERT_LE(stats.sizeInBytes, kMaxSizeInBytes);
+    ASSERT_GT(stats.entriesCount, static_cast<size_t>(0));
+    ASSERT_LT(stats.entriesCount, static_cast<size_t>(1000));
+    ASSERT_EQ(static_cast<uint64_t>(1000 - stats.entriesCount), stats.evictionsCount);
+
+    // The most recently inserted entry should still be there
+    ASSERT_TRUE(cache->contains(makeCacheKey(1, utf8ToUnicode("word999"))));
+}
+
+TEST(SharedTextShaperCache, canBeUsedConcurrently) {
+    auto cache = Valdi::makeShared<SharedTextShaperCache>(256 * 1024);
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; t++) {
+        threads.emplace_back([cache]() {
+            for (size_t i = 0; i < 500; i++) {
+                auto characters = utf8ToUnicode("word" + std::to_string(i % 50));
+                auto key = makeCacheKey(1, characters);
+
+                std::vector<ShapedGlyph> out;
+                if (!cache->find(key, out)) {
+                    auto shapedGlyphs = generateGlyphVec(characters);
+                    cache->insert(key, shapedGlyphs.data(), shapedGlyphs.size());
+                } else {
+                    ASSERT_EQ(generateGlyphVec(characters), out);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = cache->getStats();
+    ASSERT_EQ(static_cast<size_t>(50), stats.entriesCount);
+    ASSERT_EQ(static_cast<uint64_t>(2000), stats.hitsCount + stats.missesCount);
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Animations/SpringForce.hpp"
+
+namespace snap::drawing {
+
+static MassState stepSpring(SpringForce& spring, MassState state, long timeElapsed, size_t steps) {
+    for (size_t i = 0; i < steps; i++) {
+        state = spring.updateValues(state.value, state.velocity, timeElapsed);
+    }
+    return state;
+}
+
+static void checkSpringIsTimeConsistent(double damping, double stiffness) {
+    SpringForce spring(damping, stiffness, 0.001);
+    spring.setFinalPosition(1);
+
+    MassState initialState;
+    initialState.value = 0;
+    initialState.velocity = 0;
+
+    // The springs are solved analytically, so the number of steps should not matter
+    auto singleStep = stepSpring(spring, initialState, 64, 1);
+    auto manySteps = stepSpring(spring, initialState, 16, 4);
+
+    ASSERT_NEAR(singleStep.value, manySteps.value, 0.0001);
+    ASSERT_NEAR(singleStep.velocity, manySteps.velocity, 0.001);
+}
+
+TEST(SpringForce, underdampedSpringIsTimeConsistent) {
+    checkSpringIsTimeConsistent(20.1, 381.47);
+}
+
+TEST(SpringForce, criticallyDampedSpringIsTimeConsistent) {
+    checkSpringIsTimeConsistent(2 * 20, 400);
+}
+
+TEST(SpringForce, overdampedSpringIsTimeConsistent) {
+    checkSpringIsTimeConsistent(100, 400);
+}
+
+TEST(SpringForce, reachesEquilibriumAtFinalPosition) {
+    SpringForce spring(20.1, 381.47, 0.001);
+    spring.setFinalPosition(1);
+
+    MassState state;
+    state.value = 0;
+    state.velocity = 0;
+
+    size_t steps = 0;
+    while (!spring.isAtEquilibrium(state.value, state.velocity)) {
+        state = spring.updateValues(state.value, state.velocity, 16);
+        steps++;
+        ASSERT_LT(steps, static_cast<size_t>(1000));
+    }
+
+    ASSERT_NEAR(1.0, state.value, 0.001);
+}
+
+} // namespace snap::drawing
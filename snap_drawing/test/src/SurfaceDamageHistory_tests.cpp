@@ -0,0 +1,80 @@
+#include "snap_drawing/cpp/Drawing/Surface/SurfaceDamageHistory.hpp"
+#include <gtest/gtest.h>
+
+namespace snap::drawing {
+
+TEST(SurfaceDamageHistory, redrawsEverythingWhenBufferAgeIsUnknown) {
+    SurfaceDamageHistory history(3);
+    history.onFramePresented({Rect::makeXYWH(0, 0, 100, 100)}, 100, 100);
+
+    auto redrawRects = history.resolveRedrawRects({Rect::makeXYWH(10, 10, 10, 10)}, 100, 100, 0);
+
+    ASSERT_EQ(static_cast<size_t>(1), redrawRects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 100, 100), redrawRects[0]);
+}
+
+TEST(SurfaceDamageHistory, redrawsDamageOfCurrentFrameWithPreviousBuffer) {
+    SurfaceDamageHistory history(3);
+    history.onFramePresented({Rect::makeXYWH(0, 0, 100, 100)}, 100, 100);
+
+    auto redrawRects = history.resolveRedrawRects({Rect::makeXYWH(10.5, 10.5, 10, 10)}, 100, 100, 1);
+
+    ASSERT_EQ(static_cast<size_t>(1), redrawRects.size());
+    ASSERT_EQ(Rect::makeLTRB(10, 10, 21, 21), redrawRects[0]);
+}
+
+TEST(SurfaceDamageHistory, includesDamageOfFramesMissedByOlderBuffers) {
+    SurfaceDamageHistory history(3);
+    history.onFramePresented({Rect::makeXYWH(0, 0, 100, 100)}, 100, 100);
+    history.onFramePresented({Rect::makeXYWH(50, 50, 10, 10)}, 100, 100);
+
+    auto redrawRects = history.resolveRedrawRects({Rect::makeXYWH(10, 10, 10, 10)}, 100, 100, 2);
+
+    ASSERT_EQ(static_cast<size_t>(2), redrawRects.size());
+    ASSERT_EQ(Rect::makeXYWH(10, 10, 10, 10), redrawRects[0]);
+    ASSERT_EQ(Rect::makeXYWH(50, 50, 10, 10), redrawRects[1]);
+}
+
+TEST(SurfaceDamageHistory, redrawsEverythingWhenBufferIsOlderThanHistory) {
+    SurfaceDamageHistory history(3);
+    history.onFramePresented({Rect::makeXYWH(0, 0, 100, 100)}, 100, 100);
+
+    auto redrawRects = history.resolveRedrawRects({Rect::makeXYWH(10, 10, 10, 10)}, 100, 100, 3);
+
+    ASSERT_EQ(static_cast<size_t>(1), redrawRects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 100, 100), redrawRects[0]);
+}
+
+TEST(SurfaceDamageHistory, redrawsEverythingWhenSizeChanges) {
+    SurfaceDamageHistory history(3);
+    history.onFramePresented({Rect::makeXYWH(0, 0, 100, 100)}, 100, 100);
+
+    auto redrawRects = history.resolveRedrawRects({Rect::makeXYWH(10, 10, 10, 10)}, 200, 100, 1);
+
+    ASSERT_EQ(static_cast<size_t>(1), redrawRects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 200, 100), redrawRects[0]);
+}
+
+TEST(SurfaceDamageHistory, mergesIntersectingRects) {
+    auto rects = SurfaceDamageHistory::normalizeRects({Rect::makeXYWH(0, 0, 10, 10),
+                                                       Rect::makeXYWH(50, 0, 10, 10),
+                                                       Rect::makeXYWH(5, 0, 50, 5),
+                                                       Rect::makeXYWH(90, 90, 20, 20)},
+                                                      100,
+                                                      100,
+                                                      8);
+
+    ASSERT_EQ(static_cast<size_t>(2), rects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 60, 10), rects[0]);
+    ASSERT_EQ(Rect::makeXYWH(90, 90, 10, 10), rects[1]);
+}
+
+TEST(SurfaceDamageHistory, mergesRectsIntoBoundsWhenAboveMaxCount) {
+    auto rects = SurfaceDamageHistory::normalizeRects(
+        {Rect::makeXYWH(0, 0, 10, 10), Rect::makeXYWH(20, 20, 10, 10), Rect::makeXYWH(40, 40, 10, 10)}, 100, 100, 2);
+
+    ASSERT_EQ(static_cast<size_t>(1), rects.size());
+    ASSERT_EQ(Rect::makeXYWH(0, 0, 50, 50), rects[0]);
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Text/TextLayoutCache.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static Ref<TextLayout> makeEmptyTextLayout(Size maxSize) {
+    return makeShared<TextLayout>(maxSize,
+                                  std::vector<TextLayoutEntry>(),
+                                  std::vector<TextLayoutDecorationEntry>(),
+                                  std::vector<TextLayoutAttachment>(),
+                                  true);
+}
+
+static TextLayoutCacheKey makeCacheKey(std::string_view text, Scalar width) {
+    TextLayoutCacheKey key;
+    key.maxSize = Size::make(width, 100);
+    key.text = StringCache::getGlobal().makeString(text);
+    key.numberOfLines = 1;
+    key.displayScale = 1.0f;
+    key.dynamicTypeScale = 1.0f;
+    key.includeTextBlob = true;
+    return key;
+}
+
+static Ref<AttributedText> makeAttributedText(std::string_view first, std::string_view second) {
+    AttributedText::Parts parts;
+    parts.emplace_back();
+    parts.back().content = StringCache::getGlobal().makeString(first);
+    parts.emplace_back();
+    parts.back().content = StringCache::getGlobal().makeString(second);
+    parts.back().style.textDecoration = {TextDecorationUnderline};
+
+    return makeShared<AttributedText>(std::move(parts));
+}
+
+TEST(TextLayoutCache, canInsertAndFind) {
+    auto cache = makeShared<TextLayoutCache>(16);
+    auto textLayout = makeEmptyTextLayout(Size::make(50, 100));
+
+    ASSERT_EQ(nullptr, cache->find(makeCacheKey("Hello", 50)));
+
+    cache->insert(makeCacheKey("Hello", 50), textLayout);
+
+    ASSERT_EQ(textLayout, cache->find(makeCacheKey("Hello", 50)));
+    ASSERT_EQ(nullptr, cache->find(makeCacheKey("Hello", 51)));
+    ASSERT_EQ(nullptr, cache->find(makeCacheKey("World", 50)));
+
+    auto otherKey = makeCacheKey("Hello", 50);
+    otherKey.numberOfLines = 2;
+    ASSERT_EQ(nullptr, cache->find(otherKey));
+}
+
+TEST(TextLayoutCache, comparesAttributedTextsByValue) {
+    auto key = makeCacheKey("", 50);
+    key.attributedText = makeAttributedText("Hello", "World");
+
+    auto equalKey = makeCacheKey("", 50);
+    equalKey.attributedText = makeAttributedText("Hello", "World");
+
+    auto differentKey = makeCacheKey("", 50);
+    differentKey.attributedText = makeAttributedText("Hello", "There");
+
+    ASSERT_TRUE(key == equalKey);
+    ASSERT_EQ(key.hash(), equalKey.hash());
+    ASSERT_TRUE(key != differentKey);
+
+    auto cache = makeShared<TextLayoutCache>(16);
+    auto textLayout = makeEmptyTextLayout(Size::make(50, 100));
+    cache->insert(std::move(key), textLayout);
+
+    ASSERT_EQ(textLayout, cache->find(equalKey));
+    ASSERT_EQ(nullptr, cache->find(differentKey));
+}
+
+TEST(TextLayoutCache, evictsLeastRecentlyUsed) {
+    auto cache = makeShared<TextLayoutCache>(2);
+
+    cache->insert(makeCacheKey("1", 50), makeEmptyTextLayout(Size::make(50, 100)));
+    cache->insert(makeCacheKey("2", 50), makeEmptyTextLayout(Size::make(50, 100)));
+
+    // Make the first entry the most recently used
+    ASSERT_NE(nullptr, cache->find(makeCacheKey("1", 50)));
+
+    cache->insert(makeCacheKey("3", 50), makeEmptyTextLayout(Size::make(50, 100)));
+
+    ASSERT_EQ(static_cast<size_t>(2), cache->size());
+    ASSERT_NE(nullptr, cache->find(makeCacheKey("1", 50)));
+    ASSERT_EQ(nullptr, cache->find(makeCacheKey("2", 50)));
+    ASSERT_NE(nullptr, cache->find(makeCacheKey("3", 50)));
+}
+
+TEST(TextLayoutCache, purgesUnusedTextLayouts) {
+    auto cache = makeShared<TextLayoutCache>(16);
+
+    auto retainedTextLayout = makeEmptyTextLayout(Size::make(50, 100));
+    cache->insert(makeCacheKey("1", 50), retainedTextLayout);
+    cache->insert(makeCacheKey("2", 50), makeEmptyTextLayout(Size::make(50, 100)));
+
+    ASSERT_EQ(static_cast<size_t>(2), cache->size());
+
+    cache->purgeUnused();
+
+    ASSERT_EQ(static_cast<size_t>(1), cache->size());
+    ASSERT_EQ(retainedTextLayout, cache->find(makeCacheKey("1", 50)));
+
+    retainedTextLayout = nullptr;
+    cache->purgeUnused();
+
+    ASSERT_EQ(static_cast<size_t>(0), cache->size());
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "TestGestureUtils.hpp"
+#include "snap_drawing/cpp/Touches/TouchEventResampler.hpp"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static TouchEvent makeEventAtTime(TouchEventType type, Scalar x, Scalar y, double seconds, size_t pointerCount = 1) {
+    TouchEvent::PointerLocations pointerLocations;
+    for (size_t i = 0; i < pointerCount; i++) {
+        pointerLocations.push_back(Point::make(x, y));
+    }
+    return TouchEvent(type,
+                      Point::make(x, y),
+                      Point::make(x, y),
+                      Vector::makeEmpty(),
+                      pointerCount,
+                      0,
+                      std::move(pointerLocations),
+                      TimePoint(seconds),
+                      Duration(),
+                      nullptr);
+}
+
+TEST(TouchEventResampler, interpolatesBetweenSamples) {
+    TouchEventResampler resampler;
+    ASSERT_FALSE(resampler.flush(TimePoint(0.0)).has_value());
+
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 0, 10, 0.000));
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 4, 10, 0.004));
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 8, 10, 0.008));
+    ASSERT_TRUE(resampler.hasPendingEvent());
+
+    // Sampled 5ms before the frame time, between the last two samples
+    auto event = resampler.flush(TimePoint(0.011));
+    ASSERT_TRUE(event.has_value());
+    ASSERT_FALSE(resampler.hasPendingEvent());
+
+    ASSERT_EQ(TouchEventTypeMoved, event.value().getType());
+    ASSERT_NEAR(0.006, event.value().getTime().getTime(), 0.0001);
+    ASSERT_NEAR(6.0f, event.value().getLocation().x, 0.01f);
+    ASSERT_NEAR(10.0f, event.value().getLocation().y, 0.01f);
+    ASSERT_NEAR(6.0f, event.value().getLocationByPointer(0).x, 0.01f);
+
+    ASSERT_FALSE(resampler.flush(TimePoint(0.027)).has_value());
+}
+
+TEST(TouchEventResampler, extrapolatesFromVelocityUpToMaxPrediction) {
+    TouchEventResampler resampler;
+
+    // Moving at 1000 points per second
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 0, 0, 0.000));
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 4, 0, 0.004));
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 8, 0, 0.008));
+
+    auto event = resampler.flush(TimePoint(0.015));
+    ASSERT_TRUE(event.has_value());
+    ASSERT_NEAR(0.010, event.value().getTime().getTime(), 0.0001);
+    ASSERT_NEAR(10.0f, event.value().getLocation().x, 0.01f);
+
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 12, 0, 0.012));
+
+    // The prediction is capped
+    event = resampler.flush(TimePoint(0.100));
+    ASSERT_TRUE(event.has_value());
+    ASSERT_NEAR(0.012 + TouchEventResampler::kMaxPrediction.seconds(), event.value().getTime().getTime(), 0.0001);
+    ASSERT_NEAR(20.0f, event.value().getLocation().x, 0.01f);
+}
+
+TEST(TouchEventResampler, doesNotResampleMultiplePointers) {
+    TouchEventResampler resampler;
+
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 0, 0, 0.000, 2));
+    resampler.addMovedEvent(makeEventAtTime(TouchEventTypeMoved, 8, 0, 0.008, 2));
+
+    auto event = resampler.flush(TimePoint(0.011));
+    ASSERT_TRUE(event.has_value());
+    ASSERT_EQ(TimePoint(0.008), event.value().getTime());
+    ASSERT_EQ(8.0f, event.value().getLocation().x);
+}
+
+TEST(TouchEventResampler, layerRootDispatchesMovedEventsOncePerFrame) {
+    auto container = makeContainer(0, 0, 100, 100);
+    container->root->setTouchEventBatchingEnabled(true);
+    container->root->processFrame(TimePoint(0.0));
+
+    auto touchSnapshot = addTouchGesture(makeTouchGestureRecognizer(container->view));
+
+    container->root->dispatchTouchEvent(makeEventAtTime(TouchEventTypeDown, 30, 30, 0.000));
+    ASSERT_EQ(GestureRecognizerStateBegan, touchSnapshot->state);
+    ASSERT_EQ(1, touchSnapshot->counter);
+
+    ASSERT_TRUE(container->root->dispatchTouchEvent(makeEventAtTime(TouchEventTypeMoved, 32, 30, 0.004)));
+    ASSERT_TRUE(container->root->dispatchTouchEvent(makeEventAtTime(TouchEventTypeMoved, 34, 30, 0.008)));
+    ASSERT_EQ(1, touchSnapshot->counter);
+    ASSERT_TRUE(container->root->needsProcessFrame());
+
+    container->root->processFrame(TimePoint(0.011));
+    ASSERT_EQ(2, touchSnapshot->counter);
+    ASSERT_EQ(GestureRecognizerStateChanged, touchSnapshot->state);
+    ASSERT_NEAR(33.0f, touchSnapshot->location.x, 0.01f);
+
+    // Pending moved events are dispatched before the touch ends
+    container->root->dispatchTouchEvent(makeEventAtTime(TouchEventTypeMoved, 36, 30, 0.012));
+    container->root->dispatchTouchEvent(makeEventAtTime(TouchEventTypeUp, 36, 30, 0.013));
+    ASSERT_EQ(4, touchSnapshot->counter);
+    ASSERT_EQ(GestureRecognizerStateEnded, touchSnapshot->state);
+    ASSERT_EQ(36.0f, touchSnapshot->location.x);
+}
+
+} // namespace snap::drawing
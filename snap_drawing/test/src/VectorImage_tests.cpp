@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "snap_drawing/cpp/Utils/Image.hpp"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPictureRecorder.h"
+
+using namespace Valdi;
+
+namespace snap::drawing {
+
+static sk_sp<SkPicture> makeTestPicture() {
+    SkPictureRecorder recorder;
+    auto* canvas = recorder.beginRecording(SkRect::MakeWH(10, 20));
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeWH(10, 20), paint);
+    return recorder.finishRecordingAsPicture();
+}
+
+TEST(VectorImage, keepsPictureWhenResized) {
+    auto imageResult = Image::makeFromPicture(makeTestPicture(), 10, 20);
+    ASSERT_TRUE(imageResult.success()) << imageResult.error().getMessage();
+
+    auto image = imageResult.value();
+    ASSERT_TRUE(image->isVector());
+    ASSERT_EQ(10, image->width());
+    ASSERT_EQ(20, image->height());
+
+    auto resized = image->resized(30, 60);
+    ASSERT_TRUE(resized->isVector());
+    ASSERT_EQ(image->getPicture(), resized->getPicture());
+    ASSERT_EQ(30, resized->width());
+    ASSERT_EQ(60, resized->height());
+}
+
+TEST(VectorImage, onlyRasterizesHotSizes) {
+    auto image = Image::makeFromPicture(makeTestPicture(), 10, 20).value();
+
+    ASSERT_EQ(nullptr, image->getRasterizedIfHot(20, 40));
+    ASSERT_EQ(nullptr, image->getRasterizedIfHot(20, 40));
+
+    auto rasterized = image->getRasterizedIfHot(20, 40);
+    ASSERT_NE(nullptr, rasterized);
+    ASSERT_FALSE(rasterized->isVector());
+    ASSERT_EQ(20, rasterized->width());
+    ASSERT_EQ(40, rasterized->height());
+
+    ASSERT_EQ(rasterized, image->getRasterizedIfHot(20, 40));
+
+    // Other sizes are still drawn from the picture until they are hot too
+    ASSERT_EQ(nullptr, image->getRasterizedIfHot(30, 60));
+}
+
+TEST(VectorImage, ignoresRasterImages) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(4, 4);
+    auto rasterImage = makeShared<Image>(SkImages::RasterFromBitmap(bitmap));
+    ASSERT_FALSE(rasterImage->isVector());
+    ASSERT_EQ(nullptr, rasterImage->getRasterizedIfHot(4, 4));
+}
+
+} // namespace snap::drawing
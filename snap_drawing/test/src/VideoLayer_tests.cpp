@@ -144,4 +144,26 @@ TEST_F(VideoLayerTests, stopsProcessingWhenQueueIsRemoved) {
     ASSERT_TRUE(_layerRoot->needsProcessFrame());
 }
 
+TEST_F(VideoLayerTests, presentsFramesInCompositorPlaneWhenEnabled) {
+    _layerRoot->setContentLayer(nullptr, ContentLayerSizingModeMatchSize);
+    _layerRoot->setPresentsVideoInCompositorPlane(true);
+    _layerRoot->setContentLayer(_videoLayer, ContentLayerSizingModeMatchSize);
+
+    auto queue = makeShared<ImageQueue>(1);
+    _videoLayer->setImageQueue(queue);
+    enqueueColorToQueue(queue, Color::red());
+
+    updateAndDraw();
+
+    ASSERT_TRUE(_layerRoot->getLastDrawnFrame()->hasExternalSurfaces());
+    // The frames are left for the presenter of the surface to dequeue
+    ASSERT_EQ(static_cast<size_t>(1), queue->getQueueSize());
+    ASSERT_FALSE(_layerRoot->needsProcessFrame());
+
+    _videoLayer->setImageQueue(nullptr);
+    updateAndDraw();
+
+    ASSERT_FALSE(_layerRoot->getLastDrawnFrame()->hasExternalSurfaces());
+}
+
 } // namespace snap::drawing
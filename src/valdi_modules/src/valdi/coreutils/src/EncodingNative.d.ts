@@ -0,0 +1,7 @@
+export function encodeBase64(bytes: ArrayBufferLike | Uint8Array, urlSafe: boolean): string;
+
+export function decodeBase64(str: string): ArrayBuffer;
+
+export function encodeHex(bytes: ArrayBufferLike | Uint8Array): string;
+
+export function decodeHex(str: string): ArrayBuffer;
@@ -22,4 +22,12 @@ describe('coreutils > Base64', () => {
   it('should url-safe Base64 decode correctly with padding', () => {
     expect(Base64.toByteArray('PDw_Pz8-Pg=')).toEqual(byteArray);
   });
+  it('should round trip large buffers', () => {
+    const bytes = new Uint8Array(1000);
+    for (let i = 0; i < bytes.length; i++) {
+      bytes[i] = (i * 7) & 0xff;
+    }
+    expect(Base64.toByteArray(Base64.fromByteArray(bytes))).toEqual(bytes);
+    expect(Base64.toByteArray(Base64.fromByteArray(bytes, { urlSafe: true }))).toEqual(bytes);
+  });
 });
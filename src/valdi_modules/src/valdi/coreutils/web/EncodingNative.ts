@@ -0,0 +1,153 @@
+/**
+ * Ported from https://github.com/beatgammit/base64-js/blob/master/index.js
+ */
+
+const lookup: string[] = [];
+const revLookup: { [key: string]: number } = {};
+
+const code = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+for (let i = 0, len = code.length; i < len; ++i) {
+  lookup[i] = code[i];
+  revLookup[code.charCodeAt(i)] = i;
+}
+
+// Support decoding URL-safe base64 strings, as Node.js does.
+// See: https://en.wikipedia.org/wiki/Base64#URL_applications
+revLookup['-'.charCodeAt(0)] = 62;
+revLookup['_'.charCodeAt(0)] = 63;
+
+function getLens(b64: string): [number, number] {
+  const len = b64.length;
+
+  if (len % 4 > 0) {
+    throw new Error('Invalid string. Length must be a multiple of 4');
+  }
+
+  // Trim off extra bytes after placeholder bytes are found
+  // See: https://github.com/beatgammit/base64-js/issues/42
+  let validLen = b64.indexOf('=');
+  if (validLen === -1) validLen = len;
+
+  const placeHoldersLen = validLen === len ? 0 : 4 - (validLen % 4);
+
+  return [validLen, placeHoldersLen];
+}
+
+function _byteLength(b64: string, validLen: number, placeHoldersLen: number): number {
+  return ((validLen + placeHoldersLen) * 3) / 4 - placeHoldersLen;
+}
+
+function tripletToBase64(num: number): string {
+  return lookup[(num >> 18) & 0x3f] + lookup[(num >> 12) & 0x3f] + lookup[(num >> 6) & 0x3f] + lookup[num & 0x3f];
+}
+
+function encodeChunk(uint8: Uint8Array, start: number, end: number): string {
+  let tmp: number;
+  const output: string[] = [];
+  for (let i = start; i < end; i += 3) {
+    tmp = ((uint8[i] << 16) & 0xff0000) + ((uint8[i + 1] << 8) & 0xff00) + (uint8[i + 2] & 0xff);
+    output.push(tripletToBase64(tmp));
+  }
+  return output.join('');
+}
+
+export function encodeBase64(bytes: ArrayBufferLike | Uint8Array, urlSafe: boolean): string {
+  const uint8 = bytes instanceof Uint8Array ? bytes : new Uint8Array(bytes);
+  let tmp: number;
+  const len = uint8.length;
+  const extraBytes = len % 3; // if we have 1 byte left, pad 2 bytes
+  const parts: string[] = [];
+  const maxChunkLength = 16383; // must be multiple of 3
+
+  // go through the array every three bytes, we'll deal with trailing stuff later
+  for (let i = 0, len2 = len - extraBytes; i < len2; i += maxChunkLength) {
+    parts.push(encodeChunk(uint8, i, i + maxChunkLength > len2 ? len2 : i + maxChunkLength));
+  }
+
+  // pad the end with zeros, but make sure to not forget the extra bytes
+  if (extraBytes === 1) {
+    tmp = uint8[len - 1];
+    parts.push(lookup[tmp >> 2] + lookup[(tmp << 4) & 0x3f] + '==');
+  } else if (extraBytes === 2) {
+    tmp = (uint8[len - 2] << 8) + uint8[len - 1];
+    parts.push(lookup[tmp >> 10] + lookup[(tmp >> 4) & 0x3f] + lookup[(tmp << 2) & 0x3f] + '=');
+  }
+
+  const base64String = parts.join('');
+
+  if (urlSafe) {
+    // Convert to URL-safe base64
+    return base64String.replace(/\+/g, '-').replace(/\//g, '_').replace(/=/g, '');
+  } else {
+    return base64String;
+  }
+}
+export function decodeBase64(b64: string): ArrayBuffer {
+  let tmp = 0;
+
+  // Add padding to make length multiple of 4, if necessary
+  const originalLen = b64.length;
+  if (originalLen % 4 > 0) {
+    const paddingCount = 4 - (originalLen % 4);
+    b64 += '='.repeat(paddingCount);
+  }
+
+  const lens = getLens(b64);
+  const validLen = lens[0];
+  const placeHoldersLen = lens[1];
+
+  const arr = new Uint8Array(_byteLength(b64, validLen, placeHoldersLen));
+
+  let curByte = 0;
+
+  // if there are placeholders, only get up to the last complete 4 chars
+  const len = placeHoldersLen > 0 ? validLen - 4 : validLen;
+
+  let i = 0;
+  for (i = 0; i < len; i += 4) {
+    tmp =
+      (revLookup[b64.charCodeAt(i)] << 18) |
+      (revLookup[b64.charCodeAt(i + 1)] << 12) |
+      (revLookup[b64.charCodeAt(i + 2)] << 6) |
+      revLookup[b64.charCodeAt(i + 3)];
+    arr[curByte++] = (tmp >> 16) & 0xff;
+    arr[curByte++] = (tmp >> 8) & 0xff;
+    arr[curByte++] = tmp & 0xff;
+  }
+
+  if (placeHoldersLen === 2) {
+    tmp = (revLookup[b64.charCodeAt(i)] << 2) | (revLookup[b64.charCodeAt(i + 1)] >> 4);
+    arr[curByte++] = tmp & 0xff;
+  }
+
+  if (placeHoldersLen === 1) {
+    tmp =
+      (revLookup[b64.charCodeAt(i)] << 10) |
+      (revLookup[b64.charCodeAt(i + 1)] << 4) |
+      (revLookup[b64.charCodeAt(i + 2)] >> 2);
+    arr[curByte++] = (tmp >> 8) & 0xff;
+    arr[curByte++] = tmp & 0xff;
+  }
+
+  return arr.buffer;
+}
+
+export function encodeHex(bytes: ArrayBufferLike | Uint8Array): string {
+  const uint8 = bytes instanceof Uint8Array ? bytes : new Uint8Array(bytes);
+  let output = '';
+  for (let i = 0; i < uint8.length; i++) {
+    output += (uint8[i] < 16 ? '0' : '') + uint8[i].toString(16);
+  }
+  return output;
+}
+
+export function decodeHex(str: string): ArrayBuffer {
+  if (str.length % 2 !== 0 || !/^[0-9a-fA-F]*$/.test(str)) {
+    throw new Error('Invalid hex string');
+  }
+  const arr = new Uint8Array(str.length / 2);
+  for (let i = 0; i < arr.length; i++) {
+    arr[i] = parseInt(str.substr(i * 2, 2), 16);
+  }
+  return arr.buffer;
+}
@@ -1,6 +1,6 @@
 import { IRenderer } from 'valdi_core/src/IRenderer';
 import { Size } from './DrawingModuleProvider';
-import { IBitmap } from './IBitmap';
+import { IBitmap, ImageEncoding } from './IBitmap';
 
 export const enum MeasureMode {
   UNSPECIFIED = 0,
@@ -70,4 +70,12 @@ export interface IManagedContextFrame {
    * Only the areas that have changed since the last rasterization will be rasterized.
    */
   rasterDeltaInto(bitmap: IBitmap): void;
+
+  /**
+   * Rasterize the frame into a bitmap of the given size in pixels and encode it
+   * with the given encoding and quality between 0 and 1. Rasterization and encoding happen
+   * on a worker thread, so that frames of different contexts are processed concurrently.
+   * The frame can be disposed before the returned promise resolves.
+   */
+  encode(width: number, height: number, encoding: ImageEncoding, quality: number): Promise<ArrayBuffer>;
 }
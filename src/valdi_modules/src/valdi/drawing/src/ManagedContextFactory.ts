@@ -3,7 +3,7 @@ import { IRenderer } from 'valdi_core/src/IRenderer';
 import { jsx } from 'valdi_core/src/JSXBootstrap';
 import { Renderer } from 'valdi_core/src/Renderer';
 import { Size } from './DrawingModuleProvider';
-import { IBitmap } from './IBitmap';
+import { IBitmap, ImageEncoding } from './IBitmap';
 import { IManagedContext, IManagedContextAssetsLoadResult, IManagedContextFrame, MeasureMode } from './IManagedContext';
 import { ManagedContextAssetTracker } from './ManagedContextAssetTracker';
 import {
@@ -14,6 +14,7 @@ import {
   destroyValdiContextWithSnapDrawing,
   disposeFrame,
   drawFrame,
+  encodeFrame,
   rasterFrame,
 } from './ManagedContextNative';
 
@@ -33,6 +34,18 @@ class FrameImpl implements IManagedContextFrame {
   rasterDeltaInto(bitmap: IBitmap): void {
     rasterFrame(this.native, bitmap.native, false, true);
   }
+
+  encode(width: number, height: number, encoding: ImageEncoding, quality: number): Promise<ArrayBuffer> {
+    return new Promise((resolve, reject) => {
+      encodeFrame(this.native, width, height, encoding, quality, (data, error) => {
+        if (data) {
+          resolve(data);
+        } else {
+          reject(new Error(error ?? 'Failed to encode frame'));
+        }
+      });
+    });
+  }
 }
 
 class ManagedContextImpl implements IManagedContext {
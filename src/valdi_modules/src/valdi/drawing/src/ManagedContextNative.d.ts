@@ -1,3 +1,4 @@
+import { ImageEncoding } from './IBitmap';
 import { INativeBitmap } from './INativeBitmap';
 
 export interface SnapDrawingValdiContextNative {
@@ -43,3 +44,14 @@ export function rasterFrame(
   shouldClearBitmapBeforeDrawing: boolean,
   deltaRasterization: boolean,
 ): void;
+
+export type EncodeFrameCallback = (data: ArrayBuffer | undefined, error: string | undefined) => void;
+
+export function encodeFrame(
+  native: SnapDrawingFrameNative,
+  width: number,
+  height: number,
+  encoding: ImageEncoding,
+  quality: number,
+  callback: EncodeFrameCallback,
+): void;
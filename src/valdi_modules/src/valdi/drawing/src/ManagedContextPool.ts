@@ -0,0 +1,229 @@
+import { ImageEncoding } from './IBitmap';
+import { IManagedContext } from './IManagedContext';
+import { IManagedContextOptions, createManagedContext } from './ManagedContextFactory';
+
+export interface IManagedContextPoolOptions extends IManagedContextOptions {
+  /**
+   * Maximum number of contexts rendering at the same time. Requests made while all
+   * the contexts are busy are queued. Defaults to 4.
+   */
+  maxContexts?: number;
+
+  /**
+   * Maximum number of requests waiting for a context, requests made past that
+   * limit are rejected immediately. Defaults to 256.
+   */
+  maxPendingRequests?: number;
+}
+
+export interface IRenderImageRequest {
+  /**
+   * Render function evaluated in the context, like for IManagedContext.render()
+   */
+  render: () => void;
+
+  /**
+   * Size of the layout, in points
+   */
+  width: number;
+  height: number;
+
+  /**
+   * Ratio between pixels and points of the encoded image. Defaults to 1.
+   */
+  scale?: number;
+
+  encoding: ImageEncoding;
+
+  /**
+   * Encoding quality, between 0 and 1
+   */
+  quality: number;
+
+  /**
+   * Time in milliseconds after which the request is rejected if it was not yet rasterized,
+   * including the time spent waiting for a context and for the assets to load.
+   */
+  timeoutMs?: number;
+}
+
+interface PendingRequest {
+  request: IRenderImageRequest;
+  deadline: number | undefined;
+  resolve: (data: ArrayBuffer) => void;
+  reject: (error: Error) => void;
+}
+
+const DEFAULT_MAX_CONTEXTS = 4;
+const DEFAULT_MAX_PENDING_REQUESTS = 256;
+
+function isPastDeadline(deadline: number | undefined): boolean {
+  return deadline !== undefined && Date.now() >= deadline;
+}
+
+class DeadlineExceededError extends Error {
+  constructor() {
+    super('Render request exceeded its deadline');
+  }
+}
+
+/**
+ * A pool of managed contexts which renders images on behalf of many requests, typically in a
+ * server. Contexts are kept warm between requests: their renderer reconciles the next render
+ * with the tree of the previous one, and their raster state is reused. The frames are rasterized
+ * and encoded on worker threads, so that up to maxContexts of them are processed concurrently
+ * while the JS thread renders the next requests.
+ */
+export class ManagedContextPool {
+  private readonly maxContexts: number;
+  private readonly maxPendingRequests: number;
+  private readonly idleContexts: IManagedContext[] = [];
+  private readonly pendingRequests: PendingRequest[] = [];
+  private contextsCount = 0;
+  private disposed = false;
+
+  constructor(private readonly options?: IManagedContextPoolOptions) {
+    this.maxContexts = Math.max(options?.maxContexts ?? DEFAULT_MAX_CONTEXTS, 1);
+    this.maxPendingRequests = options?.maxPendingRequests ?? DEFAULT_MAX_PENDING_REQUESTS;
+  }
+
+  /**
+   * Render, rasterize and encode the given request in one of the contexts of the pool.
+   */
+  renderImage(request: IRenderImageRequest): Promise<ArrayBuffer> {
+    if (this.disposed) {
+      return Promise.reject(new Error('ManagedContextPool was disposed'));
+    }
+    if (this.pendingRequests.length >= this.maxPendingRequests) {
+      return Promise.reject(new Error('Too many pending render requests'));
+    }
+
+    const deadline = request.timeoutMs !== undefined ? Date.now() + request.timeoutMs : undefined;
+    return new Promise((resolve, reject) => {
+      this.pendingRequests.push({ request, deadline, resolve, reject });
+      this.processPendingRequests();
+    });
+  }
+
+  /**
+   * Number of contexts created by the pool, idle or busy
+   */
+  getContextsCount(): number {
+    return this.contextsCount;
+  }
+
+  getPendingRequestsCount(): number {
+    return this.pendingRequests.length;
+  }
+
+  /**
+   * Dispose the idle contexts and reject the pending requests. Busy contexts are
+   * disposed once their request completes.
+   */
+  dispose(): void {
+    this.disposed = true;
+    for (const pendingRequest of this.pendingRequests.splice(0)) {
+      pendingRequest.reject(new Error('ManagedContextPool was disposed'));
+    }
+    for (const context of this.idleContexts.splice(0)) {
+      context.dispose();
+    }
+  }
+
+  private processPendingRequests(): void {
+    while (this.pendingRequests.length > 0) {
+      const pendingRequest = this.pendingRequests[0];
+      if (isPastDeadline(pendingRequest.deadline)) {
+        this.pendingRequests.shift();
+        pendingRequest.reject(new DeadlineExceededError());
+        continue;
+      }
+
+      const context = this.acquireContext();
+      if (!context) {
+        return;
+      }
+
+      this.pendingRequests.shift();
+      this.runRequest(context, pendingRequest).then(
+        data => {
+          this.releaseContext(context);
+          pendingRequest.resolve(data);
+        },
+        (error: Error) => {
+          this.releaseContext(context);
+          pendingRequest.reject(error);
+        },
+      );
+    }
+  }
+
+  private acquireContext(): IManagedContext | undefined {
+    const context = this.idleContexts.pop();
+    if (context) {
+      return context;
+    }
+    if (this.contextsCount >= this.maxContexts) {
+      return undefined;
+    }
+
+    this.contextsCount++;
+    return createManagedContext(this.options);
+  }
+
+  private releaseContext(context: IManagedContext): void {
+    if (this.disposed) {
+      this.contextsCount--;
+      context.dispose();
+      return;
+    }
+
+    this.idleContexts.push(context);
+    this.processPendingRequests();
+  }
+
+  private async runRequest(context: IManagedContext, pendingRequest: PendingRequest): Promise<ArrayBuffer> {
+    const request = pendingRequest.request;
+    context.render(request.render);
+    context.layout(request.width, request.height, false);
+
+    await this.waitForAssets(context, pendingRequest.deadline);
+
+    const scale = request.scale ?? 1;
+    const frame = context.draw();
+    try {
+      return await frame.encode(
+        Math.ceil(request.width * scale),
+        Math.ceil(request.height * scale),
+        request.encoding,
+        request.quality,
+      );
+    } finally {
+      frame.dispose();
+    }
+  }
+
+  private waitForAssets(context: IManagedContext, deadline: number | undefined): Promise<void> {
+    return new Promise((resolve, reject) => {
+      let settled = false;
+      let timeout: number | undefined;
+      if (deadline !== undefined) {
+        timeout = setTimeout(() => {
+          settled = true;
+          reject(new DeadlineExceededError());
+        }, Math.max(deadline - Date.now(), 0));
+      }
+
+      context.onAllAssetsLoaded().then(() => {
+        if (settled) {
+          return;
+        }
+        settled = true;
+        if (timeout !== undefined) {
+          clearTimeout(timeout);
+        }
+        resolve();
+      }, reject);
+    });
+  }
+}
@@ -0,0 +1,72 @@
+import { ImageEncoding } from 'drawing/src/IBitmap';
+import { IRenderImageRequest, ManagedContextPool } from 'drawing/src/ManagedContextPool';
+
+import 'jasmine/src/jasmine';
+import 'valdi_tsx/src/JSX';
+
+function makeRequest(color: string, timeoutMs?: number): IRenderImageRequest {
+  return {
+    render: () => {
+      <view width={4} height={4} backgroundColor={color} />;
+    },
+    width: 4,
+    height: 4,
+    scale: 2,
+    encoding: ImageEncoding.PNG,
+    quality: 1,
+    timeoutMs,
+  };
+}
+
+describe('ManagedContextPool', () => {
+  it('renders encoded images', async () => {
+    const pool = new ManagedContextPool();
+
+    const data = await pool.renderImage(makeRequest('red'));
+    const header = new Uint8Array(data, 0, 4);
+    expect(Array.from(header)).toEqual([0x89, 0x50, 0x4e, 0x47]);
+
+    pool.dispose();
+  });
+
+  it('reuses contexts between requests', async () => {
+    const pool = new ManagedContextPool({ maxContexts: 2 });
+
+    const requests = [
+      pool.renderImage(makeRequest('red')),
+      pool.renderImage(makeRequest('green')),
+      pool.renderImage(makeRequest('blue')),
+    ];
+    expect(pool.getContextsCount()).toBe(2);
+    expect(pool.getPendingRequestsCount()).toBe(1);
+
+    const results = await Promise.all(requests);
+    expect(results.length).toBe(3);
+    expect(pool.getContextsCount()).toBe(2);
+    expect(pool.getPendingRequestsCount()).toBe(0);
+
+    pool.dispose();
+  });
+
+  it('rejects requests past their deadline', async () => {
+    const pool = new ManagedContextPool({ maxContexts: 1 });
+
+    const request = pool.renderImage(makeRequest('red'));
+    const expiredRequest = pool.renderImage(makeRequest('green', 0));
+
+    await expectAsync(expiredRequest).toBeRejected();
+    await request;
+
+    pool.dispose();
+  });
+
+  it('rejects requests past the queue limit', async () => {
+    const pool = new ManagedContextPool({ maxContexts: 1, maxPendingRequests: 1 });
+
+    const requests = [pool.renderImage(makeRequest('red')), pool.renderImage(makeRequest('green'))];
+    await expectAsync(pool.renderImage(makeRequest('blue'))).toBeRejected();
+    await Promise.all(requests);
+
+    pool.dispose();
+  });
+});
@@ -1,3 +1,4 @@
+import { ImageEncoding } from '../src/IBitmap';
 import { INativeBitmap } from '../src/INativeBitmap';
 import {
   SnapDrawingValdiContext,
@@ -5,6 +6,7 @@ import {
   SnapDrawingFrameNative,
   AssetTrackerCallback,
   AssetTrackerEventType,
+  EncodeFrameCallback,
 } from '../src/ManagedContextNative';
 
 /** Internal no-op tracker state */
@@ -59,3 +61,15 @@ export function rasterFrame(
 ): void {
   // no-op
 }
+
+export function encodeFrame(
+  _native: SnapDrawingFrameNative,
+  _width: number,
+  _height: number,
+  _encoding: ImageEncoding,
+  _quality: number,
+  callback: EncodeFrameCallback,
+): void {
+  // Stub: nothing is rasterized on web
+  callback(new ArrayBuffer(0), undefined);
+}
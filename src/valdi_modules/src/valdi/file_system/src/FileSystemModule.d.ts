@@ -19,5 +19,21 @@ export interface FileSystemModule {
 
   writeFileSync(path: string, data: ArrayBuffer | string): void;
 
+  /**
+   * Reads the file off the JS thread, and calls the completion with either the content or an error.
+   */
+  readFile(
+    path: string,
+    options: ReadFileOptions | undefined,
+    completion: (content: string | ArrayBuffer | undefined, error: string | undefined) => void,
+  ): void;
+
+  /**
+   * Writes the file off the JS thread, and calls the completion with an error if it failed.
+   * Writes to a file which are still pending are coalesced: only the last content is written.
+   * Reads from the same FileSystem see the pending writes.
+   */
+  writeFile(path: string, data: ArrayBuffer | string, completion: (error: string | undefined) => void): void;
+
   currentWorkingDirectory(): string;
 }
\ No newline at end of file
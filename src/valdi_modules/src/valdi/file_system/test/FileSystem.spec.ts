@@ -47,6 +47,30 @@ describe('File System Module', () => {
     expect(resultFromFileRemove).toBeTrue();
   });
 
+  it('should write and read a file asynchronously', done => {
+    const fileContent = 'async test data for file';
+    fs.writeFile(newFSItems.file, fileContent, writeError => {
+      expect(writeError).toBeUndefined();
+
+      fs.readFile(newFSItems.file, { encoding: 'utf8' }, (result, readError) => {
+        expect(readError).toBeUndefined();
+        expect(result).toEqual(fileContent);
+        expect(fs.removeSync(newFSItems.file)).toBeTrue();
+        done();
+      });
+    });
+  });
+
+  it('should return an error for async read file operation if file does not exist', done => {
+    const fileName = `${VALDI_MODULES_ROOT}/file_system/test/no_file`;
+
+    fs.readFile(fileName, undefined, (result, error) => {
+      expect(result).toBeUndefined();
+      expect(error).toEqual(`Could not read the file at path: '${fileName}'`);
+      done();
+    });
+  });
+
   it('should get current root directory for client repository', () => {
     expect(() => fs.currentWorkingDirectory()).not.toThrow();
   });
@@ -118,6 +118,20 @@ const fsStub: FileSystemModule = {
     files.set(p, bytes);
   },
 
+  readFile(
+    path: string,
+    options: ReadFileOptions | undefined,
+    completion: (content: string | ArrayBuffer | undefined, error: string | undefined) => void,
+  ): void {
+    const content = this.readFileSync(path, options);
+    setTimeout(() => completion(content, undefined), 0);
+  },
+
+  writeFile(path: string, data: ArrayBuffer | string, completion: (error: string | undefined) => void): void {
+    this.writeFileSync(path, data);
+    setTimeout(() => completion(undefined), 0);
+  },
+
   currentWorkingDirectory(): string {
     return CWD;
   },
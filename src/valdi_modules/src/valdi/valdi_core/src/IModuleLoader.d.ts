@@ -14,6 +14,7 @@ export interface IModuleLoader {
   unload(paths: string[], isHotReloading: boolean, disableHotReloadDenyList: boolean): string[];
   unloadAllUnused(modulesToKeep: string[]): string[];
   preload(path: string, maxDepth: number): void;
+  getUntouchedPreloadedModules(): string[];
   isLoaded(path: string): boolean;
   hasModuleFactory(path: string): boolean;
   unregisterModule(path: string): void;
@@ -6,9 +6,9 @@ import { ElementFrame } from './ValdiRuntime';
 import { Style } from './Style';
 
 export type VisibilityObserver = (
-  appearingElements: number[],
-  disappearingElements: number[],
-  viewportUpdates: number[],
+  appearingElements: ArrayLike<number>,
+  disappearingElements: ArrayLike<number>,
+  viewportUpdates: ArrayLike<number>,
   eventTime: number,
 ) => void;
 export type FrameObserver = (updates: Float64Array) => void;
@@ -15,6 +15,8 @@ import { Buffer } from './utils/Buffer';
 
 declare const runtime: ValdiRuntime;
 
+const VISIBILITY_UPDATES_HEADER_SIZE = 2;
+
 const enum RenderRequestEntryType {
   CREATE_ELEMENT = 1,
   DESTROY_ELEMENT = 2,
@@ -33,8 +35,21 @@ const enum RenderRequestEntryType {
   END_ANIMATIONS = 15,
   ON_LAYOUT_COMPLETE = 16,
   CANCEL_ANIMATION = 17,
+  SET_ATTRIBUTE_STRING = 18,
 }
 
+/**
+ * Strings up to this length are sent by their interned id from the runtime string cache
+ * instead of as attached values, which lets the native side resolve them without going
+ * through a JS value conversion. Longer strings are likely dynamic content and would
+ * grow the cache without being reused.
+ */
+const MAX_INTERNED_ATTRIBUTE_STRING_LENGTH = 64;
+/**
+ * Upper bound on the number of distinct strings interned through attribute values.
+ */
+const MAX_INTERNED_ATTRIBUTE_STRINGS = 4096;
+
 const bufferPool = [new Buffer(512)];
 
 export class JSXRendererDelegate implements IRendererDelegate {
@@ -183,6 +198,18 @@ export class JSXRendererDelegate implements IRendererDelegate {
   onElementAttributeChangeString(id: number, attributeName: string, value: string): void {
     const attributeNameParam = this.attributeCache.get(attributeName);
 
+    if (
+      value.length <= MAX_INTERNED_ATTRIBUTE_STRING_LENGTH &&
+      (this.stringCache.has(value) || this.stringCache.size < MAX_INTERNED_ATTRIBUTE_STRINGS)
+    ) {
+      this.buffer.putUint32_3(
+        RenderRequestEntryType.SET_ATTRIBUTE_STRING | (id << 8),
+        attributeNameParam,
+        this.stringCache.get(value),
+      );
+      return;
+    }
+
     let index = this.attachedValueIndexByString[value];
     if (!index) {
       const attachedValues = this.attachedValues;
@@ -351,15 +378,16 @@ export class JSXRendererDelegate implements IRendererDelegate {
   }
 
   registerVisibilityObserver(observer: VisibilityObserver) {
-    this.pendingVisibilityObserver = (
-      appearingElements,
-      disappearingElements,
-      viewportUpdates,
-      acknowledger,
-      eventTime,
-    ) => {
+    this.pendingVisibilityObserver = (updates, acknowledger, eventTime) => {
       try {
-        observer(appearingElements, disappearingElements, viewportUpdates, eventTime);
+        const appearingEnd = VISIBILITY_UPDATES_HEADER_SIZE + updates[0];
+        const disappearingEnd = appearingEnd + updates[1];
+        observer(
+          updates.subarray(VISIBILITY_UPDATES_HEADER_SIZE, appearingEnd),
+          updates.subarray(appearingEnd, disappearingEnd),
+          updates.subarray(disappearingEnd),
+          eventTime,
+        );
       } finally {
         // The acknowledger is used to workaround the fact that calls between the main thread and the js threads
         // are asynchronous.
@@ -102,6 +102,10 @@ interface Module {
   sourceMap: ISourceMap | undefined | null;
   sourceMapLineOffset?: number;
   disposables?: (() => void)[];
+  // Whether the module was evaluated by preload() before anything used it
+  evaluatedByPreload?: boolean;
+  // Whether the exports of the module were used after it was evaluated
+  exportsAccessed?: boolean;
 }
 
 function isModuleUsed(jsModule: Module) {
@@ -204,6 +208,9 @@ export class ModuleLoader implements IModuleLoader {
     }
 
     if (module.lazyExports) {
+      if (module.status === ModuleStatus.UNLOADED) {
+        module.evaluatedByPreload = true;
+      }
       module.lazyExports();
     }
 
@@ -216,6 +223,22 @@ export class ModuleLoader implements IModuleLoader {
     }
   }
 
+  /**
+   * Returns the paths of the modules which were evaluated by preload() but whose exports
+   * were never accessed since. Those modules were evaluated for nothing, and are good
+   * candidates to be removed from the preloaded modules.
+   */
+  getUntouchedPreloadedModules(): string[] {
+    const out: string[] = [];
+    for (const modulePath in this.modules) {
+      const jsModule = this.modules[modulePath];
+      if (jsModule.evaluatedByPreload && !jsModule.exportsAccessed) {
+        out.push(modulePath);
+      }
+    }
+    return out;
+  }
+
   hasModuleFactory(path: string): boolean {
     const resolvedPath = resolveAbsoluteImportFromPath(path);
     return this.moduleFactory[resolvedPath.absolutePath] !== undefined;
@@ -477,6 +500,7 @@ export class ModuleLoader implements IModuleLoader {
 
       if (jsModule.lazyExports && jsModule.status !== ModuleStatus.LOADING) {
         if (disableProxy || this.commonJsCompatible) {
+          jsModule.exportsAccessed = true;
           return jsModule.lazyExports();
         }
 
@@ -510,6 +534,7 @@ export class ModuleLoader implements IModuleLoader {
 
       if (jsModule.lazyExports) {
         if (disableProxy || this.commonJsCompatible) {
+          jsModule.exportsAccessed = true;
           return jsModule.lazyExports();
         }
 
@@ -588,6 +613,7 @@ export class ModuleLoader implements IModuleLoader {
     } else {
       return new Proxy(jsExports, {
         get(target, key) {
+          jsModule.exportsAccessed = true;
           if (!didEval) {
             lazyExports();
           }
@@ -26,11 +26,10 @@ export interface RenderRequest {
   frameObserver?: NativeFrameObserver;
 }
 
-export type NativeVisibilityObserver = (
-  disappearingElements: number[],
-  appearingElements: number[],
-  viewportUpdates: number[],
-  acknowledger: () => void,
-  eventTime: number,
-) => void;
+/**
+ * The visibility updates are laid out as:
+ * [appearingCount][disappearingCount][appearingElements...][disappearingElements...][viewportUpdates...]
+ * Every viewport update is: [elementId][x][y][width][height]
+ */
+export type NativeVisibilityObserver = (updates: Float64Array, acknowledger: () => void, eventTime: number) => void;
 export type NativeFrameObserver = (updates: Float64Array) => void;
@@ -955,9 +955,10 @@ export class Renderer implements IRenderer {
     this.popVirtualNode();
   }
 
-  private callVisiblityChanged(elementIds: number[], visible: boolean, eventTime: EventTime) {
-    for (const elementId of elementIds) {
-      const element = this.elementById[elementId];
+  private callVisiblityChanged(elementIds: ArrayLike<number>, visible: boolean, eventTime: EventTime) {
+    const length = elementIds.length;
+    for (let i = 0; i < length; i++) {
+      const element = this.elementById[elementIds[i]];
       if (!element) {
         continue;
       }
@@ -972,7 +973,7 @@ export class Renderer implements IRenderer {
     }
   }
 
-  private callViewportChanged(viewportChanges: number[], eventTime: EventTime) {
+  private callViewportChanged(viewportChanges: ArrayLike<number>, eventTime: EventTime) {
     const length = viewportChanges.length;
 
     for (let i = 0; i < length; ) {
@@ -999,9 +1000,9 @@ export class Renderer implements IRenderer {
   }
 
   private elementsVisibilityChanged(
-    appearingElements: number[],
-    disappearingElements: number[],
-    viewportChanges: number[],
+    appearingElements: ArrayLike<number>,
+    disappearingElements: ArrayLike<number>,
+    viewportChanges: ArrayLike<number>,
     eventTime: EventTime,
   ) {
     this.batchUpdates(() => {
@@ -5,12 +5,21 @@ export type StringInterner = (str: string) => number;
 export class StringCache {
   private interner: StringInterner;
   private cache: StringMap<number>;
+  private count = 0;
 
   constructor(interner: StringInterner) {
     this.interner = interner;
     this.cache = {};
   }
 
+  get size(): number {
+    return this.count;
+  }
+
+  has(str: string): boolean {
+    return this.cache[str] !== undefined;
+  }
+
   get(str: string): number {
     let id = this.cache[str];
     if (id !== undefined) {
@@ -19,6 +28,7 @@ export class StringCache {
 
     id = this.interner(str);
     this.cache[str] = id;
+    this.count++;
 
     return id;
   }
@@ -1,4 +1,5 @@
 import { makeSingleCallInterruptibleCallback } from 'valdi_core/src/utils/FunctionUtils';
+import { invalidateMessageFields } from './FieldFactory';
 import { getProtobufModule } from './ValdiProtobufModule';
 import { IArena, IMessage, IMessageConstructor, JSONPrintOptions } from './types';
 import { ValdiProtobufModule, INativeMessageArena, INativeMessageIndex } from './ValdiProtobuf';
@@ -179,4 +180,24 @@ export class Arena implements IArena {
     const messageIndex = this.protobuf.copyMessage(this.$native, message.$index, otherArena.$native);
     return this.getMessageInstance(message.constructor as IMessageConstructor, messageIndex);
   }
+
+  diffMessages(previous: IMessage, next: IMessage): number[] {
+    this.checkMessageArena(previous);
+    this.checkMessageArena(next);
+    return this.protobuf.diffMessages(this.$native, previous.$index, next.$index);
+  }
+
+  applyMessagePatch(message: IMessage, patch: IMessage, paths: readonly string[]): number[] {
+    this.checkMessageArena(message);
+    this.checkMessageArena(patch);
+    const fieldIndexes = this.protobuf.applyMessagePatch(this.$native, message.$index, patch.$index, paths as string[]);
+    invalidateMessageFields(message);
+    return fieldIndexes;
+  }
+
+  private checkMessageArena(message: IMessage): void {
+    if (message.$arena !== this) {
+      throw Error('Message does not belong to this Arena');
+    }
+  }
 }
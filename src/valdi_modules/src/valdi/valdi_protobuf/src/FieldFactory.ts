@@ -311,6 +311,14 @@ export interface IMessageField {
   toNativeDirect(arena: IArena, value: any): any;
 }
 
+/**
+ * Discard the field values cached on the message, which have to be resolved again
+ * after the message was modified natively.
+ */
+export function invalidateMessageFields(message: IMessage): void {
+  delete (message as any)[JS_FIELDS_KEY];
+}
+
 function resolveFields(
   message: IMessage,
   converters: readonly (ValueConverterPair<FieldValues, NativeFieldValues> | undefined)[],
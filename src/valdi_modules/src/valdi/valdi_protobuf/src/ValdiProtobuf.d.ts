@@ -134,4 +134,17 @@ export interface ValdiProtobufModule {
     messageIndex: INativeMessageIndex,
     fromArena: INativeMessageArena,
   ): INativeMessageIndex;
+
+  diffMessages(
+    arena: INativeMessageArena,
+    previousMessageIndex: INativeMessageIndex,
+    nextMessageIndex: INativeMessageIndex,
+  ): number[];
+
+  applyMessagePatch(
+    arena: INativeMessageArena,
+    messageIndex: INativeMessageIndex,
+    patchMessageIndex: INativeMessageIndex,
+    paths: string[],
+  ): number[];
 }
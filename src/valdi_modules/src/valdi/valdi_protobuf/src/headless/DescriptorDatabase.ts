@@ -295,7 +295,7 @@ export class DescriptorDatabase {
 
   getDescriptorSetFromBuffer(buffer: Uint8Array): Uint8Array {
     const tag = String.fromCharCode(...buffer.subarray(0, 8));
-    if (tag != 'VALDIPRO') {
+    if (tag != 'VALDIPRO' && tag != 'VALDIPRC') {
       // no tag, the entire buffer is a file descriptor set
       return buffer;
     }
@@ -109,4 +109,15 @@ export class HeadlessValdiProtobufModule implements ValdiProtobufModule {
   copyMessage(arena: INativeMessageArena, messageIndex: number, fromArena: INativeMessageArena): number {
     throw new Error('Method not implemented.');
   }
+  diffMessages(arena: INativeMessageArena, previousMessageIndex: number, nextMessageIndex: number): number[] {
+    throw new Error('Method not implemented.');
+  }
+  applyMessagePatch(
+    arena: INativeMessageArena,
+    messageIndex: number,
+    patchMessageIndex: number,
+    paths: string[],
+  ): number[] {
+    throw new Error('Method not implemented.');
+  }
 }
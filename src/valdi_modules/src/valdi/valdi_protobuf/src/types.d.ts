@@ -91,6 +91,18 @@ export interface IArena {
   setMessageField(message: IMessage, fieldIndex: number, totalFieldsLength: number, fieldValue: any): void;
   getMessageInstance(constructor: IMessageConstructor, messageIndex: INativeMessageIndex): IMessage;
   copyMessage(message: IMessage): IMessage;
+  /**
+   * Compare the next version of a message with its previous version, and return the indexes
+   * of the fields which changed. The nested messages which did not change are shared between
+   * both versions, such that only the changed fields need to be rendered again.
+   */
+  diffMessages(previous: IMessage, next: IMessage): number[];
+  /**
+   * Apply in place the fields of the patch designated by the given field mask paths, which are
+   * dot separated field names like "user.display_name". Fields which are not set in the patch
+   * are cleared. Returns the indexes of the fields of the message which were patched.
+   */
+  applyMessagePatch(message: IMessage, patch: IMessage, paths: readonly string[]): number[];
 }
 
 export type IMessageConstructor = {
@@ -2256,6 +2256,47 @@ describe('Valdi Proto Runtime', () => {
     });
   });
 
+  describe('diff and patch', () => {
+    it('returns the indexes of the changed fields', () => {
+      const arena = new Arena();
+      const previous = test.Message.decode(
+        arena,
+        test.Message.create(arena, { int32: 1, string: 'a', otherMessage: { value: 'nested' } }).encode(),
+      );
+      const next = test.Message.decode(
+        arena,
+        test.Message.create(arena, { int32: 1, string: 'b', otherMessage: { value: 'nested' } }).encode(),
+      );
+
+      // Field indexes follow the declaration order of the fields
+      expect(arena.diffMessages(previous, next)).toEqual([13]);
+      expect(arena.diffMessages(next, next)).toEqual([]);
+      expect(next.otherMessage!.$index).toBe(previous.otherMessage!.$index);
+    });
+
+    it('can apply a patch in place', () => {
+      const arena = new Arena();
+      const message = test.Message.create(arena, { int32: 1, string: 'a', selfMessage: { int32: 2, string: 'kept' } });
+      expect(message.selfMessage!.int32).toBe(2);
+
+      const patch = test.Message.create(arena, { int32: 3, selfMessage: { int32: 4, string: 'ignored' } });
+
+      expect(arena.applyMessagePatch(message, patch, ['string', 'int32', 'self_message.int32'])).toEqual([0, 13, 16]);
+
+      expect(message.int32).toBe(3);
+      expect(message.string).toBe('');
+      expect(message.selfMessage!.int32).toBe(4);
+      expect(message.selfMessage!.string).toBe('kept');
+    });
+
+    it('fails to apply a patch with an invalid path', () => {
+      const arena = new Arena();
+      const message = test.Message.create(arena, { int32: 1 });
+
+      expect(() => arena.applyMessagePatch(message, message, ['unknown'])).toThrow();
+    });
+  });
+
   describe('Reflection', () => {
     it('can parse and load proto files', () => {
       interface MyTestMessage {
@@ -347,6 +347,50 @@ describe('ModuleLoader', () => {
     expect(error?.stack).not.toEqual(error2?.stack);
   });
 
+  it('reports preloaded modules which were never used', () => {
+    const module1: JsModuleFunc = (require, module, exports) => {
+      exports.module2 = require('./module2');
+      require('./module3');
+    };
+
+    const module2: JsModuleFunc = (require, module, exports) => {
+      exports.value = 42;
+    };
+
+    const module3: JsModuleFunc = (require, module, exports) => {
+      exports.value = 43;
+    };
+
+    const moduleByPath: StringMap<JsModuleFunc> = {
+      'my_module/src/module1': module1,
+      'my_module/src/module2': module2,
+      'my_module/src/module3': module3,
+    };
+
+    const loader = new ModuleLoader(
+      (path, require, module, exports): JSEvalResult => {
+        moduleByPath[path]!(require, module, exports);
+        return undefined;
+      },
+      undefined,
+      undefined,
+      false,
+    );
+
+    loader.preload('my_module/src/module1', 1);
+
+    expect(loader.getUntouchedPreloadedModules().sort()).toEqual([
+      'my_module/src/module1',
+      'my_module/src/module2',
+      'my_module/src/module3',
+    ]);
+
+    const module = loader.load('my_module/src/module1');
+    expect(module.module2.value).toBe(42);
+
+    expect(loader.getUntouchedPreloadedModules()).toEqual(['my_module/src/module3']);
+  });
+
   it('preloadsValdiModuleOnImport', () => {
     const preloadedValdiModules: string[] = [];
     const valdiModulePreloader = (name: string) => {
@@ -8,3 +8,12 @@ export interface IWorkerServiceClient<T> {
   readonly api: T;
   dispose(): void;
 }
+
+export interface IWorkerPoolClient<T> {
+  /**
+   * Number of workers in the pool
+   */
+  readonly size: number;
+  readonly api: T;
+  dispose(): void;
+}
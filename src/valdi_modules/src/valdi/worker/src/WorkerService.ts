@@ -1,8 +1,9 @@
 /* eslint-disable @typescript-eslint/no-unsafe-return */
 /* eslint-disable @typescript-eslint/no-unsafe-member-access */
-import { IWorkerServiceClient } from './IWorkerService';
+import { IWorkerPoolClient, IWorkerServiceClient } from './IWorkerService';
 import { WorkerServiceEntryPoint, WorkerServiceEntryPointConstructor } from './WorkerServiceEntryPoint';
 import { ManagedWorker } from './internal/ManagedWorker';
+import { ManagedWorkerPool } from './internal/ManagedWorkerPool';
 import { ManagedWorkerService } from './internal/ManagedWorkerService';
 
 interface ServiceWorkerExecutorGetters {
@@ -66,6 +67,32 @@ export function startWorkerService<T, A extends unknown[], Service extends Worke
   return doStartWorkerService(workerEntryPoint, args, serviceWorkerExecutor);
 }
 
+/**
+ * Start a pool of worker services with the given entry point, each running in its own worker,
+ * passing the given arguments to each of them. Calls made on the api of the returned client are
+ * dispatched to the service with the fewest calls in flight, which allows independent tasks like
+ * parsing or decoding payloads to run in parallel. The services should therefore be stateless.
+ * Payloads made of typed arrays are passed to the workers without being copied.
+ * The pool will remain in memory until dispose() is called.
+ */
+export function startWorkerPool<T, A extends unknown[], Service extends WorkerServiceEntryPoint<T, A>>(
+  workerEntryPoint: WorkerServiceEntryPointConstructor<T, A, Service>,
+  args: A,
+  size: number,
+): IWorkerPoolClient<T> {
+  if (size < 1) {
+    throw new Error(`Invalid WorkerPool size ${size}`);
+  }
+
+  const clients: IWorkerServiceClient<T>[] = [];
+  for (let i = 0; i < size; i++) {
+    const managedWorker = new ManagedWorker('worker/src/WorkerServiceExecutor', WORKER_SERVICE_EXECUTOR_KEEP_ALIVE_MS);
+    clients.push(doStartWorkerService(workerEntryPoint, args, managedWorker));
+  }
+
+  return new ManagedWorkerPool(clients);
+}
+
 function launchArgumentsEqual(left: readonly unknown[], right: readonly unknown[]): boolean {
   if (left.length !== right.length) {
     return false;
@@ -0,0 +1,100 @@
+/* eslint-disable @typescript-eslint/no-unsafe-member-access */
+/* eslint-disable @typescript-eslint/no-explicit-any */
+import { CancelablePromise } from 'valdi_core/src/CancelablePromise';
+import { IWorkerPoolClient, IWorkerServiceClient } from '../IWorkerService';
+import { canBeUsedAsProxyMethod } from '../utils/WorkerServiceBridgeUtils';
+
+type AnyPromiseFunction = (...args: unknown[]) => CancelablePromise<unknown>;
+
+interface WorkerPoolSlot<T> {
+  readonly client: IWorkerServiceClient<T>;
+  pendingCalls: number;
+}
+
+/**
+ * Dispatches the calls made on its api to a fixed set of worker services, each
+ * running in its own worker. Each call goes to the service with the fewest calls
+ * in flight, so that independent calls can be processed concurrently.
+ */
+export class ManagedWorkerPool<T> implements IWorkerPoolClient<T> {
+  readonly api: T;
+
+  private slots: WorkerPoolSlot<T>[];
+
+  constructor(clients: IWorkerServiceClient<T>[]) {
+    this.slots = clients.map(client => ({ client, pendingCalls: 0 }));
+    this.api = this.makeAPIProxy();
+  }
+
+  get size(): number {
+    return this.slots.length;
+  }
+
+  dispose(): void {
+    const slots = this.slots;
+    this.slots = [];
+
+    for (const slot of slots) {
+      slot.client.dispose();
+    }
+  }
+
+  private nextSlot(name: PropertyKey): WorkerPoolSlot<T> {
+    let bestSlot: WorkerPoolSlot<T> | undefined;
+    for (const slot of this.slots) {
+      if (!bestSlot || slot.pendingCalls < bestSlot.pendingCalls) {
+        bestSlot = slot;
+      }
+    }
+
+    if (!bestSlot) {
+      throw new Error(`Cannot call ${name.toString()}: WorkerPool was disposed`);
+    }
+
+    return bestSlot;
+  }
+
+  private makeAPIProxyFunction(name: PropertyKey): AnyPromiseFunction {
+    const proxyFunction = (...args: unknown[]): CancelablePromise<unknown> => {
+      const slot = this.nextSlot(name);
+      const fn = (slot.client.api as any)[name] as AnyPromiseFunction;
+
+      slot.pendingCalls++;
+      let settled = false;
+      const onSettled = () => {
+        if (!settled) {
+          settled = true;
+          slot.pendingCalls--;
+        }
+      };
+
+      const result = fn(...args);
+      result.then(onSettled, onSettled);
+
+      return result;
+    };
+
+    Object.defineProperty(proxyFunction, 'name', { value: name });
+
+    return proxyFunction;
+  }
+
+  private makeAPIProxy(): T {
+    return new Proxy(
+      {},
+      {
+        get: (target: any, prop: PropertyKey): AnyPromiseFunction | undefined => {
+          let fn = target[prop] as AnyPromiseFunction | undefined;
+          if (!fn) {
+            if (canBeUsedAsProxyMethod(prop)) {
+              fn = this.makeAPIProxyFunction(prop);
+              target[prop] = fn;
+            }
+          }
+
+          return fn;
+        },
+      },
+    ) as T;
+  }
+}
@@ -1,8 +1,9 @@
 import { toError } from 'valdi_core/src/utils/ErrorUtils';
 import 'jasmine/src/jasmine';
-import { IWorkerServiceClient } from 'worker/src/IWorkerService';
+import { IWorkerPoolClient, IWorkerServiceClient } from 'worker/src/IWorkerService';
 import {
   getWorkerServiceIdsForEntryPoint,
+  startWorkerPool,
   startWorkerService,
   useOrStartWorkerService,
   useWorkerService,
@@ -184,4 +185,29 @@ describe('WorkerService', () => {
       client.dispose();
     }
   });
+
+  it('dispatches pool calls to the least busy worker', async () => {
+    const pool: IWorkerPoolClient<ICalculator> = startWorkerPool(CalculatorServiceEntryPoint, [5], 3);
+
+    try {
+      expect(pool.size).toBe(3);
+
+      // Concurrent calls are spread across the workers
+      await Promise.all([pool.api.add(1), pool.api.add(2)]);
+
+      const values = await Promise.all([pool.api.value(), pool.api.value(), pool.api.value()]);
+
+      expect(values).toEqual([6, 7, 5]);
+    } finally {
+      pool.dispose();
+    }
+  });
+
+  it('rejects pool calls after dispose', () => {
+    const pool: IWorkerPoolClient<ICalculator> = startWorkerPool(CalculatorServiceEntryPoint, [0], 2);
+    pool.dispose();
+
+    expect(pool.size).toBe(0);
+    expect(() => pool.api.value()).toThrowError('Cannot call value: WorkerPool was disposed');
+  });
 });
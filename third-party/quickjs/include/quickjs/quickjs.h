@@ -726,6 +726,9 @@ static inline int JS_SetProperty(JSContext* ctx, JSValueConst this_obj, JSAtom p
 
 void JS_SetPropertyCacheEnabledRT(JSRuntime* rt, int enabled);
 int JS_SetProperty_tsn(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSValue val);
+int JS_SetPropertyWithIC_tsn(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSValue val, JS_SetPropCache_tsn* ic);
+void JS_FreeSetPropCache_tsn(JSRuntime* rt, JS_SetPropCache_tsn* ic);
+void JS_MarkSetPropCache_tsn(JSRuntime* rt, JS_SetPropCache_tsn* ic, JS_MarkFunc* mark_func);
 int JS_SetPropertyUint32(JSContext* ctx, JSValueConst this_obj, uint32_t idx, JSValue val);
 int JS_SetPropertyInt64(JSContext* ctx, JSValueConst this_obj, int64_t idx, JSValue val);
 int JS_SetPropertyStr(JSContext* ctx, JSValueConst this_obj, const char* prop, JSValue val);
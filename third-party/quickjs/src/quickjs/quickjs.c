@@ -8290,6 +8290,23 @@ static force_inline int JS_SetPropertyWithIC(JSContext* ctx, JSValueConst obj, J
     return JS_SetPropertyInternalUpdateIC(ctx, obj, prop, val, obj, flags, ic);
 }
 
+/* SNAP: expose the write cache to tsn generated code, which owns the cache slots */
+int JS_SetPropertyWithIC_tsn(JSContext* ctx, JSValueConst this_obj, JSAtom prop, JSValue val, JS_SetPropCache_tsn* ic) {
+    return JS_SetPropertyWithIC(ctx, this_obj, prop, val, JS_PROP_THROW, ic);
+}
+
+void JS_FreeSetPropCache_tsn(JSRuntime* rt, JS_SetPropCache_tsn* ic) {
+    js_free_shape_null(rt, ic->old_shape);
+    js_free_shape_null(rt, ic->new_shape);
+    ic->old_shape = NULL;
+    ic->new_shape = NULL;
+}
+
+void JS_MarkSetPropCache_tsn(JSRuntime* rt, JS_SetPropCache_tsn* ic, JS_MarkFunc* mark_func) {
+    if (ic->new_shape) mark_func(rt, &ic->new_shape->header);
+    if (ic->old_shape) mark_func(rt, &ic->old_shape->header);
+}
+
 /* flags can be JS_PROP_THROW or JS_PROP_THROW_STRICT */
 static int JS_SetPropertyValue(JSContext* ctx, JSValueConst this_obj, JSValue prop, JSValue val, int flags) {
     if (likely(JS_VALUE_GET_TAG(this_obj) == JS_TAG_OBJECT && JS_VALUE_GET_TAG(prop) == JS_TAG_INT)) {
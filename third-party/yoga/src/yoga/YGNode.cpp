@@ -28,6 +28,8 @@ YGNode::YGNode(YGNode&& node) {
   children_ = std::move(node.children_);
   config_ = node.config_;
   resolvedDimensions_ = node.resolvedDimensions_;
+  relayoutBoundaryEnabled_ = node.relayoutBoundaryEnabled_;
+  hasConfinedDirtiness_ = node.hasConfinedDirtiness_;
   for (auto c : children_) {
     c->setOwner(c);
   }
@@ -212,6 +214,9 @@ void YGNode::setDirty(bool isDirty) {
     return;
   }
   flags_.at<isDirty_>() = isDirty;
+  if (!isDirty) {
+    hasConfinedDirtiness_ = false;
+  }
   if (isDirty && dirtied_) {
     dirtied_(this);
   }
@@ -394,9 +399,55 @@ void YGNode::markDirtyAndPropogate() {
     setDirty(true);
     setLayoutComputedFlexBasis(YGFloatOptional());
     if (owner_) {
-      owner_->markDirtyAndPropogate();
+      owner_->markDirtyFromChild();
+    }
+  } else if (hasConfinedDirtiness_) {
+    // The node itself changed, which can now affect its owner
+    hasConfinedDirtiness_ = false;
+    if (owner_) {
+      owner_->markDirtyFromChild();
+    }
+  }
+}
+
+void YGNode::markDirtyFromChild() {
+  if (!isRelayoutBoundary()) {
+    markDirtyAndPropogate();
+    return;
+  }
+  if (!flags_.at<isDirty_>()) {
+    hasConfinedDirtiness_ = true;
+    setDirty(true);
+    setLayoutComputedFlexBasis(YGFloatOptional());
+  }
+}
+
+static bool YGIsDimensionDefined(const CompactValue value) {
+  return !value.isUndefined() && !value.isAuto();
+}
+
+bool YGNode::isRelayoutBoundary() const {
+  if (!relayoutBoundaryEnabled_ || owner_ == nullptr ||
+      style_.display() != YGDisplayFlex) {
+    return false;
+  }
+  if (!YGIsDimensionDefined(style_.dimensions()[YGDimensionWidth]) ||
+      !YGIsDimensionDefined(style_.dimensions()[YGDimensionHeight])) {
+    return false;
+  }
+  // The baseline of the node depends on its children
+  if (style_.alignSelf() == YGAlignBaseline ||
+      (style_.alignSelf() == YGAlignAuto &&
+       owner_->getStyle().alignItems() == YGAlignBaseline)) {
+    return false;
+  }
+  // The paddings are resolved against the size of the owner
+  for (int edge = YGEdgeLeft; edge <= YGEdgeAll; edge++) {
+    if (YGValue(style_.padding()[edge]).unit == YGUnitPercent) {
+      return false;
     }
   }
+  return true;
 }
 
 void YGNode::markDirtyAndPropogateDownwards() {
@@ -40,6 +40,8 @@ private:
   Flags flags_ =
       {true, false, false, YGNodeTypeDefault, false, false, false, false};
   uint8_t reserved_ = 0;
+  bool relayoutBoundaryEnabled_ = false;
+  bool hasConfinedDirtiness_ = false;
   union {
     YGMeasureFunc noContext;
     MeasureWithContextFn withContext;
@@ -69,6 +71,8 @@ private:
   void setMeasureFunc(decltype(measure_));
   void setBaselineFunc(decltype(baseline_));
 
+  void markDirtyFromChild();
+
   void useWebDefaults() {
     flags_.at<useWebDefaults_>() = true;
     style_.flexDirection() = YGFlexDirectionRow;
@@ -177,6 +181,15 @@ public:
 
   bool isDirty() const { return flags_.at<isDirty_>(); }
 
+  // Whether the node was dirtied by one of its descendants while being a
+  // relayout boundary, in which case its owner was left untouched.
+  bool hasConfinedDirtiness() const { return hasConfinedDirtiness_; }
+
+  // Whether the size of the node is independent of its content, in which case
+  // the dirtiness of its descendants does not propagate past it. The node then
+  // needs to be laid out on its own with its last computed size.
+  bool isRelayoutBoundary() const;
+
   std::array<YGValue, 2> getResolvedDimensions() const {
     return resolvedDimensions_;
   }
@@ -276,6 +289,9 @@ public:
   YG_DEPRECATED void setConfig(YGConfigRef config) { config_ = config; }
 
   void setDirty(bool isDirty);
+  void setRelayoutBoundaryEnabled(bool relayoutBoundaryEnabled) {
+    relayoutBoundaryEnabled_ = relayoutBoundaryEnabled;
+  }
   void setLayoutLastOwnerDirection(YGDirection direction);
   void setLayoutComputedFlexBasis(const YGFloatOptional computedFlexBasis);
   void setLayoutComputedFlexBasisGeneration(
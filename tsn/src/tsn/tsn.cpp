@@ -1447,6 +1447,11 @@ static void __tsn_module_finalize(JSRuntime* rt, JSValue value) {
     for (size_t i = 0; i < constants_length; i++) {
         JS_FreeValueRT(rt, module->constants[i]);
     }
+    // The write caches retain the shapes they recorded
+    auto setprop_cache_slots = module->setprop_cache_slots;
+    for (size_t i = 0; i < setprop_cache_slots; i++) {
+        JS_FreeSetPropCache_tsn(rt, &module->setprop_cache[i]);
+    }
 
     js_free_rt(rt, module);
 }
@@ -1456,6 +1461,9 @@ static void __tsn_module_mark(JSRuntime* rt, JSValueConst val, JS_MarkFunc* mark
     for (size_t i = 0; i < module->constants_length; i++) {
         JS_MarkValue(rt, module->constants[i], mark_func);
     }
+    for (size_t i = 0; i < module->setprop_cache_slots; i++) {
+        JS_MarkSetPropCache_tsn(rt, &module->setprop_cache[i], mark_func);
+    }
 }
 
 static int tsn_register_class(tsn_vm* ctx, JSClassDef* classDef, JSClassID classID) {
@@ -1728,20 +1736,29 @@ tsn_value tsn_call_constructor_vargs(tsn_vm* ctx,
     return result;
 }
 
-tsn_module* tsn_new_module(tsn_vm* ctx, size_t atoms_length, size_t constants_length, size_t prop_cache_slots) {
+tsn_module* tsn_new_module(tsn_vm* ctx,
+                           size_t atoms_length,
+                           size_t constants_length,
+                           size_t prop_cache_slots,
+                           size_t setprop_cache_slots) {
     auto jsModule = JS_NewObjectClass(ctx, getTSNModuleClassID());
     if (tsn_is_exception(ctx, jsModule)) {
         return nullptr;
     }
 
-    auto* module = reinterpret_cast<tsn_module*>(js_malloc(ctx,
-                                                           sizeof(tsn_module) + (sizeof(tsn_atom) * atoms_length) +
-                                                               sizeof(tsn_value) * constants_length +
-                                                               sizeof(tsn_prop_cache) * prop_cache_slots));
+    auto prop_cache_end = sizeof(tsn_module) + (sizeof(tsn_atom) * atoms_length) +
+                          sizeof(tsn_value) * constants_length + sizeof(tsn_prop_cache) * prop_cache_slots;
+    // Write caches hold pointers, unlike the packed read caches before them
+    auto setprop_cache_offset =
+        (prop_cache_end + alignof(tsn_setprop_cache) - 1) & ~(alignof(tsn_setprop_cache) - 1);
+
+    auto* module = reinterpret_cast<tsn_module*>(
+        js_malloc(ctx, setprop_cache_offset + sizeof(tsn_setprop_cache) * setprop_cache_slots));
     module->name = tsn_get_vm_helpers(ctx)->current_module_name;
     module->atoms_length = atoms_length;
     module->constants_length = constants_length;
     module->prop_cache_slots = prop_cache_slots;
+    module->setprop_cache_slots = setprop_cache_slots;
     module->module_as_value = jsModule;
     // Atoms point right after the tsn_module struct
     module->atoms = reinterpret_cast<tsn_atom*>(reinterpret_cast<uint8_t*>(module) + sizeof(tsn_module));
@@ -1751,6 +1768,8 @@ tsn_module* tsn_new_module(tsn_vm* ctx, size_t atoms_length, size_t constants_le
     module->prop_cache =
         reinterpret_cast<tsn_prop_cache*>(reinterpret_cast<uint8_t*>(module) + sizeof(tsn_module) +
                                           (sizeof(tsn_atom) * atoms_length) + (sizeof(tsn_value) * constants_length));
+    module->setprop_cache =
+        reinterpret_cast<tsn_setprop_cache*>(reinterpret_cast<uint8_t*>(module) + setprop_cache_offset);
     for (size_t i = 0; i < atoms_length; i++) {
         module->atoms[i] = 0;
     }
@@ -1760,6 +1779,9 @@ tsn_module* tsn_new_module(tsn_vm* ctx, size_t atoms_length, size_t constants_le
     for (size_t i = 0; i < prop_cache_slots; i++) {
         memset(&module->prop_cache[i], 0, sizeof(tsn_prop_cache));
     }
+    for (size_t i = 0; i < setprop_cache_slots; i++) {
+        memset(&module->setprop_cache[i], 0, sizeof(tsn_setprop_cache));
+    }
 
     JS_SetOpaque(jsModule, module);
 
@@ -2393,6 +2415,11 @@ tsn_result tsn_set_property(tsn_vm* ctx, const tsn_value* m, tsn_atom export_nam
     return tsn_process_result(ctx, JS_SetProperty_tsn(ctx, *m, export_name, JS_DupValue(ctx, *val)));
 }
 
+tsn_result tsn_set_property_ic(
+    tsn_vm* ctx, const tsn_value* m, tsn_atom prop, const tsn_value* val, tsn_setprop_cache* ic) {
+    return tsn_process_result(ctx, JS_SetPropertyWithIC_tsn(ctx, *m, prop, JS_DupValue(ctx, *val), ic));
+}
+
 tsn_result tsn_set_properties(
     tsn_vm* ctx, const tsn_value* m, int nProps, const int* atoms, const tsn_value* values, const tsn_module* module) {
     tsn_result ret = tsn_result_success;
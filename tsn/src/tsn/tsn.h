@@ -25,6 +25,7 @@ typedef JSStackFrame tsn_stackframe;
 typedef tsn_value (*tsn_module_init_fn)(tsn_vm* ctx);
 
 typedef JS_PropCache_tsn tsn_prop_cache;
+typedef JS_SetPropCache_tsn tsn_setprop_cache;
 
 typedef struct {
     const char* name;
@@ -34,6 +35,8 @@ typedef struct {
     tsn_value* constants;
     uint32_t prop_cache_slots;
     tsn_prop_cache* prop_cache;
+    uint32_t setprop_cache_slots;
+    tsn_setprop_cache* setprop_cache;
     tsn_value module_as_value;
 } tsn_module;
 
@@ -103,7 +106,11 @@ js_force_inline tsn_runtime* tsn_get_runtime(tsn_vm* ctx) {
     return JS_GetRuntime(ctx);
 }
 
-tsn_module* tsn_new_module(tsn_vm* ctx, size_t atoms_length, size_t constants_length, size_t prop_cache_slots);
+tsn_module* tsn_new_module(tsn_vm* ctx,
+                           size_t atoms_length,
+                           size_t constants_length,
+                           size_t prop_cache_slots,
+                           size_t setprop_cache_slots);
 void __tsn_deallocate_module(tsn_runtime* rt, tsn_module* module);
 
 void tsn_retain_module(tsn_vm* ctx, tsn_module* module);
@@ -203,6 +210,9 @@ tsn_result tsn_set_module_const_string(
 tsn_result tsn_set_property_str(tsn_vm* ctx, tsn_value m, const char* export_name, tsn_value val);
 
 tsn_result tsn_set_property(tsn_vm* ctx, const tsn_value* m, tsn_atom export_name, const tsn_value* val);
+// set with ic
+tsn_result tsn_set_property_ic(
+    tsn_vm* ctx, const tsn_value* m, tsn_atom prop, const tsn_value* val, tsn_setprop_cache* ic);
 
 tsn_result tsn_set_properties(
     tsn_vm* ctx, const tsn_value* m, int nProps, const int* atoms, const tsn_value* values, const tsn_module* module);
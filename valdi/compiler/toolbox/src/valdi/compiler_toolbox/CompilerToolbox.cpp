@@ -23,7 +23,7 @@ Valdi Compiler Toolbox
 Available commands:
   precompile      Precompile a JavaScript file into JS ByteCode
   image_info      Retrieves the info of an image
-  image_convert   Convert an image into a different format and or size
+  image_convert   Convert an image into one or more different formats and or sizes
   rewrite_header  Rewrites imports of a C or Objective-C header
     )D3LIM" << std::endl;
     return -1;
@@ -93,39 +93,71 @@ static int imageInfo(Arguments& arguments) {
     return EXIT_SUCCESS;
 }
 
+// Returns the value of an argument for the output at the given index, an argument given once applies to all outputs
+static std::optional<StringBox> getOutputArgumentValue(const Ref<Argument>& argument, size_t outputIndex) {
+    const auto& values = argument->values();
+    if (values.empty()) {
+        return std::nullopt;
+    }
+    return {values.size() == 1 ? values[0] : values[outputIndex]};
+}
+
 static int imageConvert(Arguments& arguments) {
     ArgumentsParser parser;
     auto input = parser.addArgument("-i")->setDescription("The input image file to convert")->setRequired();
-    auto output = parser.addArgument("-o")->setDescription("The converted output image file")->setRequired();
-    auto width = parser.addArgument("-w")->setDescription("The output width");
-    auto height = parser.addArgument("-h")->setDescription("The output height");
-    auto quality = parser.addArgument("-q")->setDescription("The quality ratio between 0 and 1, applicable for JPG");
+    auto output = parser.addArgument("-o")
+                      ->setDescription("The converted output image file, repeat it to convert into several outputs")
+                      ->setRequired()
+                      ->setAllowsMultipleValues();
+    auto width = parser.addArgument("-w")
+                     ->setDescription("The output width, given once or once per output")
+                     ->setAllowsMultipleValues();
+    auto height = parser.addArgument("-h")
+                      ->setDescription("The output height, given once or once per output")
+                      ->setAllowsMultipleValues();
+    auto quality = parser.addArgument("-q")
+                       ->setDescription("The quality ratio between 0 and 1, applicable for JPG and WebP, given once or "
+                                        "once per output")
+                       ->setAllowsMultipleValues();
 
     auto result = parser.parse(arguments);
     if (!result) {
         return printErrorAndUsage(result.error(), parser, "image_convert");
     }
 
-    std::optional<int> outputWidth;
-    std::optional<int> outputHeight;
-
-    if (width->hasValue()) {
-        outputWidth = {Value(width->value()).toInt()};
-    }
-    if (height->hasValue()) {
-        outputHeight = {Value(height->value()).toInt()};
+    auto outputsCount = output->values().size();
+    for (const auto& argument : {width, height, quality}) {
+        auto valuesCount = argument->values().size();
+        if (valuesCount > 1 && valuesCount != outputsCount) {
+            return printErrorAndUsage(
+                Error(STRING_FORMAT("Argument '{}' should be given once or once per output", argument->getName())),
+                parser,
+                "image_convert");
+        }
     }
 
-    double qualityRatio = 1.0;
-    if (quality->hasValue()) {
-        qualityRatio = Value(quality->value()).toDouble();
-        if (qualityRatio < 0 || qualityRatio > 1) {
-            return onError(Error("Quality ratio should be between 0 and 1"));
+    std::vector<snap::imagetoolbox::ImageConversionOutput> outputs;
+    outputs.reserve(outputsCount);
+
+    for (size_t i = 0; i < outputsCount; i++) {
+        auto& conversionOutput = outputs.emplace_back();
+        conversionOutput.filePath = output->values()[i];
+
+        if (auto outputWidth = getOutputArgumentValue(width, i)) {
+            conversionOutput.width = {Value(outputWidth.value()).toInt()};
+        }
+        if (auto outputHeight = getOutputArgumentValue(height, i)) {
+            conversionOutput.height = {Value(outputHeight.value()).toInt()};
+        }
+        if (auto qualityRatio = getOutputArgumentValue(quality, i)) {
+            conversionOutput.qualityRatio = Value(qualityRatio.value()).toDouble();
+            if (conversionOutput.qualityRatio < 0 || conversionOutput.qualityRatio > 1) {
+                return onError(Error("Quality ratio should be between 0 and 1"));
+            }
         }
     }
 
-    auto convertResult =
-        snap::imagetoolbox::convertImage(input->value(), output->value(), outputWidth, outputHeight, qualityRatio);
+    auto convertResult = snap::imagetoolbox::convertImage(input->value(), outputs);
     if (!convertResult) {
         return onError(convertResult.error());
     }
@@ -1,6 +1,6 @@
 package com.snap.valdi
 
-import android.content.ComponentCallbacks
+import android.content.ComponentCallbacks2
 import android.content.Context
 import android.content.res.Configuration
 import android.graphics.Bitmap
@@ -87,7 +87,7 @@ class ValdiRuntimeManager(context: Context,
                                 hostUncaughtExceptionHandler: HostUncaughtExceptionHandler? = null,
                                 tracer: Tracer? = null,
                                 val customModuleProvider: IValdiCustomModuleProvider? = null
-) : LifecycleObserver, ComponentCallbacks, FontManager.Listener {
+) : LifecycleObserver, ComponentCallbacks2, FontManager.Listener {
 
     val logger: Logger
 
@@ -773,6 +773,10 @@ class ValdiRuntimeManager(context: Context,
         snapDrawingRuntimeField?.clearCache()
     }
 
+    override fun onTrimMemory(level: Int) {
+        NativeBridge.applicationDidTrimMemory(handle.nativeHandle, level)
+    }
+
     private fun makeRegisterFontOperation(descriptor: FontDescriptor, isFallback: Boolean, dataProvider: FontDataProvider): Runnable {
         return Runnable {
             val snapDrawingRuntime = this.snapDrawingRuntime
@@ -6,6 +6,8 @@ import com.snap.valdi.attributes.impl.animations.ValdiAnimator
 abstract class AttributeHandlerDelegate {
     // Set after registration to identify the attribute name
     var attributeId: Int = 0
+    // Set on registration, identifies the delegate in the native view operations
+    var delegateId: Int = 0
     var attributeName = ""
     var viewClassName = ""
 
@@ -0,0 +1,40 @@
+package com.snap.valdi.attributes
+
+/**
+ * Holds every bound AttributeHandlerDelegate under a compact int id, which is what the
+ * native view operations refer to them by. This avoids attaching the delegate objects to
+ * each batch of view operations, which would need to be resolved through JNI on every flush.
+ * Delegates are bound once per view class and are retained for the lifetime of the process.
+ */
+object AttributeHandlerDelegateRegistry {
+
+    @Volatile
+    private var delegates = arrayOfNulls<AttributeHandlerDelegate>(64)
+    private var count = 0
+
+    fun register(delegate: AttributeHandlerDelegate): Int {
+        synchronized(this) {
+            if (delegate.delegateId != 0) {
+                return delegate.delegateId
+            }
+
+            // Ids start at 1 so that 0 identifies a delegate that was never registered
+            val delegateId = count + 1
+            var delegates = this.delegates
+            if (delegateId >= delegates.size) {
+                // Copied so that concurrent readers never observe a partially filled array
+                delegates = delegates.copyOf(delegates.size * 2)
+            }
+            delegates[delegateId] = delegate
+            count = delegateId
+            this.delegates = delegates
+
+            delegate.delegateId = delegateId
+            return delegateId
+        }
+    }
+
+    fun get(delegateId: Int): AttributeHandlerDelegate {
+        return delegates[delegateId] ?: throw IllegalStateException("Unknown attribute handler delegate ${delegateId}")
+    }
+}
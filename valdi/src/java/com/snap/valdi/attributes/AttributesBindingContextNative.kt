@@ -17,7 +17,8 @@ class AttributesBindingContextNative(viewClass: Class<*>,
                                 invalidateLayoutOnChange: Boolean,
                                 delegate: AttributeHandlerDelegate,
                                 compositeParts: Any?) {
-        val attributeId = NativeBridge.bindAttribute(nativeHandle, type, name, invalidateLayoutOnChange, delegate, compositeParts)
+        val delegateId = AttributeHandlerDelegateRegistry.register(delegate)
+        val attributeId = NativeBridge.bindAttribute(nativeHandle, type, name, invalidateLayoutOnChange, delegateId, compositeParts)
         boundAttributeIds[name] = attributeId
 
         delegate.attributeId = attributeId
@@ -3,6 +3,7 @@ package com.snap.valdi.nativebridge
 import android.view.View
 import com.snap.valdi.ViewRef
 import com.snap.valdi.attributes.AttributeHandlerDelegate
+import com.snap.valdi.attributes.AttributeHandlerDelegateRegistry
 import com.snap.valdi.attributes.BooleanAttributeHandlerDelegate
 import com.snap.valdi.attributes.CornersAttributeHandlerDelegate
 import com.snap.valdi.attributes.FloatAttributeHandlerDelegate
@@ -176,7 +177,7 @@ class ValdiViewManagerOperationsManager(private val logger: Logger) {
         var viewRef: ViewRef? = null
 
         try {
-            delegate = attachedValues[buffer.int] as T
+            delegate = AttributeHandlerDelegateRegistry.get(buffer.int) as T
             viewRef = attachedValues[buffer.int] as ViewRef
 
             receiver(delegate, viewRef)
@@ -23,15 +23,19 @@ abstract class SnapDrawingFrameScheduler {
     private var mainThreadHandler: Handler = Handler(Looper.getMainLooper())
     private var started = false
 
-    protected fun postCallbackOnHandler(handle: Choreographer.FrameCallback, handler: Handler) {
+    protected fun postCallbackOnHandler(handle: Choreographer.FrameCallback, handler: Handler, delayMs: Long = 0) {
         if (Looper.myLooper() !== handler.looper) {
             handler.post {
-                postCallbackOnHandler(handle, handler)
+                postCallbackOnHandler(handle, handler, delayMs)
             }
             return
         }
 
-        Choreographer.getInstance().postFrameCallback(handle)
+        if (delayMs > 0) {
+            Choreographer.getInstance().postFrameCallbackDelayed(handle, delayMs)
+        } else {
+            Choreographer.getInstance().postFrameCallback(handle)
+        }
     }
 
     protected abstract fun onStart(threadFactory: ThreadFactory)
@@ -66,6 +70,11 @@ abstract class SnapDrawingFrameScheduler {
         postCallbackOnHandler(CallbackHandle(handle), this.mainThreadHandler)
     }
 
+    @Keep
+    fun onMainThreadAfter(handle: Long, delayMs: Long) {
+        postCallbackOnHandler(CallbackHandle(handle), this.mainThreadHandler, delayMs)
+    }
+
     companion object {
         @JvmStatic
         private fun createThreadFactory(): ThreadFactory {
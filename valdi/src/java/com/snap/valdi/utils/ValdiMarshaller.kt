@@ -449,7 +449,7 @@ abstract class ValdiMarshaller(handle: Long): NativeHandleWrapper(handle) {
     }
 
     fun getListOfDoubles(index: Int): List<Double> {
-        return getList(index, { getDouble(it) })
+        return getDoubleArray(index).asList()
     }
 
     fun getListOfBooleans(index: Int): List<Boolean> {
@@ -476,6 +476,60 @@ abstract class ValdiMarshaller(handle: Long): NativeHandleWrapper(handle) {
         return list
     }
 
+    /**
+     * Push a list of doubles. Implementations can override it to transfer
+     * all the values at once instead of pushing them one by one.
+     */
+    open fun pushDoubleArray(values: DoubleArray): Int {
+        val objectIndex = pushList(values.size)
+        for (i in values.indices) {
+            pushDouble(values[i])
+            setListItem(objectIndex, i)
+        }
+        return objectIndex
+    }
+
+    /**
+     * Push a list of longs. Implementations can override it to transfer
+     * all the values at once instead of pushing them one by one.
+     */
+    open fun pushLongArray(values: LongArray): Int {
+        val objectIndex = pushList(values.size)
+        for (i in values.indices) {
+            pushLong(values[i])
+            setListItem(objectIndex, i)
+        }
+        return objectIndex
+    }
+
+    open fun getDoubleArray(index: Int): DoubleArray {
+        val length = getListLength(index)
+        if (length == 0) {
+            return DoubleArray(0)
+        }
+
+        val array = DoubleArray(length) {
+            getDouble(getListItemAndPopPrevious(index, it, it > 0))
+        }
+        pop()
+
+        return array
+    }
+
+    open fun getLongArray(index: Int): LongArray {
+        val length = getListLength(index)
+        if (length == 0) {
+            return LongArray(0)
+        }
+
+        val array = LongArray(length) {
+            getLong(getListItemAndPopPrevious(index, it, it > 0))
+        }
+        pop()
+
+        return array
+    }
+
     inline fun <T>pushList(list: List<T>, itemMarshaller: (T) -> Int): Int {
         val objectIndex = pushList(list.size)
 
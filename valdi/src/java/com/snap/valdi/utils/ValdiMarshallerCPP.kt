@@ -131,6 +131,10 @@ internal class ValdiMarshallerCPP: ValdiMarshaller {
 
     override fun pushByteArray(byteArray: ByteArray) = nativePushByteArray(nativeHandle, byteArray)
 
+    override fun pushDoubleArray(values: DoubleArray) = nativePushDoubleArray(nativeHandle, values)
+
+    override fun pushLongArray(values: LongArray) = nativePushLongArray(nativeHandle, values)
+
     override fun pushCppObject(cppObject: CppObjectWrapper): Int {
         return nativePushCppObject(nativeHandle, cppObject.nativeHandle)
     }
@@ -147,6 +151,14 @@ internal class ValdiMarshallerCPP: ValdiMarshaller {
         return nativeGetByteArray(nativeHandle, index) ?: throw MarshallerException("No ByteArray at index $index")
     }
 
+    override fun getDoubleArray(index: Int): DoubleArray {
+        return nativeGetDoubleArray(nativeHandle, index) ?: throw MarshallerException("No list at index $index")
+    }
+
+    override fun getLongArray(index: Int): LongArray {
+        return nativeGetLongArray(nativeHandle, index) ?: throw MarshallerException("No list at index $index")
+    }
+
     override fun getString(index: Int) = nativeGetString(nativeHandle, index)
 
     override fun getStringFromInternedString(index: Int): String {
@@ -359,6 +371,10 @@ internal class ValdiMarshallerCPP: ValdiMarshaller {
         private external fun nativePushCppObject(ptr: Long, cppHandle: Long): Int
         @JvmStatic
         private external fun nativePushByteArray(ptr: Long, byteArray: ByteArray): Int
+        @JvmStatic
+        private external fun nativePushDoubleArray(ptr: Long, doubleArray: DoubleArray): Int
+        @JvmStatic
+        private external fun nativePushLongArray(ptr: Long, longArray: LongArray): Int
 
         @JvmStatic
         private external fun nativeGetType(ptr: Long, index: Int): Int
@@ -382,6 +398,10 @@ internal class ValdiMarshallerCPP: ValdiMarshaller {
         @JvmStatic
         private external fun nativeGetByteArray(ptr: Long, index: Int): ByteArray?
         @JvmStatic
+        private external fun nativeGetDoubleArray(ptr: Long, index: Int): DoubleArray?
+        @JvmStatic
+        private external fun nativeGetLongArray(ptr: Long, index: Int): LongArray?
+        @JvmStatic
         private external fun nativeGetFunction(ptr: Long, index: Int): Any?
 
         @JvmStatic
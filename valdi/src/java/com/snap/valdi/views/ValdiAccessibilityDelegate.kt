@@ -43,6 +43,12 @@ public abstract class ValdiAccessibilityDelegate(val host: View) : Accessibility
     private var virtualViewIdFocusedKeyboard: Int = VIRTUAL_VIEW_ID_INVALID
     private var virtualViewIdHovered: Int = VIRTUAL_VIEW_ID_INVALID
 
+    private var rootInvalidationScheduled = false
+    private val invalidateRootRunnable = Runnable {
+        rootInvalidationScheduled = false
+        invalidateVirtualView(VIRTUAL_VIEW_ID_HOST, AccessibilityEventCompat.CONTENT_CHANGE_TYPE_SUBTREE)
+    }
+
     init {
         if (host == null) {
             throw IllegalArgumentException("Host may not be null")
@@ -221,7 +227,13 @@ public abstract class ValdiAccessibilityDelegate(val host: View) : Accessibility
      * Invalidation (public calls)
      */
     public fun invalidateRoot() {
-        invalidateVirtualView(VIRTUAL_VIEW_ID_HOST, AccessibilityEventCompat.CONTENT_CHANGE_TYPE_SUBTREE)
+        // Every subtree change makes the accessibility services fetch the whole hierarchy again,
+        // so only notify them once per frame, and not at all when no service is running.
+        if (rootInvalidationScheduled || !manager.isEnabled()) {
+            return
+        }
+        rootInvalidationScheduled = true
+        ViewCompat.postOnAnimation(host, invalidateRootRunnable)
     }
 
     public fun invalidateVirtualView(virtualViewId: Int) {
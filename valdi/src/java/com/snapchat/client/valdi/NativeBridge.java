@@ -158,6 +158,8 @@ public class NativeBridge {
 
     public static native void applicationIsInLowMemory(long runtimeManagerHandle);
 
+    public static native void applicationDidTrimMemory(long runtimeManagerHandle, int level);
+
     public static native String getViewNodeDebugDescription(long viewNodeHandle);
 
     public static native void valueChangedForAttribute(long runtimeHandle, long viewNodeHandle, long attributePtr, Object value);
@@ -194,7 +196,7 @@ public class NativeBridge {
                                            int type,
                                            String name,
                                            boolean invalidateLayoutOnChange,
-                                           Object delegate,
+                                           int delegateId,
                                            Object compositeParts);
     public static native void bindScrollAttributes(long bindingContextHandle);
     public static native void bindAssetAttributes(long bindingContextHandle, int outputType);
@@ -48,7 +48,7 @@ public:
 
         if (value.isString()) {
             Valdi::Path path(value.toStringBox().toStringView());
-            auto loadResult = Valdi::DiskUtils::load(path);
+            auto loadResult = Valdi::DiskUtils::loadMappedIfLarge(path, Valdi::FileAccessPattern::Sequential);
             if (!loadResult) {
                 return loadResult.moveError();
             }
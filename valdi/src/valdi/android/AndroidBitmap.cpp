@@ -3,6 +3,7 @@
 #include "valdi_core/jni/JavaUtils.hpp"
 
 #include <android/bitmap.h>
+#include <android/hardware_buffer.h>
 
 namespace ValdiAndroid {
 
@@ -36,14 +37,39 @@ static Valdi::AlphaType getAlphaType([[maybe_unused]] int32_t flags) {
 #endif
 }
 
-AndroidBitmap::AndroidBitmap(const JavaObject& bitmap) : _bitmap(bitmap, "Bitmap") {}
+AndroidBitmap::AndroidBitmap(const JavaObject& bitmap) : _bitmap(bitmap, "Bitmap") {
+#if defined(__ANDROID_API__) && __ANDROID_API__ >= 30
+    auto* env = JavaEnv::getUnsafeEnv();
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap.getUnsafeObject(), &info) == ANDROID_BITMAP_RESULT_SUCCESS &&
+        (info.flags & ANDROID_BITMAP_FLAGS_IS_HARDWARE) != 0) {
+        // The buffer is acquired by this call and released with the AndroidBitmap
+        if (AndroidBitmap_getHardwareBuffer(env, bitmap.getUnsafeObject(), &_hardwareBuffer) !=
+            ANDROID_BITMAP_RESULT_SUCCESS) {
+            _hardwareBuffer = nullptr;
+        }
+    }
+#endif
+}
 
-AndroidBitmap::~AndroidBitmap() = default;
+AndroidBitmap::~AndroidBitmap() {
+    releaseHardwareBuffer();
+}
 
 void AndroidBitmap::dispose() {
+    releaseHardwareBuffer();
     _bitmap = GlobalRefJavaObjectBase();
 }
 
+void AndroidBitmap::releaseHardwareBuffer() {
+#if defined(__ANDROID_API__) && __ANDROID_API__ >= 26
+    if (_hardwareBuffer != nullptr) {
+        AHardwareBuffer_release(_hardwareBuffer);
+        _hardwareBuffer = nullptr;
+    }
+#endif
+}
+
 Valdi::BitmapInfo AndroidBitmap::getInfo() const {
     auto jBitmap = _bitmap.get();
     AndroidBitmapInfo info;
@@ -55,7 +81,10 @@ Valdi::BitmapInfo AndroidBitmap::getInfo() const {
 void* AndroidBitmap::lockBytes() {
     auto jBitmap = _bitmap.get();
     void* addrPtr = nullptr;
-    AndroidBitmap_lockPixels(JavaEnv::getUnsafeEnv(), jBitmap.get(), &addrPtr);
+    // Hardware bitmaps cannot be locked, callers should use getHardwareBuffer() for those
+    if (AndroidBitmap_lockPixels(JavaEnv::getUnsafeEnv(), jBitmap.get(), &addrPtr) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return nullptr;
+    }
     return addrPtr;
 }
 
@@ -64,6 +93,10 @@ void AndroidBitmap::unlockBytes() {
     AndroidBitmap_unlockPixels(JavaEnv::getUnsafeEnv(), jBitmap.get());
 }
 
+void* AndroidBitmap::getHardwareBuffer() {
+    return _hardwareBuffer;
+}
+
 JavaObject AndroidBitmap::getJavaBitmap() const {
     return _bitmap.toObject();
 }
@@ -12,6 +12,8 @@
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/jni/GlobalRefJavaObject.hpp"
 
+struct AHardwareBuffer;
+
 namespace ValdiAndroid {
 
 class AndroidBitmap : public Valdi::IBitmap {
@@ -27,12 +29,22 @@ public:
 
     void unlockBytes() override;
 
+    /**
+     Returns the AHardwareBuffer of the bitmap if it was created with Bitmap.Config.HARDWARE.
+     Those bitmaps live in GPU memory and cannot be locked, but their buffer can be drawn
+     by snap_drawing without copying the pixels back to the CPU.
+     */
+    void* getHardwareBuffer() override;
+
     JavaObject getJavaBitmap() const;
 
     static Valdi::Result<Valdi::Ref<AndroidBitmap>> make(const Valdi::BitmapInfo& info);
 
 private:
     GlobalRefJavaObjectBase _bitmap;
+    AHardwareBuffer* _hardwareBuffer = nullptr;
+
+    void releaseHardwareBuffer();
 };
 
 class AndroidBitmapHandler : public AndroidBitmap {
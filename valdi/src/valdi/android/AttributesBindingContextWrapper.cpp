@@ -33,11 +33,13 @@ static DeferredViewOperations& getViewOperationsFromViewTransactionScope(
     return viewTransaction.getViewOperations();
 }
 
+/**
+ The Java delegate is held by the AttributeHandlerDelegateRegistry on the Java side,
+ and is referred to by its id in the view operations.
+ */
 class AndroidAttributeHandlerDelegate : public Valdi::AttributeHandlerDelegate {
 public:
-    explicit AndroidAttributeHandlerDelegate(jobject javaDelegate)
-        : _javaDelegate(
-              Valdi::makeShared<GlobalRefJavaObject>(JavaEnv(), javaDelegate, "AttributeHandlerDelegate", false)) {}
+    explicit AndroidAttributeHandlerDelegate(int32_t delegateId) : _delegateId(delegateId) {}
 
     void onReset(Valdi::ViewTransactionScope& viewTransactionScope,
                  Valdi::ViewNode& /*viewNode*/,
@@ -45,7 +47,7 @@ public:
                  const Valdi::StringBox& /*name*/,
                  const Valdi::Ref<Valdi::Animator>& animator) override {
         getViewOperationsFromViewTransactionScope(viewTransactionScope)
-            .enqueueResetAttribute(view, _javaDelegate, animator);
+            .enqueueResetAttribute(view, _delegateId, animator);
     }
 
     Valdi::Result<Valdi::Void> onApply(Valdi::ViewTransactionScope& viewTransactionScope,
@@ -70,11 +72,11 @@ protected:
                                              ViewOperation operation,
                                              const Valdi::Ref<Valdi::View>& view,
                                              const Valdi::Ref<Valdi::Animator>& animator) {
-        return operations.enqueueApplyAttribute(operation, view, _javaDelegate, animator);
+        return operations.enqueueApplyAttribute(operation, view, _delegateId, animator);
     }
 
 private:
-    Valdi::Value _javaDelegate;
+    int32_t _delegateId;
 };
 
 class BooleanAttributeHandlerDelegate : public AndroidAttributeHandlerDelegate {
@@ -345,7 +347,7 @@ static std::vector<snap::valdi_core::CompositeAttributePart> unmarshallComposite
 }
 
 jint AttributesBindingContextWrapper::bindAttributes(
-    jint type, jstring name, jboolean invalidateLayoutOnChange, jobject delegate, jobject parts) {
+    jint type, jstring name, jboolean invalidateLayoutOnChange, jint delegateId, jobject parts) {
     JavaEnv env;
     auto attributeName = toInternedString(env, name);
     auto invalidateLayoutOnChangeCpp = static_cast<bool>(invalidateLayoutOnChange);
@@ -357,55 +359,55 @@ jint AttributesBindingContextWrapper::bindAttributes(
             attributeId =
                 _bindingContext.bindUntypedAttribute(attributeName,
                                                      invalidateLayoutOnChangeCpp,
-                                                     Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegate));
+                                                     Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeInt:
             attributeId = _bindingContext.bindIntAttribute(
-                attributeName, invalidateLayoutOnChangeCpp, Valdi::makeShared<IntAttributeHandlerDelegate>(delegate));
+                attributeName, invalidateLayoutOnChangeCpp, Valdi::makeShared<IntAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeBoolean:
             attributeId =
                 _bindingContext.bindBooleanAttribute(attributeName,
                                                      invalidateLayoutOnChangeCpp,
-                                                     Valdi::makeShared<BooleanAttributeHandlerDelegate>(delegate));
+                                                     Valdi::makeShared<BooleanAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeDouble:
             attributeId = _bindingContext.bindDoubleAttribute(
-                attributeName, invalidateLayoutOnChangeCpp, Valdi::makeShared<FloatAttributeHandlerDelegate>(delegate));
+                attributeName, invalidateLayoutOnChangeCpp, Valdi::makeShared<FloatAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeString:
             attributeId =
                 _bindingContext.bindStringAttribute(attributeName,
                                                     invalidateLayoutOnChangeCpp,
-                                                    Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegate));
+                                                    Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeColor:
             attributeId = _bindingContext.bindColorAttribute(
-                attributeName, invalidateLayoutOnChangeCpp, Valdi::makeShared<LongAttributeHandlerDelegate>(delegate));
+                attributeName, invalidateLayoutOnChangeCpp, Valdi::makeShared<LongAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeBorder:
             attributeId =
                 _bindingContext.bindBorderAttribute(attributeName,
                                                     invalidateLayoutOnChangeCpp,
-                                                    Valdi::makeShared<CornersAttributeHandlerDelegate>(delegate));
+                                                    Valdi::makeShared<CornersAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypePercent:
             attributeId =
                 _bindingContext.bindPercentAttribute(attributeName,
                                                      invalidateLayoutOnChangeCpp,
-                                                     Valdi::makeShared<PercentAttributeHandlerDelegate>(delegate));
+                                                     Valdi::makeShared<PercentAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeText:
             attributeId =
                 _bindingContext.bindTextAttribute(attributeName,
                                                   invalidateLayoutOnChangeCpp,
-                                                  Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegate));
+                                                  Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegateId));
             break;
         case kAttributeTypeComposite: {
             auto cppParts = unmarshallCompositeAttributeParts(env, parts);
 
             attributeId = _bindingContext.bindCompositeAttribute(
-                attributeName, cppParts, Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegate));
+                attributeName, cppParts, Valdi::makeShared<ObjectAttributeHandlerDelegate>(delegateId));
         } break;
         default:
             throwJavaValdiException(JavaEnv::getUnsafeEnv(),
@@ -22,7 +22,7 @@ public:
     AttributesBindingContextWrapper(ViewManager& viewManager, Valdi::AttributesBindingContext& bindingContext);
     ~AttributesBindingContextWrapper() override;
 
-    jint bindAttributes(jint type, jstring name, jboolean invalidateLayoutOnChange, jobject delegate, jobject parts);
+    jint bindAttributes(jint type, jstring name, jboolean invalidateLayoutOnChange, jint delegateId, jobject parts);
 
     void bindScrollAttributes();
 
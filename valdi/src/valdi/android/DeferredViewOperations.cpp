@@ -47,24 +47,24 @@ DeferredViewOperations::~DeferredViewOperations() = default;
 
 Valdi::ByteBuffer& DeferredViewOperations::enqueueApplyAttribute(ViewOperation operation,
                                                                  const Valdi::Ref<Valdi::View>& view,
-                                                                 const Valdi::Value& handler,
+                                                                 int32_t delegateId,
                                                                  const Valdi::Ref<Valdi::Animator>& animator) {
     updateActiveAnimator(animator);
 
     auto& buffer = writeHeader(operation, true);
-    write(buffer, handler);
-    write(buffer, Valdi::Value(view));
+    write(buffer, delegateId);
+    writeView(buffer, view);
     return buffer;
 }
 
 void DeferredViewOperations::enqueueResetAttribute(const Valdi::Ref<Valdi::View>& view,
-                                                   const Valdi::Value& handler,
+                                                   int32_t delegateId,
                                                    const Valdi::Ref<Valdi::Animator>& animator) {
     updateActiveAnimator(animator);
 
     auto& buffer = writeHeader(ViewOperationResetAttribute, false);
-    write(buffer, handler);
-    write(buffer, Valdi::Value(view));
+    write(buffer, delegateId);
+    writeView(buffer, view);
 }
 
 void DeferredViewOperations::updateActiveAnimator(const Valdi::Ref<Valdi::Animator>& animator) {
@@ -88,14 +88,14 @@ void DeferredViewOperations::enqueueMoveToParent(const Valdi::Ref<Valdi::View>&
                                                  const Valdi::Ref<Valdi::View>& parentView,
                                                  int32_t index) {
     auto& buffer = writeHeader(ViewOperationMoveToParent, true);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
     write(buffer, Valdi::Value(parentView));
     write(buffer, index);
 }
 
 void DeferredViewOperations::enqueueRemoveFromParent(const Valdi::Ref<Valdi::View>& view, bool shouldClearViewNode) {
     auto& buffer = writeHeader(ViewOperationMoveToParent, false);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
     write(buffer, static_cast<int32_t>(shouldClearViewNode));
 }
 
@@ -109,7 +109,7 @@ void DeferredViewOperations::enqueueSetFrame(const Valdi::Ref<Valdi::View>& view
     updateActiveAnimator(animator);
 
     auto& buffer = writeHeader(ViewOperationSetFrame, isRightToLeft);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
     write(buffer, x);
     write(buffer, y);
     write(buffer, width);
@@ -123,7 +123,7 @@ void DeferredViewOperations::enqueueSetScrollableSpecs(const Valdi::Ref<Valdi::V
                                                        int32_t contentHeight,
                                                        bool animated) {
     auto& buffer = writeHeader(ViewOperationSetScrollableSpecs, true);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
     write(buffer, contentOffsetX);
     write(buffer, contentOffsetY);
     write(buffer, contentWidth);
@@ -135,7 +135,7 @@ void DeferredViewOperations::enqueueSetLoadedAsset(const Valdi::Ref<Valdi::View>
                                                    const Valdi::Ref<Valdi::LoadedAsset>& loadedAsset,
                                                    bool shouldDrawFlipped) {
     auto& buffer = writeHeader(ViewOperationSetLoadedAsset, loadedAsset != nullptr);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
     write(buffer, static_cast<int32_t>(shouldDrawFlipped));
     if (loadedAsset != nullptr) {
         write(buffer, Valdi::Value(loadedAsset));
@@ -146,24 +146,24 @@ void DeferredViewOperations::enqueueMovedToTree(const Valdi::Ref<Valdi::View>& v
                                                 const Valdi::Value& userData,
                                                 int32_t viewNodeId) {
     auto& buffer = writeHeader(ViewOperationMovedToTree, true);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
     write(buffer, userData);
     write(buffer, viewNodeId);
 }
 
 void DeferredViewOperations::enqueueAddedToPool(const Valdi::Ref<Valdi::View>& view) {
     auto& buffer = writeHeader(ViewOperationAddedToPool, false);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
 }
 
 void DeferredViewOperations::enqueueBeginRenderingView(const Valdi::Ref<Valdi::View>& view) {
     auto& buffer = writeHeader(ViewOperationBeginRenderingView, false);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
 }
 
 void DeferredViewOperations::enqueueEndRenderingView(const Valdi::Ref<Valdi::View>& view, bool layoutDidBecomeDirty) {
     auto& buffer = writeHeader(ViewOperationEndRenderingView, layoutDidBecomeDirty);
-    write(buffer, Valdi::Value(view));
+    writeView(buffer, view);
 }
 
 std::optional<SerializedViewOperations> DeferredViewOperations::dequeueOperations() {
@@ -180,6 +180,8 @@ std::optional<SerializedViewOperations> DeferredViewOperations::dequeueOperation
 
 void DeferredViewOperations::clear() {
     _lastAnimator = nullptr;
+    _lastView = nullptr;
+    _lastViewIndex = 0;
     _buffer.clear();
     _attachedValues.clear();
     _indexByAttachedValue.clear();
@@ -204,16 +206,30 @@ void DeferredViewOperations::write(Valdi::ByteBuffer& buffer, float value) {
 }
 
 void DeferredViewOperations::write(Valdi::ByteBuffer& buffer, const Valdi::Value& value) {
+    write(buffer, getAttachedValueIndex(value));
+}
+
+void DeferredViewOperations::writeView(Valdi::ByteBuffer& buffer, const Valdi::Ref<Valdi::View>& view) {
+    // Consecutive operations are most often made on the same view, like when applying
+    // its attributes, the attached value lookup is skipped for those.
+    // The last view remains retained by the attached values until the operations are cleared.
+    if (view == nullptr || view.get() != _lastView) {
+        _lastViewIndex = getAttachedValueIndex(Valdi::Value(view));
+        _lastView = view.get();
+    }
+    write(buffer, _lastViewIndex);
+}
+
+int32_t DeferredViewOperations::getAttachedValueIndex(const Valdi::Value& value) {
     const auto& it = _indexByAttachedValue.find(value);
     if (it != _indexByAttachedValue.end()) {
-        write(buffer, static_cast<int32_t>(it->second));
-        return;
+        return static_cast<int32_t>(it->second);
     }
 
     auto index = _attachedValues.size();
     _attachedValues.append(value);
     _indexByAttachedValue[value] = index;
-    write(buffer, static_cast<int32_t>(index));
+    return static_cast<int32_t>(index);
 }
 
 Valdi::ByteBuffer& DeferredViewOperations::writeHeader(ViewOperation operation, bool hasValue) {
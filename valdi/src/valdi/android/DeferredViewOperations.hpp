@@ -79,13 +79,18 @@ public:
     std::optional<SerializedViewOperations> dequeueOperations();
     void clear();
 
+    /**
+     Enqueue the fixed layout record of an apply attribute operation, made of its header, the id
+     of the Java delegate handling the attribute, and the index of the view. The typed value of
+     the attribute is then written into the returned buffer.
+     */
     Valdi::ByteBuffer& enqueueApplyAttribute(ViewOperation operation,
                                              const Valdi::Ref<Valdi::View>& view,
-                                             const Valdi::Value& handler,
+                                             int32_t delegateId,
                                              const Valdi::Ref<Valdi::Animator>& animator);
 
     void enqueueResetAttribute(const Valdi::Ref<Valdi::View>& view,
-                               const Valdi::Value& handler,
+                               int32_t delegateId,
                                const Valdi::Ref<Valdi::Animator>& animator);
 
     void enqueueMoveToParent(const Valdi::Ref<Valdi::View>& view,
@@ -129,12 +134,17 @@ private:
     Valdi::ValueArrayBuilder _attachedValues;
     Valdi::FlatMap<Valdi::Value, size_t> _indexByAttachedValue;
     Valdi::Ref<Valdi::Animator> _lastAnimator;
+    const Valdi::View* _lastView = nullptr;
+    int32_t _lastViewIndex = 0;
 
     template<typename T>
     void doWrite(Valdi::ByteBuffer& buffer, T value);
 
     void updateActiveAnimator(const Valdi::Ref<Valdi::Animator>& animator);
 
+    int32_t getAttachedValueIndex(const Valdi::Value& value);
+    void writeView(Valdi::ByteBuffer& buffer, const Valdi::Ref<Valdi::View>& view);
+
     Valdi::ByteBuffer& writeHeader(ViewOperation operation, bool hasValue);
 
     Valdi::Ref<Valdi::ByteBuffer> makeBuffer();
@@ -17,6 +17,7 @@
 #include "valdi_core/jni/JavaCache.hpp"
 #include "valdi_core/jni/JavaUtils.hpp"
 #include <djinni/jni/djinni_support.hpp>
+#include <vector>
 
 static int valueTypeToInt(Valdi::ValueType type) {
     // Must match ValdiMarshaller.kt
@@ -299,6 +300,61 @@ jint nativePushByteArray(JNIEnv* env, jclass /*cls*/, jlong ptr, jbyteArray byte
     return static_cast<jint>(marshaller->push(std::move(value)));
 }
 
+// Primitive arrays are transferred in a single region copy instead of one
+// JNI call per item, then expanded into a ValueArray on the native side.
+template<typename T, typename JNIType>
+static jint pushPrimitiveArray(Valdi::Marshaller* marshaller, const std::vector<JNIType>& values) {
+    auto array = Valdi::ValueArray::make(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        array->emplace(i, Valdi::Value(static_cast<T>(values[i])));
+    }
+
+    return static_cast<jint>(marshaller->push(Valdi::Value(array)));
+}
+
+template<typename JNIType, typename Converter>
+static bool getPrimitiveArray(JNIEnv* env,
+                              Valdi::Marshaller* marshaller,
+                              jint index,
+                              std::vector<JNIType>& output,
+                              Converter&& converter) {
+    auto array = marshaller->getArray(static_cast<int>(index));
+    if (!checkMarshaller(env, marshaller)) {
+        return false;
+    }
+
+    output.reserve(array->size());
+    for (const auto& item : *array) {
+        output.emplace_back(static_cast<JNIType>(converter(item)));
+    }
+
+    return true;
+}
+
+jint nativePushDoubleArray(JNIEnv* env, jclass /*cls*/, jlong ptr, jdoubleArray doubleArray) {
+    auto* marshaller = unwrap(env, ptr);
+    if (marshaller == nullptr || !checkNotNull(env, doubleArray)) {
+        return 0;
+    }
+
+    std::vector<jdouble> values(static_cast<size_t>(env->GetArrayLength(doubleArray)));
+    env->GetDoubleArrayRegion(doubleArray, 0, static_cast<jsize>(values.size()), values.data());
+
+    return pushPrimitiveArray<double>(marshaller, values);
+}
+
+jint nativePushLongArray(JNIEnv* env, jclass /*cls*/, jlong ptr, jlongArray longArray) {
+    auto* marshaller = unwrap(env, ptr);
+    if (marshaller == nullptr || !checkNotNull(env, longArray)) {
+        return 0;
+    }
+
+    std::vector<jlong> values(static_cast<size_t>(env->GetArrayLength(longArray)));
+    env->GetLongArrayRegion(longArray, 0, static_cast<jsize>(values.size()), values.data());
+
+    return pushPrimitiveArray<int64_t>(marshaller, values);
+}
+
 jint nativePushString(JNIEnv* env,
 
                       jclass /*cls*/,
@@ -621,6 +677,45 @@ jbyteArray nativeGetByteArray(JNIEnv* env,
         ValdiAndroid::toJavaObject(ValdiAndroid::JavaEnv(), typedArray).releaseObject());
 }
 
+jdoubleArray nativeGetDoubleArray(JNIEnv* env, jclass /*cls*/, jlong ptr, jint index) {
+    auto* marshaller = unwrap(env, ptr);
+    if (marshaller == nullptr) {
+        return nullptr;
+    }
+
+    std::vector<jdouble> values;
+    if (!getPrimitiveArray(
+            env, marshaller, index, values, [](const Valdi::Value& item) { return item.toDouble(); })) {
+        return nullptr;
+    }
+
+    auto size = static_cast<jsize>(values.size());
+    auto* doubleArray = env->NewDoubleArray(size);
+    if (doubleArray != nullptr) {
+        env->SetDoubleArrayRegion(doubleArray, 0, size, values.data());
+    }
+    return doubleArray;
+}
+
+jlongArray nativeGetLongArray(JNIEnv* env, jclass /*cls*/, jlong ptr, jint index) {
+    auto* marshaller = unwrap(env, ptr);
+    if (marshaller == nullptr) {
+        return nullptr;
+    }
+
+    std::vector<jlong> values;
+    if (!getPrimitiveArray(env, marshaller, index, values, [](const Valdi::Value& item) { return item.toLong(); })) {
+        return nullptr;
+    }
+
+    auto size = static_cast<jsize>(values.size());
+    auto* longArray = env->NewLongArray(size);
+    if (longArray != nullptr) {
+        env->SetLongArrayRegion(longArray, 0, size, values.data());
+    }
+    return longArray;
+}
+
 jobject JNICALL nativeGetNativeWrapper(JNIEnv* env, jclass /*cls*/, jlong ptr, jint index) {
     auto* marshaller = unwrap(env, ptr);
     if (marshaller == nullptr) {
@@ -911,6 +1006,8 @@ djinni::JniClassInitializer jvmMarshallerJNIOnLoad([] { // NOLINT(fuchsia-static
                                         ValdiMakeNativeMethod(nativePushOpaqueObject),
                                         ValdiMakeNativeMethod(nativePushFunction),
                                         ValdiMakeNativeMethod(nativePushByteArray),
+                                        ValdiMakeNativeMethod(nativePushDoubleArray),
+                                        ValdiMakeNativeMethod(nativePushLongArray),
 
                                         ValdiMakeCriticalNativeMethod(nativePushMap),
                                         ValdiMakeCriticalNativeMethod(nativePushArray),
@@ -933,6 +1030,8 @@ djinni::JniClassInitializer jvmMarshallerJNIOnLoad([] { // NOLINT(fuchsia-static
                                         ValdiMakeNativeMethod(nativeGetNativeWrapper),
                                         ValdiMakeNativeMethod(nativeGetOpaqueObject),
                                         ValdiMakeNativeMethod(nativeGetByteArray),
+                                        ValdiMakeNativeMethod(nativeGetDoubleArray),
+                                        ValdiMakeNativeMethod(nativeGetLongArray),
                                         ValdiMakeNativeMethod(nativeGetFunction),
 
                                         ValdiMakeNativeMethod(nativeGetArrayLength),
@@ -1398,6 +1398,17 @@ void ValdiAndroid::NativeBridge::applicationIsInLowMemory( // NOLINT
     wrapper->applicationIsInLowMemory();
 }
 
+void ValdiAndroid::NativeBridge::applicationDidTrimMemory( // NOLINT
+    fbjni::alias_ref<fbjni::JClass> /* clazz */,           // NOLINT
+    jlong runtimeManagerHandle,
+    jint level) {
+    auto* wrapper = getRuntimeManagerWrapper(runtimeManagerHandle);
+    if (wrapper == nullptr) {
+        return;
+    }
+    wrapper->applicationDidTrimMemory(static_cast<int>(level));
+}
+
 jstring ValdiAndroid::NativeBridge::getViewNodeDebugDescription( // NOLINT
     fbjni::alias_ref<fbjni::JClass> /* clazz */,                 // NOLINT
     jlong viewNodeHandle) {
@@ -1726,10 +1737,10 @@ jint ValdiAndroid::NativeBridge::bindAttribute(fbjni::alias_ref<fbjni::JClass> c
                                                jint type,
                                                jstring name,
                                                jboolean invalidateLayoutOnChange,
-                                               jobject delegate,
+                                               jint delegateId,
                                                jobject compositeParts) {
     auto wrapper = getBindingContextWrapper(bindingContextHandle);
-    return wrapper->bindAttributes(type, name, invalidateLayoutOnChange, delegate, compositeParts);
+    return wrapper->bindAttributes(type, name, invalidateLayoutOnChange, delegateId, compositeParts);
 }
 
 void ValdiAndroid::NativeBridge::bindScrollAttributes(fbjni::alias_ref<fbjni::JClass> clazz, // NOLINT
@@ -2351,6 +2362,7 @@ void ValdiAndroid::NativeBridge::registerNatives() {
         makeNativeMethod("applicationSetConfiguration", ValdiAndroid::NativeBridge::applicationSetConfiguration),
         makeNativeMethod("applicationDidResume", ValdiAndroid::NativeBridge::applicationDidResume),
         makeNativeMethod("applicationIsInLowMemory", ValdiAndroid::NativeBridge::applicationIsInLowMemory),
+        makeNativeMethod("applicationDidTrimMemory", ValdiAndroid::NativeBridge::applicationDidTrimMemory),
         makeNativeMethod("applicationWillPause", ValdiAndroid::NativeBridge::applicationWillPause),
         makeNativeMethod("setRootView", ValdiAndroid::NativeBridge::setRootView),
         makeNativeMethod("measureLayout", ValdiAndroid::NativeBridge::measureLayout),
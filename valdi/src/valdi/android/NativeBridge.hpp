@@ -114,6 +114,9 @@ public:
                                             jfloat dynamicTypeScale);
     static void applicationDidResume(fbjni::alias_ref<fbjni::JClass> clazz, jlong runtimeManagerHandle);
     static void applicationIsInLowMemory(fbjni::alias_ref<fbjni::JClass> clazz, jlong runtimeManagerHandle);
+    static void applicationDidTrimMemory(fbjni::alias_ref<fbjni::JClass> clazz,
+                                         jlong runtimeManagerHandle,
+                                         jint level);
     static void applicationWillPause(fbjni::alias_ref<fbjni::JClass> clazz, jlong runtimeManagerHandle);
     static void setRootView(fbjni::alias_ref<fbjni::JClass> clazz,
                             jlong runtimeHandle,
@@ -190,7 +193,7 @@ public:
                               jint type,
                               jstring name,
                               jboolean invalidateLayoutOnChange,
-                              jobject delegate,
+                              jint delegateId,
                               jobject compositeParts);
     static void bindScrollAttributes(fbjni::alias_ref<fbjni::JClass> clazz, jlong bindingContextHandle);
     static void bindAssetAttributes(fbjni::alias_ref<fbjni::JClass> clazz, jlong bindingContextHandle, jint outputType);
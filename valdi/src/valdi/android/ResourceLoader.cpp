@@ -7,6 +7,7 @@
 
 #include "valdi/android/ResourceLoader.hpp"
 #include "valdi_core/cpp/Attributes/ImageFilter.hpp"
+#include "valdi_core/cpp/Utils/DiskUtils.hpp"
 #include "valdi_core/jni/JavaUtils.hpp"
 
 #include "utils/base/NonCopyable.hpp"
@@ -14,6 +15,7 @@
 #ifdef __ANDROID__
 #include <android/asset_manager.h>
 #include <android/asset_manager_jni.h>
+#include <unistd.h>
 #endif
 
 namespace ValdiAndroid {
@@ -82,9 +84,29 @@ Valdi::Result<Valdi::BytesView> ResourceLoader::loadModuleContent(const Valdi::S
     if (asset == nullptr) {
         return Valdi::Error("Unable to open asset");
     }
+
+    // Assets stored uncompressed in the APK can be mapped directly from it, which keeps them off the
+    // heap and lets the pages be shared and reclaimed by the OS. Compressed assets have no file
+    // descriptor and are inflated by the AssetManager instead.
+    off64_t assetOffset = 0;
+    off64_t assetLength = 0;
+    auto fd = AAsset_openFileDescriptor64(asset, &assetOffset, &assetLength);
+    if (fd >= 0) {
+        auto mapped = Valdi::DiskUtils::loadMappedFromFd(
+            fd, assetOffset, static_cast<size_t>(assetLength), Valdi::FileAccessPattern::Random);
+        ::close(fd);
+        if (mapped) {
+            AAsset_close(asset);
+            return mapped;
+        }
+    }
+
     auto managedAsset = Valdi::makeShared<ManagedAsset>(asset);
 
     const auto* buffer = AAsset_getBuffer(asset);
+    if (buffer == nullptr) {
+        return Valdi::Error("Unable to read asset");
+    }
     auto length = AAsset_getLength(asset);
 
     return Valdi::BytesView(managedAsset, reinterpret_cast<const Valdi::Byte*>(buffer), static_cast<size_t>(length));
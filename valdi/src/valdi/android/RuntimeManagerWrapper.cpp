@@ -251,7 +251,41 @@ void RuntimeManagerWrapper::applicationIsInLowMemory() {
 #if SNAP_DRAWING_ENABLED
     auto snapDrawingRuntime = _snapDrawingRuntime.getIfCreated();
     if (snapDrawingRuntime) {
-        snapDrawingRuntime.value()->getDrawLooper()->onApplicationIsInLowMemory();
+        snapDrawingRuntime.value()->onMemoryPressure(snap::drawing::MemoryPressureLevel::Critical);
+    }
+#endif
+}
+
+#if SNAP_DRAWING_ENABLED
+// Values of the TRIM_MEMORY_ constants from android.content.ComponentCallbacks2
+constexpr int kTrimMemoryRunningLow = 10;
+constexpr int kTrimMemoryRunningCritical = 15;
+constexpr int kTrimMemoryUIHidden = 20;
+constexpr int kTrimMemoryModerate = 60;
+constexpr int kTrimMemoryComplete = 80;
+
+static snap::drawing::MemoryPressureLevel memoryPressureLevelFromTrimMemoryLevel(int level) {
+    if (level >= kTrimMemoryComplete || level == kTrimMemoryRunningCritical) {
+        return snap::drawing::MemoryPressureLevel::Critical;
+    }
+    if (level >= kTrimMemoryModerate || level == kTrimMemoryRunningLow) {
+        return snap::drawing::MemoryPressureLevel::High;
+    }
+    return snap::drawing::MemoryPressureLevel::Moderate;
+}
+#endif
+
+void RuntimeManagerWrapper::applicationDidTrimMemory(int level) {
+#if SNAP_DRAWING_ENABLED
+    // The UI being hidden is not a sign of memory pressure on its own, the background
+    // levels which follow take care of it.
+    if (level == kTrimMemoryUIHidden) {
+        return;
+    }
+
+    auto snapDrawingRuntime = _snapDrawingRuntime.getIfCreated();
+    if (snapDrawingRuntime) {
+        snapDrawingRuntime.value()->onMemoryPressure(memoryPressureLevelFromTrimMemoryLevel(level));
     }
 #endif
 }
@@ -95,6 +95,10 @@ public:
     void applicationDidResume();
     void applicationWillPause();
     void applicationIsInLowMemory();
+    /**
+     Called from ComponentCallbacks2.onTrimMemory() with one of the TRIM_MEMORY_ levels.
+     */
+    void applicationDidTrimMemory(int level);
 
     const Valdi::Ref<AndroidSnapDrawingRuntime>& getOrCreateSnapDrawingRuntime();
 
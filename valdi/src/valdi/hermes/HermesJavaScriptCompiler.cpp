@@ -54,7 +54,7 @@ Shared<hermes::hbc::BCProvider> HermesJavaScriptCompiler::compile(const std::str
 
 BytesView HermesJavaScriptCompiler::compileToSerializedBytecode(const std::string& script,
                                                                 const std::string_view& sourceFilename,
-                                                                JSExceptionTracker& exceptionTracker) {
+                                                                ExceptionTracker& exceptionTracker) {
     std::function<void(hermes::Module&)> runOptimizationPasses;
     if constexpr (snap::isDesktop()) {
         // Enable optimizations on desktop for release type builds.
@@ -106,7 +106,7 @@ Shared<hermes::hbc::BCProviderFromSrc> HermesJavaScriptCompiler::compileToByteco
     hermes::OutputFormatKind outputFormat,
     std::function<void(hermes::Module&)> runOptimizations,
     const hermes::BytecodeGenerationOptions& bytecodeGenerationsOptions,
-    JSExceptionTracker& exceptionTracker) {
+    ExceptionTracker& exceptionTracker) {
     auto compileFlags = getCompileFlags(outputFormat, !runOptimizations);
 
     auto buffer =
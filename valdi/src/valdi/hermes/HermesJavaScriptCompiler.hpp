@@ -33,9 +33,13 @@ public:
                                             const std::string_view& sourceFilename,
                                             JSExceptionTracker& exceptionTracker);
 
+    /**
+     Compile the given script into serialized bytecode. Does not depend on any runtime,
+     and can be called from any thread.
+     */
     static BytesView compileToSerializedBytecode(const std::string& script,
                                                  const std::string_view& sourceFilename,
-                                                 JSExceptionTracker& exceptionTracker);
+                                                 ExceptionTracker& exceptionTracker);
 
     static Shared<hermes::hbc::BCProvider> deserializeBytecode(const BytesView& serializedBytecode,
                                                                JSExceptionTracker& exceptionTracker);
@@ -52,7 +56,7 @@ private:
         hermes::OutputFormatKind outputFormat,
         std::function<void(hermes::Module&)> runOptimizations,
         const hermes::BytecodeGenerationOptions& bytecodeGenerationsOptions,
-        JSExceptionTracker& exceptionTracker);
+        ExceptionTracker& exceptionTracker);
 };
 
 } // namespace Valdi::Hermes
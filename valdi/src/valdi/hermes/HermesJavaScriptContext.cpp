@@ -1137,6 +1137,13 @@ void HermesJavaScriptContext::garbageCollect() {
     _runtime->collect("Explicit GC");
 }
 
+bool HermesJavaScriptContext::performIdleGarbageCollection(std::chrono::steady_clock::duration /*budget*/) {
+    // The heap is collected concurrently by the Hermes GC and a full collection would not fit
+    // in an idle budget, so we only release the slots of the values we no longer reference.
+    _managedValues.collect();
+    return true;
+}
+
 void HermesJavaScriptContext::enqueueMicrotask(const JSValue& value, JSExceptionTracker& exceptionTracker) {
     hermes::vm::GCScope gcScope(*_runtime);
     const auto* hermesValue = toPinnedHermesValue(value);
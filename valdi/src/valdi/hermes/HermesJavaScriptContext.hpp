@@ -138,6 +138,7 @@ public:
     void releasePropertyName(const JSPropertyName& value) final;
 
     void garbageCollect() final;
+    bool performIdleGarbageCollection(std::chrono::steady_clock::duration budget) final;
     JavaScriptContextMemoryStatistics dumpMemoryStatistics() final;
     BytesView dumpHeap(JSExceptionTracker& exceptionTracker);
 
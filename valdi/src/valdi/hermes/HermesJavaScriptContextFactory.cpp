@@ -6,7 +6,9 @@
 //
 
 #include "valdi/hermes/HermesJavaScriptContextFactory.hpp"
+#include "valdi/hermes/HermesJavaScriptCompiler.hpp"
 #include "valdi/hermes/HermesJavaScriptContext.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptHeapDumpBuilder.hpp"
 
 #ifdef HERMES_ENABLE_DEBUGGER
@@ -30,6 +32,32 @@ Ref<IJavaScriptContext> HermesJavaScriptContextFactory::createJsContext(JavaScri
     return makeShared<HermesJavaScriptContext>(taskScheduler, logger);
 }
 
+bool HermesJavaScriptContextFactory::supportsBackgroundPreCompilation() {
+#ifdef HERMESVM_LEAN
+    return false;
+#else
+    return true;
+#endif
+}
+
+Result<BytesView> HermesJavaScriptContextFactory::preCompile(const std::string_view& script,
+                                                             const std::string_view& sourceFilename) {
+#ifdef HERMESVM_LEAN
+    return Error("Hermes not compiled with compilation enabled");
+#else
+    SimpleExceptionTracker exceptionTracker;
+    auto formattedScript = Valdi::formatJsModule(script);
+
+    auto serializedBytecode =
+        HermesJavaScriptCompiler::compileToSerializedBytecode(formattedScript, sourceFilename, exceptionTracker);
+    if (!exceptionTracker) {
+        return exceptionTracker.extractError();
+    }
+
+    return Valdi::makePreCompiledJsModule(serializedBytecode.data(), serializedBytecode.size());
+#endif
+}
+
 void HermesJavaScriptContextFactory::startJsDebuggerServer([[maybe_unused]] ILogger& logger) {
 #ifdef HERMES_ENABLE_DEBUGGER
     if (_debuggerServer == nullptr) {
@@ -55,26 +83,35 @@ void HermesJavaScriptContextFactory::stopJsDebuggerServer() {
 
 BytesView HermesJavaScriptContextFactory::dumpHeap(std::span<IJavaScriptContext*> jsContexts,
                                                    JSExceptionTracker& exceptionTracker) {
-    if constexpr (shouldEnableJsHeapDump()) {
-        Valdi::JavaScriptHeapDumpBuilder heapDumpBuilder;
+    Valdi::JavaScriptHeapDumpBuilder heapDumpBuilder;
+    if (!appendHeapDump(jsContexts, heapDumpBuilder, exceptionTracker) || !exceptionTracker) {
+        return BytesView();
+    }
+
+    return heapDumpBuilder.build();
+}
 
+bool HermesJavaScriptContextFactory::appendHeapDump(std::span<IJavaScriptContext*> jsContexts,
+                                                    JavaScriptHeapDumpBuilder& heapDumpBuilder,
+                                                    JSExceptionTracker& exceptionTracker) {
+    if constexpr (shouldEnableJsHeapDump()) {
         for (auto* jsContext : jsContexts) {
+            // Each context dump is merged and released before the next one is taken
             auto heapDump = dynamic_cast<HermesJavaScriptContext*>(jsContext)->dumpHeap(exceptionTracker);
             if (!exceptionTracker) {
-                return BytesView();
+                return true;
             }
 
             heapDumpBuilder.appendDump(heapDump.data(), heapDump.size(), exceptionTracker);
             if (!exceptionTracker) {
-                return BytesView();
+                return true;
             }
         }
-
-        return heapDumpBuilder.build();
     } else {
         exceptionTracker.onError("Heap dump support not enabled");
-        return BytesView();
     }
+
+    return true;
 }
 
 } // namespace Valdi::Hermes
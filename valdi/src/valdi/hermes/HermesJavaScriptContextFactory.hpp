@@ -24,8 +24,16 @@ public:
 
     Ref<IJavaScriptContext> createJsContext(JavaScriptTaskScheduler* taskScheduler, ILogger& logger) final;
 
+    bool supportsBackgroundPreCompilation() final;
+
+    Result<BytesView> preCompile(const std::string_view& script, const std::string_view& sourceFilename) final;
+
     BytesView dumpHeap(std::span<IJavaScriptContext*> jsContexts, JSExceptionTracker& exceptionTracker) final;
 
+    bool appendHeapDump(std::span<IJavaScriptContext*> jsContexts,
+                        JavaScriptHeapDumpBuilder& heapDumpBuilder,
+                        JSExceptionTracker& exceptionTracker) final;
+
     void startJsDebuggerServer(ILogger& logger) final;
 
     void stopJsDebuggerServer() final;
@@ -69,6 +69,13 @@ public:
     void cancelAnimator(const Valdi::Ref<Valdi::Animator>& animator) override;
 
     void executeInTransactionThread(Valdi::DispatchFunction executeFn) override;
+
+private:
+    bool _inCATransaction = false;
+    uint64_t _caTransactionSequence = 0;
+
+    void beginCATransactionIfNeeded();
+    void commitCATransactionIfNeeded();
 };
 
 } // namespace ValdiIOS
@@ -61,9 +61,43 @@ static UIView *toUIView(const Valdi::Ref<Valdi::View>& view) {
 ViewTransaction::ViewTransaction() = default;
 ViewTransaction::~ViewTransaction() = default;
 
-    void ViewTransaction::flush(bool sync) {}
+    void ViewTransaction::flush(bool sync) {
+        commitCATransactionIfNeeded();
+    }
+
+    void ViewTransaction::willUpdateRootView(const Valdi::Ref<Valdi::View>& view) {
+        beginCATransactionIfNeeded();
+    }
 
-    void ViewTransaction::willUpdateRootView(const Valdi::Ref<Valdi::View>& view) {}
+    void ViewTransaction::beginCATransactionIfNeeded() {
+        if (_inCATransaction) {
+            return;
+        }
+        _inCATransaction = true;
+        auto sequence = ++_caTransactionSequence;
+
+        // Group all the layer changes of the update in a single transaction. Disabling the actions
+        // saves the implicit animation lookup on every layer property change, animations from
+        // Valdi animators are explicit CAAnimations and are not affected.
+        [CATransaction begin];
+        [CATransaction setDisableActions:YES];
+
+        // The transaction is expected to be flushed within the same run loop iteration,
+        // this makes sure it never outlives it.
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (_caTransactionSequence == sequence) {
+                commitCATransactionIfNeeded();
+            }
+        });
+    }
+
+    void ViewTransaction::commitCATransactionIfNeeded() {
+        if (!_inCATransaction) {
+            return;
+        }
+        _inCATransaction = false;
+        [CATransaction commit];
+    }
 
     void ViewTransaction::didUpdateRootView(const Valdi::Ref<Valdi::View>& view, bool layoutDidBecomeDirty) {
         if (layoutDidBecomeDirty) {
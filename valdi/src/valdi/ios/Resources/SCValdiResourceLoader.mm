@@ -64,7 +64,7 @@ Valdi::Result<Valdi::BytesView> ResourceLoader::loadModuleContent(const Valdi::S
     auto cppPath = ValdiIOS::StringFromNSString(url.path);
     Valdi::Path path(cppPath.toStringView());
 
-    return Valdi::DiskUtils::load(path);
+    return Valdi::DiskUtils::loadMapped(path);
 }
 
 Valdi::StringBox ResourceLoader::resolveLocalAssetURL(const Valdi::StringBox &moduleName, const Valdi::StringBox &resourcePath) {
@@ -95,7 +95,7 @@ private:
 
 - (void)onApplicationIsInLowMemory
 {
-    _instance->getDrawLooper()->onApplicationIsInLowMemory();
+    _instance->onMemoryPressure(snap::drawing::MemoryPressureLevel::Critical);
 }
 
 - (void *)handle
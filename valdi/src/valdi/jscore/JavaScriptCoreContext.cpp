@@ -882,6 +882,35 @@ void JavaScriptCoreContext::setObjectProperty(const Valdi::JSValue& object,
     }
 }
 
+void JavaScriptCoreContext::setObjectProperties(const Valdi::JSValue& object,
+                                                const Valdi::JSPropertyName* propertyNames,
+                                                const Valdi::JSValueRef* propertyValues,
+                                                size_t count,
+                                                Valdi::JSExceptionTracker& exceptionTracker) {
+    auto objectRef = fromValdiJSValue(object).asObjectRefOrThrow(*this, exceptionTracker);
+    if (!exceptionTracker) {
+        return;
+    }
+
+    // Typed objects are populated in one go, resolving the object and the global context once
+    auto context = getJSGlobalContext();
+    auto attributes = toPropertyAttributes(true);
+    for (size_t i = 0; i < count; i++) {
+        JSValueRef exception = nullptr;
+        JSObjectSetProperty(context,
+                            objectRef,
+                            fromValdiJSPropertyName(propertyNames[i]),
+                            fromValdiJSValue(propertyValues[i].get()).valueRef,
+                            attributes,
+                            &exception);
+
+        if (exception != nullptr) {
+            storeException(exceptionTracker, exception);
+            return;
+        }
+    }
+}
+
 void JavaScriptCoreContext::setObjectProperty(const Valdi::JSValue& object,
                                               const Valdi::JSValue& propertyName,
                                               const Valdi::JSValue& propertyValue,
@@ -100,6 +100,12 @@ public:
                            bool enumerable,
                            Valdi::JSExceptionTracker& exceptionTracker) override;
 
+    void setObjectProperties(const Valdi::JSValue& object,
+                             const Valdi::JSPropertyName* propertyNames,
+                             const Valdi::JSValueRef* propertyValues,
+                             size_t count,
+                             Valdi::JSExceptionTracker& exceptionTracker) override;
+
     Valdi::JSValueRef callObjectAsFunction(const Valdi::JSValue& object,
                                            Valdi::JSFunctionCallContext& callContext) override;
 
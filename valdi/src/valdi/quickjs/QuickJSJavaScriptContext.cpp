@@ -62,37 +62,22 @@ void freeByteBuffer(JSRuntime* rt, void* opaque, void* /*ptr*/) {
     Valdi::unsafeBridgeRelease(opaque);
 }
 
-static void handleRejectedPromise(
-    JSContext* ctx, JSValueConst promise, JSValueConst reason, JS_BOOL is_handled, void* opaque) {
-    auto& jsContext = *reinterpret_cast<QuickJSJavaScriptContext*>(opaque);
-
-    if (is_handled == 0) {
-        jsContext.appendRejectedPromise(promise, reason);
-    } else {
-        jsContext.removeRejectedPromise(promise);
-    }
-}
-
 constexpr double kMaxStackSizeRatio = 0.75;
 
-static int handleInterrupt(JSRuntime* rt, void* opaque) {
-    auto& jsContext = *reinterpret_cast<QuickJSJavaScriptContext*>(opaque);
-    if (jsContext.interruptRequested()) {
-        jsContext.onInterrupt();
-    }
-    return 0;
-}
-
 QuickJSJavaScriptContext::QuickJSJavaScriptContext(Valdi::JavaScriptTaskScheduler* taskScheduler)
-    : Valdi::IJavaScriptContext(taskScheduler) {
-    _runtime = JS_NewRuntime();
-    JS_SetPropertyCacheEnabledRT(_runtime, 2); // 2 = enabled for both get and set
+    : QuickJSJavaScriptContext(taskScheduler, Valdi::makeShared<QuickJSRuntime>()) {}
+
+QuickJSJavaScriptContext::QuickJSJavaScriptContext(Valdi::JavaScriptTaskScheduler* taskScheduler,
+                                                   const Valdi::Ref<QuickJSRuntime>& runtime)
+    : Valdi::IJavaScriptContext(taskScheduler),
+      _quickJsRuntime(runtime),
+      _threadAccessChecker(runtime->getThreadAccessChecker()),
+      _runtime(runtime->get()) {
+    auto guard = _threadAccessChecker.guard();
     _context = JS_NewContext(_runtime);
     tsn_load_in_context(_context);
     attachValdiJSContext(_context, this);
-    JS_SetHostPromiseRejectionTracker(_runtime, &handleRejectedPromise, this);
-
-    JS_SetInterruptHandler(_runtime, &handleInterrupt, this);
+    _quickJsRuntime->attachContext(this);
 }
 
 QuickJSJavaScriptContext::~QuickJSJavaScriptContext() {
@@ -124,7 +109,8 @@ QuickJSJavaScriptContext::~QuickJSJavaScriptContext() {
         JS_RunGC(_runtime);
     }
 
-    JS_FreeRuntime(_runtime);
+    // The runtime is freed alongside the last context using it
+    _quickJsRuntime->detachContext(this);
 }
 
 void QuickJSJavaScriptContext::onInitialize(Valdi::JSExceptionTracker& exceptionTracker) {
@@ -426,7 +412,7 @@ size_t QuickJSJavaScriptContext::associateWeakReference(const JSValue& value,
         return 0;
     }
 
-    weakReferenceId = ++_weakReferenceSequence;
+    weakReferenceId = _quickJsRuntime->makeWeakReferenceId();
 
     setWeakReferenceIdToJSWeakReferenceFinalizer(fromValdiJSValue(finalizerObject.get()), weakReferenceId);
     _weakReferences[weakReferenceId] = value;
@@ -644,6 +630,22 @@ JSValue QuickJSJavaScriptContext::getConstructorFromObject(const Valdi::JSValue&
     return jsValue;
 }
 
+void QuickJSJavaScriptContext::getObjectProperties(const Valdi::JSValue& object,
+                                                   const Valdi::JSPropertyName* propertyNames,
+                                                   size_t count,
+                                                   Valdi::JSValueRef* outValues,
+                                                   Valdi::JSExceptionTracker& exceptionTracker) {
+    auto guard = _threadAccessChecker.guard();
+    auto jsObject = fromValdiJSValue(object);
+    for (size_t i = 0; i < count; i++) {
+        outValues[i] = checkCallAndGetValue(exceptionTracker,
+                                            JS_GetProperty(_context, jsObject, fromValdiJSPropertyName(propertyNames[i])));
+        if (!exceptionTracker) {
+            return;
+        }
+    }
+}
+
 bool QuickJSJavaScriptContext::hasObjectProperty(const Valdi::JSValue& object,
                                                  const Valdi::JSPropertyName& propertyName) {
     auto guard = _threadAccessChecker.guard();
@@ -686,6 +688,23 @@ void QuickJSJavaScriptContext::setObjectProperty(const Valdi::JSValue& object,
     }
 }
 
+void QuickJSJavaScriptContext::setObjectProperties(const Valdi::JSValue& object,
+                                                   const Valdi::JSPropertyName* propertyNames,
+                                                   const Valdi::JSValueRef* propertyValues,
+                                                   size_t count,
+                                                   Valdi::JSExceptionTracker& exceptionTracker) {
+    auto guard = _threadAccessChecker.guard();
+    auto jsObject = fromValdiJSValue(object);
+    for (size_t i = 0; i < count; i++) {
+        // JS_SetProperty() automatically releases the given value.
+        auto retainedJsValue = JS_DupValue(_context, fromValdiJSValue(propertyValues[i].get()));
+        if (!checkCall(exceptionTracker,
+                       JS_SetProperty(_context, jsObject, fromValdiJSPropertyName(propertyNames[i]), retainedJsValue))) {
+            return;
+        }
+    }
+}
+
 void QuickJSJavaScriptContext::setObjectPropertyNonEumerable(const Valdi::JSValue& object,
                                                              const Valdi::JSPropertyName& propertyName,
                                                              const JSValue& propertyValue,
@@ -1035,7 +1054,22 @@ void QuickJSJavaScriptContext::releasePropertyName(const Valdi::JSPropertyName&
 
 void QuickJSJavaScriptContext::garbageCollect() {
     auto guard = _threadAccessChecker.guard();
+    runGarbageCollect();
+}
+
+bool QuickJSJavaScriptContext::performIdleGarbageCollection(std::chrono::steady_clock::duration budget) {
+    auto guard = _threadAccessChecker.guard();
+    // A cycle collection cannot be interrupted, so we only run it if the previous one would have fit
+    if (_lastGarbageCollectDuration <= budget) {
+        runGarbageCollect();
+    }
+    return true;
+}
+
+void QuickJSJavaScriptContext::runGarbageCollect() {
+    auto startTime = std::chrono::steady_clock::now();
     JS_RunGC(_runtime);
+    _lastGarbageCollectDuration = std::chrono::steady_clock::now() - startTime;
 }
 
 static JSValue flushMicrotask(JSContext* ctx, int argc, JSValueConst* argv) {
@@ -1187,14 +1221,16 @@ static void onObjectEdge(JSRuntime* rt, JSGCObjectHeader* gp) {
 
 #pragma clang diagnostic pop
 
-void QuickJSJavaScriptContext::dumpHeap(Valdi::JavaScriptHeapDumpBuilder& heapDumpBuilder) {
+void QuickJSJavaScriptContext::dumpHeap(Valdi::JavaScriptHeapDumpBuilder& heapDumpBuilder, bool dumpRuntimeObjects) {
     auto guard = _threadAccessChecker.guard();
     auto* oldOpaque = JS_GetRuntimeOpaque(_runtime);
 
     // We shove the heap dump builder as an opaque so that we can retrieve it while visiting
     // the heap.
     JS_SetRuntimeOpaque(_runtime, reinterpret_cast<Valdi::JavaScriptHeapDumpBuilder*>(&heapDumpBuilder));
-    JS_VisitAllGCObjects(_runtime, &onObjectBegin, &onObjectEdgeProperty, &onObjectEdge);
+    if (dumpRuntimeObjects) {
+        JS_VisitAllGCObjects(_runtime, &onObjectBegin, &onObjectEdgeProperty, &onObjectEdge);
+    }
 
     auto stashedJSValues = getAllStashedJSValues();
     // Emit the stashed JS values as a separate node
@@ -1219,8 +1255,17 @@ JSContext* QuickJSJavaScriptContext::getContext() const {
     return _context;
 }
 
+const Valdi::Ref<QuickJSRuntime>& QuickJSJavaScriptContext::getQuickJSRuntime() const {
+    return _quickJsRuntime;
+}
+
 JSClassID QuickJSJavaScriptContext::initializeClass(const JSClassDefWithId* classDef,
                                                     Valdi::JSExceptionTracker& exceptionTracker) {
+    // Classes are registered in the runtime, which might be shared with other contexts
+    if (JS_IsRegisteredClass(_runtime, classDef->classID) != 0) {
+        return classDef->classID;
+    }
+
     if (!checkCall(exceptionTracker, JS_NewClass(_runtime, classDef->classID, &classDef->classDef))) {
         return 0;
     }
@@ -1318,7 +1363,8 @@ void QuickJSJavaScriptContext::willExitVM(Valdi::JSExceptionTracker& exceptionTr
                 case 1:
                     continue;
                 case -1: {
-                    setExceptionToTracker(exceptionTracker);
+                    // When the runtime is shared, the job might have been enqueued by another context
+                    exceptionTracker.storeException(toRetainedJSValueRef(JS_GetException(context)));
                     notifyRejectedPromises();
                     return;
                 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "valdi/runtime/Interfaces/IJavaScriptContext.hpp"
+#include "valdi/quickjs/QuickJSRuntime.hpp"
 #include "valdi_core/cpp/Threading/ThreadAccessChecker.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
@@ -37,6 +38,7 @@ struct QuickJSRejectedPromise {
 class QuickJSJavaScriptContext : public Valdi::IJavaScriptContext {
 public:
     explicit QuickJSJavaScriptContext(Valdi::JavaScriptTaskScheduler* taskScheduler);
+    QuickJSJavaScriptContext(Valdi::JavaScriptTaskScheduler* taskScheduler, const Valdi::Ref<QuickJSRuntime>& runtime);
     ~QuickJSJavaScriptContext() override;
 
     Valdi::JSValueRef getGlobalObject(Valdi::JSExceptionTracker& exceptionTracker) override;
@@ -102,6 +104,12 @@ public:
 
     bool hasObjectProperty(const Valdi::JSValue& object, const Valdi::JSPropertyName& propertyName) final;
 
+    void getObjectProperties(const Valdi::JSValue& object,
+                             const Valdi::JSPropertyName* propertyNames,
+                             size_t count,
+                             Valdi::JSValueRef* outValues,
+                             Valdi::JSExceptionTracker& exceptionTracker) override;
+
     void setObjectProperty(const Valdi::JSValue& object,
                            const std::string_view& propertyName,
                            const Valdi::JSValue& propertyValue,
@@ -120,6 +128,12 @@ public:
                            bool enumerable,
                            Valdi::JSExceptionTracker& exceptionTracker) override;
 
+    void setObjectProperties(const Valdi::JSValue& object,
+                             const Valdi::JSPropertyName* propertyNames,
+                             const Valdi::JSValueRef* propertyValues,
+                             size_t count,
+                             Valdi::JSExceptionTracker& exceptionTracker) override;
+
     Valdi::JSValueRef callObjectAsFunction(const Valdi::JSValue& object,
                                            Valdi::JSFunctionCallContext& callContext) override;
 
@@ -175,9 +189,17 @@ public:
     void releasePropertyName(const Valdi::JSPropertyName& value) override;
 
     void garbageCollect() override;
+    bool performIdleGarbageCollection(std::chrono::steady_clock::duration budget) override;
     Valdi::JavaScriptContextMemoryStatistics dumpMemoryStatistics() override;
 
-    void dumpHeap(Valdi::JavaScriptHeapDumpBuilder& heapDumpBuilder);
+    /**
+     Dump the heap of the context into the given builder. When the runtime is shared, all the
+     objects of the runtime are visited, dumpRuntimeObjects can be set to false to only dump
+     the references exported by this context.
+     */
+    void dumpHeap(Valdi::JavaScriptHeapDumpBuilder& heapDumpBuilder, bool dumpRuntimeObjects);
+
+    const Valdi::Ref<QuickJSRuntime>& getQuickJSRuntime() const;
 
     void enqueueMicrotask(const Valdi::JSValue& value, Valdi::JSExceptionTracker& exceptionTracker) override;
 
@@ -207,7 +229,8 @@ protected:
 private:
     friend QuickJSJavaScriptContextEntry;
 
-    Valdi::ThreadAccessChecker _threadAccessChecker;
+    Valdi::Ref<QuickJSRuntime> _quickJsRuntime;
+    Valdi::ThreadAccessChecker& _threadAccessChecker;
 
     JSRuntime* _runtime = nullptr;
     JSContext* _context = nullptr;
@@ -230,8 +253,8 @@ private:
     JSClassID _wrappedObjectClassID = 0;
     JSClassID _weakReferenceFinalizerClassID = 0;
     size_t _enterVmCount = 0;
-    size_t _weakReferenceSequence = 0;
     bool _needsGarbageCollect = false;
+    std::chrono::steady_clock::duration _lastGarbageCollectDuration = std::chrono::steady_clock::duration::zero();
     std::thread::id _lastThreadId;
 
     std::deque<QuickJSRejectedPromise> _rejectedPromises;
@@ -244,6 +267,8 @@ private:
                                        const JSValue& propertyValue,
                                        Valdi::JSExceptionTracker& exceptionTracker);
 
+    void runGarbageCollect();
+
     Valdi::JSValueRef checkCallAndGetValue(Valdi::JSExceptionTracker& exceptionTracker, const JSValue& value);
     bool checkCall(Valdi::JSExceptionTracker& exceptionTracker, int retValue);
     void setExceptionToTracker(Valdi::JSExceptionTracker& exceptionTracker);
@@ -8,11 +8,19 @@
 #include "valdi/quickjs/QuickJSJavaScriptContextFactory.hpp"
 #include "valdi/quickjs/QuickJSJavaScriptContext.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptHeapDumpBuilder.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <algorithm>
+#include <quickjs/quickjs.h>
 
 namespace ValdiQuickJS {
 
 QuickJSJavaScriptContextFactory::QuickJSJavaScriptContextFactory() = default;
 
+QuickJSJavaScriptContextFactory::QuickJSJavaScriptContextFactory(bool shareRuntimeBetweenContexts)
+    : _shareRuntimeBetweenContexts(shareRuntimeBetweenContexts) {}
+
 const char* QuickJSJavaScriptContextFactory::getName() {
     return "QuickJS";
 }
@@ -23,23 +31,96 @@ bool QuickJSJavaScriptContextFactory::requiresDedicatedThread() {
 
 Valdi::Ref<Valdi::IJavaScriptContext> QuickJSJavaScriptContextFactory::createJsContext(
     Valdi::JavaScriptTaskScheduler* taskScheduler, Valdi::ILogger& /*logger*/) {
+    if (_shareRuntimeBetweenContexts) {
+        return Valdi::makeShared<QuickJSJavaScriptContext>(taskScheduler,
+                                                           QuickJSRuntime::getOrCreateForCurrentThread());
+    }
     return Valdi::makeShared<QuickJSJavaScriptContext>(taskScheduler);
 }
 
+bool QuickJSJavaScriptContextFactory::supportsBackgroundPreCompilation() {
+    return true;
+}
+
+static Valdi::Error getPendingError(JSContext* context) {
+    auto exception = JS_GetException(context);
+    const auto* message = JS_ToCString(context, exception);
+    auto error = Valdi::Error(Valdi::StringCache::getGlobal().makeString(
+        message != nullptr ? std::string_view(message) : std::string_view("Failed to compile script")));
+    JS_FreeCString(context, message);
+    JS_FreeValue(context, exception);
+
+    return error;
+}
+
+Valdi::Result<Valdi::BytesView> QuickJSJavaScriptContextFactory::preCompile(const std::string_view& script,
+                                                                            const std::string_view& sourceFilename) {
+    // Bytecode only references atoms by name, so it can be compiled in a short lived
+    // runtime and later read from the runtime of any JS context.
+    auto* runtime = JS_NewRuntime();
+    JS_SetPropertyCacheEnabledRT(runtime, 2); // Must match the runtimes of the JS contexts
+    auto* context = JS_NewContext(runtime);
+
+    auto formattedScript = Valdi::formatJsModule(script);
+    auto sourceFilenameStr = std::string(sourceFilename);
+    auto compiledScript = JS_Eval(context,
+                                  formattedScript.data(),
+                                  formattedScript.length(),
+                                  sourceFilenameStr.c_str(),
+                                  JS_EVAL_FLAG_COMPILE_ONLY);
+
+    Valdi::Result<Valdi::BytesView> result;
+    if (JS_IsException(compiledScript)) {
+        result = getPendingError(context);
+    } else {
+        size_t objectSize = 0;
+        auto* buffer = JS_WriteObject(context, &objectSize, compiledScript, JS_WRITE_OBJ_BYTECODE);
+        if (buffer == nullptr) {
+            result = Valdi::Error("Could not write object");
+        } else {
+            result = Valdi::makePreCompiledJsModule(reinterpret_cast<const Valdi::Byte*>(buffer), objectSize);
+            js_free(context, buffer);
+        }
+    }
+
+    JS_FreeValue(context, compiledScript);
+    JS_FreeContext(context);
+    JS_FreeRuntime(runtime);
+
+    return result;
+}
+
 Valdi::BytesView QuickJSJavaScriptContextFactory::dumpHeap(std::span<Valdi::IJavaScriptContext*> jsContexts,
                                                            Valdi::JSExceptionTracker& exceptionTracker) {
-    if constexpr (Valdi::shouldEnableJsHeapDump()) {
-        Valdi::JavaScriptHeapDumpBuilder heapDumpBuilder;
+    Valdi::JavaScriptHeapDumpBuilder heapDumpBuilder;
+    if (!appendHeapDump(jsContexts, heapDumpBuilder, exceptionTracker) || !exceptionTracker) {
+        return Valdi::BytesView();
+    }
 
+    return heapDumpBuilder.build();
+}
+
+bool QuickJSJavaScriptContextFactory::appendHeapDump(std::span<Valdi::IJavaScriptContext*> jsContexts,
+                                                     Valdi::JavaScriptHeapDumpBuilder& heapDumpBuilder,
+                                                     Valdi::JSExceptionTracker& exceptionTracker) {
+    if constexpr (Valdi::shouldEnableJsHeapDump()) {
+        // The objects of a shared runtime are only dumped once
+        std::vector<const QuickJSRuntime*> dumpedRuntimes;
         for (auto* jsContext : jsContexts) {
-            dynamic_cast<QuickJSJavaScriptContext*>(jsContext)->dumpHeap(heapDumpBuilder);
+            auto* quickJsContext = dynamic_cast<QuickJSJavaScriptContext*>(jsContext);
+            const auto* runtime = quickJsContext->getQuickJSRuntime().get();
+            auto dumpRuntimeObjects =
+                std::find(dumpedRuntimes.begin(), dumpedRuntimes.end(), runtime) == dumpedRuntimes.end();
+            if (dumpRuntimeObjects) {
+                dumpedRuntimes.emplace_back(runtime);
+            }
+            quickJsContext->dumpHeap(heapDumpBuilder, dumpRuntimeObjects);
         }
-
-        return heapDumpBuilder.build();
     } else {
         exceptionTracker.onError("Heap dump support not enabled");
-        return Valdi::BytesView();
     }
+
+    return true;
 }
 
 } // namespace ValdiQuickJS
@@ -0,0 +1,120 @@
+//
+//  QuickJSRuntime.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/quickjs/QuickJSRuntime.hpp"
+#include "valdi/quickjs/QuickJSJavaScriptContext.hpp"
+#include "valdi/quickjs/QuickJSUtils.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+namespace ValdiQuickJS {
+
+struct SharedRuntimes {
+    std::mutex mutex;
+    Valdi::FlatMap<std::thread::id, QuickJSRuntime*> runtimeByThreadId;
+};
+
+static SharedRuntimes& getSharedRuntimes() {
+    static auto* kSharedRuntimes = new SharedRuntimes();
+    return *kSharedRuntimes;
+}
+
+static int handleInterrupt(JSRuntime* /*rt*/, void* opaque) {
+    reinterpret_cast<QuickJSRuntime*>(opaque)->onInterrupt();
+    return 0;
+}
+
+static void handleRejectedPromise(
+    JSContext* ctx, JSValueConst promise, JSValueConst reason, JS_BOOL is_handled, void* /*opaque*/) {
+    auto& jsContext = *getValdiJSContext(ctx);
+
+    if (is_handled == 0) {
+        jsContext.appendRejectedPromise(promise, reason);
+    } else {
+        jsContext.removeRejectedPromise(promise);
+    }
+}
+
+QuickJSRuntime::QuickJSRuntime() : _runtime(JS_NewRuntime()) {
+    JS_SetPropertyCacheEnabledRT(_runtime, 2); // 2 = enabled for both get and set
+    JS_SetRuntimeOpaque(_runtime, this);
+    JS_SetHostPromiseRejectionTracker(_runtime, &handleRejectedPromise, nullptr);
+    JS_SetInterruptHandler(_runtime, &handleInterrupt, this);
+}
+
+QuickJSRuntime::~QuickJSRuntime() {
+    {
+        auto& sharedRuntimes = getSharedRuntimes();
+        std::lock_guard<std::mutex> lock(sharedRuntimes.mutex);
+        for (auto it = sharedRuntimes.runtimeByThreadId.begin(); it != sharedRuntimes.runtimeByThreadId.end(); ++it) {
+            if (it->second == this) {
+                sharedRuntimes.runtimeByThreadId.erase(it);
+                break;
+            }
+        }
+    }
+
+    JS_FreeRuntime(_runtime);
+}
+
+JSRuntime* QuickJSRuntime::get() const {
+    return _runtime;
+}
+
+Valdi::ThreadAccessChecker& QuickJSRuntime::getThreadAccessChecker() {
+    return _threadAccessChecker;
+}
+
+void QuickJSRuntime::attachContext(QuickJSJavaScriptContext* context) {
+    _contexts.emplace_back(context);
+}
+
+void QuickJSRuntime::detachContext(QuickJSJavaScriptContext* context) {
+    auto it = std::find(_contexts.begin(), _contexts.end(), context);
+    if (it != _contexts.end()) {
+        _contexts.erase(it);
+    }
+}
+
+size_t QuickJSRuntime::makeWeakReferenceId() {
+    return ++_weakReferenceSequence;
+}
+
+void QuickJSRuntime::removeWeakReference(size_t weakReferenceId) {
+    for (auto* context : _contexts) {
+        context->removeWeakReference(weakReferenceId);
+    }
+}
+
+void QuickJSRuntime::onInterrupt() {
+    for (auto* context : _contexts) {
+        if (context->interruptRequested()) {
+            context->onInterrupt();
+        }
+    }
+}
+
+Valdi::Ref<QuickJSRuntime> QuickJSRuntime::getOrCreateForCurrentThread() {
+    auto& sharedRuntimes = getSharedRuntimes();
+    std::lock_guard<std::mutex> lock(sharedRuntimes.mutex);
+
+    auto threadId = std::this_thread::get_id();
+    const auto& it = sharedRuntimes.runtimeByThreadId.find(threadId);
+    if (it != sharedRuntimes.runtimeByThreadId.end()) {
+        return Valdi::strongSmallRef(it->second);
+    }
+
+    auto runtime = Valdi::makeShared<QuickJSRuntime>();
+    sharedRuntimes.runtimeByThreadId[threadId] = runtime.get();
+
+    return runtime;
+}
+
+} // namespace ValdiQuickJS
@@ -0,0 +1,68 @@
+//
+//  QuickJSRuntime.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Threading/ThreadAccessChecker.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <quickjs/quickjs.h>
+#include <vector>
+
+namespace ValdiQuickJS {
+
+class QuickJSJavaScriptContext;
+
+/**
+ QuickJSRuntime owns a QuickJS JSRuntime, which holds the atoms, the shapes and the garbage
+ collected heap of all the JSContexts created from it. A runtime can be shared between several
+ QuickJSJavaScriptContext which are used from the same thread, in which case each of them has
+ its own JSContext, and thus its own global object, inside the shared runtime.
+ */
+class QuickJSRuntime : public Valdi::SimpleRefCountable {
+public:
+    QuickJSRuntime();
+    ~QuickJSRuntime() override;
+
+    JSRuntime* get() const;
+
+    /**
+     The thread access checker shared by all the contexts created from this runtime,
+     since none of them can be used while another one is being used in a different thread.
+     */
+    Valdi::ThreadAccessChecker& getThreadAccessChecker();
+
+    void attachContext(QuickJSJavaScriptContext* context);
+    void detachContext(QuickJSJavaScriptContext* context);
+
+    /**
+     Returns a new weak reference id. Ids are unique across all the contexts of the runtime,
+     as the weak reference finalizers only know about the runtime they are collected from.
+     */
+    size_t makeWeakReferenceId();
+    void removeWeakReference(size_t weakReferenceId);
+
+    void onInterrupt();
+
+    /**
+     Returns the runtime shared between the contexts of the current thread, creating it if needed.
+     The runtime is released once the last context using it is destroyed.
+     */
+    static Valdi::Ref<QuickJSRuntime> getOrCreateForCurrentThread();
+
+private:
+    JSRuntime* _runtime;
+    Valdi::ThreadAccessChecker _threadAccessChecker;
+    std::vector<QuickJSJavaScriptContext*> _contexts;
+    size_t _weakReferenceSequence = 0;
+};
+
+inline QuickJSRuntime* getQuickJSRuntime(JSRuntime* rt) {
+    return reinterpret_cast<QuickJSRuntime*>(JS_GetRuntimeOpaque(rt));
+}
+
+} // namespace ValdiQuickJS
@@ -14,6 +14,7 @@
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 
 #include "valdi/quickjs/QuickJSJavaScriptContext.hpp"
+#include "valdi/quickjs/QuickJSRuntime.hpp"
 
 #include <mutex>
 
@@ -63,10 +64,10 @@ void jsFunctionFinalize(JSRuntime* /*tr*/, JSValue value) {
 }
 
 void jsWeakRefFinalizerFinalize(JSRuntime* tr, JSValue value) {
-    auto* jsContext = getValdiJSContext(tr);
-    if (jsContext != nullptr) {
+    auto* runtime = getQuickJSRuntime(tr);
+    if (runtime != nullptr) {
         auto weakReferenceId = weakReferenceIdFromJSWeakReferenceFinalizer(value);
-        jsContext->removeWeakReference(weakReferenceId);
+        runtime->removeWeakReference(weakReferenceId);
     }
 }
 
@@ -45,15 +45,11 @@ inline JSAtom fromValdiJSPropertyName(const Valdi::JSPropertyName& value) {
 }
 
 inline void attachValdiJSContext(JSContext* context, QuickJSJavaScriptContext* quickJsContext) {
-    JS_SetRuntimeOpaque(JS_GetRuntime(context), quickJsContext);
+    JS_SetContextOpaque(context, quickJsContext);
 }
 
 inline QuickJSJavaScriptContext* getValdiJSContext(JSContext* context) {
-    return reinterpret_cast<QuickJSJavaScriptContext*>(JS_GetRuntimeOpaque(JS_GetRuntime(context)));
-}
-
-inline QuickJSJavaScriptContext* getValdiJSContext(JSRuntime* rt) {
-    return reinterpret_cast<QuickJSJavaScriptContext*>(JS_GetRuntimeOpaque(rt));
+    return reinterpret_cast<QuickJSJavaScriptContext*>(JS_GetContextOpaque(context));
 }
 
 inline void setObjectCallable(const JSValue& value, const Valdi::Ref<Valdi::JSFunction>& callable) {
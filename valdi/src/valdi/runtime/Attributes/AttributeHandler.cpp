@@ -13,6 +13,7 @@
 #include "valdi/runtime/Context/ViewNode.hpp"
 #include "valdi_core/cpp/Constants.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/PerfCounters.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
 namespace Valdi {
@@ -51,14 +52,20 @@ Result<Void> AttributeHandler::applyAttribute(ViewTransactionScope& viewTransact
                                               const Valdi::Value& value,
                                               const SharedAnimator& animator) const {
     SC_ASSERT(!requiresView() || viewNode.hasView());
+    PerfCounters::increment(PerfCounterType::AttributesApplied);
 
     Result<Void> result;
-    auto postprocessedValue = postprocess(viewNode, value);
-    if (postprocessedValue) {
-        result = _delegate->onApply(
-            viewTransactionScope, viewNode, viewNode.getView(), _name, postprocessedValue.value(), animator);
+    if (VALDI_LIKELY(_postprocessors.empty())) {
+        // Most attributes don't have postprocessors, the value can be given to the delegate as is
+        result = _delegate->onApply(viewTransactionScope, viewNode, viewNode.getView(), _name, value, animator);
     } else {
-        result = postprocessedValue.moveError();
+        auto postprocessedValue = postprocess(viewNode, value);
+        if (postprocessedValue) {
+            result = _delegate->onApply(
+                viewTransactionScope, viewNode, viewNode.getView(), _name, postprocessedValue.value(), animator);
+        } else {
+            result = postprocessedValue.moveError();
+        }
     }
 
     if (!result) {
@@ -104,18 +111,20 @@ Result<PreprocessedValue> AttributeHandler::preprocess(const Value& value) const
             return *result;
         }
 
+        ColorPaletteLookupRecorder colorLookupRecorder;
         auto preprocessResult = preprocessWithoutCache(value);
         if (!preprocessResult) {
             return preprocessResult.moveError();
         }
 
-        return _preprocessorCache->store(cacheKey, preprocessResult.moveValue());
+        return _preprocessorCache->store(cacheKey, preprocessResult.moveValue(), colorLookupRecorder.getColorIds());
     } else {
+        ColorPaletteLookupRecorder colorLookupRecorder;
         auto result = preprocessWithoutCache(value);
         if (!result) {
             return result.moveError();
         }
-        return PreprocessedValue(result.moveValue());
+        return PreprocessedValue(result.moveValue(), colorLookupRecorder.getColorIds());
     }
 }
 
@@ -176,6 +185,12 @@ void AttributeHandler::clearPreprocessorCache() {
     }
 }
 
+void AttributeHandler::clearPreprocessorCache(const ColorPaletteChanges& changes) {
+    if (_preprocessorCache != nullptr) {
+        _preprocessorCache->clear(changes);
+    }
+}
+
 const Ref<CompositeAttribute>& AttributeHandler::getCompositeAttribute() const {
     return _compositeAttribute;
 }
@@ -211,6 +226,10 @@ AttributeHandler AttributeHandler::withDelegate(const Ref<AttributeHandlerDelega
         handler.setShouldReevaluateOnColorPaletteChange(true);
     }
 
+    if (_alwaysApply) {
+        handler.setAlwaysApply(true);
+    }
+
     handler._preprocessors = _preprocessors;
     if (!_preprocessingTrivial) {
         handler._preprocessingTrivial = false;
@@ -241,6 +260,18 @@ bool AttributeHandler::isCompositePart() const {
     return _isCompositePart;
 }
 
+bool AttributeHandler::hasPostprocessors() const {
+    return !_postprocessors.empty();
+}
+
+void AttributeHandler::setAlwaysApply(bool alwaysApply) {
+    _alwaysApply = alwaysApply;
+}
+
+bool AttributeHandler::alwaysApply() const {
+    return _alwaysApply;
+}
+
 bool AttributeHandler::isPreprocessingTrivial() const {
     return _preprocessingTrivial;
 }
@@ -79,6 +79,11 @@ public:
 
     void clearPreprocessorCache();
 
+    /**
+     Clear the preprocessed values that were resolved with any of the changed colors.
+     */
+    void clearPreprocessorCache(const ColorPaletteChanges& changes);
+
     /**
      * If this Attribute belongs to a Composite attribute, this will be non null
      */
@@ -98,9 +103,17 @@ public:
     bool hasPreprocessors() const;
     bool shouldReevaluateOnColorPaletteChange() const;
     bool isCompositePart() const;
+    bool hasPostprocessors() const;
+
+    /**
+     Whether the attribute should be applied every time it is evaluated, even when
+     its resolved value is equal to the value that was last applied on the view.
+     */
+    bool alwaysApply() const;
 
     void setEnablePreprocessorCache(bool enablePreprocessorCache);
     void setShouldReevaluateOnColorPaletteChange(bool reevaluateOnColorPaletteChange);
+    void setAlwaysApply(bool alwaysApply);
 
     AttributeHandler withDelegate(const Ref<AttributeHandlerDelegate>& delegate) const;
 
@@ -119,6 +132,7 @@ private:
     bool _shouldReevaluateOnColorPaletteChange = false;
     bool _isCompositePart = false;
     bool _preprocessingTrivial = true;
+    bool _alwaysApply = false;
 };
 
 } // namespace Valdi
@@ -17,6 +17,7 @@
 namespace Valdi {
 
 class AttributeOwner;
+class ColorPaletteChanges;
 class ViewTransactionScope;
 
 class AttributesApplier : public SimpleRefCountable {
@@ -66,6 +67,14 @@ public:
      */
     virtual void reapplyAttribute(ViewTransactionScope& viewTransactionScope, AttributeId id) = 0;
 
+    /**
+     Reapply a previously applied attribute if its value was resolved with any of the changed colors.
+     The attribute is not applied again if it still resolves to the value that was last applied.
+     */
+    virtual void reapplyAttributeForColorChanges(ViewTransactionScope& viewTransactionScope,
+                                                 AttributeId id,
+                                                 const ColorPaletteChanges& changes) = 0;
+
     /**
      Apply any pending changes. Mostly used for composite attributes, since they need to be
      calculated from a set of attributes.
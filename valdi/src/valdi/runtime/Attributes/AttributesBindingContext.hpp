@@ -30,6 +30,13 @@ public:
                                       bool enableCache,
                                       AttributePreprocessor&& preprocessor) = 0;
 
+    /**
+     Mark the given bound attribute as always applied: its handler will be called every time
+     the attribute is evaluated, even when its resolved value did not change since it was last
+     applied. Handlers with side effects beyond setting the value on the view should use this.
+     */
+    virtual void setAlwaysApply(const StringBox& attribute) = 0;
+
     virtual AttributeId bindStringAttribute(const StringBox& attribute,
                                             bool invalidateLayoutOnChange,
                                             const Ref<AttributeHandlerDelegate>& delegate) = 0;
@@ -69,6 +69,13 @@ void AttributesBindingContextImpl::registerPreprocessor(const Valdi::StringBox&
     }
 }
 
+void AttributesBindingContextImpl::setAlwaysApply(const StringBox& attribute) {
+    auto attributeId = _attributeIds.getIdForName(attribute);
+    auto it = _handlers.find(attributeId);
+    SC_ASSERT(it != _handlers.end(), "setAlwaysApply must be called after an attribute has been bound.");
+    it->second.setAlwaysApply(true);
+}
+
 AttributeId AttributesBindingContextImpl::bindStringAttribute(const StringBox& attribute,
                                                               bool invalidateLayoutOnChange,
                                                               const Ref<AttributeHandlerDelegate>& delegate) {
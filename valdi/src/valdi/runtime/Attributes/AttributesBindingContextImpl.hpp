@@ -28,6 +28,8 @@ public:
                               bool enableCache,
                               AttributePreprocessor&& preprocessor) override;
 
+    void setAlwaysApply(const StringBox& attribute) override;
+
     AttributeId bindStringAttribute(const StringBox& attribute,
                                     bool invalidateLayoutOnChange,
                                     const Ref<AttributeHandlerDelegate>& delegate) override;
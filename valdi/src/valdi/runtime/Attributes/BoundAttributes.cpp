@@ -11,6 +11,8 @@
 #include "valdi/runtime/Context/ViewNode.hpp"
 #include "valdi/runtime/Views/MeasureDelegate.hpp"
 
+#include <algorithm>
+
 namespace Valdi {
 
 BoundAttributes::BoundAttributes(const StringBox& className,
@@ -25,6 +27,15 @@ BoundAttributes::BoundAttributes(const StringBox& className,
       _measureDelegate(measureDelegate),
       _attributeIds(attributeIds),
       _scrollable(scrollable) {
+    // The handlers are resolved from a table indexed by AttributeId, sized once upfront
+    AttributeId maxAttributeId = 0;
+    for (const auto& it : _handlerByAttributeName) {
+        maxAttributeId = std::max(maxAttributeId, it.second.getId());
+    }
+    if (!_handlerByAttributeName.empty()) {
+        _attributeHandlers.resize(maxAttributeId + 1, nullptr);
+    }
+
     for (auto& it : _handlerByAttributeName) {
         insertAttributeHandler(&it.second);
     }
@@ -35,8 +46,8 @@ BoundAttributes::~BoundAttributes() = default;
 void BoundAttributes::insertAttributeHandler(AttributeHandler* attributeHandler) {
     auto attributeId = attributeHandler->getId();
 
-    while (attributeId >= _attributeHandlers.size()) {
-        _attributeHandlers.emplace_back(nullptr);
+    if (attributeId >= _attributeHandlers.size()) {
+        _attributeHandlers.resize(attributeId + 1, nullptr);
     }
 
     _attributeHandlers[attributeId] = attributeHandler;
@@ -11,8 +11,9 @@ namespace Valdi {
 
 PreprocessorCacheValue::PreprocessorCacheValue(const PreprocessorCacheKey& key,
                                                const Value& value,
+                                               ColorIds colorIds,
                                                Weak<PreprocessorCache> cache)
-    : _key(key), _value(value), _cache(std::move(cache)) {}
+    : _key(key), _value(value), _colorIds(std::move(colorIds)), _cache(std::move(cache)) {}
 
 PreprocessorCacheValue::~PreprocessorCacheValue() {
     auto cache = _cache.lock();
@@ -25,12 +26,31 @@ const Value& PreprocessorCacheValue::value() const {
     return _value;
 }
 
+const ColorIds& PreprocessorCacheValue::colorIds() const {
+    return _colorIds;
+}
+
 PreprocessedValue::PreprocessedValue(Value value) : value(std::move(value)) {}
 
-PreprocessedValue::PreprocessedValue(Value value, Ref<SharedPtrRefCountable> handle)
-    : value(std::move(value)), handle(std::move(handle)) {}
+PreprocessedValue::PreprocessedValue(Value value, ColorIds colorIds)
+    : value(std::move(value)), colorIds(std::move(colorIds)) {}
+
+PreprocessedValue::PreprocessedValue(Value value, Ref<SharedPtrRefCountable> handle, ColorIds colorIds)
+    : value(std::move(value)), handle(std::move(handle)), colorIds(std::move(colorIds)) {}
+
+// Enough to hold the values used by a typical screen for a single attribute
+static constexpr size_t kDefaultRecentlyUsedValuesCapacity = 32;
+
+PreprocessorCache::PreprocessorCache() : PreprocessorCache(kDefaultRecentlyUsedValuesCapacity) {}
+
+PreprocessorCache::PreprocessorCache(size_t recentlyUsedValuesCapacity)
+    : _recentlyUsedValues(recentlyUsedValuesCapacity) {}
+
+PreprocessorCache::~PreprocessorCache() = default;
 
 std::optional<PreprocessedValue> PreprocessorCache::get(const PreprocessorCacheKey& key) const {
+    // Declared before the lock so that it is released after it
+    Ref<PreprocessorCacheValue> evictedValue;
     std::lock_guard<Mutex> guard(_mutex);
 
     const auto& it = _cache.find(key);
@@ -43,29 +63,74 @@ std::optional<PreprocessedValue> PreprocessorCache::get(const PreprocessorCacheK
         return std::nullopt;
     }
 
+    evictedValue = markRecentlyUsed(strongCachedValue);
+
     auto value = strongCachedValue->value();
 
-    return PreprocessedValue(std::move(value), strongCachedValue);
+    return PreprocessedValue(std::move(value), strongCachedValue, strongCachedValue->colorIds());
 }
 
-PreprocessedValue PreprocessorCache::store(const PreprocessorCacheKey& key, const Value& value) {
+PreprocessedValue PreprocessorCache::store(const PreprocessorCacheKey& key, const Value& value, ColorIds colorIds) {
+    Ref<PreprocessorCacheValue> evictedValue;
     std::lock_guard<Mutex> guard(_mutex);
-    auto cachedValue = Valdi::makeShared<PreprocessorCacheValue>(key, value, weak_from_this());
+    auto cachedValue = Valdi::makeShared<PreprocessorCacheValue>(key, value, colorIds, weak_from_this());
     _cache[key] = cachedValue;
-    return PreprocessedValue(value, cachedValue);
+    evictedValue = markRecentlyUsed(cachedValue);
+    return PreprocessedValue(value, cachedValue, std::move(colorIds));
+}
+
+Ref<PreprocessorCacheValue> PreprocessorCache::markRecentlyUsed(const Ref<PreprocessorCacheValue>& value) const {
+    if (_recentlyUsedValues.empty()) {
+        return nullptr;
+    }
+
+    // Values used repeatedly can appear multiple times, which keeps them alive for longer
+    auto evictedValue = std::move(_recentlyUsedValues[_recentlyUsedValuesIndex]);
+    _recentlyUsedValues[_recentlyUsedValuesIndex] = value;
+    _recentlyUsedValuesIndex = (_recentlyUsedValuesIndex + 1) % _recentlyUsedValues.size();
+
+    return evictedValue;
 }
 
 void PreprocessorCache::removeCacheKey(const PreprocessorCacheKey& key) {
     std::lock_guard<Mutex> guard(_mutex);
     const auto& it = _cache.find(key);
-    if (it != _cache.end()) {
+    // The key might have been stored again with a new value after the cache was cleared
+    if (it != _cache.end() && it->second.expired()) {
         _cache.erase(key);
     }
 }
 
 void PreprocessorCache::clear() {
+    std::vector<Ref<PreprocessorCacheValue>> recentlyUsedValues;
     std::lock_guard<Mutex> guard(_mutex);
     _cache.clear();
+    recentlyUsedValues.resize(_recentlyUsedValues.size());
+    std::swap(recentlyUsedValues, _recentlyUsedValues);
+    _recentlyUsedValuesIndex = 0;
+}
+
+void PreprocessorCache::clear(const ColorPaletteChanges& changes) {
+    // Declared before the lock so that the values are released after it
+    std::vector<Ref<PreprocessorCacheValue>> removedValues;
+    std::lock_guard<Mutex> guard(_mutex);
+
+    auto it = _cache.begin();
+    while (it != _cache.end()) {
+        auto cachedValue = it->second.lock();
+        if (cachedValue != nullptr && changes.containsAny(cachedValue->colorIds())) {
+            it = _cache.erase(it);
+            removedValues.emplace_back(std::move(cachedValue));
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto& recentlyUsedValue : _recentlyUsedValues) {
+        if (recentlyUsedValue != nullptr && changes.containsAny(recentlyUsedValue->colorIds())) {
+            removedValues.emplace_back(std::move(recentlyUsedValue));
+        }
+    }
 }
 
 } // namespace Valdi
@@ -8,11 +8,13 @@
 #pragma once
 
 #include "valdi/runtime/Attributes/PreprocessorCacheKey.hpp"
+#include "valdi_core/cpp/Attributes/ColorPalette.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/Value.hpp"
 #include <optional>
+#include <vector>
 
 namespace Valdi {
 
@@ -25,37 +27,64 @@ namespace Valdi {
 struct PreprocessedValue {
     Value value;
     Ref<SharedPtrRefCountable> handle;
+    // The colors of the ColorPalette that the value was resolved with
+    ColorIds colorIds;
 
     explicit PreprocessedValue(Value value);
-    PreprocessedValue(Value value, Ref<SharedPtrRefCountable> handle);
+    PreprocessedValue(Value value, ColorIds colorIds);
+    PreprocessedValue(Value value, Ref<SharedPtrRefCountable> handle, ColorIds colorIds);
 };
 
 class PreprocessorCache;
 class PreprocessorCacheValue : public SharedPtrRefCountable {
 public:
-    PreprocessorCacheValue(const PreprocessorCacheKey& key, const Value& value, Weak<PreprocessorCache> cache);
+    PreprocessorCacheValue(const PreprocessorCacheKey& key,
+                           const Value& value,
+                           ColorIds colorIds,
+                           Weak<PreprocessorCache> cache);
     ~PreprocessorCacheValue() override;
 
     const Value& value() const;
+    const ColorIds& colorIds() const;
 
 private:
     PreprocessorCacheKey _key;
     Value _value;
+    ColorIds _colorIds;
     Weak<PreprocessorCache> _cache;
 };
 
+/**
+ Caches preprocessed values by their input value. Values are held weakly and are
+ removed once no consumer holds their handle, except for the most recently used
+ values which are kept alive, so that closing and re-opening a screen can re-use them.
+ */
 class PreprocessorCache : public std::enable_shared_from_this<PreprocessorCache> {
 public:
+    PreprocessorCache();
+    explicit PreprocessorCache(size_t recentlyUsedValuesCapacity);
+    ~PreprocessorCache();
+
     std::optional<PreprocessedValue> get(const PreprocessorCacheKey& key) const;
-    PreprocessedValue store(const PreprocessorCacheKey& key, const Value& value);
+    PreprocessedValue store(const PreprocessorCacheKey& key, const Value& value, ColorIds colorIds = ColorIds());
     void clear();
 
+    /**
+     Remove the values that were resolved with any of the changed colors.
+     */
+    void clear(const ColorPaletteChanges& changes);
+
 private:
     FlatMap<PreprocessorCacheKey, Weak<PreprocessorCacheValue>> _cache;
+    // Ring buffer retaining the most recently used values
+    mutable std::vector<Ref<PreprocessorCacheValue>> _recentlyUsedValues;
+    mutable size_t _recentlyUsedValuesIndex = 0;
     mutable Mutex _mutex;
 
     friend PreprocessorCacheValue;
     void removeCacheKey(const PreprocessorCacheKey& key);
+
+    Ref<PreprocessorCacheValue> markRecentlyUsed(const Ref<PreprocessorCacheValue>& value) const;
 };
 
 } // namespace Valdi
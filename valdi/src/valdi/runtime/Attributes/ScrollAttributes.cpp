@@ -8,6 +8,7 @@
 #include "valdi/runtime/Attributes/ScrollAttributes.hpp"
 #include "valdi/runtime/Attributes/AttributeHandlerDelegateWithCallable.hpp"
 
+#include "valdi/runtime/Context/ScrollLinkedEffects.hpp"
 #include "valdi/runtime/Context/ViewNode.hpp"
 
 #include "valdi/runtime/Attributes/AttributesBinderHelper.hpp"
@@ -71,6 +72,21 @@ void ScrollAttributes::bind(AttributeHandlerById& attributes) {
             viewNode.setScrollContentOffset(viewTransactionScope, Point(), false);
         });
 
+    binder.bind(
+        "scrollLinkedEffects",
+        [](ViewTransactionScope& viewTransactionScope, ViewNode& viewNode, const Value& value) -> Result<Void> {
+            auto scrollLinkedEffects = ScrollLinkedEffects::parse(value, viewNode.getAttributeIds());
+            if (!scrollLinkedEffects) {
+                return scrollLinkedEffects.moveError();
+            }
+
+            viewNode.setScrollLinkedEffects(viewTransactionScope, scrollLinkedEffects.moveValue());
+            return Void();
+        },
+        [](ViewTransactionScope& viewTransactionScope, ViewNode& viewNode) {
+            viewNode.setScrollLinkedEffects(viewTransactionScope, nullptr);
+        });
+
     binder.bindViewNodeFloat("staticContentWidth", &ViewNode::setScrollStaticContentWidth);
     binder.bindViewNodeFloat("staticContentHeight", &ViewNode::setScrollStaticContentHeight);
 }
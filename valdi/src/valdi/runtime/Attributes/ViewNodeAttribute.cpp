@@ -21,7 +21,8 @@ ViewNodeAttribute::ViewNodeAttribute(const AttributeHandler* handler)
     : _handler(handler),
       _handlerNeedsView(handler->requiresView()),
       _handlerCanAffectLayout(handler->shouldInvalidateLayoutOnChange()),
-      _handlerIsCompositePart(handler->isCompositePart()) {}
+      _handlerIsCompositePart(handler->isCompositePart()),
+      _handlerSkipsUnchangedValues(canSkipUnchangedValues(handler)) {}
 
 ViewNodeAttribute::~ViewNodeAttribute() {
     if (_hasSingleAttribute) {
@@ -202,6 +203,11 @@ void ViewNodeAttribute::replaceValue(const Value& value) {
 
     _appliedValueDirty = false;
     _hasAppliedValue = true;
+    _forceApply = false;
+
+    if (_handlerSkipsUnchangedValues) {
+        _appliedValue = value;
+    }
 }
 
 Value ViewNodeAttribute::getResolvedValue() const {
@@ -348,8 +354,14 @@ Result<Void> ViewNodeAttribute::update(ViewTransactionScope& viewTransactionScop
 
     if (needValue) {
         if (!_hasAppliedValue || _appliedValueDirty) {
+            // The resolved value can change back and forth between two updates, or be rebuilt into
+            // an equal value like for composite attributes, in which case the view already holds it.
+            auto canSkipUnchangedValue = _hasAppliedValue && !_forceApply && !justAddedView &&
+                                         _handlerSkipsUnchangedValues && _pendingAnimatedValue == nullptr;
+
             _hasAppliedValue = true;
             _appliedValueDirty = false;
+            _forceApply = false;
 
             auto pendingAnimatedValue = std::move(_pendingAnimatedValue);
 
@@ -358,11 +370,23 @@ Result<Void> ViewNodeAttribute::update(ViewTransactionScope& viewTransactionScop
                 return result.moveError();
             }
 
+            if (canSkipUnchangedValue && result.value() == _appliedValue) {
+                return Void();
+            }
+
+            if (_handlerSkipsUnchangedValues) {
+                _appliedValue = result.value();
+            }
+
             // The intention here is to only apply the attribute values that are supposed to describe the initial
             // pre-animation state of the view, but got captured in the view's "appearing in the viewport" animation
             bool shouldForceApplyWithoutAnimation = pendingAnimatedValue == nullptr && justAddedView;
             if (shouldForceApplyWithoutAnimation) {
-                return _handler->applyAttribute(viewTransactionScope, *viewNode, result.value(), nullptr);
+                auto applyResult = _handler->applyAttribute(viewTransactionScope, *viewNode, result.value(), nullptr);
+                if (!applyResult) {
+                    _forceApply = true;
+                }
+                return applyResult;
             }
             auto flushResult =
                 flushPendingAnimatedValue(viewTransactionScope, viewNode, pendingAnimatedValue, animator != nullptr);
@@ -370,6 +394,7 @@ Result<Void> ViewNodeAttribute::update(ViewTransactionScope& viewTransactionScop
             auto applyResult = _handler->applyAttribute(viewTransactionScope, *viewNode, result.value(), animator);
 
             if (!applyResult) {
+                _forceApply = true;
                 return applyResult;
             }
 
@@ -383,6 +408,7 @@ Result<Void> ViewNodeAttribute::update(ViewTransactionScope& viewTransactionScop
         if (_hasAppliedValue) {
             _hasAppliedValue = false;
             _appliedValueDirty = false;
+            _appliedValue = Value();
 
             auto pendingAnimatedValue = std::move(_pendingAnimatedValue);
             auto flushResult =
@@ -422,6 +448,8 @@ Result<Void> ViewNodeAttribute::flushPendingAnimatedValue(ViewTransactionScope&
 
 void ViewNodeAttribute::markDirty() {
     _appliedValueDirty = true;
+    // Explicit reapplies are used when the output of the handler changes for the same value
+    _forceApply = true;
 
     if (_hasSingleAttribute) {
         getSingleAttributeValue().preprocessedValue = Result<PreprocessedValue>();
@@ -432,6 +460,41 @@ void ViewNodeAttribute::markDirty() {
     }
 }
 
+static bool invalidatePreprocessedValueForColorChanges(AttributeValue& attributeValue,
+                                                       const ColorPaletteChanges& changes) {
+    if (attributeValue.preprocessedValue.empty()) {
+        return false;
+    }
+
+    // Values which failed to resolve might reference a color that was just added
+    if (attributeValue.preprocessedValue && !changes.containsAny(attributeValue.preprocessedValue.value().colorIds)) {
+        return false;
+    }
+
+    attributeValue.preprocessedValue = Result<PreprocessedValue>();
+    return true;
+}
+
+bool ViewNodeAttribute::markDirtyForColorChanges(const ColorPaletteChanges& changes) {
+    auto dirty = false;
+
+    if (_hasSingleAttribute) {
+        dirty = invalidatePreprocessedValueForColorChanges(getSingleAttributeValue(), changes);
+    } else if (_hasAttributeCollection) {
+        for (auto& it : getAttributeValueCollection().values) {
+            if (invalidatePreprocessedValueForColorChanges(it, changes)) {
+                dirty = true;
+            }
+        }
+    }
+
+    if (dirty) {
+        _appliedValueDirty = true;
+    }
+
+    return dirty;
+}
+
 Ref<ViewNodeAttribute> ViewNodeAttribute::copy() {
     auto copy = makeShared<ViewNodeAttribute>(_handler);
 
@@ -452,6 +515,16 @@ void ViewNodeAttribute::setHandler(const AttributeHandler* handler) {
     _handlerNeedsView = handler->requiresView();
     _handlerCanAffectLayout = handler->shouldInvalidateLayoutOnChange();
     _handlerIsCompositePart = handler->isCompositePart();
+    _handlerSkipsUnchangedValues = canSkipUnchangedValues(handler);
+    // The new handler might not have seen the applied value
+    _appliedValue = Value();
+    _forceApply = true;
+}
+
+bool ViewNodeAttribute::canSkipUnchangedValues(const AttributeHandler* handler) {
+    // Postprocessors resolve the value against the state of the ViewNode,
+    // which can change without the attribute value itself changing.
+    return !handler->alwaysApply() && !handler->hasPostprocessors();
 }
 
 } // namespace Valdi
@@ -22,10 +22,11 @@ class ILogger;
 class Animator;
 class AttributeHandler;
 class AttributeOwner;
+class ColorPaletteChanges;
 class CompositeAttribute;
 class ViewTransactionScope;
 
-class ViewNodeAttribute : public SimpleRefCountable {
+class ViewNodeAttribute : public NonAtomicRefCountable {
 public:
     explicit ViewNodeAttribute(const AttributeHandler* handler);
     ~ViewNodeAttribute() override;
@@ -42,6 +43,13 @@ public:
 
     void markDirty();
 
+    /**
+     Mark the attribute dirty if any of its values were resolved with one of the changed colors,
+     or failed to resolve. Unlike markDirty(), update() will not apply the attribute again if it
+     resolves to the value that was last applied. Returns whether the attribute was marked dirty.
+     */
+    bool markDirtyForColorChanges(const ColorPaletteChanges& changes);
+
     /**
      Prepare this attribute for an animation.
      */
@@ -130,6 +138,9 @@ private:
     // Set whenever animating an attribute for a ViewNode which doesn't have a view
     std::unique_ptr<Result<Value>> _pendingAnimatedValue;
 
+    // The preprocessed value that was last applied, used to skip applying unchanged values
+    Value _appliedValue;
+
     // Our dynamic storage, which can be either a single value or a collection of values
     std::aligned_union<0, AttributeValue, AttributeValueCollection*>::type _valuesUnion;
 
@@ -137,9 +148,12 @@ private:
     bool _handlerNeedsView = false;
     bool _handlerCanAffectLayout = false;
     bool _handlerIsCompositePart = false;
+    // Whether applying a value equal to the applied value can be skipped
+    bool _handlerSkipsUnchangedValues = false;
 
     bool _appliedValueDirty = false;
     bool _hasAppliedValue = false;
+    bool _forceApply = false;
     bool _hasSingleAttribute = false;
     bool _hasAttributeCollection = false;
 
@@ -171,5 +185,7 @@ private:
     }
 
     AttributeValue* getActiveAttributeValue();
+
+    static bool canSkipUnchangedValues(const AttributeHandler* handler);
 };
 } // namespace Valdi
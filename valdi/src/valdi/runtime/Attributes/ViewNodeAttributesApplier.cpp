@@ -19,6 +19,17 @@
 
 namespace Valdi {
 
+static constexpr size_t kMaxTrackedCompositeParts = 64;
+
+static inline uint64_t getCompositePartDirtyMask(size_t index) {
+    // Parts beyond what the mask can track are considered always dirty
+    return index < kMaxTrackedCompositeParts ? (static_cast<uint64_t>(1) << index) : 0;
+}
+
+static inline bool isCompositePartDirty(uint64_t dirtyParts, size_t index) {
+    return index >= kMaxTrackedCompositeParts || (dirtyParts & getCompositePartDirtyMask(index)) != 0;
+}
+
 ViewNodeAttributesApplier::ViewNodeAttributesApplier(ViewNode* viewNode) : _viewNode(viewNode) {}
 
 ViewNodeAttributesApplier::~ViewNodeAttributesApplier() = default;
@@ -97,10 +108,32 @@ void ViewNodeAttributesApplier::reapplyAttribute(ViewTransactionScope& viewTrans
 
     attribute->markDirty();
 
-    if (attribute->isCompositePart()) {
-        _dirtyCompositeAttributes[attribute->getCompositeAttribute()->getAttributeId()] = nullptr;
+    updateDirtyAttribute(viewTransactionScope, id, *attribute);
+}
+
+void ViewNodeAttributesApplier::reapplyAttributeForColorChanges(ViewTransactionScope& viewTransactionScope,
+                                                                AttributeId id,
+                                                                const ColorPaletteChanges& changes) {
+    const auto& it = _attributes.find(id);
+    if (it == _attributes.end()) {
+        return;
+    }
+    auto attribute = it->second;
+
+    if (attribute->markDirtyForColorChanges(changes)) {
+        updateDirtyAttribute(viewTransactionScope, id, *attribute);
+    }
+}
+
+void ViewNodeAttributesApplier::updateDirtyAttribute(ViewTransactionScope& viewTransactionScope,
+                                                     AttributeId id,
+                                                     ViewNodeAttribute& attribute) {
+    if (attribute.isCompositePart()) {
+        const auto* compositeAttribute = attribute.getCompositeAttribute();
+        markCompositeAttributePartDirty(id, *compositeAttribute);
+        _dirtyCompositeAttributes[compositeAttribute->getAttributeId()] = nullptr;
     } else {
-        updateAttribute(viewTransactionScope, id, *attribute, nullptr, /* justAddedView */ false);
+        updateAttribute(viewTransactionScope, id, attribute, nullptr, /* justAddedView */ false);
     }
 }
 
@@ -153,6 +186,7 @@ void ViewNodeAttributesApplier::updateAttributeWithoutUpdate(AttributeId id, con
 
     if (attribute->isCompositePart()) {
         const auto* compositeAttribute = attribute->getCompositeAttribute();
+        markCompositeAttributePartDirty(id, *compositeAttribute);
         if (_dirtyCompositeAttributes.find(compositeAttribute->getAttributeId()) == _dirtyCompositeAttributes.end()) {
             // If this attribute belongs to a composite attribute and that the composite attribute is not already
             // marked as dirtied, we directly update the composite value so that it is up to date with our change.
@@ -174,7 +208,7 @@ void ViewNodeAttributesApplier::processAttributeChange(ViewTransactionScope& vie
                                                        ViewNodeAttribute& attribute,
                                                        const Ref<Animator>& animator) {
     if (attribute.canAffectLayout()) {
-        _viewNode->invalidateMeasuredSize();
+        _viewNode->markMeasuredSizeDirty();
     }
 
     if (id == DefaultAttributeTranslationX) {
@@ -191,7 +225,9 @@ void ViewNodeAttributesApplier::processAttributeChange(ViewTransactionScope& vie
     }
 
     if (attribute.isCompositePart()) {
-        _dirtyCompositeAttributes[attribute.getCompositeAttribute()->getAttributeId()] = animator;
+        const auto* compositeAttribute = attribute.getCompositeAttribute();
+        markCompositeAttributePartDirty(id, *compositeAttribute);
+        _dirtyCompositeAttributes[compositeAttribute->getAttributeId()] = animator;
     } else {
         updateAttribute(viewTransactionScope, id, attribute, animator, /* justAddedView */ false);
     }
@@ -279,8 +315,37 @@ void ViewNodeAttributesApplier::updateCompositeAttribute(ViewTransactionScope& v
     SC_ASSERT(compositeAttribute != nullptr,
               "Composite attributes should have a compositeAttribute object associated with them");
 
-    auto value = ValueArray::make(compositeAttribute->getParts().size());
-    auto result = populateCompositeAttribute(*value, *compositeAttribute);
+    auto partsSize = compositeAttribute->getParts().size();
+    Ref<ValueArray> value;
+    Ref<ValueArray> previousValue;
+    uint64_t dirtyParts = 0;
+
+    {
+        auto& cacheEntry = _compositeAttributesCache[compositeId];
+        // The value last handed out might still be retained by the handlers or by the attribute
+        // itself, in which case it cannot be modified. The one before is usually released by then.
+        if (cacheEntry.spareValue != nullptr && cacheEntry.spareValue->retainCount() == 1 &&
+            cacheEntry.spareValue->size() == partsSize) {
+            value = std::move(cacheEntry.spareValue);
+        }
+        if (cacheEntry.value != nullptr && cacheEntry.value->size() == partsSize) {
+            previousValue = std::move(cacheEntry.value);
+            dirtyParts = cacheEntry.dirtyParts;
+        }
+    }
+
+    if (value == nullptr) {
+        value = ValueArray::make(partsSize);
+    }
+
+    auto result = populateCompositeAttribute(*value, *compositeAttribute, previousValue.get(), dirtyParts);
+
+    {
+        auto& cacheEntry = _compositeAttributesCache[compositeId];
+        cacheEntry.value = value;
+        cacheEntry.spareValue = std::move(previousValue);
+        cacheEntry.dirtyParts = 0;
+    }
 
     if (result.hasAValue) {
         if (result.isIncomplete) {
@@ -300,6 +365,14 @@ void ViewNodeAttributesApplier::updateCompositeAttribute(ViewTransactionScope& v
 
 CompositeAttributeResult ViewNodeAttributesApplier::populateCompositeAttribute(
     ValueArray& valueArray, const CompositeAttribute& compositeAttribute) {
+    return populateCompositeAttribute(valueArray, compositeAttribute, nullptr, 0);
+}
+
+CompositeAttributeResult ViewNodeAttributesApplier::populateCompositeAttribute(
+    ValueArray& valueArray,
+    const CompositeAttribute& compositeAttribute,
+    const ValueArray* previousValueArray,
+    uint64_t dirtyParts) {
     CompositeAttributeResult result = {false, false, false};
 
     size_t size = compositeAttribute.getParts().size();
@@ -317,6 +390,12 @@ CompositeAttributeResult ViewNodeAttributesApplier::populateCompositeAttribute(
             }
 
             // valueToInsert will be null
+        } else if (previousValueArray != nullptr && !isCompositePartDirty(dirtyParts, index) &&
+                   !hasPostprocessors(part.attributeId)) {
+            result.hasAValue = true;
+
+            // The part did not change since the previous value was composed
+            valueToInsert = (*previousValueArray)[index];
         } else {
             result.hasAValue = true;
 
@@ -344,6 +423,27 @@ CompositeAttributeResult ViewNodeAttributesApplier::populateCompositeAttribute(
     return result;
 }
 
+void ViewNodeAttributesApplier::markCompositeAttributePartDirty(AttributeId partId,
+                                                                const CompositeAttribute& compositeAttribute) {
+    auto it = _compositeAttributesCache.find(compositeAttribute.getAttributeId());
+    if (it == _compositeAttributesCache.end()) {
+        return;
+    }
+
+    const auto& parts = compositeAttribute.getParts();
+    for (size_t index = 0; index < parts.size(); index++) {
+        if (parts[index].attributeId == partId) {
+            it->second.dirtyParts |= getCompositePartDirtyMask(index);
+        }
+    }
+}
+
+bool ViewNodeAttributesApplier::hasPostprocessors(AttributeId id) const {
+    // Postprocessed values depend on the state of the ViewNode and are always evaluated again
+    const auto* attributeHandler = _boundAttributes->getAttributeHandlerForId(id);
+    return attributeHandler != nullptr && attributeHandler->hasPostprocessors();
+}
+
 const AttributeHandler* ViewNodeAttributesApplier::getAttributeHandler(AttributeId id) const {
     const auto* attributeHandler = _boundAttributes->getAttributeHandlerForId(id);
     if (VALDI_UNLIKELY(attributeHandler == nullptr)) {
@@ -433,6 +533,21 @@ Ref<ValueMap> ViewNodeAttributesApplier::dumpAttributes() const {
     return out;
 }
 
+size_t ViewNodeAttributesApplier::getAttributesCount() const {
+    size_t count = 0;
+    for ([[maybe_unused]] const auto& it : _attributes) {
+        count++;
+    }
+    return count;
+}
+
+size_t ViewNodeAttributesApplier::getEstimatedMemoryUsage() const {
+    auto attributeEntrySize = sizeof(std::pair<AttributeId, Ref<ViewNodeAttribute>>) + sizeof(ViewNodeAttribute);
+    return getAttributesCount() * attributeEntrySize +
+           _compositeAttributesCache.size() * sizeof(std::pair<AttributeId, CompositeAttributeCacheEntry>) +
+           _dirtyCompositeAttributes.size() * sizeof(std::pair<AttributeId, Ref<Animator>>);
+}
+
 ILogger& ViewNodeAttributesApplier::getLogger() const {
     return _viewNode->getLogger();
 }
@@ -452,6 +567,7 @@ const Ref<BoundAttributes>& ViewNodeAttributesApplier::getBoundAttributes() cons
 
 void ViewNodeAttributesApplier::updateAttributeHandlers() {
     std::vector<AttributeId> attributeIdsToRemove;
+    _compositeAttributesCache.clear();
 
     for (const auto& it : _attributes) {
         const auto* handler = getAttributeHandler(it.first);
@@ -480,6 +596,7 @@ void ViewNodeAttributesApplier::updateAttributeHandlers() {
 void ViewNodeAttributesApplier::destroy() {
     _viewNode = nullptr;
     _dirtyCompositeAttributes.clear();
+    _compositeAttributesCache.clear();
     _attributes.clear();
 }
 
@@ -13,6 +13,7 @@
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
 #include "valdi_core/cpp/Utils/ValueMap.hpp"
 
 namespace Valdi {
@@ -31,6 +32,19 @@ struct CompositeAttributeResult {
     bool isIncomplete;
 };
 
+/**
+ Holds the last values composed for a composite attribute of a ViewNode,
+ so that only the parts which changed since need to be processed again.
+ */
+struct CompositeAttributeCacheEntry {
+    // The last composed value
+    Ref<ValueArray> value;
+    // The value composed before, which is reused once nothing else retains it
+    Ref<ValueArray> spareValue;
+    // Bit mask of the parts which changed since value was composed
+    uint64_t dirtyParts = 0;
+};
+
 /**
  Attributes applier for a ViewNode
  */
@@ -53,6 +67,9 @@ public:
                                      const Ref<Animator>& animator) override;
 
     void reapplyAttribute(ViewTransactionScope& viewTransactionScope, AttributeId id) override;
+    void reapplyAttributeForColorChanges(ViewTransactionScope& viewTransactionScope,
+                                         AttributeId id,
+                                         const ColorPaletteChanges& changes) override;
 
     void flush(ViewTransactionScope& viewTransactionScope) override;
     bool needsFlush() const override;
@@ -72,6 +89,14 @@ public:
      */
     Ref<ValueMap> dumpAttributes() const;
 
+    size_t getAttributesCount() const;
+
+    /**
+     Returns an estimate of the memory used to store the attributes,
+     excluding the memory referenced by the attribute values.
+     */
+    size_t getEstimatedMemoryUsage() const;
+
     /**
      Copy all the attributes requiring a view and which can have an impact in the layout.
      */
@@ -99,6 +124,7 @@ private:
     // Attributes set on this applier.
     SafeReentrantContainer<FlatMap<AttributeId, Ref<ViewNodeAttribute>>> _attributes;
     FlatMap<AttributeId, Ref<Animator>> _dirtyCompositeAttributes;
+    FlatMap<AttributeId, CompositeAttributeCacheEntry> _compositeAttributesCache;
 
     bool _hasView = false;
 
@@ -114,6 +140,14 @@ private:
 
     CompositeAttributeResult populateCompositeAttribute(ValueArray& valueArray,
                                                         const CompositeAttribute& compositeAttribute);
+    CompositeAttributeResult populateCompositeAttribute(ValueArray& valueArray,
+                                                        const CompositeAttribute& compositeAttribute,
+                                                        const ValueArray* previousValueArray,
+                                                        uint64_t dirtyParts);
+
+    void markCompositeAttributePartDirty(AttributeId partId, const CompositeAttribute& compositeAttribute);
+    void updateDirtyAttribute(ViewTransactionScope& viewTransactionScope, AttributeId id, ViewNodeAttribute& attribute);
+    bool hasPostprocessors(AttributeId id) const;
 
     void updateAttributes(ViewTransactionScope& viewTransactionScope,
                           const Ref<Animator>& animator,
@@ -155,34 +155,37 @@ void CSSAttributesManager::updateCSS(const CSSAttributesManagerUpdateContext& co
     }
 }
 
-bool CSSAttributesManager::setCSSClass(const Value& cssClass, bool isOverridenFromParent) {
+CSSChange CSSAttributesManager::setCSSClass(const Value& cssClass, bool isOverridenFromParent) {
     return getCSSNodeContainer(isOverridenFromParent).node.setClass(cssClass.toStringBox());
 }
 
-bool CSSAttributesManager::setCSSDocument(const Value& cssDocument, bool isOverridenFromParent) {
+CSSChange CSSAttributesManager::setCSSDocument(const Value& cssDocument, bool isOverridenFromParent) {
     auto cssDocumentNative = castOrNull<CSSDocument>(cssDocument.getValdiObject());
 
     auto& nodeContainer = getCSSNodeContainer(isOverridenFromParent);
 
     if (cssDocumentNative == nodeContainer.cssDocument) {
-        return false;
+        return CSSChange::None;
     }
 
     nodeContainer.cssDocument = std::move(cssDocumentNative);
     if (nodeContainer.cssDocument != nullptr) {
         nodeContainer.node.setMonitoredCssAttributes(nodeContainer.cssDocument->getMonitoredAttributes());
+        nodeContainer.node.setDescendantDependencies(nodeContainer.cssDocument->getDescendantDependencies());
     } else {
         nodeContainer.node.setMonitoredCssAttributes(nullptr);
+        nodeContainer.node.setDescendantDependencies(nullptr);
     }
 
-    return true;
+    // Descendants resolve their ancestors by document, so they all need to be restyled
+    return CSSChange::SelfAndDescendants;
 }
 
-bool CSSAttributesManager::setElementTag(const StringBox& elementTag, bool isOverridenFromParent) {
+CSSChange CSSAttributesManager::setElementTag(const StringBox& elementTag, bool isOverridenFromParent) {
     return getCSSNodeContainer(isOverridenFromParent).node.setTagName(elementTag);
 }
 
-bool CSSAttributesManager::setElementId(const StringBox& elementId, bool isOverridenFromParent) {
+CSSChange CSSAttributesManager::setElementId(const StringBox& elementId, bool isOverridenFromParent) {
     return getCSSNodeContainer(isOverridenFromParent).node.setNodeId(elementId);
 }
 
@@ -219,19 +222,20 @@ void CSSAttributesManager::setParent(CSSAttributesManager* attributesManagerOfPa
     _attributesManagerOfParent = attributesManagerOfParent;
 }
 
-bool CSSAttributesManager::setSiblingsIndexes(int siblingsCount, int indexAmongSiblings) {
-    auto changed = false;
+CSSChange CSSAttributesManager::setSiblingsIndexes(int siblingsCount, int indexAmongSiblings) {
+    auto change = CSSChange::None;
 
     if (_cssNodeContainer != nullptr) {
-        changed |= _cssNodeContainer->node.setSiblingsCount(siblingsCount);
-        changed |= _cssNodeContainer->node.setIndexAmongSiblings(indexAmongSiblings);
+        change = mergeCSSChanges(change, _cssNodeContainer->node.setSiblingsCount(siblingsCount));
+        change = mergeCSSChanges(change, _cssNodeContainer->node.setIndexAmongSiblings(indexAmongSiblings));
     }
     if (_cssNodeContainerFromParentOveridde != nullptr) {
-        changed |= _cssNodeContainerFromParentOveridde->node.setSiblingsCount(siblingsCount);
-        changed |= _cssNodeContainerFromParentOveridde->node.setIndexAmongSiblings(indexAmongSiblings);
+        change = mergeCSSChanges(change, _cssNodeContainerFromParentOveridde->node.setSiblingsCount(siblingsCount));
+        change = mergeCSSChanges(change,
+                                 _cssNodeContainerFromParentOveridde->node.setIndexAmongSiblings(indexAmongSiblings));
     }
 
-    return changed;
+    return change;
 }
 
 StringBox CSSAttributesManager::getNodeId() const {
@@ -242,6 +246,14 @@ StringBox CSSAttributesManager::getNodeId() const {
     return StringBox();
 }
 
+StringBox CSSAttributesManager::getNodeIdOverridenFromParent() const {
+    if (_cssNodeContainerFromParentOveridde != nullptr) {
+        return _cssNodeContainerFromParentOveridde->node.getNodeId();
+    }
+
+    return StringBox();
+}
+
 Shared<CSSDocument> CSSAttributesManager::getCSSDocument() const {
     if (_cssNodeContainer != nullptr) {
         return _cssNodeContainer->cssDocument.toShared();
@@ -266,15 +278,15 @@ bool CSSAttributesManager::hasNodeId(const StringBox& nodeId) const {
     return false;
 }
 
-bool CSSAttributesManager::attributeChanged(AttributeId attribute) {
-    bool changed = false;
+CSSChange CSSAttributesManager::attributeChanged(AttributeId attribute) {
+    auto change = CSSChange::None;
     if (_cssNodeContainer != nullptr) {
-        changed |= _cssNodeContainer->node.attributeChanged(attribute);
+        change = mergeCSSChanges(change, _cssNodeContainer->node.attributeChanged(attribute));
     }
     if (_cssNodeContainerFromParentOveridde != nullptr) {
-        changed |= _cssNodeContainerFromParentOveridde->node.attributeChanged(attribute);
+        change = mergeCSSChanges(change, _cssNodeContainerFromParentOveridde->node.attributeChanged(attribute));
     }
-    return changed;
+    return change;
 }
 
 CSSNodeContainer& CSSAttributesManager::getCSSNodeContainer(bool isOverridenFromParent) {
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "valdi/runtime/CSS/CSSChange.hpp"
 #include "valdi/runtime/CSS/CSSNodeParentResolver.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
@@ -67,17 +68,24 @@ public:
 
     Shared<CSSDocument> getCSSDocument() const;
 
-    bool setCSSDocument(const Value& cssDocument, bool isOverridenFromParent);
-    bool setCSSClass(const Value& cssClass, bool isOverridenFromParent);
-    bool setElementId(const StringBox& elementId, bool isOverridenFromParent);
-    bool setElementTag(const StringBox& elementTag, bool isOverridenFromParent);
-    bool setSiblingsIndexes(int siblingsCount, int indexAmongSiblings);
+    /**
+     The setters below return which nodes need to be restyled as a result of the change:
+     none, only this node, or this node and all its descendants when the changed property
+     is referenced by a parent or ancestor selector of the CSS document.
+     */
+    CSSChange setCSSDocument(const Value& cssDocument, bool isOverridenFromParent);
+    CSSChange setCSSClass(const Value& cssClass, bool isOverridenFromParent);
+    CSSChange setElementId(const StringBox& elementId, bool isOverridenFromParent);
+    CSSChange setElementTag(const StringBox& elementTag, bool isOverridenFromParent);
+    CSSChange setSiblingsIndexes(int siblingsCount, int indexAmongSiblings);
 
-    bool attributeChanged(AttributeId attribute);
+    CSSChange attributeChanged(AttributeId attribute);
 
     StringBox getNodeId() const;
     bool hasNodeId(const StringBox& nodeId) const;
 
+    StringBox getNodeIdOverridenFromParent() const;
+
     bool needUpdateCSS() const;
 
     void setParent(CSSAttributesManager* attributesManagerOfParent);
@@ -0,0 +1,26 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+
+namespace Valdi {
+
+/**
+ Describes which nodes need to be restyled after a CSS relevant property of a node changed.
+ */
+enum class CSSChange : uint8_t {
+    // The matched rules cannot have changed.
+    None = 0,
+    // Only the rules matched by the node itself may have changed.
+    Self = 1,
+    // The node is referenced by parent or ancestor selectors, so the rules matched
+    // by its descendants may have changed as well.
+    SelfAndDescendants = 2,
+};
+
+constexpr CSSChange mergeCSSChanges(CSSChange left, CSSChange right) {
+    return left > right ? left : right;
+}
+
+} // namespace Valdi
@@ -14,7 +14,7 @@ namespace Valdi {
 
 CSSDocument::CSSDocument(const ResourceId& resourceId, const Valdi::StyleNode& styleNode, AttributeIds& attributeIds)
     : _resourceId(resourceId) {
-    populateStyleNode(attributeIds, styleNode, _rootNode);
+    populateStyleNode(attributeIds, styleNode, _rootNode, /* matchesAncestors */ false);
 }
 
 CSSDocument::~CSSDocument() = default;
@@ -23,6 +23,17 @@ const MonitoredCssAttributesPtr& CSSDocument::getMonitoredAttributes() const {
     return _monitoredCssAttributes;
 }
 
+const CSSDescendantDependenciesPtr& CSSDocument::getDescendantDependencies() const {
+    return _descendantDependencies;
+}
+
+CSSDescendantDependencies& CSSDocument::getOrCreateDescendantDependencies() {
+    if (_descendantDependencies == nullptr) {
+        _descendantDependencies = std::make_shared<CSSDescendantDependencies>();
+    }
+    return *_descendantDependencies;
+}
+
 Value valueFromNodeAttribute(const Valdi::NodeAttribute& attribute) {
     switch (attribute.type()) {
         case Valdi::NodeAttribute_Type_NODE_ATTRIBUTE_TYPE_DOUBLE:
@@ -52,7 +63,8 @@ void CSSDocument::populateStyleDeclaration(AttributeIds& attributeIds,
 
 void CSSDocument::populateStyleNode(AttributeIds& attributeIds,
                                     const Valdi::StyleNode& styleNode,
-                                    CSSStyleNode& currentNode) {
+                                    CSSStyleNode& currentNode,
+                                    bool matchesAncestors) {
     for (const auto& decl : styleNode.styles()) {
         auto& newStyle = currentNode.styles.emplace_back();
         populateStyleDeclaration(attributeIds, decl, newStyle);
@@ -60,26 +72,47 @@ void CSSDocument::populateStyleNode(AttributeIds& attributeIds,
 
     if (styleNode.has_ruleindex()) {
         currentNode.ruleIndex = std::make_unique<CSSProcessedRuleIndex>();
-        populateRuleIndex(attributeIds, styleNode.ruleindex(), *currentNode.ruleIndex);
+        populateRuleIndex(attributeIds, styleNode.ruleindex(), *currentNode.ruleIndex, matchesAncestors);
     }
 }
 
 void CSSDocument::populateMapRule(AttributeIds& attributeIds,
                                   const google::protobuf::RepeatedPtrField<::Valdi::NamedStyleNode>& mapRule,
-                                  FlatMap<StringBox, CSSStyleNode>& currentMap) {
+                                  FlatMap<StringBox, CSSStyleNode>& currentMap,
+                                  FlatSet<StringBox> CSSDescendantDependencies::*descendantDependenciesKeys,
+                                  bool matchesAncestors) {
     for (const auto& it : mapRule) {
         auto key = StringCache::getGlobal().makeString(it.name());
+        if (matchesAncestors) {
+            (getOrCreateDescendantDependencies().*descendantDependenciesKeys).emplace(key);
+        }
         auto outIt = currentMap.try_emplace(key);
-        populateStyleNode(attributeIds, it.node(), outIt.first->second);
+        populateStyleNode(attributeIds, it.node(), outIt.first->second, matchesAncestors);
     }
 }
 
 void CSSDocument::populateRuleIndex(AttributeIds& attributeIds,
                                     const Valdi::CSSRuleIndex& ruleIndex,
-                                    CSSProcessedRuleIndex& currentRuleIndex) {
-    populateMapRule(attributeIds, ruleIndex.id_rules(), currentRuleIndex.idRules);
-    populateMapRule(attributeIds, ruleIndex.class_rules(), currentRuleIndex.classRules);
-    populateMapRule(attributeIds, ruleIndex.tag_rules(), currentRuleIndex.tagRules);
+                                    CSSProcessedRuleIndex& currentRuleIndex,
+                                    bool matchesAncestors) {
+    // Everything nested under a parent or ancestor rule index is matched against the ancestors
+    // of the styled node, those are tracked so that restyling can be limited to the changed node
+    // when a change doesn't affect any of them.
+    populateMapRule(attributeIds,
+                    ruleIndex.id_rules(),
+                    currentRuleIndex.idRules,
+                    &CSSDescendantDependencies::ids,
+                    matchesAncestors);
+    populateMapRule(attributeIds,
+                    ruleIndex.class_rules(),
+                    currentRuleIndex.classRules,
+                    &CSSDescendantDependencies::classes,
+                    matchesAncestors);
+    populateMapRule(attributeIds,
+                    ruleIndex.tag_rules(),
+                    currentRuleIndex.tagRules,
+                    &CSSDescendantDependencies::tags,
+                    matchesAncestors);
 
     for (const auto& attributeRule : ruleIndex.attribute_rules()) {
         auto& newAttributeRule = currentRuleIndex.attributeRules.emplace_back();
@@ -93,35 +126,49 @@ void CSSDocument::populateRuleIndex(AttributeIds& attributeIds,
             _monitoredCssAttributes = Valdi::makeShared<FlatSet<AttributeId>>();
         }
         _monitoredCssAttributes->emplace(newAttributeRule.attribute.id);
+        if (matchesAncestors) {
+            getOrCreateDescendantDependencies().attributes.emplace(newAttributeRule.attribute.id);
+        }
+
+        populateStyleNode(attributeIds, attributeRule.node(), newAttributeRule.styleNode, matchesAncestors);
+    }
 
-        populateStyleNode(attributeIds, attributeRule.node(), newAttributeRule.styleNode);
+    if (matchesAncestors &&
+        (ruleIndex.has_first_child_rule() || ruleIndex.has_last_child_rule() || !ruleIndex.nth_child_rules().empty())) {
+        getOrCreateDescendantDependencies().hasPositionalRules = true;
     }
 
     if (ruleIndex.has_first_child_rule()) {
         currentRuleIndex.firstChildRule = std::make_unique<CSSStyleNode>();
-        populateStyleNode(attributeIds, ruleIndex.first_child_rule(), *currentRuleIndex.firstChildRule);
+        populateStyleNode(
+            attributeIds, ruleIndex.first_child_rule(), *currentRuleIndex.firstChildRule, matchesAncestors);
     }
 
     if (ruleIndex.has_last_child_rule()) {
         currentRuleIndex.lastChildRule = std::make_unique<CSSStyleNode>();
-        populateStyleNode(attributeIds, ruleIndex.last_child_rule(), *currentRuleIndex.lastChildRule);
+        populateStyleNode(
+            attributeIds, ruleIndex.last_child_rule(), *currentRuleIndex.lastChildRule, matchesAncestors);
     }
 
     for (const auto& nthChildRule : ruleIndex.nth_child_rules()) {
         auto& newRule = currentRuleIndex.nthChildRules.emplace_back();
         newRule.n = static_cast<int>(nthChildRule.n());
         newRule.offset = static_cast<int>(nthChildRule.offset());
-        populateStyleNode(attributeIds, nthChildRule.node(), newRule.node);
+        populateStyleNode(attributeIds, nthChildRule.node(), newRule.node, matchesAncestors);
     }
 
     if (ruleIndex.has_direct_parent_rules()) {
         currentRuleIndex.directParentRules = std::make_unique<CSSProcessedRuleIndex>();
-        populateRuleIndex(attributeIds, ruleIndex.direct_parent_rules(), *currentRuleIndex.directParentRules);
+        populateRuleIndex(attributeIds,
+                          ruleIndex.direct_parent_rules(),
+                          *currentRuleIndex.directParentRules,
+                          /* matchesAncestors */ true);
     }
 
     if (ruleIndex.has_ancestor_rules()) {
         currentRuleIndex.ancestorRules = std::make_unique<CSSProcessedRuleIndex>();
-        populateRuleIndex(attributeIds, ruleIndex.ancestor_rules(), *currentRuleIndex.ancestorRules);
+        populateRuleIndex(
+            attributeIds, ruleIndex.ancestor_rules(), *currentRuleIndex.ancestorRules, /* matchesAncestors */ true);
     }
 }
 
@@ -57,6 +57,21 @@ struct CSSProcessedRuleIndex {
 
 using MonitoredCssAttributesPtr = std::shared_ptr<FlatSet<AttributeId>>;
 
+/**
+ The properties of a node which are matched by parent or ancestor selectors of a document.
+ A change of any of these on a node can change the rules matched by its descendants,
+ any other change only affects the node itself.
+ */
+struct CSSDescendantDependencies {
+    FlatSet<StringBox> classes;
+    FlatSet<StringBox> ids;
+    FlatSet<StringBox> tags;
+    FlatSet<AttributeId> attributes;
+    bool hasPositionalRules = false;
+};
+
+using CSSDescendantDependenciesPtr = std::shared_ptr<CSSDescendantDependencies>;
+
 class CSSDocument : public ValdiObject {
 public:
     CSSDocument(const ResourceId& resourceId, const Valdi::StyleNode& styleNode, AttributeIds& attributeIds);
@@ -64,6 +79,11 @@ public:
 
     const CSSStyleNode& getRootNode() const;
     const MonitoredCssAttributesPtr& getMonitoredAttributes() const;
+    /**
+     Returns the dependencies of the parent and ancestor selectors of the document,
+     or null if the document has none.
+     */
+    const CSSDescendantDependenciesPtr& getDescendantDependencies() const;
 
     Result<Ref<CSSAttributes>> getAttributesForClass(const StringBox& className) const;
 
@@ -79,18 +99,27 @@ private:
     ResourceId _resourceId;
     CSSStyleNode _rootNode;
     MonitoredCssAttributesPtr _monitoredCssAttributes;
+    CSSDescendantDependenciesPtr _descendantDependencies;
 
-    void populateStyleNode(AttributeIds& attributeIds, const Valdi::StyleNode& styleNode, CSSStyleNode& currentNode);
+    void populateStyleNode(AttributeIds& attributeIds,
+                           const Valdi::StyleNode& styleNode,
+                           CSSStyleNode& currentNode,
+                           bool matchesAncestors);
     void populateRuleIndex(AttributeIds& attributeIds,
                            const Valdi::CSSRuleIndex& ruleIndex,
-                           CSSProcessedRuleIndex& currentRuleIndex);
+                           CSSProcessedRuleIndex& currentRuleIndex,
+                           bool matchesAncestors);
     static void populateStyleDeclaration(AttributeIds& attributeIds,
                                          const Valdi::StyleDeclaration& styleDeclaration,
                                          CSSStyleDeclaration& currentStyleDeclaration);
 
     void populateMapRule(AttributeIds& attributeIds,
                          const google::protobuf::RepeatedPtrField<::Valdi::NamedStyleNode>& mapRule,
-                         FlatMap<StringBox, CSSStyleNode>& currentMap);
+                         FlatMap<StringBox, CSSStyleNode>& currentMap,
+                         FlatSet<StringBox> CSSDescendantDependencies::*descendantDependenciesKeys,
+                         bool matchesAncestors);
+
+    CSSDescendantDependencies& getOrCreateDescendantDependencies();
 };
 
 } // namespace Valdi
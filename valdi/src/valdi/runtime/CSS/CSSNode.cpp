@@ -61,37 +61,81 @@ CSSNode::~CSSNode() {
     }
 }
 
-bool CSSNode::setClass(const StringBox& cssClass) {
+CSSChange CSSNode::setClass(const StringBox& cssClass) {
     if (_cssClass == cssClass) {
-        return false;
+        return CSSChange::None;
     }
 
     _cssClass = cssClass;
-    _resolvedCssClasses.clear();
 
-    forEachCSSClass(cssClass, [&](StringBox cssClass) { _resolvedCssClasses.emplace(std::move(cssClass)); });
+    FlatSet<StringBox> resolvedCssClasses;
+    forEachCSSClass(cssClass, [&](StringBox cssClass) { resolvedCssClasses.emplace(std::move(cssClass)); });
+    std::swap(_resolvedCssClasses, resolvedCssClasses);
+
+    if (_descendantDependencies == nullptr || _descendantDependencies->classes.empty()) {
+        return CSSChange::Self;
+    }
+
+    // Only classes which were added or removed can affect the descendants
+    const auto& dependencyClasses = _descendantDependencies->classes;
+    for (const auto& className : _resolvedCssClasses) {
+        if (resolvedCssClasses.find(className) == resolvedCssClasses.end() &&
+            dependencyClasses.find(className) != dependencyClasses.end()) {
+            return CSSChange::SelfAndDescendants;
+        }
+    }
+    for (const auto& className : resolvedCssClasses) {
+        if (_resolvedCssClasses.find(className) == _resolvedCssClasses.end() &&
+            dependencyClasses.find(className) != dependencyClasses.end()) {
+            return CSSChange::SelfAndDescendants;
+        }
+    }
 
-    return true;
+    return CSSChange::Self;
 }
 
-bool CSSNode::setNodeId(const StringBox& nodeId) {
+CSSChange CSSNode::resolveKeyChange(const FlatSet<StringBox> CSSDescendantDependencies::*descendantDependenciesKeys,
+                                    const StringBox& oldKey,
+                                    const StringBox& newKey) const {
+    if (_descendantDependencies == nullptr) {
+        return CSSChange::Self;
+    }
+
+    const auto& keys = (*_descendantDependencies).*descendantDependenciesKeys;
+    if (keys.find(oldKey) != keys.end() || keys.find(newKey) != keys.end()) {
+        return CSSChange::SelfAndDescendants;
+    }
+
+    return CSSChange::Self;
+}
+
+CSSChange CSSNode::resolvePositionChange() const {
+    if (_descendantDependencies != nullptr && _descendantDependencies->hasPositionalRules) {
+        return CSSChange::SelfAndDescendants;
+    }
+    return CSSChange::Self;
+}
+
+CSSChange CSSNode::setNodeId(const StringBox& nodeId) {
     if (_nodeId == nodeId) {
-        return false;
+        return CSSChange::None;
     }
+    auto change = resolveKeyChange(&CSSDescendantDependencies::ids, _nodeId, nodeId);
     _nodeId = nodeId;
-    return true;
+    return change;
 }
 
 const StringBox& CSSNode::getNodeId() const {
     return _nodeId;
 }
 
-bool CSSNode::setTagName(const StringBox& tagName) {
+CSSChange CSSNode::setTagName(const StringBox& tagName) {
     if (_tagName == tagName) {
-        return false;
+        return CSSChange::None;
     }
+    auto change = resolveKeyChange(&CSSDescendantDependencies::tags, _tagName, tagName);
     _tagName = tagName;
-    return true;
+    return change;
 }
 
 void CSSNode::setIsManagingRootOfChildTree(bool managingRootOfChildTree) {
@@ -102,6 +146,10 @@ void CSSNode::setMonitoredCssAttributes(MonitoredCssAttributesPtr monitoredCssAt
     _monitoredCssAttributes = std::move(monitoredCssAttributes);
 }
 
+void CSSNode::setDescendantDependencies(CSSDescendantDependenciesPtr descendantDependencies) {
+    _descendantDependencies = std::move(descendantDependencies);
+}
+
 const StringBox& CSSNode::getClass() const {
     return _cssClass;
 }
@@ -114,30 +162,39 @@ bool CSSNode::isMonitoredAttribute(AttributeId attribute) const {
     return _monitoredCssAttributes->find(attribute) != _monitoredCssAttributes->end();
 }
 
-bool CSSNode::attributeChanged(AttributeId attribute) {
-    return isMonitoredAttribute(attribute);
+CSSChange CSSNode::attributeChanged(AttributeId attribute) {
+    if (!isMonitoredAttribute(attribute)) {
+        return CSSChange::None;
+    }
+
+    if (_descendantDependencies != nullptr &&
+        _descendantDependencies->attributes.find(attribute) != _descendantDependencies->attributes.end()) {
+        return CSSChange::SelfAndDescendants;
+    }
+
+    return CSSChange::Self;
 }
 
 int CSSNode::getIndexAmongSiblings() const {
     return _indexAmongSiblings;
 }
 
-bool CSSNode::setIndexAmongSiblings(int index) {
+CSSChange CSSNode::setIndexAmongSiblings(int index) {
     if (index == _indexAmongSiblings) {
-        return false;
+        return CSSChange::None;
     }
 
     _indexAmongSiblings = index;
-    return true;
+    return resolvePositionChange();
 }
 
-bool CSSNode::setSiblingsCount(int count) {
+CSSChange CSSNode::setSiblingsCount(int count) {
     if (count == _siblingsCount) {
-        return false;
+        return CSSChange::None;
     }
 
     _siblingsCount = count;
-    return true;
+    return resolvePositionChange();
 }
 
 inline bool shouldReplaceDeclaration(const CSSStyleDeclaration& existing, const CSSStyleDeclaration& newDeclaration) {
@@ -305,6 +362,13 @@ void CSSNode::applyCss(ViewTransactionScope& viewTransactionScope,
 
     insertDeclarations(cssDocument, cssDocument.getRootNode(), attributesApplier, *bestStyleDeclarationByKey);
 
+    if (_lastStyleDeclarations != nullptr && *_lastStyleDeclarations == *bestStyleDeclarationByKey) {
+        // The node matched the exact same declarations as the last time, the attributes
+        // already hold those values.
+        CSSNode::releaseStyleDeclarationMap(std::move(bestStyleDeclarationByKey));
+        return;
+    }
+
     if (_lastStyleDeclarations != nullptr) {
         for (const auto& it : *_lastStyleDeclarations) {
             if (bestStyleDeclarationByKey->find(it.first) == bestStyleDeclarationByKey->end()) {
@@ -14,6 +14,7 @@
 #include "valdi/runtime/Attributes/Animator.hpp"
 #include "valdi/runtime/Attributes/AttributeIds.hpp"
 #include "valdi/runtime/Attributes/AttributeOwner.hpp"
+#include "valdi/runtime/CSS/CSSChange.hpp"
 #include "valdi/runtime/CSS/CSSDocument.hpp"
 #include "valdi/runtime/CSS/CSSNodeParentResolver.hpp"
 #include "valdi/valdi.pb.h"
@@ -33,7 +34,7 @@ public:
     CSSNode(const CSSNode&) = delete;
     ~CSSNode() override;
 
-    bool setClass(const StringBox& cssClass);
+    CSSChange setClass(const StringBox& cssClass);
     const StringBox& getClass() const;
 
     void applyCss(ViewTransactionScope& viewTransactionScope,
@@ -44,18 +45,19 @@ public:
     void setParentResolver(CSSNodeParentResolver* parentResolver);
 
     int getIndexAmongSiblings() const;
-    bool setIndexAmongSiblings(int index);
+    CSSChange setIndexAmongSiblings(int index);
 
-    bool setSiblingsCount(int count);
+    CSSChange setSiblingsCount(int count);
 
-    bool attributeChanged(AttributeId attribute);
+    CSSChange attributeChanged(AttributeId attribute);
 
-    bool setTagName(const StringBox& tagName);
+    CSSChange setTagName(const StringBox& tagName);
 
-    bool setNodeId(const StringBox& nodeId);
+    CSSChange setNodeId(const StringBox& nodeId);
     const StringBox& getNodeId() const;
 
     void setMonitoredCssAttributes(MonitoredCssAttributesPtr monitoredCssAttributes);
+    void setDescendantDependencies(CSSDescendantDependenciesPtr descendantDependencies);
 
     const StringBox& getTagName() const;
 
@@ -69,6 +71,7 @@ private:
     StringBox _nodeId;
     CSSNodeParentResolver* _parentResolver = nullptr;
     MonitoredCssAttributesPtr _monitoredCssAttributes;
+    CSSDescendantDependenciesPtr _descendantDependencies;
 
     FlatSet<StringBox> _resolvedCssClasses;
     StringBox _cssClass;
@@ -95,6 +98,10 @@ private:
                                      const SharedAnimator& animator);
 
     bool isMonitoredAttribute(AttributeId attribute) const;
+    CSSChange resolveKeyChange(const FlatSet<StringBox> CSSDescendantDependencies::*descendantDependenciesKeys,
+                               const StringBox& oldKey,
+                               const StringBox& newKey) const;
+    CSSChange resolvePositionChange() const;
 
     CSSNode* resolveParent(const CSSDocument& cssDocument) const;
 
@@ -15,7 +15,9 @@
 #include "valdi/runtime/Rendering/RenderRequest.hpp"
 #include "valdi/runtime/Runtime.hpp"
 #include "valdi/runtime/Utils/AsyncGroup.hpp"
+#include "valdi_core/cpp/Threading/PooledDispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/ContainerUtils.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/ValueFunction.hpp"
 #include <algorithm>
@@ -96,6 +98,7 @@ void Context::onDestroy() {
     Ref<ContextHandler> handler;
     std::vector<Ref<ValueFunction>> updateCompletedCallbacks;
     std::deque<PendingRenderRequest> pendingRenderRequests;
+    Ref<DispatchQueue> renderQueue;
     Ref<Metrics> metrics;
     auto notifySync = false;
 
@@ -116,6 +119,7 @@ void Context::onDestroy() {
         updateCompletedCallbacks = std::move(_updateCompletedCallbacks);
         // NOTE(rjaber): The pending render request can contain a disposable, which will request access to the lock
         pendingRenderRequests = std::move(_pendingRenderRequests);
+        renderQueue = std::move(_renderQueue);
         notifySync = _updateHandlerSynchronously;
     }
 
@@ -138,6 +142,8 @@ void Context::onRendered() {
     }
     _didPerformInitialRender = true;
 
+    StartupTimeline::shared().markMilestone(StartupMilestone::FirstRender);
+
     auto initialRenderLatency = _creationWatch.elapsed();
     Ref<Metrics> metrics = _runtime != nullptr ? _runtime->getMetrics() : nullptr;
     if (metrics != nullptr) {
@@ -302,6 +308,15 @@ bool Context::hasPendingRenderRequests() const {
     return !_pendingRenderRequests.empty();
 }
 
+Ref<DispatchQueue> Context::getOrCreateRenderQueue() {
+    std::lock_guard<Mutex> guard(_mutex);
+    if (_renderQueue == nullptr && !_destroyed) {
+        _renderQueue = makeShared<PooledDispatchQueue>(
+            STRING_LITERAL("Valdi Render"), ThreadPool::getShared(), /* maxConcurrentTasks */ 1);
+    }
+    return _renderQueue;
+}
+
 void Context::markUpdateCompleted(ContextUpdateId updateId) {
     std::unique_lock<Mutex> guard(_mutex);
     markUpdateCompleted(updateId, guard);
@@ -14,6 +14,7 @@
 #include "valdi/runtime/Utils/BridgeLogger.hpp"
 #include "valdi/runtime/Utils/DisposableGroup.hpp"
 #include "valdi_core/cpp/Context/ComponentPath.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Threading/TaskQueue.hpp"
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/ValdiObject.hpp"
@@ -117,6 +118,14 @@ public:
     bool flushRenderRequests();
     bool hasPendingRenderRequests() const;
 
+    /**
+     Returns the serial queue on which the render requests of this Context are processed
+     when parallel rendering is enabled, creating it if needed. The queue runs on the
+     shared ThreadPool, so that the render requests of different Contexts can be processed
+     concurrently while the ones of a given Context keep their order.
+     */
+    Ref<DispatchQueue> getOrCreateRenderQueue();
+
     void waitUntilAllUpdatesCompleted(const Ref<ValueFunction>& callback);
     void waitUntilAllUpdatesCompletedSync(bool shouldFlushRenderRequests);
 
@@ -171,6 +180,7 @@ private:
     std::vector<Ref<ValueFunction>> _updateCompletedCallbacks;
     Ref<Context> _parentContext;
     std::deque<PendingRenderRequest> _pendingRenderRequests;
+    Ref<DispatchQueue> _renderQueue;
 
     bool _created = false;
     bool _destroyed = false;
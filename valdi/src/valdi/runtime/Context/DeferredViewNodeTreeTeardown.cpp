@@ -0,0 +1,94 @@
+//
+//  DeferredViewNodeTreeTeardown.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/runtime/Context/DeferredViewNodeTreeTeardown.hpp"
+#include "valdi/runtime/Context/ViewNode.hpp"
+#include "valdi/runtime/Context/ViewNodeTree.hpp"
+#include "valdi/runtime/Utils/MainThreadManager.hpp"
+#include "valdi_core/cpp/Utils/ValueFunctionWithCallable.hpp"
+
+namespace Valdi {
+
+static void appendViewNodesInPostOrder(ViewNode* viewNode, std::vector<Ref<ViewNode>>& viewNodes) {
+    for (auto* child : *viewNode) {
+        appendViewNodesInPostOrder(child, viewNodes);
+    }
+
+    viewNodes.emplace_back(strongSmallRef(viewNode));
+}
+
+DeferredViewNodeTreeTeardown::DeferredViewNodeTreeTeardown(const Ref<ViewNodeTree>& viewNodeTree,
+                                                           MainThreadManager& mainThreadManager)
+    : _viewNodeTree(viewNodeTree), _mainThreadManager(mainThreadManager) {}
+
+DeferredViewNodeTreeTeardown::~DeferredViewNodeTreeTeardown() = default;
+
+void DeferredViewNodeTreeTeardown::start() {
+    const auto& rootViewNode = _viewNodeTree->getRootViewNode();
+    if (rootViewNode != nullptr) {
+        auto& viewTransactionScope = _viewNodeTree->getCurrentViewTransactionScope();
+        // Removing the root view removes the views of the children from it
+        if (!rootViewNode->removeView(viewTransactionScope)) {
+            for (auto i = rootViewNode->getChildCount(); i > 0; i--) {
+                rootViewNode->getChildAt(i - 1)->removeViewFromParent(viewTransactionScope);
+            }
+        }
+
+        appendViewNodesInPostOrder(rootViewNode.get(), _viewNodes);
+    }
+
+    scheduleNextChunk();
+}
+
+bool DeferredViewNodeTreeTeardown::processUntil(std::chrono::steady_clock::time_point deadline) {
+    auto& viewTransactionScope = _viewNodeTree->getCurrentViewTransactionScope();
+
+    while (_nextViewNodeIndex < _viewNodes.size()) {
+        auto viewNode = std::move(_viewNodes[_nextViewNodeIndex++]);
+        // The children were released before their parent, so this only clears the ViewNode itself
+        if (_viewNodeTree->removeViewNode(viewNode->getRawId()) == nullptr) {
+            viewNode->removeFromParent(viewTransactionScope);
+        }
+        viewNode = nullptr;
+
+        if (_nextViewNodeIndex % kViewNodesPerDeadlineCheck == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    if (_nextViewNodeIndex < _viewNodes.size()) {
+        return false;
+    }
+
+    _viewNodes.clear();
+    _nextViewNodeIndex = 0;
+    _viewNodeTree->clear();
+
+    return true;
+}
+
+size_t DeferredViewNodeTreeTeardown::getRemainingViewNodesCount() const {
+    return _viewNodes.size() - _nextViewNodeIndex;
+}
+
+void DeferredViewNodeTreeTeardown::scheduleNextChunk() {
+    _mainThreadManager.onIdle(makeShared<ValueFunctionWithCallable>(
+        [self = strongSmallRef(this)](const ValueFunctionCallContext& /*callContext*/) -> Value {
+            self->processNextChunk();
+            return Value::undefined();
+        }));
+}
+
+void DeferredViewNodeTreeTeardown::processNextChunk() {
+    _viewNodeTree->scheduleExclusiveUpdate([self = strongSmallRef(this)]() {
+        if (!self->processUntil(std::chrono::steady_clock::now() + kChunkBudget)) {
+            self->scheduleNextChunk();
+        }
+    });
+}
+
+} // namespace Valdi
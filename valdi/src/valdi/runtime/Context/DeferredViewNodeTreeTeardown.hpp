@@ -0,0 +1,61 @@
+//
+//  DeferredViewNodeTreeTeardown.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace Valdi {
+
+class MainThreadManager;
+class ViewNode;
+class ViewNodeTree;
+
+/**
+ Tears down a ViewNodeTree in time-sliced chunks. The views of the tree are detached from
+ the platform hierarchy when the teardown starts, and the ViewNodes, with their Yoga nodes,
+ attribute appliers and cached state, are then cleared and released in post order from idle
+ callbacks of the main thread, spending at most kChunkBudget per chunk.
+ */
+class DeferredViewNodeTreeTeardown : public SimpleRefCountable {
+public:
+    DeferredViewNodeTreeTeardown(const Ref<ViewNodeTree>& viewNodeTree, MainThreadManager& mainThreadManager);
+    ~DeferredViewNodeTreeTeardown() override;
+
+    /**
+     Detach the views of the tree and schedule the release of its ViewNodes.
+     Must be called within an exclusive update of the tree.
+     */
+    void start();
+
+    /**
+     Clear and release ViewNodes until the given deadline is reached.
+     Returns whether all the ViewNodes were released.
+     Must be called within an exclusive update of the tree.
+     */
+    bool processUntil(std::chrono::steady_clock::time_point deadline);
+
+    size_t getRemainingViewNodesCount() const;
+
+    static constexpr std::chrono::microseconds kChunkBudget = std::chrono::microseconds(4000);
+    // How many ViewNodes are released between checks of the deadline
+    static constexpr size_t kViewNodesPerDeadlineCheck = 16;
+
+private:
+    Ref<ViewNodeTree> _viewNodeTree;
+    MainThreadManager& _mainThreadManager;
+    std::vector<Ref<ViewNode>> _viewNodes;
+    size_t _nextViewNodeIndex = 0;
+
+    void scheduleNextChunk();
+    void processNextChunk();
+};
+
+} // namespace Valdi
@@ -0,0 +1,172 @@
+//
+//  ScrollLinkedEffects.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/runtime/Context/ScrollLinkedEffects.hpp"
+#include "valdi/runtime/Attributes/AttributeIds.hpp"
+#include "valdi/runtime/Context/ViewNode.hpp"
+#include "valdi/runtime/Context/ViewNodeTree.hpp"
+#include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Valdi {
+
+class ScrollLinkedEffectsAttributeOwner : public AttributeOwner {
+public:
+    int getAttributePriority(AttributeId /*id*/) const override {
+        return kAttributeOwnerPriorityParentOverriden;
+    }
+
+    StringBox getAttributeSource(AttributeId /*id*/) const override {
+        static auto kSource = STRING_LITERAL("scrollLinkedEffect");
+
+        return kSource;
+    }
+};
+
+static Result<std::pair<double, double>> parseRange(const Value& effectValue, std::string_view key) {
+    const auto* array = effectValue.getMapValue(key).getArray();
+    if (array == nullptr || array->size() != 2 || !(*array)[0].isNumber() || !(*array)[1].isNumber()) {
+        return Error(STRING_FORMAT("Expected '{}' to be an array of 2 numbers", key));
+    }
+
+    auto start = (*array)[0].toDouble();
+    auto end = (*array)[1].toDouble();
+    if (std::isnan(start) || std::isnan(end)) {
+        return Error(STRING_FORMAT("'{}' cannot contain NaN values", key));
+    }
+
+    return std::make_pair(start, end);
+}
+
+ScrollLinkedEffects::ScrollLinkedEffects() = default;
+ScrollLinkedEffects::~ScrollLinkedEffects() = default;
+
+Result<Ref<ScrollLinkedEffects>> ScrollLinkedEffects::parse(const Value& value, AttributeIds& attributeIds) {
+    const auto* effectValues = value.getArray();
+    if (effectValues == nullptr) {
+        return Error("Expected an array of scroll linked effects");
+    }
+
+    auto effects = makeShared<ScrollLinkedEffects>();
+    effects->_effects.reserve(effectValues->size());
+
+    for (const auto& effectValue : *effectValues) {
+        if (effectValue.getMap() == nullptr) {
+            return Error("Expected scroll linked effect to be a map");
+        }
+
+        auto target = effectValue.getMapValue("target");
+        auto attribute = effectValue.getMapValue("attribute");
+        if (!target.isNumber() || !attribute.isString()) {
+            return Error("Scroll linked effect requires a numeric 'target' and a string 'attribute'");
+        }
+
+        auto inputRange = parseRange(effectValue, "inputRange");
+        if (!inputRange) {
+            return inputRange.moveError();
+        }
+        auto outputRange = parseRange(effectValue, "outputRange");
+        if (!outputRange) {
+            return outputRange.moveError();
+        }
+
+        auto& effect = effects->_effects.emplace_back();
+        effect.target = static_cast<RawViewNodeId>(target.toInt());
+        effect.attribute = attributeIds.getIdForName(attribute.toStringBox());
+        effect.horizontal = effectValue.getMapValue("horizontal").toBool();
+        effect.inputStart = inputRange.value().first;
+        effect.inputEnd = inputRange.value().second;
+        effect.outputStart = outputRange.value().first;
+        effect.outputEnd = outputRange.value().second;
+        effect.onThreshold = effectValue.getMapValue("onThreshold").getFunctionRef();
+
+        const auto* thresholds = effectValue.getMapValue("thresholds").getArray();
+        if (thresholds != nullptr) {
+            effect.thresholds.reserve(thresholds->size());
+            for (const auto& threshold : *thresholds) {
+                effect.thresholds.emplace_back(threshold.toDouble());
+            }
+            std::sort(effect.thresholds.begin(), effect.thresholds.end());
+        }
+    }
+
+    return effects;
+}
+
+double ScrollLinkedEffects::resolveOutput(const Effect& effect, double contentOffset) {
+    auto inputLength = effect.inputEnd - effect.inputStart;
+    double ratio;
+    if (inputLength == 0) {
+        ratio = contentOffset < effect.inputStart ? 0.0 : 1.0;
+    } else {
+        ratio = std::clamp((contentOffset - effect.inputStart) / inputLength, 0.0, 1.0);
+    }
+
+    return effect.outputStart + (effect.outputEnd - effect.outputStart) * ratio;
+}
+
+size_t ScrollLinkedEffects::resolveThresholdRegion(const Effect& effect, double contentOffset) {
+    return static_cast<size_t>(std::upper_bound(effect.thresholds.begin(), effect.thresholds.end(), contentOffset) -
+                               effect.thresholds.begin());
+}
+
+void ScrollLinkedEffects::apply(ViewTransactionScope& viewTransactionScope,
+                                ViewNodeTree& viewNodeTree,
+                                const Point& directionAgnosticContentOffset) {
+    for (auto& effect : _effects) {
+        auto contentOffset = static_cast<double>(effect.horizontal ? directionAgnosticContentOffset.x :
+                                                                     directionAgnosticContentOffset.y);
+
+        auto output = resolveOutput(effect, contentOffset);
+        if (!effect.hasAppliedValue || effect.appliedValue != output) {
+            auto target = viewNodeTree.getViewNode(effect.target);
+            if (target != nullptr) {
+                target->setAttribute(viewTransactionScope, effect.attribute, getAttributeOwner(), Value(output), nullptr);
+                effect.hasAppliedValue = true;
+                effect.appliedValue = output;
+            }
+        }
+
+        auto thresholdRegion = resolveThresholdRegion(effect, contentOffset);
+        if (thresholdRegion != effect.thresholdRegion) {
+            effect.thresholdRegion = thresholdRegion;
+            if (effect.onThreshold != nullptr) {
+                (*effect.onThreshold)(ValueFunctionFlagsNone,
+                                      {Value(static_cast<int32_t>(thresholdRegion)), Value(contentOffset)});
+            }
+        }
+    }
+}
+
+void ScrollLinkedEffects::remove(ViewTransactionScope& viewTransactionScope, ViewNodeTree& viewNodeTree) {
+    for (auto& effect : _effects) {
+        if (!effect.hasAppliedValue) {
+            continue;
+        }
+        effect.hasAppliedValue = false;
+
+        auto target = viewNodeTree.getViewNode(effect.target);
+        if (target != nullptr) {
+            target->getAttributesApplier().removeAllAttributesForOwner(
+                viewTransactionScope, getAttributeOwner(), nullptr);
+        }
+    }
+}
+
+size_t ScrollLinkedEffects::size() const {
+    return _effects.size();
+}
+
+AttributeOwner* ScrollLinkedEffects::getAttributeOwner() {
+    static auto* kOwner = new ScrollLinkedEffectsAttributeOwner();
+    return kOwner;
+}
+
+} // namespace Valdi
@@ -0,0 +1,83 @@
+//
+//  ScrollLinkedEffects.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi/runtime/Attributes/AttributeOwner.hpp"
+#include "valdi/runtime/Context/RawViewNodeId.hpp"
+#include "valdi/runtime/Views/Frame.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+#include "valdi_core/cpp/Utils/ValueFunction.hpp"
+
+#include <vector>
+
+namespace Valdi {
+
+class ViewNodeTree;
+class ViewTransactionScope;
+
+/**
+ Drives numeric attributes of ViewNodes from the content offset of a scroll ViewNode,
+ without round-tripping through JS on every scroll event. Each effect linearly maps
+ a range of the content offset to a range of attribute values, clamping outside of it.
+ JS is only notified when the content offset crosses one of the thresholds of an effect.
+ The applied values take precedence over the values rendered from JS for the same attributes.
+
+ The attribute value is an array of maps with the following keys:
+   - target: the id of the ViewNode to update
+   - attribute: the name of the numeric attribute to update (ex: "opacity", "translationY")
+   - inputRange: [start, end] content offset range
+   - outputRange: [start, end] attribute value range
+   - horizontal: whether the horizontal content offset should be used, false by default
+   - thresholds: optional sorted content offsets to report to onThreshold
+   - onThreshold: optional callback called with the index of the threshold region the content
+     offset is in, and the content offset, whenever that region changes.
+ */
+class ScrollLinkedEffects : public SimpleRefCountable {
+public:
+    ScrollLinkedEffects();
+    ~ScrollLinkedEffects() override;
+
+    static Result<Ref<ScrollLinkedEffects>> parse(const Value& value, AttributeIds& attributeIds);
+
+    void apply(ViewTransactionScope& viewTransactionScope,
+               ViewNodeTree& viewNodeTree,
+               const Point& directionAgnosticContentOffset);
+    void remove(ViewTransactionScope& viewTransactionScope, ViewNodeTree& viewNodeTree);
+
+    size_t size() const;
+
+    /**
+     Returns the AttributeOwner singleton used for the attribute values applied by scroll linked effects.
+     */
+    static AttributeOwner* getAttributeOwner();
+
+private:
+    struct Effect {
+        RawViewNodeId target = 0;
+        AttributeId attribute = 0;
+        bool horizontal = false;
+        double inputStart = 0;
+        double inputEnd = 0;
+        double outputStart = 0;
+        double outputEnd = 0;
+        std::vector<double> thresholds;
+        Ref<ValueFunction> onThreshold;
+
+        bool hasAppliedValue = false;
+        double appliedValue = 0;
+        size_t thresholdRegion = 0;
+    };
+
+    std::vector<Effect> _effects;
+
+    static double resolveOutput(const Effect& effect, double contentOffset);
+    static size_t resolveThresholdRegion(const Effect& effect, double contentOffset);
+};
+
+} // namespace Valdi
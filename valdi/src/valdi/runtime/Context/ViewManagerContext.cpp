@@ -9,6 +9,7 @@
 #include "valdi/runtime/Attributes/DefaultAttributeProcessors.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
 #include "valdi/runtime/Views/GlobalViewFactories.hpp"
+#include "valdi/runtime/Views/ViewPoolUsageStats.hpp"
 #include "valdi/runtime/Views/ViewPreloader.hpp"
 
 namespace Valdi {
@@ -22,6 +23,7 @@ ViewManagerContext::ViewManagerContext(IViewManager& viewManager,
                                        ILogger& logger)
     : _viewManager(viewManager),
       _attributesManager(viewManager, attributeIds, colorPalette, logger, yogaConfig),
+      _viewPoolUsageStats(Valdi::makeShared<ViewPoolUsageStats>()),
       _mainThreadManager(mainThreadManager) {
     Valdi::registerDefaultProcessors(_attributesManager);
 
@@ -56,6 +58,20 @@ void ViewManagerContext::preloadViews(const StringBox& className, size_t count)
     }
 }
 
+void ViewManagerContext::recordViewUsage(const StringBox& screenName, const ViewNodeViewStats& viewStats) {
+    _viewPoolUsageStats->recordUsage(screenName, viewStats);
+}
+
+void ViewManagerContext::preloadViewsForScreen(const StringBox& screenName) {
+    if (_viewPreloader == nullptr) {
+        return;
+    }
+
+    for (const auto& it : _viewPoolUsageStats->getPeakUsage(screenName)) {
+        _viewPreloader->startPreload(it.first, it.second);
+    }
+}
+
 void ViewManagerContext::setPreloadingPaused(bool preloadingPaused) {
     if (_viewPreloader != nullptr) {
         if (preloadingPaused) {
@@ -91,4 +107,8 @@ ViewPoolsStats ViewManagerContext::getViewPoolsStats() const {
     return stats;
 }
 
+const Ref<ViewPoolUsageStats>& ViewManagerContext::getViewPoolUsageStats() const {
+    return _viewPoolUsageStats;
+}
+
 } // namespace Valdi
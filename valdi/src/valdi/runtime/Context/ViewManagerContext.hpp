@@ -21,6 +21,8 @@ class DispatchQueue;
 class ViewPreloader;
 class MainThreadManager;
 class ColorPalette;
+class ViewNodeViewStats;
+class ViewPoolUsageStats;
 
 using ViewPoolsStats = FlatMap<StringBox, size_t>;
 
@@ -65,18 +67,32 @@ public:
     void preloadViews(const StringBox& className, size_t count);
     void setPreloadingPaused(bool preloadingPaused);
 
+    /**
+     Record the views that a screen had inflated, so that they can be preloaded
+     the next time the screen is opened.
+     */
+    void recordViewUsage(const StringBox& screenName, const ViewNodeViewStats& viewStats);
+
+    /**
+     Preload the views that the given screen needed at its peak the previous times it was
+     opened, minus the views already available in the pools.
+     */
+    void preloadViewsForScreen(const StringBox& screenName);
+
     void setPreloadingWorkQueue(const Ref<DispatchQueue>& preloadingWorkQueue);
 
     void setAccessibilityEnabled(const bool accessibilityEnabled);
     bool getAccessibilityEnabled() const;
 
     ViewPoolsStats getViewPoolsStats() const;
+    const Ref<ViewPoolUsageStats>& getViewPoolUsageStats() const;
 
 private:
     IViewManager& _viewManager;
     AttributesManager _attributesManager;
     Ref<GlobalViewFactories> _globalViewFactories;
     Ref<ViewPreloader> _viewPreloader;
+    Ref<ViewPoolUsageStats> _viewPoolUsageStats;
     Ref<MainThreadManager> _mainThreadManager;
     bool _accessibilityEnabled;
 };
@@ -10,6 +10,7 @@
 #include "valdi/runtime/Attributes/Yoga/Yoga.hpp"
 #include "valdi/runtime/CSS/CSSAttributesManager.hpp"
 #include "valdi/runtime/Context/IViewNodeAssetHandler.hpp"
+#include "valdi/runtime/Context/ScrollLinkedEffects.hpp"
 #include "valdi/runtime/Context/ViewManagerContext.hpp"
 #include "valdi/runtime/Context/ViewNodeAccessibilityState.hpp"
 #include "valdi/runtime/Context/ViewNodeChildrenIndexer.hpp"
@@ -24,8 +25,11 @@
 #include "valdi/runtime/Views/MeasureDelegate.hpp"
 #include "valdi/runtime/Views/ViewTransactionScope.hpp"
 #include "valdi_core/cpp/Constants.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/ObjectPool.hpp"
+#include "valdi_core/cpp/Utils/PerfCounters.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 #include "valdi_core/cpp/Utils/ValueArrayBuilder.hpp"
@@ -61,6 +65,7 @@ void setupYogaNode(YGNode* yogaNode, ViewNode* viewNode) {
     Yoga::attachViewNode(yogaNode, viewNode);
     yogaNode->setDirty(true);
     yogaNode->setDirtiedFunc(ygDirtiedCallback);
+    yogaNode->setRelayoutBoundaryEnabled(true);
 }
 
 static auto getBackend(ViewNodeTree* tree) {
@@ -101,6 +106,11 @@ void LazyLayoutData::destroyNode() {
     }
 }
 
+// Maximum number of nodes visited when prelaying out a lazy layout which is about to become visible
+constexpr size_t kMaxPrelayoutNodesCount = 256;
+// Maximum time in milliseconds spent prelaying out upcoming children in a single visibility update
+constexpr double kUpcomingChildrenPrelayoutBudgetMs = 4.0;
+
 const SharedAnimator& nullAnimator() {
     static SharedAnimator nullAnimator;
     return nullAnimator;
@@ -124,6 +134,7 @@ constexpr size_t kLimitToViewportDisabledFlag = 14;
 constexpr size_t kHasChildWithZIndex = 15;
 constexpr size_t kAnimationsEnabled = 16;
 constexpr size_t kHasParent = 17;
+constexpr size_t kCSSDescendantsNeedUpdate = 18;
 constexpr size_t kShouldReceiveVisibilityUpdates = 19;
 constexpr size_t kCSSNeedsUpdate = 20;
 constexpr size_t kCSSHasChildNeedsUpdate = 21;
@@ -149,6 +160,8 @@ ViewNode::ViewNode(YGConfig* yogaConfig, AttributeIds& attributeIds, ILogger& lo
     _flags[kViewTreeNeedsUpdateFlag] = true;
     _flags[kAnimationsEnabled] = true;
     _flags[kAccessibilityTreeNeedsUpdate] = true;
+
+    PerfCounters::increment(PerfCounterType::ViewNodesCreated);
 }
 
 ViewNode::~ViewNode() {
@@ -196,11 +209,11 @@ static void callViewCallbackIfNeeded(const Ref<ValueFunction>& valueFunction) {
 }
 
 void ViewNode::callViewChangedIfNeeded() {
-    if (_onViewChangedCallback == nullptr) {
+    if (_callbacks == nullptr || _callbacks->onViewChanged == nullptr) {
         return;
     }
     auto param = toPlaformRepresentation(true);
-    (*_onViewChangedCallback)(ValueFunctionFlagsNone, {param});
+    (*_callbacks->onViewChanged)(ValueFunctionFlagsNone, {param});
 }
 
 void ViewNode::removeViewFromParent(ViewTransactionScope& viewTransactionScope) {
@@ -246,7 +259,9 @@ void ViewNode::setView(ViewTransactionScope& viewTransactionScope,
         removeViewFromParent(viewTransactionScope, /*shouldViewClearViewNode*/ true);
 
         if (hasView()) {
-            callViewCallbackIfNeeded(_onViewDestroyedCallback);
+            if (_callbacks != nullptr) {
+                callViewCallbackIfNeeded(_callbacks->onViewDestroyed);
+            }
 
             // We don't enqueue the root view of the root context to the view pool,
             // nor do we explicitly remove it from the view hierarchy. We let
@@ -273,7 +288,9 @@ void ViewNode::setView(ViewTransactionScope& viewTransactionScope,
         if (hasView()) {
             _attributesApplier.didAddView(viewTransactionScope, animator);
 
-            callViewCallbackIfNeeded(_onViewCreatedCallback);
+            if (_callbacks != nullptr) {
+                callViewCallbackIfNeeded(_callbacks->onViewCreated);
+            }
             if (_flags[kLayoutDidCompleteOnceFlag]) {
                 setViewFrameNeedsUpdate();
             }
@@ -735,7 +752,9 @@ bool ViewNode::doUpdateVisibility(const Valdi::Frame& viewport,
         if (_childrenIndexer != nullptr) {
             // Use our childrenIndexer if we have one, which will efficiently find the elements which
             // have become visible or invisible
-            auto result = _childrenIndexer->findChildrenVisibility(getCalculatedViewport());
+            auto result = _childrenIndexer->findChildrenVisibility(
+                getCalculatedViewport(),
+                _scrollState != nullptr ? _scrollState->getDirectionAgnosticVelocity() : Point());
             for (auto* childViewNode : *result.invisibleChildren) {
                 changed |=
                     childViewNode->doUpdateVisibility(getCalculatedViewport(), viewportChanged, false, visitedNodes);
@@ -744,6 +763,18 @@ bool ViewNode::doUpdateVisibility(const Valdi::Frame& viewport,
                 changed |= childViewNode->doUpdateVisibility(
                     getCalculatedViewport(), viewportChanged, isVisible, visitedNodes);
             }
+            if (isVisible && !result.upcomingChildren->empty()) {
+                // Upcoming children are ordered from the closest to the furthest, the ones
+                // which could not fit in the budget will be laid out when becoming visible.
+                snap::utils::time::StopWatch sw;
+                sw.start();
+                for (auto* childViewNode : *result.upcomingChildren) {
+                    childViewNode->prelayoutLazyLayout();
+                    if (sw.elapsed().milliseconds() >= kUpcomingChildrenPrelayoutBudgetMs) {
+                        break;
+                    }
+                }
+            }
         } else {
             // Without childrenIndexer, just go over all our children
             for (ViewNode* childViewNode : *this) {
@@ -865,6 +896,8 @@ void ViewNode::handleOnScroll(const Point& directionDependentContentOffset,
         auto& scrollState = getOrCreateScrollState();
         auto shouldUpdateAttributeSync = scrollState.onScrollCallbackPrefersSyncCalls();
 
+        scrollState.setDirectionAgnosticVelocity(directionDependentVelocity);
+
         auto directionAgnosticContentOffset =
             scrollState.resolveDirectionAgnosticContentOffset(directionDependentContentOffset);
         auto directionAgnosticUnclampedContentOffset =
@@ -875,6 +908,12 @@ void ViewNode::handleOnScroll(const Point& directionDependentContentOffset,
         updateScrollAttributeValueIfNeeded(
             DefaultAttributeContentOffsetY, directionAgnosticContentOffset.y, shouldUpdateAttributeSync);
 
+        if (scrollState.getScrollLinkedEffects() != nullptr) {
+            auto scrollLinkedEffects = scrollState.getScrollLinkedEffects();
+            scrollLinkedEffects->apply(
+                tree->getCurrentViewTransactionScope(), *tree, directionAgnosticContentOffset);
+        }
+
         scrollState.notifyOnScroll(
             directionAgnosticContentOffset, directionAgnosticUnclampedContentOffset, directionDependentVelocity);
 
@@ -917,6 +956,7 @@ void ViewNode::onScrollEnd(const Point& directionDependentContentOffset,
 
     // Make sure everyone is notified that we are not animating anymore
     scrollState.setCurrentlyAnimating(false);
+    scrollState.setDirectionAgnosticVelocity(Point());
 
     // Trigger typescript's onScrollEnd
 
@@ -1288,6 +1328,9 @@ float ViewNode::getPointScale() const {
 }
 
 void ViewNode::onChildrenChanged() {
+    if (_viewNodeTree != nullptr) {
+        _viewNodeTree->invalidateNodeIdIndex();
+    }
     setChildrenIndexerNeedsUpdate();
     setViewTreeNeedsUpdate();
     setAccessibilityTreeNeedsUpdate();
@@ -1353,7 +1396,8 @@ void ViewNode::insertChildAt(ViewTransactionScope& viewTransactionScope, const R
     child->getCSSAttributesManager().setParent(&getCSSAttributesManager());
 
     if (child->getCSSAttributesManager().needUpdateCSS()) {
-        child->setCSSNeedsUpdate();
+        // The ancestors of the whole moved subtree changed
+        child->handleCSSChange(CSSChange::SelfAndDescendants);
     }
     if (child->cssNeedsUpdate()) {
         setCSSHasChildNeedsUpdate();
@@ -1384,6 +1428,24 @@ bool ViewNode::invalidateMeasuredSize() {
         return _emittingViewNode->invalidateMeasuredSize();
     }
 
+    if (_yogaNode == nullptr || !_yogaNode->getLayout().didUseCustomMeasure()) {
+        return false;
+    }
+
+    // The attributes did not change, so measurements cached for them are no longer valid
+    const auto& boundAttributes = _attributesApplier.getBoundAttributes();
+    if (boundAttributes != nullptr && boundAttributes->getMeasureDelegate() != nullptr) {
+        boundAttributes->getMeasureDelegate()->onMeasuredSizeInvalidated(*this);
+    }
+
+    return markLayoutDirty();
+}
+
+bool ViewNode::markMeasuredSizeDirty() {
+    if (_emittingViewNode != nullptr) {
+        return _emittingViewNode->markMeasuredSizeDirty();
+    }
+
     if (_yogaNode == nullptr) {
         return false;
     }
@@ -1591,6 +1653,13 @@ LazyLayoutData& ViewNode::getOrCreateLazyLayoutData() {
     return *_lazyLayoutData;
 }
 
+ViewNodeCallbacks& ViewNode::getOrCreateCallbacks() {
+    if (_callbacks == nullptr) {
+        _callbacks = std::make_unique<ViewNodeCallbacks>();
+    }
+    return *_callbacks;
+}
+
 YGNode* ViewNode::getLazyLayoutYogaNode() const {
     return _lazyLayoutData != nullptr ? _lazyLayoutData->yogaNode : nullptr;
 }
@@ -2068,6 +2137,8 @@ bool ViewNode::calculateLayoutOnNodeIfNeeded(YGNode* yogaNode,
     auto module = getModuleName();
 
     VALDI_TRACE("Valdi.calculateLayout");
+    ScopedStartupSpan startupSpan(StartupSpanType::Layout, module);
+    PerfCounters::increment(PerfCounterType::LayoutPasses);
     auto metricsObj = getMetrics();
     ScopedMetrics metrics = isFromLazyLayout ?
                                 Metrics::scopedCalculateLazyLayoutLatency(metricsObj, module, backendString) :
@@ -2075,6 +2146,7 @@ bool ViewNode::calculateLayoutOnNodeIfNeeded(YGNode* yogaNode,
 
     MeasureMetrics measureCount;
     doCalculateLayoutOnNode(yogaNode, width, widthMode, height, heightMode, direction, measureCount);
+    StartupTimeline::shared().markMilestone(StartupMilestone::FirstLayout);
 
     if (measureCount.totalMeasure > 0) {
         if (isFromLazyLayout) {
@@ -2116,6 +2188,55 @@ void ViewNode::performLayout(ViewTransactionScope& viewTransactionScope, Size si
     _flags[kCalculatingLayoutFlag] = false;
 }
 
+bool ViewNode::isRelayoutBoundaryDirty() const {
+    return _yogaNode != nullptr && _yogaNode->isDirty() && _yogaNode->hasConfinedDirtiness();
+}
+
+void ViewNode::performRelayoutBoundaryLayout(ViewTransactionScope& viewTransactionScope) {
+    auto* ownerYogaNode = _yogaNode->getOwner();
+    if (ownerYogaNode == nullptr) {
+        return;
+    }
+
+    // The node is laid out as a root, which resolves its size from its style and its position
+    // from the given owner size. We force the style size to the last size resolved by the owner,
+    // which takes the flex factors into account, and restore the position afterwards.
+    auto& style = _yogaNode->getStyle();
+    YGValue savedWidth = style.dimensions()[YGDimensionWidth];
+    YGValue savedHeight = style.dimensions()[YGDimensionHeight];
+    const auto& layout = _yogaNode->getLayout();
+    auto savedPosition = layout.position;
+    auto savedDimensions = layout.dimensions;
+    auto direction = layout.direction() == YGDirectionRTL ? LayoutDirectionRTL : LayoutDirectionLTR;
+    const auto& ownerDimensions = ownerYogaNode->getLayout().dimensions;
+
+    style.dimensions()[YGDimensionWidth] = YGValue{savedDimensions[YGDimensionWidth], YGUnitPoint};
+    style.dimensions()[YGDimensionHeight] = YGValue{savedDimensions[YGDimensionHeight], YGUnitPoint};
+
+    _flags[kCalculatingLayoutFlag] = true;
+    calculateLayoutOnNodeIfNeeded(_yogaNode,
+                                  ownerDimensions[YGDimensionWidth],
+                                  MeasureModeExactly,
+                                  ownerDimensions[YGDimensionHeight],
+                                  MeasureModeExactly,
+                                  direction,
+                                  /* forceLayout */ false,
+                                  /* isFromLazyLayout */ false);
+
+    style.dimensions()[YGDimensionWidth] = savedWidth;
+    style.dimensions()[YGDimensionHeight] = savedHeight;
+    _yogaNode->resolveDimension();
+
+    for (auto edge : {YGEdgeLeft, YGEdgeTop, YGEdgeRight, YGEdgeBottom}) {
+        _yogaNode->setLayoutPosition(savedPosition[edge], edge);
+    }
+    _yogaNode->setLayoutDimension(savedDimensions[YGDimensionWidth], YGDimensionWidth);
+    _yogaNode->setLayoutDimension(savedDimensions[YGDimensionHeight], YGDimensionHeight);
+
+    layoutFinished(viewTransactionScope, true);
+    _flags[kCalculatingLayoutFlag] = false;
+}
+
 Size ViewNode::measureLayout(
     float width, MeasureMode widthMode, float height, MeasureMode heightMode, LayoutDirection direction) {
     if (!_flags[kCalculatingLayoutFlag]) {
@@ -2149,6 +2270,10 @@ void ViewNode::layoutFinished(ViewTransactionScope& viewTransactionScope, bool d
     ViewNodesFrameObserver* frameObserver = nullptr;
     if (_viewNodeTree != nullptr) {
         frameObserver = _viewNodeTree->getViewNodesFrameObserver();
+
+        if (_viewNodeTree->isParallelLayoutEnabled()) {
+            calculateLazyLayoutsInParallel(didPerformLayout);
+        }
     }
 
     float rtlOffsetX = 0.0f;
@@ -2257,9 +2382,208 @@ bool ViewNode::updateLazyLayout() {
 
     _lazyLayoutData->availableWidth = _calculatedFrame.width;
     _lazyLayoutData->availableHeight = _calculatedFrame.height;
+
+    if (_lazyLayoutData->hasPrecalculatedLayout) {
+        _lazyLayoutData->hasPrecalculatedLayout = false;
+        updated = true;
+    }
+
     return updated;
 }
 
+struct PendingLazyLayout {
+    ViewNode* viewNode;
+    float width;
+    float height;
+    bool forceLayout;
+    bool updated = false;
+
+    PendingLazyLayout(ViewNode* viewNode, float width, float height, bool forceLayout)
+        : viewNode(viewNode), width(width), height(height), forceLayout(forceLayout) {}
+};
+
+void ViewNode::calculateLazyLayoutsInParallel(bool didPerformLayout) {
+    std::vector<PendingLazyLayout> pendingLazyLayouts;
+    collectPendingLazyLayouts(didPerformLayout, pendingLazyLayouts);
+
+    if (pendingLazyLayouts.size() < 2) {
+        // Not worth dispatching, the layout pass will take care of it
+        return;
+    }
+
+    VALDI_TRACE("Valdi.calculateLazyLayoutsInParallel");
+
+    const auto& threadPool = ThreadPool::getShared();
+    threadPool->parallelFor(
+        pendingLazyLayouts.size(), threadPool->getWorkersCount() + 1, [&](size_t index) {
+            auto& pendingLazyLayout = pendingLazyLayouts[index];
+            pendingLazyLayout.updated = pendingLazyLayout.viewNode->calculateLayoutOnNodeIfNeeded(
+                pendingLazyLayout.viewNode->_lazyLayoutData->yogaNode,
+                pendingLazyLayout.width,
+                MeasureModeExactly,
+                pendingLazyLayout.height,
+                MeasureModeExactly,
+                LayoutDirectionLTR /* The direction is set on the style directly */,
+                pendingLazyLayout.forceLayout,
+                /* isFromLazyLayout */ true);
+        });
+
+    for (const auto& pendingLazyLayout : pendingLazyLayouts) {
+        auto& lazyLayoutData = *pendingLazyLayout.viewNode->_lazyLayoutData;
+        lazyLayoutData.availableWidth = pendingLazyLayout.width;
+        lazyLayoutData.availableHeight = pendingLazyLayout.height;
+        lazyLayoutData.hasPrecalculatedLayout |= pendingLazyLayout.updated;
+    }
+}
+
+void ViewNode::collectPendingLazyLayouts(bool didPerformLayout, std::vector<PendingLazyLayout>& pendingLazyLayouts) {
+    for (auto* child : *this) {
+        if (!didPerformLayout && !child->_flags[kHasLazyLayoutNeedingCalculationFlag]) {
+            continue;
+        }
+
+        auto* lazyYogaNode = child->getLazyLayoutYogaNode();
+        if (child->_flags[kIsLazyLayoutFlag] && lazyYogaNode != nullptr && child->_flags[kVisibleInViewportFlag]) {
+            // Same resolution as updateLazyLayout(), applied ahead of time since it can dirty the node
+            auto size = ygNodeGetFrame(child->_yogaNode, 0).size();
+            auto direction = child->_yogaNode->getLayout().direction();
+            auto directionHasChanged = direction != lazyYogaNode->getLayout().direction();
+            YGNodeStyleSetDirection(lazyYogaNode, direction);
+
+            auto forceLayout = directionHasChanged || child->_lazyLayoutData->availableWidth != size.width ||
+                               child->_lazyLayoutData->availableHeight != size.height;
+
+            if (forceLayout || lazyYogaNode->isDirty()) {
+                if (!child->hasExternalMeasureInLazyLayout()) {
+                    pendingLazyLayouts.emplace_back(child, size.width, size.height, forceLayout);
+                }
+                // The frames of the children will only be known once this subtree is laid out
+                continue;
+            }
+        }
+
+        child->collectPendingLazyLayouts(didPerformLayout, pendingLazyLayouts);
+    }
+}
+
+bool ViewNode::hasExternalMeasureInLazyLayout() const {
+    for (const auto* child : *this) {
+        if (child->_lazyLayoutData != nullptr && child->_lazyLayoutData->onMeasureCallback != nullptr) {
+            // onMeasure callbacks are synchronous calls into JS, which could deadlock from a worker
+            return true;
+        }
+        // Nested lazy layouts are calculated separately, only their own measure is needed here
+        if (!child->_flags[kIsLazyLayoutFlag] && child->hasExternalMeasureInLazyLayout()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename F>
+static float resolveHorizontalEdges(F&& getEdgeValue) {
+    // Same precedence as yoga: the specific edge first, then the horizontal and all edges
+    auto resolveEdge = [&](YGEdge edge, YGEdge relativeEdge) {
+        for (auto candidateEdge : {edge, relativeEdge, YGEdgeHorizontal, YGEdgeAll}) {
+            auto value = getEdgeValue(candidateEdge);
+            if (value.unit != YGUnitUndefined) {
+                return value.unit == YGUnitPoint ? value.value : 0.0f;
+            }
+        }
+        return 0.0f;
+    };
+
+    return resolveEdge(YGEdgeLeft, YGEdgeStart) + resolveEdge(YGEdgeRight, YGEdgeEnd);
+}
+
+static float getHorizontalInsets(const YGNode* yogaNode) {
+    auto padding = resolveHorizontalEdges([&](YGEdge edge) { return YGNodeStyleGetPadding(yogaNode, edge); });
+    auto border = resolveHorizontalEdges([&](YGEdge edge) {
+        auto value = YGNodeStyleGetBorder(yogaNode, edge);
+        return std::isnan(value) ? YGValueUndefined : YGValue{value, YGUnitPoint};
+    });
+
+    return padding + border;
+}
+
+static float getHorizontalMargins(const YGNode* yogaNode) {
+    return resolveHorizontalEdges([&](YGEdge edge) { return YGNodeStyleGetMargin(yogaNode, edge); });
+}
+
+static bool isStretchedHorizontally(const YGNode* parentYogaNode, const YGNode* yogaNode) {
+    auto flexDirection = YGNodeStyleGetFlexDirection(parentYogaNode);
+    if (flexDirection != YGFlexDirectionColumn && flexDirection != YGFlexDirectionColumnReverse) {
+        return false;
+    }
+
+    auto align = YGNodeStyleGetAlignSelf(yogaNode);
+    if (align == YGAlignAuto) {
+        align = YGNodeStyleGetAlignItems(parentYogaNode);
+    }
+
+    return align == YGAlignStretch;
+}
+
+void ViewNode::prelayoutLazyLayout() {
+    auto* lazyYogaNode = getLazyLayoutYogaNode();
+    if (!_flags[kIsLazyLayoutFlag] || !_flags[kLayoutDidCompleteOnceFlag] || lazyYogaNode == nullptr ||
+        !lazyYogaNode->isDirty()) {
+        return;
+    }
+
+    VALDI_TRACE("Valdi.prelayoutLazyLayout");
+
+    // The constraints given to the measured nodes are resolved from the width of the lazy layout,
+    // which is known ahead of time as it is laid out by the parent. This is an estimate which
+    // handles common column layouts, nodes which are measured with different constraints
+    // will still benefit from the warmed up caches of the measure delegate.
+    auto width = _calculatedFrame.width - getHorizontalInsets(lazyYogaNode);
+    size_t remainingNodesCount = kMaxPrelayoutNodesCount;
+    for (auto* child : *this) {
+        child->prelayout(*lazyYogaNode, width, remainingNodesCount);
+    }
+}
+
+void ViewNode::prelayout(const YGNode& parentYogaNode, float availableWidth, size_t& remainingNodesCount) {
+    if (remainingNodesCount == 0) {
+        return;
+    }
+    remainingNodesCount--;
+
+    if (_flags[kLayoutDidCompleteOnceFlag] && !_yogaNode->isDirty()) {
+        return;
+    }
+
+    auto width = std::max(availableWidth - getHorizontalMargins(_yogaNode), 0.0f);
+    auto widthMode = isStretchedHorizontally(&parentYogaNode, _yogaNode) ? MeasureModeExactly : MeasureModeAtMost;
+    auto styleWidth = YGNodeStyleGetWidth(_yogaNode);
+    if (styleWidth.unit == YGUnitPoint) {
+        width = styleWidth.value;
+        widthMode = MeasureModeExactly;
+    }
+
+    if (_lazyLayoutData != nullptr && _lazyLayoutData->onMeasureCallback != nullptr) {
+        // Measured from JS, which can only happen synchronously
+        return;
+    }
+
+    const auto& boundAttributes = _attributesApplier.getBoundAttributes();
+    if (boundAttributes != nullptr && boundAttributes->getMeasureDelegate() != nullptr) {
+        boundAttributes->getMeasureDelegate()->prelayout(*this, width, widthMode, 0.0f, MeasureModeUnspecified);
+        return;
+    }
+
+    if (_flags[kIsLazyLayoutFlag]) {
+        // Nested lazy layouts are prelaid out when they are about to become visible within their parent
+        return;
+    }
+
+    auto innerWidth = width - getHorizontalInsets(_yogaNode);
+    for (auto* child : *this) {
+        child->prelayout(*_yogaNode, innerWidth, remainingNodesCount);
+    }
+}
+
 void ViewNode::updateScrollState() {
     auto& scrollState = getOrCreateScrollState();
     scrollState.setInScrollMode(true);
@@ -2404,8 +2728,8 @@ void ViewNode::layoutFinished(ViewTransactionScope& viewTransactionScope,
     float childrenRtlOffsetX = isInScrollMode() ? getOrCreateScrollState().getRtlOffsetX() : 0.0f;
     const auto& resolvedAnimator = resolveAnimator(parentAnimator);
 
-    if (_onLayoutCompletedCallback != nullptr && frameObserver != nullptr) {
-        frameObserver->appendCompleteCallback(_onLayoutCompletedCallback);
+    if (_callbacks != nullptr && _callbacks->onLayoutCompleted != nullptr && frameObserver != nullptr) {
+        frameObserver->appendCompleteCallback(_callbacks->onLayoutCompleted);
     }
 
     auto* childrenIndexer = _childrenIndexer.get();
@@ -2516,11 +2840,18 @@ void ViewNode::applyFrame(ViewTransactionScope& viewTransactionScope,
     }
 }
 
-bool ViewNode::handleCSSChange(bool cssChanged) {
-    if (cssChanged) {
-        setCSSNeedsUpdate();
+bool ViewNode::handleCSSChange(CSSChange cssChange) {
+    switch (cssChange) {
+        case CSSChange::None:
+            return false;
+        case CSSChange::SelfAndDescendants:
+            _flags[kCSSDescendantsNeedUpdate] = true;
+            [[fallthrough]];
+        case CSSChange::Self:
+            setCSSNeedsUpdate();
+            return true;
     }
-    return cssChanged;
+    return false;
 }
 
 bool ViewNode::isHorizontal() {
@@ -2543,12 +2874,19 @@ bool ViewNode::setAttribute(ViewTransactionScope& viewTransactionScope,
                             const Ref<Animator>& animator,
                             bool isOverridenFromParent) {
     if (attributeId == DefaultAttributeId) {
+        if (_viewNodeTree != nullptr) {
+            _viewNodeTree->invalidateNodeIdIndex();
+        }
         return handleCSSChange(
             getCSSAttributesManager().setElementId(attributeValue.toStringBox(), isOverridenFromParent));
     } else if (attributeId == DefaultAttributeElementTag) {
         return handleCSSChange(
             getCSSAttributesManager().setElementTag(attributeValue.toStringBox(), isOverridenFromParent));
     } else if (attributeId == DefaultAttributeCSSDocument) {
+        // The node ids are held by the CSS nodes, which are re-created for the new document
+        if (_viewNodeTree != nullptr) {
+            _viewNodeTree->invalidateNodeIdIndex();
+        }
         return handleCSSChange(getCSSAttributesManager().setCSSDocument(attributeValue, isOverridenFromParent));
     } else if (attributeId == DefaultAttributeCSSClass) {
         return handleCSSChange(getCSSAttributesManager().setCSSClass(attributeValue, isOverridenFromParent));
@@ -2589,24 +2927,48 @@ void ViewNode::reapplyAttributesRecursive(ViewTransactionScope& viewTransactionS
     getAttributesApplier().flush(viewTransactionScope);
 }
 
+void ViewNode::reapplyAttributesForColorChangesRecursive(ViewTransactionScope& viewTransactionScope,
+                                                         const std::vector<AttributeId>& attributes,
+                                                         const ColorPaletteChanges& changes) {
+    for (const auto& attribute : attributes) {
+        getAttributesApplier().reapplyAttributeForColorChanges(viewTransactionScope, attribute, changes);
+    }
+
+    for (auto* child : *this) {
+        child->reapplyAttributesForColorChangesRecursive(viewTransactionScope, attributes, changes);
+    }
+
+    getAttributesApplier().flush(viewTransactionScope);
+}
+
 void ViewNode::notifyAttributeFailed(AttributeId attributeId, const Error& error) {
     _attributesApplier.onApplyAttributeFailed(attributeId, error);
 }
 
 void ViewNode::setOnViewCreatedCallback(Ref<ValueFunction> onViewCreatedCallback) {
-    _onViewCreatedCallback = std::move(onViewCreatedCallback);
+    if (onViewCreatedCallback == nullptr && _callbacks == nullptr) {
+        return;
+    }
+    auto& callbacks = getOrCreateCallbacks();
+    callbacks.onViewCreated = std::move(onViewCreatedCallback);
 
-    if (_onViewCreatedCallback != nullptr && hasView()) {
-        (*_onViewCreatedCallback)();
+    if (callbacks.onViewCreated != nullptr && hasView()) {
+        (*callbacks.onViewCreated)();
     }
 }
 
 void ViewNode::setOnViewDestroyedCallback(Ref<ValueFunction> onViewDestroyedCallback) {
-    _onViewDestroyedCallback = std::move(onViewDestroyedCallback);
+    if (onViewDestroyedCallback == nullptr && _callbacks == nullptr) {
+        return;
+    }
+    getOrCreateCallbacks().onViewDestroyed = std::move(onViewDestroyedCallback);
 }
 
 void ViewNode::setOnViewChangedCallback(Ref<ValueFunction> onViewChangedCallback) {
-    _onViewChangedCallback = std::move(onViewChangedCallback);
+    if (onViewChangedCallback == nullptr && _callbacks == nullptr) {
+        return;
+    }
+    getOrCreateCallbacks().onViewChanged = std::move(onViewChangedCallback);
 
     if (hasView()) {
         callViewChangedIfNeeded();
@@ -2614,7 +2976,10 @@ void ViewNode::setOnViewChangedCallback(Ref<ValueFunction> onViewChangedCallback
 }
 
 void ViewNode::setOnLayoutCompletedCallback(Ref<ValueFunction> onLayoutCompletedCallback) {
-    _onLayoutCompletedCallback = std::move(onLayoutCompletedCallback);
+    if (onLayoutCompletedCallback == nullptr && _callbacks == nullptr) {
+        return;
+    }
+    getOrCreateCallbacks().onLayoutCompleted = std::move(onLayoutCompletedCallback);
 }
 
 void ViewNode::setOnMeasureCallback(ViewTransactionScope& viewTransactionScope, Ref<ValueFunction> onMeasureCallback) {
@@ -2652,6 +3017,26 @@ void ViewNode::setOnContentSizeChangeCallback(Ref<ValueFunction> onContentSizeCh
     scrollState.setOnContentSizeChangeCallback(std::move(onContentSizeChangeCallback));
 }
 
+void ViewNode::setScrollLinkedEffects(ViewTransactionScope& viewTransactionScope,
+                                      Ref<ScrollLinkedEffects> scrollLinkedEffects) {
+    auto& scrollState = getOrCreateScrollState();
+    if (scrollState.getScrollLinkedEffects() == scrollLinkedEffects) {
+        return;
+    }
+
+    auto* tree = getViewNodeTree();
+    if (scrollState.getScrollLinkedEffects() != nullptr && tree != nullptr) {
+        scrollState.getScrollLinkedEffects()->remove(viewTransactionScope, *tree);
+    }
+
+    scrollState.setScrollLinkedEffects(std::move(scrollLinkedEffects));
+
+    if (scrollState.getScrollLinkedEffects() != nullptr && tree != nullptr) {
+        scrollState.getScrollLinkedEffects()->apply(
+            viewTransactionScope, *tree, scrollState.getDirectionAgnosticContentOffset());
+    }
+}
+
 std::vector<SharedViewNode> ViewNode::copyChildren() const {
     std::vector<SharedViewNode> out;
     out.reserve(static_cast<size_t>(getChildCount()));
@@ -2881,7 +3266,11 @@ void ViewNode::updateCSS(ViewTransactionScope& viewTransactionScope,
 
     handleCSSChange(getCSSAttributesManager().setSiblingsIndexes(siblingsCount, indexAmongSiblings));
 
-    auto needUpdateSelf = force || _flags[kCSSNeedsUpdate];
+    // Descendants are only restyled when something they may match through a parent or
+    // ancestor selector changed on this node.
+    auto forceDescendants = force || _flags[kCSSDescendantsNeedUpdate];
+    auto needUpdateSelf = forceDescendants || _flags[kCSSNeedsUpdate];
+    // Children are still visited so that their sibling indexes are refreshed
     auto needUpdateChildren = needUpdateSelf || _flags[kCSSHasChildNeedsUpdate];
 
     if (needUpdateSelf) {
@@ -2895,12 +3284,14 @@ void ViewNode::updateCSS(ViewTransactionScope& viewTransactionScope,
         auto childCount = static_cast<int>(getChildCount());
         int index = 0;
         for (auto* childViewNode : *this) {
-            childViewNode->updateCSS(viewTransactionScope, animator, needUpdateSelf, childCount, index, updateResult);
+            childViewNode->updateCSS(
+                viewTransactionScope, animator, forceDescendants, childCount, index, updateResult);
             index++;
         }
     }
 
     _flags[kCSSNeedsUpdate] = false;
+    _flags[kCSSDescendantsNeedUpdate] = false;
     _flags[kCSSHasChildNeedsUpdate] = false;
 }
 
@@ -2992,6 +3383,16 @@ void ViewNode::setViewportExtensionRight(float viewportExtensionRight) {
     updateViewportExtension([&](auto& scrollState) { scrollState.setViewportExtensionRight(viewportExtensionRight); });
 }
 
+template<typename F>
+auto ViewNode::readAccessibilityState(F&& fn) const {
+    if (_accessibilityState != nullptr) {
+        return fn(*_accessibilityState);
+    }
+    // Nodes without accessibility attributes resolve their accessibility from their other attributes,
+    // which is only needed while an assistive technology walks the tree, so we don't keep the state around
+    return fn(ViewNodeAccessibilityState(_attributesApplier));
+}
+
 ViewNodeAccessibilityState& ViewNode::getOrCreateAccessibilityState() {
     if (_accessibilityState == nullptr) {
         _accessibilityState = std::make_unique<ViewNodeAccessibilityState>(_attributesApplier);
@@ -3001,76 +3402,106 @@ ViewNodeAccessibilityState& ViewNode::getOrCreateAccessibilityState() {
 
 void ViewNode::setAccessibilityCategory(int accessibilityCategoryInt) {
     auto accessibilityCategory = static_cast<AccessibilityCategory>(accessibilityCategoryInt);
+    if (_accessibilityState == nullptr && accessibilityCategory == AccessibilityCategoryAuto) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityCategory(accessibilityCategory);
     setAccessibilityTreeNeedsUpdate();
 }
 AccessibilityCategory ViewNode::getAccessibilityCategory() {
-    return getOrCreateAccessibilityState().getAccessibilityCategory();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityCategory(); });
 }
 
 void ViewNode::setAccessibilityNavigation(int accessibilityNavigationInt) {
     auto accessibilityNavigation = static_cast<AccessibilityNavigation>(accessibilityNavigationInt);
+    if (_accessibilityState == nullptr && accessibilityNavigation == AccessibilityNavigationAuto) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityNavigation(accessibilityNavigation);
     setAccessibilityTreeNeedsUpdate();
 }
 AccessibilityNavigation ViewNode::getAccessibilityNavigation() {
-    return getOrCreateAccessibilityState().getAccessibilityNavigation();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityNavigation(); });
 }
 
 void ViewNode::setAccessibilityPriority(float accessibilityPriority) {
+    if (_accessibilityState == nullptr && accessibilityPriority == 0) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityPriority(accessibilityPriority);
     setAccessibilityTreeNeedsUpdate();
 }
 float ViewNode::getAccessibilityPriority() {
-    return getOrCreateAccessibilityState().getAccessibilityPriority();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityPriority(); });
 }
 
 void ViewNode::setAccessibilityLabel(const StringBox& accessibilityLabel) {
+    if (_accessibilityState == nullptr && accessibilityLabel.isEmpty()) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityLabel(accessibilityLabel);
     setAccessibilityTreeNeedsUpdate();
 }
 StringBox ViewNode::getAccessibilityLabel() {
-    return getOrCreateAccessibilityState().getAccessibilityLabel();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityLabel(); });
 }
 
 void ViewNode::setAccessibilityHint(const StringBox& accessibilityHint) {
+    if (_accessibilityState == nullptr && accessibilityHint.isEmpty()) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityHint(accessibilityHint);
     setAccessibilityTreeNeedsUpdate();
 }
 StringBox ViewNode::getAccessibilityHint() {
-    return getOrCreateAccessibilityState().getAccessibilityHint();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityHint(); });
 }
 
 void ViewNode::setAccessibilityValue(const StringBox& accessibilityValue) {
+    if (_accessibilityState == nullptr && accessibilityValue.isEmpty()) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityValue(accessibilityValue);
     setAccessibilityTreeNeedsUpdate();
 }
 StringBox ViewNode::getAccessibilityValue() {
-    return getOrCreateAccessibilityState().getAccessibilityValue();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityValue(); });
 }
 
 void ViewNode::setAccessibilityStateDisabled(bool accessibilityStateDisabled) {
+    if (_accessibilityState == nullptr && !accessibilityStateDisabled) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityStateDisabled(accessibilityStateDisabled);
 }
 bool ViewNode::getAccessibilityStateDisabled() {
-    return getOrCreateAccessibilityState().getAccessibilityStateDisabled();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityStateDisabled(); });
 }
 
 void ViewNode::setAccessibilityStateSelected(bool accessibilityStateSelected) {
+    if (_accessibilityState == nullptr && !accessibilityStateSelected) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityStateSelected(accessibilityStateSelected);
 }
 bool ViewNode::getAccessibilityStateSelected() {
-    return getOrCreateAccessibilityState().getAccessibilityStateSelected();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityStateSelected(); });
 }
 
 void ViewNode::setAccessibilityStateLiveRegion(bool accessibilityStateLiveRegion) {
+    if (_accessibilityState == nullptr && !accessibilityStateLiveRegion) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityStateLiveRegion(accessibilityStateLiveRegion);
 }
 bool ViewNode::getAccessibilityStateLiveRegion() {
-    return getOrCreateAccessibilityState().getAccessibilityStateLiveRegion();
+    return readAccessibilityState([](const auto& state) { return state.getAccessibilityStateLiveRegion(); });
 }
 
 void ViewNode::setAccessibilityId(const StringBox& accessibilityId) {
+    if (_accessibilityState == nullptr && accessibilityId.isEmpty()) {
+        return;
+    }
     getOrCreateAccessibilityState().setAccessibilityId(accessibilityId);
     setAccessibilityTreeNeedsUpdate();
 
@@ -3291,6 +3722,19 @@ void ViewNode::setEstimatedHeight(float estimatedHeight) {
     }
 }
 
+size_t ViewNodeTreeInfo::getTotalBytes() const {
+    return viewNodesBytes + layoutBytes + attributesBytes;
+}
+
+void ViewNodeTreeInfo::merge(const ViewNodeTreeInfo& other) {
+    nodesCount += other.nodesCount;
+    viewsCount += other.viewsCount;
+    attributesCount += other.attributesCount;
+    viewNodesBytes += other.viewNodesBytes;
+    layoutBytes += other.layoutBytes;
+    attributesBytes += other.attributesBytes;
+}
+
 ViewNodeTreeInfo ViewNode::dumpTreeInfo() const {
     ViewNodeTreeInfo info;
     info.nodesCount = 1;
@@ -3298,11 +3742,32 @@ ViewNodeTreeInfo ViewNode::dumpTreeInfo() const {
         info.viewsCount = 1;
     }
 
-    for (auto* child : *this) {
-        auto childInfo = child->dumpTreeInfo();
+    info.viewNodesBytes = sizeof(ViewNode) + getChildCount() * sizeof(ViewNode*);
+    if (_childrenIndexer != nullptr) {
+        info.viewNodesBytes += sizeof(ViewNodeChildrenIndexer);
+    }
+    if (_scrollState != nullptr) {
+        info.viewNodesBytes += sizeof(ViewNodeScrollState);
+    }
+    if (_accessibilityState != nullptr) {
+        info.viewNodesBytes += sizeof(ViewNodeAccessibilityState);
+    }
+    if (_callbacks != nullptr) {
+        info.viewNodesBytes += sizeof(ViewNodeCallbacks);
+    }
 
-        info.nodesCount += childInfo.nodesCount;
-        info.viewsCount += childInfo.viewsCount;
+    if (_yogaNode != nullptr) {
+        info.layoutBytes += sizeof(YGNode);
+    }
+    if (_lazyLayoutData != nullptr) {
+        info.layoutBytes += sizeof(LazyLayoutData);
+    }
+
+    info.attributesCount = static_cast<int>(_attributesApplier.getAttributesCount());
+    info.attributesBytes = _attributesApplier.getEstimatedMemoryUsage();
+
+    for (auto* child : *this) {
+        info.merge(child->dumpTreeInfo());
     }
 
     return info;
@@ -3392,6 +3857,13 @@ void ygDirtiedCallback(YGNodeRef node) {
         viewNode->scheduleLazyLayout();
     }
 
+    if (node->hasConfinedDirtiness()) {
+        auto* viewNodeTree = viewNode->getViewNodeTree();
+        if (viewNodeTree != nullptr) {
+            viewNodeTree->onRelayoutBoundaryDirty(viewNode);
+        }
+    }
+
     if (!viewNode->hasParent()) {
         auto* viewNodeTree = viewNode->getViewNodeTree();
         if (viewNodeTree != nullptr) {
@@ -57,8 +57,10 @@ class BoundAttributes;
 class AttributeOwner;
 class ViewNodesFrameObserver;
 class Metrics;
+class ColorPaletteChanges;
 
 class ViewNode;
+struct PendingLazyLayout;
 class ViewNodeIterator {
 public:
     ViewNodeIterator(const ViewNode* viewNode, size_t index);
@@ -81,12 +83,25 @@ struct LazyLayoutData {
     float estimatedWidth = 0;
     float estimatedHeight = 0;
     Ref<ValueFunction> onMeasureCallback;
+    // Set when the layout was calculated ahead of the layout pass by calculateLazyLayoutsInParallel()
+    bool hasPrecalculatedLayout = false;
 
     ~LazyLayoutData();
 
     void destroyNode();
 };
 
+/**
+ The JS callbacks of a ViewNode, which are only set on a few nodes. Allocated on first use
+ so that they don't take room in every ViewNode.
+ */
+struct ViewNodeCallbacks {
+    Ref<ValueFunction> onViewCreated;
+    Ref<ValueFunction> onViewDestroyed;
+    Ref<ValueFunction> onViewChanged;
+    Ref<ValueFunction> onLayoutCompleted;
+};
+
 struct ViewNodeUpdateViewTreeResult {
     int visitedNodes = 0;
     int reinsertedViews = 0;
@@ -107,6 +122,7 @@ struct CSSUpdateResult {
 };
 
 class ViewNodeScrollState;
+class ScrollLinkedEffects;
 class ViewNodeAccessibilityState;
 
 class ViewNodeViewStats;
@@ -120,6 +136,17 @@ class ViewTransactionScope;
 struct ViewNodeTreeInfo {
     int nodesCount = 0;
     int viewsCount = 0;
+    int attributesCount = 0;
+
+    // Estimated native memory retained by the nodes themselves. Memory owned by
+    // the platform views, or referenced by the attribute values, is not included.
+    size_t viewNodesBytes = 0;
+    size_t layoutBytes = 0;
+    size_t attributesBytes = 0;
+
+    size_t getTotalBytes() const;
+
+    void merge(const ViewNodeTreeInfo& other);
 };
 
 enum LayoutDirection {
@@ -236,7 +263,15 @@ public:
 
     bool isVisibleInViewport() const;
 
+    /**
+     Invalidate the measured size of this node when its content changed without its attributes changing,
+     this also drops any measurement cached for its attributes.
+     */
     bool invalidateMeasuredSize();
+    /**
+     Mark the measured size of this node as dirty after one of its layout attributes changed.
+     */
+    bool markMeasuredSizeDirty();
     bool markLayoutDirty();
     /**
      Returns whether a full layout calculation is required from this node
@@ -321,6 +356,14 @@ public:
                                     const std::vector<AttributeId>& attributes,
                                     bool invalidateMeasure);
 
+    /**
+     Reapply the given attributes in this ViewNode and its children,
+     only where their values were resolved with any of the changed colors.
+     */
+    void reapplyAttributesForColorChangesRecursive(ViewTransactionScope& viewTransactionScope,
+                                                   const std::vector<AttributeId>& attributes,
+                                                   const ColorPaletteChanges& changes);
+
     void notifyAttributeFailed(AttributeId attributeId, const Error& error);
 
     AttributesApplier& getAttributesApplier();
@@ -383,6 +426,19 @@ public:
         float width, MeasureMode widthMode, float height, MeasureMode heightMode, LayoutDirection direction);
     void performLayout(ViewTransactionScope& viewTransactionScope, Size size, LayoutDirection direction);
 
+    /**
+     Whether this node is a relayout boundary which was dirtied by one of its descendants.
+     Since its size does not depend on its content, the dirtiness did not propagate to its
+     parent and the node needs to be laid out on its own through performRelayoutBoundaryLayout().
+     */
+    bool isRelayoutBoundaryDirty() const;
+
+    /**
+     Calculate the layout of this relayout boundary subtree, using the size and position that
+     were last resolved for it by its parent.
+     */
+    void performRelayoutBoundaryLayout(ViewTransactionScope& viewTransactionScope);
+
     /**
      Update the visibility of all the nodes in this subtree,
      and perform updates based on what changes.
@@ -406,6 +462,8 @@ public:
     void setOnDragEndingCallback(Ref<ValueFunction> onDragEndingCallback);
     void setOnDragEndCallback(Ref<ValueFunction> onDragEndCallback);
     void setOnContentSizeChangeCallback(Ref<ValueFunction> onContentSizeChangeCallback);
+    void setScrollLinkedEffects(ViewTransactionScope& viewTransactionScope,
+                                Ref<ScrollLinkedEffects> scrollLinkedEffects);
 
     bool isRightToLeft() const;
     PlatformType getPlatformType() const;
@@ -590,26 +648,11 @@ public:
     void setAssetHandler(const Ref<IViewNodeAssetHandler>& assetHandler);
 
 private:
+    // The fields read by the tree walks of layout, visibility and view tree updates
+    // come first, so that they share the first cache lines of the instance.
     YGNode* _yogaNode = nullptr;
-    Weak<ViewNode> _parent;
-    AttributeIds& _attributeIds;
-    ILogger& _logger;
-    std::unique_ptr<LazyLayoutData> _lazyLayoutData;
-
-    CSSAttributesManager _cssAttributesManager;
-    ViewNodeAttributesApplier _attributesApplier;
-    // Will be set for ViewNode used during measure passes.
-    Ref<ViewNode> _emittingViewNode;
-
-    Frame _calculatedViewport;
-    Frame _calculatedFrame;
-    Frame _viewFrame;
-    Frame _previousViewFrame;
-    float _translationX = 0;
-    float _translationY = 0;
-    std::unique_ptr<ViewNodeScrollState> _scrollState;
-    std::unique_ptr<ViewNodeAccessibilityState> _accessibilityState;
-    std::unique_ptr<ViewNodeChildrenIndexer> _childrenIndexer;
+    std::bitset<30> _flags;
+    RawViewNodeId _rawId = 0;
 
     // The number of children views inside this view node subtree
     // that are inserted in the nearest parent view.
@@ -619,21 +662,35 @@ private:
     int _zIndex = 0;
     int _animationsCount = 0;
     int _lastChildrenIndexerId = 0;
-    RawViewNodeId _rawId = 0;
+    float _translationX = 0;
+    float _translationY = 0;
 
-    std::bitset<30> _flags;
+    Frame _calculatedViewport;
+    Frame _calculatedFrame;
+    Frame _viewFrame;
+    Frame _previousViewFrame;
 
     ViewNodeTree* _viewNodeTree = nullptr;
-
     Ref<View> _view;
+    Weak<ViewNode> _parent;
+    std::unique_ptr<ViewNodeChildrenIndexer> _childrenIndexer;
+
+    AttributeIds& _attributeIds;
+    ILogger& _logger;
+    std::unique_ptr<LazyLayoutData> _lazyLayoutData;
+
+    CSSAttributesManager _cssAttributesManager;
+    ViewNodeAttributesApplier _attributesApplier;
+    // Will be set for ViewNode used during measure passes.
+    Ref<ViewNode> _emittingViewNode;
+
+    std::unique_ptr<ViewNodeScrollState> _scrollState;
+    std::unique_ptr<ViewNodeAccessibilityState> _accessibilityState;
+    std::unique_ptr<ViewNodeCallbacks> _callbacks;
+
     Ref<ViewFactory> _viewFactory;
     Ref<IViewNodeAssetHandler> _assetHandler;
 
-    Ref<ValueFunction> _onViewCreatedCallback;
-    Ref<ValueFunction> _onViewDestroyedCallback;
-    Ref<ValueFunction> _onViewChangedCallback;
-    Ref<ValueFunction> _onLayoutCompletedCallback;
-
     void layoutFinished(ViewTransactionScope& viewTransactionScope, bool didPerformLayout);
     void layoutFinished(ViewTransactionScope& viewTransactionScope,
                         bool didPerformLayout,
@@ -652,6 +709,11 @@ private:
     void setViewFrameNeedsUpdate();
 
     bool updateLazyLayout();
+    void calculateLazyLayoutsInParallel(bool didPerformLayout);
+    void collectPendingLazyLayouts(bool didPerformLayout, std::vector<PendingLazyLayout>& pendingLazyLayouts);
+    bool hasExternalMeasureInLazyLayout() const;
+    void prelayoutLazyLayout();
+    void prelayout(const YGNode& parentYogaNode, float availableWidth, size_t& remainingNodesCount);
     void doUpdateViewTree(ViewTransactionScope& viewTransactionScope,
                           const Ref<View>& currentParentView,
                           bool parentVisibleInViewport,
@@ -723,6 +785,8 @@ private:
 
     ViewNodeScrollState& getOrCreateScrollState();
     ViewNodeAccessibilityState& getOrCreateAccessibilityState();
+    template<typename F>
+    auto readAccessibilityState(F&& fn) const;
 
     void getAccessibilityChildrenDeepWalk(std::vector<ViewNode*>& outChildren);
 
@@ -746,7 +810,7 @@ private:
                    int siblingsCount,
                    int indexAmongSiblings,
                    CSSUpdateResult& updateResult);
-    bool handleCSSChange(bool cssChanged);
+    bool handleCSSChange(CSSChange cssChange);
 
     void onFinishedAnimating();
 
@@ -768,6 +832,7 @@ private:
     bool isMemberOfAccessibilityTree();
 
     LazyLayoutData& getOrCreateLazyLayoutData();
+    ViewNodeCallbacks& getOrCreateCallbacks();
     YGNode* getLazyLayoutYogaNode() const;
     const YGNode* getContainerYogaNode() const;
 
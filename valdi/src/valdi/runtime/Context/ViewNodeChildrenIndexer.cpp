@@ -10,10 +10,15 @@
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace Valdi {
 
 ChildrenVisibilityResult::ChildrenVisibilityResult()
-    : visibleChildren(makeReusableArray<ViewNode*>()), invisibleChildren(makeReusableArray<ViewNode*>()) {}
+    : visibleChildren(makeReusableArray<ViewNode*>()),
+      invisibleChildren(makeReusableArray<ViewNode*>()),
+      upcomingChildren(makeReusableArray<ViewNode*>()) {}
 
 ViewNodeChildrenIndexer::ViewNodeChildrenIndexer(ViewNode* viewNode) : _viewNode(viewNode) {}
 
@@ -74,7 +79,72 @@ void ViewNodeChildrenIndexer::appendNodesIfNeeded(std::vector<ViewNode*>& output
     }
 }
 
-ChildrenVisibilityResult ViewNodeChildrenIndexer::findChildrenVisibility(const Frame& viewport) {
+void ViewNodeChildrenIndexer::appendUpcomingNodes(
+    std::vector<ViewNode*>& output, size_t from, size_t to, bool reversed, int updateId) {
+    for (size_t i = 0; i < to - from; i++) {
+        auto& cell = _cells[reversed ? to - i - 1 : from + i];
+        for (auto* node : cell) {
+            // Nodes which are also in a visible cell were already appended with this updateId
+            if (node->getLastChildrenIndexerId() != updateId &&
+                std::find(output.begin(), output.end(), node) == output.end()) {
+                output.emplace_back(node);
+            }
+        }
+    }
+}
+
+size_t ViewNodeChildrenIndexer::resolveVelocityLookahead(float velocity, size_t visibleCellsCount) const {
+    if (_cellSize == 0.0f || velocity == 0.0f || std::isnan(velocity)) {
+        return 0;
+    }
+
+    auto distance = std::min(std::abs(velocity) * kVelocityLookaheadDuration,
+                             static_cast<float>(visibleCellsCount * kMaxVelocityLookaheadViewports) * _cellSize);
+    return static_cast<size_t>(std::ceil(distance / _cellSize));
+}
+
+void ViewNodeChildrenIndexer::updateUpcomingNodes(std::vector<ViewNode*>& output,
+                                                  bool didFullUpdate,
+                                                  float velocity,
+                                                  int updateId) {
+    auto lookahead = _visibleUpperBound - _visibleLowerBound;
+    auto velocityLookahead = resolveVelocityLookahead(velocity, lookahead);
+    auto lowerLookahead = lookahead + (velocity < 0 ? velocityLookahead : 0);
+    auto upperLookahead = lookahead + (velocity > 0 ? velocityLookahead : 0);
+
+    auto upcomingLowerBound = _visibleLowerBound - std::min(lowerLookahead, _visibleLowerBound);
+    auto upcomingUpperBound = std::min(_visibleUpperBound + upperLookahead, _cells.size());
+
+    // Cells which entered the upcoming range since the last call. On full update, all
+    // the cells of the upcoming range are reported.
+    auto lowerFrom = upcomingLowerBound;
+    auto lowerTo = didFullUpdate ? _visibleLowerBound : std::min(_upcomingLowerBound, _visibleLowerBound);
+    auto upperFrom = didFullUpdate ? _visibleUpperBound : std::max(_upcomingUpperBound, _visibleUpperBound);
+    auto upperTo = upcomingUpperBound;
+
+    // Report the cells closest to the viewport in the scroll direction first
+    if (velocity < 0) {
+        if (lowerFrom < lowerTo) {
+            appendUpcomingNodes(output, lowerFrom, lowerTo, true, updateId);
+        }
+        if (upperFrom < upperTo) {
+            appendUpcomingNodes(output, upperFrom, upperTo, false, updateId);
+        }
+    } else {
+        if (upperFrom < upperTo) {
+            appendUpcomingNodes(output, upperFrom, upperTo, false, updateId);
+        }
+        if (lowerFrom < lowerTo) {
+            appendUpcomingNodes(output, lowerFrom, lowerTo, true, updateId);
+        }
+    }
+
+    _upcomingLowerBound = upcomingLowerBound;
+    _upcomingUpperBound = upcomingUpperBound;
+}
+
+ChildrenVisibilityResult ViewNodeChildrenIndexer::findChildrenVisibility(const Frame& viewport,
+                                                                         const Point& directionAgnosticVelocity) {
     auto updateId = ++_updateId;
     auto didFullUpdate = _needUpdate;
 
@@ -91,6 +161,11 @@ ChildrenVisibilityResult ViewNodeChildrenIndexer::findChildrenVisibility(const F
     ChildrenVisibilityResult result;
 
     appendNodesIfNeeded(*result.visibleChildren, _visibleLowerBound, _visibleUpperBound, updateId);
+    // Must be done before appending the invisible nodes, which also get tagged with the updateId
+    updateUpcomingNodes(*result.upcomingChildren,
+                        didFullUpdate,
+                        _horizontal ? directionAgnosticVelocity.x : directionAgnosticVelocity.y,
+                        updateId);
 
     if (didFullUpdate) {
         // On full update, we append all the invisible nodes in the output since the nodes
@@ -21,12 +21,20 @@ namespace Valdi {
 class ViewNode;
 
 constexpr size_t kMaxChildrenBeforeIndexing = 10;
+// Duration in seconds of scrolling at the current velocity that the upcoming range covers.
+constexpr float kVelocityLookaheadDuration = 0.3f;
+// Maximum number of viewport lengths the upcoming range gets extended by from the velocity.
+constexpr size_t kMaxVelocityLookaheadViewports = 3;
 
 struct ChildrenVisibilityResult {
     // Children which are visible;
     ReusableArray<ViewNode*> visibleChildren;
     // Children which became invisible
     ReusableArray<ViewNode*> invisibleChildren;
+    // Invisible children which entered the range of one viewport length around the visible
+    // children, extended in the scroll direction while flinging, and which are therefore likely
+    // to become visible soon. Ordered from the closest to the furthest in the scroll direction.
+    ReusableArray<ViewNode*> upcomingChildren;
 
     ChildrenVisibilityResult();
 };
@@ -40,13 +48,20 @@ public:
     void setNeedsUpdate();
     bool needsUpdate() const;
 
-    ChildrenVisibilityResult findChildrenVisibility(const Frame& viewport);
+    /**
+     Find the children visibility changes for the given viewport. The directionAgnosticVelocity,
+     in points per second, extends the range of upcoming children in the scroll direction.
+     */
+    ChildrenVisibilityResult findChildrenVisibility(const Frame& viewport,
+                                                    const Point& directionAgnosticVelocity = Point());
 
 private:
     ViewNode* _viewNode;
     std::vector<SmallVector<ViewNode*, 2>> _cells;
     size_t _visibleLowerBound = 0;
     size_t _visibleUpperBound = 0;
+    size_t _upcomingLowerBound = 0;
+    size_t _upcomingUpperBound = 0;
     float _cellSize = 0;
     int _updateId = 0;
     bool _horizontal = false;
@@ -59,6 +74,12 @@ private:
     void insertNodeInCells(ViewNode* viewNode, float start, float end);
 
     void appendNodesIfNeeded(std::vector<ViewNode*>& output, size_t from, size_t to, int updateId);
+
+    void appendUpcomingNodes(std::vector<ViewNode*>& output, size_t from, size_t to, bool reversed, int updateId);
+
+    void updateUpcomingNodes(std::vector<ViewNode*>& output, bool didFullUpdate, float velocity, int updateId);
+
+    size_t resolveVelocityLookahead(float velocity, size_t visibleCellsCount) const;
 };
 
 } // namespace Valdi
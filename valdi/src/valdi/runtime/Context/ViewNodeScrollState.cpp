@@ -6,6 +6,7 @@
 //
 
 #include "valdi/runtime/Context/ViewNodeScrollState.hpp"
+#include "valdi/runtime/Context/ScrollLinkedEffects.hpp"
 #include "valdi/runtime/Views/Measure.hpp"
 #include "valdi_core/cpp/Events/TouchEvents.hpp"
 
@@ -47,6 +48,14 @@ const Point& ViewNodeScrollState::getDirectionAgnosticContentOffset() const {
     return _directionAgnosticContentOffset;
 }
 
+const Point& ViewNodeScrollState::getDirectionAgnosticVelocity() const {
+    return _directionAgnosticVelocity;
+}
+
+void ViewNodeScrollState::setDirectionAgnosticVelocity(const Point& directionAgnosticVelocity) {
+    _directionAgnosticVelocity = directionAgnosticVelocity;
+}
+
 Point ViewNodeScrollState::getDirectionDependentContentOffset() const {
     return resolveDirectionDependentContentOffset(_directionAgnosticContentOffset);
 }
@@ -432,6 +441,14 @@ void ViewNodeScrollState::setOnContentSizeChangeCallback(Ref<ValueFunction>&& on
     _onContentSizeChangeCallback = std::move(onContentSizeChangeCallback);
 }
 
+const Ref<ScrollLinkedEffects>& ViewNodeScrollState::getScrollLinkedEffects() const {
+    return _scrollLinkedEffects;
+}
+
+void ViewNodeScrollState::setScrollLinkedEffects(Ref<ScrollLinkedEffects>&& scrollLinkedEffects) {
+    _scrollLinkedEffects = std::move(scrollLinkedEffects);
+}
+
 void ViewNodeScrollState::setOnDragEndCallback(Ref<ValueFunction>&& onDragEndCallback) {
     _onDragEndCallback = std::move(onDragEndCallback);
 }
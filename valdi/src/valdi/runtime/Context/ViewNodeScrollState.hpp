@@ -14,6 +14,8 @@
 
 namespace Valdi {
 
+class ScrollLinkedEffects;
+
 struct ViewNodeScrollStateUpdateContentSizeResult {
     bool changed = false;
     bool contentOffsetAdjusted = false;
@@ -37,6 +39,9 @@ public:
 
     const Point& getDirectionAgnosticContentOffset() const;
 
+    const Point& getDirectionAgnosticVelocity() const;
+    void setDirectionAgnosticVelocity(const Point& directionAgnosticVelocity);
+
     Point getDirectionDependentContentOffset() const;
     void resolveClipRect(Frame& outClipRect) const;
 
@@ -94,6 +99,9 @@ public:
     void setOnDragEndCallback(Ref<ValueFunction>&& onDragEndCallback);
     void setOnContentSizeChangeCallback(Ref<ValueFunction>&& onContentSizeChangeCallback);
 
+    const Ref<ScrollLinkedEffects>& getScrollLinkedEffects() const;
+    void setScrollLinkedEffects(Ref<ScrollLinkedEffects>&& scrollLinkedEffects);
+
     void setViewportExtensionTop(float viewportExtensionTop);
     void setViewportExtensionBottom(float viewportExtensionBottom);
     void setViewportExtensionLeft(float viewportExtensionLeft);
@@ -104,6 +112,7 @@ public:
 private:
     Point _directionAgnosticContentOffset;
     Point _directionAgnosticUnclampedContentOffset;
+    Point _directionAgnosticVelocity;
     Size _contentSize;
     Size _viewportSize;
 
@@ -128,6 +137,7 @@ private:
     Ref<ValueFunction> _onDragEndingCallback;
     Ref<ValueFunction> _onDragEndCallback;
     Ref<ValueFunction> _onContentSizeChangeCallback;
+    Ref<ScrollLinkedEffects> _scrollLinkedEffects;
 
     static void submitScrollEvent(const Ref<ValueFunction>& callback,
                                   ValueFunctionFlags callFlags,
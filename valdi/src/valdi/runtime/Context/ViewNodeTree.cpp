@@ -72,6 +72,8 @@ void ViewNodeTree::clear() {
     _runtime = nullptr;
     _viewFactories.clear();
     _updateFunctions.clear();
+    _dirtyRelayoutBoundaries.clear();
+    invalidateNodeIdIndex();
 }
 
 Ref<View> ViewNodeTree::getViewForNodePath(const ViewNodePath& nodePath) const {
@@ -92,7 +94,7 @@ Ref<ViewNode> ViewNodeTree::getViewNodeForNodePath(const ViewNodePath& nodePath)
     std::vector<SharedViewNode> nodes;
 
     for (const auto& entry : nodePath.getEntries()) {
-        current->findAllNodesWithId(entry.nodeId, nodes);
+        findAllNodesWithId(current, entry.nodeId, nodes);
 
         if (nodes.empty()) {
             return nullptr;
@@ -110,10 +112,75 @@ Ref<ViewNode> ViewNodeTree::getViewNodeForNodePath(const ViewNodePath& nodePath)
     return current;
 }
 
+void ViewNodeTree::findAllNodesWithId(const Ref<ViewNode>& ancestor,
+                                      const StringBox& nodeId,
+                                      std::vector<SharedViewNode>& output) const {
+    if (ancestor->getCSSAttributesManager().hasNodeId(nodeId)) {
+        output.emplace_back(ancestor);
+        return;
+    }
+
+    if (!_nodeIdIndexValid) {
+        _nodeIdIndex.clear();
+        if (_rootViewNode != nullptr) {
+            buildNodeIdIndex(_rootViewNode.get());
+        }
+        _nodeIdIndexValid = true;
+    }
+
+    const auto& it = _nodeIdIndex.find(nodeId);
+    if (it == _nodeIdIndex.end()) {
+        return;
+    }
+
+    for (const auto& candidate : it->second) {
+        // Keep the candidates within the subtree of the ancestor, which are not nested in another match
+        auto parent = candidate->getParent();
+        while (parent != nullptr && parent != ancestor && !parent->getCSSAttributesManager().hasNodeId(nodeId)) {
+            parent = parent->getParent();
+        }
+
+        if (parent == ancestor) {
+            output.emplace_back(candidate);
+        }
+    }
+}
+
+void ViewNodeTree::buildNodeIdIndex(ViewNode* viewNode) const {
+    auto& cssAttributesManager = viewNode->getCSSAttributesManager();
+    auto nodeId = cssAttributesManager.getNodeId();
+    if (!nodeId.isEmpty()) {
+        _nodeIdIndex[nodeId].emplace_back(strongSmallRef(viewNode));
+    }
+    auto nodeIdOverridenFromParent = cssAttributesManager.getNodeIdOverridenFromParent();
+    if (!nodeIdOverridenFromParent.isEmpty() && nodeIdOverridenFromParent != nodeId) {
+        _nodeIdIndex[nodeIdOverridenFromParent].emplace_back(strongSmallRef(viewNode));
+    }
+
+    for (auto* child : *viewNode) {
+        buildNodeIdIndex(child);
+    }
+}
+
+void ViewNodeTree::invalidateNodeIdIndex() {
+    if (_nodeIdIndexValid) {
+        _nodeIdIndexValid = false;
+        _nodeIdIndex.clear();
+    }
+}
+
 const Ref<ViewNode>& ViewNodeTree::getRootViewNode() const {
     return _rootViewNode;
 }
 
+ViewNodeTreeInfo ViewNodeTree::dumpTreeInfo() const {
+    auto guard = lock();
+    if (_rootViewNode == nullptr) {
+        return ViewNodeTreeInfo();
+    }
+    return _rootViewNode->dumpTreeInfo();
+}
+
 Ref<View> ViewNodeTree::getRootView() const {
     if (_rootView != nullptr) {
         return _rootView;
@@ -255,9 +322,12 @@ void ViewNodeTree::performUpdates() {
 
     if (_layoutDirty) {
         _layoutDirty = false;
+        ScopedFramePhase framePhase(FramePhase::Layout);
         rootViewNode->performLayout(getCurrentViewTransactionScope(), _layoutSize, _layoutDirection);
     }
 
+    performRelayoutBoundariesLayout(*rootViewNode);
+
     flushOnLayoutCallbacks();
 
     rootViewNode->updateVisibilityAndPerformUpdates(getCurrentViewTransactionScope());
@@ -291,6 +361,16 @@ bool ViewNodeTree::retainsLayoutSpecsOnInvalidateLayout() const {
     return _retainsLayoutSpecsOnInvalidateLayout;
 }
 
+void ViewNodeTree::setParallelLayoutEnabled(bool parallelLayoutEnabled) {
+    auto lockGuard = lock();
+    _parallelLayoutEnabled = parallelLayoutEnabled;
+}
+
+bool ViewNodeTree::isParallelLayoutEnabled() const {
+    auto lockGuard = lock();
+    return _parallelLayoutEnabled;
+}
+
 void ViewNodeTree::setLayoutSpecs(Size layoutSize, LayoutDirection layoutDirection) {
     auto lockGuard = lock();
     _hasLayoutSpecs = true;
@@ -335,6 +415,31 @@ void ViewNodeTree::onLayoutDirty() {
     }
 }
 
+void ViewNodeTree::onRelayoutBoundaryDirty(ViewNode* viewNode) {
+    _dirtyRelayoutBoundaries.emplace_back(strongSmallRef(viewNode));
+    schedulePerformUpdates();
+}
+
+void ViewNodeTree::performRelayoutBoundariesLayout(ViewNode& rootViewNode) {
+    if (_dirtyRelayoutBoundaries.empty()) {
+        return;
+    }
+
+    ScopedFramePhase framePhase(FramePhase::Layout);
+    auto dirtyRelayoutBoundaries = std::move(_dirtyRelayoutBoundaries);
+    _dirtyRelayoutBoundaries.clear();
+
+    for (const auto& viewNode : dirtyRelayoutBoundaries) {
+        // The boundary might have been laid out as part of the layout of one of its ancestors,
+        // or might have been removed from the tree since it was dirtied.
+        if (!viewNode->isRelayoutBoundaryDirty() || viewNode->getRoot().get() != &rootViewNode) {
+            continue;
+        }
+
+        viewNode->performRelayoutBoundaryLayout(getCurrentViewTransactionScope());
+    }
+}
+
 void ViewNodeTree::onRootViewNodeNeedsUpdate() {
     schedulePerformUpdates();
 }
@@ -497,6 +602,7 @@ void ViewNodeTree::setRootViewNode(Ref<ViewNode> rootViewNode, bool useDefaultVi
     auto& viewTransactionScope = getCurrentViewTransactionScope();
 
     _rootViewNode = std::move(rootViewNode);
+    invalidateNodeIdIndex();
 
     if (_rootViewNode != nullptr) {
         _rootViewNode->removeFromParent(viewTransactionScope);
@@ -534,6 +640,61 @@ void ViewNodeTree::addViewNode(const Ref<ViewNode>& viewNode) {
     }
 }
 
+void ViewNodeTree::markViewNodesAsPrerendered() {
+    for (const auto& it : _rawViewNodes) {
+        _prerenderedViewNodeIds.insert(it.first);
+    }
+}
+
+bool ViewNodeTree::hasPrerenderedViewNodes() const {
+    return !_prerenderedViewNodeIds.empty();
+}
+
+Ref<ViewNode> ViewNodeTree::adoptPrerenderedViewNode(RawViewNodeId id, const StringBox& viewClassName) {
+    const auto& it = _prerenderedViewNodeIds.find(id);
+    if (it == _prerenderedViewNodeIds.end()) {
+        return nullptr;
+    }
+    _prerenderedViewNodeIds.erase(it);
+
+    auto viewNode = getViewNode(id);
+    if (viewNode == nullptr) {
+        return nullptr;
+    }
+
+    // The root view node always uses the default view factory
+    if (viewNode != _rootViewNode && viewNode->getViewClassName() != viewClassName) {
+        removePrerenderedViewNode(viewNode);
+        return nullptr;
+    }
+
+    return viewNode;
+}
+
+void ViewNodeTree::removePrerenderedViewNodes() {
+    auto prerenderedViewNodeIds = std::move(_prerenderedViewNodeIds);
+    _prerenderedViewNodeIds.clear();
+
+    for (auto id : prerenderedViewNodeIds) {
+        auto viewNode = getViewNode(id);
+        if (viewNode != nullptr) {
+            removePrerenderedViewNode(viewNode);
+        }
+    }
+}
+
+void ViewNodeTree::removePrerenderedViewNode(const Ref<ViewNode>& viewNode) {
+    auto& viewTransactionScope = getCurrentViewTransactionScope();
+
+    // The children might have been adopted, they are detached instead of being removed along with their parent.
+    // The ones which were not adopted are removed on their own.
+    while (viewNode->getChildCount() > 0) {
+        viewNode->getChildAt(viewNode->getChildCount() - 1)->removeFromParent(viewTransactionScope);
+    }
+
+    removeViewNode(viewNode->getRawId());
+}
+
 void ViewNodeTree::setKeepViewAliveOnDestroy(bool keepViewAliveOnDestroy) {
     if (_keepViewAliveOnDestroy != keepViewAliveOnDestroy) {
         _keepViewAliveOnDestroy = keepViewAliveOnDestroy;
@@ -657,6 +818,8 @@ void ViewNodeTree::runUpdates() {
 
 void ViewNodeTree::runUpdatesInner() {
     VALDI_TRACE("Valdi.runTreeUpdates")
+    ScopedFrameMetrics frameMetrics(
+        FrameMetricsAggregator::shared(), _context->getPath().getResourceId().bundleName, FramePhase::ViewTreeUpdate);
 
     ContextEntry contextEntry(_context);
     auto viewTransactionScope = beginViewTransaction();
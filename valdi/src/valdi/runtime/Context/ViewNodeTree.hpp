@@ -18,6 +18,7 @@
 #include "valdi/runtime/Views/ViewFactory.hpp"
 #include "valdi/runtime/Views/ViewTransactionScope.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/TrackedLock.hpp"
 #include "valdi_core/cpp/Utils/ValdiObject.hpp"
@@ -81,8 +82,26 @@ public:
      */
     Ref<ViewNode> getViewNodeForNodePath(const ViewNodePath& nodePath) const;
 
+    /**
+     Find the nodes with the given id within the subtree of the given node attached to the root,
+     without looking into the subtrees of the matching nodes. This has the same result as
+     ViewNode::findAllNodesWithId(), but resolves the candidates from an index of the nodes by id
+     which is lazily built from the root and invalidated whenever the hierarchy or an id changes.
+     */
+    void findAllNodesWithId(const Ref<ViewNode>& ancestor,
+                            const StringBox& nodeId,
+                            std::vector<SharedViewNode>& output) const;
+
+    void invalidateNodeIdIndex();
+
     const Ref<ViewNode>& getRootViewNode() const;
 
+    /**
+     Returns the number of nodes and views of the tree, along with an estimate
+     of the native memory they retain.
+     */
+    ViewNodeTreeInfo dumpTreeInfo() const;
+
     Ref<View> getRootView() const;
 
     /**
@@ -160,6 +179,25 @@ public:
     Ref<ViewNode> getViewNode(RawViewNodeId id);
     void setRootViewNode(Ref<ViewNode> rootViewNode, bool useDefaultViewFactory);
 
+    /**
+     Mark all the view nodes currently in the tree as prerendered. Prerendered view nodes were created
+     from a RenderRequest generated at compile time, and are adopted by the first render from JS which
+     creates an element with the same id and view class, instead of being re-created.
+     */
+    void markViewNodesAsPrerendered();
+    bool hasPrerenderedViewNodes() const;
+
+    /**
+     Returns the prerendered view node with the given id if it can be adopted by an element of the given
+     view class, and stops tracking it as prerendered.
+     */
+    Ref<ViewNode> adoptPrerenderedViewNode(RawViewNodeId id, const StringBox& viewClassName);
+
+    /**
+     Remove the prerendered view nodes which were not adopted.
+     */
+    void removePrerenderedViewNodes();
+
     bool keepViewAliveOnDestroy() const;
     void setKeepViewAliveOnDestroy(bool keepViewAliveOnDestroy);
 
@@ -171,6 +209,16 @@ public:
     void setRetainsLayoutSpecsOnInvalidateLayout(bool retainsLayoutSpecsOnInvalidateLayout);
     bool retainsLayoutSpecsOnInvalidateLayout() const;
 
+    /**
+     Set whether the lazy layout subtrees which need to be calculated should be laid out concurrently
+     on the shared ThreadPool. Each lazy layout has its own detached Yoga tree with a size resolved by the
+     parent layout, so they can be calculated independently before the single-threaded pass that applies
+     the frames. Subtrees using an onMeasure callback are always calculated on the calling thread.
+     This should only be enabled when the measure delegates of the views in the tree are thread safe.
+     */
+    void setParallelLayoutEnabled(bool parallelLayoutEnabled);
+    bool isParallelLayoutEnabled() const;
+
     /**
      Schedule an exclusive update function, which will be called once
      all the pending exclusive updates have finished running.
@@ -221,6 +269,13 @@ public:
     void onLayoutDirty();
     void onRootViewNodeNeedsUpdate();
 
+    /**
+     Called when a relayout boundary was dirtied by one of its descendants. The boundary
+     will be laid out on its own in the next update pass, without invalidating the layout
+     of the whole tree.
+     */
+    void onRelayoutBoundaryDirty(ViewNode* viewNode);
+
     // Unsafe to call unless the ViewNodeTree lock is acquired.
     ViewTransactionScope& getCurrentViewTransactionScope();
     const Ref<ViewTransactionScope>& getCurrentViewTransactionScopeRef();
@@ -235,6 +290,10 @@ public:
     TrackedLock lock() const;
 
 private:
+    void removePrerenderedViewNode(const Ref<ViewNode>& viewNode);
+
+    void buildNodeIdIndex(ViewNode* viewNode) const;
+
     SharedContext _context;
     Ref<ViewManagerContext> _viewManagerContext;
     IViewManager* _viewManager;
@@ -242,6 +301,10 @@ private:
 
     FlatMap<StringBox, Ref<ViewFactory>> _viewFactories;
     FlatMap<RawViewNodeId, Ref<ViewNode>> _rawViewNodes;
+    FlatSet<RawViewNodeId> _prerenderedViewNodeIds;
+    // The nodes attached to the root by id, in depth first order
+    mutable FlatMap<StringBox, std::vector<Ref<ViewNode>>> _nodeIdIndex;
+    mutable bool _nodeIdIndexValid = false;
     Ref<ViewNode> _rootViewNode;
     Ref<ViewNodesVisibilityObserver> _visibilityObserver;
     Ref<ViewNodesFrameObserver> _framesObserver;
@@ -252,7 +315,8 @@ private:
     Ref<ViewTransactionScope> _currentViewTransactionScope;
     std::deque<ViewNodeTreeUpdates> _updateFunctions;
     std::vector<Ref<ValueFunction>> _onLayoutCallbacks;
-    mutable RecursiveMutex _mutex;
+    std::vector<Ref<ViewNode>> _dirtyRelayoutBoundaries;
+    mutable RecursiveMutex _mutex{"ViewNodeTree"};
 
     FlatMap<AnimationCancelToken, SharedAnimator> _pendingCancellableAnimations;
 
@@ -282,6 +346,7 @@ private:
     bool _scheduledPerformUpdates = false;
     bool _viewInflationEnabled = true;
     bool _retainsLayoutSpecsOnInvalidateLayout = false;
+    bool _parallelLayoutEnabled = false;
     int _disableUpdatesCounter = 0;
     int _beginViewTransactionCounter = 0;
     size_t _layoutDirtyCounter = 0;
@@ -293,6 +358,7 @@ private:
     void runUpdatesInner();
 
     void flushOnLayoutCallbacks();
+    void performRelayoutBoundariesLayout(ViewNode& rootViewNode);
 
     void schedulePerformUpdates();
     void performUpdatesIfLayoutSpecsUpToDate();
@@ -8,8 +8,10 @@
 #include "valdi/runtime/Context/ViewNodesVisibilityObserver.hpp"
 #include "valdi/runtime/Context/Context.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/TimePoint.hpp"
 #include "valdi_core/cpp/Utils/ValueFunctionWithCallable.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
 
 namespace Valdi {
 
@@ -37,29 +39,33 @@ void ViewNodesVisibilityObserver::flush(const Ref<Context>& context) {
         }
     }
 
-    auto visibleIds = ValueArray::make(visibleIdsSize);
-    auto invisibleIds = ValueArray::make(invisibleIdsSize);
-    size_t visibleIdsIndex = 0;
-    size_t invisibleIdsIndex = 0;
+    auto updatesSize = kVisibilityUpdatesHeaderSize + visibleIdsSize + invisibleIdsSize +
+                       _viewportUpdates.size() * kViewportUpdateSize;
+    auto buffer = makeShared<ByteBuffer>();
+    auto* updates = reinterpret_cast<double*>(buffer->appendWritable(updatesSize * sizeof(double)));
+
+    updates[0] = static_cast<double>(visibleIdsSize);
+    updates[1] = static_cast<double>(invisibleIdsSize);
+
+    auto* visibleIds = updates + kVisibilityUpdatesHeaderSize;
+    auto* invisibleIds = visibleIds + visibleIdsSize;
 
     for (const auto& it : _visibilityUpdates) {
         if (it.second) {
-            (*visibleIds)[visibleIdsIndex++] = Value(it.first);
+            *visibleIds++ = static_cast<double>(it.first);
         } else {
-            (*invisibleIds)[invisibleIdsIndex++] = Value(it.first);
+            *invisibleIds++ = static_cast<double>(it.first);
         }
     }
 
-    auto viewportUpdates = ValueArray::make(_viewportUpdates.size() * 5);
-
-    size_t index = 0;
+    auto* viewportUpdates = invisibleIds;
     for (const auto& it : _viewportUpdates) {
-        auto frame = it.second;
-        viewportUpdates->emplace(index++, Value(it.first));
-        viewportUpdates->emplace(index++, Value(frame.x));
-        viewportUpdates->emplace(index++, Value(frame.y));
-        viewportUpdates->emplace(index++, Value(frame.width));
-        viewportUpdates->emplace(index++, Value(frame.height));
+        const auto& frame = it.second;
+        *viewportUpdates++ = static_cast<double>(it.first);
+        *viewportUpdates++ = static_cast<double>(frame.x);
+        *viewportUpdates++ = static_cast<double>(frame.y);
+        *viewportUpdates++ = static_cast<double>(frame.width);
+        *viewportUpdates++ = static_cast<double>(frame.height);
     }
 
     _visibilityUpdates.clear();
@@ -84,8 +90,8 @@ void ViewNodesVisibilityObserver::flush(const Ref<Context>& context) {
             return Value::undefined();
         });
 
-    (*_callback)(
-        {Value(visibleIds), Value(invisibleIds), Value(viewportUpdates), Value(callback), Value(eventTime.getTime())});
+    auto updatesArray = makeShared<ValueTypedArray>(TypedArrayType::Float64Array, buffer->toBytesView());
+    (*_callback)({Value(updatesArray), Value(callback), Value(eventTime.getTime())});
 }
 
 void ViewNodesVisibilityObserver::onFlushAcknowledged(const Ref<Context>& context) {
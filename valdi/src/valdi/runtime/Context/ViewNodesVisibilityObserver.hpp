@@ -19,8 +19,16 @@ namespace Valdi {
 class MainThreadManager;
 class Context;
 
+/**
+ Collects the visibility and viewport changes of the ViewNodes of a tree, and sends them to JS
+ on flush as a single Float64Array laid out as:
+ [visibleIdsCount, invisibleIdsCount, visibleIds..., invisibleIds..., (id, x, y, width, height)...]
+ */
 class ViewNodesVisibilityObserver : public SharedPtrRefCountable {
 public:
+    static constexpr size_t kVisibilityUpdatesHeaderSize = 2;
+    static constexpr size_t kViewportUpdateSize = 5;
+
     explicit ViewNodesVisibilityObserver(MainThreadManager* mainThreadManager);
     ~ViewNodesVisibilityObserver() override;
 
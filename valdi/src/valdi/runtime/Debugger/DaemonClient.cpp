@@ -8,6 +8,7 @@
 #include "valdi/runtime/Debugger/DaemonClient.hpp"
 
 #include "valdi_core/cpp/Resources/ValdiPacket.hpp"
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
@@ -16,7 +17,6 @@
 #include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
 #include "valdi_core/cpp/Utils/ValueUtils.hpp"
 
-#include "utils/encoding/Base64Utils.hpp"
 
 namespace Valdi {
 
@@ -117,7 +117,7 @@ static BytesView getDataBytesForKey(const Value& value, std::string_view stringK
 
     auto base64String = value.getMapValue(base64Key).toStringBox();
     auto data = makeShared<Bytes>();
-    snap::utils::encoding::base64ToBinary(base64String.toStringView(), *data);
+    Base64Codec::decode(base64String.toStringView(), *data);
     return BytesView(data);
 }
 
@@ -289,6 +289,68 @@ void DaemonClient::sendJsDebuggerInfo(uint16_t port, const std::vector<StringBox
     submitPayload(json);
 }
 
+void DaemonClient::sendJsSamplingProfile(int64_t samplingIntervalMs,
+                                         int64_t samplesCount,
+                                         const std::string& foldedStacks) {
+    Value profile = Value()
+                        .setMapValue("sampling_interval_ms", Value(samplingIntervalMs))
+                        .setMapValue("samples_count", Value(samplesCount))
+                        .setMapValue("folded_stacks", Value(foldedStacks));
+    Value json = Value().setMapValue("event", Value().setMapValue("js_sampling_profile", profile));
+    submitPayload(json);
+}
+
+void DaemonClient::sendLockContentionReport(const Value& report) {
+    Value json = Value().setMapValue("event", Value().setMapValue("lock_contention_report", report));
+    submitPayload(json);
+}
+
+void DaemonClient::sendStartupTimelineReport(const Value& report) {
+    Value json = Value().setMapValue("event", Value().setMapValue("startup_timeline_report", report));
+    submitPayload(json);
+}
+
+static int64_t toMicroseconds(std::chrono::steady_clock::duration duration) {
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void DaemonClient::sendFrameMetricsSummary(const StringBox& module, const FrameMetricsSummary& summary) {
+    Value bridgeCrossings;
+    for (size_t i = 0; i < kBridgeCrossingTypesCount; i++) {
+        auto type = static_cast<BridgeCrossingType>(i);
+        auto count = static_cast<int64_t>(summary.bridgeCrossings.getCount(type));
+        auto durationUs = toMicroseconds(summary.bridgeCrossings.getDuration(type));
+        bridgeCrossings.setMapValue(
+            bridgeCrossingTypeToString(type),
+            Value().setMapValue("count", Value(count)).setMapValue("estimated_duration_us", Value(durationUs)));
+    }
+
+    Value frameMetrics =
+        Value()
+            .setMapValue("module", Value(module))
+            .setMapValue("period_ms",
+                         Value(static_cast<int64_t>(
+                             std::chrono::duration_cast<std::chrono::milliseconds>(summary.period).count())))
+            .setMapValue("frames_count", Value(static_cast<int64_t>(summary.frameTimes.getCount())))
+            .setMapValue("janky_frames_count", Value(static_cast<int64_t>(summary.jankyFramesCount)))
+            .setMapValue("p50_frame_time_us",
+                         Value(static_cast<int64_t>(summary.frameTimes.getValueAtPercentile(50).count())))
+            .setMapValue("p95_frame_time_us",
+                         Value(static_cast<int64_t>(summary.frameTimes.getValueAtPercentile(95).count())))
+            .setMapValue("bridge_crossings", bridgeCrossings)
+            .setMapValue("max_bridge_crossings_per_frame",
+                         Value(static_cast<int64_t>(summary.maxBridgeCrossingsPerFrame)))
+            .setMapValue("gpu_bound_frames_count", Value(static_cast<int64_t>(summary.gpuBoundFramesCount)))
+            .setMapValue("p50_gpu_time_us", Value(toMicroseconds(summary.gpuTimes.getValueAtPercentile(50))))
+            .setMapValue("p95_gpu_time_us", Value(toMicroseconds(summary.gpuTimes.getValueAtPercentile(95))))
+            .setMapValue("p50_present_latency_us",
+                         Value(toMicroseconds(summary.presentLatencies.getValueAtPercentile(50))))
+            .setMapValue("p95_present_latency_us",
+                         Value(toMicroseconds(summary.presentLatencies.getValueAtPercentile(95))));
+    Value json = Value().setMapValue("event", Value().setMapValue("frame_metrics_summary", frameMetrics));
+    submitPayload(json);
+}
+
 DaemonClientPendingResponse::DaemonClientPendingResponse(Function<void(const Value&)> handler)
     : handler(std::move(handler)) {}
 
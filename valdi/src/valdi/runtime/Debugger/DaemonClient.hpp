@@ -16,6 +16,7 @@
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/Error.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
@@ -84,6 +85,16 @@ public:
 
     void sendJsDebuggerInfo(uint16_t port, const std::vector<StringBox>& websocketTargets) override;
 
+    void sendJsSamplingProfile(int64_t samplingIntervalMs,
+                               int64_t samplesCount,
+                               const std::string& foldedStacks) override;
+
+    void sendLockContentionReport(const Value& report);
+
+    void sendStartupTimelineReport(const Value& report);
+
+    void sendFrameMetricsSummary(const StringBox& module, const FrameMetricsSummary& summary);
+
 private:
     DaemonClientListener* _listener;
     int _connectionId;
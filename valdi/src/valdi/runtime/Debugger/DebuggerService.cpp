@@ -230,6 +230,27 @@ void DebuggerService::willLog(LogType type, const std::string& message) {
     }
 }
 
+void DebuggerService::sendLockContentionReport(const Value& report) {
+    std::lock_guard<Mutex> guard(_mutex);
+    for (const auto& daemonClient : _clients) {
+        daemonClient->sendLockContentionReport(report);
+    }
+}
+
+void DebuggerService::sendStartupTimelineReport(const Value& report) {
+    std::lock_guard<Mutex> guard(_mutex);
+    for (const auto& daemonClient : _clients) {
+        daemonClient->sendStartupTimelineReport(report);
+    }
+}
+
+void DebuggerService::sendFrameMetricsSummary(const StringBox& module, const FrameMetricsSummary& summary) {
+    std::lock_guard<Mutex> guard(_mutex);
+    for (const auto& daemonClient : _clients) {
+        daemonClient->sendFrameMetricsSummary(module, summary);
+    }
+}
+
 void DebuggerService::didReceiveUpdatedResources(const SharedVector<Shared<Resource>>& resources) {
     std::lock_guard<Mutex> lock(_mutex);
     for (const auto& resource : *resources) {
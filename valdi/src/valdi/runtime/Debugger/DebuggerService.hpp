@@ -69,6 +69,24 @@ public:
 
     uint16_t getBoundPort();
 
+    /**
+     Send the given lock contention report, as produced by the LockContentionProfiler,
+     to all the connected daemon clients.
+     */
+    void sendLockContentionReport(const Value& report);
+
+    /**
+     Send the given startup timeline report, as produced by the StartupTimeline,
+     to all the connected daemon clients.
+     */
+    void sendStartupTimelineReport(const Value& report);
+
+    /**
+     Send the given frame metrics summary, including the bridge crossings made by the frames,
+     to all the connected daemon clients.
+     */
+    void sendFrameMetricsSummary(const StringBox& module, const FrameMetricsSummary& summary);
+
     static uint32_t resolveDebuggerPort(bool isStandalone);
 
 protected:
@@ -26,6 +26,13 @@ public:
     virtual void submitRequest(const Value& payload, const Ref<ValueFunction>& callback) = 0;
 
     virtual void sendJsDebuggerInfo(uint16_t port, const std::vector<StringBox>& websocketTargets) = 0;
+
+    /**
+     Send the JS stacks sampled by the sampling profiler, in the folded format.
+     */
+    virtual void sendJsSamplingProfile(int64_t samplingIntervalMs,
+                                       int64_t samplesCount,
+                                       const std::string& foldedStacks) = 0;
 };
 
 } // namespace Valdi
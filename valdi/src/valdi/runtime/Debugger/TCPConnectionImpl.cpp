@@ -7,10 +7,12 @@
 
 #include "valdi/runtime/Debugger/TCPConnectionImpl.hpp"
 #include "valdi_core/cpp/Utils/ObjectPool.hpp"
+#include <algorithm>
 
 namespace Valdi {
 
 constexpr size_t kBufferSize = 8192;
+constexpr size_t kMaxBuffersPerWrite = 64;
 using ArrayBuffer = std::array<Byte, kBufferSize>;
 
 void cleanUpBuffer(ArrayBuffer& /*arrayBuffer*/) {}
@@ -56,20 +58,33 @@ void TCPConnectionImpl::lockFreeDoSend() {
         return;
     }
 
-    auto bytes = _pendingPackets.front();
+    // Packets submitted while the previous write was in flight are corked into a single gather write
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.reserve(std::min(_pendingPackets.size(), kMaxBuffersPerWrite));
+    for (const auto& bytes : _pendingPackets) {
+        if (buffers.size() == kMaxBuffersPerWrite) {
+            break;
+        }
+        buffers.emplace_back(bytes.data(), bytes.size());
+    }
+
+    auto packetsCount = buffers.size();
 
-    boost::asio::async_write(_socket,
-                             boost::asio::buffer(bytes.data(), bytes.size()),
-                             [strongSelf = strongSmallRef(this)](boost::system::error_code ec, std::size_t /*length*/) {
-                                 if (ec.failed()) {
-                                     strongSelf->close(errorFromBoostError(ec));
-                                     return;
-                                 }
+    boost::asio::async_write(
+        _socket,
+        buffers,
+        [strongSelf = strongSmallRef(this), packetsCount](boost::system::error_code ec, std::size_t /*length*/) {
+            if (ec.failed()) {
+                strongSelf->close(errorFromBoostError(ec));
+                return;
+            }
 
-                                 std::lock_guard<Mutex> guard(strongSelf->_mutex);
-                                 strongSelf->_pendingPackets.pop_front();
-                                 strongSelf->lockFreeDoSend();
-                             });
+            std::lock_guard<Mutex> guard(strongSelf->_mutex);
+            strongSelf->_pendingPackets.erase(strongSelf->_pendingPackets.begin(),
+                                              strongSelf->_pendingPackets.begin() +
+                                                  static_cast<std::ptrdiff_t>(packetsCount));
+            strongSelf->lockFreeDoSend();
+        });
 }
 
 void TCPConnectionImpl::close(const Error& error) {
@@ -136,6 +151,8 @@ void TCPConnectionImpl::doRead() {
             if (ec.failed()) {
                 strongSelf->close(errorFromBoostError(ec));
             } else {
+                length += strongSelf->readAvailable(buffer->data() + length, buffer->size() - length);
+
                 strongSelf->doRead();
 
                 auto listener = strongSelf->getDataListener();
@@ -146,6 +163,28 @@ void TCPConnectionImpl::doRead() {
         });
 }
 
+size_t TCPConnectionImpl::readAvailable(Byte* output, size_t capacity) {
+    // Small writes from the peer usually arrive as many small segments, the ones which were already
+    // received are coalesced into the same buffer so that they are delivered with a single callback.
+    size_t length = 0;
+    while (length < capacity) {
+        boost::system::error_code ec;
+        auto available = _socket.available(ec);
+        if (ec.failed() || available == 0) {
+            break;
+        }
+
+        auto read = _socket.read_some(boost::asio::buffer(output + length, std::min(available, capacity - length)), ec);
+        if (ec.failed()) {
+            // The error will be reported by the next asynchronous read
+            break;
+        }
+        length += read;
+    }
+
+    return length;
+}
+
 void TCPConnectionImpl::onReady() {
     _address = resolveAddress();
     doRead();
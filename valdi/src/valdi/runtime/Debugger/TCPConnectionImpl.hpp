@@ -11,6 +11,7 @@
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include <array>
 #include <deque>
+#include <vector>
 
 namespace Valdi {
 
@@ -47,6 +48,7 @@ private:
     bool _closed = false;
 
     void doRead();
+    size_t readAvailable(Byte* output, size_t capacity);
     void lockFreeDoSend();
 
     void doClose(const Error& error);
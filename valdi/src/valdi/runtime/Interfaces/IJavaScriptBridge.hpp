@@ -10,11 +10,13 @@
 
 #include "valdi/runtime/Interfaces/IJavaScriptContext.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
 #include <span>
 
 namespace Valdi {
 
 class ILogger;
+class JavaScriptHeapDumpBuilder;
 
 struct IJavaScriptBridgeConfig {};
 
@@ -45,11 +47,40 @@ public:
      */
     virtual Valdi::Ref<IJavaScriptContext> createJsContext(JavaScriptTaskScheduler* taskScheduler, ILogger& logger) = 0;
 
+    /**
+     Whether the engine can compile JS modules without a JSContext, allowing modules
+     to be compiled ahead of time from any thread.
+     */
+    virtual bool supportsBackgroundPreCompilation() {
+        return false;
+    }
+
+    /**
+     Compile the given JS module source into a precompiled JS module, in the same format
+     as IJavaScriptContext::preCompile(). Only available when supportsBackgroundPreCompilation()
+     returns true, can be called from any thread.
+     */
+    virtual Result<BytesView> preCompile(const std::string_view& /*script*/,
+                                         const std::string_view& /*sourceFilename*/) {
+        return Error("Background precompilation is not supported by this engine");
+    }
+
     /**
      Dumps the heap for the given JSContexts.
      */
     virtual BytesView dumpHeap(std::span<IJavaScriptContext*> jsContexts, JSExceptionTracker& exceptionTracker) = 0;
 
+    /**
+     Appends the heap of the given JSContexts into the given builder, without serializing
+     the full dump in memory first. Returns false if the engine does not support it,
+     in which case dumpHeap() should be used instead.
+     */
+    virtual bool appendHeapDump(std::span<IJavaScriptContext*> /*jsContexts*/,
+                                JavaScriptHeapDumpBuilder& /*heapDumpBuilder*/,
+                                JSExceptionTracker& /*exceptionTracker*/) {
+        return false;
+    }
+
     /**
      * Starts the JS debugger server for the created JSContexts.
      */
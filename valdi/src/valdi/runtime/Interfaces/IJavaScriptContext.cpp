@@ -14,6 +14,10 @@
 
 namespace Valdi {
 
+// Bounds the strings retained by the cache used in newStringCached()
+constexpr size_t kStringCacheMaxSize = 512;
+constexpr size_t kStringCacheMaxStringLength = 256;
+
 IJavaScriptContext::IJavaScriptContext(JavaScriptTaskScheduler* taskScheduler) : _taskScheduler(taskScheduler) {}
 
 IJavaScriptContext::~IJavaScriptContext() = default;
@@ -22,6 +26,14 @@ JavaScriptTaskScheduler* IJavaScriptContext::getTaskScheduler() const {
     return _taskScheduler;
 }
 
+size_t IJavaScriptContext::getLazyArrayMinSize() const {
+    return _lazyArrayMinSize;
+}
+
+size_t IJavaScriptContext::getLazyArrayPrefetchSize() const {
+    return _lazyArrayPrefetchSize;
+}
+
 void IJavaScriptContext::setLongConstructor(const JSValueRef& longConstructor) {
     _longConstructor = ensureRetainedValue(longConstructor);
 }
@@ -37,6 +49,8 @@ void IJavaScriptContext::initialize(const IJavaScriptContextConfig& config, JSEx
     }
 
     _utf16Disabled = config.disableUTF16;
+    _lazyArrayMinSize = config.lazyArrayMinSize;
+    _lazyArrayPrefetchSize = config.lazyArrayPrefetchSize;
 
     _undefinedValue = ensureRetainedValue(onNewUndefined());
     _nullValue = ensureRetainedValue(onNewNull());
@@ -65,6 +79,7 @@ void IJavaScriptContext::prepareForTeardown() {
     _valueMarshaller = nullptr;
     clearGlobalObjectPropertyCache();
     clearPropertyNameCache();
+    clearStringCache();
 
     for (auto& stashedJSValue : _stashedJSValues) {
         if (!stashedJSValue.empty()) {
@@ -168,6 +183,32 @@ void IJavaScriptContext::setObjectProperty(const JSValue& object,
     setObjectProperty(object, propertyName, propertyValue, true, exceptionTracker);
 }
 
+void IJavaScriptContext::getObjectProperties(const JSValue& object,
+                                             const JSPropertyName* propertyNames,
+                                             size_t count,
+                                             JSValueRef* outValues,
+                                             JSExceptionTracker& exceptionTracker) {
+    for (size_t i = 0; i < count; i++) {
+        outValues[i] = getObjectProperty(object, propertyNames[i], exceptionTracker);
+        if (!exceptionTracker) {
+            return;
+        }
+    }
+}
+
+void IJavaScriptContext::setObjectProperties(const JSValue& object,
+                                             const JSPropertyName* propertyNames,
+                                             const JSValueRef* propertyValues,
+                                             size_t count,
+                                             JSExceptionTracker& exceptionTracker) {
+    for (size_t i = 0; i < count; i++) {
+        setObjectProperty(object, propertyNames[i], propertyValues[i].get(), true, exceptionTracker);
+        if (!exceptionTracker) {
+            return;
+        }
+    }
+}
+
 JSValueRef IJavaScriptContext::newError(std::string_view message,
                                         std::optional<std::string_view> stack,
                                         JSExceptionTracker& exceptionTracker) {
@@ -360,6 +401,44 @@ JSPropertyName IJavaScriptContext::getPropertyNameCached(const StringBox& str) {
     return propertyName;
 }
 
+JSValueRef IJavaScriptContext::newStringCached(const StringBox& str, JSExceptionTracker& exceptionTracker) {
+    const auto& it = _stringCache.find(str);
+    if (it != _stringCache.end()) {
+        return it->second;
+    }
+
+    auto jsString = newStringUTF8(str.toStringView(), exceptionTracker);
+    if (!exceptionTracker || str.length() > kStringCacheMaxStringLength) {
+        return jsString;
+    }
+
+    if (_stringCache.size() >= kStringCacheMaxSize) {
+        // The cached strings are expected to come from a small hot set, we start over
+        // rather than tracking recency on every lookup.
+        clearStringCache();
+    }
+
+    jsString = ensureRetainedValue(std::move(jsString));
+    _stringCacheReverse[jsString.get()] = str;
+    _stringCache[str] = jsString;
+
+    return jsString;
+}
+
+StringBox IJavaScriptContext::valueToStringCached(const JSValue& value, JSExceptionTracker& exceptionTracker) {
+    const auto& it = _stringCacheReverse.find(value);
+    if (it != _stringCacheReverse.end()) {
+        return it->second;
+    }
+
+    return valueToString(value, exceptionTracker);
+}
+
+void IJavaScriptContext::clearStringCache() {
+    _stringCacheReverse.clear();
+    _stringCache.clear();
+}
+
 JSValueRef IJavaScriptContext::getPropertyFromGlobalObjectCached(const StringBox& str,
                                                                  JSExceptionTracker& exceptionTracker) {
     const auto& it = _cachedGlobalObjectsProperties.find(str);
@@ -24,6 +24,7 @@
 #include "valdi_core/cpp/Utils/Value.hpp"
 #include "valdi_core/cpp/Utils/ValueMap.hpp"
 #include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
+#include <chrono>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -81,6 +82,11 @@ struct IJavaScriptContextConfig {
     bool disableUTF16 = false;
     bool disableValueMarshaller = false;
     bool disableProxyObjectStore = false;
+    // Native arrays with at least this many items are converted to JS lazily,
+    // see newLazyJSArray(). 0 disables lazy arrays.
+    size_t lazyArrayMinSize = 0;
+    // How many items are converted at once when reading an item of a lazy array.
+    size_t lazyArrayPrefetchSize = 32;
 };
 
 struct IJavaScriptContextDebuggerInfo {
@@ -106,6 +112,9 @@ public:
 
     JavaScriptTaskScheduler* getTaskScheduler() const;
 
+    size_t getLazyArrayMinSize() const;
+    size_t getLazyArrayPrefetchSize() const;
+
     virtual JSValueRef getGlobalObject(JSExceptionTracker& exceptionTracker) = 0;
 
     virtual JSValueRef evaluate(const std::string& script,
@@ -160,8 +169,17 @@ public:
     virtual JSValueRef newArray(size_t initialSize, JSExceptionTracker& exceptionTracker) = 0;
     virtual JSValueRef newArrayWithValues(const JSValue* values, size_t size, JSExceptionTracker& exceptionTracker);
 
+    /**
+     Create an ArrayBuffer backed by the memory of the given buffer, without copying it.
+     Implementations must retain the buffer source and release it from the ArrayBuffer
+     finalizer, so that large payloads can be shared between native and JS.
+     */
     virtual JSValueRef newArrayBuffer(const BytesView& buffer, JSExceptionTracker& exceptionTracker) = 0;
 
+    /**
+     Create an ArrayBuffer holding a copy of the given data. Should only be used when
+     the data is not backed by a RefCountable, otherwise prefer newArrayBuffer().
+     */
     virtual JSValueRef newArrayBufferCopy(const Byte* data, size_t size, JSExceptionTracker& exceptionTracker);
 
     virtual JSValueRef newTypedArrayFromArrayBuffer(const TypedArrayType& type,
@@ -191,6 +209,18 @@ public:
 
     virtual bool hasObjectProperty(const JSValue& object, const JSPropertyName& propertyName) = 0;
 
+    /**
+     Resolve the values of the given properties, writing them in order into outValues,
+     which must be able to hold count values. Stops at the first failure.
+     The default implementation calls getObjectProperty() for each property, engines
+     can override it to resolve all the properties in a single call.
+     */
+    virtual void getObjectProperties(const JSValue& object,
+                                     const JSPropertyName* propertyNames,
+                                     size_t count,
+                                     JSValueRef* outValues,
+                                     JSExceptionTracker& exceptionTracker);
+
     void setObjectProperty(const JSValue& object,
                            const std::string_view& propertyName,
                            const JSValue& propertyValue,
@@ -218,6 +248,18 @@ public:
                            const JSValue& propertyValue,
                            JSExceptionTracker& exceptionTracker);
 
+    /**
+     Set the given enumerable properties on the object, propertyValues[i] being the value
+     of propertyNames[i]. Stops at the first failure.
+     The default implementation calls setObjectProperty() for each property, engines
+     can override it to set all the properties in a single call.
+     */
+    virtual void setObjectProperties(const JSValue& object,
+                                     const JSPropertyName* propertyNames,
+                                     const JSValueRef* propertyValues,
+                                     size_t count,
+                                     JSExceptionTracker& exceptionTracker);
+
     virtual void setObjectProperty(const JSValue& object,
                                    const JSValue& propertyName,
                                    const JSValue& propertyValue,
@@ -245,6 +287,11 @@ public:
     virtual double valueToDouble(const JSValue& value, JSExceptionTracker& exceptionTracker) = 0;
     virtual int32_t valueToInt(const JSValue& value, JSExceptionTracker& exceptionTracker) = 0;
     virtual Ref<RefCountable> valueToWrappedObject(const JSValue& value, JSExceptionTracker& exceptionTracker) = 0;
+    /**
+     Resolve the memory of the given TypedArray or ArrayBuffer. The returned data points
+     directly into the JS backing store and remains valid as long as the returned
+     arrayBuffer is retained.
+     */
     virtual JSTypedArray valueToTypedArray(const JSValue& value, JSExceptionTracker& exceptionTracker) = 0;
     virtual Ref<JSFunction> valueToFunction(const JSValue& value, JSExceptionTracker& exceptionTracker) = 0;
     JavaScriptLong valueToLong(const JSValue& value, JSExceptionTracker& exceptionTracker);
@@ -275,6 +322,15 @@ public:
 
     virtual void garbageCollect() = 0;
 
+    /**
+     Give the engine an opportunity to perform garbage collection work while the app is idle.
+     The engine should only perform work which is expected to complete within the given budget.
+     Returns true if the engine does not have more work to perform until the next JS task runs.
+     */
+    virtual bool performIdleGarbageCollection(std::chrono::steady_clock::duration /*budget*/) {
+        return true;
+    }
+
     virtual JavaScriptContextMemoryStatistics dumpMemoryStatistics() = 0;
 
     virtual void startDebugger(bool isWorker) {}
@@ -334,6 +390,19 @@ public:
     JSPropertyName getPropertyNameCached(const StringBox& str);
     void clearPropertyNameCache();
 
+    /**
+     Returns a JS string for the given StringBox, which is cached per context by the interned
+     string. Repeated conversions of the same StringBox return the same JS string handle.
+     */
+    JSValueRef newStringCached(const StringBox& str, JSExceptionTracker& exceptionTracker);
+
+    /**
+     Converts the given JS value into a StringBox. Returns the StringBox directly without
+     reading the characters from the engine when the JS string was created by newStringCached().
+     */
+    StringBox valueToStringCached(const JSValue& value, JSExceptionTracker& exceptionTracker);
+    void clearStringCache();
+
     JSValueRef getPropertyFromGlobalObjectCached(const StringBox& str, JSExceptionTracker& exceptionTracker);
     void clearGlobalObjectPropertyCache();
 
@@ -414,6 +483,8 @@ private:
     IJavaScriptContextListener* _listener = nullptr;
     FlatMap<StringBox, JSPropertyNameRef> _propertyNameCache;
     FlatMap<StringBox, JSValueRef> _cachedGlobalObjectsProperties;
+    FlatMap<StringBox, JSValueRef> _stringCache;
+    FlatMap<JSValue, StringBox> _stringCacheReverse;
     std::vector<StashedJSValue> _stashedJSValues;
     SequenceIDGenerator _sequenceIdGenerator;
 
@@ -427,6 +498,8 @@ private:
     JSValueRef _unsignedLongCache;
     JSValueRef _signedLongCache;
     JSPropertyNameRef _exportModePropertyName;
+    size_t _lazyArrayMinSize = 0;
+    size_t _lazyArrayPrefetchSize = 0;
     bool _utf16Disabled = false;
     bool _interruptRequested = false;
     bool _tearingDown = false;
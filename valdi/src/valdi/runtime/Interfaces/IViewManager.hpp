@@ -109,6 +109,12 @@ public:
       Should be removed once the A/B test is complete, by v13.21.
      */
     virtual void setDisableAnimationRemoveOnCompleteIos(bool disable) {};
+
+    /**
+     Set whether the views managed by this IViewManager instance should display a live overlay
+     with the timings of the most recent frames. Not all view managers support it.
+     */
+    virtual void setPerformanceOverlayEnabled(bool enabled) {};
 };
 
 } // namespace Valdi
@@ -6,6 +6,7 @@
 //
 
 #include "valdi/runtime/JavaScript/JSFunctionWithCallable.hpp"
+#include "valdi_core/cpp/Utils/BridgeCrossings.hpp"
 
 namespace Valdi {
 
@@ -20,6 +21,7 @@ const ReferenceInfo& JSFunctionWithCallable::getReferenceInfo() const {
 }
 
 JSValueRef JSFunctionWithCallable::operator()(JSFunctionNativeCallContext& callContext) noexcept {
+    ScopedBridgeCrossing bridgeCrossing(BridgeCrossingType::JSToNative);
     return _callable(callContext);
 }
 
@@ -0,0 +1,107 @@
+#include "valdi/runtime/JavaScript/JavaScriptBytecodeCache.hpp"
+#include "valdi/runtime/Interfaces/IDiskCache.hpp"
+#include "valdi/runtime/Interfaces/IJavaScriptBridge.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
+#include "valdi/runtime/Utils/BytesUtils.hpp"
+#include "valdi_core/cpp/Interfaces/ILogger.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/PathUtils.hpp"
+
+#include <cstring>
+
+namespace Valdi {
+
+constexpr std::string_view kBytecodeFileExtension = "bc";
+
+static Path getBytecodePath(const StringBox& importPath) {
+    auto path = Path(importPath.toStringView());
+    path.appendFileExtension(kBytecodeFileExtension);
+    return path;
+}
+
+JavaScriptBytecodeCache::JavaScriptBytecodeCache(const Ref<IDiskCache>& diskCache,
+                                                 const Ref<DispatchQueue>& dispatchQueue,
+                                                 ILogger& logger)
+    : _diskCache(diskCache), _dispatchQueue(dispatchQueue), _logger(logger) {}
+
+JavaScriptBytecodeCache::~JavaScriptBytecodeCache() = default;
+
+BytesView JavaScriptBytecodeCache::computeSourceHash(const BytesView& source) {
+    return BytesUtils::sha256(source)->toBytesView();
+}
+
+std::optional<BytesView> JavaScriptBytecodeCache::load(const StringBox& importPath, const BytesView& sourceHash) {
+    auto data = _diskCache->load(getBytecodePath(importPath));
+    if (!data) {
+        return std::nullopt;
+    }
+
+    // Entries start with the hash of the source they were compiled from
+    const auto& entry = data.value();
+    if (entry.size() <= sourceHash.size() || std::memcmp(entry.data(), sourceHash.data(), sourceHash.size()) != 0) {
+        return std::nullopt;
+    }
+
+    return BytesView(entry.getSource(), entry.data() + sourceHash.size(), entry.size() - sourceHash.size());
+}
+
+void JavaScriptBytecodeCache::store(const StringBox& importPath,
+                                    const BytesView& sourceHash,
+                                    const BytesView& bytecode) {
+    _dispatchQueue->async([self = strongSmallRef(this), importPath, sourceHash, bytecode]() {
+        self->doStore(importPath, sourceHash, bytecode);
+    });
+}
+
+void JavaScriptBytecodeCache::doStore(const StringBox& importPath,
+                                      const BytesView& sourceHash,
+                                      const BytesView& bytecode) {
+    auto entry = makeShared<ByteBuffer>();
+    entry->reserve(sourceHash.size() + bytecode.size());
+    entry->append(sourceHash.begin(), sourceHash.end());
+    entry->append(bytecode.begin(), bytecode.end());
+
+    auto result = _diskCache->store(getBytecodePath(importPath), entry->toBytesView());
+    if (!result) {
+        VALDI_WARN(_logger, "Failed to store JS bytecode of module {}: {}", importPath, result.error());
+    }
+}
+
+void JavaScriptBytecodeCache::preCompileInBackground(IJavaScriptBridge& jsBridge,
+                                                     const StringBox& importPath,
+                                                     const BytesView& source) {
+    _dispatchQueue->async([self = strongSmallRef(this), &jsBridge, importPath, source]() {
+        self->doPreCompile(jsBridge, importPath, source);
+    });
+}
+
+void JavaScriptBytecodeCache::doPreCompile(IJavaScriptBridge& jsBridge,
+                                           const StringBox& importPath,
+                                           const BytesView& source) {
+    auto sourceHash = computeSourceHash(source);
+    if (load(importPath, sourceHash)) {
+        return;
+    }
+
+    auto preCompiledModule = jsBridge.preCompile(source.asStringView(), importPath.toStringView());
+    if (!preCompiledModule) {
+        VALDI_WARN(_logger, "Failed to precompile JS module {}: {}", importPath, preCompiledModule.error());
+        return;
+    }
+
+    auto bytecode = getPreCompiledJsModuleData(preCompiledModule.value());
+    if (!bytecode) {
+        return;
+    }
+
+    doStore(importPath, sourceHash, bytecode.value());
+}
+
+void JavaScriptBytecodeCache::remove(const StringBox& importPath) {
+    _dispatchQueue->async(
+        [self = strongSmallRef(this), importPath]() { self->_diskCache->remove(getBytecodePath(importPath)); });
+}
+
+} // namespace Valdi
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+#include <optional>
+
+namespace Valdi {
+
+class IDiskCache;
+class IJavaScriptBridge;
+class DispatchQueue;
+class ILogger;
+
+/**
+ The JavaScriptBytecodeCache keeps the bytecode compiled by the JS engine for the modules
+ which are shipped as source, so that the modules evaluated during each runtime initialization
+ are only parsed and compiled once. Entries are keyed by import path and hold the hash of
+ the source they were compiled from, so that a module whose source changed is compiled again
+ and its stale bytecode is replaced in place.
+ Entries are written to the disk cache from the given dispatch queue, where modules can
+ also be compiled ahead of time by engines which support it, so that the first require
+ of a downloaded module evaluates bytecode.
+ */
+class JavaScriptBytecodeCache : public SimpleRefCountable {
+public:
+    JavaScriptBytecodeCache(const Ref<IDiskCache>& diskCache, const Ref<DispatchQueue>& dispatchQueue, ILogger& logger);
+    ~JavaScriptBytecodeCache() override;
+
+    /**
+     Return the hash of the given module source, which identifies its bytecode in the cache.
+     */
+    static BytesView computeSourceHash(const BytesView& source);
+
+    /**
+     Return the bytecode previously compiled for the given import path, or nullopt if
+     there is none or if it was compiled from a different source.
+     */
+    std::optional<BytesView> load(const StringBox& importPath, const BytesView& sourceHash);
+
+    /**
+     Asynchronously store the bytecode compiled from the source with the given hash.
+     */
+    void store(const StringBox& importPath, const BytesView& sourceHash, const BytesView& bytecode);
+
+    /**
+     Asynchronously compile the given module source using the engine of the given bridge,
+     and store its bytecode, unless bytecode compiled from the same source is already stored.
+     The bridge must support background precompilation.
+     */
+    void preCompileInBackground(IJavaScriptBridge& jsBridge, const StringBox& importPath, const BytesView& source);
+
+    /**
+     Remove the bytecode stored for the given import path, typically because
+     the engine failed to evaluate it.
+     */
+    void remove(const StringBox& importPath);
+
+private:
+    Ref<IDiskCache> _diskCache;
+    Ref<DispatchQueue> _dispatchQueue;
+    [[maybe_unused]] ILogger& _logger;
+
+    void doStore(const StringBox& importPath, const BytesView& sourceHash, const BytesView& bytecode);
+    void doPreCompile(IJavaScriptBridge& jsBridge, const StringBox& importPath, const BytesView& source);
+};
+
+} // namespace Valdi
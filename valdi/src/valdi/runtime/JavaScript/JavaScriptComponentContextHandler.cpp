@@ -426,7 +426,7 @@ void JavaScriptComponentContextHandler::doCallComponentFunction(JavaScriptEntryP
         return;
     }
 
-    auto jsFunctionName = jsEntry.jsContext.newStringUTF8(functionName.toStringView(), jsEntry.exceptionTracker);
+    auto jsFunctionName = jsEntry.jsContext.newStringCached(functionName, jsEntry.exceptionTracker);
     if (!jsEntry.exceptionTracker) {
         return;
     }
@@ -466,7 +466,7 @@ void JavaScriptComponentContextHandler::doOnAttributeChange(JavaScriptEntryParam
                                                             const Value& attributeValue) {
     auto jsViewNodeId = jsEntry.jsContext.newNumber(static_cast<int32_t>(viewNodeId));
 
-    auto attributeNameResult = jsEntry.jsContext.newStringUTF8(attributeName.toStringView(), jsEntry.exceptionTracker);
+    auto attributeNameResult = jsEntry.jsContext.newStringCached(attributeName, jsEntry.exceptionTracker);
     if (!jsEntry.exceptionTracker) {
         return;
     }
@@ -6,6 +6,7 @@
 //
 
 #include "valdi/runtime/JavaScript/JavaScriptHeapDumpBuilder.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptHeapDumpOutputStream.hpp"
 #include "utils/debugging/Assert.hpp"
 #include "valdi_core/cpp/Schema/ValueSchema.hpp"
 #include "valdi_core/cpp/Utils/JSONReader.hpp"
@@ -17,6 +18,8 @@
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 namespace Valdi {
@@ -519,6 +522,46 @@ std::span<const JavaScriptHeapDumpParser::Edge> JavaScriptHeapDumpParser::Node::
 
 static constexpr size_t kElementsPerNode = 7;
 
+static constexpr const char* kNodeTypeNames[] = {"hidden",
+                                                 "array",
+                                                 "string",
+                                                 "object",
+                                                 "code",
+                                                 "closure",
+                                                 "regexp",
+                                                 "number",
+                                                 "native",
+                                                 "synthetic",
+                                                 "symbol",
+                                                 "bigint",
+                                                 "object shape"};
+static_assert(std::size(kNodeTypeNames) == static_cast<size_t>(JavaScriptHeapDumpNodeType::COUNT));
+
+/**
+ Flushes the serialized dump into the output stream once enough bytes are pending.
+ */
+struct JavaScriptHeapDumpBuilder::ChunkedOutput {
+    ByteBuffer& buffer;
+    JavaScriptHeapDumpOutputStream& output;
+    size_t chunkSize;
+    Result<Void> result = Void();
+
+    ChunkedOutput(ByteBuffer& buffer, JavaScriptHeapDumpOutputStream& output, size_t chunkSize)
+        : buffer(buffer), output(output), chunkSize(chunkSize) {}
+
+    void flush(bool force) {
+        if (buffer.size() < chunkSize && !force) {
+            return;
+        }
+
+        // Once the output failed, the remaining of the dump is discarded
+        if (result) {
+            result = output.write(buffer.data(), buffer.size());
+        }
+        buffer.clear();
+    }
+};
+
 JavaScriptHeapDumpBuilder::JavaScriptHeapDumpBuilder() = default;
 JavaScriptHeapDumpBuilder::~JavaScriptHeapDumpBuilder() = default;
 
@@ -537,19 +580,7 @@ static void writeSnapshot(size_t nodeCount, size_t edgeCount, JSONWriter& writer
             writer.writeProperty("node_types");
             writer.writeBeginArray();
             {
-                writer.writeStringArray({"hidden",
-                                         "array",
-                                         "string",
-                                         "object",
-                                         "code",
-                                         "closure",
-                                         "regexp",
-                                         "number",
-                                         "native",
-                                         "synthetic",
-                                         "symbol",
-                                         "bigint",
-                                         "object shape"});
+                writer.writeStringArray(std::begin(kNodeTypeNames), std::end(kNodeTypeNames));
                 writer.writeComma();
                 writer.writeCommaDelimitedStrings({"string", "number", "number", "number", "number", "number"});
             }
@@ -589,11 +620,33 @@ static void writeSnapshot(size_t nodeCount, size_t edgeCount, JSONWriter& writer
 }
 
 BytesView JavaScriptHeapDumpBuilder::build() {
-    SC_ASSERT(_nodes.size() == _nodeById.size());
-
     auto output = makeShared<ByteBuffer>();
     JSONWriter writer(*output);
 
+    writeDump(writer, nullptr);
+
+    return output->toBytesView();
+}
+
+Result<Void> JavaScriptHeapDumpBuilder::write(JavaScriptHeapDumpOutputStream& output, size_t chunkSize) {
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->reserve(chunkSize);
+    JSONWriter writer(*buffer);
+    ChunkedOutput chunkedOutput(*buffer, output, chunkSize);
+
+    writeDump(writer, &chunkedOutput);
+    chunkedOutput.flush(true);
+
+    if (!chunkedOutput.result) {
+        return chunkedOutput.result;
+    }
+
+    return output.finish();
+}
+
+void JavaScriptHeapDumpBuilder::writeDump(JSONWriter& writer, ChunkedOutput* chunkedOutput) {
+    SC_ASSERT(_nodes.size() == _nodeById.size());
+
     writer.writeBeginObject();
 
     writer.writeProperty("snapshot");
@@ -628,6 +681,10 @@ BytesView JavaScriptHeapDumpBuilder::build() {
         writer.writeInt(static_cast<int32_t>(0));
         writer.writeComma();
         writer.writeInt(static_cast<int32_t>(0));
+
+        if (chunkedOutput != nullptr) {
+            chunkedOutput->flush(false);
+        }
     });
     writer.writeComma();
     writer.writeNewLine();
@@ -649,12 +706,112 @@ BytesView JavaScriptHeapDumpBuilder::build() {
         writer.writeInt(edge.nameOrIndex);
         writer.writeComma();
         writer.writeInt(static_cast<int32_t>(indexedNode.nodeIndex.value() * kElementsPerNode));
+
+        if (chunkedOutput != nullptr) {
+            chunkedOutput->flush(false);
+        }
     });
     writer.writeComma();
     writer.writeNewLine();
 
     writer.writeProperty("strings");
-    writer.writeArray(_stringTable, [&](const StringBox& str) { writer.writeString(str.toStringView()); });
+    writer.writeArray(_stringTable, [&](const StringBox& str) {
+        writer.writeString(str.toStringView());
+
+        if (chunkedOutput != nullptr) {
+            chunkedOutput->flush(false);
+        }
+    });
+
+    writer.writeEndObject();
+}
+
+BytesView JavaScriptHeapDumpBuilder::buildSummary(size_t maxHistogramEntries) const {
+    struct HistogramEntry {
+        int32_t type;
+        int32_t name;
+        int64_t count = 0;
+        int64_t selfSize = 0;
+    };
+
+    FlatMap<uint64_t, HistogramEntry> histogramByKey;
+    std::vector<const Node*> roots;
+    int64_t totalSelfSize = 0;
+
+    for (const auto& node : _nodes) {
+        auto key = (static_cast<uint64_t>(node.type) << 32) | static_cast<uint32_t>(node.name);
+        auto& entry = histogramByKey[key];
+        entry.type = node.type;
+        entry.name = node.name;
+        entry.count++;
+        entry.selfSize += node.selfSize;
+        totalSelfSize += node.selfSize;
+
+        if (node.type == static_cast<int32_t>(JavaScriptHeapDumpNodeType::SYNTHETIC)) {
+            roots.emplace_back(&node);
+        }
+    }
+
+    std::vector<HistogramEntry> histogram;
+    histogram.reserve(histogramByKey.size());
+    for (const auto& it : histogramByKey) {
+        histogram.emplace_back(it.second);
+    }
+    std::sort(histogram.begin(), histogram.end(), [](const HistogramEntry& left, const HistogramEntry& right) {
+        if (left.selfSize != right.selfSize) {
+            return left.selfSize > right.selfSize;
+        }
+        return left.count > right.count;
+    });
+    if (histogram.size() > maxHistogramEntries) {
+        histogram.resize(maxHistogramEntries);
+    }
+
+    auto output = makeShared<ByteBuffer>();
+    JSONWriter writer(*output);
+
+    writer.writeBeginObject();
+
+    writer.writeProperty("node_count");
+    writer.writeInt(static_cast<int64_t>(_nodes.size()));
+    writer.writeComma();
+
+    writer.writeProperty("edge_count");
+    writer.writeInt(static_cast<int64_t>(_edges.size()));
+    writer.writeComma();
+
+    writer.writeProperty("total_self_size");
+    writer.writeInt(totalSelfSize);
+    writer.writeComma();
+
+    writer.writeProperty("histogram");
+    writer.writeArray(histogram, [&](const HistogramEntry& entry) {
+        writer.writeBeginObject();
+        writer.writeProperty("type");
+        writer.writeString(kNodeTypeNames[entry.type]);
+        writer.writeComma();
+        writer.writeProperty("name");
+        writer.writeString(_stringTable[entry.name].toStringView());
+        writer.writeComma();
+        writer.writeProperty("count");
+        writer.writeInt(entry.count);
+        writer.writeComma();
+        writer.writeProperty("self_size");
+        writer.writeInt(entry.selfSize);
+        writer.writeEndObject();
+    });
+    writer.writeComma();
+
+    writer.writeProperty("roots");
+    writer.writeArray(roots, [&](const Node* node) {
+        writer.writeBeginObject();
+        writer.writeProperty("name");
+        writer.writeString(_stringTable[node->name].toStringView());
+        writer.writeComma();
+        writer.writeProperty("edge_count");
+        writer.writeInt(node->edgeCount);
+        writer.writeEndObject();
+    });
 
     writer.writeEndObject();
 
@@ -10,6 +10,7 @@
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/ExceptionTracker.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
@@ -23,6 +24,8 @@
 namespace Valdi {
 
 class JSONReader;
+class JSONWriter;
+class JavaScriptHeapDumpOutputStream;
 
 /**
  The first number in the group of numbers for a node in the nodes array corresponds to its type.
@@ -187,7 +190,23 @@ public:
 
     BytesView build();
 
+    /**
+     Write the heap dump into the given output stream. The serialized dump is flushed into the output
+     whenever chunkSize bytes are pending, so that the memory used while writing stays bounded regardless
+     of the size of the dump.
+     */
+    [[nodiscard]] Result<Void> write(JavaScriptHeapDumpOutputStream& output, size_t chunkSize);
+
+    /**
+     Build a JSON summary of the heap dump, which is much smaller than the dump itself: the histogram of
+     the nodes grouped by type and name, sorted by self size and truncated to the given number of entries,
+     and the synthetic root nodes with the number of nodes they reference.
+     */
+    BytesView buildSummary(size_t maxHistogramEntries) const;
+
 private:
+    struct ChunkedOutput;
+
     /**
      Represents a Node that has been visited through the beginNode() method.
      */
@@ -257,6 +276,8 @@ private:
     ReferencedNode& appendReferencedNode();
 
     int32_t getStringTableIndex(const StringBox& str);
+
+    void writeDump(JSONWriter& writer, ChunkedOutput* chunkedOutput);
 };
 
 /**
@@ -0,0 +1,111 @@
+//
+//  JavaScriptHeapDumpOutputStream.cpp
+//  valdi
+//
+//  Copyright © 2024 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/JavaScript/JavaScriptHeapDumpOutputStream.hpp"
+#include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include "zstd.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace Valdi {
+
+Result<Void> JavaScriptHeapDumpOutputStream::finish() {
+    return Void();
+}
+
+JavaScriptHeapDumpBufferOutputStream::JavaScriptHeapDumpBufferOutputStream() : _buffer(makeShared<ByteBuffer>()) {}
+
+JavaScriptHeapDumpBufferOutputStream::~JavaScriptHeapDumpBufferOutputStream() = default;
+
+Result<Void> JavaScriptHeapDumpBufferOutputStream::write(const Byte* data, size_t length) {
+    _buffer->append(data, data + length);
+    return Void();
+}
+
+BytesView JavaScriptHeapDumpBufferOutputStream::getBytes() const {
+    return _buffer->toBytesView();
+}
+
+JavaScriptHeapDumpFileOutputStream::JavaScriptHeapDumpFileOutputStream(int fd) : _fd(fd) {}
+
+JavaScriptHeapDumpFileOutputStream::~JavaScriptHeapDumpFileOutputStream() = default;
+
+Result<Void> JavaScriptHeapDumpFileOutputStream::write(const Byte* data, size_t length) {
+    while (length > 0) {
+        auto written = ::write(_fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return Error(STRING_FORMAT("Failed to write heap dump: {}", strerror(errno)));
+        }
+
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+
+    return Void();
+}
+
+JavaScriptHeapDumpZStdOutputStream::JavaScriptHeapDumpZStdOutputStream(JavaScriptHeapDumpOutputStream& destination,
+                                                                       int compressionLevel)
+    : _destination(destination), _cctx(ZSTD_createCCtx()), _outputBuffer(makeShared<ByteBuffer>()) {
+    if (_cctx != nullptr) {
+        ZSTD_CCtx_setParameter(_cctx, ZSTD_c_compressionLevel, compressionLevel);
+    }
+    _outputBuffer->resize(ZSTD_CStreamOutSize());
+}
+
+JavaScriptHeapDumpZStdOutputStream::~JavaScriptHeapDumpZStdOutputStream() {
+    ZSTD_freeCCtx(_cctx);
+}
+
+Result<Void> JavaScriptHeapDumpZStdOutputStream::write(const Byte* data, size_t length) {
+    return compress(data, length, false);
+}
+
+Result<Void> JavaScriptHeapDumpZStdOutputStream::finish() {
+    auto result = compress(nullptr, 0, true);
+    if (!result) {
+        return result;
+    }
+
+    return _destination.finish();
+}
+
+Result<Void> JavaScriptHeapDumpZStdOutputStream::compress(const Byte* data, size_t length, bool endOfStream) {
+    if (_cctx == nullptr) {
+        return Error("Could not create ZSTD context");
+    }
+
+    ZSTD_inBuffer input = {data, length, 0};
+    for (;;) {
+        ZSTD_outBuffer output = {_outputBuffer->data(), _outputBuffer->size(), 0};
+        auto remaining = ZSTD_compressStream2(_cctx, &output, &input, endOfStream ? ZSTD_e_end : ZSTD_e_continue);
+        if (ZSTD_isError(remaining) != 0) {
+            return Error(STRING_FORMAT("Could not compress heap dump: {}", ZSTD_getErrorName(remaining)));
+        }
+
+        if (output.pos > 0) {
+            auto result = _destination.write(_outputBuffer->data(), output.pos);
+            if (!result) {
+                return result;
+            }
+        }
+
+        // When ending the stream, the remaining value is the amount of data still to be flushed
+        if (endOfStream ? remaining == 0 : input.pos == input.size) {
+            return Void();
+        }
+    }
+}
+
+} // namespace Valdi
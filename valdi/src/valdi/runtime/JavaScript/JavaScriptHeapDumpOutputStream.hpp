@@ -0,0 +1,85 @@
+//
+//  JavaScriptHeapDumpOutputStream.hpp
+//  valdi
+//
+//  Copyright © 2024 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+
+struct ZSTD_CCtx_s;
+
+namespace Valdi {
+
+/**
+ Receives the chunks of a heap dump as they are produced, so that the whole
+ dump never has to be held in memory.
+ */
+class JavaScriptHeapDumpOutputStream {
+public:
+    virtual ~JavaScriptHeapDumpOutputStream() = default;
+
+    [[nodiscard]] virtual Result<Void> write(const Byte* data, size_t length) = 0;
+
+    /**
+     Called once after the last chunk was written.
+     */
+    [[nodiscard]] virtual Result<Void> finish();
+};
+
+/**
+ Output stream which accumulates the heap dump in memory.
+ */
+class JavaScriptHeapDumpBufferOutputStream : public JavaScriptHeapDumpOutputStream {
+public:
+    JavaScriptHeapDumpBufferOutputStream();
+    ~JavaScriptHeapDumpBufferOutputStream() override;
+
+    Result<Void> write(const Byte* data, size_t length) override;
+
+    BytesView getBytes() const;
+
+private:
+    Ref<ByteBuffer> _buffer;
+};
+
+/**
+ Output stream which writes the heap dump to a file descriptor, which can be a file
+ or a socket. The file descriptor is not owned by the stream.
+ */
+class JavaScriptHeapDumpFileOutputStream : public JavaScriptHeapDumpOutputStream {
+public:
+    explicit JavaScriptHeapDumpFileOutputStream(int fd);
+    ~JavaScriptHeapDumpFileOutputStream() override;
+
+    Result<Void> write(const Byte* data, size_t length) override;
+
+private:
+    int _fd;
+};
+
+/**
+ Output stream which compresses the heap dump as a single zstd frame on the fly,
+ and forwards the compressed chunks into another output stream.
+ */
+class JavaScriptHeapDumpZStdOutputStream : public JavaScriptHeapDumpOutputStream {
+public:
+    JavaScriptHeapDumpZStdOutputStream(JavaScriptHeapDumpOutputStream& destination, int compressionLevel);
+    ~JavaScriptHeapDumpZStdOutputStream() override;
+
+    Result<Void> write(const Byte* data, size_t length) override;
+    Result<Void> finish() override;
+
+private:
+    JavaScriptHeapDumpOutputStream& _destination;
+    ZSTD_CCtx_s* _cctx;
+    Ref<ByteBuffer> _outputBuffer;
+
+    Result<Void> compress(const Byte* data, size_t length, bool endOfStream);
+};
+
+} // namespace Valdi
@@ -0,0 +1,236 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi/runtime/JavaScript/JavaScriptLazyArray.hpp"
+#include "valdi/runtime/JavaScript/JSFunctionWithCallable.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptFunctionCallContext.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
+
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace Valdi {
+
+namespace {
+
+enum class LazyArrayTrapKind : uint8_t {
+    // The trap only needs the item targeted by an index key to be converted.
+    Read,
+    // Same as Read, but all the items must be converted when the key is not an index,
+    // since it might be "length" and shrink or grow the array.
+    Write,
+    // The trap observes all the items.
+    All,
+};
+
+class LazyArrayState : public SimpleRefCountable {
+public:
+    LazyArrayState(Ref<ValueArray> array, ReferenceInfo referenceInfo, size_t prefetchSize)
+        : _array(std::move(array)),
+          _referenceInfo(std::move(referenceInfo)),
+          _prefetchSize(std::max(prefetchSize, static_cast<size_t>(1))),
+          _converted(_array->size(), false),
+          _remaining(_array->size()) {}
+
+    size_t size() const {
+        return _array->size();
+    }
+
+    bool prepareForTrap(IJavaScriptContext& jsContext,
+                        LazyArrayTrapKind kind,
+                        const JSValue& target,
+                        const JSValue& key,
+                        JSExceptionTracker& exceptionTracker) {
+        if (_remaining == 0) {
+            return true;
+        }
+
+        if (kind != LazyArrayTrapKind::All) {
+            auto index = resolveIndex(jsContext, key, exceptionTracker);
+            if (!exceptionTracker) {
+                return false;
+            }
+            if (index) {
+                return convert(jsContext, target, index.value(), index.value() + _prefetchSize, exceptionTracker);
+            }
+            if (kind == LazyArrayTrapKind::Read) {
+                return true;
+            }
+        }
+
+        return convert(jsContext, target, 0, size(), exceptionTracker);
+    }
+
+private:
+    Ref<ValueArray> _array;
+    ReferenceInfo _referenceInfo;
+    size_t _prefetchSize;
+    std::vector<bool> _converted;
+    size_t _remaining;
+
+    std::optional<size_t> resolveIndex(IJavaScriptContext& jsContext,
+                                       const JSValue& key,
+                                       JSExceptionTracker& exceptionTracker) const {
+        auto keyType = jsContext.getValueType(key);
+        if (keyType != ValueType::StaticString && keyType != ValueType::InternedString) {
+            // Symbol keys, like Symbol.iterator
+            return std::nullopt;
+        }
+
+        auto str = jsContext.valueToString(key, exceptionTracker);
+        if (!exceptionTracker) {
+            return std::nullopt;
+        }
+
+        // Only canonical array indexes reference items, "01" or "1.0" are regular properties.
+        auto view = str.toStringView();
+        if (view.empty() || (view.size() > 1 && view[0] == '0')) {
+            return std::nullopt;
+        }
+
+        size_t index = 0;
+        for (auto c : view) {
+            if (c < '0' || c > '9') {
+                return std::nullopt;
+            }
+            index = index * 10 + static_cast<size_t>(c - '0');
+            if (index >= size()) {
+                return std::nullopt;
+            }
+        }
+
+        return {index};
+    }
+
+    bool convert(IJavaScriptContext& jsContext,
+                 const JSValue& target,
+                 size_t start,
+                 size_t end,
+                 JSExceptionTracker& exceptionTracker) {
+        end = std::min(end, size());
+
+        ReferenceInfoBuilder referenceInfoBuilder(_referenceInfo);
+        for (size_t i = start; i < end && _remaining > 0; i++) {
+            if (_converted[i]) {
+                continue;
+            }
+
+            auto item = valueToJSValue(jsContext, (*_array)[i], referenceInfoBuilder.withArrayIndex(i), exceptionTracker);
+            if (!exceptionTracker) {
+                return false;
+            }
+
+            jsContext.setObjectPropertyIndex(target, i, item.get(), exceptionTracker);
+            if (!exceptionTracker) {
+                return false;
+            }
+
+            _converted[i] = true;
+            _remaining--;
+        }
+
+        return true;
+    }
+};
+
+} // namespace
+
+static bool setLazyArrayTrap(IJavaScriptContext& jsContext,
+                             const JSValue& handler,
+                             const Ref<LazyArrayState>& state,
+                             const StringBox& trapName,
+                             LazyArrayTrapKind kind,
+                             JSExceptionTracker& exceptionTracker) {
+    auto trap = makeShared<JSFunctionWithCallable>(
+        ReferenceInfoBuilder(), [state, trapName, kind](JSFunctionNativeCallContext& callContext) -> JSValueRef {
+            static auto kReflect = STRING_LITERAL("Reflect");
+
+            auto& jsContext = callContext.getContext();
+            auto& exceptionTracker = callContext.getExceptionTracker();
+
+            // All the traps take the target as first parameter, and the key as second parameter
+            // except for ownKeys.
+            if (!state->prepareForTrap(
+                    jsContext, kind, callContext.getParameter(0), callContext.getParameter(1), exceptionTracker)) {
+                return jsContext.newUndefined();
+            }
+
+            // The item is now set in the target, let the default behavior handle the operation
+            auto reflect = jsContext.getPropertyFromGlobalObjectCached(kReflect, exceptionTracker);
+            CHECK_CALL_CONTEXT(callContext);
+
+            auto reflectFunction =
+                jsContext.getObjectProperty(reflect.get(), jsContext.getPropertyNameCached(trapName), exceptionTracker);
+            CHECK_CALL_CONTEXT(callContext);
+
+            JSFunctionCallContext reflectCallContext(
+                jsContext, callContext.getParameters(), callContext.getParameterSize(), exceptionTracker);
+            return jsContext.callObjectAsFunction(reflectFunction.get(), reflectCallContext);
+        });
+
+    auto trapFunction = jsContext.newFunction(trap, exceptionTracker);
+    if (!exceptionTracker) {
+        return false;
+    }
+
+    jsContext.setObjectProperty(handler, jsContext.getPropertyNameCached(trapName), trapFunction.get(), exceptionTracker);
+    return static_cast<bool>(exceptionTracker);
+}
+
+JSValueRef newLazyJSArray(IJavaScriptContext& jsContext,
+                          const Ref<ValueArray>& array,
+                          size_t prefetchSize,
+                          const ReferenceInfoBuilder& referenceInfoBuilder,
+                          JSExceptionTracker& exceptionTracker) {
+    static auto kProxy = STRING_LITERAL("Proxy");
+    static auto kLength = STRING_LITERAL("length");
+    static const std::pair<StringBox, LazyArrayTrapKind> kTraps[] = {
+        {STRING_LITERAL("get"), LazyArrayTrapKind::Read},
+        {STRING_LITERAL("has"), LazyArrayTrapKind::Read},
+        {STRING_LITERAL("getOwnPropertyDescriptor"), LazyArrayTrapKind::Read},
+        {STRING_LITERAL("set"), LazyArrayTrapKind::Write},
+        {STRING_LITERAL("defineProperty"), LazyArrayTrapKind::Write},
+        {STRING_LITERAL("deleteProperty"), LazyArrayTrapKind::Write},
+        {STRING_LITERAL("ownKeys"), LazyArrayTrapKind::All},
+    };
+
+    auto target = jsContext.newArray(array->size(), exceptionTracker);
+    if (!exceptionTracker) {
+        return jsContext.newUndefined();
+    }
+
+    // Not all engines honor the initial size
+    auto length = jsContext.newNumber(static_cast<double>(array->size()));
+    jsContext.setObjectProperty(target.get(), jsContext.getPropertyNameCached(kLength), length.get(), exceptionTracker);
+    if (!exceptionTracker) {
+        return jsContext.newUndefined();
+    }
+
+    auto handler = jsContext.newObject(exceptionTracker);
+    if (!exceptionTracker) {
+        return jsContext.newUndefined();
+    }
+
+    // The state is only referenced by the traps, the target is given to them as a parameter
+    // so that the JS objects do not get retained from native.
+    auto state = makeShared<LazyArrayState>(array, referenceInfoBuilder.build(), prefetchSize);
+    for (const auto& [trapName, kind] : kTraps) {
+        if (!setLazyArrayTrap(jsContext, handler.get(), state, trapName, kind, exceptionTracker)) {
+            return jsContext.newUndefined();
+        }
+    }
+
+    auto proxyConstructor = jsContext.getPropertyFromGlobalObjectCached(kProxy, exceptionTracker);
+    if (!exceptionTracker) {
+        return jsContext.newUndefined();
+    }
+
+    std::initializer_list<JSValueRef> parameters = {std::move(target), std::move(handler)};
+    JSFunctionCallContext callContext(jsContext, parameters.begin(), parameters.size(), exceptionTracker);
+
+    return jsContext.callObjectAsConstructor(proxyConstructor.get(), callContext);
+}
+
+} // namespace Valdi
@@ -0,0 +1,27 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi/runtime/Interfaces/IJavaScriptContext.hpp"
+#include "valdi_core/cpp/Utils/ReferenceInfo.hpp"
+
+namespace Valdi {
+
+class ValueArray;
+
+/**
+ Create a JS array backed by the given native array, where items are only converted
+ to JS when they are accessed from JS. The returned value is a Proxy over a regular
+ JS array, so Array.isArray(), length, iteration and the Array prototype methods behave
+ as they would on an eagerly converted array.
+ Reading an item converts it along with the up to prefetchSize - 1 items that follow it.
+ Enumerating the keys of the array, or setting a non index property, converts all the
+ remaining items. The native array must not be mutated after this call.
+ */
+[[nodiscard]] JSValueRef newLazyJSArray(IJavaScriptContext& jsContext,
+                                        const Ref<ValueArray>& array,
+                                        size_t prefetchSize,
+                                        const ReferenceInfoBuilder& referenceInfoBuilder,
+                                        JSExceptionTracker& exceptionTracker);
+
+} // namespace Valdi
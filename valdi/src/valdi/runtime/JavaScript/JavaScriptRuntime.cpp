@@ -22,6 +22,8 @@
 #include "valdi/runtime/JavaScript/JavaScriptContextEntryPoint.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptErrorStackTrace.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptFunctionCallContext.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptHeapDumpBuilder.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptHeapDumpOutputStream.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptModuleContainer.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptValueMarshaller.hpp"
@@ -32,11 +34,13 @@
 #include "valdi/runtime/ValdiRuntimeTweaks.hpp"
 #include "valdi_core/cpp/Constants.hpp"
 #include "valdi_core/cpp/Resources/ResourceId.hpp"
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
 #include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/Marshaller.hpp"
 #include "valdi_core/cpp/Utils/ObjectPool.hpp"
 #include "valdi_core/cpp/Utils/PathUtils.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/TimePoint.hpp"
@@ -46,6 +50,7 @@
 #include "valdi_core/cpp/Utils/ValueMap.hpp"
 
 #include "valdi/runtime/JavaScript/JavaScriptANRDetector.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptBytecodeCache.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptRuntimeDeserializers.hpp"
 #include "valdi/runtime/JavaScript/Modules/JavaScriptModuleFactory.hpp"
 
@@ -76,10 +81,10 @@
 
 #include "valdi/runtime/Metrics/Metrics.hpp"
 
-#include "utils/encoding/Base64Utils.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptAssetLoadObserver.hpp"
 #include "valdi_core/cpp/Utils/ContainerUtils.hpp"
 #include <fmt/format.h>
+#include <optional>
 #include <sstream>
 
 #if defined(__ANDROID__)
@@ -97,7 +102,17 @@
 namespace Valdi {
 
 // static const long long kJsGarbageCollectionDelaySeconds = 2;
+// Time given to the engine to collect garbage once the main thread becomes idle, which is
+// about half of a frame at 60fps so that a frame starting right after is not delayed
+constexpr auto kIdleGcBudget = std::chrono::milliseconds(8);
+constexpr auto kSamplingProfileFlushInterval = std::chrono::seconds(1);
+constexpr auto kMaxStackSampleLatency = std::chrono::milliseconds(2);
+constexpr size_t kHeapDumpChunkSize = 64 * 1024;
+constexpr size_t kHeapDumpSummaryMaxHistogramEntries = 100;
+constexpr int kHeapDumpCompressionLevel = 3;
 constexpr int kTraceRecordingTimeoutSeconds = 20;
+// Below this size, the eager conversion is cheaper than going through the lazy array proxy
+constexpr size_t kLazyJSArrayMinSize = 256;
 
 constexpr size_t kLoadPropertyName = 0;
 constexpr size_t kUnloadAllUnusedPropertyName = 1;
@@ -301,6 +316,11 @@ void JavaScriptRuntime::postInit() {
     }
 
     _contextHandler = makeShared<JavaScriptComponentContextHandler>(*this, this, *_logger);
+
+    if (shouldPreCompileRemoteModules()) {
+        _resourceManager.addListener(this);
+    }
+
     _initLock.leaveIfNotCompleted();
 
     if (_listener != nullptr) {
@@ -359,11 +379,16 @@ void JavaScriptRuntime::teardown(bool destroyContext) {
     // Just in case postInit() was never called
     _initLock.leaveIfNotCompleted();
 
+    if (shouldPreCompileRemoteModules()) {
+        _resourceManager.removeListener(this);
+    }
+
     if (destroyContext) {
         _dispatchQueue->sync([&]() {
             if (_anrDetector != nullptr) {
                 _anrDetector->removeTaskScheduler(this);
             }
+            detachSamplingProfiler();
             // Prevent further dispatches to run
             _listener = nullptr;
             _dispatchQueue->fullTeardown();
@@ -400,6 +425,7 @@ void JavaScriptRuntime::teardown(bool destroyContext) {
         if (_anrDetector != nullptr) {
             _anrDetector->removeTaskScheduler(this);
         }
+        detachSamplingProfiler();
         _dispatchQueue->fullTeardown();
         _listener = nullptr;
     }
@@ -409,6 +435,10 @@ void JavaScriptRuntime::setThreadQoS(ThreadQoSClass threadQoS) {
     _dispatchQueue->setQoSClass(threadQoS);
 }
 
+void JavaScriptRuntime::setBytecodeCache(const Ref<JavaScriptBytecodeCache>& bytecodeCache) {
+    _bytecodeCache = bytecodeCache;
+}
+
 void JavaScriptRuntime::setListener(Valdi::IJavaScriptRuntimeListener* listener) {
     _listener = listener;
 }
@@ -443,6 +473,7 @@ void JavaScriptRuntime::bindRuntimeFunction(IJavaScriptContext& jsContext,
 
 Result<Void> JavaScriptRuntime::initializeContext() {
     VALDI_TRACE("Valdi.createJsContext");
+    ScopedStartupSpan startupSpan(StartupSpanType::JSEngineInit);
     Ref<ValdiRuntimeTweaks> runtimeTweaks;
     if (_listener != nullptr) {
         runtimeTweaks = _listener->getRuntimeTweaks();
@@ -455,6 +486,9 @@ Result<Void> JavaScriptRuntime::initializeContext() {
     std::unique_ptr<JavaScriptRuntimeDeserializers> runtimeDeserializers;
 
     IJavaScriptContextConfig config;
+    if (runtimeTweaks != nullptr && runtimeTweaks->enableLazyJSArrays()) {
+        config.lazyArrayMinSize = kLazyJSArrayMinSize;
+    }
 
     JSExceptionTracker exceptionTracker(*jsContext);
     jsContext->initialize(config, exceptionTracker);
@@ -850,6 +884,16 @@ JSValueRef JavaScriptRuntime::runtimeSubmitRenderRequest(JSFunctionNativeCallCon
     auto callback = callContext.getParameterAsFunction(1);
     CHECK_CALL_CONTEXT(callContext);
     auto renderRequest = _runtimeDeserializers->deserializeRenderRequest(rawRequest, referenceInfo, exceptionTracker);
+    if (exceptionTracker && renderRequest != nullptr) {
+        // Attribute the time since the JS task started, or since the previous render request
+        // submitted by the same task, to this render request.
+        auto now = std::chrono::steady_clock::now();
+        renderRequest->setJsRenderDuration(now - _jsTaskStartTime);
+        _jsTaskStartTime = now;
+        const auto& bridgeCrossings = BridgeCrossings::current();
+        renderRequest->setJsBridgeCrossings(bridgeCrossings.since(_jsTaskStartBridgeCrossings));
+        _jsTaskStartBridgeCrossings = bridgeCrossings;
+    }
     if (exceptionTracker && _listener != nullptr) {
         _listener->receivedRenderRequest(renderRequest);
     }
@@ -1031,8 +1075,8 @@ JSValueRef JavaScriptRuntime::runtimeTakeElementSnapshot(JSFunctionNativeCallCon
                                         return;
                                     }
 
-                                    auto base64 = snap::utils::encoding::binaryToBase64(result.value().data(),
-                                                                                        result.value().size());
+                                    auto base64 =
+                                        Base64Codec::encode(result.value().data(), result.value().size());
 
                                     cb(Value(StringCache::getGlobal().makeString(std::move(base64))));
                                 });
@@ -1287,6 +1331,7 @@ JSValueRef JavaScriptRuntime::loadJsModule(IJavaScriptContext& jsContext,
                                            size_t parametersLength,
                                            JSExceptionTracker& exceptionTracker) {
     VALDI_TRACE_META("Valdi.loadJsModule", importPath);
+    ScopedStartupSpan startupSpan(StartupSpanType::ModuleEvaluation, importPath);
     snap::utils::time::StopWatch sw;
     sw.start();
 
@@ -1338,8 +1383,13 @@ JSValueRef JavaScriptRuntime::loadJsModule(IJavaScriptContext& jsContext,
             _moduleMemoryTracker.push_back({waterMarkBefore, 0});
         }
 
-        result = loadJsModuleFromBytes(
-            jsContext, jsFileContent.value().content, importPath, parameters, parametersLength, exceptionTracker);
+        result = loadJsModuleFromBytes(jsContext,
+                                       jsFileContent.value().content,
+                                       importPath,
+                                       parameters,
+                                       parametersLength,
+                                       /* useBytecodeCache */ true,
+                                       exceptionTracker);
 
         if (waterMarkBefore != 0) {
             // Compuete the memory usage: watermark_after - watermark_before
@@ -1384,6 +1434,7 @@ ModuleLoadResult JavaScriptRuntime::loadJsModuleFromBytes(IJavaScriptContext& js
                                                           const StringBox& importPath,
                                                           const JSValueRef* parameters,
                                                           size_t parametersLength,
+                                                          bool useBytecodeCache,
                                                           JSExceptionTracker& exceptionTracker) {
     // Assign global context when loading a JS module
     JavaScriptContextEntry contextEntry(_globalContext);
@@ -1401,6 +1452,9 @@ ModuleLoadResult JavaScriptRuntime::loadJsModuleFromBytes(IJavaScriptContext& js
             moduleLoadMode = ModuleLoadMode::JS_BYTECODE;
             evalResult =
                 jsContext.evaluatePreCompiled(preCompiledContent.value(), importPath.toStringView(), exceptionTracker);
+        } else if (useBytecodeCache && shouldUseBytecodeCache() && jsContext.supportsPreCompilation()) {
+            evalResult = evaluateJsModuleWithBytecodeCache(jsContext, jsModule, importPath, exceptionTracker);
+            moduleLoadMode = ModuleLoadMode::JS_BYTECODE;
         } else {
             moduleLoadMode = ModuleLoadMode::JS_SOURCE;
             auto moduleSrc = jsModule.asStringView();
@@ -1417,6 +1471,52 @@ ModuleLoadResult JavaScriptRuntime::loadJsModuleFromBytes(IJavaScriptContext& js
     return std::make_pair(jsContext.callObjectAsFunction(evalResult.get(), callContext), moduleLoadMode);
 }
 
+JSValueRef JavaScriptRuntime::evaluateJsModuleWithBytecodeCache(IJavaScriptContext& jsContext,
+                                                                const BytesView& jsModule,
+                                                                const StringBox& importPath,
+                                                                JSExceptionTracker& exceptionTracker) {
+    auto sourceHash = JavaScriptBytecodeCache::computeSourceHash(jsModule);
+    // Bytecode is stored under the resolved path, so that it is found regardless of how the module was imported,
+    // including when it was compiled ahead of time after being downloaded.
+    auto bytecodeCacheKey = importPath;
+    auto resourceId = JavaScriptPathResolver::resolveResourceId(importPath);
+    if (resourceId) {
+        bytecodeCacheKey = StringCache::getGlobal().makeString(resourceId.value().toAbsolutePath());
+    }
+
+    auto cachedBytecode = _bytecodeCache->load(bytecodeCacheKey, sourceHash);
+    if (cachedBytecode) {
+        auto evalResult =
+            jsContext.evaluatePreCompiled(cachedBytecode.value(), importPath.toStringView(), exceptionTracker);
+        if (exceptionTracker) {
+            return evalResult;
+        }
+
+        // The bytecode might have been produced by a different version of the engine,
+        // compile the module again from its source.
+        VALDI_WARN(*_logger,
+                   "Failed to evaluate cached bytecode of JS module {}: {}",
+                   importPath,
+                   exceptionTracker.extractError());
+        _bytecodeCache->remove(bytecodeCacheKey);
+    }
+
+    auto preCompiledModule = jsContext.preCompile(jsModule.asStringView(), importPath.toStringView(), exceptionTracker);
+    if (!exceptionTracker) {
+        return jsContext.newUndefined();
+    }
+
+    auto bytecode = getPreCompiledJsModuleData(preCompiledModule);
+    if (!bytecode) {
+        exceptionTracker.onError(Error("Engine returned an invalid precompiled JS module"));
+        return jsContext.newUndefined();
+    }
+
+    _bytecodeCache->store(bytecodeCacheKey, sourceHash, bytecode.value());
+
+    return jsContext.evaluatePreCompiled(bytecode.value(), importPath.toStringView(), exceptionTracker);
+}
+
 ModuleLoadResult JavaScriptRuntime::loadJsModuleFromNative(IJavaScriptContext& jsContext,
                                                            const StringBox& importPath,
                                                            const JSValueRef* parameters,
@@ -1482,7 +1582,8 @@ JSValueRef JavaScriptRuntime::runtimeGetSourceMap(JSFunctionNativeCallContext& c
             if (endLine != std::string_view::npos) {
                 sourceMapBase64 = sourceMapBase64.substr(0, endLine);
             }
-            auto decodedSourceMapping = snap::utils::encoding::base64ToBinary(sourceMapBase64);
+            Bytes decodedSourceMapping;
+            Base64Codec::decode(sourceMapBase64, decodedSourceMapping);
             return callContext.getContext().newStringUTF8(
                 std::string_view(reinterpret_cast<const char*>(decodedSourceMapping.data()),
                                  decodedSourceMapping.size()),
@@ -2010,6 +2111,8 @@ JSValueRef JavaScriptRuntime::runtimeCreateWorker(JSFunctionNativeCallContext& c
                                                        _anrDetector,
                                                        _logger,
                                                        true);
+    // Workers evaluate the same modules as the main runtime, they share its compiled bytecode
+    workerRuntime->setBytecodeCache(_bytecodeCache);
     workerRuntime->postInit();
     for (const auto& moduleFactory : _moduleFactories) {
         workerRuntime->registerJavaScriptModuleFactory(moduleFactory);
@@ -2944,6 +3047,32 @@ JSValueRef JavaScriptRuntime::symbolicateError(const JSValueRef& error) {
     return error;
 }
 
+bool JavaScriptRuntime::shouldUseBytecodeCache() const {
+    // The debugger needs the modules to be evaluated from their source
+    return _bytecodeCache != nullptr && !_enableDebugger;
+}
+
+bool JavaScriptRuntime::shouldPreCompileRemoteModules() const {
+    // Downloaded modules are precompiled once by the main runtime, on behalf of its workers
+    return !_isWorker && shouldUseBytecodeCache() && _javaScriptBridge.supportsBackgroundPreCompilation();
+}
+
+void JavaScriptRuntime::bundleIsBeingUnloaded(const Shared<Bundle>& /*bundle*/) {}
+
+void JavaScriptRuntime::bundleRemoteArchiveDidLoad(const Ref<Bundle>& bundle) {
+    // Compile the sources of the downloaded module ahead of time, so that
+    // they don't need to be compiled on the JS thread when they are first required.
+    for (const auto& jsPath : bundle->getAllJsPaths()) {
+        auto jsFile = bundle->getJs(jsPath);
+        if (!jsFile || getPreCompiledJsModuleData(jsFile.value().content)) {
+            continue;
+        }
+
+        auto importPath = StringCache::getGlobal().makeString(ResourceId(bundle->getName(), jsPath).toAbsolutePath());
+        _bytecodeCache->preCompileInBackground(_javaScriptBridge, importPath, jsFile.value().content);
+    }
+}
+
 void JavaScriptRuntime::onUnhandledRejectedPromise(IJavaScriptContext& jsContext, const JSValue& promiseResult) {
     auto currentContext = Context::currentRef();
 
@@ -2992,6 +3121,43 @@ void JavaScriptRuntime::performGcNow(IJavaScriptContext& jsContext) {
     VALDI_DEBUG(*_logger, "Performed JS GC");
 }
 
+void JavaScriptRuntime::scheduleIdleGcIfNeeded() {
+    // GC pauses in workers don't delay the rendering
+    if (_isWorker || _idleGcScheduled) {
+        return;
+    }
+    _idleGcScheduled = true;
+
+    _mainThreadManager.onIdle(makeShared<ValueFunctionWithCallable>(
+        [weakSelf = weakRef(this)](const ValueFunctionCallContext& /*callContext*/) -> Value {
+            auto self = weakSelf.lock();
+            if (self != nullptr) {
+                auto deadline = std::chrono::steady_clock::now() + kIdleGcBudget;
+                self->_dispatchQueue->async([self, deadline]() { self->performIdleGcNow(deadline); });
+            }
+            return Value::undefined();
+        }));
+}
+
+void JavaScriptRuntime::performIdleGcNow(std::chrono::steady_clock::time_point deadline) {
+    _idleGcScheduled = false;
+    if (_javaScriptContext == nullptr || !_running) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+        // The JS thread was busy until the deadline, the next JS task will schedule the GC again
+        return;
+    }
+
+    VALDI_TRACE("Valdi.performIdleGc");
+    auto completed = _javaScriptContext->performIdleGarbageCollection(deadline - now);
+    if (!completed) {
+        scheduleIdleGcIfNeeded();
+    }
+}
+
 JavaScriptContextMemoryStatistics JavaScriptRuntime::dumpMemoryStatistics(IJavaScriptContext& jsContext) {
     return jsContext.dumpMemoryStatistics();
 }
@@ -3000,7 +3166,13 @@ Result<Value> JavaScriptRuntime::evaluateScript(const BytesView& script, const S
     Result<Value> result;
     dispatchSynchronouslyOnJsThread([&](JavaScriptEntryParameters& jsEntry) {
         auto loadResult =
-            loadJsModuleFromBytes(jsEntry.jsContext, script, sourceFilename, nullptr, 0, jsEntry.exceptionTracker);
+            loadJsModuleFromBytes(jsEntry.jsContext,
+                                  script,
+                                  sourceFilename,
+                                  nullptr,
+                                  0,
+                                  /* useBytecodeCache */ false,
+                                  jsEntry.exceptionTracker);
 
         if (!jsEntry.exceptionTracker) {
             result = jsEntry.exceptionTracker.extractError();
@@ -3149,6 +3321,8 @@ std::shared_ptr<snap::valdi::JSRuntime> JavaScriptRuntime::createWorker() {
                                                        _anrDetector,
                                                        _logger,
                                                        true);
+    // Workers evaluate the same modules as the main runtime, they share its compiled bytecode
+    workerRuntime->setBytecodeCache(_bytecodeCache);
     workerRuntime->postInit();
     for (const auto& moduleFactory : _moduleFactories) {
         workerRuntime->registerJavaScriptModuleFactory(moduleFactory);
@@ -3170,6 +3344,11 @@ void JavaScriptRuntime::runOnJsThread(const Value& runnable) {
 }
 
 void JavaScriptRuntime::daemonClientConnected(const Shared<IDaemonClient>& daemonClient) {
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        _connectedDaemonClients.emplace_back(daemonClient);
+    }
+
     dispatchOnJsThreadUnattributed([=](JavaScriptEntryParameters& jsEntry) {
         Value wrappedDaemonClient;
 
@@ -3218,6 +3397,11 @@ void JavaScriptRuntime::daemonClientConnected(const Shared<IDaemonClient>& daemo
 }
 
 void JavaScriptRuntime::daemonClientDisconnected(const Shared<IDaemonClient>& daemonClient) {
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        eraseFirstIf(_connectedDaemonClients, [&](const auto& it) { return it == daemonClient; });
+    }
+
     dispatchOnJsThreadUnattributed([=](JavaScriptEntryParameters& jsEntry) {
         const auto& it = _daemonClients.find(daemonClient->getConnectionId());
         if (it != _daemonClients.end()) {
@@ -3439,6 +3623,8 @@ std::vector<JavaScriptCapturedStacktrace> JavaScriptRuntime::captureStackTraces(
 }
 
 void JavaScriptRuntime::onInterrupt(IJavaScriptContext& jsContext) {
+    captureStackSample(jsContext);
+
     for (;;) {
         Ref<JavaScriptStacktraceCaptureSession> captureSession;
 
@@ -3490,8 +3676,16 @@ void JavaScriptRuntime::dispatchOnJsThread(Ref<Context> ownerContext,
                                            JavaScriptTaskScheduleType scheduleType,
                                            uint32_t delayMs,
                                            JavaScriptThreadTask&& function) {
-    auto dispatchFunc = makeJsThreadDispatchFunction(
-        ownerContext != nullptr ? std::move(ownerContext) : Ref(_globalContext), std::move(function));
+    if (ownerContext == nullptr) {
+        ownerContext = _globalContext;
+    }
+
+    if (scheduleType == JavaScriptTaskScheduleTypeDefault && !_dispatchQueue->isCurrent()) {
+        dispatchBatchedOnJsThread(std::move(ownerContext), std::move(function));
+        return;
+    }
+
+    auto dispatchFunc = makeJsThreadDispatchFunction(std::move(ownerContext), std::move(function));
 
     if (scheduleType == JavaScriptTaskScheduleTypeAlwaysAsync) {
         _dispatchQueue->asyncAfter(std::move(dispatchFunc), std::chrono::milliseconds(delayMs));
@@ -3503,11 +3697,58 @@ void JavaScriptRuntime::dispatchOnJsThread(Ref<Context> ownerContext,
         return;
     }
 
-    if (scheduleType == JavaScriptTaskScheduleTypeAlwaysSync) {
-        _dispatchQueue->sync(dispatchFunc);
-    } else {
-        _dispatchQueue->async(std::move(dispatchFunc));
+    // The sync task must run after the async tasks which were dispatched before it
+    closeJsTaskBatch();
+    _dispatchQueue->sync(dispatchFunc);
+}
+
+void JavaScriptRuntime::dispatchBatchedOnJsThread(Ref<Context>&& ownerContext, JavaScriptThreadTask&& jsTask) {
+    std::lock_guard<Mutex> lock(_jsTaskBatchMutex);
+    if (_openJsTaskBatch == nullptr) {
+        _openJsTaskBatch = makeShared<JsTaskBatch>();
+        _dispatchQueue->async([this, batch = _openJsTaskBatch]() { flushJsTaskBatch(batch); });
+    }
+
+    _openJsTaskBatch->tasks.emplace_back(PendingJsTask{RetainedContext(std::move(ownerContext)), std::move(jsTask)});
+}
+
+void JavaScriptRuntime::closeJsTaskBatch() {
+    std::lock_guard<Mutex> lock(_jsTaskBatchMutex);
+    _openJsTaskBatch = nullptr;
+}
+
+void JavaScriptRuntime::flushJsTaskBatch(const Ref<JsTaskBatch>& batch) {
+    std::vector<PendingJsTask> tasks;
+    {
+        std::lock_guard<Mutex> lock(_jsTaskBatchMutex);
+        if (_openJsTaskBatch == batch) {
+            _openJsTaskBatch = nullptr;
+        }
+        tasks = std::move(batch->tasks);
     }
+
+    if (_javaScriptContext == nullptr || !_running) {
+        return;
+    }
+
+    // Consecutive tasks of the same context share a single VM entry
+    size_t groupStart = 0;
+    while (groupStart < tasks.size()) {
+        const auto& ownerContext = tasks[groupStart].context.context;
+        auto groupEnd = groupStart + 1;
+        while (groupEnd < tasks.size() && tasks[groupEnd].context.context == ownerContext) {
+            groupEnd++;
+        }
+
+        runJsTasks(ownerContext, tasks.data() + groupStart, groupEnd - groupStart);
+        groupStart = groupEnd;
+
+        if (_javaScriptContext == nullptr || !_running) {
+            return;
+        }
+    }
+
+    scheduleIdleGcIfNeeded();
 }
 
 void JavaScriptRuntime::dispatchSynchronouslyOnJsThread(JavaScriptThreadTask&& function) {
@@ -3543,21 +3784,63 @@ DispatchFunction JavaScriptRuntime::makeJsThreadDispatchFunction(Ref<Context>&&
             auto module = ownerContext->getPath().getResourceId().bundleName;
             ScopedMetrics metrics = isSync ? Metrics::thresholdedScopedSlowSyncJsCall(getMetrics(), module) :
                                              Metrics::thresholdedScopedSlowAsyncJsCall(getMetrics(), module);
-            auto& jsContext = *_javaScriptContext;
+            _jsTaskStartTime = std::chrono::steady_clock::now();
+            _jsTaskStartBridgeCrossings = BridgeCrossings::current();
 
             JavaScriptContextEntry contextEntry(ownerContext);
-            JSExceptionTracker exceptionTracker(jsContext);
-            {
-                JavaScriptEntryParameters jsEntry(jsContext, exceptionTracker, ownerContext);
+            runJsTask(*_javaScriptContext, ownerContext, jsTask);
+        });
 
-                jsTask(jsEntry);
-            }
+        scheduleIdleGcIfNeeded();
+    };
+}
+
+void JavaScriptRuntime::runJsTasks(const Ref<Context>& ownerContext, PendingJsTask* tasks, size_t size) {
+    _lastDispatchedContextId = ownerContext->getContextId();
+
+    ownerContext->withAttribution([&]() {
+        auto module = ownerContext->getPath().getResourceId().bundleName;
+        ScopedMetrics metrics = Metrics::thresholdedScopedSlowAsyncJsCall(getMetrics(), module);
+        auto& jsContext = *_javaScriptContext;
+        _jsTaskStartTime = std::chrono::steady_clock::now();
+        _jsTaskStartBridgeCrossings = BridgeCrossings::current();
+
+        JavaScriptContextEntry contextEntry(ownerContext);
+        if (size == 1) {
+            runJsTask(jsContext, ownerContext, tasks[0].task);
+            return;
+        }
 
-            if (!exceptionTracker) {
-                handleUncaughtJsError(jsContext, ownerContext, exceptionTracker);
+        // Pending jobs are executed once the outermost entry exits, after the last task of the group.
+        // Each task still gets its own exception tracker, so that a failing task does not prevent
+        // the next ones from running.
+        JSExceptionTracker exceptionTracker(jsContext);
+        {
+            JavaScriptEntryParameters jsEntry(jsContext, exceptionTracker, ownerContext);
+            for (size_t i = 0; i < size; i++) {
+                runJsTask(jsContext, ownerContext, tasks[i].task);
             }
-        });
-    };
+        }
+
+        if (!exceptionTracker) {
+            handleUncaughtJsError(jsContext, ownerContext, exceptionTracker);
+        }
+    });
+}
+
+void JavaScriptRuntime::runJsTask(IJavaScriptContext& jsContext,
+                                  const Ref<Context>& ownerContext,
+                                  const JavaScriptThreadTask& jsTask) {
+    JSExceptionTracker exceptionTracker(jsContext);
+    {
+        JavaScriptEntryParameters jsEntry(jsContext, exceptionTracker, ownerContext);
+
+        jsTask(jsEntry);
+    }
+
+    if (!exceptionTracker) {
+        handleUncaughtJsError(jsContext, ownerContext, exceptionTracker);
+    }
 }
 
 void JavaScriptRuntime::onInitError(std::string_view failingAction, const Error& error) {
@@ -3695,6 +3978,112 @@ void JavaScriptRuntime::stopProfiling(Function<void(const Result<std::vector<std
     });
 }
 
+Ref<JavaScriptSamplingProfiler> JavaScriptRuntime::getSamplingProfiler() {
+    std::lock_guard<Mutex> lock(_mutex);
+    return _samplingProfiler;
+}
+
+void JavaScriptRuntime::startSamplingProfiler(std::chrono::steady_clock::duration samplingInterval) {
+    Ref<JavaScriptSamplingProfiler> samplingProfiler;
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        if (_samplingProfiler == nullptr) {
+            _samplingProfiler = makeShared<JavaScriptSamplingProfiler>();
+        }
+        samplingProfiler = _samplingProfiler;
+    }
+
+    samplingProfiler->setListener(this);
+    samplingProfiler->start(samplingInterval, kSamplingProfileFlushInterval);
+}
+
+JavaScriptSamplingProfile JavaScriptRuntime::stopSamplingProfiler() {
+    auto samplingProfiler = getSamplingProfiler();
+    if (samplingProfiler == nullptr) {
+        return JavaScriptSamplingProfile();
+    }
+
+    samplingProfiler->stop();
+    return samplingProfiler->flush();
+}
+
+void JavaScriptRuntime::detachSamplingProfiler() {
+    auto samplingProfiler = getSamplingProfiler();
+    if (samplingProfiler != nullptr) {
+        samplingProfiler->stop();
+        samplingProfiler->setListener(nullptr);
+    }
+}
+
+void JavaScriptRuntime::onSampleRequested() {
+    std::lock_guard<Mutex> lock(_mutex);
+    if (_javaScriptContext == nullptr) {
+        return;
+    }
+
+    _stackSampleRequestTime = std::chrono::steady_clock::now().time_since_epoch().count();
+    _javaScriptContext->requestInterrupt();
+}
+
+void JavaScriptRuntime::captureStackSample(IJavaScriptContext& jsContext) {
+    auto requestTime = _stackSampleRequestTime.exchange(0);
+    if (requestTime == 0) {
+        return;
+    }
+
+    // The interrupt is served whenever JS code runs next. If the JS thread was idle when the sample
+    // was requested, we would otherwise attribute the sample to the beginning of the next task.
+    auto latency =
+        std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(requestTime);
+    if (latency > kMaxStackSampleLatency) {
+        return;
+    }
+
+    auto samplingProfiler = getSamplingProfiler();
+    if (samplingProfiler == nullptr) {
+        return;
+    }
+
+    // Symbolication is left to the consumers of the profile, to keep the sampling cheap
+    StringBox stackTrace;
+    JSExceptionTracker exceptionTracker(jsContext);
+    auto error = jsContext.newError("", std::nullopt, exceptionTracker);
+    if (exceptionTracker) {
+        auto jsStack = jsContext.getObjectProperty(error.get(), "stack", exceptionTracker);
+        if (exceptionTracker) {
+            stackTrace = jsContext.valueToString(jsStack.get(), exceptionTracker);
+        }
+    }
+    exceptionTracker.clearError();
+
+    auto context = Context::currentRef();
+    if (context == nullptr) {
+        context = getLastDispatchedContext();
+    }
+
+    samplingProfiler->addSample(context, stackTrace.toStringView());
+}
+
+void JavaScriptRuntime::onProfileFlushed(const JavaScriptSamplingProfile& profile) {
+    std::vector<Shared<IDaemonClient>> daemonClients;
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        daemonClients = _connectedDaemonClients;
+    }
+
+    if (daemonClients.empty()) {
+        return;
+    }
+
+    auto samplingIntervalMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(profile.samplingInterval).count();
+    auto foldedStacks = profile.toFoldedString();
+    for (const auto& daemonClient : daemonClients) {
+        daemonClient->sendJsSamplingProfile(
+            static_cast<int64_t>(samplingIntervalMs), static_cast<int64_t>(profile.samplesCount), foldedStacks);
+    }
+}
+
 ILogger& JavaScriptRuntime::getLogger() const {
     return *_logger;
 }
@@ -3725,6 +4114,55 @@ Result<BytesView> JavaScriptRuntime::dumpHeap() {
     }
 }
 
+Result<Void> JavaScriptRuntime::dumpHeap(JavaScriptHeapDumpOutputStream& output,
+                                         const JavaScriptHeapDumpOptions& options) {
+    if constexpr (Valdi::shouldEnableJsHeapDump()) {
+        JavaScriptHeapDumpBuilder heapDumpBuilder;
+        Result<Void> result = Void();
+        dispatchSynchronouslyOnJsThread([&](JavaScriptEntryParameters& entry) {
+            std::vector<IJavaScriptContext*> jsContexts;
+
+            lockAllJSContexts(jsContexts, [&]() {
+                auto span = std::span<IJavaScriptContext*>(jsContexts.data(), jsContexts.size());
+                if (!_javaScriptBridge.appendHeapDump(span, heapDumpBuilder, entry.exceptionTracker)) {
+                    auto heapDump = _javaScriptBridge.dumpHeap(span, entry.exceptionTracker);
+                    if (entry.exceptionTracker) {
+                        heapDumpBuilder.appendDump(heapDump.data(), heapDump.size(), entry.exceptionTracker);
+                    }
+                }
+            });
+
+            if (!entry.exceptionTracker) {
+                result = entry.exceptionTracker.extractError();
+            }
+        });
+
+        if (!result) {
+            return result;
+        }
+
+        // Serialization happens outside of the JS thread, as it can take a while for large heaps
+        std::optional<JavaScriptHeapDumpZStdOutputStream> compressedOutput;
+        auto* destination = &output;
+        if (options.compress) {
+            destination = &compressedOutput.emplace(output, kHeapDumpCompressionLevel);
+        }
+
+        if (options.summaryOnly) {
+            auto summary = heapDumpBuilder.buildSummary(kHeapDumpSummaryMaxHistogramEntries);
+            result = destination->write(summary.data(), summary.size());
+            if (!result) {
+                return result;
+            }
+            return destination->finish();
+        }
+
+        return heapDumpBuilder.write(*destination, kHeapDumpChunkSize);
+    } else {
+        return Error("Heap dump support not enabled");
+    }
+}
+
 Result<Ref<Context>> JavaScriptRuntime::getContextForId(ContextId contextId) const {
     // We lookup in the ContextManager first, to handle both contexts that are created externally
     // and contexts that are created directly in JS (which happens when running tests)
@@ -17,10 +17,12 @@
 #include "valdi/runtime/Context/RawViewNodeId.hpp"
 
 #include "valdi/runtime/Resources/Bundle.hpp"
+#include "valdi/runtime/Resources/IResourceManagerListener.hpp"
 
 #include "valdi/runtime/Utils/AsyncGroup.hpp"
 #include "valdi/runtime/Utils/DumpedLogs.hpp"
 
+#include "valdi_core/cpp/Utils/BridgeCrossings.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
@@ -35,6 +37,7 @@
 
 #include "valdi/runtime/JavaScript/JSPropertyNameIndex.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptComponentContextHandler.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptSamplingProfiler.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptStringCache.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptTaskScheduler.hpp"
 #include "valdi_core/cpp/JavaScript/JavaScriptPathResolver.hpp"
@@ -43,6 +46,7 @@
 #include "utils/time/StopWatch.hpp"
 
 #include "valdi_core/cpp/Utils/Function.hpp"
+#include <chrono>
 #include <future>
 #include <tuple>
 #include <utility>
@@ -63,6 +67,7 @@ class ContextComponentRenderer;
 class ViewNode;
 class JavaScriptRuntimeDeserializers;
 class IDiskCache;
+class JavaScriptBytecodeCache;
 class AttributeIds;
 class StyleAttributesCache;
 class IDaemonClient;
@@ -71,6 +76,7 @@ class AsyncGroup;
 class Marshaller;
 class TimePoint;
 class JavaScriptANRDetector;
+class JavaScriptHeapDumpOutputStream;
 
 struct AnimationOptions;
 
@@ -146,6 +152,14 @@ enum class ModuleLoadMode {
 
 using ModuleLoadResult = std::pair<JSValueRef, ModuleLoadMode>;
 
+struct JavaScriptHeapDumpOptions {
+    // Whether the dump should be compressed as a zstd frame while it is written
+    bool compress = false;
+    // Whether to only write a small JSON summary of the heap, with the nodes aggregated
+    // by type and name, instead of the full dump
+    bool summaryOnly = false;
+};
+
 struct ModuleMemoryConsumptionInfo {
     ptrdiff_t waterMark;           // The memory usage water mark before loading
     ptrdiff_t childrenConsumption; // Total memory usage by children of this module
@@ -159,7 +173,9 @@ struct ModuleMemoryConsumptionInfo {
 class JavaScriptRuntime : public JavaScriptTaskScheduler,
                           public IJavaScriptContextListener,
                           public snap::valdi::JSRuntime,
-                          public JavaScriptComponentContextHandlerListener {
+                          public JavaScriptComponentContextHandlerListener,
+                          public IResourceManagerListener,
+                          public IJavaScriptSamplingProfilerListener {
 public:
     JavaScriptRuntime(IJavaScriptBridge& jsBridge,
                       ResourceManager& resourceManager,
@@ -176,6 +192,12 @@ public:
 
     void postInit();
 
+    /**
+     Set the cache holding the bytecode of the JS modules which are shipped as source.
+     Must be called before postInit().
+     */
+    void setBytecodeCache(const Ref<JavaScriptBytecodeCache>& bytecodeCache);
+
     void setListener(IJavaScriptRuntimeListener* listener);
     IJavaScriptRuntimeListener* getListener() const;
 
@@ -220,6 +242,9 @@ public:
     MainThreadManager* getMainThreadManager() const override;
 
     void onUnhandledRejectedPromise(IJavaScriptContext& jsContext, const JSValue& promiseResult) override;
+
+    void bundleIsBeingUnloaded(const Shared<Bundle>& bundle) final;
+    void bundleRemoteArchiveDidLoad(const Ref<Bundle>& bundle) final;
     void onInterrupt(IJavaScriptContext& jsContext) final;
 
     void dispatchOnJsThread(Ref<Context> ownerContext,
@@ -293,6 +318,22 @@ public:
 
     void stopProfiling(Function<void(const Result<std::vector<std::string>>&)> onComplete);
 
+    /**
+     Start sampling the JS stack at the given interval. Samples are attributed to the component
+     which was running, and the aggregated profile is periodically sent to the connected
+     daemon clients.
+     */
+    void startSamplingProfiler(std::chrono::steady_clock::duration samplingInterval);
+
+    /**
+     Stop the sampling profiler and return the samples which were not sent yet.
+     */
+    JavaScriptSamplingProfile stopSamplingProfiler();
+
+    // IJavaScriptSamplingProfilerListener
+    void onSampleRequested() final;
+    void onProfileFlushed(const JavaScriptSamplingProfile& profile) final;
+
     ILogger& getLogger() const;
 
     TimePoint getPerformanceTimeOrigin() const;
@@ -303,6 +344,12 @@ public:
 
     Result<BytesView> dumpHeap();
 
+    /**
+     Write the heap dump into the given output stream in bounded chunks, so that
+     the serialized dump is never fully held in memory.
+     */
+    Result<Void> dumpHeap(JavaScriptHeapDumpOutputStream& output, const JavaScriptHeapDumpOptions& options);
+
 private:
     struct RegisteredTypeConverter {
         StringBox typeName;
@@ -313,6 +360,14 @@ private:
         JSValueRef request;
         Ref<ValueFunction> callback;
     };
+    struct PendingJsTask {
+        RetainedContext context;
+        JavaScriptThreadTask task;
+    };
+    // Async tasks posted from other threads which are run together from a single JS thread task
+    struct JsTaskBatch : public SimpleRefCountable {
+        std::vector<PendingJsTask> tasks;
+    };
 
     Mutex _mutex;
     IJavaScriptBridge& _javaScriptBridge;
@@ -337,6 +392,7 @@ private:
     JSPropertyNameIndex<6> _propertyNameIndex;
 
     Ref<IDiskCache> _diskCache;
+    Ref<JavaScriptBytecodeCache> _bytecodeCache;
     // List of JS modules which should be reloaded whenever they are unloaded
     FlatSet<ResourceId> _modulesToAutoReload;
     // List of JS modules which were unloaded and need to be reloaded
@@ -347,11 +403,18 @@ private:
     JavaScriptStringCache _stringCache;
 
     Ref<DispatchQueue> _dispatchQueue;
+    Mutex _jsTaskBatchMutex;
+    // Batch which async tasks are appended to until it gets flushed or a sync task is dispatched
+    Ref<JsTaskBatch> _openJsTaskBatch;
     std::atomic<bool> _isDisposed;
     std::atomic<ContextId> _lastDispatchedContextId;
+    // Start time of the JS task currently running, or of the last render request it submitted
+    std::chrono::steady_clock::time_point _jsTaskStartTime;
+    BridgeCrossings _jsTaskStartBridgeCrossings;
     // A lock that will block the JS thread until postInit() is called and the initialization has completed
     AsyncGroup _initLock;
     bool _hasGcScheduled = false;
+    bool _idleGcScheduled = false;
     bool _symbolicating = false;
     bool _running = false;
     bool _enableDebugger;
@@ -368,6 +431,10 @@ private:
     std::vector<Ref<JavaScriptModuleFactory>> _moduleFactories;
     std::vector<RegisteredTypeConverter> _typeConverters;
     std::vector<Ref<JavaScriptStacktraceCaptureSession>> _stacktraceCaptureSessions;
+    Ref<JavaScriptSamplingProfiler> _samplingProfiler;
+    std::vector<Shared<IDaemonClient>> _connectedDaemonClients;
+    // Time at which the pending stack sample was requested, or 0 if there is none
+    std::atomic<std::chrono::steady_clock::rep> _stackSampleRequestTime = 0;
     std::vector<Weak<JavaScriptRuntime>> _jsWorkers;
 
     Shared<JSValueRefHolder> _uncaughtExceptionHandler;
@@ -519,6 +586,8 @@ private:
     std::vector<Ref<JavaScriptRuntime>> getAllWorkers();
     void dispatchPerformGcToWorkers();
     void performGcNow(IJavaScriptContext& jsContext);
+    void scheduleIdleGcIfNeeded();
+    void performIdleGcNow(std::chrono::steady_clock::time_point deadline);
     JavaScriptContextMemoryStatistics dumpMemoryStatistics(IJavaScriptContext& jsContext);
 
     [[nodiscard]] Result<Shared<JavaScriptModuleContainer>> loadModuleContent(
@@ -546,8 +615,17 @@ private:
                                            const StringBox& importPath,
                                            const JSValueRef* parameters,
                                            size_t parametersLength,
+                                           bool useBytecodeCache,
                                            JSExceptionTracker& exceptionTracker);
 
+    bool shouldUseBytecodeCache() const;
+    bool shouldPreCompileRemoteModules() const;
+
+    JSValueRef evaluateJsModuleWithBytecodeCache(IJavaScriptContext& jsContext,
+                                                 const BytesView& jsModule,
+                                                 const StringBox& importPath,
+                                                 JSExceptionTracker& exceptionTracker);
+
     ModuleLoadResult loadJsModuleFromNative(IJavaScriptContext& jsContext,
                                             const StringBox& importPath,
                                             const JSValueRef* parameters,
@@ -573,6 +651,11 @@ private:
     void onRecoverableError(std::string_view failingAction, const Error& error);
 
     DispatchFunction makeJsThreadDispatchFunction(Ref<Context>&& ownerContext, JavaScriptThreadTask&& jsTask);
+    void dispatchBatchedOnJsThread(Ref<Context>&& ownerContext, JavaScriptThreadTask&& jsTask);
+    void closeJsTaskBatch();
+    void flushJsTaskBatch(const Ref<JsTaskBatch>& batch);
+    void runJsTasks(const Ref<Context>& ownerContext, PendingJsTask* tasks, size_t size);
+    void runJsTask(IJavaScriptContext& jsContext, const Ref<Context>& ownerContext, const JavaScriptThreadTask& jsTask);
 
     void dispatchOnJsThreadUnattributed(JavaScriptThreadTask&& function);
 
@@ -591,6 +674,9 @@ private:
     void teardown(bool destroyContext);
 
     Ref<JSStackTraceProvider> doCaptureCurrentStackTrace(IJavaScriptContext& jsContext);
+    void captureStackSample(IJavaScriptContext& jsContext);
+    Ref<JavaScriptSamplingProfiler> getSamplingProfiler();
+    void detachSamplingProfiler();
 
     static void lockNextWorker(std::vector<IJavaScriptContext*>& jsContexts,
                                std::vector<Ref<JavaScriptRuntime>>& jsWorkers,
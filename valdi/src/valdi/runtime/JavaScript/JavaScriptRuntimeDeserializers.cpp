@@ -114,16 +114,16 @@ static Ref<RenderRequest> onParseError(JSExceptionTracker& exceptionTracker) {
 }
 
 const Value& JavaScriptRuntimeDeserializers::getAttachedValue(const RenderRequestDescriptor& requestDescriptor,
-                                                              const Ref<ValueArray>& values,
+                                                              std::vector<Value>& values,
                                                               size_t index,
                                                               const ReferenceInfoBuilder& referenceInfoBuilder,
                                                               JSExceptionTracker& exceptionTracker) const {
-    if (values == nullptr || index >= values->size()) {
+    if (index >= values.size()) {
         onParseError(exceptionTracker);
         return Value::undefinedRef();
     }
 
-    auto& entry = (*values)[index];
+    auto& entry = values[index];
     if (entry.isNull()) {
         auto propertyValue = _jsContext.getObjectPropertyForIndex(requestDescriptor.values, index, exceptionTracker);
         if (!exceptionTracker) {
@@ -147,7 +147,9 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
     const auto* descriptor = reinterpret_cast<const uint32_t*>(requestDescriptor.descriptor.data);
 
     auto valuesSize = requestDescriptor.valuesLength;
-    Ref<ValueArray> values = valuesSize > 0 ? ValueArray::make(valuesSize) : nullptr;
+    // Lazily resolved attached values, reused across requests
+    auto values = makeReusableArray<Value>();
+    values->resize(static_cast<size_t>(valuesSize));
     auto length = static_cast<size_t>(requestDescriptor.descriptorSize);
     if (requestDescriptor.descriptor.length / 4 < length) {
         return onParseError(exceptionTracker);
@@ -160,7 +162,7 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
 
         RawViewNodeId nodeId = 0;
 
-        if (type < 14) {
+        if (type < 14 || type == 18) {
             // Those are always tied to a node id.
             nodeId = static_cast<RawViewNodeId>(typeHeader >> 8);
         }
@@ -200,7 +202,7 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
             entry->setElementId(nodeId);
             entry->setParentElementId(static_cast<RawViewNodeId>(parentId));
             entry->setParentIndex(static_cast<int>(parentIndex));
-        } else if (type >= 5 && type <= 13) {
+        } else if ((type >= 5 && type <= 13) || type == 18) {
             if (current + 1 > length) {
                 return onParseError(exceptionTracker);
             }
@@ -268,7 +270,7 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
                     valueArray->emplace(
                         i,
                         getAttachedValue(requestDescriptor,
-                                         values,
+                                         *values,
                                          valueIndex,
                                          ReferenceInfoBuilder().withProperty(attributeName).withArrayIndex(i),
                                          exceptionTracker));
@@ -300,7 +302,7 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
                 auto attributeName = _styleAttributesCache.getAttributeIds().getNameForId(attributeId);
 
                 entry->setAttributeValue(getAttachedValue(requestDescriptor,
-                                                          values,
+                                                          *values,
                                                           valueIndex,
                                                           ReferenceInfoBuilder().withProperty(attributeName),
                                                           exceptionTracker));
@@ -308,6 +310,17 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
                     return nullptr;
                 }
                 disableCallIfContextIsDestroyed(entry->getAttributeValue());
+            } else if (type == 18) {
+                // String interned in the JavaScriptStringCache
+                if (current + 1 > length) {
+                    return onParseError(exceptionTracker);
+                }
+                auto str = _stringCache.get(descriptor[current++]);
+                if (!str) {
+                    return onParseError(exceptionTracker);
+                }
+
+                entry->setAttributeValue(Value(std::move(*str)));
             }
         } else if (type == 14) {
             if (current + 12 > length) {
@@ -340,7 +353,7 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
             animationOptions.damping = damping;
             animationOptions.completionCallback =
                 getAttachedValue(requestDescriptor,
-                                 values,
+                                 *values,
                                  completionIndex,
                                  ReferenceInfoBuilder().withObject(kAnimationCompletion),
                                  exceptionTracker);
@@ -351,7 +364,7 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
             disableCallIfContextIsDestroyed(animationOptions.completionCallback);
 
             const auto& controlPoints = getAttachedValue(
-                requestDescriptor, values, controlPointsIndex, ReferenceInfoBuilder(), exceptionTracker);
+                requestDescriptor, *values, controlPointsIndex, ReferenceInfoBuilder(), exceptionTracker);
             if (!exceptionTracker) {
                 return nullptr;
             }
@@ -370,7 +383,7 @@ Ref<RenderRequest> JavaScriptRuntimeDeserializers::parseRequestDescriptor(
 
             auto* entry = renderRequest->appendOnLayoutComplete();
             entry->setCallback(getAttachedValue(requestDescriptor,
-                                                values,
+                                                *values,
                                                 valueIndex,
                                                 ReferenceInfoBuilder().withObject(kOnLayoutComplete),
                                                 exceptionTracker)
@@ -46,7 +46,7 @@ private:
                                               JSExceptionTracker& exceptionTracker);
 
     const Value& getAttachedValue(const RenderRequestDescriptor& requestDescriptor,
-                                  const Ref<ValueArray>& values,
+                                  std::vector<Value>& values,
                                   size_t index,
                                   const ReferenceInfoBuilder& referenceInfoBuilder,
                                   JSExceptionTracker& exceptionTracker) const;
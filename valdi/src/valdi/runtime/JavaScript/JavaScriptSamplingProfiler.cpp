@@ -0,0 +1,216 @@
+//
+//  JavaScriptSamplingProfiler.cpp
+//  valdi
+//
+//  Copyright © 2024 Snap Inc. All rights reserved.
+//
+
+#include "valdi/runtime/JavaScript/JavaScriptSamplingProfiler.hpp"
+
+#include "valdi/runtime/Context/Context.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fmt/format.h>
+
+namespace Valdi {
+
+constexpr std::string_view kUnattributedComponent = "<unattributed>";
+constexpr std::string_view kFramePrefix = "at ";
+
+static std::string_view trim(std::string_view str) {
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front())) != 0) {
+        str = str.substr(1);
+    }
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back())) != 0) {
+        str = str.substr(0, str.size() - 1);
+    }
+    return str;
+}
+
+static std::string_view removeTrailingNumber(std::string_view location) {
+    auto separatorIndex = location.rfind(':');
+    if (separatorIndex == std::string_view::npos || separatorIndex + 1 == location.size()) {
+        return location;
+    }
+
+    for (auto c : location.substr(separatorIndex + 1)) {
+        if (std::isdigit(static_cast<unsigned char>(c)) == 0) {
+            return location;
+        }
+    }
+
+    return location.substr(0, separatorIndex);
+}
+
+static void appendFrame(std::string& output, std::string_view frame) {
+    // Frames look like "fn (file.js:12:4)", we keep the function and the file only
+    if (!frame.empty() && frame.back() == ')') {
+        auto locationStart = frame.rfind('(');
+        if (locationStart != std::string_view::npos) {
+            auto location = frame.substr(locationStart + 1, frame.size() - locationStart - 2);
+            location = removeTrailingNumber(removeTrailingNumber(location));
+            auto function = trim(frame.substr(0, locationStart));
+            frame = std::string_view();
+
+            output.append(function);
+            output.append(" (");
+            output.append(location);
+            output.append(")");
+        }
+    }
+
+    output.append(frame);
+}
+
+std::string JavaScriptSamplingProfile::toFoldedString() const {
+    std::string output;
+    for (const auto& [stack, count] : foldedStacks) {
+        output += fmt::format("{} {}\n", stack, count);
+    }
+    return output;
+}
+
+JavaScriptSamplingProfiler::JavaScriptSamplingProfiler()
+    : _dispatchQueue(DispatchQueue::create(STRING_LITERAL("com.snap.valdi.JSSamplingProfiler"),
+                                           ThreadQoSClass::ThreadQoSClassNormal)),
+      _samplingInterval(std::chrono::milliseconds(10)),
+      _flushInterval(std::chrono::seconds(1)) {}
+
+JavaScriptSamplingProfiler::~JavaScriptSamplingProfiler() {
+    _dispatchQueue->fullTeardown();
+}
+
+void JavaScriptSamplingProfiler::start(std::chrono::steady_clock::duration samplingInterval,
+                                       std::chrono::steady_clock::duration flushInterval) {
+    std::lock_guard<Mutex> lock(_mutex);
+    _samplingInterval = samplingInterval;
+    _flushInterval = flushInterval;
+    _lastFlushTime = std::chrono::steady_clock::now();
+    _started = true;
+    scheduleNextTick();
+}
+
+void JavaScriptSamplingProfiler::stop() {
+    std::lock_guard<Mutex> lock(_mutex);
+    _started = false;
+    if (_nextTickTask != 0) {
+        _dispatchQueue->cancel(_nextTickTask);
+        _nextTickTask = 0;
+    }
+}
+
+bool JavaScriptSamplingProfiler::isStarted() const {
+    std::lock_guard<Mutex> lock(_mutex);
+    return _started;
+}
+
+void JavaScriptSamplingProfiler::setListener(IJavaScriptSamplingProfilerListener* listener) {
+    std::lock_guard<Mutex> lock(_mutex);
+    _listener = listener;
+}
+
+void JavaScriptSamplingProfiler::addSample(const Ref<Context>& context, std::string_view stackTrace) {
+    std::string foldedStack;
+    if (context != nullptr && !context->getPath().isEmpty()) {
+        foldedStack = context->getPath().toString();
+        std::replace(foldedStack.begin(), foldedStack.end(), ';', ':');
+    } else {
+        foldedStack = kUnattributedComponent;
+    }
+
+    auto frames = foldStackTrace(stackTrace);
+    if (!frames.empty()) {
+        foldedStack += ';';
+        foldedStack += frames;
+    }
+
+    std::lock_guard<Mutex> lock(_mutex);
+    _foldedStacks[std::move(foldedStack)]++;
+    _samplesCount++;
+}
+
+JavaScriptSamplingProfile JavaScriptSamplingProfiler::flush() {
+    std::lock_guard<Mutex> lock(_mutex);
+    return lockFreeFlush();
+}
+
+JavaScriptSamplingProfile JavaScriptSamplingProfiler::lockFreeFlush() {
+    JavaScriptSamplingProfile profile;
+    profile.samplingInterval = _samplingInterval;
+    profile.samplesCount = _samplesCount;
+    profile.foldedStacks.reserve(_foldedStacks.size());
+    for (auto& it : _foldedStacks) {
+        profile.foldedStacks.emplace_back(it.first, it.second);
+    }
+    std::sort(profile.foldedStacks.begin(), profile.foldedStacks.end());
+
+    _foldedStacks.clear();
+    _samplesCount = 0;
+    _lastFlushTime = std::chrono::steady_clock::now();
+
+    return profile;
+}
+
+void JavaScriptSamplingProfiler::scheduleNextTick() {
+    if (_nextTickTask != 0 || !_started) {
+        return;
+    }
+
+    _nextTickTask = _dispatchQueue->asyncAfter(
+        [self = Valdi::weakRef(this)]() {
+            auto strongSelf = self.lock();
+            if (strongSelf != nullptr) {
+                strongSelf->onTick();
+            }
+        },
+        _samplingInterval);
+}
+
+void JavaScriptSamplingProfiler::onTick() {
+    // The listener is called with the lock held, so that it cannot be
+    // removed and destroyed while it is being called.
+    std::lock_guard<Mutex> lock(_mutex);
+    _nextTickTask = 0;
+    if (!_started || _listener == nullptr) {
+        return;
+    }
+
+    _listener->onSampleRequested();
+
+    if (_samplesCount > 0 && std::chrono::steady_clock::now() - _lastFlushTime >= _flushInterval) {
+        _listener->onProfileFlushed(lockFreeFlush());
+    }
+
+    scheduleNextTick();
+}
+
+std::string JavaScriptSamplingProfiler::foldStackTrace(std::string_view stackTrace) {
+    std::vector<std::string_view> frames;
+    while (!stackTrace.empty()) {
+        auto separatorIndex = stackTrace.find('\n');
+        auto line = trim(stackTrace.substr(0, separatorIndex));
+        stackTrace = separatorIndex == std::string_view::npos ? std::string_view() :
+                                                                stackTrace.substr(separatorIndex + 1);
+
+        // Lines which are not frames, like the error message of V8 stacks, are ignored
+        if (line.substr(0, kFramePrefix.size()) == kFramePrefix) {
+            frames.emplace_back(trim(line.substr(kFramePrefix.size())));
+        }
+    }
+
+    std::string output;
+    for (auto it = frames.rbegin(); it != frames.rend(); it++) {
+        if (!output.empty()) {
+            output += ';';
+        }
+        auto frameStart = output.size();
+        appendFrame(output, *it);
+        std::replace(output.begin() + static_cast<std::ptrdiff_t>(frameStart), output.end(), ';', ':');
+    }
+
+    return output;
+}
+
+} // namespace Valdi
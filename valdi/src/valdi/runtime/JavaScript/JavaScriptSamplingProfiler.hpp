@@ -0,0 +1,111 @@
+//
+//  JavaScriptSamplingProfiler.hpp
+//  valdi
+//
+//  Copyright © 2024 Snap Inc. All rights reserved.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Threading/TaskId.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Valdi {
+
+class Context;
+class DispatchQueue;
+
+/**
+ The samples aggregated by the JavaScriptSamplingProfiler between two flushes.
+ */
+struct JavaScriptSamplingProfile {
+    std::chrono::steady_clock::duration samplingInterval = std::chrono::steady_clock::duration::zero();
+    size_t samplesCount = 0;
+    // Stacks in the folded format, root frame first, with the component which was
+    // running as the first frame, associated with the number of samples they were seen in.
+    std::vector<std::pair<std::string, size_t>> foldedStacks;
+
+    /**
+     Return the profile as folded stack lines, as consumed by flame graph tools.
+     */
+    std::string toFoldedString() const;
+};
+
+class IJavaScriptSamplingProfilerListener {
+public:
+    virtual ~IJavaScriptSamplingProfilerListener() = default;
+
+    /**
+     Called from the profiler thread at every sampling interval. Implementations
+     should capture the stacktrace of the JS code which is currently running, if any,
+     and pass it to addSample() without blocking the profiler thread.
+     */
+    virtual void onSampleRequested() = 0;
+
+    /**
+     Called from the profiler thread with the samples aggregated since the last flush.
+     */
+    virtual void onProfileFlushed(const JavaScriptSamplingProfile& profile) = 0;
+};
+
+/**
+ The JavaScriptSamplingProfiler periodically samples the JS stack and attributes each
+ sample to the component which was running, so that JS time can be split by component
+ with a low enough overhead to be enabled in release builds. It only requests samples
+ from its listener; the JS thread is never blocked by the profiler thread, and ticks
+ where no JS code runs don't produce any sample.
+ */
+class JavaScriptSamplingProfiler : public SharedPtrRefCountable {
+public:
+    JavaScriptSamplingProfiler();
+    ~JavaScriptSamplingProfiler() override;
+
+    void start(std::chrono::steady_clock::duration samplingInterval, std::chrono::steady_clock::duration flushInterval);
+    void stop();
+
+    bool isStarted() const;
+
+    void setListener(IJavaScriptSamplingProfilerListener* listener);
+
+    /**
+     Record a sample with the given raw engine stacktrace, attributed to the given context.
+     Can be called from any thread.
+     */
+    void addSample(const Ref<Context>& context, std::string_view stackTrace);
+
+    /**
+     Return the samples aggregated since the last flush and reset them.
+     */
+    JavaScriptSamplingProfile flush();
+
+    /**
+     Return the frames of the given raw engine stacktrace, root frame first, in the
+     folded format. Line and column numbers are dropped so that samples taken at
+     different locations of the same function are aggregated together.
+     */
+    static std::string foldStackTrace(std::string_view stackTrace);
+
+private:
+    mutable Mutex _mutex;
+    Ref<DispatchQueue> _dispatchQueue;
+    IJavaScriptSamplingProfilerListener* _listener = nullptr;
+    FlatMap<std::string, size_t> _foldedStacks;
+    std::chrono::steady_clock::duration _samplingInterval;
+    std::chrono::steady_clock::duration _flushInterval;
+    std::chrono::steady_clock::time_point _lastFlushTime;
+    size_t _samplesCount = 0;
+    task_id_t _nextTickTask = 0;
+    bool _started = false;
+
+    void onTick();
+    void scheduleNextTick();
+    JavaScriptSamplingProfile lockFreeFlush();
+};
+
+} // namespace Valdi
@@ -259,3 +259,21 @@ struct JSTypedArray {
 };
 
 } // namespace Valdi
+
+namespace std {
+
+template<>
+struct hash<Valdi::JSValue> {
+    std::size_t operator()(const Valdi::JSValue& value) const noexcept {
+        uint64_t words[Valdi::kJSValueStorageSize / sizeof(uint64_t)];
+        std::memcpy(words, value.storage, sizeof(words));
+
+        std::size_t hash = 0;
+        for (auto word : words) {
+            hash = hash * 31 + std::hash<uint64_t>()(word);
+        }
+        return hash;
+    }
+};
+
+} // namespace std
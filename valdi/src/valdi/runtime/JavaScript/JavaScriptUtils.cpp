@@ -15,6 +15,7 @@
 #include "valdi/runtime/JavaScript/JavaScriptCircularRefChecker.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptContextEntryPoint.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptFunctionCallContext.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptLazyArray.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptTaskScheduler.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptValueMarshaller.hpp"
 #include "valdi/runtime/JavaScript/ValueFunctionWithJSValue.hpp"
@@ -242,7 +243,7 @@ JSValueRef valueToJSValue(IJavaScriptContext& jsContext,
                           JSExceptionTracker& exceptionTracker) {
     switch (value.getType()) {
         case ValueType::InternedString:
-            return jsContext.newStringUTF8(value.toStringBox().toStringView(), exceptionTracker);
+            return jsContext.newStringCached(value.toStringBox(), exceptionTracker);
         case ValueType::StaticString:
             return staticStringTOJSValue(jsContext, *value.getStaticString(), exceptionTracker);
         case ValueType::Double:
@@ -300,6 +301,15 @@ JSValueRef valueToJSValue(IJavaScriptContext& jsContext,
         case ValueType::Array: {
             const auto& array = *value.getArray();
 
+            auto lazyArrayMinSize = jsContext.getLazyArrayMinSize();
+            if (lazyArrayMinSize > 0 && array.size() >= lazyArrayMinSize) {
+                return newLazyJSArray(jsContext,
+                                      value.getArrayRef(),
+                                      jsContext.getLazyArrayPrefetchSize(),
+                                      referenceInfoBuilder,
+                                      exceptionTracker);
+            }
+
             auto jsArray = jsContext.newArray(array.size(), exceptionTracker);
             if (!exceptionTracker) {
                 return jsContext.newUndefined();
@@ -594,6 +604,20 @@ JSValueRef newTypedArrayFromBytesView(IJavaScriptContext& jsContext,
     JSValueRef arrayBuffer;
     auto unwrappedArrayBuffer = unwrapJSValueIfNeeded(jsContext, bytesView.getSource().get(), exceptionTracker);
 
+    if (unwrappedArrayBuffer) {
+        // The bytes view can be a sub range of the JS ArrayBuffer, for instance a bytes field of
+        // a Protobuf message decoded from a JS buffer. The ArrayBuffer can only be re-used directly
+        // if it matches the bytes view exactly.
+        auto unwrappedTypedArray = jsContext.valueToTypedArray(unwrappedArrayBuffer.value(), exceptionTracker);
+        if (!exceptionTracker) {
+            return arrayBuffer;
+        }
+
+        if (unwrappedTypedArray.data != bytesView.data() || unwrappedTypedArray.length != bytesView.size()) {
+            unwrappedArrayBuffer = std::nullopt;
+        }
+    }
+
     if (unwrappedArrayBuffer) {
         arrayBuffer = JSValueRef::makeRetained(jsContext, unwrappedArrayBuffer.value());
     } else {
@@ -738,7 +762,7 @@ Value jsValueToValue(IJavaScriptContext& jsContext,
         case Valdi::ValueType::InternedString:
         case Valdi::ValueType::StaticString:
             // We always use the interned string API when going from an untyped JSValue to a Value
-            return Value(jsContext.valueToString(jsValue, exceptionTracker));
+            return Value(jsContext.valueToStringCached(jsValue, exceptionTracker));
         case Valdi::ValueType::Int:
             return Value(jsContext.valueToInt(jsValue, exceptionTracker));
         case Valdi::ValueType::Double:
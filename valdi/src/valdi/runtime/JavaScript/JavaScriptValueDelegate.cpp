@@ -20,6 +20,7 @@
 #include "valdi_core/cpp/Utils/Trace.hpp"
 #include "valdi_core/cpp/Utils/ValueMarshaller.hpp"
 #include "valdi_core/cpp/Utils/ValueTypedProxyObject.hpp"
+#include <atomic>
 #include <boost/functional/hash.hpp>
 #include <fmt/format.h>
 
@@ -225,11 +226,11 @@ public:
             return jsContext.newUndefined();
         }
 
-        for (size_t i = 0; i < _propertiesSize; i++) {
-            jsContext.setObjectProperty(object.get(), getPropertyName(i), propertyValues[i].get(), jsExceptionTracker);
-            if (!jsExceptionTracker) {
-                return jsContext.newUndefined();
-            }
+        InlineContainerAllocator<JavaScriptClassDelegate, JSPropertyName> allocator;
+        jsContext.setObjectProperties(
+            object.get(), allocator.getContainerStartPtr(this), propertyValues, _propertiesSize, jsExceptionTracker);
+        if (!jsExceptionTracker) {
+            return jsContext.newUndefined();
         }
 
         return object;
@@ -295,7 +296,7 @@ public:
 
     Value enumCaseToValue(const JSValueRef& enumeration, bool /*isBoxed*/, ExceptionTracker& exceptionTracker) final {
         if (_enumSchema->getCaseSchema().isString()) {
-            return Value(_jsContext.valueToString(enumeration.get(), toJSExceptionTracker(exceptionTracker)));
+            return Value(_jsContext.valueToStringCached(enumeration.get(), toJSExceptionTracker(exceptionTracker)));
         } else if (_enumSchema->getCaseSchema().isInteger()) {
             return Value(_jsContext.valueToInt(enumeration.get(), toJSExceptionTracker(exceptionTracker)));
         } else {
@@ -712,6 +713,11 @@ public:
           _valueMarshaller(valueMarshaller) {}
 
     ~JSBridgedPromiseCallback() override {
+        if (_settled) {
+            // The resolve and reject functions were released when settling the promise
+            return;
+        }
+
         auto taskScheduler = _taskScheduler.lock();
         if (taskScheduler != nullptr) {
             taskScheduler->dispatchOnJsThreadAsync(
@@ -736,21 +742,42 @@ private:
     JSValueID _resolve;
     JSValueID _reject;
     Ref<ValueMarshaller<JSValueRef>> _valueMarshaller;
+    std::atomic_bool _settled = false;
 
     void fulfill(const Result<Value>& result) {
         auto taskScheduler = _taskScheduler.lock();
-        if (taskScheduler != nullptr) {
-            taskScheduler->dispatchOnJsThreadAsyncAfter(
-                _context, 0, [self = Valdi::strongSmallRef(this), result](const JavaScriptEntryParameters& jsEntry) {
-                    self->doFullfill(result, jsEntry);
-                });
+        if (taskScheduler == nullptr) {
+            return;
+        }
+
+        auto task = [self = Valdi::strongSmallRef(this), result](const JavaScriptEntryParameters& jsEntry) {
+            self->doFullfill(result, jsEntry);
+            self->releaseResolveAndReject(jsEntry);
+        };
+
+        if (taskScheduler->isInJsThread()) {
+            // The promise must not be settled synchronously from within JS
+            taskScheduler->dispatchOnJsThreadAsyncAfter(_context, 0, std::move(task));
+        } else {
+            // Completions arriving from other threads are batched with the other pending
+            // JS tasks, so that they are settled within a single VM entry and microtask drain
+            taskScheduler->dispatchOnJsThreadAsync(_context, std::move(task));
         }
     }
 
+    void releaseResolveAndReject(const JavaScriptEntryParameters& jsEntry) {
+        if (_settled.exchange(true)) {
+            return;
+        }
+
+        jsEntry.jsContext.removedStashedJSValue(_resolve);
+        jsEntry.jsContext.removedStashedJSValue(_reject);
+    }
+
     void doFullfill(const Result<Value>& result, const JavaScriptEntryParameters& jsEntry) {
         auto resolve = jsEntry.jsContext.getStashedJSValue(_resolve);
         auto reject = jsEntry.jsContext.getStashedJSValue(_reject);
-        if (!resolve || !reject) {
+        if (!resolve || !reject || _settled) {
             return;
         }
 
@@ -96,8 +96,7 @@ Value JavaScriptValueMarshaller::marshall(const JSValueRef& jsValue,
         // Leverage cache for classes
         valueMarshaller = getValueMarshallerForClassSchema(valueSchema.getClassRef(), exceptionTracker);
     } else {
-        auto valueMarshallerWithSchema = _marshallerRegistry.getValueMarshaller(valueSchema, exceptionTracker);
-        valueMarshaller = std::move(valueMarshallerWithSchema.valueMarshaller);
+        valueMarshaller = getValueMarshallerForSchema(valueSchema, exceptionTracker);
     }
 
     if (valueMarshaller == nullptr) {
@@ -147,6 +146,24 @@ Ref<ValueMarshaller<JSValueRef>> JavaScriptValueMarshaller::getValueMarshallerFo
     return valueMarshallerWithSchema.valueMarshaller;
 }
 
+Ref<ValueMarshaller<JSValueRef>> JavaScriptValueMarshaller::getValueMarshallerForSchema(
+    const ValueSchema& valueSchema, JSExceptionTracker& exceptionTracker) {
+    ValueSchemaRegistryKey schemaKey(valueSchema);
+    const auto& it = _valueMarshallerBySchema.find(schemaKey);
+    if (it != _valueMarshallerBySchema.end()) {
+        return it->second;
+    }
+
+    auto valueMarshallerWithSchema = _marshallerRegistry.getValueMarshaller(valueSchema, exceptionTracker);
+    if (!exceptionTracker) {
+        return nullptr;
+    }
+
+    _valueMarshallerBySchema[std::move(schemaKey)] = valueMarshallerWithSchema.valueMarshaller;
+
+    return valueMarshallerWithSchema.valueMarshaller;
+}
+
 static Value unwrapSingleProxy(const PlatformObjectAttachments& objectAttachments,
                                JSExceptionTracker& exceptionTracker) {
     auto proxies = objectAttachments.getAllProxies();
@@ -61,9 +61,14 @@ private:
     // in the app never changes once they reach JS, as they are fully resolved schema representing
     // models used in the app.
     std::vector<Ref<RefCountable>> _classes;
+    // Marshallers of the non class schemas, keyed by their unresolved schema so that
+    // repeated marshalling with the same schema doesn't need to resolve it again.
+    FlatMap<ValueSchemaRegistryKey, Ref<ValueMarshaller<JSValueRef>>> _valueMarshallerBySchema;
 
     Ref<ValueMarshaller<JSValueRef>> getValueMarshallerForClassSchema(const Ref<ClassSchema>& classSchema,
                                                                       JSExceptionTracker& exceptionTracker);
+    Ref<ValueMarshaller<JSValueRef>> getValueMarshallerForSchema(const ValueSchema& valueSchema,
+                                                                 JSExceptionTracker& exceptionTracker);
     Ref<ValueMarshaller<JSValueRef>> getValueMarshallerForFunctionSchema(const Ref<FunctionSchema>& functionSchema,
                                                                          JSExceptionTracker& exceptionTracker);
 
@@ -0,0 +1,109 @@
+//
+//  EncodingModuleFactory.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/runtime/JavaScript/Modules/EncodingModuleFactory.hpp"
+
+#include "valdi/runtime/JavaScript/JSFunctionWithCallable.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptFunctionCallContext.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptTypes.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
+
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
+#include "valdi_core/cpp/Utils/HexCodec.hpp"
+
+namespace Valdi {
+
+EncodingModuleFactory::EncodingModuleFactory() = default;
+EncodingModuleFactory::~EncodingModuleFactory() = default;
+
+StringBox EncodingModuleFactory::getModulePath() const {
+    return STRING_LITERAL("coreutils/src/EncodingNative");
+}
+
+JSValueRef EncodingModuleFactory::encodeBase64(JSFunctionNativeCallContext& callContext) {
+    auto buffer = callContext.getParameterAsTypedArray(0);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto urlSafe = callContext.getParameterAsBool(1);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto encoded = Base64Codec::encode(reinterpret_cast<const Byte*>(buffer.data), buffer.length, urlSafe);
+
+    return callContext.getContext().newStringUTF8(encoded, callContext.getExceptionTracker());
+}
+
+JSValueRef EncodingModuleFactory::decodeBase64(JSFunctionNativeCallContext& callContext) {
+    auto str = callContext.getParameterAsStaticString(0);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto utf8Storage = str->utf8Storage();
+    auto output = makeShared<Bytes>();
+    if (!Base64Codec::decode(utf8Storage.toStringView(), *output)) {
+        return callContext.throwError(Error("Invalid base64 string"));
+    }
+
+    return callContext.getContext().newArrayBuffer(BytesView(output), callContext.getExceptionTracker());
+}
+
+JSValueRef EncodingModuleFactory::encodeHex(JSFunctionNativeCallContext& callContext) {
+    auto buffer = callContext.getParameterAsTypedArray(0);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto encoded = HexCodec::encode(reinterpret_cast<const Byte*>(buffer.data), buffer.length);
+
+    return callContext.getContext().newStringUTF8(encoded, callContext.getExceptionTracker());
+}
+
+JSValueRef EncodingModuleFactory::decodeHex(JSFunctionNativeCallContext& callContext) {
+    auto str = callContext.getParameterAsStaticString(0);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto utf8Storage = str->utf8Storage();
+    auto output = makeShared<Bytes>();
+    if (!HexCodec::decode(utf8Storage.toStringView(), *output)) {
+        return callContext.throwError(Error("Invalid hex string"));
+    }
+
+    return callContext.getContext().newArrayBuffer(BytesView(output), callContext.getExceptionTracker());
+}
+
+JSValueRef EncodingModuleFactory::loadModule(IJavaScriptContext& jsContext,
+                                             const ReferenceInfoBuilder& referenceInfoBuilder,
+                                             JSExceptionTracker& exceptionTracker) {
+    auto module = jsContext.newObject(exceptionTracker);
+    if (!exceptionTracker) {
+        return JSValueRef();
+    }
+
+    auto functions = std::vector({
+        std::make_pair("encodeBase64", &EncodingModuleFactory::encodeBase64),
+        std::make_pair("decodeBase64", &EncodingModuleFactory::decodeBase64),
+        std::make_pair("encodeHex", &EncodingModuleFactory::encodeHex),
+        std::make_pair("decodeHex", &EncodingModuleFactory::decodeHex),
+    });
+
+    for (const auto& function : functions) {
+        auto functionName = StringCache::getGlobal().makeString(std::string_view(function.first));
+
+        auto jsFunction = jsContext.newFunction(
+            makeShared<JSFunctionWithCallable>(ReferenceInfoBuilder().withProperty(functionName), function.second),
+            exceptionTracker);
+        if (!exceptionTracker) {
+            return JSValueRef();
+        }
+
+        jsContext.setObjectProperty(module.get(), std::string_view(function.first), jsFunction.get(), exceptionTracker);
+
+        if (!exceptionTracker) {
+            return JSValueRef();
+        }
+    }
+
+    return module;
+}
+
+} // namespace Valdi
@@ -0,0 +1,37 @@
+//
+//  EncodingModuleFactory.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi/runtime/JavaScript/Modules/JavaScriptModuleFactory.hpp"
+
+namespace Valdi {
+
+class IJavaScriptContext;
+
+/**
+ Exposes the native base64 and hex codecs to JS, so that binary payloads
+ are not encoded and decoded in script.
+ */
+class EncodingModuleFactory : public JavaScriptModuleFactory {
+public:
+    EncodingModuleFactory();
+    ~EncodingModuleFactory() override;
+
+    StringBox getModulePath() const final;
+    JSValueRef loadModule(IJavaScriptContext& context,
+                          const ReferenceInfoBuilder& referenceInfoBuilder,
+                          JSExceptionTracker& exceptionTracker) override;
+
+private:
+    static JSValueRef encodeBase64(JSFunctionNativeCallContext& callContext);
+    static JSValueRef decodeBase64(JSFunctionNativeCallContext& callContext);
+    static JSValueRef encodeHex(JSFunctionNativeCallContext& callContext);
+    static JSValueRef decodeHex(JSFunctionNativeCallContext& callContext);
+};
+
+} // namespace Valdi
@@ -1,4 +1,7 @@
 #include "valdi/runtime/JavaScript/Modules/FileSystemFactory.hpp"
+#include "valdi/runtime/Resources/AsyncDiskCache.hpp"
+#include "valdi/runtime/Resources/DiskCacheImpl.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/DiskUtils.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
@@ -8,9 +11,47 @@
 #include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
 
 namespace Valdi {
-FileSystemFactory::FileSystemFactory() = default;
+FileSystemFactory::FileSystemFactory()
+    : _diskCache(makeShared<AsyncDiskCache>(
+          makeShared<DiskCacheImpl>(STRING_LITERAL("/")),
+          DispatchQueue::createOnSharedPool(STRING_LITERAL("com.snap.valdi.FileSystem"), 1))) {}
 FileSystemFactory::~FileSystemFactory() = default;
 
+static Path resolvePath(const StringBox& pathName) {
+    Path path(pathName.toStringView());
+    if (!path.isAbsolute()) {
+        path = DiskUtils::currentWorkingDirectory().appending(path);
+    }
+    return path;
+}
+
+static Value makeFileContentValue(const BytesView& fileContent, const Value& options) {
+    auto encoding = options.getMapValue("encoding");
+
+    if (encoding == Value("utf8")) {
+        return Value(StaticString::makeUTF8(fileContent.asStringView()));
+    } else if (encoding == Value("utf16")) {
+        return Value(StaticString::makeUTF16(reinterpret_cast<const char16_t*>(fileContent.data()),
+                                             fileContent.size() / sizeof(char16_t)));
+    } else {
+        return Value(makeShared<ValueTypedArray>(ArrayBuffer, fileContent));
+    }
+}
+
+static BytesView getFileContentBytes(const Value& fileContent) {
+    BytesView bytes;
+
+    if (fileContent.isTypedArray()) {
+        bytes = fileContent.getTypedArray()->getBuffer();
+    } else if (fileContent.isString()) {
+        auto string = fileContent.toStringBox();
+        bytes =
+            BytesView(string.getInternedString(), reinterpret_cast<const Byte*>(string.getCStr()), string.length());
+    }
+
+    return bytes;
+}
+
 StringBox FileSystemFactory::getModulePath() {
     return STRING_LITERAL("FileSystem");
 }
@@ -19,19 +60,18 @@ Value FileSystemFactory::loadModule() {
     Value out;
 
     auto strongThis = shared_from_this();
+    auto diskCache = _diskCache;
 
     out.setMapValue(
         "removeSync",
-        Value(makeShared<ValueFunctionWithCallable>([strongThis](const ValueFunctionCallContext& callContext) -> Value {
+        Value(makeShared<ValueFunctionWithCallable>([diskCache](const ValueFunctionCallContext& callContext) -> Value {
             auto pathNameResult = callContext.getParameterAsString(0);
 
             if (!callContext.getExceptionTracker()) {
                 return Value::undefined();
             }
 
-            Path const path = Path(pathNameResult.toStringView());
-
-            bool const result = DiskUtils::remove(path);
+            bool const result = diskCache->remove(resolvePath(pathNameResult));
             if (!result) {
                 callContext.getExceptionTracker().onError(fmt::format("Could not remove path: '{}'", pathNameResult));
                 return Value::undefined();
@@ -70,7 +110,7 @@ Value FileSystemFactory::loadModule() {
 
     out.setMapValue(
         "readFileSync",
-        Value(makeShared<ValueFunctionWithCallable>([strongThis](const ValueFunctionCallContext& callContext) -> Value {
+        Value(makeShared<ValueFunctionWithCallable>([diskCache](const ValueFunctionCallContext& callContext) -> Value {
             auto pathToFile = callContext.getParameterAsString(0);
 
             if (!callContext.getExceptionTracker()) {
@@ -79,32 +119,51 @@ Value FileSystemFactory::loadModule() {
 
             auto options = callContext.getParameter(1);
 
-            Path const path = Path(pathToFile.toStringView());
-
-            auto result = DiskUtils::load(path);
+            auto result = diskCache->load(resolvePath(pathToFile));
             if (!result) {
                 callContext.getExceptionTracker().onError(
                     fmt::format("Could not read the file at path: '{}'", pathToFile));
                 return Value::undefined();
             }
 
-            auto fileContent = result.moveValue();
+            return makeFileContentValue(result.value(), options);
+        })));
+
+    out.setMapValue(
+        "readFile",
+        Value(makeShared<ValueFunctionWithCallable>([diskCache](const ValueFunctionCallContext& callContext) -> Value {
+            auto pathToFile = callContext.getParameterAsString(0);
+            if (!callContext.getExceptionTracker()) {
+                return Value::undefined();
+            }
 
-            auto encoding = options.getMapValue("encoding");
+            auto options = callContext.getParameter(1);
 
-            if (encoding == Value("utf8")) {
-                return Value(StaticString::makeUTF8(fileContent.asStringView()));
-            } else if (encoding == Value("utf16")) {
-                return Value(StaticString::makeUTF16(reinterpret_cast<const char16_t*>(fileContent.data()),
-                                                     fileContent.size() / sizeof(char16_t)));
-            } else {
-                return Value(makeShared<ValueTypedArray>(ArrayBuffer, fileContent));
+            auto callback = callContext.getParameterAsFunction(2);
+            if (!callContext.getExceptionTracker()) {
+                return Value::undefined();
             }
+
+            diskCache->loadAsync(
+                resolvePath(pathToFile), [pathToFile, options, callback](const Result<BytesView>& result) {
+                    std::array<Value, 2> params;
+                    if (!result) {
+                        params[0] = Value::undefined();
+                        params[1] = Value(fmt::format("Could not read the file at path: '{}'", pathToFile));
+                    } else {
+                        params[0] = makeFileContentValue(result.value(), options);
+                        params[1] = Value::undefined();
+                    }
+
+                    (*callback)(params.data(), params.size());
+                });
+
+            return Value::undefined();
         })));
 
     out.setMapValue(
         "writeFileSync",
-        Value(makeShared<ValueFunctionWithCallable>([strongThis](const ValueFunctionCallContext& callContext) -> Value {
+        Value(makeShared<ValueFunctionWithCallable>([diskCache](const ValueFunctionCallContext& callContext) -> Value {
             auto pathToFile = callContext.getParameterAsString(0);
 
             if (!callContext.getExceptionTracker()) {
@@ -118,36 +177,43 @@ Value FileSystemFactory::loadModule() {
                 return Value::undefined();
             }
 
-            BytesView bytes;
-
-            if (fileContent.isTypedArray()) {
-                bytes = fileContent.getTypedArray()->getBuffer();
-            } else if (fileContent.isString()) {
-                auto string = fileContent.toStringBox();
-                bytes = BytesView(
-                    string.getInternedString(), reinterpret_cast<const Byte*>(string.getCStr()), string.length());
+            auto result = diskCache->store(resolvePath(pathToFile), getFileContentBytes(fileContent));
+            if (!result) {
+                callContext.getExceptionTracker().onError(
+                    fmt::format("Could not store the file at path: '{}'", pathToFile));
+                return Value::undefined();
             }
 
-            Path const path = Path(pathToFile.toStringView());
+            return Value::undefined();
+        })));
 
-            if (DiskUtils::isFile(path)) {
-                DiskUtils::remove(path);
+    out.setMapValue(
+        "writeFile",
+        Value(makeShared<ValueFunctionWithCallable>([diskCache](const ValueFunctionCallContext& callContext) -> Value {
+            auto pathToFile = callContext.getParameterAsString(0);
+            if (!callContext.getExceptionTracker()) {
+                return Value::undefined();
             }
 
-            if (path.getComponents().size() > 1) {
-                auto directory = path.removingLastComponent();
-                if (!DiskUtils::isDirectory(directory)) {
-                    DiskUtils::makeDirectory(directory, true);
-                }
-            }
+            auto fileContent = callContext.getParameter(1);
 
-            auto result = DiskUtils::store(path, bytes);
-            if (!result) {
-                callContext.getExceptionTracker().onError(
-                    fmt::format("Could not store the file at path: '{}'", pathToFile));
+            auto callback = callContext.getParameterAsFunction(2);
+            if (!callContext.getExceptionTracker()) {
                 return Value::undefined();
             }
 
+            // Writes to the same file which are still pending are coalesced, only the last content is written
+            auto path = resolvePath(pathToFile);
+            auto bytes = getFileContentBytes(fileContent);
+            diskCache->storeAsync(path, bytes, [pathToFile, callback](const Result<Void>& result) {
+                auto param = Value::undefined();
+                if (!result) {
+                    param = Value(fmt::format("Could not store the file at path: '{}'", pathToFile));
+                }
+
+                (*callback)(&param, 1);
+            });
+
             return Value::undefined();
         })));
 
@@ -5,6 +5,8 @@
 
 namespace Valdi {
 
+class AsyncDiskCache;
+
 class FileSystemFactory : public Valdi::SharedPtrRefCountable, public snap::valdi_core::ModuleFactory {
 public:
     FileSystemFactory();
@@ -12,6 +14,10 @@ public:
 
     StringBox getModulePath() override;
     Value loadModule() override;
+
+private:
+    // Rooted at the file system root, the async reads and writes run on a serial queue of the shared ThreadPool
+    Ref<AsyncDiskCache> _diskCache;
 };
 
 } // namespace Valdi
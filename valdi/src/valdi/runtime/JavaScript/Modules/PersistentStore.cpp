@@ -9,12 +9,51 @@
 #include "valdi/runtime/Resources/EncryptedDiskCache.hpp"
 #include "valdi/runtime/Resources/UserSession.hpp"
 #include "valdi_core/cpp/Resources/ValdiArchive.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 
 namespace Valdi {
 
 constexpr int64_t kPersistentStoreSaveDelayMs = 50;
+constexpr size_t kPersistentStoreMaxLogSegments = 32;
+constexpr size_t kPersistentStoreMinCompactionSize = 64 * 1024;
+
+struct PersistentStoreContent {
+    std::optional<Result<BytesView>> snapshot;
+    std::vector<Result<BytesView>> logSegments;
+};
+
+static Path getLogSegmentPath(const Path& diskCachePath, size_t index) {
+    return Path(fmt::format("{}.{}.log", diskCachePath.toString(), index));
+}
+
+static bool hasContent(IDiskCache& diskCache, const Path& diskCachePath) {
+    return diskCache.exists(diskCachePath) || diskCache.exists(getLogSegmentPath(diskCachePath, 0));
+}
+
+static PersistentStoreContent loadContent(IDiskCache& diskCache, const Path& diskCachePath) {
+    PersistentStoreContent content;
+
+    if (diskCache.exists(diskCachePath)) {
+        content.snapshot = {diskCache.load(diskCachePath)};
+        if (!content.snapshot.value()) {
+            return content;
+        }
+    }
+
+    for (;;) {
+        auto path = getLogSegmentPath(diskCachePath, content.logSegments.size());
+        if (!diskCache.exists(path)) {
+            return content;
+        }
+
+        auto& logSegment = content.logSegments.emplace_back(diskCache.load(path));
+        if (!logSegment) {
+            return content;
+        }
+    }
+}
 
 PersistentStore::PersistentStore(const StringBox& diskCachePath,
                                  const Ref<IDiskCache>& diskCache,
@@ -42,7 +81,7 @@ void PersistentStore::store(const StringBox& key,
                             uint64_t ttlSeconds,
                             uint64_t weight,
                             Function<void(Result<Void>)> completion) {
-    _dispatchQueue->async(
+    dispatchWhenPopulated(
         [key, blob, ttlSeconds, weight, self = strongRef(this), completion = std::move(completion)]() {
             self->_store.store(key, blob, ttlSeconds, weight);
             self->scheduleSave(completion);
@@ -107,14 +146,14 @@ void PersistentStore::updateActiveDiskStore() {
 
 void PersistentStore::fetchAll(
     Function<void(const std::vector<std::pair<StringBox, KeyValueStoreEntry>>&)> completion) {
-    _dispatchQueue->async([self = strongRef(this), completion = std::move(completion)]() {
+    dispatchWhenPopulated([self = strongRef(this), completion = std::move(completion)]() {
         auto entries = self->_store.fetchAll();
         completion(entries);
     });
 }
 
 void PersistentStore::fetch(const StringBox& key, Function<void(Result<BytesView>)> completion) {
-    _dispatchQueue->async([key, self = strongRef(this), completion = std::move(completion)]() {
+    dispatchWhenPopulated([key, self = strongRef(this), completion = std::move(completion)]() {
         auto data = self->_store.fetch(key);
         if (data) {
             completion(data.value());
@@ -125,12 +164,12 @@ void PersistentStore::fetch(const StringBox& key, Function<void(Result<BytesView
 }
 
 void PersistentStore::exists(const StringBox& key, Function<void(bool)> completion) {
-    _dispatchQueue->async(
+    dispatchWhenPopulated(
         [key, self = strongRef(this), completion = std::move(completion)]() { completion(self->_store.exists(key)); });
 }
 
 void PersistentStore::remove(const StringBox& key, Function<void(Result<Void>)> completion) {
-    _dispatchQueue->async([key, self = strongRef(this), completion = std::move(completion)]() {
+    dispatchWhenPopulated([key, self = strongRef(this), completion = std::move(completion)]() {
         if (self->_store.remove(key)) {
             self->scheduleSave(completion);
         } else {
@@ -140,7 +179,7 @@ void PersistentStore::remove(const StringBox& key, Function<void(Result<Void>)>
 }
 
 void PersistentStore::removeAll(Function<void(Result<Void>)> completion) {
-    _dispatchQueue->async([self = strongRef(this), completion = std::move(completion)]() {
+    dispatchWhenPopulated([self = strongRef(this), completion = std::move(completion)]() {
         self->_store.removeAll();
         self->scheduleSave(completion);
     });
@@ -160,14 +199,7 @@ void PersistentStore::scheduleSave(Function<void(Result<Void>)> completion) {
 }
 
 void PersistentStore::doSave() {
-    Result<Void> result;
-    auto serializeResult = _store.serialize();
-
-    if (serializeResult) {
-        result = _activeDiskCache->store(_diskCachePath, serializeResult.value());
-    } else {
-        result = serializeResult.moveError();
-    }
+    auto result = shouldCompact() ? compact() : appendChanges();
 
     auto pendingSaves = std::move(_pendingSaves);
     for (const auto& pendingSave : pendingSaves) {
@@ -175,6 +207,97 @@ void PersistentStore::doSave() {
     }
 }
 
+bool PersistentStore::shouldCompact() const {
+    if (!_hasSnapshot || _store.requiresSerialize() || _logSegmentsCount >= kPersistentStoreMaxLogSegments) {
+        return true;
+    }
+
+    // Rewriting the snapshot costs about its size, doing it once the log gets bigger than the snapshot
+    // keeps the bytes written per change within a constant factor of the change size.
+    return _logSizeInBytes > std::max(_snapshotSizeInBytes, kPersistentStoreMinCompactionSize);
+}
+
+Result<Void> PersistentStore::compact() {
+    auto serializeResult = _store.serialize();
+    if (!serializeResult) {
+        return serializeResult.moveError();
+    }
+
+    auto result = _activeDiskCache->store(_diskCachePath, serializeResult.value());
+    if (!result) {
+        return result;
+    }
+
+    _hasSnapshot = true;
+    _snapshotSizeInBytes = serializeResult.value().size();
+
+    // The snapshot is written first, changes left over by an interruption are ignored when replayed on it
+    removeLogSegments();
+
+    return Void();
+}
+
+Result<Void> PersistentStore::appendChanges() {
+    if (!_store.hasChanges()) {
+        return Void();
+    }
+
+    auto serializeResult = _store.serializeChanges();
+    if (!serializeResult) {
+        return serializeResult.moveError();
+    }
+
+    auto result = _activeDiskCache->store(getLogSegmentPath(_logSegmentsCount), serializeResult.value());
+    if (!result) {
+        return result;
+    }
+
+    _logSegmentsCount++;
+    _logSizeInBytes += serializeResult.value().size();
+
+    return Void();
+}
+
+void PersistentStore::populateLog(const std::vector<Result<BytesView>>& logSegments) {
+    for (const auto& logSegment : logSegments) {
+        auto path = getLogSegmentPath(_logSegmentsCount);
+        _logSegmentsCount++;
+
+        Result<Void> result;
+        if (logSegment) {
+            _logSizeInBytes += logSegment.value().size();
+            result = _store.populateChanges(logSegment.value());
+            if (result) {
+                continue;
+            }
+        } else {
+            result = logSegment.error();
+        }
+
+        // The last changes might have been partially written, the next save will write a new snapshot
+        // without them.
+        VALDI_WARN(_logger,
+                   "Failed to replay changes at '{}': {}",
+                   _activeDiskCache->getAbsoluteURL(path),
+                   result.error());
+        _hasSnapshot = false;
+        return;
+    }
+}
+
+void PersistentStore::removeLogSegments() {
+    for (size_t i = 0; i < _logSegmentsCount || _activeDiskCache->exists(getLogSegmentPath(i)); i++) {
+        _activeDiskCache->remove(getLogSegmentPath(i));
+    }
+
+    _logSegmentsCount = 0;
+    _logSizeInBytes = 0;
+}
+
+Path PersistentStore::getLogSegmentPath(size_t index) const {
+    return Valdi::getLogSegmentPath(_diskCachePath, index);
+}
+
 void PersistentStore::populate() {
     _dispatchQueue->async([self = strongRef(this)]() { self->doPopulate(); });
 }
@@ -186,21 +309,81 @@ void PersistentStore::onPopulateFailure(const Error& error) {
 }
 
 void PersistentStore::doPopulate() {
-    if (_activeDiskCache->exists(_diskCachePath)) {
-        auto result = _activeDiskCache->load(_diskCachePath);
-        if (!result) {
-            onPopulateFailure(result.error());
+    _hasSnapshot = false;
+    _snapshotSizeInBytes = 0;
+    _logSegmentsCount = 0;
+    _logSizeInBytes = 0;
+
+    auto populateSequence = ++_populateSequence;
+
+    if (!hasContent(*_activeDiskCache, _diskCachePath)) {
+        onPopulated();
+        return;
+    }
+
+    // Loading and decrypting the store can take a while for large stores. It is done on the shared
+    // thread pool so that stores load in parallel, and that the operations of the other stores
+    // are not blocked by it. The operations of this store are deferred until it is populated.
+    _populating = true;
+    ThreadPool::getShared()->submit([weakSelf = weakRef(this),
+                                     dispatchQueue = _dispatchQueue,
+                                     diskCache = _activeDiskCache,
+                                     diskCachePath = _diskCachePath,
+                                     populateSequence]() {
+        auto content = loadContent(*diskCache, diskCachePath);
+        dispatchQueue->async([weakSelf, populateSequence, content = std::move(content)]() {
+            auto self = weakSelf.lock();
+            if (self != nullptr && self->_populateSequence == populateSequence) {
+                self->applyContent(content);
+            }
+        });
+    });
+}
+
+void PersistentStore::applyContent(const PersistentStoreContent& content) {
+    if (content.snapshot) {
+        const auto& snapshot = content.snapshot.value();
+        if (!snapshot) {
+            onPopulateFailure(snapshot.error());
+            onPopulated();
             return;
         }
 
-        auto populateResult = _store.populate(result.value());
+        auto populateResult = _store.populate(snapshot.value());
         if (!populateResult) {
             onPopulateFailure(populateResult.error());
+            onPopulated();
             return;
         }
+
+        _hasSnapshot = true;
+        _snapshotSizeInBytes = snapshot.value().size();
+    }
+
+    populateLog(content.logSegments);
+    onPopulated();
+}
+
+void PersistentStore::onPopulated() {
+    _populating = false;
+
+    auto pendingOperations = std::move(_pendingOperations);
+    _pendingOperations.clear();
+    for (const auto& pendingOperation : pendingOperations) {
+        pendingOperation();
     }
 }
 
+void PersistentStore::dispatchWhenPopulated(DispatchFunction function) {
+    _dispatchQueue->async([self = strongRef(this), function = std::move(function)]() mutable {
+        if (self->_populating) {
+            self->_pendingOperations.emplace_back(std::move(function));
+        } else {
+            function();
+        }
+    });
+}
+
 void PersistentStore::setCurrentTimeSeconds(uint64_t timeSeconds) {
     _store.setCurrentTimeSeconds(timeSeconds);
 }
@@ -30,6 +30,7 @@ class Keychain;
 namespace Valdi {
 
 class UserSession;
+struct PersistentStoreContent;
 
 class PersistentStore : public ValdiObject {
 public:
@@ -81,10 +82,30 @@ private:
     [[maybe_unused]] ILogger& _logger;
     bool _disableBatchWrites;
     std::vector<Function<void(Result<Void>)>> _pendingSaves;
+    // The store is saved as a snapshot followed by a log of changes, which is compacted into a new snapshot
+    // once it gets larger than the snapshot itself
+    bool _hasSnapshot = false;
+    size_t _snapshotSizeInBytes = 0;
+    size_t _logSegmentsCount = 0;
+    size_t _logSizeInBytes = 0;
+    // Operations are deferred while the content of the store is loaded in the background
+    bool _populating = false;
+    size_t _populateSequence = 0;
+    std::vector<DispatchFunction> _pendingOperations;
 
     void scheduleSave(Function<void(Result<Void>)> completion);
     void doSave();
     void doPopulate();
+    void applyContent(const PersistentStoreContent& content);
+    void onPopulated();
+    void dispatchWhenPopulated(DispatchFunction function);
+
+    bool shouldCompact() const;
+    Result<Void> compact();
+    Result<Void> appendChanges();
+    void populateLog(const std::vector<Result<BytesView>>& logSegments);
+    void removeLogSegments();
+    Path getLogSegmentPath(size_t index) const;
 
     void updateUserSession(const Ref<UserSession>& userSession);
     void updateActiveDiskStore();
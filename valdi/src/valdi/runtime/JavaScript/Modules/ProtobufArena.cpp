@@ -8,6 +8,8 @@
 #include "valdi/runtime/JavaScript/Modules/ProtobufArena.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
+#include <algorithm>
+
 namespace Valdi {
 
 JSProtobufMessage::JSProtobufMessage(size_t messageIndex,
@@ -22,7 +24,9 @@ size_t JSProtobufMessage::getMessageIndex() const {
 }
 
 ProtobufArena::ProtobufArena(bool eagerDecoding, bool includeAllFieldsDuringEncoding)
-    : _eagerDecoding(eagerDecoding), _includeAllFieldsDuringEncoding(includeAllFieldsDuringEncoding) {}
+    : _decodingArena(makeShared<Protobuf::MessageArena>()),
+      _eagerDecoding(eagerDecoding),
+      _includeAllFieldsDuringEncoding(includeAllFieldsDuringEncoding) {}
 ProtobufArena::~ProtobufArena() = default;
 
 std::unique_lock<std::recursive_mutex> ProtobufArena::lock() const {
@@ -53,6 +57,7 @@ size_t ProtobufArena::decodeMessage(const Ref<ProtobufMessageFactory>& messageFa
 
     VALDI_TRACE_META("Protobuf.decodeMessage", descriptor->name());
 
+    Protobuf::MessageArena::Scope arenaScope(_decodingArena.get());
     auto message = createMessageForDescriptor(descriptor, bytes.getSource());
 
     if (!message->decode(bytes.data(), bytes.size(), exceptionTracker)) {
@@ -74,6 +79,7 @@ size_t ProtobufArena::decodeMessageFromJSON(const Ref<ProtobufMessageFactory>& m
 
     VALDI_TRACE_META("Protobuf.decodeMessageFromJSON", descriptor->name());
 
+    Protobuf::MessageArena::Scope arenaScope(_decodingArena.get());
     auto message = createMessageForDescriptor(descriptor, nullptr);
 
     if (!message->decodeFromJSON(json, exceptionTracker)) {
@@ -189,6 +195,69 @@ std::string ProtobufArena::messageToJSON(size_t messageIndex,
     return message->toJSON(printOptions, exceptionTracker);
 }
 
+std::vector<size_t> ProtobufArena::diffMessages(size_t previousMessageIndex,
+                                                size_t nextMessageIndex,
+                                                ExceptionTracker& exceptionTracker) {
+    std::vector<size_t> fieldIndexes;
+
+    auto* previousMessage = getMessage(previousMessageIndex, exceptionTracker);
+    auto* nextMessage = getMessage(nextMessageIndex, exceptionTracker);
+    if (!exceptionTracker) {
+        return fieldIndexes;
+    }
+
+    const auto* descriptor = nextMessage->getDescriptor();
+    if (previousMessage->getDescriptor() != descriptor) {
+        exceptionTracker.onError(Error("Cannot diff messages of different types"));
+        return fieldIndexes;
+    }
+
+    VALDI_TRACE_META("Protobuf.diffMessages", descriptor->name());
+
+    for (auto fieldNumber : nextMessage->shareUnchangedMessages(*previousMessage)) {
+        // Unknown fields are not exposed to JS
+        const auto* fieldDescriptor = descriptor->FindFieldByNumber(static_cast<int>(fieldNumber));
+        if (fieldDescriptor != nullptr) {
+            fieldIndexes.emplace_back(static_cast<size_t>(fieldDescriptor->index()));
+        }
+    }
+
+    std::sort(fieldIndexes.begin(), fieldIndexes.end());
+    return fieldIndexes;
+}
+
+std::vector<size_t> ProtobufArena::applyMessagePatch(size_t messageIndex,
+                                                     size_t patchMessageIndex,
+                                                     const std::vector<std::string>& paths,
+                                                     ExceptionTracker& exceptionTracker) {
+    std::vector<size_t> fieldIndexes;
+
+    auto* message = getMessage(messageIndex, exceptionTracker);
+    auto* patchMessage = getMessage(patchMessageIndex, exceptionTracker);
+    if (!exceptionTracker) {
+        return fieldIndexes;
+    }
+
+    const auto* descriptor = message->getDescriptor();
+
+    VALDI_TRACE_META("Protobuf.applyMessagePatch", descriptor->name());
+
+    if (!message->applyPatch(*patchMessage, paths, *this, exceptionTracker)) {
+        return fieldIndexes;
+    }
+
+    for (const auto& path : paths) {
+        const auto* fieldDescriptor = descriptor->FindFieldByName(path.substr(0, path.find('.')));
+        if (fieldDescriptor != nullptr) {
+            fieldIndexes.emplace_back(static_cast<size_t>(fieldDescriptor->index()));
+        }
+    }
+
+    std::sort(fieldIndexes.begin(), fieldIndexes.end());
+    fieldIndexes.erase(std::unique(fieldIndexes.begin(), fieldIndexes.end()), fieldIndexes.end());
+    return fieldIndexes;
+}
+
 void ProtobufArena::retainMessageFactory(const Ref<ProtobufMessageFactory>& messageFactory) {
     for (const auto& existingMessageFactory : _retainedMessageFactories) {
         if (existingMessageFactory == messageFactory) {
@@ -73,6 +73,24 @@ public:
                               const Protobuf::JSONPrintOptions& printOptions,
                               ExceptionTracker& exceptionTracker) const;
 
+    /**
+     Compare the next version of a message with its previous version, and share the nested
+     messages which did not change between both versions. Returns the indexes of the fields
+     of the message which changed.
+     */
+    std::vector<size_t> diffMessages(size_t previousMessageIndex,
+                                     size_t nextMessageIndex,
+                                     ExceptionTracker& exceptionTracker);
+
+    /**
+     Apply in place the fields of the patch message designated by the given field mask paths.
+     Returns the indexes of the fields of the message which were patched.
+     */
+    std::vector<size_t> applyMessagePatch(size_t messageIndex,
+                                          size_t patchMessageIndex,
+                                          const std::vector<std::string>& paths,
+                                          ExceptionTracker& exceptionTracker);
+
     VALDI_CLASS_HEADER(ProtobufArena)
 
 protected:
@@ -83,6 +101,8 @@ private:
     mutable std::recursive_mutex _mutex;
     std::vector<Ref<ProtobufMessageFactory>> _retainedMessageFactories;
     std::vector<Ref<JSProtobufMessage>> _messages;
+    // Decoded message trees are allocated in this arena, and freed in bulk with the ProtobufArena
+    Ref<Protobuf::MessageArena> _decodingArena;
     bool _eagerDecoding = false;
     bool _includeAllFieldsDuringEncoding = false;
 
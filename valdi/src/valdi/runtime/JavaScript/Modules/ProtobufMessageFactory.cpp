@@ -9,6 +9,7 @@
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_protobuf/DescriptorDatabase.hpp"
+#include "valdi_protobuf/MessageParseTable.hpp"
 
 namespace Valdi {
 
@@ -17,7 +18,9 @@ ProtobufMessageFactory::ProtobufMessageFactory(bool skipProtoIndex)
       _pool(_descriptorDatabase.get()) {
     _pool.InternalSetLazilyBuildDependencies();
 }
-ProtobufMessageFactory::~ProtobufMessageFactory() = default;
+ProtobufMessageFactory::~ProtobufMessageFactory() {
+    Protobuf::MessageParseTable::removeTablesForPool(&_pool);
+}
 
 bool ProtobufMessageFactory::load(const BytesView& data, ExceptionTracker& exceptionTracker) {
     return _descriptorDatabase->addFileDescriptorSet(data, exceptionTracker);
@@ -49,7 +52,7 @@ const google::protobuf::Descriptor* ProtobufMessageFactory::getDescriptorAtIndex
 
     const auto* descriptor = _descriptorDatabase->getDescriptorOfSymbolAtIndex(index);
     if (descriptor == nullptr) {
-        const std::string& symbolNameStr = _descriptorDatabase->getSymbolNameAtIndex(index);
+        std::string symbolNameStr(_descriptorDatabase->getSymbolNameAtIndex(index));
         descriptor = _pool.FindMessageTypeByName(symbolNameStr);
         SC_ASSERT_NOTNULL(descriptor);
         if (descriptor == nullptr) {
@@ -72,13 +75,13 @@ static std::string_view getLastComponent(std::string_view fullName) {
 }
 
 static std::vector<ProtobufMessageFactory::NamespaceEntry> getNamespaceEntriesForPackage(
-    const Protobuf::DescriptorDatabase& database, const DescriptorIndex::Package& package) {
+    const Protobuf::DescriptorDatabase& database, const Protobuf::CompactDescriptorIndex::Package& package) {
     std::vector<ProtobufMessageFactory::NamespaceEntry> output;
 
-    output.reserve(package.symbol_indexes_size() + package.nested_package_indexes_size());
+    output.reserve(package.symbolIndexes.size() + package.nestedPackageIndexes.size());
 
-    for (const auto& symbolIndex : package.symbol_indexes()) {
-        const auto& fullName = database.getSymbolNameAtIndex(symbolIndex);
+    for (auto symbolIndex : package.symbolIndexes) {
+        auto fullName = database.getSymbolNameAtIndex(symbolIndex);
 
         auto& it = output.emplace_back();
         it.id = symbolIndex;
@@ -86,8 +89,8 @@ static std::vector<ProtobufMessageFactory::NamespaceEntry> getNamespaceEntriesFo
         it.name = getLastComponent(fullName);
     }
 
-    for (const auto& nestedPackageIndex : package.nested_package_indexes()) {
-        const auto& fullName = database.getPackageAtIndex(nestedPackageIndex).full_name();
+    for (auto nestedPackageIndex : package.nestedPackageIndexes) {
+        auto fullName = database.getPackageAtIndex(nestedPackageIndex).fullName;
 
         auto& it = output.emplace_back();
         it.id = nestedPackageIndex;
@@ -843,6 +843,76 @@ JSValueRef ProtobufModule::arenaCopyMessage(JSFunctionNativeCallContext& callCon
     return toJSIndex(callContext, copyIndex);
 }
 
+static std::vector<std::string> getStrings(JSFunctionNativeCallContext& callContext, size_t parameterIndex) {
+    std::vector<std::string> output;
+
+    auto array = callContext.getParameter(parameterIndex);
+    auto length = jsArrayGetLength(callContext.getContext(), array, callContext.getExceptionTracker());
+    if (!callContext.getExceptionTracker()) {
+        return output;
+    }
+
+    output.reserve(length);
+
+    for (size_t i = 0; i < length; i++) {
+        auto property = callContext.getContext().getObjectPropertyForIndex(array, i, callContext.getExceptionTracker());
+        if (!callContext.getExceptionTracker()) {
+            return output;
+        }
+        auto string = callContext.getContext().valueToString(property.get(), callContext.getExceptionTracker());
+        if (!callContext.getExceptionTracker()) {
+            return output;
+        }
+        output.emplace_back(string.toStringView());
+    }
+
+    return output;
+}
+
+static JSValueRef toJSIndexes(JSFunctionNativeCallContext& callContext, const std::vector<size_t>& indexes) {
+    return callContext.getContext().newArrayWithValues(
+        indexes.size(), callContext.getExceptionTracker(), [&](size_t i) { return toJSIndex(callContext, indexes[i]); });
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+JSValueRef ProtobufModule::arenaDiffMessages(JSFunctionNativeCallContext& callContext) {
+    auto arenaResult = getArena(callContext, 0);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto previousMessageIndex = getIndex(callContext, 1);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto nextMessageIndex = getIndex(callContext, 2);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto fieldIndexes =
+        arenaResult->diffMessages(previousMessageIndex, nextMessageIndex, callContext.getExceptionTracker());
+    CHECK_CALL_CONTEXT(callContext);
+
+    return toJSIndexes(callContext, fieldIndexes);
+}
+
+// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
+JSValueRef ProtobufModule::arenaApplyMessagePatch(JSFunctionNativeCallContext& callContext) {
+    auto arenaResult = getArena(callContext, 0);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto messageIndex = getIndex(callContext, 1);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto patchMessageIndex = getIndex(callContext, 2);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto paths = getStrings(callContext, 3);
+    CHECK_CALL_CONTEXT(callContext);
+
+    auto fieldIndexes =
+        arenaResult->applyMessagePatch(messageIndex, patchMessageIndex, paths, callContext.getExceptionTracker());
+    CHECK_CALL_CONTEXT(callContext);
+
+    return toJSIndexes(callContext, fieldIndexes);
+}
+
 // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 JSValueRef ProtobufModule::createArena(JSFunctionNativeCallContext& callContext) {
     auto eagerDecoding = callContext.getParameterAsBool(0);
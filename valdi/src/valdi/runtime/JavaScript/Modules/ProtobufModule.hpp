@@ -55,6 +55,8 @@ public:
     JSValueRef arenaSetMessageField(JSFunctionNativeCallContext& callContext);
     JSValueRef arenaGetMessageFields(JSFunctionNativeCallContext& callContext);
     JSValueRef arenaCopyMessage(JSFunctionNativeCallContext& callContext);
+    JSValueRef arenaDiffMessages(JSFunctionNativeCallContext& callContext);
+    JSValueRef arenaApplyMessagePatch(JSFunctionNativeCallContext& callContext);
 
 protected:
     ResourceManager& _resourcesManager;
@@ -103,6 +103,8 @@ JSValueRef ProtobufModuleFactory::loadModule(IJavaScriptContext& jsContext,
                      std::make_pair("setMessageField", &ProtobufModule::arenaSetMessageField),
                      std::make_pair("getMessageFields", &ProtobufModule::arenaGetMessageFields),
                      std::make_pair("copyMessage", &ProtobufModule::arenaCopyMessage),
+                     std::make_pair("diffMessages", &ProtobufModule::arenaDiffMessages),
+                     std::make_pair("applyMessagePatch", &ProtobufModule::arenaApplyMessagePatch),
                      std::make_pair("createArena", &ProtobufModule::createArena)});
 
     if constexpr (ProtobufModule::areProtoDebugFeaturesEnabled()) {
@@ -113,13 +113,19 @@ static Value makeJsConnection(const Ref<ITCPConnection>& connection, JSTCPConnec
             }
 
             if (protocol == JSTCPConnectionProtocolValdiString || protocol == JSTCPConnectionProtocolValdiBytes) {
-                auto out = makeShared<ByteBuffer>();
-                ValdiPacket::write(bytes.data(), bytes.size(), *out);
-                bytes = out->toBytesView();
+                // Only the packet header is copied, the data is submitted by reference
+                ByteRope data;
+                data.append(bytes);
+                ByteRope packet;
+                ValdiPacket::write(data, packet);
+
+                for (const auto& chunk : packet.getChunks()) {
+                    connection->submitData(chunk);
+                }
+            } else {
+                connection->submitData(bytes);
             }
 
-            connection->submitData(bytes);
-
             return Value::undefined();
         })));
 
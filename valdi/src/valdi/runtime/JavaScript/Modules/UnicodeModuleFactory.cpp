@@ -15,6 +15,7 @@
 
 #include "valdi/runtime/JavaScript/JSFunctionWithCallable.hpp"
 #include "valdi/runtime/Text/Emoji.hpp"
+#include "valdi_core/cpp/Text/GraphemeClusters.hpp"
 #include "valdi_core/cpp/Text/UTF16Utils.hpp"
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
@@ -148,67 +149,31 @@ static int32_t computeCharacterFlags(hb_unicode_funcs_t* unicodeFuncs, uint32_t
     return getUnicodeFlag(unicodeFuncs, c);
 }
 
-inline static bool isCombiningChar(uint32_t codepoint) {
-    // Combining marks range from U+0300 to U+036F (simplified example)
-    return (codepoint >= 0x0300 && codepoint <= 0x036F);
-}
-
-inline static bool isRegionalIndicator(uint32_t codepoint) {
-    // Regional indicators range from U+1F1E6 to U+1F1FF
-    return (codepoint >= 0x1F1E6 && codepoint <= 0x1F1FF);
-}
-
-inline static bool isZeroWidthJoiner(uint32_t codepoint) {
-    return codepoint == 0x200D; // U+200D
-}
-
-inline static bool isEmojiModifier(uint32_t codepoint) {
-    // Emoji modifiers range from U+1F3FB to U+1F3FF
-    return (codepoint >= 0x1F3FB && codepoint <= 0x1F3FF);
-}
-
-inline static bool isVariationSelector(uint32_t codepoint) {
-    return (codepoint >= 0xFE00 && codepoint <= 0xFE0F) || (codepoint >= 0xE0100 && codepoint <= 0xE01EF);
-}
-
-static bool isPartOfGraphemeCluster(uint32_t current, uint32_t previous, uint32_t previousFlags) {
-    if (isCombiningChar(current)) {
-        return true;
-    }
-
-    if (isZeroWidthJoiner(previous) || isZeroWidthJoiner(current)) {
-        return true;
-    }
-
-    if (isRegionalIndicator(current) && isRegionalIndicator(previous)) {
-        return true;
-    }
-
-    if (isEmojiModifier(current) && (previousFlags & kCharacterFlagEmoji) != 0) {
-        return true;
-    }
-
-    if (isVariationSelector(current)) {
-        return true;
-    }
-
-    return false;
-}
-
 static void resolveUnicodeSequences(const uint32_t* unicodePoints, uint32_t* flags, size_t size) {
-    uint32_t previous = 0;
-    uint32_t previousFlags = 0;
+    GraphemeClusterSegmenter segmenter;
 
-    const auto* itBegin = unicodePoints;
-    const auto* it = itBegin;
-    const auto* itEnd = itBegin + size;
+    const auto* it = unicodePoints;
+    const auto* itEnd = unicodePoints + size;
     const auto* emojiTrie = getEmojiUnicodeTrie();
+    const auto& emojiSequenceScanner = getEmojiSequenceScanner();
 
     while (it != itEnd) {
-        auto current = *it;
+        // Skip the unicode points which can neither start an emoji sequence, nor be part of a grapheme
+        // cluster. Sequences are anchored on their first or second unicode point, so we resume right
+        // before the next anchor.
+        if (!emojiSequenceScanner.contains(*it) && !segmenter.continuesCluster(GraphemeClusterClass::Other)) {
+            const auto* resumeIt = emojiSequenceScanner.findFirst(it + 1, itEnd) - 1;
+            if (resumeIt != it) {
+                flags += resumeIt - it;
+                it = resumeIt;
+                segmenter.advance(GraphemeClusterClass::Other, (flags[-1] & kCharacterFlagEmoji) != 0);
+            }
+        }
+
+        auto currentClass = getGraphemeClusterClass(*it);
         auto currentFlags = *flags;
 
-        if (it != itBegin && isPartOfGraphemeCluster(current, previous, previousFlags)) {
+        if (segmenter.continuesCluster(currentClass)) {
             currentFlags |= kCharacterFromGraphemeCluster;
             *flags = currentFlags;
         }
@@ -219,23 +184,20 @@ static void resolveUnicodeSequences(const uint32_t* unicodePoints, uint32_t* fla
             currentFlags |= kCharacterFlagEmoji;
             *flags = currentFlags;
 
-            it++;
-            flags++;
-
             for (size_t i = 1; i < emojiSequence->size(); i++) {
-                currentFlags = *flags | (kCharacterFlagEmoji | kCharacterFromGraphemeCluster);
-                *flags = currentFlags;
-
+                segmenter.advance(currentClass, true);
                 it++;
                 flags++;
+
+                currentClass = getGraphemeClusterClass(*it);
+                currentFlags = *flags | (kCharacterFlagEmoji | kCharacterFromGraphemeCluster);
+                *flags = currentFlags;
             }
-        } else {
-            it++;
-            flags++;
         }
 
-        previous = current;
-        previousFlags = currentFlags;
+        segmenter.advance(currentClass, (currentFlags & kCharacterFlagEmoji) != 0);
+        it++;
+        flags++;
     }
 }
 
@@ -301,11 +263,9 @@ static ProcessedUnicodeString processUnicodeString(const uint32_t* data,
     } else {
         output.buffer->reserve(length * 2 * sizeof(uint32_t));
         output.buffer->append(reinterpret_cast<const Byte*>(data), reinterpret_cast<const Byte*>(data + length));
+        auto* flags = reinterpret_cast<int32_t*>(output.buffer->appendWritable(length * sizeof(int32_t)));
         for (size_t i = 0; i < length; i++) {
-            auto codepoint = data[i];
-            int32_t currentFlags = includeCategorization ? computeCharacterFlags(unicodeFuncs, codepoint) : 0;
-            output.buffer->append(reinterpret_cast<const Byte*>(&currentFlags),
-                                  reinterpret_cast<const Byte*>(&currentFlags + 1));
+            flags[i] = includeCategorization ? computeCharacterFlags(unicodeFuncs, data[i]) : 0;
         }
     }
 
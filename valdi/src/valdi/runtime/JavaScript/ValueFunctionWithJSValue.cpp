@@ -12,6 +12,7 @@
 #include "valdi/runtime/JavaScript/JavaScriptTaskScheduler.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
+#include "valdi_core/cpp/Utils/BridgeCrossings.hpp"
 #include "valdi_core/cpp/Utils/ResolvablePromise.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
@@ -83,6 +84,7 @@ Value ValueFunctionWithJSValue::doJsCall(JavaScriptEntryParameters& jsEntry,
                                          ExceptionTracker* exceptionTracker,
                                          bool ignoreRetValue) {
     VALDI_TRACE_META("Valdi.callJsFunction", getFunctionName());
+    ScopedBridgeCrossing bridgeCrossing(BridgeCrossingType::NativeToJS);
 
     auto jsValue = getJsValue(jsEntry.jsContext, jsEntry.exceptionTracker);
     if (!jsEntry.exceptionTracker) {
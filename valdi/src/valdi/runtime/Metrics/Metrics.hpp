@@ -9,7 +9,10 @@
 
 #include "utils/base/NonCopyable.hpp"
 #include "utils/time/StopWatch.hpp"
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/LockContentionProfiler.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 #include <chrono>
 
@@ -70,6 +73,25 @@ public:
 
     virtual void emitLoadModuleMemory(const StringBox& module, int64_t totalMemory, int64_t ownMemory) {};
 
+    /**
+     Called periodically with the frame time histograms of a module, split by frame phase,
+     along with the phases to which the janky frames were attributed and the bridge crossings
+     the frames made.
+     */
+    virtual void emitFrameMetricsSummary(const StringBox& module, const FrameMetricsSummary& summary) {};
+
+    /**
+     Called periodically while the lock contention profiler is enabled, with the wait and hold
+     times of every lock site which was contended during the period.
+     */
+    virtual void emitLockContentionSummary(const StringBox& site, const LockContentionSummary& summary) {};
+
+    /**
+     Called once per process start with the startup timeline, from the creation of the RuntimeManager
+     until the first frame, along with the spans which were on the critical path to that frame.
+     */
+    virtual void emitStartupTimeline(const StartupTimelineReport& report) {};
+
     static ScopedMetrics scopedOnScrollLatency(const Ref<Metrics>& metrics,
                                                const StringBox& module,
                                                const StringBox& backend);
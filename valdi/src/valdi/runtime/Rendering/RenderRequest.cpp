@@ -6,10 +6,29 @@
 //
 
 #include "valdi/runtime/Rendering/RenderRequest.hpp"
+#include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
 
 namespace Valdi {
 
+// Buffers which grew above this capacity are released instead of being kept in the pool,
+// so that a single very large render request does not pin its memory forever.
+constexpr size_t kMaxPooledBufferCapacity = 256 * 1024;
+
+static void recycleRenderRequestBuffer(ByteBuffer& buffer) {
+    if (buffer.capacity() > kMaxPooledBufferCapacity) {
+        buffer = ByteBuffer();
+    } else {
+        buffer.clear();
+    }
+}
+
+static ObjectPoolInner<ByteBuffer>& getRenderRequestBufferPool() {
+    static auto* kPool = new ObjectPoolInner<ByteBuffer>();
+    return *kPool;
+}
+
 class SerializeEntryVisitor {
 public:
     SerializeEntryVisitor(const AttributeIds& attributeIds, ValueArray& array)
@@ -40,6 +59,8 @@ struct DestructEntryVisitor {
     }
 };
 
+RenderRequest::RenderRequest() : _entries(getRenderRequestBufferPool().getOrCreate(&recycleRenderRequestBuffer)) {}
+
 RenderRequest::~RenderRequest() {
     DestructEntryVisitor visitor;
     visitEntries(visitor);
@@ -69,12 +90,28 @@ const Value& RenderRequest::getFrameObserverCallback() const {
     return _frameObserverCallback;
 }
 
+void RenderRequest::setJsRenderDuration(std::chrono::steady_clock::duration jsRenderDuration) {
+    _jsRenderDuration = jsRenderDuration;
+}
+
+std::chrono::steady_clock::duration RenderRequest::getJsRenderDuration() const {
+    return _jsRenderDuration;
+}
+
+void RenderRequest::setJsBridgeCrossings(const BridgeCrossings& jsBridgeCrossings) {
+    _jsBridgeCrossings = jsBridgeCrossings;
+}
+
+const BridgeCrossings& RenderRequest::getJsBridgeCrossings() const {
+    return _jsBridgeCrossings;
+}
+
 size_t RenderRequest::getEntriesSize() const {
     return _entriesSize;
 }
 
 size_t RenderRequest::getEntriesBytesCount() const {
-    return _entries.size();
+    return _entries->size();
 }
 
 RenderRequestEntries::CreateElement* RenderRequest::appendCreateElement() {
@@ -114,7 +151,7 @@ RenderRequestEntries::OnLayoutComplete* RenderRequest::appendOnLayoutComplete()
 }
 
 RenderRequestEntries::EntryBase* RenderRequest::doAppendEntry(size_t size) {
-    auto* buffer = _entries.appendWritable(size);
+    auto* buffer = _entries->appendWritable(size);
     _entriesSize++;
     return reinterpret_cast<RenderRequestEntries::EntryBase*>(buffer);
 }
@@ -135,4 +172,85 @@ Value RenderRequest::serialize(const AttributeIds& attributeIds) const {
     return Value(out);
 }
 
+static AnimationOptions deserializeAnimationOptions(const Value& value) {
+    AnimationOptions options;
+
+    auto type = value.getMapValue("type").toStringBox();
+    if (type == std::string_view("linear")) {
+        options.type = snap::valdi_core::AnimationType::Linear;
+    } else if (type == std::string_view("easeIn")) {
+        options.type = snap::valdi_core::AnimationType::EaseIn;
+    } else if (type == std::string_view("easeOut")) {
+        options.type = snap::valdi_core::AnimationType::EaseOut;
+    } else {
+        options.type = snap::valdi_core::AnimationType::EaseInOut;
+    }
+
+    const auto* controlPoints = value.getMapValue("controlPoints").getArray();
+    if (controlPoints != nullptr) {
+        for (const auto& controlPoint : *controlPoints) {
+            options.controlPoints.emplace_back(controlPoint.toDouble());
+        }
+    }
+
+    options.duration = value.getMapValue("duration").toDouble();
+    options.beginFromCurrentState = value.getMapValue("beginFromCurrentState").toBool();
+    options.crossfade = value.getMapValue("crossfade").toBool();
+    options.stiffness = value.getMapValue("stiffness").toDouble();
+    options.damping = value.getMapValue("damping").toDouble();
+
+    return options;
+}
+
+Result<Ref<RenderRequest>> RenderRequest::deserialize(const Value& value, AttributeIds& attributeIds) {
+    const auto* entries = value.getMapValue("entries").getArray();
+    if (entries == nullptr) {
+        return Error("Expected 'entries' array in serialized render request");
+    }
+
+    auto renderRequest = makeShared<RenderRequest>();
+    renderRequest->setContextId(static_cast<ContextId>(value.getMapValue("contextID").toInt()));
+
+    for (const auto& entry : *entries) {
+        auto type = entry.getMapValue("type").toStringBox();
+        auto elementId = static_cast<RawViewNodeId>(entry.getMapValue("elementId").toInt());
+
+        if (type == std::string_view("CreateElement")) {
+            auto* createElement = renderRequest->appendCreateElement();
+            createElement->setElementId(elementId);
+            createElement->setViewClassName(entry.getMapValue("viewClass").toStringBox());
+        } else if (type == std::string_view("DestroyElement")) {
+            renderRequest->appendDestroyElement()->setElementId(elementId);
+        } else if (type == std::string_view("MoveElementToParent")) {
+            auto* moveElement = renderRequest->appendMoveElementToParent();
+            moveElement->setElementId(elementId);
+            moveElement->setParentElementId(
+                static_cast<RawViewNodeId>(entry.getMapValue("parentElementId").toInt()));
+            moveElement->setParentIndex(entry.getMapValue("parentIndex").toInt());
+        } else if (type == std::string_view("SetRootElement")) {
+            renderRequest->appendSetRootElement()->setElementId(elementId);
+        } else if (type == std::string_view("SetElementAttribute")) {
+            auto* setAttribute = renderRequest->appendSetElementAttribute();
+            setAttribute->setElementId(elementId);
+            setAttribute->setAttributeId(attributeIds.getIdForName(entry.getMapValue("attributeName").toStringBox()));
+            setAttribute->setAttributeValue(entry.getMapValue("attributeValue"));
+            setAttribute->setInjectedFromParent(entry.getMapValue("injectedFromParent").toBool());
+        } else if (type == std::string_view("StartAnimations")) {
+            renderRequest->appendStartAnimations()->getAnimationOptions() =
+                deserializeAnimationOptions(entry.getMapValue("options"));
+        } else if (type == std::string_view("EndAnimations")) {
+            renderRequest->appendEndAnimations();
+        } else if (type == std::string_view("CancelAnimation")) {
+            renderRequest->appendCancelAnimation()->setToken(entry.getMapValue("token").toInt());
+        } else if (type == std::string_view("OnLayoutComplete")) {
+            // Callbacks cannot be restored
+            continue;
+        } else {
+            return Error(STRING_FORMAT("Unknown render request entry type '{}'", type));
+        }
+    }
+
+    return renderRequest;
+}
+
 } // namespace Valdi
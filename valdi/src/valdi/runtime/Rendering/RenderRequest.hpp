@@ -11,12 +11,17 @@
 
 #include "valdi/runtime/Attributes/AttributeIds.hpp"
 #include "valdi_core/cpp/Context/ContextId.hpp"
+#include "valdi_core/cpp/Utils/BridgeCrossings.hpp"
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 
 #include "valdi_core/cpp/Utils/InlineContainerAllocator.hpp"
+#include "valdi_core/cpp/Utils/ObjectPool.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/ValueMap.hpp"
 
+#include <chrono>
+
 namespace Valdi {
 
 template<typename... Types>
@@ -44,11 +49,17 @@ constexpr size_t getEntryAllocSize(const T& /*placeholder*/) {
     return getEntryAllocSize<T>();
 }
 
+using PooledRenderRequestBuffer = ObjectPoolEntry<ByteBuffer, void (*)(ByteBuffer&)>;
+
 /**
- A render request used to render components that are not backed by a Valdi document
+ A render request used to render components that are not backed by a Valdi document.
+ The entries are packed into a byte buffer which is taken from a pool, and given back to the pool
+ once the request is destroyed after being rendered. This lets consecutive frames reuse the same
+ allocations instead of growing a new buffer for every request.
  */
 class RenderRequest : public SimpleRefCountable {
 public:
+    RenderRequest();
     ~RenderRequest() override;
 
     ContextId getContextId() const;
@@ -60,8 +71,26 @@ public:
     void setFrameObserverCallback(const Value& frameObserverCallback);
     const Value& getFrameObserverCallback() const;
 
+    /**
+     The time the JS thread spent producing this render request.
+     */
+    void setJsRenderDuration(std::chrono::steady_clock::duration jsRenderDuration);
+    std::chrono::steady_clock::duration getJsRenderDuration() const;
+
+    /**
+     The bridge crossings the JS thread made while producing this render request.
+     */
+    void setJsBridgeCrossings(const BridgeCrossings& jsBridgeCrossings);
+    const BridgeCrossings& getJsBridgeCrossings() const;
+
     Value serialize(const AttributeIds& attributeIds) const;
 
+    /**
+     Re-create a RenderRequest from a Value previously returned by serialize().
+     Callbacks cannot be restored: OnLayoutComplete entries and animation completions are dropped.
+     */
+    static Result<Ref<RenderRequest>> deserialize(const Value& value, AttributeIds& attributeIds);
+
     size_t getEntriesSize() const;
     size_t getEntriesBytesCount() const;
 
@@ -82,8 +111,8 @@ public:
 
     template<typename Visitor>
     void visitEntries(Visitor& visitor) {
-        auto* current = _entries.data();
-        auto* end = current + _entries.size();
+        auto* current = _entries->data();
+        auto* end = current + _entries->size();
 
         while (current != end) {
             current += RenderRequestEntries::visitEntry(*reinterpret_cast<RenderRequestEntries::EntryBase*>(current),
@@ -96,10 +125,12 @@ public:
 
 private:
     ContextId _contextId = ContextIdNull;
-    ByteBuffer _entries;
+    PooledRenderRequestBuffer _entries;
     Value _visibilityObserverCallback;
     Value _frameObserverCallback;
     size_t _entriesSize = 0;
+    std::chrono::steady_clock::duration _jsRenderDuration = std::chrono::steady_clock::duration::zero();
+    BridgeCrossings _jsBridgeCrossings;
 
     RenderRequestEntries::EntryBase* doAppendEntry(size_t size);
 
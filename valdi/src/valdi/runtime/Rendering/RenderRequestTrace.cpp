@@ -0,0 +1,149 @@
+//
+//  RenderRequestTrace.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/runtime/Rendering/RenderRequestTrace.hpp"
+#include "valdi/runtime/Context/ViewNodeTree.hpp"
+#include "valdi/runtime/Rendering/ViewNodeRenderer.hpp"
+
+#include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/ValueUtils.hpp"
+
+#include "utils/time/StopWatch.hpp"
+
+namespace Valdi {
+
+constexpr int32_t kRenderRequestTraceVersion = 1;
+
+static const StringBox& versionKey() {
+    static auto kVersion = STRING_LITERAL("version");
+    return kVersion;
+}
+
+static const StringBox& requestsKey() {
+    static auto kRequests = STRING_LITERAL("requests");
+    return kRequests;
+}
+
+static const StringBox& timestampKey() {
+    static auto kTimestamp = STRING_LITERAL("timestampMs");
+    return kTimestamp;
+}
+
+static const StringBox& requestKey() {
+    static auto kRequest = STRING_LITERAL("request");
+    return kRequest;
+}
+
+double RenderRequestTraceReplayResult::getTotalRenderDurationMs() const {
+    double total = 0;
+    for (auto duration : renderDurationsMs) {
+        total += duration;
+    }
+    return total;
+}
+
+RenderRequestTraceRecorder::RenderRequestTraceRecorder(const AttributeIds& attributeIds)
+    : _attributeIds(attributeIds), _startTime(std::chrono::steady_clock::now()) {}
+
+RenderRequestTraceRecorder::~RenderRequestTraceRecorder() = default;
+
+void RenderRequestTraceRecorder::record(const RenderRequest& renderRequest) {
+    auto serializedRequest = renderRequest.serialize(_attributeIds);
+
+    std::lock_guard<Mutex> guard(_mutex);
+    auto timestamp = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _startTime);
+
+    auto record = makeShared<ValueMap>();
+    (*record)[timestampKey()] = Value(timestamp.count());
+    (*record)[requestKey()] = std::move(serializedRequest);
+
+    _records.emplace_back(Value(record));
+}
+
+size_t RenderRequestTraceRecorder::size() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    return _records.size();
+}
+
+Ref<ByteBuffer> RenderRequestTraceRecorder::serialize() const {
+    Ref<ValueArray> requests;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        requests = ValueArray::make(_records.data(), _records.data() + _records.size());
+    }
+
+    auto trace = makeShared<ValueMap>();
+    (*trace)[versionKey()] = Value(kRenderRequestTraceVersion);
+    (*trace)[requestsKey()] = Value(requests);
+
+    return valueToJson(Value(trace));
+}
+
+RenderRequestTrace::RenderRequestTrace() = default;
+RenderRequestTrace::RenderRequestTrace(std::vector<RenderRequestTraceEntry>&& entries) : _entries(std::move(entries)) {}
+RenderRequestTrace::~RenderRequestTrace() = default;
+
+Result<RenderRequestTrace> RenderRequestTrace::parse(const BytesView& bytes, AttributeIds& attributeIds) {
+    auto trace = jsonToValue(bytes.data(), bytes.size());
+    if (!trace) {
+        return trace.moveError();
+    }
+
+    auto version = trace.value().getMapValue(versionKey()).toInt();
+    if (version != kRenderRequestTraceVersion) {
+        return Error(STRING_FORMAT("Unsupported render request trace version {}", version));
+    }
+
+    const auto* requests = trace.value().getMapValue(requestsKey()).getArray();
+    if (requests == nullptr) {
+        return Error("Expected 'requests' array in render request trace");
+    }
+
+    std::vector<RenderRequestTraceEntry> entries;
+    entries.reserve(requests->size());
+
+    for (const auto& record : *requests) {
+        auto renderRequest = RenderRequest::deserialize(record.getMapValue(requestKey()), attributeIds);
+        if (!renderRequest) {
+            return renderRequest.moveError();
+        }
+
+        auto& entry = entries.emplace_back();
+        entry.timestampMs = record.getMapValue(timestampKey()).toDouble();
+        entry.renderRequest = renderRequest.moveValue();
+    }
+
+    return RenderRequestTrace(std::move(entries));
+}
+
+const std::vector<RenderRequestTraceEntry>& RenderRequestTrace::getEntries() const {
+    return _entries;
+}
+
+RenderRequestTraceReplayResult RenderRequestTrace::replay(ViewNodeTree& viewNodeTree,
+                                                          ILogger& logger,
+                                                          bool limitToViewportDisabled) const {
+    RenderRequestTraceReplayResult result;
+    result.renderDurationsMs.reserve(_entries.size());
+
+    for (const auto& entry : _entries) {
+        snap::utils::time::StopWatch sw;
+        sw.start();
+
+        viewNodeTree.scheduleExclusiveUpdate([&]() {
+            ViewNodeRenderer renderer(viewNodeTree, logger, limitToViewportDisabled);
+            renderer.render(*entry.renderRequest);
+            viewNodeTree.performUpdates();
+        });
+
+        result.renderDurationsMs.emplace_back(sw.elapsed().milliseconds());
+    }
+
+    return result;
+}
+
+} // namespace Valdi
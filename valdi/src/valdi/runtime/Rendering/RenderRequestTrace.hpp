@@ -0,0 +1,83 @@
+//
+//  RenderRequestTrace.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi/runtime/Rendering/RenderRequest.hpp"
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace Valdi {
+
+class ILogger;
+class ViewNodeTree;
+
+struct RenderRequestTraceEntry {
+    // Time at which the render request was received, relative to the start of the recording
+    double timestampMs = 0;
+    Ref<RenderRequest> renderRequest;
+};
+
+struct RenderRequestTraceReplayResult {
+    // Time spent rendering and updating the tree for each replayed render request
+    std::vector<double> renderDurationsMs;
+
+    double getTotalRenderDurationMs() const;
+};
+
+/**
+ Records the stream of render requests processed by a Runtime, so that rendering workloads
+ captured on a real screen can be replayed offline without JS. The trace is stored as JSON
+ using the RenderRequest::serialize() representation.
+ */
+class RenderRequestTraceRecorder : public SimpleRefCountable {
+public:
+    explicit RenderRequestTraceRecorder(const AttributeIds& attributeIds);
+    ~RenderRequestTraceRecorder() override;
+
+    void record(const RenderRequest& renderRequest);
+
+    size_t size() const;
+
+    Ref<ByteBuffer> serialize() const;
+
+private:
+    const AttributeIds& _attributeIds;
+    mutable Mutex _mutex;
+    std::chrono::steady_clock::time_point _startTime;
+    std::vector<Value> _records;
+};
+
+class RenderRequestTrace {
+public:
+    RenderRequestTrace();
+    explicit RenderRequestTrace(std::vector<RenderRequestTraceEntry>&& entries);
+    ~RenderRequestTrace();
+
+    static Result<RenderRequestTrace> parse(const BytesView& bytes, AttributeIds& attributeIds);
+
+    const std::vector<RenderRequestTraceEntry>& getEntries() const;
+
+    /**
+     Render all the requests of the trace into the given ViewNodeTree, regardless of the context
+     they were recorded for, and measure how long each of them took to be rendered and applied.
+     */
+    RenderRequestTraceReplayResult replay(ViewNodeTree& viewNodeTree,
+                                          ILogger& logger,
+                                          bool limitToViewportDisabled) const;
+
+private:
+    std::vector<RenderRequestTraceEntry> _entries;
+};
+
+} // namespace Valdi
@@ -17,6 +17,7 @@
 #include "valdi/runtime/Rendering/RenderRequest.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 
@@ -32,6 +33,10 @@ ViewNodeRenderer::ViewNodeRenderer(ViewNodeTree& viewNodeTree, ILogger& logger,
       _limitToViewportDisabled(limitToViewportDisabled) {}
 
 void ViewNodeRenderer::render(const RenderRequest& request) {
+    ScopedFrameMetrics::addPhaseDuration(FramePhase::JSRender, request.getJsRenderDuration());
+    ScopedFrameMetrics::addBridgeCrossings(request.getJsBridgeCrossings());
+    ScopedFramePhase framePhase(FramePhase::Render);
+
     if (!request.getVisibilityObserverCallback().isNullOrUndefined()) {
         _viewNodeTree.registerViewNodesVisibilityObserverCallback(
             request.getVisibilityObserverCallback().getFunctionRef());
@@ -40,11 +45,28 @@ void ViewNodeRenderer::render(const RenderRequest& request) {
         _viewNodeTree.registerViewNodesFrameObserverCallback(request.getFrameObserverCallback().getFunctionRef());
     }
 
+    auto adoptsPrerenderedViewNodes = _viewNodeTree.hasPrerenderedViewNodes();
+
+    request.visitEntries(*this);
+
+    setCurrent(nullptr);
+    setParent(nullptr);
+
+    if (adoptsPrerenderedViewNodes) {
+        _viewNodeTree.removePrerenderedViewNodes();
+    }
+
+    updateCSS();
+}
+
+void ViewNodeRenderer::prerender(const RenderRequest& request) {
     request.visitEntries(*this);
 
     setCurrent(nullptr);
     setParent(nullptr);
 
+    _viewNodeTree.markViewNodesAsPrerendered();
+
     updateCSS();
 }
 
@@ -54,6 +76,15 @@ void ViewNodeRenderer::visit(RenderRequestEntries::CreateElement& entry) {
         return;
     }
 
+    if (_viewNodeTree.hasPrerenderedViewNodes()) {
+        auto prerenderedViewNode =
+            _viewNodeTree.adoptPrerenderedViewNode(entry.getElementId(), entry.getViewClassName());
+        if (prerenderedViewNode != nullptr) {
+            setCurrent(std::move(prerenderedViewNode));
+            return;
+        }
+    }
+
     auto viewNode =
         Valdi::makeShared<ViewNode>(_attributesManager.getYogaConfig(), _attributesManager.getAttributeIds(), _logger);
     viewNode->setViewFactory(_viewTransactionScope, _viewNodeTree.getOrCreateViewFactory(entry.getViewClassName()));
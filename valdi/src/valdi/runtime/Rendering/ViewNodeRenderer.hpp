@@ -34,6 +34,12 @@ public:
 
     void render(const RenderRequest& request);
 
+    /**
+     Render a RenderRequest which was generated at compile time, before the component was
+     rendered from JS. The resulting view nodes are adopted by the first render from JS.
+     */
+    void prerender(const RenderRequest& request);
+
 private:
     ViewNodeTree& _viewNodeTree;
     ViewTransactionScope& _viewTransactionScope;
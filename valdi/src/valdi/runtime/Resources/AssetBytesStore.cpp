@@ -1,5 +1,6 @@
 
 #include "valdi/runtime/Resources/AssetBytesStore.hpp"
+#include "valdi/runtime/Utils/BytesUtils.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 
@@ -15,11 +16,20 @@ static const StringBox& getAssetBytesStoreUrlPrefix() {
 }
 
 StringBox AssetBytesStore::registerAssetBytes(const BytesView& bytes) {
+    auto contentHash = StringCache::getGlobal().makeString(BytesUtils::sha256String(bytes));
+
     std::lock_guard<Mutex> lock(_mutex);
+    // Identical bytes registered multiple times resolve to the same url, and thus share the same asset
+    const auto& existingIt = _urlByContentHash.find(contentHash);
+    if (existingIt != _urlByContentHash.end()) {
+        return existingIt->second;
+    }
+
     auto id = ++_assetKeyBytesIdSequence;
 
     auto url = STRING_FORMAT("{}{}", getAssetBytesStoreUrlPrefix(), id);
-    _bytesByUrl[url] = bytes;
+    _bytesByUrl[url] = AssetBytesEntry{bytes, contentHash};
+    _urlByContentHash[contentHash] = url;
     return url;
 }
 
@@ -27,6 +37,7 @@ void AssetBytesStore::unregisterAssetBytes(const StringBox& url) {
     std::lock_guard<Mutex> lock(_mutex);
     auto it = _bytesByUrl.find(url);
     if (it != _bytesByUrl.end()) {
+        _urlByContentHash.erase(it->second.contentHash);
         _bytesByUrl.erase(it);
     }
 }
@@ -38,7 +49,7 @@ Shared<snap::valdi_core::Cancelable> AssetBytesStore::downloadItem(
         std::lock_guard<Mutex> lock(_mutex);
         const auto& it = _bytesByUrl.find(url);
         if (it != _bytesByUrl.end()) {
-            result = Result<BytesView>(it->second);
+            result = Result<BytesView>(it->second.bytes);
         } else {
             result = Result<BytesView>(Error("Did not find associated bytes with url"));
         }
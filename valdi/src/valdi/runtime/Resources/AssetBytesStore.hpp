@@ -9,6 +9,11 @@
 
 namespace Valdi {
 
+/**
+ In-memory store of the assets created from bytes, which are exposed through a generated url.
+ Assets are keyed by the hash of their content, so that registering the same bytes again
+ returns the url of the existing entry.
+ */
 class AssetBytesStore : public IRemoteDownloader {
 public:
     AssetBytesStore();
@@ -24,9 +29,15 @@ public:
     static bool isAssetBytesUrl(const StringBox& url);
 
 private:
+    struct AssetBytesEntry {
+        BytesView bytes;
+        StringBox contentHash;
+    };
+
     Mutex _mutex;
     uint64_t _assetKeyBytesIdSequence = 0;
-    FlatMap<StringBox, BytesView> _bytesByUrl;
+    FlatMap<StringBox, AssetBytesEntry> _bytesByUrl;
+    FlatMap<StringBox, StringBox> _urlByContentHash;
 };
 
 } // namespace Valdi
@@ -0,0 +1,87 @@
+//
+//  AssetKeyCache.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/runtime/Resources/AssetKeyCache.hpp"
+
+namespace Valdi {
+
+AssetKeyCache::AssetKeyCache() = default;
+AssetKeyCache::~AssetKeyCache() = default;
+
+bool AssetKeyCache::isCacheable(const StringBox& value) {
+    // Data URLs are typically unique and large, caching them would only retain them
+    return !value.hasPrefix("data:");
+}
+
+bool AssetKeyCache::find(const StringBox& value, std::optional<AssetKey>& assetKey) const {
+    std::lock_guard<Mutex> guard(_mutex);
+    const auto& it = _keyByValue.find(value);
+    if (it == _keyByValue.end()) {
+        return false;
+    }
+
+    assetKey = it->second;
+    return true;
+}
+
+bool AssetKeyCache::findRelative(const StringBox& bundleName,
+                                 const StringBox& assetName,
+                                 std::optional<AssetKey>& assetKey) const {
+    std::lock_guard<Mutex> guard(_mutex);
+    const auto& bundleIt = _relativeKeyByBundleName.find(bundleName);
+    if (bundleIt == _relativeKeyByBundleName.end()) {
+        return false;
+    }
+
+    const auto& it = bundleIt->second.find(assetName);
+    if (it == bundleIt->second.end()) {
+        return false;
+    }
+
+    assetKey = it->second;
+    return true;
+}
+
+void AssetKeyCache::store(const StringBox& value, const std::optional<AssetKey>& assetKey) {
+    std::lock_guard<Mutex> guard(_mutex);
+    lockFreeMakeRoom();
+
+    if (_keyByValue.try_emplace(value, assetKey).second) {
+        _size++;
+    }
+}
+
+void AssetKeyCache::storeRelative(const StringBox& bundleName, const StringBox& assetName, const AssetKey& assetKey) {
+    std::lock_guard<Mutex> guard(_mutex);
+    lockFreeMakeRoom();
+
+    if (_relativeKeyByBundleName[bundleName].try_emplace(assetName, assetKey).second) {
+        _size++;
+    }
+}
+
+void AssetKeyCache::lockFreeMakeRoom() {
+    if (_size >= kMaxEntries) {
+        _keyByValue.clear();
+        _relativeKeyByBundleName.clear();
+        _size = 0;
+    }
+}
+
+void AssetKeyCache::clear() {
+    std::lock_guard<Mutex> guard(_mutex);
+    _keyByValue.clear();
+    _relativeKeyByBundleName.clear();
+    _size = 0;
+}
+
+size_t AssetKeyCache::size() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    return _size;
+}
+
+} // namespace Valdi
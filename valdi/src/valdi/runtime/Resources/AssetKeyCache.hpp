@@ -0,0 +1,91 @@
+//
+//  AssetKeyCache.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi/runtime/Resources/AssetKey.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+#include <optional>
+
+namespace Valdi {
+
+/**
+ Caches the AssetKey resolved from asset attribute values, so that parsing and sanitizing the
+ module and asset names, and looking up the bundle, happens once per distinct value. Values are
+ keyed by their interned StringBox, relative asset names are keyed by their bundle name as well.
+
+ The cache must be cleared whenever the bundles are replaced or unloaded, as the cached keys
+ retain the bundle they were resolved against.
+ */
+class AssetKeyCache {
+public:
+    AssetKeyCache();
+    ~AssetKeyCache();
+
+    /**
+     Returns the cached AssetKey of the given attribute value, or calls the given function to resolve it.
+     The function returns an empty optional if the value is a relative asset name, which is cached as well.
+     */
+    template<typename F>
+    std::optional<AssetKey> getOrResolve(const StringBox& value, F&& resolve) {
+        if (!isCacheable(value)) {
+            return resolve();
+        }
+
+        std::optional<AssetKey> assetKey;
+        if (find(value, assetKey)) {
+            return assetKey;
+        }
+
+        assetKey = resolve();
+        store(value, assetKey);
+        return assetKey;
+    }
+
+    /**
+     Returns the cached AssetKey of the given asset name relative to the given bundle,
+     or calls the given function to resolve it.
+     */
+    template<typename F>
+    AssetKey getOrResolveRelative(const StringBox& bundleName, const StringBox& assetName, F&& resolve) {
+        std::optional<AssetKey> assetKey;
+        if (findRelative(bundleName, assetName, assetKey)) {
+            return std::move(assetKey.value());
+        }
+
+        auto resolvedAssetKey = resolve();
+        storeRelative(bundleName, assetName, resolvedAssetKey);
+        return resolvedAssetKey;
+    }
+
+    void clear();
+
+    size_t size() const;
+
+    // Beyond this number of entries, the cache is cleared before inserting new ones
+    static constexpr size_t kMaxEntries = 4096;
+
+private:
+    mutable Mutex _mutex;
+    FlatMap<StringBox, std::optional<AssetKey>> _keyByValue;
+    FlatMap<StringBox, FlatMap<StringBox, AssetKey>> _relativeKeyByBundleName;
+    size_t _size = 0;
+
+    static bool isCacheable(const StringBox& value);
+
+    bool find(const StringBox& value, std::optional<AssetKey>& assetKey) const;
+    bool findRelative(const StringBox& bundleName, const StringBox& assetName, std::optional<AssetKey>& assetKey) const;
+
+    void store(const StringBox& value, const std::optional<AssetKey>& assetKey);
+    void storeRelative(const StringBox& bundleName, const StringBox& assetName, const AssetKey& assetKey);
+
+    void lockFreeMakeRoom();
+};
+
+} // namespace Valdi
@@ -24,36 +24,42 @@ StringBox static sanitizeAssetName(const StringBox& assetName) {
     return assetName.trimmed().replacing('-', '_');
 }
 
-static Ref<Asset> resolveFromModuleAndAssetName(ResourceManager& resourceManager,
-                                                const Ref<AssetsManager>& assetsManager,
-                                                const StringBox& moduleName,
-                                                const StringBox& assetName) {
+static AssetKey resolveAssetKey(ResourceManager& resourceManager,
+                                const StringBox& moduleName,
+                                const StringBox& assetName) {
     auto module = resourceManager.getBundle(moduleName);
 
-    return assetsManager->getAsset(AssetKey(module, sanitizeAssetName(assetName)));
+    return AssetKey(module, sanitizeAssetName(assetName));
 }
 
-Ref<Asset> AssetResolver::resolve(ResourceManager& resourceManager, const Value& value) {
-    if (value.isValdiObject()) {
-        return castOrNull<Asset>(value.getValdiObject());
-    }
-
-    auto str = value.toStringBox();
-
-    const auto& assetsManager = resourceManager.getAssetsManager();
-
+static std::optional<AssetKey> resolveAbsoluteAssetKey(ResourceManager& resourceManager, const StringBox& str) {
     if (AssetsManager::isAssetUrl(str)) {
-        return assetsManager->getAsset(AssetKey(str));
+        return AssetKey(str);
     }
 
     auto moduleSeparator = str.indexOf(':');
     if (moduleSeparator) {
         // Module is explicitly specified
         auto pair = str.split(*moduleSeparator);
-        return resolveFromModuleAndAssetName(resourceManager, assetsManager, pair.first.trimmed(), pair.second);
+        return resolveAssetKey(resourceManager, pair.first.trimmed(), pair.second);
     }
 
-    return nullptr;
+    return std::nullopt;
+}
+
+Ref<Asset> AssetResolver::resolve(ResourceManager& resourceManager, const Value& value) {
+    if (value.isValdiObject()) {
+        return castOrNull<Asset>(value.getValdiObject());
+    }
+
+    auto str = value.toStringBox();
+    auto assetKey = resourceManager.getAssetKeyCache().getOrResolve(
+        str, [&]() { return resolveAbsoluteAssetKey(resourceManager, str); });
+    if (!assetKey) {
+        return nullptr;
+    }
+
+    return resourceManager.getAssetsManager()->getAsset(assetKey.value());
 }
 
 Result<Ref<Asset>> AssetResolver::resolve(ViewNode& viewNode, const Value& value) {
@@ -73,10 +79,12 @@ Result<Ref<Asset>> AssetResolver::resolve(ViewNode& viewNode, const Value& value
         return Error("Cannot resolve relative asset without a document");
     }
 
-    return resolveFromModuleAndAssetName(resourceManager,
-                                         resourceManager.getAssetsManager(),
-                                         cssDocument->getResourceId().bundleName,
-                                         value.toStringBox());
+    const auto& bundleName = cssDocument->getResourceId().bundleName;
+    auto assetName = value.toStringBox();
+    auto assetKey = resourceManager.getAssetKeyCache().getOrResolveRelative(
+        bundleName, assetName, [&]() { return resolveAssetKey(resourceManager, bundleName, assetName); });
+
+    return resourceManager.getAssetsManager()->getAsset(assetKey);
 }
 
 } // namespace Valdi
@@ -677,6 +677,23 @@ static const char* stringFromOutputType(snap::valdi_core::AssetOutputType output
     return snap::valdi_core::to_string(outputType);
 }
 
+static Ref<AssetLoaderRequestHandler> findReusableRequestHandler(const Ref<ManagedAsset>& managedAsset,
+                                                                 const Ref<AssetConsumer>& assetConsumer) {
+    auto consumersSize = managedAsset->getConsumersSize();
+    for (size_t i = 0; i < consumersSize; i++) {
+        auto consumer = managedAsset->getConsumer(i);
+        auto requestHandler = castOrNull<AssetLoaderRequestHandler>(consumer->getAssetLoaderCompletion());
+        if (requestHandler != nullptr && requestHandler->getRequestedWidth() == assetConsumer->getPreferredWidth() &&
+            requestHandler->getRequestedHeight() == assetConsumer->getPreferredHeight() &&
+            requestHandler->getAttachedData() == assetConsumer->getAttachedData() &&
+            consumer->getOutputType() == assetConsumer->getOutputType()) {
+            return requestHandler;
+        }
+    }
+
+    return nullptr;
+}
+
 void AssetsManager::loadAssetForConsumerAtResolvedLocation(AssetsManagerTransaction& transaction,
                                                            const AssetKey& assetKey,
                                                            const Ref<ManagedAsset>& managedAsset,
@@ -705,24 +722,34 @@ void AssetsManager::loadAssetForConsumerAtResolvedLocation(AssetsManagerTransact
     auto preferredHeight = assetConsumer->getPreferredHeight();
     auto attachedData = assetConsumer->getAttachedData();
 
-    if (assetLoader->canReuseLoadedAssets()) {
-        auto consumersSize = managedAsset->getConsumersSize();
-        for (size_t i = 0; i < consumersSize; i++) {
-            auto consumer = managedAsset->getConsumer(i);
-            auto requestHandler = castOrNull<AssetLoaderRequestHandler>(consumer->getAssetLoaderCompletion());
-            if (requestHandler != nullptr && requestHandler->getRequestedWidth() == preferredWidth &&
-                requestHandler->getRequestedHeight() == preferredHeight &&
-                requestHandler->getAttachedData() == attachedData &&
-                consumer->getOutputType() == assetConsumer->getOutputType()) {
-                updateConsumerRequestHandler(assetConsumer, requestHandler);
-
-                if (!requestHandler->getLastLoadResult().empty()) {
-                    onConsumerLoad(assetConsumer, requestHandler->getLastLoadResult());
-                    scheduleAssetUpdate(transaction, assetKey);
-                }
+    auto canReuseLoadedAssets = assetLoader->canReuseLoadedAssets();
+    AssetLoadRequestKey requestKey{assetKey,
+                                   assetLocation.getUrl(),
+                                   assetConsumer->getOutputType(),
+                                   preferredWidth,
+                                   preferredHeight,
+                                   attachedData};
+
+    if (canReuseLoadedAssets) {
+        // Consumers updated within the same transaction resolve their shared request without
+        // going through all the consumers of the asset.
+        auto requestHandler = transaction.getLoadRequest(requestKey);
+        if (requestHandler == nullptr) {
+            requestHandler = findReusableRequestHandler(managedAsset, assetConsumer);
+            if (requestHandler != nullptr) {
+                transaction.setLoadRequest(requestKey, requestHandler);
+            }
+        }
 
-                return;
+        if (requestHandler != nullptr) {
+            updateConsumerRequestHandler(assetConsumer, requestHandler);
+
+            if (!requestHandler->getLastLoadResult().empty()) {
+                onConsumerLoad(assetConsumer, requestHandler->getLastLoadResult());
+                scheduleAssetUpdate(transaction, assetKey);
             }
+
+            return;
         }
     }
 
@@ -737,6 +764,10 @@ void AssetsManager::loadAssetForConsumerAtResolvedLocation(AssetsManagerTransact
                                                                 preferredHeight,
                                                                 attachedData);
     updateConsumerRequestHandler(assetConsumer, requestHandler);
+
+    if (canReuseLoadedAssets) {
+        transaction.setLoadRequest(requestKey, requestHandler);
+    }
 }
 
 void AssetsManager::onObservableDestroyed(const AssetKey& assetKey) {
@@ -6,9 +6,17 @@
 //
 
 #include "valdi/runtime/Resources/AssetsManagerTransaction.hpp"
+#include "valdi/runtime/Resources/AssetLoaderRequestHandler.hpp"
+
+#include <boost/functional/hash.hpp>
 
 namespace Valdi {
 
+bool AssetLoadRequestKey::operator==(const AssetLoadRequestKey& other) const {
+    return assetKey == other.assetKey && url == other.url && outputType == other.outputType &&
+           width == other.width && height == other.height && attachedData == other.attachedData;
+}
+
 AssetsManagerTransaction::AssetsManagerTransaction(std::unique_lock<std::recursive_mutex>&& lock)
     : _lock(std::move(lock)) {}
 
@@ -27,21 +35,38 @@ void AssetsManagerTransaction::acquireLock() {
 }
 
 void AssetsManagerTransaction::enqueueUpdate(const AssetKey& assetKey) {
-    _updates.emplace_back(assetKey);
+    if (_pendingUpdates.insert(assetKey).second) {
+        _updates.emplace_back(assetKey);
+    }
 }
 
 std::optional<AssetKey> AssetsManagerTransaction::dequeueUpdate() {
-    if (_updates.empty()) {
+    if (_updatesIndex == _updates.size()) {
+        _updates.clear();
+        _updatesIndex = 0;
         return std::nullopt;
     }
 
-    auto assetKey = *_updates.begin();
-
-    _updates.erase(_updates.begin());
+    auto assetKey = std::move(_updates[_updatesIndex++]);
+    _pendingUpdates.erase(assetKey);
 
     return {std::move(assetKey)};
 }
 
+Ref<AssetLoaderRequestHandler> AssetsManagerTransaction::getLoadRequest(const AssetLoadRequestKey& key) const {
+    const auto& it = _loadRequests.find(key);
+    if (it == _loadRequests.end() || it->second->scheduledForCancelation()) {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+void AssetsManagerTransaction::setLoadRequest(const AssetLoadRequestKey& key,
+                                              const Ref<AssetLoaderRequestHandler>& requestHandler) {
+    _loadRequests[key] = requestHandler;
+}
+
 thread_local AssetsManagerTransaction* kCurrent = nullptr;
 
 AssetsManagerTransaction* AssetsManagerTransaction::current() {
@@ -53,3 +78,17 @@ void AssetsManagerTransaction::setCurrent(AssetsManagerTransaction* current) {
 }
 
 } // namespace Valdi
+
+namespace std {
+
+std::size_t hash<Valdi::AssetLoadRequestKey>::operator()(const Valdi::AssetLoadRequestKey& k) const noexcept {
+    std::size_t hash = 0;
+    boost::hash_combine(hash, std::hash<Valdi::AssetKey>()(k.assetKey));
+    boost::hash_combine(hash, k.url.hash());
+    boost::hash_combine(hash, static_cast<int>(k.outputType));
+    boost::hash_combine(hash, k.width);
+    boost::hash_combine(hash, k.height);
+    return hash;
+}
+
+} // namespace std
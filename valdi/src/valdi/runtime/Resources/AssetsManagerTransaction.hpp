@@ -8,13 +8,46 @@
 #pragma once
 
 #include "valdi/runtime/Resources/AssetKey.hpp"
+#include "valdi_core/AssetOutputType.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
 
 #include <mutex>
 #include <optional>
 
 namespace Valdi {
 
+class AssetLoaderRequestHandler;
+
+/**
+ Identifies the load requests which can be shared between asset consumers.
+ */
+struct AssetLoadRequestKey {
+    AssetKey assetKey;
+    StringBox url;
+    snap::valdi_core::AssetOutputType outputType;
+    int32_t width;
+    int32_t height;
+    Value attachedData;
+
+    bool operator==(const AssetLoadRequestKey& other) const;
+};
+
+} // namespace Valdi
+
+namespace std {
+
+template<>
+struct hash<Valdi::AssetLoadRequestKey> {
+    std::size_t operator()(const Valdi::AssetLoadRequestKey& k) const noexcept;
+};
+
+} // namespace std
+
+namespace Valdi {
+
 class AssetsManagerTransaction {
 public:
     explicit AssetsManagerTransaction(std::unique_lock<std::recursive_mutex>&& lock);
@@ -23,16 +56,31 @@ public:
     void releaseLock();
     void acquireLock();
 
+    /**
+     Enqueue an update for the given asset. Does nothing if an update for the asset is
+     already pending, since a single update will observe all the changes made before it runs.
+     */
     void enqueueUpdate(const AssetKey& assetKey);
 
     std::optional<AssetKey> dequeueUpdate();
 
+    /**
+     Returns the load request that was started or reused for the given key during this transaction,
+     so that all the consumers of the same asset with the same specs which are updated in a single pass
+     share one load request.
+     */
+    Ref<AssetLoaderRequestHandler> getLoadRequest(const AssetLoadRequestKey& key) const;
+    void setLoadRequest(const AssetLoadRequestKey& key, const Ref<AssetLoaderRequestHandler>& requestHandler);
+
     static AssetsManagerTransaction* current();
     static void setCurrent(AssetsManagerTransaction* current);
 
 private:
     std::unique_lock<std::recursive_mutex> _lock;
     SmallVector<AssetKey, 8> _updates;
+    size_t _updatesIndex = 0;
+    FlatSet<AssetKey> _pendingUpdates;
+    FlatMap<AssetLoadRequestKey, Ref<AssetLoaderRequestHandler>> _loadRequests;
 };
 
 } // namespace Valdi
@@ -0,0 +1,171 @@
+#include "valdi/runtime/Resources/AsyncDiskCache.hpp"
+
+namespace Valdi {
+
+AsyncDiskCache::AsyncDiskCache(const Ref<IDiskCache>& diskCache,
+                               const Ref<DispatchQueue>& dispatchQueue,
+                               std::chrono::steady_clock::duration batchDelay)
+    : _diskCache(diskCache), _dispatchQueue(dispatchQueue), _batchDelay(batchDelay) {}
+
+AsyncDiskCache::~AsyncDiskCache() = default;
+
+bool AsyncDiskCache::exists(const Path& path) {
+    if (getPendingBytes(path)) {
+        return true;
+    }
+    return _diskCache->exists(path);
+}
+
+Result<BytesView> AsyncDiskCache::load(const Path& path) {
+    auto pendingBytes = getPendingBytes(path);
+    if (pendingBytes) {
+        return pendingBytes.value();
+    }
+    return _diskCache->load(path);
+}
+
+Result<BytesView> AsyncDiskCache::loadForAbsoluteURL(const StringBox& url) {
+    return _diskCache->loadForAbsoluteURL(url);
+}
+
+Result<Void> AsyncDiskCache::store(const Path& path, const BytesView& bytes) {
+    // The store is written from the queue so that it cannot be overridden by a batch being written
+    auto replacedStore = removePendingStore(path);
+    Result<Void> result;
+    _dispatchQueue->safeSync([&]() { result = _diskCache->store(path, bytes); });
+    if (replacedStore) {
+        notifyCompletions(replacedStore.value(), result);
+    }
+    return result;
+}
+
+bool AsyncDiskCache::remove(const Path& path) {
+    auto removedStore = removePendingStore(path);
+    auto removed = false;
+    _dispatchQueue->safeSync([&]() { removed = _diskCache->remove(path); });
+    if (removedStore) {
+        notifyCompletions(removedStore.value(), Void());
+        return true;
+    }
+    return removed;
+}
+
+StringBox AsyncDiskCache::getAbsoluteURL(const Path& path) const {
+    return _diskCache->getAbsoluteURL(path);
+}
+
+Ref<IDiskCache> AsyncDiskCache::scopedCache(const Path& path, bool allowsReadOutsideOfScope) const {
+    auto scopedDiskCache = _diskCache->scopedCache(path, allowsReadOutsideOfScope);
+    if (scopedDiskCache == nullptr) {
+        return nullptr;
+    }
+    return makeShared<AsyncDiskCache>(scopedDiskCache, _dispatchQueue, _batchDelay);
+}
+
+Path AsyncDiskCache::getRootPath() const {
+    return _diskCache->getRootPath();
+}
+
+std::vector<Path> AsyncDiskCache::list(const Path& path) const {
+    return _diskCache->list(path);
+}
+
+void AsyncDiskCache::loadAsync(const Path& path, Function<void(Result<BytesView>)> completion) {
+    _dispatchQueue->async(
+        [self = strongSmallRef(this), path, completion = std::move(completion)]() { completion(self->load(path)); });
+}
+
+void AsyncDiskCache::storeAsync(const Path& path, const BytesView& bytes, Function<void(Result<Void>)> completion) {
+    std::lock_guard<Mutex> lock(_mutex);
+    auto& pendingStore = _pendingStores[makeKey(path)];
+    pendingStore.path = path;
+    pendingStore.bytes = bytes;
+    if (completion) {
+        pendingStore.completions.emplace_back(std::move(completion));
+    }
+
+    if (_batchScheduled) {
+        return;
+    }
+    _batchScheduled = true;
+
+    auto writeBatch = [self = strongSmallRef(this)]() { self->writePendingStores(); };
+    if (_batchDelay == std::chrono::steady_clock::duration::zero()) {
+        _dispatchQueue->async(std::move(writeBatch));
+    } else {
+        _dispatchQueue->asyncAfter(std::move(writeBatch), _batchDelay);
+    }
+}
+
+void AsyncDiskCache::flush() {
+    _dispatchQueue->safeSync([&]() { writePendingStores(); });
+}
+
+size_t AsyncDiskCache::getPendingStoresCount() const {
+    std::lock_guard<Mutex> lock(_mutex);
+    return _pendingStores.size();
+}
+
+std::optional<BytesView> AsyncDiskCache::getPendingBytes(const Path& path) const {
+    std::lock_guard<Mutex> lock(_mutex);
+    auto it = _pendingStores.find(makeKey(path));
+    if (it == _pendingStores.end()) {
+        return std::nullopt;
+    }
+    return it->second.bytes;
+}
+
+std::optional<std::vector<AsyncDiskCache::StoreCompletion>> AsyncDiskCache::removePendingStore(const Path& path) {
+    std::lock_guard<Mutex> lock(_mutex);
+    auto it = _pendingStores.find(makeKey(path));
+    if (it == _pendingStores.end()) {
+        return std::nullopt;
+    }
+    auto completions = std::move(it->second.completions);
+    _pendingStores.erase(it);
+    return completions;
+}
+
+void AsyncDiskCache::writePendingStores() {
+    std::vector<PendingStore> batch;
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        _batchScheduled = false;
+        batch.reserve(_pendingStores.size());
+        for (auto& it : _pendingStores) {
+            batch.emplace_back(PendingStore{it.second.path, it.second.bytes, std::move(it.second.completions)});
+            it.second.completions.clear();
+        }
+    }
+
+    for (const auto& pendingStore : batch) {
+        auto result = _diskCache->store(pendingStore.path, pendingStore.bytes);
+
+        std::vector<StoreCompletion> completions;
+        {
+            // Stores stay visible to loads until they are written, unless they were replaced since
+            std::lock_guard<Mutex> lock(_mutex);
+            auto it = _pendingStores.find(makeKey(pendingStore.path));
+            if (it != _pendingStores.end() && it->second.bytes.data() == pendingStore.bytes.data() &&
+                it->second.bytes.size() == pendingStore.bytes.size()) {
+                completions = std::move(it->second.completions);
+                _pendingStores.erase(it);
+            }
+        }
+
+        notifyCompletions(pendingStore.completions, result);
+        notifyCompletions(completions, result);
+    }
+}
+
+StringBox AsyncDiskCache::makeKey(const Path& path) {
+    return path.toStringBox();
+}
+
+void AsyncDiskCache::notifyCompletions(const std::vector<StoreCompletion>& completions, const Result<Void>& result) {
+    for (const auto& completion : completions) {
+        completion(result);
+    }
+}
+
+} // namespace Valdi
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "valdi/runtime/Interfaces/IDiskCache.hpp"
+
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ AsyncDiskCache is an implementation of DiskCache which takes another DiskCache instance to perform
+ the actual I/O, and which allows loads and stores to be performed on the given serial queue with
+ completion callbacks, so that threads like the JS thread don't have to wait on the disk.
+ Stores are batched: they are accumulated and written together on the queue after the given delay,
+ and a store to a path which is still pending replaces the previous one so that only the last bytes
+ are written. The synchronous methods see the pending stores.
+ */
+class AsyncDiskCache : public IDiskCache {
+public:
+    AsyncDiskCache(const Ref<IDiskCache>& diskCache,
+                   const Ref<DispatchQueue>& dispatchQueue,
+                   std::chrono::steady_clock::duration batchDelay = std::chrono::steady_clock::duration::zero());
+    ~AsyncDiskCache() override;
+
+    bool exists(const Path& path) final;
+
+    Result<BytesView> load(const Path& path) final;
+
+    Result<BytesView> loadForAbsoluteURL(const StringBox& url) final;
+
+    Result<Void> store(const Path& path, const BytesView& bytes) final;
+
+    bool remove(const Path& path) final;
+
+    StringBox getAbsoluteURL(const Path& path) const final;
+
+    Ref<IDiskCache> scopedCache(const Path& path, bool allowsReadOutsideOfScope) const final;
+
+    Path getRootPath() const final;
+
+    std::vector<Path> list(const Path& path) const final;
+
+    /**
+     Load the item at the given path on the queue and call the completion with the result
+     from the queue.
+     */
+    void loadAsync(const Path& path, Function<void(Result<BytesView>)> completion);
+
+    /**
+     Schedule the item at the given path to be stored with the given bytes. The completion
+     is called from the queue once the batch containing the store was written.
+     */
+    void storeAsync(const Path& path, const BytesView& bytes, Function<void(Result<Void>)> completion);
+
+    /**
+     Synchronously write all the pending stores.
+     */
+    void flush();
+
+    size_t getPendingStoresCount() const;
+
+private:
+    using StoreCompletion = Function<void(Result<Void>)>;
+
+    struct PendingStore {
+        Path path;
+        BytesView bytes;
+        std::vector<StoreCompletion> completions;
+    };
+
+    mutable Mutex _mutex;
+    Ref<IDiskCache> _diskCache;
+    Ref<DispatchQueue> _dispatchQueue;
+    std::chrono::steady_clock::duration _batchDelay;
+    FlatMap<StringBox, PendingStore> _pendingStores;
+    bool _batchScheduled = false;
+
+    std::optional<BytesView> getPendingBytes(const Path& path) const;
+    std::optional<std::vector<StoreCompletion>> removePendingStore(const Path& path);
+    void writePendingStores();
+
+    static StringBox makeKey(const Path& path);
+    static void notifyCompletions(const std::vector<StoreCompletion>& completions, const Result<Void>& result);
+};
+
+} // namespace Valdi
@@ -10,6 +10,7 @@
 #include "utils/time/StopWatch.hpp"
 #include "valdi/runtime/CSS/CSSDocument.hpp"
 #include "valdi/runtime/Resources/AssetCatalog.hpp"
+#include "valdi/runtime/Resources/SharedBundleStore.hpp"
 #include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
 #include "valdi_core/cpp/Attributes/AttributeUtils.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
@@ -83,6 +84,10 @@ void BundleInitializer::initWithRemoteArchive(bool hasRemoteAssets) {
     _bundle->_hasRemoteAssets = hasRemoteAssets;
 }
 
+void BundleInitializer::setSharedArtifacts(Ref<SharedBundleArtifacts> sharedArtifacts) {
+    _bundle->_sharedArtifacts = std::move(sharedArtifacts);
+}
+
 const Ref<Bundle>& BundleInitializer::getBundle() const {
     return _bundle;
 }
@@ -101,12 +106,12 @@ BundleInitializer Bundle::prepareForInit() {
 }
 
 bool Bundle::hasRemoteArchive() const {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     return _hasRemoteArchive;
 }
 
 bool Bundle::hasRemoteAssets() const {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     return _hasRemoteAssets;
 }
 
@@ -121,10 +126,10 @@ Result<Void> Bundle::lockFreeLoadEntriesIfNeeded() {
 
     _loadedEntries = true;
 
+    // Entries are resolved from the archive when they are first requested, so that
+    // the entries of seekable archives are only decompressed if they are used.
     for (const auto& entryPath : _decompressedBundle->getAllEntryPaths()) {
         if (_entryByPath.find(entryPath) == _entryByPath.end()) {
-            auto entry = _decompressedBundle->getEntry(entryPath);
-            _entryByPath[entryPath] = BytesView(_decompressedBundle, entry->data, entry->size);
             _allEntryPaths.emplace_back(entryPath);
         }
     }
@@ -132,44 +137,78 @@ Result<Void> Bundle::lockFreeLoadEntriesIfNeeded() {
     return Void();
 }
 
+SharedBundleArtifacts* Bundle::lockFreeGetSharedArtifacts(const StringBox& entryPath) const {
+    // Entries replaced through setEntry() no longer match what the shared artifacts were parsed from
+    if (_sharedArtifacts == nullptr || _sharedArtifacts->getArchive() != _decompressedBundle ||
+        _overriddenEntryPaths.contains(entryPath)) {
+        return nullptr;
+    }
+    return _sharedArtifacts.get();
+}
+
+std::optional<BytesView> Bundle::lockFreeGetEntry(const StringBox& path) {
+    const auto& it = _entryByPath.find(path);
+    if (it != _entryByPath.end()) {
+        return it->second;
+    }
+
+    if (_decompressedBundle == nullptr) {
+        return std::nullopt;
+    }
+
+    auto entry = _decompressedBundle->getEntry(path);
+    if (!entry) {
+        return std::nullopt;
+    }
+
+    auto bytes = BytesView(_decompressedBundle, entry->data, entry->size);
+    _entryByPath[path] = bytes;
+
+    return bytes;
+}
+
 Result<BytesView> Bundle::getEntry(const StringBox& path) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
 
     auto archiveResult = lockFreeLoadEntriesIfNeeded();
     if (!archiveResult) {
         return archiveResult.moveError();
     }
 
-    const auto& it = _entryByPath.find(path);
-    if (it == _entryByPath.end()) {
+    auto entry = lockFreeGetEntry(path);
+    if (!entry) {
         return Error(STRING_FORMAT("No item named '{}' in module '{}', available items are: {}",
                                    path,
                                    _name,
                                    StringBox::join(_allEntryPaths, ", ")));
     }
 
-    return it->second;
+    return entry.value();
 }
 
 bool Bundle::hasEntry(const StringBox& path) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     lockFreeLoadEntriesIfNeeded();
 
-    return _entryByPath.find(path) != _entryByPath.end();
+    return _entryByPath.find(path) != _entryByPath.end() ||
+           (_decompressedBundle != nullptr && _decompressedBundle->containsEntry(path));
 }
 
 void Bundle::setEntry(const StringBox& path, const BytesView& data) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
 
-    const auto& it = _entryByPath.find(path);
-    if (it == _entryByPath.end()) {
+    // Once loaded, paths from the archive are already listed even if their entry was not resolved yet
+    auto isListed = _entryByPath.find(path) != _entryByPath.end() ||
+                    (_loadedEntries && _decompressedBundle != nullptr && _decompressedBundle->containsEntry(path));
+    if (!isListed) {
         _allEntryPaths.emplace_back(path);
     }
     _entryByPath[path] = data;
+    _overriddenEntryPaths.insert(path);
 }
 
 Result<JavaScriptFile> Bundle::getJs(const StringBox& jsPath) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     const auto& it = _jsFilesByPath.find(jsPath);
     if (it != _jsFilesByPath.end()) {
         return it->second;
@@ -191,13 +230,13 @@ Result<JavaScriptFile> Bundle::getJs(const StringBox& jsPath) {
 }
 
 std::vector<StringBox> Bundle::getAllEntryPaths() {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     lockFreeLoadEntriesIfNeeded();
     return _allEntryPaths;
 }
 
 std::vector<StringBox> Bundle::getAllJsPaths() {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     lockFreeLoadEntriesIfNeeded();
 
     std::vector<StringBox> output;
@@ -212,12 +251,12 @@ std::vector<StringBox> Bundle::getAllJsPaths() {
 }
 
 void Bundle::setJs(const StringBox& jsPath, const JavaScriptFile& jsFile) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     _jsFilesByPath[jsPath] = jsFile;
 }
 
 Result<BundleResourceContent> Bundle::getResourceContent(const StringBox& path) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     const auto& it = _resourceContentByPath.find(path);
     if (it != _resourceContentByPath.end()) {
         return it->second;
@@ -233,12 +272,12 @@ Result<BundleResourceContent> Bundle::getResourceContent(const StringBox& path)
 }
 
 void Bundle::setResourceContent(const StringBox& path, const BundleResourceContent& resourceContent) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     _resourceContentByPath[path] = resourceContent;
 }
 
 Result<Ref<CSSDocument>> Bundle::getCSSDocument(const StringBox& path, AttributeIds& attributeIds) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
 
     const auto& it = _cssDocumentByPath.find(path);
     if (it != _cssDocumentByPath.end()) {
@@ -252,6 +291,11 @@ Result<Ref<CSSDocument>> Bundle::getCSSDocument(const StringBox& path, Attribute
 
     auto entry = entryResult.moveValue();
 
+    auto* sharedArtifacts = lockFreeGetSharedArtifacts(path);
+    if (sharedArtifacts != nullptr && sharedArtifacts->canShareCSSDocuments(attributeIds)) {
+        return sharedArtifacts->getCSSDocument(path, entry);
+    }
+
     auto documentResult = CSSDocument::parse(ResourceId(_name, path), entry.data(), entry.size(), attributeIds);
     if (documentResult) {
         _cssDocumentByPath[path] = documentResult.value();
@@ -261,7 +305,7 @@ Result<Ref<CSSDocument>> Bundle::getCSSDocument(const StringBox& path, Attribute
 }
 
 void Bundle::setCSSDocument(const StringBox& path, const Ref<CSSDocument>& cssDocument) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     _cssDocumentByPath[path] = cssDocument;
 }
 
@@ -270,7 +314,7 @@ bool Bundle::hasModuleLoadStrategy() {
 }
 
 Result<Ref<ModuleLoadStrategy>> Bundle::getModuleLoadStrategy() {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     auto resourceContent = getResourceContent(loadStrategyFilePath());
     if (!resourceContent) {
         return resourceContent.moveError();
@@ -281,6 +325,11 @@ Result<Ref<ModuleLoadStrategy>> Bundle::getModuleLoadStrategy() {
         return moduleLoadStragey;
     }
 
+    auto* sharedArtifacts = lockFreeGetSharedArtifacts(loadStrategyFilePath());
+    if (sharedArtifacts != nullptr) {
+        return sharedArtifacts->getModuleLoadStrategy(resourceContent.value().raw);
+    }
+
     auto parsed = ModuleLoadStrategy::parse(resourceContent.value().raw.data(), resourceContent.value().raw.size());
     if (!parsed) {
         return parsed.moveError();
@@ -304,18 +353,21 @@ void removeUnusedItems(FlatMap<StringBox, T>& items) {
 }
 
 void Bundle::unloadUnusedResources() {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     removeUnusedItems(_cssDocumentByPath);
+    if (_sharedArtifacts != nullptr) {
+        _sharedArtifacts->unloadUnusedArtifacts();
+    }
 }
 
 Result<Ref<AssetCatalog>> Bundle::getAssetCatalog(const StringBox& assetCatalogPath) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
 
     return lockFreeGetAssetCatalog(assetCatalogPath);
 }
 
 void Bundle::setAssetCatalog(const StringBox& assetCatalogPath, const Ref<AssetCatalog>& assetCatalog) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     _assetCatalogByPath[assetCatalogPath] = assetCatalog;
 }
 
@@ -325,11 +377,17 @@ Result<Ref<AssetCatalog>> Bundle::lockFreeGetAssetCatalog(const StringBox& asset
         return it->second;
     }
 
-    auto entry = getEntry(assetCatalogPath.append(".assetcatalog"));
+    auto entryPath = assetCatalogPath.append(".assetcatalog");
+    auto entry = getEntry(entryPath);
     if (!entry) {
         return entry.moveError();
     }
 
+    auto* sharedArtifacts = lockFreeGetSharedArtifacts(entryPath);
+    if (sharedArtifacts != nullptr) {
+        return sharedArtifacts->getAssetCatalog(assetCatalogPath, entry.value());
+    }
+
     auto catalogResult = AssetCatalog::parse(entry.value().data(), entry.value().size());
     if (!catalogResult) {
         return catalogResult.moveError();
@@ -357,7 +415,7 @@ const StringBox& Bundle::getName() const {
  */
 Result<StringBox> Bundle::getHash() {
     static auto kHashName = STRING_LITERAL("hash");
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
 
     auto entryResult = getResourceContent(kHashName);
     if (!entryResult) {
@@ -368,24 +426,24 @@ Result<StringBox> Bundle::getHash() {
 }
 
 void Bundle::setLoadedArchiveIfNeeded(const Ref<ValdiModuleArchive>& archive) {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     if (_decompressedBundle == nullptr) {
         _decompressedBundle = archive;
     }
 }
 
 bool Bundle::hasLoadedArchive() const {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     return _decompressedBundle != nullptr;
 }
 
 bool Bundle::hasRemoteArchiveNeedingLoad() const {
-    std::lock_guard<std::recursive_mutex> guard(_mutex);
+    std::lock_guard<RecursiveMutex> guard(_mutex);
     return _hasRemoteArchive && _decompressedBundle == nullptr;
 }
 
-std::unique_lock<std::recursive_mutex> Bundle::lock() const {
-    return std::unique_lock<std::recursive_mutex>(_mutex);
+std::unique_lock<RecursiveMutex> Bundle::lock() const {
+    return std::unique_lock<RecursiveMutex>(_mutex);
 }
 
 JavaScriptFile::JavaScriptFile() = default;
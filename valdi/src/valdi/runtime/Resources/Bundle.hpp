@@ -15,6 +15,7 @@
 
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
@@ -57,6 +58,7 @@ private:
 class ValdiModuleArchive;
 class ValdiModuleArchiveLoader;
 class AttributeIds;
+class SharedBundleArtifacts;
 
 class Bundle;
 
@@ -68,11 +70,17 @@ public:
     void initWithLocalArchive(Ref<ValdiModuleArchive> decompressedBundle, bool hasRemoteAssets);
     void initWithRemoteArchive(bool hasRemoteAssets);
 
+    /**
+     Set the artifacts shared with the other runtimes which loaded the same module. The bundle
+     uses them for the entries of its local archive which were not replaced by a hot reload.
+     */
+    void setSharedArtifacts(Ref<SharedBundleArtifacts> sharedArtifacts);
+
     const Ref<Bundle>& getBundle() const;
 
 private:
     Ref<Bundle> _bundle;
-    std::lock_guard<std::recursive_mutex> _lock;
+    std::lock_guard<RecursiveMutex> _lock;
 };
 
 struct BundleResourceContent {
@@ -134,7 +142,7 @@ public:
     void setLoadedArchiveIfNeeded(const Ref<ValdiModuleArchive>& archive);
     bool hasLoadedArchive() const;
 
-    std::unique_lock<std::recursive_mutex> lock() const;
+    std::unique_lock<RecursiveMutex> lock() const;
 
     bool initialized() const {
         return _initialized.load(std::memory_order_relaxed);
@@ -146,13 +154,14 @@ private:
     StringBox _name;
 
     Ref<ValdiModuleArchive> _decompressedBundle;
+    Ref<SharedBundleArtifacts> _sharedArtifacts;
     bool _hasRemoteAssets = false;
     bool _hasRemoteArchive = false;
     bool _loadedEntries = false;
     std::atomic<bool> _initialized = false;
 
     [[maybe_unused]] ILogger& _logger;
-    mutable std::recursive_mutex _mutex;
+    mutable RecursiveMutex _mutex{"Bundle"};
 
     FlatMap<StringBox, JavaScriptFile> _jsFilesByPath;
     FlatMap<StringBox, Ref<CSSDocument>> _cssDocumentByPath;
@@ -160,8 +169,11 @@ private:
     FlatMap<StringBox, BundleResourceContent> _resourceContentByPath;
     FlatMap<StringBox, BytesView> _entryByPath;
     std::vector<StringBox> _allEntryPaths;
+    FlatSet<StringBox> _overriddenEntryPaths;
 
     Result<Void> lockFreeLoadEntriesIfNeeded();
+    std::optional<BytesView> lockFreeGetEntry(const StringBox& path);
+    SharedBundleArtifacts* lockFreeGetSharedArtifacts(const StringBox& entryPath) const;
 
     Result<Ref<AssetCatalog>> lockFreeGetAssetCatalog(const StringBox& assetCatalogPath);
 };
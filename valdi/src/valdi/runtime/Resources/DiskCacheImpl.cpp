@@ -43,7 +43,8 @@ Result<BytesView> DiskCacheImpl::load(const Path& path) {
         return resolvedPath.moveError();
     }
 
-    return DiskUtils::load(resolvedPath.value());
+    // Large items are mapped instead of copied in the heap
+    return DiskUtils::loadMappedIfLarge(resolvedPath.value(), FileAccessPattern::Normal);
 }
 
 Result<BytesView> DiskCacheImpl::loadForAbsoluteURL(const StringBox& url) {
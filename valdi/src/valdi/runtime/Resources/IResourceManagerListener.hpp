@@ -18,6 +18,12 @@ public:
     virtual ~IResourceManagerListener() = default;
 
     virtual void bundleIsBeingUnloaded(const Shared<Bundle>& bundle) = 0;
+
+    /**
+     Called from a worker thread when the archive of a remote bundle finished loading
+     and its sources became available.
+     */
+    virtual void bundleRemoteArchiveDidLoad(const Ref<Bundle>& /*bundle*/) {}
 };
 
 } // namespace Valdi
@@ -25,9 +25,18 @@ struct KeyValueStoreManifest {
     KeyValueStoreEntryManifest manifest[0];
 };
 
+struct KeyValueStoreChangeManifest {
+    uint64_t change;
+    uint64_t mutationId;
+    uint64_t expirationDate;
+    uint64_t weight;
+};
+
 constexpr uint64_t kKeyValueStoreVersion = 2;
+constexpr uint64_t kKeyValueStoreChangesVersion = 1;
 
 STRING_CONST(manifestEntryName, "__manifest__")
+STRING_CONST(changesManifestEntryName, "__changes__")
 
 KeyValueStoreEntry::KeyValueStoreEntry() = default;
 KeyValueStoreEntry::KeyValueStoreEntry(uint64_t mutationId,
@@ -46,6 +55,7 @@ void KeyValueStore::store(const StringBox& key, const BytesView& blob, uint64_t
     }
 
     _entries[key] = KeyValueStoreEntry(++_mutationId, expirationDateSeconds, weight, blob);
+    _changes[key] = KeyValueStoreChange::Store;
 }
 
 std::optional<BytesView> KeyValueStore::fetch(const StringBox& key, bool updateSequence) {
@@ -61,6 +71,7 @@ std::optional<BytesView> KeyValueStore::fetch(const StringBox& key, bool updateS
 
     if (updateSequence) {
         it->second.mutationId = ++_mutationId;
+        _changes.try_emplace(key, KeyValueStoreChange::Touch);
     }
 
     return {it->second.data};
@@ -85,11 +96,14 @@ bool KeyValueStore::remove(const StringBox& key) {
     }
 
     _entries.erase(it);
+    _changes[key] = KeyValueStoreChange::Remove;
     return true;
 }
 
 void KeyValueStore::removeAll() {
     _entries.clear();
+    _changes.clear();
+    _requiresSerialize = true;
 }
 
 void KeyValueStore::setMaxWeight(uint64_t maxWeight) {
@@ -151,6 +165,7 @@ void KeyValueStore::evictEntriesIfNeeded(std::vector<std::pair<StringBox, KeyVal
             const auto& it = _entries.find(collectedEntries[j].first);
             if (it != _entries.end()) {
                 _entries.erase(it);
+                _changes[collectedEntries[j].first] = KeyValueStoreChange::Remove;
             }
         }
 
@@ -187,12 +202,79 @@ Result<BytesView> KeyValueStore::serialize() {
     builder.addEntry(ValdiArchiveEntry(manifestEntryName(), manifest.data(), manifest.size()));
 
     for (const auto& it : entries) {
-        builder.addEntry(ValdiArchiveEntry(it.first, it.second.data.data(), it.second.data.size()));
+        builder.addEntry(it.first, it.second.data);
+    }
+
+    clearChanges();
+
+    return builder.build()->toBytesView();
+}
+
+Result<BytesView> KeyValueStore::serializeChanges() {
+    // Apply the expiration and the eviction, which might add changes
+    collectEntries();
+
+    KeyValueStoreManifest header;
+    header.version = kKeyValueStoreChangesVersion;
+    // Each batch of changes gets its own id, which tells whether it is already part of a store it is replayed on
+    header.mutationIdSequence = ++_mutationId;
+
+    ByteBuffer manifest;
+    manifest.append(reinterpret_cast<const Byte*>(&header), reinterpret_cast<const Byte*>(&header) + sizeof(header));
+
+    std::vector<std::pair<StringBox, BytesView>> archiveEntries;
+    archiveEntries.reserve(_changes.size());
+
+    for (const auto& it : _changes) {
+        KeyValueStoreChangeManifest change;
+        change.change = static_cast<uint64_t>(KeyValueStoreChange::Remove);
+        change.mutationId = 0;
+        change.expirationDate = 0;
+        change.weight = 0;
+
+        BytesView data;
+        const auto& entryIt = _entries.find(it.first);
+        if (entryIt != _entries.end()) {
+            auto isTouch = it.second == KeyValueStoreChange::Touch;
+            change.change = static_cast<uint64_t>(isTouch ? KeyValueStoreChange::Touch : KeyValueStoreChange::Store);
+            change.mutationId = entryIt->second.mutationId;
+            change.expirationDate = entryIt->second.expirationDate;
+            change.weight = entryIt->second.weight;
+
+            if (!isTouch) {
+                data = entryIt->second.data;
+            }
+        }
+
+        manifest.append(reinterpret_cast<const Byte*>(&change),
+                        reinterpret_cast<const Byte*>(&change) + sizeof(change));
+        archiveEntries.emplace_back(it.first, std::move(data));
+    }
+
+    ValdiArchiveBuilder builder;
+    builder.addEntry(ValdiArchiveEntry(changesManifestEntryName(), manifest.data(), manifest.size()));
+    for (const auto& archiveEntry : archiveEntries) {
+        builder.addEntry(archiveEntry.first, archiveEntry.second);
     }
 
+    clearChanges();
+
     return builder.build()->toBytesView();
 }
 
+bool KeyValueStore::hasChanges() const {
+    return !_changes.empty() || _requiresSerialize;
+}
+
+bool KeyValueStore::requiresSerialize() const {
+    return _requiresSerialize;
+}
+
+void KeyValueStore::clearChanges() {
+    _changes.clear();
+    _requiresSerialize = false;
+}
+
 bool KeyValueStore::isEntryExpired(const KeyValueStoreEntry& entry) const {
     if (entry.expirationDate == 0) {
         return false;
@@ -201,8 +283,11 @@ bool KeyValueStore::isEntryExpired(const KeyValueStoreEntry& entry) const {
     return currentTimeSeconds() >= entry.expirationDate;
 }
 
-Result<Parser<Byte>> parseManifest(const ValdiArchiveEntry& entry, uint64_t* idSequence) {
-    if (entry.filePath != manifestEntryName()) {
+Result<Parser<Byte>> parseManifest(const ValdiArchiveEntry& entry,
+                                   const StringBox& manifestName,
+                                   uint64_t version,
+                                   uint64_t* idSequence) {
+    if (entry.filePath != manifestName) {
         return Error("First entry in store should be the manifest");
     }
 
@@ -212,7 +297,7 @@ Result<Parser<Byte>> parseManifest(const ValdiArchiveEntry& entry, uint64_t* idS
         return manifestHeaderResult.moveError();
     }
 
-    if (manifestHeaderResult.value()->version != kKeyValueStoreVersion) {
+    if (manifestHeaderResult.value()->version != version) {
         return Error("Incompatible KeyValueStore version");
     }
 
@@ -250,7 +335,7 @@ Result<Void> KeyValueStore::populate(const BytesView& data) {
 
     for (const auto& entry : entries.value()) {
         if (manifestParser.getBegin() == nullptr) {
-            auto manifestResult = parseManifest(entry, &idSequence);
+            auto manifestResult = parseManifest(entry, manifestEntryName(), kKeyValueStoreVersion, &idSequence);
             if (!manifestResult) {
                 return manifestResult.error();
             }
@@ -268,6 +353,69 @@ Result<Void> KeyValueStore::populate(const BytesView& data) {
         }
     }
 
+    _mutationId = idSequence;
+    clearChanges();
+    return Void();
+}
+
+Result<Void> KeyValueStore::populateChanges(const BytesView& data) {
+    auto archive = ValdiArchive(data.begin(), data.end());
+    auto entries = archive.getEntries();
+    if (!entries) {
+        return entries.error();
+    }
+
+    if (entries.value().empty()) {
+        return Error("Changes should start with the manifest");
+    }
+
+    uint64_t idSequence = 0;
+    auto manifestResult =
+        parseManifest(entries.value()[0], changesManifestEntryName(), kKeyValueStoreChangesVersion, &idSequence);
+    if (!manifestResult) {
+        return manifestResult.error();
+    }
+
+    if (idSequence <= _mutationId) {
+        // Those changes were made before the store was last serialized
+        return Void();
+    }
+
+    auto manifestParser = manifestResult.moveValue();
+    for (size_t i = 1; i < entries.value().size(); i++) {
+        const auto& entry = entries.value()[i];
+        auto changeResult = manifestParser.parseStruct<KeyValueStoreChangeManifest>();
+        if (!changeResult) {
+            return changeResult.moveError();
+        }
+        const auto* change = changeResult.value();
+
+        switch (static_cast<KeyValueStoreChange>(change->change)) {
+            case KeyValueStoreChange::Store: {
+                auto storeEntry = KeyValueStoreEntry(change->mutationId,
+                                                     change->expirationDate,
+                                                     change->weight,
+                                                     BytesView(data.getSource(), entry.data, entry.dataLength));
+                if (isEntryExpired(storeEntry)) {
+                    _entries.erase(entry.filePath);
+                } else {
+                    _entries[entry.filePath] = std::move(storeEntry);
+                }
+            } break;
+            case KeyValueStoreChange::Touch: {
+                const auto& it = _entries.find(entry.filePath);
+                if (it != _entries.end()) {
+                    it->second.mutationId = change->mutationId;
+                }
+            } break;
+            case KeyValueStoreChange::Remove:
+                _entries.erase(entry.filePath);
+                break;
+            default:
+                return Error("Invalid KeyValueStore change");
+        }
+    }
+
     _mutationId = idSequence;
     return Void();
 }
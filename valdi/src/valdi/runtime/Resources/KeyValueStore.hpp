@@ -18,6 +18,13 @@ namespace Valdi {
 
 class ByteBuffer;
 
+enum class KeyValueStoreChange : uint64_t {
+    Store = 1,
+    // The entry was accessed, only its mutation id changed
+    Touch = 2,
+    Remove = 3,
+};
+
 struct KeyValueStoreEntry {
     uint64_t mutationId;
     uint64_t expirationDate;
@@ -36,6 +43,25 @@ public:
     Result<BytesView> serialize();
     Result<Void> populate(const BytesView& data);
 
+    /**
+     Serialize the mutations made since the last serialize() or serializeChanges() call. The output
+     is meant to be appended to a log, and replayed in order with populateChanges() on top of the
+     data returned by serialize(). Changes which are older than the store they are replayed on are ignored.
+     */
+    Result<BytesView> serializeChanges();
+    Result<Void> populateChanges(const BytesView& data);
+
+    /**
+     Whether mutations were made since the last serialize() or serializeChanges() call
+     */
+    bool hasChanges() const;
+
+    /**
+     Whether the mutations cannot be expressed as changes, and the store must be serialized
+     as a whole with serialize().
+     */
+    bool requiresSerialize() const;
+
     void store(const StringBox& key, const BytesView& blob, uint64_t ttlSeconds, uint64_t weight);
 
     std::optional<BytesView> fetch(const StringBox& key);
@@ -58,12 +84,15 @@ private:
     uint64_t _mutationId = 0;
     uint64_t _maxWeight;
     FlatMap<StringBox, KeyValueStoreEntry> _entries;
+    FlatMap<StringBox, KeyValueStoreChange> _changes;
+    bool _requiresSerialize = false;
 
     void buildManifest(const std::vector<std::pair<StringBox, KeyValueStoreEntry>>& entries, ByteBuffer& output) const;
     std::vector<std::pair<StringBox, KeyValueStoreEntry>> collectEntries();
     void evictEntriesIfNeeded(std::vector<std::pair<StringBox, KeyValueStoreEntry>>& collectedEntries);
 
     bool isEntryExpired(const KeyValueStoreEntry& entry) const;
+    void clearChanges();
 
     uint64_t currentTimeSeconds() const;
 
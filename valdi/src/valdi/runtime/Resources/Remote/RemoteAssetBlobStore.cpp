@@ -0,0 +1,88 @@
+#include "valdi/runtime/Resources/Remote/RemoteAssetBlobStore.hpp"
+#include "valdi/runtime/Interfaces/IDiskCache.hpp"
+#include "valdi/runtime/Utils/BytesUtils.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+namespace Valdi {
+
+constexpr std::string_view kBlobsDirectory = "asset_blobs";
+constexpr std::string_view kReferencesDirectory = "asset_blobs_refs";
+
+static Path getReferencesPath(const StringBox& owner) {
+    return Path(kReferencesDirectory).appending(owner.toStringView());
+}
+
+RemoteAssetBlobStore::RemoteAssetBlobStore(Ref<IDiskCache> diskCache) : _diskCache(std::move(diskCache)) {}
+
+RemoteAssetBlobStore::~RemoteAssetBlobStore() = default;
+
+Result<Path> RemoteAssetBlobStore::store(const std::string_view& fileExtension, const BytesView& data) {
+    auto blobPath = Path(kBlobsDirectory).appending(BytesUtils::sha256String(data));
+    if (!fileExtension.empty()) {
+        blobPath.appendFileExtension(fileExtension);
+    }
+
+    std::lock_guard<Mutex> guard(_mutex);
+    if (_diskCache->exists(blobPath)) {
+        return blobPath;
+    }
+
+    auto result = _diskCache->store(blobPath, data);
+    if (!result) {
+        return result.moveError();
+    }
+
+    return blobPath;
+}
+
+Result<Void> RemoteAssetBlobStore::setReferences(const StringBox& owner, const std::vector<Path>& blobPaths) {
+    auto references = makeShared<ByteBuffer>();
+    for (const auto& blobPath : blobPaths) {
+        auto blobName = blobPath.getLastComponent();
+        references->append(blobName);
+        references->append('\n');
+    }
+
+    std::lock_guard<Mutex> guard(_mutex);
+    auto result = _diskCache->store(getReferencesPath(owner), references->toBytesView());
+    if (!result) {
+        return result.moveError();
+    }
+
+    lockFreeRemoveUnreferencedBlobs();
+
+    return Void();
+}
+
+void RemoteAssetBlobStore::lockFreeRemoveUnreferencedBlobs() {
+    FlatSet<std::string> referencedBlobs;
+
+    for (const auto& referencesPath : _diskCache->list(_diskCache->getRootPath().appending(kReferencesDirectory))) {
+        auto references = _diskCache->load(referencesPath);
+        if (!references) {
+            // Without the full list of references, removing blobs would not be safe
+            return;
+        }
+
+        auto str = references.value().asStringView();
+        while (!str.empty()) {
+            auto separatorIndex = str.find('\n');
+            auto blobName = str.substr(0, separatorIndex);
+            if (!blobName.empty()) {
+                referencedBlobs.emplace(blobName);
+            }
+
+            str = separatorIndex == std::string_view::npos ? std::string_view() : str.substr(separatorIndex + 1);
+        }
+    }
+
+    for (const auto& blobPath : _diskCache->list(_diskCache->getRootPath().appending(kBlobsDirectory))) {
+        if (referencedBlobs.find(std::string(blobPath.getLastComponent())) == referencedBlobs.end()) {
+            _diskCache->remove(blobPath);
+        }
+    }
+}
+
+} // namespace Valdi
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/PathUtils.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+#include <vector>
+
+namespace Valdi {
+
+class IDiskCache;
+
+/**
+ Content addressed store for the assets of remote modules. Each asset is stored once in
+ the disk cache under the hash of its content, so that assets which are shared between
+ modules, or which did not change between two versions of a module, are not stored again.
+ Each owner, typically the assets package of a module, records the blobs it references.
+ Blobs which are not referenced by any owner anymore are removed when references change.
+ */
+class RemoteAssetBlobStore {
+public:
+    explicit RemoteAssetBlobStore(Ref<IDiskCache> diskCache);
+    ~RemoteAssetBlobStore();
+
+    /**
+     Store the given asset data if it is not already in the store, and return the path
+     of its blob in the disk cache. The file extension is kept in the blob path.
+     */
+    [[nodiscard]] Result<Path> store(const std::string_view& fileExtension, const BytesView& data);
+
+    /**
+     Replace the blobs referenced by the given owner, and remove the blobs which are
+     not referenced anymore by any owner.
+     */
+    [[nodiscard]] Result<Void> setReferences(const StringBox& owner, const std::vector<Path>& blobPaths);
+
+private:
+    Ref<IDiskCache> _diskCache;
+    Mutex _mutex;
+
+    void lockFreeRemoveUnreferencedBlobs();
+};
+
+} // namespace Valdi
@@ -16,11 +16,12 @@
 #include "valdi/runtime/Utils/BytesUtils.hpp"
 #include "valdi/runtime/Utils/HTTPRequestManagerUtils.hpp"
 #include "valdi_core/cpp/Resources/ValdiArchive.hpp"
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/ValdiObject.hpp"
+#include "valdi_core/cpp/Utils/ValueMap.hpp"
 
-#include "utils/encoding/Base64Utils.hpp"
 
 #include "valdi_core/Cancelable.hpp"
 #include "valdi_core/HTTPRequest.hpp"
@@ -36,6 +37,80 @@ namespace Valdi {
 STRING_CONST(urlFilePath, "url")
 STRING_CONST(dataFilePath, "data")
 
+// Concurrent remote loads allowed for each priority, indexed by RemoteDownloaderPriority
+constexpr std::array<size_t, kRemoteDownloaderPrioritiesCount> kMaxConcurrentRemoteLoads = {1, 2, 6};
+// HTTP request priority for each priority, indexed by RemoteDownloaderPriority
+constexpr std::array<int32_t, kRemoteDownloaderPrioritiesCount> kHTTPRequestPriorities = {1, 2, 4};
+// Remote items are downloaded in ranges of this size, so that a failed load only loses the last range
+constexpr size_t kRangeSize = 1024 * 1024;
+constexpr int32_t kHTTPStatusPartialContent = 206;
+constexpr int32_t kHTTPStatusRangeNotSatisfiable = 416;
+
+struct ContentRange {
+    size_t start = 0;
+    size_t end = 0;
+    size_t total = 0;
+};
+
+static std::optional<size_t> parseContentRangeNumber(std::string_view str) {
+    if (str.empty()) {
+        return std::nullopt;
+    }
+
+    size_t number = 0;
+    for (auto c : str) {
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        number = number * 10 + static_cast<size_t>(c - '0');
+    }
+
+    return number;
+}
+
+/**
+ Parse a Content-Range header in the form "bytes <start>-<end>/<total>"
+ */
+static std::optional<ContentRange> parseContentRange(const Value& headers) {
+    const auto* headersMap = headers.getMap();
+    if (headersMap == nullptr) {
+        return std::nullopt;
+    }
+
+    static auto kContentRange = STRING_LITERAL("content-range");
+    for (const auto& it : *headersMap) {
+        if (it.first.lowercased() != kContentRange) {
+            continue;
+        }
+
+        auto value = it.second.toStringBox();
+        auto str = value.toStringView();
+        std::string_view prefix = "bytes ";
+        if (str.substr(0, prefix.size()) != prefix) {
+            return std::nullopt;
+        }
+        str = str.substr(prefix.size());
+
+        auto separatorIndex = str.find('-');
+        auto totalSeparatorIndex = str.find('/');
+        if (separatorIndex == std::string_view::npos || totalSeparatorIndex == std::string_view::npos ||
+            separatorIndex > totalSeparatorIndex) {
+            return std::nullopt;
+        }
+
+        auto start = parseContentRangeNumber(str.substr(0, separatorIndex));
+        auto end = parseContentRangeNumber(str.substr(separatorIndex + 1, totalSeparatorIndex - separatorIndex - 1));
+        auto total = parseContentRangeNumber(str.substr(totalSeparatorIndex + 1));
+        if (!start || !end || !total || start.value() > end.value() || end.value() >= total.value()) {
+            return std::nullopt;
+        }
+
+        return ContentRange{start.value(), end.value(), total.value()};
+    }
+
+    return std::nullopt;
+}
+
 class CachedBundleItem {
 public:
     CachedBundleItem(StringBox url, BytesView data) : _url(std::move(url)), _data(std::move(data)) {}
@@ -206,7 +281,7 @@ void RemoteDownloader::loadBase64Data(const Shared<RemoteDownloaderTask>& task)
 
     auto out = makeShared<Bytes>();
 
-    if (!snap::utils::encoding::base64ToBinary(strView, *out)) {
+    if (!Base64Codec::decode(strView, *out)) {
         loadCompleted(task, Error("Invalid base64"), true);
         return;
     }
@@ -220,6 +295,8 @@ void RemoteDownloader::storeDownloadedItemInDiskCache(const Shared<RemoteDownloa
         return;
     }
 
+    removePartialDataFromDiskCache(task);
+
     VALDI_INFO(_logger,
                "Storing downloaded {} from {} in disk cache at {}",
                task->getItemDescription(),
@@ -261,18 +338,104 @@ void RemoteDownloader::handleSuccessRemoteDownload(const Shared<RemoteDownloader
     loadCompleted(task, transformLoadResult(task, preprocessedPayload.value()), false);
 }
 
+static Path getPartialDataPath(const Shared<RemoteDownloaderTask>& task) {
+    return Path(task->getLocalFilename().append(".partial"));
+}
+
+Ref<ByteBuffer> RemoteDownloader::loadPartialDataFromDiskCache(const Shared<RemoteDownloaderTask>& task) {
+    auto partialData = makeShared<ByteBuffer>();
+    if (_diskCache == nullptr) {
+        return partialData;
+    }
+
+    auto result = _diskCache->load(getPartialDataPath(task));
+    if (!result) {
+        return partialData;
+    }
+
+    auto cachedBundleItem = CachedBundleItem::deserialize(result.value());
+    if (!cachedBundleItem || cachedBundleItem.value().getUrl() != task->getUrl()) {
+        // The partial data is corrupted or belongs to a previous url
+        return partialData;
+    }
+
+    const auto& data = cachedBundleItem.value().getData();
+    VALDI_INFO(_logger,
+               "Resuming load of {} at {} from {} bytes",
+               task->getItemDescription(),
+               task->getUrl(),
+               data.size());
+    partialData->append(data.begin(), data.end());
+
+    return partialData;
+}
+
+void RemoteDownloader::storePartialDataInDiskCache(const Shared<RemoteDownloaderTask>& task,
+                                                   const Ref<ByteBuffer>& partialData) {
+    if (_diskCache == nullptr) {
+        return;
+    }
+
+    CachedBundleItem bundleItem(task->getUrl(), partialData->toBytesView());
+    auto result = _diskCache->store(getPartialDataPath(task), bundleItem.serialize()->toBytesView());
+    if (!result) {
+        VALDI_WARN(_logger,
+                   "Failed to store partially downloaded {} from {}: {}",
+                   task->getItemDescription(),
+                   task->getUrl(),
+                   result.error());
+    }
+}
+
+void RemoteDownloader::removePartialDataFromDiskCache(const Shared<RemoteDownloaderTask>& task) {
+    if (_diskCache != nullptr) {
+        _diskCache->remove(getPartialDataPath(task));
+    }
+}
+
+void RemoteDownloader::remoteLoadFailed(const Shared<RemoteDownloaderTask>& task,
+                                        const Error& error,
+                                        bool keepPartialData) {
+    auto partialData = task->getPartialData();
+    task->setPartialData(nullptr);
+
+    auto weakThis = weak_from_this();
+    _workQueue->async([=]() {
+        auto strongThis = weakThis.lock();
+        if (strongThis == nullptr) {
+            return;
+        }
+
+        if (keepPartialData && partialData != nullptr && !partialData->empty()) {
+            strongThis->storePartialDataInDiskCache(task, partialData);
+        } else {
+            strongThis->removePartialDataFromDiskCache(task);
+        }
+    });
+
+    loadCompleted(task, error, false);
+}
+
 void RemoteDownloader::remoteResponseReceived(const Shared<RemoteDownloaderTask>& task,
                                               Result<snap::valdi_core::HTTPResponse> responseResult) {
     if (!responseResult) {
-        loadCompleted(task, responseResult.error().rethrow("Remote load failed"), false);
+        remoteLoadFailed(task, responseResult.error().rethrow("Remote load failed"), true);
         return;
     }
 
     auto response = responseResult.moveValue();
+    const auto& partialData = task->getPartialData();
+
+    if (response.statusCode == kHTTPStatusRangeNotSatisfiable && !partialData->empty()) {
+        // The partial data does not match the remote item anymore, start over
+        partialData->clear();
+        requestNextRange(task);
+        return;
+    }
 
     if (response.statusCode < 200 || response.statusCode >= 300) {
-        loadCompleted(
-            task, Error(STRING_FORMAT("Remote load failed: Got HTTP status code {}", response.statusCode)), false);
+        remoteLoadFailed(
+            task, Error(STRING_FORMAT("Remote load failed: Got HTTP status code {}", response.statusCode)), true);
         return;
     }
 
@@ -284,16 +447,36 @@ void RemoteDownloader::remoteResponseReceived(const Shared<RemoteDownloaderTask>
     }
 
     if (bodyBytes.empty()) {
-        loadCompleted(task, Error(STRING_LITERAL("Remote load failed: Got empty HTTP body")), false);
+        remoteLoadFailed(task, Error(STRING_LITERAL("Remote load failed: Got empty HTTP body")), true);
         return;
     }
 
+    // When the server does not support range requests, the whole item is returned with a 200
+    if (response.statusCode == kHTTPStatusPartialContent) {
+        auto contentRange = parseContentRange(response.headers);
+        if (!contentRange || contentRange.value().start != partialData->size() ||
+            contentRange.value().end - contentRange.value().start + 1 != bodyBytes.size()) {
+            remoteLoadFailed(task, Error(STRING_LITERAL("Remote load failed: Got invalid Content-Range")), false);
+            return;
+        }
+
+        partialData->append(bodyBytes.begin(), bodyBytes.end());
+        if (partialData->size() < contentRange.value().total) {
+            requestNextRange(task);
+            return;
+        }
+
+        bodyBytes = partialData->toBytesView();
+    }
+
+    task->setPartialData(nullptr);
+
     auto expectedHash = task->getExpectedHash();
     if (!expectedHash.empty()) {
         auto calculatedHash = BytesUtils::sha256(bodyBytes)->toBytesView();
         bool hashMatches = expectedHash == calculatedHash;
         if (!hashMatches) {
-            loadCompleted(
+            remoteLoadFailed(
                 task,
                 Error(STRING_FORMAT("Remote load failed: SHA256 integrity check failed. Expected '{}', got '{}'",
                                     expectedHash.asStringView(),
@@ -314,21 +497,24 @@ void RemoteDownloader::remoteResponseReceived(const Shared<RemoteDownloaderTask>
     });
 }
 
-void RemoteDownloader::loadRemote(const Shared<RemoteDownloaderTask>& task) {
+void RemoteDownloader::requestNextRange(const Shared<RemoteDownloaderTask>& task) {
     auto requestManager = getRequestManager();
 
     if (requestManager == nullptr) {
-        loadCompleted(task, Error(STRING_LITERAL("No RequestManager set in the RemoteDownloader")), false);
+        remoteLoadFailed(task, Error(STRING_LITERAL("No RequestManager set in the RemoteDownloader")), true);
         return;
     }
 
-    int32_t priority = 4;
+    auto priority = kHTTPRequestPriorities[task->getRemoteLoadSlot().value()];
 
     static auto kGetMethod = STRING_LITERAL("GET");
+    static auto kRangeHeader = STRING_LITERAL("Range");
 
-    snap::valdi_core::HTTPRequest request(task->getUrl(), kGetMethod, Value(), {}, priority);
+    auto offset = task->getPartialData()->size();
+    Value headers;
+    headers.setMapValue(kRangeHeader, Value(STRING_FORMAT("bytes={}-{}", offset, offset + kRangeSize - 1)));
 
-    VALDI_INFO(_logger, "Starting load of {} at {}", task->getItemDescription(), task->getUrl());
+    snap::valdi_core::HTTPRequest request(task->getUrl(), kGetMethod, headers, {}, priority);
 
     auto weakThis = weak_from_this();
     requestManager->performRequest(
@@ -342,13 +528,92 @@ void RemoteDownloader::loadRemote(const Shared<RemoteDownloaderTask>& task) {
         }));
 }
 
+void RemoteDownloader::loadRemote(const Shared<RemoteDownloaderTask>& task) {
+    if (getRequestManager() == nullptr) {
+        loadCompleted(task, Error(STRING_LITERAL("No RequestManager set in the RemoteDownloader")), false);
+        return;
+    }
+
+    task->setPartialData(loadPartialDataFromDiskCache(task));
+
+    VALDI_INFO(_logger, "Starting load of {} at {}", task->getItemDescription(), task->getUrl());
+
+    requestNextRange(task);
+}
+
+void RemoteDownloader::scheduleRemoteLoad(const Shared<RemoteDownloaderTask>& task) {
+    std::vector<Shared<RemoteDownloaderTask>> startableTasks;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        _pendingRemoteTasks.emplace_back(task);
+        startableTasks = lockFreePopStartableRemoteTasks();
+    }
+
+    startRemoteLoads(startableTasks);
+}
+
+void RemoteDownloader::releaseRemoteLoadSlot(const Shared<RemoteDownloaderTask>& task) {
+    std::vector<Shared<RemoteDownloaderTask>> startableTasks;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        auto remoteLoadSlot = task->getRemoteLoadSlot();
+        if (!remoteLoadSlot) {
+            return;
+        }
+        task->setRemoteLoadSlot(std::nullopt);
+        _remoteLoadsCount[remoteLoadSlot.value()]--;
+        startableTasks = lockFreePopStartableRemoteTasks();
+    }
+
+    startRemoteLoads(startableTasks);
+}
+
+std::vector<Shared<RemoteDownloaderTask>> RemoteDownloader::lockFreePopStartableRemoteTasks() {
+    std::vector<Shared<RemoteDownloaderTask>> startableTasks;
+
+    for (size_t i = kRemoteDownloaderPrioritiesCount; i > 0; i--) {
+        auto priority = static_cast<RemoteDownloaderPriority>(i - 1);
+        if (priority == RemoteDownloaderPriorityPrefetch && _remoteLoadsCount[RemoteDownloaderPriorityVisible] > 0) {
+            // Prefetches are speculative, they wait for the network to be idle of visible loads
+            continue;
+        }
+
+        auto it = _pendingRemoteTasks.begin();
+        while (it != _pendingRemoteTasks.end() && _remoteLoadsCount[priority] < kMaxConcurrentRemoteLoads[priority]) {
+            if ((*it)->getPriority() != priority) {
+                it++;
+                continue;
+            }
+
+            _remoteLoadsCount[priority]++;
+            (*it)->setRemoteLoadSlot(priority);
+            startableTasks.emplace_back(std::move(*it));
+            it = _pendingRemoteTasks.erase(it);
+        }
+    }
+
+    return startableTasks;
+}
+
+void RemoteDownloader::startRemoteLoads(const std::vector<Shared<RemoteDownloaderTask>>& tasks) {
+    auto weakThis = weak_from_this();
+    for (const auto& task : tasks) {
+        _workQueue->async([=]() {
+            auto strongThis = weakThis.lock();
+            if (strongThis != nullptr) {
+                strongThis->loadRemote(task);
+            }
+        });
+    }
+}
+
 void RemoteDownloader::doLoad(const Shared<RemoteDownloaderTask>& task) {
     if (task->getUrl().hasPrefix("file://")) {
         loadFileUrl(task);
     } else if (task->getUrl().hasPrefix("data:image/")) {
         loadBase64Data(task);
     } else if (!loadFromDiskCache(task)) {
-        loadRemote(task);
+        scheduleRemoteLoad(task);
     }
 }
 
@@ -365,7 +630,8 @@ void RemoteDownloader::enqueue(const StringBox& localFilename,
                                const StringBox& url,
                                const IRemoteDownloaderItemHandler& itemHandler,
                                const BytesView& expectedHash,
-                               RemoteDownloaderLoadCompletion completion) {
+                               RemoteDownloaderLoadCompletion completion,
+                               RemoteDownloaderPriority priority) {
     std::unique_lock<Mutex> guard(_mutex);
 
     const auto& inMemoryIt = _downloadedItemByUrl.find(url);
@@ -385,12 +651,14 @@ void RemoteDownloader::enqueue(const StringBox& localFilename,
 
     const auto& it = _taskByUrl.find(url);
     if (it == _taskByUrl.end()) {
-        task = Valdi::makeShared<RemoteDownloaderTask>(localFilename, url, expectedHash, itemHandler);
+        task = Valdi::makeShared<RemoteDownloaderTask>(localFilename, url, expectedHash, itemHandler, priority);
         _taskByUrl[url] = task;
 
         shouldStartRequest = true;
     } else {
         task = it->second;
+        // A pending task is upgraded to the highest priority of its requests
+        task->setPriority(std::max(task->getPriority(), priority));
     }
 
     task->appendRequest(RemoteDownloaderRequest(std::move(completion)));
@@ -422,6 +690,8 @@ void RemoteDownloader::loadCompleted(const Shared<RemoteDownloaderTask>& task,
                                      bool fromDiskCache) {
     [[maybe_unused]] auto elapsed = task->getElapsedTime();
 
+    releaseRemoteLoadSlot(task);
+
     if (transformedResult.failure()) {
         VALDI_ERROR(_logger,
                     "Failed to load {} at remote URL {} in {}: {}",
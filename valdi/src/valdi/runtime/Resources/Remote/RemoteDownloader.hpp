@@ -19,8 +19,10 @@
 #include "valdi_core/cpp/Utils/Value.hpp"
 
 #include "valdi_core/cpp/Utils/Function.hpp"
+#include <array>
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace snap::valdi_core {
 class HTTPRequestManager;
@@ -61,6 +63,9 @@ private:
  a limited set of unique file ids which can change over time, as opposed to
  manage an unbounded amount of temporary files identified by their urls. The disk
  cache thus only grows when new modules are added in the app.
+ Remote loads are started by order of priority with a concurrency limit per priority
+ class. They are performed through range requests, and the data downloaded so far is
+ kept in the disk cache when a load fails so that the next load can resume from it.
  */
 class RemoteDownloader : public std::enable_shared_from_this<RemoteDownloader> {
 public:
@@ -74,7 +79,8 @@ public:
                  const StringBox& url,
                  const IRemoteDownloaderItemHandler& itemHandler,
                  const BytesView& expectedHash,
-                 RemoteDownloaderLoadCompletion completion);
+                 RemoteDownloaderLoadCompletion completion,
+                 RemoteDownloaderPriority priority = RemoteDownloaderPriorityVisible);
 
     std::shared_ptr<snap::valdi_core::HTTPRequestManager> getRequestManager() const;
 
@@ -89,11 +95,20 @@ private:
 
     FlatMap<StringBox, Shared<RemoteDownloaderTask>> _taskByUrl;
     FlatMap<StringBox, CachedLoadedItem> _downloadedItemByUrl;
+    std::vector<Shared<RemoteDownloaderTask>> _pendingRemoteTasks;
+    std::array<size_t, kRemoteDownloaderPrioritiesCount> _remoteLoadsCount = {};
 
     void doLoad(const Shared<RemoteDownloaderTask>& task);
 
+    void scheduleRemoteLoad(const Shared<RemoteDownloaderTask>& task);
+    void releaseRemoteLoadSlot(const Shared<RemoteDownloaderTask>& task);
+    std::vector<Shared<RemoteDownloaderTask>> lockFreePopStartableRemoteTasks();
+    void startRemoteLoads(const std::vector<Shared<RemoteDownloaderTask>>& tasks);
+
     bool loadFromDiskCache(const Shared<RemoteDownloaderTask>& task);
     void loadRemote(const Shared<RemoteDownloaderTask>& task);
+    void requestNextRange(const Shared<RemoteDownloaderTask>& task);
+    void remoteLoadFailed(const Shared<RemoteDownloaderTask>& task, const Error& error, bool keepPartialData);
     void loadFileUrl(const Shared<RemoteDownloaderTask>& task);
     void loadBase64Data(const Shared<RemoteDownloaderTask>& task);
 
@@ -107,6 +122,10 @@ private:
     void storeDownloadedItemInDiskCache(const Shared<RemoteDownloaderTask>& task, const BytesView& data);
     BytesView loadDownloadedItemFromDiskCache(const Shared<RemoteDownloaderTask>& task);
 
+    Ref<ByteBuffer> loadPartialDataFromDiskCache(const Shared<RemoteDownloaderTask>& task);
+    void storePartialDataInDiskCache(const Shared<RemoteDownloaderTask>& task, const Ref<ByteBuffer>& partialData);
+    void removePartialDataFromDiskCache(const Shared<RemoteDownloaderTask>& task);
+
     Shared<RemoteDownloaderTask> removeTask(const StringBox& url, const Result<Value>& taskResult);
 
     static Result<Value> transformLoadResult(const Shared<RemoteDownloaderTask>& task, const BytesView& result);
@@ -20,6 +20,19 @@ enum RemoteDownloaderLoadSource {
     RemoteDownloaderLoadSourceNetwork
 };
 
+/**
+ The priority class of a download. Remote loads are started in order of priority,
+ and each class has its own limit of concurrent remote loads so that background
+ downloads cannot starve the downloads which are needed to render.
+ */
+enum RemoteDownloaderPriority {
+    RemoteDownloaderPriorityBackground,
+    RemoteDownloaderPriorityPrefetch,
+    RemoteDownloaderPriorityVisible
+};
+
+constexpr size_t kRemoteDownloaderPrioritiesCount = 3;
+
 using RemoteDownloaderLoadCompletion = Function<void(Result<Value>, RemoteDownloaderLoadSource)>;
 
 class RemoteDownloaderRequest {
@@ -13,11 +13,13 @@ namespace Valdi {
 RemoteDownloaderTask::RemoteDownloaderTask(StringBox localFilename,
                                            StringBox url,
                                            BytesView expectedHash,
-                                           const IRemoteDownloaderItemHandler& itemHandler)
+                                           const IRemoteDownloaderItemHandler& itemHandler,
+                                           RemoteDownloaderPriority priority)
     : _localFilename(std::move(localFilename)),
       _url(std::move(url)),
       _expectedHash(std::move(expectedHash)),
-      _itemHandler(itemHandler) {
+      _itemHandler(itemHandler),
+      _priority(priority) {
     _sw.start();
 }
 
@@ -61,4 +63,28 @@ const IRemoteDownloaderItemHandler& RemoteDownloaderTask::getItemHandler() const
     return _itemHandler;
 }
 
+RemoteDownloaderPriority RemoteDownloaderTask::getPriority() const {
+    return _priority;
+}
+
+void RemoteDownloaderTask::setPriority(RemoteDownloaderPriority priority) {
+    _priority = priority;
+}
+
+const std::optional<RemoteDownloaderPriority>& RemoteDownloaderTask::getRemoteLoadSlot() const {
+    return _remoteLoadSlot;
+}
+
+void RemoteDownloaderTask::setRemoteLoadSlot(std::optional<RemoteDownloaderPriority> remoteLoadSlot) {
+    _remoteLoadSlot = remoteLoadSlot;
+}
+
+const Ref<ByteBuffer>& RemoteDownloaderTask::getPartialData() const {
+    return _partialData;
+}
+
+void RemoteDownloaderTask::setPartialData(const Ref<ByteBuffer>& partialData) {
+    _partialData = partialData;
+}
+
 } // namespace Valdi
@@ -8,11 +8,13 @@
 #pragma once
 
 #include "valdi/runtime/Resources/Remote/RemoteDownloaderRequest.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 
 #include "utils/time/StopWatch.hpp"
 
+#include <optional>
 #include <vector>
 
 namespace Valdi {
@@ -24,7 +26,8 @@ public:
     RemoteDownloaderTask(StringBox localFilename,
                          StringBox url,
                          BytesView expectedHash,
-                         const IRemoteDownloaderItemHandler& itemHandler);
+                         const IRemoteDownloaderItemHandler& itemHandler,
+                         RemoteDownloaderPriority priority);
 
     // NOTE: All non const methods are NOT thread safe
     void appendRequest(RemoteDownloaderRequest request);
@@ -42,12 +45,30 @@ public:
     snap::utils::time::Duration<std::chrono::steady_clock> getElapsedTime() const;
     const IRemoteDownloaderItemHandler& getItemHandler() const;
 
+    RemoteDownloaderPriority getPriority() const;
+    void setPriority(RemoteDownloaderPriority priority);
+
+    /**
+     The priority class of the remote load slot held by this task, if the remote load was started.
+     */
+    const std::optional<RemoteDownloaderPriority>& getRemoteLoadSlot() const;
+    void setRemoteLoadSlot(std::optional<RemoteDownloaderPriority> remoteLoadSlot);
+
+    /**
+     The data downloaded so far through range requests.
+     */
+    const Ref<ByteBuffer>& getPartialData() const;
+    void setPartialData(const Ref<ByteBuffer>& partialData);
+
 private:
     StringBox _localFilename;
     StringBox _url;
     BytesView _expectedHash;
     const IRemoteDownloaderItemHandler& _itemHandler;
     std::vector<RemoteDownloaderRequest> _requests;
+    RemoteDownloaderPriority _priority;
+    std::optional<RemoteDownloaderPriority> _remoteLoadSlot;
+    Ref<ByteBuffer> _partialData;
     snap::utils::time::StopWatch _sw;
 };
 
@@ -11,6 +11,7 @@
 #include "valdi/runtime/Metrics/Metrics.hpp"
 #include "valdi/runtime/Resources/AssetDensityResolver.hpp"
 #include "valdi/runtime/Resources/Remote/DownloadableModuleManifestWrapper.hpp"
+#include "valdi/runtime/Resources/Remote/RemoteAssetBlobStore.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModuleResources.hpp"
 #include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
 #include "valdi/runtime/Utils/AsyncGroup.hpp"
@@ -50,7 +51,7 @@ Result<Value> ModuleBundleResultTransformer::transform(const StringBox& /*localF
     if (_decompressionDisabled) {
         decompressedBundleResult = ValdiModuleArchive::deserialize(data);
     } else {
-        decompressedBundleResult = ValdiModuleArchive::decompress(data.data(), data.size());
+        decompressedBundleResult = ValdiModuleArchive::decompress(data);
     }
 
     if (!decompressedBundleResult) {
@@ -70,10 +71,17 @@ void ModuleBundleResultTransformer::setDecompressionDisabled(bool decompressionD
 }
 
 // For resources, we decompress the module and save every resource into an individual file on disk.
-// We store a file that acts as the manifest for all the available files stored locally.
+// Files are stored by their content hash, so that resources shared between modules or module versions
+// are stored only once. We store a file that acts as the manifest for all the available files stored locally.
 
 ResourcesBundleResultTransformer::ResourcesBundleResultTransformer(Ref<IDiskCache> diskCache, ILogger& logger)
-    : _diskCache(std::move(diskCache)), _logger(logger) {}
+    : _diskCache(std::move(diskCache)), _logger(logger) {
+    if (_diskCache != nullptr) {
+        _blobStore = std::make_unique<RemoteAssetBlobStore>(_diskCache);
+    }
+}
+
+ResourcesBundleResultTransformer::~ResourcesBundleResultTransformer() = default;
 
 Result<BytesView> ResourcesBundleResultTransformer::preprocess(const StringBox& localFilename,
                                                                const BytesView& remoteData) const {
@@ -83,11 +91,17 @@ Result<BytesView> ResourcesBundleResultTransformer::preprocess(const StringBox&
 
     _diskCache->remove(Path(localFilename));
 
+    // Resources used to be stored in a directory per module
+    Path legacyCacheDirectoryPath(localFilename.toStringView());
+    legacyCacheDirectoryPath.removeFileExtension();
+    legacyCacheDirectoryPath.appendFileExtension("dir");
+    _diskCache->remove(legacyCacheDirectoryPath);
+
     Result<ValdiModuleArchive> decompressedBundleResult;
     if (_decompressionDisabled) {
         decompressedBundleResult = ValdiModuleArchive::deserialize(remoteData);
     } else {
-        decompressedBundleResult = ValdiModuleArchive::decompress(remoteData.data(), remoteData.size());
+        decompressedBundleResult = ValdiModuleArchive::decompress(remoteData);
     }
 
     if (!decompressedBundleResult) {
@@ -97,10 +111,7 @@ Result<BytesView> ResourcesBundleResultTransformer::preprocess(const StringBox&
     auto decompressedBundle = Valdi::makeShared<ValdiModuleArchive>(decompressedBundleResult.moveValue());
 
     ValdiArchiveBuilder manifestBuilder;
-
-    Path cacheDirectoryPath(localFilename.toStringView());
-    cacheDirectoryPath.removeFileExtension();
-    cacheDirectoryPath.appendFileExtension("dir");
+    std::vector<Path> blobPaths;
 
     for (const auto& path : decompressedBundle->getAllEntryPaths()) {
         auto entry = decompressedBundle->getEntry(path);
@@ -108,15 +119,20 @@ Result<BytesView> ResourcesBundleResultTransformer::preprocess(const StringBox&
 
         auto bytesView = BytesView(decompressedBundle, entry->data, entry->size);
 
-        auto cachePath = cacheDirectoryPath.appending(path.toStringView());
-
-        auto storeSuccess = _diskCache->store(cachePath, bytesView);
-        if (!storeSuccess) {
-            return storeSuccess.error().rethrow(
-                STRING_FORMAT("Failed to store resource item '{}' in disk cache", path));
+        auto cachePath = _blobStore->store(Path(path.toStringView()).getFileExtension(), bytesView);
+        if (!cachePath) {
+            return cachePath.error().rethrow(STRING_FORMAT("Failed to store resource item '{}' in disk cache", path));
         }
 
-        manifestBuilder.addEntry(ValdiArchiveEntry(path, cachePath.toStringBox()));
+        manifestBuilder.addEntry(ValdiArchiveEntry(path, cachePath.value().toStringBox()));
+        blobPaths.emplace_back(cachePath.moveValue());
+    }
+
+    // Resources of the previous version of the module which are not used anymore are removed
+    auto referencesResult = _blobStore->setReferences(localFilename, blobPaths);
+    if (!referencesResult) {
+        return referencesResult.error().rethrow(
+            STRING_FORMAT("Failed to store the resource references of '{}' in disk cache", localFilename));
     }
 
     auto moduleBytes = manifestBuilder.build();
@@ -312,7 +328,8 @@ void RemoteModuleManager::handleResourcesLoadCompleted(
 }
 
 void RemoteModuleManager::loadResources(const StringBox& moduleName,
-                                        Function<void(Result<Ref<RemoteModuleResources>>)> completion) {
+                                        Function<void(Result<Ref<RemoteModuleResources>>)> completion,
+                                        RemoteDownloaderPriority priority) {
     auto manifest = getRegisteredManifest(moduleName);
     if (manifest == nullptr) {
         completion(Error(STRING_FORMAT("Module '{}' doesnt have a downloadable manifest registered", moduleName)));
@@ -345,7 +362,8 @@ void RemoteModuleManager::loadResources(const StringBox& moduleName,
             if (strongThis != nullptr) {
                 strongThis->handleResourcesLoadCompleted(moduleName, result, loadSource, completion);
             }
-        });
+        },
+        priority);
 }
 
 void RemoteModuleManager::handleModuleLoadCompleted(const Result<Value>& result,
@@ -361,7 +379,8 @@ void RemoteModuleManager::handleModuleLoadCompleted(const Result<Value>& result,
 }
 
 void RemoteModuleManager::loadModule(const StringBox& moduleName,
-                                     Function<void(Result<Ref<ValdiModuleArchive>>)> completion) {
+                                     Function<void(Result<Ref<ValdiModuleArchive>>)> completion,
+                                     RemoteDownloaderPriority priority) {
     auto manifest = getRegisteredManifest(moduleName);
     if (manifest == nullptr) {
         completion(Error(STRING_FORMAT("Module '{}' doesnt have a downloadable manifest registered", moduleName)));
@@ -383,7 +402,8 @@ void RemoteModuleManager::loadModule(const StringBox& moduleName,
                              if (strongThis != nullptr) {
                                  strongThis->handleModuleLoadCompleted(result, completion);
                              }
-                         });
+                         },
+                         priority);
 }
 
 void RemoteModuleManager::setDecompressionDisabled(bool decompressionDisabled) {
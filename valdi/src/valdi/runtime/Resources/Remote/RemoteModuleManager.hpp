@@ -16,6 +16,7 @@
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <vector>
@@ -35,6 +36,7 @@ struct ValdiArchiveEntry;
 class IDiskCache;
 class DownloadableModuleManifestWrapper;
 class Metrics;
+class RemoteAssetBlobStore;
 
 class ModuleBundleResultTransformer : public IRemoteDownloaderItemHandler {
 public:
@@ -51,6 +53,7 @@ private:
 class ResourcesBundleResultTransformer : public IRemoteDownloaderItemHandler {
 public:
     ResourcesBundleResultTransformer(Ref<IDiskCache> diskCache, ILogger& logger);
+    ~ResourcesBundleResultTransformer() override;
 
     Result<BytesView> preprocess(const StringBox& localFilename, const BytesView& remoteData) const override;
 
@@ -64,6 +67,7 @@ public:
 
 private:
     Ref<IDiskCache> _diskCache;
+    std::unique_ptr<RemoteAssetBlobStore> _blobStore;
     [[maybe_unused]] ILogger& _logger;
     bool _decompressionDisabled = false;
 
@@ -88,8 +92,12 @@ public:
     void registerManifest(const StringBox& moduleName, const Ref<DownloadableModuleManifestWrapper>& moduleManifest);
     Ref<DownloadableModuleManifestWrapper> getRegisteredManifest(const StringBox& moduleName) const;
 
-    void loadModule(const StringBox& moduleName, Function<void(Result<Ref<ValdiModuleArchive>>)> completion);
-    void loadResources(const StringBox& moduleName, Function<void(Result<Ref<RemoteModuleResources>>)> completion);
+    void loadModule(const StringBox& moduleName,
+                    Function<void(Result<Ref<ValdiModuleArchive>>)> completion,
+                    RemoteDownloaderPriority priority = RemoteDownloaderPriorityVisible);
+    void loadResources(const StringBox& moduleName,
+                       Function<void(Result<Ref<RemoteModuleResources>>)> completion,
+                       RemoteDownloaderPriority priority = RemoteDownloaderPriorityVisible);
 
     void setMetrics(const Ref<Metrics>& metrics);
 
@@ -0,0 +1,231 @@
+#include "valdi/runtime/Resources/Remote/RemoteModulePrefetchPlanner.hpp"
+#include "valdi/runtime/Interfaces/IDiskCache.hpp"
+#include "valdi_core/cpp/Context/ComponentPath.hpp"
+#include "valdi_core/cpp/Interfaces/ILogger.hpp"
+#include "valdi_core/cpp/Resources/ValdiArchive.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Valdi {
+
+STRING_CONST(entryComponentPath, "__entry__")
+
+// Size of the persisted model, the transitions of the least recently opened components are evicted past it
+constexpr uint64_t kMaxModelWeight = 64 * 1024;
+// Next components kept per component, the least frequent ones are dropped past it
+constexpr size_t kMaxTransitionsPerComponent = 8;
+// Once a count reaches this value, all the counts of the component are halved so that the model
+// can adapt when the way the app is used changes
+constexpr uint32_t kMaxTransitionCount = 256;
+// A transition needs to have been observed at least this many times to be predicted
+constexpr uint32_t kMinPredictedTransitionCount = 2;
+// A transition needs to represent at least this percent of the transitions of a component to be predicted
+constexpr uint32_t kMinPredictedTransitionPercent = 25;
+
+struct ComponentTransition {
+    StringBox componentPath;
+    uint32_t count;
+};
+
+constexpr std::string_view kModelPath = "prefetch_planner/transitions";
+
+static Path getModelPath() {
+    return Path(kModelPath);
+}
+
+static std::vector<ComponentTransition> parseTransitions(const BytesView& data) {
+    std::vector<ComponentTransition> transitions;
+
+    auto archive = ValdiArchive(data.begin(), data.end());
+    auto entries = archive.getEntries();
+    if (!entries) {
+        return transitions;
+    }
+
+    for (const auto& entry : entries.value()) {
+        if (entry.dataLength != sizeof(uint32_t)) {
+            continue;
+        }
+
+        uint32_t count = 0;
+        std::memcpy(&count, entry.data, sizeof(uint32_t));
+        transitions.emplace_back(ComponentTransition{entry.filePath, count});
+    }
+
+    return transitions;
+}
+
+static BytesView serializeTransitions(const std::vector<ComponentTransition>& transitions) {
+    ValdiArchiveBuilder builder;
+
+    for (const auto& transition : transitions) {
+        builder.addEntry(ValdiArchiveEntry(transition.componentPath,
+                                           reinterpret_cast<const Byte*>(&transition.count),
+                                           sizeof(transition.count)));
+    }
+
+    return builder.build()->toBytesView();
+}
+
+RemoteModulePrefetchPlanner::RemoteModulePrefetchPlanner(const Ref<IDiskCache>& diskCache,
+                                                         const Ref<DispatchQueue>& dispatchQueue,
+                                                         ILogger& logger)
+    : _diskCache(diskCache), _dispatchQueue(dispatchQueue), _logger(logger) {
+    _store.setMaxWeight(kMaxModelWeight);
+}
+
+RemoteModulePrefetchPlanner::~RemoteModulePrefetchPlanner() = default;
+
+std::vector<StringBox> RemoteModulePrefetchPlanner::onComponentOpened(const ComponentPath& componentPath) {
+    auto componentPathString = StringCache::getGlobal().makeString(componentPath.toString());
+
+    std::lock_guard<Mutex> guard(_mutex);
+    lockFreePopulateIfNeeded();
+
+    auto previousComponentPath = _previousComponentPath.isEmpty() ? entryComponentPath() : _previousComponentPath;
+    _previousComponentPath = componentPathString;
+
+    if (previousComponentPath != componentPathString) {
+        lockFreeRecordTransition(previousComponentPath, componentPathString);
+    }
+
+    return lockFreePredictNextBundles(componentPathString);
+}
+
+void RemoteModulePrefetchPlanner::lockFreePopulateIfNeeded() {
+    if (_populated) {
+        return;
+    }
+    _populated = true;
+
+    if (_diskCache == nullptr) {
+        return;
+    }
+
+    auto data = _diskCache->load(getModelPath());
+    if (!data) {
+        return;
+    }
+
+    auto result = _store.populate(data.value());
+    if (!result) {
+        VALDI_WARN(_logger, "Failed to populate the remote module prefetch model: {}", result.error());
+        _store.removeAll();
+    }
+}
+
+void RemoteModulePrefetchPlanner::lockFreeRecordTransition(const StringBox& from, const StringBox& to) {
+    std::vector<ComponentTransition> transitions;
+    auto existingData = _store.fetch(from);
+    if (existingData) {
+        transitions = parseTransitions(existingData.value());
+    }
+
+    auto it = std::find_if(transitions.begin(), transitions.end(), [&](const ComponentTransition& transition) {
+        return transition.componentPath == to;
+    });
+
+    if (it == transitions.end()) {
+        if (transitions.size() >= kMaxTransitionsPerComponent) {
+            // Replace the least frequent transition
+            it = std::min_element(transitions.begin(),
+                                  transitions.end(),
+                                  [](const ComponentTransition& left, const ComponentTransition& right) {
+                                      return left.count < right.count;
+                                  });
+            *it = ComponentTransition{to, 0};
+        } else {
+            it = transitions.insert(transitions.end(), ComponentTransition{to, 0});
+        }
+    }
+
+    it->count++;
+
+    if (it->count >= kMaxTransitionCount) {
+        for (auto& transition : transitions) {
+            transition.count /= 2;
+        }
+    }
+
+    auto data = serializeTransitions(transitions);
+    _store.store(from, data, 0, static_cast<uint64_t>(data.size() + from.length()));
+
+    lockFreeScheduleSave();
+}
+
+std::vector<StringBox> RemoteModulePrefetchPlanner::lockFreePredictNextBundles(const StringBox& componentPath) {
+    std::vector<StringBox> bundleNames;
+
+    auto data = _store.fetch(componentPath);
+    if (!data) {
+        return bundleNames;
+    }
+
+    auto transitions = parseTransitions(data.value());
+
+    uint32_t totalCount = 0;
+    for (const auto& transition : transitions) {
+        totalCount += transition.count;
+    }
+
+    std::sort(transitions.begin(),
+              transitions.end(),
+              [](const ComponentTransition& left, const ComponentTransition& right) { return left.count > right.count; });
+
+    auto currentBundleName = ComponentPath::parse(componentPath).getResourceId().bundleName;
+
+    for (const auto& transition : transitions) {
+        if (transition.count < kMinPredictedTransitionCount ||
+            transition.count * 100 < totalCount * kMinPredictedTransitionPercent) {
+            // Transitions are sorted, the next ones are less likely
+            break;
+        }
+
+        auto bundleName = ComponentPath::parse(transition.componentPath).getResourceId().bundleName;
+        if (bundleName.isEmpty() || bundleName == currentBundleName ||
+            std::find(bundleNames.begin(), bundleNames.end(), bundleName) != bundleNames.end()) {
+            continue;
+        }
+
+        bundleNames.emplace_back(std::move(bundleName));
+    }
+
+    return bundleNames;
+}
+
+void RemoteModulePrefetchPlanner::lockFreeScheduleSave() {
+    if (_diskCache == nullptr || _saveScheduled) {
+        return;
+    }
+    _saveScheduled = true;
+
+    // Saves are coalesced, the model is written once after a burst of opened components
+    _dispatchQueue->async([self = strongSmallRef(this)]() { self->doSave(); });
+}
+
+void RemoteModulePrefetchPlanner::doSave() {
+    BytesView data;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        _saveScheduled = false;
+
+        auto result = _store.serialize();
+        if (!result) {
+            VALDI_WARN(_logger, "Failed to serialize the remote module prefetch model: {}", result.error());
+            return;
+        }
+        data = result.moveValue();
+    }
+
+    auto result = _diskCache->store(getModelPath(), data);
+    if (!result) {
+        VALDI_WARN(_logger, "Failed to store the remote module prefetch model: {}", result.error());
+    }
+}
+
+} // namespace Valdi
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "valdi/runtime/Resources/KeyValueStore.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+#include <vector>
+
+namespace Valdi {
+
+class IDiskCache;
+class DispatchQueue;
+class ILogger;
+class ComponentPath;
+
+/**
+ The RemoteModulePrefetchPlanner learns in which order components are opened, so that
+ the modules of the components which are likely to be opened next can be prefetched
+ ahead of time. For each component path, it counts how many times each other component
+ path was opened right after it. The first component opened in a session is recorded
+ as a transition from a special entry key.
+ The model is kept in a KeyValueStore persisted in the disk cache, with one entry per
+ component path, so that the transitions of components which were not opened in a while
+ are the first to be evicted.
+ */
+class RemoteModulePrefetchPlanner : public SimpleRefCountable {
+public:
+    RemoteModulePrefetchPlanner(const Ref<IDiskCache>& diskCache,
+                                const Ref<DispatchQueue>& dispatchQueue,
+                                ILogger& logger);
+    ~RemoteModulePrefetchPlanner() override;
+
+    /**
+     Record that the given component was opened, and return the names of the bundles
+     of the components which are likely to be opened next.
+     */
+    std::vector<StringBox> onComponentOpened(const ComponentPath& componentPath);
+
+private:
+    Ref<IDiskCache> _diskCache;
+    Ref<DispatchQueue> _dispatchQueue;
+    [[maybe_unused]] ILogger& _logger;
+    KeyValueStore _store;
+    StringBox _previousComponentPath;
+    bool _populated = false;
+    bool _saveScheduled = false;
+    Mutex _mutex;
+
+    void lockFreePopulateIfNeeded();
+    void lockFreeRecordTransition(const StringBox& from, const StringBox& to);
+    std::vector<StringBox> lockFreePredictNextBundles(const StringBox& componentPath);
+    void lockFreeScheduleSave();
+    void doSave();
+};
+
+} // namespace Valdi
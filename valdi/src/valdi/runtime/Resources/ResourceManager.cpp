@@ -10,10 +10,14 @@
 #include "valdi/runtime/Metrics/Metrics.hpp"
 #include "valdi/runtime/Resources/AssetDensityResolver.hpp"
 #include "valdi/runtime/Resources/AssetsManager.hpp"
+#include "valdi/runtime/Resources/IResourceManagerListener.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModuleManager.hpp"
+#include "valdi/runtime/Resources/Remote/RemoteModulePrefetchPlanner.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModulePrefetchTask.hpp"
 #include "valdi/runtime/Resources/Remote/RemoteModuleResources.hpp"
+#include "valdi/runtime/Resources/SharedBundleStore.hpp"
 #include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
+#include "valdi/runtime/Resources/ZStdUtils.hpp"
 #include "valdi_core/cpp/Resources/ValdiArchive.hpp"
 
 #include "valdi_core/cpp/Constants.hpp"
@@ -25,11 +29,14 @@
 #include "valdi/runtime/ValdiRuntimeTweaks.hpp"
 
 #include "valdi/runtime/Utils/BytesUtils.hpp"
+#include "valdi/runtime/Utils/MainThreadManager.hpp"
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 
 #include "utils/time/StopWatch.hpp"
 #include "valdi_core/cpp/Context/ComponentPath.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 
 #include "valdi/runtime/Utils/AsyncGroup.hpp"
@@ -37,6 +44,7 @@
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Parser.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
+#include "valdi_core/cpp/Utils/ValueFunctionWithCallable.hpp"
 #include "valdi_core/cpp/Utils/ValueMap.hpp"
 #include "valdi_core/cpp/Utils/ValueUtils.hpp"
 
@@ -58,6 +66,7 @@ ResourceManager::ResourceManager(const Shared<IResourceLoader>& resourceLoader,
     : _resourceLoader(resourceLoader),
       _diskCache(diskCache),
       _workerQueue(workerQueue),
+      _mainThreadManager(mainThreadManager),
       _deviceDensity(deviceDensity),
       _hotReloaderEnabled(hotReloaderEnabled),
       _logger(logger) {
@@ -65,6 +74,7 @@ ResourceManager::ResourceManager(const Shared<IResourceLoader>& resourceLoader,
         makeShared<RemoteModuleManager>(diskCache, requestManager, _workerQueue, _logger, _deviceDensity);
     _assetsManager = makeShared<AssetsManager>(
         resourceLoader, _remoteModuleManager, assetLoaderManager, workerQueue, mainThreadManager, logger);
+    _prefetchPlanner = makeShared<RemoteModulePrefetchPlanner>(diskCache, _workerQueue, _logger);
 }
 
 ResourceManager::~ResourceManager() = default;
@@ -77,7 +87,38 @@ static StringBox resolveSourceMapFilePath(const StringBox& modulePath) {
     return modulePath.append(".map.json");
 }
 
-Result<Ref<ValdiModuleArchive>> ResourceManager::getArchiveForModule(const StringBox& modulePath) {
+void ResourceManager::loadZStdDictionaryIfNeeded() {
+    std::lock_guard<Mutex> guard(_mutex);
+    if (_didLoadZStdDictionary) {
+        return;
+    }
+    _didLoadZStdDictionary = true;
+
+    // Apps can ship a zstd dictionary shared by all their modules, local and remote ones,
+    // which were then compressed with it.
+    auto dictionaryContent = _resourceLoader->loadModuleContent(STRING_LITERAL("valdi.zstddict"));
+    if (!dictionaryContent) {
+        return;
+    }
+
+    auto result = ZStdDictionary::registerDictionary(dictionaryContent.value());
+    if (!result) {
+        VALDI_ERROR(_logger, "Failed to register zstd dictionary: {}", result.error());
+    }
+}
+
+static Result<Ref<ValdiModuleArchive>> decompressModuleArchive(const BytesView& data) {
+    auto result = ValdiModuleArchive::decompress(data);
+    if (!result) {
+        return result.moveError();
+    }
+    return Valdi::makeShared<ValdiModuleArchive>(result.moveValue());
+}
+
+Result<Ref<ValdiModuleArchive>> ResourceManager::getArchiveForModule(const StringBox& modulePath,
+                                                                     Ref<SharedBundleArtifacts>& sharedArtifacts) {
+    loadZStdDictionaryIfNeeded();
+
     auto bundleFilePath = resolveModuleArchiveFilePath(modulePath);
 
     auto bundleContent = _resourceLoader->loadModuleContent(bundleFilePath);
@@ -93,16 +134,31 @@ Result<Ref<ValdiModuleArchive>> ResourceManager::getArchiveForModule(const Strin
 
     const auto& data = bundleContent.value();
 
-    auto result = ValdiModuleArchive::decompress(data.data(), data.size());
-    if (!result) {
-        return result.moveError();
+    Ref<SharedBundleStore> sharedBundleStore;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        sharedBundleStore = _sharedBundleStore;
     }
-    return Valdi::makeShared<ValdiModuleArchive>(result.moveValue());
+
+    if (sharedBundleStore == nullptr) {
+        return decompressModuleArchive(data);
+    }
+
+    auto artifactsResult =
+        sharedBundleStore->getOrCreate(modulePath, data, [&]() { return decompressModuleArchive(data); });
+    if (!artifactsResult) {
+        return artifactsResult.moveError();
+    }
+
+    sharedArtifacts = artifactsResult.moveValue();
+    return sharedArtifacts->getArchive();
 }
 
 BundleInitializer ResourceManager::registerBundle(const StringBox& bundleName) {
     auto bundle = makeShared<Bundle>(bundleName, _logger);
     _bundleByName[bundleName] = bundle;
+    // Asset keys resolved against a previous instance of the bundle are no longer valid
+    _assetKeyCache.clear();
 
     return bundle->prepareForInit();
 }
@@ -180,7 +236,7 @@ void ResourceManager::insertImageAssetInBundle(const Ref<Bundle>& bundle,
 
 void ResourceManager::insertAssetPackageInBundle(const Ref<Bundle>& bundle, const BytesView& assetPackageData) {
     _workerQueue->async([self = strongSmallRef(this), bundle, assetPackageData]() {
-        auto result = ValdiModuleArchive::decompress(assetPackageData.data(), assetPackageData.size());
+        auto result = ValdiModuleArchive::decompress(assetPackageData);
         if (!result) {
             VALDI_ERROR(self->_logger,
                         "Failed to decompress asset bundle in bundle '{}': {}",
@@ -189,11 +245,12 @@ void ResourceManager::insertAssetPackageInBundle(const Ref<Bundle>& bundle, cons
             return;
         }
 
-        const auto& assetPackage = result.value();
+        // The archive retains the entries that were decompressed from it
+        auto assetPackage = makeShared<ValdiModuleArchive>(result.moveValue());
 
         AssetDensityResolver resolver;
 
-        for (const auto& entryPath : assetPackage.getAllEntryPaths()) {
+        for (const auto& entryPath : assetPackage->getAllEntryPaths()) {
             resolver.appendDensity(Value(entryPath).toDouble());
         }
 
@@ -202,7 +259,7 @@ void ResourceManager::insertAssetPackageInBundle(const Ref<Bundle>& bundle, cons
             return;
         }
 
-        auto assetsEntry = assetPackage.getEntryForIndex(bestIndex.value());
+        auto assetsEntry = assetPackage->getEntryForIndex(bestIndex.value());
 
         ValdiArchive archive(assetsEntry.data, assetsEntry.data + assetsEntry.size);
         auto allFiles = archive.getEntries();
@@ -216,7 +273,7 @@ void ResourceManager::insertAssetPackageInBundle(const Ref<Bundle>& bundle, cons
         }
 
         for (const auto& asset : allFiles.value()) {
-            auto bytes = BytesView(result.value().getDecompressedContent().getSource(), asset.data, asset.dataLength);
+            auto bytes = BytesView(assetPackage, asset.data, asset.dataLength);
             self->doInsertImageAssetInBundle(bundle, asset.filePath, bytes);
         }
     });
@@ -262,6 +319,7 @@ Ref<Bundle> ResourceManager::getBundle(const StringBox& bundleName) {
     }
 
     VALDI_TRACE_META("Valdi.loadBundle", bundleName);
+    ScopedStartupSpan startupSpan(StartupSpanType::BundleLoad, bundleName);
     snap::utils::time::StopWatch sw;
     sw.start();
 
@@ -275,7 +333,8 @@ Ref<Bundle> ResourceManager::getBundle(const StringBox& bundleName) {
     auto assetPackageKey = STRING_LITERAL("res.assetpackage");
     auto hasAssetPackage = false;
 
-    auto archiveResult = getArchiveForModule(bundleName);
+    Ref<SharedBundleArtifacts> sharedArtifacts;
+    auto archiveResult = getArchiveForModule(bundleName, sharedArtifacts);
     if (!archiveResult) {
         if (!_hotReloaderEnabled) {
             VALDI_ERROR(_logger, "Failed to load archive of Module '{}': {}", bundleName, archiveResult.error());
@@ -284,6 +343,7 @@ Ref<Bundle> ResourceManager::getBundle(const StringBox& bundleName) {
     } else {
         hasAssetPackage = inlineAssetsEnabled && archiveResult.value()->containsEntry(assetPackageKey);
         initializeBundle(bundleInitializer, archiveResult.value());
+        bundleInitializer.setSharedArtifacts(std::move(sharedArtifacts));
     }
 
     populateSourceMap(bundleName, *bundleInitializer.getBundle());
@@ -360,6 +420,10 @@ void ResourceManager::populateSourceMap(const StringBox& bundleName, Bundle& bun
 }
 
 void ResourceManager::preloadForComponentPath(const ComponentPath& componentPath) {
+    _workerQueue->async([self = strongSmallRef(this), componentPath = componentPath]() {
+        self->prefetchBundles(self->_prefetchPlanner->onComponentOpened(componentPath));
+    });
+
     auto componentPathString = StringCache::getGlobal().makeString(componentPath.toString());
     {
         std::lock_guard<Mutex> lock(_mutex);
@@ -388,13 +452,87 @@ void ResourceManager::preloadForComponentPath(const ComponentPath& componentPath
             return;
         }
 
-        // Load each modules
-        for (const auto& moduleName : strategy->valdiModules) {
-            self->getBundle(moduleName);
-        }
+        self->preloadBundles(strategy->valdiModules);
     });
 }
 
+void ResourceManager::preloadBundles(const std::vector<StringBox>& bundleNames) {
+    const auto& threadPool = ThreadPool::getShared();
+
+    std::lock_guard<Mutex> lock(_mutex);
+    for (const auto& bundleName : bundleNames) {
+        if (_bundleByName.find(bundleName) != _bundleByName.end()) {
+            continue;
+        }
+
+        threadPool->submit([self = strongSmallRef(this), bundleName]() { self->doPreloadBundle(bundleName); });
+    }
+}
+
+void ResourceManager::prefetchBundles(const std::vector<StringBox>& bundleNames) {
+    for (const auto& bundleName : bundleNames) {
+        {
+            std::lock_guard<Mutex> lock(_mutex);
+            if (!_prefetchedBundles.insert(bundleName).second) {
+                continue;
+            }
+        }
+
+        if (isBundleLoaded(bundleName) || _remoteModuleManager->getRegisteredManifest(bundleName) == nullptr) {
+            continue;
+        }
+
+        // Wait for the main thread to be idle, so that the prefetch does not compete with the component
+        // which was just opened
+        _mainThreadManager.onIdle(makeShared<ValueFunctionWithCallable>(
+            [self = strongSmallRef(this), bundleName](const ValueFunctionCallContext& /*callContext*/) -> Value {
+                self->_workerQueue->async([self, bundleName]() {
+                    VALDI_TRACE_META("Valdi.prefetchBundle", bundleName);
+                    FlatSet<StringBox> processedModules;
+                    self->loadModuleAsyncInner(bundleName,
+                                               processedModules,
+                                               ResourceManagerLoadModuleType::SourcesAndAssets,
+                                               RemoteDownloaderPriorityPrefetch,
+                                               [self, bundleName](const Result<Void>& result) {
+                                                   if (!result) {
+                                                       VALDI_WARN(self->_logger,
+                                                                  "Failed to prefetch bundle '{}': {}",
+                                                                  bundleName,
+                                                                  result.error());
+                                                   }
+                                               });
+                });
+                return Value::undefined();
+            }));
+    }
+}
+
+void ResourceManager::doPreloadBundle(const StringBox& bundleName) {
+    VALDI_TRACE_META("Valdi.preloadBundle", bundleName);
+    static auto kAssetCatalogPath = STRING_LITERAL("res");
+    static auto kAssetCatalogEntryPath = STRING_LITERAL("res.assetcatalog");
+
+    auto bundle = getBundle(bundleName);
+
+    if (bundle->hasModuleLoadStrategy()) {
+        auto moduleLoadStrategy = bundle->getModuleLoadStrategy();
+        if (!moduleLoadStrategy) {
+            VALDI_WARN(_logger,
+                       "Failed to preload module load strategy of bundle '{}': {}",
+                       bundleName,
+                       moduleLoadStrategy.error());
+        }
+    }
+
+    if (bundle->hasEntry(kAssetCatalogEntryPath)) {
+        auto assetCatalog = bundle->getAssetCatalog(kAssetCatalogPath);
+        if (!assetCatalog) {
+            VALDI_WARN(
+                _logger, "Failed to preload asset catalog of bundle '{}': {}", bundleName, assetCatalog.error());
+        }
+    }
+}
+
 void ResourceManager::loadModuleAsync(const StringBox& bundleName,
                                       ResourceManagerLoadModuleType loadType,
                                       Function<void(Result<Void>)> onComplete) {
@@ -407,13 +545,15 @@ void ResourceManager::loadModuleAsync(const Ref<DispatchQueue>& dispatchQueue,
                                       Function<void(Result<Void>)> onComplete) {
     dispatchQueue->async([self = strongSmallRef(this), bundleName, loadType, completion = std::move(onComplete)]() {
         FlatSet<StringBox> processedModules;
-        self->loadModuleAsyncInner(bundleName, processedModules, loadType, completion);
+        self->loadModuleAsyncInner(
+            bundleName, processedModules, loadType, RemoteDownloaderPriorityVisible, completion);
     });
 }
 
 void ResourceManager::loadModuleAsyncInner(const StringBox& bundleName,
                                            FlatSet<StringBox>& processedModules,
                                            ResourceManagerLoadModuleType loadType,
+                                           RemoteDownloaderPriority priority,
                                            Function<void(Result<Void>)> onComplete) {
     if (processedModules.find(bundleName) != processedModules.end()) {
         onComplete(Void());
@@ -440,6 +580,7 @@ void ResourceManager::loadModuleAsyncInner(const StringBox& bundleName,
         loadModuleAsyncInner(StringCache::getGlobal().makeString(dependency),
                              processedModules,
                              loadType,
+                             priority,
                              [=](auto result) { task->leave(result); });
     }
 
@@ -450,17 +591,22 @@ void ResourceManager::loadModuleAsyncInner(const StringBox& bundleName,
 
     if (includeSources) {
         task->enter();
-        _remoteModuleManager->loadModule(bundleName, [=](auto result) {
-            if (result) {
-                bundle->setLoadedArchiveIfNeeded(result.value());
-            }
-            task->leave(result);
-        });
+        _remoteModuleManager->loadModule(
+            bundleName,
+            [=](auto result) {
+                if (result) {
+                    bundle->setLoadedArchiveIfNeeded(result.value());
+                    notifyBundleRemoteArchiveDidLoad(bundle);
+                }
+                task->leave(result);
+            },
+            priority);
     }
 
     if (includeAssets) {
         task->enter();
-        _remoteModuleManager->loadResources(bundleName, [=](auto result) { task->leave(result); });
+        _remoteModuleManager->loadResources(
+            bundleName, [=](auto result) { task->leave(result); }, priority);
     }
 
     task->notify(std::move(onComplete));
@@ -476,10 +622,26 @@ void ResourceManager::removeListener(Valdi::IResourceManagerListener* listener)
     _listeners.erase(std::remove(_listeners.begin(), _listeners.end(), listener), _listeners.end());
 }
 
+void ResourceManager::notifyBundleRemoteArchiveDidLoad(const Ref<Bundle>& bundle) {
+    std::vector<IResourceManagerListener*> listeners;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        listeners = _listeners;
+    }
+
+    for (auto* listener : listeners) {
+        listener->bundleRemoteArchiveDidLoad(bundle);
+    }
+}
+
 const Ref<AssetsManager>& ResourceManager::getAssetsManager() const {
     return _assetsManager;
 }
 
+AssetKeyCache& ResourceManager::getAssetKeyCache() {
+    return _assetKeyCache;
+}
+
 const Ref<IDiskCache>& ResourceManager::getDiskCache() const {
     return _diskCache;
 }
@@ -519,6 +681,8 @@ const Ref<Metrics>& ResourceManager::getMetrics() const {
 
 void ResourceManager::removeUnusedResources() {
     std::lock_guard<Mutex> guard(_mutex);
+    // The cached asset keys retain their bundle, which would otherwise never be seen as unused
+    _assetKeyCache.clear();
 
     auto it = _bundleByName.begin();
     while (it != _bundleByName.end()) {
@@ -566,4 +730,9 @@ void ResourceManager::setInlineAssetsEnabled(bool inlineAssetsEnabled) {
     _inlineAssetsEnabled = inlineAssetsEnabled;
 }
 
+void ResourceManager::setSharedBundleStore(const Ref<SharedBundleStore>& sharedBundleStore) {
+    std::lock_guard<Mutex> guard(_mutex);
+    _sharedBundleStore = sharedBundleStore;
+}
+
 } // namespace Valdi
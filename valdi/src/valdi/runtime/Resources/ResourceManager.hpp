@@ -11,7 +11,9 @@
 #include <mutex>
 #include <string>
 
+#include "valdi/runtime/Resources/AssetKeyCache.hpp"
 #include "valdi/runtime/Resources/Bundle.hpp"
+#include "valdi/runtime/Resources/Remote/RemoteDownloaderRequest.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
@@ -33,6 +35,7 @@ class ResourceManager;
 class ValdiModuleArchive;
 class IResourceManagerListener;
 class RemoteModuleManager;
+class RemoteModulePrefetchPlanner;
 class DispatchQueue;
 class IResourceLoader;
 class IDiskCache;
@@ -43,6 +46,8 @@ class AssetLoaderManager;
 class ValdiRuntimeTweaks;
 class ComponentPath;
 class Metrics;
+class SharedBundleArtifacts;
+class SharedBundleStore;
 
 enum class ResourceManagerLoadModuleType {
     Sources,
@@ -97,14 +102,32 @@ public:
 
     const Ref<AssetsManager>& getAssetsManager() const;
 
+    /**
+     Cache of the AssetKey resolved from asset attribute values, cleared whenever a bundle is
+     registered or unloaded.
+     */
+    AssetKeyCache& getAssetKeyCache();
+
     void setRuntimeTweaks(const Ref<ValdiRuntimeTweaks>& runtimeTweaks);
     Ref<ValdiRuntimeTweaks> getRuntimeTweaks() const;
 
     void setMetrics(const Ref<Metrics>& metrics);
     const Ref<Metrics>& getMetrics() const;
 
+    /**
+     Preload the bundles of the given component path from its module load strategy, and
+     prefetch in idle time the remote bundles of the components which are likely to be
+     opened next according to the RemoteModulePrefetchPlanner.
+     */
     void preloadForComponentPath(const ComponentPath& componentPath);
 
+    /**
+     Read, decompress and initialize the given bundles in parallel on the shared ThreadPool,
+     alongside their asset catalog and module load strategy. Bundles are usable as soon as
+     they are individually ready, getBundle() only waits on the bundle it returns.
+     */
+    void preloadBundles(const std::vector<StringBox>& bundleNames);
+
     bool enableAccessibility() const;
     bool enableDeferredGC() const;
     bool isLazyModulePreloadingEnabled() const;
@@ -115,16 +138,26 @@ public:
 
     void setInlineAssetsEnabled(bool inlineAssetsEnabled);
 
+    /**
+     Share the decompressed archives of the local modules and the artifacts parsed from them with
+     the other ResourceManagers using the given store. Must be set before the first bundle is loaded.
+     */
+    void setSharedBundleStore(const Ref<SharedBundleStore>& sharedBundleStore);
+
 private:
     Shared<IResourceLoader> _resourceLoader;
     Ref<IDiskCache> _diskCache;
     Ref<RemoteModuleManager> _remoteModuleManager;
     Ref<DispatchQueue> _workerQueue;
+    MainThreadManager& _mainThreadManager;
     Ref<AssetsManager> _assetsManager;
+    Ref<RemoteModulePrefetchPlanner> _prefetchPlanner;
     double _deviceDensity;
     Ref<ValdiRuntimeTweaks> _runtimeTweaks;
     Ref<Metrics> _metrics;
+    Ref<SharedBundleStore> _sharedBundleStore;
     bool _didSetupImageAssetOverrideDirectory = false;
+    bool _didLoadZStdDictionary = false;
     bool _enableTSN = true;
     bool _inlineAssetsEnabled = true;
     bool _hotReloaderEnabled;
@@ -133,11 +166,17 @@ private:
     ILogger& _logger;
     FlatMap<StringBox, Ref<Bundle>> _bundleByName;
     FlatSet<StringBox> _seenComponentPaths;
+    FlatSet<StringBox> _prefetchedBundles;
     std::vector<IResourceManagerListener*> _listeners;
     std::shared_ptr<snap::valdi_core::HTTPRequestManager> _requestManager;
+    AssetKeyCache _assetKeyCache;
     mutable Mutex _mutex;
 
-    [[nodiscard]] Result<Ref<ValdiModuleArchive>> getArchiveForModule(const StringBox& modulePath);
+    [[nodiscard]] Result<Ref<ValdiModuleArchive>> getArchiveForModule(const StringBox& modulePath,
+                                                                      Ref<SharedBundleArtifacts>& sharedArtifacts);
+    void loadZStdDictionaryIfNeeded();
+    void doPreloadBundle(const StringBox& bundleName);
+    void prefetchBundles(const std::vector<StringBox>& bundleNames);
     void initializeBundle(BundleInitializer& bundleInitializer, Ref<ValdiModuleArchive> moduleArchive);
 
     BundleInitializer registerBundle(const StringBox& bundleName);
@@ -149,7 +188,9 @@ private:
     void loadModuleAsyncInner(const StringBox& bundleName,
                               FlatSet<StringBox>& processedModules,
                               ResourceManagerLoadModuleType loadType,
+                              RemoteDownloaderPriority priority,
                               Function<void(Result<Void>)> onComplete);
+    void notifyBundleRemoteArchiveDidLoad(const Ref<Bundle>& bundle);
     void doInsertImageAssetInBundle(const Ref<Bundle>& bundle, const StringBox& filePath, const BytesView& imageData);
 
     Path getImageAssetsOverrideDirectory();
@@ -0,0 +1,156 @@
+//
+//  SharedBundleStore.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/runtime/Resources/SharedBundleStore.hpp"
+#include "valdi/runtime/CSS/CSSDocument.hpp"
+#include "valdi/runtime/Resources/AssetCatalog.hpp"
+#include "valdi/runtime/Resources/Bundle.hpp"
+#include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
+#include "valdi_core/cpp/Utils/Trace.hpp"
+
+namespace Valdi {
+
+SharedBundleArtifacts::SharedBundleArtifacts(StringBox bundleName,
+                                             Ref<ValdiModuleArchive> archive,
+                                             AttributeIds& attributeIds)
+    : _bundleName(std::move(bundleName)), _archive(std::move(archive)), _attributeIds(attributeIds) {}
+
+SharedBundleArtifacts::~SharedBundleArtifacts() = default;
+
+const Ref<ValdiModuleArchive>& SharedBundleArtifacts::getArchive() const {
+    return _archive;
+}
+
+bool SharedBundleArtifacts::canShareCSSDocuments(const AttributeIds& attributeIds) const {
+    // CSS documents reference the attribute ids they were parsed with
+    return &_attributeIds == &attributeIds;
+}
+
+Result<Ref<CSSDocument>> SharedBundleArtifacts::getCSSDocument(const StringBox& path, const BytesView& content) {
+    std::lock_guard<Mutex> guard(_mutex);
+    const auto& it = _cssDocumentByPath.find(path);
+    if (it != _cssDocumentByPath.end()) {
+        return it->second;
+    }
+
+    auto documentResult =
+        CSSDocument::parse(ResourceId(_bundleName, path), content.data(), content.size(), _attributeIds);
+    if (documentResult) {
+        _cssDocumentByPath[path] = documentResult.value();
+    }
+
+    return documentResult;
+}
+
+Result<Ref<AssetCatalog>> SharedBundleArtifacts::getAssetCatalog(const StringBox& assetCatalogPath,
+                                                                 const BytesView& content) {
+    std::lock_guard<Mutex> guard(_mutex);
+    const auto& it = _assetCatalogByPath.find(assetCatalogPath);
+    if (it != _assetCatalogByPath.end()) {
+        return it->second;
+    }
+
+    auto catalogResult = AssetCatalog::parse(content.data(), content.size());
+    if (catalogResult) {
+        _assetCatalogByPath[assetCatalogPath] = catalogResult.value();
+    }
+
+    return catalogResult;
+}
+
+Result<Ref<ModuleLoadStrategy>> SharedBundleArtifacts::getModuleLoadStrategy(const BytesView& content) {
+    std::lock_guard<Mutex> guard(_mutex);
+    if (_moduleLoadStrategy != nullptr) {
+        return _moduleLoadStrategy;
+    }
+
+    auto parsed = ModuleLoadStrategy::parse(content.data(), content.size());
+    if (parsed) {
+        _moduleLoadStrategy = parsed.value();
+    }
+
+    return parsed;
+}
+
+void SharedBundleArtifacts::unloadUnusedArtifacts() {
+    std::lock_guard<Mutex> guard(_mutex);
+    auto it = _cssDocumentByPath.begin();
+    while (it != _cssDocumentByPath.end()) {
+        if (it->second.use_count() == 1) {
+            it = _cssDocumentByPath.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+SharedBundleStore::SharedBundleStore(AttributeIds& attributeIds) : _attributeIds(attributeIds) {}
+SharedBundleStore::~SharedBundleStore() = default;
+
+Ref<SharedBundleArtifacts> SharedBundleStore::lockFreeGet(const StringBox& bundleName,
+                                                          size_t contentSize,
+                                                          size_t contentHash) const {
+    const auto& it = _entryByBundleName.find(bundleName);
+    if (it == _entryByBundleName.end() || it->second.contentSize != contentSize ||
+        it->second.contentHash != contentHash) {
+        return nullptr;
+    }
+
+    return strongRef(it->second.artifacts);
+}
+
+Result<Ref<SharedBundleArtifacts>> SharedBundleStore::getOrCreate(
+    const StringBox& bundleName,
+    const BytesView& moduleContent,
+    const Function<Result<Ref<ValdiModuleArchive>>()>& decompress) {
+    auto contentSize = moduleContent.size();
+    auto contentHash = moduleContent.hash();
+
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        auto artifacts = lockFreeGet(bundleName, contentSize, contentHash);
+        if (artifacts != nullptr) {
+            return artifacts;
+        }
+    }
+
+    VALDI_TRACE_META("Valdi.decompressSharedBundle", bundleName);
+
+    // Decompress outside of the lock, runtimes loading the same module at the same time
+    // might both decompress it, in which case the first one to finish is kept.
+    auto archive = decompress();
+    if (!archive) {
+        return archive.moveError();
+    }
+
+    std::lock_guard<Mutex> guard(_mutex);
+    auto existingArtifacts = lockFreeGet(bundleName, contentSize, contentHash);
+    if (existingArtifacts != nullptr) {
+        return existingArtifacts;
+    }
+
+    auto artifacts = makeShared<SharedBundleArtifacts>(bundleName, archive.moveValue(), _attributeIds);
+    auto& entry = _entryByBundleName[bundleName];
+    entry.contentSize = contentSize;
+    entry.contentHash = contentHash;
+    entry.artifacts = artifacts.toWeak();
+
+    return artifacts;
+}
+
+size_t SharedBundleStore::size() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    size_t count = 0;
+    for (const auto& it : _entryByBundleName) {
+        if (!it.second.artifacts.expired()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace Valdi
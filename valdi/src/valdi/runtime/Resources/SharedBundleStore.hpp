@@ -0,0 +1,100 @@
+//
+//  SharedBundleStore.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+namespace Valdi {
+
+class AttributeIds;
+class AssetCatalog;
+class CSSDocument;
+class ModuleLoadStrategy;
+class ValdiModuleArchive;
+
+/**
+ The decompressed archive of a local module alongside the artifacts parsed from its entries,
+ shared between the Bundle instances of the runtimes which loaded the same module content.
+ The artifacts are parsed the first time any of those runtimes requests them, and never change
+ afterwards: hot reloaded resources are set on the Bundle of the runtime, which shadows them.
+ */
+class SharedBundleArtifacts : public SharedPtrRefCountable {
+public:
+    SharedBundleArtifacts(StringBox bundleName, Ref<ValdiModuleArchive> archive, AttributeIds& attributeIds);
+    ~SharedBundleArtifacts() override;
+
+    const Ref<ValdiModuleArchive>& getArchive() const;
+
+    /**
+     Whether CSS documents parsed with the given AttributeIds can be shared through this instance.
+     */
+    bool canShareCSSDocuments(const AttributeIds& attributeIds) const;
+
+    Result<Ref<CSSDocument>> getCSSDocument(const StringBox& path, const BytesView& content);
+    Result<Ref<AssetCatalog>> getAssetCatalog(const StringBox& assetCatalogPath, const BytesView& content);
+    Result<Ref<ModuleLoadStrategy>> getModuleLoadStrategy(const BytesView& content);
+
+    /**
+     Release the parsed CSS documents which are no longer used by any runtime.
+     */
+    void unloadUnusedArtifacts();
+
+private:
+    StringBox _bundleName;
+    Ref<ValdiModuleArchive> _archive;
+    AttributeIds& _attributeIds;
+    mutable Mutex _mutex;
+
+    FlatMap<StringBox, Ref<CSSDocument>> _cssDocumentByPath;
+    FlatMap<StringBox, Ref<AssetCatalog>> _assetCatalogByPath;
+    Ref<ModuleLoadStrategy> _moduleLoadStrategy;
+};
+
+/**
+ Process wide store of the SharedBundleArtifacts, owned by the RuntimeManager so that the runtimes
+ and their workers decompress and parse each module once. Artifacts are identified by the module
+ name and a fingerprint of the module content as returned by the IResourceLoader, so that runtimes
+ with custom resource loaders returning a different content don't share them. The store only
+ references the artifacts weakly: they are released once no Bundle uses them anymore.
+ */
+class SharedBundleStore : public SimpleRefCountable {
+public:
+    explicit SharedBundleStore(AttributeIds& attributeIds);
+    ~SharedBundleStore() override;
+
+    /**
+     Returns the artifacts of the module with the given content, creating them with
+     the archive returned by decompress if they are not already used by a runtime.
+     */
+    Result<Ref<SharedBundleArtifacts>> getOrCreate(const StringBox& bundleName,
+                                                   const BytesView& moduleContent,
+                                                   const Function<Result<Ref<ValdiModuleArchive>>()>& decompress);
+
+    size_t size() const;
+
+private:
+    struct Entry {
+        size_t contentSize = 0;
+        size_t contentHash = 0;
+        Weak<SharedBundleArtifacts> artifacts;
+    };
+
+    AttributeIds& _attributeIds;
+    mutable Mutex _mutex;
+    FlatMap<StringBox, Entry> _entryByBundleName;
+
+    Ref<SharedBundleArtifacts> lockFreeGet(const StringBox& bundleName, size_t contentSize, size_t contentHash) const;
+};
+
+} // namespace Valdi
@@ -9,6 +9,7 @@
 #include "valdi/runtime/Resources/ZStdUtils.hpp"
 #include "valdi_core/cpp/Resources/ValdiArchive.hpp"
 
+#include "valdi_core/cpp/Utils/InlineContainerAllocator.hpp"
 #include "valdi_core/cpp/Utils/Parser.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
@@ -19,28 +20,109 @@
 
 namespace Valdi {
 
+/**
+ Layout of a seekable archive, all integers are little endian uint32:
+ magic | dictionary id | entries count | index entries | entries data
+ The dictionary id is the ID of the zstd dictionary that the entries were compressed with,
+ or 0 if they were compressed without a dictionary.
+ Each index entry is made of:
+ path length | path, padded to 4 bytes | flags | data offset | stored size | size
+ The data offset is relative to the beginning of the archive. The stored size is the size
+ of the entry in the archive, the size is the size of the entry once decompressed.
+ */
+constexpr uint32_t kSeekableArchiveMagic = 0x0200C633;
+constexpr uint32_t kSeekableEntryFlagCompressed = 1;
+constexpr int kSeekableEntryCompressionLevel = 19;
+
+struct SeekableIndexEntry {
+    uint32_t flags;
+    uint32_t offset;
+    uint32_t storedSize;
+    uint32_t size;
+};
+
+static bool isSeekableArchive(const Byte* data, size_t len) {
+    if (len < sizeof(uint32_t)) {
+        return false;
+    }
+    uint32_t magic;
+    std::memcpy(&magic, data, sizeof(uint32_t));
+    return magic == kSeekableArchiveMagic;
+}
+
+static Error onSeekableArchiveFailure(Error&& error) {
+    return error.rethrow("Invalid seekable Valdi Archive");
+}
+
+static void appendUInt32(ByteBuffer& output, uint32_t value) {
+    output.append(reinterpret_cast<const Byte*>(&value), reinterpret_cast<const Byte*>(&value + 1));
+}
+
+static void appendPaddingUpTo(ByteBuffer& output, size_t alignedSize) {
+    while (output.size() < alignedSize) {
+        output.append(static_cast<Byte>(0));
+    }
+}
+
 ValdiModuleArchive::ValdiModuleArchive() = default;
 
 ValdiModuleArchive::ValdiModuleArchive(BytesView decompressedContent,
                                        FlatMap<StringBox, ValdiModuleArchiveEntry> entries,
+                                       FlatMap<StringBox, CompressedEntry> compressedEntries,
                                        std::vector<StringBox> orderedEntryPaths)
     : _decompressedContent(std::move(decompressedContent)),
       _entries(std::move(entries)),
-      _orderedEntryPaths(std::move(orderedEntryPaths)) {}
+      _compressedEntries(std::move(compressedEntries)),
+      _orderedEntryPaths(std::move(orderedEntryPaths)) {
+    if (!_compressedEntries.empty()) {
+        _decompressedEntries = makeShared<DecompressedEntries>();
+    }
+}
 
 ValdiModuleArchive::~ValdiModuleArchive() = default;
 
 bool ValdiModuleArchive::containsEntry(const Valdi::StringBox& path) const {
-    return _entries.find(path) != _entries.end();
+    return _entries.find(path) != _entries.end() || _compressedEntries.find(path) != _compressedEntries.end();
 }
 
 std::optional<ValdiModuleArchiveEntry> ValdiModuleArchive::getEntry(const Valdi::StringBox& path) const {
     const auto& it = _entries.find(path);
-    if (it == _entries.end()) {
+    if (it != _entries.end()) {
+        return {it->second};
+    }
+
+    const auto& compressedIt = _compressedEntries.find(path);
+    if (compressedIt == _compressedEntries.end()) {
+        return std::nullopt;
+    }
+
+    const auto* decompressed = getDecompressedEntry(path, compressedIt->second);
+    if (decompressed == nullptr) {
         return std::nullopt;
     }
 
-    return {it->second};
+    return {(ValdiModuleArchiveEntry){.data = decompressed->data(), .size = decompressed->size()}};
+}
+
+const ByteBuffer* ValdiModuleArchive::getDecompressedEntry(const StringBox& path,
+                                                           const CompressedEntry& compressedEntry) const {
+    std::lock_guard<Mutex> guard(_decompressedEntries->mutex);
+    const auto& it = _decompressedEntries->buffers.find(path);
+    if (it != _decompressedEntries->buffers.end()) {
+        return it->second.get();
+    }
+
+    auto decompressed =
+        ZStdUtils::decompress(compressedEntry.data, compressedEntry.compressedSize, compressedEntry.size);
+    if (!decompressed) {
+        return nullptr;
+    }
+
+    // Decompressed entries are kept for the lifetime of the archive, as the returned
+    // entries point into them.
+    const auto* buffer = decompressed.value().get();
+    _decompressedEntries->buffers[path] = decompressed.moveValue();
+    return buffer;
 }
 
 const std::vector<StringBox>& ValdiModuleArchive::getAllEntryPaths() const {
@@ -67,19 +149,27 @@ const BytesView& ValdiModuleArchive::getDecompressedContent() const {
 }
 
 Result<ValdiModuleArchive> ValdiModuleArchive::decompress(const Byte* data, size_t len) {
-    if (ZStdUtils::isZstdFile(data, len)) {
-        auto decompressed = ZStdUtils::decompress(data, len);
+    return ValdiModuleArchive::decompress(BytesView(nullptr, data, len));
+}
+
+Result<ValdiModuleArchive> ValdiModuleArchive::decompress(const BytesView& data) {
+    if (ZStdUtils::isZstdFile(data.data(), data.size())) {
+        auto decompressed = ZStdUtils::decompress(data.data(), data.size());
         if (!decompressed) {
             return decompressed.moveError();
         }
 
         return ValdiModuleArchive::deserialize(decompressed.value()->toBytesView());
     } else {
-        return ValdiModuleArchive::deserialize(BytesView(nullptr, data, len));
+        return ValdiModuleArchive::deserialize(data);
     }
 }
 
 Result<ValdiModuleArchive> ValdiModuleArchive::deserialize(BytesView decompressedContent) {
+    if (isSeekableArchive(decompressedContent.data(), decompressedContent.size())) {
+        return deserializeSeekable(std::move(decompressedContent));
+    }
+
     auto module = ValdiArchive(decompressedContent.data(), decompressedContent.data() + decompressedContent.size());
 
     FlatMap<StringBox, ValdiModuleArchiveEntry> entries;
@@ -96,7 +186,155 @@ Result<ValdiModuleArchive> ValdiModuleArchive::deserialize(BytesView decompresse
         orderedEntryPaths.emplace_back(moduleEntry.filePath);
     }
 
-    return ValdiModuleArchive(std::move(decompressedContent), std::move(entries), std::move(orderedEntryPaths));
+    return ValdiModuleArchive(
+        std::move(decompressedContent), std::move(entries), {}, std::move(orderedEntryPaths));
+}
+
+Result<ValdiModuleArchive> ValdiModuleArchive::deserializeSeekable(BytesView content) {
+    auto parser = Parser(content.begin(), content.end());
+
+    // Skip the magic, which was already checked
+    auto magic = parser.parse<Void>(sizeof(uint32_t));
+    if (!magic) {
+        return onSeekableArchiveFailure(magic.moveError());
+    }
+
+    auto dictionaryId = parser.parseValue<uint32_t>();
+    if (!dictionaryId) {
+        return onSeekableArchiveFailure(dictionaryId.moveError());
+    }
+
+    // Fail early instead of when an entry is first requested
+    if (dictionaryId.value() != 0 && ZStdDictionary::getRegisteredDictionary(dictionaryId.value()) == nullptr) {
+        return Error(STRING_FORMAT(
+            "Valdi Archive was compressed with zstd dictionary {}, which was not registered", dictionaryId.value()));
+    }
+
+    auto entriesCount = parser.parseValue<uint32_t>();
+    if (!entriesCount) {
+        return onSeekableArchiveFailure(entriesCount.moveError());
+    }
+
+    FlatMap<StringBox, ValdiModuleArchiveEntry> entries;
+    FlatMap<StringBox, CompressedEntry> compressedEntries;
+    std::vector<StringBox> orderedEntryPaths;
+
+    for (uint32_t i = 0; i < entriesCount.value(); i++) {
+        auto pathLength = parser.parseValue<uint32_t>();
+        if (!pathLength) {
+            return onSeekableArchiveFailure(pathLength.moveError());
+        }
+
+        auto pathData = parser.parse<char>(pathLength.value());
+        if (!pathData) {
+            return onSeekableArchiveFailure(pathData.moveError());
+        }
+
+        auto padding = parser.parse<Void>(alignUp(pathLength.value(), sizeof(uint32_t)) - pathLength.value());
+        if (!padding) {
+            return onSeekableArchiveFailure(padding.moveError());
+        }
+
+        auto indexEntry = parser.parseValue<SeekableIndexEntry>();
+        if (!indexEntry) {
+            return onSeekableArchiveFailure(indexEntry.moveError());
+        }
+
+        const auto& index = indexEntry.value();
+        if (static_cast<size_t>(index.offset) + static_cast<size_t>(index.storedSize) > content.size()) {
+            return Error(STRING_FORMAT("Invalid seekable Valdi Archive: entry at offset {} with size {} is out of "
+                                       "bounds of archive with size {}",
+                                       index.offset,
+                                       index.storedSize,
+                                       content.size()));
+        }
+
+        auto path = StringCache::getGlobal().makeString(pathData.value(), pathLength.value());
+        const auto* data = content.data() + index.offset;
+
+        if ((index.flags & kSeekableEntryFlagCompressed) != 0) {
+            if (!ZStdUtils::isZstdFile(data, index.storedSize)) {
+                return Error(STRING_FORMAT("Invalid seekable Valdi Archive: entry '{}' is not a zstd frame", path));
+            }
+            compressedEntries[path] =
+                CompressedEntry{.data = data, .compressedSize = index.storedSize, .size = index.size};
+        } else {
+            if (index.storedSize != index.size) {
+                return Error(
+                    STRING_FORMAT("Invalid seekable Valdi Archive: stored entry '{}' has mismatching sizes", path));
+            }
+            entries[path] = (ValdiModuleArchiveEntry){.data = data, .size = index.size};
+        }
+
+        orderedEntryPaths.emplace_back(std::move(path));
+    }
+
+    return ValdiModuleArchive(
+        std::move(content), std::move(entries), std::move(compressedEntries), std::move(orderedEntryPaths));
+}
+
+Result<Ref<ByteBuffer>> ValdiModuleArchive::serializeSeekable(const std::vector<ValdiArchiveEntry>& entries,
+                                                               bool compress,
+                                                               const ZStdDictionary* dictionary) {
+    std::vector<Ref<ByteBuffer>> compressedData;
+    compressedData.reserve(entries.size());
+
+    auto indexSize = sizeof(uint32_t) * 3;
+    for (const auto& entry : entries) {
+        indexSize += sizeof(uint32_t) + alignUp(entry.filePath.length(), sizeof(uint32_t)) + sizeof(SeekableIndexEntry);
+
+        Ref<ByteBuffer> compressedEntry;
+        if (compress) {
+            auto result = ZStdUtils::compress(entry.data, entry.dataLength, kSeekableEntryCompressionLevel, dictionary);
+            if (!result) {
+                return result.moveError().rethrow(STRING_FORMAT("Failed to compress entry '{}'", entry.filePath));
+            }
+            // Entries which do not compress well, like images, are stored as is
+            if (result.value()->size() < entry.dataLength) {
+                compressedEntry = result.moveValue();
+            }
+        }
+        compressedData.emplace_back(std::move(compressedEntry));
+    }
+
+    auto output = makeShared<ByteBuffer>();
+    appendUInt32(*output, kSeekableArchiveMagic);
+    appendUInt32(*output, dictionary != nullptr ? dictionary->getId() : 0);
+    appendUInt32(*output, static_cast<uint32_t>(entries.size()));
+
+    auto dataOffset = indexSize;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+        const auto& compressedEntry = compressedData[i];
+
+        appendUInt32(*output, static_cast<uint32_t>(entry.filePath.length()));
+        output->append(entry.filePath.getCStr(), entry.filePath.getCStr() + entry.filePath.length());
+        appendPaddingUpTo(*output, alignUp(output->size(), sizeof(uint32_t)));
+
+        auto storedSize = compressedEntry != nullptr ? compressedEntry->size() : entry.dataLength;
+        SeekableIndexEntry indexEntry;
+        indexEntry.flags = compressedEntry != nullptr ? kSeekableEntryFlagCompressed : 0;
+        indexEntry.offset = static_cast<uint32_t>(dataOffset);
+        indexEntry.storedSize = static_cast<uint32_t>(storedSize);
+        indexEntry.size = static_cast<uint32_t>(entry.dataLength);
+        output->append(reinterpret_cast<const Byte*>(&indexEntry), reinterpret_cast<const Byte*>(&indexEntry + 1));
+
+        dataOffset = alignUp(dataOffset + storedSize, sizeof(uint32_t));
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+        const auto& compressedEntry = compressedData[i];
+
+        if (compressedEntry != nullptr) {
+            output->append(compressedEntry->begin(), compressedEntry->end());
+        } else {
+            output->append(entry.data, entry.data + entry.dataLength);
+        }
+        appendPaddingUpTo(*output, alignUp(output->size(), sizeof(uint32_t)));
+    }
+
+    return output;
 }
 
 } // namespace Valdi
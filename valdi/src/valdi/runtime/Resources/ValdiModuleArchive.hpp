@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 #include <vector>
@@ -20,6 +22,17 @@ struct ValdiModuleArchiveEntry {
     size_t size;
 };
 
+struct ValdiArchiveEntry;
+class ZStdDictionary;
+
+/**
+ A module archive can either be:
+ - A ValdiArchive, optionally compressed as a whole with zstd. All the entries
+ are available once the archive is decompressed.
+ - A seekable archive, which starts with an index of its entries followed by their data,
+ each entry being compressed independently. It can be used straight from a memory mapped
+ file, an entry is only decompressed the first time it is requested.
+ */
 class ValdiModuleArchive : public SharedPtrRefCountable {
 public:
     ValdiModuleArchive();
@@ -32,22 +45,58 @@ public:
 
     const std::vector<StringBox>& getAllEntryPaths() const;
 
+    /**
+     Returns the decompressed archive, or the archive as it was given for seekable archives,
+     whose entries are decompressed separately.
+     */
     const BytesView& getDecompressedContent() const;
 
     [[nodiscard]] static Result<ValdiModuleArchive> decompress(const Byte* data, size_t len);
+    /**
+     Same as decompress(data, len), but retains the source of the given bytes, which
+     lets seekable archives point directly into them.
+     */
+    [[nodiscard]] static Result<ValdiModuleArchive> decompress(const BytesView& data);
     [[nodiscard]] static Result<ValdiModuleArchive> deserialize(BytesView decompressedContent);
 
+    /**
+     Serialize the given entries as a seekable archive. When compress is set, entries
+     which get smaller when compressed are stored compressed, with the given dictionary
+     if there is one.
+     */
+    [[nodiscard]] static Result<Ref<ByteBuffer>> serializeSeekable(const std::vector<ValdiArchiveEntry>& entries,
+                                                                   bool compress,
+                                                                   const ZStdDictionary* dictionary = nullptr);
+
     bool operator==(const ValdiModuleArchive& other) const;
     bool operator!=(const ValdiModuleArchive& other) const;
 
 private:
+    struct CompressedEntry {
+        const Byte* data;
+        size_t compressedSize;
+        size_t size;
+    };
+
+    struct DecompressedEntries : public SimpleRefCountable {
+        Mutex mutex;
+        FlatMap<StringBox, Ref<ByteBuffer>> buffers;
+    };
+
     BytesView _decompressedContent;
     FlatMap<StringBox, ValdiModuleArchiveEntry> _entries;
+    FlatMap<StringBox, CompressedEntry> _compressedEntries;
+    Ref<DecompressedEntries> _decompressedEntries;
     std::vector<StringBox> _orderedEntryPaths;
 
     ValdiModuleArchive(BytesView decompressedContent,
                        FlatMap<StringBox, ValdiModuleArchiveEntry> entries,
+                       FlatMap<StringBox, CompressedEntry> compressedEntries,
                        std::vector<StringBox> orderedEntryPaths);
+
+    const ByteBuffer* getDecompressedEntry(const StringBox& path, const CompressedEntry& compressedEntry) const;
+
+    [[nodiscard]] static Result<ValdiModuleArchive> deserializeSeekable(BytesView content);
 };
 
 } // namespace Valdi
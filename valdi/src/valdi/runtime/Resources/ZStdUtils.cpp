@@ -10,9 +10,96 @@
 #include "zstd.h"
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <memory>
 
 namespace Valdi {
 
+struct ZStdDictionaryRegistry {
+    Mutex mutex;
+    FlatMap<uint32_t, Ref<ZStdDictionary>> dictionaries;
+};
+
+static ZStdDictionaryRegistry& getDictionaryRegistry() {
+    static auto* kRegistry = new ZStdDictionaryRegistry();
+    return *kRegistry;
+}
+
+ZStdDictionary::ZStdDictionary(uint32_t id, BytesView data, ZSTD_DDict_s* ddict)
+    : _id(id), _data(std::move(data)), _ddict(ddict) {}
+
+ZStdDictionary::~ZStdDictionary() {
+    ZSTD_freeDDict(_ddict);
+    for (const auto& it : _cdictByCompressionLevel) {
+        ZSTD_freeCDict(it.second);
+    }
+}
+
+uint32_t ZStdDictionary::getId() const {
+    return _id;
+}
+
+const ZSTD_DDict_s* ZStdDictionary::getDDict() const {
+    return _ddict;
+}
+
+const ZSTD_CDict_s* ZStdDictionary::getCDict(int compressionLevel) const {
+    std::lock_guard<Mutex> guard(_mutex);
+    const auto& it = _cdictByCompressionLevel.find(compressionLevel);
+    if (it != _cdictByCompressionLevel.end()) {
+        return it->second;
+    }
+
+    auto* cdict = ZSTD_createCDict(_data.data(), _data.size(), compressionLevel);
+    _cdictByCompressionLevel[compressionLevel] = cdict;
+    return cdict;
+}
+
+Result<Ref<ZStdDictionary>> ZStdDictionary::registerDictionary(const BytesView& data) {
+    auto id = ZSTD_getDictID_fromDict(data.data(), data.size());
+    if (id == 0) {
+        return Error("Invalid zstd dictionary: only dictionaries trained by zstd, which have an ID, are supported");
+    }
+
+    auto& registry = getDictionaryRegistry();
+    std::lock_guard<Mutex> guard(registry.mutex);
+    const auto& it = registry.dictionaries.find(id);
+    if (it != registry.dictionaries.end()) {
+        return it->second;
+    }
+
+    auto* ddict = ZSTD_createDDict(data.data(), data.size());
+    if (ddict == nullptr) {
+        return Error(STRING_FORMAT("Could not digest zstd dictionary {}", id));
+    }
+
+    auto dictionary = makeShared<ZStdDictionary>(id, data, ddict);
+    registry.dictionaries[id] = dictionary;
+    return dictionary;
+}
+
+Ref<ZStdDictionary> ZStdDictionary::getRegisteredDictionary(uint32_t id) {
+    auto& registry = getDictionaryRegistry();
+    std::lock_guard<Mutex> guard(registry.mutex);
+    const auto& it = registry.dictionaries.find(id);
+    if (it == registry.dictionaries.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+static Result<Ref<ZStdDictionary>> getDictionaryForFrame(const Byte* input, size_t len) {
+    auto id = ZSTD_getDictID_fromFrame(input, len);
+    if (id == 0) {
+        return Ref<ZStdDictionary>();
+    }
+
+    auto dictionary = ZStdDictionary::getRegisteredDictionary(id);
+    if (dictionary == nullptr) {
+        return Error(STRING_FORMAT("Data was compressed with zstd dictionary {}, which was not registered", id));
+    }
+    return dictionary;
+}
+
 bool ZStdUtils::isZstdFile(const Byte* input, size_t length) {
     if (length < 4) {
         return false;
@@ -42,6 +129,19 @@ Result<Ref<ByteBuffer>> ZStdUtils::decompress(const Byte* input, size_t len) {
         return Error(STRING_FORMAT("Could not initialize stream: {}", ZSTD_getErrorName(initResult)));
     }
 
+    auto dictionary = getDictionaryForFrame(input, len);
+    if (!dictionary) {
+        ZSTD_freeDStream(dstream);
+        return dictionary.moveError();
+    }
+    if (dictionary.value() != nullptr) {
+        auto refResult = ZSTD_DCtx_refDDict(dstream, dictionary.value()->getDDict());
+        if (ZSTD_isError(refResult) != 0) {
+            ZSTD_freeDStream(dstream);
+            return Error(STRING_FORMAT("Could not use zstd dictionary: {}", ZSTD_getErrorName(refResult)));
+        }
+    }
+
     ZSTD_inBuffer inBuffer;
     inBuffer.src = input;
     inBuffer.size = len;
@@ -73,4 +173,66 @@ Result<Ref<ByteBuffer>> ZStdUtils::decompress(const Byte* input, size_t len) {
 
     return output;
 }
+
+Result<Ref<ByteBuffer>> ZStdUtils::decompress(const Byte* input, size_t len, size_t decompressedSize) {
+    auto dictionary = getDictionaryForFrame(input, len);
+    if (!dictionary) {
+        return dictionary.moveError();
+    }
+
+    auto output = makeShared<ByteBuffer>();
+    output->resize(decompressedSize);
+
+    size_t result;
+    if (dictionary.value() != nullptr) {
+        // Contexts are reused across the decompressions happening on the same thread
+        thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> tContext(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+        if (tContext == nullptr) {
+            return Error("Could not create ZSTD context");
+        }
+        result = ZSTD_decompress_usingDDict(
+            tContext.get(), output->data(), output->size(), input, len, dictionary.value()->getDDict());
+    } else {
+        result = ZSTD_decompress(output->data(), output->size(), input, len);
+    }
+    if (ZSTD_isError(result) != 0) {
+        return Error(STRING_FORMAT("Could not decompress frame: {}", ZSTD_getErrorName(result)));
+    }
+    if (result != decompressedSize) {
+        return Error(STRING_FORMAT("Decompressed {} bytes, expected {}", result, decompressedSize));
+    }
+
+    return output;
+}
+
+Result<Ref<ByteBuffer>> ZStdUtils::compress(const Byte* input,
+                                            size_t len,
+                                            int compressionLevel,
+                                            const ZStdDictionary* dictionary) {
+    auto output = makeShared<ByteBuffer>();
+    output->resize(ZSTD_compressBound(len));
+
+    size_t result;
+    if (dictionary != nullptr) {
+        const auto* cdict = dictionary->getCDict(compressionLevel);
+        auto* cctx = ZSTD_createCCtx();
+        if (cdict == nullptr || cctx == nullptr) {
+            ZSTD_freeCCtx(cctx);
+            return Error("Could not create ZSTD context");
+        }
+        result = ZSTD_compress_usingCDict(cctx, output->data(), output->size(), input, len, cdict);
+        ZSTD_freeCCtx(cctx);
+    } else {
+        result = ZSTD_compress(output->data(), output->size(), input, len, compressionLevel);
+    }
+    if (ZSTD_isError(result) != 0) {
+        return Error(STRING_FORMAT("Could not compress data: {}", ZSTD_getErrorName(result)));
+    }
+
+    output->resize(result);
+    output->shrinkToFit();
+
+    return output;
+}
+
 } // namespace Valdi
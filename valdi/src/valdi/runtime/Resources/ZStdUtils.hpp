@@ -9,14 +9,59 @@
 
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include <vector>
 
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace Valdi {
 
+/**
+ A zstd dictionary, trained over content which shares a lot of boilerplate like the
+ files of the modules. Dictionaries are registered once per process and referenced by
+ their ID from the frames compressed with them. The dictionary is digested for
+ decompression once when registered, and for compression the first time it is used
+ with a given compression level.
+ */
+class ZStdDictionary : public SimpleRefCountable {
+public:
+    ZStdDictionary(uint32_t id, BytesView data, ZSTD_DDict_s* ddict);
+    ~ZStdDictionary() override;
+
+    uint32_t getId() const;
+    const ZSTD_DDict_s* getDDict() const;
+    const ZSTD_CDict_s* getCDict(int compressionLevel) const;
+
+    [[nodiscard]] static Result<Ref<ZStdDictionary>> registerDictionary(const BytesView& data);
+    static Ref<ZStdDictionary> getRegisteredDictionary(uint32_t id);
+
+private:
+    uint32_t _id;
+    BytesView _data;
+    ZSTD_DDict_s* _ddict;
+    mutable Mutex _mutex;
+    mutable FlatMap<int, ZSTD_CDict_s*> _cdictByCompressionLevel;
+};
+
 class ZStdUtils {
 public:
+    /**
+     Decompress the given input. Frames which were compressed with a dictionary are decompressed
+     with the registered dictionary that has the same ID, and fail if there is none.
+     */
     [[nodiscard]] static Result<Ref<ByteBuffer>> decompress(const Byte* input, size_t len);
+    /**
+     Decompress a single frame whose decompressed size is known ahead of time,
+     directly into a buffer of that size.
+     */
+    [[nodiscard]] static Result<Ref<ByteBuffer>> decompress(const Byte* input, size_t len, size_t decompressedSize);
+    [[nodiscard]] static Result<Ref<ByteBuffer>> compress(const Byte* input,
+                                                          size_t len,
+                                                          int compressionLevel,
+                                                          const ZStdDictionary* dictionary = nullptr);
     static bool isZstdFile(const Byte* input, size_t length);
 };
 
@@ -10,6 +10,7 @@
 
 #include "valdi/runtime/Attributes/ValueConverters.hpp"
 #include "valdi/runtime/Attributes/Yoga/Yoga.hpp"
+#include "valdi/runtime/Context/DeferredViewNodeTreeTeardown.hpp"
 #include "valdi/runtime/Context/ViewNodeTree.hpp"
 #include "valdi_core/cpp/Constants.hpp"
 
@@ -18,7 +19,10 @@
 #include "valdi/runtime/CSS/CSSDocument.hpp"
 
 #include "valdi/runtime/Rendering/RenderRequest.hpp"
+#include "valdi/runtime/Rendering/RenderRequestTrace.hpp"
 #include "valdi/runtime/Rendering/ViewNodeRenderer.hpp"
+#include "valdi/runtime/Interfaces/IViewTransaction.hpp"
+#include "valdi/runtime/Views/ViewTransactionScope.hpp"
 
 #include "valdi/runtime/Resources/AssetCatalog.hpp"
 
@@ -28,8 +32,10 @@
 #include "valdi/runtime/Context/ViewNodeViewStats.hpp"
 #include "valdi_core/cpp/Context/ComponentPath.hpp"
 
+#include "valdi/runtime/JavaScript/JavaScriptBytecodeCache.hpp"
 #include "valdi/runtime/JavaScript/Modules/FileSystemFactory.hpp"
 #include "valdi/runtime/JavaScript/Modules/JavaScriptModuleFactoryBridge.hpp"
+#include "valdi/runtime/JavaScript/Modules/EncodingModuleFactory.hpp"
 #include "valdi/runtime/JavaScript/Modules/PersistentStoreModuleFactory.hpp"
 #include "valdi/runtime/JavaScript/Modules/ProtobufModuleFactory.hpp"
 #include "valdi/runtime/JavaScript/Modules/TCPSocketModuleFactory.hpp"
@@ -42,8 +48,10 @@
 #include "valdi/runtime/ValdiRuntimeTweaks.hpp"
 #include "valdi_core/cpp/Resources/ResourceId.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 #include "valdi_core/cpp/Utils/ValueArrayBuilder.hpp"
+#include "valdi_core/cpp/Utils/ValueUtils.hpp"
 
 #include "utils/platform/BuildOptions.hpp"
 #include "utils/time/StopWatch.hpp"
@@ -114,6 +122,14 @@ Runtime::Runtime(AttributeIds& attributeIds,
                                                                   jsRuntimeThreadQoS,
                                                                   anrDetector,
                                                                   logger);
+
+        if (diskCache != nullptr) {
+            // Bytecode is only compatible with the engine which produced it
+            auto bytecodeCachePath =
+                Path(std::string_view("js_bytecode")).appending(std::string_view(jsBridge->getName()));
+            _javaScriptRuntime->setBytecodeCache(makeShared<JavaScriptBytecodeCache>(
+                diskCache->scopedCache(bytecodeCachePath, false), _workerQueue, *logger));
+        }
     }
 
     // Uncomment to print the internal Valdi object sizes
@@ -161,6 +177,7 @@ void Runtime::postInit() {
 
         registerJavaScriptModuleFactory(makeShared<ProtobufModuleFactory>(*_resourceManager, _workerQueue, *_logger));
         registerJavaScriptModuleFactory(makeShared<UnicodeModuleFactory>());
+        registerJavaScriptModuleFactory(makeShared<EncodingModuleFactory>());
 
         if constexpr (kTCPSocketEnabled) {
             registerNativeModuleFactory(makeShared<TCPSocketModuleFactory>().toShared());
@@ -210,6 +227,12 @@ SharedContext Runtime::createContext(const Ref<ViewManagerContext>& viewManagerC
 
     _resourceManager->preloadForComponentPath(componentPath);
 
+    if (viewManagerContext != nullptr && !componentPath.isEmpty()) {
+        // Warm up the view pools with the views this screen needed the previous times it was opened,
+        // while the JS side is busy rendering it.
+        viewManagerContext->preloadViewsForScreen(StringBox::fromString(componentPath.toString()));
+    }
+
     return context;
 }
 
@@ -230,7 +253,51 @@ SharedViewNodeTree Runtime::createViewNodeTreeAndContext(const Ref<ViewManagerCo
                                                          const Shared<ValueConvertible>& componentContext) {
     auto context = createContext(viewManagerContext, path, initialViewModel, componentContext);
     context->onCreate();
-    return createViewNodeTree(context);
+    auto viewNodeTree = createViewNodeTree(context);
+    prerenderViewNodeTree(viewNodeTree);
+    return viewNodeTree;
+}
+
+void Runtime::prerenderViewNodeTree(const SharedViewNodeTree& viewNodeTree) {
+    const auto& componentPath = viewNodeTree->getContext()->getPath();
+    const auto& resourceId = componentPath.getResourceId();
+
+    // Loading the module would delay the context creation, the prerendered template is only used
+    // when the module is already available.
+    if (!_resourceManager->isBundleLoaded(resourceId.bundleName)) {
+        return;
+    }
+
+    auto bundle = _resourceManager->getBundle(resourceId.bundleName);
+    auto entryPath = STRING_FORMAT("{}.{}.prerender", resourceId.resourcePath, componentPath.getSymbolName());
+    if (!bundle->hasEntry(entryPath)) {
+        return;
+    }
+
+    auto entry = bundle->getEntry(entryPath);
+    if (!entry) {
+        VALDI_ERROR(*_logger, "Failed to load prerendered template {}: {}", entryPath, entry.error());
+        return;
+    }
+
+    auto renderRequest = RenderRequest::deserialize(deserializeValue(entry.value().data(), entry.value().size()),
+                                                    _attributeIds);
+    if (!renderRequest) {
+        VALDI_ERROR(*_logger, "Failed to parse prerendered template {}: {}", entryPath, renderRequest.error());
+        return;
+    }
+    renderRequest.value()->setContextId(viewNodeTree->getContext()->getContextId());
+
+    viewNodeTree->scheduleExclusiveUpdate([this, viewNodeTree, renderRequest = renderRequest.moveValue()]() {
+        // The component was already rendered from JS
+        if (viewNodeTree->getRootViewNode() != nullptr) {
+            return;
+        }
+
+        VALDI_TRACE("Valdi.prerenderViewNodeTree");
+        ViewNodeRenderer renderer(*viewNodeTree, viewNodeTree->getContext()->getLogger(), _limitToViewportDisabled);
+        renderer.prerender(*renderRequest);
+    });
 }
 
 bool Runtime::hasViewNodeTreeForContext(const SharedContext& context) const {
@@ -298,12 +365,32 @@ void appendAllViews(ViewNode* viewNode, std::vector<Ref<View>>& views) {
     }
 }
 
+static void recordViewUsage(const ViewNodeTree& viewNodeTree, const ViewNode& rootViewNode) {
+    const auto& viewManagerContext = viewNodeTree.getViewManagerContext();
+    const auto& context = viewNodeTree.getContext();
+    if (viewManagerContext == nullptr || context == nullptr || context->getPath().isEmpty()) {
+        return;
+    }
+
+    auto viewStats = rootViewNode.getViewStats();
+    viewManagerContext->recordViewUsage(StringBox::fromString(context->getPath().toString()), *viewStats);
+}
+
 void Runtime::destroyViewNodeTree(ViewNodeTree& viewNodeTree) {
     _viewNodeManager.removeViewNodeTree(viewNodeTree);
 
     viewNodeTree.scheduleExclusiveUpdate([&]() {
         auto rootViewNode = viewNodeTree.getRootViewNode();
+        if (_deferredViewNodeTreeTeardownEnabled) {
+            if (rootViewNode != nullptr) {
+                recordViewUsage(viewNodeTree, *rootViewNode);
+            }
+            makeShared<DeferredViewNodeTreeTeardown>(strongSmallRef(&viewNodeTree), *_mainThreadManager)->start();
+            return;
+        }
+
         if (rootViewNode != nullptr) {
+            recordViewUsage(viewNodeTree, *rootViewNode);
             viewNodeTree.removeViewNode(rootViewNode->getRawId());
         }
 
@@ -374,7 +461,9 @@ std::string Runtime::dumpVerboseLogs() const {
 }
 
 void Runtime::receivedUpdatedResources(const std::vector<Shared<Resource>>& resources) {
-    updateResources(resources);
+    // The daemon may send whole modules on every change, only the resources whose content
+    // changed since they were last received are reloaded.
+    doUpdateResources(resources, true);
 }
 
 void Runtime::updateResource(const BytesView& resource,
@@ -386,10 +475,36 @@ void Runtime::updateResource(const BytesView& resource,
 }
 
 void Runtime::updateResources(const std::vector<Shared<Resource>>& resources) {
-    runWithExclusiveJsThreadLock([this, resources]() {
+    doUpdateResources(resources, false);
+}
+
+void Runtime::doUpdateResources(const std::vector<Shared<Resource>>& resources, bool skipUnchangedResources) {
+    runWithExclusiveJsThreadLock([this, resources, skipUnchangedResources]() {
         snap::utils::time::StopWatch sw;
         sw.start();
-        VALDI_INFO(*_logger, "Hot reloading {} resources", resources.size());
+
+        std::vector<Shared<Resource>> changedResources;
+        changedResources.reserve(resources.size());
+        for (const auto& resource : resources) {
+            if (skipUnchangedResources) {
+                const auto& it = _lastReceivedResources.find(resource->resourceId);
+                if (it != _lastReceivedResources.end() && it->second == resource->data) {
+                    continue;
+                }
+            }
+            _lastReceivedResources[resource->resourceId] = resource->data;
+            changedResources.emplace_back(resource);
+        }
+
+        if (changedResources.empty()) {
+            VALDI_INFO(*_logger, "Skipping hot reload of {} unchanged resources", resources.size());
+            return;
+        }
+
+        VALDI_INFO(*_logger,
+                   "Hot reloading {} resources ({} unchanged)",
+                   changedResources.size(),
+                   resources.size() - changedResources.size());
 
         if (Valdi::traceReloaderPerformance) {
             VALDI_INFO(*_logger, "Runtime::updateResources started");
@@ -397,7 +512,7 @@ void Runtime::updateResources(const std::vector<Shared<Resource>>& resources) {
 
         std::vector<ResourceId> unloadedJsFiles;
 
-        for (const auto& resource : resources) {
+        for (const auto& resource : changedResources) {
             const auto& bundleName = resource->resourceId.bundleName;
             const auto& filePathWithinBundle = resource->resourceId.resourcePath;
 
@@ -521,7 +636,7 @@ void Runtime::setAutoRenderDisabled(bool autoRenderDisabled) {
     if (!autoRenderDisabled && oldValue) {
         for (const auto& context : _contextManager.getAllContexts()) {
             if (context->hasPendingRenderRequests()) {
-                getMainThreadManager().dispatch(context, [context]() { context->flushRenderRequests(); });
+                scheduleFlushRenderRequests(context);
             }
         }
     }
@@ -533,11 +648,30 @@ void Runtime::receivedRenderRequest(const Ref<RenderRequest>& renderRequest) {
         return;
     }
 
+    StartupTimeline::shared().markMilestone(StartupMilestone::FirstRenderRequest);
+
     auto taskIdOptional = context->enqueueRenderRequest(renderRequest);
 
     if (taskIdOptional && !_autoRenderDisabled) {
-        getMainThreadManager().dispatch(
-            context, [context, taskId = taskIdOptional.value()]() { context->runRenderRequest(taskId); });
+        scheduleRenderRequest(context, taskIdOptional.value());
+    }
+}
+
+void Runtime::scheduleRenderRequest(const SharedContext& context, ContextUpdateId updateId) {
+    auto renderQueue = _parallelRenderingEnabled ? context->getOrCreateRenderQueue() : nullptr;
+    if (renderQueue != nullptr) {
+        renderQueue->async([context, updateId]() { context->runRenderRequest(updateId); });
+    } else {
+        getMainThreadManager().dispatch(context, [context, updateId]() { context->runRenderRequest(updateId); });
+    }
+}
+
+void Runtime::scheduleFlushRenderRequests(const SharedContext& context) {
+    auto renderQueue = _parallelRenderingEnabled ? context->getOrCreateRenderQueue() : nullptr;
+    if (renderQueue != nullptr) {
+        renderQueue->async([context]() { context->flushRenderRequests(); });
+    } else {
+        getMainThreadManager().dispatch(context, [context]() { context->flushRenderRequests(); });
     }
 }
 
@@ -557,9 +691,16 @@ void Runtime::processRenderRequest(const Ref<RenderRequest>& rawRenderRequest) {
         return;
     }
 
+    auto renderRequestTraceRecorder = _renderRequestTraceRecorder;
+    if (renderRequestTraceRecorder != nullptr) {
+        renderRequestTraceRecorder->record(*rawRenderRequest);
+    }
+
     viewNodeTree->scheduleExclusiveUpdate(
         [=]() {
             VALDI_TRACE("Valdi.processRenderRequest");
+            ScopedStartupSpan startupSpan(StartupSpanType::RenderRequest,
+                                          viewNodeTree->getContext()->getPath().getResourceId().bundleName);
 
             ViewNodeRenderer renderer(*viewNodeTree, viewNodeTree->getContext()->getLogger(), _limitToViewportDisabled);
 
@@ -581,7 +722,16 @@ void Runtime::processRenderRequest(const Ref<RenderRequest>& rawRenderRequest) {
             viewNodeTree->getContext()->onRendered();
         },
         [=]() {
-            if (_listener != nullptr) {
+            if (_listener == nullptr) {
+                return;
+            }
+
+            if (viewNodeTree->shouldRenderInMainThread() && !_mainThreadManager->currentThreadIsMainThread()) {
+                // Rendered in parallel, the listener is notified on the main thread once the view operations
+                // of the render were replayed.
+                viewNodeTree->getCurrentViewTransactionScope().transaction().executeInTransactionThread(
+                    [=]() { _listener->onContextRendered(*this, viewNodeTree->getContext()); });
+            } else {
                 _listener->onContextRendered(*this, viewNodeTree->getContext());
             }
         });
@@ -675,8 +825,11 @@ void Runtime::updateColorPalette(const Value& colorPaletteMap) {
 
 Value Runtime::getColorPalette() {
     auto valueMap = Valdi::makeShared<Valdi::ValueMap>();
-    for (const auto& [name, color] : _colorPalette->getColors()) {
-        (*valueMap)[name] = Valdi::Value(color.value);
+    auto colorsCount = _colorPalette->getColorsCount();
+    valueMap->reserve(colorsCount);
+    for (ColorId colorId = 0; colorId < colorsCount; colorId++) {
+        const auto& name = _colorPalette->getColorNameForId(colorId);
+        (*valueMap)[name] = Valdi::Value(_colorPalette->getColorForId(colorId).value);
     }
 
     return Valdi::Value(std::move(valueMap));
@@ -754,6 +907,10 @@ void Runtime::setDebugRequests(bool debugRequests) {
     _debugRequests = debugRequests;
 }
 
+void Runtime::setRenderRequestTraceRecorder(const Ref<RenderRequestTraceRecorder>& renderRequestTraceRecorder) {
+    _renderRequestTraceRecorder = renderRequestTraceRecorder;
+}
+
 void Runtime::setLimitToViewportDisabled(bool limitToViewportDisabled) {
     _limitToViewportDisabled = limitToViewportDisabled;
 }
@@ -762,6 +919,22 @@ bool Runtime::limitToViewportDisabled() const {
     return _limitToViewportDisabled;
 }
 
+void Runtime::setDeferredViewNodeTreeTeardownEnabled(bool deferredViewNodeTreeTeardownEnabled) {
+    _deferredViewNodeTreeTeardownEnabled = deferredViewNodeTreeTeardownEnabled;
+}
+
+bool Runtime::deferredViewNodeTreeTeardownEnabled() const {
+    return _deferredViewNodeTreeTeardownEnabled;
+}
+
+void Runtime::setParallelRenderingEnabled(bool parallelRenderingEnabled) {
+    _parallelRenderingEnabled = parallelRenderingEnabled;
+}
+
+bool Runtime::parallelRenderingEnabled() const {
+    return _parallelRenderingEnabled;
+}
+
 const Ref<DispatchQueue>& Runtime::getWorkerQueue() const {
     return _workerQueue;
 }
@@ -796,10 +969,18 @@ void Runtime::setShouldProcessUpdatesSynchronously(bool shouldProcessUpdatesSync
 void Runtime::emitInitMetrics() {
     runWithExclusiveJsThreadLock([this]() {
         auto initStopWatch = std::move(_initStopWatch);
+        if (initStopWatch == nullptr) {
+            return;
+        }
+
+        auto elapsed = initStopWatch->elapsed();
         auto metrics = getMetrics();
-        if (metrics != nullptr && initStopWatch != nullptr) {
-            metrics->emitRuntimeInitLatency(initStopWatch->elapsed());
+        if (metrics != nullptr) {
+            metrics->emitRuntimeInitLatency(elapsed);
         }
+
+        auto now = std::chrono::steady_clock::now();
+        StartupTimeline::shared().recordSpan(StartupSpanType::RuntimeInit, StringBox(), now - elapsed.chrono(), now);
     });
 }
 
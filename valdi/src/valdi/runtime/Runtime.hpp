@@ -20,6 +20,7 @@
 #include "valdi/runtime/Utils/DumpedLogs.hpp"
 #include "valdi/runtime/Utils/MainThreadManager.hpp"
 #include "valdi/runtime/Utils/SharedAtomic.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/Value.hpp"
@@ -70,6 +71,7 @@ class ColorPalette;
 class AssetLoaderManager;
 class ITweakValueProvider;
 class JavaScriptANRDetector;
+class RenderRequestTraceRecorder;
 class MetricsStopWatch;
 
 class IDaemonClient;
@@ -218,6 +220,12 @@ public:
 
     void setDebugRequests(bool debugRequests);
 
+    /**
+     Set a recorder which will be given every render request processed by this Runtime,
+     so that they can be replayed offline later. Pass nullptr to stop recording.
+     */
+    void setRenderRequestTraceRecorder(const Ref<RenderRequestTraceRecorder>& renderRequestTraceRecorder);
+
     void postInit();
 
     DumpedLogs dumpLogs(bool includeMetadata, bool includeVerbose, bool isCrashing) const;
@@ -227,6 +235,24 @@ public:
     void setLimitToViewportDisabled(bool limitToViewportDisabled);
     bool limitToViewportDisabled() const;
 
+    /**
+     Set whether destroyed ViewNodeTrees should be torn down in time-sliced chunks when the main thread
+     is idle. When enabled, the views are detached from the platform hierarchy right away, while the
+     ViewNodes and their associated state are released later.
+     */
+    void setDeferredViewNodeTreeTeardownEnabled(bool deferredViewNodeTreeTeardownEnabled);
+    bool deferredViewNodeTreeTeardownEnabled() const;
+
+    /**
+     Set whether the deferred render requests of different Contexts should be processed in parallel.
+     When enabled, render requests are applied and laid out on a serial queue per Context, backed by the
+     shared ThreadPool, instead of the main thread. The view operations of each render are collected into
+     a DeferredViewTransaction, which is replayed on the main thread in the order the renders completed.
+     This must only be enabled with view managers which can create their views outside of the main thread.
+     */
+    void setParallelRenderingEnabled(bool parallelRenderingEnabled);
+    bool parallelRenderingEnabled() const;
+
     const Ref<DispatchQueue>& getWorkerQueue() const;
 
     ILogger& getLogger() const;
@@ -279,6 +305,9 @@ public:
 protected:
     void receivedRenderRequest(const Ref<RenderRequest>& renderRequest) override;
 
+    void scheduleRenderRequest(const SharedContext& context, ContextUpdateId updateId);
+    void scheduleFlushRenderRequests(const SharedContext& context);
+
     void receivedCallActionMessage(const ContextId& contextId,
                                    const StringBox& actionName,
                                    const Ref<ValueArray>& parameters) override;
@@ -319,6 +348,7 @@ private:
     Shared<snap::valdi::RuntimeMessageHandler> _runtimeMessageHandler;
 
     Ref<ILogger> _logger;
+    Ref<RenderRequestTraceRecorder> _renderRequestTraceRecorder;
     bool _traceViewLifecycle = false;
     bool _debugRequests = false;
     bool _didEvaluateKotlinJs = false;
@@ -327,7 +357,11 @@ private:
     bool _didInit = false;
     bool _shouldProcessUpdatesSynchronously = false;
     std::atomic_bool _autoRenderDisabled = false;
+    std::atomic_bool _deferredViewNodeTreeTeardownEnabled = false;
+    std::atomic_bool _parallelRenderingEnabled = false;
     std::atomic_int _hotReloadSequence = 0;
+    // Content of the resources last received from the debugger service, only accessed from the JS thread
+    FlatMap<ResourceId, BytesView> _lastReceivedResources;
 
     std::shared_ptr<IRuntimeListener> _listener;
 
@@ -342,8 +376,12 @@ private:
 
     void destroyViewNodeTreeWithId(ContextId contextId);
 
+    void doUpdateResources(const std::vector<Shared<Resource>>& resources, bool skipUnchangedResources);
+
     void doDestroyContext(const SharedContext& context);
 
+    void prerenderViewNodeTree(const SharedViewNodeTree& viewNodeTree);
+
     void runWithExclusiveJsThreadLock(DispatchFunction&& cb);
     bool disablePersistentStoreEncryption();
 };
@@ -11,6 +11,7 @@
 #include "valdi/runtime/Context/AttributionResolver.hpp"
 #include "valdi/runtime/Context/ViewManagerContext.hpp"
 #include "valdi/runtime/Resources/BytesAssetLoader.hpp"
+#include "valdi/runtime/Resources/SharedBundleStore.hpp"
 #include "valdi/runtime/ValdiRuntimeTweaks.hpp"
 
 #include "valdi/runtime/Resources/AssetLoaderManager.hpp"
@@ -22,6 +23,7 @@
 #include "valdi/runtime/Debugger/DebuggerService.hpp"
 #include "valdi/runtime/Interfaces/IDiskCache.hpp"
 #include "valdi/runtime/Metrics/Metrics.hpp"
+#include "valdi/runtime/Utils/PprofExporter.hpp"
 #include "valdi/runtime/Utils/ShutdownUtils.hpp"
 #include "valdi/runtime/Views/GlobalViewFactories.hpp"
 #include "valdi/runtime/Views/ViewPreloader.hpp"
@@ -29,12 +31,18 @@
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 
 #include "valdi_core/ModuleFactoriesProvider.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/LockContentionProfiler.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
 
 #include <algorithm>
 
 namespace Valdi {
 
+constexpr std::chrono::steady_clock::duration kLockContentionFlushInterval = std::chrono::seconds(10);
+
 Shared<DebuggerService> createDebuggerService(bool enableDebuggerService,
                                               bool disableHotReloader,
                                               bool isStandalone,
@@ -111,7 +119,9 @@ RuntimeManager::RuntimeManager(const Ref<IMainThreadDispatcher>& mainThreadDispa
       _yogaConfig(Valdi::Yoga::createConfig(0)),
       _debuggerService(createDebuggerService(
           enableDebuggerService, disableHotReloader, isStandalone, platformType, runtimeMessageHandler, logger)),
+      _sharedBundleStore(makeShared<SharedBundleStore>(_attributeIds)),
       _deferredGCTask(DispatchQueue::TaskIDNull),
+      _lockContentionFlushTask(DispatchQueue::TaskIDNull),
       _mainThreadManager(makeShared<MainThreadManager>(mainThreadDispatcher)),
       _assetLoaderManager(makeShared<AssetLoaderManager>()),
       _innerLogger(_debuggerService != nullptr ? _debuggerService->getBridgeLogger() : logger),
@@ -124,6 +134,9 @@ RuntimeManager::RuntimeManager(const Ref<IMainThreadDispatcher>& mainThreadDispa
       _platformType(platformType),
       _jsThreadQoS(jsThreadQoS),
       _debuggerServiceEnabled(_debuggerService != nullptr) {
+    // The startup timeline starts with the first RuntimeManager of the process
+    StartupTimeline::shared().start();
+
     _mainThreadManager->postInit();
     _workerQueue = DispatchQueue::create(STRING_LITERAL("Valdi Worker Thread"), ThreadQoSClassHigh);
     _anrDetector = makeShared<JavaScriptANRDetector>(_logger);
@@ -210,6 +223,8 @@ SharedRuntime RuntimeManager::createRuntime(const Shared<IResourceLoader>& resou
         autoRenderDisabled = _loadOperationsCount > 0;
     }
 
+    // Runtimes created by the manager share the modules they load, and the artifacts parsed from them
+    runtime->getResourceManager().setSharedBundleStore(_sharedBundleStore);
     runtime->setRuntimeTweaks(runtimeTweaks);
     runtime->setAutoRenderDisabled(autoRenderDisabled);
     runtime->setMetrics(metrics);
@@ -444,34 +459,34 @@ void RuntimeManager::setApplicationId(const StringBox& applicationId) {
     }
 }
 
-void RuntimeManager::onColorPaletteUpdated(const ColorPalette& /*colorPalette*/) {
+void RuntimeManager::onColorPaletteUpdated(const ColorPalette& /*colorPalette*/, const ColorPaletteChanges& changes) {
     FlatSet<AttributeId> attributesToReapply;
 
-    // Clear the cache for all color attributes
+    // Clear the cached values resolved with the changed colors
     for (const auto& viewManagerContext : _viewManagerContexts) {
         for (const auto& it : viewManagerContext->getAttributesManager().getAllBoundAttributes()) {
             for (const auto& handlerIt : it.second->getHandlers()) {
                 auto* handler = it.second->getAttributeHandlerForId(handlerIt.first);
 
                 if (handler->shouldReevaluateOnColorPaletteChange()) {
-                    handler->clearPreprocessorCache();
+                    handler->clearPreprocessorCache(changes);
                     attributesToReapply.insert(handlerIt.first);
                 }
             }
         }
     }
 
-    // Reapply all the color attributes
+    // Reapply the color attributes whose values were resolved with the changed colors
     auto allAttributes = makeShared<std::vector<AttributeId>>();
     allAttributes->insert(allAttributes->end(), attributesToReapply.begin(), attributesToReapply.end());
 
     for (const auto& runtime : getAllRuntimes()) {
         for (const auto& tree : runtime->getViewNodeTreeManager().getAllRootViewNodeTrees()) {
-            tree->scheduleExclusiveUpdate([treePtr = tree.get(), allAttributes]() {
+            tree->scheduleExclusiveUpdate([treePtr = tree.get(), allAttributes, changes]() {
                 auto rootViewNode = treePtr->getRootViewNode();
                 if (rootViewNode != nullptr) {
-                    rootViewNode->reapplyAttributesRecursive(
-                        treePtr->getCurrentViewTransactionScope(), *allAttributes, false);
+                    rootViewNode->reapplyAttributesForColorChangesRecursive(
+                        treePtr->getCurrentViewTransactionScope(), *allAttributes, changes);
                 }
             });
         }
@@ -498,6 +513,103 @@ void RuntimeManager::setMetrics(const Ref<Metrics>& metrics) {
     std::lock_guard<Mutex> guard(_mutex);
     _metrics = metrics;
     _anrDetector->setMetrics(metrics);
+
+    if (metrics != nullptr) {
+        Shared<DebuggerService> debuggerService;
+        if constexpr (kDebuggerServiceEnabled) {
+            debuggerService = _debuggerService;
+        }
+        FrameMetricsAggregator::shared().setFlushCallback(
+            [metrics, debuggerService](const StringBox& module, const FrameMetricsSummary& summary) {
+                metrics->emitFrameMetricsSummary(module, summary);
+                if (debuggerService != nullptr) {
+                    debuggerService->sendFrameMetricsSummary(module, summary);
+                }
+            });
+        StartupTimeline::shared().setCompletionCallback(
+            [metrics, debuggerService](const StartupTimelineReport& report) {
+                metrics->emitStartupTimeline(report);
+                if (debuggerService != nullptr) {
+                    debuggerService->sendStartupTimelineReport(report.toValue());
+                }
+            });
+    } else {
+        FrameMetricsAggregator::shared().setFlushCallback(FrameMetricsFlushCallback());
+        StartupTimeline::shared().setCompletionCallback(StartupTimelineCompletionCallback());
+    }
+}
+
+void RuntimeManager::setLockContentionProfilingEnabled(bool enabled) {
+    task_id_t previousFlushTask;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        previousFlushTask = _lockContentionFlushTask;
+        _lockContentionFlushTask = DispatchQueue::TaskIDNull;
+    }
+    if (previousFlushTask != DispatchQueue::TaskIDNull) {
+        _workerQueue->cancel(previousFlushTask);
+    }
+
+    if (enabled) {
+        // Drop what was recorded during a previous profiling session
+        LockContentionProfiler::shared().collect();
+        LockContentionProfiler::setEnabled(true);
+        scheduleLockContentionFlush();
+    } else {
+        LockContentionProfiler::setEnabled(false);
+        flushLockContention();
+    }
+}
+
+void RuntimeManager::setAllocationProfilingEnabled(bool enabled) {
+    if (enabled) {
+        // Drop what was recorded during a previous profiling session
+        AllocationProfiler::shared().collect();
+    }
+    AllocationProfiler::setEnabled(enabled);
+}
+
+Ref<ByteBuffer> RuntimeManager::collectAllocationProfile() {
+    return exportAllocationProfileToPprof(AllocationProfiler::shared().collect());
+}
+
+void RuntimeManager::scheduleLockContentionFlush() {
+    auto taskId = _workerQueue->asyncAfter(
+        [weakThis = weakRef(this)]() {
+            auto strongThis = weakThis.lock();
+            if (strongThis == nullptr || !LockContentionProfiler::isEnabled()) {
+                return;
+            }
+            strongThis->flushLockContention();
+            strongThis->scheduleLockContentionFlush();
+        },
+        kLockContentionFlushInterval);
+
+    std::lock_guard<Mutex> guard(_mutex);
+    _lockContentionFlushTask = taskId;
+}
+
+void RuntimeManager::flushLockContention() {
+    auto summaries = LockContentionProfiler::shared().collect();
+    if (summaries.empty()) {
+        return;
+    }
+
+    Ref<Metrics> metrics;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        metrics = _metrics;
+    }
+
+    if (metrics != nullptr) {
+        for (const auto& it : summaries) {
+            metrics->emitLockContentionSummary(StringCache::getGlobal().makeString(it.first), it.second);
+        }
+    }
+
+    if (kDebuggerServiceEnabled && _debuggerService != nullptr) {
+        _debuggerService->sendLockContentionReport(LockContentionProfiler::toValue(summaries));
+    }
 }
 
 void RuntimeManager::setTweakValueProvider(const Shared<ITweakValueProvider>& tweakValueProvider) {
@@ -523,9 +635,11 @@ void RuntimeManager::setTweakValueProvider(const Shared<ITweakValueProvider>& tw
 
     auto disableAnimationRemoveOnCompleteIos =
         runtimeTweaks != nullptr ? runtimeTweaks->disableAnimationRemoveOnCompleteIos() : false;
+    auto enablePerformanceOverlay = runtimeTweaks != nullptr ? runtimeTweaks->enablePerformanceOverlay() : false;
     for (const auto& viewManagerContext : _viewManagerContexts) {
         viewManagerContext->getViewManager().setDisableAnimationRemoveOnCompleteIos(
             disableAnimationRemoveOnCompleteIos);
+        viewManagerContext->getViewManager().setPerformanceOverlayEnabled(enablePerformanceOverlay);
     }
 
     for (const auto& runtime : runtimes) {
@@ -673,6 +787,83 @@ JavaScriptContextMemoryStatistics RuntimeManager::dumpMemoryStatistics() {
     return stats;
 }
 
+static Value treeInfoToValue(const ViewNodeTreeInfo& info) {
+    return Value()
+        .setMapValue("totalBytes", Value(static_cast<int64_t>(info.getTotalBytes())))
+        .setMapValue("viewNodesBytes", Value(static_cast<int64_t>(info.viewNodesBytes)))
+        .setMapValue("layoutBytes", Value(static_cast<int64_t>(info.layoutBytes)))
+        .setMapValue("attributesBytes", Value(static_cast<int64_t>(info.attributesBytes)))
+        .setMapValue("viewNodesCount", Value(static_cast<int32_t>(info.nodesCount)))
+        .setMapValue("viewsCount", Value(static_cast<int32_t>(info.viewsCount)))
+        .setMapValue("attributesCount", Value(static_cast<int32_t>(info.attributesCount)));
+}
+
+Value RuntimeManager::dumpNativeMemoryStatistics() {
+    struct ContextEntry {
+        ContextId contextId;
+        ComponentPath componentPath;
+        ViewNodeTreeInfo info;
+    };
+    struct ModuleEntry {
+        StringBox moduleName;
+        ViewNodeTreeInfo info;
+        std::vector<ContextEntry> contexts;
+    };
+
+    std::vector<ModuleEntry> modules;
+    FlatMap<StringBox, size_t> moduleIndexByName;
+    ViewNodeTreeInfo totalInfo;
+
+    for (const auto& runtime : getAllRuntimes()) {
+        for (const auto& tree : runtime->getViewNodeTreeManager().getAllRootViewNodeTrees()) {
+            const auto& context = tree->getContext();
+            auto info = tree->dumpTreeInfo();
+            const auto& moduleName = context->getAttribution().moduleName;
+
+            auto it = moduleIndexByName.find(moduleName);
+            if (it == moduleIndexByName.end()) {
+                it = moduleIndexByName.try_emplace(moduleName, modules.size()).first;
+                modules.emplace_back().moduleName = moduleName;
+            }
+
+            auto& module = modules[it->second];
+            module.info.merge(info);
+            module.contexts.emplace_back(ContextEntry{context->getContextId(), context->getPath(), info});
+            totalInfo.merge(info);
+        }
+    }
+
+    std::sort(modules.begin(), modules.end(), [](const ModuleEntry& left, const ModuleEntry& right) {
+        return left.info.getTotalBytes() > right.info.getTotalBytes();
+    });
+
+    auto modulesArray = ValueArray::make(modules.size());
+    for (size_t i = 0; i < modules.size(); i++) {
+        auto& module = modules[i];
+        std::sort(module.contexts.begin(),
+                  module.contexts.end(),
+                  [](const ContextEntry& left, const ContextEntry& right) {
+                      return left.info.getTotalBytes() > right.info.getTotalBytes();
+                  });
+
+        auto contextsArray = ValueArray::make(module.contexts.size());
+        for (size_t j = 0; j < module.contexts.size(); j++) {
+            const auto& context = module.contexts[j];
+            contextsArray->emplace(j,
+                                   treeInfoToValue(context.info)
+                                       .setMapValue("contextId", Value(static_cast<int64_t>(context.contextId)))
+                                       .setMapValue("componentPath", Value(context.componentPath.toString())));
+        }
+
+        modulesArray->emplace(i,
+                              treeInfoToValue(module.info)
+                                  .setMapValue("module", Value(module.moduleName))
+                                  .setMapValue("contexts", Value(contextsArray)));
+    }
+
+    return treeInfoToValue(totalInfo).setMapValue("modules", Value(modulesArray));
+}
+
 void RuntimeManager::emitMetrics(void (Metrics::*emitterFunc)(const MetricsDuration&)) {
     std::shared_ptr<MetricsStopWatch> initStopWatch;
     Ref<Metrics> metrics;
@@ -690,6 +881,18 @@ void RuntimeManager::emitMetrics(void (Metrics::*emitterFunc)(const MetricsDurat
 
 void RuntimeManager::emitInitMetrics() {
     emitMetrics(&Metrics::emitRuntimeManagerInitLatency);
+
+    std::shared_ptr<MetricsStopWatch> initStopWatch;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        initStopWatch = _initStopWatch;
+    }
+
+    if (initStopWatch != nullptr) {
+        auto now = std::chrono::steady_clock::now();
+        StartupTimeline::shared().recordSpan(
+            StartupSpanType::RuntimeManagerInit, StringBox(), now - initStopWatch->elapsed().chrono(), now);
+    }
 }
 
 void RuntimeManager::emitUserSessionReadyMetrics() {
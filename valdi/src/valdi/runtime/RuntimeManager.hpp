@@ -49,7 +49,9 @@ class AttributionResolver;
 class Metrics;
 class JavaScriptANRDetector;
 class MetricsStopWatch;
+class ByteBuffer;
 class ValdiRuntimeTweaks;
+class SharedBundleStore;
 
 struct RegisteredTypeConverter {
     StringBox className;
@@ -135,6 +137,13 @@ public:
 
     JavaScriptContextMemoryStatistics dumpMemoryStatistics();
 
+    /**
+     Returns an estimate of the native memory retained by the view nodes of every Context,
+     grouped by module and sorted from the largest to the smallest. Each module
+     entry contains the breakdown by Context, identified by its component path.
+     */
+    Value dumpNativeMemoryStatistics();
+
     void setJsThreadQoS(ThreadQoSClass jsThreadQoS);
 
     void setAttributionResolver(const Ref<AttributionResolver>& attributionResolver);
@@ -152,6 +161,23 @@ public:
 
     void setMetrics(const Ref<Metrics>& metrics);
 
+    /**
+     Enable or disable the lock contention profiler. While enabled, the contention recorded on
+     the named locks is periodically emitted to the Metrics and sent to the connected debugger clients.
+     */
+    void setLockContentionProfilingEnabled(bool enabled);
+
+    /**
+     Enable or disable the allocation profiler. While enabled, the allocations made through the
+     counted allocation sites are sampled, and can be collected with collectAllocationProfile().
+     */
+    void setAllocationProfilingEnabled(bool enabled);
+
+    /**
+     Returns the allocations sampled since the last collect as a pprof profile, and resets them.
+     */
+    Ref<ByteBuffer> collectAllocationProfile();
+
     PlatformType getPlatformType() const;
 
     const Ref<JavaScriptANRDetector>& getANRDetector() const;
@@ -159,15 +185,17 @@ public:
     VALDI_CLASS_HEADER(RuntimeManager)
 
 protected:
-    void onColorPaletteUpdated(const ColorPalette& colorPalette) override;
+    void onColorPaletteUpdated(const ColorPalette& colorPalette, const ColorPaletteChanges& changes) override;
 
 private:
     std::shared_ptr<MetricsStopWatch> _initStopWatch;
     std::shared_ptr<YGConfig> _yogaConfig;
     Shared<DebuggerService> _debuggerService;
     AttributeIds _attributeIds;
+    Ref<SharedBundleStore> _sharedBundleStore;
 
     task_id_t _deferredGCTask;
+    task_id_t _lockContentionFlushTask;
 
     Ref<MainThreadManager> _mainThreadManager;
     Ref<AssetLoaderManager> _assetLoaderManager;
@@ -215,6 +243,9 @@ private:
 
     task_id_t swapDeferredGCTask(task_id_t task);
 
+    void scheduleLockContentionFlush();
+    void flushLockContention();
+
     void updateLoadOperationsCount(int increment);
 
     using MetricsDuration = snap::utils::time::Duration<std::chrono::steady_clock>;
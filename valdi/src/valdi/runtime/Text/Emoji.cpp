@@ -1,5 +1,6 @@
 #include "valdi/runtime/Text/Emoji.hpp"
 #include "valdi/runtime/Text/Emoji_Gen.hpp"
+#include "valdi_core/cpp/Text/GraphemeClusters.hpp"
 #include "valdi_core/cpp/Text/UnicodeSequenceTrie.hpp"
 
 namespace Valdi {
@@ -66,4 +67,17 @@ const UnicodeSequenceTrie* getEmojiUnicodeTrie() {
     return kTrie;
 }
 
+static UnicodeRangeScanner* makeEmojiSequenceScanner() {
+    std::vector<CharacterRange> ranges;
+    getEmojiUnicodeTrie()->appendAnchorUnicodePoints(ranges);
+    appendGraphemeClusterExtendRanges(ranges);
+
+    return new UnicodeRangeScanner(std::move(ranges));
+}
+
+const UnicodeRangeScanner& getEmojiSequenceScanner() {
+    static auto* kScanner = makeEmojiSequenceScanner();
+    return *kScanner;
+}
+
 } // namespace Valdi
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "valdi_core/cpp/Text/UnicodeRangeScanner.hpp"
 #include "valdi_core/cpp/Text/UnicodeSequenceTrie.hpp"
 #include <vector>
 
@@ -10,4 +11,10 @@ Returns a unicode trie set that contains all the emoji characters.
  */
 const UnicodeSequenceTrie* getEmojiUnicodeTrie();
 
+/**
+Returns a scanner matching the unicode points which can anchor an emoji sequence of the
+emoji trie or extend a grapheme cluster. Text without any of those can skip the emoji trie.
+ */
+const UnicodeRangeScanner& getEmojiSequenceScanner();
+
 } // namespace Valdi
\ No newline at end of file
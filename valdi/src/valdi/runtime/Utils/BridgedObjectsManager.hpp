@@ -95,6 +95,23 @@ public:
         return ids;
     }
 
+    /**
+     Release all the objects with the given ids at once.
+     Returns how many of the ids were found.
+     */
+    size_t releaseObjects(const std::vector<uint64_t>& ids) {
+        size_t releasedCount = 0;
+        for (auto id : ids) {
+            auto bridgedObject = getBridgedObject(id);
+            if (bridgedObject != nullptr) {
+                releaseAndDestroyObjectIfNeeded(bridgedObject);
+                releasedCount++;
+            }
+        }
+
+        return releasedCount;
+    }
+
     void releaseAllObjectsAndFreeze() {
         if (_frozen) {
             return;
@@ -148,10 +165,8 @@ private:
 
     void expandObjectsIfNeeded(size_t insertionIndex) {
         if (insertionIndex >= _objects.size()) {
-            _objects.reserve(insertionIndex + 1);
-            while (_objects.size() <= insertionIndex) {
-                _objects.emplace_back();
-            }
+            // resize() grows the capacity geometrically, unlike reserving the exact size
+            _objects.resize(insertionIndex + 1);
         }
     }
 
@@ -7,39 +7,256 @@
 
 #include "valdi/runtime/Utils/DataEncryptor.hpp"
 
+#include <openssl/aead.h>
 #include <openssl/rand.h>
 #include <openssl/span.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 namespace Valdi {
 
+using Iv = snap::utils::crypto::AesEncryptor::Iv;
+
+// "VCE1", followed by the segment size, the decrypted size and the IV
+constexpr uint32_t kSegmentedMagic = 0x31454356;
+constexpr size_t kSegmentSize = 64 * 1024;
+constexpr size_t kTagSize = 16;
+constexpr size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(Iv);
+
+struct SegmentedHeader {
+    const Byte* data;
+    size_t segmentSize;
+    size_t length;
+    Iv iv;
+};
+
 DataEncryptor::DataEncryptor(const snap::utils::crypto::AesEncryptor::Key& key) : _key(key) {}
 
 static bssl::Span<uint8_t> toSpan(const Byte* data, size_t length) {
     return bssl::Span<uint8_t>(const_cast<uint8_t*>(data), length);
 }
 
+static size_t getSegmentsCount(size_t length, size_t segmentSize) {
+    // Empty data still has one segment, so that it is authenticated
+    return std::max(static_cast<size_t>(1), (length + segmentSize - 1) / segmentSize);
+}
+
+static Iv makeSegmentNonce(const Iv& iv, uint64_t segmentIndex) {
+    auto nonce = iv;
+    for (size_t i = 0; i < sizeof(segmentIndex); i++) {
+        nonce[nonce.size() - 1 - i] ^= static_cast<uint8_t>(segmentIndex >> (i * 8));
+    }
+    return nonce;
+}
+
+static void writeHeader(Byte* output, size_t length, const Iv& iv) {
+    auto magic = kSegmentedMagic;
+    auto segmentSize = static_cast<uint32_t>(kSegmentSize);
+    auto decryptedLength = static_cast<uint64_t>(length);
+
+    std::memcpy(output, &magic, sizeof(magic));
+    output += sizeof(magic);
+    std::memcpy(output, &segmentSize, sizeof(segmentSize));
+    output += sizeof(segmentSize);
+    std::memcpy(output, &decryptedLength, sizeof(decryptedLength));
+    output += sizeof(decryptedLength);
+    std::memcpy(output, iv.data(), iv.size());
+}
+
+static std::optional<SegmentedHeader> parseHeader(const Byte* data, size_t length) {
+    if (length < kHeaderSize) {
+        return std::nullopt;
+    }
+
+    uint32_t magic;
+    uint32_t segmentSize;
+    uint64_t decryptedLength;
+    SegmentedHeader header;
+
+    const auto* input = data;
+    std::memcpy(&magic, input, sizeof(magic));
+    input += sizeof(magic);
+    std::memcpy(&segmentSize, input, sizeof(segmentSize));
+    input += sizeof(segmentSize);
+    std::memcpy(&decryptedLength, input, sizeof(decryptedLength));
+    input += sizeof(decryptedLength);
+    std::memcpy(header.iv.data(), input, header.iv.size());
+
+    if (magic != kSegmentedMagic || segmentSize == 0 || decryptedLength > length) {
+        return std::nullopt;
+    }
+
+    header.data = data;
+    header.segmentSize = static_cast<size_t>(segmentSize);
+    header.length = static_cast<size_t>(decryptedLength);
+
+    auto segmentsCount = getSegmentsCount(header.length, header.segmentSize);
+    if (length != kHeaderSize + header.length + segmentsCount * kTagSize) {
+        return std::nullopt;
+    }
+
+    return header;
+}
+
+static bool initContext(EVP_AEAD_CTX* context, const snap::utils::crypto::AesEncryptor::Key& key) {
+    // BoringSSL picks the hardware accelerated AES implementation when the CPU supports it
+    return EVP_AEAD_CTX_init(
+               context, EVP_aead_aes_128_gcm(), key.data(), key.size(), EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr) != 0;
+}
+
+static bool openSegment(const EVP_AEAD_CTX* context,
+                        const SegmentedHeader& header,
+                        size_t segmentIndex,
+                        Byte* out,
+                        size_t segmentLength) {
+    const auto* cipherText = header.data + kHeaderSize + segmentIndex * (header.segmentSize + kTagSize);
+    auto nonce = makeSegmentNonce(header.iv, segmentIndex);
+
+    // The header is authenticated with every segment, which prevents segments from being truncated
+    size_t outLength = 0;
+    return EVP_AEAD_CTX_open(context,
+                             out,
+                             &outLength,
+                             segmentLength,
+                             nonce.data(),
+                             nonce.size(),
+                             cipherText,
+                             segmentLength + kTagSize,
+                             header.data,
+                             kHeaderSize) != 0 &&
+           outLength == segmentLength;
+}
+
+static bool decryptSegments(const snap::utils::crypto::AesEncryptor::Key& key,
+                            const SegmentedHeader& header,
+                            size_t offset,
+                            Byte* out,
+                            size_t outLength) {
+    bssl::ScopedEVP_AEAD_CTX context;
+    if (!initContext(context.get(), key)) {
+        return false;
+    }
+
+    if (header.length == 0) {
+        Byte empty;
+        return openSegment(context.get(), header, 0, &empty, 0);
+    }
+
+    if (outLength == 0) {
+        return true;
+    }
+
+    std::vector<Byte> segmentBuffer;
+
+    auto end = offset + outLength;
+    auto firstSegment = offset / header.segmentSize;
+    auto lastSegment = (end - 1) / header.segmentSize;
+
+    for (auto segmentIndex = firstSegment; segmentIndex <= lastSegment; segmentIndex++) {
+        auto segmentStart = segmentIndex * header.segmentSize;
+        auto segmentLength = std::min(header.segmentSize, header.length - segmentStart);
+        auto copyStart = std::max(offset, segmentStart);
+        auto copyEnd = std::min(end, segmentStart + segmentLength);
+        auto* segmentOut = out + (copyStart - offset);
+
+        if (copyStart == segmentStart && copyEnd == segmentStart + segmentLength) {
+            // The whole segment is requested, decrypt it in place
+            if (!openSegment(context.get(), header, segmentIndex, segmentOut, segmentLength)) {
+                return false;
+            }
+        } else {
+            segmentBuffer.resize(segmentLength);
+            if (!openSegment(context.get(), header, segmentIndex, segmentBuffer.data(), segmentLength)) {
+                return false;
+            }
+            std::memcpy(segmentOut, segmentBuffer.data() + (copyStart - segmentStart), copyEnd - copyStart);
+        }
+    }
+
+    return true;
+}
+
 bool DataEncryptor::encrypt(const Byte* data, size_t length, ByteBuffer& out) const {
-    snap::utils::crypto::AesEncryptor::Iv iv;
+    Iv iv;
     RAND_bytes(reinterpret_cast<uint8_t*>(iv.data()), iv.size());
 
-    snap::utils::crypto::AesEncryptor encryptor(_key, iv);
-
-    auto encryptResult = encryptor.encrypt(toSpan(data, length));
-    if (!encryptResult) {
+    bssl::ScopedEVP_AEAD_CTX context;
+    if (!initContext(context.get(), _key)) {
         return false;
     }
 
-    // Insert the IV at the front
-    out.append(iv.begin(), iv.end());
+    auto segmentsCount = getSegmentsCount(length, kSegmentSize);
+    auto previousSize = out.size();
+    auto* output = out.appendWritable(kHeaderSize + length + segmentsCount * kTagSize);
+
+    writeHeader(output, length, iv);
 
-    // Append the data after
-    out.append(encryptResult.value().data(), encryptResult.value().data() + encryptResult.value().size());
+    static const Byte kEmpty = 0;
+    const auto* header = output;
+    auto* segmentOutput = output + kHeaderSize;
+    for (size_t segmentIndex = 0; segmentIndex < segmentsCount; segmentIndex++) {
+        auto segmentStart = segmentIndex * kSegmentSize;
+        auto segmentLength = std::min(kSegmentSize, length - segmentStart);
+        auto nonce = makeSegmentNonce(iv, segmentIndex);
+
+        size_t outLength = 0;
+        if (EVP_AEAD_CTX_seal(context.get(),
+                              segmentOutput,
+                              &outLength,
+                              segmentLength + kTagSize,
+                              nonce.data(),
+                              nonce.size(),
+                              length > 0 ? data + segmentStart : &kEmpty,
+                              segmentLength,
+                              header,
+                              kHeaderSize) == 0) {
+            out.resize(previousSize);
+            return false;
+        }
+
+        segmentOutput += outLength;
+    }
 
     return true;
 }
 
 bool DataEncryptor::decrypt(const Byte* data, size_t length, ByteBuffer& out) const {
-    snap::utils::crypto::AesEncryptor::Iv iv;
+    auto header = parseHeader(data, length);
+    if (header) {
+        auto previousSize = out.size();
+        auto* output = out.appendWritable(header.value().length);
+        if (decryptSegments(_key, header.value(), 0, output, header.value().length)) {
+            return true;
+        }
+        out.resize(previousSize);
+        // The data might have been encrypted by a previous version and happen to look like segments.
+        // The authentication tags tell them apart.
+    }
+
+    return decryptSingleSegment(data, length, out);
+}
+
+bool DataEncryptor::decrypt(const Byte* data, size_t length, size_t offset, Byte* out, size_t outLength) const {
+    auto header = parseHeader(data, length);
+    if (!header || offset > header.value().length || outLength > header.value().length - offset) {
+        return false;
+    }
+
+    return decryptSegments(_key, header.value(), offset, out, outLength);
+}
+
+std::optional<size_t> DataEncryptor::getDecryptedSize(const Byte* data, size_t length) {
+    auto header = parseHeader(data, length);
+    if (!header) {
+        return std::nullopt;
+    }
+    return header.value().length;
+}
+
+bool DataEncryptor::decryptSingleSegment(const Byte* data, size_t length, ByteBuffer& out) const {
+    Iv iv;
 
     if (length < iv.size()) {
         return false;
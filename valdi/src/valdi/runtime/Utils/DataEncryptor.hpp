@@ -12,13 +12,18 @@
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 
+#include <optional>
+
 namespace Valdi {
 
 /**
  * The DataEncryptor is a class that simplifies encrypting and decrypting data
  * using a given private and securely generated AES Key.
- * The data is encoded with a secure random IV that will be stored
- * to the given ByteBuffer.
+ * The data is encrypted in segments of 64KB which are each authenticated with their own tag,
+ * so that decrypting does not need intermediate buffers and ranges of the data can be decrypted
+ * without decrypting the whole data. The segments are encoded with a secure random IV that will be
+ * stored to the given ByteBuffer. Data encrypted as a single segment by previous versions can still
+ * be decrypted.
  */
 class DataEncryptor {
 public:
@@ -27,10 +32,24 @@ public:
     bool encrypt(const Byte* data, size_t length, ByteBuffer& out) const;
     bool decrypt(const Byte* data, size_t length, ByteBuffer& out) const;
 
+    /**
+     * Decrypt outLength bytes starting at the given offset of the decrypted data into the given
+     * buffer. Only the segments covering the range are decrypted.
+     */
+    bool decrypt(const Byte* data, size_t length, size_t offset, Byte* out, size_t outLength) const;
+
+    /**
+     * Returns the size that the given encrypted data will have once decrypted, or std::nullopt
+     * if the data is not encrypted in segments.
+     */
+    static std::optional<size_t> getDecryptedSize(const Byte* data, size_t length);
+
     static snap::utils::crypto::AesEncryptor::Key generateKey();
 
 private:
     snap::utils::crypto::AesEncryptor::Key _key;
+
+    bool decryptSingleSegment(const Byte* data, size_t length, ByteBuffer& out) const;
 };
 
 } // namespace Valdi
@@ -6,42 +6,25 @@
 //
 
 #include "valdi/runtime/Utils/HexUtils.hpp"
-
-#include <iomanip>
-#include <sstream>
+#include "valdi_core/cpp/Utils/HexCodec.hpp"
 
 namespace Valdi {
 
 size_t hexStringToBytes(const std::string_view& hexString, Byte* output, size_t outputLength) {
-    size_t strIndex = 0;
-
-    for (size_t i = 0; i < outputLength; i++) {
-        if (strIndex + 2 > hexString.size()) {
-            return 0;
-        }
-
-        std::string tok;
-        tok.append(hexString.data() + strIndex, 2);
-        uint8_t byte = strtol(tok.data(), nullptr, 16);
-
-        output[i] = byte;
+    auto hexLength = outputLength * 2;
+    if (hexLength > hexString.size()) {
+        return 0;
+    }
 
-        strIndex += 2;
+    if (!HexCodec::decode(hexString.substr(0, hexLength), output)) {
+        return 0;
     }
 
-    return strIndex;
+    return hexLength;
 }
 
 std::string bytesToHexString(const Byte* input, size_t inputLength) {
-    std::stringstream stream;
-    stream << std::hex << std::setfill('0');
-
-    for (size_t i = 0; i < inputLength; i++) {
-        auto b = input[i];
-        stream << std::setw(2) << static_cast<int>(b);
-    }
-
-    return stream.str();
+    return HexCodec::encode(input, inputLength);
 }
 
 } // namespace Valdi
@@ -28,8 +28,11 @@ bool MainThreadBatchAllowScope::isAllowed() {
     return kMainTreachBatchAllowScopeCounter > 0;
 }
 
-MainThreadTask::MainThreadTask(size_t flushId, const Ref<Context>& context, DispatchFunction&& function)
-    : flushId(flushId), context(context), function(std::move(function)) {}
+MainThreadTask::MainThreadTask(size_t flushId,
+                               const Ref<Context>& context,
+                               DispatchFunction&& function,
+                               MainThreadTaskPriority priority)
+    : flushId(flushId), context(context), function(std::move(function)), priority(priority) {}
 
 MainThreadTask::~MainThreadTask() = default;
 
@@ -50,19 +53,28 @@ bool MainThreadManager::shouldAllowBatchFromCurrentThread() {
 }
 
 void MainThreadManager::dispatch(const Ref<Context>& context, DispatchFunction function) {
-    doDispatch(context, std::move(function), false);
+    doDispatch(context, std::move(function), MainThreadTaskPriority::Normal, false);
+}
+
+void MainThreadManager::dispatch(const Ref<Context>& context,
+                                 DispatchFunction function,
+                                 MainThreadTaskPriority priority) {
+    doDispatch(context, std::move(function), priority, false);
 }
 
 void MainThreadManager::dispatchSync(const Ref<Context>& context, DispatchFunction function) {
-    doDispatch(context, std::move(function), true);
+    doDispatch(context, std::move(function), MainThreadTaskPriority::Normal, true);
 }
 
-void MainThreadManager::doDispatch(const Ref<Context>& context, DispatchFunction&& function, bool sync) {
+void MainThreadManager::doDispatch(const Ref<Context>& context,
+                                   DispatchFunction&& function,
+                                   MainThreadTaskPriority priority,
+                                   bool sync) {
     if (_tornDown) {
         return;
     }
 
-    std::unique_lock<std::mutex> lockGuard(_mutex);
+    std::unique_lock<Mutex> lockGuard(_mutex);
 
     _tasksSequence++;
     size_t flushId;
@@ -72,12 +84,12 @@ void MainThreadManager::doDispatch(const Ref<Context>& context, DispatchFunction
         // We are in a batch, schedule the task with the current flushId
         flushId = _flushIdSequence;
         _batchFlushId = flushId;
-        _pendingTasks.emplace_back(flushId, context, std::move(function));
+        _pendingTasks.emplace_back(flushId, context, std::move(function), priority);
         shouldDispatch = false;
     } else {
         // Outside of a batch, we schedule the task for the next flush
         flushId = ++_flushIdSequence;
-        _pendingTasks.emplace_back(flushId, context, std::move(function));
+        _pendingTasks.emplace_back(flushId, context, std::move(function), priority);
         shouldDispatch = true;
     }
     lockGuard.unlock();
@@ -88,23 +100,19 @@ void MainThreadManager::doDispatch(const Ref<Context>& context, DispatchFunction
 }
 
 void MainThreadManager::scheduleFlush(size_t flushId, bool sync) {
-    auto dispatchFn =
-        new DispatchFunction([self = strongSmallRef(this), flushId]() { self->flushTasksWithId(flushId); });
+    // A synchronous dispatch expects its task to have run once the flush returns
+    auto dispatchFn = new DispatchFunction(
+        [self = strongSmallRef(this), flushId, sync]() { self->flushTasksWithId(flushId, !sync); });
     _mainThreadDispatcher->dispatch(dispatchFn, sync);
 }
 
 bool MainThreadManager::runNextTask() {
-    std::unique_lock<std::mutex> lock(_mutex);
+    std::unique_lock<Mutex> lock(_mutex);
     size_t flushIdSequence = _flushIdSequence;
-    return runNextTaskWithId(flushIdSequence, lock);
+    return runNextTaskWithId(flushIdSequence, lock, false);
 }
 
-bool MainThreadManager::runNextTaskWithId(size_t flushId) {
-    std::unique_lock<std::mutex> lock(_mutex);
-    return runNextTaskWithId(flushId, lock);
-}
-
-bool MainThreadManager::runNextTaskWithId(size_t flushId, std::unique_lock<std::mutex>& lock) {
+bool MainThreadManager::runNextTaskWithId(size_t flushId, std::unique_lock<Mutex>& lock, bool overBudget) {
     if (_pendingTasks.empty() || _pendingTasks.front().flushId > flushId) {
         return false;
     }
@@ -112,35 +120,114 @@ bool MainThreadManager::runNextTaskWithId(size_t flushId, std::unique_lock<std::
     auto task = std::move(_pendingTasks.front());
     _pendingTasks.pop_front();
     _tasksSequence++;
+
+    // Low priority tasks also get postponed while earlier ones are, so that they stay in order
+    if (task.priority == MainThreadTaskPriority::Low && (overBudget || !_postponedTasks.empty())) {
+        _postponedTasks.emplace_back(std::move(task));
+        schedulePostponedFlushIfNeeded();
+        return true;
+    }
+
     lock.unlock();
 
     if (!_tornDown) {
-        if (task.context != nullptr) {
-            task.context->withAttribution(task.function);
-        } else {
-            task.function();
-        }
+        runTask(task);
         return true;
     }
 
     return false;
 }
 
+void MainThreadManager::runTask(MainThreadTask& task) {
+    if (task.context != nullptr) {
+        task.context->withAttribution(task.function);
+    } else {
+        task.function();
+    }
+}
+
 void MainThreadManager::clearAndTeardown() {
     if (!_tornDown) {
         _tornDown = true;
-        std::lock_guard<std::mutex> lockGuard(_mutex);
+        std::lock_guard<Mutex> lockGuard(_mutex);
         _pendingTasks.clear();
+        _postponedTasks.clear();
+        _contextsInPostponedRound.clear();
     }
 }
 
-void MainThreadManager::flushTasksWithId(size_t flushId) {
-    while (runNextTaskWithId(flushId)) {
+void MainThreadManager::setFlushBudget(std::chrono::steady_clock::duration flushBudget) {
+    std::lock_guard<Mutex> lockGuard(_mutex);
+    _flushBudget = flushBudget;
+}
+
+void MainThreadManager::flushTasksWithId(size_t flushId, bool canPostpone) {
+    std::unique_lock<Mutex> lock(_mutex);
+    auto deadline = std::chrono::steady_clock::now() + _flushBudget;
+
+    for (;;) {
+        auto overBudget = canPostpone && std::chrono::steady_clock::now() >= deadline;
+        if (!runNextTaskWithId(flushId, lock, overBudget)) {
+            break;
+        }
+        if (!lock.owns_lock()) {
+            lock.lock();
+        }
+    }
+}
+
+void MainThreadManager::schedulePostponedFlushIfNeeded() {
+    if (_postponedFlushScheduled) {
+        return;
+    }
+    _postponedFlushScheduled = true;
+
+    _mainThreadDispatcher->dispatch(
+        new DispatchFunction([self = strongSmallRef(this)]() { self->flushPostponedTasks(); }), false);
+}
+
+void MainThreadManager::flushPostponedTasks() {
+    std::unique_lock<Mutex> lock(_mutex);
+    _postponedFlushScheduled = false;
+    auto deadline = std::chrono::steady_clock::now() + _flushBudget;
+
+    // Tasks are run in rounds, where each round runs the oldest task of every context,
+    // so that the tasks of a context stay in order, but get interleaved with the others.
+    // A round can span multiple flushes.
+    size_t index = 0;
+    while (!_postponedTasks.empty() && !_tornDown) {
+        if (index >= _postponedTasks.size()) {
+            index = 0;
+            _contextsInPostponedRound.clear();
+        }
+
+        if (!_contextsInPostponedRound.insert(_postponedTasks[index].context.get()).second) {
+            index++;
+            continue;
+        }
+
+        auto task = std::move(_postponedTasks[index]);
+        _postponedTasks.erase(_postponedTasks.begin() + static_cast<std::ptrdiff_t>(index));
+        _tasksSequence++;
+        lock.unlock();
+
+        runTask(task);
+
+        lock.lock();
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    if (_postponedTasks.empty()) {
+        _contextsInPostponedRound.clear();
+    } else if (!_tornDown) {
+        schedulePostponedFlushIfNeeded();
     }
 }
 
 void MainThreadManager::beginBatch() {
-    std::lock_guard<std::mutex> lockGuard(_mutex);
+    std::lock_guard<Mutex> lockGuard(_mutex);
 
     _batchCount++;
 }
@@ -150,7 +237,7 @@ void MainThreadManager::endBatch() {
 
     // See if we are the last endBatch() call, otherwise decrement the batchCount
     {
-        std::lock_guard<std::mutex> lockGuard(_mutex);
+        std::lock_guard<Mutex> lockGuard(_mutex);
         SC_ASSERT(_batchCount > 0, "Unbalanced beginBatch() endBatch() call");
         if (_batchCount > 1) {
             // Only the last endBatch() call will flush the TaskQueue
@@ -165,11 +252,11 @@ void MainThreadManager::endBatch() {
         _flushIdSequence++;
     }
 
-    // Flush all pending tasks.
-    flushTasksWithId(flushId);
+    // Flush all pending tasks. The tasks of a batch are meant to be applied together.
+    flushTasksWithId(flushId, false);
 
     // Disable batching
-    std::lock_guard<std::mutex> lockGuard(_mutex);
+    std::lock_guard<Mutex> lockGuard(_mutex);
     SC_ASSERT(_batchCount == 1, "Unbalanced beginBatch() endBatch() call");
     _batchCount = 0;
 
@@ -182,7 +269,7 @@ void MainThreadManager::endBatch() {
 }
 
 void MainThreadManager::onIdle(const Ref<ValueFunction>& callback) {
-    std::lock_guard<std::mutex> lockGuard(_mutex);
+    std::lock_guard<Mutex> lockGuard(_mutex);
     _onIdleCallbacks.emplace_back(callback);
 
     if (!_idleFlushScheduled) {
@@ -203,9 +290,9 @@ void MainThreadManager::flushNextIdleCallback(uint64_t previousTasksSequence) {
     Ref<ValueFunction> callback;
 
     {
-        std::lock_guard<std::mutex> lockGuard(_mutex);
+        std::lock_guard<Mutex> lockGuard(_mutex);
 
-        if (_tasksSequence != previousTasksSequence) {
+        if (_tasksSequence != previousTasksSequence || !_postponedTasks.empty()) {
             // We have pending tasks, something else was scheduled
             // since the idle flush was scheduled
             scheduleFlushIdleCallbacks();
@@ -237,7 +324,7 @@ MainThreadBatch MainThreadManager::scopedBatch() {
 
 // This check only makes sense inside the main thread
 bool MainThreadManager::hasBatch() const {
-    std::lock_guard<std::mutex> lockGuard(_mutex);
+    std::lock_guard<Mutex> lockGuard(_mutex);
     return _batchCount > 0;
 }
 
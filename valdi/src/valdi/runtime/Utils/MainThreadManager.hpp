@@ -10,11 +10,14 @@
 #include "valdi_core/cpp/Interfaces/ILogger.hpp"
 #include "valdi_core/cpp/Interfaces/IMainThreadDispatcher.hpp"
 #include "valdi_core/cpp/Threading/TaskQueue.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/ValueFunction.hpp"
 
 #include "utils/base/NonCopyable.hpp"
 #include <atomic>
+#include <chrono>
 #include <deque>
 #include <mutex>
 #include <thread>
@@ -34,12 +37,30 @@ private:
     MainThreadManager* _manager = nullptr;
 };
 
+enum class MainThreadTaskPriority : uint8_t {
+    /**
+     Tasks run in the order they were dispatched, regardless of how long the flush takes.
+     */
+    Normal = 0,
+    /**
+     Tasks can be postponed to a later main thread tick when the flush they were dispatched
+     in ran out of budget. They run in order relative to each other, but after the Normal
+     tasks dispatched in the meantime. Postponed tasks from different contexts are interleaved,
+     so that one busy context cannot starve the others.
+     */
+    Low,
+};
+
 struct MainThreadTask {
     size_t flushId;
     Ref<Context> context;
     DispatchFunction function;
+    MainThreadTaskPriority priority;
 
-    MainThreadTask(size_t flushId, const Ref<Context>& context, DispatchFunction&& function);
+    MainThreadTask(size_t flushId,
+                   const Ref<Context>& context,
+                   DispatchFunction&& function,
+                   MainThreadTaskPriority priority);
     ~MainThreadTask();
 };
 
@@ -61,6 +82,7 @@ public:
     void postInit();
 
     void dispatch(const Ref<Context>& context, DispatchFunction function);
+    void dispatch(const Ref<Context>& context, DispatchFunction function, MainThreadTaskPriority priority);
     void dispatchSync(const Ref<Context>& context, DispatchFunction function);
 
     void beginBatch();
@@ -74,7 +96,8 @@ public:
     bool hasBatch() const;
 
     /**
-     Schedule a function to be executed when the main thread is idle
+     Schedule a function to be executed when the main thread is idle, which is when
+     a main thread tick went by without any task dispatched or postponed.
      */
     void onIdle(const Ref<ValueFunction>& callback);
 
@@ -89,29 +112,48 @@ public:
 
     bool runNextTask();
 
+    /**
+     Set for how long an asynchronous flush can run before its remaining Low priority tasks
+     get postponed to the next main thread tick.
+     */
+    void setFlushBudget(std::chrono::steady_clock::duration flushBudget);
+
+    static constexpr std::chrono::steady_clock::duration kDefaultFlushBudget = std::chrono::milliseconds(8);
+
 private:
     Ref<IMainThreadDispatcher> _mainThreadDispatcher;
     std::atomic<std::thread::id> _mainThreadId;
     std::atomic_bool _tornDown;
-    mutable std::mutex _mutex;
+    mutable Mutex _mutex{"MainThreadManager"};
     std::deque<MainThreadTask> _pendingTasks;
+    std::deque<MainThreadTask> _postponedTasks;
+    // Only used to identify the contexts, those are retained by the postponed tasks
+    FlatSet<const Context*> _contextsInPostponedRound;
     std::deque<Ref<ValueFunction>> _onIdleCallbacks;
     int _batchCount = 0;
     size_t _flushIdSequence = 0;
     size_t _tasksSequence = 0;
     size_t _batchFlushId = 0;
     bool _idleFlushScheduled = false;
+    bool _postponedFlushScheduled = false;
+    std::chrono::steady_clock::duration _flushBudget = kDefaultFlushBudget;
 
     static bool shouldAllowBatchFromCurrentThread();
 
     void flushNextIdleCallback(uint64_t previousTasksSequence);
     void scheduleFlushIdleCallbacks();
 
-    void flushTasksWithId(size_t flushId);
-    bool runNextTaskWithId(size_t flushId);
-    bool runNextTaskWithId(size_t flushId, std::unique_lock<std::mutex>& lock);
-    void doDispatch(const Ref<Context>& context, DispatchFunction&& function, bool sync);
+    void flushTasksWithId(size_t flushId, bool canPostpone);
+    bool runNextTaskWithId(size_t flushId, std::unique_lock<Mutex>& lock, bool overBudget);
+    void runTask(MainThreadTask& task);
+    void doDispatch(const Ref<Context>& context,
+                    DispatchFunction&& function,
+                    MainThreadTaskPriority priority,
+                    bool sync);
     void scheduleFlush(size_t flushId, bool sync);
+
+    void flushPostponedTasks();
+    void schedulePostponedFlushIfNeeded();
 };
 
 } // namespace Valdi
@@ -0,0 +1,304 @@
+//
+//  PprofExporter.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi/runtime/Utils/PprofExporter.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_protobuf/WireWriter.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define VALDI_PPROF_HAS_DLADDR 1
+#else
+#define VALDI_PPROF_HAS_DLADDR 0
+#endif
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define VALDI_PPROF_HAS_DEMANGLE 1
+#else
+#define VALDI_PPROF_HAS_DEMANGLE 0
+#endif
+
+namespace Valdi {
+
+using Protobuf::FieldNumber;
+using Protobuf::WireWriter;
+
+// Wire types of the Protobuf encoding
+constexpr uint32_t kWireTypeVarint = 0;
+constexpr uint32_t kWireTypeLengthDelimited = 2;
+
+// Field numbers of perftools.profiles.Profile, see
+// https://github.com/google/pprof/blob/main/proto/profile.proto
+namespace ProfileField {
+constexpr FieldNumber kSampleType = 1;
+constexpr FieldNumber kSample = 2;
+constexpr FieldNumber kLocation = 4;
+constexpr FieldNumber kFunction = 5;
+constexpr FieldNumber kStringTable = 6;
+constexpr FieldNumber kDurationNanos = 10;
+constexpr FieldNumber kPeriodType = 11;
+constexpr FieldNumber kPeriod = 12;
+} // namespace ProfileField
+
+namespace ValueTypeField {
+constexpr FieldNumber kType = 1;
+constexpr FieldNumber kUnit = 2;
+} // namespace ValueTypeField
+
+namespace SampleField {
+constexpr FieldNumber kLocationId = 1;
+constexpr FieldNumber kValue = 2;
+constexpr FieldNumber kLabel = 3;
+} // namespace SampleField
+
+namespace LabelField {
+constexpr FieldNumber kKey = 1;
+constexpr FieldNumber kStr = 2;
+} // namespace LabelField
+
+namespace LocationField {
+constexpr FieldNumber kId = 1;
+constexpr FieldNumber kAddress = 3;
+constexpr FieldNumber kLine = 4;
+} // namespace LocationField
+
+namespace LineField {
+constexpr FieldNumber kFunctionId = 1;
+} // namespace LineField
+
+namespace FunctionField {
+constexpr FieldNumber kId = 1;
+constexpr FieldNumber kName = 2;
+constexpr FieldNumber kSystemName = 3;
+constexpr FieldNumber kFilename = 4;
+} // namespace FunctionField
+
+namespace {
+
+struct PprofFunction {
+    int64_t name;
+    int64_t systemName;
+    int64_t filename;
+};
+
+struct PprofLocation {
+    uintptr_t address;
+    // 0 when the address could not be symbolized
+    uint64_t functionId;
+};
+
+class PprofBuilder {
+public:
+    explicit PprofBuilder(ByteBuffer& output) : _writer(output) {
+        // The first string of the table must be the empty string
+        _strings.emplace_back();
+        _stringIndexes[std::string()] = 0;
+    }
+
+    int64_t getStringIndex(const std::string& str) {
+        const auto& it = _stringIndexes.find(str);
+        if (it != _stringIndexes.end()) {
+            return it->second;
+        }
+        auto index = static_cast<int64_t>(_strings.size());
+        _strings.emplace_back(str);
+        _stringIndexes[str] = index;
+        return index;
+    }
+
+    uint64_t getLocationId(uintptr_t address) {
+        const auto& it = _locationIds.find(address);
+        if (it != _locationIds.end()) {
+            return it->second;
+        }
+        auto id = static_cast<uint64_t>(_locations.size() + 1);
+        _locations.emplace_back(PprofLocation{address, symbolize(address)});
+        _locationIds[address] = id;
+        return id;
+    }
+
+    void writeValueType(FieldNumber fieldNumber, const std::string& type, const std::string& unit) {
+        auto typeIndex = getStringIndex(type);
+        auto unitIndex = getStringIndex(unit);
+
+        auto prefix = beginMessage(fieldNumber);
+        writeVarintField(ValueTypeField::kType, static_cast<uint64_t>(typeIndex));
+        writeVarintField(ValueTypeField::kUnit, static_cast<uint64_t>(unitIndex));
+        _writer.endLengthDelimited(prefix);
+    }
+
+    void writeSample(const AllocationSample& sample, uint64_t samplingInterval) {
+        std::vector<uint64_t> locationIds;
+        locationIds.reserve(sample.frames.size());
+        for (auto frame : sample.frames) {
+            locationIds.emplace_back(getLocationId(frame));
+        }
+        auto siteKey = getStringIndex("site");
+        auto site = getStringIndex(allocationSiteToString(sample.site));
+        auto traceScopeKey = getStringIndex("trace_scope");
+        auto traceScope = getStringIndex(sample.traceScope);
+
+        auto prefix = beginMessage(ProfileField::kSample);
+        writePackedVarints(SampleField::kLocationId, locationIds.data(), locationIds.size());
+        uint64_t values[] = {samplingInterval, static_cast<uint64_t>(sample.bytes) * samplingInterval};
+        writePackedVarints(SampleField::kValue, values, 2);
+        writeLabel(siteKey, site);
+        if (!sample.traceScope.empty()) {
+            writeLabel(traceScopeKey, traceScope);
+        }
+        _writer.endLengthDelimited(prefix);
+    }
+
+    void writeLocationsAndFunctions() {
+        for (size_t i = 0; i < _locations.size(); i++) {
+            const auto& location = _locations[i];
+            auto prefix = beginMessage(ProfileField::kLocation);
+            writeVarintField(LocationField::kId, static_cast<uint64_t>(i + 1));
+            writeVarintField(LocationField::kAddress, static_cast<uint64_t>(location.address));
+            if (location.functionId != 0) {
+                auto linePrefix = beginMessage(LocationField::kLine);
+                writeVarintField(LineField::kFunctionId, location.functionId);
+                _writer.endLengthDelimited(linePrefix);
+            }
+            _writer.endLengthDelimited(prefix);
+        }
+
+        for (size_t i = 0; i < _functions.size(); i++) {
+            const auto& function = _functions[i];
+            auto prefix = beginMessage(ProfileField::kFunction);
+            writeVarintField(FunctionField::kId, static_cast<uint64_t>(i + 1));
+            writeVarintField(FunctionField::kName, static_cast<uint64_t>(function.name));
+            writeVarintField(FunctionField::kSystemName, static_cast<uint64_t>(function.systemName));
+            writeVarintField(FunctionField::kFilename, static_cast<uint64_t>(function.filename));
+            _writer.endLengthDelimited(prefix);
+        }
+    }
+
+    void writeStringTable() {
+        static const auto kTag = WireWriter::encodeTag(ProfileField::kStringTable);
+        for (const auto& str : _strings) {
+            _writer.writeTag(kTag, kWireTypeLengthDelimited);
+            _writer.writeLengthDelimited(reinterpret_cast<const Byte*>(str.data()), str.size());
+        }
+    }
+
+    void writeVarintField(FieldNumber fieldNumber, uint64_t value) {
+        if (value == 0) {
+            // Default values are omitted
+            return;
+        }
+        _writer.writeTag(WireWriter::encodeTag(fieldNumber), kWireTypeVarint);
+        _writer.writeVarint(value);
+    }
+
+private:
+    WireWriter _writer;
+    std::vector<std::string> _strings;
+    FlatMap<std::string, int64_t> _stringIndexes;
+    std::vector<PprofLocation> _locations;
+    FlatMap<uintptr_t, uint64_t> _locationIds;
+    std::vector<PprofFunction> _functions;
+    FlatMap<std::string, uint64_t> _functionIds;
+
+    size_t beginMessage(FieldNumber fieldNumber) {
+        _writer.writeTag(WireWriter::encodeTag(fieldNumber), kWireTypeLengthDelimited);
+        return _writer.beginLengthDelimited();
+    }
+
+    void writePackedVarints(FieldNumber fieldNumber, const uint64_t* values, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        auto prefix = beginMessage(fieldNumber);
+        for (size_t i = 0; i < count; i++) {
+            _writer.writeVarint(values[i]);
+        }
+        _writer.endLengthDelimited(prefix);
+    }
+
+    void writeLabel(int64_t key, int64_t str) {
+        auto prefix = beginMessage(SampleField::kLabel);
+        writeVarintField(LabelField::kKey, static_cast<uint64_t>(key));
+        writeVarintField(LabelField::kStr, static_cast<uint64_t>(str));
+        _writer.endLengthDelimited(prefix);
+    }
+
+    uint64_t symbolize(uintptr_t address) {
+#if VALDI_PPROF_HAS_DLADDR
+        Dl_info info;
+        if (dladdr(reinterpret_cast<void*>(address), &info) == 0 || info.dli_sname == nullptr) {
+            return 0;
+        }
+
+        std::string systemName(info.dli_sname);
+        const auto& it = _functionIds.find(systemName);
+        if (it != _functionIds.end()) {
+            return it->second;
+        }
+
+        std::string name = systemName;
+#if VALDI_PPROF_HAS_DEMANGLE
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(systemName.c_str(), nullptr, nullptr, &status);
+        if (demangled != nullptr) {
+            if (status == 0) {
+                name = demangled;
+            }
+            free(demangled); // NOLINT(cppcoreguidelines-no-malloc)
+        }
+#endif
+
+        PprofFunction function;
+        function.name = getStringIndex(name);
+        function.systemName = getStringIndex(systemName);
+        function.filename = info.dli_fname != nullptr ? getStringIndex(std::string(info.dli_fname)) : 0;
+
+        auto id = static_cast<uint64_t>(_functions.size() + 1);
+        _functions.emplace_back(function);
+        _functionIds[systemName] = id;
+        return id;
+#else
+        return 0;
+#endif
+    }
+};
+
+} // namespace
+
+Ref<ByteBuffer> exportAllocationProfileToPprof(const AllocationProfile& profile) {
+    auto output = makeShared<ByteBuffer>();
+    PprofBuilder builder(*output);
+
+    builder.writeValueType(ProfileField::kSampleType, "alloc_objects", "count");
+    builder.writeValueType(ProfileField::kSampleType, "alloc_space", "bytes");
+
+    for (const auto& sample : profile.samples) {
+        builder.writeSample(sample, profile.samplingInterval);
+    }
+
+    builder.writeLocationsAndFunctions();
+
+    builder.writeVarintField(
+        ProfileField::kDurationNanos,
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(profile.period).count()));
+    builder.writeValueType(ProfileField::kPeriodType, "allocations", "count");
+    builder.writeVarintField(ProfileField::kPeriod, profile.samplingInterval);
+
+    // Written last, as every other field may add to it
+    builder.writeStringTable();
+
+    return output;
+}
+
+} // namespace Valdi
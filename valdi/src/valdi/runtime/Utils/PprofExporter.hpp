@@ -0,0 +1,25 @@
+//
+//  PprofExporter.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+namespace Valdi {
+
+struct AllocationProfile;
+
+/**
+ Serialize an allocation profile into an uncompressed pprof profile.proto message, which can
+ be opened with `pprof` once gzipped or as is. Samples are scaled by the sampling interval,
+ and labelled with their allocation site and trace scope. Frames are symbolized in process
+ when the symbols are available.
+ */
+Ref<ByteBuffer> exportAllocationProfileToPprof(const AllocationProfile& profile);
+
+} // namespace Valdi
@@ -104,4 +104,16 @@ bool ValdiRuntimeTweaks::skipProtoIndex() const {
     return getConfigKey("VALDI_PROTO_SKIP_INDEX");
 }
 
+bool ValdiRuntimeTweaks::enableLazyJSArrays() const {
+    return getConfigKey("VALDI_ENABLE_LAZY_JS_ARRAYS");
+}
+
+bool ValdiRuntimeTweaks::enableParallelRasterization() const {
+    return getConfigKey("VALDI_ENABLE_PARALLEL_RASTERIZATION");
+}
+
+bool ValdiRuntimeTweaks::enablePerformanceOverlay() const {
+    return getConfigKey("VALDI_ENABLE_PERFORMANCE_OVERLAY");
+}
+
 } // namespace Valdi
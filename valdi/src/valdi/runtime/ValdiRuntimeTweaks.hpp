@@ -31,6 +31,9 @@ public:
     bool shouldNudgeJSThread() const;
     bool disablePersistentStoreEncryption() const;
     bool skipProtoIndex() const;
+    bool enableLazyJSArrays() const;
+    bool enableParallelRasterization() const;
+    bool enablePerformanceOverlay() const;
 
 private:
     Shared<ITweakValueProvider> _tweakValueProvider;
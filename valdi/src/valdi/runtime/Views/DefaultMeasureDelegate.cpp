@@ -8,10 +8,14 @@
 #include "valdi/runtime/Views/DefaultMeasureDelegate.hpp"
 #include "valdi/runtime/Context/ViewNode.hpp"
 #include "valdi/runtime/Views/View.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
+#include "valdi_core/cpp/Utils/Trace.hpp"
 
 namespace Valdi {
 
-DefaultMeasureDelegate::DefaultMeasureDelegate() = default;
+constexpr size_t kMeasureCacheCapacity = 256;
+
+DefaultMeasureDelegate::DefaultMeasureDelegate() : _measureCache(kMeasureCacheCapacity) {}
 DefaultMeasureDelegate::~DefaultMeasureDelegate() = default;
 
 Size DefaultMeasureDelegate::measure(
@@ -21,7 +25,69 @@ Size DefaultMeasureDelegate::measure(
         return Valdi::Size();
     }
 
-    return onMeasure(layoutAttributes.value(), width, widthMode, height, heightMode, viewNode.isRightToLeft());
+    auto attributesHash = MeasureCacheKey::hashAttributes(*layoutAttributes.value());
+    MeasureCacheKey key(layoutAttributes.moveValue(),
+                        attributesHash,
+                        width,
+                        widthMode,
+                        height,
+                        heightMode,
+                        viewNode.isRightToLeft());
+
+    auto cachedSize = _measureCache.find(key);
+    if (cachedSize) {
+        return cachedSize.value();
+    }
+
+    auto size = onMeasure(key.attributes, width, widthMode, height, heightMode, key.isRightToLeft);
+    _measureCache.insert(std::move(key), size);
+
+    return size;
+}
+
+void DefaultMeasureDelegate::prelayout(
+    ViewNode& viewNode, float width, MeasureMode widthMode, float height, MeasureMode heightMode) {
+    auto layoutAttributes = viewNode.copyProcessedViewLayoutAttributes();
+    if (!layoutAttributes) {
+        return;
+    }
+
+    auto attributesHash = MeasureCacheKey::hashAttributes(*layoutAttributes.value());
+    MeasureCacheKey key(layoutAttributes.moveValue(),
+                        attributesHash,
+                        width,
+                        widthMode,
+                        height,
+                        heightMode,
+                        viewNode.isRightToLeft());
+
+    if (_measureCache.find(key)) {
+        return;
+    }
+
+    ThreadPool::getShared()->submit([self = strongSmallRef(this), key = std::move(key)]() mutable {
+        if (self->_measureCache.find(key)) {
+            return;
+        }
+
+        VALDI_TRACE("Valdi.prelayoutNode");
+        auto size =
+            self->onMeasure(key.attributes, key.width, key.widthMode, key.height, key.heightMode, key.isRightToLeft);
+        self->_measureCache.insert(std::move(key), size);
+    });
+}
+
+void DefaultMeasureDelegate::onMeasuredSizeInvalidated(ViewNode& viewNode) {
+    auto layoutAttributes = viewNode.copyProcessedViewLayoutAttributes();
+    if (!layoutAttributes) {
+        return;
+    }
+
+    _measureCache.remove(layoutAttributes.value());
+}
+
+void DefaultMeasureDelegate::clearMeasureCache() {
+    _measureCache.clear();
 }
 
 } // namespace Valdi
@@ -7,12 +7,19 @@
 
 #pragma once
 
+#include "valdi/runtime/Views/MeasureCache.hpp"
 #include "valdi/runtime/Views/MeasureDelegate.hpp"
 
 namespace Valdi {
 
 class View;
 
+/**
+ A MeasureDelegate which measures from the processed layout attributes of the node.
+ Since the measured size only depends on the attributes and the constraints, the results
+ are cached so that nodes with identical attributes, like recycled cells, skip onMeasure().
+ onMeasure() can be called from any thread.
+ */
 class DefaultMeasureDelegate : public MeasureDelegate {
 public:
     DefaultMeasureDelegate();
@@ -20,12 +27,25 @@ public:
 
     Size measure(ViewNode& viewNode, float width, MeasureMode widthMode, float height, MeasureMode heightMode) final;
 
+    void onMeasuredSizeInvalidated(ViewNode& viewNode) final;
+
+    /**
+     Measure the node from a worker thread of the shared ThreadPool and store the result
+     in the measure cache, unless it is already there.
+     */
+    void prelayout(ViewNode& viewNode, float width, MeasureMode widthMode, float height, MeasureMode heightMode) final;
+
+    void clearMeasureCache();
+
     virtual Valdi::Size onMeasure(const Valdi::Ref<Valdi::ValueMap>& attributes,
                                   float width,
                                   Valdi::MeasureMode widthMode,
                                   float height,
                                   Valdi::MeasureMode heightMode,
                                   bool isRightToLeft) = 0;
+
+private:
+    MeasureCache _measureCache;
 };
 
 } // namespace Valdi
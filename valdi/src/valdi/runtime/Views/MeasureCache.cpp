@@ -0,0 +1,126 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi/runtime/Views/MeasureCache.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+
+#include <boost/functional/hash.hpp>
+#include <vector>
+
+namespace Valdi {
+
+static float resolveConstraint(float size, MeasureMode mode) {
+    // The size is meaningless and often NaN when unspecified
+    return mode == MeasureModeUnspecified ? 0.0f : size;
+}
+
+MeasureCacheKey::MeasureCacheKey(Ref<ValueMap> attributes,
+                                 size_t attributesHash,
+                                 float width,
+                                 MeasureMode widthMode,
+                                 float height,
+                                 MeasureMode heightMode,
+                                 bool isRightToLeft)
+    : attributes(std::move(attributes)),
+      attributesHash(attributesHash),
+      width(resolveConstraint(width, widthMode)),
+      widthMode(widthMode),
+      height(resolveConstraint(height, heightMode)),
+      heightMode(heightMode),
+      isRightToLeft(isRightToLeft) {}
+
+bool MeasureCacheKey::operator==(const MeasureCacheKey& other) const {
+    if (attributesHash != other.attributesHash || width != other.width || widthMode != other.widthMode ||
+        height != other.height || heightMode != other.heightMode || isRightToLeft != other.isRightToLeft) {
+        return false;
+    }
+
+    if (attributes == other.attributes) {
+        return true;
+    }
+    if (attributes == nullptr || other.attributes == nullptr) {
+        return false;
+    }
+
+    return Value(attributes) == Value(other.attributes);
+}
+
+bool MeasureCacheKey::operator!=(const MeasureCacheKey& other) const {
+    return !(*this == other);
+}
+
+size_t MeasureCacheKey::hash() const {
+    auto hash = attributesHash;
+    boost::hash_combine(hash, width);
+    boost::hash_combine(hash, static_cast<int>(widthMode));
+    boost::hash_combine(hash, height);
+    boost::hash_combine(hash, static_cast<int>(heightMode));
+    boost::hash_combine(hash, isRightToLeft);
+    return hash;
+}
+
+size_t MeasureCacheKey::hashAttributes(const ValueMap& attributes) {
+    size_t hash = attributes.size();
+    for (const auto& it : attributes) {
+        size_t entryHash = it.first.hash();
+        boost::hash_combine(entryHash, it.second.hash());
+        // Summing keeps the hash independent from the iteration order
+        hash += entryHash;
+    }
+    return hash;
+}
+
+MeasureCache::MeasureCache(size_t capacity) : _cache(capacity) {}
+MeasureCache::~MeasureCache() = default;
+
+std::optional<Size> MeasureCache::find(const MeasureCacheKey& key) {
+    std::lock_guard<Mutex> guard(_mutex);
+    auto it = _cache.find(key);
+    if (it == _cache.end()) {
+        return std::nullopt;
+    }
+    return {it->value()};
+}
+
+void MeasureCache::insert(MeasureCacheKey key, Size size) {
+    std::lock_guard<Mutex> guard(_mutex);
+    _cache.insert(std::move(key), std::move(size));
+}
+
+void MeasureCache::remove(const Ref<ValueMap>& attributes) {
+    auto attributesHash = MeasureCacheKey::hashAttributes(*attributes);
+    Value attributesValue(attributes);
+
+    std::lock_guard<Mutex> guard(_mutex);
+    std::vector<MeasureCacheKey> keysToRemove;
+    for (const auto& node : _cache) {
+        const auto& key = node->key();
+        if (key.attributesHash == attributesHash && key.attributes != nullptr &&
+            Value(key.attributes) == attributesValue) {
+            keysToRemove.emplace_back(key);
+        }
+    }
+
+    for (const auto& key : keysToRemove) {
+        _cache.remove(key);
+    }
+}
+
+void MeasureCache::clear() {
+    std::lock_guard<Mutex> guard(_mutex);
+    _cache.clear();
+}
+
+size_t MeasureCache::size() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    return _cache.size();
+}
+
+} // namespace Valdi
+
+namespace std {
+
+std::size_t hash<Valdi::MeasureCacheKey>::operator()(const Valdi::MeasureCacheKey& k) const noexcept {
+    return k.hash();
+}
+
+} // namespace std
@@ -0,0 +1,88 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi/runtime/Views/Frame.hpp"
+#include "valdi/runtime/Views/Measure.hpp"
+
+#include "valdi_core/cpp/Utils/LRUCache.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/ValueMap.hpp"
+
+#include <optional>
+
+namespace Valdi {
+
+/**
+ * Identifies a measure request: the processed layout attributes of a node with the constraints
+ * given by the layout engine. The attributes hash does not depend on the map iteration order.
+ */
+struct MeasureCacheKey {
+    Ref<ValueMap> attributes;
+    size_t attributesHash = 0;
+    float width = 0.0f;
+    MeasureMode widthMode = MeasureModeUnspecified;
+    float height = 0.0f;
+    MeasureMode heightMode = MeasureModeUnspecified;
+    bool isRightToLeft = false;
+
+    MeasureCacheKey() = default;
+    MeasureCacheKey(Ref<ValueMap> attributes,
+                    size_t attributesHash,
+                    float width,
+                    MeasureMode widthMode,
+                    float height,
+                    MeasureMode heightMode,
+                    bool isRightToLeft);
+
+    bool operator==(const MeasureCacheKey& other) const;
+    bool operator!=(const MeasureCacheKey& other) const;
+
+    size_t hash() const;
+
+    static size_t hashAttributes(const ValueMap& attributes);
+};
+
+} // namespace Valdi
+
+namespace std {
+
+template<>
+struct hash<Valdi::MeasureCacheKey> {
+    std::size_t operator()(const Valdi::MeasureCacheKey& k) const noexcept;
+};
+
+} // namespace std
+
+namespace Valdi {
+
+/**
+ * A thread safe LRU cache of measured sizes, used by a MeasureDelegate to avoid
+ * calling the platform measure for nodes which have identical layout attributes
+ * and constraints, which is common in recycled list cells.
+ */
+class MeasureCache {
+public:
+    explicit MeasureCache(size_t capacity);
+    ~MeasureCache();
+
+    std::optional<Size> find(const MeasureCacheKey& key);
+    void insert(MeasureCacheKey key, Size size);
+
+    /**
+     * Remove all the measured sizes for the given attributes, regardless of the constraints.
+     * Should be called when the content backing the attributes changed without the attributes
+     * themselves changing, for instance when an image finished loading.
+     */
+    void remove(const Ref<ValueMap>& attributes);
+
+    void clear();
+
+    size_t size() const;
+
+private:
+    mutable Mutex _mutex;
+    LRUCache<MeasureCacheKey, Size> _cache;
+};
+
+} // namespace Valdi
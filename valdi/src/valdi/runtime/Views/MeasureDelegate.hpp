@@ -20,6 +20,22 @@ class MeasureDelegate : public SimpleRefCountable {
 public:
     virtual Size measure(
         ViewNode& viewNode, float width, MeasureMode widthMode, float height, MeasureMode heightMode) = 0;
+
+    /**
+     Called when the measured size of the given node was invalidated while its attributes did not change.
+     */
+    virtual void onMeasuredSizeInvalidated(ViewNode& /*viewNode*/) {}
+
+    /**
+     Called ahead of time for nodes which are about to become visible, with the constraints
+     that the node will likely be measured with. Implementations can measure the node
+     asynchronously and store the result so that the upcoming measure() call is cheaper.
+     */
+    virtual void prelayout(ViewNode& /*viewNode*/,
+                           float /*width*/,
+                           MeasureMode /*widthMode*/,
+                           float /*height*/,
+                           MeasureMode /*heightMode*/) {}
 };
 
 } // namespace Valdi
@@ -8,6 +8,7 @@
 #include "valdi/runtime/Views/ViewFactory.hpp"
 #include "valdi/runtime/Attributes/BoundAttributes.hpp"
 #include "valdi/runtime/Interfaces/IViewManager.hpp"
+#include "valdi_core/cpp/Utils/PerfCounters.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
 
 namespace Valdi {
@@ -37,6 +38,7 @@ Ref<View> ViewFactory::createView(ViewNodeTree* viewNodeTree, ViewNode* viewNode
     }
 
     VALDI_TRACE_META("Valdi.createView", _viewClassName);
+    PerfCounters::increment(PerfCounterType::ViewsInflated);
     return doCreateView(viewNodeTree, viewNode);
 }
 
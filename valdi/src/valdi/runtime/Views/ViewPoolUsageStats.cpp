@@ -0,0 +1,38 @@
+// Copyright © 2026 Snap, Inc. All rights reserved.
+
+#include "valdi/runtime/Views/ViewPoolUsageStats.hpp"
+#include "valdi/runtime/Context/ViewNodeViewStats.hpp"
+
+#include <algorithm>
+
+namespace Valdi {
+
+ViewPoolUsageStats::ViewPoolUsageStats() = default;
+ViewPoolUsageStats::~ViewPoolUsageStats() = default;
+
+void ViewPoolUsageStats::recordUsage(const StringBox& screenName, const ViewNodeViewStats& viewStats) {
+    std::lock_guard<Mutex> lock(_mutex);
+    auto& peakUsage = _peakUsageByScreenName[screenName];
+
+    for (const auto& it : viewStats.getNumberOfViewsByViewClass()) {
+        auto& peak = peakUsage[it.first];
+        peak = std::max(peak, it.second);
+    }
+}
+
+ViewCountByViewClass ViewPoolUsageStats::getPeakUsage(const StringBox& screenName) const {
+    std::lock_guard<Mutex> lock(_mutex);
+    const auto& it = _peakUsageByScreenName.find(screenName);
+    if (it == _peakUsageByScreenName.end()) {
+        return {};
+    }
+
+    return it->second;
+}
+
+void ViewPoolUsageStats::clear() {
+    std::lock_guard<Mutex> lock(_mutex);
+    _peakUsageByScreenName.clear();
+}
+
+} // namespace Valdi
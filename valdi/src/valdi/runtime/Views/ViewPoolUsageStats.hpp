@@ -0,0 +1,45 @@
+// Copyright © 2026 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+namespace Valdi {
+
+class ViewNodeViewStats;
+
+using ViewCountByViewClass = FlatMap<StringBox, size_t>;
+
+/**
+ Records, for each screen, the peak number of views of each view class that
+ the screen had inflated. This is used to preload the views that a screen is
+ likely to need before it renders again.
+ */
+class ViewPoolUsageStats : public SimpleRefCountable {
+public:
+    ViewPoolUsageStats();
+    ~ViewPoolUsageStats() override;
+
+    /**
+     Record the views that the given screen has inflated, keeping for each view class
+     the highest number of views seen so far.
+     */
+    void recordUsage(const StringBox& screenName, const ViewNodeViewStats& viewStats);
+
+    /**
+     Returns the peak number of views of each view class for the given screen,
+     or an empty map if no usage was recorded for it.
+     */
+    ViewCountByViewClass getPeakUsage(const StringBox& screenName) const;
+
+    void clear();
+
+private:
+    FlatMap<StringBox, ViewCountByViewClass> _peakUsageByScreenName;
+    mutable Mutex _mutex;
+};
+
+} // namespace Valdi
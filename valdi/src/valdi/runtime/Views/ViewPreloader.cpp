@@ -68,7 +68,7 @@ void ViewPreloader::schedulePreload() {
     if (_workQueue != nullptr) {
         _workQueue->async([=]() { strongThis->preload(); });
     } else {
-        _mainThreadManager.dispatch(nullptr, [=]() { strongThis->preload(); });
+        _mainThreadManager.dispatch(nullptr, [=]() { strongThis->preload(); }, MainThreadTaskPriority::Low);
     }
 }
 
@@ -16,11 +16,25 @@
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 
+#include "utils/time/StopWatch.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+
 // TODO(rjaber): The cached shaders are only ever valid if SnapDrawing and Skia don't change. The moment there's any
 //               change, we need to invalidate the cache. There isn't a suitable mechanism for this; this value is
 //               currently used as a stand-in until we have a more reliable mechanism.
 static const int kShaderCacheVersion = 1;
 
+// The usage profile is an archive of the keys of the recently used shaders, by shader file name
+static constexpr std::string_view kUsageProfileFileName = "usage_profile";
+static const size_t kMaxUsageProfileShadersCount = 256;
+// Preloading happens in the background, the budget bounds the disk reads done at startup
+static const double kUsageProfilePreloadBudgetMs = 500;
+// Delay after the first newly used shader before the profile is written, to batch the writes
+static const std::chrono::seconds kUsageProfileWriteDelay = std::chrono::seconds(5);
+
 using namespace Valdi;
 
 namespace snap::drawing {
@@ -111,6 +125,11 @@ void ShaderCache::store(const SkData& key, const SkData& data) {
     auto dataByteView = dataResult.moveValue();
     auto keyByteView = ownedKeyResult.moveValue();
 
+    auto fileNameResult = keyToFileName(keyByteView);
+    if (fileNameResult) {
+        recordUsage(fileNameResult.value().toStringBox(), keyByteView);
+    }
+
     auto weakThis = weakRef(this);
     _queue->async([weakThis, dataByteView, keyByteView]() {
         auto strongThis = weakThis.lock();
@@ -122,10 +141,33 @@ void ShaderCache::store(const SkData& key, const SkData& data) {
 
 sk_sp<SkData> ShaderCache::load(const SkData& key) {
     auto keyByteViewUnowned = Valdi::BytesView(nullptr, static_cast<const Byte*>(key.data()), key.size());
-    auto loadResult = loadShaderFromDisk(keyByteViewUnowned);
+    auto keyFilePathResult = keyToFileName(keyByteViewUnowned);
+    if (keyFilePathResult.failure()) {
+        return nullptr;
+    }
+    auto fileName = keyFilePathResult.value().toStringBox();
+
+    std::optional<BytesView> preloadedData;
+    {
+        std::lock_guard<Valdi::Mutex> guard(_mutex);
+        auto it = _preloadedShaders.find(fileName);
+        if (it != _preloadedShaders.end()) {
+            // Skia keeps the compiled program once loaded, the preloaded data won't be needed again
+            preloadedData = it->second.data;
+            _preloadedShaders.erase(it);
+        }
+    }
+
+    auto loadResult =
+        preloadedData ? Result<BytesView>(preloadedData.value()) : loadShaderFromDisk(keyByteViewUnowned);
     if (loadResult.failure()) {
         return nullptr;
     } else {
+        auto ownedKeyResult = skDataToByteView(key);
+        if (ownedKeyResult) {
+            recordUsage(fileName, ownedKeyResult.value());
+        }
+
         auto result = loadResult.moveValue();
         // TODO(rjaber): Data copy is temporary; Skia expects the returned SkData pointer to be 4 bytes aligned. By
         //               doing the copy, we rely on SkData being correctly aligned on creation.
@@ -133,4 +175,149 @@ sk_sp<SkData> ShaderCache::load(const SkData& key) {
     }
 }
 
+std::vector<ShaderCacheEntry> ShaderCache::getWarmUpShaders() {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+
+    std::vector<ShaderCacheEntry> output;
+    output.reserve(_preloadedShaders.size());
+
+    for (const auto& fileName : _preloadedShaderFileNames) {
+        auto it = _preloadedShaders.find(fileName);
+        if (it == _preloadedShaders.end()) {
+            continue;
+        }
+
+        auto& entry = output.emplace_back();
+        entry.key = snap::drawing::skDataFromBytes(it->second.key, snap::drawing::DataConversionModeAlwaysCopy);
+        entry.data = snap::drawing::skDataFromBytes(it->second.data, snap::drawing::DataConversionModeAlwaysCopy);
+    }
+
+    return output;
+}
+
+void ShaderCache::preloadUsageProfile() {
+    auto weakThis = weakRef(this);
+    _queue->async([weakThis]() {
+        auto strongThis = weakThis.lock();
+        if (strongThis) {
+            strongThis->doPreloadUsageProfile();
+        }
+    });
+}
+
+void ShaderCache::doPreloadUsageProfile() {
+    auto profilePath = Path(kUsageProfileFileName);
+    if (!_diskCache->exists(profilePath)) {
+        return;
+    }
+
+    auto profileResult = _diskCache->load(profilePath);
+    if (profileResult.failure()) {
+        VALDI_ERROR(_logger, "Failed to load shader usage profile: {}", profileResult.error());
+        return;
+    }
+    auto profileBytes = profileResult.moveValue();
+
+    ValdiArchive archive(profileBytes.data(), profileBytes.data() + profileBytes.size());
+    auto entriesResult = archive.getEntries();
+    if (entriesResult.failure()) {
+        VALDI_ERROR(_logger, "Failed to parse shader usage profile: {}", entriesResult.error());
+        _diskCache->remove(profilePath);
+        return;
+    }
+
+    snap::utils::time::StopWatch sw;
+    sw.start();
+
+    // The most recently used shaders are at the end of the profile
+    const auto& entries = entriesResult.value();
+    size_t preloadedCount = 0;
+    for (auto it = entries.rbegin(); it != entries.rend(); it++) {
+        if (sw.elapsed().milliseconds() >= kUsageProfilePreloadBudgetMs) {
+            VALDI_WARN(_logger, "Preloaded {} shaders out of {} within budget", preloadedCount, entries.size());
+            break;
+        }
+
+        auto key = Valdi::makeShared<Valdi::ByteBuffer>(it->data, it->data + it->dataLength)->toBytesView();
+        auto dataResult = loadShaderFromDisk(key);
+        if (dataResult.failure()) {
+            // Evicted since the profile was written
+            continue;
+        }
+
+        std::lock_guard<Valdi::Mutex> guard(_mutex);
+        if (_preloadedShaders.find(it->filePath) == _preloadedShaders.end()) {
+            _preloadedShaders[it->filePath] = PreloadedShader{key, dataResult.value()};
+            _preloadedShaderFileNames.emplace_back(it->filePath);
+            preloadedCount++;
+        }
+    }
+
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    // Warm up in the order the shaders were first used
+    std::reverse(_preloadedShaderFileNames.begin(), _preloadedShaderFileNames.end());
+
+    // Keep the shaders of the previous sessions in the profile, this session appends to them
+    std::vector<std::pair<StringBox, BytesView>> usageProfile;
+    for (const auto& fileName : _preloadedShaderFileNames) {
+        if (_usageProfileFileNames.find(fileName) == _usageProfileFileNames.end()) {
+            usageProfile.emplace_back(fileName, _preloadedShaders[fileName].key);
+        }
+    }
+    usageProfile.insert(usageProfile.end(), _usageProfile.begin(), _usageProfile.end());
+    _usageProfile = std::move(usageProfile);
+    for (const auto& fileName : _preloadedShaderFileNames) {
+        _usageProfileFileNames.insert(fileName);
+    }
+    while (_usageProfile.size() > kMaxUsageProfileShadersCount) {
+        _usageProfileFileNames.erase(_usageProfile.front().first);
+        _usageProfile.erase(_usageProfile.begin());
+    }
+}
+
+void ShaderCache::recordUsage(const StringBox& fileName, const BytesView& key) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    if (!_usageProfileFileNames.insert(fileName).second) {
+        return;
+    }
+
+    _usageProfile.emplace_back(fileName, key);
+    if (_usageProfile.size() > kMaxUsageProfileShadersCount) {
+        _usageProfileFileNames.erase(_usageProfile.front().first);
+        _usageProfile.erase(_usageProfile.begin());
+    }
+
+    if (_usageProfileWriteScheduled) {
+        return;
+    }
+    _usageProfileWriteScheduled = true;
+
+    auto weakThis = weakRef(this);
+    _queue->asyncAfter(
+        [weakThis]() {
+            auto strongThis = weakThis.lock();
+            if (strongThis) {
+                strongThis->writeUsageProfile();
+            }
+        },
+        kUsageProfileWriteDelay);
+}
+
+void ShaderCache::writeUsageProfile() {
+    ValdiArchiveBuilder builder;
+    {
+        std::lock_guard<Valdi::Mutex> guard(_mutex);
+        _usageProfileWriteScheduled = false;
+
+        for (const auto& [fileName, key] : _usageProfile) {
+            builder.addEntry(ValdiArchiveEntry(fileName, key.data(), key.size()));
+        }
+    }
+
+    auto storeResult = _diskCache->store(Path(kUsageProfileFileName), builder.build()->toBytesView());
+    if (storeResult.failure()) {
+        VALDI_ERROR(_logger, "Failed to store shader usage profile with error {}", storeResult.error());
+    }
+}
+
 } // namespace snap::drawing
@@ -14,6 +14,8 @@
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/FlatSet.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 #include "valdi_core/cpp/Utils/Void.hpp"
 
@@ -28,14 +30,39 @@ public:
 
     sk_sp<SkData> load(const SkData& key) override;
     void store(const SkData& key, const SkData& data) override;
+    std::vector<ShaderCacheEntry> getWarmUpShaders() override;
+
+    /**
+     Asynchronously load the usage profile written by the previous sessions, along with the shaders
+     it references, so that they can be compiled ahead of time and served without disk reads.
+     */
+    void preloadUsageProfile();
 
 private:
+    struct PreloadedShader {
+        Valdi::BytesView key;
+        Valdi::BytesView data;
+    };
+
     Valdi::Result<Valdi::BytesView> loadShaderFromDisk(const Valdi::BytesView& keyData) const;
     void storeShaderToDisk(const Valdi::BytesView& key, const Valdi::BytesView& data) const;
 
+    void doPreloadUsageProfile();
+    void recordUsage(const Valdi::StringBox& fileName, const Valdi::BytesView& key);
+    void writeUsageProfile();
+
     [[maybe_unused]] Valdi::ILogger& _logger;
     Valdi::Ref<Valdi::DispatchQueue> _queue;
     Valdi::Ref<Valdi::IDiskCache> _diskCache;
+
+    Valdi::Mutex _mutex;
+    // Shaders of the usage profile loaded ahead of their first use, by file name
+    Valdi::FlatMap<Valdi::StringBox, PreloadedShader> _preloadedShaders;
+    std::vector<Valdi::StringBox> _preloadedShaderFileNames;
+    // File names and keys of the shaders used by this session and the previous ones, oldest first
+    std::vector<std::pair<Valdi::StringBox, Valdi::BytesView>> _usageProfile;
+    Valdi::FlatSet<Valdi::StringBox> _usageProfileFileNames;
+    bool _usageProfileWriteScheduled = false;
 };
 
 } // namespace snap::drawing
@@ -69,6 +69,25 @@ static ScalingResult findScaledDimensions(int imageWidth, int imageHeight, int t
     return ScalingResult(newWidth, newHeight, scalingFactorFloat);
 }
 
+/**
+ Whether the given cached original can produce an image for the target dimensions.
+ Originals which were decoded at a reduced size cannot be upscaled back and need to be
+ decoded again from their source once a larger size is requested.
+ */
+static bool canProvideDimensions(ImageCacheItem& cachedItem, int targetWidth, int targetHeight) {
+    if (!cachedItem.isDownsampled()) {
+        return true;
+    }
+    if (targetWidth == 0 && targetHeight == 0) {
+        return false;
+    }
+    if (targetWidth >= targetHeight) {
+        return cachedItem.getWidth() >= targetWidth;
+    } else {
+        return cachedItem.getHeight() >= targetHeight;
+    }
+}
+
 ImageCache::ImageCache(Valdi::ILogger& logger, size_t maxSizeInBytes)
     : _maxSizeInBytes(maxSizeInBytes),
       _currentSize(0),
@@ -86,7 +105,7 @@ Valdi::Result<CachedImage> ImageCache::getResizedCachedImage(const String& url,
                                                              int preferredHeight) {
     Valdi::Result<CachedImage> result;
     auto it = _cache.find(url);
-    if (it == _cache.end()) {
+    if (it == _cache.end() || !canProvideDimensions(*it->second, preferredWidth, preferredHeight)) {
         result = Valdi::Error("not found");
     } else {
         result = getResizedImage(url, it->second, preferredWidth, preferredHeight);
@@ -98,6 +117,10 @@ size_t ImageCache::getCurrentSize() const {
     return _currentSize;
 }
 
+size_t ImageCache::getMaxSize() const {
+    return _maxSizeInBytes;
+}
+
 CachedImage ImageCache::getResizedImage(const String& url,
                                         Ref<ImageCacheItem>& cachedItem,
                                         int preferredWidth,
@@ -133,7 +156,53 @@ CachedImage ImageCache::getResizedImage(const String& url,
         invalidateCachedItems(EvictionPolicy::Memory);
     }
 
-    return CachedImage(returnImage, scalingFactor);
+    // The scale is relative to the source of the image, which is larger than the cached original
+    // when it was decoded at a reduced size.
+    return CachedImage(returnImage, scalingFactor * cachedItem->getDownsampleScale());
+}
+
+String ImageCache::makeFilteredUrl(const String& url, const Ref<Image>& image, const String& filterSignature) {
+    return url.append(STRING_FORMAT(
+        "&com.valdi.dimensions={},{};&com.valdi.filter={};", image->width(), image->height(), filterSignature));
+}
+
+Ref<Image> ImageCache::getFilteredCachedImage(const String& url,
+                                              const Ref<Image>& image,
+                                              const String& filterSignature) {
+    auto it = _cache.find(makeFilteredUrl(url, image, filterSignature));
+    if (it == _cache.end()) {
+        return nullptr;
+    }
+
+    return retrieveImage(it->second);
+}
+
+Ref<Image> ImageCache::setFilteredCachedImage(const String& url,
+                                              const Ref<Image>& image,
+                                              const String& filterSignature,
+                                              const Ref<Image>& filteredImage) {
+    auto filteredUrl = makeFilteredUrl(url, image, filterSignature);
+    auto it = _cache.find(filteredUrl);
+    if (it != _cache.end()) {
+        return retrieveImage(it->second);
+    }
+
+    // The original might have been evicted while the filter was being applied
+    auto originalIt = _cache.find(url);
+    if (originalIt == _cache.end()) {
+        return filteredImage;
+    }
+
+    auto filteredCachedItem = originalIt->second->makeVariant(filteredUrl, filteredImage);
+    _cacheListStart->insertAfter(filteredCachedItem);
+    _cache[filteredUrl] = filteredCachedItem;
+    _currentSize += filteredCachedItem->getImageSizeInBytes();
+
+    if (_currentSize > _maxSizeInBytes) {
+        invalidateCachedItems(EvictionPolicy::Memory);
+    }
+
+    return filteredImage;
 }
 
 void ImageCache::setMaxAge(uint64_t maxAgeSeconds) {
@@ -162,6 +231,14 @@ Ref<ImageCacheItem> ImageCache::tryRemoveOriginalImage(Ref<ImageCacheItem>& cach
 }
 
 void ImageCache::invalidateCachedItems(EvictionPolicy policy) {
+    invalidateCachedItems(policy, _maxSizeInBytes);
+}
+
+void ImageCache::trimToSize(size_t sizeInBytes) {
+    invalidateCachedItems(EvictionPolicy::Memory, sizeInBytes);
+}
+
+void ImageCache::invalidateCachedItems(EvictionPolicy policy, size_t maxSizeInBytes) {
     VALDI_TRACE("Valdi.invalidateCachedItems");
     const bool enableTimeExit = (policy == EvictionPolicy::Time) || (policy == EvictionPolicy::Both);
     const bool enableSizeExit = (policy == EvictionPolicy::Memory) || (policy == EvictionPolicy::Both);
@@ -175,7 +252,7 @@ void ImageCache::invalidateCachedItems(EvictionPolicy policy) {
         if (enableTimeExit && !it->isExpired(pastTime)) {
             break;
         }
-        if (enableSizeExit && (_currentSize <= _maxSizeInBytes)) {
+        if (enableSizeExit && (_currentSize <= maxSizeInBytes)) {
             break;
         }
 
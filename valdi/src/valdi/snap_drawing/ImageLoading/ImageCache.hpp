@@ -15,6 +15,8 @@
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 
+#include <atomic>
+
 namespace snap::drawing {
 
 class Image;
@@ -44,15 +46,39 @@ public:
                                                                int preferredWidth,
                                                                int preferredHeight);
 
+    /**
+     Returns the cached result of applying the filter with the given signature to the given image,
+     which was returned by this cache for the given url, or nullptr if it was not cached.
+     */
+    Ref<Image> getFilteredCachedImage(const String& url, const Ref<Image>& image, const String& filterSignature);
+
+    /**
+     Cache the result of applying the filter with the given signature to the given image, which was
+     returned by this cache for the given url. The filtered image is kept as a variant of the original
+     image of the url. Returns the cached filtered image, which is the given one unless it was already cached.
+     */
+    Ref<Image> setFilteredCachedImage(const String& url,
+                                      const Ref<Image>& image,
+                                      const String& filterSignature,
+                                      const Ref<Image>& filteredImage);
+
     void invalidateCachedItems(EvictionPolicy policy);
 
+    /**
+     Evict the least recently used images which are not in use until the cache
+     holds at most the given size.
+     */
+    void trimToSize(size_t sizeInBytes);
+
     void setMaxAge(uint64_t maxAgeSeconds);
     int getVariantCount(const String& url) const;
     size_t getCurrentSize() const;
+    size_t getMaxSize() const;
 
 private:
     const size_t _maxSizeInBytes;
-    size_t _currentSize;
+    // Read from any thread to report the memory usage
+    std::atomic<size_t> _currentSize;
     snap::utils::time::Duration<std::chrono::steady_clock> _maxAgeMicroSeconds;
     [[maybe_unused]] Valdi::ILogger& _logger;
 
@@ -64,6 +90,9 @@ private:
                                                snap::utils::time::Duration<std::chrono::steady_clock> pastTime,
                                                bool enableTimeExit);
     Ref<Image> retrieveImage(Ref<ImageCacheItem>& cachedItem);
+    void invalidateCachedItems(EvictionPolicy policy, size_t maxSizeInBytes);
+
+    static String makeFilteredUrl(const String& url, const Ref<Image>& image, const String& filterSignature);
 
     CachedImage getResizedImage(const String& url,
                                 Ref<ImageCacheItem>& cachedItem,
@@ -87,10 +87,22 @@ int ImageCacheItem::getHeight() const {
     return _image->height();
 }
 
+bool ImageCacheItem::isDownsampled() const {
+    return _image->isDownsampled();
+}
+
+float ImageCacheItem::getDownsampleScale() const {
+    return _image->getDownsampleScale();
+}
+
 Valdi::Ref<ImageCacheItem> ImageCacheItem::getResized(const String& url, int width, int height) {
+    return makeVariant(url, _image->resized(width, height));
+}
+
+Valdi::Ref<ImageCacheItem> ImageCacheItem::makeVariant(const String& url, const Valdi::Ref<Image>& image) {
     _variants++;
     auto strongRef = Valdi::strongSmallRef(this);
-    return Valdi::makeShared<ImageCacheItem>(url, strongRef, _image->resized(width, height));
+    return Valdi::makeShared<ImageCacheItem>(url, strongRef, image);
 }
 
 bool ImageCacheItem::isExpired(snap::utils::time::Duration<std::chrono::steady_clock> time) const {
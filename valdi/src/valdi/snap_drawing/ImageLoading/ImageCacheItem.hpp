@@ -38,7 +38,14 @@ public:
 
     int getHeight() const;
 
+    /**
+     Whether the image held by this item was decoded at a lower resolution than its source.
+     */
+    bool isDownsampled() const;
+    float getDownsampleScale() const;
+
     Ref<ImageCacheItem> getResized(const String& url, int width, int height);
+    Ref<ImageCacheItem> makeVariant(const String& url, const Ref<Image>& image);
 
     bool isExpired(snap::utils::time::Duration<std::chrono::steady_clock> time) const;
 
@@ -0,0 +1,92 @@
+//
+//  ImageDiskCache.cpp
+//  valdi-snap_drawing
+//
+
+#include "valdi/snap_drawing/ImageLoading/ImageDiskCache.hpp"
+
+#include "snap_drawing/cpp/Utils/Image.hpp"
+#include "valdi/runtime/Utils/BytesUtils.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+
+#include <cstring>
+
+namespace snap::drawing {
+
+// Bumped whenever the encoding of the stored images changes
+static const int kImageDiskCacheVersion = 1;
+static const double kImageDiskCacheEncodingQuality = 0.9;
+
+ImageDiskCache::ImageDiskCache(const Ref<Valdi::IDiskCache>& diskCache, Valdi::ILogger& logger)
+    : _diskCache(diskCache->scopedCache(Valdi::Path(fmt::format("{}", kImageDiskCacheVersion)), false)),
+      _logger(logger) {}
+
+ImageDiskCache::~ImageDiskCache() = default;
+
+Valdi::Path ImageDiskCache::getPath(const String& url, int preferredWidth, int preferredHeight) {
+    auto urlHash = Valdi::BytesUtils::sha256String(reinterpret_cast<const Valdi::Byte*>(url.getCStr()), url.length());
+    return Valdi::Path(fmt::format("{}_{}x{}", urlHash, preferredWidth, preferredHeight));
+}
+
+Valdi::Result<Ref<Image>> ImageDiskCache::load(const String& url, int preferredWidth, int preferredHeight) const {
+    auto path = getPath(url, preferredWidth, preferredHeight);
+    if (!_diskCache->exists(path)) {
+        return Valdi::Error("Image not in disk cache");
+    }
+
+    auto bytes = _diskCache->load(path);
+    if (!bytes) {
+        return bytes.moveError();
+    }
+
+    // Stored images start with the scale they had relative to their source
+    float scale = 1.0f;
+    if (bytes.value().size() <= sizeof(scale)) {
+        return Valdi::Error("Invalid image in disk cache");
+    }
+    std::memcpy(&scale, bytes.value().data(), sizeof(scale));
+
+    auto image = Image::make(bytes.value().subrange(sizeof(scale), bytes.value().size() - sizeof(scale)));
+    if (!image) {
+        return image.moveError();
+    }
+    image.value()->setDownsampleScale(scale);
+
+    return image;
+}
+
+void ImageDiskCache::store(
+    const String& url, int preferredWidth, int preferredHeight, const Ref<Image>& image, float scale) {
+    // WebP keeps the alpha channel while staying much smaller than PNG
+    auto encoded = image->encode(EncodedImageFormatWebP, kImageDiskCacheEncodingQuality);
+    if (!encoded) {
+        VALDI_WARN(_logger, "Failed to encode image {} for the disk cache: {}", url, encoded.error());
+        return;
+    }
+
+    auto buffer = Valdi::makeShared<Valdi::ByteBuffer>();
+    buffer->append(reinterpret_cast<const Valdi::Byte*>(&scale), reinterpret_cast<const Valdi::Byte*>(&scale + 1));
+    buffer->append(encoded.value().begin(), encoded.value().end());
+
+    auto storeResult = _diskCache->store(getPath(url, preferredWidth, preferredHeight), buffer->toBytesView());
+    if (!storeResult) {
+        VALDI_WARN(_logger, "Failed to store image {} in the disk cache: {}", url, storeResult.error());
+    }
+}
+
+void ImageDiskCache::trim(size_t maxImagesCount) {
+    auto rootPath = _diskCache->getRootPath();
+    auto paths = _diskCache->list(rootPath);
+    if (paths.size() <= maxImagesCount) {
+        return;
+    }
+
+    VALDI_INFO(_logger, "Clearing {} images from the image disk cache", paths.size());
+    for (const auto& path : paths) {
+        _diskCache->remove(path);
+    }
+}
+
+} // namespace snap::drawing
@@ -0,0 +1,51 @@
+//
+//  ImageDiskCache.hpp
+//  valdi-snap_drawing
+//
+
+#pragma once
+
+#include "snap_drawing/cpp/Utils/Aliases.hpp"
+
+#include "valdi/runtime/Interfaces/IDiskCache.hpp"
+#include "valdi_core/cpp/Interfaces/ILogger.hpp"
+
+namespace snap::drawing {
+
+class Image;
+
+/**
+ The cold tier of the ImageLoader: stores re-encoded copies of the resized images
+ it produced, keyed by URL and requested size, so that images evicted from the
+ in-memory ImageCache can be restored without downloading and decoding the
+ full resolution source again.
+ Only resized images are stored, the full resolution sources are already
+ cached by the downloaders.
+ The methods perform disk I/O and should not be called from the ImageLoader queue.
+ */
+class ImageDiskCache : public Valdi::SimpleRefCountable {
+public:
+    ImageDiskCache(const Ref<Valdi::IDiskCache>& diskCache, Valdi::ILogger& logger);
+    ~ImageDiskCache() override;
+
+    /**
+     Load and decode the image stored for the given URL and size. The returned image
+     carries the downsample scale it had relative to its source when it was stored.
+     */
+    Valdi::Result<Ref<Image>> load(const String& url, int preferredWidth, int preferredHeight) const;
+
+    void store(const String& url, int preferredWidth, int preferredHeight, const Ref<Image>& image, float scale);
+
+    /**
+     Remove all the stored images if there are more than the given count.
+     */
+    void trim(size_t maxImagesCount);
+
+private:
+    Ref<Valdi::IDiskCache> _diskCache;
+    [[maybe_unused]] Valdi::ILogger& _logger;
+
+    static Valdi::Path getPath(const String& url, int preferredWidth, int preferredHeight);
+};
+
+} // namespace snap::drawing
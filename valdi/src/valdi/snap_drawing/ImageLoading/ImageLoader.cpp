@@ -8,17 +8,20 @@
 #include "valdi/snap_drawing/ImageLoading/ImageLoader.hpp"
 
 #include "snap_drawing/cpp/Utils/Image.hpp"
+#include "valdi/snap_drawing/ImageLoading/ImageDiskCache.hpp"
 #include "valdi/snap_drawing/ImageLoading/ImageLoaderBridge.hpp"
 #include "valdi/snap_drawing/ImageLoading/ImageLoaderTask.hpp"
 
 #include "valdi/runtime/Resources/AssetLoaderCompletion.hpp"
 #include "valdi_core/cpp/Attributes/ImageFilter.hpp"
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 
 #include "valdi_core/cpp/Constants.hpp"
 
+#include <algorithm>
 #include <utility>
 
 namespace snap::drawing {
@@ -39,7 +42,11 @@ private:
 };
 
 ImageLoader::ImageLoader(const Valdi::Ref<Valdi::DispatchQueue>& queue, Valdi::ILogger& logger, size_t maxSize)
-    : _queue(queue), _logger(logger), _cache(logger, maxSize), _reclamationInterval(0) {}
+    : _queue(queue),
+      _logger(logger),
+      _cache(logger, maxSize),
+      _reclamationInterval(0),
+      _maxDecodeWorkers(std::max(static_cast<size_t>(1), Valdi::ThreadPool::getShared()->getWorkersCount() / 2)) {}
 
 ImageLoader::~ImageLoader() = default;
 
@@ -52,19 +59,26 @@ snap::valdi_core::AssetOutputType ImageLoader::getOutputType() const {
     return snap::valdi_core::AssetOutputType::ImageSnapDrawing;
 }
 
-static Valdi::Ref<Valdi::LoadedAsset> toFilteredImage(const CachedImage& cacheItem,
-                                                      const Valdi::Value& associatedData) {
+static Valdi::Ref<Valdi::ImageFilter> getScaledFilter(const CachedImage& cacheItem,
+                                                       const Valdi::Value& associatedData) {
     auto typedFilter = associatedData.getTypedRef<Valdi::ImageFilter>();
-    auto image = cacheItem.image;
     if (typedFilter != nullptr) {
         const auto scaling = cacheItem.scale;
         if (scaling > 1) {
             auto newBlurValue = typedFilter->getBlurRadius() / scaling;
             typedFilter = typedFilter->withBlurRadius(newBlurValue);
         }
-        image = image->withFilter(typedFilter);
     }
-    return image;
+    return typedFilter;
+}
+
+/**
+ Blurs are applied once ahead of time, as blurring on every draw is expensive. Color matrices are
+ cheap to apply while drawing and are left to the GPU, unless the image is blurred as well.
+ Vector images are filtered at the scale they are drawn at.
+ */
+static bool shouldApplyFilterAheadOfTime(const Image& image, const Valdi::ImageFilter& filter) {
+    return filter.getBlurRadius() > 0.0f && !image.isVector();
 }
 
 Valdi::Shared<snap::valdi_core::Cancelable> ImageLoader::loadAsset(
@@ -94,25 +108,85 @@ void ImageLoader::loadImage(const Ref<ImageLoaderTask>& task) {
     auto imgResult =
         _cache.getResizedCachedImage(task->getUrl(), task->getPreferredWidth(), task->getPreferredHeight());
 
-    if (!imgResult) {
-        auto cancelable = task->getRemoteDownloader()->downloadItem(
-            task->getUrl(), [task](const Valdi::Result<Valdi::BytesView>& result) {
-                if (auto strongThis = task->getImageLoader().lock()) {
-                    strongThis->handleByteViewLoadResult(task, result);
-                }
-            });
-        task->setCurrentCancelable(cancelable);
-    } else {
+    if (imgResult) {
         handleImageLoadResult(task, imgResult.value());
+    } else if (getDiskCache() != nullptr && (task->getPreferredWidth() > 0 || task->getPreferredHeight() > 0)) {
+        enqueueDecode(task, Valdi::BytesView(), /* fromDiskCache */ true);
+    } else {
+        downloadImage(task);
     }
 }
 
+void ImageLoader::downloadImage(const Ref<ImageLoaderTask>& task) {
+    if (task->wasCanceled()) {
+        return;
+    }
+
+    auto cancelable = task->getRemoteDownloader()->downloadItem(
+        task->getUrl(), [task](const Valdi::Result<Valdi::BytesView>& result) {
+            if (auto strongThis = task->getImageLoader().lock()) {
+                strongThis->handleByteViewLoadResult(task, result);
+            }
+        });
+    task->setCurrentCancelable(cancelable);
+}
+
 void ImageLoader::handleImageLoadResult(const Ref<ImageLoaderTask>& task, const Valdi::Result<CachedImage>& result) {
-    if (result) {
-        task->notifyCompletion(toFilteredImage(result.value(), task->getFilter()));
-    } else {
+    if (!result) {
         task->notifyCompletion(result.error());
+        return;
     }
+
+    const auto& image = result.value().image;
+    auto filter = getScaledFilter(result.value(), task->getFilter());
+    if (filter == nullptr) {
+        task->notifyCompletion(image);
+    } else if (!shouldApplyFilterAheadOfTime(*image, *filter)) {
+        task->notifyCompletion(image->withFilter(filter));
+    } else {
+        applyFilter(task, image, filter);
+    }
+}
+
+void ImageLoader::applyFilter(const Ref<ImageLoaderTask>& task,
+                              const Ref<Image>& image,
+                              const Ref<Valdi::ImageFilter>& filter) {
+    auto filterSignature = filter->getSignature();
+    auto filteredImage = _cache.getFilteredCachedImage(task->getUrl(), image, filterSignature);
+    if (filteredImage != nullptr) {
+        task->notifyCompletion(image->withFilter(filter, filteredImage));
+        return;
+    }
+
+    Valdi::ThreadPool::getShared()->submit([task, image, filter, filterSignature]() {
+        if (task->wasCanceled()) {
+            return;
+        }
+
+        auto filteredImage = image->makeFiltered(*filter);
+        if (auto strongThis = task->getImageLoader().lock()) {
+            strongThis->_queue->async([task, image, filter, filterSignature, filteredImage]() {
+                if (auto strongThis = task->getImageLoader().lock()) {
+                    strongThis->handleFilterResult(task, image, filter, filterSignature, filteredImage);
+                }
+            });
+        }
+    });
+}
+
+void ImageLoader::handleFilterResult(const Ref<ImageLoaderTask>& task,
+                                     const Ref<Image>& image,
+                                     const Ref<Valdi::ImageFilter>& filter,
+                                     const String& filterSignature,
+                                     const Ref<Image>& filteredImage) {
+    if (filteredImage == nullptr) {
+        // The filter is then applied while drawing
+        task->notifyCompletion(image->withFilter(filter));
+        return;
+    }
+
+    task->notifyCompletion(image->withFilter(
+        filter, _cache.setFilteredCachedImage(task->getUrl(), image, filterSignature, filteredImage)));
 }
 
 void ImageLoader::handleByteViewLoadResult(const Ref<ImageLoaderTask>& task,
@@ -141,16 +215,144 @@ void ImageLoader::loadImageFromBytes(const Ref<ImageLoaderTask>& task, const Val
         return;
     }
 
-    auto result = Image::make(bytes);
+    enqueueDecode(task, bytes, /* fromDiskCache */ false);
+}
+
+void ImageLoader::enqueueDecode(const Ref<ImageLoaderTask>& task, const Valdi::BytesView& bytes, bool fromDiskCache) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    _pendingDecodes.emplace_back(PendingDecode{task, bytes, _decodeSequence++, fromDiskCache});
+
+    if (_activeDecodeWorkers < _maxDecodeWorkers) {
+        _activeDecodeWorkers++;
+        Valdi::ThreadPool::getShared()->submit([weakThis = Valdi::weakRef(this)]() {
+            if (auto strongThis = weakThis.lock()) {
+                strongThis->runDecodeWorker();
+            }
+        });
+    }
+}
+
+bool ImageLoader::popNextDecode(PendingDecode& output) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+
+    // Canceled tasks belong to images that are no longer displayed, they are dropped
+    // without being decoded.
+    _pendingDecodes.erase(std::remove_if(_pendingDecodes.begin(),
+                                         _pendingDecodes.end(),
+                                         [](const auto& pendingDecode) { return pendingDecode.task->wasCanceled(); }),
+                          _pendingDecodes.end());
+
+    if (_pendingDecodes.empty()) {
+        _activeDecodeWorkers--;
+        return false;
+    }
+
+    // The most recently requested images are decoded first: after a fast scroll, those are the ones
+    // in the viewport, while the older requests are for images that have already scrolled off.
+    auto it = std::max_element(_pendingDecodes.begin(), _pendingDecodes.end(), [](const auto& left, const auto& right) {
+        return left.sequence < right.sequence;
+    });
+    output = std::move(*it);
+    _pendingDecodes.erase(it);
+    return true;
+}
+
+void ImageLoader::runDecodeWorker() {
+    PendingDecode pendingDecode;
+    while (popNextDecode(pendingDecode)) {
+        auto task = std::move(pendingDecode.task);
+
+        if (pendingDecode.fromDiskCache) {
+            auto result = getDiskCache()->load(task->getUrl(), task->getPreferredWidth(), task->getPreferredHeight());
+            _queue->async([task, result = std::move(result)]() {
+                if (auto strongThis = task->getImageLoader().lock()) {
+                    if (result) {
+                        strongThis->handleDecodeResult(task, result, /* shouldStoreInDiskCache */ false);
+                    } else {
+                        strongThis->downloadImage(task);
+                    }
+                }
+            });
+            continue;
+        }
+
+        auto result = Image::make(pendingDecode.bytes, task->getPreferredWidth(), task->getPreferredHeight());
+        pendingDecode.bytes = Valdi::BytesView();
+
+        _queue->async([task, result = std::move(result)]() {
+            if (auto strongThis = task->getImageLoader().lock()) {
+                strongThis->handleDecodeResult(task, result, /* shouldStoreInDiskCache */ true);
+            }
+        });
+    }
+}
+
+void ImageLoader::handleDecodeResult(const Ref<ImageLoaderTask>& task,
+                                     const Valdi::Result<Ref<Image>>& result,
+                                     bool shouldStoreInDiskCache) {
     if (!result) {
         handleImageLoadResult(task, result.error());
         return;
     }
 
-    imgResult = _cache.setCachedItemAndGetResizedImage(
-        task->getUrl(), result.value(), task->getPreferredWidth(), task->getPreferredHeight());
+    // Another worker might have decoded the same image concurrently
+    auto imgResult =
+        _cache.getResizedCachedImage(task->getUrl(), task->getPreferredWidth(), task->getPreferredHeight());
+    if (!imgResult) {
+        imgResult = _cache.setCachedItemAndGetResizedImage(
+            task->getUrl(), result.value(), task->getPreferredWidth(), task->getPreferredHeight());
+    }
 
     handleImageLoadResult(task, imgResult);
+
+    // Only images smaller than their source are worth storing, the sources themselves are
+    // already cached by the downloaders. Vector images are resized without being rasterized.
+    auto diskCache = shouldStoreInDiskCache ? getDiskCache() : nullptr;
+    if (diskCache != nullptr && imgResult && imgResult.value().scale > 1.0f && !imgResult.value().image->isVector()) {
+        Valdi::ThreadPool::getShared()->submit([diskCache, task, cachedImage = imgResult.value()]() {
+            diskCache->store(task->getUrl(),
+                             task->getPreferredWidth(),
+                             task->getPreferredHeight(),
+                             cachedImage.image,
+                             cachedImage.scale);
+        });
+    }
+}
+
+void ImageLoader::onMemoryPressure(MemoryPressureLevel level) {
+    _queue->async([weakThis = Valdi::weakRef(this), level]() {
+        auto strongThis = weakThis.lock();
+        if (strongThis == nullptr) {
+            return;
+        }
+
+        auto maxSize = strongThis->_cache.getMaxSize();
+        switch (level) {
+            case MemoryPressureLevel::Moderate:
+                strongThis->_cache.trimToSize(maxSize / 2);
+                break;
+            case MemoryPressureLevel::High:
+                strongThis->_cache.trimToSize(maxSize / 4);
+                break;
+            case MemoryPressureLevel::Critical:
+                strongThis->_cache.trimToSize(0);
+                break;
+        }
+    });
+}
+
+size_t ImageLoader::getCacheSizeInBytes() const {
+    return _cache.getCurrentSize();
+}
+
+void ImageLoader::setDiskCache(const Ref<ImageDiskCache>& diskCache) {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    _diskCache = diskCache;
+}
+
+Ref<ImageDiskCache> ImageLoader::getDiskCache() const {
+    std::lock_guard<Valdi::Mutex> guard(_mutex);
+    return _diskCache;
 }
 
 void ImageLoader::setReclamationInterval(size_t expirationTime) {
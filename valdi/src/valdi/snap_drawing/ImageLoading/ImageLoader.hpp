@@ -8,18 +8,23 @@
 #pragma once
 
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/MemoryBudgetManager.hpp"
 
 #include "valdi/runtime/Interfaces/IRemoteDownloader.hpp"
 #include "valdi/runtime/Resources/AssetLoaderFactory.hpp"
 #include "valdi/snap_drawing/ImageLoading/ImageCache.hpp"
+#include "valdi_core/cpp/Attributes/ImageFilter.hpp"
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 
+#include <vector>
+
 namespace snap::drawing {
 
 class Image;
 
 class ImageLoaderTask;
+class ImageDiskCache;
 
 class ImageLoader : public Valdi::AssetLoaderFactory {
 public:
@@ -33,6 +38,20 @@ public:
 
     void setReclamationInterval(size_t expirationTime);
 
+    /**
+     Set the disk cache in which the resized images are stored, and from which
+     they are restored after being evicted from the in-memory cache.
+     */
+    void setDiskCache(const Ref<ImageDiskCache>& diskCache);
+
+    /**
+     Asynchronously evict the unused images from the in-memory cache, down to a fraction
+     of its budget which depends on the pressure level.
+     */
+    void onMemoryPressure(MemoryPressureLevel level);
+
+    size_t getCacheSizeInBytes() const;
+
     Valdi::Shared<snap::valdi_core::Cancelable> loadAsset(const Valdi::StringBox& url,
                                                           int32_t preferredWidth,
                                                           int32_t preferredHeight,
@@ -41,21 +60,51 @@ public:
                                                           const Valdi::Ref<Valdi::AssetLoaderCompletion>& completion);
 
 private:
+    struct PendingDecode {
+        Ref<ImageLoaderTask> task;
+        Valdi::BytesView bytes;
+        uint64_t sequence = 0;
+        bool fromDiskCache = false;
+    };
+
     mutable Valdi::Mutex _mutex;
     Valdi::Ref<Valdi::DispatchQueue> _queue;
     [[maybe_unused]] Valdi::ILogger& _logger;
     ImageCache _cache;
 
     size_t _reclamationInterval;
+    Ref<ImageDiskCache> _diskCache;
+
+    std::vector<PendingDecode> _pendingDecodes;
+    uint64_t _decodeSequence = 0;
+    size_t _activeDecodeWorkers = 0;
+    size_t _maxDecodeWorkers;
 
     void loadImage(const Ref<ImageLoaderTask>& task);
+    void downloadImage(const Ref<ImageLoaderTask>& task);
 
     void handleByteViewLoadResult(const Ref<ImageLoaderTask>& task, const Valdi::Result<Valdi::BytesView>& result);
 
     void handleImageLoadResult(const Ref<ImageLoaderTask>& task, const Valdi::Result<CachedImage>& result);
+    void applyFilter(const Ref<ImageLoaderTask>& task,
+                     const Ref<Image>& image,
+                     const Ref<Valdi::ImageFilter>& filter);
+    void handleFilterResult(const Ref<ImageLoaderTask>& task,
+                            const Ref<Image>& image,
+                            const Ref<Valdi::ImageFilter>& filter,
+                            const String& filterSignature,
+                            const Ref<Image>& filteredImage);
 
     void loadImageFromBytes(const Ref<ImageLoaderTask>& task, const Valdi::BytesView& bytes);
 
+    void enqueueDecode(const Ref<ImageLoaderTask>& task, const Valdi::BytesView& bytes, bool fromDiskCache);
+    void runDecodeWorker();
+    bool popNextDecode(PendingDecode& output);
+    void handleDecodeResult(const Ref<ImageLoaderTask>& task,
+                            const Valdi::Result<Ref<Image>>& result,
+                            bool shouldStoreInDiskCache);
+    Ref<ImageDiskCache> getDiskCache() const;
+
     void scheduleReclamation();
 };
 
@@ -6,14 +6,19 @@
 //
 
 #include "valdi/snap_drawing/ImageLoading/ImageLoaderFactory.hpp"
+#include "valdi/snap_drawing/ImageLoading/ImageDiskCache.hpp"
 #include "valdi/snap_drawing/ImageLoading/ImageLoader.hpp"
 
 #include "valdi/snap_drawing/ImageLoading/AnimatedImageLoaderFactory.hpp"
 
 #include "valdi/runtime/Resources/AssetLoaderManager.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 
 namespace snap::drawing {
 
+// The disk cache is cleared once it holds more images than this
+static const size_t kMaxImageDiskCacheImagesCount = 4096;
+
 Valdi::Ref<ImageLoader> createImageLoader(const Valdi::Ref<Valdi::DispatchQueue>& queue,
                                           Valdi::ILogger& logger,
                                           uint64_t maxCacheSizeInBytes) {
@@ -23,15 +28,26 @@ Valdi::Ref<ImageLoader> createImageLoader(const Valdi::Ref<Valdi::DispatchQueue>
     return imageLoader;
 }
 
-void registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager,
-                          const Ref<Resources>& resources,
-                          const Valdi::Ref<Valdi::DispatchQueue>& queue,
-                          Valdi::ILogger& logger,
-                          uint64_t maxCacheSizeInBytes) {
+Valdi::Ref<ImageLoader> registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager,
+                                             const Ref<Resources>& resources,
+                                             const Valdi::Ref<Valdi::DispatchQueue>& queue,
+                                             Valdi::ILogger& logger,
+                                             uint64_t maxCacheSizeInBytes,
+                                             const Valdi::Ref<Valdi::IDiskCache>& diskCache) {
     auto imageLoader = createImageLoader(queue, logger, maxCacheSizeInBytes);
 
+    if (diskCache != nullptr) {
+        auto imageDiskCache = Valdi::makeShared<ImageDiskCache>(diskCache, logger);
+        Valdi::ThreadPool::getShared()->submit([imageDiskCache]() {
+            imageDiskCache->trim(kMaxImageDiskCacheImagesCount);
+        });
+        imageLoader->setDiskCache(imageDiskCache);
+    }
+
     assetLoaderManager.registerAssetLoaderFactory(imageLoader);
     assetLoaderManager.registerAssetLoaderFactory(Valdi::makeShared<AnimatedImageLoaderFactory>(resources));
+
+    return imageLoader;
 }
 
 } // namespace snap::drawing
@@ -14,6 +14,7 @@ namespace Valdi {
 class DispatchQueue;
 class ILogger;
 class AssetLoaderManager;
+class IDiskCache;
 
 } // namespace Valdi
 
@@ -26,10 +27,14 @@ Ref<ImageLoader> createImageLoader(const Valdi::Ref<Valdi::DispatchQueue>& queue
                                    Valdi::ILogger& logger,
                                    uint64_t maxCacheSizeInBytes);
 
-void registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager,
-                          const Ref<Resources>& resources,
-                          const Valdi::Ref<Valdi::DispatchQueue>& queue,
-                          Valdi::ILogger& logger,
-                          uint64_t maxCacheSizeInBytes);
+/**
+ Register the image and animated image loaders, and return the created ImageLoader.
+ */
+Ref<ImageLoader> registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager,
+                                      const Ref<Resources>& resources,
+                                      const Valdi::Ref<Valdi::DispatchQueue>& queue,
+                                      Valdi::ILogger& logger,
+                                      uint64_t maxCacheSizeInBytes,
+                                      const Valdi::Ref<Valdi::IDiskCache>& diskCache);
 
 } // namespace snap::drawing
@@ -191,4 +191,9 @@ bool BridgeLayer::hitTest(const Point& point) const {
     }
 }
 
+bool BridgeLayer::canBeHitOutsideOfHitTestBounds() const {
+    // The bridged view can decide to be hit anywhere
+    return true;
+}
+
 } // namespace snap::drawing
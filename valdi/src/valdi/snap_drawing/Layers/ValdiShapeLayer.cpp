@@ -24,8 +24,10 @@ void ValdiShapeLayer::onDraw(DrawingContext& drawingContext) {
         if (_pathData == nullptr) {
             setPath(Path());
         } else {
-            setPath(pathFromValdiGeometricPath(
-                _pathData->getBuffer(), drawingContext.drawBounds().width(), drawingContext.drawBounds().height()));
+            setPath(pathFromValdiGeometricPath(getResources()->getPathCache().get(),
+                                               _pathData->getBuffer(),
+                                               drawingContext.drawBounds().width(),
+                                               drawingContext.drawBounds().height()));
         }
     }
 
@@ -8,8 +8,8 @@
 #include "valdi/snap_drawing/Modules/BitmapNativeModuleFactory.hpp"
 #include "snap_drawing/cpp/Utils/Bitmap.hpp"
 #include "snap_drawing/cpp/Utils/Image.hpp"
-#include "utils/encoding/Base64Utils.hpp"
 #include "valdi_core/cpp/Interfaces/IBitmap.hpp"
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
 #include "valdi_core/cpp/Utils/BitmapWithBuffer.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
 #include "valdi_core/cpp/Utils/ValueFunctionWithMethod.hpp"
@@ -98,12 +98,12 @@ Valdi::Value BitmapNativeModuleFactory::decodeNativeBitmap(const Valdi::ValueFun
 
         if (data.isStaticString()) {
             auto utf8Storage = data.getStaticString()->utf8Storage();
-            if (!snap::utils::encoding::base64ToBinary(utf8Storage.toStringView(), *bytes)) {
+            if (!Valdi::Base64Codec::decode(utf8Storage.toStringView(), *bytes)) {
                 callContext.getExceptionTracker().onError("Failed to decode");
                 return Valdi::Value();
             }
         } else {
-            if (!snap::utils::encoding::base64ToBinary(data.toStringBox().toStringView(), *bytes)) {
+            if (!Valdi::Base64Codec::decode(data.toStringBox().toStringView(), *bytes)) {
                 callContext.getExceptionTracker().onError("Failed to decode");
                 return Valdi::Value();
             }
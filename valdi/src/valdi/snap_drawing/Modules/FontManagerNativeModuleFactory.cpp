@@ -80,6 +80,8 @@ static Valdi::Value doRegisterFont(const Valdi::ValueFunctionCallContext& callCo
 
         fontManager->registerTypeface(
             fontName, FontStyle(FontWidthNormal, fontWeight.value(), fontSlant.value()), false, loadableTypeface);
+        // Fonts registered by modules are about to be used, start parsing them in the background
+        loadableTypeface->prefetch();
     }
 
     return Valdi::Value::undefined();
@@ -14,17 +14,24 @@
 #include "snap_drawing/cpp/Layers/Interfaces/ILayerRoot.hpp"
 #include "snap_drawing/cpp/Resources.hpp"
 #include "snap_drawing/cpp/Text/FontManager.hpp"
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
+#include "snap_drawing/cpp/Utils/Image.hpp"
 #include "valdi/runtime/Context/Context.hpp"
 #include "valdi/runtime/Context/ContextAutoDestroy.hpp"
 #include "valdi/runtime/Context/IViewNodesAssetTracker.hpp"
 #include "valdi/runtime/Context/ViewManagerContext.hpp"
+#include "valdi/runtime/Resources/ResourceManager.hpp"
 #include "valdi/runtime/Runtime.hpp"
+#include "valdi/runtime/ValdiRuntimeTweaks.hpp"
 #include "valdi/snap_drawing/Utils/ValdiUtils.hpp"
 #include "valdi_core/cpp/Interfaces/IBitmap.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/Trace.hpp"
 #include "valdi_core/cpp/Utils/ValueFunctionWithMethod.hpp"
 #include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
 #include <cstdint>
+#include <optional>
 
 namespace snap::drawing {
 
@@ -46,6 +53,14 @@ public:
         return !_useNewExternalSurfaceRasterMethod;
     }
 
+    bool shouldPresentVideoInCompositorPlane() const final {
+        return false;
+    }
+
+    bool hasTimeRemainingInFrame() const final {
+        return true;
+    }
+
     void onInitialize() final {}
     void setChildNeedsDisplay() final {}
     void requestLayout(ILayer* layer) final {}
@@ -78,6 +93,11 @@ public:
                                                               ExternalSurfaceRasterizationMethod::FAST,
                                                           enableDeltaRasterization)),
           _useNewExternalSurfaceRasterMethod(useNewExternalSurfaceRasterMethod) {
+        auto runtimeTweaks = runtime->getResourceManager().getRuntimeTweaks();
+        if (runtimeTweaks != nullptr && runtimeTweaks->enableParallelRasterization()) {
+            _rasterContext->setParallelRasterizationEnabled(true);
+        }
+
         auto rootLayer = valdiViewToLayer(_viewNodeTree->getRootView());
         if (rootLayer != nullptr) {
             rootLayer->onParentChanged(_layerRoot);
@@ -143,6 +163,14 @@ public:
         return _displayList == nullptr;
     }
 
+    const Ref<RasterContext>& getRasterContext() const {
+        return _rasterContext;
+    }
+
+    const Ref<DisplayList>& getDisplayList() const {
+        return _displayList;
+    }
+
 private:
     Ref<RasterContext> _rasterContext;
     Ref<DisplayList> _displayList;
@@ -204,6 +232,7 @@ Valdi::Value ManagedContextNativeModuleFactory::loadModule() {
     binder.bind("drawFrame", &ManagedContextNativeModuleFactory::drawFrame);
     binder.bind("disposeFrame", &ManagedContextNativeModuleFactory::disposeFrame);
     binder.bind("rasterFrame", &ManagedContextNativeModuleFactory::rasterFrame);
+    binder.bind("encodeFrame", &ManagedContextNativeModuleFactory::encodeFrame);
     return out;
 }
 
@@ -362,4 +391,102 @@ Valdi::Value ManagedContextNativeModuleFactory::rasterFrame(const Valdi::ValueFu
     return Valdi::Value();
 }
 
+static std::optional<EncodedImageFormat> encodedImageFormatFromIndex(int32_t index) {
+    switch (index) {
+        case 0:
+            return {EncodedImageFormatJPG};
+        case 1:
+            return {EncodedImageFormatPNG};
+        case 2:
+            return {EncodedImageFormatWebP};
+        default:
+            return std::nullopt;
+    }
+}
+
+static Valdi::Result<Valdi::BytesView> rasterAndEncodeFrame(const Ref<RasterContext>& rasterContext,
+                                                            const Ref<DisplayList>& displayList,
+                                                            int32_t width,
+                                                            int32_t height,
+                                                            EncodedImageFormat format,
+                                                            double qualityRatio) {
+    VALDI_TRACE("SnapDrawing.managedContext.encodeFrame");
+    auto bitmap = BitmapPool::getShared()->allocateBitmap(Valdi::BitmapInfo(
+        width, height, Valdi::ColorType::ColorTypeRGBA8888, Valdi::AlphaType::AlphaTypePremul, 0));
+    if (!bitmap) {
+        return bitmap.moveError();
+    }
+
+    auto rasterResult = rasterContext->raster(displayList, bitmap.value(), /* shouldClearBitmapBeforeDrawing */ true);
+    if (!rasterResult) {
+        return rasterResult.moveError();
+    }
+
+    // The image wraps the pooled pixels, which go back to the pool once the encoded bytes are produced
+    auto image = Image::makeFromBitmap(bitmap.value(), /* shouldCopy */ false);
+    if (!image) {
+        return image.moveError();
+    }
+
+    return image.value()->encode(format, qualityRatio);
+}
+
+Valdi::Value ManagedContextNativeModuleFactory::encodeFrame(const Valdi::ValueFunctionCallContext& callContext) {
+    auto frame = getSnapDrawingFrameFromCallContext(callContext);
+    if (frame == nullptr) {
+        return Valdi::Value();
+    }
+
+    if (frame->isDisposed()) {
+        callContext.getExceptionTracker().onError("Frame was disposed");
+        return Valdi::Value();
+    }
+
+    auto width = callContext.getParameterAsInt(1);
+    auto height = callContext.getParameterAsInt(2);
+    auto formatIndex = callContext.getParameterAsInt(3);
+    auto qualityRatio = callContext.getParameterAsDouble(4);
+    if (!callContext.getExceptionTracker()) {
+        return Valdi::Value();
+    }
+
+    if (width <= 0 || height <= 0) {
+        callContext.getExceptionTracker().onError("Frame must be encoded with a positive size");
+        return Valdi::Value();
+    }
+
+    auto format = encodedImageFormatFromIndex(formatIndex);
+    if (!format) {
+        callContext.getExceptionTracker().onError("Invalid encoding");
+        return Valdi::Value();
+    }
+
+    auto callback = callContext.getParameterAsFunction(5);
+    if (callback == nullptr) {
+        return Valdi::Value();
+    }
+
+    // Rasterizing and encoding don't touch the view tree, so frames of different contexts are
+    // processed concurrently on the workers while the JS thread lays out and draws the next ones.
+    // The frame can be disposed in the meantime, its raster context and display list are retained here.
+    Valdi::ThreadPool::getShared()->submit([rasterContext = frame->getRasterContext(),
+                                            displayList = frame->getDisplayList(),
+                                            width,
+                                            height,
+                                            format = format.value(),
+                                            qualityRatio,
+                                            callback = std::move(callback)]() {
+        auto result = rasterAndEncodeFrame(rasterContext, displayList, width, height, format, qualityRatio);
+        if (result) {
+            auto typedArray = Valdi::makeShared<Valdi::ValueTypedArray>(Valdi::ArrayBuffer, result.value());
+            callback->call(Valdi::ValueFunctionFlagsNone, {Valdi::Value(typedArray)});
+        } else {
+            callback->call(Valdi::ValueFunctionFlagsNone,
+                           {Valdi::Value::undefined(), Valdi::Value(result.error().toStringBox())});
+        }
+    });
+
+    return Valdi::Value();
+}
+
 } // namespace snap::drawing
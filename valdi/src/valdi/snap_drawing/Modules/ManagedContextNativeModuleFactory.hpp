@@ -39,6 +39,7 @@ private:
     Valdi::Value drawFrame(const Valdi::ValueFunctionCallContext& callContext);
     Valdi::Value disposeFrame(const Valdi::ValueFunctionCallContext& callContext);
     Valdi::Value rasterFrame(const Valdi::ValueFunctionCallContext& callContext);
+    Valdi::Value encodeFrame(const Valdi::ValueFunctionCallContext& callContext);
 };
 
 } // namespace snap::drawing
@@ -7,11 +7,19 @@
 
 #include "valdi/snap_drawing/Runtime.hpp"
 #include "valdi/snap_drawing/Graphics/ShaderCache.hpp"
+#include "valdi/snap_drawing/ImageLoading/ImageLoader.hpp"
 #include "valdi/snap_drawing/ImageLoading/ImageLoaderFactory.hpp"
 #include "valdi/snap_drawing/SnapDrawingViewManager.hpp"
 
 #include "snap_drawing/cpp/Drawing/DrawLooper.hpp"
 #include "snap_drawing/cpp/Text/FontManager.hpp"
+#include "snap_drawing/cpp/Text/SharedTextShaperCache.hpp"
+#include "snap_drawing/cpp/Text/TextLayoutCache.hpp"
+#include "snap_drawing/cpp/Utils/BitmapPool.hpp"
+#include "snap_drawing/cpp/Utils/MemoryBudgetManager.hpp"
+
+#include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
 
 namespace snap::drawing {
 
@@ -27,11 +35,16 @@ Runtime::Runtime(const Ref<IFrameScheduler>& frameScheduler,
       _hostViewManager(hostViewManager),
       _maxCacheSizeInBytes(maxCacheSizeInBytes) {
     _drawLooper = Valdi::makeShared<snap::drawing::DrawLooper>(_frameScheduler, logger);
+    // The first frame of the process is drawn by snap_drawing when its runtime is created during startup
+    Valdi::StartupTimeline::shared().setExpectsFirstDraw(true);
 
     if (diskCache != nullptr) {
         auto shaderPath = Valdi::Path("shaders");
         auto shadersDiskCache = diskCache->scopedCache(shaderPath, false);
         _shaderCache = Valdi::makeShared<snap::drawing::ShaderCache>(shadersDiskCache, workerQueue, logger);
+        _shaderCache->preloadUsageProfile();
+
+        _imagesDiskCache = diskCache->scopedCache(Valdi::Path("images"), false);
     }
 
     _fontManager = Valdi::makeShared<snap::drawing::FontManager>(logger);
@@ -39,6 +52,48 @@ Runtime::Runtime(const Ref<IFrameScheduler>& frameScheduler,
                                               hostViewManager != nullptr ? hostViewManager->getPointScale() : 1.0f,
                                               gesturesConfiguration,
                                               logger);
+
+    _memoryBudgetManager = Valdi::makeShared<MemoryBudgetManager>();
+    _memoryBudgetManager->registerConsumer(
+        STRING_LITERAL("textShaper"),
+        []() { return SharedTextShaperCache::getGlobal()->getStats().sizeInBytes; },
+        [fontManager = _fontManager](MemoryPressureLevel level) {
+            if (level != MemoryPressureLevel::Moderate) {
+                fontManager->getTextShaper()->clearCache();
+            }
+        });
+    _memoryBudgetManager->registerConsumer(
+        STRING_LITERAL("textLayouts"),
+        // TextLayouts are not tracked by size, the cache is bounded by its entries count
+        []() -> size_t { return 0; },
+        [resources = _resources](MemoryPressureLevel level) {
+            const auto& textLayoutCache = resources->getTextLayoutCache();
+            if (textLayoutCache == nullptr) {
+                return;
+            }
+            if (level == MemoryPressureLevel::Critical) {
+                textLayoutCache->clear();
+            } else {
+                textLayoutCache->purgeUnused();
+            }
+        });
+    _memoryBudgetManager->registerConsumer(
+        STRING_LITERAL("bitmapPool"),
+        []() { return BitmapPool::getShared()->getSizeInBytes(); },
+        [](MemoryPressureLevel level) {
+            const auto& bitmapPool = BitmapPool::getShared();
+            switch (level) {
+                case MemoryPressureLevel::Moderate:
+                    bitmapPool->trimToSize(bitmapPool->getMaxSizeInBytes() / 2);
+                    break;
+                case MemoryPressureLevel::High:
+                    bitmapPool->trimToSize(bitmapPool->getMaxSizeInBytes() / 4);
+                    break;
+                case MemoryPressureLevel::Critical:
+                    bitmapPool->clear();
+                    break;
+            }
+        });
 }
 
 Runtime::~Runtime() = default;
@@ -60,10 +115,23 @@ void Runtime::initializeViewManager(Valdi::PlatformType platformType) {
 
 void Runtime::registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager) {
     auto& logger = _resources->getLogger();
-    auto queue =
-        Valdi::DispatchQueue::create(STRING_LITERAL("com.snap.valdi.ImageLoader"), Valdi::ThreadQoSClassNormal);
-
-    snap::drawing::registerAssetLoaders(assetLoaderManager, _resources, queue, logger, _maxCacheSizeInBytes);
+    // Image decodes are short lived background tasks, they don't need a dedicated thread.
+    auto queue = Valdi::DispatchQueue::createOnSharedPool(STRING_LITERAL("com.snap.valdi.ImageLoader"), 1);
+
+    auto imageLoader = snap::drawing::registerAssetLoaders(
+        assetLoaderManager, _resources, queue, logger, _maxCacheSizeInBytes, _imagesDiskCache);
+
+    _memoryBudgetManager->registerConsumer(
+        STRING_LITERAL("images"),
+        [weakImageLoader = Valdi::weakRef(imageLoader.get())]() -> size_t {
+            auto imageLoader = weakImageLoader.lock();
+            return imageLoader != nullptr ? imageLoader->getCacheSizeInBytes() : 0;
+        },
+        [weakImageLoader = Valdi::weakRef(imageLoader.get())](MemoryPressureLevel level) {
+            if (auto imageLoader = weakImageLoader.lock()) {
+                imageLoader->onMemoryPressure(level);
+            }
+        });
 }
 
 const Ref<IFrameScheduler>& Runtime::getFrameScheduler() const {
@@ -74,6 +142,23 @@ const Ref<SnapDrawingViewManager>& Runtime::getViewManager() const {
     return _snapDrawingViewManager;
 }
 
+void Runtime::onMemoryPressure(MemoryPressureLevel level) {
+    // Log the breakdown before evicting, to know where the memory was going
+    for (const auto& usage : _memoryBudgetManager->getMemoryUsage()) {
+        VALDI_INFO(_resources->getLogger(), "Memory pressure: {} holds {} bytes", usage.name, usage.sizeInBytes);
+    }
+
+    _memoryBudgetManager->onMemoryPressure(level);
+
+    if (level != MemoryPressureLevel::Moderate) {
+        _drawLooper->onApplicationIsInLowMemory();
+    }
+}
+
+const Ref<MemoryBudgetManager>& Runtime::getMemoryBudgetManager() const {
+    return _memoryBudgetManager;
+}
+
 const Ref<FontManager>& Runtime::getFontManager() const {
     return _fontManager;
 }
@@ -10,6 +10,7 @@
 #include "valdi_core/cpp/Utils/Shared.hpp"
 
 #include "snap_drawing/cpp/Utils/Aliases.hpp"
+#include "snap_drawing/cpp/Utils/MemoryBudgetManager.hpp"
 
 #include "valdi/snap_drawing/SnapDrawingViewManager.hpp"
 #include "valdi_core/cpp/Context/PlatformType.hpp"
@@ -50,6 +51,14 @@ public:
 
     void registerAssetLoaders(Valdi::AssetLoaderManager& assetLoaderManager);
 
+    /**
+     Evict from the caches of the runtime according to the given level, called from the
+     OS memory warnings.
+     */
+    void onMemoryPressure(MemoryPressureLevel level);
+
+    const Ref<MemoryBudgetManager>& getMemoryBudgetManager() const;
+
     const Ref<IFrameScheduler>& getFrameScheduler() const;
 
     const Ref<SnapDrawingViewManager>& getViewManager() const;
@@ -73,8 +82,10 @@ private:
     Valdi::Ref<snap::drawing::ShaderCache> _shaderCache;
     Valdi::Ref<snap::drawing::FontManager> _fontManager;
     Valdi::Ref<Valdi::DispatchQueue> _workerQueue;
+    Valdi::Ref<Valdi::IDiskCache> _imagesDiskCache;
     Valdi::Ref<GraphicsContext> _graphicsContext;
     Valdi::Ref<Resources> _resources;
+    Valdi::Ref<MemoryBudgetManager> _memoryBudgetManager;
     Valdi::IViewManager* _hostViewManager;
     uint64_t _maxCacheSizeInBytes;
 };
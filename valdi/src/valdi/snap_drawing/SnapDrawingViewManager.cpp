@@ -26,6 +26,7 @@
 #include "valdi/snap_drawing/SnapDrawingViewTransaction.hpp"
 
 #include "snap_drawing/cpp/Drawing/DrawingContext.hpp"
+#include "snap_drawing/cpp/Drawing/PerformanceOverlay.hpp"
 
 #include "snap_drawing/cpp/Layers/ButtonLayer.hpp"
 #include "snap_drawing/cpp/Layers/ImageLayer.hpp"
@@ -149,6 +150,10 @@ public:
         _sourceBinder.registerPreprocessor(attribute, enableCache, std::move(preprocessor));
     }
 
+    void setAlwaysApply(const Valdi::StringBox& attribute) override {
+        _sourceBinder.setAlwaysApply(attribute);
+    }
+
     Valdi::AttributeId bindStringAttribute(const Valdi::StringBox& attribute,
                                            bool invalidateLayoutOnChange,
                                            const Valdi::Ref<Valdi::AttributeHandlerDelegate>& delegate) override {
@@ -331,10 +336,21 @@ SnapDrawingViewManager::SnapDrawingViewManager(const Ref<Resources>& resources,
     registerLayerClass(imageViewClass);
     registerLayerClass(Valdi::makeShared<AnimatedImageLayerClass>(_resources, layerClass));
 
+    if (_resources->getPerformanceOverlay() == nullptr) {
+        // Installed upfront while disabled, so that it can be toggled while the layer roots draw
+        auto performanceOverlay = Valdi::makeShared<PerformanceOverlay>();
+        performanceOverlay->setEnabled(false);
+        _resources->setPerformanceOverlay(performanceOverlay);
+    }
+
     VALDI_DEBUG(_logger, "SnapDrawing Layer alloc size is {} bytes", sizeof(Layer));
 }
 
-SnapDrawingViewManager::~SnapDrawingViewManager() = default;
+SnapDrawingViewManager::~SnapDrawingViewManager() {
+    if (_resources->getPerformanceOverlay()->isEnabled()) {
+        Valdi::FrameMetricsAggregator::shared().setObserver(nullptr);
+    }
+}
 
 Valdi::StringBox SnapDrawingViewManager::getClassName(const ILayerClass& layerClass) const {
     switch (_platformType) {
@@ -413,7 +429,7 @@ void SnapDrawingViewManager::callAction(Valdi::ViewNodeTree* viewNodeTree,
 }
 
 Valdi::NativeAnimator SnapDrawingViewManager::createAnimator(snap::valdi_core::AnimationType type,
-                                                             const std::vector<double>& /*controlPoints*/,
+                                                             const std::vector<double>& controlPoints,
                                                              double duration,
                                                              bool beginFromCurrentState,
                                                              bool /*crossfade*/,
@@ -435,6 +451,12 @@ Valdi::NativeAnimator SnapDrawingViewManager::createAnimator(snap::valdi_core::A
             break;
     }
 
+    // Custom curves take precedence over the preset curve, like on the other platforms
+    if (controlPoints.size() == 4) {
+        interpolationFunction = InterpolationFunctions::cubicBezier(
+            controlPoints[0], controlPoints[1], controlPoints[2], controlPoints[3]);
+    }
+
     return Valdi::makeShared<ValdiAnimator>(
                Duration(duration), std::move(interpolationFunction), beginFromCurrentState, stiffness, damping)
         .toShared();
@@ -566,6 +588,16 @@ void SnapDrawingViewManager::registerTypeface(const Valdi::StringBox& fontFamily
     _resources->getFontManager()->registerTypeface(fontFamily, fontStyle, canUseAsFallback, data);
 }
 
+void SnapDrawingViewManager::setPerformanceOverlayEnabled(bool enabled) {
+    const auto& performanceOverlay = _resources->getPerformanceOverlay();
+    if (performanceOverlay->isEnabled() == enabled) {
+        return;
+    }
+
+    performanceOverlay->setEnabled(enabled);
+    Valdi::FrameMetricsAggregator::shared().setObserver(enabled ? performanceOverlay : nullptr);
+}
+
 const Ref<Resources>& SnapDrawingViewManager::getResources() const {
     return _resources;
 }
@@ -81,6 +81,8 @@ public:
     Valdi::Ref<Valdi::IViewTransaction> createViewTransaction(
         const Valdi::Ref<Valdi::MainThreadManager>& mainThreadManager, bool shouldDefer) override;
 
+    void setPerformanceOverlayEnabled(bool enabled) override;
+
 private:
     [[maybe_unused]] Valdi::ILogger& _logger;
     Valdi::PlatformType _platformType;
@@ -14,6 +14,7 @@
 #include "valdi/snap_drawing/SnapDrawingLayerHolder.hpp"
 
 #include "snap_drawing/cpp/Drawing/DisplayList/DisplayList.hpp"
+#include "snap_drawing/cpp/Utils/PathCache.hpp"
 
 namespace snap::drawing {
 
@@ -144,6 +145,23 @@ Path pathFromValdiGeometricPath(const Valdi::BytesView& pathData, double width,
     return path;
 }
 
+Path pathFromValdiGeometricPath(PathCache* pathCache, const Valdi::BytesView& pathData, double width, double height) {
+    if (pathCache == nullptr) {
+        return pathFromValdiGeometricPath(pathData, width, height);
+    }
+
+    PathCacheKey key(pathData, Size::make(static_cast<Scalar>(width), static_cast<Scalar>(height)));
+    auto cachedPath = pathCache->find(key);
+    if (cachedPath) {
+        return std::move(cachedPath.value());
+    }
+
+    auto path = pathFromValdiGeometricPath(pathData, width, height);
+    pathCache->insert(std::move(key), path);
+
+    return path;
+}
+
 void drawLayerInCanvas(const Ref<Layer>& layer, DrawableSurfaceCanvas& canvas) {
     DrawMetrics metrics;
     auto displayList = Valdi::makeShared<DisplayList>(layer->getFrame().size(), TimePoint(0.0));
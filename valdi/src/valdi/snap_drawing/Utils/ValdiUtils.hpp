@@ -18,6 +18,7 @@ class ViewNode;
 namespace snap::drawing {
 
 class DrawableSurfaceCanvas;
+class PathCache;
 
 Valdi::Ref<Valdi::View> layerToValdiView(const Valdi::Ref<Layer>& layer, bool makeStrongRef);
 Valdi::Ref<Layer> valdiViewToLayer(const Valdi::Ref<Valdi::View>& view);
@@ -34,6 +35,10 @@ Color snapDrawingColorFromValdiColor(int64_t color);
 
 Path pathFromValdiGeometricPath(const Valdi::BytesView& pathData, double width, double height);
 
+// Same as pathFromValdiGeometricPath(), but returns the Path from the given cache when it is set,
+// so that all the layers using the same path data at the same size share it.
+Path pathFromValdiGeometricPath(PathCache* pathCache, const Valdi::BytesView& pathData, double width, double height);
+
 void drawLayerInCanvas(const Ref<Layer>& layer, DrawableSurfaceCanvas& canvas);
 
 } // namespace snap::drawing
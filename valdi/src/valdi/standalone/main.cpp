@@ -4,6 +4,7 @@
 #include "valdi/standalone_runtime/SignalHandler.hpp"
 #include "valdi/standalone_runtime/ValdiStandaloneMain.hpp"
 
+#include <cstdlib>
 #include <iostream>
 
 int main(int argc, const char** argv) {
@@ -35,6 +36,11 @@ int main(int argc, const char** argv) {
     auto debuggerServiceArgument =
         parser.addArgument("--debugger_service")->setDescription("Whether to enable the debugger service")->setAsFlag();
 
+    auto shardsArgument =
+        parser.addArgument("--shards")
+            ->setDescription("The number of processes in which the script is evaluated in parallel. Each process "
+                             "exposes its shard in valdiStandalone.shardIndex and valdiStandalone.shardsCount");
+
     auto remainderArgument = parser.addArgument("--")
                                  ->setDescription("Delimiter for arguments which will be passed to the JS context")
                                  ->setAsRemainder();
@@ -57,6 +63,14 @@ int main(int argc, const char** argv) {
     standaloneArguments.enableHotReloader = hotReloadArgument->hasValue();
     standaloneArguments.enableDebuggerService =
         debuggerServiceArgument->hasValue() || standaloneArguments.enableHotReloader;
+    if (shardsArgument->hasValue()) {
+        auto shardsCount = std::strtoul(shardsArgument->value().getCStr(), nullptr, 10);
+        if (shardsCount == 0) {
+            std::cerr << "Invalid number of shards: " << shardsArgument->value().toStringView() << std::endl;
+            return EXIT_FAILURE;
+        }
+        standaloneArguments.shardsCount = shardsCount;
+    }
     standaloneArguments.jsArguments.emplace_back(executablePath);
     standaloneArguments.jsArguments.insert(
         standaloneArguments.jsArguments.end(), remainderArgument->values().begin(), remainderArgument->values().end());
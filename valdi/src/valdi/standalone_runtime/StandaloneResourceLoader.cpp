@@ -44,7 +44,7 @@ Result<BytesView> StandaloneResourceLoader::loadModuleContent(const StringBox& m
     // Search in files second
     const auto& modulePathIt = _pathByModule.find(module);
     if (modulePathIt != _pathByModule.end()) {
-        return DiskUtils::load(modulePathIt->second);
+        return DiskUtils::loadMappedIfLarge(modulePathIt->second, FileAccessPattern::Random);
     }
 
     // Otherwise look in module search directories
@@ -77,7 +77,7 @@ void StandaloneResourceLoader::addModuleSearchDirectory(const StringBox& searchD
 Result<BytesView> StandaloneResourceLoader::searchForModule(const Path& directory, const StringBox& module) {
     auto file = directory.appending(module.toStringView());
     if (DiskUtils::isFile(file)) {
-        return DiskUtils::load(file);
+        return DiskUtils::loadMappedIfLarge(file, FileAccessPattern::Random);
     }
 
     if (DiskUtils::isDirectory(directory)) {
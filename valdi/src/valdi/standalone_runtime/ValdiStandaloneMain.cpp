@@ -19,7 +19,12 @@
 #include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
 
 namespace Valdi {
 
@@ -46,7 +51,7 @@ public:
 };
 } // namespace
 
-int runValdiStandalone(const StandaloneArguments& arguments) {
+static int runValdiStandaloneShard(const StandaloneArguments& arguments, size_t shardIndex) {
     ConsoleLogger::getLogger().setMinLogType(arguments.logLevel);
 
     auto resourceLoader = Valdi::makeShared<StandaloneResourceLoader>();
@@ -72,9 +77,47 @@ int runValdiStandalone(const StandaloneArguments& arguments) {
         runtime->getRuntimeManager().registerModuleFactoriesProvider(moduleFactoriesProvider);
     }
 
+    runtime->setShard(shardIndex, arguments.shardsCount);
     runtime->evalScript(arguments.scriptPath, arguments.jsArguments);
 
     return mainQueue->runIndefinitely();
 }
 
+static int runValdiStandaloneShards(const StandaloneArguments& arguments) {
+    // Each shard gets its own process, and thus its own runtime and JS heap. The processes are forked before
+    // any runtime is created.
+    std::vector<pid_t> shardProcesses;
+    for (size_t shardIndex = 0; shardIndex < arguments.shardsCount; shardIndex++) {
+        auto pid = fork();
+        if (pid == 0) {
+            std::exit(runValdiStandaloneShard(arguments, shardIndex));
+        }
+        if (pid < 0) {
+            std::cerr << "Failed to start shard " << shardIndex << ": " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        shardProcesses.emplace_back(pid);
+    }
+
+    auto exitCode = shardProcesses.size() == arguments.shardsCount ? EXIT_SUCCESS : EXIT_FAILURE;
+    for (size_t shardIndex = 0; shardIndex < shardProcesses.size(); shardIndex++) {
+        int status = 0;
+        if (waitpid(shardProcesses[shardIndex], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "Shard " << shardIndex << " failed" << std::endl;
+            exitCode = EXIT_FAILURE;
+        }
+    }
+
+    return exitCode;
+}
+
+int runValdiStandalone(const StandaloneArguments& arguments) {
+    if (arguments.shardsCount > 1) {
+        return runValdiStandaloneShards(arguments);
+    }
+
+    return runValdiStandaloneShard(arguments, 0);
+}
+
 } // namespace Valdi
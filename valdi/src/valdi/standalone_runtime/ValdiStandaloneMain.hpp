@@ -31,6 +31,9 @@ struct StandaloneArguments {
     std::vector<std::shared_ptr<snap::valdi_core::ModuleFactoriesProvider>> moduleFactoriesProviders;
     bool enableDebuggerService = false;
     bool enableHotReloader = false;
+    // When greater than 1, the script is evaluated in that many isolated processes, each of them
+    // being given its shard index so that it can run its own part of the tests.
+    size_t shardsCount = 1;
 };
 
 int runValdiStandalone(const StandaloneArguments& arguments);
@@ -152,6 +152,11 @@ Ref<ValueFunction> ValdiStandaloneRuntime::makeMainThreadFunction(const ValueFun
     });
 }
 
+void ValdiStandaloneRuntime::setShard(size_t shardIndex, size_t shardsCount) {
+    _shardIndex = shardIndex;
+    _shardsCount = shardsCount;
+}
+
 void ValdiStandaloneRuntime::setupJsRuntime(const std::vector<StringBox>& jsArguments) {
     auto exitCoordinator = _exitCoordinator;
 
@@ -170,6 +175,8 @@ void ValdiStandaloneRuntime::setupJsRuntime(const std::vector<StringBox>& jsArgu
             return Value::undefined();
         }));
     (*standaloneRuntime)[STRING_LITERAL("debuggerEnabled")] = Value(_runtimeManager->debuggerServiceEnabled());
+    (*standaloneRuntime)[STRING_LITERAL("shardIndex")] = Value(static_cast<int32_t>(_shardIndex));
+    (*standaloneRuntime)[STRING_LITERAL("shardsCount")] = Value(static_cast<int32_t>(_shardsCount));
 
     (*standaloneRuntime)[STRING_LITERAL("destroyAllComponents")] =
         Value(makeShared<ValueFunctionWithCallable>([this](const ValueFunctionCallContext& /*callContext*/) -> Value {
@@ -44,6 +44,12 @@ public:
     StandaloneViewManager& getViewManager() const;
     const Ref<ViewManagerContext>& getViewManagerContext() const;
 
+    /**
+     Set the shard of the tests that this runtime should run, which is exposed to the script
+     as valdiStandalone.shardIndex and valdiStandalone.shardsCount.
+     */
+    void setShard(size_t shardIndex, size_t shardsCount);
+
     void setupJsRuntime(const std::vector<StringBox>& jsArguments);
     void evalScript(const StringBox& scriptPath, const std::vector<StringBox>& jsArguments);
 
@@ -76,6 +82,8 @@ private:
     Ref<StandaloneExitCoordinator> _exitCoordinator;
     Ref<ViewManagerContext> _viewManagerContext;
     bool _shouldWaitForHotReload;
+    size_t _shardIndex = 0;
+    size_t _shardsCount = 1;
 
     Ref<ValueFunction> makeMainThreadFunction(const ValueFunctionCallable& callable);
 
@@ -10,13 +10,23 @@
 #include "utils/debugging/Assert.hpp"
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include <algorithm>
+#include <array>
 #include <cstdio>
 #include <fmt/format.h>
+#include <memory>
 #include <shared_mutex>
 
 namespace Valdi::V8 {
 // TODO(rjaber): The locking is unnecessary we should move towards a reference table with zero locks
-constexpr size_t kReferencesArrayMinSize = 8096;
+
+// Persistents are stored in fixed size slabs whose slots are reused through the free list of the
+// reference table. Growing the table never moves the existing slots, since copying a persistent
+// allocates a new V8 global handle.
+constexpr size_t kPersistentSlabSize = 1024;
+
+struct V8PersistentSlab {
+    std::array<v8::Persistent<v8::Value>, kPersistentSlabSize> slots;
+};
 
 class IndirectV8PersistentTable;
 
@@ -57,27 +67,22 @@ public:
         auto write = _table.writeAccess();
         auto entry = write.makeRef(tag);
 
-        auto index = entry.getIndex();
-        if (index >= _referenceArray.capacity()) {
-            auto newSize = std::max(index, std::max(kReferencesArrayMinSize, _referenceArray.capacity() * 2));
-            _referenceArray.reserve(newSize);
-        }
-
-        _referenceArray[index].Reset(isolate, value);
-        _referenceArray[index].SetWrapperClassId(kWrappedObjectID);
+        auto& slot = getOrCreateSlot(entry.getIndex());
+        slot.Reset(isolate, value);
+        slot.SetWrapperClassId(kWrappedObjectID);
         if (weak_deleter != nullptr && opaque != nullptr) {
             auto parameter = new V8ManagedPointerWrapper(opaque, weak_deleter, entry.id);
-            _referenceArray[index].SetWeak(
+            slot.SetWeak(
                 parameter,
                 [](const v8::WeakCallbackInfo<V8ManagedPointerWrapper>& info) {
                     info.GetParameter()->release();
                     delete info.GetParameter();
                 },
                 v8::WeakCallbackType::kParameter);
-            _referenceArray[index].SetWrapperClassId(kWrappedObjectID);
+            slot.SetWrapperClassId(kWrappedObjectID);
         } else {
-            _referenceArray[index].ClearWeak();
-            _referenceArray[index].SetWrapperClassId(kNoWrapperID);
+            slot.ClearWeak();
+            slot.SetWrapperClassId(kNoWrapperID);
         }
         return entry.id;
     }
@@ -93,7 +98,23 @@ public:
     void release(SequenceID id) {
         auto write = _table.writeAccess();
         if (!write.releaseRef(id)) {
-            _referenceArray[id.getIndex()].Reset();
+            getSlot(id.getIndex()).Reset();
+        }
+    }
+
+    void releaseAll(const IndirectV8Persistent* values, size_t count) {
+        auto write = _table.writeAccess();
+        _releaseBatch.clear();
+        _expiredBatch.clear();
+        for (size_t i = 0; i < count; i++) {
+            if (write.contains(values[i].getId())) {
+                _releaseBatch.emplace_back(values[i].getId());
+            }
+        }
+
+        write.releaseRefs(_releaseBatch, _expiredBatch);
+        for (const auto& id : _expiredBatch) {
+            getSlot(id.getIndex()).Reset();
         }
     }
 
@@ -103,9 +124,8 @@ public:
 
     std::pair<v8::Local<v8::Value>, uint16_t> newLocalRef(v8::Isolate* isolate, SequenceID id) const {
         auto read = _table.readAccess();
-        auto index = read.getEntry(id).getIndex();
-        return std::make_pair(v8::Local<v8::Value>::New(isolate, _referenceArray[index]),
-                              _referenceArray[index].WrapperClassId());
+        const auto& slot = getSlot(read.getEntry(id).getIndex());
+        return std::make_pair(v8::Local<v8::Value>::New(isolate, slot), slot.WrapperClassId());
     }
 
     ReferenceTableStats dumpStats() const {
@@ -119,7 +139,22 @@ public:
 
 private:
     ReferenceTable _table;
-    std::vector<v8::Persistent<v8::Value, v8::CopyablePersistentTraits<v8::Value>>> _referenceArray;
+    std::vector<std::unique_ptr<V8PersistentSlab>> _slabs;
+    // Reused by releaseAll() while holding the write access
+    std::vector<SequenceID> _releaseBatch;
+    std::vector<SequenceID> _expiredBatch;
+
+    v8::Persistent<v8::Value>& getOrCreateSlot(size_t index) {
+        auto slabIndex = index / kPersistentSlabSize;
+        while (slabIndex >= _slabs.size()) {
+            _slabs.emplace_back(std::make_unique<V8PersistentSlab>());
+        }
+        return _slabs[slabIndex]->slots[index % kPersistentSlabSize];
+    }
+
+    v8::Persistent<v8::Value>& getSlot(size_t index) const {
+        return _slabs[index / kPersistentSlabSize]->slots[index % kPersistentSlabSize];
+    }
 };
 
 void V8ManagedPointerWrapper::release() {
@@ -215,6 +250,17 @@ v8::Local<v8::External> IndirectV8Persistent::makeWeakExternal(v8::Isolate* isol
     return retval;
 }
 
+void IndirectV8Persistent::releaseAll(IndirectV8Persistent* values, size_t count) {
+    IndirectV8PersistentTable::get().releaseAll(values, count);
+    for (size_t i = 0; i < count; i++) {
+        values[i]._id = SequenceID();
+    }
+}
+
+SequenceID IndirectV8Persistent::getId() const {
+    return _id;
+}
+
 ReferenceTableStats IndirectV8Persistent::dumpStats() {
     return IndirectV8PersistentTable::get().dumpStats();
 }
@@ -54,6 +54,13 @@ public:
     void retain();
     void release();
 
+    /**
+     Release all the given persistents under a single lock of the persistents table.
+     */
+    static void releaseAll(IndirectV8Persistent* values, size_t count);
+
+    SequenceID getId() const;
+
     static ReferenceTableStats dumpStats();
 
 private:
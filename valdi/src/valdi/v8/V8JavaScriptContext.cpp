@@ -6,6 +6,7 @@
 //
 
 #include "valdi/v8/V8JavaScriptContext.hpp"
+#include "utils/base/NonCopyable.hpp"
 #include "valdi/runtime/JavaScript/JavaScriptFunctionCallContext.hpp"
 #include "valdi/runtime/Utils/RefCountableAutoreleasePool.hpp"
 #include "valdi/v8/HeapDumpOutputStream.hpp"
@@ -13,6 +14,7 @@
 
 #include "valdi_core/cpp/Text/UTF16Utils.hpp"
 #include "valdi_core/cpp/Utils/ReferenceInfo.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
 
 #include "valdi/v8/V8JavaScriptContext.hpp"
@@ -26,7 +28,7 @@
 #include <iostream>
 
 namespace {
-void initializeV8Engine() {
+v8::Platform& initializeV8Engine() {
     static std::once_flag flag;
     static std::unique_ptr<v8::Platform> platform;
     std::call_once(flag, [&]() {
@@ -37,6 +39,7 @@ void initializeV8Engine() {
         v8::V8::InitializePlatform(platform.get());
         v8::V8::Initialize();
     });
+    return *platform;
 }
 } // namespace
 
@@ -158,8 +161,8 @@ inline void setObjectPropertyIndexHelper(v8::Local<v8::Context>& context,
     }
 }
 
-V8JavaScriptContext::V8JavaScriptContext(JavaScriptTaskScheduler* taskScheduler) : IJavaScriptContext(taskScheduler) {
-    initializeV8Engine();
+V8JavaScriptContext::V8JavaScriptContext(JavaScriptTaskScheduler* taskScheduler)
+    : IJavaScriptContext(taskScheduler), _platform(initializeV8Engine()) {
     _allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
     _params.array_buffer_allocator = _allocator;
     _isolate = v8::Isolate::New(_params);
@@ -174,10 +177,10 @@ V8JavaScriptContext::V8JavaScriptContext(JavaScriptTaskScheduler* taskScheduler)
 
     auto valdiObjectTemplate = v8::ObjectTemplate::New(_isolate);
     valdiObjectTemplate->SetInternalFieldCount(static_cast<int>(InternalFieldSlot::Count));
-    _valdiObjectTemplate.Reset(_isolate, valdiObjectTemplate);
+    _valdiObjectTemplate.Set(_isolate, valdiObjectTemplate);
     auto propertyString = v8::String::NewFromUtf8Literal(_isolate, "com.snapinc.valdi.js.v8.function.private_prop");
     auto functionPrivate = v8::Private::New(_isolate, propertyString);
-    _functionDataProperty.Reset(_isolate, functionPrivate);
+    _functionDataProperty.Set(_isolate, functionPrivate);
 }
 
 V8JavaScriptContext::~V8JavaScriptContext() {
@@ -288,6 +291,30 @@ JSValueRef V8JavaScriptContext::newObject(JSExceptionTracker& exceptionTracker)
     return toRetainedJSValueRef(IndirectV8Persistent::make(_isolate, val));
 }
 
+/**
+ Holds the persistents of the arguments and of the this value of a native call. They only need
+ to outlive the call, and are released together once it returns. Callees which keep one of the
+ arguments around retain it beforehand.
+ */
+class V8CallPersistents : public snap::NonCopyable {
+public:
+    explicit V8CallPersistents(size_t capacity) {
+        _persistents.reserve(capacity);
+    }
+
+    ~V8CallPersistents() {
+        IndirectV8Persistent::releaseAll(_persistents.data(), _persistents.size());
+    }
+
+    const IndirectV8Persistent& make(v8::Isolate* isolate, const v8::Local<v8::Value>& value) {
+        _persistents.emplace_back(IndirectV8Persistent::make(isolate, value));
+        return _persistents.back();
+    }
+
+private:
+    SmallVector<IndirectV8Persistent, 8> _persistents;
+};
+
 static void InvokeCallable(const v8::FunctionCallbackInfo<v8::Value>& info) {
     auto isolate = info.GetIsolate();
     v8::HandleScope handleScope(isolate);
@@ -301,16 +328,18 @@ static void InvokeCallable(const v8::FunctionCallbackInfo<v8::Value>& info) {
     }
 
     auto callable = unsafeBridge<JSFunction>(data);
-    JSValueRef outArguments[info.Length()];
-    for (int i = 0; i < info.Length(); i++) {
-        outArguments[i] =
-            JSValueRef::makeUnretained(*context, toValdiJSValue(IndirectV8Persistent::make(isolate, info[i])));
+    auto argumentsCount = static_cast<size_t>(info.Length());
+    V8CallPersistents callPersistents(argumentsCount + 1);
+    JSValueRef outArguments[argumentsCount];
+    for (size_t i = 0; i < argumentsCount; i++) {
+        outArguments[i] = JSValueRef::makeUnretained(
+            *context, toValdiJSValue(callPersistents.make(isolate, info[static_cast<int>(i)])));
     }
 
     JSExceptionTracker tracker(*context);
     JSFunctionNativeCallContext callContext(
-        *context, outArguments, info.Length(), tracker, callable->getReferenceInfo());
-    callContext.setThisValue(toValdiJSValue(IndirectV8Persistent::make(isolate, info.This())));
+        *context, outArguments, argumentsCount, tracker, callable->getReferenceInfo());
+    callContext.setThisValue(toValdiJSValue(callPersistents.make(isolate, info.This())));
 
     if (context->interruptRequested()) {
         context->onInterrupt();
@@ -1091,6 +1120,15 @@ void V8JavaScriptContext::garbageCollect() {
     _isolate->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
 }
 
+bool V8JavaScriptContext::performIdleGarbageCollection(std::chrono::steady_clock::duration budget) {
+    auto budgetSeconds = std::chrono::duration_cast<std::chrono::duration<double>>(budget).count();
+    auto deadline = _platform.MonotonicallyIncreasingTime() + budgetSeconds;
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    return _isolate->IdleNotificationDeadline(deadline);
+#pragma clang diagnostic pop
+}
+
 JavaScriptContextMemoryStatistics V8JavaScriptContext::dumpMemoryStatistics() {
     JavaScriptContextMemoryStatistics retval;
 
@@ -136,6 +136,7 @@ public:
     void releasePropertyName(const JSPropertyName& value) override;
 
     void garbageCollect() override;
+    bool performIdleGarbageCollection(std::chrono::steady_clock::duration budget) override;
 
     JavaScriptContextMemoryStatistics dumpMemoryStatistics() override;
     void enqueueMicrotask(const JSValue& value, JSExceptionTracker& exceptionTracker) override;
@@ -163,12 +164,14 @@ private:
     inline JSValueRef toRetainedJSValueRef(const IndirectV8Persistent& value);
     inline JSValueRef toUnretainedJSValueRef(const IndirectV8Persistent& value);
 
+    v8::Platform& _platform;
     v8::ArrayBuffer::Allocator* _allocator;
     v8::Isolate::CreateParams _params;
     v8::Isolate* _isolate;
     v8::Global<v8::Context> _context;
-    v8::Persistent<v8::ObjectTemplate> _valdiObjectTemplate;
-    v8::Persistent<v8::Private> _functionDataProperty;
+    // Those live as long as the isolate
+    v8::Eternal<v8::ObjectTemplate> _valdiObjectTemplate;
+    v8::Eternal<v8::Private> _functionDataProperty;
 };
 
 } // namespace Valdi::V8
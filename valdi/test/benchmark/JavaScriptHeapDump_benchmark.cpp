@@ -1,4 +1,5 @@
 #include "valdi/runtime/JavaScript/JavaScriptHeapDumpBuilder.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptHeapDumpOutputStream.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include <benchmark/benchmark.h>
@@ -47,6 +48,61 @@ static void BuildHeapDump(benchmark::State& state) {
 }
 BENCHMARK(BuildHeapDump);
 
+class DiscardingOutputStream : public JavaScriptHeapDumpOutputStream {
+public:
+    Result<Void> write(const Byte* /*data*/, size_t length) override {
+        totalBytes += length;
+        maxChunkSize = std::max(maxChunkSize, length);
+        return Void();
+    }
+
+    size_t totalBytes = 0;
+    size_t maxChunkSize = 0;
+};
+
+static void WriteHeapDumpChunked(benchmark::State& state) {
+    BenchmarkHelper helper;
+    DiscardingOutputStream output;
+
+    for (auto _ : state) {
+        JavaScriptHeapDumpBuilder builder;
+        helper.populateHeapDumpBuilder(builder);
+
+        benchmark::DoNotOptimize(builder.write(output, 64 * 1024));
+    }
+
+    state.counters["MaxChunkSize"] = static_cast<double>(output.maxChunkSize);
+    state.SetBytesProcessed(static_cast<int64_t>(output.totalBytes));
+}
+BENCHMARK(WriteHeapDumpChunked);
+
+static void WriteHeapDumpCompressed(benchmark::State& state) {
+    BenchmarkHelper helper;
+    DiscardingOutputStream output;
+
+    for (auto _ : state) {
+        JavaScriptHeapDumpBuilder builder;
+        helper.populateHeapDumpBuilder(builder);
+
+        JavaScriptHeapDumpZStdOutputStream compressedOutput(output, 3);
+        benchmark::DoNotOptimize(builder.write(compressedOutput, 64 * 1024));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(output.totalBytes));
+}
+BENCHMARK(WriteHeapDumpCompressed);
+
+static void BuildHeapDumpSummary(benchmark::State& state) {
+    BenchmarkHelper helper;
+    JavaScriptHeapDumpBuilder builder;
+    helper.populateHeapDumpBuilder(builder);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(builder.buildSummary(100));
+    }
+}
+BENCHMARK(BuildHeapDumpSummary);
+
 static void ParseHeapDump(benchmark::State& state) {
     BenchmarkHelper helper;
     JavaScriptHeapDumpBuilder builder;
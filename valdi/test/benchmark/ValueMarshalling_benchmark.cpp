@@ -0,0 +1,381 @@
+// Benchmarks of the conversions between Valdi values and JS values, for every JS engine available in the build.
+// Each benchmark is registered as <Case>/<Engine>[/<Size>], results can be exported in a machine readable format
+// with --benchmark_out=<path> --benchmark_out_format=json to compare engines and track marshaller regressions.
+
+#include "utils/debugging/Assert.hpp"
+#include "valdi/jsbridge/JavaScriptBridge.hpp"
+#include "valdi/runtime/Context/Context.hpp"
+#include "valdi/runtime/Interfaces/IJavaScriptBridge.hpp"
+#include "valdi/runtime/Interfaces/IJavaScriptContext.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptContextEntryPoint.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptFunctionCallContext.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptTaskScheduler.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptValueMarshaller.hpp"
+#include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Threading/TaskQueue.hpp"
+#include "valdi_core/cpp/Threading/Thread.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/ResolvablePromise.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+#include "valdi_core/cpp/Utils/ValueFunctionWithCallable.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
+#include "valdi_core/cpp/Utils/ValueTypedObject.hpp"
+
+#if VALDI_HAS_V8
+#include "valdi/v8/V8JavaScriptContextFactory.hpp"
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Valdi;
+using namespace snap::valdi_core;
+
+namespace {
+
+struct BenchmarkTaskScheduler : public JavaScriptTaskScheduler {
+    Ref<Context> valdiContext;
+    IJavaScriptContext* jsContext = nullptr;
+    Ref<TaskQueue> taskQueue = makeShared<TaskQueue>();
+
+    explicit BenchmarkTaskScheduler(const Ref<Context>& valdiContext) : valdiContext(valdiContext) {}
+
+    void dispatchOnJsThread(Ref<Context> ownerContext,
+                            JavaScriptTaskScheduleType scheduleType,
+                            uint32_t delayMs,
+                            JavaScriptThreadTask&& function) override {
+        auto executeValdiContext = ownerContext != nullptr ? ownerContext : valdiContext;
+        taskQueue->enqueue(
+            [this, executeValdiContext = std::move(executeValdiContext), function = std::move(function)]() {
+                JSExceptionTracker exceptionTracker(*jsContext);
+                JavaScriptContextEntry contextEntry(executeValdiContext);
+                jsContext->willEnterVM();
+                JavaScriptEntryParameters entryParameters(*jsContext, exceptionTracker, executeValdiContext);
+                function(entryParameters);
+                jsContext->willExitVM(exceptionTracker);
+            },
+            std::chrono::milliseconds(delayMs));
+
+        if (scheduleType == JavaScriptTaskScheduleTypeAlwaysSync) {
+            taskQueue->flushUpToNow();
+        }
+    }
+
+    bool isInJsThread() override {
+        return true;
+    }
+
+    Ref<Context> getLastDispatchedContext() const override {
+        return nullptr;
+    }
+
+    std::vector<JavaScriptCapturedStacktrace> captureStackTraces(
+        std::chrono::steady_clock::duration /*timeout*/) override {
+        return {};
+    }
+};
+
+/**
+ * Owns a JS context of the given engine, entered for the lifetime of the object.
+ */
+class BenchmarkJSContext {
+public:
+    explicit BenchmarkJSContext(IJavaScriptBridge* jsBridge)
+        : _valdiContext(makeShared<Context>(1, strongSmallRef(&ConsoleLogger::getLogger()))),
+          _taskScheduler(makeShared<BenchmarkTaskScheduler>(_valdiContext)),
+          _jsContext(jsBridge->createJsContext(_taskScheduler.get(), ConsoleLogger::getLogger())),
+          _exceptionTracker(*_jsContext),
+          _contextEntry(_valdiContext) {
+        _taskScheduler->jsContext = _jsContext.get();
+        _valdiContext->retainDisposables();
+        _jsContext->willEnterVM();
+        _jsContext->initialize(IJavaScriptContextConfig(), _exceptionTracker);
+        checkException();
+    }
+
+    ~BenchmarkJSContext() {
+        _jsContext->willExitVM(_exceptionTracker);
+        _valdiContext->releaseDisposables();
+        _taskScheduler->taskQueue->flushUpToNow();
+        _taskScheduler->taskQueue->dispose();
+    }
+
+    IJavaScriptContext& getContext() {
+        return *_jsContext;
+    }
+
+    JSExceptionTracker& getExceptionTracker() {
+        return _exceptionTracker;
+    }
+
+    JSValueRef evaluate(const std::string& script) {
+        auto result = _jsContext->evaluate(script, "benchmark.js", _exceptionTracker);
+        checkException();
+        return result;
+    }
+
+    void checkException() {
+        if (!_exceptionTracker) {
+            auto error = _exceptionTracker.extractError();
+            ConsoleLogger::getLogger().log(LogTypeError, error.toString());
+            std::abort();
+        }
+    }
+
+private:
+    Ref<Context> _valdiContext;
+    Ref<BenchmarkTaskScheduler> _taskScheduler;
+    Ref<IJavaScriptContext> _jsContext;
+    JSExceptionTracker _exceptionTracker;
+    JavaScriptContextEntry _contextEntry;
+};
+
+using BenchmarkFunction = void (*)(BenchmarkJSContext& jsContext, benchmark::State& state);
+
+static std::vector<std::pair<std::string, IJavaScriptBridge*>> getJsBridges() {
+    std::vector<std::pair<std::string, IJavaScriptBridge*>> jsBridges;
+#if VALDI_HAS_QUICKJS
+    jsBridges.emplace_back("QuickJS", JavaScriptBridge::get(JavaScriptEngineType::QuickJS));
+#endif
+#if VALDI_HAS_JSCORE
+    jsBridges.emplace_back("JSCore", JavaScriptBridge::get(JavaScriptEngineType::JSCore));
+#endif
+#if VALDI_HAS_HERMES
+    jsBridges.emplace_back("Hermes", JavaScriptBridge::get(JavaScriptEngineType::Hermes));
+#endif
+#if VALDI_HAS_V8
+    // The V8 bridge is not part of the runtime with VM, it is linked into this benchmark directly
+    static auto* kV8Bridge = new V8::V8JavaScriptContextFactory();
+    jsBridges.emplace_back("V8", kV8Bridge);
+#endif
+    return jsBridges;
+}
+
+static ValueSchema parseSchema(std::string_view schemaString) {
+    auto schema = ValueSchema::parse(schemaString);
+    SC_ASSERT(schema.success(), schema.description());
+    return schema.moveValue();
+}
+
+static const ValueSchema& getItemSchema() {
+    static auto kSchema = parseSchema("c 'BenchmarkItem'{'title': s, 'subtitle': s?, 'count': d, "
+                                      "'enabled': b, 'tags': a<s>, 'score': d?}");
+    return kSchema;
+}
+
+static Ref<ValueTypedObject> makeItem(size_t index) {
+    auto tags = ValueArray::make(3);
+    for (size_t i = 0; i < tags->size(); i++) {
+        tags->emplace(i, Value(StringCache::getGlobal().makeString(std::string("tag") + std::to_string(i))));
+    }
+
+    return ValueTypedObject::make(getItemSchema().getClassRef(),
+                                  {Value(StringCache::getGlobal().makeString("Item " + std::to_string(index))),
+                                   Value::undefined(),
+                                   Value(static_cast<double>(index)),
+                                   Value(index % 2 == 0),
+                                   Value(tags),
+                                   Value(0.5)});
+}
+
+static Value makeMap(size_t entriesCount) {
+    Value map;
+    for (size_t i = 0; i < entriesCount; i++) {
+        auto key = StringCache::getGlobal().makeString("key" + std::to_string(i));
+        if (i % 2 == 0) {
+            map.setMapValue(key, Value(static_cast<double>(i)));
+        } else {
+            map.setMapValue(key, Value(key));
+        }
+    }
+    return map;
+}
+
+static void TypedObjectToJS(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    auto item = makeItem(0);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(typedObjectToJSValue(
+            jsContext.getContext(), item, ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+}
+
+static void TypedObjectFromJS(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    auto jsItem = typedObjectToJSValue(
+        jsContext.getContext(), makeItem(0), ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+    auto* valueMarshaller = jsContext.getContext().getValueMarshaller();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(valueMarshaller->marshall(
+            jsItem, getItemSchema(), ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+}
+
+static void MapRoundTrip(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    auto map = makeMap(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        auto jsMap =
+            valueToJSValue(jsContext.getContext(), map, ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+        benchmark::DoNotOptimize(jsValueToValue(
+            jsContext.getContext(), jsMap.get(), ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ArrayRoundTrip(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    auto size = static_cast<size_t>(state.range(0));
+    auto array = ValueArray::make(size);
+    for (size_t i = 0; i < size; i++) {
+        array->emplace(i, Value(static_cast<double>(i)));
+    }
+    auto arrayValue = Value(array);
+
+    for (auto _ : state) {
+        auto jsArray =
+            valueToJSValue(jsContext.getContext(), arrayValue, ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+        benchmark::DoNotOptimize(jsValueToValue(
+            jsContext.getContext(), jsArray.get(), ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void StringRoundTrip(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    auto length = static_cast<size_t>(state.range(0));
+    auto string = Value(StringCache::getGlobal().makeString(std::string(length, 'a')));
+
+    for (auto _ : state) {
+        auto jsString =
+            valueToJSValue(jsContext.getContext(), string, ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+        benchmark::DoNotOptimize(jsValueToValue(
+            jsContext.getContext(), jsString.get(), ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void CallJSFunctionFromNative(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    auto jsFunction = jsContext.evaluate("(function(title, count) { return title.length + count; })");
+    auto title = Value(STRING_LITERAL("Hello World"));
+
+    for (auto _ : state) {
+        JSValueRef parameters[2];
+        parameters[0] =
+            valueToJSValue(jsContext.getContext(), title, ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+        parameters[1] = jsContext.getContext().newNumber(42.0);
+
+        JSFunctionCallContext callContext(jsContext.getContext(), parameters, 2, jsContext.getExceptionTracker());
+        auto result = jsContext.getContext().callObjectAsFunction(jsFunction.get(), callContext);
+        benchmark::DoNotOptimize(jsValueToValue(
+            jsContext.getContext(), result.get(), ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+}
+
+static void CallNativeFunctionFromJS(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    constexpr size_t kCallsPerIteration = 100;
+
+    auto callLoop = jsContext.evaluate("(function(fn, count) { for (let i = 0; i < count; i++) { fn('title', i); } })");
+    auto nativeFunction = makeShared<ValueFunctionWithCallable>(
+        [](const ValueFunctionCallContext& callContext) { return Value(callContext.getParameterAsInt(1)); });
+    auto jsNativeFunction = valueToJSValue(
+        jsContext.getContext(), Value(nativeFunction), ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+
+    for (auto _ : state) {
+        JSValueRef parameters[2];
+        parameters[0] = jsNativeFunction;
+        parameters[1] = jsContext.getContext().newNumber(static_cast<double>(kCallsPerIteration));
+
+        JSFunctionCallContext callContext(jsContext.getContext(), parameters, 2, jsContext.getExceptionTracker());
+        benchmark::DoNotOptimize(jsContext.getContext().callObjectAsFunction(callLoop.get(), callContext));
+    }
+    jsContext.checkException();
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kCallsPerIteration));
+}
+
+static void PromiseRoundTrip(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    static auto kSchema = parseSchema("c 'BenchmarkPromiseHolder'{'value': p<d>}");
+    auto* valueMarshaller = jsContext.getContext().getValueMarshaller();
+
+    for (auto _ : state) {
+        auto promise = makeShared<ResolvablePromise>();
+        promise->fulfill(Value(42.0));
+
+        auto holder = ValueTypedObject::make(kSchema.getClassRef(), {Value(promise)});
+        auto jsHolder = typedObjectToJSValue(
+            jsContext.getContext(), holder, ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+        benchmark::DoNotOptimize(
+            valueMarshaller->marshall(jsHolder, kSchema, ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+}
+
+static void TypedArrayRoundTrip(BenchmarkJSContext& jsContext, benchmark::State& state) {
+    auto length = static_cast<size_t>(state.range(0));
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(length);
+    auto typedArray = Value(makeShared<ValueTypedArray>(Uint8Array, buffer->toBytesView()));
+
+    for (auto _ : state) {
+        auto jsTypedArray =
+            valueToJSValue(jsContext.getContext(), typedArray, ReferenceInfoBuilder(), jsContext.getExceptionTracker());
+        benchmark::DoNotOptimize(jsValueToValue(
+            jsContext.getContext(), jsTypedArray.get(), ReferenceInfoBuilder(), jsContext.getExceptionTracker()));
+    }
+    jsContext.checkException();
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+static void registerBenchmark(const std::string& name,
+                              const std::string& engineName,
+                              IJavaScriptBridge* jsBridge,
+                              BenchmarkFunction function,
+                              const std::vector<int64_t>& sizes) {
+    auto* registeredBenchmark = benchmark::RegisterBenchmark(
+        (name + "/" + engineName).c_str(), [jsBridge, function, engineName](benchmark::State& state) {
+            BenchmarkJSContext jsContext(jsBridge);
+            function(jsContext, state);
+            state.SetLabel(engineName);
+        });
+
+    for (auto size : sizes) {
+        registeredBenchmark->Arg(size);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MAIN_THREAD_INIT();
+    ConsoleLogger::getLogger().setMinLogType(LogTypeWarn);
+
+    for (const auto& [engineName, jsBridge] : getJsBridges()) {
+        registerBenchmark("TypedObjectToJS", engineName, jsBridge, &TypedObjectToJS, {});
+        registerBenchmark("TypedObjectFromJS", engineName, jsBridge, &TypedObjectFromJS, {});
+        registerBenchmark("MapRoundTrip", engineName, jsBridge, &MapRoundTrip, {4, 64});
+        registerBenchmark("ArrayRoundTrip", engineName, jsBridge, &ArrayRoundTrip, {16, 1024});
+        registerBenchmark("StringRoundTrip", engineName, jsBridge, &StringRoundTrip, {8, 256, 16 * 1024});
+        registerBenchmark("CallJSFunctionFromNative", engineName, jsBridge, &CallJSFunctionFromNative, {});
+        registerBenchmark("CallNativeFunctionFromJS", engineName, jsBridge, &CallNativeFunctionFromJS, {});
+        registerBenchmark("PromiseRoundTrip", engineName, jsBridge, &PromiseRoundTrip, {});
+        registerBenchmark("TypedArrayRoundTrip", engineName, jsBridge, &TypedArrayRoundTrip, {1024, 1024 * 1024});
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
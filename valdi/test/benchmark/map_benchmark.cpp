@@ -6,6 +6,47 @@
 
 using namespace Valdi;
 
+/**
+ A sample of attribute names as they appear in style and attribute maps, which are
+ the most common keys of ValueMap instances at runtime.
+ */
+static std::vector<StringBox> makeAttributeNames(StringCache& stringCache) {
+    static const std::vector<std::string> kAttributeNames = {
+        "width",        "height",      "flexDirection", "justifyContent", "alignItems",    "backgroundColor",
+        "borderRadius", "opacity",     "marginLeft",    "marginRight",    "marginTop",     "marginBottom",
+        "paddingLeft",  "paddingRight", "paddingTop",   "paddingBottom",  "font",          "color",
+        "value",        "textAlign",   "onTap",         "style",          "numberOfLines", "accessibilityId",
+        "class",        "id",          "position",      "left",           "top",           "flexGrow",
+        "flexShrink",   "overflow",
+    };
+
+    return internStrings(stringCache, kAttributeNames);
+}
+
+template<typename Map>
+static void queryAttributeNames(benchmark::State& state, bool includeMisses) {
+    StringCache stringCache;
+    auto attributeNames = makeAttributeNames(stringCache);
+    auto size = std::min(static_cast<size_t>(state.range(0)), attributeNames.size());
+
+    Map map;
+    for (size_t i = 0; i < size; i++) {
+        map[attributeNames[i]] = true;
+    }
+
+    // Lookups of attributes which were not set are as common as hits when resolving styles
+    const auto& queriedNames =
+        includeMisses ? attributeNames : std::vector<StringBox>(attributeNames.begin(), attributeNames.begin() + size);
+
+    for (auto _ : state) {
+        for (const auto& str : queriedNames) {
+            const auto& it = map.find(str);
+
+            benchmark::DoNotOptimize(it != map.end());
+        }
+    }
+}
+
 static void CreateUnorderedMap(benchmark::State& state) {
     StringCache stringCache;
     auto cachedStrings = makeRandomInternedStrings(stringCache, state.range(0), 10);
@@ -140,4 +181,24 @@ static void IterateFlatMap(benchmark::State& state) {
 }
 BENCHMARK(IterateFlatMap)->DenseRange(8, 128, 8);
 
+static void QueryAttributeNamesUnorderedMap(benchmark::State& state) {
+    queryAttributeNames<std::unordered_map<StringBox, bool>>(state, false);
+}
+BENCHMARK(QueryAttributeNamesUnorderedMap)->DenseRange(4, 32, 4);
+
+static void QueryAttributeNamesFlatMap(benchmark::State& state) {
+    queryAttributeNames<Valdi::FlatMap<StringBox, bool>>(state, false);
+}
+BENCHMARK(QueryAttributeNamesFlatMap)->DenseRange(4, 32, 4);
+
+static void QueryAttributeNamesWithMissesUnorderedMap(benchmark::State& state) {
+    queryAttributeNames<std::unordered_map<StringBox, bool>>(state, true);
+}
+BENCHMARK(QueryAttributeNamesWithMissesUnorderedMap)->DenseRange(4, 32, 4);
+
+static void QueryAttributeNamesWithMissesFlatMap(benchmark::State& state) {
+    queryAttributeNames<Valdi::FlatMap<StringBox, bool>>(state, true);
+}
+BENCHMARK(QueryAttributeNamesWithMissesFlatMap)->DenseRange(4, 32, 4);
+
 BENCHMARK_MAIN();
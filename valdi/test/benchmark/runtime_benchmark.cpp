@@ -1,5 +1,8 @@
 #include "benchmark_utils.hpp"
+#include "valdi_core/cpp/Threading/TaskQueue.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
 #include "valdi_test_utils.hpp"
+#include <array>
 #include <benchmark/benchmark.h>
 
 using namespace ValdiTest;
@@ -78,4 +81,28 @@ static void UpdateCSS(benchmark::State& state) {
 }
 BENCHMARK(UpdateCSS);
 
+template<size_t CaptureSize>
+static void TaskQueueAsync(benchmark::State& state) {
+    TaskQueue taskQueue;
+    auto object = makeShared<ValueMap>();
+    auto value = Value(STRING_LITERAL("Hello"));
+    std::array<uint8_t, CaptureSize> capture{};
+
+    AllocationProfiler::setEnabled(true);
+    auto snapshot = AllocationCounters::current();
+
+    for (auto _ : state) {
+        taskQueue.async([object, value, capture]() { benchmark::DoNotOptimize(capture); });
+        taskQueue.runNextTask();
+    }
+
+    auto allocations = AllocationCounters::current().since(snapshot);
+    AllocationProfiler::setEnabled(false);
+
+    state.counters["ClosureAllocationsPerAsync"] = benchmark::Counter(
+        static_cast<double>(allocations.getCount(AllocationSite::DispatchClosure)), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_TEMPLATE(TaskQueueAsync, 16);
+BENCHMARK_TEMPLATE(TaskQueueAsync, 256);
+
 BENCHMARK_MAIN();
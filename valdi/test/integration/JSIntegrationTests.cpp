@@ -1,8 +1,10 @@
 #include "JSBridgeTestFixture.hpp"
 #include "JSIntegrationTestsUtils.hpp"
 #include "utils/platform/TargetPlatform.hpp"
+#include "valdi/quickjs/QuickJSJavaScriptContextFactory.hpp"
 #include "valdi/runtime/Interfaces/IJavaScriptBridge.hpp"
 #include "valdi/runtime/JavaScript/JSFunctionWithCallable.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptLazyArray.hpp"
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/StaticString.hpp"
 #include <future>
@@ -395,6 +397,67 @@ TEST_P(JSContextFixture, canCreateArray) {
     ASSERT_EQ(Value(expectedValue.build()), value1);
 }
 
+TEST_P(JSContextFixture, canCreateLazyArray) {
+    MAIN_THREAD_INIT();
+    auto wrapper = createWrapper();
+
+    auto jsEntry = wrapper.makeJsEntry();
+    auto& context = jsEntry.context;
+    auto& exceptionTracker = jsEntry.exceptionTracker;
+
+    auto items = ValueArrayBuilder();
+    for (int32_t i = 0; i < 100; i++) {
+        items.append(Value(i * 2));
+    }
+
+    auto lazyArray = newLazyJSArray(context, items.build(), 8, ReferenceInfoBuilder(), exceptionTracker);
+    jsEntry.checkException();
+
+    auto func = context.evaluate(R""""(
+        (function(array) {
+            const result = [
+                Array.isArray(array),
+                array.length,
+                array[42],
+                array.slice(97),
+                5 in array,
+                100 in array,
+                Object.keys(array).length,
+                [...array].reduce((a, b) => a + b, 0),
+            ];
+            array[3] = 'updated';
+            array.length = 10;
+            result.push(array[3], array.length, array[50]);
+            return result;
+        });
+    )"""",
+                                 "",
+                                 exceptionTracker);
+    jsEntry.checkException();
+
+    Valdi::JSFunctionCallContext params(context, &lazyArray, 1, exceptionTracker);
+    auto result = context.callObjectAsFunction(func.get(), params);
+    jsEntry.checkException();
+
+    auto value = jsValueToValue(context, result.get(), ReferenceInfoBuilder(), exceptionTracker);
+    jsEntry.checkException();
+
+    auto expectedValue = ValueArrayBuilder();
+    expectedValue.append(Value(true));
+    expectedValue.append(Value(100.0));
+    expectedValue.append(Value(84.0));
+    expectedValue.append(Value(ValueArray::make({Value(194.0), Value(196.0), Value(198.0)})));
+    expectedValue.append(Value(true));
+    expectedValue.append(Value(false));
+    expectedValue.append(Value(100.0));
+    expectedValue.append(Value(9900.0));
+    expectedValue.append(Value(STRING_LITERAL("updated")));
+    expectedValue.append(Value(10.0));
+    expectedValue.append(Value::undefined());
+
+    ASSERT_EQ(Value(expectedValue.build()), value);
+}
+
 TEST_P(JSContextFixture, canCreateAndCallFunction) {
     SKIP_IF_V8("Ticket: 2249");
     MAIN_THREAD_INIT();
@@ -641,6 +704,54 @@ TEST_P(JSContextFixture, unwrapsJsTypedArray) {
     ASSERT_EQ(static_cast<Byte>(7), cppTypedArray->getBuffer().data()[0]);
 }
 
+TEST_P(JSContextFixture, wrapsSubRangeOfJsTypedArrayWithoutCopy) {
+    SKIP_IF_V8("Ticket: 2254");
+    MAIN_THREAD_INIT();
+    auto wrapper = createWrapper();
+
+    auto jsEntry = wrapper.makeJsEntry();
+    auto& context = jsEntry.context;
+    auto& exceptionTracker = jsEntry.exceptionTracker;
+
+    auto globalObject = context.getGlobalObject(exceptionTracker);
+    jsEntry.checkException();
+    auto uint8ArrayCtor = context.getObjectProperty(globalObject.get(), "Uint8Array", exceptionTracker);
+    jsEntry.checkException();
+
+    std::initializer_list<JSValueRef> uint8Params = {context.newNumber(4)};
+
+    JSFunctionCallContext uint8CallContext(context, uint8Params.begin(), uint8Params.size(), exceptionTracker);
+
+    auto uint8ArrayRef = context.callObjectAsConstructor(uint8ArrayCtor.get(), uint8CallContext);
+    jsEntry.checkException();
+
+    for (size_t i = 0; i < 4; i++) {
+        auto value = context.newNumber(static_cast<int32_t>(i + 1));
+        context.setObjectPropertyIndex(uint8ArrayRef.get(), i, value.get(), exceptionTracker);
+        jsEntry.checkException();
+    }
+
+    auto cppTypedArray =
+        jsTypedArrayToValueTypedArray(context, uint8ArrayRef.get(), ReferenceInfoBuilder(), exceptionTracker);
+    jsEntry.checkException();
+
+    const auto& buffer = cppTypedArray->getBuffer();
+    ASSERT_EQ(static_cast<size_t>(4), buffer.size());
+
+    // Wrap the middle of the buffer, like a bytes field of a message decoded from a JS buffer
+    auto newJsTypedArray = newTypedArrayFromBytesView(
+        context, Uint8Array, BytesView(buffer.getSource(), buffer.data() + 1, 2), exceptionTracker);
+    jsEntry.checkException();
+
+    auto newTypedArray = context.valueToTypedArray(newJsTypedArray.get(), exceptionTracker);
+    jsEntry.checkException();
+
+    ASSERT_EQ(static_cast<size_t>(2), newTypedArray.length);
+    ASSERT_EQ(static_cast<const void*>(buffer.data() + 1), newTypedArray.data);
+    ASSERT_EQ(static_cast<Byte>(2), reinterpret_cast<const Byte*>(newTypedArray.data)[0]);
+    ASSERT_EQ(static_cast<Byte>(3), reinterpret_cast<const Byte*>(newTypedArray.data)[1]);
+}
+
 struct DummyObject : public Valdi::ValdiObject {
     VALDI_CLASS_HEADER_IMPL(DummyObject);
 };
@@ -1821,6 +1932,86 @@ TEST_P(JSContextFixture, stackOverflowGuard) {
     }
 }
 
+TEST_P(JSContextFixture, cachesStringsCreatedFromStringBoxes) {
+    MAIN_THREAD_INIT();
+    auto wrapper = createWrapper();
+    auto jsEntry = wrapper.makeJsEntry();
+    auto& context = jsEntry.context;
+    auto& exceptionTracker = jsEntry.exceptionTracker;
+
+    auto str = STRING_LITERAL("hello");
+
+    auto jsString1 = context.newStringCached(str, exceptionTracker);
+    auto jsString2 = context.newStringCached(str, exceptionTracker);
+    jsEntry.checkException();
+
+    ASSERT_EQ(ValueType::InternedString, context.getValueType(jsString1.get()));
+    ASSERT_TRUE(context.isValueEqual(jsString1.get(), jsString2.get()));
+
+    auto result = context.valueToStringCached(jsString1.get(), exceptionTracker);
+    jsEntry.checkException();
+    ASSERT_EQ(str, result);
+    // The reverse lookup gives back the StringBox the JS string was created from
+    ASSERT_EQ(str.getInternedString().get(), result.getInternedString().get());
+
+    auto otherJsString = context.newStringUTF8("world", exceptionTracker);
+    ASSERT_EQ(STRING_LITERAL("world"), context.valueToStringCached(otherJsString.get(), exceptionTracker));
+    jsEntry.checkException();
+
+    context.clearStringCache();
+    ASSERT_EQ(str, context.valueToStringCached(jsString1.get(), exceptionTracker));
+    jsEntry.checkException();
+}
+
+TEST(QuickJSSharedRuntime, contextsShareRuntimeWithSeparateGlobals) {
+    MAIN_THREAD_INIT();
+    ValdiQuickJS::QuickJSJavaScriptContextFactory jsBridge(/* shareRuntimeBetweenContexts */ true);
+
+    auto wrapper1 = JSContextWrapper(&jsBridge, nullptr);
+    auto wrapper2 = JSContextWrapper(&jsBridge, nullptr);
+
+    wrapper1.evaluateScript("globalThis.sharedValue = 'first'", "first.js");
+
+    ASSERT_EQ(STRING_LITERAL("first"), wrapper1.evaluateScript("globalThis.sharedValue", "first.js").toStringBox());
+    ASSERT_EQ(STRING_LITERAL("undefined"), wrapper2.evaluateScript("typeof sharedValue", "second.js").toStringBox());
+}
+
+TEST(QuickJSSharedRuntime, weakRefsAreResolvedPerContext) {
+    MAIN_THREAD_INIT();
+    ValdiQuickJS::QuickJSJavaScriptContextFactory jsBridge(/* shareRuntimeBetweenContexts */ true);
+
+    auto wrapper1 = JSContextWrapper(&jsBridge, nullptr);
+    auto wrapper2 = JSContextWrapper(&jsBridge, nullptr);
+
+    auto jsEntry1 = wrapper1.makeJsEntry();
+    auto jsEntry2 = wrapper2.makeJsEntry();
+    auto& context1 = jsEntry1.context;
+    auto& context2 = jsEntry2.context;
+
+    RefCountableAutoreleasePool autoreleasePool;
+
+    auto object1 = context1.newObject(jsEntry1.exceptionTracker);
+    auto weakRef1 = context1.newWeakRef(object1.get(), jsEntry1.exceptionTracker);
+    jsEntry1.checkException();
+
+    auto object2 = context2.newObject(jsEntry2.exceptionTracker);
+    auto weakRef2 = context2.newWeakRef(object2.get(), jsEntry2.exceptionTracker);
+    jsEntry2.checkException();
+
+    // Weak reference ids are unique across the shared runtime
+    ASSERT_FALSE(context1.isValueUndefined(context1.derefWeakRef(weakRef1.get(), jsEntry1.exceptionTracker).get()));
+    ASSERT_TRUE(context1.isValueUndefined(context1.derefWeakRef(weakRef2.get(), jsEntry1.exceptionTracker).get()));
+
+    object1 = JSValueRef();
+    context1.garbageCollect();
+    autoreleasePool.releaseAll();
+
+    ASSERT_TRUE(context1.isValueUndefined(context1.derefWeakRef(weakRef1.get(), jsEntry1.exceptionTracker).get()));
+    ASSERT_FALSE(context2.isValueUndefined(context2.derefWeakRef(weakRef2.get(), jsEntry2.exceptionTracker).get()));
+    jsEntry1.checkException();
+    jsEntry2.checkException();
+}
+
 INSTANTIATE_TEST_SUITE_P(JSIntegrationTests,
                          JSContextFixture,
                          ::testing::Values(JavaScriptEngineTestCase::QuickJS,
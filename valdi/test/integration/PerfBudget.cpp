@@ -0,0 +1,64 @@
+#include "PerfBudget.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+
+#include <limits>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+PerfBudget::PerfBudget()
+    : _perfCountersWereEnabled(PerfCounters::isEnabled()),
+      _allocationProfilerWasEnabled(AllocationProfiler::isEnabled()),
+      _previousSamplingInterval(AllocationProfiler::getSamplingInterval()) {
+    PerfCounters::setEnabled(true);
+    if (!_allocationProfilerWasEnabled) {
+        // Only the counts are needed, avoid capturing backtraces
+        AllocationProfiler::setSamplingInterval(std::numeric_limits<uint64_t>::max());
+        AllocationProfiler::setEnabled(true);
+    }
+    _snapshot = PerfCounters::current();
+}
+
+PerfBudget::~PerfBudget() {
+    if (!_allocationProfilerWasEnabled) {
+        AllocationProfiler::setEnabled(false);
+        AllocationProfiler::shared().collect();
+        AllocationProfiler::setSamplingInterval(_previousSamplingInterval);
+    }
+    PerfCounters::setEnabled(_perfCountersWereEnabled);
+}
+
+PerfBudget& PerfBudget::expectAtMost(PerfCounterType type, uint64_t maxValue) {
+    _maxValues[static_cast<size_t>(type)] = {maxValue};
+    return *this;
+}
+
+PerfCounterValues PerfBudget::getMeasured() const {
+    return PerfCounters::current().since(_snapshot);
+}
+
+::testing::AssertionResult PerfBudget::check() const {
+    auto measured = getMeasured();
+
+    auto result = ::testing::AssertionSuccess();
+    bool exceeded = false;
+    for (size_t i = 0; i < kPerfCounterTypesCount; i++) {
+        const auto& maxValue = _maxValues[i];
+        auto value = measured.values[i];
+        if (!maxValue || value <= maxValue.value()) {
+            continue;
+        }
+
+        if (!exceeded) {
+            exceeded = true;
+            result = ::testing::AssertionFailure() << "Perf budget exceeded:";
+        }
+        result << "\n  " << perfCounterTypeToString(static_cast<PerfCounterType>(i)) << ": " << value
+               << " (budget: " << maxValue.value() << ")";
+    }
+
+    return result;
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "valdi_core/cpp/Utils/PerfCounters.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <optional>
+
+namespace ValdiTest {
+
+/**
+ Deterministic perf budget of a test scenario. The work made by the runtime is counted from the
+ creation of the budget, and check() fails if any counter went above its declared upper bound.
+ Allocations are counted through the AllocationProfiler, which is enabled for the lifetime of the budget.
+
+    PerfBudget budget;
+    budget.expectAtMost(Valdi::PerfCounterType::ViewsInflated, 6);
+    // Run the scenario
+    ASSERT_TRUE(budget.check());
+ */
+class PerfBudget {
+public:
+    PerfBudget();
+    ~PerfBudget();
+
+    PerfBudget& expectAtMost(Valdi::PerfCounterType type, uint64_t maxValue);
+
+    /**
+     Returns the work counted since the budget was created.
+     */
+    Valdi::PerfCounterValues getMeasured() const;
+
+    ::testing::AssertionResult check() const;
+
+private:
+    Valdi::PerfCounterValues _snapshot;
+    std::array<std::optional<uint64_t>, Valdi::kPerfCounterTypesCount> _maxValues;
+    bool _perfCountersWereEnabled;
+    bool _allocationProfilerWasEnabled;
+    uint64_t _previousSamplingInterval;
+};
+
+} // namespace ValdiTest
@@ -13,11 +13,13 @@
 #include "valdi/runtime/JavaScript/ValueFunctionWithJSValue.hpp"
 #include "valdi/runtime/JavaScript/WrappedJSValueRef.hpp"
 #include "valdi/runtime/Rendering/RenderRequest.hpp"
+#include "valdi/runtime/Rendering/ViewNodeRenderer.hpp"
 #include "valdi/runtime/Resources/AssetsManager.hpp"
 #include "valdi/runtime/Resources/ObservableAsset.hpp"
 #include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
 #include "valdi/runtime/Runtime.hpp"
 #include "valdi/runtime/ValdiRuntimeTweaks.hpp"
+#include "valdi/runtime/Views/ViewPoolUsageStats.hpp"
 #include "valdi_core/cpp/Attributes/TextAttributeValue.hpp"
 #include "valdi_core/cpp/JavaScript/ModuleFactoryRegistry.hpp"
 #include "valdi_core/cpp/Schema/ValueSchemaRegistry.hpp"
@@ -27,6 +29,7 @@
 #include "valdi/jsbridge/JavaScriptBridge.hpp"
 
 #include "JSBridgeTestFixture.hpp"
+#include "PerfBudget.hpp"
 #include "RuntimeTestsUtils.hpp"
 #include "TSNTestUtils.hpp"
 #include "TestANRDetectorListener.hpp"
@@ -428,6 +431,33 @@ TEST_P(RuntimeFixture, canGetElementByNodePath) {
     ASSERT_EQ(nullptr, tree->getViewNodeForNodePath(parseNodePath("container[0].multiLabel[2]")));
 }
 
+TEST_P(RuntimeFixture, updatesNodePathLookupsWhenHierarchyChanges) {
+    auto tree = wrapper.createViewNodeTreeAndContext("test", "NodePath");
+
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    auto containerViewNodes = tree->getRootViewNode()->copyChildrenWithDebugId(STRING_LITERAL("container"));
+    ASSERT_EQ(static_cast<size_t>(10), containerViewNodes.size());
+    auto multiLabels = containerViewNodes[6]->copyChildrenWithDebugId(STRING_LITERAL("multiLabel"));
+    ASSERT_EQ(static_cast<size_t>(2), multiLabels.size());
+
+    ASSERT_EQ(multiLabels[0], tree->getViewNodeForNodePath(parseNodePath("container[6].multiLabel[0]")));
+    ASSERT_EQ(multiLabels[1], tree->getViewNodeForNodePath(parseNodePath("container[6].multiLabel[1]")));
+
+    tree->scheduleExclusiveUpdate(
+        [&]() { multiLabels[0]->removeFromParent(tree->getCurrentViewTransactionScope()); });
+
+    ASSERT_EQ(multiLabels[1], tree->getViewNodeForNodePath(parseNodePath("container[6].multiLabel[0]")));
+    ASSERT_EQ(nullptr, tree->getViewNodeForNodePath(parseNodePath("container[6].multiLabel[1]")));
+
+    tree->scheduleExclusiveUpdate([&]() {
+        containerViewNodes[6]->appendChild(tree->getCurrentViewTransactionScope(), multiLabels[0]);
+    });
+
+    ASSERT_EQ(multiLabels[1], tree->getViewNodeForNodePath(parseNodePath("container[6].multiLabel[0]")));
+    ASSERT_EQ(multiLabels[0], tree->getViewNodeForNodePath(parseNodePath("container[6].multiLabel[1]")));
+}
+
 TEST_P(RuntimeFixture, canApplyCSS) {
     auto viewModel = makeShared<ValueMap>();
     (*viewModel)[STRING_LITERAL("containerColor")] = Value(STRING_LITERAL("black"));
@@ -476,6 +506,45 @@ TEST_P(RuntimeFixture, doesntReapplyCSSAfterMultipleRender) {
     checkViewHasSingleHistoryPerAttribute(rootView);
 }
 
+TEST_P(RuntimeFixture, staysWithinPerfBudgetWhenRenderingViewTree) {
+    PerfBudget budget;
+    budget.expectAtMost(PerfCounterType::ViewNodesCreated, 6).expectAtMost(PerfCounterType::ViewsInflated, 6);
+
+    auto tree = wrapper.createViewNodeTreeAndContext("test", "BasicViewTree");
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    ASSERT_TRUE(budget.check());
+}
+
+TEST_P(RuntimeFixture, staysWithinPerfBudgetWhenRerenderingWithSameViewModel) {
+    auto viewModel = makeShared<ValueMap>();
+    (*viewModel)[STRING_LITERAL("containerColor")] = Value(STRING_LITERAL("black"));
+
+    auto tree = wrapper.createViewNodeTreeAndContext("test", "CSSAttributes", Value(viewModel));
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    PerfBudget budget;
+    budget.expectAtMost(PerfCounterType::ViewNodesCreated, 0).expectAtMost(PerfCounterType::ViewsInflated, 0);
+
+    wrapper.setViewModel(tree->getContext(), Value(viewModel));
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    ASSERT_TRUE(budget.check());
+}
+
+TEST_P(RuntimeFixture, failsWhenExceedingPerfBudget) {
+    PerfBudget budget;
+    budget.expectAtMost(PerfCounterType::ViewsInflated, 1).expectAtMost(PerfCounterType::LayoutPasses, 1000);
+
+    auto tree = wrapper.createViewNodeTreeAndContext("test", "BasicViewTree");
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    auto result = budget.check();
+    ASSERT_FALSE(result);
+    ASSERT_NE(std::string::npos, std::string(result.message()).find("views_inflated"));
+    ASSERT_EQ(std::string::npos, std::string(result.message()).find("layout_passes"));
+}
+
 TEST_P(RuntimeFixture, canResetCSSValues) {
     auto viewModel = makeShared<ValueMap>();
     (*viewModel)[STRING_LITERAL("containerColor")] = Value(STRING_LITERAL("black"));
@@ -1054,6 +1123,54 @@ TEST_P(RuntimeFixture, canApplyCompositeAttributes) {
               getRootView(tree));
 }
 
+TEST_P(RuntimeFixture, updatesCompositeAttributesWhenPartsChange) {
+    auto viewModel = makeShared<ValueMap>();
+    (*viewModel)[STRING_LITERAL("style")] = Value(STRING_LITERAL("dotted"));
+    (*viewModel)[STRING_LITERAL("left")] = Value(1.0);
+
+    auto tree = wrapper.createViewNodeTreeAndContext("test", "CompositeAttributes", Value(viewModel));
+
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    auto makeExpectedView = [](const Value& left, const Value& style) {
+        auto values = ValueArray::make(5);
+        (*values)[0] = left;
+        (*values)[1] = Value(2.0);
+        (*values)[2] = Value(3.0);
+        (*values)[3] = Value(4.0);
+        (*values)[4] = style;
+
+        return DummyView("SCValdiView")
+            .addChild(DummyView("UIRectangleView")
+                          .addAttribute("id", "container")
+                          .addAttribute("rectangle", Valdi::Value(values)));
+    };
+
+    ASSERT_EQ(makeExpectedView(Value(1.0), Value(std::string("dotted"))), getRootView(tree));
+
+    // Only one part changes at a time, the other parts should be kept as is
+    for (auto i = 0; i < 3; i++) {
+        auto left = static_cast<double>(i + 5);
+        (*viewModel)[STRING_LITERAL("left")] = Value(left);
+        wrapper.setViewModel(tree->getContext(), Value(viewModel));
+        wrapper.waitUntilAllUpdatesCompleted();
+
+        ASSERT_EQ(makeExpectedView(Value(left), Value(std::string("dotted"))), getRootView(tree));
+    }
+
+    (*viewModel)[STRING_LITERAL("style")] = Value(STRING_LITERAL("solid"));
+    wrapper.setViewModel(tree->getContext(), Value(viewModel));
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    ASSERT_EQ(makeExpectedView(Value(7.0), Value(std::string("solid"))), getRootView(tree));
+
+    viewModel->erase(STRING_LITERAL("style"));
+    wrapper.setViewModel(tree->getContext(), Value(viewModel));
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    ASSERT_EQ(makeExpectedView(Value(7.0), Value()), getRootView(tree));
+}
+
 TEST_P(RuntimeFixture, optionalCompositeAttributeParts) {
     auto viewModel = makeShared<ValueMap>();
     (*viewModel)[STRING_LITERAL("left")] = Value(1.0);
@@ -3458,6 +3575,32 @@ TEST_P(RuntimeFixture, supportsNestedSlots) {
     ASSERT_EQ(0, numberOfUnexpired);
 }
 
+TEST_P(RuntimeFixture, canDeferViewNodeTreeTeardown) {
+    wrapper.runtime->setDeferredViewNodeTreeTeardownEnabled(true);
+
+    auto tree = wrapper.createViewNodeTreeAndContext("test", "NestedSlots");
+
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    ASSERT_EQ(static_cast<size_t>(1), getRootView(tree).getChildrenCount());
+
+    std::vector<Valdi::Weak<ViewNode>> allViewNodes;
+    forEachViewNode(tree->getRootViewNode(), [&](ViewNode* viewNode) { allViewNodes.emplace_back(weakRef(viewNode)); });
+
+    wrapper.runtime->destroyContext(tree->getContext());
+
+    // The views should be detached right away, while the ViewNodes are released when the main thread is idle
+    ASSERT_EQ(static_cast<size_t>(0), getRootView(tree).getChildrenCount());
+    ASSERT_FALSE(allViewNodes.back().expired());
+
+    wrapper.flushQueues();
+
+    for (const auto& viewNodePtr : allViewNodes) {
+        ASSERT_TRUE(viewNodePtr.expired());
+    }
+    ASSERT_EQ(nullptr, tree->getRootViewNode());
+}
+
 Value lazyLayoutViewModel() {
     auto items = ValueArray::make(3);
 
@@ -3595,6 +3738,30 @@ TEST_P(RuntimeFixture, canDisableAutoRendering) {
               getRootView(tree));
 }
 
+TEST_P(RuntimeFixture, canRenderContextsInParallel) {
+    wrapper.runtime->setParallelRenderingEnabled(true);
+
+    auto tree1 = wrapper.createViewNodeTreeAndContext("test", "BasicViewTree");
+    auto tree2 = wrapper.createViewNodeTreeAndContext("test", "BasicViewTree");
+
+    wrapper.waitUntilAllUpdatesCompleted();
+    // Replay the deferred view transactions
+    wrapper.flushQueues();
+
+    ASSERT_FALSE(tree1->getContext()->hasPendingRenderRequests());
+    ASSERT_FALSE(tree2->getContext()->hasPendingRenderRequests());
+
+    auto expectedRootView = DummyView("SCValdiView")
+                                .addChild(DummyView("SCValdiLabel"))
+                                .addChild(DummyView("SCValdiView")
+                                              .addChild(DummyView("UIButton"))
+                                              .addChild(DummyView("UIButton"))
+                                              .addChild(DummyView("UIButton")));
+
+    ASSERT_EQ(expectedRootView, getRootView(tree1));
+    ASSERT_EQ(expectedRootView, getRootView(tree2));
+}
+
 TEST_P(RuntimeFixture, disablesAutoRenderingWhileLoadOperationIsEnqueued) {
     auto group = makeShared<AsyncGroup>();
 
@@ -4173,6 +4340,82 @@ TEST_P(RuntimeFixture, supportsRawContexts) {
     ASSERT_EQ(DummyView("RootView"), view);
 }
 
+TEST_P(RuntimeFixture, adoptsPrerenderedViewNodesOnFirstRender) {
+    wrapper.runtime->setLimitToViewportDisabled(true);
+
+    auto context = wrapper.runtime->createContext(
+        wrapper.standaloneRuntime->getViewManagerContext(), STRING_LITERAL("valdi.RawComponent"), nullptr, nullptr);
+    context->onCreate();
+
+    auto view = DummyView("RootView");
+    auto viewNodeTree = wrapper.runtime->createViewNodeTree(context);
+    viewNodeTree->setRootView(view.getSharedImpl());
+
+    auto valueAttribute = wrapper.runtime->getAttributeIds().getIdForName("value");
+
+    auto makeRenderRequest = [&](const StringBox& labelValue, bool includesFooter) {
+        auto renderRequest = Valdi::makeShared<RenderRequest>();
+        renderRequest->setContextId(context->getContextId());
+
+        auto* createElement = renderRequest->appendCreateElement();
+        createElement->setElementId(1);
+        createElement->setViewClassName(STRING_LITERAL("UIView"));
+
+        createElement = renderRequest->appendCreateElement();
+        createElement->setElementId(2);
+        createElement->setViewClassName(STRING_LITERAL("SCValdiLabel"));
+
+        auto* moveToParent = renderRequest->appendMoveElementToParent();
+        moveToParent->setElementId(2);
+        moveToParent->setParentElementId(1);
+
+        if (includesFooter) {
+            createElement = renderRequest->appendCreateElement();
+            createElement->setElementId(3);
+            createElement->setViewClassName(STRING_LITERAL("UIView"));
+
+            moveToParent = renderRequest->appendMoveElementToParent();
+            moveToParent->setElementId(3);
+            moveToParent->setParentElementId(1);
+            moveToParent->setParentIndex(1);
+        }
+
+        auto* setElementAttribute = renderRequest->appendSetElementAttribute();
+        setElementAttribute->setElementId(2);
+        setElementAttribute->setAttributeId(valueAttribute);
+        setElementAttribute->setAttributeValue(Value(labelValue));
+
+        renderRequest->appendSetRootElement()->setElementId(1);
+
+        return renderRequest;
+    };
+
+    auto prerenderRequest = makeRenderRequest(STRING_LITERAL("Loading"), true);
+    viewNodeTree->scheduleExclusiveUpdate([&]() {
+        ViewNodeRenderer renderer(*viewNodeTree, context->getLogger(), true);
+        renderer.prerender(*prerenderRequest);
+    });
+
+    ASSERT_EQ(DummyView("RootView")
+                  .addChild(DummyView("SCValdiLabel").addAttribute("value", "Loading"))
+                  .addChild(DummyView("UIView")),
+              view);
+    ASSERT_TRUE(viewNodeTree->hasPrerenderedViewNodes());
+
+    auto prerenderedLabel = viewNodeTree->getViewNode(2);
+    ASSERT_TRUE(prerenderedLabel != nullptr);
+
+    wrapper.runtime->processRenderRequest(makeRenderRequest(STRING_LITERAL("Loaded"), false));
+
+    // The label was adopted and updated, the footer which JS did not render was removed
+    ASSERT_EQ(DummyView("RootView").addChild(DummyView("SCValdiLabel").addAttribute("value", "Loaded")), view);
+    ASSERT_EQ(prerenderedLabel, viewNodeTree->getViewNode(2));
+    ASSERT_TRUE(viewNodeTree->getViewNode(3) == nullptr);
+    ASSERT_FALSE(viewNodeTree->hasPrerenderedViewNodes());
+
+    wrapper.runtime->destroyContext(context);
+}
+
 TEST_P(RuntimeFixture, renderRequestCanRetainAndReleaseItsEntries) {
     auto viewClass = STRING_LITERAL("ThisIsMyViewClass");
     auto attributeValue = makeShared<ValueMap>();
@@ -4633,6 +4876,45 @@ TEST_P(RuntimeFixture, canPreloadViews) {
     ASSERT_EQ(10, getNumberOfPooledViews(viewClassName, stats));
 }
 
+TEST_P(RuntimeFixture, preloadsViewsUsedByScreenOnNextOpen) {
+    wrapper.teardown();
+    wrapper = RuntimeWrapper(getJsBridge(), getTSNMode(), true);
+
+    auto viewManagerContext = wrapper.standaloneRuntime->getViewManagerContext();
+    auto tree = wrapper.runtime->createViewNodeTreeAndContext(viewManagerContext,
+                                                              STRING_LITERAL("test/src/BasicViewTree.valdi"));
+
+    wrapper.waitUntilAllUpdatesCompleted();
+    tree->setLayoutSpecs(Size(200, 200), LayoutDirectionLTR);
+    tree->setRootView(Valdi::makeShared<StandaloneView>(STRING_LITERAL("MyRootView")));
+
+    auto componentPath = tree->getContext()->getPath();
+    auto screenName = StringBox::fromString(componentPath.toString());
+
+    wrapper.runtime->destroyContext(tree->getContext());
+    tree = nullptr;
+
+    auto peakUsage = viewManagerContext->getViewPoolUsageStats()->getPeakUsage(screenName);
+    ASSERT_EQ(static_cast<size_t>(1), peakUsage[STRING_LITERAL("SCValdiLabel")]);
+    ASSERT_EQ(static_cast<size_t>(3), peakUsage[STRING_LITERAL("UIButton")]);
+
+    viewManagerContext->clearViewPools();
+
+    auto context = wrapper.runtime->createContext(viewManagerContext, componentPath, nullptr, nullptr);
+
+    wrapper.mainQueue->runUntilTrue([&]() {
+        auto stats = viewManagerContext->getViewPoolsStats();
+        return getNumberOfPooledViews(STRING_LITERAL("SCValdiLabel"), stats) == 1 &&
+               getNumberOfPooledViews(STRING_LITERAL("UIButton"), stats) == 3;
+    });
+    auto stats = viewManagerContext->getViewPoolsStats();
+
+    ASSERT_EQ(1, getNumberOfPooledViews(STRING_LITERAL("SCValdiLabel"), stats));
+    ASSERT_EQ(3, getNumberOfPooledViews(STRING_LITERAL("UIButton"), stats));
+
+    wrapper.runtime->destroyContext(context);
+}
+
 TEST_P(RuntimeFixture, preloadOnlyAddsToThePoolIfMissing) {
     wrapper.teardown();
     wrapper = RuntimeWrapper(getJsBridge(), getTSNMode(), true);
@@ -5243,6 +5525,39 @@ TEST_P(RuntimeFixture, canHotReloadAsset) {
     ASSERT_EQ(resourceData, loadedAsset->getBytes());
 }
 
+TEST_P(RuntimeFixture, skipsHotReloadOfUnchangedResources) {
+    auto makeResources = [](const char* content) {
+        std::vector<Shared<Resource>> resources;
+        resources.emplace_back(
+            makeShared<Resource>(ResourceId(STRING_LITERAL("random_module"), STRING_LITERAL("data.json")),
+                                 makeShared<ByteBuffer>(content)->toBytesView()));
+        return resources;
+    };
+    auto flushJsThread = [&]() {
+        wrapper.runtime->getJavaScriptRuntime()->dispatchOnJsThreadSync(nullptr, [](auto& /*jsEntry*/) {});
+    };
+
+    auto initialSequence = wrapper.runtime->getHotReloadSequence();
+
+    wrapper.runtime->receivedUpdatedResources(makeResources("{}"));
+    flushJsThread();
+    ASSERT_EQ(initialSequence + 1, wrapper.runtime->getHotReloadSequence());
+
+    // Same content, nothing should be reloaded
+    wrapper.runtime->receivedUpdatedResources(makeResources("{}"));
+    flushJsThread();
+    ASSERT_EQ(initialSequence + 1, wrapper.runtime->getHotReloadSequence());
+
+    wrapper.runtime->receivedUpdatedResources(makeResources("{\"key\": true}"));
+    flushJsThread();
+    ASSERT_EQ(initialSequence + 2, wrapper.runtime->getHotReloadSequence());
+
+    auto bundle = wrapper.runtime->getResourceManager().getBundle(STRING_LITERAL("random_module"));
+    auto entry = bundle->getEntry(STRING_LITERAL("data.json"));
+    ASSERT_TRUE(entry) << entry.description();
+    ASSERT_EQ(makeShared<ByteBuffer>("{\"key\": true}")->toBytesView(), entry.value());
+}
+
 static void registerAssetArchives(RuntimeWrapper& wrapper,
                                   RequestManagerMock& requestManager,
                                   const char* archiveName) {
@@ -7327,6 +7642,39 @@ TEST_P(RuntimeFixture, canUpdateCustomColorPalette) {
         getRootView(tree));
 }
 
+TEST_P(RuntimeFixture, onlyReappliesAttributesUsingChangedColors) {
+    auto tree = wrapper.createViewNodeTreeAndContext(STRING_LITERAL("ColorPaletteTest@test/src/ColorPaletteTest"),
+                                                     Value(makeShared<ValueMap>()),
+                                                     Value::undefined());
+
+    wrapper.waitUntilAllUpdatesCompleted();
+
+    PerfBudget budget;
+    // Only the background of the child uses the foreground color
+    budget.expectAtMost(PerfCounterType::AttributesApplied, 1);
+
+    wrapper.runtime->getJavaScriptRuntime()->callComponentFunction(tree->getContext(),
+                                                                   STRING_LITERAL("updateForegroundColor"));
+
+    wrapper.flushQueues();
+
+    ASSERT_TRUE(budget.check());
+    ASSERT_EQ(static_cast<uint64_t>(1), budget.getMeasured().get(PerfCounterType::AttributesApplied));
+
+    ASSERT_EQ(
+        DummyView("SCValdiView")
+            .addAttribute("border", Value(ValueArray::make({Value(1.0), Value(65535)})))
+            .addChild(DummyView("SCValdiView")
+                          .addAttribute("background",
+                                        Value(ValueArray::make({
+                                            Value(ValueArray::make({Value(static_cast<int64_t>(4294902015))})),
+                                            Value(ValueArray::make({})),
+                                            Value(static_cast<int32_t>(0)),
+                                            Value(false),
+                                        })))),
+        getRootView(tree));
+}
+
 static Result<Value> postprocessArrayValueToLength(ViewNode& viewNode, const Value& in) {
     if (in.getArray() == nullptr) {
         return Value(0.0);
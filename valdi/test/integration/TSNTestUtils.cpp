@@ -39,7 +39,7 @@ static tsn_value doLoadModule(tsn_vm* ctx,
 }
 
 static tsn_value moduleInitFn(tsn_vm* ctx) {
-    auto* tsnModule = tsn_new_module(ctx, 1, 0, 1);
+    auto* tsnModule = tsn_new_module(ctx, 1, 0, 1, 0);
     if (tsnModule == nullptr) {
         return tsn_exception(ctx);
     }
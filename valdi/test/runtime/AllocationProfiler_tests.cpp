@@ -0,0 +1,98 @@
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/AutoMalloc.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+class AllocationProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        AllocationProfiler::shared().collect();
+        AllocationProfiler::setSamplingInterval(AllocationProfiler::kDefaultSamplingInterval);
+        AllocationProfiler::setEnabled(true);
+    }
+
+    void TearDown() override {
+        AllocationProfiler::setEnabled(false);
+        AllocationProfiler::setSamplingInterval(AllocationProfiler::kDefaultSamplingInterval);
+        AllocationProfiler::shared().collect();
+    }
+};
+
+TEST_F(AllocationProfilerTest, countsSmallVectorGrowth) {
+    auto snapshot = AllocationCounters::current();
+
+    SmallVector<int, 4> vector;
+    for (int i = 0; i < 4; i++) {
+        vector.emplace_back(i);
+    }
+    // Still in the inline storage
+    ASSERT_EQ(static_cast<uint64_t>(0), AllocationCounters::current().since(snapshot).getTotalCount());
+
+    vector.emplace_back(4);
+    auto allocations = AllocationCounters::current().since(snapshot);
+    ASSERT_EQ(static_cast<uint64_t>(1), allocations.getCount(AllocationSite::SmallVector));
+    ASSERT_EQ(static_cast<uint64_t>(vector.capacity() * sizeof(int)),
+              allocations.getBytes(AllocationSite::SmallVector));
+}
+
+TEST_F(AllocationProfilerTest, countsAutoMallocAndByteBuffer) {
+    auto snapshot = AllocationCounters::current();
+
+    AutoMalloc<int, 8> inlineMalloc(4);
+    AutoMalloc<int, 8> heapMalloc(16);
+
+    ByteBuffer buffer;
+    buffer.reserve(64);
+
+    auto allocations = AllocationCounters::current().since(snapshot);
+    ASSERT_EQ(static_cast<uint64_t>(1), allocations.getCount(AllocationSite::AutoMalloc));
+    ASSERT_EQ(static_cast<uint64_t>(16 * sizeof(int)), allocations.getBytes(AllocationSite::AutoMalloc));
+    ASSERT_EQ(static_cast<uint64_t>(1), allocations.getCount(AllocationSite::ByteBuffer));
+    ASSERT_EQ(static_cast<uint64_t>(64), allocations.getBytes(AllocationSite::ByteBuffer));
+}
+
+TEST_F(AllocationProfilerTest, doesNotCountWhileDisabled) {
+    AllocationProfiler::setEnabled(false);
+    auto snapshot = AllocationCounters::current();
+
+    std::vector<int, ProfiledAllocator<int, AllocationSite::SmallVector>> vector(32);
+
+    ASSERT_EQ(static_cast<uint64_t>(0), AllocationCounters::current().since(snapshot).getTotalCount());
+    ASSERT_TRUE(AllocationProfiler::shared().collect().samples.empty());
+}
+
+TEST_F(AllocationProfilerTest, samplesEveryNthAllocationWithTraceScope) {
+    AllocationProfiler::setSamplingInterval(2);
+    // Align the countdown left by the previous allocations of this thread
+    while (AllocationProfiler::shared().collect().samples.empty()) {
+        std::vector<int, ProfiledAllocator<int, AllocationSite::SmallVector>> vector(1);
+    }
+
+    std::string traceScope = "Scope";
+    auto* previousTraceScope = AllocationProfiler::exchangeTraceScope(&traceScope);
+    for (size_t i = 0; i < 6; i++) {
+        std::vector<int, ProfiledAllocator<int, AllocationSite::SmallVector>> vector(8);
+    }
+    AllocationProfiler::exchangeTraceScope(previousTraceScope);
+
+    auto profile = AllocationProfiler::shared().collect();
+    ASSERT_EQ(static_cast<uint64_t>(2), profile.samplingInterval);
+    ASSERT_EQ(static_cast<size_t>(3), profile.samples.size());
+    for (const auto& sample : profile.samples) {
+        ASSERT_EQ(AllocationSite::SmallVector, sample.site);
+        ASSERT_EQ(8 * sizeof(int), sample.bytes);
+        ASSERT_EQ("Scope", sample.traceScope);
+    }
+
+    // The samples were reset by the collect
+    ASSERT_TRUE(AllocationProfiler::shared().collect().samples.empty());
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,110 @@
+#include "valdi/runtime/Resources/AssetKeyCache.hpp"
+#include "valdi/runtime/Resources/Bundle.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+TEST(AssetKeyCache, resolvesValuesOnce) {
+    AssetKeyCache cache;
+    auto url = STRING_LITERAL("https://snapchat.com/image.png");
+    size_t resolveCount = 0;
+    auto resolve = [&]() -> std::optional<AssetKey> {
+        resolveCount++;
+        return AssetKey(url);
+    };
+
+    ASSERT_EQ(AssetKey(url), cache.getOrResolve(url, resolve));
+    ASSERT_EQ(AssetKey(url), cache.getOrResolve(url, resolve));
+    ASSERT_EQ(static_cast<size_t>(1), resolveCount);
+}
+
+TEST(AssetKeyCache, cachesRelativeValues) {
+    AssetKeyCache cache;
+    size_t resolveCount = 0;
+    auto resolve = [&]() -> std::optional<AssetKey> {
+        resolveCount++;
+        return std::nullopt;
+    };
+
+    ASSERT_FALSE(cache.getOrResolve(STRING_LITERAL("image"), resolve).has_value());
+    ASSERT_FALSE(cache.getOrResolve(STRING_LITERAL("image"), resolve).has_value());
+    ASSERT_EQ(static_cast<size_t>(1), resolveCount);
+}
+
+TEST(AssetKeyCache, resolvesRelativeAssetNamesPerBundle) {
+    AssetKeyCache cache;
+    auto bundle = makeShared<Bundle>(STRING_LITERAL("module"), ConsoleLogger::getLogger());
+    auto otherBundle = makeShared<Bundle>(STRING_LITERAL("other_module"), ConsoleLogger::getLogger());
+    auto assetName = STRING_LITERAL("image");
+    size_t resolveCount = 0;
+
+    auto key = cache.getOrResolveRelative(bundle->getName(), assetName, [&]() {
+        resolveCount++;
+        return AssetKey(bundle, assetName);
+    });
+    auto otherKey = cache.getOrResolveRelative(otherBundle->getName(), assetName, [&]() {
+        resolveCount++;
+        return AssetKey(otherBundle, assetName);
+    });
+    auto cachedKey = cache.getOrResolveRelative(bundle->getName(), assetName, [&]() {
+        resolveCount++;
+        return AssetKey(otherBundle, assetName);
+    });
+
+    ASSERT_EQ(static_cast<size_t>(2), resolveCount);
+    ASSERT_EQ(AssetKey(bundle, assetName), key);
+    ASSERT_EQ(AssetKey(otherBundle, assetName), otherKey);
+    ASSERT_EQ(key, cachedKey);
+}
+
+TEST(AssetKeyCache, doesNotCacheDataUrls) {
+    AssetKeyCache cache;
+    auto url = STRING_LITERAL("data:image/png;base64,iVBORw0KGgo=");
+    size_t resolveCount = 0;
+    auto resolve = [&]() -> std::optional<AssetKey> {
+        resolveCount++;
+        return AssetKey(url);
+    };
+
+    cache.getOrResolve(url, resolve);
+    cache.getOrResolve(url, resolve);
+
+    ASSERT_EQ(static_cast<size_t>(2), resolveCount);
+    ASSERT_EQ(static_cast<size_t>(0), cache.size());
+}
+
+TEST(AssetKeyCache, canBeCleared) {
+    AssetKeyCache cache;
+    auto url = STRING_LITERAL("https://snapchat.com/image.png");
+    size_t resolveCount = 0;
+    auto resolve = [&]() -> std::optional<AssetKey> {
+        resolveCount++;
+        return AssetKey(url);
+    };
+
+    cache.getOrResolve(url, resolve);
+    ASSERT_EQ(static_cast<size_t>(1), cache.size());
+
+    cache.clear();
+    ASSERT_EQ(static_cast<size_t>(0), cache.size());
+
+    cache.getOrResolve(url, resolve);
+    ASSERT_EQ(static_cast<size_t>(2), resolveCount);
+}
+
+TEST(AssetKeyCache, staysBounded) {
+    AssetKeyCache cache;
+
+    for (size_t i = 0; i < AssetKeyCache::kMaxEntries + 10; i++) {
+        auto url = StringBox::fromString(std::to_string(i));
+        cache.getOrResolve(url, [&]() -> std::optional<AssetKey> { return AssetKey(url); });
+    }
+
+    ASSERT_GE(AssetKeyCache::kMaxEntries, cache.size());
+}
+
+} // namespace ValdiTest
@@ -1366,6 +1366,42 @@ TEST(AssetsManager, canPauseUpdates) {
     wrapper.tearDown();
 }
 
+TEST(AssetsManager, sharesLoadRequestsBetweenConsumersWithSameSpecs) {
+    AssetsManagerWrapper wrapper;
+
+    auto assetToLoad = makeShared<StandaloneLoadedAsset>(BytesView(), 0, 0);
+    auto url = STRING_LITERAL("https://snapchat.com/image.png");
+
+    wrapper.assetLoader->setAssetResponse(url, assetToLoad);
+
+    wrapper.assetsManager->beginPauseUpdates();
+
+    auto asset = wrapper.assetsManager->getAsset(AssetKey(url));
+
+    std::vector<Ref<SyncAssetLoadObserver>> observers;
+    for (size_t i = 0; i < 6; i++) {
+        auto observer = makeShared<SyncAssetLoadObserver>();
+        auto size = i % 2 == 0 ? 0 : 42;
+        asset->addLoadObserver(observer.toShared(), snap::valdi_core::AssetOutputType::Dummy, size, size, Value());
+        observers.emplace_back(observer);
+    }
+
+    wrapper.assetsManager->endPauseUpdates();
+
+    wrapper.flushQueues();
+
+    for (const auto& observer : observers) {
+        ASSERT_EQ(static_cast<size_t>(1), observer->getResults().size());
+    }
+
+    // One load per unique size, shared by all the consumers requesting it
+    ASSERT_EQ(static_cast<size_t>(2), wrapper.assetLoader->getCurrentLoadRequestsCount());
+    ASSERT_EQ(static_cast<size_t>(2), wrapper.assetLoader->getLoadAssetCount());
+    ASSERT_EQ(static_cast<size_t>(1), wrapper.assetLoader->getRequestPayloadCallCount());
+
+    wrapper.tearDown();
+}
+
 TEST(AssetsManager, canLoadWhileUpdatesArePaused) {
     AssetsManagerWrapper wrapper;
 
@@ -0,0 +1,132 @@
+#include "valdi/runtime/Resources/AsyncDiskCache.hpp"
+
+#include "valdi/standalone_runtime/InMemoryDiskCache.hpp"
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static BytesView makeData(std::string_view str) {
+    return makeShared<ByteBuffer>(str)->toBytesView();
+}
+
+class CountingDiskCache : public InMemoryDiskCache {
+public:
+    Result<Void> store(const Path& path, const BytesView& bytes) override {
+        storesCount++;
+        return InMemoryDiskCache::store(path, bytes);
+    }
+
+    size_t storesCount = 0;
+};
+
+struct AsyncDiskCacheDependencies {
+    Ref<DispatchQueue> dispatchQueue;
+    Ref<CountingDiskCache> innerDiskCache;
+    Ref<AsyncDiskCache> diskCache;
+
+    // The batches are only written when flushed
+    AsyncDiskCacheDependencies()
+        : dispatchQueue(DispatchQueue::create(STRING_LITERAL("AsyncDiskCache"), ThreadQoSClassMax)),
+          innerDiskCache(makeShared<CountingDiskCache>()),
+          diskCache(makeShared<AsyncDiskCache>(innerDiskCache, dispatchQueue, std::chrono::hours(1))) {}
+
+    ~AsyncDiskCacheDependencies() {
+        dispatchQueue->fullTeardown();
+    }
+};
+
+TEST(AsyncDiskCache, coalescesPendingStores) {
+    AsyncDiskCacheDependencies dependencies;
+    auto& diskCache = dependencies.diskCache;
+
+    size_t completionsCount = 0;
+    auto completion = [&](const Result<Void>& result) {
+        ASSERT_TRUE(result) << result.description();
+        completionsCount++;
+    };
+
+    diskCache->storeAsync(Path("a.txt"), makeData("1"), completion);
+    diskCache->storeAsync(Path("a.txt"), makeData("2"), completion);
+    diskCache->storeAsync(Path("b.txt"), makeData("3"), completion);
+
+    ASSERT_EQ(static_cast<size_t>(2), diskCache->getPendingStoresCount());
+    ASSERT_EQ(static_cast<size_t>(0), dependencies.innerDiskCache->storesCount);
+
+    // Pending stores are visible before they are written
+    ASSERT_TRUE(diskCache->exists(Path("a.txt")));
+    ASSERT_EQ("2", diskCache->load(Path("a.txt")).value().asStringView());
+    ASSERT_FALSE(dependencies.innerDiskCache->exists(Path("a.txt")));
+
+    diskCache->flush();
+
+    ASSERT_EQ(static_cast<size_t>(0), diskCache->getPendingStoresCount());
+    ASSERT_EQ(static_cast<size_t>(2), dependencies.innerDiskCache->storesCount);
+    ASSERT_EQ(static_cast<size_t>(3), completionsCount);
+    ASSERT_EQ("2", dependencies.innerDiskCache->load(Path("a.txt")).value().asStringView());
+    ASSERT_EQ("3", dependencies.innerDiskCache->load(Path("b.txt")).value().asStringView());
+}
+
+TEST(AsyncDiskCache, syncStoreReplacesPendingStore) {
+    AsyncDiskCacheDependencies dependencies;
+    auto& diskCache = dependencies.diskCache;
+
+    size_t completionsCount = 0;
+    diskCache->storeAsync(Path("a.txt"), makeData("1"), [&](const Result<Void>& /*result*/) { completionsCount++; });
+
+    auto result = diskCache->store(Path("a.txt"), makeData("2"));
+    ASSERT_TRUE(result) << result.description();
+
+    ASSERT_EQ(static_cast<size_t>(1), completionsCount);
+    ASSERT_EQ(static_cast<size_t>(0), diskCache->getPendingStoresCount());
+
+    diskCache->flush();
+
+    ASSERT_EQ(static_cast<size_t>(1), dependencies.innerDiskCache->storesCount);
+    ASSERT_EQ("2", dependencies.innerDiskCache->load(Path("a.txt")).value().asStringView());
+}
+
+TEST(AsyncDiskCache, removeDropsPendingStore) {
+    AsyncDiskCacheDependencies dependencies;
+    auto& diskCache = dependencies.diskCache;
+
+    diskCache->storeAsync(Path("a.txt"), makeData("1"), nullptr);
+
+    ASSERT_TRUE(diskCache->remove(Path("a.txt")));
+    ASSERT_FALSE(diskCache->exists(Path("a.txt")));
+
+    diskCache->flush();
+
+    ASSERT_EQ(static_cast<size_t>(0), dependencies.innerDiskCache->storesCount);
+    ASSERT_FALSE(dependencies.innerDiskCache->exists(Path("a.txt")));
+}
+
+TEST(AsyncDiskCache, canLoadAsync) {
+    AsyncDiskCacheDependencies dependencies;
+    auto& diskCache = dependencies.diskCache;
+
+    ASSERT_TRUE(dependencies.innerDiskCache->store(Path("a.txt"), makeData("Hello World")));
+
+    std::optional<Result<BytesView>> loadResult;
+    diskCache->loadAsync(Path("a.txt"), [&](const Result<BytesView>& result) { loadResult = result; });
+    std::optional<Result<BytesView>> missingResult;
+    diskCache->loadAsync(Path("b.txt"), [&](const Result<BytesView>& result) { missingResult = result; });
+
+    dependencies.dispatchQueue->sync([]() {});
+
+    ASSERT_TRUE(loadResult.has_value());
+    ASSERT_TRUE(loadResult.value()) << loadResult.value().description();
+    ASSERT_EQ("Hello World", loadResult.value().value().asStringView());
+
+    ASSERT_TRUE(missingResult.has_value());
+    ASSERT_FALSE(missingResult.value());
+}
+
+} // namespace ValdiTest
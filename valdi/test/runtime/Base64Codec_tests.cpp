@@ -0,0 +1,119 @@
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static std::string encode(std::string_view str, bool urlSafe = false) {
+    return Base64Codec::encode(reinterpret_cast<const Byte*>(str.data()), str.size(), urlSafe);
+}
+
+static std::optional<std::string> decode(std::string_view str) {
+    Bytes output;
+    if (!Base64Codec::decode(str, output)) {
+        return std::nullopt;
+    }
+    return std::string(reinterpret_cast<const char*>(output.data()), output.size());
+}
+
+static std::string repeat(std::string_view str, size_t count) {
+    std::string output;
+    for (size_t i = 0; i < count; i++) {
+        output += str;
+    }
+    return output;
+}
+
+static std::string makeData(size_t size) {
+    std::string data;
+    data.resize(size);
+    uint32_t seed = 42;
+    for (auto& c : data) {
+        seed = seed * 1103515245 + 12345;
+        c = static_cast<char>(seed >> 16);
+    }
+    return data;
+}
+
+TEST(Base64Codec, canEncode) {
+    ASSERT_EQ("", encode(""));
+    ASSERT_EQ("Zg==", encode("f"));
+    ASSERT_EQ("Zm8=", encode("fo"));
+    ASSERT_EQ("Zm9v", encode("foo"));
+    ASSERT_EQ("Zm9vYg==", encode("foob"));
+    ASSERT_EQ("Zm9vYmFy", encode("foobar"));
+    ASSERT_EQ("PDw/Pz8+Pg==", encode("<<???>>"));
+    ASSERT_EQ("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw==",
+              encode("The quick brown fox jumps over the lazy dog"));
+}
+
+TEST(Base64Codec, canEncodeUrlSafe) {
+    ASSERT_EQ("PDw_Pz8-Pg", encode("<<???>>", true));
+    ASSERT_EQ("Zm8", encode("fo", true));
+    ASSERT_EQ("Zm9v", encode("foo", true));
+    // Sextets 62 and 63 in vectorized blocks
+    ASSERT_EQ(std::string(64, '+'), encode(repeat("\xfb\xef\xbe", 16)));
+    ASSERT_EQ(std::string(64, '-'), encode(repeat("\xfb\xef\xbe", 16), true));
+    ASSERT_EQ(std::string(64, '_'), encode(std::string(48, '\xff'), true));
+}
+
+TEST(Base64Codec, canDecode) {
+    ASSERT_EQ("", decode(""));
+    ASSERT_EQ("f", decode("Zg=="));
+    ASSERT_EQ("fo", decode("Zm8="));
+    ASSERT_EQ("foobar", decode("Zm9vYmFy"));
+    ASSERT_EQ("The quick brown fox jumps over the lazy dog",
+              decode("VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZw=="));
+}
+
+TEST(Base64Codec, canDecodeWithoutPaddingAndUrlSafe) {
+    ASSERT_EQ("<<???>>", decode("PDw/Pz8+Pg"));
+    ASSERT_EQ("<<???>>", decode("PDw_Pz8-Pg"));
+    ASSERT_EQ("<<???>>", decode("PDw_Pz8-Pg="));
+    ASSERT_EQ(repeat("\xfb\xef\xbe", 16), decode(std::string(64, '-')));
+    ASSERT_EQ(std::string(48, '\xff'), decode(std::string(64, '_')));
+}
+
+TEST(Base64Codec, skipsLineBreaks) {
+    auto data = makeData(300);
+    auto encoded = encode(data);
+    std::string withLineBreaks;
+    for (size_t i = 0; i < encoded.size(); i += 76) {
+        withLineBreaks += encoded.substr(i, 76);
+        withLineBreaks += "\r\n";
+    }
+
+    ASSERT_EQ(data, decode(withLineBreaks));
+}
+
+TEST(Base64Codec, failsOnInvalidInput) {
+    ASSERT_FALSE(decode("Z"));
+    ASSERT_FALSE(decode("Zm9vY"));
+    ASSERT_FALSE(decode("Zm9v YmFy"));
+    ASSERT_FALSE(decode("Zm9v=YmFy"));
+    ASSERT_FALSE(decode("Zm9vYmFyZm9vYmFyZm9vYmFy\xc3\xa9"));
+    ASSERT_FALSE(decode("Zm9vYmFyZm9vYmFy*m9vYmFyZm9vYmFy"));
+}
+
+TEST(Base64Codec, roundTripsAllSizes) {
+    for (size_t size = 0; size < 200; size++) {
+        auto data = makeData(size);
+        auto encoded = encode(data);
+        ASSERT_EQ(Base64Codec::getEncodedLength(size, false), encoded.size());
+        ASSERT_EQ(data, decode(encoded)) << size;
+
+        auto urlSafeEncoded = encode(data, true);
+        ASSERT_EQ(Base64Codec::getEncodedLength(size, true), urlSafeEncoded.size());
+        ASSERT_EQ(data, decode(urlSafeEncoded)) << size;
+    }
+}
+
+TEST(Base64Codec, roundTripsLargePayloads) {
+    auto data = makeData(1024 * 1024 + 7);
+    auto encoded = encode(data);
+
+    ASSERT_EQ(data, decode(encoded));
+}
+
+} // namespace ValdiTest
@@ -118,6 +118,27 @@ TEST(BridgedObjectsManager, canReleaseAllObjects) {
     ASSERT_EQ(1, obj3.use_count());
 }
 
+TEST(BridgedObjectsManager, canReleaseObjectsInBulk) {
+    BridgedObjectsManager<Shared<BridgeTest>> manager;
+
+    auto obj1 = makeBridgeObject();
+    auto obj2 = makeBridgeObject();
+
+    auto id1 = manager.storeObject(obj1);
+    auto id2 = manager.storeObject(obj2);
+    manager.retainObject(*id2);
+
+    ASSERT_EQ(static_cast<size_t>(2), manager.releaseObjects({*id1, *id2, 42}));
+
+    ASSERT_EQ(1, obj1.use_count());
+    ASSERT_EQ(2, obj2.use_count());
+    ASSERT_EQ(nullptr, manager.getObject(*id1));
+    ASSERT_NE(nullptr, manager.getObject(*id2));
+
+    ASSERT_EQ(static_cast<size_t>(1), manager.releaseObjects({*id1, *id2}));
+    ASSERT_EQ(1, obj2.use_count());
+}
+
 TEST(BridgedObjectsManager, canFreeze) {
     BridgedObjectsManager<Shared<BridgeTest>> manager;
 
@@ -0,0 +1,122 @@
+#include "valdi_core/cpp/Utils/ByteRope.hpp"
+#include "valdi_core/cpp/Utils/DiskUtils.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static BytesView makeBytes(size_t size, char c) {
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->append(std::string(size, c));
+    return buffer->toBytesView();
+}
+
+TEST(ByteRope, appendsSmallRegionsAsCopies) {
+    ByteRope rope;
+    rope.append("Hello");
+    rope.append(" ");
+    rope.append(makeBytes(3, '!'));
+
+    ASSERT_EQ(static_cast<size_t>(9), rope.size());
+    ASSERT_EQ(static_cast<size_t>(1), rope.getChunks().size());
+    ASSERT_EQ("Hello !!!", rope.toBytesView().asStringView());
+}
+
+TEST(ByteRope, appendsLargeBytesByReference) {
+    auto large = makeBytes(ByteRope::kMinReferencedSize, 'a');
+
+    ByteRope rope;
+    rope.append("head");
+    rope.append(large);
+    rope.append("tail");
+
+    auto chunks = rope.getChunks();
+    ASSERT_EQ(static_cast<size_t>(3), chunks.size());
+    ASSERT_EQ(large.data(), chunks[1].data());
+    ASSERT_EQ("head" + std::string(large.size(), 'a') + "tail", rope.toBytesView().asStringView());
+}
+
+TEST(ByteRope, growsWithoutReallocatingChunks) {
+    ByteRope rope;
+    std::string expected;
+    for (size_t i = 0; i < 10000; i++) {
+        auto str = std::to_string(i);
+        rope.append(str);
+        expected += str;
+    }
+
+    auto chunks = rope.getChunks();
+    ASSERT_LT(static_cast<size_t>(1), chunks.size());
+    // Chunks grow with the rope
+    ASSERT_LT(chunks.front().size(), chunks.back().size());
+    ASSERT_EQ(expected.size(), rope.size());
+    ASSERT_EQ(expected, rope.toBytesView().asStringView());
+}
+
+TEST(ByteRope, canAppendOtherRope) {
+    ByteRope inner;
+    inner.append(makeBytes(ByteRope::kMinReferencedSize, 'b'));
+    inner.append("inner");
+
+    ByteRope rope;
+    rope.append("outer");
+    rope.append(inner);
+    inner.append("ignored");
+
+    ASSERT_EQ("outer" + std::string(ByteRope::kMinReferencedSize, 'b') + "inner", rope.toBytesView().asStringView());
+}
+
+TEST(ByteRope, canSlice) {
+    ByteRope rope;
+    rope.append("abc");
+    rope.append(makeBytes(ByteRope::kMinReferencedSize, 'd'));
+    rope.append("efg");
+
+    auto withinChunk = rope.slice(4, 10);
+    ASSERT_EQ(std::string(10, 'd'), withinChunk.asStringView());
+    ASSERT_EQ(rope.getChunks()[1].data() + 1, withinChunk.data());
+
+    auto acrossChunks = rope.slice(1, ByteRope::kMinReferencedSize + 4);
+    ASSERT_EQ("bc" + std::string(ByteRope::kMinReferencedSize, 'd') + "ef", acrossChunks.asStringView());
+
+    ASSERT_EQ("fg", rope.slice(rope.size() - 2, 100).asStringView());
+    ASSERT_TRUE(rope.slice(rope.size(), 1).empty());
+}
+
+TEST(ByteRope, exportsIOVecs) {
+    ByteRope rope;
+    rope.append("abc");
+    rope.append(makeBytes(ByteRope::kMinReferencedSize, 'd'));
+
+    std::vector<iovec> vecs;
+    rope.toIOVecs(vecs);
+
+    ASSERT_EQ(static_cast<size_t>(2), vecs.size());
+    ASSERT_EQ(static_cast<size_t>(3), vecs[0].iov_len);
+    ASSERT_EQ(ByteRope::kMinReferencedSize, vecs[1].iov_len);
+}
+
+TEST(ByteRope, canBeStoredOnDisk) {
+    ByteRope rope;
+    std::string expected;
+    for (size_t i = 0; i < 100; i++) {
+        auto bytes = makeBytes(ByteRope::kMinReferencedSize, static_cast<char>('a' + i % 26));
+        rope.append(bytes);
+        rope.append(std::to_string(i));
+        expected += bytes.asStringView();
+        expected += std::to_string(i);
+    }
+
+    auto path = DiskUtils::temporaryFilePath();
+    auto storeResult = DiskUtils::store(path, rope);
+    ASSERT_TRUE(storeResult) << storeResult.description();
+
+    auto loadResult = DiskUtils::load(path);
+    DiskUtils::remove(path);
+
+    ASSERT_TRUE(loadResult) << loadResult.description();
+    ASSERT_EQ(expected, loadResult.value().asStringView());
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,115 @@
+#include "valdi_core/cpp/Attributes/ColorPalette.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+class TestColorPaletteListener : public ColorPaletteListener {
+public:
+    void onColorPaletteUpdated(const ColorPalette& /*colorPalette*/, const ColorPaletteChanges& changes) override {
+        updates.emplace_back(changes);
+    }
+
+    std::vector<ColorPaletteChanges> updates;
+};
+
+TEST(ColorPalette, resolvesColorsById) {
+    ColorPalette colorPalette;
+
+    auto colorId = colorPalette.getColorIdForName(STRING_LITERAL("red"));
+    ASSERT_TRUE(colorId.has_value());
+    ASSERT_EQ(Color(0xFF0000FF), colorPalette.getColorForId(colorId.value()));
+    ASSERT_EQ(STRING_LITERAL("red"), colorPalette.getColorNameForId(colorId.value()));
+    ASSERT_FALSE(colorPalette.getColorIdForName(STRING_LITERAL("semanticBackground")).has_value());
+
+    auto colorsCount = colorPalette.getColorsCount();
+    FlatMap<StringBox, Color> colors;
+    colors[STRING_LITERAL("semanticBackground")] = Color(0x112233FF);
+    colorPalette.updateColors(colors);
+
+    // New colors are appended after the existing ones
+    ASSERT_EQ(colorsCount + 1, colorPalette.getColorsCount());
+    ASSERT_EQ(std::optional<ColorId>(static_cast<ColorId>(colorsCount)),
+              colorPalette.getColorIdForName(STRING_LITERAL("semanticBackground")));
+    ASSERT_EQ(Color(0x112233FF), colorPalette.getColorForId(static_cast<ColorId>(colorsCount)));
+    ASSERT_EQ(colorId, colorPalette.getColorIdForName(STRING_LITERAL("red")));
+}
+
+TEST(ColorPalette, notifiesOnlyChangedColors) {
+    ColorPalette colorPalette;
+    TestColorPaletteListener listener;
+    colorPalette.setListener(&listener);
+
+    FlatMap<StringBox, Color> colors;
+    colors[STRING_LITERAL("background")] = Color(0x000000FF);
+    colors[STRING_LITERAL("foreground")] = Color(0xFFFFFFFF);
+    colorPalette.updateColors(colors);
+
+    ASSERT_EQ(static_cast<size_t>(1), listener.updates.size());
+    ASSERT_EQ(static_cast<size_t>(2), listener.updates[0].size());
+
+    auto backgroundId = colorPalette.getColorIdForName(STRING_LITERAL("background")).value();
+    auto foregroundId = colorPalette.getColorIdForName(STRING_LITERAL("foreground")).value();
+
+    // Only the foreground changes
+    colors[STRING_LITERAL("foreground")] = Color(0x808080FF);
+    colorPalette.updateColors(colors);
+
+    ASSERT_EQ(static_cast<size_t>(2), listener.updates.size());
+    ASSERT_EQ(static_cast<size_t>(1), listener.updates[1].size());
+    ASSERT_TRUE(listener.updates[1].contains(foregroundId));
+    ASSERT_FALSE(listener.updates[1].contains(backgroundId));
+
+    // Nothing changes
+    colorPalette.updateColors(colors);
+
+    ASSERT_EQ(static_cast<size_t>(2), listener.updates.size());
+}
+
+TEST(ColorPalette, recordsColorLookups) {
+    ColorPalette colorPalette;
+
+    auto redId = colorPalette.getColorIdForName(STRING_LITERAL("red")).value();
+    auto blueId = colorPalette.getColorIdForName(STRING_LITERAL("blue")).value();
+
+    // Lookups made outside of a recorder are not recorded
+    colorPalette.getColorForName(STRING_LITERAL("white"));
+
+    ColorPaletteLookupRecorder recorder;
+    colorPalette.getColorForName(STRING_LITERAL("red"));
+    colorPalette.getColorForName(STRING_LITERAL("notAColor"));
+
+    {
+        ColorPaletteLookupRecorder nestedRecorder;
+        colorPalette.getColorForName(STRING_LITERAL("blue"));
+        ASSERT_EQ(ColorIds({blueId}), nestedRecorder.getColorIds());
+    }
+
+    colorPalette.getColorForName(STRING_LITERAL("red"));
+
+    ASSERT_EQ(ColorIds({redId}), recorder.getColorIds());
+}
+
+TEST(ColorPalette, canQueryChanges) {
+    ColorPaletteChanges changes(4);
+
+    ASSERT_TRUE(changes.empty());
+
+    changes.insert(2);
+    changes.insert(2);
+    changes.insert(8);
+
+    ASSERT_FALSE(changes.empty());
+    ASSERT_EQ(static_cast<size_t>(2), changes.size());
+    ASSERT_TRUE(changes.contains(2));
+    ASSERT_TRUE(changes.contains(8));
+    ASSERT_FALSE(changes.contains(0));
+    ASSERT_FALSE(changes.contains(100));
+    ASSERT_TRUE(changes.containsAny(ColorIds({0, 8})));
+    ASSERT_FALSE(changes.containsAny(ColorIds({0, 1})));
+    ASSERT_FALSE(changes.containsAny(ColorIds()));
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,118 @@
+#include "valdi_core/cpp/Threading/Coroutine.hpp"
+#include "valdi_core/cpp/Utils/ResolvablePromise.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static Coroutine<int> addOne(int value) {
+    co_return value + 1;
+}
+
+static Coroutine<Result<Value>> awaitPromise(Ref<Promise> promise) {
+    auto result = co_await promise;
+    if (!result) {
+        co_return result.moveError();
+    }
+
+    auto value = co_await addOne(result.value().toInt());
+    co_return Value(value);
+}
+
+static Coroutine<> hopToQueue(Ref<DispatchQueue> queue, std::vector<bool>& isOnQueue) {
+    isOnQueue.emplace_back(queue->isCurrent());
+    co_await queue;
+    isOnQueue.emplace_back(queue->isCurrent());
+    co_await queue;
+    isOnQueue.emplace_back(queue->isCurrent());
+}
+
+TEST(Coroutine, completesWithoutSuspending) {
+    auto coroutine = addOne(41);
+
+    ASSERT_TRUE(coroutine.isCompleted());
+    ASSERT_EQ(42, coroutine.value());
+}
+
+TEST(Coroutine, resumesWhenPromiseIsFulfilled) {
+    auto promise = makeShared<ResolvablePromise>();
+    auto coroutine = awaitPromise(promise);
+
+    ASSERT_FALSE(coroutine.isCompleted());
+
+    promise->fulfill(Value(1));
+
+    ASSERT_TRUE(coroutine.isCompleted());
+    ASSERT_TRUE(coroutine.value()) << coroutine.value().description();
+    ASSERT_EQ(Value(2), coroutine.value().value());
+}
+
+TEST(Coroutine, resumesWithPromiseFailure) {
+    auto promise = makeShared<ResolvablePromise>();
+    promise->fulfill(Error("Failed"));
+
+    auto coroutine = awaitPromise(promise);
+
+    ASSERT_TRUE(coroutine.isCompleted());
+    ASSERT_FALSE(coroutine.value());
+    ASSERT_EQ(STRING_LITERAL("Failed"), coroutine.value().error().getMessage());
+}
+
+TEST(Coroutine, hopsToDispatchQueue) {
+    auto queue = DispatchQueue::create(STRING_LITERAL("Coroutine"), ThreadQoSClassNormal);
+    std::vector<bool> isOnQueue;
+
+    auto coroutine = hopToQueue(queue, isOnQueue);
+    queue->sync([]() {});
+
+    ASSERT_TRUE(coroutine.isCompleted());
+    ASSERT_EQ(std::vector<bool>({false, true, true}), isOnQueue);
+
+    queue->fullTeardown();
+}
+
+TEST(Coroutine, runsInlineWhenAlreadyOnQueue) {
+    auto queue = DispatchQueue::create(STRING_LITERAL("Coroutine"), ThreadQoSClassNormal);
+    std::vector<bool> isOnQueue;
+    bool completedInline = false;
+
+    queue->async([&]() {
+        auto coroutine = hopToQueue(queue, isOnQueue);
+        completedInline = coroutine.isCompleted();
+    });
+    queue->sync([]() {});
+
+    ASSERT_TRUE(completedInline);
+    ASSERT_EQ(std::vector<bool>({true, true, true}), isOnQueue);
+
+    queue->fullTeardown();
+}
+
+TEST(Coroutine, canBeExposedAsPromise) {
+    auto resolvablePromise = makeShared<ResolvablePromise>();
+    auto promise = toPromise(awaitPromise(resolvablePromise));
+
+    std::optional<Value> result;
+    promise->onComplete([&](const Result<Value>& promiseResult) { result = promiseResult.value(); });
+
+    ASSERT_FALSE(result.has_value());
+
+    resolvablePromise->fulfill(Value(41));
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(Value(42), result.value());
+}
+
+TEST(Coroutine, reusesFramesOfCompletedCoroutines) {
+    { auto coroutine = addOne(1); }
+
+    auto pooledFramesCount = CoroutineFrameAllocator::getPooledFramesCount();
+    ASSERT_LT(static_cast<size_t>(0), pooledFramesCount);
+
+    auto coroutine = addOne(2);
+    ASSERT_EQ(pooledFramesCount - 1, CoroutineFrameAllocator::getPooledFramesCount());
+}
+
+} // namespace ValdiTest
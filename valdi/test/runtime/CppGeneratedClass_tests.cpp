@@ -78,6 +78,30 @@ RegisteredCppGeneratedClass MyCardSection::registeredClass = CppGeneratedClass::
     "c 'MyCardSection'{'cards': a<r:'MyCard'>, 'ids': a<l>}",
     []() -> RegisteredCppGeneratedClass::TypeReferencesVec { return {&MyCard::registeredClass}; });
 
+struct MyPinnedCard : public CppGeneratedModel {
+    StringBox pin;
+    std::optional<Ref<MyCard>> card;
+    std::vector<double> offsets;
+
+    MyPinnedCard() = default;
+    ~MyPinnedCard() override = default;
+
+    using Fields = CppModelFields<&MyPinnedCard::pin, &MyPinnedCard::card, &MyPinnedCard::offsets>;
+    static RegisteredCppGeneratedClass registeredClass;
+
+    static void marshall(ExceptionTracker& exceptionTracker, const Ref<MyPinnedCard>& value, Value& out) {
+        CppMarshaller::marshallModel(exceptionTracker, value, out);
+    }
+
+    static void unmarshall(ExceptionTracker& exceptionTracker, const Value& value, Ref<MyPinnedCard>& out) {
+        CppMarshaller::unmarshallModel(exceptionTracker, value, out);
+    }
+};
+
+RegisteredCppGeneratedClass MyPinnedCard::registeredClass = CppGeneratedClass::registerSchema(
+    "c 'MyPinnedCard'{'pin': s, 'card': r?:'MyCard', 'offsets': a<d>}",
+    []() -> RegisteredCppGeneratedClass::TypeReferencesVec { return {&MyCard::registeredClass}; });
+
 struct ICalculator : public CppGeneratedInterface {
     virtual Result<double> add(double left, double right) = 0;
 
@@ -224,6 +248,57 @@ TEST(CppGeneratedClass, canUnmarshallObjectFromTypedObject) {
     ASSERT_EQ(std::nullopt, out->onTap);
 }
 
+TEST(CppGeneratedClass, canMarshallModelFromFields) {
+    auto card = makeShared<MyCard>();
+    card->title = STRING_LITERAL("Hello World");
+    card->width = 42;
+
+    auto object = makeShared<MyPinnedCard>();
+    object->pin = STRING_LITERAL("top");
+    object->card = {card};
+    object->offsets = {1.0, 2.5};
+
+    SimpleExceptionTracker exceptionTracker;
+    Value out;
+    MyPinnedCard::marshall(exceptionTracker, object, out);
+    ASSERT_TRUE(exceptionTracker) << exceptionTracker.extractError();
+
+    ASSERT_EQ(static_cast<size_t>(3), MyPinnedCard::Fields::kFieldsCount);
+
+    auto typedObject = out.getTypedObjectRef();
+    ASSERT_TRUE(typedObject != nullptr);
+    ASSERT_EQ(Value(STRING_LITERAL("top")), typedObject->getProperty(0));
+    ASSERT_EQ(Value(STRING_LITERAL("Hello World")), typedObject->getProperty(1).getTypedObjectRef()->getProperty(0));
+    ASSERT_EQ(Value(ValueArray::make({Value(1.0), Value(2.5)})), typedObject->getProperty(2));
+
+    Ref<MyPinnedCard> unmarshalled;
+    MyPinnedCard::unmarshall(exceptionTracker, out, unmarshalled);
+    ASSERT_TRUE(exceptionTracker) << exceptionTracker.extractError();
+
+    ASSERT_TRUE(unmarshalled != nullptr);
+    ASSERT_EQ(STRING_LITERAL("top"), unmarshalled->pin);
+    ASSERT_TRUE(unmarshalled->card.has_value());
+    ASSERT_EQ(STRING_LITERAL("Hello World"), unmarshalled->card.value()->title);
+    ASSERT_EQ(42.0, unmarshalled->card.value()->width);
+    ASSERT_EQ(std::vector<double>({1.0, 2.5}), unmarshalled->offsets);
+}
+
+TEST(CppGeneratedClass, canUnmarshallModelFromFieldsWithMissingOptional) {
+    Ref<MyPinnedCard> out;
+    SimpleExceptionTracker exceptionTracker;
+    MyPinnedCard::unmarshall(exceptionTracker,
+                             Value()
+                                 .setMapValue("pin", Value(STRING_LITERAL("bottom")))
+                                 .setMapValue("offsets", Value(ValueArray::make({Value(3.0)}))),
+                             out);
+    ASSERT_TRUE(exceptionTracker) << exceptionTracker.extractError();
+
+    ASSERT_TRUE(out != nullptr);
+    ASSERT_EQ(STRING_LITERAL("bottom"), out->pin);
+    ASSERT_EQ(std::nullopt, out->card);
+    ASSERT_EQ(std::vector<double>({3.0}), out->offsets);
+}
+
 TEST(CppGeneratedClass, canMarshallFunction) {
     auto object = makeShared<MyCard>();
 
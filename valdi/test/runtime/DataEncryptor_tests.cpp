@@ -1,6 +1,8 @@
 #include "valdi/runtime/Utils/DataEncryptor.hpp"
 #include "gtest/gtest.h"
 
+#include <vector>
+
 using namespace Valdi;
 
 namespace ValdiTest {
@@ -57,4 +59,93 @@ TEST(DataEncryptor, failsToDecryptWithInvalidIV) {
     }
 }
 
+static std::vector<Byte> makeData(size_t length) {
+    std::vector<Byte> data(length);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = static_cast<Byte>(i * 31 + (i >> 8));
+    }
+    return data;
+}
+
+TEST(DataEncryptor, canEncryptAndDecryptMultipleSegments) {
+    auto data = makeData(200 * 1024 + 7);
+
+    DataEncryptor encryptor(DataEncryptor::generateKey());
+
+    ByteBuffer encryptedBuffer;
+    ASSERT_TRUE(encryptor.encrypt(data.data(), data.size(), encryptedBuffer));
+
+    auto decryptedSize = DataEncryptor::getDecryptedSize(encryptedBuffer.data(), encryptedBuffer.size());
+    ASSERT_TRUE(decryptedSize.has_value());
+    ASSERT_EQ(data.size(), decryptedSize.value());
+
+    ByteBuffer decryptedBuffer;
+    ASSERT_TRUE(encryptor.decrypt(encryptedBuffer.data(), encryptedBuffer.size(), decryptedBuffer));
+
+    ASSERT_EQ(std::vector<Byte>(decryptedBuffer.begin(), decryptedBuffer.end()), data);
+}
+
+TEST(DataEncryptor, canDecryptRange) {
+    auto data = makeData(200 * 1024);
+
+    DataEncryptor encryptor(DataEncryptor::generateKey());
+
+    ByteBuffer encryptedBuffer;
+    ASSERT_TRUE(encryptor.encrypt(data.data(), data.size(), encryptedBuffer));
+
+    // Range across the boundary of the first and second segments
+    size_t offset = 64 * 1024 - 100;
+    std::vector<Byte> range(300);
+    ASSERT_TRUE(
+        encryptor.decrypt(encryptedBuffer.data(), encryptedBuffer.size(), offset, range.data(), range.size()));
+    ASSERT_EQ(std::vector<Byte>(data.begin() + offset, data.begin() + offset + range.size()), range);
+
+    // Range at the end of the data
+    offset = data.size() - 10;
+    range.resize(10);
+    ASSERT_TRUE(
+        encryptor.decrypt(encryptedBuffer.data(), encryptedBuffer.size(), offset, range.data(), range.size()));
+    ASSERT_EQ(std::vector<Byte>(data.begin() + offset, data.end()), range);
+
+    // Out of bounds
+    range.resize(11);
+    ASSERT_FALSE(
+        encryptor.decrypt(encryptedBuffer.data(), encryptedBuffer.size(), offset, range.data(), range.size()));
+}
+
+TEST(DataEncryptor, canEncryptAndDecryptEmptyData) {
+    DataEncryptor encryptor(DataEncryptor::generateKey());
+
+    ByteBuffer encryptedBuffer;
+    ASSERT_TRUE(encryptor.encrypt(nullptr, 0, encryptedBuffer));
+
+    ByteBuffer decryptedBuffer;
+    ASSERT_TRUE(encryptor.decrypt(encryptedBuffer.data(), encryptedBuffer.size(), decryptedBuffer));
+    ASSERT_TRUE(decryptedBuffer.empty());
+}
+
+TEST(DataEncryptor, failsToDecryptCorruptedSegment) {
+    auto data = makeData(150 * 1024);
+
+    DataEncryptor encryptor(DataEncryptor::generateKey());
+
+    ByteBuffer encryptedBuffer;
+    ASSERT_TRUE(encryptor.encrypt(data.data(), data.size(), encryptedBuffer));
+
+    // Corrupt a byte of the last segment
+    (*encryptedBuffer[encryptedBuffer.size() - 20])++;
+
+    ByteBuffer decryptedBuffer;
+    ASSERT_FALSE(encryptor.decrypt(encryptedBuffer.data(), encryptedBuffer.size(), decryptedBuffer));
+
+    // The segments which were not corrupted can still be decrypted
+    std::vector<Byte> range(1024);
+    ASSERT_TRUE(encryptor.decrypt(encryptedBuffer.data(), encryptedBuffer.size(), 0, range.data(), range.size()));
+    ASSERT_EQ(std::vector<Byte>(data.begin(), data.begin() + range.size()), range);
+
+    std::vector<Byte> lastRange(1024);
+    ASSERT_FALSE(encryptor.decrypt(
+        encryptedBuffer.data(), encryptedBuffer.size(), data.size() - 1024, lastRange.data(), lastRange.size()));
+}
+
 } // namespace ValdiTest
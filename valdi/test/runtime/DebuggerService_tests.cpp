@@ -263,6 +263,53 @@ TEST(DebuggerService, canReceiveUpdatedResources) {
     ASSERT_EQ(static_cast<size_t>(1), dequeuedResources.resources.size());
 }
 
+TEST(DebuggerService, canReceivePacketSubmittedInSmallChunks) {
+    DebuggerServiceWrapper wrapper;
+
+    wrapper.service->addListener(wrapper.listener.get());
+
+    wrapper.service->start();
+
+    auto client = makeShared<TCPClient>();
+    auto tcpListener = makeShared<MockTCPClientListener>();
+
+    Ref<ITCPConnection> connection;
+
+    wrapper.connectToService(client, tcpListener, connection);
+
+    ASSERT_TRUE(connection != nullptr);
+
+    auto updatedResources = ValueArray::make(1);
+    Value resource1;
+    resource1.setMapValue("data", Value("hello"))
+        .setMapValue("bundle_name", Value("bundle1"))
+        .setMapValue("file_path_within_bundle", Value("src/file1.js"));
+    updatedResources->emplace(0, resource1);
+
+    Value resources;
+    resources.setMapValue("resources", Value(updatedResources));
+    Value event;
+    event.setMapValue("updated_resources", resources);
+    Value payload;
+    payload.setMapValue("event", event);
+
+    auto output = valueToJson(payload);
+    auto out = makeShared<ByteBuffer>();
+    ValdiPacket::write(reinterpret_cast<const Byte*>(output->data()), output->size(), *out);
+
+    // Chunks submitted while a write is in flight are written together, and must be sent in order
+    auto bytes = out->toBytesView();
+    constexpr size_t kChunkSize = 3;
+    for (size_t offset = 0; offset < bytes.size(); offset += kChunkSize) {
+        auto chunkSize = std::min(kChunkSize, bytes.size() - offset);
+        connection->submitData(BytesView(bytes.getSource(), bytes.data() + offset, chunkSize));
+    }
+
+    auto dequeuedResources = wrapper.listener->dequeueNextEvent();
+    ASSERT_EQ(DebuggerServiceEventTypeReceivedUpdatedResources, dequeuedResources.type);
+    ASSERT_EQ(static_cast<size_t>(1), dequeuedResources.resources.size());
+}
+
 TEST(DebuggerService, submitConfigurationOnConnect) {
     DebuggerServiceWrapper wrapper;
 
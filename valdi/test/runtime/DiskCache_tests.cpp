@@ -204,4 +204,34 @@ TEST(DiskCache, scopedInstanceRespectsIsolation) {
     ASSERT_FALSE(result.success()) << result.description();
 }
 
+TEST(DiskCache, keepsLargeLoadedItemsValidWhenOverwritten) {
+    TemporaryDirectory directory;
+    DiskCacheImpl diskCache(directory.get());
+
+    // Large enough to be mapped instead of read
+    std::string content(256 * 1024, 'a');
+    auto result = diskCache.store(Path("large"),
+                                  BytesView(nullptr, reinterpret_cast<const Byte*>(content.data()), content.size()));
+    ASSERT_TRUE(result.success()) << result.description();
+
+    auto loadResult = diskCache.load(Path("large"));
+    ASSERT_TRUE(loadResult.success()) << loadResult.description();
+    ASSERT_EQ(std::string_view(content), loadResult.value().asStringView());
+
+    std::string newContent(128, 'b');
+    result = diskCache.store(Path("large"),
+                             BytesView(nullptr, reinterpret_cast<const Byte*>(newContent.data()), newContent.size()));
+    ASSERT_TRUE(result.success()) << result.description();
+
+    // The previously loaded item should be unaffected by the new store
+    ASSERT_EQ(std::string_view(content), loadResult.value().asStringView());
+
+    auto newLoadResult = diskCache.load(Path("large"));
+    ASSERT_TRUE(newLoadResult.success()) << newLoadResult.description();
+    ASSERT_EQ(std::string_view(newContent), newLoadResult.value().asStringView());
+
+    // No temporary file should be left behind
+    ASSERT_EQ(static_cast<size_t>(1), diskCache.list(diskCache.getRootPath()).size());
+}
+
 } // namespace ValdiTest
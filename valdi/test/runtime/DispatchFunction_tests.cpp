@@ -0,0 +1,108 @@
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+#include <array>
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+class DispatchFunctionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        AllocationProfiler::setEnabled(true);
+    }
+
+    void TearDown() override {
+        AllocationProfiler::setEnabled(false);
+    }
+};
+
+struct LargeCapture {
+    std::array<uint64_t, 16> values{};
+};
+
+TEST_F(DispatchFunctionTest, storesCommonClosuresInline) {
+    auto object = makeShared<ValueMap>();
+    auto otherObject = makeShared<ValueMap>();
+    auto value = Value(STRING_LITERAL("Hello"));
+
+    auto lambda = [object, otherObject, value]() {};
+    static_assert(DispatchFunction::fitsInline<decltype(lambda)>());
+
+    auto snapshot = AllocationCounters::current();
+    DispatchFunction function(lambda);
+    function();
+
+    ASSERT_EQ(static_cast<uint64_t>(0), AllocationCounters::current().since(snapshot).getTotalCount());
+}
+
+TEST_F(DispatchFunctionTest, reusesPooledClosures) {
+    LargeCapture capture;
+    capture.values[15] = 42;
+    uint64_t result = 0;
+    auto lambda = [capture, &result]() { result = capture.values[15]; };
+    static_assert(!DispatchFunction::fitsInline<decltype(lambda)>());
+
+    { DispatchFunction warmup(lambda); }
+
+    auto pooledClosuresCount = DispatchClosureAllocator::getPooledClosuresCount();
+    ASSERT_LT(static_cast<size_t>(0), pooledClosuresCount);
+
+    auto snapshot = AllocationCounters::current();
+    {
+        DispatchFunction function(lambda);
+        ASSERT_EQ(pooledClosuresCount - 1, DispatchClosureAllocator::getPooledClosuresCount());
+        function();
+    }
+
+    ASSERT_EQ(static_cast<uint64_t>(42), result);
+    ASSERT_EQ(pooledClosuresCount, DispatchClosureAllocator::getPooledClosuresCount());
+    ASSERT_EQ(static_cast<uint64_t>(0), AllocationCounters::current().since(snapshot).getTotalCount());
+}
+
+TEST_F(DispatchFunctionTest, copiesAndReleasesPooledClosures) {
+    auto object = makeShared<ValueMap>();
+    LargeCapture capture;
+    DispatchFunction function([object, capture]() {});
+    ASSERT_EQ(static_cast<long>(2), object.use_count());
+
+    auto copy = function;
+    ASSERT_EQ(static_cast<long>(3), object.use_count());
+
+    auto moved = std::move(function);
+    ASSERT_EQ(static_cast<long>(3), object.use_count());
+
+    copy = DispatchFunction();
+    moved = DispatchFunction();
+    ASSERT_EQ(static_cast<long>(1), object.use_count());
+}
+
+TEST_F(DispatchFunctionTest, recyclesClosuresFreedOnAnotherThread) {
+    auto queue = DispatchQueue::create(STRING_LITERAL("DispatchFunction"), ThreadQoSClassNormal);
+    LargeCapture capture;
+    size_t callsCount = 0;
+
+    auto submitBatch = [&]() {
+        for (size_t i = 0; i < DispatchClosureAllocator::kMaxPooledClosuresPerSizeClass * 4; i++) {
+            queue->async([capture, &callsCount]() { callsCount++; });
+        }
+        queue->sync([]() {});
+    };
+
+    // The closures freed on the queue go back to this thread through the shared depot
+    submitBatch();
+    auto snapshot = AllocationCounters::current();
+    submitBatch();
+
+    ASSERT_EQ(DispatchClosureAllocator::kMaxPooledClosuresPerSizeClass * 8, callsCount);
+    ASSERT_GT(DispatchClosureAllocator::kMaxPooledClosuresPerSizeClass * 4,
+              AllocationCounters::current().since(snapshot).getCount(AllocationSite::DispatchClosure));
+
+    queue->fullTeardown();
+}
+
+} // namespace ValdiTest
@@ -94,4 +94,30 @@ TEST(Emoji, canDetectComplexEmojis) {
     ASSERT_EQ(UnicodeSequence({0x1F3F4, 0xE0067, 0xE0062, 0xE0065, 0xE006E, 0xE0067, 0xE007F}), *result);
 }
 
+TEST(Emoji, scannerMatchesAllEmojiAnchors) {
+    const auto& scanner = getEmojiSequenceScanner();
+
+    std::vector<CharacterRange> anchors;
+    getEmojiUnicodeTrie()->appendAnchorUnicodePoints(anchors);
+    ASSERT_FALSE(anchors.empty());
+
+    for (const auto& anchor : anchors) {
+        ASSERT_TRUE(scanner.contains(anchor.from));
+    }
+
+    // Keycap sequences are anchored on their variation selector
+    ASSERT_TRUE(scanner.contains(0xFE0F));
+    ASSERT_TRUE(scanner.contains(0x200D));
+}
+
+TEST(Emoji, scannerSkipsPlainText) {
+    const auto& scanner = getEmojiSequenceScanner();
+    auto str = makeUTF32String("Hello world 1234 #* Привет 你好");
+
+    ASSERT_EQ(str.data() + str.size(), scanner.findFirst(str.data(), str.data() + str.size()));
+
+    str = makeUTF32String("Hello world 👋");
+    ASSERT_EQ(str.data() + str.size() - 1, scanner.findFirst(str.data(), str.data() + str.size()));
+}
+
 } // namespace ValdiTest
\ No newline at end of file
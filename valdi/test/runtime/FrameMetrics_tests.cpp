@@ -0,0 +1,306 @@
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
+#include "valdi_core/cpp/Utils/LatencyHistogram.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+TEST(LatencyHistogram, bucketsBoundTheRelativeError) {
+    for (uint64_t value : {0, 1, 7, 8, 15, 16, 100, 1000, 16667, 123456, 10000000}) {
+        auto index = LatencyHistogram::getBucketIndex(value);
+        auto upperBound = LatencyHistogram::getBucketUpperBound(index);
+
+        ASSERT_LE(value, upperBound);
+        ASSERT_LE(static_cast<double>(upperBound - value),
+                  static_cast<double>(value) / static_cast<double>(LatencyHistogram::kSubBucketsCount));
+        if (index > 0) {
+            ASSERT_LT(LatencyHistogram::getBucketUpperBound(index - 1), value);
+        }
+    }
+}
+
+TEST(LatencyHistogram, computesPercentiles) {
+    LatencyHistogram histogram;
+
+    for (int i = 1; i <= 100; i++) {
+        histogram.record(std::chrono::milliseconds(i));
+    }
+
+    ASSERT_EQ(static_cast<uint64_t>(100), histogram.getCount());
+    ASSERT_EQ(std::chrono::microseconds(1000), histogram.getMin());
+    ASSERT_EQ(std::chrono::microseconds(100000), histogram.getMax());
+    ASSERT_EQ(std::chrono::microseconds(50500), histogram.getMean());
+
+    auto p50 = histogram.getValueAtPercentile(50).count();
+    ASSERT_GE(p50, 50000);
+    ASSERT_LE(p50, 50000 + 50000 / 8);
+
+    auto p90 = histogram.getValueAtPercentile(90).count();
+    ASSERT_GE(p90, 90000);
+    ASSERT_LE(p90, 90000 + 90000 / 8);
+
+    ASSERT_EQ(std::chrono::microseconds(100000), histogram.getValueAtPercentile(100));
+}
+
+TEST(LatencyHistogram, canMergeAndReset) {
+    LatencyHistogram left;
+    LatencyHistogram right;
+
+    left.record(std::chrono::milliseconds(2));
+    right.record(std::chrono::milliseconds(1));
+    right.record(std::chrono::milliseconds(3));
+
+    left.merge(right);
+
+    ASSERT_EQ(static_cast<uint64_t>(3), left.getCount());
+    ASSERT_EQ(std::chrono::microseconds(1000), left.getMin());
+    ASSERT_EQ(std::chrono::microseconds(3000), left.getMax());
+
+    left.reset();
+    ASSERT_TRUE(left.empty());
+    ASSERT_EQ(std::chrono::microseconds(0), left.getValueAtPercentile(50));
+}
+
+struct FlushedSummaries {
+    std::vector<std::pair<StringBox, FrameMetricsSummary>> summaries;
+
+    FrameMetricsFlushCallback makeCallback() {
+        return [this](const StringBox& module, const FrameMetricsSummary& summary) {
+            summaries.emplace_back(module, summary);
+        };
+    }
+};
+
+TEST(FrameMetrics, attributesJankToSlowestPhase) {
+    FrameMetricsAggregator aggregator(std::chrono::milliseconds(16), std::chrono::hours(1));
+    FlushedSummaries flushed;
+    aggregator.setFlushCallback(flushed.makeCallback());
+
+    auto module = STRING_LITERAL("my_module");
+
+    FrameTimings fastFrame;
+    fastFrame.add(FramePhase::Render, std::chrono::milliseconds(2));
+    fastFrame.add(FramePhase::Layout, std::chrono::milliseconds(4));
+
+    FrameTimings layoutBoundFrame;
+    layoutBoundFrame.add(FramePhase::Render, std::chrono::milliseconds(5));
+    layoutBoundFrame.add(FramePhase::Layout, std::chrono::milliseconds(20));
+
+    FrameTimings jsBoundFrame;
+    jsBoundFrame.add(FramePhase::JSRender, std::chrono::milliseconds(12));
+    jsBoundFrame.add(FramePhase::Raster, std::chrono::milliseconds(8));
+
+    aggregator.recordFrame(module, fastFrame);
+    aggregator.recordFrame(module, layoutBoundFrame);
+    aggregator.recordFrame(module, layoutBoundFrame);
+    aggregator.recordFrame(module, jsBoundFrame);
+
+    ASSERT_TRUE(flushed.summaries.empty());
+
+    aggregator.flush();
+
+    ASSERT_EQ(static_cast<size_t>(1), flushed.summaries.size());
+    ASSERT_EQ(module, flushed.summaries[0].first);
+
+    const auto& summary = flushed.summaries[0].second;
+    ASSERT_EQ(static_cast<uint64_t>(4), summary.frameTimes.getCount());
+    ASSERT_EQ(static_cast<uint64_t>(3), summary.jankyFramesCount);
+    ASSERT_EQ(static_cast<uint64_t>(2), summary.jankyFramesByPhase[static_cast<size_t>(FramePhase::Layout)]);
+    ASSERT_EQ(static_cast<uint64_t>(1), summary.jankyFramesByPhase[static_cast<size_t>(FramePhase::JSRender)]);
+    ASSERT_EQ(static_cast<uint64_t>(0), summary.jankyFramesByPhase[static_cast<size_t>(FramePhase::Render)]);
+    ASSERT_EQ(static_cast<uint64_t>(3), summary.phaseTimes[static_cast<size_t>(FramePhase::Layout)].getCount());
+    ASSERT_EQ(static_cast<uint64_t>(0), summary.phaseTimes[static_cast<size_t>(FramePhase::Draw)].getCount());
+
+    // Nothing new to flush
+    aggregator.flush();
+    ASSERT_EQ(static_cast<size_t>(1), flushed.summaries.size());
+}
+
+TEST(FrameMetrics, flushesPeriodically) {
+    FrameMetricsAggregator aggregator(std::chrono::milliseconds(16), std::chrono::seconds(10));
+    FlushedSummaries flushed;
+    aggregator.setFlushCallback(flushed.makeCallback());
+
+    auto module = STRING_LITERAL("my_module");
+    auto start = std::chrono::steady_clock::now();
+
+    FrameTimings frame;
+    frame.add(FramePhase::Render, std::chrono::milliseconds(2));
+
+    aggregator.recordFrame(module, frame, start + std::chrono::seconds(1));
+    aggregator.recordFrame(module, frame, start + std::chrono::seconds(5));
+    ASSERT_TRUE(flushed.summaries.empty());
+
+    aggregator.recordFrame(module, frame, start + std::chrono::seconds(11));
+
+    ASSERT_EQ(static_cast<size_t>(1), flushed.summaries.size());
+    ASSERT_EQ(static_cast<uint64_t>(3), flushed.summaries[0].second.frameTimes.getCount());
+}
+
+TEST(FrameMetrics, doesNotRecordWhenDisabled) {
+    FrameMetricsAggregator aggregator;
+    ASSERT_FALSE(aggregator.isEnabled());
+
+    {
+        ScopedFrameMetrics frameMetrics(aggregator, STRING_LITERAL("my_module"), FramePhase::ViewTreeUpdate);
+        ScopedFramePhase phase(FramePhase::Layout);
+    }
+
+    FlushedSummaries flushed;
+    aggregator.setFlushCallback(flushed.makeCallback());
+    aggregator.flush();
+
+    ASSERT_TRUE(flushed.summaries.empty());
+}
+
+TEST(FrameMetrics, scopedPhasesOnlyCountTheirOwnTime) {
+    FrameMetricsAggregator aggregator(std::chrono::milliseconds(16), std::chrono::hours(1));
+    FlushedSummaries flushed;
+    aggregator.setFlushCallback(flushed.makeCallback());
+
+    {
+        ScopedFrameMetrics frameMetrics(aggregator, STRING_LITERAL("my_module"), FramePhase::ViewTreeUpdate);
+        ScopedFrameMetrics::addPhaseDuration(FramePhase::JSRender, std::chrono::milliseconds(30));
+
+        {
+            ScopedFramePhase render(FramePhase::Render);
+            {
+                ScopedFramePhase layout(FramePhase::Layout);
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        }
+
+        // Nested frames are merged into the outer frame
+        ScopedFrameMetrics nestedFrameMetrics(aggregator, STRING_LITERAL("other_module"), FramePhase::Draw);
+    }
+
+    // Phases outside of a frame are ignored
+    { ScopedFramePhase render(FramePhase::Render); }
+
+    aggregator.flush();
+
+    ASSERT_EQ(static_cast<size_t>(1), flushed.summaries.size());
+    ASSERT_EQ(STRING_LITERAL("my_module"), flushed.summaries[0].first);
+
+    const auto& summary = flushed.summaries[0].second;
+    ASSERT_EQ(static_cast<uint64_t>(1), summary.frameTimes.getCount());
+    ASSERT_EQ(static_cast<uint64_t>(1), summary.jankyFramesCount);
+    ASSERT_EQ(static_cast<uint64_t>(1), summary.jankyFramesByPhase[static_cast<size_t>(FramePhase::JSRender)]);
+
+    const auto& layoutTimes = summary.phaseTimes[static_cast<size_t>(FramePhase::Layout)];
+    const auto& renderTimes = summary.phaseTimes[static_cast<size_t>(FramePhase::Render)];
+    ASSERT_EQ(static_cast<uint64_t>(1), layoutTimes.getCount());
+    ASSERT_GE(layoutTimes.getMax(), std::chrono::milliseconds(5));
+    ASSERT_LT(renderTimes.getMax(), layoutTimes.getMin());
+    ASSERT_TRUE(summary.phaseTimes[static_cast<size_t>(FramePhase::Draw)].empty());
+}
+
+TEST(FrameMetrics, countsBridgeCrossingsOfFrames) {
+    FrameMetricsAggregator aggregator(std::chrono::milliseconds(16), std::chrono::hours(1));
+    FlushedSummaries flushed;
+    aggregator.setFlushCallback(flushed.makeCallback());
+
+    // Crossings made outside of a frame are ignored
+    { ScopedBridgeCrossing crossing(BridgeCrossingType::JSToNative); }
+
+    for (size_t i = 0; i < 2; i++) {
+        ScopedFrameMetrics frameMetrics(aggregator, STRING_LITERAL("my_module"), FramePhase::ViewTreeUpdate);
+        for (size_t j = 0; j <= i; j++) {
+            ScopedBridgeCrossing crossing(BridgeCrossingType::NativeToPlatform);
+        }
+
+        BridgeCrossings jsCrossings;
+        jsCrossings.counts[static_cast<size_t>(BridgeCrossingType::JSToNative)] = 3;
+        ScopedFrameMetrics::addBridgeCrossings(jsCrossings);
+    }
+
+    aggregator.flush();
+
+    ASSERT_EQ(static_cast<size_t>(1), flushed.summaries.size());
+    const auto& summary = flushed.summaries[0].second;
+    ASSERT_EQ(static_cast<uint64_t>(6), summary.bridgeCrossings.getCount(BridgeCrossingType::JSToNative));
+    ASSERT_EQ(static_cast<uint64_t>(0), summary.bridgeCrossings.getCount(BridgeCrossingType::NativeToJS));
+    ASSERT_EQ(static_cast<uint64_t>(3), summary.bridgeCrossings.getCount(BridgeCrossingType::NativeToPlatform));
+    ASSERT_EQ(static_cast<uint64_t>(5), summary.maxBridgeCrossingsPerFrame);
+}
+
+TEST(FrameMetrics, recordsGPUTimingsOfFrames) {
+    FrameMetricsAggregator aggregator(std::chrono::milliseconds(16), std::chrono::hours(1));
+    FlushedSummaries flushed;
+    aggregator.setFlushCallback(flushed.makeCallback());
+
+    auto module = STRING_LITERAL("my_module");
+    aggregator.recordFrame(module, FrameTimings());
+
+    GPUFrameTiming gpuBoundFrame;
+    gpuBoundFrame.gpuDuration = std::chrono::milliseconds(20);
+    gpuBoundFrame.presentLatency = std::chrono::milliseconds(30);
+    aggregator.recordGPUFrame(module, gpuBoundFrame);
+
+    GPUFrameTiming presentedFrame;
+    presentedFrame.presentLatency = std::chrono::milliseconds(10);
+    aggregator.recordGPUFrame(module, presentedFrame);
+
+    GPUFrameTiming fastFrame;
+    fastFrame.gpuDuration = std::chrono::milliseconds(2);
+    aggregator.recordGPUFrame(module, fastFrame);
+
+    aggregator.flush();
+
+    ASSERT_EQ(static_cast<size_t>(1), flushed.summaries.size());
+    const auto& summary = flushed.summaries[0].second;
+    ASSERT_EQ(static_cast<uint64_t>(2), summary.gpuTimes.getCount());
+    ASSERT_EQ(std::chrono::microseconds(20000), summary.gpuTimes.getMax());
+    ASSERT_EQ(static_cast<uint64_t>(2), summary.presentLatencies.getCount());
+    ASSERT_EQ(std::chrono::microseconds(10000), summary.presentLatencies.getMin());
+    ASSERT_EQ(static_cast<uint64_t>(1), summary.gpuBoundFramesCount);
+    // GPU bound frames are not janky unless their CPU time went over the budget as well
+    ASSERT_EQ(static_cast<uint64_t>(0), summary.jankyFramesCount);
+}
+
+class RecordedFrames : public IFrameMetricsObserver {
+public:
+    std::vector<std::pair<StringBox, FrameDuration>> frames;
+
+    void onFrameRecorded(const StringBox& module, const FrameTimings& timings) override {
+        frames.emplace_back(module, timings.getTotal());
+    }
+};
+
+TEST(FrameMetrics, notifiesObserverOfEachFrame) {
+    FrameMetricsAggregator aggregator(std::chrono::milliseconds(16), std::chrono::hours(1));
+    auto observer = makeShared<RecordedFrames>();
+    aggregator.setObserver(observer);
+    ASSERT_TRUE(aggregator.isEnabled());
+
+    auto module = STRING_LITERAL("my_module");
+    {
+        ScopedFrameMetrics frameMetrics(aggregator, module, FramePhase::ViewTreeUpdate);
+        ScopedFrameMetrics::addPhaseDuration(FramePhase::Raster, std::chrono::milliseconds(3));
+    }
+
+    ASSERT_EQ(static_cast<size_t>(1), observer->frames.size());
+    ASSERT_EQ(module, observer->frames[0].first);
+    ASSERT_GE(observer->frames[0].second, std::chrono::milliseconds(3));
+
+    // Summaries are only aggregated once a flush callback is set
+    FlushedSummaries flushed;
+    aggregator.setFlushCallback(flushed.makeCallback());
+    aggregator.flush();
+    ASSERT_TRUE(flushed.summaries.empty());
+
+    aggregator.recordFrame(module, FrameTimings());
+    aggregator.flush();
+    ASSERT_EQ(static_cast<size_t>(2), observer->frames.size());
+    ASSERT_EQ(static_cast<size_t>(1), flushed.summaries.size());
+
+    aggregator.setObserver(nullptr);
+    aggregator.setFlushCallback(FrameMetricsFlushCallback());
+    ASSERT_FALSE(aggregator.isEnabled());
+}
+
+} // namespace ValdiTest
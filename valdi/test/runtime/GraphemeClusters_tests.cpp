@@ -0,0 +1,62 @@
+#include "valdi_core/cpp/Text/GraphemeClusters.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static std::vector<bool> segment(std::initializer_list<uint32_t> unicodePoints, bool isEmoji) {
+    GraphemeClusterSegmenter segmenter;
+    std::vector<bool> output;
+
+    for (auto unicodePoint : unicodePoints) {
+        auto unicodePointClass = getGraphemeClusterClass(unicodePoint);
+        output.emplace_back(segmenter.continuesCluster(unicodePointClass));
+        segmenter.advance(unicodePointClass, isEmoji);
+    }
+
+    return output;
+}
+
+TEST(GraphemeClusters, canClassifyUnicodePoints) {
+    ASSERT_EQ(GraphemeClusterClass::Other, getGraphemeClusterClass('a'));
+    ASSERT_EQ(GraphemeClusterClass::CombiningMark, getGraphemeClusterClass(0x0301));
+    ASSERT_EQ(GraphemeClusterClass::ZeroWidthJoiner, getGraphemeClusterClass(0x200D));
+    ASSERT_EQ(GraphemeClusterClass::VariationSelector, getGraphemeClusterClass(0xFE0F));
+    ASSERT_EQ(GraphemeClusterClass::VariationSelector, getGraphemeClusterClass(0xE0100));
+    ASSERT_EQ(GraphemeClusterClass::RegionalIndicator, getGraphemeClusterClass(0x1F1FA));
+    ASSERT_EQ(GraphemeClusterClass::EmojiModifier, getGraphemeClusterClass(0x1F3FB));
+    ASSERT_EQ(GraphemeClusterClass::Other, getGraphemeClusterClass(0x1F600));
+    ASSERT_EQ(GraphemeClusterClass::Other, getGraphemeClusterClass(0xE01F0));
+}
+
+TEST(GraphemeClusters, canSegmentUnicodePoints) {
+    ASSERT_EQ(std::vector<bool>({false, false, false}), segment({'a', 'b', 'c'}, false));
+    // Combining marks and variation selectors extend the previous unicode point
+    ASSERT_EQ(std::vector<bool>({false, true, false}), segment({'e', 0x0301, 'a'}, false));
+    ASSERT_EQ(std::vector<bool>({false, true}), segment({0x2764, 0xFE0F}, false));
+    // Joiners glue both sides
+    ASSERT_EQ(std::vector<bool>({false, true, true, false}), segment({0x1F468, 0x200D, 0x1F469, 'a'}, false));
+    // Regional indicators only pair together
+    ASSERT_EQ(std::vector<bool>({false, true, false}), segment({0x1F1FA, 0x1F1F8, 'a'}, false));
+    ASSERT_EQ(std::vector<bool>({false, false}), segment({'a', 0x1F1FA}, false));
+    // The first unicode point never continues a cluster
+    ASSERT_EQ(std::vector<bool>({false, true}), segment({0x0301, 0x0301}, false));
+}
+
+TEST(GraphemeClusters, emojiModifiersOnlyExtendEmojis) {
+    ASSERT_EQ(std::vector<bool>({false, false}), segment({0x1F44B, 0x1F3FD}, false));
+    ASSERT_EQ(std::vector<bool>({false, true}), segment({0x1F44B, 0x1F3FD}, true));
+}
+
+TEST(GraphemeClusters, canResetSegmenter) {
+    GraphemeClusterSegmenter segmenter;
+    segmenter.advance(GraphemeClusterClass::ZeroWidthJoiner, false);
+    ASSERT_TRUE(segmenter.continuesCluster(GraphemeClusterClass::Other));
+
+    segmenter.reset();
+    ASSERT_FALSE(segmenter.continuesCluster(GraphemeClusterClass::Other));
+    ASSERT_FALSE(segmenter.continuesCluster(GraphemeClusterClass::CombiningMark));
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,44 @@
+#include "valdi_core/cpp/Utils/HexCodec.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static std::optional<std::string> decode(std::string_view str) {
+    Bytes output;
+    if (!HexCodec::decode(str, output)) {
+        return std::nullopt;
+    }
+    return std::string(reinterpret_cast<const char*>(output.data()), output.size());
+}
+
+TEST(HexCodec, canEncode) {
+    std::vector<Byte> bytes;
+    std::string expected;
+    for (size_t i = 0; i < 256; i++) {
+        bytes.emplace_back(static_cast<Byte>(i));
+        expected += "0123456789abcdef"[i >> 4];
+        expected += "0123456789abcdef"[i & 0x0F];
+    }
+
+    // Exercise all the lengths around the vectorized block size
+    for (size_t size = 0; size < bytes.size(); size++) {
+        ASSERT_EQ(expected.substr(0, size * 2), HexCodec::encode(bytes.data(), size));
+    }
+}
+
+TEST(HexCodec, canDecode) {
+    ASSERT_EQ("", decode(""));
+    ASSERT_EQ(std::string("\xf4\x2d"), decode("f42d"));
+    ASSERT_EQ(std::string("\xf4\x2d"), decode("F42D"));
+    ASSERT_EQ(std::string("\x0a\x00\x10\xf0", 4), decode("0a0010f0"));
+}
+
+TEST(HexCodec, failsOnInvalidInput) {
+    ASSERT_FALSE(decode("f42"));
+    ASSERT_FALSE(decode("f4g2"));
+    ASSERT_FALSE(decode("f4 2"));
+}
+
+} // namespace ValdiTest
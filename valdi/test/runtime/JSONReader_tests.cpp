@@ -0,0 +1,54 @@
+#include "valdi_core/cpp/Utils/JSONReader.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+TEST(JSONReader, parsesUnescapedStringsWithoutCopy) {
+    std::string_view input = R"(["a string long enough to be scanned by words", ""])";
+    JSONReader reader(input);
+
+    std::string_view str;
+    bool isInInput = false;
+    ASSERT_TRUE(reader.parseBeginArray());
+    ASSERT_TRUE(reader.parseStringView(str, isInInput));
+    ASSERT_EQ("a string long enough to be scanned by words", str);
+    ASSERT_TRUE(isInInput);
+    ASSERT_TRUE(str.data() >= input.data() && str.data() < input.data() + input.size());
+
+    ASSERT_TRUE(reader.parseComma());
+    ASSERT_TRUE(reader.parseStringView(str, isInInput));
+    ASSERT_EQ("", str);
+    ASSERT_TRUE(reader.parseEndArray());
+    ASSERT_TRUE(reader.ensureIsAtEnd());
+}
+
+TEST(JSONReader, decodesEscapedStrings) {
+    std::string_view input = R"(["escaped \"quotes\" and \\ backslashes \u00e9" , "\\"])";
+    JSONReader reader(input);
+
+    std::string_view str;
+    bool isInInput = true;
+    ASSERT_TRUE(reader.parseBeginArray());
+    ASSERT_TRUE(reader.parseStringView(str, isInInput));
+    ASSERT_EQ("escaped \"quotes\" and \\ backslashes \xC3\xA9", str);
+    ASSERT_FALSE(isInInput);
+
+    ASSERT_TRUE(reader.parseComma());
+    std::string decoded;
+    ASSERT_TRUE(reader.parseString(decoded));
+    ASSERT_EQ("\\", decoded);
+    ASSERT_TRUE(reader.parseEndArray());
+}
+
+TEST(JSONReader, failsOnUnterminatedStrings) {
+    JSONReader reader(R"("an unterminated string \")");
+
+    std::string_view str;
+    bool isInInput;
+    ASSERT_FALSE(reader.parseStringView(str, isInInput));
+    ASSERT_TRUE(reader.hasError());
+}
+
+} // namespace ValdiTest
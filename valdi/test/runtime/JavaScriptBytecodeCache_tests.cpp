@@ -0,0 +1,142 @@
+#include "valdi/runtime/Interfaces/IJavaScriptBridge.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptBytecodeCache.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptUtils.hpp"
+
+#include "valdi/standalone_runtime/InMemoryDiskCache.hpp"
+
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <fmt/format.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static BytesView makeData(std::string_view str) {
+    return makeShared<ByteBuffer>(str)->toBytesView();
+}
+
+class PreCompilingJavaScriptBridge : public IJavaScriptBridge {
+public:
+    const char* getName() override {
+        return "PreCompiling";
+    }
+
+    Ref<IJavaScriptContext> createJsContext(JavaScriptTaskScheduler* /*taskScheduler*/,
+                                            ILogger& /*logger*/) override {
+        return nullptr;
+    }
+
+    BytesView dumpHeap(std::span<IJavaScriptContext*> /*jsContexts*/, JSExceptionTracker& exceptionTracker) override {
+        exceptionTracker.onError("Not supported");
+        return BytesView();
+    }
+
+    bool supportsBackgroundPreCompilation() override {
+        return true;
+    }
+
+    Result<BytesView> preCompile(const std::string_view& script, const std::string_view& /*sourceFilename*/) override {
+        preCompileCount++;
+        auto bytecode = fmt::format("compiled {}", script);
+        return makePreCompiledJsModule(reinterpret_cast<const Byte*>(bytecode.data()), bytecode.size());
+    }
+
+    size_t preCompileCount = 0;
+};
+
+struct JavaScriptBytecodeCacheDependencies {
+    Ref<DispatchQueue> dispatchQueue;
+    Ref<InMemoryDiskCache> diskCache;
+    Ref<JavaScriptBytecodeCache> bytecodeCache;
+
+    JavaScriptBytecodeCacheDependencies()
+        : dispatchQueue(DispatchQueue::create(STRING_LITERAL("JavaScriptBytecodeCache"), ThreadQoSClassMax)),
+          diskCache(makeShared<InMemoryDiskCache>()),
+          bytecodeCache(makeShared<JavaScriptBytecodeCache>(diskCache, dispatchQueue, ConsoleLogger::getLogger())) {}
+
+    ~JavaScriptBytecodeCacheDependencies() {
+        dispatchQueue->fullTeardown();
+    }
+
+    void flush() const {
+        dispatchQueue->sync([]() {});
+    }
+};
+
+TEST(JavaScriptBytecodeCache, canLoadStoredBytecode) {
+    JavaScriptBytecodeCacheDependencies dependencies;
+    auto importPath = STRING_LITERAL("valdi_core/src/Init");
+    auto sourceHash = JavaScriptBytecodeCache::computeSourceHash(makeData("module.exports = 42;"));
+
+    ASSERT_FALSE(dependencies.bytecodeCache->load(importPath, sourceHash).has_value());
+
+    dependencies.bytecodeCache->store(importPath, sourceHash, makeData("bytecode"));
+    dependencies.flush();
+
+    auto bytecode = dependencies.bytecodeCache->load(importPath, sourceHash);
+
+    ASSERT_TRUE(bytecode.has_value());
+    ASSERT_EQ("bytecode", bytecode.value().asStringView());
+}
+
+TEST(JavaScriptBytecodeCache, ignoresBytecodeOfDifferentSource) {
+    JavaScriptBytecodeCacheDependencies dependencies;
+    auto importPath = STRING_LITERAL("valdi_core/src/Init");
+    auto sourceHash = JavaScriptBytecodeCache::computeSourceHash(makeData("module.exports = 42;"));
+    auto newSourceHash = JavaScriptBytecodeCache::computeSourceHash(makeData("module.exports = 43;"));
+
+    dependencies.bytecodeCache->store(importPath, sourceHash, makeData("bytecode"));
+    dependencies.flush();
+
+    ASSERT_FALSE(dependencies.bytecodeCache->load(importPath, newSourceHash).has_value());
+
+    // The new bytecode replaces the stale one
+    dependencies.bytecodeCache->store(importPath, newSourceHash, makeData("new bytecode"));
+    dependencies.flush();
+
+    ASSERT_FALSE(dependencies.bytecodeCache->load(importPath, sourceHash).has_value());
+    auto bytecode = dependencies.bytecodeCache->load(importPath, newSourceHash);
+    ASSERT_TRUE(bytecode.has_value());
+    ASSERT_EQ("new bytecode", bytecode.value().asStringView());
+}
+
+TEST(JavaScriptBytecodeCache, canRemoveBytecode) {
+    JavaScriptBytecodeCacheDependencies dependencies;
+    auto importPath = STRING_LITERAL("valdi_core/src/Init");
+    auto sourceHash = JavaScriptBytecodeCache::computeSourceHash(makeData("module.exports = 42;"));
+
+    dependencies.bytecodeCache->store(importPath, sourceHash, makeData("bytecode"));
+    dependencies.bytecodeCache->remove(importPath);
+    dependencies.flush();
+
+    ASSERT_FALSE(dependencies.bytecodeCache->load(importPath, sourceHash).has_value());
+}
+
+TEST(JavaScriptBytecodeCache, canPreCompileInBackground) {
+    JavaScriptBytecodeCacheDependencies dependencies;
+    PreCompilingJavaScriptBridge jsBridge;
+    auto importPath = STRING_LITERAL("my_module/src/MyModule");
+    auto source = makeData("module.exports = 42;");
+    auto sourceHash = JavaScriptBytecodeCache::computeSourceHash(source);
+
+    dependencies.bytecodeCache->preCompileInBackground(jsBridge, importPath, source);
+    dependencies.flush();
+
+    auto bytecode = dependencies.bytecodeCache->load(importPath, sourceHash);
+    ASSERT_TRUE(bytecode.has_value());
+    ASSERT_EQ("compiled module.exports = 42;", bytecode.value().asStringView());
+
+    // Modules which already have bytecode for the same source are not compiled again
+    dependencies.bytecodeCache->preCompileInBackground(jsBridge, importPath, source);
+    dependencies.flush();
+
+    ASSERT_EQ(static_cast<size_t>(1), jsBridge.preCompileCount);
+}
+
+} // namespace ValdiTest
@@ -6,6 +6,7 @@
 //
 
 #include "valdi/runtime/JavaScript/JavaScriptHeapDumpBuilder.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptHeapDumpOutputStream.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/ValueUtils.hpp"
 #include <gtest/gtest.h>
@@ -124,6 +125,68 @@ TEST(JavaScriptHeapDumpBuilder, canBuildHeapDump) {
     ASSERT_EQ(expectedJSONValue.value(), result.value());
 }
 
+class ChunkRecordingOutputStream : public JavaScriptHeapDumpBufferOutputStream {
+public:
+    Result<Void> write(const Byte* data, size_t length) override {
+        chunksCount++;
+        return JavaScriptHeapDumpBufferOutputStream::write(data, length);
+    }
+
+    Result<Void> finish() override {
+        finished = true;
+        return Void();
+    }
+
+    size_t chunksCount = 0;
+    bool finished = false;
+};
+
+static void populateSmallHeapDump(JavaScriptHeapDumpBuilder& builder) {
+    builder.beginNode(JavaScriptHeapDumpNodeType::SYNTHETIC, STRING_LITERAL("(GC roots)"), 1, 0);
+    builder.appendEdge(JavaScriptHeapDumpEdgeType::ELEMENT, JavaScriptHeapEdgeIdentifier::indexed(0), 2);
+    builder.appendEdge(JavaScriptHeapDumpEdgeType::ELEMENT, JavaScriptHeapEdgeIdentifier::indexed(1), 3);
+    builder.beginNode(JavaScriptHeapDumpNodeType::OBJECT, STRING_LITERAL("Object"), 2, 40);
+    builder.beginNode(JavaScriptHeapDumpNodeType::OBJECT, STRING_LITERAL("Object"), 3, 24);
+    builder.appendEdge(
+        JavaScriptHeapDumpEdgeType::PROPERTY, JavaScriptHeapEdgeIdentifier::named(STRING_LITERAL("items")), 4);
+    builder.beginNode(JavaScriptHeapDumpNodeType::ARRAY, STRING_LITERAL("Array"), 4, 100);
+}
+
+TEST(JavaScriptHeapDumpBuilder, canWriteHeapDumpInChunks) {
+    JavaScriptHeapDumpBuilder builder;
+    populateSmallHeapDump(builder);
+
+    ChunkRecordingOutputStream output;
+    auto result = builder.write(output, 16);
+    ASSERT_TRUE(result) << result.description();
+
+    ASSERT_TRUE(output.finished);
+    ASSERT_TRUE(output.chunksCount > 1);
+
+    auto expectedDump = builder.build();
+    auto chunkedDump = output.getBytes();
+
+    ASSERT_EQ(std::string_view(reinterpret_cast<const char*>(expectedDump.data()), expectedDump.size()),
+              std::string_view(reinterpret_cast<const char*>(chunkedDump.data()), chunkedDump.size()));
+}
+
+TEST(JavaScriptHeapDumpBuilder, canBuildHeapDumpSummary) {
+    JavaScriptHeapDumpBuilder builder;
+    populateSmallHeapDump(builder);
+
+    auto summary = builder.buildSummary(2);
+    auto result = jsonToValue(summary.data(), summary.size());
+    ASSERT_TRUE(result) << result.description();
+
+    std::string_view expectedJSON =
+        R"({"node_count":4,"edge_count":3,"total_self_size":164,"histogram":[{"type":"array","name":"Array","count":1,"self_size":100},{"type":"object","name":"Object","count":2,"self_size":64}],"roots":[{"name":"(GC roots)","edge_count":2}]})";
+
+    auto expectedJSONValue = jsonToValue(expectedJSON);
+    ASSERT_TRUE(expectedJSONValue) << expectedJSONValue.description();
+
+    ASSERT_EQ(expectedJSONValue.value(), result.value());
+}
+
 TEST(JavaScriptHeapDumpBuilder, canMergeHeapDumps) {
     // Build first heap dump
     BytesView heapDump1;
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "valdi/runtime/Exception.hpp"
+#include "valdi/runtime/JavaScript/JavaScriptSamplingProfiler.hpp"
+#include "valdi/runtime/Utils/AsyncGroup.hpp"
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+class TestSamplingProfilerListener : public IJavaScriptSamplingProfilerListener {
+public:
+    explicit TestSamplingProfilerListener(JavaScriptSamplingProfiler& profiler) : _profiler(profiler) {}
+
+    void onSampleRequested() override {
+        _profiler.addSample(nullptr, "    at render (MyComponent.js:12:4)\n    at <anonymous> (Init.js:3:1)\n");
+    }
+
+    void onProfileFlushed(const JavaScriptSamplingProfile& profile) override {
+        if (!flushedProfile.has_value()) {
+            flushedProfile = profile;
+            flushGroup->leave();
+        }
+    }
+
+    Ref<AsyncGroup> flushGroup = makeShared<AsyncGroup>();
+    std::optional<JavaScriptSamplingProfile> flushedProfile;
+
+private:
+    JavaScriptSamplingProfiler& _profiler;
+};
+
+TEST(JavaScriptSamplingProfiler, foldsStackTraceFromRootFrame) {
+    auto folded = JavaScriptSamplingProfiler::foldStackTrace(
+        "Error\n    at inner (file.js:10:2)\n    at outer (other.js:4:12)\n    at <anonymous>\n");
+
+    ASSERT_EQ("<anonymous>;outer (other.js);inner (file.js)", folded);
+}
+
+TEST(JavaScriptSamplingProfiler, aggregatesSamples) {
+    auto profiler = makeShared<JavaScriptSamplingProfiler>();
+
+    profiler->addSample(nullptr, "    at a (a.js:1)\n    at b (b.js:2)");
+    profiler->addSample(nullptr, "    at a (a.js:3)\n    at b (b.js:2)");
+    profiler->addSample(nullptr, "    at b (b.js:2)");
+    profiler->addSample(nullptr, "");
+
+    auto profile = profiler->flush();
+
+    ASSERT_EQ(static_cast<size_t>(4), profile.samplesCount);
+    ASSERT_EQ("<unattributed> 1\n<unattributed>;b (b.js) 1\n<unattributed>;b (b.js);a (a.js) 2\n",
+              profile.toFoldedString());
+
+    ASSERT_EQ(static_cast<size_t>(0), profiler->flush().samplesCount);
+}
+
+TEST(JavaScriptSamplingProfiler, flushesSamplesToListener) {
+    auto profiler = makeShared<JavaScriptSamplingProfiler>();
+    TestSamplingProfilerListener listener(*profiler);
+    listener.flushGroup->enter();
+
+    profiler->setListener(&listener);
+    profiler->start(std::chrono::milliseconds(1), std::chrono::milliseconds(5));
+
+    if (!listener.flushGroup->blockingWaitWithTimeout(std::chrono::seconds(5))) {
+        throw Exception("Failed to wait for profile flush");
+    }
+
+    profiler->stop();
+    profiler->setListener(nullptr);
+
+    ASSERT_TRUE(listener.flushedProfile.has_value());
+    ASSERT_TRUE(listener.flushedProfile->samplesCount > 0);
+    ASSERT_EQ(static_cast<size_t>(1), listener.flushedProfile->foldedStacks.size());
+    ASSERT_EQ("<unattributed>;<anonymous> (Init.js);render (MyComponent.js)",
+              listener.flushedProfile->foldedStacks[0].first);
+}
+
+} // namespace ValdiTest
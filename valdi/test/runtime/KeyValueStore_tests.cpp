@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "valdi/runtime/Resources/KeyValueStore.hpp"
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static BytesView makeData(std::string_view str) {
+    return makeShared<ByteBuffer>(str)->toBytesView();
+}
+
+TEST(KeyValueStore, replaysChangesOnSnapshot) {
+    KeyValueStore store;
+    store.setMaxWeight(0);
+    store.store(STRING_LITERAL("item1"), makeData("Hello"), 0, 0);
+    auto snapshot = store.serialize().moveValue();
+
+    ASSERT_FALSE(store.hasChanges());
+
+    store.store(STRING_LITERAL("item2"), makeData("World"), 0, 0);
+    store.remove(STRING_LITERAL("item1"));
+    ASSERT_TRUE(store.hasChanges());
+    auto changes = store.serializeChanges().moveValue();
+
+    ASSERT_FALSE(store.hasChanges());
+
+    KeyValueStore restoredStore;
+    restoredStore.setMaxWeight(0);
+    ASSERT_TRUE(restoredStore.populate(snapshot));
+    auto result = restoredStore.populateChanges(changes);
+    ASSERT_TRUE(result) << result.description();
+
+    ASSERT_EQ(store.getMutationId(), restoredStore.getMutationId());
+    ASSERT_FALSE(restoredStore.exists(STRING_LITERAL("item1")));
+    ASSERT_EQ("World", restoredStore.fetch(STRING_LITERAL("item2")).value().asStringView());
+}
+
+TEST(KeyValueStore, ignoresChangesOlderThanSnapshot) {
+    KeyValueStore store;
+    store.setMaxWeight(0);
+    store.store(STRING_LITERAL("item1"), makeData("Hello"), 0, 0);
+    auto changes = store.serializeChanges().moveValue();
+
+    store.remove(STRING_LITERAL("item1"));
+    auto snapshot = store.serialize().moveValue();
+
+    KeyValueStore restoredStore;
+    restoredStore.setMaxWeight(0);
+    ASSERT_TRUE(restoredStore.populate(snapshot));
+    ASSERT_TRUE(restoredStore.populateChanges(changes));
+
+    // The changes were written before the snapshot, they should not bring back the removed item
+    ASSERT_FALSE(restoredStore.exists(STRING_LITERAL("item1")));
+}
+
+TEST(KeyValueStore, requiresSerializeAfterRemoveAll) {
+    KeyValueStore store;
+    store.setMaxWeight(0);
+    store.store(STRING_LITERAL("item1"), makeData("Hello"), 0, 0);
+    store.serializeChanges();
+
+    store.removeAll();
+    ASSERT_TRUE(store.requiresSerialize());
+
+    store.serialize();
+    ASSERT_FALSE(store.requiresSerialize());
+    ASSERT_FALSE(store.hasChanges());
+}
+
+} // namespace ValdiTest
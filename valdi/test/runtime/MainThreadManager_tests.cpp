@@ -0,0 +1,161 @@
+#include "valdi/runtime/Context/Context.hpp"
+#include "valdi/runtime/Utils/MainThreadManager.hpp"
+#include "valdi_core/cpp/Utils/ValueFunctionWithCallable.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+class ManualMainThreadDispatcher : public IMainThreadDispatcher {
+public:
+    void dispatch(DispatchFunction* function, bool sync) override {
+        if (sync) {
+            (*function)();
+            delete function;
+        } else {
+            _functions.emplace_back(function);
+        }
+    }
+
+    // Run the functions which were dispatched before this call, like a main thread tick would
+    size_t runTick() {
+        auto functions = std::move(_functions);
+        _functions.clear();
+        for (auto* function : functions) {
+            (*function)();
+            delete function;
+        }
+        return functions.size();
+    }
+
+    void runUntilIdle() {
+        while (runTick() > 0) {
+        }
+    }
+
+private:
+    std::vector<DispatchFunction*> _functions;
+};
+
+struct MainThreadManagerWrapper {
+    Ref<ManualMainThreadDispatcher> dispatcher;
+    Ref<MainThreadManager> mainThreadManager;
+    std::vector<std::string> events;
+
+    MainThreadManagerWrapper()
+        : dispatcher(makeShared<ManualMainThreadDispatcher>()),
+          mainThreadManager(makeShared<MainThreadManager>(dispatcher)) {}
+
+    ~MainThreadManagerWrapper() {
+        mainThreadManager->clearAndTeardown();
+    }
+
+    void dispatch(const Ref<Context>& context, std::string event, MainThreadTaskPriority priority) {
+        mainThreadManager->dispatch(
+            context, [this, event = std::move(event)]() { events.emplace_back(event); }, priority);
+    }
+};
+
+TEST(MainThreadManager, runsTasksInOrderWithinBudget) {
+    MainThreadManagerWrapper wrapper;
+
+    wrapper.dispatch(nullptr, "a", MainThreadTaskPriority::Normal);
+    wrapper.dispatch(nullptr, "b", MainThreadTaskPriority::Low);
+    wrapper.dispatch(nullptr, "c", MainThreadTaskPriority::Normal);
+
+    wrapper.dispatcher->runTick();
+
+    ASSERT_EQ(std::vector<std::string>({"a", "b", "c"}), wrapper.events);
+}
+
+TEST(MainThreadManager, postponesLowPriorityTasksWhenOverBudget) {
+    MainThreadManagerWrapper wrapper;
+    wrapper.mainThreadManager->setFlushBudget(std::chrono::steady_clock::duration::zero());
+
+    {
+        auto batch = wrapper.mainThreadManager->scopedBatch();
+        MainThreadBatchAllowScope allowScope;
+        wrapper.dispatch(nullptr, "low1", MainThreadTaskPriority::Low);
+        wrapper.dispatch(nullptr, "normal1", MainThreadTaskPriority::Normal);
+        wrapper.dispatch(nullptr, "low2", MainThreadTaskPriority::Low);
+    }
+
+    // Batches are flushed as a whole
+    ASSERT_EQ(std::vector<std::string>({"low1", "normal1", "low2"}), wrapper.events);
+    wrapper.events.clear();
+
+    wrapper.dispatch(nullptr, "low3", MainThreadTaskPriority::Low);
+    wrapper.dispatch(nullptr, "normal2", MainThreadTaskPriority::Normal);
+    wrapper.dispatch(nullptr, "low4", MainThreadTaskPriority::Low);
+    wrapper.dispatch(nullptr, "normal3", MainThreadTaskPriority::Normal);
+
+    wrapper.dispatcher->runTick();
+
+    // The flush was over budget from the start, only the normal tasks ran
+    ASSERT_EQ(std::vector<std::string>({"normal2", "normal3"}), wrapper.events);
+
+    wrapper.dispatcher->runUntilIdle();
+
+    ASSERT_EQ(std::vector<std::string>({"normal2", "normal3", "low3", "low4"}), wrapper.events);
+}
+
+TEST(MainThreadManager, keepsLowPriorityTasksInOrderWhilePostponed) {
+    MainThreadManagerWrapper wrapper;
+    wrapper.mainThreadManager->setFlushBudget(std::chrono::steady_clock::duration::zero());
+
+    wrapper.dispatch(nullptr, "low1", MainThreadTaskPriority::Low);
+    wrapper.dispatcher->runTick();
+    ASSERT_TRUE(wrapper.events.empty());
+
+    wrapper.mainThreadManager->setFlushBudget(std::chrono::hours(1));
+    wrapper.dispatch(nullptr, "low2", MainThreadTaskPriority::Low);
+    wrapper.dispatcher->runUntilIdle();
+
+    ASSERT_EQ(std::vector<std::string>({"low1", "low2"}), wrapper.events);
+}
+
+TEST(MainThreadManager, interleavesPostponedTasksOfContexts) {
+    MainThreadManagerWrapper wrapper;
+    wrapper.mainThreadManager->setFlushBudget(std::chrono::steady_clock::duration::zero());
+
+    auto context1 = makeShared<Context>(1, nullptr);
+    auto context2 = makeShared<Context>(2, nullptr);
+
+    wrapper.dispatch(context1, "1a", MainThreadTaskPriority::Low);
+    wrapper.dispatch(context1, "1b", MainThreadTaskPriority::Low);
+    wrapper.dispatch(context1, "1c", MainThreadTaskPriority::Low);
+    wrapper.dispatch(context2, "2a", MainThreadTaskPriority::Low);
+    wrapper.dispatch(context2, "2b", MainThreadTaskPriority::Low);
+
+    // Postpones all the tasks
+    wrapper.dispatcher->runTick();
+    ASSERT_TRUE(wrapper.events.empty());
+
+    // Each postponed flush runs a single task, since the budget is zero
+    wrapper.dispatcher->runUntilIdle();
+
+    ASSERT_EQ(std::vector<std::string>({"1a", "2a", "1b", "2b", "1c"}), wrapper.events);
+}
+
+TEST(MainThreadManager, runsIdleCallbacksOnlyWithoutPostponedTasks) {
+    MainThreadManagerWrapper wrapper;
+    wrapper.mainThreadManager->setFlushBudget(std::chrono::steady_clock::duration::zero());
+
+    wrapper.dispatch(nullptr, "low1", MainThreadTaskPriority::Low);
+    wrapper.dispatch(nullptr, "low2", MainThreadTaskPriority::Low);
+    wrapper.dispatcher->runTick();
+
+    wrapper.mainThreadManager->onIdle(makeShared<ValueFunctionWithCallable>([&](const ValueFunctionCallContext&) {
+        wrapper.events.emplace_back("idle");
+        return Value::undefined();
+    }));
+
+    wrapper.dispatcher->runUntilIdle();
+
+    ASSERT_EQ(std::vector<std::string>({"low1", "low2", "idle"}), wrapper.events);
+}
+
+} // namespace ValdiTest
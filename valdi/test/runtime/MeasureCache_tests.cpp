@@ -0,0 +1,98 @@
+#include "valdi/runtime/Views/MeasureCache.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static Ref<ValueMap> makeAttributes(const char* text, double fontSize) {
+    auto attributes = makeShared<ValueMap>();
+    (*attributes)[STRING_LITERAL("value")] = Value(StringCache::getGlobal().makeString(std::string_view(text)));
+    (*attributes)[STRING_LITERAL("fontSize")] = Value(fontSize);
+    return attributes;
+}
+
+static MeasureCacheKey makeKey(
+    const Ref<ValueMap>& attributes, float width, MeasureMode widthMode, float height, MeasureMode heightMode) {
+    return MeasureCacheKey(
+        attributes, MeasureCacheKey::hashAttributes(*attributes), width, widthMode, height, heightMode, false);
+}
+
+TEST(MeasureCache, returnsSizeForIdenticalAttributes) {
+    MeasureCache cache(16);
+
+    cache.insert(makeKey(makeAttributes("Hello", 12), 100, MeasureModeAtMost, 0, MeasureModeUnspecified),
+                 Size(42, 16));
+
+    // Different map instance with the same content
+    auto result = cache.find(makeKey(makeAttributes("Hello", 12), 100, MeasureModeAtMost, 0, MeasureModeUnspecified));
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(Size(42, 16), result.value());
+
+    ASSERT_FALSE(
+        cache.find(makeKey(makeAttributes("Hello", 14), 100, MeasureModeAtMost, 0, MeasureModeUnspecified))
+            .has_value());
+    ASSERT_FALSE(
+        cache.find(makeKey(makeAttributes("World", 12), 100, MeasureModeAtMost, 0, MeasureModeUnspecified))
+            .has_value());
+}
+
+TEST(MeasureCache, keysOnConstraints) {
+    MeasureCache cache(16);
+    auto attributes = makeAttributes("Hello", 12);
+
+    cache.insert(makeKey(attributes, 100, MeasureModeAtMost, 0, MeasureModeUnspecified), Size(42, 16));
+
+    ASSERT_FALSE(cache.find(makeKey(attributes, 50, MeasureModeAtMost, 0, MeasureModeUnspecified)).has_value());
+    ASSERT_FALSE(cache.find(makeKey(attributes, 100, MeasureModeExactly, 0, MeasureModeUnspecified)).has_value());
+    // The height is ignored when unspecified
+    ASSERT_TRUE(cache.find(makeKey(attributes, 100, MeasureModeAtMost, NAN, MeasureModeUnspecified)).has_value());
+}
+
+TEST(MeasureCache, hashIsIndependentFromInsertionOrder) {
+    auto attributes1 = makeShared<ValueMap>();
+    (*attributes1)[STRING_LITERAL("a")] = Value(1.0);
+    (*attributes1)[STRING_LITERAL("b")] = Value(2.0);
+
+    auto attributes2 = makeShared<ValueMap>();
+    (*attributes2)[STRING_LITERAL("b")] = Value(2.0);
+    (*attributes2)[STRING_LITERAL("a")] = Value(1.0);
+
+    ASSERT_EQ(MeasureCacheKey::hashAttributes(*attributes1), MeasureCacheKey::hashAttributes(*attributes2));
+}
+
+TEST(MeasureCache, canRemoveAllConstraintsForAttributes) {
+    MeasureCache cache(16);
+
+    cache.insert(makeKey(makeAttributes("Hello", 12), 100, MeasureModeAtMost, 0, MeasureModeUnspecified),
+                 Size(42, 16));
+    cache.insert(makeKey(makeAttributes("Hello", 12), 20, MeasureModeAtMost, 0, MeasureModeUnspecified),
+                 Size(20, 32));
+    cache.insert(makeKey(makeAttributes("World", 12), 100, MeasureModeAtMost, 0, MeasureModeUnspecified),
+                 Size(44, 16));
+
+    cache.remove(makeAttributes("Hello", 12));
+
+    ASSERT_EQ(static_cast<size_t>(1), cache.size());
+    ASSERT_TRUE(
+        cache.find(makeKey(makeAttributes("World", 12), 100, MeasureModeAtMost, 0, MeasureModeUnspecified))
+            .has_value());
+}
+
+TEST(MeasureCache, evictsLeastRecentlyUsed) {
+    MeasureCache cache(2);
+    auto attributes = makeAttributes("Hello", 12);
+
+    cache.insert(makeKey(attributes, 1, MeasureModeExactly, 1, MeasureModeExactly), Size(1, 1));
+    cache.insert(makeKey(attributes, 2, MeasureModeExactly, 2, MeasureModeExactly), Size(2, 2));
+    ASSERT_TRUE(cache.find(makeKey(attributes, 1, MeasureModeExactly, 1, MeasureModeExactly)).has_value());
+    cache.insert(makeKey(attributes, 3, MeasureModeExactly, 3, MeasureModeExactly), Size(3, 3));
+
+    ASSERT_TRUE(cache.find(makeKey(attributes, 1, MeasureModeExactly, 1, MeasureModeExactly)).has_value());
+    ASSERT_FALSE(cache.find(makeKey(attributes, 2, MeasureModeExactly, 2, MeasureModeExactly)).has_value());
+    ASSERT_TRUE(cache.find(makeKey(attributes, 3, MeasureModeExactly, 3, MeasureModeExactly)).has_value());
+}
+
+} // namespace ValdiTest
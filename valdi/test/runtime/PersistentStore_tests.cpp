@@ -455,6 +455,139 @@ TEST(PersistentStore, restoredCacheSupportsEviction) {
     ASSERT_EQ(STRING_LITERAL("item4"), entries[1].first);
 }
 
+static Ref<PersistentStore> makeUnencryptedStore(PersistentStoreDependencies& dependencies) {
+    auto store = Valdi::makeShared<PersistentStore>(STRING_LITERAL("somepath"),
+                                                    dependencies.diskCache,
+                                                    nullptr,
+                                                    nullptr,
+                                                    dependencies.dispatchQueue,
+                                                    dependencies.logger,
+                                                    0,
+                                                    true);
+    store->populate();
+    dependencies.dispatchQueue->sync([]() {});
+    return store;
+}
+
+static std::vector<std::pair<StringBox, KeyValueStoreEntry>> fetchAllEntries(const Ref<PersistentStore>& store) {
+    SharedAtomic<std::vector<std::pair<StringBox, KeyValueStoreEntry>>> result;
+    AsyncGroup group;
+
+    group.enter();
+    store->fetchAll([&](const auto& entries) {
+        result.set(entries);
+        group.leave();
+    });
+
+    group.blockingWaitWithTimeout(std::chrono::seconds(5));
+
+    return result.get();
+}
+
+TEST(PersistentStore, appendsChangesAfterSnapshot) {
+    PersistentStoreDependencies dependencies;
+    auto store = makeUnencryptedStore(dependencies);
+
+    store->store(STRING_LITERAL("item1"), makeShared<ByteBuffer>("Hello")->toBytesView(), 0, 0, [](const auto&) {});
+    dependencies.dispatchQueue->sync([]() {});
+
+    auto snapshot = dependencies.diskCache->load(Path("global/somepath"));
+    ASSERT_TRUE(snapshot) << snapshot.description();
+
+    store->store(STRING_LITERAL("item2"), makeShared<ByteBuffer>("World")->toBytesView(), 0, 0, [](const auto&) {});
+    store->remove(STRING_LITERAL("item1"), [](const auto&) {});
+    dependencies.dispatchQueue->sync([]() {});
+
+    // The snapshot should be left untouched, the changes are appended to the log
+    ASSERT_EQ(snapshot.value(), dependencies.diskCache->load(Path("global/somepath")).value());
+    ASSERT_TRUE(dependencies.diskCache->exists(Path("global/somepath.0.log")));
+    ASSERT_TRUE(dependencies.diskCache->exists(Path("global/somepath.1.log")));
+
+    store = makeUnencryptedStore(dependencies);
+
+    auto entries = fetchAllEntries(store);
+    ASSERT_EQ(static_cast<size_t>(1), entries.size());
+    ASSERT_EQ(STRING_LITERAL("item2"), entries[0].first);
+    ASSERT_EQ("World", entries[0].second.data.asStringView());
+}
+
+TEST(PersistentStore, compactsLogIntoSnapshot) {
+    PersistentStoreDependencies dependencies;
+    auto store = makeUnencryptedStore(dependencies);
+
+    auto blob = makeShared<ByteBuffer>(std::string(48 * 1024, 'a'))->toBytesView();
+
+    for (size_t i = 0; i < 3; i++) {
+        store->store(StringCache::getGlobal().makeString(fmt::format("item{}", i)), blob, 0, 0, [](const auto&) {});
+        dependencies.dispatchQueue->sync([]() {});
+    }
+
+    ASSERT_TRUE(dependencies.diskCache->exists(Path("global/somepath.1.log")));
+
+    // The log is now bigger than the snapshot, it should be merged into it
+    store->store(STRING_LITERAL("item3"), blob, 0, 0, [](const auto&) {});
+    dependencies.dispatchQueue->sync([]() {});
+
+    ASSERT_FALSE(dependencies.diskCache->exists(Path("global/somepath.0.log")));
+    ASSERT_FALSE(dependencies.diskCache->exists(Path("global/somepath.1.log")));
+
+    store = makeUnencryptedStore(dependencies);
+
+    auto entries = fetchAllEntries(store);
+    ASSERT_EQ(static_cast<size_t>(4), entries.size());
+    ASSERT_EQ(STRING_LITERAL("item0"), entries[0].first);
+    ASSERT_EQ(STRING_LITERAL("item3"), entries[3].first);
+}
+
+TEST(PersistentStore, restoresAccessOrderFromLog) {
+    PersistentStoreDependencies dependencies;
+    auto store = makeUnencryptedStore(dependencies);
+
+    store->store(STRING_LITERAL("item1"), BytesView(), 0, 1, [](const auto&) {});
+    store->store(STRING_LITERAL("item2"), BytesView(), 0, 1, [](const auto&) {});
+    dependencies.dispatchQueue->sync([]() {});
+
+    // Fetching updates the sequence of the entry, which should be persisted with the next save
+    store->fetch(STRING_LITERAL("item1"), [](const auto&) {});
+    store->store(STRING_LITERAL("item3"), BytesView(), 0, 1, [](const auto&) {});
+    dependencies.dispatchQueue->sync([]() {});
+
+    store = makeUnencryptedStore(dependencies);
+
+    auto entries = fetchAllEntries(store);
+    ASSERT_EQ(static_cast<size_t>(3), entries.size());
+    ASSERT_EQ(STRING_LITERAL("item2"), entries[0].first);
+    ASSERT_EQ(STRING_LITERAL("item1"), entries[1].first);
+    ASSERT_EQ(STRING_LITERAL("item3"), entries[2].first);
+}
+
+TEST(PersistentStore, defersOperationsUntilPopulated) {
+    PersistentStoreDependencies dependencies;
+    auto store = makeUnencryptedStore(dependencies);
+
+    store->store(STRING_LITERAL("item1"), makeShared<ByteBuffer>("Hello")->toBytesView(), 0, 0, [](const auto&) {});
+    dependencies.dispatchQueue->sync([]() {});
+
+    store = Valdi::makeShared<PersistentStore>(STRING_LITERAL("somepath"),
+                                               dependencies.diskCache,
+                                               nullptr,
+                                               nullptr,
+                                               dependencies.dispatchQueue,
+                                               dependencies.logger,
+                                               0,
+                                               true);
+    store->populate();
+
+    // Issued while the content is still being loaded in the background
+    store->store(STRING_LITERAL("item2"), makeShared<ByteBuffer>("World")->toBytesView(), 0, 0, [](const auto&) {});
+
+    auto entries = fetchAllEntries(store);
+    ASSERT_EQ(static_cast<size_t>(2), entries.size());
+    ASSERT_EQ(STRING_LITERAL("item1"), entries[0].first);
+    ASSERT_EQ("Hello", entries[0].second.data.asStringView());
+    ASSERT_EQ(STRING_LITERAL("item2"), entries[1].first);
+}
+
 static BytesView makeBytes(std::initializer_list<Byte> data) {
     auto output = makeShared<ByteBuffer>();
     output->set(data);
@@ -0,0 +1,83 @@
+#include "valdi/runtime/Attributes/PreprocessorCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static PreprocessorCacheKey makeKey(double value) {
+    return PreprocessorCacheKey(Value(value));
+}
+
+TEST(PreprocessorCache, returnsStoredValueWhileHandleIsHeld) {
+    auto cache = makeShared<PreprocessorCache>(0);
+
+    auto stored = cache->store(makeKey(1), Value(42.0));
+    auto result = cache->get(makeKey(1));
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(Value(42.0), result->value);
+    ASSERT_FALSE(cache->get(makeKey(2)).has_value());
+}
+
+TEST(PreprocessorCache, releasesValueWhenHandleIsReleased) {
+    auto cache = makeShared<PreprocessorCache>(0);
+
+    { auto stored = cache->store(makeKey(1), Value(42.0)); }
+
+    ASSERT_FALSE(cache->get(makeKey(1)).has_value());
+}
+
+TEST(PreprocessorCache, keepsRecentlyUsedValuesAfterHandleIsReleased) {
+    auto cache = makeShared<PreprocessorCache>(2);
+
+    { auto stored = cache->store(makeKey(1), Value(1.0)); }
+    { auto stored = cache->store(makeKey(2), Value(2.0)); }
+
+    ASSERT_TRUE(cache->get(makeKey(1)).has_value());
+    // The lookup above made the value for key 1 the most recently used one
+    { auto stored = cache->store(makeKey(3), Value(3.0)); }
+
+    ASSERT_TRUE(cache->get(makeKey(1)).has_value());
+    ASSERT_FALSE(cache->get(makeKey(2)).has_value());
+    ASSERT_TRUE(cache->get(makeKey(3)).has_value());
+}
+
+TEST(PreprocessorCache, clearReleasesRecentlyUsedValues) {
+    auto cache = makeShared<PreprocessorCache>(2);
+
+    { auto stored = cache->store(makeKey(1), Value(1.0)); }
+
+    cache->clear();
+
+    ASSERT_FALSE(cache->get(makeKey(1)).has_value());
+}
+
+TEST(PreprocessorCache, canClearValuesResolvedWithChangedColors) {
+    auto cache = makeShared<PreprocessorCache>(2);
+
+    auto first = cache->store(makeKey(1), Value(1.0), ColorIds({0, 1}));
+    auto second = cache->store(makeKey(2), Value(2.0), ColorIds({2}));
+    { auto stored = cache->store(makeKey(3), Value(3.0), ColorIds({1})); }
+
+    ASSERT_EQ(ColorIds({0, 1}), first.colorIds);
+    ASSERT_EQ(ColorIds({2}), cache->get(makeKey(2))->colorIds);
+
+    ColorPaletteChanges changes;
+    changes.insert(1);
+    cache->clear(changes);
+
+    ASSERT_FALSE(cache->get(makeKey(1)).has_value());
+    ASSERT_TRUE(cache->get(makeKey(2)).has_value());
+    ASSERT_FALSE(cache->get(makeKey(3)).has_value());
+
+    // Values stored again are not removed when the previous handles are released
+    auto updated = cache->store(makeKey(1), Value(10.0), ColorIds({0, 1}));
+    first = PreprocessedValue(Value());
+
+    auto result = cache->get(makeKey(1));
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(Value(10.0), result->value);
+}
+
+} // namespace ValdiTest
@@ -87,6 +87,27 @@ TEST(ReferenceTable, canReleaseRef) {
     ASSERT_EQ(static_cast<size_t>(0), allReferences.size());
 }
 
+TEST(ReferenceTable, canReleaseRefsInBulk) {
+    ReferenceTable table;
+
+    auto write = table.writeAccess();
+    auto id = write.makeRef("MyRef").id;
+    auto id2 = write.makeRef("MyRef2").id;
+    auto id3 = write.makeRef("MyRef3").id;
+    write.retainRef(id2);
+
+    std::vector<SequenceID> expiredIds;
+    write.releaseRefs({id, id2, id3}, expiredIds);
+
+    ASSERT_EQ(std::vector<SequenceID>({id, id3}), expiredIds);
+    ASSERT_FALSE(write.contains(id));
+    ASSERT_EQ(static_cast<size_t>(1), write.getEntry(id2).retainCount);
+    ASSERT_FALSE(write.contains(id3));
+
+    // Released indexes are reused
+    ASSERT_EQ(static_cast<uint32_t>(2), write.makeRef("MyRef4").id.getIndex());
+}
+
 TEST(ReferenceTable, canReuseIndexes) {
     ReferenceTable table;
 
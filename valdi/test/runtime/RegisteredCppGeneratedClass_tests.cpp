@@ -1,4 +1,5 @@
 #include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Schema/ValueSchemaBinary.hpp"
 #include "valdi_core/cpp/Schema/ValueSchemaRegistry.hpp"
 #include "valdi_core/cpp/Utils/CppGeneratedClass.hpp"
 #include <gtest/gtest.h>
@@ -102,4 +103,27 @@ TEST_F(CppGeneratedClassTests, canGetClassName) {
     ASSERT_EQ(STRING_LITERAL("MyObject"), registeredClass1.getClassName());
 }
 
+TEST_F(CppGeneratedClassTests, resolvesSchemaFromBinaryTable) {
+    ValueSchemaBinaryBuilder builder;
+    ASSERT_TRUE(builder.append(ValueSchema::parse("c 'MyObject' {'prop': b}").value()));
+    ASSERT_TRUE(builder.append(ValueSchema::parse("c 'MyObjectList' {'array': a<r:'MyObject'>}").value()));
+    auto data = builder.build();
+    ValueSchemaBinaryTable schemaTable(data->data(), data->size());
+
+    auto registeredClass1 = RegisteredCppGeneratedClass(
+        _registry.get(), &schemaTable, 0, []() -> RegisteredCppGeneratedClass::TypeReferencesVec { return {}; });
+    auto registeredClass2 = RegisteredCppGeneratedClass(
+        _registry.get(), &schemaTable, 1, [&]() -> RegisteredCppGeneratedClass::TypeReferencesVec {
+            return {&registeredClass1};
+        });
+
+    ASSERT_EQ(STRING_LITERAL("MyObjectList"), registeredClass2.getClassName());
+
+    SimpleExceptionTracker exceptionTracker;
+    auto classSchema = registeredClass2.getResolvedClassSchema(exceptionTracker);
+    ASSERT_TRUE(exceptionTracker) << exceptionTracker.extractError();
+
+    ASSERT_EQ("class 'MyObjectList'{'array': array<link:ref:'MyObject'>}", ValueSchema::cls(classSchema).toString());
+}
+
 } // namespace ValdiTest
@@ -21,6 +21,7 @@
 #include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
 using namespace Valdi;
@@ -479,6 +480,48 @@ TEST(RemoteModuleManager, canLoadResources) {
     ASSERT_EQ(file2Content.value().asStringView(), std::string_view("content2"));
 }
 
+TEST(RemoteModuleManager, storesSharedResourcesOnce) {
+    RemoteModuleManagerWrapper wrapper;
+
+    std::vector<Ref<RemoteModuleResources>> allResources;
+    for (size_t i = 0; i < 2; i++) {
+        ValdiArchiveBuilder assetsBuilder;
+        assetsBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("shared.png"), STRING_LITERAL("shared content")));
+        assetsBuilder.addEntry(ValdiArchiveEntry(STRING_LITERAL("file.png"),
+                                                 StringCache::getGlobal().makeString(fmt::format("content{}", i))));
+        auto assetsArtifactBytes = assetsBuilder.build();
+
+        auto module = StringCache::getGlobal().makeString(fmt::format("Module{}", i));
+        auto url = StringCache::getGlobal().makeString(fmt::format("http://snap.com/valdi/module{}.assets", i));
+        wrapper.requestManager->addMockedResponse(url, STRING_LITERAL("GET"), assetsArtifactBytes->toBytesView());
+
+        auto manifest = makeShared<DownloadableModuleManifestWrapper>();
+        auto artifact = manifest->pb.add_assets()->mutable_artifact();
+        artifact->set_url(url.slowToString());
+        auto sha256Digest = BytesUtils::sha256(assetsArtifactBytes->toBytesView());
+        artifact->set_sha256digest(sha256Digest->data(), sha256Digest->size());
+        wrapper.remoteBundleManager->registerManifest(module, manifest);
+
+        auto resultHolder = ResultHolder<Ref<RemoteModuleResources>>::make();
+        wrapper.remoteBundleManager->loadResources(module, resultHolder->makeCompletion());
+        auto result = resultHolder->waitForResult();
+
+        ASSERT_TRUE(result.success()) << result.description();
+        allResources.emplace_back(result.value());
+    }
+
+    auto sharedPath1 = allResources[0]->getResourceCacheUrl(STRING_LITERAL("shared.png"));
+    auto sharedPath2 = allResources[1]->getResourceCacheUrl(STRING_LITERAL("shared.png"));
+    ASSERT_TRUE(sharedPath1.has_value());
+    ASSERT_EQ(sharedPath1, sharedPath2);
+    ASSERT_NE(allResources[0]->getResourceCacheUrl(STRING_LITERAL("file.png")),
+              allResources[1]->getResourceCacheUrl(STRING_LITERAL("file.png")));
+
+    auto sharedContent = wrapper.disk->loadForAbsoluteURL(sharedPath1.value());
+    ASSERT_TRUE(sharedContent.success()) << sharedContent.description();
+    ASSERT_EQ(std::string_view("shared content"), sharedContent.value().asStringView());
+}
+
 TEST(RemoteModuleManager, canLoadResourcesFromDisk) {
     Ref<InMemoryDiskCache> disk;
 
@@ -622,11 +665,16 @@ TEST(RemoteModuleManager, reloadResourcesOnOutOfDateCache) {
     // We should have queried the network to get the new data
     ASSERT_EQ(static_cast<size_t>(1), newWrapper.requestManager->getAllPerformedTasks().size());
 
-    // The cache paths should be the same
-    ASSERT_EQ(*resources, *newResult.value());
+    // Resources are stored by content, the cache paths should have changed
+    ASSERT_NE(*resources, *newResult.value());
 
-    auto file1Path = resources->getResourceCacheUrl(STRING_LITERAL("file1"));
-    auto file2Path = resources->getResourceCacheUrl(STRING_LITERAL("file2"));
+    // The resources of the previous version should have been removed
+    auto previousFile1Path = resources->getResourceCacheUrl(STRING_LITERAL("file1"));
+    ASSERT_TRUE(previousFile1Path.has_value());
+    ASSERT_TRUE(disk->loadForAbsoluteURL(previousFile1Path.value()).failure());
+
+    auto file1Path = newResult.value()->getResourceCacheUrl(STRING_LITERAL("file1"));
+    auto file2Path = newResult.value()->getResourceCacheUrl(STRING_LITERAL("file2"));
 
     ASSERT_TRUE(file1Path.has_value());
     ASSERT_TRUE(file2Path.has_value());
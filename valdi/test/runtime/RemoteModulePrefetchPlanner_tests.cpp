@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "valdi/runtime/Resources/Remote/RemoteModulePrefetchPlanner.hpp"
+
+#include "valdi/standalone_runtime/InMemoryDiskCache.hpp"
+#include "valdi_core/cpp/Context/ComponentPath.hpp"
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <fmt/format.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+struct RemoteModulePrefetchPlannerDependencies {
+    Ref<DispatchQueue> dispatchQueue;
+    Ref<InMemoryDiskCache> diskCache;
+
+    RemoteModulePrefetchPlannerDependencies()
+        : dispatchQueue(DispatchQueue::create(STRING_LITERAL("PrefetchPlanner"), ThreadQoSClassMax)),
+          diskCache(Valdi::makeShared<InMemoryDiskCache>()) {}
+
+    ~RemoteModulePrefetchPlannerDependencies() {
+        dispatchQueue->fullTeardown();
+    }
+
+    Ref<RemoteModulePrefetchPlanner> makePlanner() const {
+        return Valdi::makeShared<RemoteModulePrefetchPlanner>(
+            diskCache, dispatchQueue, ConsoleLogger::getLogger());
+    }
+};
+
+static ComponentPath makeComponentPath(std::string_view bundleName) {
+    return ComponentPath::parse(StringCache::getGlobal().makeString(fmt::format("Root@{}/src/Root", bundleName)));
+}
+
+static void openFeedThenProfile(RemoteModulePrefetchPlanner& planner) {
+    planner.onComponentOpened(makeComponentPath("feed"));
+    planner.onComponentOpened(makeComponentPath("profile"));
+}
+
+TEST(RemoteModulePrefetchPlanner, predictsFrequentTransitions) {
+    RemoteModulePrefetchPlannerDependencies dependencies;
+    auto planner = dependencies.makePlanner();
+
+    openFeedThenProfile(*planner);
+    // A transition observed once is not predicted
+    ASSERT_TRUE(planner->onComponentOpened(makeComponentPath("feed")).empty());
+
+    planner->onComponentOpened(makeComponentPath("profile"));
+    auto predictedBundles = planner->onComponentOpened(makeComponentPath("feed"));
+
+    ASSERT_EQ(std::vector<StringBox>({STRING_LITERAL("profile")}), predictedBundles);
+}
+
+TEST(RemoteModulePrefetchPlanner, predictsEntryComponent) {
+    RemoteModulePrefetchPlannerDependencies dependencies;
+
+    for (size_t i = 0; i < 2; i++) {
+        // Each planner is a new session, which starts by opening the feed
+        auto planner = dependencies.makePlanner();
+        openFeedThenProfile(*planner);
+        dependencies.dispatchQueue->sync([]() {});
+    }
+
+    auto planner = dependencies.makePlanner();
+    auto predictedBundles = planner->onComponentOpened(makeComponentPath("feed"));
+
+    ASSERT_EQ(std::vector<StringBox>({STRING_LITERAL("profile")}), predictedBundles);
+}
+
+TEST(RemoteModulePrefetchPlanner, ignoresUnlikelyTransitions) {
+    RemoteModulePrefetchPlannerDependencies dependencies;
+    auto planner = dependencies.makePlanner();
+
+    for (size_t i = 0; i < 10; i++) {
+        planner->onComponentOpened(makeComponentPath("feed"));
+        planner->onComponentOpened(makeComponentPath("profile"));
+    }
+    for (size_t i = 0; i < 2; i++) {
+        planner->onComponentOpened(makeComponentPath("feed"));
+        planner->onComponentOpened(makeComponentPath("settings"));
+    }
+
+    auto predictedBundles = planner->onComponentOpened(makeComponentPath("feed"));
+
+    ASSERT_EQ(std::vector<StringBox>({STRING_LITERAL("profile")}), predictedBundles);
+}
+
+} // namespace ValdiTest
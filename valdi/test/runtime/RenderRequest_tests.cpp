@@ -0,0 +1,145 @@
+#include "valdi/runtime/Rendering/RenderRequest.hpp"
+#include "valdi/runtime/Rendering/RenderRequestTrace.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+struct CountEntriesVisitor {
+    size_t createElementCount = 0;
+    size_t setElementAttributeCount = 0;
+
+    void visit(RenderRequestEntries::CreateElement& /*entry*/) {
+        createElementCount++;
+    }
+
+    void visit(RenderRequestEntries::SetElementAttribute& /*entry*/) {
+        setElementAttributeCount++;
+    }
+
+    template<typename T>
+    void visit(T& /*entry*/) {}
+};
+
+TEST(RenderRequest, canAppendAndVisitEntries) {
+    auto renderRequest = makeShared<RenderRequest>();
+
+    auto* createElement = renderRequest->appendCreateElement();
+    createElement->setElementId(1);
+    createElement->setViewClassName(STRING_LITERAL("SCValdiView"));
+
+    auto* setElementAttribute = renderRequest->appendSetElementAttribute();
+    setElementAttribute->setElementId(1);
+    setElementAttribute->setAttributeValue(Value(42.0));
+
+    ASSERT_EQ(static_cast<size_t>(2), renderRequest->getEntriesSize());
+
+    CountEntriesVisitor visitor;
+    renderRequest->visitEntries(visitor);
+
+    ASSERT_EQ(static_cast<size_t>(1), visitor.createElementCount);
+    ASSERT_EQ(static_cast<size_t>(1), visitor.setElementAttributeCount);
+}
+
+TEST(RenderRequest, releasesEntriesWhenRecyclingBuffer) {
+    auto array = ValueArray::make({Value(1.0), Value(2.0)});
+
+    {
+        auto renderRequest = makeShared<RenderRequest>();
+        for (size_t i = 0; i < 100; i++) {
+            auto* entry = renderRequest->appendSetElementAttribute();
+            entry->setElementId(static_cast<RawViewNodeId>(i + 1));
+            entry->setAttributeValue(Value(array));
+        }
+
+        ASSERT_EQ(101, array.use_count());
+    }
+
+    ASSERT_EQ(1, array.use_count());
+
+    // The next request reuses a recycled buffer, which must start empty
+    auto renderRequest = makeShared<RenderRequest>();
+    ASSERT_EQ(static_cast<size_t>(0), renderRequest->getEntriesSize());
+    ASSERT_EQ(static_cast<size_t>(0), renderRequest->getEntriesBytesCount());
+
+    renderRequest->appendDestroyElement()->setElementId(1);
+
+    CountEntriesVisitor visitor;
+    renderRequest->visitEntries(visitor);
+    ASSERT_EQ(static_cast<size_t>(0), visitor.setElementAttributeCount);
+    ASSERT_EQ(static_cast<size_t>(1), renderRequest->getEntriesSize());
+}
+
+static Ref<RenderRequest> makeRenderRequest(AttributeIds& attributeIds) {
+    auto renderRequest = makeShared<RenderRequest>();
+    renderRequest->setContextId(7);
+
+    auto* createElement = renderRequest->appendCreateElement();
+    createElement->setElementId(1);
+    createElement->setViewClassName(STRING_LITERAL("SCValdiView"));
+
+    renderRequest->appendSetRootElement()->setElementId(1);
+
+    auto* setElementAttribute = renderRequest->appendSetElementAttribute();
+    setElementAttribute->setElementId(1);
+    setElementAttribute->setAttributeId(attributeIds.getIdForName("opacity"));
+    setElementAttribute->setAttributeValue(Value(0.5));
+
+    auto* moveElement = renderRequest->appendMoveElementToParent();
+    moveElement->setElementId(2);
+    moveElement->setParentElementId(1);
+    moveElement->setParentIndex(3);
+
+    renderRequest->appendDestroyElement()->setElementId(2);
+
+    return renderRequest;
+}
+
+TEST(RenderRequest, canDeserializeSerializedRequest) {
+    AttributeIds attributeIds;
+    auto renderRequest = makeRenderRequest(attributeIds);
+
+    auto serialized = renderRequest->serialize(attributeIds);
+    auto deserialized = RenderRequest::deserialize(serialized, attributeIds);
+
+    ASSERT_TRUE(deserialized) << deserialized.description();
+    ASSERT_EQ(static_cast<ContextId>(7), deserialized.value()->getContextId());
+    ASSERT_EQ(renderRequest->getEntriesSize(), deserialized.value()->getEntriesSize());
+    ASSERT_EQ(serialized, deserialized.value()->serialize(attributeIds));
+}
+
+TEST(RenderRequest, failsToDeserializeUnknownEntries) {
+    AttributeIds attributeIds;
+
+    auto entry = makeShared<ValueMap>();
+    (*entry)[STRING_LITERAL("type")] = Value(STRING_LITERAL("Unknown"));
+    auto serialized = makeShared<ValueMap>();
+    (*serialized)[STRING_LITERAL("entries")] = Value(ValueArray::make({Value(entry)}));
+
+    ASSERT_FALSE(RenderRequest::deserialize(Value(serialized), attributeIds));
+}
+
+TEST(RenderRequestTrace, canParseRecordedTrace) {
+    AttributeIds attributeIds;
+    auto recorder = makeShared<RenderRequestTraceRecorder>(attributeIds);
+
+    auto renderRequest = makeRenderRequest(attributeIds);
+    recorder->record(*renderRequest);
+    recorder->record(*renderRequest);
+
+    ASSERT_EQ(static_cast<size_t>(2), recorder->size());
+
+    auto trace = RenderRequestTrace::parse(recorder->serialize()->toBytesView(), attributeIds);
+
+    ASSERT_TRUE(trace) << trace.description();
+    ASSERT_EQ(static_cast<size_t>(2), trace.value().getEntries().size());
+
+    const auto& entries = trace.value().getEntries();
+    ASSERT_LE(entries[0].timestampMs, entries[1].timestampMs);
+    ASSERT_EQ(renderRequest->serialize(attributeIds), entries[1].renderRequest->serialize(attributeIds));
+}
+
+} // namespace ValdiTest
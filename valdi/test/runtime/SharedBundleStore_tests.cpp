@@ -0,0 +1,100 @@
+#include "valdi/runtime/Attributes/AttributeIds.hpp"
+#include "valdi/runtime/Resources/Bundle.hpp"
+#include "valdi/runtime/Resources/SharedBundleStore.hpp"
+#include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
+#include "valdi_core/cpp/Resources/ValdiArchive.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static Ref<ByteBuffer> makeModuleContent(std::string_view loadStrategy) {
+    std::vector<ValdiArchiveEntry> entries;
+    entries.emplace_back(STRING_LITERAL("load_strategy.json"), StringCache::getGlobal().makeString(loadStrategy));
+
+    auto result = ValdiModuleArchive::serializeSeekable(entries, false);
+    SC_ASSERT(result.success());
+    return result.moveValue();
+}
+
+static Ref<SharedBundleArtifacts> getArtifacts(SharedBundleStore& store,
+                                               const StringBox& bundleName,
+                                               const Ref<ByteBuffer>& content,
+                                               int& decompressCount) {
+    auto result = store.getOrCreate(bundleName, content->toBytesView(), [&]() -> Result<Ref<ValdiModuleArchive>> {
+        decompressCount++;
+        auto archive = ValdiModuleArchive::decompress(content->toBytesView());
+        if (!archive) {
+            return archive.moveError();
+        }
+        return makeShared<ValdiModuleArchive>(archive.moveValue());
+    });
+    SC_ASSERT(result.success(), result.description());
+    return result.moveValue();
+}
+
+static Ref<Bundle> makeBundle(const StringBox& bundleName, const Ref<SharedBundleArtifacts>& artifacts) {
+    auto bundle = makeShared<Bundle>(bundleName, ConsoleLogger::getLogger());
+    auto initializer = bundle->prepareForInit();
+    initializer.initWithLocalArchive(artifacts->getArchive(), false);
+    initializer.setSharedArtifacts(artifacts);
+    return bundle;
+}
+
+static constexpr std::string_view kLoadStrategy = R"({"module/Component": {"valdi_modules": ["other"]}})";
+
+TEST(SharedBundleStore, sharesArtifactsOfSameModuleContent) {
+    AttributeIds attributeIds;
+    SharedBundleStore store(attributeIds);
+    auto bundleName = STRING_LITERAL("module");
+    int decompressCount = 0;
+
+    auto artifacts = getArtifacts(store, bundleName, makeModuleContent(kLoadStrategy), decompressCount);
+    ASSERT_EQ(artifacts, getArtifacts(store, bundleName, makeModuleContent(kLoadStrategy), decompressCount));
+    ASSERT_EQ(1, decompressCount);
+
+    // A different content for the same module, like from a custom resource loader
+    auto otherArtifacts = getArtifacts(store, bundleName, makeModuleContent("{}"), decompressCount);
+    ASSERT_NE(artifacts, otherArtifacts);
+    ASSERT_EQ(2, decompressCount);
+
+    otherArtifacts = nullptr;
+    ASSERT_EQ(static_cast<size_t>(1), store.size());
+    artifacts = nullptr;
+    ASSERT_EQ(static_cast<size_t>(0), store.size());
+}
+
+TEST(SharedBundleStore, bundlesShareParsedArtifactsUntilHotReloaded) {
+    AttributeIds attributeIds;
+    SharedBundleStore store(attributeIds);
+    auto bundleName = STRING_LITERAL("module");
+    int decompressCount = 0;
+
+    auto artifacts = getArtifacts(store, bundleName, makeModuleContent(kLoadStrategy), decompressCount);
+    auto bundle = makeBundle(bundleName, artifacts);
+    auto otherBundle = makeBundle(bundleName, artifacts);
+
+    auto loadStrategy = bundle->getModuleLoadStrategy();
+    ASSERT_TRUE(loadStrategy) << loadStrategy.description();
+    ASSERT_EQ(loadStrategy.value(), otherBundle->getModuleLoadStrategy().value());
+
+    // Hot reloading the entry in one bundle does not affect the other
+    auto reloadedContent = STRING_LITERAL("{}");
+    otherBundle->setEntry(STRING_LITERAL("load_strategy.json"),
+                          BytesView(reloadedContent.getInternedString(),
+                                    reinterpret_cast<const Byte*>(reloadedContent.getCStr()),
+                                    reloadedContent.length()));
+
+    auto reloadedLoadStrategy = otherBundle->getModuleLoadStrategy();
+    ASSERT_TRUE(reloadedLoadStrategy) << reloadedLoadStrategy.description();
+    ASSERT_NE(loadStrategy.value(), reloadedLoadStrategy.value());
+    ASSERT_EQ(nullptr, reloadedLoadStrategy.value()->getStrategyForComponentPath(STRING_LITERAL("module/Component")));
+
+    ASSERT_EQ(loadStrategy.value(), bundle->getModuleLoadStrategy().value());
+    ASSERT_NE(nullptr, loadStrategy.value()->getStrategyForComponentPath(STRING_LITERAL("module/Component")));
+}
+
+} // namespace ValdiTest
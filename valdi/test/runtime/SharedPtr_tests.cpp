@@ -8,6 +8,7 @@
 #include "valdi_core/cpp/Utils/Shared.hpp"
 #include "valdi_core/cpp/Utils/ValueFunction.hpp"
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace Valdi;
 
@@ -23,6 +24,10 @@ struct Container : public SimpleRefCountable {
     Shared<Int> value;
 };
 
+struct NonAtomicContainer : public NonAtomicRefCountable {
+    Shared<Int> value;
+};
+
 struct Outer : public SharedPtrRefCountable {
     Shared<Int> inner;
 
@@ -219,4 +224,38 @@ TEST(SimpleRefCountable, canAllocAndDealloc) {
     ASSERT_EQ(0, container.use_count());
 }
 
+TEST(NonAtomicRefCountable, canAllocAndDealloc) {
+    auto value = makeShared<Int>(42).toShared();
+    auto container = makeShared<NonAtomicContainer>();
+    container->value = value;
+
+    ASSERT_EQ(1, container->retainCount());
+
+    auto copy = container;
+    ASSERT_EQ(2, container->retainCount());
+
+    copy = nullptr;
+    ASSERT_EQ(1, container->retainCount());
+    ASSERT_EQ(2, value.use_count());
+
+    container = nullptr;
+
+    ASSERT_EQ(1, value.use_count());
+}
+
+TEST(NonAtomicRefCountable, canMoveBetweenThreads) {
+    auto value = makeShared<Int>(42).toShared();
+    auto container = makeShared<NonAtomicContainer>();
+    container->value = value;
+
+    std::thread thread([container = std::move(container)]() mutable {
+        auto copy = container;
+        ASSERT_EQ(2, container->retainCount());
+        container = nullptr;
+    });
+    thread.join();
+
+    ASSERT_EQ(1, value.use_count());
+}
+
 } // namespace ValdiTest
@@ -0,0 +1,156 @@
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+#include <optional>
+#include <vector>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static StartupSpan makeSpan(StartupSpanType type, const char* name, int64_t startMs, int64_t endMs) {
+    return StartupSpan{type,
+                       StringCache::getGlobal().makeString(std::string_view(name)),
+                       std::chrono::milliseconds(startMs),
+                       std::chrono::milliseconds(endMs)};
+}
+
+static std::vector<StringBox> getCriticalPathNames(const StartupTimelineReport& report) {
+    std::vector<StringBox> names;
+    for (auto index : report.criticalPath) {
+        names.emplace_back(report.spans[index].name);
+    }
+    return names;
+}
+
+TEST(StartupTimeline, computesCriticalPathToFirstFrame) {
+    auto report = StartupTimeline::makeReport(
+        {
+            makeSpan(StartupSpanType::RenderRequest, "render", 70, 80),
+            makeSpan(StartupSpanType::JSEngineInit, "engine", 0, 30),
+            makeSpan(StartupSpanType::BundleLoad, "bundle", 30, 40),
+            // Runs in parallel of the bundle load and ends before it, so it did not block the first frame
+            makeSpan(StartupSpanType::BundleLoad, "parallel", 31, 35),
+            makeSpan(StartupSpanType::ModuleEvaluation, "module", 45, 65),
+            makeSpan(StartupSpanType::Layout, "layout", 80, 90),
+            // Ends after the first frame
+            makeSpan(StartupSpanType::Layout, "late", 95, 120),
+        },
+        std::chrono::milliseconds(100));
+
+    ASSERT_EQ(static_cast<size_t>(7), report.spans.size());
+    ASSERT_EQ(STRING_LITERAL("engine"), report.spans[0].name);
+
+    ASSERT_EQ(std::vector<StringBox>({STRING_LITERAL("engine"),
+                                      STRING_LITERAL("bundle"),
+                                      STRING_LITERAL("module"),
+                                      STRING_LITERAL("render"),
+                                      STRING_LITERAL("layout"),
+                                      STRING_LITERAL("late")}),
+              getCriticalPathNames(report));
+
+    ASSERT_EQ(std::chrono::milliseconds(30), report.getCriticalPathTime(StartupSpanType::JSEngineInit));
+    ASSERT_EQ(std::chrono::milliseconds(10), report.getCriticalPathTime(StartupSpanType::BundleLoad));
+    ASSERT_EQ(std::chrono::milliseconds(20), report.getCriticalPathTime(StartupSpanType::ModuleEvaluation));
+    ASSERT_EQ(std::chrono::milliseconds(15), report.getCriticalPathTime(StartupSpanType::Layout));
+    // 40 to 45, 65 to 70 and 90 to 95
+    ASSERT_EQ(std::chrono::milliseconds(15), report.unattributedTime);
+}
+
+TEST(StartupTimeline, attributesEnclosingSpansTheTimeBeforeTheirChildren) {
+    auto report = StartupTimeline::makeReport(
+        {
+            makeSpan(StartupSpanType::ModuleEvaluation, "parent", 0, 50),
+            makeSpan(StartupSpanType::ModuleEvaluation, "child", 20, 50),
+            makeSpan(StartupSpanType::BundleLoad, "grandchild", 25, 30),
+        },
+        std::chrono::milliseconds(50));
+
+    ASSERT_EQ(std::vector<StringBox>({STRING_LITERAL("parent"), STRING_LITERAL("child")}),
+              getCriticalPathNames(report));
+    ASSERT_EQ(std::chrono::milliseconds(20), report.criticalPathBlockingTimes[0]);
+    ASSERT_EQ(std::chrono::milliseconds(30), report.criticalPathBlockingTimes[1]);
+    ASSERT_EQ(std::chrono::milliseconds(0), report.unattributedTime);
+}
+
+TEST(StartupTimeline, completesOnFirstRender) {
+    StartupTimeline timeline;
+    std::vector<StartupTimelineReport> reports;
+    timeline.setCompletionCallback([&](const StartupTimelineReport& report) { reports.emplace_back(report); });
+
+    // Nothing is recorded before the timeline starts
+    ASSERT_FALSE(timeline.isRecording());
+    timeline.markMilestone(StartupMilestone::FirstRender);
+    ASSERT_TRUE(reports.empty());
+
+    auto startTime = std::chrono::steady_clock::now();
+    timeline.start(startTime);
+    timeline.recordSpan(StartupSpanType::JSEngineInit,
+                        StringBox(),
+                        startTime + std::chrono::milliseconds(5),
+                        startTime + std::chrono::milliseconds(20));
+    timeline.markMilestone(StartupMilestone::FirstRenderRequest, startTime + std::chrono::milliseconds(25));
+    timeline.markMilestone(StartupMilestone::FirstRenderRequest, startTime + std::chrono::milliseconds(27));
+    timeline.markMilestone(StartupMilestone::FirstRender, startTime + std::chrono::milliseconds(30));
+
+    ASSERT_FALSE(timeline.isRecording());
+    ASSERT_EQ(static_cast<size_t>(1), reports.size());
+
+    const auto& report = reports[0];
+    ASSERT_EQ(std::chrono::milliseconds(30), report.firstFrameTime);
+    ASSERT_EQ(std::make_optional<std::chrono::steady_clock::duration>(std::chrono::milliseconds(25)),
+              report.milestones[static_cast<size_t>(StartupMilestone::FirstRenderRequest)]);
+    ASSERT_FALSE(report.milestones[static_cast<size_t>(StartupMilestone::FirstDraw)].has_value());
+    ASSERT_EQ(std::chrono::milliseconds(15), report.getCriticalPathTime(StartupSpanType::JSEngineInit));
+    ASSERT_EQ(std::chrono::milliseconds(15), report.unattributedTime);
+
+    // The timeline is only reported once
+    timeline.start(startTime);
+    timeline.markMilestone(StartupMilestone::FirstDraw, startTime + std::chrono::milliseconds(40));
+    ASSERT_EQ(static_cast<size_t>(1), reports.size());
+}
+
+TEST(StartupTimeline, waitsForFirstDrawWhenExpected) {
+    StartupTimeline timeline;
+    auto startTime = std::chrono::steady_clock::now();
+    timeline.start(startTime);
+    timeline.setExpectsFirstDraw(true);
+
+    timeline.markMilestone(StartupMilestone::FirstRender, startTime + std::chrono::milliseconds(30));
+    ASSERT_TRUE(timeline.isRecording());
+
+    timeline.recordSpan(StartupSpanType::Draw,
+                        StringBox(),
+                        startTime + std::chrono::milliseconds(35),
+                        startTime + std::chrono::milliseconds(45));
+    timeline.markMilestone(StartupMilestone::FirstDraw, startTime + std::chrono::milliseconds(45));
+    ASSERT_FALSE(timeline.isRecording());
+
+    // The report is held until a callback is set
+    std::optional<StartupTimelineReport> completedReport;
+    timeline.setCompletionCallback([&](const StartupTimelineReport& report) { completedReport = report; });
+
+    ASSERT_TRUE(completedReport.has_value());
+    ASSERT_EQ(std::chrono::milliseconds(45), completedReport.value().firstFrameTime);
+    ASSERT_EQ(std::chrono::milliseconds(10), completedReport.value().getCriticalPathTime(StartupSpanType::Draw));
+}
+
+TEST(StartupTimeline, dropsSpansPastCapacity) {
+    StartupTimeline timeline;
+    auto startTime = std::chrono::steady_clock::now();
+    timeline.start(startTime);
+
+    for (size_t i = 0; i < StartupTimeline::kMaxSpans + 3; i++) {
+        timeline.recordSpan(StartupSpanType::Layout, StringBox(), startTime, startTime);
+    }
+
+    std::optional<StartupTimelineReport> completedReport;
+    timeline.setCompletionCallback([&](const StartupTimelineReport& report) { completedReport = report; });
+    timeline.markMilestone(StartupMilestone::FirstRender, startTime + std::chrono::milliseconds(1));
+
+    ASSERT_TRUE(completedReport.has_value());
+    ASSERT_EQ(StartupTimeline::kMaxSpans, completedReport.value().spans.size());
+    ASSERT_EQ(static_cast<size_t>(3), completedReport.value().droppedSpansCount);
+}
+
+} // namespace ValdiTest
@@ -48,6 +48,22 @@ TEST(StringCache, canInternStrings) {
     ASSERT_NE(str1.getInternedString(), str3.getInternedString());
 }
 
+TEST(StringCache, hashesLiteralsAtCompileTime) {
+    static_assert(hashString("hello") != 0);
+    static_assert(hashString("") == 0);
+    constexpr auto kHash = hashString("a string longer than eight bytes");
+
+    ASSERT_EQ(StringBox::makeHash(std::string_view("a string longer than eight bytes")), kHash);
+
+    const char* runtimeString = "hello world";
+    auto fromLiteral = STRING_LITERAL("hello world");
+    auto fromRuntimeString = STRING_LITERAL(runtimeString);
+
+    ASSERT_EQ(fromLiteral, fromRuntimeString);
+    ASSERT_EQ(fromLiteral.getInternedString(), StringCache::getGlobal().makeStringFromLiteral("hello world").getInternedString());
+    ASSERT_EQ(StringBox::makeHash(std::string_view("hello world")), fromLiteral.getInternedString()->getHash());
+}
+
 TEST(StringCache, canDeallocConcurrently) {
     auto& cache = StringCache::getGlobal();
 
@@ -60,7 +76,7 @@ TEST(StringCache, canDeallocConcurrently) {
         StringBox str2;
         StringBox str3;
 
-        auto lock = cache.lock();
+        auto lock = cache.lock("StringToTest");
 
         queue1->async([&]() {
             // In Thread1, we release the string
@@ -80,4 +96,34 @@ TEST(StringCache, canDeallocConcurrently) {
     }
 }
 
+TEST(StringCache, canInternConcurrently) {
+    auto& cache = StringCache::getGlobal();
+
+    std::vector<Ref<DispatchQueue>> queues;
+    std::vector<std::vector<StringBox>> stringsByQueue;
+    for (size_t i = 0; i < 4; i++) {
+        queues.emplace_back(DispatchQueue::create(STRING_FORMAT("Thread{}", i), ThreadQoSClassMax));
+    }
+    stringsByQueue.resize(queues.size());
+
+    for (size_t i = 0; i < queues.size(); i++) {
+        queues[i]->async([&, i]() {
+            for (size_t j = 0; j < 200; j++) {
+                stringsByQueue[i].emplace_back(cache.makeString(fmt::format("ConcurrentString{}", j)));
+            }
+        });
+    }
+
+    for (const auto& queue : queues) {
+        queue->sync([]() {});
+    }
+
+    for (size_t i = 1; i < stringsByQueue.size(); i++) {
+        ASSERT_EQ(stringsByQueue[0].size(), stringsByQueue[i].size());
+        for (size_t j = 0; j < stringsByQueue[i].size(); j++) {
+            ASSERT_EQ(stringsByQueue[0][j].getInternedString(), stringsByQueue[i][j].getInternedString());
+        }
+    }
+}
+
 } // namespace ValdiTest
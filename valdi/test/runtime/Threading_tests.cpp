@@ -5,12 +5,18 @@
 //  Created by Simon Corsin on 03/05/23
 //
 
+#include "valdi_core/cpp/Threading/PooledDispatchQueue.hpp"
 #include "valdi_core/cpp/Threading/TaskQueue.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
 #include "valdi_core/cpp/Threading/ThreadedDispatchQueue.hpp"
 #include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/LockContentionProfiler.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include "valdi_core/cpp/Utils/TrackedLock.hpp"
+#include <future>
 #include <gtest/gtest.h>
+#include <optional>
+#include <thread>
 
 using namespace Valdi;
 
@@ -88,6 +94,215 @@ TEST(TaskQueue, barrierDoesNotAllowOtherTaskToRun) {
     ASSERT_TRUE(innerTaskRan);
 }
 
+TEST(TaskQueue, preservesOrderBetweenImmediateAndDelayedTasks) {
+    TaskQueue taskQueue;
+    std::vector<int> order;
+
+    auto now = std::chrono::steady_clock::now();
+    taskQueue.enqueue([&]() { order.emplace_back(0); });
+    taskQueue.enqueue([&]() { order.emplace_back(1); }, now - std::chrono::seconds(1));
+    taskQueue.enqueue([&]() { order.emplace_back(2); });
+    // Enough tasks to overflow the lock-free ring
+    for (int i = 0; i < 1000; i++) {
+        taskQueue.enqueue([&, i]() { order.emplace_back(3 + i); });
+    }
+
+    taskQueue.flush();
+
+    ASSERT_EQ(static_cast<size_t>(1003), order.size());
+    ASSERT_EQ(1, order[0]);
+    ASSERT_EQ(0, order[1]);
+    for (size_t i = 2; i < order.size(); i++) {
+        ASSERT_EQ(static_cast<int>(i), order[i]);
+    }
+}
+
+TEST(TaskQueue, canCancelImmediateTask) {
+    TaskQueue taskQueue;
+    bool ran = false;
+
+    auto id = taskQueue.enqueue([&]() { ran = true; }).id;
+    taskQueue.cancel(id);
+
+    ASSERT_EQ(static_cast<size_t>(0), taskQueue.flush());
+    ASSERT_FALSE(ran);
+}
+
+TEST(TaskQueue, wakesUpConsumerOnTasksFromMultipleProducers) {
+    auto taskQueue = makeShared<TaskQueue>();
+    constexpr size_t kTasksPerProducer = 5000;
+    std::atomic<size_t> counter(0);
+
+    auto consumer = Thread::create(STRING_LITERAL("Consumer"), ThreadQoSClassMax, [&]() {
+                        while (counter < kTasksPerProducer * 3) {
+                            taskQueue->runNextTask(std::chrono::steady_clock::now() + std::chrono::seconds(5));
+                        }
+                    }).value();
+
+    std::vector<Ref<Thread>> producers;
+    for (size_t i = 0; i < 3; i++) {
+        producers.emplace_back(Thread::create(STRING_LITERAL("Producer"), ThreadQoSClassMax, [&]() {
+                                   for (size_t j = 0; j < kTasksPerProducer; j++) {
+                                       taskQueue->async([&]() { counter++; });
+                                   }
+                               }).value());
+    }
+
+    for (const auto& producer : producers) {
+        producer->join();
+    }
+    consumer->join();
+
+    ASSERT_EQ(kTasksPerProducer * 3, counter.load());
+}
+
+TEST(ThreadPool, runsAllSubmittedTasks) {
+    auto threadPool = makeShared<ThreadPool>(STRING_LITERAL("Test Pool"), 4, ThreadQoSClassNormal);
+    std::atomic<size_t> counter(0);
+    std::promise<void> promise;
+    constexpr size_t kTasksCount = 1000;
+
+    for (size_t i = 0; i < kTasksCount; i++) {
+        threadPool->submit([&]() {
+            // Tasks submitted from a worker go through the worker's own deque
+            threadPool->submit([&]() {
+                if (++counter == kTasksCount * 2) {
+                    promise.set_value();
+                }
+            });
+            if (++counter == kTasksCount * 2) {
+                promise.set_value();
+            }
+        });
+    }
+
+    promise.get_future().wait();
+    ASSERT_EQ(kTasksCount * 2, counter.load());
+
+    threadPool->teardown();
+}
+
+TEST(ThreadPool, runsDelayedTasksAfterDeadline) {
+    auto threadPool = makeShared<ThreadPool>(STRING_LITERAL("Test Pool"), 2, ThreadQoSClassNormal);
+    std::promise<std::chrono::steady_clock::time_point> promise;
+
+    auto executeTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+    threadPool->submitAfter([&]() { promise.set_value(std::chrono::steady_clock::now()); }, executeTime);
+
+    ASSERT_GE(promise.get_future().get(), executeTime);
+
+    threadPool->teardown();
+}
+
+TEST(ThreadPool, parallelForVisitsEveryIndexOnce) {
+    auto threadPool = makeShared<ThreadPool>(STRING_LITERAL("Test Pool"), 4, ThreadQoSClassNormal);
+    constexpr size_t kCount = 500;
+    std::vector<std::atomic<int>> visits(kCount);
+
+    threadPool->parallelFor(kCount, 4, [&](size_t index) { visits[index]++; });
+
+    for (const auto& visit : visits) {
+        ASSERT_EQ(1, visit.load());
+    }
+
+    threadPool->teardown();
+}
+
+TEST(ThreadPool, parallelForCanBeCalledFromSaturatedWorkers) {
+    auto threadPool = makeShared<ThreadPool>(STRING_LITERAL("Test Pool"), 2, ThreadQoSClassNormal);
+    std::atomic<size_t> counter(0);
+    std::promise<void> promise1;
+    std::promise<void> promise2;
+
+    // Both workers nest a parallelFor, which can only complete if the callers do the work themselves
+    threadPool->submit([&]() {
+        threadPool->parallelFor(100, 8, [&](size_t /*index*/) { counter++; });
+        promise1.set_value();
+    });
+    threadPool->submit([&]() {
+        threadPool->parallelFor(100, 8, [&](size_t /*index*/) { counter++; });
+        promise2.set_value();
+    });
+
+    promise1.get_future().wait();
+    promise2.get_future().wait();
+    ASSERT_EQ(static_cast<size_t>(200), counter.load());
+
+    threadPool->teardown();
+}
+
+TEST(PooledDispatchQueue, serialQueueRunsTasksInOrder) {
+    auto threadPool = makeShared<ThreadPool>(STRING_LITERAL("Test Pool"), 4, ThreadQoSClassNormal);
+    auto queue = makeShared<PooledDispatchQueue>(STRING_LITERAL("Serial Queue"), threadPool, 1);
+
+    std::vector<size_t> order;
+    std::atomic<size_t> runningTasks(0);
+    bool overlapped = false;
+
+    for (size_t i = 0; i < 200; i++) {
+        queue->async([&, i]() {
+            if (++runningTasks > 1) {
+                overlapped = true;
+            }
+            ASSERT_TRUE(queue->isCurrent());
+            order.emplace_back(i);
+            runningTasks--;
+        });
+    }
+
+    queue->sync([]() {});
+
+    ASSERT_FALSE(overlapped);
+    ASSERT_EQ(static_cast<size_t>(200), order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        ASSERT_EQ(i, order[i]);
+    }
+
+    threadPool->teardown();
+}
+
+TEST(PooledDispatchQueue, concurrentQueueRespectsMaxConcurrentTasks) {
+    auto threadPool = makeShared<ThreadPool>(STRING_LITERAL("Test Pool"), 4, ThreadQoSClassNormal);
+    auto queue = makeShared<PooledDispatchQueue>(STRING_LITERAL("Concurrent Queue"), threadPool, 2);
+
+    std::atomic<size_t> runningTasks(0);
+    std::atomic<size_t> maxRunningTasks(0);
+
+    for (size_t i = 0; i < 100; i++) {
+        queue->async([&]() {
+            auto running = ++runningTasks;
+            auto previousMax = maxRunningTasks.load();
+            while (running > previousMax && !maxRunningTasks.compare_exchange_weak(previousMax, running)) {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            runningTasks--;
+        });
+    }
+
+    queue->sync([]() {});
+
+    ASSERT_LE(maxRunningTasks.load(), static_cast<size_t>(2));
+
+    threadPool->teardown();
+}
+
+TEST(PooledDispatchQueue, canCancelDelayedTask) {
+    auto threadPool = makeShared<ThreadPool>(STRING_LITERAL("Test Pool"), 2, ThreadQoSClassNormal);
+    auto queue = makeShared<PooledDispatchQueue>(STRING_LITERAL("Serial Queue"), threadPool, 1);
+
+    std::atomic_bool cancelledTaskRan(false);
+    std::promise<void> promise;
+
+    auto taskId = queue->asyncAfter([&]() { cancelledTaskRan = true; }, std::chrono::milliseconds(5));
+    queue->asyncAfter([&]() { promise.set_value(); }, std::chrono::milliseconds(10));
+    queue->cancel(taskId);
+
+    promise.get_future().wait();
+    ASSERT_FALSE(cancelledTaskRan);
+
+    threadPool->teardown();
+}
+
 TEST(TrackedLock, canDropTrackedLocks) {
     auto mutex = makeShared<RecursiveMutex>();
     TrackedLock lock1(*mutex);
@@ -112,4 +327,69 @@ TEST(TrackedLock, canDropTrackedLocks) {
     ASSERT_TRUE(lock3.owns());
 }
 
+static std::optional<LockContentionSummary> collectLockContention(std::string_view siteName) {
+    for (auto& it : LockContentionProfiler::shared().collect()) {
+        if (it.first == siteName) {
+            return std::move(it.second);
+        }
+    }
+    return std::nullopt;
+}
+
+TEST(LockContentionProfiler, recordsContendedAcquires) {
+    Mutex mutex("LockContentionProfilerTests.contended");
+    LockContentionProfiler::setEnabled(true);
+
+    mutex.lock();
+    std::thread thread([&]() {
+        mutex.lock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        mutex.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mutex.unlock();
+    thread.join();
+
+    LockContentionProfiler::setEnabled(false);
+
+    auto summary = collectLockContention("LockContentionProfilerTests.contended");
+    ASSERT_TRUE(summary.has_value());
+    ASSERT_EQ(static_cast<uint64_t>(1), summary->getContendedAcquiresCount());
+    ASSERT_GE(summary->waitTimes.getMax(), std::chrono::milliseconds(10));
+    ASSERT_EQ(static_cast<uint64_t>(1), summary->holdTimes.getCount());
+    ASSERT_GE(summary->holdTimes.getMax(), std::chrono::milliseconds(4));
+    ASSERT_EQ(static_cast<size_t>(1), summary->waitingThreads.size());
+
+    // The summary is reset once collected
+    ASSERT_FALSE(collectLockContention("LockContentionProfilerTests.contended").has_value());
+}
+
+TEST(LockContentionProfiler, ignoresUncontendedAndRecursiveAcquires) {
+    RecursiveMutex mutex("LockContentionProfilerTests.uncontended");
+    LockContentionProfiler::setEnabled(true);
+
+    {
+        std::lock_guard<RecursiveMutex> lock1(mutex);
+        std::lock_guard<RecursiveMutex> lock2(mutex);
+    }
+
+    LockContentionProfiler::setEnabled(false);
+
+    ASSERT_FALSE(collectLockContention("LockContentionProfilerTests.uncontended").has_value());
+}
+
+TEST(LockContentionProfiler, doesNotRecordWhileDisabled) {
+    Mutex mutex("LockContentionProfilerTests.disabled");
+
+    mutex.lock();
+    std::thread thread([&]() {
+        std::lock_guard<Mutex> lock(mutex);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    mutex.unlock();
+    thread.join();
+
+    ASSERT_FALSE(collectLockContention("LockContentionProfilerTests.disabled").has_value());
+}
+
 } // namespace ValdiTest
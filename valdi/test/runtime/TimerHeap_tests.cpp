@@ -0,0 +1,97 @@
+#include "valdi_core/cpp/Utils/TimerHeap.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+TEST(TimerHeap, popsInDeadlineOrder) {
+    TimerHeap<int, std::string> heap;
+
+    heap.insert(30, "c");
+    heap.insert(10, "a");
+    heap.insert(20, "b");
+
+    ASSERT_EQ(static_cast<size_t>(3), heap.size());
+    ASSERT_EQ(10, heap.topTime());
+    ASSERT_EQ("a", heap.pop());
+    ASSERT_EQ("b", heap.pop());
+    ASSERT_EQ("c", heap.pop());
+    ASSERT_TRUE(heap.empty());
+}
+
+TEST(TimerHeap, keepsInsertionOrderForSameDeadline) {
+    TimerHeap<int, int> heap;
+
+    for (int i = 0; i < 100; i++) {
+        heap.insert(i % 2 == 0 ? 1 : 0, i);
+    }
+
+    for (int i = 1; i < 100; i += 2) {
+        ASSERT_EQ(i, heap.pop());
+    }
+    for (int i = 0; i < 100; i += 2) {
+        ASSERT_EQ(i, heap.pop());
+    }
+}
+
+TEST(TimerHeap, canRemoveThroughHandle) {
+    TimerHeap<int, std::string> heap;
+
+    auto handleA = heap.insert(10, "a");
+    auto handleB = heap.insert(20, "b");
+    auto handleC = heap.insert(30, "c");
+
+    auto removed = heap.remove(handleB);
+    ASSERT_TRUE(removed.has_value());
+    ASSERT_EQ("b", removed.value());
+    ASSERT_FALSE(heap.contains(handleB));
+    ASSERT_FALSE(heap.remove(handleB).has_value());
+
+    ASSERT_TRUE(heap.contains(handleA));
+    ASSERT_TRUE(heap.contains(handleC));
+
+    ASSERT_EQ("a", heap.pop());
+    ASSERT_FALSE(heap.contains(handleA));
+    ASSERT_EQ("c", heap.pop());
+}
+
+TEST(TimerHeap, doesNotReuseHandles) {
+    TimerHeap<int, int> heap;
+
+    auto handle1 = heap.insert(10, 1);
+    heap.pop();
+    auto handle2 = heap.insert(10, 2);
+
+    // The slot is reused but the handle is different
+    ASSERT_EQ(handle1.slot, handle2.slot);
+    ASSERT_NE(handle1, handle2);
+    ASSERT_FALSE(heap.remove(handle1).has_value());
+    ASSERT_TRUE(heap.contains(handle2));
+}
+
+TEST(TimerHeap, staysOrderedAfterRandomRemovals) {
+    TimerHeap<int, int> heap;
+    std::vector<TimerHeapHandle> handles;
+    std::mt19937 random(42);
+
+    for (int i = 0; i < 1000; i++) {
+        auto time = static_cast<int>(random() % 500);
+        handles.emplace_back(heap.insert(time, time));
+    }
+
+    for (size_t i = 0; i < handles.size(); i += 3) {
+        ASSERT_TRUE(heap.remove(handles[i]).has_value());
+    }
+
+    auto previous = -1;
+    while (!heap.empty()) {
+        auto value = heap.pop();
+        ASSERT_LE(previous, value);
+        previous = value;
+    }
+}
+
+} // namespace ValdiTest
@@ -1,5 +1,7 @@
 #include "valdi_core/cpp/Utils/Trace.hpp"
+#include "valdi_core/cpp/Utils/TraceExporter.hpp"
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace Valdi;
 
@@ -118,4 +120,107 @@ TEST(Tracer, onlyReturnsRecordingWhenLastRecorderEnd) {
     ASSERT_FALSE(tracer.isRecording());
 }
 
+TEST(Tracer, canRecordFromMultipleThreads) {
+    Tracer tracer;
+    auto start = std::chrono::steady_clock::now();
+
+    auto id = tracer.startRecording();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&tracer, start, i]() {
+            for (int j = 0; j < 100; j++) {
+                tracer.append(i % 2 == 0 ? "even" : "odd", appendMs(start, j), appendMs(start, j + 1));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto result = tracer.stopRecording(id);
+
+    ASSERT_EQ(static_cast<size_t>(400), result.size());
+
+    std::vector<ThreadId> threadIds;
+    for (size_t i = 0; i < result.size(); i++) {
+        ASSERT_TRUE(result[i].trace == "even" || result[i].trace == "odd");
+        if (i > 0) {
+            ASSERT_LE(result[i - 1].start, result[i].start);
+        }
+        if (std::find(threadIds.begin(), threadIds.end(), result[i].threadId) == threadIds.end()) {
+            threadIds.emplace_back(result[i].threadId);
+        }
+    }
+    ASSERT_EQ(static_cast<size_t>(4), threadIds.size());
+}
+
+TEST(Tracer, canAppendWithInternedName) {
+    Tracer tracer;
+    auto start = std::chrono::steady_clock::now();
+
+    auto helloId = tracer.internTraceName("hello");
+    ASSERT_EQ(helloId, tracer.internTraceName("hello"));
+    ASSERT_NE(helloId, tracer.internTraceName("world"));
+
+    auto id = tracer.startRecording();
+
+    tracer.append(helloId, start, appendMs(start, 50));
+    tracer.append("hello", start, appendMs(start, 100));
+
+    auto result = tracer.stopRecording(id);
+
+    ASSERT_EQ(static_cast<size_t>(2), result.size());
+    ASSERT_EQ("hello", result[0].trace);
+    ASSERT_EQ("hello", result[1].trace);
+}
+
+TEST(Tracer, keepsMostRecentTracesWhenThreadBufferIsFull) {
+    Tracer tracer;
+    auto start = std::chrono::steady_clock::now();
+
+    auto id = tracer.startRecording();
+
+    for (int i = 0; i < 20000; i++) {
+        tracer.append("trace", appendMs(start, i), appendMs(start, i + 1));
+    }
+
+    auto result = tracer.stopRecording(id);
+
+    ASSERT_FALSE(result.empty());
+    ASSERT_LT(result.size(), static_cast<size_t>(20000));
+    ASSERT_EQ(appendMs(start, 19999), result.back().start);
+}
+
+TEST(Tracer, doesNotReturnTracesFromPreviousRecording) {
+    Tracer tracer;
+    auto start = std::chrono::steady_clock::now();
+
+    auto id = tracer.startRecording();
+    tracer.append("hello", start, appendMs(start, 50));
+    ASSERT_EQ(static_cast<size_t>(1), tracer.stopRecording(id).size());
+
+    tracer.append("ignored", start, appendMs(start, 50));
+
+    auto id2 = tracer.startRecording();
+    tracer.append("world", start, appendMs(start, 100));
+    auto result = tracer.stopRecording(id2);
+
+    ASSERT_EQ(static_cast<size_t>(1), result.size());
+    ASSERT_EQ("world", result[0].trace);
+}
+
+TEST(Tracer, canExportToChromeTraceFormat) {
+    auto start = TraceTimePoint(std::chrono::microseconds(1000));
+    std::vector<RecordedTrace> traces;
+    traces.emplace_back("hello \"world\"", start, start + std::chrono::microseconds(250), 7, 1);
+
+    auto json = exportTracesToChromeTraceJSON(traces, 42);
+
+    ASSERT_EQ(
+        "{\"traceEvents\":[{\"name\":\"hello \\\"world\\\"\",\"cat\":\"valdi\",\"ph\":\"X\",\"ts\":1000.000000,"
+        "\"dur\":250.000000,\"pid\":42,\"tid\":7}],\"displayTimeUnit\":\"ms\"}",
+        json->toStringView());
+}
+
 } // namespace ValdiTest
@@ -54,4 +54,36 @@ TEST(UTF16ToUTF32Index, canResolveIndexesOnDifferentLength) {
     ASSERT_EQ(static_cast<size_t>(25), index.getUTF32Index(29));
 }
 
+TEST(UTF16Utils, canCountLeadingASCII) {
+    std::string_view str = "Hello World, this is ASCII\U0001F385 tail";
+    auto utf16 = utf8ToUtf16(str.data(), str.size());
+
+    ASSERT_EQ(static_cast<size_t>(26), countLeadingASCII(str.data(), str.size()));
+    ASSERT_EQ(static_cast<size_t>(26), countLeadingASCII(utf16.first, utf16.second));
+    ASSERT_EQ(static_cast<size_t>(5), countLeadingASCII(str.data(), 5));
+    ASSERT_EQ(static_cast<size_t>(0), countLeadingASCII(str.data() + 26, str.size() - 26));
+}
+
+TEST(UTF16Utils, canRoundTripMixedASCIIAndMultiByteStrings) {
+    std::string_view str =
+        "A long ASCII run before \u00e9t\u00e9 \u4e2d\u6587 and \U0001F385\U0001F385 then more ASCII text\n";
+
+    auto utf16 = utf8ToUtf16(str.data(), str.size());
+    std::u16string utf16Copy(utf16.first, utf16.second);
+    auto utf32 = utf8ToUtf32(str.data(), str.size());
+    std::vector<uint32_t> utf32Copy(utf32.first, utf32.first + utf32.second);
+
+    // The two emojis are encoded as surrogate pairs in UTF16
+    ASSERT_EQ(utf32Copy.size() + 2, utf16Copy.size());
+    ASSERT_EQ(static_cast<uint32_t>('A'), utf32Copy[0]);
+    ASSERT_EQ(static_cast<uint32_t>(0xE9), utf32Copy[24]);
+
+    auto utf16ToUtf8Result = utf16ToUtf8(utf16Copy.data(), utf16Copy.size());
+    ASSERT_EQ(str, std::string_view(utf16ToUtf8Result.first, utf16ToUtf8Result.second));
+
+    auto utf16ToUtf32Result = utf16ToUtf32(utf16Copy.data(), utf16Copy.size());
+    ASSERT_EQ(utf32Copy,
+              std::vector<uint32_t>(utf16ToUtf32Result.first, utf16ToUtf32Result.first + utf16ToUtf32Result.second));
+}
+
 } // namespace ValdiTest
@@ -0,0 +1,101 @@
+#include "valdi_core/cpp/Text/UnicodeRangeScanner.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+TEST(UnicodeRangeScanner, canQueryRanges) {
+    UnicodeRangeScanner scanner({CharacterRange(0x200D, 0x200D), CharacterRange(0x1F300, 0x1F5FF)});
+
+    ASSERT_EQ(static_cast<size_t>(2), scanner.getRangesCount());
+    ASSERT_FALSE(scanner.contains(0));
+    ASSERT_FALSE(scanner.contains('a'));
+    ASSERT_FALSE(scanner.contains(0x200C));
+    ASSERT_TRUE(scanner.contains(0x200D));
+    ASSERT_FALSE(scanner.contains(0x200E));
+    ASSERT_FALSE(scanner.contains(0x1F2FF));
+    ASSERT_TRUE(scanner.contains(0x1F300));
+    ASSERT_TRUE(scanner.contains(0x1F400));
+    ASSERT_TRUE(scanner.contains(0x1F5FF));
+    ASSERT_FALSE(scanner.contains(0x1F600));
+    ASSERT_FALSE(scanner.contains(0xFFFFFFFF));
+}
+
+TEST(UnicodeRangeScanner, mergesOverlappingRanges) {
+    UnicodeRangeScanner scanner(
+        {CharacterRange(20, 30), CharacterRange(10, 15), CharacterRange(16, 19), CharacterRange(25, 40)});
+
+    ASSERT_EQ(static_cast<size_t>(1), scanner.getRangesCount());
+    ASSERT_FALSE(scanner.contains(9));
+    ASSERT_TRUE(scanner.contains(10));
+    ASSERT_TRUE(scanner.contains(40));
+    ASSERT_FALSE(scanner.contains(41));
+}
+
+TEST(UnicodeRangeScanner, mergesClosestRangesWhenFull) {
+    std::vector<CharacterRange> ranges;
+    for (uint32_t i = 0; i < UnicodeRangeScanner::kMaxRanges * 2; i++) {
+        // Pairs of ranges close to each other, far away from the next pair
+        auto start = 0x1000 * (i / 2) + (i % 2) * 4;
+        ranges.emplace_back(start, start + 1);
+    }
+
+    UnicodeRangeScanner scanner(ranges);
+
+    ASSERT_EQ(UnicodeRangeScanner::kMaxRanges, scanner.getRangesCount());
+
+    // All the given ranges are still matched
+    for (const auto& range : ranges) {
+        ASSERT_TRUE(scanner.contains(range.from));
+        ASSERT_TRUE(scanner.contains(range.to));
+    }
+
+    // The gaps between the pairs were filled, but not the gaps between the pairs
+    ASSERT_TRUE(scanner.contains(2));
+    ASSERT_TRUE(scanner.contains(3));
+    ASSERT_FALSE(scanner.contains(6));
+    ASSERT_FALSE(scanner.contains(0xFFF));
+}
+
+TEST(UnicodeRangeScanner, canFindFirst) {
+    UnicodeRangeScanner scanner({CharacterRange(0x1F600, 0x1F64F), CharacterRange(0xFE0F, 0xFE0F)});
+
+    std::vector<uint32_t> unicodePoints(37, 'a');
+    const auto* begin = unicodePoints.data();
+    const auto* end = begin + unicodePoints.size();
+
+    ASSERT_EQ(end, scanner.findFirst(begin, end));
+    ASSERT_EQ(begin, scanner.findFirst(begin, begin));
+
+    // Try every position, to cover both the vectorized blocks and the remaining tail
+    for (size_t i = 0; i < unicodePoints.size(); i++) {
+        unicodePoints[i] = 0x1F642;
+        ASSERT_EQ(begin + i, scanner.findFirst(begin, end));
+
+        unicodePoints[i] = 0x1F650;
+        ASSERT_EQ(end, scanner.findFirst(begin, end));
+
+        unicodePoints[i] = 'a';
+    }
+
+    unicodePoints[5] = 0xFE0F;
+    unicodePoints[6] = 0x1F600;
+    unicodePoints[30] = 0x1F64F;
+    ASSERT_EQ(begin + 5, scanner.findFirst(begin, end));
+    ASSERT_EQ(begin + 6, scanner.findFirst(begin + 6, end));
+    ASSERT_EQ(begin + 30, scanner.findFirst(begin + 7, end));
+    ASSERT_EQ(end, scanner.findFirst(begin + 31, end));
+}
+
+TEST(UnicodeRangeScanner, emptyScannerFindsNothing) {
+    UnicodeRangeScanner scanner;
+
+    std::vector<uint32_t> unicodePoints(8, 0);
+
+    ASSERT_FALSE(scanner.contains(0));
+    ASSERT_EQ(unicodePoints.data() + unicodePoints.size(),
+              scanner.findFirst(unicodePoints.data(), unicodePoints.data() + unicodePoints.size()));
+}
+
+} // namespace ValdiTest
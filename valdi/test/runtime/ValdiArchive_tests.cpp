@@ -1,5 +1,6 @@
 #include "valdi_core/cpp/Resources/ValdiArchive.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <algorithm>
 #include <gtest/gtest.h>
 
 using namespace Valdi;
@@ -39,4 +40,37 @@ TEST(ValdiArchive, supportsPadding) {
     ASSERT_EQ("!?", dataStr);
 }
 
+TEST(ValdiArchive, canBuildAsRope) {
+    auto largeData = makeShared<ByteBuffer>();
+    largeData->append(std::string(ByteRope::kMinReferencedSize + 1, 'a'));
+
+    ValdiArchiveBuilder builder;
+    builder.addEntry(ValdiArchiveEntry(STRING_LITERAL("small"), STRING_LITERAL("data")));
+    builder.addEntry(STRING_LITERAL("large"), largeData->toBytesView());
+
+    auto rope = builder.buildRope();
+    auto archiveBytes = builder.build();
+
+    // The large entry is referenced and not copied
+    auto chunks = rope->getChunks();
+    ASSERT_TRUE(std::any_of(
+        chunks.begin(), chunks.end(), [&](const BytesView& chunk) { return chunk.data() == largeData->data(); }));
+
+    ASSERT_EQ(archiveBytes->size(), rope->size());
+    auto ropeBytes = rope->toBytesView();
+    ASSERT_EQ(archiveBytes->toBytesView().asStringView(), ropeBytes.asStringView());
+
+    ValdiArchive archive(ropeBytes.begin(), ropeBytes.end());
+    auto result = archive.getEntries();
+    ASSERT_TRUE(result) << result.description();
+
+    const auto& entries = result.value();
+    ASSERT_EQ(static_cast<size_t>(2), entries.size());
+    ASSERT_EQ(STRING_LITERAL("small"), entries[0].filePath);
+    ASSERT_EQ(STRING_LITERAL("data"), entries[0].getStringData());
+    ASSERT_EQ(STRING_LITERAL("large"), entries[1].filePath);
+    ASSERT_EQ(largeData->toBytesView().asStringView(),
+              std::string_view(reinterpret_cast<const char*>(entries[1].data), entries[1].dataLength));
+}
+
 } // namespace ValdiTest
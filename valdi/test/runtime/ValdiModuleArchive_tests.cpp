@@ -0,0 +1,206 @@
+#include "valdi/runtime/Resources/ValdiModuleArchive.hpp"
+#include "valdi/runtime/Resources/ZStdUtils.hpp"
+#include "valdi_core/cpp/Resources/ValdiArchive.hpp"
+#include "valdi_core/cpp/Utils/DiskUtils.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "zstd/zdict.h"
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static std::string_view toStringView(const ValdiModuleArchiveEntry& entry) {
+    return std::string_view(reinterpret_cast<const char*>(entry.data), entry.size);
+}
+
+static constexpr std::string_view kSmallData = "!?";
+
+static Ref<ByteBuffer> makeSeekableArchive(const StringBox& compressibleData) {
+    std::vector<ValdiArchiveEntry> entries;
+    entries.emplace_back(STRING_LITERAL("index.js"), compressibleData);
+    entries.emplace_back(
+        STRING_LITERAL("a.txt"), reinterpret_cast<const Byte*>(kSmallData.data()), kSmallData.size());
+
+    auto result = ValdiModuleArchive::serializeSeekable(entries, true);
+    SC_ASSERT(result.success());
+    return result.moveValue();
+}
+
+static StringBox makeCompressibleData() {
+    std::string data;
+    for (size_t i = 0; i < 256; i++) {
+        data += "console.log('Hello World');\n";
+    }
+    return StringCache::getGlobal().makeString(data);
+}
+
+TEST(ValdiModuleArchive, canReadSeekableArchive) {
+    auto compressibleData = makeCompressibleData();
+    auto archiveBytes = makeSeekableArchive(compressibleData);
+
+    // The compressible entry should have been stored compressed
+    ASSERT_LT(archiveBytes->size(), compressibleData.length());
+
+    auto result = ValdiModuleArchive::decompress(archiveBytes->toBytesView());
+    ASSERT_TRUE(result) << result.description();
+
+    const auto& archive = result.value();
+
+    ASSERT_EQ(static_cast<size_t>(2), archive.getAllEntryPaths().size());
+    ASSERT_TRUE(archive.containsEntry(STRING_LITERAL("index.js")));
+    ASSERT_TRUE(archive.containsEntry(STRING_LITERAL("a.txt")));
+    ASSERT_FALSE(archive.containsEntry(STRING_LITERAL("b.txt")));
+
+    auto jsEntry = archive.getEntry(STRING_LITERAL("index.js"));
+    ASSERT_TRUE(jsEntry.has_value());
+    ASSERT_EQ(compressibleData.toStringView(), toStringView(jsEntry.value()));
+
+    auto textEntry = archive.getEntry(STRING_LITERAL("a.txt"));
+    ASSERT_TRUE(textEntry.has_value());
+    ASSERT_EQ(kSmallData, toStringView(textEntry.value()));
+
+    // Entries which are not compressed point directly into the archive
+    ASSERT_TRUE(textEntry.value().data >= archiveBytes->begin() && textEntry.value().data < archiveBytes->end());
+
+    ASSERT_FALSE(archive.getEntry(STRING_LITERAL("b.txt")).has_value());
+}
+
+TEST(ValdiModuleArchive, decompressesSeekableEntriesOnce) {
+    auto archiveBytes = makeSeekableArchive(makeCompressibleData());
+    auto archive = ValdiModuleArchive::decompress(archiveBytes->toBytesView()).moveValue();
+
+    auto entry = archive.getEntry(STRING_LITERAL("index.js"));
+    auto entryAgain = archive.getEntry(STRING_LITERAL("index.js"));
+
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_TRUE(entryAgain.has_value());
+    ASSERT_EQ(entry.value().data, entryAgain.value().data);
+}
+
+TEST(ValdiModuleArchive, rejectsTruncatedSeekableArchive) {
+    auto archiveBytes = makeSeekableArchive(makeCompressibleData());
+    auto truncated = BytesView(archiveBytes, archiveBytes->data(), archiveBytes->size() - 8);
+
+    auto result = ValdiModuleArchive::decompress(truncated);
+    ASSERT_FALSE(result);
+}
+
+TEST(ValdiModuleArchive, canReadMappedSeekableArchive) {
+    auto compressibleData = makeCompressibleData();
+    auto archiveBytes = makeSeekableArchive(compressibleData);
+
+    auto path = DiskUtils::temporaryFilePath();
+    ASSERT_TRUE(DiskUtils::store(path, archiveBytes->toBytesView()));
+
+    auto mapped = DiskUtils::loadMapped(path);
+    ASSERT_TRUE(mapped) << mapped.description();
+    ASSERT_EQ(archiveBytes->toBytesView(), mapped.value());
+
+    auto archive = ValdiModuleArchive::decompress(mapped.value()).moveValue();
+    DiskUtils::remove(path);
+
+    auto jsEntry = archive.getEntry(STRING_LITERAL("index.js"));
+    ASSERT_TRUE(jsEntry.has_value());
+    ASSERT_EQ(compressibleData.toStringView(), toStringView(jsEntry.value()));
+}
+
+TEST(ValdiModuleArchive, canReadSeekableArchiveMappedFromFileRegion) {
+    auto compressibleData = makeCompressibleData();
+    auto archiveBytes = makeSeekableArchive(compressibleData);
+
+    // Simulates an archive stored uncompressed within an APK, at an offset which is not page aligned
+    std::string container(5000, 'x');
+    auto archiveOffset = container.size();
+    container.append(reinterpret_cast<const char*>(archiveBytes->data()), archiveBytes->size());
+    container.append(100, 'y');
+
+    auto path = DiskUtils::temporaryFilePath();
+    ASSERT_TRUE(DiskUtils::store(path, container));
+
+    auto fd = ::open(path.toString().c_str(), O_RDONLY);
+    ASSERT_TRUE(fd >= 0);
+    auto mapped = DiskUtils::loadMappedFromFd(
+        fd, static_cast<int64_t>(archiveOffset), archiveBytes->size(), FileAccessPattern::Random);
+    ::close(fd);
+    DiskUtils::remove(path);
+
+    ASSERT_TRUE(mapped) << mapped.description();
+    ASSERT_EQ(archiveBytes->toBytesView(), mapped.value());
+
+    auto archive = ValdiModuleArchive::decompress(mapped.value()).moveValue();
+    auto jsEntry = archive.getEntry(STRING_LITERAL("index.js"));
+    ASSERT_TRUE(jsEntry.has_value());
+    ASSERT_EQ(compressibleData.toStringView(), toStringView(jsEntry.value()));
+}
+
+static Ref<ZStdDictionary> trainDictionary() {
+    std::string samples;
+    std::vector<size_t> sampleSizes;
+    for (size_t i = 0; i < 512; i++) {
+        auto sample = fmt::format("\"use strict\";\nObject.defineProperty(exports, \"__esModule\", "
+                                  "{{ value: true }});\nexports.Component{} = void 0;\n"
+                                  "const Component{} = require(\"valdi_core/src/Component\");\n"
+                                  "class Component{} extends Component_1.Component {{ onRender() {{ "
+                                  "<view width={{{}}} />; }} }}\n",
+                                  i,
+                                  i * 7,
+                                  i * 13,
+                                  i * 31);
+        samples += sample;
+        sampleSizes.emplace_back(sample.size());
+    }
+
+    std::vector<Byte> dictionaryBuffer(4096);
+    auto dictionarySize = ZDICT_trainFromBuffer(dictionaryBuffer.data(),
+                                                dictionaryBuffer.size(),
+                                                samples.data(),
+                                                sampleSizes.data(),
+                                                static_cast<unsigned>(sampleSizes.size()));
+    SC_ASSERT(ZDICT_isError(dictionarySize) == 0);
+
+    auto dictionaryBytes = makeShared<ByteBuffer>();
+    dictionaryBytes->append(dictionaryBuffer.data(), dictionaryBuffer.data() + dictionarySize);
+
+    auto dictionary = ZStdDictionary::registerDictionary(dictionaryBytes->toBytesView());
+    SC_ASSERT(dictionary.success());
+    return dictionary.moveValue();
+}
+
+TEST(ValdiModuleArchive, canReadSeekableArchiveCompressedWithDictionary) {
+    auto dictionary = trainDictionary();
+
+    auto jsData = STRING_LITERAL("\"use strict\";\nObject.defineProperty(exports, \"__esModule\", { value: true });\n"
+                                 "exports.MyComponent = void 0;\nconst Component_1 = require(\"valdi_core/src/"
+                                 "Component\");\nclass MyComponent extends Component_1.Component { onRender() { "
+                                 "<view width={42} />; } }\n");
+    std::vector<ValdiArchiveEntry> entries;
+    entries.emplace_back(STRING_LITERAL("index.js"), jsData);
+
+    auto withoutDictionary = ValdiModuleArchive::serializeSeekable(entries, true).moveValue();
+    auto withDictionary = ValdiModuleArchive::serializeSeekable(entries, true, dictionary.get()).moveValue();
+
+    ASSERT_LT(withDictionary->size(), withoutDictionary->size());
+
+    auto result = ValdiModuleArchive::decompress(withDictionary->toBytesView());
+    ASSERT_TRUE(result) << result.description();
+
+    auto jsEntry = result.value().getEntry(STRING_LITERAL("index.js"));
+    ASSERT_TRUE(jsEntry.has_value());
+    ASSERT_EQ(jsData.toStringView(), toStringView(jsEntry.value()));
+
+    // Whole-file decompression also picks up the dictionary from the frame
+    auto compressed =
+        ZStdUtils::compress(reinterpret_cast<const Byte*>(jsData.getCStr()), jsData.length(), 3, dictionary.get())
+            .moveValue();
+    auto decompressed = ZStdUtils::decompress(compressed->data(), compressed->size());
+    ASSERT_TRUE(decompressed) << decompressed.description();
+    ASSERT_EQ(jsData.toStringView(), decompressed.value()->toBytesView().asStringView());
+
+    // The dictionary is shared by all the users of the same ID
+    ASSERT_EQ(dictionary, ZStdDictionary::getRegisteredDictionary(dictionary->getId()));
+}
+
+} // namespace ValdiTest
@@ -0,0 +1,104 @@
+#include "valdi_core/cpp/Resources/ValdiPacket.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static Ref<ByteBuffer> makePackets(const std::vector<std::string>& payloads) {
+    auto out = makeShared<ByteBuffer>();
+    for (const auto& payload : payloads) {
+        ValdiPacket::write(reinterpret_cast<const Byte*>(payload.data()), payload.size(), *out);
+    }
+    return out;
+}
+
+static BytesView makeBytesView(const Byte* begin, const Byte* end) {
+    return makeShared<ByteBuffer>(begin, end)->toBytesView();
+}
+
+TEST(ValdiPacketStream, returnsPacketsWithoutCopyingWrittenBytes) {
+    auto packets = makePackets({"Hello", "World"});
+
+    ValdiPacketStream stream;
+    stream.write(packets->toBytesView());
+
+    auto packet1 = stream.read();
+    ASSERT_TRUE(packet1) << packet1.description();
+    ASSERT_EQ("Hello", packet1.value().asStringView());
+    ASSERT_EQ(packets->data() + ValdiPacket::minSize(), packet1.value().data());
+
+    auto packet2 = stream.read();
+    ASSERT_TRUE(packet2) << packet2.description();
+    ASSERT_EQ("World", packet2.value().asStringView());
+
+    auto packet3 = stream.read();
+    ASSERT_FALSE(packet3);
+    ASSERT_EQ(ValdiPacket::incompletePacketError(), packet3.error());
+}
+
+TEST(ValdiPacketStream, reassemblesSplitPackets) {
+    std::string largePayload(ValdiPacketStream::kMinChunkSize * 4, 'a');
+    auto packets = makePackets({"Hello", largePayload, "World"});
+
+    // Deliver the data in small pieces, splitting the headers as well
+    ValdiPacketStream stream;
+    std::vector<std::string> received;
+    size_t pieceSize = 3;
+    size_t offset = 0;
+    while (offset < packets->size()) {
+        auto end = std::min(offset + pieceSize, packets->size());
+        stream.write(makeBytesView(packets->data() + offset, packets->data() + end));
+        offset = end;
+        pieceSize = pieceSize * 2 + 1;
+
+        for (;;) {
+            auto packet = stream.read();
+            if (!packet) {
+                ASSERT_EQ(ValdiPacket::incompletePacketError(), packet.error());
+                break;
+            }
+            received.emplace_back(packet.value().asStringView());
+        }
+    }
+
+    ASSERT_EQ(std::vector<std::string>({"Hello", largePayload, "World"}), received);
+}
+
+TEST(ValdiPacketStream, keepsReturnedPacketsValid) {
+    auto packets = makePackets({"First", "Second"});
+    auto splitOffset = ValdiPacket::minSize() + 5 + 2;
+
+    ValdiPacketStream stream;
+    stream.write(makeBytesView(packets->data(), packets->data() + 1));
+    stream.write(makeBytesView(packets->data() + 1, packets->data() + splitOffset));
+
+    auto packet1 = stream.read();
+    ASSERT_TRUE(packet1) << packet1.description();
+
+    stream.write(makeBytesView(packets->data() + splitOffset, packets->end()));
+    stream.write(makePackets({std::string(ValdiPacketStream::kMinChunkSize * 2, 'b')})->toBytesView());
+
+    auto packet2 = stream.read();
+    ASSERT_TRUE(packet2) << packet2.description();
+    auto packet3 = stream.read();
+    ASSERT_TRUE(packet3) << packet3.description();
+
+    ASSERT_EQ("First", packet1.value().asStringView());
+    ASSERT_EQ("Second", packet2.value().asStringView());
+    ASSERT_EQ(std::string(ValdiPacketStream::kMinChunkSize * 2, 'b'), packet3.value().asStringView());
+}
+
+TEST(ValdiPacketStream, failsOnInvalidPacket) {
+    std::string invalid(ValdiPacket::minSize(), 'x');
+
+    ValdiPacketStream stream;
+    stream.write(makeBytesView(reinterpret_cast<const Byte*>(invalid.data()),
+                               reinterpret_cast<const Byte*>(invalid.data() + invalid.size())));
+
+    auto packet = stream.read();
+    ASSERT_FALSE(packet);
+    ASSERT_NE(ValdiPacket::incompletePacketError(), packet.error());
+}
+
+} // namespace ValdiTest
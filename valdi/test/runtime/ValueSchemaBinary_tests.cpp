@@ -0,0 +1,112 @@
+#include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Schema/ValueSchemaBinary.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+
+namespace ValdiTest {
+
+static ValueSchema parseSchema(std::string_view str) {
+    auto result = ValueSchema::parse(str);
+    SC_ASSERT(result.success(), result.description());
+    return result.moveValue();
+}
+
+TEST(ValueSchemaBinary, roundTripsSchemas) {
+    std::vector<ValueSchema> schemas = {
+        parseSchema("c 'MyObject' {'prop': b, 'optional': d?, 'boxed': i@?, 'untyped': u}"),
+        parseSchema("c+ 'MyInterface' {'method': f*(s, r:'MyObject'): p<t>, 'callback': f|w|(a<l>)}"),
+        parseSchema("e<s> 'MyStringEnum' {'good': 'OK', 'bad': 'NOT OK'}"),
+        parseSchema("e<i> 'MyIntEnum' {'ok': 200, 'not_found': 404}"),
+        parseSchema("c 'Generic' {'value': r:0, 'observable': g<o>:'Observable'<r:1, m<s, r<e>:'MyIntEnum'>>}"),
+        parseSchema("f!(): v"),
+        ValueSchema::cls(STRING_LITERAL("Collections"),
+                         false,
+                         {
+                             ClassPropertySchema(STRING_LITERAL("map"),
+                                                 ValueSchema::es6map(ValueSchema::string(), ValueSchema::date())),
+                             ClassPropertySchema(STRING_LITERAL("set"), ValueSchema::es6set(ValueSchema::integer())),
+                             ClassPropertySchema(STRING_LITERAL("outcome"),
+                                                 ValueSchema::outcome(ValueSchema::string(), ValueSchema::untyped())),
+                         }),
+    };
+
+    ValueSchemaBinaryBuilder builder;
+    for (size_t i = 0; i < schemas.size(); i++) {
+        auto index = builder.append(schemas[i]);
+        ASSERT_TRUE(index) << index.description();
+        ASSERT_EQ(i, index.value());
+    }
+
+    auto data = builder.build();
+    ValueSchemaBinaryTable table(data->data(), data->size());
+
+    auto size = table.size();
+    ASSERT_TRUE(size) << size.description();
+    ASSERT_EQ(schemas.size(), size.value());
+
+    // Schemas can be retrieved in any order
+    for (size_t i = schemas.size(); i > 0; i--) {
+        auto schema = table.getSchema(i - 1);
+        ASSERT_TRUE(schema) << schema.description();
+        ASSERT_EQ(schemas[i - 1], schema.value());
+        ASSERT_EQ(schemas[i - 1].toString(), schema.value().toString());
+    }
+
+    ASSERT_FALSE(table.getSchema(schemas.size()));
+}
+
+TEST(ValueSchemaBinary, storesNamesOnce) {
+    auto schema = parseSchema("c 'AVeryLongClassNameThatShouldOnlyBeStoredOnce' {'prop': "
+                              "r:'AVeryLongClassNameThatShouldOnlyBeStoredOnce'}");
+
+    ValueSchemaBinaryBuilder builder;
+    ASSERT_TRUE(builder.append(schema));
+    auto sizeWithOneSchema = builder.build()->size();
+
+    ASSERT_TRUE(builder.append(schema));
+    auto sizeWithTwoSchemas = builder.build()->size();
+
+    auto buffer = builder.build();
+    auto data = buffer->toBytesView().asStringView();
+    auto firstOccurrence = data.find("AVeryLongClassNameThatShouldOnlyBeStoredOnce");
+    ASSERT_NE(std::string_view::npos, firstOccurrence);
+    ASSERT_EQ(std::string_view::npos, data.find("AVeryLongClassNameThatShouldOnlyBeStoredOnce", firstOccurrence + 1));
+
+    ASSERT_LT(sizeWithTwoSchemas - sizeWithOneSchema,
+              std::string_view("AVeryLongClassNameThatShouldOnlyBeStoredOnce").size());
+}
+
+TEST(ValueSchemaBinary, failsOnUnsupportedSchemas) {
+    ValueSchemaBinaryBuilder builder;
+    std::string_view classNameParts[] = {"my", "Message"};
+    auto protoSchema = ValueSchema::proto(std::begin(classNameParts), std::end(classNameParts));
+    ASSERT_FALSE(builder.append(ValueSchema::array(protoSchema)));
+
+    // The builder should still be usable after a failure
+    auto index = builder.append(ValueSchema::string());
+    ASSERT_TRUE(index) << index.description();
+    ASSERT_EQ(static_cast<size_t>(0), index.value());
+
+    auto data = builder.build();
+    ValueSchemaBinaryTable table(data->data(), data->size());
+    auto schema = table.getSchema(0);
+    ASSERT_TRUE(schema) << schema.description();
+    ASSERT_EQ(ValueSchema::string(), schema.value());
+}
+
+TEST(ValueSchemaBinary, failsOnInvalidData) {
+    ValueSchemaBinaryBuilder builder;
+    ASSERT_TRUE(builder.append(parseSchema("c 'MyObject' {'prop': b}")));
+    auto data = builder.build();
+
+    ValueSchemaBinaryTable truncatedTable(data->data(), data->size() - 4);
+    ASSERT_FALSE(truncatedTable.getSchema(0));
+
+    ValueSchemaBinaryTable invalidTable(data->data() + 1, data->size() - 1);
+    ASSERT_FALSE(invalidTable.size());
+    ASSERT_FALSE(invalidTable.getSchema(0));
+}
+
+} // namespace ValdiTest
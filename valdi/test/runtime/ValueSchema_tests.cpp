@@ -11,6 +11,7 @@
 #include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace Valdi;
 
@@ -1097,4 +1098,36 @@ TEST(ValueSchema, failsOnInvalidTokens) {
     ASSERT_FALSE(result);
 }
 
+TEST(ValueSchema, registryLookupsReflectRegistryChanges) {
+    auto registry = makeShared<ValueSchemaRegistry>();
+    auto otherRegistry = makeShared<ValueSchemaRegistry>();
+    auto typeName = STRING_LITERAL("MyType");
+    auto typeKey = ValueSchemaRegistryKey(ValueSchema::typeReference(ValueSchemaTypeReference::named(typeName)));
+
+    ASSERT_EQ(nullptr, registry->getSchemaReferenceForTypeKey(typeKey));
+
+    auto identifier = registry->registerSchema(typeName, ValueSchema::integer());
+    otherRegistry->registerSchema(typeName, ValueSchema::string());
+
+    auto reference = registry->getSchemaReferenceForTypeKey(typeKey);
+    ASSERT_NE(nullptr, reference);
+    ASSERT_EQ(reference, registry->getSchemaReferenceForTypeKey(typeKey));
+    ASSERT_EQ(ValueSchema::integer(), reference->getSchema());
+    ASSERT_EQ(ValueSchema::string(), otherRegistry->getSchemaForTypeName(typeName).value());
+    ASSERT_EQ(ValueSchema::integer(), reference->getSchema());
+
+    registry->updateSchema(identifier, ValueSchema::doublePrecision());
+    ASSERT_EQ(ValueSchema::doublePrecision(), reference->getSchema());
+
+    // Lookups from other threads see the same registry state
+    std::thread([&]() {
+        ASSERT_EQ(reference, registry->getSchemaReferenceForTypeKey(typeKey));
+        ASSERT_EQ(ValueSchema::doublePrecision(), registry->getSchemaForTypeName(typeName).value());
+    }).join();
+
+    registry->unregisterSchema(identifier);
+    ASSERT_EQ(nullptr, registry->getSchemaReferenceForTypeKey(typeKey));
+    ASSERT_EQ(ValueSchema::voidType(), reference->getSchema());
+}
+
 } // namespace ValdiTest
@@ -162,6 +162,20 @@ TEST_P(ValueUtilsFixture, decodeCtrlCharactersToValue) {
     ASSERT_EQ(all, jsonToValue(STRING_LITERAL("{\"string\":\"\\t\\n\\f\\r\"}").toStringView(), getParseMode()).value());
 }
 
+TEST_P(ValueUtilsFixture, decodeNestedValues) {
+    auto json = STRING_LITERAL(
+        "{\"items\" : [{\"id\": -1, \"name\": \"first item name\"}, {\"id\": 2, \"name\": \"esc\\\"aped\"}]}");
+
+    Value expected;
+    expected.setMapValue("items",
+                         Value(ValueArray::make({
+                             Value().setMapValue("id", Value(-1.0)).setMapValue("name", Value("first item name")),
+                             Value().setMapValue("id", Value(2.0)).setMapValue("name", Value("esc\"aped")),
+                         })));
+
+    ASSERT_EQ(expected, jsonToValue(json.toStringView(), getParseMode()).value());
+}
+
 INSTANTIATE_TEST_SUITE_P(ValueUtilsTests,
                          ValueUtilsFixture,
                          ::testing::Values(JSONParseMode::PREFER_CORRECTNESS, JSONParseMode::PREFER_PERFORMANCE));
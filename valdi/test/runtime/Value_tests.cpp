@@ -203,6 +203,25 @@ TEST(Value, canCopySharedPointers) {
     ASSERT_EQ(1, map.use_count());
 }
 
+TEST(Value, canCopyAssignValueOwnedByReceiver) {
+    auto map = makeShared<ValueMap>();
+    {
+        auto array = ValueArray::make(1);
+        array->emplace(0, Value(map));
+
+        auto value = Value(array);
+        array = nullptr;
+
+        // The array is only kept alive by value, it must not be released before its item is copied
+        value = (*value.getArray())[0];
+
+        ASSERT_TRUE(value.isMap());
+        ASSERT_EQ(map.get(), value.getMap());
+        ASSERT_EQ(2, map.use_count());
+    }
+    ASSERT_EQ(1, map.use_count());
+}
+
 TEST(Value, canStoreFunctions) {
     auto array = Valdi::makeShared<std::vector<Value>>();
 
@@ -206,6 +206,31 @@ TEST(ViewNodeAccessibility, hasChildWithAccessibilityId) {
     ASSERT_EQ(children.size(), 1ul);
 }
 
+TEST(ViewNodeAccessibility, onlyInvalidatesAccessibilityTreeWhenAccessibilityChanges) {
+    ViewNodeTestsDependencies utils;
+
+    auto root = utils.createLayout();
+    auto child = utils.createView();
+    root->appendChild(utils.getViewTransactionScope(), child);
+
+    root->getAccessibilityChildrenRecursive();
+    ASSERT_FALSE(root->accessibilityTreeNeedsUpdate());
+
+    // Resetting accessibility attributes which were never set should be a no-op
+    child->setAccessibilityLabel(StringBox());
+    child->setAccessibilityPriority(0);
+    child->setAccessibilityNavigation(AccessibilityNavigationAuto);
+    ASSERT_FALSE(root->accessibilityTreeNeedsUpdate());
+    ASSERT_EQ(child->getAccessibilityNavigation(), AccessibilityNavigationPassthrough);
+
+    child->setAccessibilityLabel(STRING_LITERAL("accessibility-label"));
+    ASSERT_TRUE(root->accessibilityTreeNeedsUpdate());
+    ASSERT_EQ(child->getAccessibilityNavigation(), AccessibilityNavigationCover);
+
+    child->setAccessibilityLabel(StringBox());
+    ASSERT_EQ(child->getAccessibilityNavigation(), AccessibilityNavigationPassthrough);
+}
+
 TEST(ViewNodeAccessibility, isAccessibilityChildrenShallowSortedByPriority) {
     ViewNodeTestsDependencies utils;
 
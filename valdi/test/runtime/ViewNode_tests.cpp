@@ -336,6 +336,57 @@ TEST(ViewNode, providesLayoutDirtyFlagWhenLayoutAttributeChange) {
     ASSERT_EQ(2, rootView->getInvalidateLayoutCount());
 }
 
+TEST(ViewNode, confinesLayoutInvalidationToRelayoutBoundaries) {
+    ViewNodeTestsDependencies utils;
+
+    auto root = utils.createRootView();
+    auto container = utils.createView();
+    auto child = utils.createView();
+
+    root->appendChild(utils.getViewTransactionScope(), container);
+    container->appendChild(utils.getViewTransactionScope(), child);
+    utils.setViewNodeAttribute(container, "width", Value(50.0));
+    utils.setViewNodeAttribute(container, "height", Value(50.0));
+    utils.setViewNodeAttribute(container, "marginTop", Value(10.0));
+    utils.setViewNodeAttribute(child, "height", Value(10.0));
+    utils.getTree().setLayoutSpecs(Size(100, 100), LayoutDirectionLTR);
+    utils.getTree().performUpdates();
+
+    auto rootView = StandaloneView::unwrap(root->getView());
+
+    ASSERT_EQ(1, rootView->getInvalidateLayoutCount());
+    ASSERT_EQ(Frame(0, 0, 50, 10), child->getCalculatedFrame());
+
+    // The container has a fixed size, so the child cannot affect the layout outside of it
+    utils.setViewNodeAttribute(child, "height", Value(20.0));
+
+    ASSERT_EQ(1, rootView->getInvalidateLayoutCount());
+    ASSERT_FALSE(root->isFlexLayoutDirty());
+    ASSERT_TRUE(container->isFlexLayoutDirty());
+    ASSERT_TRUE(container->isRelayoutBoundaryDirty());
+
+    utils.getTree().performUpdates();
+
+    ASSERT_FALSE(container->isFlexLayoutDirty());
+    ASSERT_FALSE(child->isFlexLayoutDirty());
+    ASSERT_EQ(Frame(0, 10, 50, 50), container->getCalculatedFrame());
+    ASSERT_EQ(Frame(0, 0, 50, 20), child->getCalculatedFrame());
+
+    // Changes on the boundary itself still invalidate the whole layout
+    utils.setViewNodeAttribute(child, "height", Value(30.0));
+    utils.setViewNodeAttribute(container, "height", Value(60.0));
+
+    ASSERT_EQ(2, rootView->getInvalidateLayoutCount());
+    ASSERT_TRUE(root->isFlexLayoutDirty());
+    ASSERT_FALSE(container->isRelayoutBoundaryDirty());
+
+    utils.getTree().setLayoutSpecs(Size(100, 100), LayoutDirectionLTR);
+    utils.getTree().performUpdates();
+
+    ASSERT_EQ(Frame(0, 10, 50, 60), container->getCalculatedFrame());
+    ASSERT_EQ(Frame(0, 0, 50, 30), child->getCalculatedFrame());
+}
+
 TEST(ViewNode, supportsAllMeasureModes) {
     ViewNodeTestsDependencies utils;
 
@@ -684,6 +735,85 @@ TEST(ViewNode, canCalculateVisibilityUsingChildrenIndexer) {
     }
 }
 
+TEST(ViewNode, childrenIndexerReportsUpcomingChildren) {
+    ViewNodeTestsDependencies utils;
+
+    auto root = utils.createLayout();
+
+    std::vector<Ref<ViewNode>> children;
+
+    for (size_t i = 0; i < kMaxChildrenBeforeIndexing + 1; i++) {
+        auto newChild = utils.createLayout();
+        utils.setViewNodeFrame(newChild, 0, static_cast<double>(i) * 20, 20, 20);
+        root->appendChild(utils.getViewTransactionScope(), newChild);
+        children.emplace_back(std::move(newChild));
+    }
+
+    root->performLayout(utils.getViewTransactionScope(), Size(100, 100), LayoutDirectionLTR);
+
+    ViewNodeChildrenIndexer indexer(root.get());
+
+    auto result = indexer.findChildrenVisibility(Frame(0, 0, 100, 100));
+
+    // One viewport length after the visible children
+    ASSERT_EQ(static_cast<size_t>(5), result.visibleChildren->size());
+    ASSERT_EQ(static_cast<size_t>(5), result.upcomingChildren->size());
+    for (size_t i = 0; i < 5; i++) {
+        ASSERT_EQ(children[i + 5].get(), (*result.upcomingChildren)[i]);
+    }
+
+    result = indexer.findChildrenVisibility(Frame(0, 20, 100, 100));
+
+    // Only the children which entered the upcoming range are reported
+    ASSERT_EQ(static_cast<size_t>(1), result.upcomingChildren->size());
+    ASSERT_EQ(children[10].get(), (*result.upcomingChildren)[0]);
+
+    result = indexer.findChildrenVisibility(Frame(0, 20, 100, 100));
+
+    ASSERT_TRUE(result.upcomingChildren->empty());
+}
+
+TEST(ViewNode, childrenIndexerExtendsUpcomingChildrenInScrollDirection) {
+    ViewNodeTestsDependencies utils;
+
+    auto root = utils.createLayout();
+
+    std::vector<Ref<ViewNode>> children;
+
+    for (size_t i = 0; i < 30; i++) {
+        auto newChild = utils.createLayout();
+        utils.setViewNodeFrame(newChild, 0, static_cast<double>(i) * 20, 20, 20);
+        root->appendChild(utils.getViewTransactionScope(), newChild);
+        children.emplace_back(std::move(newChild));
+    }
+
+    root->performLayout(utils.getViewTransactionScope(), Size(100, 100), LayoutDirectionLTR);
+
+    ViewNodeChildrenIndexer indexer(root.get());
+
+    // Scrolling forward at 1000pt/s extends the upcoming range by the maximum of 3 viewports
+    auto result = indexer.findChildrenVisibility(Frame(0, 0, 100, 100), Point(0, 1000));
+
+    ASSERT_EQ(static_cast<size_t>(5), result.visibleChildren->size());
+    ASSERT_EQ(static_cast<size_t>(20), result.upcomingChildren->size());
+    for (size_t i = 0; i < 20; i++) {
+        ASSERT_EQ(children[i + 5].get(), (*result.upcomingChildren)[i]);
+    }
+
+    ViewNodeChildrenIndexer backwardIndexer(root.get());
+
+    // Scrolling backward reports the children before the viewport first, closest first
+    result = backwardIndexer.findChildrenVisibility(Frame(0, 400, 100, 100), Point(0, -1000));
+
+    ASSERT_EQ(static_cast<size_t>(25), result.upcomingChildren->size());
+    for (size_t i = 0; i < 20; i++) {
+        ASSERT_EQ(children[19 - i].get(), (*result.upcomingChildren)[i]);
+    }
+    for (size_t i = 0; i < 5; i++) {
+        ASSERT_EQ(children[25 + i].get(), (*result.upcomingChildren)[20 + i]);
+    }
+}
+
 TEST(ViewNode, canUseCustomViewport) {
     ViewNodeTestsDependencies utils;
 
@@ -1790,6 +1920,51 @@ TEST(ViewNode, canHandleLazyLayout) {
     ASSERT_EQ(Frame(8, 8, 8, 8), child->getCalculatedFrame());
 }
 
+TEST(ViewNode, canCalculateLazyLayoutsInParallel) {
+    ViewNodeTestsDependencies utils;
+    utils.getTree().setParallelLayoutEnabled(true);
+
+    auto root = utils.createRootView();
+    std::vector<Ref<ViewNode>> containers;
+    std::vector<Ref<ViewNode>> children;
+
+    for (size_t i = 0; i < 4; i++) {
+        auto container = utils.createLayout();
+        auto child = utils.createLayout();
+        container->setPrefersLazyLayout(utils.getViewTransactionScope(), true);
+
+        root->appendChild(utils.getViewTransactionScope(), container);
+        container->appendChild(utils.getViewTransactionScope(), child);
+
+        utils.setViewNodeFrame(container, 0, static_cast<float>(i) * 25, 50, 25);
+        utils.setViewNodeFrame(child, 4, 4, static_cast<float>(i) + 1, 8);
+
+        containers.emplace_back(container);
+        children.emplace_back(child);
+    }
+
+    root->performLayout(utils.getViewTransactionScope(), Size(100, 100), LayoutDirectionLTR);
+    root->updateVisibilityAndPerformUpdates(utils.getViewTransactionScope());
+
+    for (size_t i = 0; i < 4; i++) {
+        ASSERT_EQ(Frame(0, static_cast<float>(i) * 25, 50, 25), containers[i]->getCalculatedFrame());
+        ASSERT_EQ(Frame(4, 4, static_cast<float>(i) + 1, 8), children[i]->getCalculatedFrame());
+    }
+    ASSERT_FALSE(root->isLazyLayoutDirty());
+
+    utils.setViewNodeFrame(children[1], 2, 2, 10, 10);
+    utils.setViewNodeFrame(children[3], 1, 1, 20, 20);
+    ASSERT_TRUE(root->isLazyLayoutDirty());
+
+    root->updateVisibilityAndPerformUpdates(utils.getViewTransactionScope());
+
+    ASSERT_FALSE(root->isLazyLayoutDirty());
+    ASSERT_EQ(Frame(4, 4, 1, 8), children[0]->getCalculatedFrame());
+    ASSERT_EQ(Frame(2, 2, 10, 10), children[1]->getCalculatedFrame());
+    ASSERT_EQ(Frame(4, 4, 3, 8), children[2]->getCalculatedFrame());
+    ASSERT_EQ(Frame(1, 1, 20, 20), children[3]->getCalculatedFrame());
+}
+
 // TODO(simon): This test fails because we are not currently able to recover from switching
 // from non lazyLayout to lazyLayout after layout attributes have been applied.
 TEST(ViewNode, DISABLED_canToggleLazyLayout) {
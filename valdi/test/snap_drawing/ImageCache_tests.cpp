@@ -246,6 +246,42 @@ TEST_F(ImageCacheTests, overwritingImageEvictsHandledMultipleOriginalImagesGrace
     ASSERT_EQ(imgUnpacked.use_count(), 1);
 }
 
+TEST_F(ImageCacheTests, trimToSizeEvictsUnusedImages) {
+    {
+        auto result = getImage(_url, getWidth() / 2, getHeight() / 2);
+        ASSERT_TRUE(result);
+    }
+    ASSERT_GT(_cache->getCurrentSize(), _imgSize);
+
+    auto retainedImage = getImage(_url, getWidth(), getHeight());
+    _cache->trimToSize(0);
+    ASSERT_EQ(_cache->getCurrentSize(), _imgSize);
+
+    retainedImage = Valdi::Error("released");
+    _cache->trimToSize(0);
+    ASSERT_EQ(_cache->getCurrentSize(), static_cast<size_t>(0));
+}
+
+TEST_F(ImageCacheTests, downsampledImagesAreDecodedAgainForLargerSizes) {
+    auto encoded = Image::makeFromBitmap(createTestBitmap(), true)
+                       .value()
+                       ->resized(64, 48)
+                       ->encode(EncodedImageFormatJPG, 0.9)
+                       .value();
+    auto img = Image::make(encoded, 16, 12).value();
+    ASSERT_TRUE(img->isDownsampled());
+    ASSERT_EQ(img->width(), 16);
+    ASSERT_EQ(img->height(), 12);
+
+    auto url = STRING_LITERAL("asset://module/local-downsampled");
+    _cache->setCachedItemAndGetResizedImage(url, img, 16, 12);
+
+    ASSERT_TRUE(getImage(url, 16, 12));
+    ASSERT_TRUE(getImage(url, 8, 6));
+    ASSERT_FALSE(getImage(url, 32, 24));
+    ASSERT_FALSE(getImage(url, 0, 0));
+}
+
 class ImageCacheEvictionFixture : public ImageCacheTestsBase,
                                   public ::testing::TestWithParam<ImageCache::EvictionPolicy> {
 protected:
@@ -0,0 +1,54 @@
+#include "TestBitmap.hpp"
+#include "snap_drawing/cpp/Utils/Image.hpp"
+#include "valdi/snap_drawing/ImageLoading/ImageDiskCache.hpp"
+#include "valdi/standalone_runtime/InMemoryDiskCache.hpp"
+#include "valdi_core/cpp/Utils/ConsoleLogger.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace Valdi;
+using namespace snap::drawing;
+
+namespace ValdiTest {
+
+TEST(ImageDiskCache, canStoreAndLoadResizedImages) {
+    auto diskCache = makeShared<InMemoryDiskCache>();
+    auto imageDiskCache = makeShared<ImageDiskCache>(diskCache, ConsoleLogger::getLogger());
+    auto url = STRING_LITERAL("https://snap.com/image.png");
+
+    auto img = Image::makeFromBitmap(createTestBitmap(), true).value()->resized(4, 3);
+
+    ASSERT_FALSE(imageDiskCache->load(url, 4, 3));
+
+    imageDiskCache->store(url, 4, 3, img, 2.0f);
+
+    auto result = imageDiskCache->load(url, 4, 3);
+    ASSERT_TRUE(result) << result.description();
+    ASSERT_EQ(4, result.value()->width());
+    ASSERT_EQ(3, result.value()->height());
+    ASSERT_EQ(2.0f, result.value()->getDownsampleScale());
+    ASSERT_TRUE(result.value()->isDownsampled());
+
+    ASSERT_FALSE(imageDiskCache->load(url, 2, 1));
+    ASSERT_FALSE(imageDiskCache->load(STRING_LITERAL("https://snap.com/other.png"), 4, 3));
+}
+
+TEST(ImageDiskCache, trimClearsImagesAboveLimit) {
+    auto diskCache = makeShared<InMemoryDiskCache>();
+    auto imageDiskCache = makeShared<ImageDiskCache>(diskCache, ConsoleLogger::getLogger());
+    auto url = STRING_LITERAL("https://snap.com/image.png");
+
+    auto img = Image::makeFromBitmap(createTestBitmap(), true).value()->resized(4, 3);
+    imageDiskCache->store(url, 4, 3, img, 2.0f);
+    imageDiskCache->store(url, 2, 1, img, 4.0f);
+
+    imageDiskCache->trim(2);
+    ASSERT_TRUE(imageDiskCache->load(url, 4, 3));
+
+    imageDiskCache->trim(1);
+    ASSERT_FALSE(imageDiskCache->load(url, 4, 3));
+    ASSERT_FALSE(imageDiskCache->load(url, 2, 1));
+}
+
+} // namespace ValdiTest
@@ -206,4 +206,42 @@ TEST_F(ImageLoaderTests, getReturnsANewImageWithoutFilter) {
     ASSERT_EQ(img->getFilter(), nullptr);
 }
 
+TEST_F(ImageLoaderTests, blurIsAppliedOnceAndCached) {
+    _filter->setBlurRadius(2);
+
+    auto result1 = loadImage(_url, getWidth(), getHeight(), Valdi::Value(_filter));
+    ASSERT_TRUE(result1);
+    auto img1 = result1.moveValue();
+    ASSERT_EQ(img1->getFilter().get(), _filter.get());
+    ASSERT_TRUE(img1->getFilteredImage() != nullptr);
+    ASSERT_EQ(img1->getFilteredImage()->getFilter(), nullptr);
+    ASSERT_EQ(img1->getFilteredImage()->width(), img1->width());
+    ASSERT_EQ(img1->getFilteredImage()->height(), img1->height());
+
+    auto result2 = loadImage(_url, getWidth(), getHeight(), Valdi::Value(_filter));
+    ASSERT_TRUE(result2);
+    auto img2 = result2.moveValue();
+    ASSERT_EQ(img1->getFilteredImage().get(), img2->getFilteredImage().get());
+
+    // A different filter gets its own filtered image
+    auto otherFilter = _filter->withBlurRadius(4);
+    auto result3 = loadImage(_url, getWidth(), getHeight(), Valdi::Value(otherFilter));
+    ASSERT_TRUE(result3);
+    auto img3 = result3.moveValue();
+    ASSERT_TRUE(img3->getFilteredImage() != nullptr);
+    ASSERT_NE(img1->getFilteredImage().get(), img3->getFilteredImage().get());
+}
+
+TEST_F(ImageLoaderTests, colorMatrixIsAppliedWhenDrawing) {
+    const float greyscale[ImageFilter::kColorMatrixSize] = {0.33f, 0.33f, 0.33f, 0, 0, 0.33f, 0.33f, 0.33f, 0, 0,
+                                                            0.33f, 0.33f, 0.33f, 0, 0, 0,     0,     0,     1, 0};
+    _filter->concatColorMatrix(greyscale);
+
+    auto result = loadImage(_url, getWidth(), getHeight(), Valdi::Value(_filter));
+    ASSERT_TRUE(result);
+    auto img = result.moveValue();
+    ASSERT_EQ(img->getFilteredImage(), nullptr);
+    ASSERT_TRUE(img->getFilterColorFilter() != nullptr);
+}
+
 } // namespace ValdiTest
@@ -24,4 +24,11 @@ export class ColorPaletteTest extends Component {
       foreground: 'yellow'
     });
   }
+
+  updateForegroundColor() {
+    runtime.setColorPalette({
+      background: 'blue',
+      foreground: 'yellow'
+    });
+  }
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+//
+//  AllocationProfilerHooks.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+// Replaces the global operator new and delete so that heap allocations made through them are counted
+// by the AllocationProfiler while it is enabled. Only linked into the binaries which depend on
+// //valdi_core:allocation_profiler_hooks, which should be limited to debug and profiling builds.
+
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+void* allocate(size_t size) {
+    Valdi::AllocationProfiler::recordAllocation(Valdi::AllocationSite::OperatorNew, size);
+    return malloc(size > 0 ? size : 1); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void* allocateAligned(size_t size, std::align_val_t alignment) {
+    Valdi::AllocationProfiler::recordAllocation(Valdi::AllocationSite::OperatorNew, size);
+    void* ptr = nullptr;
+    auto alignmentValue = std::max(static_cast<size_t>(alignment), sizeof(void*));
+    if (posix_memalign(&ptr, alignmentValue, size > 0 ? size : 1) != 0) {
+        return nullptr;
+    }
+    return ptr;
+}
+
+void deallocate(void* ptr) {
+    free(ptr); // NOLINT(cppcoreguidelines-no-malloc)
+}
+
+void* allocateOrThrow(size_t size) {
+    auto* ptr = allocate(size);
+    if (ptr == nullptr) {
+        // Built without exceptions
+        std::abort();
+    }
+    return ptr;
+}
+
+void* allocateAlignedOrThrow(size_t size, std::align_val_t alignment) {
+    auto* ptr = allocateAligned(size, alignment);
+    if (ptr == nullptr) {
+        // Built without exceptions
+        std::abort();
+    }
+    return ptr;
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t& /*tag*/) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& /*tag*/) noexcept {
+    return allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& /*tag*/) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& /*tag*/) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t /*size*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t& /*tag*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t& /*tag*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t /*alignment*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t /*alignment*/, const std::nothrow_t& /*tag*/) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t /*alignment*/, const std::nothrow_t& /*tag*/) noexcept {
+    deallocate(ptr);
+}
@@ -175,8 +175,77 @@ std::vector<std::pair<std::string_view, int64_t>> getDefaultColors() {
     };
 }
 
+ColorPaletteChanges::ColorPaletteChanges() = default;
+
+ColorPaletteChanges::ColorPaletteChanges(size_t colorsCount) : _changed(colorsCount, false) {}
+
+void ColorPaletteChanges::insert(ColorId colorId) {
+    if (colorId >= _changed.size()) {
+        _changed.resize(colorId + 1, false);
+    }
+
+    if (!_changed[colorId]) {
+        _changed[colorId] = true;
+        _size++;
+    }
+}
+
+bool ColorPaletteChanges::contains(ColorId colorId) const {
+    return colorId < _changed.size() && _changed[colorId];
+}
+
+bool ColorPaletteChanges::containsAny(const ColorIds& colorIds) const {
+    for (auto colorId : colorIds) {
+        if (contains(colorId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ColorPaletteChanges::empty() const {
+    return _size == 0;
+}
+
+size_t ColorPaletteChanges::size() const {
+    return _size;
+}
+
+static thread_local ColorPaletteLookupRecorder* currentLookupRecorder = nullptr;
+
+ColorPaletteLookupRecorder::ColorPaletteLookupRecorder() : _previous(currentLookupRecorder) {
+    currentLookupRecorder = this;
+}
+
+ColorPaletteLookupRecorder::~ColorPaletteLookupRecorder() {
+    currentLookupRecorder = _previous;
+}
+
+const ColorIds& ColorPaletteLookupRecorder::getColorIds() const {
+    return _colorIds;
+}
+
+void ColorPaletteLookupRecorder::record(ColorId colorId) {
+    auto* recorder = currentLookupRecorder;
+    if (recorder == nullptr) {
+        return;
+    }
+
+    for (auto existingColorId : recorder->_colorIds) {
+        if (existingColorId == colorId) {
+            return;
+        }
+    }
+
+    recorder->_colorIds.emplace_back(colorId);
+}
+
 ColorPalette::ColorPalette() {
-    for (const auto& it : getDefaultColors()) {
+    auto defaultColors = getDefaultColors();
+    _colors.reserve(defaultColors.size());
+    _colorNames.reserve(defaultColors.size());
+
+    for (const auto& it : defaultColors) {
         setColorForName(StringCache::getGlobal().makeString(it.first), it.second);
     }
 }
@@ -184,45 +253,69 @@ ColorPalette::ColorPalette() {
 ColorPalette::~ColorPalette() = default;
 
 void ColorPalette::updateColors(const FlatMap<StringBox, Color>& colors) {
-    auto changed = false;
+    ColorPaletteChanges changes(_colors.size());
 
     for (const auto& it : colors) {
-        if (setColorForName(it.first, it.second)) {
-            changed = true;
+        auto changedColorId = setColorForName(it.first, it.second);
+        if (changedColorId) {
+            changes.insert(changedColorId.value());
         }
     }
 
-    if (changed) {
+    if (!changes.empty()) {
         if (_listener != nullptr) {
-            _listener->onColorPaletteUpdated(*this);
+            _listener->onColorPaletteUpdated(*this, changes);
         }
     }
 }
 
-bool ColorPalette::setColorForName(const StringBox& name, Color color) {
-    auto it = _colorByName.find(name);
-    if (it == _colorByName.end()) {
-        _colorByName[name] = color;
-        return true;
+std::optional<ColorId> ColorPalette::setColorForName(const StringBox& name, Color color) {
+    auto it = _colorIdByName.find(name);
+    if (it == _colorIdByName.end()) {
+        auto colorId = static_cast<ColorId>(_colors.size());
+        _colorIdByName[name] = colorId;
+        _colors.emplace_back(color);
+        _colorNames.emplace_back(name);
+        return {colorId};
     }
 
-    if (it->second != color) {
-        it->second = color;
-        return true;
+    auto& existingColor = _colors[it->second];
+    if (existingColor != color) {
+        existingColor = color;
+        return {it->second};
     }
-    return false;
+    return std::nullopt;
 }
 
 std::optional<Color> ColorPalette::getColorForName(const StringBox& name) const {
-    const auto& it = _colorByName.find(name);
-    if (it == _colorByName.end()) {
+    auto colorId = getColorIdForName(name);
+    if (!colorId) {
+        return std::nullopt;
+    }
+
+    ColorPaletteLookupRecorder::record(colorId.value());
+
+    return {_colors[colorId.value()]};
+}
+
+std::optional<ColorId> ColorPalette::getColorIdForName(const StringBox& name) const {
+    const auto& it = _colorIdByName.find(name);
+    if (it == _colorIdByName.end()) {
         return std::nullopt;
     }
     return {it->second};
 }
 
-const FlatMap<StringBox, Color>& ColorPalette::getColors() const {
-    return _colorByName;
+Color ColorPalette::getColorForId(ColorId colorId) const {
+    return _colors[colorId];
+}
+
+const StringBox& ColorPalette::getColorNameForId(ColorId colorId) const {
+    return _colorNames[colorId];
+}
+
+size_t ColorPalette::getColorsCount() const {
+    return _colors.size();
 }
 
 void ColorPalette::setListener(ColorPaletteListener* listener) {
@@ -9,6 +9,7 @@
 
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 
 #include <optional>
@@ -61,12 +62,66 @@ struct Color {
 
 std::ostream& operator<<(std::ostream& os, const Color& value);
 
+/**
+ Identifies a named color of a ColorPalette. Ids are dense and stable for
+ the lifetime of the palette, they index the colors of the palette directly.
+ */
+using ColorId = uint32_t;
+
+/**
+ The ids of the named colors that a value was resolved with.
+ */
+using ColorIds = SmallVector<ColorId, 2>;
+
+/**
+ The set of colors that changed during a ColorPalette update, indexed by ColorId.
+ */
+class ColorPaletteChanges {
+public:
+    ColorPaletteChanges();
+    explicit ColorPaletteChanges(size_t colorsCount);
+
+    void insert(ColorId colorId);
+
+    bool contains(ColorId colorId) const;
+    bool containsAny(const ColorIds& colorIds) const;
+
+    bool empty() const;
+    size_t size() const;
+
+private:
+    std::vector<bool> _changed;
+    size_t _size = 0;
+};
+
 class ColorPalette;
 
 class ColorPaletteListener {
 public:
     virtual ~ColorPaletteListener() = default;
-    virtual void onColorPaletteUpdated(const ColorPalette& colorPalette) = 0;
+    virtual void onColorPaletteUpdated(const ColorPalette& colorPalette, const ColorPaletteChanges& changes) = 0;
+};
+
+/**
+ Records the ids of the colors that are resolved by name on the current thread
+ while it is in scope. This is used to know which values need to be re-evaluated
+ when colors of the palette change.
+ */
+class ColorPaletteLookupRecorder {
+public:
+    ColorPaletteLookupRecorder();
+    ~ColorPaletteLookupRecorder();
+
+    ColorPaletteLookupRecorder(const ColorPaletteLookupRecorder&) = delete;
+    ColorPaletteLookupRecorder& operator=(const ColorPaletteLookupRecorder&) = delete;
+
+    const ColorIds& getColorIds() const;
+
+    static void record(ColorId colorId);
+
+private:
+    ColorPaletteLookupRecorder* _previous;
+    ColorIds _colorIds;
 };
 
 class ColorPalette : public SharedPtrRefCountable {
@@ -75,17 +130,23 @@ public:
     ~ColorPalette() override;
 
     std::optional<Color> getColorForName(const StringBox& name) const;
-    const FlatMap<StringBox, Color>& getColors() const;
+
+    std::optional<ColorId> getColorIdForName(const StringBox& name) const;
+    Color getColorForId(ColorId colorId) const;
+    const StringBox& getColorNameForId(ColorId colorId) const;
+    size_t getColorsCount() const;
 
     void updateColors(const FlatMap<StringBox, Color>& colors);
 
     void setListener(ColorPaletteListener* listener);
 
 private:
-    FlatMap<StringBox, Color> _colorByName;
+    FlatMap<StringBox, ColorId> _colorIdByName;
+    std::vector<Color> _colors;
+    std::vector<StringBox> _colorNames;
     ColorPaletteListener* _listener = nullptr;
 
-    bool setColorForName(const StringBox& name, Color color);
+    std::optional<ColorId> setColorForName(const StringBox& name, Color color);
 };
 
 } // namespace Valdi
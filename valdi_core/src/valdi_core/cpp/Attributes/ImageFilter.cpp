@@ -6,6 +6,10 @@
 //
 
 #include "valdi_core/cpp/Attributes/ImageFilter.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+
+#include <fmt/format.h>
+#include <iterator>
 
 namespace Valdi {
 
@@ -77,4 +81,16 @@ bool ImageFilter::isIdentityColorMatrix() const {
     return true;
 }
 
+StringBox ImageFilter::getSignature() const {
+    auto signature = fmt::format("blur={};matrix=", _blurRadius);
+    for (size_t i = 0; i < ImageFilter::kColorMatrixSize; i++) {
+        if (i > 0) {
+            signature += ',';
+        }
+        fmt::format_to(std::back_inserter(signature), "{}", _colorMatrix[i]);
+    }
+
+    return StringCache::getGlobal().makeString(signature);
+}
+
 } // namespace Valdi
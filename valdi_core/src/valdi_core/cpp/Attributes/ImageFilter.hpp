@@ -9,6 +9,7 @@
 
 #include <optional>
 
+#include "valdi_core/cpp/Utils/StringBox.hpp"
 #include "valdi_core/cpp/Utils/ValdiObject.hpp"
 
 namespace Valdi {
@@ -32,6 +33,12 @@ public:
 
     void concatColorMatrix(const float* colorMatrix);
 
+    /**
+     Returns a string which uniquely identifies the effect of this filter,
+     so that the results of applying it can be cached.
+     */
+    StringBox getSignature() const;
+
 private:
     float _colorMatrix[kColorMatrixSize];
     float _blurRadius = 0.0f;
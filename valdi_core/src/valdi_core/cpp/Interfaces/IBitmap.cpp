@@ -11,6 +11,10 @@ namespace Valdi {
 
 VALDI_CLASS_IMPL(IBitmap)
 
+void* IBitmap::getHardwareBuffer() {
+    return nullptr;
+}
+
 size_t BitmapInfo::bytesPerPixelForColorType(ColorType colorType) {
     switch (colorType) {
         case Valdi::ColorType::ColorTypeUnknown:
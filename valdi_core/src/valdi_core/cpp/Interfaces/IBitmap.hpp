@@ -58,6 +58,13 @@ public:
     virtual void* lockBytes() = 0;
     virtual void unlockBytes() = 0;
 
+    /**
+     Returns the GPU buffer which holds the pixels of the bitmap, as an AHardwareBuffer on Android,
+     or nullptr if the pixels are in CPU memory. A bitmap backed by a hardware buffer might not be
+     lockable, and should be imported as a texture instead.
+     */
+    virtual void* getHardwareBuffer();
+
     VALDI_CLASS_HEADER(IBitmap)
 };
 
@@ -11,6 +11,7 @@
 #include "valdi_core/cpp/Utils/InlineContainerAllocator.hpp"
 #include "valdi_core/cpp/Utils/Parser.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <cstring>
 
 namespace Valdi {
 
@@ -114,38 +115,53 @@ StringBox ValdiArchiveEntry::getStringData() const {
 
 ValdiArchiveBuilder::ValdiArchiveBuilder() = default;
 
-void ValdiArchiveBuilder::addEntry(const ValdiArchiveEntry& entry) {
-    _moduleData.reserve(_moduleData.size() + entry.dataLength + entry.filePath.length() + sizeof(uint32_t) * 2);
-
-    auto filenameLength = static_cast<uint32_t>(entry.filePath.length());
-    auto dataLength = static_cast<uint32_t>(entry.dataLength);
+template<typename F>
+void ValdiArchiveBuilder::appendEntry(const StringBox& filePath, size_t dataLength, F&& appendData) {
+    auto filenameLengthHeader = static_cast<uint32_t>(filePath.length());
+    auto dataLengthHeader = static_cast<uint32_t>(dataLength);
 
-    auto filenamePaddingLength = computePadding(entry.filePath.length());
-    auto dataPaddingLength = computePadding(entry.dataLength);
+    auto filenamePaddingLength = computePadding(filePath.length());
+    auto dataPaddingLength = computePadding(dataLength);
     if (filenamePaddingLength > 0) {
-        filenameLength |= kPaddingBit;
+        filenameLengthHeader |= kPaddingBit;
     }
     if (dataPaddingLength > 0) {
-        dataLength |= kPaddingBit;
+        dataLengthHeader |= kPaddingBit;
     }
-    _moduleData.append(reinterpret_cast<Byte*>(&filenameLength), reinterpret_cast<Byte*>(&filenameLength + 1));
-    _moduleData.append(entry.filePath.getCStr(), entry.filePath.getCStr() + entry.filePath.length());
+    _moduleData.append(reinterpret_cast<Byte*>(&filenameLengthHeader),
+                       reinterpret_cast<Byte*>(&filenameLengthHeader + 1));
+    _moduleData.append(filePath.toStringView());
     appendPadding(filenamePaddingLength);
 
-    _moduleData.append(reinterpret_cast<Byte*>(&dataLength), reinterpret_cast<Byte*>(&dataLength + 1));
-    _moduleData.append(entry.data, entry.data + entry.dataLength);
+    _moduleData.append(reinterpret_cast<Byte*>(&dataLengthHeader), reinterpret_cast<Byte*>(&dataLengthHeader + 1));
+    appendData();
     appendPadding(dataPaddingLength);
 }
 
+void ValdiArchiveBuilder::addEntry(const ValdiArchiveEntry& entry) {
+    appendEntry(
+        entry.filePath, entry.dataLength, [&]() { _moduleData.append(entry.data, entry.data + entry.dataLength); });
+}
+
+void ValdiArchiveBuilder::addEntry(const StringBox& filePath, const BytesView& data) {
+    appendEntry(filePath, data.size(), [&]() { _moduleData.append(data); });
+}
+
 void ValdiArchiveBuilder::appendPadding(size_t padding) {
-    for (size_t i = 0; i < padding; i++) {
-        _moduleData.append(static_cast<Byte>(0));
+    if (padding > 0) {
+        std::memset(_moduleData.appendWritable(padding), 0, padding);
     }
 }
 
 Ref<ByteBuffer> ValdiArchiveBuilder::build() const {
     auto out = makeShared<ByteBuffer>();
-    ValdiPacket::write(_moduleData.data(), _moduleData.size(), *out);
+    ValdiPacket::write(_moduleData, *out);
+    return out;
+}
+
+Ref<ByteRope> ValdiArchiveBuilder::buildRope() const {
+    auto out = makeShared<ByteRope>();
+    ValdiPacket::write(_moduleData, *out);
     return out;
 }
 
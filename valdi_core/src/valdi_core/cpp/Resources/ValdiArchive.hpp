@@ -8,6 +8,7 @@
 #pragma once
 
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/ByteRope.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
@@ -46,10 +47,28 @@ public:
 
     void addEntry(const ValdiArchiveEntry& entry);
 
+    /**
+     Add an entry whose data is retained by the archive instead of being copied,
+     when it is large enough.
+     */
+    void addEntry(const StringBox& filePath, const BytesView& data);
+
+    /**
+     Build the archive into a single buffer allocated at its final size.
+     */
     Ref<ByteBuffer> build() const;
 
+    /**
+     Build the archive as a ByteRope which shares the chunks of the builder,
+     which can be written with DiskUtils::store() without being flattened.
+     */
+    Ref<ByteRope> buildRope() const;
+
 private:
-    ByteBuffer _moduleData;
+    ByteRope _moduleData;
+
+    template<typename F>
+    void appendEntry(const StringBox& filePath, size_t dataLength, F&& appendData);
 
     void appendPadding(size_t padding);
 };
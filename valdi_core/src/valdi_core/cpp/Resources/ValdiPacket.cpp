@@ -9,6 +9,8 @@
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/Parser.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace Valdi {
 
@@ -38,12 +40,14 @@ Result<BytesView> ValdiPacket::read(const Byte* data, size_t size) {
         return ValdiPacket::incompletePacketError();
     }
 
-    const auto& moduleHeader = moduleHeaderResult.value();
-    if (moduleHeader->magic != kValdiMagic) {
-        return Error(STRING_FORMAT("magic is incorrect, expected {} got {}", kValdiMagic, moduleHeader->magic));
+    // Packets read from a stream are not necessarily aligned
+    ValdiPacketHeader moduleHeader;
+    std::memcpy(&moduleHeader, moduleHeaderResult.value(), sizeof(ValdiPacketHeader));
+    if (moduleHeader.magic != kValdiMagic) {
+        return Error(STRING_FORMAT("magic is incorrect, expected {} got {}", kValdiMagic, moduleHeader.magic));
     }
 
-    auto expectedLen = static_cast<size_t>(moduleHeader->totalDataLength);
+    auto expectedLen = static_cast<size_t>(moduleHeader.totalDataLength);
     const auto* expectedEndPtr = parser.getCurrent() + expectedLen;
     if (expectedEndPtr > dataEnd) {
         return ValdiPacket::incompletePacketError();
@@ -65,6 +69,35 @@ size_t ValdiPacket::write(const Byte* data, size_t size, ByteBuffer& out) {
     return size + sizeof(ValdiPacketHeader);
 }
 
+static ValdiPacketHeader makeHeader(size_t size) {
+    ValdiPacketHeader header;
+    header.magic = kValdiMagic;
+    header.totalDataLength = static_cast<uint32_t>(size);
+    return header;
+}
+
+size_t ValdiPacket::write(const ByteRope& data, ByteBuffer& out) {
+    auto header = makeHeader(data.size());
+
+    auto packetSize = sizeof(ValdiPacketHeader) + data.size();
+    out.reserve(out.size() + packetSize);
+    auto* output = out.appendWritable(packetSize);
+    std::memcpy(output, &header, sizeof(ValdiPacketHeader));
+    data.copyTo(output + sizeof(ValdiPacketHeader));
+
+    return packetSize;
+}
+
+size_t ValdiPacket::write(const ByteRope& data, ByteRope& out) {
+    auto header = makeHeader(data.size());
+
+    out.append(reinterpret_cast<const Byte*>(&header),
+               reinterpret_cast<const Byte*>(&header) + sizeof(ValdiPacketHeader));
+    out.append(data);
+
+    return data.size() + sizeof(ValdiPacketHeader);
+}
+
 const Error& ValdiPacket::incompletePacketError() {
     static auto kError = Error("Incomplete packet");
     return kError;
@@ -74,26 +107,111 @@ ValdiPacketStream::ValdiPacketStream() = default;
 ValdiPacketStream::~ValdiPacketStream() = default;
 
 void ValdiPacketStream::write(const BytesView& bytes) {
-    _buffer.append(bytes.begin(), bytes.end());
+    if (bytes.empty()) {
+        return;
+    }
+
+    auto hasBufferedData = !_pending.empty() || (_chunk != nullptr && _chunk->size() > _readOffset);
+    if (!hasBufferedData && bytes.getSource() != nullptr) {
+        _pending = bytes;
+        return;
+    }
+
+    if (!_pending.empty()) {
+        auto pending = std::move(_pending);
+        _pending = BytesView();
+        appendToChunk(pending.data(), pending.size());
+    }
+
+    appendToChunk(bytes.data(), bytes.size());
 }
 
-Result<BytesView> ValdiPacketStream::read() {
-    if (_buffer.size() < ValdiPacket::minSize()) {
+static size_t getPacketSize(const Byte* data, size_t size) {
+    if (size < sizeof(ValdiPacketHeader)) {
+        return 0;
+    }
+
+    ValdiPacketHeader header;
+    std::memcpy(&header, data, sizeof(ValdiPacketHeader));
+    return sizeof(ValdiPacketHeader) + static_cast<size_t>(header.totalDataLength);
+}
+
+void ValdiPacketStream::appendToChunk(const Byte* data, size_t size) {
+    if (_chunk != nullptr && _readOffset == _chunk->size() && _chunk.use_count() == 1) {
+        // The chunk was fully consumed and no packet retains it anymore
+        _chunk->clear();
+        _readOffset = 0;
+    }
+
+    if (_chunk != nullptr && _chunk->capacity() - _chunk->size() >= size) {
+        // Fits without reallocating, which keeps the previously returned slices valid
+        _chunk->append(data, data + size);
+        return;
+    }
+
+    const auto* unreadData = _chunk != nullptr ? _chunk->data() + _readOffset : nullptr;
+    auto unreadSize = _chunk != nullptr ? _chunk->size() - _readOffset : 0;
+
+    // Make room for the whole packet at once when its header is known
+    auto packetSize = getPacketSize(unreadData, unreadSize);
+    if (packetSize == 0 && unreadSize == 0) {
+        packetSize = getPacketSize(data, size);
+    }
+    auto capacity = std::max({kMinChunkSize, unreadSize + size, packetSize});
+
+    if (_chunk != nullptr && _chunk.use_count() == 1) {
+        // No packet retains the chunk, it can be compacted and reused
+        _chunk->shift(_readOffset);
+        _chunk->reserve(capacity);
+    } else {
+        auto chunk = makeShared<ByteBuffer>();
+        chunk->reserve(capacity);
+        if (unreadSize > 0) {
+            chunk->append(unreadData, unreadData + unreadSize);
+        }
+        _chunk = std::move(chunk);
+    }
+    _readOffset = 0;
+
+    _chunk->append(data, data + size);
+}
+
+Result<BytesView> ValdiPacketStream::readFromChunk() {
+    if (_chunk == nullptr || _chunk->size() - _readOffset < ValdiPacket::minSize()) {
         return ValdiPacket::incompletePacketError();
     }
 
-    auto result = ValdiPacket::read(_buffer.data(), _buffer.size());
+    auto result = ValdiPacket::read(_chunk->data() + _readOffset, _chunk->size() - _readOffset);
     if (!result) {
         return result;
     }
-    auto data = result.moveValue();
 
-    auto copy = makeShared<ByteBuffer>();
-    copy->append(data.begin(), data.end());
+    const auto& data = result.value();
+    _readOffset = static_cast<size_t>(data.end() - _chunk->data());
+
+    return BytesView(_chunk, data.data(), data.size());
+}
+
+Result<BytesView> ValdiPacketStream::read() {
+    if (_pending.empty()) {
+        return readFromChunk();
+    }
+
+    if (_pending.size() < ValdiPacket::minSize()) {
+        return ValdiPacket::incompletePacketError();
+    }
+
+    auto result = ValdiPacket::read(_pending.data(), _pending.size());
+    if (!result) {
+        return result;
+    }
 
-    _buffer.shift(data.end() - _buffer.data());
+    const auto& data = result.value();
+    auto packet = BytesView(_pending.getSource(), data.data(), data.size());
+    auto consumed = static_cast<size_t>(data.end() - _pending.data());
+    _pending = consumed < _pending.size() ? _pending.subrange(consumed, _pending.size() - consumed) : BytesView();
 
-    return copy->toBytesView();
+    return packet;
 }
 
 } // namespace Valdi
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/ByteRope.hpp"
 #include "valdi_core/cpp/Utils/Bytes.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
 
@@ -31,12 +32,33 @@ public:
      */
     static size_t write(const Byte* data, size_t size, ByteBuffer& out);
 
+    /**
+     Writes the data section as a Valdi packet into the given ByteBuffer,
+     which is grown once to its final size.
+     */
+    static size_t write(const ByteRope& data, ByteBuffer& out);
+
+    /**
+     Writes the data section as a Valdi packet into the given ByteRope.
+     Only the header is copied, the data section is appended by reference.
+     */
+    static size_t write(const ByteRope& data, ByteRope& out);
+
     /**
      Error sent when the packet is not complete
      */
     static const Error& incompletePacketError();
 };
 
+/**
+ Splits a stream of bytes into Valdi packets. The returned packets are slices which
+ retain the memory they were received in, they are not copied out of the stream:
+ - bytes written into an empty stream are kept as is, packets fully contained in
+ them are returned as slices of the written BytesView.
+ - remaining bytes are copied into a chunk large enough to hold the whole packet
+ once its header was received, so that large packets are copied only once.
+ Chunks which are not retained by any returned packet are reused.
+ */
 class ValdiPacketStream {
 public:
     ValdiPacketStream();
@@ -45,8 +67,15 @@ public:
     void write(const BytesView& bytes);
     Result<BytesView> read();
 
+    static constexpr size_t kMinChunkSize = 8192;
+
 private:
-    ByteBuffer _buffer;
+    BytesView _pending;
+    Ref<ByteBuffer> _chunk;
+    size_t _readOffset = 0;
+
+    Result<BytesView> readFromChunk();
+    void appendToChunk(const Byte* data, size_t size);
 };
 
 } // namespace Valdi
@@ -0,0 +1,689 @@
+//
+//  ValueSchemaBinary.cpp
+//  valdi_core
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Schema/ValueSchemaBinary.hpp"
+#include "valdi_core/cpp/Utils/Parser.hpp"
+#include "valdi_core/cpp/Utils/SmallVector.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Valdi {
+
+constexpr uint32_t kValueSchemaBinaryMagic = 0x31435356; // "VSC1"
+
+constexpr uint8_t kBinaryTypeMask = 0x3F;
+constexpr uint8_t kBinaryOptionalBit = 0x40;
+constexpr uint8_t kBinaryBoxedBit = 0x80;
+
+constexpr uint8_t kBinaryTypeReferencePositionalBit = 0x80;
+
+constexpr uint8_t kBinaryFunctionMethodBit = 1 << 0;
+constexpr uint8_t kBinaryFunctionSingleCallBit = 1 << 1;
+constexpr uint8_t kBinaryFunctionWorkerThreadBit = 1 << 2;
+
+constexpr uint8_t kBinaryEnumCaseInt = 0;
+constexpr uint8_t kBinaryEnumCaseString = 1;
+
+// The values are part of the binary format and should never be re-ordered
+enum ValueSchemaBinaryType : uint8_t {
+    ValueSchemaBinaryTypeUntyped = 0,
+    ValueSchemaBinaryTypeVoid,
+    ValueSchemaBinaryTypeInt,
+    ValueSchemaBinaryTypeLong,
+    ValueSchemaBinaryTypeDouble,
+    ValueSchemaBinaryTypeBoolean,
+    ValueSchemaBinaryTypeString,
+    ValueSchemaBinaryTypeValueTypedArray,
+    ValueSchemaBinaryTypeTypeReference,
+    ValueSchemaBinaryTypeGenericTypeReference,
+    ValueSchemaBinaryTypeClass,
+    ValueSchemaBinaryTypeEnum,
+    ValueSchemaBinaryTypeFunction,
+    ValueSchemaBinaryTypeArray,
+    ValueSchemaBinaryTypeMap,
+    ValueSchemaBinaryTypePromise,
+    ValueSchemaBinaryTypeES6Map,
+    ValueSchemaBinaryTypeES6Set,
+    ValueSchemaBinaryTypeOutcome,
+    ValueSchemaBinaryTypeDate,
+};
+
+static Error onTableFailure(const Error& error) {
+    return error.rethrow("Invalid ValueSchema binary table");
+}
+
+static void appendUInt32(ByteBuffer& buffer, uint32_t value) {
+    auto* dest = buffer.appendWritable(sizeof(uint32_t));
+    std::memcpy(dest, &value, sizeof(uint32_t));
+}
+
+ValueSchemaBinaryBuilder::ValueSchemaBinaryBuilder() = default;
+ValueSchemaBinaryBuilder::~ValueSchemaBinaryBuilder() = default;
+
+Result<size_t> ValueSchemaBinaryBuilder::append(const ValueSchema& schema) {
+    auto offset = _schemasData.size();
+    auto result = write(schema);
+    if (!result) {
+        _schemasData.resize(offset);
+        return result.moveError();
+    }
+
+    _schemaOffsets.emplace_back(static_cast<uint32_t>(offset));
+    return _schemaOffsets.size() - 1;
+}
+
+Ref<ByteBuffer> ValueSchemaBinaryBuilder::build() const {
+    auto out = makeShared<ByteBuffer>();
+    appendUInt32(*out, kValueSchemaBinaryMagic);
+
+    appendUInt32(*out, static_cast<uint32_t>(_strings.size()));
+    for (const auto& str : _strings) {
+        appendUInt32(*out, static_cast<uint32_t>(str.length()));
+        out->append(str.toStringView());
+    }
+
+    appendUInt32(*out, static_cast<uint32_t>(_schemaOffsets.size()));
+    for (auto offset : _schemaOffsets) {
+        appendUInt32(*out, offset);
+    }
+
+    out->append(_schemasData.begin(), _schemasData.end());
+
+    return out;
+}
+
+Result<Void> ValueSchemaBinaryBuilder::write(const ValueSchema& schema) {
+    uint8_t flags = 0;
+    if (schema.isOptional()) {
+        flags |= kBinaryOptionalBit;
+    }
+    if (schema.isBoxed()) {
+        flags |= kBinaryBoxedBit;
+    }
+
+    if (schema.isUntyped()) {
+        writeByte(ValueSchemaBinaryTypeUntyped | flags);
+    } else if (schema.isVoid()) {
+        writeByte(ValueSchemaBinaryTypeVoid | flags);
+    } else if (schema.isInteger()) {
+        writeByte(ValueSchemaBinaryTypeInt | flags);
+    } else if (schema.isLongInteger()) {
+        writeByte(ValueSchemaBinaryTypeLong | flags);
+    } else if (schema.isDouble()) {
+        writeByte(ValueSchemaBinaryTypeDouble | flags);
+    } else if (schema.isBoolean()) {
+        writeByte(ValueSchemaBinaryTypeBoolean | flags);
+    } else if (schema.isString()) {
+        writeByte(ValueSchemaBinaryTypeString | flags);
+    } else if (schema.isValueTypedArray()) {
+        writeByte(ValueSchemaBinaryTypeValueTypedArray | flags);
+    } else if (schema.isDate()) {
+        writeByte(ValueSchemaBinaryTypeDate | flags);
+    } else if (schema.isTypeReference()) {
+        writeByte(ValueSchemaBinaryTypeTypeReference | flags);
+        write(schema.getTypeReference());
+    } else if (schema.isGenericTypeReference()) {
+        const auto* genericTypeReference = schema.getGenericTypeReference();
+        writeByte(ValueSchemaBinaryTypeGenericTypeReference | flags);
+        write(genericTypeReference->getType());
+        writeUInt32(static_cast<uint32_t>(genericTypeReference->getTypeArgumentsSize()));
+        for (size_t i = 0; i < genericTypeReference->getTypeArgumentsSize(); i++) {
+            auto result = write(genericTypeReference->getTypeArgument(i));
+            if (!result) {
+                return result;
+            }
+        }
+    } else if (schema.isClass()) {
+        const auto* classSchema = schema.getClass();
+        writeByte(ValueSchemaBinaryTypeClass | flags);
+        writeByte(classSchema->isInterface() ? 1 : 0);
+        writeString(classSchema->getClassName());
+        writeUInt32(static_cast<uint32_t>(classSchema->getPropertiesSize()));
+        for (const auto& property : *classSchema) {
+            writeString(property.name);
+            auto result = write(property.schema);
+            if (!result) {
+                return result;
+            }
+        }
+    } else if (schema.isEnum()) {
+        const auto* enumSchema = schema.getEnum();
+        writeByte(ValueSchemaBinaryTypeEnum | flags);
+        auto result = write(enumSchema->getCaseSchema());
+        if (!result) {
+            return result;
+        }
+        writeString(enumSchema->getName());
+        writeUInt32(static_cast<uint32_t>(enumSchema->getCasesSize()));
+        for (const auto& enumCase : *enumSchema) {
+            writeString(enumCase.name);
+            if (enumCase.value.isString()) {
+                writeByte(kBinaryEnumCaseString);
+                writeString(enumCase.value.toStringBox());
+            } else if (enumCase.value.isNumber()) {
+                writeByte(kBinaryEnumCaseInt);
+                writeUInt32(static_cast<uint32_t>(enumCase.value.toInt()));
+            } else {
+                return Error(STRING_FORMAT("Unsupported value for enum case '{}' of enum '{}'",
+                                           enumCase.name.toStringView(),
+                                           enumSchema->getName().toStringView()));
+            }
+        }
+    } else if (schema.isFunction()) {
+        const auto* function = schema.getFunction();
+        const auto& attributes = function->getAttributes();
+        uint8_t attributeBits = 0;
+        if (attributes.isMethod()) {
+            attributeBits |= kBinaryFunctionMethodBit;
+        }
+        if (attributes.isSingleCall()) {
+            attributeBits |= kBinaryFunctionSingleCallBit;
+        }
+        if (attributes.shouldDispatchToWorkerThread()) {
+            attributeBits |= kBinaryFunctionWorkerThreadBit;
+        }
+
+        writeByte(ValueSchemaBinaryTypeFunction | flags);
+        writeByte(attributeBits);
+        auto result = write(function->getReturnValue());
+        if (!result) {
+            return result;
+        }
+        writeUInt32(static_cast<uint32_t>(function->getParametersSize()));
+        for (size_t i = 0; i < function->getParametersSize(); i++) {
+            auto parameterResult = write(function->getParameter(i));
+            if (!parameterResult) {
+                return parameterResult;
+            }
+        }
+    } else if (schema.isArray()) {
+        writeByte(ValueSchemaBinaryTypeArray | flags);
+        return write(schema.getArray()->getElementSchema());
+    } else if (schema.isPromise()) {
+        writeByte(ValueSchemaBinaryTypePromise | flags);
+        return write(schema.getPromise()->getValueSchema());
+    } else if (schema.isES6Set()) {
+        writeByte(ValueSchemaBinaryTypeES6Set | flags);
+        return write(schema.getES6Set()->getKey());
+    } else if (schema.isMap() || schema.isES6Map() || schema.isOutcome()) {
+        const ValueSchema* first;
+        const ValueSchema* second;
+        if (schema.isMap()) {
+            writeByte(ValueSchemaBinaryTypeMap | flags);
+            first = &schema.getMap()->getKey();
+            second = &schema.getMap()->getValue();
+        } else if (schema.isES6Map()) {
+            writeByte(ValueSchemaBinaryTypeES6Map | flags);
+            first = &schema.getES6Map()->getKey();
+            second = &schema.getES6Map()->getValue();
+        } else {
+            writeByte(ValueSchemaBinaryTypeOutcome | flags);
+            first = &schema.getOutcome()->getValue();
+            second = &schema.getOutcome()->getError();
+        }
+
+        auto result = write(*first);
+        if (!result) {
+            return result;
+        }
+        return write(*second);
+    } else {
+        return Error(STRING_FORMAT("Schema '{}' cannot be written in a binary table", schema.toString()));
+    }
+
+    return Void();
+}
+
+void ValueSchemaBinaryBuilder::write(const ValueSchemaTypeReference& typeReference) {
+    if (typeReference.isPositional()) {
+        writeByte(kBinaryTypeReferencePositionalBit);
+        writeByte(typeReference.getPosition());
+    } else {
+        writeByte(static_cast<uint8_t>(typeReference.getTypeHint()));
+        writeString(typeReference.getName());
+    }
+}
+
+void ValueSchemaBinaryBuilder::writeString(const StringBox& str) {
+    const auto& it = _stringIndexes.find(str);
+    if (it != _stringIndexes.end()) {
+        writeUInt32(it->second);
+        return;
+    }
+
+    auto index = static_cast<uint32_t>(_strings.size());
+    _strings.emplace_back(str);
+    _stringIndexes[str] = index;
+    writeUInt32(index);
+}
+
+void ValueSchemaBinaryBuilder::writeUInt32(uint32_t value) {
+    appendUInt32(_schemasData, value);
+}
+
+void ValueSchemaBinaryBuilder::writeByte(uint8_t value) {
+    _schemasData.append(static_cast<Byte>(value));
+}
+
+namespace {
+
+template<typename T>
+using ReadListVector = SmallVector<T, 20>;
+
+class ValueSchemaBinaryReader {
+public:
+    ValueSchemaBinaryReader(const Byte* begin, const Byte* end, const std::vector<StringBox>& strings)
+        : _current(begin), _end(end), _strings(strings) {}
+
+    std::optional<ValueSchema> readSchema() {
+        uint8_t header;
+        if (!readByte(header)) {
+            return std::nullopt;
+        }
+
+        auto schema = readSchemaOfType(static_cast<ValueSchemaBinaryType>(header & kBinaryTypeMask));
+        if (!schema) {
+            return std::nullopt;
+        }
+
+        if ((header & kBinaryBoxedBit) != 0) {
+            schema = ValueSchema::boxed(std::move(schema.value()));
+        }
+        if ((header & kBinaryOptionalBit) != 0) {
+            schema = ValueSchema::optional(std::move(schema.value()));
+        }
+
+        return schema;
+    }
+
+    const Error& getError() const {
+        return _error;
+    }
+
+private:
+    const Byte* _current;
+    const Byte* _end;
+    const std::vector<StringBox>& _strings;
+    Error _error;
+
+    bool setError(std::string_view message) {
+        _error = Error(StringCache::getGlobal().makeString(message));
+        return false;
+    }
+
+    bool readByte(uint8_t& out) {
+        if (_current == _end) {
+            return setError("Unexpected end of schema");
+        }
+        out = static_cast<uint8_t>(*_current);
+        _current++;
+        return true;
+    }
+
+    bool readUInt32(uint32_t& out) {
+        if (static_cast<size_t>(_end - _current) < sizeof(uint32_t)) {
+            return setError("Unexpected end of schema");
+        }
+        std::memcpy(&out, _current, sizeof(uint32_t));
+        _current += sizeof(uint32_t);
+        return true;
+    }
+
+    bool readString(StringBox& out) {
+        uint32_t index;
+        if (!readUInt32(index)) {
+            return false;
+        }
+        if (index >= _strings.size()) {
+            return setError("Out of bounds string index");
+        }
+        out = _strings[index];
+        return true;
+    }
+
+    bool readTypeReference(ValueSchemaTypeReference& out) {
+        uint8_t header;
+        if (!readByte(header)) {
+            return false;
+        }
+
+        if ((header & kBinaryTypeReferencePositionalBit) != 0) {
+            uint8_t position;
+            if (!readByte(position)) {
+                return false;
+            }
+            out = ValueSchemaTypeReference::positional(position);
+            return true;
+        }
+
+        if (header > ValueSchemaTypeReferenceTypeHintConverted) {
+            return setError("Invalid type reference type hint");
+        }
+
+        StringBox name;
+        if (!readString(name)) {
+            return false;
+        }
+        out = ValueSchemaTypeReference::named(static_cast<ValueSchemaTypeReferenceTypeHint>(header), name);
+        return true;
+    }
+
+    bool readSchemas(ReadListVector<ValueSchema>& out) {
+        uint32_t size;
+        if (!readUInt32(size)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < size; i++) {
+            auto schema = readSchema();
+            if (!schema) {
+                return false;
+            }
+            out.emplace_back(std::move(schema.value()));
+        }
+        return true;
+    }
+
+    std::optional<ValueSchema> readGenericTypeReference() {
+        ValueSchemaTypeReference typeReference;
+        if (!readTypeReference(typeReference)) {
+            return std::nullopt;
+        }
+        ReadListVector<ValueSchema> typeArguments;
+        if (!readSchemas(typeArguments)) {
+            return std::nullopt;
+        }
+
+        return ValueSchema::genericTypeReference(typeReference, typeArguments.data(), typeArguments.size());
+    }
+
+    std::optional<ValueSchema> readClass() {
+        uint8_t isInterface;
+        StringBox className;
+        uint32_t propertiesSize;
+        if (!readByte(isInterface) || !readString(className) || !readUInt32(propertiesSize)) {
+            return std::nullopt;
+        }
+
+        ReadListVector<ClassPropertySchema> properties;
+        for (uint32_t i = 0; i < propertiesSize; i++) {
+            auto& property = properties.emplace_back();
+            if (!readString(property.name)) {
+                return std::nullopt;
+            }
+            auto propertySchema = readSchema();
+            if (!propertySchema) {
+                return std::nullopt;
+            }
+            property.schema = std::move(propertySchema.value());
+        }
+
+        return ValueSchema::cls(className, isInterface != 0, properties.data(), properties.size());
+    }
+
+    std::optional<ValueSchema> readEnum() {
+        auto caseSchema = readSchema();
+        if (!caseSchema) {
+            return std::nullopt;
+        }
+
+        StringBox name;
+        uint32_t casesSize;
+        if (!readString(name) || !readUInt32(casesSize)) {
+            return std::nullopt;
+        }
+
+        ReadListVector<EnumCaseSchema> cases;
+        for (uint32_t i = 0; i < casesSize; i++) {
+            auto& enumCase = cases.emplace_back();
+            uint8_t caseType;
+            if (!readString(enumCase.name) || !readByte(caseType)) {
+                return std::nullopt;
+            }
+
+            if (caseType == kBinaryEnumCaseString) {
+                StringBox caseValue;
+                if (!readString(caseValue)) {
+                    return std::nullopt;
+                }
+                enumCase.value = Value(caseValue);
+            } else {
+                uint32_t caseValue;
+                if (!readUInt32(caseValue)) {
+                    return std::nullopt;
+                }
+                enumCase.value = Value(static_cast<int32_t>(caseValue));
+            }
+        }
+
+        return ValueSchema::enumeration(name, caseSchema.value(), cases.data(), cases.size());
+    }
+
+    std::optional<ValueSchema> readFunction() {
+        uint8_t attributeBits;
+        if (!readByte(attributeBits)) {
+            return std::nullopt;
+        }
+        auto returnValue = readSchema();
+        if (!returnValue) {
+            return std::nullopt;
+        }
+        ReadListVector<ValueSchema> parameters;
+        if (!readSchemas(parameters)) {
+            return std::nullopt;
+        }
+
+        ValueFunctionSchemaAttributes attributes((attributeBits & kBinaryFunctionMethodBit) != 0,
+                                                 (attributeBits & kBinaryFunctionSingleCallBit) != 0,
+                                                 (attributeBits & kBinaryFunctionWorkerThreadBit) != 0);
+
+        return ValueSchema::function(attributes, returnValue.value(), parameters.data(), parameters.size());
+    }
+
+    template<typename F>
+    std::optional<ValueSchema> readPair(F&& factory) {
+        auto first = readSchema();
+        if (!first) {
+            return std::nullopt;
+        }
+        auto second = readSchema();
+        if (!second) {
+            return std::nullopt;
+        }
+        return factory(std::move(first.value()), std::move(second.value()));
+    }
+
+    std::optional<ValueSchema> readSchemaOfType(ValueSchemaBinaryType type) {
+        switch (type) {
+            case ValueSchemaBinaryTypeUntyped:
+                return ValueSchema::untyped();
+            case ValueSchemaBinaryTypeVoid:
+                return ValueSchema::voidType();
+            case ValueSchemaBinaryTypeInt:
+                return ValueSchema::integer();
+            case ValueSchemaBinaryTypeLong:
+                return ValueSchema::longInteger();
+            case ValueSchemaBinaryTypeDouble:
+                return ValueSchema::doublePrecision();
+            case ValueSchemaBinaryTypeBoolean:
+                return ValueSchema::boolean();
+            case ValueSchemaBinaryTypeString:
+                return ValueSchema::string();
+            case ValueSchemaBinaryTypeValueTypedArray:
+                return ValueSchema::valueTypedArray();
+            case ValueSchemaBinaryTypeDate:
+                return ValueSchema::date();
+            case ValueSchemaBinaryTypeTypeReference: {
+                ValueSchemaTypeReference typeReference;
+                if (!readTypeReference(typeReference)) {
+                    return std::nullopt;
+                }
+                return ValueSchema::typeReference(typeReference);
+            }
+            case ValueSchemaBinaryTypeGenericTypeReference:
+                return readGenericTypeReference();
+            case ValueSchemaBinaryTypeClass:
+                return readClass();
+            case ValueSchemaBinaryTypeEnum:
+                return readEnum();
+            case ValueSchemaBinaryTypeFunction:
+                return readFunction();
+            case ValueSchemaBinaryTypeArray: {
+                auto item = readSchema();
+                if (!item) {
+                    return std::nullopt;
+                }
+                return ValueSchema::array(std::move(item.value()));
+            }
+            case ValueSchemaBinaryTypePromise: {
+                auto value = readSchema();
+                if (!value) {
+                    return std::nullopt;
+                }
+                return ValueSchema::promise(std::move(value.value()));
+            }
+            case ValueSchemaBinaryTypeES6Set: {
+                auto key = readSchema();
+                if (!key) {
+                    return std::nullopt;
+                }
+                return ValueSchema::es6set(key.value());
+            }
+            case ValueSchemaBinaryTypeMap:
+                return readPair([](ValueSchema&& key, ValueSchema&& value) {
+                    return ValueSchema::map(std::move(key), std::move(value));
+                });
+            case ValueSchemaBinaryTypeES6Map:
+                return readPair([](ValueSchema&& key, ValueSchema&& value) { return ValueSchema::es6map(key, value); });
+            case ValueSchemaBinaryTypeOutcome:
+                return readPair([](ValueSchema&& value, ValueSchema&& error) {
+                    return ValueSchema::outcome(value, error);
+                });
+        }
+
+        setError("Unrecognized schema type");
+        return std::nullopt;
+    }
+};
+
+} // namespace
+
+ValueSchemaBinaryTable::ValueSchemaBinaryTable(const Byte* data, size_t size) : _data(data), _size(size) {}
+ValueSchemaBinaryTable::~ValueSchemaBinaryTable() = default;
+
+Result<size_t> ValueSchemaBinaryTable::size() {
+    std::lock_guard<Mutex> guard(_mutex);
+    auto loadResult = lockFreeLoad();
+    if (!loadResult) {
+        return loadResult.moveError();
+    }
+
+    return _schemasCount;
+}
+
+Result<ValueSchema> ValueSchemaBinaryTable::getSchema(size_t index) {
+    std::lock_guard<Mutex> guard(_mutex);
+    auto loadResult = lockFreeLoad();
+    if (!loadResult) {
+        return loadResult.moveError();
+    }
+
+    if (index >= _schemasCount) {
+        return Error(STRING_FORMAT("Schema index {} out of bounds, table has {} schemas", index, _schemasCount));
+    }
+
+    uint32_t offset;
+    std::memcpy(&offset, _schemaOffsets + index * sizeof(uint32_t), sizeof(uint32_t));
+    if (offset >= _schemasDataSize) {
+        return onTableFailure(Error("Out of bounds schema offset"));
+    }
+
+    ValueSchemaBinaryReader reader(_schemasData + offset, _schemasData + _schemasDataSize, _strings);
+    auto schema = reader.readSchema();
+    if (!schema) {
+        return onTableFailure(reader.getError());
+    }
+
+    return schema.value();
+}
+
+Result<Void> ValueSchemaBinaryTable::lockFreeLoad() {
+    if (!_loaded) {
+        auto result = lockFreeDoLoad();
+        if (!result) {
+            _loadError = onTableFailure(result.error());
+        }
+        _loaded = true;
+    }
+
+    if (_loadError) {
+        return _loadError.value();
+    }
+
+    return Void();
+}
+
+Result<Void> ValueSchemaBinaryTable::lockFreeDoLoad() {
+    Parser<Byte> parser(_data, _data + _size);
+
+    auto readUInt32 = [&]() -> Result<uint32_t> {
+        auto bytes = parser.parse<Byte>(sizeof(uint32_t));
+        if (!bytes) {
+            return bytes.moveError();
+        }
+        uint32_t value;
+        std::memcpy(&value, bytes.value(), sizeof(uint32_t));
+        return value;
+    };
+
+    auto magic = readUInt32();
+    if (!magic) {
+        return magic.moveError();
+    }
+    if (magic.value() != kValueSchemaBinaryMagic) {
+        return Error("Invalid magic");
+    }
+
+    auto stringsCount = readUInt32();
+    if (!stringsCount) {
+        return stringsCount.moveError();
+    }
+
+    std::vector<StringBox> strings;
+    strings.reserve(std::min(static_cast<size_t>(stringsCount.value()), parser.getDistanceToEnd()));
+    for (uint32_t i = 0; i < stringsCount.value(); i++) {
+        auto length = readUInt32();
+        if (!length) {
+            return length.moveError();
+        }
+        auto str = parser.parse<char>(length.value());
+        if (!str) {
+            return str.moveError();
+        }
+        strings.emplace_back(StringCache::getGlobal().makeString(str.value(), length.value()));
+    }
+
+    auto schemasCount = readUInt32();
+    if (!schemasCount) {
+        return schemasCount.moveError();
+    }
+
+    auto schemaOffsets = parser.parse<Byte>(static_cast<size_t>(schemasCount.value()) * sizeof(uint32_t));
+    if (!schemaOffsets) {
+        return schemaOffsets.moveError();
+    }
+
+    _strings = std::move(strings);
+    _schemasCount = schemasCount.value();
+    _schemaOffsets = schemaOffsets.value();
+    _schemasData = parser.getCurrent();
+    _schemasDataSize = parser.getDistanceToEnd();
+
+    return Void();
+}
+
+} // namespace Valdi
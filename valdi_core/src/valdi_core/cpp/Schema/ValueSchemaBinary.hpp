@@ -0,0 +1,86 @@
+//
+//  ValueSchemaBinary.hpp
+//  valdi_core
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Schema/ValueSchema.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Void.hpp"
+#include <optional>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ Builds a precompiled table of ValueSchema, which can be loaded at runtime through
+ ValueSchemaBinaryTable without going through the ValueSchemaParser.
+ The table is made of a string table holding each type, property and enum case name
+ once, followed by the offsets of each schema, followed by the encoded schemas which
+ reference their names and types by index. Schema references and proto schemas are not
+ supported: type references should be kept unresolved so that they can be resolved lazily
+ by the ValueSchemaRegistry.
+ */
+class ValueSchemaBinaryBuilder {
+public:
+    ValueSchemaBinaryBuilder();
+    ~ValueSchemaBinaryBuilder();
+
+    /**
+     Append the given schema to the table, returns the index at which the schema
+     can be retrieved from the ValueSchemaBinaryTable.
+     */
+    Result<size_t> append(const ValueSchema& schema);
+
+    Ref<ByteBuffer> build() const;
+
+private:
+    std::vector<StringBox> _strings;
+    FlatMap<StringBox, uint32_t> _stringIndexes;
+    std::vector<uint32_t> _schemaOffsets;
+    ByteBuffer _schemasData;
+
+    Result<Void> write(const ValueSchema& schema);
+    void write(const ValueSchemaTypeReference& typeReference);
+    void writeString(const StringBox& str);
+    void writeUInt32(uint32_t value);
+    void writeByte(uint8_t value);
+};
+
+/**
+ A table of ValueSchema previously built by the ValueSchemaBinaryBuilder, typically
+ emitted as a static byte array alongside the generated code. The given data is
+ not copied and should outlive the table. The string table is interned the first
+ time a schema is requested, each schema is then decoded on demand.
+ */
+class ValueSchemaBinaryTable {
+public:
+    ValueSchemaBinaryTable(const Byte* data, size_t size);
+    ~ValueSchemaBinaryTable();
+
+    Result<size_t> size();
+    Result<ValueSchema> getSchema(size_t index);
+
+private:
+    const Byte* _data;
+    size_t _size;
+    Mutex _mutex;
+    bool _loaded = false;
+    std::optional<Error> _loadError;
+    std::vector<StringBox> _strings;
+    size_t _schemasCount = 0;
+    const Byte* _schemaOffsets = nullptr;
+    const Byte* _schemasData = nullptr;
+    size_t _schemasDataSize = 0;
+
+    Result<Void> lockFreeLoad();
+    Result<Void> lockFreeDoLoad();
+};
+
+} // namespace Valdi
@@ -49,18 +49,93 @@ private:
     ValueSchemaRegistrySchemaIdentifier _identifier;
 };
 
-ValueSchemaRegistry::ValueSchemaRegistry() = default;
+struct ValueSchemaRegistryThreadCache {
+    uint64_t registryId = 0;
+    uint64_t generation = 0;
+    FlatMap<ValueSchemaRegistryKey, Ref<ValueSchemaReference>> referenceByKey;
+    FlatMap<ValueSchemaRegistrySchemaIdentifier, ValueSchema> schemaByIdentifier;
+
+    ~ValueSchemaRegistryThreadCache();
+
+    void reset(uint64_t registryId, uint64_t generation) {
+        this->registryId = registryId;
+        this->generation = generation;
+        referenceByKey.clear();
+        schemaByIdentifier.clear();
+    }
+};
+
+// Lookups made while the thread exits, after its cache was destroyed, go through the lock
+static thread_local bool tThreadCacheDestroyed = false;
+static thread_local ValueSchemaRegistryThreadCache tThreadCache;
+
+ValueSchemaRegistryThreadCache::~ValueSchemaRegistryThreadCache() {
+    tThreadCacheDestroyed = true;
+}
+
+// Identifies registries in the thread caches, 0 is never used
+static std::atomic<uint64_t> kRegistryIdSequence = 0;
+
+ValueSchemaRegistry::ValueSchemaRegistry() : _id(++kRegistryIdSequence) {}
 ValueSchemaRegistry::~ValueSchemaRegistry() = default;
 
+ValueSchemaRegistryThreadCache* ValueSchemaRegistry::getThreadCache() const {
+    if (tThreadCacheDestroyed) {
+        return nullptr;
+    }
+
+    auto generation = _generation.load(std::memory_order_acquire);
+    if (tThreadCache.registryId != _id || tThreadCache.generation != generation) {
+        tThreadCache.reset(_id, generation);
+    }
+
+    return &tThreadCache;
+}
+
+void ValueSchemaRegistry::lockFreeSyncThreadCache(ValueSchemaRegistryThreadCache& threadCache) const {
+    // The registry might have changed since the thread cache was retrieved,
+    // what is read under the lock corresponds to the current generation.
+    auto generation = _generation.load(std::memory_order_relaxed);
+    if (threadCache.registryId != _id || threadCache.generation != generation) {
+        threadCache.reset(_id, generation);
+    }
+}
+
+void ValueSchemaRegistry::lockFreeCacheReference(ValueSchemaRegistryThreadCache* threadCache,
+                                                 const ValueSchemaRegistryKey& typeKey,
+                                                 const Ref<ValueSchemaReference>& reference) const {
+    if (threadCache == nullptr || reference == nullptr) {
+        return;
+    }
+
+    lockFreeSyncThreadCache(*threadCache);
+    threadCache->referenceByKey[typeKey] = reference;
+}
+
+void ValueSchemaRegistry::lockFreeIncrementGeneration() {
+    _generation.fetch_add(1, std::memory_order_release);
+}
+
 Ref<ValueSchemaReference> ValueSchemaRegistry::getSchemaReferenceForTypeKey(
     const ValueSchemaRegistryKey& typeKey) const {
+    auto* threadCache = getThreadCache();
+    if (threadCache != nullptr) {
+        const auto& it = threadCache->referenceByKey.find(typeKey);
+        if (it != threadCache->referenceByKey.end()) {
+            return it->second;
+        }
+    }
+
     std::lock_guard<std::recursive_mutex> guard(_mutex);
     const auto& it = _entryIndexByKey.find(typeKey);
     if (it == _entryIndexByKey.end()) {
         return nullptr;
     }
 
-    return _entries[it->second].reference;
+    Ref<ValueSchemaReference> reference = _entries[it->second].reference;
+    lockFreeCacheReference(threadCache, typeKey, reference);
+
+    return reference;
 }
 
 Ref<ValueSchemaReference> ValueSchemaRegistry::getSchemaReferenceForSchemaIdentifier(
@@ -125,12 +200,22 @@ static ValueSchemaRegistryKey simplifyTypeKey(const ValueSchemaRegistryKey& type
 
 Result<Ref<ValueSchemaReference>> ValueSchemaRegistry::getOrResolveSchemaReferenceForTypeKey(
     const ValueSchemaRegistryKey& typeKey) {
+    auto* threadCache = getThreadCache();
+    if (threadCache != nullptr) {
+        const auto& it = threadCache->referenceByKey.find(typeKey);
+        if (it != threadCache->referenceByKey.end()) {
+            return Ref<ValueSchemaReference>(it->second);
+        }
+    }
+
     std::lock_guard<std::recursive_mutex> guard(_mutex);
     const auto& it = _entryIndexByKey.find(typeKey);
     if (it != _entryIndexByKey.end()) {
         const auto& entry = _entries[it->second];
         if (entry.reference != nullptr) {
-            return Ref<ValueSchemaReference>(entry.reference);
+            Ref<ValueSchemaReference> reference = entry.reference;
+            lockFreeCacheReference(threadCache, typeKey, reference);
+            return reference;
         }
     }
 
@@ -207,6 +292,7 @@ ValueSchemaRegistrySchemaIdentifier ValueSchemaRegistry::registerSchema(const Va
     entry.reference = makeShared<ValueSchemaRegistryReference>(this, schemaKey, entryIndex);
 
     _entryIndexByKey[schemaKey] = entryIndex;
+    lockFreeIncrementGeneration();
 
     return entryIndex;
 }
@@ -227,15 +313,30 @@ void ValueSchemaRegistry::unregisterSchema(ValueSchemaRegistrySchemaIdentifier i
             _entryIndexByKey.erase(it);
         }
     }
+    lockFreeIncrementGeneration();
 }
 
 ValueSchema ValueSchemaRegistry::getSchemaForIdentifier(ValueSchemaRegistrySchemaIdentifier index) const {
+    auto* threadCache = getThreadCache();
+    if (threadCache != nullptr) {
+        const auto& it = threadCache->schemaByIdentifier.find(index);
+        if (it != threadCache->schemaByIdentifier.end()) {
+            return it->second;
+        }
+    }
+
     std::lock_guard<std::recursive_mutex> guard(_mutex);
     if (index >= _entries.size()) {
         return ValueSchema::voidType();
     }
 
-    return _entries[index].schema;
+    const auto& schema = _entries[index].schema;
+    if (threadCache != nullptr) {
+        lockFreeSyncThreadCache(*threadCache);
+        threadCache->schemaByIdentifier[index] = schema;
+    }
+
+    return schema;
 }
 
 std::optional<RegisteredValueSchema> ValueSchemaRegistry::getSchemaAndKeyForIdentifier(
@@ -257,6 +358,7 @@ void ValueSchemaRegistry::updateSchema(ValueSchemaRegistrySchemaIdentifier ident
     auto guard = lock();
     SC_ASSERT(identifier < _entries.size());
     _entries[identifier].schema = schema;
+    lockFreeIncrementGeneration();
 }
 
 bool ValueSchemaRegistry::updateSchemaIfKeyExists(const ValueSchemaRegistryKey& schemaKey, const ValueSchema& schema) {
@@ -266,6 +368,7 @@ bool ValueSchemaRegistry::updateSchemaIfKeyExists(const ValueSchemaRegistryKey&
         return false;
     }
     _entries[it->second].schema = schema;
+    lockFreeIncrementGeneration();
     return true;
 }
 
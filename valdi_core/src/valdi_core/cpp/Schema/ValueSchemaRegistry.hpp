@@ -14,6 +14,7 @@
 #include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Result.hpp"
+#include <atomic>
 #include <vector>
 
 namespace Valdi {
@@ -21,6 +22,7 @@ namespace Valdi {
 class ValueSchemaRegistry;
 
 class ValueSchemaRegistryReference;
+struct ValueSchemaRegistryThreadCache;
 
 struct ValueSchemaRegistryEntry {
     ValueSchema schema;
@@ -54,6 +56,11 @@ public:
  which for a ValueMap schema will be a type ref to the type name of the schema,
  and for the generic type instance it will be a generic type reference with
  the type name of the schema and the resolved type arguments.
+
+ Lookups by type key and by identifier are served from a cache local to the calling thread,
+ without taking the registry lock. The caches are tied to a generation of the registry, which
+ is incremented by every registration or update: the first lookup of a thread after a change
+ drops its cache and repopulates it from the registry under the lock.
  */
 class ValueSchemaRegistry : public SharedPtrRefCountable {
 public:
@@ -92,6 +99,8 @@ public:
 
 private:
     mutable std::recursive_mutex _mutex;
+    uint64_t _id;
+    std::atomic<uint64_t> _generation = 0;
     FlatMap<ValueSchemaRegistryKey, size_t> _entryIndexByKey;
     std::vector<ValueSchemaRegistryEntry> _entries;
     Ref<ValueSchemaRegistryListener> _listener;
@@ -99,6 +108,13 @@ private:
     friend ValueSchemaRegistryReference;
 
     Ref<ValueSchemaReference> getSchemaPostRegistration(const ValueSchemaRegistryKey& typeKey) const;
+
+    ValueSchemaRegistryThreadCache* getThreadCache() const;
+    void lockFreeSyncThreadCache(ValueSchemaRegistryThreadCache& threadCache) const;
+    void lockFreeCacheReference(ValueSchemaRegistryThreadCache* threadCache,
+                                const ValueSchemaRegistryKey& typeKey,
+                                const Ref<ValueSchemaReference>& reference) const;
+    void lockFreeIncrementGeneration();
 };
 
 } // namespace Valdi
@@ -0,0 +1,93 @@
+//
+//  GraphemeClusters.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Text/GraphemeClusters.hpp"
+#include <array>
+
+namespace Valdi {
+
+struct GraphemeClusterClassRange {
+    uint32_t from;
+    uint32_t to;
+    GraphemeClusterClass graphemeClusterClass;
+};
+
+// Sorted by unicode point
+static constexpr std::array<GraphemeClusterClassRange, 6> kGraphemeClusterClassRanges = {{
+    {0x0300, 0x036F, GraphemeClusterClass::CombiningMark},
+    {0x200D, 0x200D, GraphemeClusterClass::ZeroWidthJoiner},
+    {0xFE00, 0xFE0F, GraphemeClusterClass::VariationSelector},
+    {0x1F1E6, 0x1F1FF, GraphemeClusterClass::RegionalIndicator},
+    {0x1F3FB, 0x1F3FF, GraphemeClusterClass::EmojiModifier},
+    {0xE0100, 0xE01EF, GraphemeClusterClass::VariationSelector},
+}};
+
+enum GraphemeClusterTransition : uint8_t {
+    Break = 0,
+    Continue,
+    // Continues only when the previous unicode point was part of an emoji
+    ContinueAfterEmoji,
+};
+
+// The state used before the first unicode point
+static constexpr uint8_t kGraphemeClusterStartState = kGraphemeClusterClassCount;
+
+// Indexed by the previous class, or the start state, and then by the current class
+// clang-format off
+static constexpr uint8_t kGraphemeClusterTransitions[kGraphemeClusterClassCount + 1][kGraphemeClusterClassCount] = {
+    // Other, CombiningMark, ZeroWidthJoiner, RegionalIndicator, EmojiModifier, VariationSelector
+    {Break, Continue, Continue, Break, ContinueAfterEmoji, Continue},    // Other
+    {Break, Continue, Continue, Break, ContinueAfterEmoji, Continue},    // CombiningMark
+    {Continue, Continue, Continue, Continue, Continue, Continue},        // ZeroWidthJoiner
+    {Break, Continue, Continue, Continue, ContinueAfterEmoji, Continue}, // RegionalIndicator
+    {Break, Continue, Continue, Break, ContinueAfterEmoji, Continue},    // EmojiModifier
+    {Break, Continue, Continue, Break, ContinueAfterEmoji, Continue},    // VariationSelector
+    {Break, Break, Break, Break, Break, Break},                          // Start
+};
+// clang-format on
+
+GraphemeClusterClass getGraphemeClusterClass(uint32_t unicodePoint) {
+    if (unicodePoint < kGraphemeClusterClassRanges.front().from) {
+        return GraphemeClusterClass::Other;
+    }
+
+    for (const auto& range : kGraphemeClusterClassRanges) {
+        if (unicodePoint < range.from) {
+            break;
+        }
+        if (unicodePoint <= range.to) {
+            return range.graphemeClusterClass;
+        }
+    }
+
+    return GraphemeClusterClass::Other;
+}
+
+void appendGraphemeClusterExtendRanges(std::vector<CharacterRange>& output) {
+    for (const auto& range : kGraphemeClusterClassRanges) {
+        output.emplace_back(range.from, range.to);
+    }
+}
+
+GraphemeClusterSegmenter::GraphemeClusterSegmenter() : _previousClass(kGraphemeClusterStartState) {}
+
+bool GraphemeClusterSegmenter::continuesCluster(GraphemeClusterClass unicodePointClass) const {
+    auto transition = kGraphemeClusterTransitions[_previousClass][static_cast<size_t>(unicodePointClass)];
+    return transition == Continue || (transition == ContinueAfterEmoji && _previousIsEmoji);
+}
+
+void GraphemeClusterSegmenter::advance(GraphemeClusterClass unicodePointClass, bool isEmoji) {
+    _previousClass = static_cast<uint8_t>(unicodePointClass);
+    _previousIsEmoji = isEmoji;
+}
+
+void GraphemeClusterSegmenter::reset() {
+    _previousClass = kGraphemeClusterStartState;
+    _previousIsEmoji = false;
+}
+
+} // namespace Valdi
@@ -0,0 +1,69 @@
+//
+//  GraphemeClusters.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Text/CharacterSet.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ The classes of unicode points which can extend a grapheme cluster.
+ */
+enum class GraphemeClusterClass : uint8_t {
+    Other = 0,
+    CombiningMark,
+    ZeroWidthJoiner,
+    RegionalIndicator,
+    EmojiModifier,
+    VariationSelector,
+};
+
+constexpr size_t kGraphemeClusterClassCount = 6;
+
+GraphemeClusterClass getGraphemeClusterClass(uint32_t unicodePoint);
+
+/**
+ Append the ranges of all the unicode points whose class is not GraphemeClusterClass::Other.
+ A unicode point outside those ranges can only continue a grapheme cluster when it follows a
+ zero width joiner.
+ */
+void appendGraphemeClusterExtendRanges(std::vector<CharacterRange>& output);
+
+/**
+ Segments unicode points into grapheme clusters. This is a small state machine whose state
+ is the class of the previous unicode point and whether it was part of an emoji, and whose
+ transitions are resolved from a table indexed by the previous and current classes.
+ */
+class GraphemeClusterSegmenter {
+public:
+    GraphemeClusterSegmenter();
+
+    /**
+     Returns whether the given unicode point continues the grapheme cluster of the previous one.
+     Always returns false for the first unicode point.
+     */
+    bool continuesCluster(GraphemeClusterClass unicodePointClass) const;
+
+    /**
+     Set the given unicode point as the previous one.
+     */
+    void advance(GraphemeClusterClass unicodePointClass, bool isEmoji);
+
+    /**
+     Resets the segmenter so that the next unicode point starts a cluster.
+     */
+    void reset();
+
+private:
+    uint8_t _previousClass;
+    bool _previousIsEmoji = false;
+};
+
+} // namespace Valdi
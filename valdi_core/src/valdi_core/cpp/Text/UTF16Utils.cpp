@@ -8,6 +8,7 @@
 #include "valdi_core/cpp/Text/UTF16Utils.hpp"
 #include "UTF16Utils.hpp"
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace Valdi {
@@ -159,12 +160,61 @@ static inline void utf16Encode(char32_t pt, std::vector<char16_t>& out) {
     }
 }
 
+constexpr uint64_t kUTF8NonASCIIMask = 0x8080808080808080ULL;
+constexpr uint64_t kUTF16NonASCIIMask = 0xFF80FF80FF80FF80ULL;
+
+size_t countLeadingASCII(const char* utf8String, size_t length) {
+    size_t i = 0;
+
+    while (i + sizeof(uint64_t) <= length) {
+        uint64_t word;
+        std::memcpy(&word, utf8String + i, sizeof(uint64_t));
+        if ((word & kUTF8NonASCIIMask) != 0) {
+            break;
+        }
+        i += sizeof(uint64_t);
+    }
+
+    while (i < length && static_cast<unsigned char>(utf8String[i]) < 0x80) {
+        i++;
+    }
+
+    return i;
+}
+
+size_t countLeadingASCII(const char16_t* utf16String, size_t length) {
+    constexpr size_t kCharactersPerWord = sizeof(uint64_t) / sizeof(char16_t);
+    size_t i = 0;
+
+    while (i + kCharactersPerWord <= length) {
+        uint64_t word;
+        std::memcpy(&word, utf16String + i, sizeof(uint64_t));
+        if ((word & kUTF16NonASCIIMask) != 0) {
+            break;
+        }
+        i += kCharactersPerWord;
+    }
+
+    while (i < length && utf16String[i] < 0x80) {
+        i++;
+    }
+
+    return i;
+}
+
 std::pair<const char*, size_t> utf16ToUtf8(const char16_t* utf16String, size_t len) {
     thread_local static std::vector<char> tBuffer;
     auto& buffer = tBuffer;
     buffer.clear();
 
     for (std::u16string::size_type i = 0; i < len;) {
+        auto asciiLength = countLeadingASCII(utf16String + i, len - i);
+        if (asciiLength > 0) {
+            buffer.insert(buffer.end(), utf16String + i, utf16String + i + asciiLength);
+            i += asciiLength;
+            continue;
+        }
+
         utf8Encode(utf16Decode(utf16String, i), buffer);
     }
 
@@ -177,6 +227,13 @@ std::pair<const char16_t*, size_t> utf8ToUtf16(const char* utf8String, size_t le
     buffer.clear();
 
     for (std::string::size_type i = 0; i < len;) {
+        auto asciiLength = countLeadingASCII(utf8String + i, len - i);
+        if (asciiLength > 0) {
+            buffer.insert(buffer.end(), utf8String + i, utf8String + i + asciiLength);
+            i += asciiLength;
+            continue;
+        }
+
         utf16Encode(utf8Decode(utf8String, i), buffer);
     }
 
@@ -189,6 +246,13 @@ std::pair<const uint32_t*, size_t> utf8ToUtf32(const char* utf8String, size_t le
     buffer.clear();
 
     for (std::string::size_type i = 0; i < len;) {
+        auto asciiLength = countLeadingASCII(utf8String + i, len - i);
+        if (asciiLength > 0) {
+            buffer.insert(buffer.end(), utf8String + i, utf8String + i + asciiLength);
+            i += asciiLength;
+            continue;
+        }
+
         buffer.emplace_back(utf8Decode(utf8String, i));
     }
 
@@ -201,6 +265,13 @@ std::pair<const uint32_t*, size_t> utf16ToUtf32(const char16_t* utf16String, siz
     buffer.clear();
 
     for (std::u16string::size_type i = 0; i < len;) {
+        auto asciiLength = countLeadingASCII(utf16String + i, len - i);
+        if (asciiLength > 0) {
+            buffer.insert(buffer.end(), utf16String + i, utf16String + i + asciiLength);
+            i += asciiLength;
+            continue;
+        }
+
         buffer.emplace_back(utf16Decode(utf16String, i));
     }
 
@@ -71,6 +71,18 @@ size_t countUtf32ToUtf16(uint32_t utf32Character);
  */
 size_t utf32ToUtf16(const uint32_t* utf32String, size_t length, char16_t* output, size_t capacity);
 
+/**
+ Returns the number of leading ASCII characters within the given UTF8 string.
+ The string is scanned 8 bytes at a time, which allows the conversion functions
+ to widen or narrow ASCII runs without decoding them one code point at a time.
+ */
+size_t countLeadingASCII(const char* utf8String, size_t length);
+
+/**
+ Returns the number of leading ASCII characters within the given UTF16 string.
+ */
+size_t countLeadingASCII(const char16_t* utf16String, size_t length);
+
 /**
  An Index that can efficiently resolve a UTF32 index from a UTF16 index.
  This can be helpful when integrating between libraries that deal with different
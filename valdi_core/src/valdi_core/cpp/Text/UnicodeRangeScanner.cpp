@@ -0,0 +1,136 @@
+//
+//  UnicodeRangeScanner.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Text/UnicodeRangeScanner.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VALDI_UNICODE_RANGE_SCANNER_NEON 1
+#endif
+
+namespace Valdi {
+
+UnicodeRangeScanner::UnicodeRangeScanner() = default;
+
+UnicodeRangeScanner::UnicodeRangeScanner(std::vector<CharacterRange> ranges) {
+    std::sort(ranges.begin(), ranges.end(), [](const auto& left, const auto& right) { return left.from < right.from; });
+
+    // Merge the overlapping and adjacent ranges
+    std::vector<CharacterRange> merged;
+    merged.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        if (!merged.empty() && range.from <= merged.back().to + 1) {
+            merged.back().to = std::max(merged.back().to, range.to);
+        } else {
+            merged.emplace_back(range);
+        }
+    }
+
+    // Then merge the closest ranges until we fit
+    while (merged.size() > kMaxRanges) {
+        size_t closestIndex = 0;
+        for (size_t i = 1; i + 1 < merged.size(); i++) {
+            if (merged[i + 1].from - merged[i].to < merged[closestIndex + 1].from - merged[closestIndex].to) {
+                closestIndex = i;
+            }
+        }
+        merged[closestIndex].to = merged[closestIndex + 1].to;
+        merged.erase(merged.begin() + static_cast<std::ptrdiff_t>(closestIndex + 1));
+    }
+
+    _rangesCount = merged.size();
+    for (size_t i = 0; i < _rangesCount; i++) {
+        _starts[i] = merged[i].from;
+        _widths[i] = merged[i].to - merged[i].from;
+    }
+}
+
+bool UnicodeRangeScanner::contains(uint32_t unicodePoint) const {
+    for (size_t i = 0; i < _rangesCount; i++) {
+        if (unicodePoint - _starts[i] <= _widths[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const uint32_t* UnicodeRangeScanner::findFirst(const uint32_t* begin, const uint32_t* end) const {
+    const auto* it = begin;
+
+    if (_rangesCount == 0) {
+        return end;
+    }
+
+#if defined(__SSE2__)
+    // SSE2 only has signed comparisons, flipping the sign bit of both sides makes them unsigned
+    const auto signBit = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    std::array<__m128i, kMaxRanges> starts;
+    std::array<__m128i, kMaxRanges> widths;
+    for (size_t i = 0; i < _rangesCount; i++) {
+        starts[i] = _mm_set1_epi32(static_cast<int>(_starts[i]));
+        widths[i] = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(_widths[i])), signBit);
+    }
+
+    while (end - it >= 4) {
+        auto unicodePoints = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        auto outside = _mm_set1_epi32(-1);
+        for (size_t i = 0; i < _rangesCount; i++) {
+            auto offsets = _mm_xor_si128(_mm_sub_epi32(unicodePoints, starts[i]), signBit);
+            outside = _mm_and_si128(outside, _mm_cmpgt_epi32(offsets, widths[i]));
+        }
+
+        auto insideMask = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+        if (insideMask != 0) {
+            for (int i = 0; i < 4; i++) {
+                if ((insideMask & (1 << i)) != 0) {
+                    return it + i;
+                }
+            }
+        }
+        it += 4;
+    }
+#elif defined(VALDI_UNICODE_RANGE_SCANNER_NEON)
+    std::array<uint32x4_t, kMaxRanges> starts;
+    std::array<uint32x4_t, kMaxRanges> widths;
+    for (size_t i = 0; i < _rangesCount; i++) {
+        starts[i] = vdupq_n_u32(_starts[i]);
+        widths[i] = vdupq_n_u32(_widths[i]);
+    }
+
+    while (end - it >= 4) {
+        auto unicodePoints = vld1q_u32(it);
+        auto inside = vdupq_n_u32(0);
+        for (size_t i = 0; i < _rangesCount; i++) {
+            inside = vorrq_u32(inside, vcleq_u32(vsubq_u32(unicodePoints, starts[i]), widths[i]));
+        }
+
+        if (vmaxvq_u32(inside) != 0) {
+            // Let the scalar loop below find which one it is
+            break;
+        }
+        it += 4;
+    }
+#endif
+
+    while (it != end) {
+        if (contains(*it)) {
+            return it;
+        }
+        it++;
+    }
+
+    return end;
+}
+
+size_t UnicodeRangeScanner::getRangesCount() const {
+    return _rangesCount;
+}
+
+} // namespace Valdi
@@ -0,0 +1,50 @@
+//
+//  UnicodeRangeScanner.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Text/CharacterSet.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ UnicodeRangeScanner finds the first unicode point of a unicode array which is within a small
+ set of ranges, 4 unicode points at a time with SSE2 or NEON when available. It is used to skip
+ over the parts of a string which cannot contain the sequences a slower lookup is looking for.
+
+ The scanner holds at most kMaxRanges ranges. When built with more ranges, the closest ones are
+ merged together, which makes the scanner match a superset of the given unicode points.
+ */
+class UnicodeRangeScanner {
+public:
+    static constexpr size_t kMaxRanges = 8;
+
+    UnicodeRangeScanner();
+    explicit UnicodeRangeScanner(std::vector<CharacterRange> ranges);
+
+    /**
+     Returns a pointer to the first unicode point within the ranges of the scanner,
+     or the end pointer if there are none.
+     */
+    const uint32_t* findFirst(const uint32_t* begin, const uint32_t* end) const;
+
+    bool contains(uint32_t unicodePoint) const;
+
+    size_t getRangesCount() const;
+
+private:
+    // Ranges are stored as their start and their width, so that a unicode point is within
+    // a range when (unicodePoint - start) <= width, as an unsigned comparison.
+    std::array<uint32_t, kMaxRanges> _starts{};
+    std::array<uint32_t, kMaxRanges> _widths{};
+    size_t _rangesCount = 0;
+};
+
+} // namespace Valdi
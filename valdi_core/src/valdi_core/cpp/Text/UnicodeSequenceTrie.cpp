@@ -53,6 +53,18 @@ const UnicodeSequence* UnicodeSequenceTrie::find(std::initializer_list<uint32_t>
     return find(unicodePoints.begin(), unicodePoints.size());
 }
 
+void UnicodeSequenceTrie::appendAnchorUnicodePoints(std::vector<CharacterRange>& output) const {
+    for (const auto& it : _rootEntry.children) {
+        if (it.second.exists) {
+            output.emplace_back(it.first, it.first);
+        }
+
+        for (const auto& childIt : it.second.children) {
+            output.emplace_back(childIt.first, childIt.first);
+        }
+    }
+}
+
 void UnicodeSequenceTrie::rebuildIndex() {
     buildIndex(_rootEntry);
 }
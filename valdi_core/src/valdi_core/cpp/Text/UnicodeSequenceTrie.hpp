@@ -43,6 +43,13 @@ public:
 
     const UnicodeSequence* find(std::initializer_list<uint32_t> unicodePoints) const;
 
+    /**
+     * Append the unicode points that can anchor a match: the sequences of length 1, and
+     * the second unicode point of the longer sequences. find() can only return a sequence
+     * when the first or the second unicode point of the given array is one of them.
+     */
+    void appendAnchorUnicodePoints(std::vector<CharacterRange>& output) const;
+
 private:
     struct Entry {
         bool exists = false;
@@ -0,0 +1,153 @@
+//
+//  Coroutine.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Threading/Coroutine.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/ResolvablePromise.hpp"
+#include <array>
+#include <new>
+
+namespace Valdi {
+
+constexpr size_t kCoroutineFrameSizeClassesCount =
+    CoroutineFrameAllocator::kMaxPooledFrameSize / CoroutineFrameAllocator::kSizeClassGranularity;
+
+namespace {
+
+struct FreeCoroutineFrame {
+    FreeCoroutineFrame* next;
+};
+
+struct CoroutineFrameFreeLists {
+    std::array<FreeCoroutineFrame*, kCoroutineFrameSizeClassesCount> heads{};
+    std::array<size_t, kCoroutineFrameSizeClassesCount> counts{};
+
+    ~CoroutineFrameFreeLists();
+};
+
+thread_local CoroutineFrameFreeLists tFreeLists;
+// Frames of coroutines destroyed during thread exit after the free lists are freed directly
+thread_local bool tFreeListsDestroyed = false;
+
+CoroutineFrameFreeLists::~CoroutineFrameFreeLists() {
+    tFreeListsDestroyed = true;
+    for (auto* head : heads) {
+        while (head != nullptr) {
+            auto* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+}
+
+size_t getSizeClass(size_t size) {
+    return (size + CoroutineFrameAllocator::kSizeClassGranularity - 1) /
+               CoroutineFrameAllocator::kSizeClassGranularity -
+           1;
+}
+
+} // namespace
+
+void* CoroutineFrameAllocator::allocate(size_t size) {
+    if (size > kMaxPooledFrameSize) {
+        AllocationProfiler::recordAllocation(AllocationSite::CoroutineFrame, size);
+        return ::operator new(size);
+    }
+
+    auto sizeClass = getSizeClass(size);
+    if (!tFreeListsDestroyed) {
+        auto& freeLists = tFreeLists;
+        auto* frame = freeLists.heads[sizeClass];
+        if (frame != nullptr) {
+            freeLists.heads[sizeClass] = frame->next;
+            freeLists.counts[sizeClass]--;
+            return frame;
+        }
+    }
+
+    // Allocate the whole size class so that the frame can be reused by any coroutine of that class
+    auto allocationSize = (sizeClass + 1) * kSizeClassGranularity;
+    AllocationProfiler::recordAllocation(AllocationSite::CoroutineFrame, allocationSize);
+    return ::operator new(allocationSize);
+}
+
+void CoroutineFrameAllocator::deallocate(void* ptr, size_t size) noexcept {
+    if (size > kMaxPooledFrameSize || tFreeListsDestroyed) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto sizeClass = getSizeClass(size);
+    auto& freeLists = tFreeLists;
+    if (freeLists.counts[sizeClass] >= kMaxPooledFramesPerSizeClass) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto* frame = new (ptr) FreeCoroutineFrame();
+    frame->next = freeLists.heads[sizeClass];
+    freeLists.heads[sizeClass] = frame;
+    freeLists.counts[sizeClass]++;
+}
+
+size_t CoroutineFrameAllocator::getPooledFramesCount() {
+    if (tFreeListsDestroyed) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (auto sizeClassCount : tFreeLists.counts) {
+        count += sizeClassCount;
+    }
+    return count;
+}
+
+class PromiseAwaiterCallback : public PromiseCallback {
+public:
+    PromiseAwaiterCallback(PromiseAwaiter* awaiter, std::coroutine_handle<> handle)
+        : _awaiter(awaiter), _handle(handle) {}
+
+    void onSuccess(const Value& value) final {
+        _awaiter->_result.emplace(value);
+        _handle.resume();
+    }
+
+    void onFailure(const Error& error) final {
+        _awaiter->_result.emplace(error);
+        _handle.resume();
+    }
+
+private:
+    PromiseAwaiter* _awaiter;
+    std::coroutine_handle<> _handle;
+};
+
+PromiseAwaiter::PromiseAwaiter(Ref<Promise> promise) noexcept : _promise(std::move(promise)) {}
+PromiseAwaiter::~PromiseAwaiter() = default;
+
+void PromiseAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    // The awaiter and the promise might be destroyed as soon as the coroutine resumes,
+    // which can happen within onComplete() if the promise was already fulfilled.
+    auto promise = _promise;
+    promise->onComplete(makeShared<PromiseAwaiterCallback>(this, handle));
+}
+
+Result<Value> PromiseAwaiter::await_resume() {
+    return std::move(_result.value());
+}
+
+static Coroutine<> fulfillWhenCompleted(Ref<ResolvablePromise> promise, Coroutine<Result<Value>> coroutine) {
+    promise->fulfill(co_await coroutine);
+}
+
+Ref<Promise> toPromise(Coroutine<Result<Value>> coroutine) {
+    auto promise = makeShared<ResolvablePromise>();
+    fulfillWhenCompleted(promise, std::move(coroutine));
+    return promise;
+}
+
+} // namespace Valdi
@@ -0,0 +1,314 @@
+//
+//  Coroutine.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/Promise.hpp"
+#include "valdi_core/cpp/Utils/Result.hpp"
+#include <atomic>
+#include <coroutine>
+#include <cstdlib>
+#include <optional>
+
+namespace Valdi {
+
+/**
+ Allocates the coroutine frames from per-thread free lists, one per size class, so that
+ short lived coroutines reuse the frames of the ones which completed before them.
+ Frames larger than kMaxPooledFrameSize are allocated and freed directly.
+ */
+class CoroutineFrameAllocator {
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size) noexcept;
+
+    /**
+     Returns how many frames are kept in the free lists of the current thread.
+     */
+    static size_t getPooledFramesCount();
+
+    static constexpr size_t kSizeClassGranularity = 64;
+    static constexpr size_t kMaxPooledFrameSize = 2048;
+    static constexpr size_t kMaxPooledFramesPerSizeClass = 32;
+};
+
+template<typename T>
+class Coroutine;
+
+namespace CoroutineDetail {
+
+class PromiseBase {
+public:
+    static void* operator new(size_t size) {
+        return CoroutineFrameAllocator::allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+        CoroutineFrameAllocator::deallocate(ptr, size);
+    }
+
+    std::suspend_never initial_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        std::abort();
+    }
+
+    bool isCompleted() const noexcept {
+        return _continuation.load(std::memory_order_acquire) == completedMarker();
+    }
+
+    /**
+     Set the coroutine to resume once this one completes.
+     Returns false if this coroutine already completed.
+     */
+    bool setContinuation(std::coroutine_handle<> continuation) noexcept {
+        void* expected = nullptr;
+        return _continuation.compare_exchange_strong(
+            expected, continuation.address(), std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+
+    std::coroutine_handle<> complete() noexcept {
+        auto* continuation = _continuation.exchange(completedMarker(), std::memory_order_acq_rel);
+        if (continuation == nullptr) {
+            return std::noop_coroutine();
+        }
+        return std::coroutine_handle<>::from_address(continuation);
+    }
+
+    /**
+     The frame is owned by the running coroutine and by its Coroutine object,
+     returns whether the caller released the last ownership.
+     */
+    bool release() noexcept {
+        return _ownersCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+private:
+    std::atomic<void*> _continuation = nullptr;
+    std::atomic<uint8_t> _ownersCount = 2;
+
+    static void* completedMarker() noexcept {
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(1));
+    }
+};
+
+template<typename Promise>
+struct FinalAwaiter {
+    bool await_ready() noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        auto& promise = handle.promise();
+        auto continuation = promise.complete();
+        if (promise.release()) {
+            handle.destroy();
+        }
+        // Symmetric transfer, the awaiting coroutine resumes without growing the stack
+        return continuation;
+    }
+
+    void await_resume() noexcept {}
+};
+
+template<typename T>
+class CoroutinePromise : public PromiseBase {
+public:
+    Coroutine<T> get_return_object() noexcept;
+
+    FinalAwaiter<CoroutinePromise<T>> final_suspend() noexcept {
+        return {};
+    }
+
+    template<typename V>
+    void return_value(V&& value) {
+        _value.emplace(std::forward<V>(value));
+    }
+
+    T& value() noexcept {
+        return _value.value();
+    }
+
+private:
+    std::optional<T> _value;
+};
+
+template<>
+class CoroutinePromise<void> : public PromiseBase {
+public:
+    Coroutine<void> get_return_object() noexcept;
+
+    FinalAwaiter<CoroutinePromise<void>> final_suspend() noexcept {
+        return {};
+    }
+
+    void return_void() noexcept {}
+};
+
+} // namespace CoroutineDetail
+
+/**
+ A C++20 coroutine which can await on DispatchQueue's to hop threads, on Promise's,
+ and on other Coroutine's. The coroutine starts eagerly, and runs until it completes or
+ suspends on its first await. Destroying the Coroutine object does not cancel it,
+ its frame is released once it completed and the Coroutine object is gone.
+
+ Example:
+
+   Coroutine<Result<Value>> loadAndDecode(Ref<DispatchQueue> workerQueue, Ref<Promise> download) {
+       auto data = co_await download;
+       co_await workerQueue; // Resumes on the worker queue, or inline if already on it
+       co_return decode(data);
+   }
+ */
+template<typename T = void>
+class Coroutine {
+public:
+    using promise_type = CoroutineDetail::CoroutinePromise<T>;
+
+    Coroutine() = default;
+    explicit Coroutine(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle) {}
+    Coroutine(Coroutine&& other) noexcept : _handle(other._handle) {
+        other._handle = nullptr;
+    }
+    Coroutine(const Coroutine&) = delete;
+
+    ~Coroutine() {
+        reset();
+    }
+
+    Coroutine& operator=(Coroutine&& other) noexcept {
+        if (this != &other) {
+            reset();
+            _handle = other._handle;
+            other._handle = nullptr;
+        }
+        return *this;
+    }
+
+    Coroutine& operator=(const Coroutine&) = delete;
+
+    bool isCompleted() const noexcept {
+        return _handle && _handle.promise().isCompleted();
+    }
+
+    /**
+     Returns the value returned by the coroutine, which must have completed.
+     */
+    template<typename V = T, typename = std::enable_if_t<!std::is_void_v<V>>>
+    V& value() noexcept {
+        return _handle.promise().value();
+    }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept {
+                return handle.promise().isCompleted();
+            }
+
+            bool await_suspend(std::coroutine_handle<> continuation) noexcept {
+                return handle.promise().setContinuation(continuation);
+            }
+
+            T await_resume() noexcept {
+                if constexpr (!std::is_void_v<T>) {
+                    return std::move(handle.promise().value());
+                }
+            }
+        };
+
+        return Awaiter{_handle};
+    }
+
+private:
+    std::coroutine_handle<promise_type> _handle;
+
+    void reset() noexcept {
+        if (_handle) {
+            if (_handle.promise().release()) {
+                _handle.destroy();
+            }
+            _handle = nullptr;
+        }
+    }
+};
+
+template<typename T>
+Coroutine<T> CoroutineDetail::CoroutinePromise<T>::get_return_object() noexcept {
+    return Coroutine<T>(std::coroutine_handle<CoroutinePromise<T>>::from_promise(*this));
+}
+
+inline Coroutine<void> CoroutineDetail::CoroutinePromise<void>::get_return_object() noexcept {
+    return Coroutine<void>(std::coroutine_handle<CoroutinePromise<void>>::from_promise(*this));
+}
+
+/**
+ Awaiter which resumes the coroutine on the given DispatchQueue. The coroutine keeps
+ running inline when it is already on that queue.
+ */
+class DispatchQueueAwaiter {
+public:
+    explicit DispatchQueueAwaiter(Ref<DispatchQueue> queue) noexcept : _queue(std::move(queue)) {}
+
+    bool await_ready() const {
+        return _queue->isCurrent();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        _queue->async([handle]() { handle.resume(); });
+    }
+
+    void await_resume() noexcept {}
+
+private:
+    Ref<DispatchQueue> _queue;
+};
+
+inline DispatchQueueAwaiter operator co_await(const Ref<DispatchQueue>& queue) noexcept {
+    return DispatchQueueAwaiter(queue);
+}
+
+/**
+ Awaiter which resumes the coroutine with the result of the given Promise,
+ on the thread which fulfilled it.
+ */
+class PromiseAwaiter {
+public:
+    explicit PromiseAwaiter(Ref<Promise> promise) noexcept;
+    ~PromiseAwaiter();
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle);
+
+    Result<Value> await_resume();
+
+private:
+    Ref<Promise> _promise;
+    std::optional<Result<Value>> _result;
+
+    friend class PromiseAwaiterCallback;
+};
+
+inline PromiseAwaiter operator co_await(const Ref<Promise>& promise) noexcept {
+    return PromiseAwaiter(promise);
+}
+
+/**
+ Returns a Promise fulfilled with the result of the given coroutine, so that
+ coroutines can be exposed through the existing Promise based APIs.
+ */
+Ref<Promise> toPromise(Coroutine<Result<Value>> coroutine);
+
+} // namespace Valdi
@@ -6,6 +6,7 @@
 //
 
 #include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Threading/PooledDispatchQueue.hpp"
 #include "valdi_core/cpp/Threading/ThreadedDispatchQueue.hpp"
 #include <future>
 
@@ -40,6 +41,10 @@ Ref<DispatchQueue> DispatchQueue::createThreaded(const StringBox& name, ThreadQo
     return Valdi::makeShared<ThreadedDispatchQueue>(name, qosClass);
 }
 
+Ref<DispatchQueue> DispatchQueue::createOnSharedPool(const StringBox& name, size_t maxConcurrentTasks) {
+    return Valdi::makeShared<PooledDispatchQueue>(name, ThreadPool::getShared(), maxConcurrentTasks);
+}
+
 void DispatchQueue::setQoSClass(ThreadQoSClass qosClass) {}
 
 void DispatchQueue::setDisableSyncCallsInCallingThread(bool disableSyncCallsInCallingThread) {}
@@ -67,7 +72,12 @@ DispatchQueue* DispatchQueue::getCurrent() {
         return queue;
     }
 
-    return ThreadedDispatchQueue::getCurrent();
+    auto* threadedQueue = ThreadedDispatchQueue::getCurrent();
+    if (threadedQueue != nullptr) {
+        return threadedQueue;
+    }
+
+    return PooledDispatchQueue::getCurrent();
 }
 
 #else
@@ -77,7 +87,12 @@ Ref<DispatchQueue> DispatchQueue::create(const StringBox& name, ThreadQoSClass q
 }
 
 DispatchQueue* DispatchQueue::getCurrent() {
-    return ThreadedDispatchQueue::getCurrent();
+    auto* threadedQueue = ThreadedDispatchQueue::getCurrent();
+    if (threadedQueue != nullptr) {
+        return threadedQueue;
+    }
+
+    return PooledDispatchQueue::getCurrent();
 }
 
 #endif
@@ -55,6 +55,9 @@ public:
     static Ref<DispatchQueue> create(const StringBox& name, ThreadQoSClass qosClass);
     // Create a DispatchQueue that is always backed by a single thread.
     static Ref<DispatchQueue> createThreaded(const StringBox& name, ThreadQoSClass qosClass);
+    // Create a DispatchQueue that runs its tasks on the shared ThreadPool instead of owning a thread.
+    // Up to maxConcurrentTasks can run at the same time, a value of 1 creates a serial queue.
+    static Ref<DispatchQueue> createOnSharedPool(const StringBox& name, size_t maxConcurrentTasks);
 
     static DispatchQueue* getCurrent();
     static DispatchQueue* getMain();
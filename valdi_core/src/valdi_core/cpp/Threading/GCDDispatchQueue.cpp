@@ -8,12 +8,28 @@
 #if __APPLE__
 
 #include "valdi_core/cpp/Threading/GCDDispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
 
 namespace Valdi {
 
 const char* kDispatchQueueSpecific = "specific";
 
+/**
+ The async work items are passed to GCD as the context of dispatch_async_f() and dispatch_after_f(),
+ they are allocated from the DispatchClosureAllocator so that submitting a task does not hit the heap.
+ */
+class GCDDispatchQueuePooledWorkItem {
+public:
+    static void* operator new(size_t size) {
+        return DispatchClosureAllocator::allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+        DispatchClosureAllocator::deallocate(ptr, size);
+    }
+};
+
 class GCDDispatchQueueSyncWorkItem {
 public:
     GCDDispatchQueueSyncWorkItem(GCDDispatchQueue* queue, const DispatchFunction& function)
@@ -28,7 +44,7 @@ private:
     const DispatchFunction& _function;
 };
 
-class GCDDispatchQueueAsyncWorkItem {
+class GCDDispatchQueueAsyncWorkItem : public GCDDispatchQueuePooledWorkItem {
 public:
     GCDDispatchQueueAsyncWorkItem(Shared<GCDDispatchQueue> queue, DispatchFunction function)
         : _queue(std::move(queue)), _function(std::move(function)) {}
@@ -42,7 +58,7 @@ private:
     DispatchFunction _function;
 };
 
-class GCDDispatchQueueAsyncAfterWorkItem {
+class GCDDispatchQueueAsyncAfterWorkItem : public GCDDispatchQueuePooledWorkItem {
 public:
     GCDDispatchQueueAsyncAfterWorkItem(Shared<GCDDispatchQueue> queue, DispatchFunction function, task_id_t taskId)
         : _queue(std::move(queue)), _function(std::move(function)), _taskId(taskId) {}
@@ -57,6 +73,9 @@ private:
     task_id_t _taskId;
 };
 
+static_assert(sizeof(GCDDispatchQueueAsyncWorkItem) <= DispatchClosureAllocator::kMaxPooledClosureSize);
+static_assert(sizeof(GCDDispatchQueueAsyncAfterWorkItem) <= DispatchClosureAllocator::kMaxPooledClosureSize);
+
 void GCDDispatchQueueSyncCallback(void* context) {
     GCDDispatchQueueSyncWorkItem* workItem = reinterpret_cast<GCDDispatchQueueSyncWorkItem*>(context);
 
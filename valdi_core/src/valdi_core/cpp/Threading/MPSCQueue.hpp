@@ -0,0 +1,113 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Valdi {
+
+/**
+ * A bounded lock-free multi-producer single-consumer FIFO ring, based on
+ * Dmitry Vyukov's bounded queue. Producers can push concurrently from any thread
+ * without taking a lock. Only one thread at a time may call tryPop(), callers
+ * are responsible for serializing consumers.
+ */
+template<typename T, size_t Capacity>
+class MPSCQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MPSCQueue() : _enqueuePosition(0), _dequeuePosition(0) {
+        for (size_t i = 0; i < Capacity; i++) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MPSCQueue() {
+        auto position = _dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = _cells[position & kMask];
+            if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+                break;
+            }
+            std::launder(reinterpret_cast<T*>(&cell.storage))->~T();
+            position++;
+        }
+    }
+
+    MPSCQueue(const MPSCQueue& other) = delete;
+    MPSCQueue& operator=(const MPSCQueue& other) = delete;
+
+    /**
+     * Push the item at the end of the queue. Returns false without consuming
+     * the item if the queue is full.
+     */
+    bool tryPush(T&& item) {
+        auto position = _enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[position & kMask];
+            auto sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (&cell->storage) T(std::move(item));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Pop the item at the front of the queue. Returns false if the queue is empty,
+     * or if the producer of the front item has not finished writing it yet.
+     * Must only be called by one consumer at a time.
+     */
+    bool tryPop(T& output) {
+        auto position = _dequeuePosition.load(std::memory_order_relaxed);
+        auto& cell = _cells[position & kMask];
+        auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) < 0) {
+            return false;
+        }
+
+        auto* item = std::launder(reinterpret_cast<T*>(&cell.storage));
+        output = std::move(*item);
+        item->~T();
+        cell.sequence.store(position + Capacity, std::memory_order_release);
+        _dequeuePosition.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Returns whether the queue has no items, including items which are currently being pushed.
+     */
+    bool empty() const {
+        return _enqueuePosition.load(std::memory_order_seq_cst) == _dequeuePosition.load(std::memory_order_seq_cst);
+    }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    Cell _cells[Capacity];
+    alignas(64) std::atomic<size_t> _enqueuePosition;
+    alignas(64) std::atomic<size_t> _dequeuePosition;
+};
+
+} // namespace Valdi
@@ -0,0 +1,159 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_core/cpp/Threading/PooledDispatchQueue.hpp"
+
+namespace Valdi {
+
+// Maximum number of tasks a drain runs before yielding its worker back to the pool,
+// so that a queue with a lot of work does not starve the other queues sharing the pool.
+constexpr size_t kMaxTasksPerDrain = 32;
+
+static thread_local PooledDispatchQueue* current = nullptr;
+
+PooledDispatchQueue::PooledDispatchQueue(const StringBox& name,
+                                         const Ref<ThreadPool>& threadPool,
+                                         size_t maxConcurrentTasks)
+    : _name(name),
+      _threadPool(threadPool),
+      _taskQueue(makeShared<TaskQueue>()),
+      _maxConcurrentTasks(std::max(maxConcurrentTasks, static_cast<size_t>(1))),
+      _scheduledDrains(0) {
+    _taskQueue->setMaxConcurrentTasks(_maxConcurrentTasks);
+}
+
+PooledDispatchQueue::~PooledDispatchQueue() {
+    _taskQueue->dispose();
+}
+
+void PooledDispatchQueue::sync(const DispatchFunction& function) {
+    _taskQueue->barrier([&]() {
+        auto* previousCurrent = current;
+        current = this;
+        _runningSync = true;
+        function();
+        current = previousCurrent;
+        _runningSync = false;
+    });
+
+    // Drains that ran into our barrier have exited, tasks enqueued behind it need a new one.
+    scheduleDrainIfNeeded();
+}
+
+void PooledDispatchQueue::async(DispatchFunction function) {
+    _taskQueue->enqueue(std::move(function));
+    scheduleDrainIfNeeded();
+}
+
+task_id_t PooledDispatchQueue::asyncAfter(DispatchFunction function, std::chrono::steady_clock::duration delay) {
+    auto executeTime = std::chrono::steady_clock::now() + delay;
+    auto task = _taskQueue->enqueue(std::move(function), executeTime);
+
+    _threadPool->submitAfter(
+        [weakSelf = weakRef(this)]() {
+            auto self = weakSelf.lock();
+            if (self != nullptr) {
+                self->scheduleDrainIfNeeded();
+            }
+        },
+        executeTime);
+
+    return task.id;
+}
+
+void PooledDispatchQueue::cancel(task_id_t taskId) {
+    _taskQueue->cancel(taskId);
+}
+
+bool PooledDispatchQueue::isCurrent() const {
+    return current == this;
+}
+
+void PooledDispatchQueue::fullTeardown() {
+    _taskQueue->dispose();
+}
+
+bool PooledDispatchQueue::isDisposed() const {
+    return _taskQueue->isDisposed();
+}
+
+void PooledDispatchQueue::setListener(const Shared<IQueueListener>& listener) {
+    _taskQueue->setListener(listener);
+}
+
+Shared<IQueueListener> PooledDispatchQueue::getListener() const {
+    return _taskQueue->getListener();
+}
+
+void PooledDispatchQueue::setMaxConcurrentTasks(size_t maxConcurrentTasks) {
+    maxConcurrentTasks = std::max(maxConcurrentTasks, static_cast<size_t>(1));
+    _maxConcurrentTasks = maxConcurrentTasks;
+    _taskQueue->setMaxConcurrentTasks(maxConcurrentTasks);
+    scheduleDrainIfNeeded();
+}
+
+size_t PooledDispatchQueue::getMaxConcurrentTasks() const {
+    return _maxConcurrentTasks;
+}
+
+const StringBox& PooledDispatchQueue::getName() const {
+    return _name;
+}
+
+PooledDispatchQueue* PooledDispatchQueue::getCurrent() {
+    return current;
+}
+
+bool PooledDispatchQueue::tryAcquireDrainSlot() {
+    auto scheduledDrains = _scheduledDrains.load();
+    while (scheduledDrains < _maxConcurrentTasks.load()) {
+        if (_scheduledDrains.compare_exchange_weak(scheduledDrains, scheduledDrains + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PooledDispatchQueue::scheduleDrainIfNeeded() {
+    if (_taskQueue->isDisposed()) {
+        return;
+    }
+
+    if (tryAcquireDrainSlot()) {
+        submitDrain();
+    }
+}
+
+void PooledDispatchQueue::submitDrain() {
+    _threadPool->submit([self = strongSmallRef(this)]() { self->drain(); });
+}
+
+void PooledDispatchQueue::drain() {
+    auto* previousCurrent = current;
+    current = this;
+
+    size_t remainingTasks = kMaxTasksPerDrain;
+    for (;;) {
+        while (remainingTasks > 0 && _taskQueue->runNextTask()) {
+            remainingTasks--;
+        }
+
+        if (remainingTasks == 0) {
+            // Keep our slot and go to the back of the pool
+            current = previousCurrent;
+            submitDrain();
+            return;
+        }
+
+        _scheduledDrains.fetch_sub(1);
+
+        // A task might have been enqueued while we were releasing our slot,
+        // in which case the enqueuer could have seen all slots as taken.
+        if (!_taskQueue->hasReadyTask(std::chrono::steady_clock::now()) || !tryAcquireDrainSlot()) {
+            break;
+        }
+    }
+
+    current = previousCurrent;
+}
+
+} // namespace Valdi
@@ -0,0 +1,62 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Threading/DispatchQueue.hpp"
+#include "valdi_core/cpp/Threading/TaskQueue.hpp"
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
+#include <atomic>
+
+namespace Valdi {
+
+/**
+ * A DispatchQueue which does not own any thread, and instead runs its tasks
+ * on the workers of a ThreadPool. Tasks are kept in a TaskQueue which provides
+ * the ordering, delays and barriers, while the pool only provides the threads.
+ *
+ * With maxConcurrentTasks set to 1 the queue is serial: tasks execute in order and
+ * never overlap, although consecutive tasks might execute on different workers.
+ * With a higher value, up to maxConcurrentTasks tasks can run at the same time.
+ */
+class PooledDispatchQueue : public DispatchQueue {
+public:
+    PooledDispatchQueue(const StringBox& name, const Ref<ThreadPool>& threadPool, size_t maxConcurrentTasks);
+    ~PooledDispatchQueue() override;
+
+    void sync(const DispatchFunction& function) final;
+    void async(DispatchFunction function) final;
+    task_id_t asyncAfter(DispatchFunction function, std::chrono::steady_clock::duration delay) final;
+    void cancel(task_id_t taskId) final;
+
+    bool isCurrent() const final;
+
+    void fullTeardown() final;
+
+    bool isDisposed() const;
+
+    void setListener(const Shared<IQueueListener>& listener) final;
+
+    void setMaxConcurrentTasks(size_t maxConcurrentTasks);
+    size_t getMaxConcurrentTasks() const;
+
+    const StringBox& getName() const;
+
+    static PooledDispatchQueue* getCurrent();
+
+    // For Testing Only
+    Shared<IQueueListener> getListener() const final;
+
+private:
+    StringBox _name;
+    Ref<ThreadPool> _threadPool;
+    Ref<TaskQueue> _taskQueue;
+    std::atomic<size_t> _maxConcurrentTasks;
+    std::atomic<size_t> _scheduledDrains;
+
+    void scheduleDrainIfNeeded();
+    bool tryAcquireDrainSlot();
+    void submitDrain();
+    void drain();
+};
+
+} // namespace Valdi
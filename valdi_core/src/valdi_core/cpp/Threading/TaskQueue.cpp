@@ -14,12 +14,21 @@
 
 namespace Valdi {
 
+TaskQueue::Task::Task() : id(0), isBarrier(false) {}
+
 TaskQueue::Task::Task(task_id_t id,
                       DispatchFunction function,
                       std::chrono::steady_clock::time_point executeTime,
                       bool isBarrier)
     : id(id), function(std::move(function)), executeTime(executeTime), isBarrier(isBarrier) {}
 
+bool TaskQueue::Task::isBefore(const Task& other) const {
+    if (executeTime == other.executeTime) {
+        return id < other.id;
+    }
+    return executeTime < other.executeTime;
+}
+
 TaskQueue::TaskQueue() : _disposed(false) {}
 
 TaskQueue::~TaskQueue() {
@@ -29,9 +38,13 @@ TaskQueue::~TaskQueue() {
 void TaskQueue::dispose() {
     if (!_disposed) {
         _disposed = true;
-        std::deque<Task> toDelete;
+        TimerHeap<std::chrono::steady_clock::time_point, Task> toDelete;
+        std::deque<Task> immediateTasksToDelete;
         _mutex.lock();
-        toDelete.swap(_tasks);
+        lockFreeDrainImmediateTasksRing();
+        std::swap(toDelete, _tasks);
+        immediateTasksToDelete.swap(_immediateTasks);
+        _orderedTaskHandles.clear();
         _mutex.unlock();
         _condition.notifyAll();
     }
@@ -50,7 +63,28 @@ task_id_t TaskQueue::asyncAfter(DispatchFunction function, std::chrono::steady_c
 }
 
 EnqueuedTask TaskQueue::enqueue(Valdi::DispatchFunction function) {
-    return enqueue(std::move(function), std::chrono::steady_clock::now());
+    EnqueuedTask enqueuedTask;
+
+    if (_disposed) {
+        return enqueuedTask;
+    }
+
+    // Fast path: immediate tasks are pushed onto the lock-free ring,
+    // consumers merge them with the ordered tasks by execute time.
+    Task task(++_taskIdCounter, std::move(function), std::chrono::steady_clock::now(), false);
+    enqueuedTask.id = task.id;
+
+    if (VALDI_UNLIKELY(!_immediateTasksRing.tryPush(std::move(task)))) {
+        // The ring is full, the task still sorts properly against the ring tasks
+        // since they all have an earlier execute time or id.
+        std::lock_guard<Mutex> lockGuard(_mutex);
+        lockFreeInsertTask(std::move(task));
+    }
+
+    onTaskEnqueued(enqueuedTask);
+    notifyWaitingThreads();
+
+    return enqueuedTask;
 }
 
 EnqueuedTask TaskQueue::enqueue(Valdi::DispatchFunction function, std::chrono::steady_clock::duration delay) {
@@ -62,21 +96,17 @@ task_id_t TaskQueue::insertTask(DispatchFunction&& function,
                                 bool isBarrier) {
     auto id = ++_taskIdCounter;
 
-    // Keep the tasks sorted by execute time
-    Task task(id, std::move(function), executeTime, isBarrier);
-
-    auto it = std::upper_bound(_tasks.begin(), _tasks.end(), task, [](const Task& a, const Task& b) {
-        if (a.executeTime == b.executeTime) {
-            return a.id < b.id;
-        }
-        return a.executeTime < b.executeTime;
-    });
-
-    _tasks.emplace(it, std::move(task));
+    lockFreeInsertTask(Task(id, std::move(function), executeTime, isBarrier));
 
     return id;
 }
 
+void TaskQueue::lockFreeInsertTask(Task&& task) {
+    auto id = task.id;
+    auto executeTime = task.executeTime;
+    _orderedTaskHandles[id] = _tasks.insert(executeTime, static_cast<uint64_t>(id), std::move(task));
+}
+
 EnqueuedTask TaskQueue::enqueue(Valdi::DispatchFunction function, std::chrono::steady_clock::time_point executeTime) {
     EnqueuedTask enqueuedTask;
 
@@ -86,11 +116,25 @@ EnqueuedTask TaskQueue::enqueue(Valdi::DispatchFunction function, std::chrono::s
 
     {
         std::lock_guard<Mutex> lockGuard(_mutex);
-
         enqueuedTask.id = insertTask(std::move(function), executeTime, false);
-        enqueuedTask.isFirst = _first;
-        _first = false;
+    }
+
+    onTaskEnqueued(enqueuedTask);
+    _condition.notifyAll();
+
+    return enqueuedTask;
+}
 
+void TaskQueue::onTaskEnqueued(EnqueuedTask& enqueuedTask) {
+    if (VALDI_UNLIKELY(_first.load(std::memory_order_relaxed))) {
+        enqueuedTask.isFirst = _first.exchange(false);
+    }
+
+    // Pairs with the store to _empty in nextTask(), either we see the queue as empty
+    // and notify the listener, or the consumer sees our task and does not consider the queue empty.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (VALDI_UNLIKELY(_empty.load())) {
+        std::lock_guard<Mutex> lockGuard(_mutex);
         if (_empty) {
             _empty = false;
             if (_listener != nullptr) {
@@ -98,15 +142,85 @@ EnqueuedTask TaskQueue::enqueue(Valdi::DispatchFunction function, std::chrono::s
             }
         }
     }
+}
+
+void TaskQueue::notifyWaitingThreads() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_waitingThreads.load() == 0) {
+        return;
+    }
+
+    {
+        // Waiting threads register themselves with the lock held, taking it
+        // guarantees that they are either waiting on the condition or will see our task.
+        std::lock_guard<Mutex> lockGuard(_mutex);
+    }
 
     _condition.notifyAll();
-    return enqueuedTask;
+}
+
+std::cv_status TaskQueue::lockFreeWaitUntil(std::unique_lock<Mutex>& lock,
+                                            std::chrono::steady_clock::time_point maxTime) {
+    _waitingThreads.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!_immediateTasksRing.empty()) {
+        // A task was pushed since we last looked at the ring
+        _waitingThreads.fetch_sub(1);
+        return std::cv_status::no_timeout;
+    }
+
+    auto result = std::cv_status::no_timeout;
+    if (maxTime == std::chrono::steady_clock::time_point::max()) {
+        _condition.wait(lock);
+    } else {
+        result = _condition.waitUntil(lock, maxTime);
+    }
+
+    _waitingThreads.fetch_sub(1);
+    return result;
+}
+
+void TaskQueue::lockFreeDrainImmediateTasksRing() {
+    Task task;
+    while (_immediateTasksRing.tryPop(task)) {
+        _immediateTasks.emplace_back(std::move(task));
+    }
+}
+
+const TaskQueue::Task* TaskQueue::lockFreeFrontTask() {
+    lockFreeDrainImmediateTasksRing();
+
+    if (_immediateTasks.empty()) {
+        return _tasks.empty() ? nullptr : &_tasks.top();
+    }
+    if (_tasks.empty()) {
+        return &_immediateTasks.front();
+    }
+
+    const auto& orderedTask = _tasks.top();
+    const auto& immediateTask = _immediateTasks.front();
+
+    return orderedTask.isBefore(immediateTask) ? &orderedTask : &immediateTask;
+}
+
+DispatchFunction TaskQueue::lockFreePopFrontTask() {
+    if (_immediateTasks.empty() || (!_tasks.empty() && _tasks.top().isBefore(_immediateTasks.front()))) {
+        auto task = _tasks.pop();
+        _orderedTaskHandles.erase(task.id);
+        return std::move(task.function);
+    }
+
+    auto function = std::move(_immediateTasks.front().function);
+    _immediateTasks.pop_front();
+    return function;
 }
 
 void TaskQueue::cancel(Valdi::task_id_t taskId) {
     {
         DispatchFunction toDelete;
         std::lock_guard<Mutex> lockGuard(_mutex);
+        lockFreeDrainImmediateTasksRing();
         toDelete = lockFreeRemoveTask(taskId);
     }
 
@@ -114,10 +228,21 @@ void TaskQueue::cancel(Valdi::task_id_t taskId) {
 }
 
 DispatchFunction TaskQueue::lockFreeRemoveTask(task_id_t taskId) {
-    for (auto i = _tasks.begin(); i != _tasks.end(); ++i) {
+    const auto& it = _orderedTaskHandles.find(taskId);
+    if (it != _orderedTaskHandles.end()) {
+        auto task = _tasks.remove(it->second);
+        _orderedTaskHandles.erase(it);
+        if (task) {
+            return std::move(task->function);
+        }
+        return DispatchFunction();
+    }
+
+    // Immediate tasks are rarely cancelled and usually don't stay long in the queue
+    for (auto i = _immediateTasks.begin(); i != _immediateTasks.end(); ++i) {
         if (i->id == taskId) {
             auto task = std::move(*i);
-            _tasks.erase(i);
+            _immediateTasks.erase(i);
             return std::move(task.function);
         }
     }
@@ -131,10 +256,16 @@ void TaskQueue::barrier(const DispatchFunction& function) {
     std::unique_lock<Mutex> lockGuard(_mutex);
     auto id = insertTask(DispatchFunction(), executeTime, true);
 
-    while (!_tasks.empty()) {
+    for (;;) {
+        const auto* frontTask = lockFreeFrontTask();
+        if (frontTask == nullptr) {
+            // Queue was disposed
+            return;
+        }
+
         // Wait until we have no currently running tasks, and that the task at the front is our barrier task
-        if (_currentRunningTasks != 0 || _tasks.front().id != id) {
-            _condition.wait(lockGuard);
+        if (_currentRunningTasks != 0 || frontTask->id != id) {
+            lockFreeWaitUntil(lockGuard, std::chrono::steady_clock::time_point::max());
             continue;
         }
 
@@ -157,15 +288,22 @@ DispatchFunction TaskQueue::nextTask(std::chrono::steady_clock::time_point maxTi
     bool hasTask = false;
 
     while (!_disposed) {
-        if (_tasks.empty()) {
+        const auto* nextTask = lockFreeFrontTask();
+        if (nextTask == nullptr) {
             if (!_empty) {
                 _empty = true;
+                // Pairs with the fence in onTaskEnqueued()
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!_immediateTasksRing.empty()) {
+                    _empty = false;
+                    continue;
+                }
                 if (_listener != nullptr) {
                     _listener->onQueueEmpty();
                 }
             }
             // Wait until there's at least one task
-            auto result = _condition.waitUntil(lockGuard, maxTime);
+            auto result = lockFreeWaitUntil(lockGuard, maxTime);
             if (result == std::cv_status::timeout) {
                 // We timed out waiting for tasks, so we break now
                 break;
@@ -177,7 +315,7 @@ DispatchFunction TaskQueue::nextTask(std::chrono::steady_clock::time_point maxTi
 
         if (_currentRunningTasks >= _maxConcurrentTasks) {
             // Wait until there are no more pending running tasks
-            auto result = _condition.waitUntil(lockGuard, maxTime);
+            auto result = lockFreeWaitUntil(lockGuard, maxTime);
             if (result == std::cv_status::timeout) {
                 // We timed out waiting for tasks, so we break now
                 break;
@@ -188,19 +326,18 @@ DispatchFunction TaskQueue::nextTask(std::chrono::steady_clock::time_point maxTi
         }
 
         // Wait until the next task is ready to run
-        const auto& nextTask = _tasks.front();
-        if (VALDI_UNLIKELY(nextTask.isBarrier)) {
-            auto result = _condition.waitUntil(lockGuard, maxTime);
+        if (VALDI_UNLIKELY(nextTask->isBarrier)) {
+            auto result = lockFreeWaitUntil(lockGuard, maxTime);
 
             if (result == std::cv_status::timeout) {
                 break;
             } else {
                 continue;
             }
-        } else if (nextTask.executeTime > std::chrono::steady_clock::now()) {
-            auto maxTimeToWait = std::min(maxTime, nextTask.executeTime);
+        } else if (nextTask->executeTime > std::chrono::steady_clock::now()) {
+            auto maxTimeToWait = std::min(maxTime, nextTask->executeTime);
 
-            auto result = _condition.waitUntil(lockGuard, maxTimeToWait);
+            auto result = lockFreeWaitUntil(lockGuard, maxTimeToWait);
 
             // If we reached the given maxTime, we should abort.
             if (maxTimeToWait == maxTime && result == std::cv_status::timeout) {
@@ -219,9 +356,8 @@ DispatchFunction TaskQueue::nextTask(std::chrono::steady_clock::time_point maxTi
     if (_disposed || !hasTask) {
         *shouldRun = false;
     } else {
-        nextTaskFunction = std::move(_tasks.front().function);
+        nextTaskFunction = lockFreePopFrontTask();
         _currentRunningTasks++;
-        _tasks.pop_front();
     }
     return nextTaskFunction;
 }
@@ -267,6 +403,16 @@ bool TaskQueue::runNextTask(std::chrono::steady_clock::time_point maxTime) {
     return shouldRun;
 }
 
+bool TaskQueue::hasReadyTask(std::chrono::steady_clock::time_point time) {
+    std::lock_guard<Mutex> lockGuard(_mutex);
+    if (_disposed || _currentRunningTasks >= _maxConcurrentTasks) {
+        return false;
+    }
+
+    const auto* nextTask = lockFreeFrontTask();
+    return nextTask != nullptr && !nextTask->isBarrier && nextTask->executeTime <= time;
+}
+
 bool TaskQueue::isDisposed() const {
     return _disposed;
 }
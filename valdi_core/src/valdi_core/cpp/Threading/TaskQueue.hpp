@@ -10,10 +10,13 @@
 
 #include "valdi_core/cpp/Threading/IDispatchQueue.hpp"
 #include "valdi_core/cpp/Threading/IQueueListener.hpp"
+#include "valdi_core/cpp/Threading/MPSCQueue.hpp"
 #include "valdi_core/cpp/Threading/TaskId.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Function.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/TimerHeap.hpp"
 #include <chrono>
 #include <queue>
 
@@ -48,6 +51,12 @@ public:
     size_t flush();
     size_t flushUpToNow();
 
+    /**
+     * Returns whether runNextTask() would be able to dequeue a task right away
+     * if it was called at the given time.
+     */
+    bool hasReadyTask(std::chrono::steady_clock::time_point time);
+
     bool isDisposed() const;
     void setListener(const Shared<IQueueListener>& listener);
 
@@ -63,19 +72,33 @@ private:
         std::chrono::steady_clock::time_point executeTime;
         bool isBarrier;
 
+        Task();
         Task(task_id_t id,
              DispatchFunction function,
              std::chrono::steady_clock::time_point executeTime,
              bool isBarrier);
+
+        bool isBefore(const Task& other) const;
     };
 
+    // Capacity of the lock-free ring used for immediate tasks. When full,
+    // producers fall back to the ordered path under the lock.
+    static constexpr size_t kImmediateTasksRingCapacity = 256;
+
     std::atomic_bool _disposed;
-    mutable Mutex _mutex;
+    mutable Mutex _mutex{"TaskQueue"};
     ConditionVariable _condition;
-    task_id_t _taskIdCounter{0};
-    std::deque<Task> _tasks;
-    bool _empty = true;
-    bool _first = true;
+    std::atomic<task_id_t> _taskIdCounter{0};
+    // Delayed tasks, barriers and overflowing immediate tasks, ordered by execute time
+    TimerHeap<std::chrono::steady_clock::time_point, Task> _tasks;
+    FlatMap<task_id_t, TimerHeapHandle> _orderedTaskHandles;
+    // Immediate tasks which were moved out of the ring by a consumer, in FIFO order
+    std::deque<Task> _immediateTasks;
+    // Immediate tasks pushed by producers without taking the lock. Only consumed with _mutex held.
+    MPSCQueue<Task, kImmediateTasksRingCapacity> _immediateTasksRing;
+    std::atomic_bool _empty{true};
+    std::atomic_bool _first{true};
+    std::atomic<size_t> _waitingThreads{0};
     size_t _currentRunningTasks = 0;
     size_t _maxConcurrentTasks = 1;
     Shared<IQueueListener> _listener;
@@ -85,7 +108,15 @@ private:
     task_id_t insertTask(DispatchFunction&& function,
                          std::chrono::steady_clock::time_point executeTime,
                          bool isBarrier);
+    void lockFreeInsertTask(Task&& task);
+
+    void onTaskEnqueued(EnqueuedTask& enqueuedTask);
+    void notifyWaitingThreads();
 
+    std::cv_status lockFreeWaitUntil(std::unique_lock<Mutex>& lock, std::chrono::steady_clock::time_point maxTime);
+    void lockFreeDrainImmediateTasksRing();
+    const Task* lockFreeFrontTask();
+    DispatchFunction lockFreePopFrontTask();
     DispatchFunction lockFreeRemoveTask(task_id_t taskId);
 };
 
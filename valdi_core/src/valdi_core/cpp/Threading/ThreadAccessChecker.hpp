@@ -5,6 +5,8 @@
 //  Created by Simon Corsin on 4/12/2024
 //
 
+#pragma once
+
 #include "utils/base/NonCopyable.hpp"
 #include "valdi_core/cpp/Threading/ThreadBase.hpp"
 #include <atomic>
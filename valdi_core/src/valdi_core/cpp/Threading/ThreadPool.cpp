@@ -0,0 +1,403 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_core/cpp/Threading/ThreadPool.hpp"
+#include "utils/debugging/Assert.hpp"
+#include "valdi_core/cpp/Constants.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <fmt/format.h>
+#include <limits>
+#include <thread>
+
+namespace Valdi {
+
+// How often a worker looks at the injection queue even when its own deque is not empty,
+// so that tasks submitted from outside the pool cannot be starved by a busy worker.
+constexpr uint32_t kInjectionQueuePollInterval = 61;
+constexpr int64_t kNoTimerDeadline = std::numeric_limits<int64_t>::max();
+
+static thread_local ThreadPool* currentPool = nullptr;
+static thread_local void* currentWorker = nullptr;
+
+ThreadPool::Task::Task(DispatchFunction&& function) : function(std::move(function)) {}
+
+bool ThreadPool::Timer::operator>(const Timer& other) const {
+    if (executeTime == other.executeTime) {
+        return sequence > other.sequence;
+    }
+    return executeTime > other.executeTime;
+}
+
+ThreadPool::Worker::Worker(size_t index)
+    : index(index), stealSeed(static_cast<uint32_t>(index * 2654435761u + 1)) {}
+
+ThreadPool::ThreadPool(const StringBox& name, size_t workersCount, ThreadQoSClass qosClass)
+    : _name(name),
+      _qosClass(qosClass),
+      _disposed(false),
+      _injectionQueueSize(0),
+      _nextTimerDeadline(kNoTimerDeadline),
+      _sleepingWorkers(0) {
+    workersCount = std::max(workersCount, static_cast<size_t>(1));
+    _workers.reserve(workersCount);
+    for (size_t i = 0; i < workersCount; i++) {
+        _workers.emplace_back(std::make_unique<Worker>(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    teardown();
+}
+
+size_t ThreadPool::getWorkersCount() const {
+    return _workers.size();
+}
+
+bool ThreadPool::isCurrent() const {
+    return currentPool == this;
+}
+
+void ThreadPool::submit(DispatchFunction function) {
+    if (_disposed) {
+        return;
+    }
+
+    auto* task = new Task(std::move(function));
+
+    if (currentPool == this) {
+        // Fast path: submitting from one of our workers, push onto its own deque.
+        reinterpret_cast<Worker*>(currentWorker)->deque.push(task);
+    } else {
+        startIfNeeded();
+
+        std::lock_guard<Mutex> guard(_mutex);
+        _injectionQueue.emplace_back(task);
+        _injectionQueueSize.fetch_add(1);
+    }
+
+    wakeUpWorker();
+}
+
+namespace {
+
+struct ParallelForState : public SimpleRefCountable {
+    Mutex mutex;
+    ConditionVariable condition;
+    const Function<void(size_t)>* function;
+    size_t count;
+    std::atomic<size_t> nextIndex;
+    size_t activeHelpers = 0;
+
+    ParallelForState(const Function<void(size_t)>* function, size_t count)
+        : function(function), count(count), nextIndex(0) {}
+
+    void runLoop() {
+        for (;;) {
+            auto index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+            if (index >= count) {
+                return;
+            }
+            (*function)(index);
+        }
+    }
+};
+
+} // namespace
+
+void ThreadPool::parallelFor(size_t count, size_t maxConcurrency, const Function<void(size_t)>& function) {
+    if (count == 0) {
+        return;
+    }
+
+    auto helpersCount = std::min(std::min(count, maxConcurrency), getWorkersCount() + 1);
+    if (helpersCount <= 1 || _disposed) {
+        for (size_t i = 0; i < count; i++) {
+            function(i);
+        }
+        return;
+    }
+
+    auto state = makeShared<ParallelForState>(&function, count);
+    for (size_t i = 1; i < helpersCount; i++) {
+        submit([state]() {
+            {
+                std::lock_guard<Mutex> guard(state->mutex);
+                if (state->function == nullptr) {
+                    // The caller already completed all the work
+                    return;
+                }
+                state->activeHelpers++;
+            }
+
+            state->runLoop();
+
+            std::lock_guard<Mutex> guard(state->mutex);
+            state->activeHelpers--;
+            state->condition.notifyAll();
+        });
+    }
+
+    state->runLoop();
+
+    // The function lives on our stack, wait for the helpers that picked it up before returning
+    std::unique_lock<Mutex> lock(state->mutex);
+    while (state->activeHelpers > 0) {
+        state->condition.wait(lock);
+    }
+    state->function = nullptr;
+}
+
+void ThreadPool::submitAfter(DispatchFunction function, std::chrono::steady_clock::time_point executeTime) {
+    if (_disposed) {
+        return;
+    }
+
+    startIfNeeded();
+
+    bool isEarliest;
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+        auto previousDeadline = _nextTimerDeadline.load();
+        _timers.emplace(Timer{executeTime, ++_timerSequence, new Task(std::move(function))});
+        updateNextTimerDeadline();
+        isEarliest = _nextTimerDeadline.load() < previousDeadline;
+    }
+
+    if (isEarliest) {
+        // A sleeping worker might need to wake up earlier than it planned
+        _condition.notifyOne();
+    }
+}
+
+void ThreadPool::startIfNeeded() {
+    std::lock_guard<Mutex> guard(_mutex);
+    if (_started || _disposed) {
+        return;
+    }
+    _started = true;
+
+    for (auto& worker : _workers) {
+        auto threadResult = Thread::create(STRING_FORMAT("{} {}", _name.toStringView(), worker->index),
+                                           _qosClass,
+                                           [self = strongSmallRef(this), worker = worker.get()]() {
+                                               self->runWorker(*worker);
+                                           });
+        SC_ASSERT(threadResult.success(), threadResult.description());
+        worker->thread = threadResult.moveValue();
+    }
+}
+
+void ThreadPool::teardown() {
+    if (_disposed.exchange(true)) {
+        return;
+    }
+
+    {
+        std::lock_guard<Mutex> guard(_mutex);
+    }
+    _condition.notifyAll();
+
+    for (auto& worker : _workers) {
+        if (worker->thread != nullptr) {
+            if (currentWorker != worker.get()) {
+                worker->thread->join();
+            }
+            // Releases the reference the worker holds on us
+            worker->thread = nullptr;
+        }
+    }
+
+    for (auto& worker : _workers) {
+        while (auto* task = worker->deque.pop()) {
+            delete task;
+        }
+    }
+
+    std::lock_guard<Mutex> guard(_mutex);
+    for (auto* task : _injectionQueue) {
+        delete task;
+    }
+    _injectionQueue.clear();
+    _injectionQueueSize = 0;
+    while (!_timers.empty()) {
+        delete _timers.top().task;
+        _timers.pop();
+    }
+    _nextTimerDeadline = kNoTimerDeadline;
+}
+
+void ThreadPool::runWorker(Worker& worker) {
+    currentPool = this;
+    currentWorker = &worker;
+
+    while (!_disposed) {
+        auto* task = nextTask(worker);
+        if (task == nullptr) {
+            if (!waitForWork()) {
+                break;
+            }
+            continue;
+        }
+
+        task->function();
+        delete task;
+    }
+
+    currentPool = nullptr;
+    currentWorker = nullptr;
+}
+
+ThreadPool::Task* ThreadPool::nextTask(Worker& worker) {
+    Task* task = nullptr;
+    if (VALDI_UNLIKELY(++worker.tick % kInjectionQueuePollInterval == 0)) {
+        task = popInjectionQueue();
+    }
+    if (task == nullptr) {
+        task = worker.deque.pop();
+    }
+    if (task == nullptr) {
+        task = popInjectionQueue();
+    }
+    if (task == nullptr) {
+        task = steal(worker);
+    }
+    return task;
+}
+
+ThreadPool::Task* ThreadPool::popInjectionQueue() {
+    auto now = std::chrono::steady_clock::now();
+    if (_injectionQueueSize.load(std::memory_order_relaxed) == 0 &&
+        _nextTimerDeadline.load(std::memory_order_relaxed) > now.time_since_epoch().count()) {
+        return nullptr;
+    }
+
+    std::lock_guard<Mutex> guard(_mutex);
+    promoteExpiredTimers(now);
+
+    if (_injectionQueue.empty()) {
+        return nullptr;
+    }
+
+    auto* task = _injectionQueue.front();
+    _injectionQueue.pop_front();
+    _injectionQueueSize.fetch_sub(1);
+
+    return task;
+}
+
+ThreadPool::Task* ThreadPool::steal(Worker& worker) {
+    auto workersCount = _workers.size();
+    if (workersCount <= 1) {
+        return nullptr;
+    }
+
+    // xorshift, to avoid all the idle workers hammering the same victim
+    worker.stealSeed ^= worker.stealSeed << 13;
+    worker.stealSeed ^= worker.stealSeed >> 17;
+    worker.stealSeed ^= worker.stealSeed << 5;
+
+    auto start = static_cast<size_t>(worker.stealSeed) % workersCount;
+    for (size_t i = 0; i < workersCount; i++) {
+        auto& victim = *_workers[(start + i) % workersCount];
+        if (&victim == &worker) {
+            continue;
+        }
+        auto* task = victim.deque.steal();
+        if (task != nullptr) {
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+bool ThreadPool::hasPendingWork() const {
+    if (_injectionQueueSize.load() != 0) {
+        return true;
+    }
+    for (const auto& worker : _workers) {
+        if (!worker->deque.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::waitForWork() {
+    std::unique_lock<Mutex> lock(_mutex);
+    _sleepingWorkers.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!_disposed && !hasPendingWork()) {
+        auto deadline = _nextTimerDeadline.load();
+        if (deadline == kNoTimerDeadline) {
+            _condition.wait(lock);
+        } else {
+            _condition.waitUntil(lock,
+                                 std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(deadline)));
+        }
+    }
+
+    auto promotedTimers = promoteExpiredTimers(std::chrono::steady_clock::now());
+    _sleepingWorkers.fetch_sub(1);
+    lock.unlock();
+
+    if (promotedTimers > 1) {
+        // This worker will only pick one of them, let the others help
+        _condition.notifyAll();
+    }
+
+    return !_disposed;
+}
+
+size_t ThreadPool::promoteExpiredTimers(std::chrono::steady_clock::time_point now) {
+    if (_nextTimerDeadline.load(std::memory_order_relaxed) > now.time_since_epoch().count()) {
+        return 0;
+    }
+
+    size_t promoted = 0;
+    while (!_timers.empty() && _timers.top().executeTime <= now) {
+        _injectionQueue.emplace_back(_timers.top().task);
+        _injectionQueueSize.fetch_add(1);
+        _timers.pop();
+        promoted++;
+    }
+
+    updateNextTimerDeadline();
+
+    return promoted;
+}
+
+void ThreadPool::updateNextTimerDeadline() {
+    if (_timers.empty()) {
+        _nextTimerDeadline = kNoTimerDeadline;
+    } else {
+        _nextTimerDeadline = _timers.top().executeTime.time_since_epoch().count();
+    }
+}
+
+void ThreadPool::wakeUpWorker() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleepingWorkers.load() == 0) {
+        return;
+    }
+
+    {
+        // Synchronize with a worker that might be between its last check and its wait
+        std::lock_guard<Mutex> guard(_mutex);
+    }
+    _condition.notifyOne();
+}
+
+size_t ThreadPool::getDefaultWorkersCount() {
+    auto cores = static_cast<size_t>(std::thread::hardware_concurrency());
+    // Keep one core for the main thread
+    return std::max(cores, static_cast<size_t>(3)) - 1;
+}
+
+const Ref<ThreadPool>& ThreadPool::getShared() {
+    static auto* kSharedPool = new Ref<ThreadPool>(
+        makeShared<ThreadPool>(STRING_LITERAL("Valdi Pool Worker"), getDefaultWorkersCount(), ThreadQoSClassNormal));
+    return *kSharedPool;
+}
+
+} // namespace Valdi
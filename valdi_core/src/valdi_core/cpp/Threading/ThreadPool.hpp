@@ -0,0 +1,130 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Threading/Thread.hpp"
+#include "valdi_core/cpp/Threading/ThreadQoSClass.hpp"
+#include "valdi_core/cpp/Threading/WorkStealingDeque.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <queue>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ * A fixed-size pool of worker threads which schedules submitted functions using work stealing.
+ * Each worker owns a lock-free deque: functions submitted from a worker are pushed onto its own
+ * deque, functions submitted from any other thread go through a shared injection queue.
+ * Idle workers steal from the other workers before going to sleep.
+ *
+ * The ThreadPool has no ordering guarantees, use a PooledDispatchQueue to get serial
+ * or bounded concurrent execution on top of it.
+ *
+ * Workers are started lazily on the first submit and retain the pool while they run,
+ * teardown() must be called to release a pool that was used.
+ */
+class ThreadPool : public SharedPtrRefCountable {
+public:
+    ThreadPool(const StringBox& name, size_t workersCount, ThreadQoSClass qosClass);
+    ThreadPool(const ThreadPool& other) = delete;
+    ~ThreadPool() override;
+
+    /**
+     * Schedule the function to run on one of the workers as soon as possible.
+     */
+    void submit(DispatchFunction function);
+
+    /**
+     * Schedule the function to run on one of the workers once the given time is reached.
+     */
+    void submitAfter(DispatchFunction function, std::chrono::steady_clock::time_point executeTime);
+
+    /**
+     * Call the function for every index in [0, count) using the calling thread and up to
+     * maxConcurrency - 1 workers, and return once all the calls have completed.
+     * The calling thread always takes part in the work, so this is safe to call from
+     * one of the workers even when the pool is saturated.
+     */
+    void parallelFor(size_t count, size_t maxConcurrency, const Function<void(size_t)>& function);
+
+    /**
+     * Stop all the workers and wait for them to exit. Functions that were not yet
+     * executed are destroyed without being called.
+     */
+    void teardown();
+
+    size_t getWorkersCount() const;
+
+    /**
+     * Returns whether the current thread is one of the workers of this pool.
+     */
+    bool isCurrent() const;
+
+    /**
+     * Returns the process wide ThreadPool, sized from the number of available cores.
+     */
+    static const Ref<ThreadPool>& getShared();
+
+    static size_t getDefaultWorkersCount();
+
+private:
+    struct Task {
+        DispatchFunction function;
+
+        explicit Task(DispatchFunction&& function);
+    };
+
+    struct Timer {
+        std::chrono::steady_clock::time_point executeTime;
+        uint64_t sequence;
+        Task* task;
+
+        bool operator>(const Timer& other) const;
+    };
+
+    struct Worker {
+        size_t index;
+        WorkStealingDeque<Task> deque;
+        Ref<Thread> thread;
+        uint32_t tick = 0;
+        uint32_t stealSeed;
+
+        explicit Worker(size_t index);
+    };
+
+    StringBox _name;
+    ThreadQoSClass _qosClass;
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    mutable Mutex _mutex;
+    ConditionVariable _condition;
+    std::deque<Task*> _injectionQueue;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> _timers;
+    uint64_t _timerSequence = 0;
+    bool _started = false;
+
+    std::atomic_bool _disposed;
+    std::atomic<size_t> _injectionQueueSize;
+    std::atomic<int64_t> _nextTimerDeadline;
+    std::atomic<size_t> _sleepingWorkers;
+
+    void startIfNeeded();
+    void runWorker(Worker& worker);
+    Task* nextTask(Worker& worker);
+    Task* popInjectionQueue();
+    Task* steal(Worker& worker);
+    bool waitForWork();
+    bool hasPendingWork() const;
+    size_t promoteExpiredTimers(std::chrono::steady_clock::time_point now);
+    void updateNextTimerDeadline();
+    void wakeUpWorker();
+};
+
+} // namespace Valdi
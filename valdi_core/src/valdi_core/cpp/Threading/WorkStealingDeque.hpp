@@ -0,0 +1,153 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ * A Chase-Lev work-stealing deque of pointers.
+ * The owner thread pushes and pops from the bottom without taking any lock,
+ * while any other thread can steal from the top. The backing array grows
+ * as needed; retired arrays are kept alive until the deque is destroyed so that
+ * concurrent stealers never read from freed memory.
+ */
+template<typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t initialCapacity = 64)
+        : _top(0), _bottom(0), _array(new Array(roundUpToPowerOfTwo(initialCapacity))) {
+        _retiredArrays.emplace_back(_array.load(std::memory_order_relaxed));
+    }
+
+    WorkStealingDeque(const WorkStealingDeque& other) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque& other) = delete;
+
+    /**
+     * Push an item at the bottom of the deque. Must only be called from the owner thread.
+     */
+    void push(T* item) {
+        auto bottom = _bottom.load(std::memory_order_relaxed);
+        auto top = _top.load(std::memory_order_acquire);
+        auto* array = _array.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(array->capacity) - 1) {
+            array = grow(array, top, bottom);
+        }
+
+        array->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Pop an item from the bottom of the deque. Must only be called from the owner thread.
+     * Returns nullptr if the deque is empty.
+     */
+    T* pop() {
+        auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        auto* array = _array.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            // Deque was empty
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* item = array->get(bottom);
+        if (top == bottom) {
+            // Last item, race against stealers
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    /**
+     * Steal an item from the top of the deque. Can be called from any thread.
+     * Returns nullptr if the deque is empty or if the steal lost a race.
+     */
+    T* steal() {
+        auto top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        auto* array = _array.load(std::memory_order_consume);
+        auto* item = array->get(top);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+
+        return item;
+    }
+
+    bool empty() const {
+        auto bottom = _bottom.load(std::memory_order_relaxed);
+        auto top = _top.load(std::memory_order_relaxed);
+        return bottom <= top;
+    }
+
+    size_t size() const {
+        auto bottom = _bottom.load(std::memory_order_relaxed);
+        auto top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+private:
+    struct Array {
+        size_t capacity;
+        size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> items;
+
+        explicit Array(size_t capacity)
+            : capacity(capacity), mask(capacity - 1), items(new std::atomic<T*>[capacity]) {}
+
+        T* get(int64_t index) const {
+            return items[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T* item) {
+            items[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> _top;
+    alignas(64) std::atomic<int64_t> _bottom;
+    alignas(64) std::atomic<Array*> _array;
+    std::vector<std::unique_ptr<Array>> _retiredArrays;
+
+    Array* grow(Array* array, int64_t top, int64_t bottom) {
+        auto* newArray = new Array(array->capacity * 2);
+        for (auto i = top; i < bottom; i++) {
+            newArray->put(i, array->get(i));
+        }
+        _retiredArrays.emplace_back(newArray);
+        _array.store(newArray, std::memory_order_release);
+        return newArray;
+    }
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t capacity = 2;
+        while (capacity < value) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+};
+
+} // namespace Valdi
@@ -0,0 +1,218 @@
+//
+//  AllocationProfiler.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/PerfCounters.hpp"
+
+#include <algorithm>
+
+#if __has_include(<unwind.h>)
+#include <unwind.h>
+#define VALDI_ALLOCATION_PROFILER_HAS_UNWIND 1
+#else
+#define VALDI_ALLOCATION_PROFILER_HAS_UNWIND 0
+#endif
+
+namespace Valdi {
+
+namespace {
+
+struct AllocationThreadState {
+    AllocationCounters counters;
+    uint64_t allocationsUntilSample = 0;
+    const std::string* traceScope = nullptr;
+    // Set while the profiler records a sample, as recording allocates itself
+    bool recording = false;
+};
+
+thread_local AllocationThreadState currentThreadState;
+
+#if VALDI_ALLOCATION_PROFILER_HAS_UNWIND
+struct BacktraceState {
+    uintptr_t* frames;
+    size_t framesCount;
+    size_t capacity;
+};
+
+_Unwind_Reason_Code unwindCallback(struct _Unwind_Context* context, void* arg) {
+    auto* state = static_cast<BacktraceState*>(arg);
+    auto pc = static_cast<uintptr_t>(_Unwind_GetIP(context));
+    if (pc != 0) {
+        if (state->framesCount == state->capacity) {
+            return _URC_END_OF_STACK;
+        }
+        state->frames[state->framesCount++] = pc;
+    }
+    return _URC_NO_REASON;
+}
+#endif
+
+__attribute__((noinline)) size_t captureBacktrace(uintptr_t* frames, size_t capacity) {
+#if VALDI_ALLOCATION_PROFILER_HAS_UNWIND
+    BacktraceState state{frames, 0, capacity};
+    _Unwind_Backtrace(unwindCallback, &state);
+    return state.framesCount;
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+const char* allocationSiteToString(AllocationSite site) {
+    switch (site) {
+        case AllocationSite::OperatorNew:
+            return "operator_new";
+        case AllocationSite::ObjectPool:
+            return "object_pool";
+        case AllocationSite::AutoMalloc:
+            return "auto_malloc";
+        case AllocationSite::ByteBuffer:
+            return "byte_buffer";
+        case AllocationSite::SmallVector:
+            return "small_vector";
+        case AllocationSite::CoroutineFrame:
+            return "coroutine_frame";
+        case AllocationSite::DispatchClosure:
+            return "dispatch_closure";
+    }
+    return "unknown";
+}
+
+uint64_t AllocationCounters::getCount(AllocationSite site) const {
+    return counts[static_cast<size_t>(site)];
+}
+
+uint64_t AllocationCounters::getBytes(AllocationSite site) const {
+    return bytes[static_cast<size_t>(site)];
+}
+
+uint64_t AllocationCounters::getTotalCount() const {
+    uint64_t total = 0;
+    for (auto count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+uint64_t AllocationCounters::getTotalBytes() const {
+    uint64_t total = 0;
+    for (auto byteCount : bytes) {
+        total += byteCount;
+    }
+    return total;
+}
+
+AllocationCounters AllocationCounters::since(const AllocationCounters& snapshot) const {
+    AllocationCounters out;
+    for (size_t i = 0; i < kAllocationSitesCount; i++) {
+        out.counts[i] = counts[i] - snapshot.counts[i];
+        out.bytes[i] = bytes[i] - snapshot.bytes[i];
+    }
+    return out;
+}
+
+AllocationCounters AllocationCounters::current() {
+    return currentThreadState.counters;
+}
+
+AllocationProfiler::AllocationProfiler() : _lastCollectTime(std::chrono::steady_clock::now()) {}
+AllocationProfiler::~AllocationProfiler() = default;
+
+void AllocationProfiler::setEnabled(bool enabled) {
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void AllocationProfiler::setSamplingInterval(uint64_t samplingInterval) {
+    _samplingInterval.store(samplingInterval > 0 ? samplingInterval : 1, std::memory_order_relaxed);
+}
+
+uint64_t AllocationProfiler::getSamplingInterval() {
+    return _samplingInterval.load(std::memory_order_relaxed);
+}
+
+const std::string* AllocationProfiler::exchangeTraceScope(const std::string* traceScope) {
+    auto* previousTraceScope = currentThreadState.traceScope;
+    currentThreadState.traceScope = traceScope;
+    return previousTraceScope;
+}
+
+__attribute__((noinline)) void AllocationProfiler::doRecordAllocation(AllocationSite site, size_t bytes) {
+    auto& state = currentThreadState;
+    if (state.recording) {
+        return;
+    }
+
+    auto index = static_cast<size_t>(site);
+    state.counters.counts[index]++;
+    state.counters.bytes[index] += bytes;
+    PerfCounters::increment(PerfCounterType::Allocations);
+
+    // Clamped so that lowering the sampling interval applies right away
+    auto samplingInterval = getSamplingInterval();
+    auto allocationsUntilSample = std::min(state.allocationsUntilSample, samplingInterval);
+    if (allocationsUntilSample > 1) {
+        state.allocationsUntilSample = allocationsUntilSample - 1;
+        return;
+    }
+    state.allocationsUntilSample = samplingInterval;
+
+    state.recording = true;
+
+    std::array<uintptr_t, kMaxFrames> frames;
+    auto framesCount = captureBacktrace(frames.data(), frames.size());
+
+    AllocationSample sample;
+    sample.site = site;
+    sample.bytes = bytes;
+    if (state.traceScope != nullptr) {
+        sample.traceScope = *state.traceScope;
+    }
+    // Skip the frames of captureBacktrace and doRecordAllocation
+    constexpr size_t kSkippedFramesCount = 2;
+    if (framesCount > kSkippedFramesCount) {
+        sample.frames.assign(frames.begin() + kSkippedFramesCount, frames.begin() + framesCount);
+    }
+
+    shared().addSample(std::move(sample));
+
+    state.recording = false;
+}
+
+void AllocationProfiler::addSample(AllocationSample&& sample) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_samples.size() >= kMaxSamples) {
+        _droppedSamplesCount++;
+        return;
+    }
+    _samples.emplace_back(std::move(sample));
+}
+
+AllocationProfile AllocationProfiler::collect() {
+    auto currentTime = std::chrono::steady_clock::now();
+
+    AllocationProfile profile;
+    profile.samplingInterval = getSamplingInterval();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    profile.period = currentTime - _lastCollectTime;
+    profile.samples = std::move(_samples);
+    profile.droppedSamplesCount = _droppedSamplesCount;
+
+    _samples = {};
+    _droppedSamplesCount = 0;
+    _lastCollectTime = currentTime;
+
+    return profile;
+}
+
+AllocationProfiler& AllocationProfiler::shared() {
+    static auto* kInstance = new AllocationProfiler();
+    return *kInstance;
+}
+
+} // namespace Valdi
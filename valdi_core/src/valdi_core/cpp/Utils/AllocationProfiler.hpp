@@ -0,0 +1,189 @@
+//
+//  AllocationProfiler.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "utils/base/NonCopyable.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ * The places where allocations are counted.
+ */
+enum class AllocationSite : uint8_t {
+    // Global operator new, only counted when the allocation profiler hooks are linked in
+    OperatorNew = 0,
+    // An ObjectPool which had no pooled object to reuse
+    ObjectPool,
+    // An AutoMalloc which outgrew its inline storage
+    AutoMalloc,
+    // A ByteBuffer growing its storage
+    ByteBuffer,
+    // A SmallVector which outgrew its inline storage
+    SmallVector,
+    // A coroutine frame which had no pooled frame to reuse
+    CoroutineFrame,
+    // A DispatchFunction closure which had no pooled closure to reuse
+    DispatchClosure,
+};
+
+constexpr size_t kAllocationSitesCount = static_cast<size_t>(AllocationSite::DispatchClosure) + 1;
+
+const char* allocationSiteToString(AllocationSite site);
+
+/**
+ * How many allocations were made, and how many bytes they requested, per allocation site.
+ */
+struct AllocationCounters {
+    std::array<uint64_t, kAllocationSitesCount> counts{};
+    std::array<uint64_t, kAllocationSitesCount> bytes{};
+
+    uint64_t getCount(AllocationSite site) const;
+    uint64_t getBytes(AllocationSite site) const;
+
+    uint64_t getTotalCount() const;
+    uint64_t getTotalBytes() const;
+
+    /**
+     * Returns the allocations made since the given snapshot of the same counters was taken.
+     */
+    AllocationCounters since(const AllocationCounters& snapshot) const;
+
+    /**
+     * Returns the allocations counted on the current thread while the profiler was enabled.
+     */
+    static AllocationCounters current();
+};
+
+struct AllocationSample {
+    AllocationSite site;
+    size_t bytes;
+    // The innermost ScopedTrace of the thread when the allocation was made, empty if there was none
+    std::string traceScope;
+    // Return addresses of the native backtrace, innermost first
+    std::vector<uintptr_t> frames;
+};
+
+/**
+ * The allocations sampled over a profiling period. Each sample stands for samplingInterval allocations.
+ */
+struct AllocationProfile {
+    std::chrono::steady_clock::duration period = std::chrono::steady_clock::duration::zero();
+    uint64_t samplingInterval = 0;
+    std::vector<AllocationSample> samples;
+    // Samples which were not recorded because the profile was full
+    size_t droppedSamplesCount = 0;
+};
+
+/**
+ * An opt-in sampling allocation profiler. While enabled, the allocations made through the counted
+ * allocation sites are counted on the thread making them, and one out of samplingInterval allocations
+ * per thread is sampled along with its native backtrace and the ScopedTrace it was made in.
+ *
+ * While disabled, an allocation costs a relaxed load. The global operator new is only counted when
+ * the allocation_profiler_hooks library is linked in, which debug and profiling builds can opt into.
+ */
+class AllocationProfiler : public snap::NonCopyable {
+public:
+    AllocationProfiler();
+    ~AllocationProfiler();
+
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setSamplingInterval(uint64_t samplingInterval);
+    static uint64_t getSamplingInterval();
+
+    static inline void recordAllocation(AllocationSite site, size_t bytes) {
+        if (isEnabled()) {
+            doRecordAllocation(site, bytes);
+        }
+    }
+
+    /**
+     * Set the name of the innermost trace scope of the current thread, returns the previous one.
+     * The name must outlive the scope.
+     */
+    static const std::string* exchangeTraceScope(const std::string* traceScope);
+
+    /**
+     * Returns and resets the allocations sampled since the last collect.
+     */
+    AllocationProfile collect();
+
+    static AllocationProfiler& shared();
+
+    static constexpr uint64_t kDefaultSamplingInterval = 512;
+    static constexpr size_t kMaxSamples = 65536;
+    static constexpr size_t kMaxFrames = 64;
+
+private:
+    // std::mutex on purpose, as it does not allocate and a Valdi::Mutex could itself be profiled
+    std::mutex _mutex;
+    std::vector<AllocationSample> _samples;
+    size_t _droppedSamplesCount = 0;
+    std::chrono::steady_clock::time_point _lastCollectTime;
+
+    inline static std::atomic_bool _enabled = false;
+    inline static std::atomic<uint64_t> _samplingInterval = kDefaultSamplingInterval;
+
+    static void doRecordAllocation(AllocationSite site, size_t bytes);
+    void addSample(AllocationSample&& sample);
+};
+
+/**
+ * A std::allocator which counts its allocations on the AllocationProfiler.
+ */
+template<typename T, AllocationSite Site>
+class ProfiledAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = ProfiledAllocator<U, Site>;
+    };
+
+    ProfiledAllocator() noexcept = default;
+
+    template<typename U>
+    ProfiledAllocator(const ProfiledAllocator<U, Site>& /*other*/) noexcept {} // NOLINT(google-explicit-constructor)
+
+    T* allocate(size_t n) {
+        AllocationProfiler::recordAllocation(Site, n * sizeof(T));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template<typename U>
+    bool operator==(const ProfiledAllocator<U, Site>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const ProfiledAllocator<U, Site>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+} // namespace Valdi
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "utils/base/NonCopyable.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
 #include <memory>
 #include <type_traits>
 
@@ -74,6 +75,7 @@ private:
             _allocated = false;
             _capacity = inlineCapacity;
         } else {
+            AllocationProfiler::recordAllocation(AllocationSite::AutoMalloc, size * sizeof(T));
             std::allocator<T> allocator;
             _data = allocator.allocate(size);
             _allocated = true;
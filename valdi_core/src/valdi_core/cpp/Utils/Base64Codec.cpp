@@ -0,0 +1,308 @@
+//
+//  Base64Codec.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace Valdi {
+
+constexpr std::string_view kAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr std::string_view kUrlSafeAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// All the non sextet entries have the two high bits set, so that a block can be validated with a single test
+constexpr uint8_t kInvalid = 0xFF;
+constexpr uint8_t kSkipped = 0xFE;
+constexpr uint8_t kPadding = 0xFD;
+constexpr uint8_t kNonSextetMask = 0xC0;
+
+static constexpr std::array<uint8_t, 256> makeDecodeTable() {
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table) {
+        entry = kInvalid;
+    }
+    for (size_t i = 0; i < kAlphabet.size(); i++) {
+        table[static_cast<uint8_t>(kAlphabet[i])] = static_cast<uint8_t>(i);
+        table[static_cast<uint8_t>(kUrlSafeAlphabet[i])] = static_cast<uint8_t>(i);
+    }
+    table[static_cast<uint8_t>('\n')] = kSkipped;
+    table[static_cast<uint8_t>('\r')] = kSkipped;
+    table[static_cast<uint8_t>('=')] = kPadding;
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> kDecodeTable = makeDecodeTable();
+
+#if defined(__SSSE3__)
+
+// Vectorized codecs from Wojciech Muła and Daniel Lemire, "Faster Base64 Encoding and Decoding
+// using AVX2 Instructions", using 128 bits registers.
+
+static size_t encodeSSSE3(const Byte* data, size_t size, char* output, bool urlSafe) {
+    const auto shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    // Offsets to add to the sextets to get their characters, indexed by the range of the sextet
+    const auto offsets = _mm_setr_epi8('a' - 26,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       '0' - 52,
+                                       urlSafe ? '-' - 62 : '+' - 62,
+                                       urlSafe ? '_' - 63 : '/' - 63,
+                                       'A',
+                                       0,
+                                       0);
+
+    size_t consumed = 0;
+    // Each iteration loads 16 bytes and encodes the first 12 of them
+    while (consumed + 16 <= size) {
+        auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + consumed));
+        input = _mm_shuffle_epi8(input, shuffle);
+
+        // Split each group of 3 bytes into 4 sextets, one per byte
+        auto t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+        auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        auto t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+        auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        auto sextets = _mm_or_si128(t1, t3);
+
+        auto ranges = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+        auto isUppercase = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+        ranges = _mm_or_si128(ranges, _mm_and_si128(isUppercase, _mm_set1_epi8(13)));
+        auto characters = _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), sextets);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), characters);
+        output += 16;
+        consumed += 12;
+    }
+
+    return consumed;
+}
+
+static inline __m128i inRange(__m128i input, char low, char high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8(static_cast<char>(low - 1))),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(high + 1)), input));
+}
+
+static inline __m128i offsetIf(__m128i mask, int offset) {
+    return _mm_and_si128(mask, _mm_set1_epi8(static_cast<char>(offset)));
+}
+
+static size_t decodeSSSE3(const char* input, size_t length, Byte*& output) {
+    const auto shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t consumed = 0;
+    while (consumed + 16 <= length) {
+        auto characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+
+        // Bytes above 127 are negative and fall outside of all the ranges
+        auto isUppercase = inRange(characters, 'A', 'Z');
+        auto isLowercase = inRange(characters, 'a', 'z');
+        auto isDigit = inRange(characters, '0', '9');
+        auto isPlus = _mm_cmpeq_epi8(characters, _mm_set1_epi8('+'));
+        auto isSlash = _mm_cmpeq_epi8(characters, _mm_set1_epi8('/'));
+        auto isMinus = _mm_cmpeq_epi8(characters, _mm_set1_epi8('-'));
+        auto isUnderscore = _mm_cmpeq_epi8(characters, _mm_set1_epi8('_'));
+
+        auto isValid = _mm_or_si128(_mm_or_si128(_mm_or_si128(isUppercase, isLowercase), _mm_or_si128(isDigit, isPlus)),
+                                    _mm_or_si128(isSlash, _mm_or_si128(isMinus, isUnderscore)));
+        if (_mm_movemask_epi8(isValid) != 0xFFFF) {
+            // Padding, line breaks and invalid characters are handled by the scalar decoder
+            break;
+        }
+
+        auto offsets = _mm_or_si128(_mm_or_si128(offsetIf(isUppercase, -'A'), offsetIf(isLowercase, 26 - 'a')),
+                                    _mm_or_si128(offsetIf(isDigit, 52 - '0'), offsetIf(isPlus, 62 - '+')));
+        auto urlSafeOffsets = _mm_or_si128(offsetIf(isMinus, 62 - '-'), offsetIf(isUnderscore, 63 - '_'));
+        offsets = _mm_or_si128(offsets, _mm_or_si128(offsetIf(isSlash, 63 - '/'), urlSafeOffsets));
+        auto sextets = _mm_add_epi8(characters, offsets);
+
+        // Merge each group of 4 sextets into 3 bytes
+        auto merged = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        merged = _mm_shuffle_epi8(merged, shuffle);
+
+        alignas(16) Byte bytes[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(bytes), merged);
+        std::memcpy(output, bytes, 12);
+
+        output += 12;
+        consumed += 16;
+    }
+
+    return consumed;
+}
+
+#endif
+
+size_t Base64Codec::getEncodedLength(size_t size, bool urlSafe) {
+    if (urlSafe) {
+        return (size / 3) * 4 + ((size % 3) * 4 + 2) / 3;
+    }
+    return ((size + 2) / 3) * 4;
+}
+
+void Base64Codec::encode(const Byte* data, size_t size, char* output, bool urlSafe) {
+    const auto* alphabet = urlSafe ? kUrlSafeAlphabet.data() : kAlphabet.data();
+    size_t i = 0;
+
+#if defined(__SSSE3__)
+    i = encodeSSSE3(data, size, output, urlSafe);
+    output += (i / 3) * 4;
+#endif
+
+    for (; i + 3 <= size; i += 3) {
+        auto value = (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) |
+                     static_cast<uint32_t>(data[i + 2]);
+        output[0] = alphabet[(value >> 18) & 0x3F];
+        output[1] = alphabet[(value >> 12) & 0x3F];
+        output[2] = alphabet[(value >> 6) & 0x3F];
+        output[3] = alphabet[value & 0x3F];
+        output += 4;
+    }
+
+    auto remaining = size - i;
+    if (remaining == 0) {
+        return;
+    }
+
+    auto value = static_cast<uint32_t>(data[i]) << 16;
+    if (remaining == 2) {
+        value |= static_cast<uint32_t>(data[i + 1]) << 8;
+    }
+
+    output[0] = alphabet[(value >> 18) & 0x3F];
+    output[1] = alphabet[(value >> 12) & 0x3F];
+    if (remaining == 2) {
+        output[2] = alphabet[(value >> 6) & 0x3F];
+    }
+
+    if (!urlSafe) {
+        if (remaining == 1) {
+            output[2] = '=';
+        }
+        output[3] = '=';
+    }
+}
+
+std::string Base64Codec::encode(const Byte* data, size_t size, bool urlSafe) {
+    std::string output;
+    output.resize(getEncodedLength(size, urlSafe));
+    encode(data, size, output.data(), urlSafe);
+    return output;
+}
+
+size_t Base64Codec::getMaxDecodedLength(size_t length) {
+    return (length / 4) * 3 + ((length % 4) * 3) / 4;
+}
+
+std::optional<size_t> Base64Codec::decode(std::string_view input, Byte* output) {
+    const auto* characters = input.data();
+    auto length = input.size();
+    auto* outputStart = output;
+
+    size_t i = 0;
+    uint32_t pendingValue = 0;
+    size_t pendingSextets = 0;
+    bool reachedPadding = false;
+
+    while (i < length) {
+        if (pendingSextets == 0 && !reachedPadding) {
+#if defined(__SSSE3__)
+            i += decodeSSSE3(characters + i, length - i, output);
+#endif
+
+            for (; i + 4 <= length; i += 4) {
+                auto s0 = kDecodeTable[static_cast<uint8_t>(characters[i])];
+                auto s1 = kDecodeTable[static_cast<uint8_t>(characters[i + 1])];
+                auto s2 = kDecodeTable[static_cast<uint8_t>(characters[i + 2])];
+                auto s3 = kDecodeTable[static_cast<uint8_t>(characters[i + 3])];
+                if (((s0 | s1 | s2 | s3) & kNonSextetMask) != 0) {
+                    break;
+                }
+
+                auto value = (static_cast<uint32_t>(s0) << 18) | (static_cast<uint32_t>(s1) << 12) |
+                             (static_cast<uint32_t>(s2) << 6) | static_cast<uint32_t>(s3);
+                output[0] = static_cast<Byte>(value >> 16);
+                output[1] = static_cast<Byte>(value >> 8);
+                output[2] = static_cast<Byte>(value);
+                output += 3;
+            }
+
+            if (i >= length) {
+                break;
+            }
+        }
+
+        // Slow path, one character at a time
+        auto sextet = kDecodeTable[static_cast<uint8_t>(characters[i])];
+        i++;
+
+        if (sextet == kSkipped) {
+            continue;
+        }
+        if (sextet == kPadding) {
+            reachedPadding = true;
+            continue;
+        }
+        if (sextet == kInvalid || reachedPadding) {
+            return std::nullopt;
+        }
+
+        pendingValue = (pendingValue << 6) | sextet;
+        pendingSextets++;
+        if (pendingSextets == 4) {
+            output[0] = static_cast<Byte>(pendingValue >> 16);
+            output[1] = static_cast<Byte>(pendingValue >> 8);
+            output[2] = static_cast<Byte>(pendingValue);
+            output += 3;
+            pendingValue = 0;
+            pendingSextets = 0;
+        }
+    }
+
+    switch (pendingSextets) {
+        case 1:
+            return std::nullopt;
+        case 2:
+            output[0] = static_cast<Byte>(pendingValue >> 4);
+            output += 1;
+            break;
+        case 3:
+            output[0] = static_cast<Byte>(pendingValue >> 10);
+            output[1] = static_cast<Byte>(pendingValue >> 2);
+            output += 2;
+            break;
+        default:
+            break;
+    }
+
+    return static_cast<size_t>(output - outputStart);
+}
+
+bool Base64Codec::decode(std::string_view input, Bytes& output) {
+    output.resize(getMaxDecodedLength(input.size()));
+    auto decodedSize = decode(input, output.data());
+    if (!decodedSize) {
+        output.clear();
+        return false;
+    }
+
+    output.resize(decodedSize.value());
+    return true;
+}
+
+} // namespace Valdi
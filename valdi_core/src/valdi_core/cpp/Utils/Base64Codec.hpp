@@ -0,0 +1,57 @@
+//
+//  Base64Codec.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Valdi {
+
+/**
+ Base64 encoder and decoder which processes 16 bytes at a time with SSSE3 when available,
+ and 3 to 4 bytes at a time with lookup tables otherwise.
+
+ The decoder accepts both the standard and the URL safe alphabets, with or without padding,
+ and skips the line breaks.
+ */
+class Base64Codec {
+public:
+    /**
+     Returns how many characters encoding the given number of bytes produces.
+     */
+    static size_t getEncodedLength(size_t size, bool urlSafe);
+
+    /**
+     Encode the given bytes into the output, which must be at least getEncodedLength() large.
+     URL safe encoding uses the URL safe alphabet and omits the padding.
+     */
+    static void encode(const Byte* data, size_t size, char* output, bool urlSafe);
+
+    static std::string encode(const Byte* data, size_t size, bool urlSafe = false);
+
+    /**
+     Returns the maximum number of bytes decoding the given number of characters can produce.
+     */
+    static size_t getMaxDecodedLength(size_t length);
+
+    /**
+     Decode the given string into the output, which must be at least getMaxDecodedLength() large.
+     Returns how many bytes were written, or an empty optional if the input is not valid base64.
+     */
+    static std::optional<size_t> decode(std::string_view input, Byte* output);
+
+    /**
+     Decode the given string into the output, which is resized to the decoded size.
+     Returns false if the input is not valid base64.
+     */
+    static bool decode(std::string_view input, Bytes& output);
+};
+
+} // namespace Valdi
@@ -0,0 +1,83 @@
+//
+//  BridgeCrossings.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/BridgeCrossings.hpp"
+#include "valdi_core/cpp/Utils/PerfCounters.hpp"
+
+namespace Valdi {
+
+static thread_local BridgeCrossings currentThreadCrossings;
+
+const char* bridgeCrossingTypeToString(BridgeCrossingType type) {
+    switch (type) {
+        case BridgeCrossingType::JSToNative:
+            return "js_to_native";
+        case BridgeCrossingType::NativeToJS:
+            return "native_to_js";
+        case BridgeCrossingType::NativeToPlatform:
+            return "native_to_platform";
+    }
+    return "unknown";
+}
+
+uint64_t BridgeCrossings::getCount(BridgeCrossingType type) const {
+    return counts[static_cast<size_t>(type)];
+}
+
+std::chrono::steady_clock::duration BridgeCrossings::getDuration(BridgeCrossingType type) const {
+    return durations[static_cast<size_t>(type)];
+}
+
+uint64_t BridgeCrossings::getTotalCount() const {
+    uint64_t total = 0;
+    for (auto count : counts) {
+        total += count;
+    }
+    return total;
+}
+
+bool BridgeCrossings::empty() const {
+    return getTotalCount() == 0;
+}
+
+void BridgeCrossings::add(const BridgeCrossings& other) {
+    for (size_t i = 0; i < kBridgeCrossingTypesCount; i++) {
+        counts[i] += other.counts[i];
+        durations[i] += other.durations[i];
+    }
+}
+
+BridgeCrossings BridgeCrossings::since(const BridgeCrossings& snapshot) const {
+    BridgeCrossings out;
+    for (size_t i = 0; i < kBridgeCrossingTypesCount; i++) {
+        out.counts[i] = counts[i] - snapshot.counts[i];
+        out.durations[i] = durations[i] - snapshot.durations[i];
+    }
+    return out;
+}
+
+const BridgeCrossings& BridgeCrossings::current() {
+    return currentThreadCrossings;
+}
+
+ScopedBridgeCrossing::ScopedBridgeCrossing(BridgeCrossingType type)
+    : _type(type), _sampled(currentThreadCrossings.counts[static_cast<size_t>(type)]++ % kSamplingInterval == 0) {
+    PerfCounters::increment(PerfCounterType::BridgeCrossings);
+    if (_sampled) {
+        _startTime = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedBridgeCrossing::~ScopedBridgeCrossing() {
+    if (_sampled) {
+        auto elapsed = std::chrono::steady_clock::now() - _startTime;
+        currentThreadCrossings.durations[static_cast<size_t>(_type)] +=
+            elapsed * static_cast<int64_t>(kSamplingInterval);
+    }
+}
+
+} // namespace Valdi
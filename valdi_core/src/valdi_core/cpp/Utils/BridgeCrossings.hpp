@@ -0,0 +1,80 @@
+//
+//  BridgeCrossings.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "utils/base/NonCopyable.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Valdi {
+
+/**
+ * The boundaries between the JS engine, the C++ runtime and the platform which are counted.
+ */
+enum class BridgeCrossingType : uint8_t {
+    // A JS function calling into a native function
+    JSToNative = 0,
+    // The runtime calling a JS function
+    NativeToJS,
+    // The runtime calling an ObjC or Java function through a platform function trampoline
+    NativeToPlatform,
+};
+
+constexpr size_t kBridgeCrossingTypesCount = static_cast<size_t>(BridgeCrossingType::NativeToPlatform) + 1;
+
+const char* bridgeCrossingTypeToString(BridgeCrossingType type);
+
+/**
+ * How many times the bridges were crossed, along with the estimated time spent in those crossings.
+ * The time of a crossing includes the time of the crossings it made itself.
+ */
+struct BridgeCrossings {
+    std::array<uint64_t, kBridgeCrossingTypesCount> counts{};
+    std::array<std::chrono::steady_clock::duration, kBridgeCrossingTypesCount> durations{};
+
+    uint64_t getCount(BridgeCrossingType type) const;
+    std::chrono::steady_clock::duration getDuration(BridgeCrossingType type) const;
+
+    uint64_t getTotalCount() const;
+    bool empty() const;
+
+    void add(const BridgeCrossings& other);
+
+    /**
+     * Returns the crossings made since the given snapshot of the same counters was taken.
+     */
+    BridgeCrossings since(const BridgeCrossings& snapshot) const;
+
+    /**
+     * Returns the crossings made on the current thread since it started.
+     */
+    static const BridgeCrossings& current();
+};
+
+/**
+ * Counts a bridge crossing on the current thread. Counting is a thread local increment,
+ * only one out of kSamplingInterval crossings is timed, its duration being extrapolated
+ * to the crossings which were not.
+ */
+class ScopedBridgeCrossing : public snap::NonCopyable {
+public:
+    explicit ScopedBridgeCrossing(BridgeCrossingType type);
+    ~ScopedBridgeCrossing();
+
+    static constexpr uint64_t kSamplingInterval = 16;
+
+private:
+    BridgeCrossingType _type;
+    bool _sampled;
+    std::chrono::steady_clock::time_point _startTime;
+};
+
+} // namespace Valdi
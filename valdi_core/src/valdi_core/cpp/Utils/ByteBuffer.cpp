@@ -6,6 +6,7 @@
 //
 
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
 
 namespace Valdi {
 
@@ -20,6 +21,7 @@ static inline Byte* allocateBuffer(size_t size) {
         return nullptr;
     }
 
+    AllocationProfiler::recordAllocation(AllocationSite::ByteBuffer, size);
     return reinterpret_cast<Byte*>(malloc(sizeof(Byte) * size)); // NOLINT(cppcoreguidelines-no-malloc)
 }
 
@@ -0,0 +1,158 @@
+//
+//  ByteRope.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/ByteRope.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Valdi {
+
+ByteRope::ByteRope() = default;
+ByteRope::~ByteRope() = default;
+
+size_t ByteRope::size() const {
+    return _size;
+}
+
+bool ByteRope::empty() const {
+    return _size == 0;
+}
+
+void ByteRope::sealTail() {
+    if (_tail != nullptr && _tail->size() > _tailStart) {
+        _chunks.emplace_back(_tail, _tail->data() + _tailStart, _tail->size() - _tailStart);
+        _tailStart = _tail->size();
+    }
+}
+
+void ByteRope::ensureTailCapacity(size_t size) {
+    if (_tail != nullptr && _tail->capacity() - _tail->size() >= size) {
+        return;
+    }
+
+    sealTail();
+
+    // Chunks grow with the rope so that large payloads are made of a few large chunks
+    auto capacity = std::max(size, std::clamp(_size, kMinChunkSize, kMaxChunkSize));
+    _tail = makeShared<ByteBuffer>();
+    _tail->reserve(capacity);
+    _tailStart = 0;
+}
+
+Byte* ByteRope::appendWritable(size_t size) {
+    ensureTailCapacity(size);
+    _size += size;
+    return _tail->appendWritable(size);
+}
+
+void ByteRope::append(const Byte* begin, const Byte* end) {
+    auto size = static_cast<size_t>(end - begin);
+    if (size == 0) {
+        return;
+    }
+    std::memcpy(appendWritable(size), begin, size);
+}
+
+void ByteRope::append(std::string_view str) {
+    append(reinterpret_cast<const Byte*>(str.data()), reinterpret_cast<const Byte*>(str.data() + str.size()));
+}
+
+void ByteRope::append(const BytesView& bytes) {
+    if (bytes.size() < kMinReferencedSize || bytes.getSource() == nullptr) {
+        append(bytes.begin(), bytes.end());
+        return;
+    }
+
+    sealTail();
+    _chunks.emplace_back(bytes);
+    _size += bytes.size();
+}
+
+void ByteRope::append(const ByteRope& other) {
+    auto otherChunks = other.getChunks();
+    sealTail();
+    for (auto& chunk : otherChunks) {
+        _size += chunk.size();
+        _chunks.emplace_back(std::move(chunk));
+    }
+}
+
+void ByteRope::clear() {
+    _chunks.clear();
+    _tail = nullptr;
+    _tailStart = 0;
+    _size = 0;
+}
+
+std::vector<BytesView> ByteRope::getChunks() const {
+    std::vector<BytesView> chunks;
+    chunks.reserve(_chunks.size() + 1);
+    forEachChunk([&](const BytesView& chunk) { chunks.emplace_back(chunk); });
+    return chunks;
+}
+
+void ByteRope::toIOVecs(std::vector<iovec>& output) const {
+    output.reserve(output.size() + _chunks.size() + 1);
+    forEachChunk([&](const BytesView& chunk) {
+        auto& vec = output.emplace_back();
+        vec.iov_base = const_cast<Byte*>(chunk.data());
+        vec.iov_len = chunk.size();
+    });
+}
+
+void ByteRope::copyTo(Byte* output) const {
+    forEachChunk([&](const BytesView& chunk) {
+        std::memcpy(output, chunk.data(), chunk.size());
+        output += chunk.size();
+    });
+}
+
+BytesView ByteRope::slice(size_t start, size_t length) const {
+    length = std::min(length, _size - std::min(start, _size));
+    if (length == 0) {
+        return BytesView();
+    }
+
+    auto end = start + length;
+    size_t chunkStart = 0;
+    Ref<ByteBuffer> output;
+    Byte* outputPtr = nullptr;
+    BytesView out;
+
+    forEachChunk([&](const BytesView& chunk) {
+        auto chunkEnd = chunkStart + chunk.size();
+        if (chunkEnd > start && chunkStart < end) {
+            auto from = std::max(start, chunkStart) - chunkStart;
+            auto to = std::min(end, chunkEnd) - chunkStart;
+
+            if (start >= chunkStart && end <= chunkEnd) {
+                // The whole range is within this chunk
+                out = chunk.subrange(from, length);
+            } else {
+                if (output == nullptr) {
+                    output = makeShared<ByteBuffer>();
+                    outputPtr = output->appendWritable(length);
+                }
+                std::memcpy(outputPtr, chunk.data() + from, to - from);
+                outputPtr += to - from;
+            }
+        }
+        chunkStart = chunkEnd;
+    });
+
+    if (output != nullptr) {
+        return output->toBytesView();
+    }
+
+    return out;
+}
+
+BytesView ByteRope::toBytesView() const {
+    return slice(0, _size);
+}
+
+} // namespace Valdi
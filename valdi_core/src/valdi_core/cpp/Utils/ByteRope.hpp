@@ -0,0 +1,116 @@
+//
+//  ByteRope.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "utils/base/NonCopyable.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include <string_view>
+#include <sys/uio.h>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ A byte buffer made of a list of chunks, designed to build large payloads without the
+ reallocations and copies of a contiguous ByteBuffer as it grows. Small appends are copied
+ into the current chunk, which is never reallocated. Large BytesView and other ByteRope's
+ are appended by reference, without copying their content.
+
+ The chunks can be exported as iovec's, to be written with writev() or sent on a socket
+ without flattening, or as BytesView's.
+ */
+class ByteRope : public SimpleRefCountable, public snap::NonCopyable {
+public:
+    ByteRope();
+    ~ByteRope() override;
+
+    size_t size() const;
+    bool empty() const;
+
+    /**
+     Append N bytes to the rope, and return a writable pointer to the beginning
+     of the added region, which is always contiguous.
+     */
+    Byte* appendWritable(size_t size);
+
+    /**
+     Append and copy the given region to the rope
+     */
+    void append(const Byte* begin, const Byte* end);
+
+    /**
+     Append and copy the given string to the rope
+     */
+    void append(std::string_view str);
+
+    /**
+     Append the given BytesView to the rope. The BytesView is retained instead
+     of being copied if it is at least kMinReferencedSize bytes large.
+     */
+    void append(const BytesView& bytes);
+
+    /**
+     Append the content of the given rope by reference, without copying it.
+     Subsequent appends to the given rope are not reflected in this rope.
+     */
+    void append(const ByteRope& other);
+
+    void clear();
+
+    std::vector<BytesView> getChunks() const;
+
+    /**
+     Append the chunks of the rope as iovec's in the given vector.
+     The iovec's remain valid as long as the rope is not cleared.
+     */
+    void toIOVecs(std::vector<iovec>& output) const;
+
+    /**
+     Copy the whole content of the rope into the given output, which must be
+     at least size() bytes large.
+     */
+    void copyTo(Byte* output) const;
+
+    /**
+     Return a BytesView of the given range. The range is returned without copy when it
+     is contained within a single chunk, and is copied into a new buffer otherwise.
+     */
+    BytesView slice(size_t start, size_t length) const;
+
+    /**
+     Return a contiguous BytesView of the whole rope.
+     */
+    BytesView toBytesView() const;
+
+    static constexpr size_t kMinChunkSize = 4096;
+    static constexpr size_t kMaxChunkSize = 1024 * 1024;
+    static constexpr size_t kMinReferencedSize = 512;
+
+private:
+    std::vector<BytesView> _chunks;
+    Ref<ByteBuffer> _tail;
+    // Start of the region of the tail which is not part of _chunks yet
+    size_t _tailStart = 0;
+    size_t _size = 0;
+
+    void sealTail();
+    void ensureTailCapacity(size_t size);
+
+    template<typename F>
+    void forEachChunk(F&& fn) const {
+        for (const auto& chunk : _chunks) {
+            fn(chunk);
+        }
+        if (_tail != nullptr && _tail->size() > _tailStart) {
+            fn(BytesView(_tail, _tail->data() + _tailStart, _tail->size() - _tailStart));
+        }
+    }
+};
+
+} // namespace Valdi
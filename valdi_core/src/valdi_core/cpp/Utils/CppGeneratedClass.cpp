@@ -6,6 +6,7 @@
 //
 
 #include "valdi_core/cpp/Utils/CppGeneratedClass.hpp"
+#include "valdi_core/cpp/Schema/ValueSchemaBinary.hpp"
 #include "valdi_core/cpp/Schema/ValueSchemaRegistry.hpp"
 #include "valdi_core/cpp/Schema/ValueSchemaTypeResolver.hpp"
 #include "valdi_core/cpp/Utils/PlatformObjectAttachments.hpp"
@@ -19,8 +20,25 @@ RegisteredCppGeneratedClass::RegisteredCppGeneratedClass(ValueSchemaRegistry* re
       _schemaString(schemaString),
       _getTypeReferencesCallback(std::move(getTypeReferencesCallback)) {}
 
+RegisteredCppGeneratedClass::RegisteredCppGeneratedClass(ValueSchemaRegistry* registry,
+                                                         ValueSchemaBinaryTable* schemaTable,
+                                                         size_t schemaIndex,
+                                                         GetTypeReferencesCallback getTypeReferencesCallback)
+    : _registry(registry),
+      _schemaTable(schemaTable),
+      _schemaIndex(schemaIndex),
+      _getTypeReferencesCallback(std::move(getTypeReferencesCallback)) {}
+
 RegisteredCppGeneratedClass::~RegisteredCppGeneratedClass() = default;
 
+Result<ValueSchema> RegisteredCppGeneratedClass::loadSchema() const {
+    if (_schemaTable != nullptr) {
+        return _schemaTable->getSchema(_schemaIndex);
+    }
+
+    return ValueSchema::parse(_schemaString);
+}
+
 void RegisteredCppGeneratedClass::ensureSchemaRegistered(ExceptionTracker& exceptionTracker) {
     if (!_schemaRegistered) {
         auto lock = _registry->lock();
@@ -28,14 +46,20 @@ void RegisteredCppGeneratedClass::ensureSchemaRegistered(ExceptionTracker& excep
             return;
         }
 
-        auto parseResult = ValueSchema::parse(_schemaString);
-        if (!parseResult) {
-            exceptionTracker.onError(parseResult.moveError());
+        auto schemaResult = loadSchema();
+        if (!schemaResult) {
+            exceptionTracker.onError(schemaResult.moveError());
+            return;
+        }
+
+        const auto* classSchema = schemaResult.value().getClass();
+        if (classSchema == nullptr) {
+            exceptionTracker.onError(Error("Registered schema is not a class"));
             return;
         }
 
-        _schemaIdentifier = _registry->registerSchema(parseResult.value());
-        _className = parseResult.value().getClass()->getClassName();
+        _schemaIdentifier = _registry->registerSchema(schemaResult.value());
+        _className = classSchema->getClassName();
         _schemaRegistered = true;
     }
 }
@@ -116,6 +140,14 @@ RegisteredCppGeneratedClass CppGeneratedClass::registerSchema(std::string_view s
     return registerSchema(schemaString, []() -> RegisteredCppGeneratedClass::TypeReferencesVec { return {}; });
 }
 
+RegisteredCppGeneratedClass CppGeneratedClass::registerSchema(
+    ValueSchemaBinaryTable& schemaTable,
+    size_t schemaIndex,
+    RegisteredCppGeneratedClass::GetTypeReferencesCallback getTypeReferencesCallback) {
+    return RegisteredCppGeneratedClass(
+        ValueSchemaRegistry::sharedInstance().get(), &schemaTable, schemaIndex, std::move(getTypeReferencesCallback));
+}
+
 CppGeneratedInterface::CppGeneratedInterface() = default;
 CppGeneratedInterface::~CppGeneratedInterface() = default;
 
@@ -18,6 +18,8 @@
 namespace Valdi {
 
 class ClassSchema;
+class ValueSchema;
+class ValueSchemaBinaryTable;
 class ValueSchemaRegistry;
 class PlatformObjectAttachments;
 
@@ -29,6 +31,14 @@ public:
     RegisteredCppGeneratedClass(ValueSchemaRegistry* registry,
                                 std::string_view schemaString,
                                 GetTypeReferencesCallback getTypeReferencesCallback);
+    /**
+     Register a class whose schema is stored at the given index of a precompiled
+     schema table, which avoids parsing the schema string when the class is first used.
+     */
+    RegisteredCppGeneratedClass(ValueSchemaRegistry* registry,
+                                ValueSchemaBinaryTable* schemaTable,
+                                size_t schemaIndex,
+                                GetTypeReferencesCallback getTypeReferencesCallback);
     ~RegisteredCppGeneratedClass();
 
     void ensureSchemaRegistered(ExceptionTracker& exceptionTracker);
@@ -39,12 +49,16 @@ public:
 private:
     ValueSchemaRegistry* _registry;
     std::string_view _schemaString;
+    ValueSchemaBinaryTable* _schemaTable = nullptr;
+    size_t _schemaIndex = 0;
     std::atomic_bool _schemaRegistered = false;
     std::atomic_bool _schemaResolved = false;
     ValueSchemaRegistrySchemaIdentifier _schemaIdentifier = 0;
     StringBox _className;
     Ref<ClassSchema> _resolvedClassSchema;
     GetTypeReferencesCallback _getTypeReferencesCallback;
+
+    Result<ValueSchema> loadSchema() const;
 };
 
 class CppGeneratedClass : public ValdiObject {
@@ -57,6 +71,10 @@ protected:
         std::string_view schemaString,
         RegisteredCppGeneratedClass::GetTypeReferencesCallback getTypeReferencesCallback);
     static RegisteredCppGeneratedClass registerSchema(std::string_view schemaString);
+    static RegisteredCppGeneratedClass registerSchema(
+        ValueSchemaBinaryTable& schemaTable,
+        size_t schemaIndex,
+        RegisteredCppGeneratedClass::GetTypeReferencesCallback getTypeReferencesCallback);
 };
 
 class CppGeneratedModel : public CppGeneratedClass {
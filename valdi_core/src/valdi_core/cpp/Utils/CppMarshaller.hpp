@@ -144,12 +144,10 @@ public:
         if (value.isNullOrUndefined()) {
             out = std::nullopt;
         } else {
-            T outValue;
-            unmarshall(exceptionTracker, value, outValue);
+            // Unmarshalled in place, instead of moving a temporary into the optional
+            unmarshall(exceptionTracker, value, out.emplace());
             if (!exceptionTracker) {
                 out = std::nullopt;
-            } else {
-                out = std::make_optional<T>(std::move(outValue));
             }
         }
     }
@@ -367,6 +365,21 @@ public:
             exceptionTracker, CppObjectStore::sharedInstance(), registeredClass, value, out);
     }
 
+    /**
+     Marshall a generated model whose fields are described by its Fields type, which is a
+     CppModelFields instantiation, using its registeredClass.
+     */
+    template<typename T>
+    static void marshallModel(ExceptionTracker& exceptionTracker, const Ref<T>& value, Value& out) {
+        T::Fields::marshall(exceptionTracker, T::registeredClass, *value, out);
+    }
+
+    template<typename T>
+    static void unmarshallModel(ExceptionTracker& exceptionTracker, const Value& value, Ref<T>& out) {
+        out = makeShared<T>();
+        T::Fields::unmarshall(exceptionTracker, T::registeredClass, value, *out);
+    }
+
     template<typename T, typename R, typename... A>
     static Function<Result<R>(A...)> methodToFunction(const Ref<T>& object, Result<R> (T::*method)(A...)) {
         return [weakSelf = weakRef(object.get()), method](A... arguments) -> Result<R> {
@@ -380,6 +393,46 @@ public:
     }
 };
 
+/**
+ The fields of a generated model, as pointers to its data members in the order of the properties
+ of its schema. Since the members are template arguments, the field accesses and the marshaller
+ of each field are resolved at compile time, and the model does not need to list its fields in
+ both its marshall and unmarshall functions:
+
+    struct MyPoint : public CppGeneratedModel {
+        double x = 0;
+        double y = 0;
+
+        using Fields = CppModelFields<&MyPoint::x, &MyPoint::y>;
+        static RegisteredCppGeneratedClass registeredClass;
+
+        static void marshall(ExceptionTracker& exceptionTracker, const Ref<MyPoint>& value, Value& out) {
+            CppMarshaller::marshallModel(exceptionTracker, value, out);
+        }
+        ...
+    };
+ */
+template<auto... Members>
+struct CppModelFields {
+    static constexpr size_t kFieldsCount = sizeof...(Members);
+
+    template<typename T>
+    static void marshall(ExceptionTracker& exceptionTracker,
+                         RegisteredCppGeneratedClass& registeredClass,
+                         const T& value,
+                         Value& out) {
+        CppMarshaller::marshallTypedObject(exceptionTracker, registeredClass, out, (value.*Members)...);
+    }
+
+    template<typename T>
+    static void unmarshall(ExceptionTracker& exceptionTracker,
+                           RegisteredCppGeneratedClass& registeredClass,
+                           const Value& value,
+                           T& out) {
+        CppMarshaller::unmarshallTypedObject(exceptionTracker, registeredClass, value, (out.*Members)...);
+    }
+};
+
 template<typename R, typename... A>
 class CppValueFunction : public ValueFunction {
 public:
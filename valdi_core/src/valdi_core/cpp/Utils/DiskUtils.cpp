@@ -7,13 +7,21 @@
 
 #include "valdi_core/cpp/Utils/DiskUtils.hpp"
 #include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/ByteRope.hpp"
 
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
 #include <cstdio>
 #include <dirent.h>
+#include <fcntl.h>
 #include <fstream>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace Valdi {
@@ -168,14 +176,140 @@ Result<BytesView> DiskUtils::loadFromFd(int fd) {
     return bytes->toBytesView();
 }
 
+class MappedFile : public SimpleRefCountable {
+public:
+    MappedFile(void* data, size_t size) : _data(data), _size(size) {}
+
+    ~MappedFile() override {
+        munmap(_data, _size);
+    }
+
+    const Byte* data() const {
+        return reinterpret_cast<const Byte*>(_data);
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+private:
+    void* _data;
+    size_t _size;
+};
+
+// Under this size, reading the file is cheaper than setting up a mapping, which also rounds up to the page size
+constexpr size_t kMinMappedFileSize = 64 * 1024;
+
+static int toMadviseAdvice(FileAccessPattern accessPattern) {
+    switch (accessPattern) {
+        case FileAccessPattern::Normal:
+            return MADV_NORMAL;
+        case FileAccessPattern::Sequential:
+            return MADV_SEQUENTIAL;
+        case FileAccessPattern::Random:
+            return MADV_RANDOM;
+    }
+
+    return MADV_NORMAL;
+}
+
+Result<BytesView> DiskUtils::loadMapped(const Path& path) {
+    return loadMapped(path, FileAccessPattern::Normal);
+}
+
+Result<BytesView> DiskUtils::loadMappedIfLarge(const Path& path, FileAccessPattern accessPattern) {
+    auto stat = DiskUtils::stat(path);
+    if (stat.isFile() && stat.size() >= kMinMappedFileSize) {
+        return loadMapped(path, accessPattern);
+    }
+
+    return load(path);
+}
+
+Result<BytesView> DiskUtils::loadMapped(const Path& path, FileAccessPattern accessPattern) {
+    auto pathStr = path.toString();
+    auto fd = ::open(pathStr.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Error(STRING_FORMAT("Unable to open file at {}: {}", pathStr, strerror(errno)));
+    }
+
+    auto stat = statFromFd(fd);
+    if (!stat.isFile()) {
+        ::close(fd);
+        return Error(STRING_FORMAT("No file at {}", pathStr));
+    }
+
+    if (stat.size() == 0) {
+        ::close(fd);
+        return BytesView();
+    }
+
+    auto* data = mmap(nullptr, stat.size(), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file descriptor is closed
+    ::close(fd);
+
+    if (data == MAP_FAILED) {
+        return load(path);
+    }
+
+    if (accessPattern != FileAccessPattern::Normal) {
+        // This is only a hint, the mapping is usable regardless of whether it was applied
+        madvise(data, stat.size(), toMadviseAdvice(accessPattern));
+    }
+
+    auto mappedFile = makeShared<MappedFile>(data, stat.size());
+    return BytesView(mappedFile, mappedFile->data(), mappedFile->size());
+}
+
+Result<BytesView> DiskUtils::loadMappedFromFd(int fd,
+                                               int64_t byteOffset,
+                                               size_t size,
+                                               FileAccessPattern accessPattern) {
+    if (byteOffset < 0) {
+        return Error("Invalid byte offset");
+    }
+
+    if (size == 0) {
+        return BytesView();
+    }
+
+    // mmap() requires the offset to be a multiple of the page size, so the mapping starts at the
+    // page containing the region and the returned view skips the leading bytes.
+    static const auto kPageSize = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    auto alignedOffset = byteOffset - (byteOffset % kPageSize);
+    auto leadingBytes = static_cast<size_t>(byteOffset - alignedOffset);
+    auto mappedSize = leadingBytes + size;
+
+    auto* data = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+    if (data == MAP_FAILED) {
+        return Error(STRING_FORMAT("Unable to map file region: {}", strerror(errno)));
+    }
+
+    if (accessPattern != FileAccessPattern::Normal) {
+        madvise(data, mappedSize, toMadviseAdvice(accessPattern));
+    }
+
+    auto mappedFile = makeShared<MappedFile>(data, mappedSize);
+    return BytesView(mappedFile, mappedFile->data() + leadingBytes, size);
+}
+
 Result<Void> DiskUtils::store(const Path& path, const BytesView& bytes) {
     return store(path, bytes.asStringView());
 }
 
+static std::string makeTemporaryPathStr(const std::string& pathStr) {
+    static std::atomic<uint64_t> kTemporaryFileSequence = 0;
+
+    // Writing in place would truncate the file under the readers which mapped it
+    return fmt::format("{}.{}.{}.tmp", pathStr, ::getpid(), ++kTemporaryFileSequence);
+}
+
 Result<Void> DiskUtils::store(const Path& path, std::string_view bytes) {
     auto pathStr = path.toString();
+    auto temporaryPathStr = makeTemporaryPathStr(pathStr);
+
     std::ofstream s;
-    s.open(pathStr, std::ios::trunc | std::ios::binary);
+    s.open(temporaryPathStr, std::ios::trunc | std::ios::binary);
     if (!s.is_open()) {
         return Error(STRING_FORMAT("Unable to open file for writing at {}", pathStr));
     }
@@ -184,7 +318,58 @@ Result<Void> DiskUtils::store(const Path& path, std::string_view bytes) {
     auto success = s.good();
     s.close();
 
-    if (!success) {
+    if (!success || std::rename(temporaryPathStr.c_str(), pathStr.c_str()) != 0) {
+        std::remove(temporaryPathStr.c_str());
+        return Error(STRING_FORMAT("Unable to write file at {}", pathStr));
+    }
+
+    return Void();
+}
+
+static bool writeIOVecs(int fd, std::vector<iovec>& vecs) {
+    size_t index = 0;
+    while (index < vecs.size()) {
+        auto count = static_cast<int>(std::min(vecs.size() - index, static_cast<size_t>(IOV_MAX)));
+        auto written = ::writev(fd, &vecs[index], count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        // Skip the fully written vecs, and resume from the middle of a partially written one
+        auto remaining = static_cast<size_t>(written);
+        while (index < vecs.size() && remaining >= vecs[index].iov_len) {
+            remaining -= vecs[index].iov_len;
+            index++;
+        }
+        if (remaining > 0) {
+            vecs[index].iov_base = reinterpret_cast<Byte*>(vecs[index].iov_base) + remaining;
+            vecs[index].iov_len -= remaining;
+        }
+    }
+
+    return true;
+}
+
+Result<Void> DiskUtils::store(const Path& path, const ByteRope& bytes) {
+    auto pathStr = path.toString();
+    auto temporaryPathStr = makeTemporaryPathStr(pathStr);
+
+    auto fd = ::open(temporaryPathStr.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        return Error(STRING_FORMAT("Unable to open file for writing at {}", pathStr));
+    }
+
+    // The chunks are written as they are, without being flattened into a single buffer first
+    std::vector<iovec> vecs;
+    bytes.toIOVecs(vecs);
+    auto success = writeIOVecs(fd, vecs);
+    success = ::close(fd) == 0 && success;
+
+    if (!success || std::rename(temporaryPathStr.c_str(), pathStr.c_str()) != 0) {
+        std::remove(temporaryPathStr.c_str());
         return Error(STRING_FORMAT("Unable to write file at {}", pathStr));
     }
 
@@ -17,6 +17,8 @@
 
 namespace Valdi {
 
+class ByteRope;
+
 class FileStat {
 public:
     FileStat(bool exists, bool isDir, bool isFile, size_t size)
@@ -64,6 +66,16 @@ private:
     size_t _fileSize = 0;
 };
 
+/**
+ How the data of a mapped file is expected to be accessed, which is given to the kernel
+ so that it can tune its read ahead.
+ */
+enum class FileAccessPattern {
+    Normal,
+    Sequential,
+    Random,
+};
+
 class DiskUtils {
 public:
     static FileStat stat(const Path& path);
@@ -78,10 +90,32 @@ public:
 
     static Result<BytesView> loadFromFd(int fd);
 
+    // Map the file at the given path in memory instead of reading it. The returned view keeps the
+    // mapping alive. Falls back on load() if the file cannot be mapped.
+    static Result<BytesView> loadMapped(const Path& path);
+    static Result<BytesView> loadMapped(const Path& path, FileAccessPattern accessPattern);
+
+    // Map the file at the given path if it is large enough for the mapping to be worth it, read it
+    // otherwise. Mapped data does not count against the heap, and is shared with the page cache.
+    static Result<BytesView> loadMappedIfLarge(const Path& path, FileAccessPattern accessPattern);
+
+    // Map the given region of an already opened file, for instance an asset stored uncompressed within
+    // an APK. The offset does not need to be page aligned. The file descriptor is not closed and can be
+    // closed as soon as this returns, the returned view keeps the mapping alive.
+    static Result<BytesView> loadMappedFromFd(int fd,
+                                              int64_t byteOffset,
+                                              size_t size,
+                                              FileAccessPattern accessPattern);
+
+    // Files are written to a temporary file which then replaces the destination, so that
+    // readers which mapped the previous file keep seeing its content.
     static Result<Void> store(const Path& path, const BytesView& bytes);
 
     static Result<Void> store(const Path& path, std::string_view bytes);
 
+    // Write the chunks of the rope with writev(), without flattening them first.
+    static Result<Void> store(const Path& path, const ByteRope& bytes);
+
     static bool remove(const Path& path);
 
     static bool makeDirectory(const Path& path, bool createIntermediates);
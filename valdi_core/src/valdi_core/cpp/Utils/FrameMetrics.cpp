@@ -0,0 +1,294 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_core/cpp/Utils/FrameMetrics.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace Valdi {
+
+static thread_local ScopedFrameMetrics* currentFrame = nullptr;
+static thread_local ScopedFramePhase* currentPhase = nullptr;
+
+const char* framePhaseToString(FramePhase phase) {
+    switch (phase) {
+        case FramePhase::JSRender:
+            return "js_render";
+        case FramePhase::Render:
+            return "render";
+        case FramePhase::Layout:
+            return "layout";
+        case FramePhase::ViewTreeUpdate:
+            return "view_tree_update";
+        case FramePhase::Draw:
+            return "draw";
+        case FramePhase::Raster:
+            return "raster";
+    }
+    return "unknown";
+}
+
+FrameTimings::FrameTimings() {
+    _durations.fill(FrameDuration::zero());
+}
+
+void FrameTimings::add(FramePhase phase, FrameDuration duration) {
+    _durations[static_cast<size_t>(phase)] += duration;
+}
+
+FrameDuration FrameTimings::get(FramePhase phase) const {
+    return _durations[static_cast<size_t>(phase)];
+}
+
+FrameDuration FrameTimings::getTotal() const {
+    auto total = FrameDuration::zero();
+    for (const auto& duration : _durations) {
+        total += duration;
+    }
+    return total;
+}
+
+FramePhase FrameTimings::getSlowestPhase() const {
+    size_t slowestIndex = 0;
+    for (size_t i = 1; i < kFramePhasesCount; i++) {
+        if (_durations[i] > _durations[slowestIndex]) {
+            slowestIndex = i;
+        }
+    }
+    return static_cast<FramePhase>(slowestIndex);
+}
+
+void FrameTimings::addBridgeCrossings(const BridgeCrossings& bridgeCrossings) {
+    _bridgeCrossings.add(bridgeCrossings);
+}
+
+const BridgeCrossings& FrameTimings::getBridgeCrossings() const {
+    return _bridgeCrossings;
+}
+
+void FrameMetricsSummary::reset() {
+    period = std::chrono::steady_clock::duration::zero();
+    frameTimes.reset();
+    for (auto& phaseTime : phaseTimes) {
+        phaseTime.reset();
+    }
+    jankyFramesCount = 0;
+    jankyFramesByPhase.fill(0);
+    bridgeCrossings = BridgeCrossings();
+    maxBridgeCrossingsPerFrame = 0;
+    gpuTimes.reset();
+    presentLatencies.reset();
+    gpuBoundFramesCount = 0;
+}
+
+FrameMetricsAggregator::FrameMetricsAggregator(FrameDuration frameBudget,
+                                               std::chrono::steady_clock::duration flushInterval)
+    : _frameBudget(frameBudget), _flushInterval(flushInterval), _lastFlushTime(std::chrono::steady_clock::now()) {}
+
+FrameMetricsAggregator::~FrameMetricsAggregator() = default;
+
+void FrameMetricsAggregator::setFlushCallback(FrameMetricsFlushCallback flushCallback) {
+    std::lock_guard<Mutex> lock(_mutex);
+    _flushCallback = std::move(flushCallback);
+    if (!_flushCallback) {
+        _summaries.clear();
+    }
+    updateEnabled();
+}
+
+void FrameMetricsAggregator::setObserver(const Ref<IFrameMetricsObserver>& observer) {
+    std::lock_guard<Mutex> lock(_mutex);
+    _observer = observer;
+    updateEnabled();
+}
+
+void FrameMetricsAggregator::updateEnabled() {
+    _enabled = static_cast<bool>(_flushCallback) || _observer != nullptr;
+}
+
+bool FrameMetricsAggregator::isEnabled() const {
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+void FrameMetricsAggregator::recordFrame(const StringBox& module, const FrameTimings& timings) {
+    if (!isEnabled()) {
+        return;
+    }
+    recordFrame(module, timings, std::chrono::steady_clock::now());
+}
+
+void FrameMetricsAggregator::recordFrame(const StringBox& module,
+                                         const FrameTimings& timings,
+                                         std::chrono::steady_clock::time_point currentTime) {
+    std::unique_lock<Mutex> lock(_mutex);
+    if (!_enabled) {
+        return;
+    }
+
+    if (_observer != nullptr) {
+        // The observer is called outside of the lock, so that it can take its own locks
+        auto observer = _observer;
+        lock.unlock();
+        observer->onFrameRecorded(module, timings);
+        lock.lock();
+    }
+
+    if (!_flushCallback) {
+        return;
+    }
+
+    auto& summary = _summaries[module];
+    auto total = timings.getTotal();
+    summary.frameTimes.record(total);
+    for (size_t i = 0; i < kFramePhasesCount; i++) {
+        auto phaseDuration = timings.get(static_cast<FramePhase>(i));
+        if (phaseDuration > FrameDuration::zero()) {
+            summary.phaseTimes[i].record(phaseDuration);
+        }
+    }
+
+    const auto& bridgeCrossings = timings.getBridgeCrossings();
+    summary.bridgeCrossings.add(bridgeCrossings);
+    summary.maxBridgeCrossingsPerFrame = std::max(summary.maxBridgeCrossingsPerFrame, bridgeCrossings.getTotalCount());
+
+    if (total > _frameBudget) {
+        summary.jankyFramesCount++;
+        summary.jankyFramesByPhase[static_cast<size_t>(timings.getSlowestPhase())]++;
+    }
+
+    if (currentTime - _lastFlushTime >= _flushInterval) {
+        lock.unlock();
+        doFlush(currentTime);
+    }
+}
+
+void FrameMetricsAggregator::recordGPUFrame(const StringBox& module, const GPUFrameTiming& timing) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    std::lock_guard<Mutex> lock(_mutex);
+    if (!_flushCallback) {
+        return;
+    }
+
+    auto& summary = _summaries[module];
+    if (timing.gpuDuration) {
+        summary.gpuTimes.record(timing.gpuDuration.value());
+        if (timing.gpuDuration.value() > _frameBudget) {
+            summary.gpuBoundFramesCount++;
+        }
+    }
+    if (timing.presentLatency) {
+        summary.presentLatencies.record(timing.presentLatency.value());
+    }
+}
+
+void FrameMetricsAggregator::flush() {
+    doFlush(std::chrono::steady_clock::now());
+}
+
+void FrameMetricsAggregator::doFlush(std::chrono::steady_clock::time_point currentTime) {
+    std::vector<std::pair<StringBox, FrameMetricsSummary>> summaries;
+    FrameMetricsFlushCallback flushCallback;
+
+    {
+        std::lock_guard<Mutex> lock(_mutex);
+        auto period = currentTime - _lastFlushTime;
+        _lastFlushTime = currentTime;
+
+        for (auto& it : _summaries) {
+            if (it.second.frameTimes.empty()) {
+                continue;
+            }
+            it.second.period = period;
+            it.second.frameBudget = _frameBudget;
+            summaries.emplace_back(it.first, it.second);
+            it.second.reset();
+        }
+
+        flushCallback = _flushCallback;
+    }
+
+    if (!flushCallback) {
+        return;
+    }
+
+    for (const auto& it : summaries) {
+        flushCallback(it.first, it.second);
+    }
+}
+
+FrameMetricsAggregator& FrameMetricsAggregator::shared() {
+    static auto* kInstance = new FrameMetricsAggregator();
+    return *kInstance;
+}
+
+ScopedFrameMetrics::ScopedFrameMetrics(FrameMetricsAggregator& aggregator,
+                                       const StringBox& module,
+                                       FramePhase defaultPhase)
+    : _defaultPhase(defaultPhase) {
+    if (currentFrame != nullptr || !aggregator.isEnabled()) {
+        return;
+    }
+
+    _aggregator = &aggregator;
+    _module = module;
+    _startTime = std::chrono::steady_clock::now();
+    _startBridgeCrossings = BridgeCrossings::current();
+    currentFrame = this;
+}
+
+ScopedFrameMetrics::~ScopedFrameMetrics() {
+    if (_aggregator == nullptr) {
+        return;
+    }
+
+    currentFrame = nullptr;
+
+    auto elapsed = std::chrono::steady_clock::now() - _startTime;
+    _timings.add(_defaultPhase, elapsed - _phasesDuration);
+    _timings.addBridgeCrossings(BridgeCrossings::current().since(_startBridgeCrossings));
+    _aggregator->recordFrame(_module, _timings);
+}
+
+void ScopedFrameMetrics::addPhaseDuration(FramePhase phase, FrameDuration duration) {
+    if (currentFrame != nullptr) {
+        currentFrame->_timings.add(phase, duration);
+    }
+}
+
+void ScopedFrameMetrics::addBridgeCrossings(const BridgeCrossings& bridgeCrossings) {
+    if (currentFrame != nullptr) {
+        currentFrame->_timings.addBridgeCrossings(bridgeCrossings);
+    }
+}
+
+ScopedFramePhase::ScopedFramePhase(FramePhase phase) : _frame(currentFrame), _phase(phase) {
+    if (_frame == nullptr) {
+        return;
+    }
+
+    _parent = currentPhase;
+    _startTime = std::chrono::steady_clock::now();
+    currentPhase = this;
+}
+
+ScopedFramePhase::~ScopedFramePhase() {
+    if (_frame == nullptr) {
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - _startTime;
+    _frame->_timings.add(_phase, elapsed - _nestedPhasesDuration);
+
+    if (_parent != nullptr) {
+        _parent->_nestedPhasesDuration += elapsed;
+    } else {
+        _frame->_phasesDuration += elapsed;
+    }
+
+    currentPhase = _parent;
+}
+
+} // namespace Valdi
@@ -0,0 +1,219 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "utils/base/NonCopyable.hpp"
+#include "valdi_core/cpp/Utils/BridgeCrossings.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/LatencyHistogram.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace Valdi {
+
+/**
+ * The phases a frame goes through, from the JS render until the frame is rasterized.
+ */
+enum class FramePhase : uint8_t {
+    JSRender = 0,
+    Render,
+    Layout,
+    ViewTreeUpdate,
+    Draw,
+    Raster,
+};
+
+constexpr size_t kFramePhasesCount = static_cast<size_t>(FramePhase::Raster) + 1;
+
+const char* framePhaseToString(FramePhase phase);
+
+using FrameDuration = std::chrono::steady_clock::duration;
+
+/**
+ * The time spent in each phase during a single frame.
+ */
+class FrameTimings {
+public:
+    FrameTimings();
+
+    void add(FramePhase phase, FrameDuration duration);
+    FrameDuration get(FramePhase phase) const;
+
+    FrameDuration getTotal() const;
+
+    /**
+     * Returns the phase in which the frame spent the most time.
+     */
+    FramePhase getSlowestPhase() const;
+
+    void addBridgeCrossings(const BridgeCrossings& bridgeCrossings);
+    const BridgeCrossings& getBridgeCrossings() const;
+
+private:
+    std::array<FrameDuration, kFramePhasesCount> _durations;
+    BridgeCrossings _bridgeCrossings;
+};
+
+/**
+ * Timings of a frame which are only known once the GPU executed it and the display presented it,
+ * well after the frame was recorded. Either of them can be missing when the graphics context cannot measure it.
+ */
+struct GPUFrameTiming {
+    // Time the GPU spent executing the commands of the frame
+    std::optional<FrameDuration> gpuDuration;
+    // Time between the frame being submitted and being presented on the display
+    std::optional<FrameDuration> presentLatency;
+};
+
+/**
+ * Aggregated frame times of a module over a flush interval.
+ */
+struct FrameMetricsSummary {
+    std::chrono::steady_clock::duration period;
+    FrameDuration frameBudget;
+    LatencyHistogram frameTimes;
+    std::array<LatencyHistogram, kFramePhasesCount> phaseTimes;
+    uint64_t jankyFramesCount = 0;
+    // Number of janky frames for which the phase was the slowest
+    std::array<uint64_t, kFramePhasesCount> jankyFramesByPhase{};
+    // Bridge crossings made by all the frames, and by the frame which made the most of them
+    BridgeCrossings bridgeCrossings;
+    uint64_t maxBridgeCrossingsPerFrame = 0;
+    // GPU timings reported for the frames, a frame whose GPU time goes over the frame budget is GPU bound
+    LatencyHistogram gpuTimes;
+    LatencyHistogram presentLatencies;
+    uint64_t gpuBoundFramesCount = 0;
+
+    void reset();
+};
+
+using FrameMetricsFlushCallback = Function<void(const StringBox& module, const FrameMetricsSummary& summary)>;
+
+/**
+ * Receives the timings of every frame as they are recorded, for consumers which need
+ * them individually instead of aggregated, like a live performance overlay.
+ * Called on the thread which recorded the frame.
+ */
+class IFrameMetricsObserver : public SimpleRefCountable {
+public:
+    virtual void onFrameRecorded(const StringBox& module, const FrameTimings& timings) = 0;
+};
+
+/**
+ * Aggregates per frame timings into per module histograms. A frame whose total time goes over the
+ * frame budget is considered janky, and is attributed to the phase in which it spent the most time.
+ * The summaries are periodically flushed to the flush callback, instead of emitting one event per frame.
+ *
+ * Recording a frame does not allocate once a module has been seen.
+ * The aggregator is disabled until a flush callback or an observer is set.
+ */
+class FrameMetricsAggregator : public snap::NonCopyable {
+public:
+    explicit FrameMetricsAggregator(FrameDuration frameBudget = kDefaultFrameBudget,
+                                    std::chrono::steady_clock::duration flushInterval = kDefaultFlushInterval);
+    ~FrameMetricsAggregator();
+
+    void setFlushCallback(FrameMetricsFlushCallback flushCallback);
+
+    /**
+     * Set the observer notified of each recorded frame. Frames are only aggregated
+     * into summaries when a flush callback is set.
+     */
+    void setObserver(const Ref<IFrameMetricsObserver>& observer);
+
+    bool isEnabled() const;
+
+    void recordFrame(const StringBox& module, const FrameTimings& timings);
+    void recordFrame(const StringBox& module,
+                     const FrameTimings& timings,
+                     std::chrono::steady_clock::time_point currentTime);
+
+    /**
+     * Record the GPU timing of a frame of the module, which is reported separately as it
+     * becomes available after the frame was recorded.
+     */
+    void recordGPUFrame(const StringBox& module, const GPUFrameTiming& timing);
+
+    /**
+     * Emit the summaries of every module which recorded frames since the last flush.
+     */
+    void flush();
+
+    static FrameMetricsAggregator& shared();
+
+    static constexpr FrameDuration kDefaultFrameBudget = std::chrono::microseconds(16667);
+    static constexpr std::chrono::steady_clock::duration kDefaultFlushInterval = std::chrono::seconds(30);
+
+private:
+    mutable Mutex _mutex;
+    FrameDuration _frameBudget;
+    std::chrono::steady_clock::duration _flushInterval;
+    std::chrono::steady_clock::time_point _lastFlushTime;
+    FrameMetricsFlushCallback _flushCallback;
+    Ref<IFrameMetricsObserver> _observer;
+    std::atomic_bool _enabled = false;
+    FlatMap<StringBox, FrameMetricsSummary> _summaries;
+
+    void doFlush(std::chrono::steady_clock::time_point currentTime);
+    void updateEnabled();
+};
+
+/**
+ * Measures a frame on the current thread and records it into the aggregator when going out of scope.
+ * ScopedFramePhase instances created on the same thread while the frame is alive add their time to the frame,
+ * any remaining time of the frame is attributed to the given default phase.
+ * A ScopedFrameMetrics created while another one is alive on the same thread is merged into the outer frame.
+ */
+class ScopedFrameMetrics : public snap::NonCopyable {
+public:
+    ScopedFrameMetrics(FrameMetricsAggregator& aggregator, const StringBox& module, FramePhase defaultPhase);
+    ~ScopedFrameMetrics();
+
+    /**
+     * Add time spent outside of the current thread to the frame currently measured on this thread, if any.
+     */
+    static void addPhaseDuration(FramePhase phase, FrameDuration duration);
+
+    /**
+     * Add bridge crossings made outside of the current thread to the frame currently measured on this thread,
+     * if any. The crossings made on the current thread while the frame is alive are added automatically.
+     */
+    static void addBridgeCrossings(const BridgeCrossings& bridgeCrossings);
+
+private:
+    FrameMetricsAggregator* _aggregator = nullptr;
+    StringBox _module;
+    FramePhase _defaultPhase;
+    std::chrono::steady_clock::time_point _startTime;
+    FrameDuration _phasesDuration = FrameDuration::zero();
+    FrameTimings _timings;
+    BridgeCrossings _startBridgeCrossings;
+
+    friend class ScopedFramePhase;
+};
+
+/**
+ * Measures the time spent in a phase of the frame currently measured on this thread.
+ * Only the time not spent in nested phases is attributed to the phase.
+ */
+class ScopedFramePhase : public snap::NonCopyable {
+public:
+    explicit ScopedFramePhase(FramePhase phase);
+    ~ScopedFramePhase();
+
+private:
+    ScopedFrameMetrics* _frame;
+    ScopedFramePhase* _parent = nullptr;
+    FramePhase _phase;
+    std::chrono::steady_clock::time_point _startTime;
+    FrameDuration _nestedPhasesDuration = FrameDuration::zero();
+};
+
+} // namespace Valdi
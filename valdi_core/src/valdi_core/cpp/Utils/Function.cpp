@@ -0,0 +1,166 @@
+//
+//  Function.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include <array>
+
+namespace Valdi {
+
+constexpr size_t kDispatchClosureSizeClassesCount =
+    DispatchClosureAllocator::kMaxPooledClosureSize / DispatchClosureAllocator::kSizeClassGranularity;
+
+// How many batches of closures the shared depot holds per size class before freeing them
+constexpr size_t kMaxDepotBatchesPerSizeClass = 16;
+
+namespace {
+
+struct FreeDispatchClosure {
+    FreeDispatchClosure* next;
+    // Next batch in the shared depot and size of the batch, only set on the first closure of a batch
+    FreeDispatchClosure* nextBatch;
+    size_t batchSize;
+};
+
+void freeClosures(FreeDispatchClosure* head) {
+    while (head != nullptr) {
+        auto* next = head->next;
+        ::operator delete(head);
+        head = next;
+    }
+}
+
+struct DispatchClosureDepot {
+    Mutex mutex{"DispatchClosureDepot"};
+    std::array<FreeDispatchClosure*, kDispatchClosureSizeClassesCount> batches{};
+    std::array<size_t, kDispatchClosureSizeClassesCount> batchesCount{};
+
+    FreeDispatchClosure* popBatch(size_t sizeClass, size_t* batchSize) {
+        std::lock_guard<Mutex> guard(mutex);
+        auto* batch = batches[sizeClass];
+        if (batch != nullptr) {
+            batches[sizeClass] = batch->nextBatch;
+            batchesCount[sizeClass]--;
+            *batchSize = batch->batchSize;
+        }
+        return batch;
+    }
+
+    void pushBatch(size_t sizeClass, FreeDispatchClosure* batch, size_t batchSize) {
+        {
+            std::lock_guard<Mutex> guard(mutex);
+            if (batchesCount[sizeClass] < kMaxDepotBatchesPerSizeClass) {
+                batch->nextBatch = batches[sizeClass];
+                batch->batchSize = batchSize;
+                batches[sizeClass] = batch;
+                batchesCount[sizeClass]++;
+                return;
+            }
+        }
+        freeClosures(batch);
+    }
+
+    static DispatchClosureDepot& shared() {
+        // Leaked so that closures can still be freed during static destruction
+        static auto* kDepot = new DispatchClosureDepot();
+        return *kDepot;
+    }
+};
+
+struct DispatchClosureFreeLists {
+    std::array<FreeDispatchClosure*, kDispatchClosureSizeClassesCount> heads{};
+    std::array<size_t, kDispatchClosureSizeClassesCount> counts{};
+
+    ~DispatchClosureFreeLists();
+};
+
+thread_local DispatchClosureFreeLists tFreeLists;
+// Closures destroyed during thread exit after the free lists are freed directly
+thread_local bool tFreeListsDestroyed = false;
+
+DispatchClosureFreeLists::~DispatchClosureFreeLists() {
+    tFreeListsDestroyed = true;
+    // Give back the closures of the exiting thread, as they were most likely allocated by other threads
+    for (size_t sizeClass = 0; sizeClass < kDispatchClosureSizeClassesCount; sizeClass++) {
+        if (heads[sizeClass] != nullptr) {
+            DispatchClosureDepot::shared().pushBatch(sizeClass, heads[sizeClass], counts[sizeClass]);
+        }
+    }
+}
+
+size_t getSizeClass(size_t size) {
+    return (size + DispatchClosureAllocator::kSizeClassGranularity - 1) /
+               DispatchClosureAllocator::kSizeClassGranularity -
+           1;
+}
+
+} // namespace
+
+void* DispatchClosureAllocator::allocate(size_t size) {
+    auto sizeClass = getSizeClass(size);
+    if (!tFreeListsDestroyed) {
+        auto& freeLists = tFreeLists;
+        auto* closure = freeLists.heads[sizeClass];
+        if (closure == nullptr) {
+            closure = DispatchClosureDepot::shared().popBatch(sizeClass, &freeLists.counts[sizeClass]);
+        }
+
+        if (closure != nullptr) {
+            freeLists.heads[sizeClass] = closure->next;
+            freeLists.counts[sizeClass]--;
+            return closure;
+        }
+    }
+
+    // Allocate the whole size class so that the closure can be reused by any closure of that class
+    auto allocationSize = (sizeClass + 1) * kSizeClassGranularity;
+    AllocationProfiler::recordAllocation(AllocationSite::DispatchClosure, allocationSize);
+    return ::operator new(allocationSize);
+}
+
+void DispatchClosureAllocator::deallocate(void* ptr, size_t size) noexcept {
+    if (tFreeListsDestroyed) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto sizeClass = getSizeClass(size);
+    auto& freeLists = tFreeLists;
+    if (freeLists.counts[sizeClass] >= kMaxPooledClosuresPerSizeClass) {
+        // Move a batch to the depot, where the threads allocating the closures can take it back
+        auto* batch = freeLists.heads[sizeClass];
+        auto* last = batch;
+        for (size_t i = 1; i < kTransferBatchSize; i++) {
+            last = last->next;
+        }
+        freeLists.heads[sizeClass] = last->next;
+        freeLists.counts[sizeClass] -= kTransferBatchSize;
+        last->next = nullptr;
+
+        DispatchClosureDepot::shared().pushBatch(sizeClass, batch, kTransferBatchSize);
+    }
+
+    auto* closure = new (ptr) FreeDispatchClosure();
+    closure->next = freeLists.heads[sizeClass];
+    freeLists.heads[sizeClass] = closure;
+    freeLists.counts[sizeClass]++;
+}
+
+size_t DispatchClosureAllocator::getPooledClosuresCount() {
+    if (tFreeListsDestroyed) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (auto sizeClassCount : tFreeLists.counts) {
+        count += sizeClassCount;
+    }
+    return count;
+}
+
+} // namespace Valdi
@@ -8,14 +8,115 @@
 #pragma once
 
 #include "utils/base/Function.hpp"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Valdi {
 
 template<typename Signature>
 using Function = snap::CopyableFunction<Signature>;
 
-struct DispatchFunction : public Valdi::Function<void()> {
-    using Valdi::Function<void()>::Function;
+/**
+ A copyable function which stores callables of up to InlineSize bytes inline.
+ */
+template<typename Signature, size_t InlineSize>
+using InlineFunction = snap::OptimizedCopyableFunction<void* [InlineSize / sizeof(void*)], Signature>;
+
+/**
+ Allocates the closures of the DispatchFunction's which don't fit in their inline storage.
+ Freed closures are kept in per thread free lists, which exchange batches of closures through
+ a shared depot so that closures allocated on one thread and freed on another one are recycled.
+ */
+class DispatchClosureAllocator {
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size) noexcept;
+
+    /**
+     Returns how many freed closures the current thread holds.
+     */
+    static size_t getPooledClosuresCount();
+
+    static constexpr size_t kSizeClassGranularity = 64;
+    static constexpr size_t kMaxPooledClosureSize = 512;
+    static constexpr size_t kMaxPooledClosuresPerSizeClass = 64;
+    // How many closures are moved at once between a thread and the shared depot
+    static constexpr size_t kTransferBatchSize = kMaxPooledClosuresPerSizeClass / 2;
+};
+
+/**
+ Holds a callable allocated from the DispatchClosureAllocator, so that it can be stored
+ inline in a DispatchFunction.
+ */
+template<typename F>
+class PooledClosure {
+public:
+    explicit PooledClosure(F&& fn) : _fn(new (DispatchClosureAllocator::allocate(sizeof(F))) F(std::move(fn))) {}
+
+    explicit PooledClosure(const F& fn) : _fn(new (DispatchClosureAllocator::allocate(sizeof(F))) F(fn)) {}
+
+    PooledClosure(const PooledClosure& other)
+        : _fn(new (DispatchClosureAllocator::allocate(sizeof(F))) F(*other._fn)) {}
+
+    PooledClosure(PooledClosure&& other) noexcept : _fn(other._fn) {
+        other._fn = nullptr;
+    }
+
+    ~PooledClosure() {
+        if (_fn != nullptr) {
+            _fn->~F();
+            DispatchClosureAllocator::deallocate(_fn, sizeof(F));
+        }
+    }
+
+    PooledClosure& operator=(const PooledClosure& other) = delete;
+    PooledClosure& operator=(PooledClosure&& other) = delete;
+
+    void operator()() const {
+        (*_fn)();
+    }
+
+private:
+    F* _fn;
+};
+
+/**
+ Large enough to store a closure capturing a few Ref's and a Value without allocating.
+ */
+constexpr size_t kDispatchFunctionInlineSize = 8 * sizeof(void*);
+
+/**
+ The function type of the tasks submitted to the dispatch queues. Callables which don't fit
+ in its inline storage are allocated from the pool of the DispatchClosureAllocator.
+ */
+struct DispatchFunction : public InlineFunction<void(), kDispatchFunctionInlineSize> {
+    using Base = InlineFunction<void(), kDispatchFunctionInlineSize>;
+
+    DispatchFunction() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, DispatchFunction>>>
+    DispatchFunction(F&& fn) // NOLINT(google-explicit-constructor)
+        : Base(makeStorable(std::forward<F>(fn))) {}
+
+    template<typename F>
+    static constexpr bool fitsInline() {
+        return sizeof(F) <= kDispatchFunctionInlineSize && alignof(F) <= alignof(void*) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+private:
+    template<typename F>
+    static decltype(auto) makeStorable(F&& fn) {
+        using Callable = std::decay_t<F>;
+        if constexpr (!fitsInline<Callable>() && sizeof(Callable) <= DispatchClosureAllocator::kMaxPooledClosureSize &&
+                      alignof(Callable) <= alignof(std::max_align_t)) {
+            return PooledClosure<Callable>(std::forward<F>(fn));
+        } else {
+            return std::forward<F>(fn);
+        }
+    }
 };
 
 } // namespace Valdi
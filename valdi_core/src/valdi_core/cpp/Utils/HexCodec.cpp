@@ -0,0 +1,107 @@
+//
+//  HexCodec.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/HexCodec.hpp"
+#include <array>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace Valdi {
+
+constexpr std::string_view kHexDigits = "0123456789abcdef";
+constexpr uint8_t kInvalidNibble = 0xFF;
+
+static constexpr std::array<uint8_t, 256> makeNibbleTable() {
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table) {
+        entry = kInvalidNibble;
+    }
+    for (uint8_t i = 0; i < 10; i++) {
+        table['0' + i] = i;
+    }
+    for (uint8_t i = 0; i < 6; i++) {
+        table['a' + i] = 10 + i;
+        table['A' + i] = 10 + i;
+    }
+    return table;
+}
+
+static constexpr std::array<char, 512> makeByteTable() {
+    std::array<char, 512> table{};
+    for (size_t i = 0; i < 256; i++) {
+        table[i * 2] = kHexDigits[i >> 4];
+        table[i * 2 + 1] = kHexDigits[i & 0x0F];
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> kNibbleTable = makeNibbleTable();
+constexpr std::array<char, 512> kByteTable = makeByteTable();
+
+void HexCodec::encode(const Byte* data, size_t size, char* output) {
+    size_t i = 0;
+
+#if defined(__SSSE3__)
+    const auto digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const auto lowNibbleMask = _mm_set1_epi8(0x0F);
+
+    for (; i + 16 <= size; i += 16) {
+        auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibbleMask));
+        auto low = _mm_shuffle_epi8(digits, _mm_and_si128(input, lowNibbleMask));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(high, low));
+        output += 32;
+    }
+#endif
+
+    for (; i < size; i++) {
+        const auto* digitPair = &kByteTable[static_cast<size_t>(data[i]) * 2];
+        output[0] = digitPair[0];
+        output[1] = digitPair[1];
+        output += 2;
+    }
+}
+
+std::string HexCodec::encode(const Byte* data, size_t size) {
+    std::string output;
+    output.resize(size * 2);
+    encode(data, size, output.data());
+    return output;
+}
+
+std::optional<size_t> HexCodec::decode(std::string_view input, Byte* output) {
+    if (input.size() % 2 != 0) {
+        return std::nullopt;
+    }
+
+    auto size = input.size() / 2;
+    for (size_t i = 0; i < size; i++) {
+        auto high = kNibbleTable[static_cast<uint8_t>(input[i * 2])];
+        auto low = kNibbleTable[static_cast<uint8_t>(input[i * 2 + 1])];
+        if (((high | low) & 0xF0) != 0) {
+            return std::nullopt;
+        }
+        output[i] = static_cast<Byte>((high << 4) | low);
+    }
+
+    return size;
+}
+
+bool HexCodec::decode(std::string_view input, Bytes& output) {
+    output.resize(input.size() / 2);
+    if (!decode(input, output.data())) {
+        output.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace Valdi
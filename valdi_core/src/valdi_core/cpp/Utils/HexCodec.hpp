@@ -0,0 +1,43 @@
+//
+//  HexCodec.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Valdi {
+
+/**
+ Hex encoder and decoder based on lookup tables, the encoder processes 16 bytes at a time
+ with SSSE3 when available. Encoding produces lowercase characters, decoding accepts both cases.
+ */
+class HexCodec {
+public:
+    /**
+     Encode the given bytes into the output, which must be at least size * 2 large.
+     */
+    static void encode(const Byte* data, size_t size, char* output);
+
+    static std::string encode(const Byte* data, size_t size);
+
+    /**
+     Decode the given hex string into the output, which must be at least input.size() / 2 large.
+     Returns how many bytes were written, or an empty optional if the input is not valid hex.
+     */
+    static std::optional<size_t> decode(std::string_view input, Byte* output);
+
+    /**
+     Decode the given string into the output, which is resized to the decoded size.
+     Returns false if the input is not valid hex.
+     */
+    static bool decode(std::string_view input, Bytes& output);
+};
+
+} // namespace Valdi
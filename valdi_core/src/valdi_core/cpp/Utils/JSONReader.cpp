@@ -9,6 +9,8 @@
 #include "valdi_core/cpp/Utils/JSONReader.hpp"
 #include <fmt/format.h>
 
+#include <cstring>
+
 namespace Valdi {
 
 static inline std::string codePointToUTF8(unsigned int cp) {
@@ -39,6 +41,40 @@ static inline std::string codePointToUTF8(unsigned int cp) {
     return result;
 }
 
+// Bytes of a word set to the given character
+static constexpr uint64_t repeatByte(char c) {
+    return 0x0101010101010101ULL * static_cast<uint8_t>(c);
+}
+
+// Whether any byte of the word is zero
+static inline bool hasZeroByte(uint64_t word) {
+    return ((word - repeatByte(1)) & ~word & repeatByte(static_cast<char>(0x80))) != 0;
+}
+
+// Whether any byte of the word ends or escapes a string
+static inline bool hasStringDelimiter(uint64_t word) {
+    return hasZeroByte(word ^ repeatByte('"')) || hasZeroByte(word ^ repeatByte('\\'));
+}
+
+// Returns the offset of the first quote or backslash from the given one, or the size of the string
+// if there is none. Strings are scanned a word at a time, as most of their characters are neither.
+static size_t findStringDelimiter(std::string_view str, size_t offset) {
+    while (str.size() - offset >= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, str.data() + offset, sizeof(uint64_t));
+        if (hasStringDelimiter(word)) {
+            break;
+        }
+        offset += sizeof(uint64_t);
+    }
+
+    while (offset < str.size() && str[offset] != '"' && str[offset] != '\\') {
+        offset++;
+    }
+
+    return offset;
+}
+
 JSONReader::JSONReader(std::string_view input) : _parser(input) {}
 
 bool JSONReader::hasError() const {
@@ -118,6 +154,7 @@ JSONReader::Token JSONReader::peekToken() {
             return JSONReader::Token::Array;
         case '"':
             return JSONReader::Token::String;
+        case '-':
         case '0':
         case '1':
         case '2':
@@ -177,29 +214,76 @@ bool JSONReader::parseColon() {
     return parseToken(':');
 }
 
-bool JSONReader::parseString(std::string& output) {
+bool JSONReader::scanString(std::string_view& rawString, bool& hasEscapes) {
     if (!_parser.parse('"')) {
         return false;
     }
 
-    auto p = position();
-    auto escaping = false;
+    auto start = position();
+    auto remaining = _parser.substr(start, end());
+    size_t offset = 0;
+    hasEscapes = false;
 
-    while (escaping || !_parser.tryParse('"')) {
-        if (escaping) {
-            escaping = false;
-        } else {
-            if (_parser.peek('\\')) {
-                escaping = true;
-            }
+    for (;;) {
+        offset = findStringDelimiter(remaining, offset);
+        if (offset >= remaining.size()) {
+            _parser.skipCount(remaining.size());
+            return _parser.ensureNotAtEnd();
+        }
+        if (remaining[offset] == '"') {
+            break;
         }
 
-        if (!_parser.skip()) {
-            return false;
+        // Skip the backslash and the escaped character
+        hasEscapes = true;
+        offset += 2;
+        if (offset > remaining.size()) {
+            _parser.skipCount(remaining.size());
+            return _parser.ensureNotAtEnd();
         }
     }
 
-    return decodeString(_parser.substr(p, position() - 1), output);
+    rawString = remaining.substr(0, offset);
+    _parser.skipCount(offset + 1);
+    _parser.tryParseWhitespaces();
+    return true;
+}
+
+bool JSONReader::parseString(std::string& output) {
+    std::string_view rawString;
+    bool hasEscapes;
+    if (!scanString(rawString, hasEscapes)) {
+        return false;
+    }
+
+    if (!hasEscapes) {
+        output.append(rawString);
+        return true;
+    }
+
+    return decodeString(rawString, output);
+}
+
+bool JSONReader::parseStringView(std::string_view& output, bool& isInInput) {
+    std::string_view rawString;
+    bool hasEscapes;
+    if (!scanString(rawString, hasEscapes)) {
+        return false;
+    }
+
+    isInInput = !hasEscapes;
+    if (!hasEscapes) {
+        output = rawString;
+        return true;
+    }
+
+    _tmp.clear();
+    if (!decodeString(rawString, _tmp)) {
+        return false;
+    }
+
+    output = _tmp;
+    return true;
 }
 
 bool JSONReader::decodeString(std::string_view str, std::string& decoded) {
@@ -55,6 +55,14 @@ public:
 
     bool parseString(std::string& output);
 
+    /**
+     Parse a string without copying it when it has no escape sequences, in which case
+     the output points into the input. Escaped strings are decoded into a buffer owned
+     by the reader, the output is then only valid until the next call to parseStringView().
+     isInInput is set to whether the output points into the input.
+     */
+    bool parseStringView(std::string_view& output, bool& isInInput);
+
     bool parseInt(int32_t& output);
     bool parseUInt(uint32_t& output);
 
@@ -73,6 +81,8 @@ private:
     bool tryParseToken(std::string_view token);
     bool parseToken(std::string_view token);
 
+    bool scanString(std::string_view& rawString, bool& hasEscapes);
+
     bool decodeString(std::string_view str, std::string& decoded);
     bool decodeUnicodeCodePoint(const char*& current, const char* end, unsigned int& unicode);
     bool decodeUnicodeEscapeSequence(const char*& current, const char* end, unsigned int& retUnicode);
@@ -144,6 +144,13 @@ public:
         return _list.end();
     }
 
+    /**
+     Returns an iterator to the least recently used node, or end() if the cache is empty.
+     */
+    Iterator last() const {
+        return _list.last();
+    }
+
 private:
     FlatMap<Key, Ref<Node>> _nodeByKey;
     LinkedList<Node> _list;
@@ -0,0 +1,126 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_core/cpp/Utils/LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Valdi {
+
+LatencyHistogram::LatencyHistogram() {
+    _buckets.fill(0);
+}
+
+void LatencyHistogram::record(Duration duration) {
+    auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    recordMicroseconds(microseconds > 0 ? static_cast<uint64_t>(microseconds) : 0);
+}
+
+void LatencyHistogram::recordMicroseconds(uint64_t microseconds) {
+    _buckets[getBucketIndex(microseconds)]++;
+
+    if (_count == 0 || microseconds < _min) {
+        _min = microseconds;
+    }
+    _max = std::max(_max, microseconds);
+    _count++;
+    _sum += microseconds;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other._count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < kBucketsCount; i++) {
+        _buckets[i] += other._buckets[i];
+    }
+
+    _min = _count == 0 ? other._min : std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+    _count += other._count;
+    _sum += other._sum;
+}
+
+void LatencyHistogram::reset() {
+    _buckets.fill(0);
+    _count = 0;
+    _sum = 0;
+    _min = 0;
+    _max = 0;
+}
+
+bool LatencyHistogram::empty() const {
+    return _count == 0;
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return _count;
+}
+
+std::chrono::microseconds LatencyHistogram::getMin() const {
+    return std::chrono::microseconds(_min);
+}
+
+std::chrono::microseconds LatencyHistogram::getMax() const {
+    return std::chrono::microseconds(_max);
+}
+
+std::chrono::microseconds LatencyHistogram::getMean() const {
+    if (_count == 0) {
+        return std::chrono::microseconds(0);
+    }
+    return std::chrono::microseconds(_sum / _count);
+}
+
+std::chrono::microseconds LatencyHistogram::getValueAtPercentile(double percentile) const {
+    if (_count == 0) {
+        return std::chrono::microseconds(0);
+    }
+
+    auto clampedPercentile = std::clamp(percentile, 0.0, 100.0);
+    auto targetCount = static_cast<uint64_t>(std::ceil(clampedPercentile / 100.0 * static_cast<double>(_count)));
+    targetCount = std::max(targetCount, static_cast<uint64_t>(1));
+
+    uint64_t count = 0;
+    for (size_t i = 0; i < kBucketsCount; i++) {
+        count += _buckets[i];
+        if (count >= targetCount) {
+            // The bucket upper bound can be above the largest recorded value
+            return std::chrono::microseconds(std::min(getBucketUpperBound(i), _max));
+        }
+    }
+
+    return std::chrono::microseconds(_max);
+}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t microseconds) {
+    if (microseconds < kSubBucketsCount) {
+        return static_cast<size_t>(microseconds);
+    }
+
+    auto magnitude = static_cast<size_t>(std::bit_width(microseconds) - 1);
+    if (magnitude >= kMaxMagnitude) {
+        return kBucketsCount - 1;
+    }
+
+    auto shift = magnitude - kSubBucketsBits;
+    auto subBucket = static_cast<size_t>(microseconds >> shift) & (kSubBucketsCount - 1);
+
+    return (shift + 1) * kSubBucketsCount + subBucket;
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(size_t bucketIndex) {
+    if (bucketIndex < kSubBucketsCount) {
+        return static_cast<uint64_t>(bucketIndex);
+    }
+
+    auto shift = bucketIndex / kSubBucketsCount - 1;
+    auto subBucket = static_cast<uint64_t>(bucketIndex % kSubBucketsCount);
+    auto lowerBound = (static_cast<uint64_t>(kSubBucketsCount) + subBucket) << shift;
+
+    return lowerBound + (static_cast<uint64_t>(1) << shift) - 1;
+}
+
+} // namespace Valdi
@@ -0,0 +1,61 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Valdi {
+
+/**
+ * A fixed size latency histogram with HDR style log-linear buckets: every power of two range of
+ * microseconds is split into kSubBucketsCount linear sub buckets, which bounds the relative error
+ * of any reported value to 1/kSubBucketsCount. Latencies up to about an hour are covered.
+ *
+ * Recording a value is O(1) and never allocates, making it cheap enough to be always enabled.
+ * The histogram is not thread safe.
+ */
+class LatencyHistogram {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    static constexpr size_t kSubBucketsBits = 3;
+    static constexpr size_t kSubBucketsCount = static_cast<size_t>(1) << kSubBucketsBits;
+    static constexpr size_t kMaxMagnitude = 32;
+    static constexpr size_t kBucketsCount = (kMaxMagnitude - kSubBucketsBits + 1) * kSubBucketsCount;
+
+    LatencyHistogram();
+
+    void record(Duration duration);
+    void recordMicroseconds(uint64_t microseconds);
+
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    bool empty() const;
+    uint64_t getCount() const;
+
+    std::chrono::microseconds getMin() const;
+    std::chrono::microseconds getMax() const;
+    std::chrono::microseconds getMean() const;
+
+    /**
+     * Returns an upper bound of the value below which the given percentage of the recorded
+     * values fall. percentile is between 0 and 100.
+     */
+    std::chrono::microseconds getValueAtPercentile(double percentile) const;
+
+    static size_t getBucketIndex(uint64_t microseconds);
+    static uint64_t getBucketUpperBound(size_t bucketIndex);
+
+private:
+    std::array<uint32_t, kBucketsCount> _buckets;
+    uint64_t _count = 0;
+    uint64_t _sum = 0;
+    uint64_t _min = 0;
+    uint64_t _max = 0;
+};
+
+} // namespace Valdi
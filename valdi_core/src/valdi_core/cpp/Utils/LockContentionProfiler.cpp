@@ -0,0 +1,143 @@
+//
+//  LockContentionProfiler.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/LockContentionProfiler.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+
+#include <cstring>
+#include <functional>
+
+namespace Valdi {
+
+uint64_t LockContentionSummary::getContendedAcquiresCount() const {
+    return waitTimes.getCount();
+}
+
+void LockContentionSummary::reset() {
+    period = std::chrono::steady_clock::duration::zero();
+    waitTimes.reset();
+    holdTimes.reset();
+    waitingThreads.clear();
+}
+
+LockContentionSite::LockContentionSite(const char* name)
+    : _name(name), _lastCollectTime(std::chrono::steady_clock::now()) {}
+
+const char* LockContentionSite::getName() const {
+    return _name;
+}
+
+void LockContentionSite::recordContendedAcquire(std::chrono::steady_clock::duration waitTime) {
+    auto threadId = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _summary.waitTimes.record(waitTime);
+    _summary.waitingThreads[threadId]++;
+}
+
+void LockContentionSite::recordContendedHold(std::chrono::steady_clock::duration holdTime) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _summary.holdTimes.record(holdTime);
+}
+
+LockContentionSummary LockContentionSite::collect(std::chrono::steady_clock::time_point currentTime) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto summary = _summary;
+    summary.period = currentTime - _lastCollectTime;
+    _lastCollectTime = currentTime;
+    _summary.reset();
+    return summary;
+}
+
+LockContentionProfiler::LockContentionProfiler() = default;
+LockContentionProfiler::~LockContentionProfiler() = default;
+
+void LockContentionProfiler::setEnabled(bool enabled) {
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+LockContentionSite* LockContentionProfiler::getSite(const char* name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto* site : _sites) {
+        if (std::strcmp(site->getName(), name) == 0) {
+            return site;
+        }
+    }
+
+    // Sites are never freed, as the locks referencing them can be destroyed at any point during teardown
+    auto* site = new LockContentionSite(name);
+    _sites.emplace_back(site);
+    return site;
+}
+
+std::vector<std::pair<std::string_view, LockContentionSummary>> LockContentionProfiler::collect() {
+    std::vector<LockContentionSite*> sites;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        sites = _sites;
+    }
+
+    auto currentTime = std::chrono::steady_clock::now();
+    std::vector<std::pair<std::string_view, LockContentionSummary>> summaries;
+    for (auto* site : sites) {
+        auto summary = site->collect(currentTime);
+        if (summary.waitTimes.empty()) {
+            continue;
+        }
+        summaries.emplace_back(std::string_view(site->getName()), std::move(summary));
+    }
+
+    return summaries;
+}
+
+static Value histogramToValue(const LatencyHistogram& histogram) {
+    return Value()
+        .setMapValue("count", Value(static_cast<int64_t>(histogram.getCount())))
+        .setMapValue("mean_us", Value(static_cast<int64_t>(histogram.getMean().count())))
+        .setMapValue("p50_us", Value(static_cast<int64_t>(histogram.getValueAtPercentile(50).count())))
+        .setMapValue("p95_us", Value(static_cast<int64_t>(histogram.getValueAtPercentile(95).count())))
+        .setMapValue("p99_us", Value(static_cast<int64_t>(histogram.getValueAtPercentile(99).count())))
+        .setMapValue("max_us", Value(static_cast<int64_t>(histogram.getMax().count())));
+}
+
+Value LockContentionProfiler::toValue(
+    const std::vector<std::pair<std::string_view, LockContentionSummary>>& summaries) {
+    auto sites = ValueArray::make(summaries.size());
+    size_t index = 0;
+    for (const auto& it : summaries) {
+        const auto& summary = it.second;
+
+        auto threads = ValueArray::make(summary.waitingThreads.size());
+        size_t threadIndex = 0;
+        for (const auto& thread : summary.waitingThreads) {
+            threads->emplace(threadIndex++,
+                             Value()
+                                 .setMapValue("thread_id",
+                                              Value(static_cast<int64_t>(std::hash<std::thread::id>()(thread.first))))
+                                 .setMapValue("contended_acquires", Value(static_cast<int64_t>(thread.second))));
+        }
+
+        auto periodMs = std::chrono::duration_cast<std::chrono::milliseconds>(summary.period).count();
+        sites->emplace(index++,
+                       Value()
+                           .setMapValue("site", Value(StringCache::getGlobal().makeString(it.first)))
+                           .setMapValue("period_ms", Value(static_cast<int64_t>(periodMs)))
+                           .setMapValue("wait_times", histogramToValue(summary.waitTimes))
+                           .setMapValue("hold_times", histogramToValue(summary.holdTimes))
+                           .setMapValue("waiting_threads", Value(threads)));
+    }
+
+    return Value().setMapValue("sites", Value(sites));
+}
+
+LockContentionProfiler& LockContentionProfiler::shared() {
+    static auto* kInstance = new LockContentionProfiler();
+    return *kInstance;
+}
+
+} // namespace Valdi
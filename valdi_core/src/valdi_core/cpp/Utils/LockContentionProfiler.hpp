@@ -0,0 +1,112 @@
+//
+//  LockContentionProfiler.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "utils/base/NonCopyable.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/LatencyHistogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Valdi {
+
+class Value;
+
+/**
+ * The contention recorded on a lock site over a collection period.
+ */
+struct LockContentionSummary {
+    std::chrono::steady_clock::duration period;
+    // Time spent waiting for the lock, for the acquires which could not take it right away
+    LatencyHistogram waitTimes;
+    // Time the lock was held after a contended acquire
+    LatencyHistogram holdTimes;
+    // Number of contended acquires per waiting thread
+    FlatMap<std::thread::id, uint64_t> waitingThreads;
+
+    uint64_t getContendedAcquiresCount() const;
+
+    void reset();
+};
+
+/**
+ * A named group of locks whose contention is recorded together. Sites are registered
+ * with the LockContentionProfiler and live for the duration of the process.
+ */
+class LockContentionSite : public snap::NonCopyable {
+public:
+    explicit LockContentionSite(const char* name);
+
+    const char* getName() const;
+
+    void recordContendedAcquire(std::chrono::steady_clock::duration waitTime);
+    void recordContendedHold(std::chrono::steady_clock::duration holdTime);
+
+    /**
+     * Returns the contention recorded since the last collect and resets it.
+     */
+    LockContentionSummary collect(std::chrono::steady_clock::time_point currentTime);
+
+private:
+    const char* _name;
+    // std::mutex on purpose, as a Valdi::Mutex could itself be a profiled lock
+    std::mutex _mutex;
+    std::chrono::steady_clock::time_point _lastCollectTime;
+    LockContentionSummary _summary;
+};
+
+/**
+ * An opt-in profiler recording how long threads wait for the named locks, and how long those locks
+ * are held once acquired after a wait. Only the contended acquires are timed: while enabled, an
+ * uncontended acquire of a profiled lock costs a relaxed load and a try lock.
+ *
+ * Locks opt in by being constructed with a site name, see Mutex and RecursiveMutex.
+ */
+class LockContentionProfiler : public snap::NonCopyable {
+public:
+    LockContentionProfiler();
+    ~LockContentionProfiler();
+
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the site for the given name, registering it if needed.
+     * The name must be a string literal.
+     */
+    LockContentionSite* getSite(const char* name);
+
+    /**
+     * Returns and resets the summaries of every site which recorded contention since the last collect.
+     */
+    std::vector<std::pair<std::string_view, LockContentionSummary>> collect();
+
+    /**
+     * Convert the given summaries into a Value suitable to be sent to the debugger.
+     */
+    static Value toValue(const std::vector<std::pair<std::string_view, LockContentionSummary>>& summaries);
+
+    static LockContentionProfiler& shared();
+
+private:
+    std::mutex _mutex;
+    std::vector<LockContentionSite*> _sites;
+
+    inline static std::atomic_bool _enabled = false;
+};
+
+} // namespace Valdi
@@ -7,6 +7,7 @@
 
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "utils/debugging/Assert.hpp"
+#include "valdi_core/cpp/Utils/LockContentionProfiler.hpp"
 
 namespace Valdi {
 
@@ -58,19 +59,48 @@ void MutexThreadChecker::assertNotLocked() {}
 #endif
 
 Mutex::Mutex() = default;
+Mutex::Mutex(const char* contentionSiteName)
+    : _contentionSite(LockContentionProfiler::shared().getSite(contentionSiteName)) {}
 Mutex::~Mutex() = default;
 
 void Mutex::lock() {
     _threadChecker.assertNotLocked();
-    _innerMutex.lock();
+    if (_contentionSite != nullptr && LockContentionProfiler::isEnabled()) {
+        lockProfiled();
+    } else {
+        _innerMutex.lock();
+    }
     _threadChecker.onLock();
 }
 
 void Mutex::unlock() {
     _threadChecker.onUnlock();
+    if (_contentionSite != nullptr) {
+        onUnlockProfiled();
+    }
     _innerMutex.unlock();
 }
 
+void Mutex::lockProfiled() {
+    if (_innerMutex.try_lock()) {
+        return;
+    }
+
+    auto waitStartTime = std::chrono::steady_clock::now();
+    _innerMutex.lock();
+    _contendedAcquireTime = std::chrono::steady_clock::now();
+    _contentionSite->recordContendedAcquire(_contendedAcquireTime - waitStartTime);
+}
+
+void Mutex::onUnlockProfiled() {
+    if (_contendedAcquireTime == std::chrono::steady_clock::time_point()) {
+        return;
+    }
+
+    _contentionSite->recordContendedHold(std::chrono::steady_clock::now() - _contendedAcquireTime);
+    _contendedAcquireTime = std::chrono::steady_clock::time_point();
+}
+
 void Mutex::assertIsLocked() {
     _threadChecker.assertIsLocked();
 }
@@ -80,24 +110,60 @@ void Mutex::onLockAcquired() {
 }
 
 RecursiveMutex::RecursiveMutex() = default;
+RecursiveMutex::RecursiveMutex(const char* contentionSiteName)
+    : _contentionSite(LockContentionProfiler::shared().getSite(contentionSiteName)) {}
 RecursiveMutex::~RecursiveMutex() = default;
 
 void RecursiveMutex::lock() {
-    _innerMutex.lock();
+    if (_contentionSite != nullptr) {
+        lockProfiled();
+    } else {
+        _innerMutex.lock();
+    }
     _threadChecker.onLockRefCounted();
 }
 
 void RecursiveMutex::unlock() {
     _threadChecker.onUnlockRefCounted();
+    if (_contentionSite != nullptr) {
+        onUnlockProfiled();
+    }
     _innerMutex.unlock();
 }
 
+void RecursiveMutex::lockProfiled() {
+    if (!LockContentionProfiler::isEnabled()) {
+        _innerMutex.lock();
+    } else if (!_innerMutex.try_lock()) {
+        // The try lock succeeds when the current thread already holds the lock,
+        // so only the acquires which waited for another thread get here.
+        auto waitStartTime = std::chrono::steady_clock::now();
+        _innerMutex.lock();
+        _contendedAcquireTime = std::chrono::steady_clock::now();
+        _contentionSite->recordContendedAcquire(_contendedAcquireTime - waitStartTime);
+    }
+    _profiledLockDepth++;
+}
+
+void RecursiveMutex::onUnlockProfiled() {
+    if (--_profiledLockDepth != 0 || _contendedAcquireTime == std::chrono::steady_clock::time_point()) {
+        return;
+    }
+
+    _contentionSite->recordContendedHold(std::chrono::steady_clock::now() - _contendedAcquireTime);
+    _contendedAcquireTime = std::chrono::steady_clock::time_point();
+}
+
 void RecursiveMutex::assertIsLocked() {
     _threadChecker.assertIsLocked();
 }
 
 std::unique_lock<std::mutex> ConditionVariable::toStdLock(std::unique_lock<Mutex>& lock) {
     if (lock.owns_lock()) {
+        if (lock.mutex()->_contentionSite != nullptr) {
+            // Waiting releases the lock, which ends the hold time
+            lock.mutex()->onUnlockProfiled();
+        }
         return std::unique_lock<std::mutex>(lock.release()->_innerMutex, std::adopt_lock_t());
     } else {
         return std::unique_lock<std::mutex>(lock.release()->_innerMutex, std::defer_lock_t());
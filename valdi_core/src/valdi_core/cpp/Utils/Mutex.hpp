@@ -8,6 +8,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -68,6 +69,8 @@ namespace Valdi {
 #define VALDI_STD_RELEASE(__mu__) // no-op
 #endif
 
+class LockContentionSite;
+
 class MutexThreadChecker {
 public:
     MutexThreadChecker();
@@ -91,12 +94,15 @@ private:
 
 /**
  A Mutex wrapper which asserts against deadlocks when compiled in debug.
+ A Mutex constructed with a contention site name has its contended acquires recorded
+ by the LockContentionProfiler while the profiler is enabled.
  */
 class VALDI_CAPABILITY("mutex") Mutex {
 public:
     friend class ConditionVariable;
 
     Mutex();
+    explicit Mutex(const char* contentionSiteName);
     ~Mutex();
 
     void lock() VALDI_ACQUIRE();
@@ -108,8 +114,13 @@ public:
 private:
     mutable std::mutex _innerMutex;
     MutexThreadChecker _threadChecker;
+    LockContentionSite* _contentionSite = nullptr;
+    // Set only when the lock was acquired after a contended wait
+    std::chrono::steady_clock::time_point _contendedAcquireTime;
 
     void onLockAcquired();
+    void lockProfiled();
+    void onUnlockProfiled();
 };
 
 /**
@@ -119,6 +130,7 @@ private:
 class VALDI_CAPABILITY("mutex") RecursiveMutex {
 public:
     RecursiveMutex();
+    explicit RecursiveMutex(const char* contentionSiteName);
     ~RecursiveMutex();
 
     void lock() VALDI_ACQUIRE();
@@ -130,6 +142,13 @@ public:
 private:
     mutable std::recursive_mutex _innerMutex;
     MutexThreadChecker _threadChecker;
+    LockContentionSite* _contentionSite = nullptr;
+    // Only maintained for the profiled mutexes, to record the hold time when the outermost lock is released
+    size_t _profiledLockDepth = 0;
+    std::chrono::steady_clock::time_point _contendedAcquireTime;
+
+    void lockProfiled();
+    void onUnlockProfiled();
 };
 
 /**
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "utils/base/NonCopyable.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
 #include <deque>
 #include <mutex>
 #include <utility>
@@ -107,6 +108,7 @@ public:
         std::lock_guard<std::mutex> lock(_mutex);
 
         if (_objects.empty()) {
+            AllocationProfiler::recordAllocation(AllocationSite::ObjectPool, sizeof(T));
             return ObjectPoolEntry<T, Cleanup>(factory(), this, cleanup);
         }
 
@@ -0,0 +1,50 @@
+//
+//  PerfCounters.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/PerfCounters.hpp"
+
+namespace Valdi {
+
+const char* perfCounterTypeToString(PerfCounterType type) {
+    switch (type) {
+        case PerfCounterType::ViewNodesCreated:
+            return "view_nodes_created";
+        case PerfCounterType::ViewsInflated:
+            return "views_inflated";
+        case PerfCounterType::AttributesApplied:
+            return "attributes_applied";
+        case PerfCounterType::BridgeCrossings:
+            return "bridge_crossings";
+        case PerfCounterType::Allocations:
+            return "allocations";
+        case PerfCounterType::LayoutPasses:
+            return "layout_passes";
+    }
+    return "unknown";
+}
+
+PerfCounterValues PerfCounterValues::since(const PerfCounterValues& snapshot) const {
+    PerfCounterValues out;
+    for (size_t i = 0; i < kPerfCounterTypesCount; i++) {
+        out.values[i] = values[i] - snapshot.values[i];
+    }
+    return out;
+}
+
+void PerfCounters::setEnabled(bool enabled) {
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+PerfCounterValues PerfCounters::current() {
+    PerfCounterValues out;
+    for (size_t i = 0; i < kPerfCounterTypesCount; i++) {
+        out.values[i] = _values[i].load(std::memory_order_relaxed);
+    }
+    return out;
+}
+
+} // namespace Valdi
@@ -0,0 +1,76 @@
+//
+//  PerfCounters.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Valdi {
+
+/**
+ * The units of work of the runtime which are counted by the PerfCounters.
+ */
+enum class PerfCounterType : uint8_t {
+    ViewNodesCreated = 0,
+    // Views created by a ViewFactory, views reused from a pool are not counted
+    ViewsInflated,
+    AttributesApplied,
+    // Crossings of the JS, native and platform bridges, in any direction
+    BridgeCrossings,
+    // Allocations counted by the AllocationProfiler, which must be enabled for them to be counted
+    Allocations,
+    // Layout calculations of a dirty view node tree
+    LayoutPasses,
+};
+
+constexpr size_t kPerfCounterTypesCount = static_cast<size_t>(PerfCounterType::LayoutPasses) + 1;
+
+const char* perfCounterTypeToString(PerfCounterType type);
+
+struct PerfCounterValues {
+    std::array<uint64_t, kPerfCounterTypesCount> values{};
+
+    uint64_t get(PerfCounterType type) const {
+        return values[static_cast<size_t>(type)];
+    }
+
+    /**
+     * Returns the work counted since the given snapshot of the same counters was taken.
+     */
+    PerfCounterValues since(const PerfCounterValues& snapshot) const;
+};
+
+/**
+ * Process wide counters of the work made by the runtime, across all threads. Meant for deterministic
+ * assertions on the amount of work of a scenario, like perf budgets in tests. While disabled, counting
+ * costs a relaxed load.
+ */
+class PerfCounters {
+public:
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled() {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    static inline void increment(PerfCounterType type, uint64_t count = 1) {
+        if (isEnabled()) {
+            _values[static_cast<size_t>(type)].fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    static PerfCounterValues current();
+
+private:
+    inline static std::atomic_bool _enabled = false;
+    inline static std::array<std::atomic<uint64_t>, kPerfCounterTypesCount> _values{};
+};
+
+} // namespace Valdi
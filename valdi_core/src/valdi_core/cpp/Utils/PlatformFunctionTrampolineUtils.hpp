@@ -3,6 +3,7 @@
 #pragma once
 
 #include "valdi_core/cpp/Threading/IDispatchQueue.hpp"
+#include "valdi_core/cpp/Utils/BridgeCrossings.hpp"
 #include "valdi_core/cpp/Utils/ResolvablePromise.hpp"
 #include "valdi_core/cpp/Utils/SmallVector.hpp"
 #include "valdi_core/cpp/Utils/Trace.hpp"
@@ -38,6 +39,7 @@ Value handleBridgeCall(const Ref<IDispatchQueue>& callQueue,
                        const ValueFunctionCallContext& callContext,
                        F&& doCall) {
     if (callQueue == nullptr) {
+        ScopedBridgeCrossing bridgeCrossing(BridgeCrossingType::NativeToPlatform);
         return doCall(self, callContext);
     } else {
         if (isPromiseReturnType) {
@@ -50,6 +52,7 @@ Value handleBridgeCall(const Ref<IDispatchQueue>& callQueue,
                 VALDI_TRACE_META("Valdi.workerCall", capturedCallContext.getFunctionIdentifier());
                 SimpleExceptionTracker exceptionTracker;
                 auto callContext = capturedCallContext.toCallContext(exceptionTracker);
+                ScopedBridgeCrossing bridgeCrossing(BridgeCrossingType::NativeToPlatform);
                 auto result = doCall(strongSelf.get(), callContext);
 
                 handleBridgeCallPromiseResult(callContext, promise, result);
@@ -63,6 +66,7 @@ Value handleBridgeCall(const Ref<IDispatchQueue>& callQueue,
                 VALDI_TRACE_META("Valdi.workerCall", capturedCallContext.getFunctionIdentifier());
                 SimpleExceptionTracker exceptionTracker;
                 auto callContext = capturedCallContext.toCallContext(exceptionTracker);
+                ScopedBridgeCrossing bridgeCrossing(BridgeCrossingType::NativeToPlatform);
                 doCall(strongSelf.get(), callContext);
             });
 
@@ -100,6 +100,20 @@ bool ReferenceTable::contains(SequenceID id) const {
     return entry.retainCount != 0 && entry.id == id;
 }
 
+bool ReferenceTable::releaseRef(SequenceID id) {
+    auto& entry = getEntry(id);
+    entry.retainCount--;
+
+    if (entry.retainCount > 0) {
+        return true;
+    }
+
+    entry.id = Valdi::SequenceID();
+    entry.tag = nullptr;
+    _sequence.releaseId(id);
+    return false;
+}
+
 ReferenceTableEntry& ReferenceTable::getEntry(SequenceID id) {
     auto index = toEntryIndex(id);
 
@@ -205,17 +219,16 @@ void ReferenceTable::WriteAccess::retainRef(SequenceID id) const {
 }
 
 bool ReferenceTable::WriteAccess::releaseRef(SequenceID id) const {
-    auto& entry = _table->getEntry(id);
-    entry.retainCount--;
+    return _table->releaseRef(id);
+}
 
-    if (entry.retainCount > 0) {
-        return true;
+void ReferenceTable::WriteAccess::releaseRefs(const std::vector<SequenceID>& ids,
+                                              std::vector<SequenceID>& expiredIds) const {
+    for (const auto& id : ids) {
+        if (!_table->releaseRef(id)) {
+            expiredIds.emplace_back(id);
+        }
     }
-
-    entry.id = Valdi::SequenceID();
-    entry.tag = nullptr;
-    _table->_sequence.releaseId(id);
-    return false;
 }
 
 bool ReferenceTable::WriteAccess::contains(SequenceID id) const {
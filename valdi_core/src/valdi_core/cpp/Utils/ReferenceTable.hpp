@@ -91,6 +91,12 @@ public:
          */
         bool releaseRef(SequenceID id) const;
 
+        /**
+         Release all the references with the given ids under the same lock.
+         The ids of the references which are no longer alive are appended to expiredIds.
+         */
+        void releaseRefs(const std::vector<SequenceID>& ids, std::vector<SequenceID>& expiredIds) const;
+
     private:
         std::unique_lock<std::shared_mutex> _sharedLock;
         std::unique_lock<std::mutex> _uniqueLock;
@@ -117,6 +123,7 @@ private:
     ReferenceTableEntry& getEntry(SequenceID id);
     const ReferenceTableEntry& getEntry(SequenceID id) const;
     bool contains(SequenceID id) const;
+    bool releaseRef(SequenceID id);
 
     size_t toEntryIndex(SequenceID id) const;
     static void checkEntry(SequenceID id, const ReferenceTableEntry& entry);
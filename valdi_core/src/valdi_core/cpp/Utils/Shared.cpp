@@ -32,11 +32,21 @@ NonAtomicRefCountable::NonAtomicRefCountable() : _retainCount(1) {}
 NonAtomicRefCountable::~NonAtomicRefCountable() = default;
 
 void NonAtomicRefCountable::unsafeRetainInner() {
+#ifdef DEBUG
+    auto guard = _threadAccessChecker.guard();
+#endif
     ++_retainCount;
 }
 
 void NonAtomicRefCountable::unsafeReleaseInner() {
-    auto result = --_retainCount;
+    long result;
+    {
+#ifdef DEBUG
+        // The guard must be released before the instance gets deleted
+        auto guard = _threadAccessChecker.guard();
+#endif
+        result = --_retainCount;
+    }
 
     if (result == 0) {
         delete this;
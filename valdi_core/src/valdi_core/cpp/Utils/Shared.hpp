@@ -8,6 +8,9 @@
 #pragma once
 
 #include "utils/debugging/Assert.hpp"
+#ifdef DEBUG
+#include "valdi_core/cpp/Threading/ThreadAccessChecker.hpp"
+#endif
 #include <atomic>
 #include <memory>
 #include <type_traits>
@@ -59,6 +62,10 @@ private:
  * that the instances from this class won't be shared between
  * threads. Please only consider this class if you've measured
  * that atomic ref counting is a bottleneck for your use case.
+ * Instances can move between threads, as long as they are never
+ * retained or released from two threads at the same time. In debug
+ * builds, retain and release go through a ThreadAccessChecker which
+ * aborts when it detects such concurrent accesses.
  */
 class NonAtomicRefCountable : public RefCountable {
 public:
@@ -72,6 +79,9 @@ public:
 
 private:
     long _retainCount;
+#ifdef DEBUG
+    ThreadAccessChecker _threadAccessChecker;
+#endif
 };
 
 /**
@@ -14,12 +14,18 @@
 
 #pragma clang diagnostic pop
 
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
+
 namespace Valdi {
 
+// Heap allocations made when a SmallVector outgrows its inline storage are counted by the AllocationProfiler
+template<typename T>
+using SmallVectorAllocator = ProfiledAllocator<T, AllocationSite::SmallVector>;
+
 template<typename T, std::size_t size>
-using SmallVector = boost::container::small_vector<T, size>;
+using SmallVector = boost::container::small_vector<T, size, SmallVectorAllocator<T>>;
 
 template<typename T>
-using SmallVectorBase = boost::container::small_vector_base<T>;
+using SmallVectorBase = boost::container::small_vector_base<T, SmallVectorAllocator<T>>;
 
 } // namespace Valdi
@@ -0,0 +1,287 @@
+//
+//  StartupTimeline.cpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#include "valdi_core/cpp/Utils/StartupTimeline.hpp"
+#include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/Value.hpp"
+#include "valdi_core/cpp/Utils/ValueArray.hpp"
+
+#include <algorithm>
+
+namespace Valdi {
+
+const char* startupSpanTypeToString(StartupSpanType type) {
+    switch (type) {
+        case StartupSpanType::RuntimeManagerInit:
+            return "runtime_manager_init";
+        case StartupSpanType::RuntimeInit:
+            return "runtime_init";
+        case StartupSpanType::JSEngineInit:
+            return "js_engine_init";
+        case StartupSpanType::BundleLoad:
+            return "bundle_load";
+        case StartupSpanType::ModuleEvaluation:
+            return "module_evaluation";
+        case StartupSpanType::RenderRequest:
+            return "render_request";
+        case StartupSpanType::Layout:
+            return "layout";
+        case StartupSpanType::Draw:
+            return "draw";
+    }
+    return "unknown";
+}
+
+const char* startupMilestoneToString(StartupMilestone milestone) {
+    switch (milestone) {
+        case StartupMilestone::FirstRenderRequest:
+            return "first_render_request";
+        case StartupMilestone::FirstLayout:
+            return "first_layout";
+        case StartupMilestone::FirstRender:
+            return "first_render";
+        case StartupMilestone::FirstDraw:
+            return "first_draw";
+    }
+    return "unknown";
+}
+
+static Value spanTypeToValue(StartupSpanType type) {
+    return Value(StringCache::getGlobal().makeString(std::string_view(startupSpanTypeToString(type))));
+}
+
+static int64_t toMicroseconds(std::chrono::steady_clock::duration duration) {
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+std::chrono::steady_clock::duration StartupTimelineReport::getCriticalPathTime(StartupSpanType type) const {
+    auto total = std::chrono::steady_clock::duration::zero();
+    for (size_t i = 0; i < criticalPath.size(); i++) {
+        if (spans[criticalPath[i]].type == type) {
+            total += criticalPathBlockingTimes[i];
+        }
+    }
+    return total;
+}
+
+Value StartupTimelineReport::toValue() const {
+    auto spansArray = ValueArray::make(spans.size());
+    for (size_t i = 0; i < spans.size(); i++) {
+        const auto& span = spans[i];
+        spansArray->emplace(i,
+                            Value()
+                                .setMapValue("type", spanTypeToValue(span.type))
+                                .setMapValue("name", Value(span.name))
+                                .setMapValue("start_us", Value(toMicroseconds(span.start)))
+                                .setMapValue("duration_us", Value(toMicroseconds(span.end - span.start))));
+    }
+
+    Value milestonesMap;
+    for (size_t i = 0; i < kStartupMilestonesCount; i++) {
+        if (milestones[i]) {
+            milestonesMap.setMapValue(startupMilestoneToString(static_cast<StartupMilestone>(i)),
+                                      Value(toMicroseconds(milestones[i].value())));
+        }
+    }
+
+    auto criticalPathArray = ValueArray::make(criticalPath.size());
+    for (size_t i = 0; i < criticalPath.size(); i++) {
+        const auto& span = spans[criticalPath[i]];
+        criticalPathArray->emplace(
+            i,
+            Value()
+                .setMapValue("span_index", Value(static_cast<int64_t>(criticalPath[i])))
+                .setMapValue("type", spanTypeToValue(span.type))
+                .setMapValue("name", Value(span.name))
+                .setMapValue("blocking_us", Value(toMicroseconds(criticalPathBlockingTimes[i]))));
+    }
+
+    Value criticalPathByType;
+    for (size_t i = 0; i < kStartupSpanTypesCount; i++) {
+        auto type = static_cast<StartupSpanType>(i);
+        auto time = getCriticalPathTime(type);
+        if (time != std::chrono::steady_clock::duration::zero()) {
+            criticalPathByType.setMapValue(startupSpanTypeToString(type), Value(toMicroseconds(time)));
+        }
+    }
+
+    return Value()
+        .setMapValue("first_frame_us", Value(toMicroseconds(firstFrameTime)))
+        .setMapValue("milestones", milestonesMap)
+        .setMapValue("spans", Value(spansArray))
+        .setMapValue("critical_path", Value(criticalPathArray))
+        .setMapValue("critical_path_by_type_us", criticalPathByType)
+        .setMapValue("unattributed_us", Value(toMicroseconds(unattributedTime)))
+        .setMapValue("dropped_spans", Value(static_cast<int64_t>(droppedSpansCount)));
+}
+
+StartupTimeline::StartupTimeline() = default;
+StartupTimeline::~StartupTimeline() = default;
+
+void StartupTimeline::start(std::chrono::steady_clock::time_point time) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_started) {
+        return;
+    }
+    _started = true;
+    _startTime = time;
+    _spans.reserve(kMaxSpans);
+    _recording.store(true, std::memory_order_relaxed);
+}
+
+void StartupTimeline::recordSpan(StartupSpanType type,
+                                 const StringBox& name,
+                                 std::chrono::steady_clock::time_point start,
+                                 std::chrono::steady_clock::time_point end) {
+    if (!isRecording()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isRecording()) {
+        return;
+    }
+    if (_spans.size() >= kMaxSpans) {
+        _droppedSpansCount++;
+        return;
+    }
+
+    auto relativeStart = std::max(start - _startTime, std::chrono::steady_clock::duration::zero());
+    auto relativeEnd = std::max(end - _startTime, relativeStart);
+    _spans.emplace_back(StartupSpan{type, name, relativeStart, relativeEnd});
+}
+
+void StartupTimeline::markMilestone(StartupMilestone milestone, std::chrono::steady_clock::time_point time) {
+    if (!isRecording()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto& milestoneTime = _milestones[static_cast<size_t>(milestone)];
+    if (!isRecording() || milestoneTime) {
+        return;
+    }
+
+    milestoneTime = {time - _startTime};
+
+    if (milestone == StartupMilestone::FirstDraw ||
+        (milestone == StartupMilestone::FirstRender && !_expectsFirstDraw)) {
+        complete(lock, milestoneTime.value());
+    }
+}
+
+void StartupTimeline::setExpectsFirstDraw(bool expectsFirstDraw) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _expectsFirstDraw = expectsFirstDraw;
+}
+
+void StartupTimeline::setCompletionCallback(StartupTimelineCompletionCallback completionCallback) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _completionCallback = std::move(completionCallback);
+    if (!_completionCallback || !_pendingReport) {
+        return;
+    }
+
+    auto report = std::move(_pendingReport.value());
+    _pendingReport = std::nullopt;
+    auto callback = _completionCallback;
+    lock.unlock();
+
+    callback(report);
+}
+
+void StartupTimeline::complete(std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::duration firstFrameTime) {
+    _recording.store(false, std::memory_order_relaxed);
+
+    auto report = makeReport(std::move(_spans), firstFrameTime);
+    report.milestones = _milestones;
+    report.droppedSpansCount = _droppedSpansCount;
+    _spans = {};
+
+    if (!_completionCallback) {
+        _pendingReport = std::move(report);
+        return;
+    }
+
+    auto callback = _completionCallback;
+    lock.unlock();
+
+    callback(report);
+}
+
+StartupTimelineReport StartupTimeline::makeReport(std::vector<StartupSpan> spans,
+                                                  std::chrono::steady_clock::duration firstFrameTime) {
+    std::stable_sort(spans.begin(), spans.end(), [](const StartupSpan& left, const StartupSpan& right) {
+        return left.start < right.start;
+    });
+
+    StartupTimelineReport report;
+    report.spans = std::move(spans);
+    report.firstFrameTime = firstFrameTime;
+
+    // Walk backward from the first frame, picking at each step the span which ended last before the cursor.
+    // Spans still running at the cursor are clipped to it, so that an enclosing span is attributed the time
+    // before the spans it contains. On equal ends the innermost span wins.
+    std::vector<bool> visited(report.spans.size(), false);
+    auto cursor = firstFrameTime;
+    for (;;) {
+        std::optional<size_t> blockingIndex;
+        auto blockingEnd = std::chrono::steady_clock::duration::zero();
+
+        for (size_t i = 0; i < report.spans.size(); i++) {
+            const auto& span = report.spans[i];
+            if (visited[i] || span.start >= cursor) {
+                continue;
+            }
+
+            auto end = std::min(span.end, cursor);
+            if (!blockingIndex || end > blockingEnd ||
+                (end == blockingEnd && span.start > report.spans[blockingIndex.value()].start)) {
+                blockingIndex = {i};
+                blockingEnd = end;
+            }
+        }
+
+        if (!blockingIndex) {
+            break;
+        }
+
+        const auto& blockingSpan = report.spans[blockingIndex.value()];
+        visited[blockingIndex.value()] = true;
+        report.unattributedTime += cursor - blockingEnd;
+        report.criticalPath.emplace_back(blockingIndex.value());
+        report.criticalPathBlockingTimes.emplace_back(blockingEnd - blockingSpan.start);
+        cursor = blockingSpan.start;
+    }
+
+    report.unattributedTime += cursor;
+    std::reverse(report.criticalPath.begin(), report.criticalPath.end());
+    std::reverse(report.criticalPathBlockingTimes.begin(), report.criticalPathBlockingTimes.end());
+
+    return report;
+}
+
+StartupTimeline& StartupTimeline::shared() {
+    static auto* kInstance = new StartupTimeline();
+    return *kInstance;
+}
+
+ScopedStartupSpan::ScopedStartupSpan(StartupSpanType type, const StringBox& name)
+    : _type(type), _recording(StartupTimeline::shared().isRecording()) {
+    if (_recording) {
+        _name = name;
+        _startTime = std::chrono::steady_clock::now();
+    }
+}
+
+ScopedStartupSpan::~ScopedStartupSpan() {
+    if (_recording) {
+        StartupTimeline::shared().recordSpan(_type, _name, _startTime, std::chrono::steady_clock::now());
+    }
+}
+
+} // namespace Valdi
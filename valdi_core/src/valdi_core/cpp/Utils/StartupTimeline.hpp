@@ -0,0 +1,191 @@
+//
+//  StartupTimeline.hpp
+//  valdi
+//
+//  Created by Simon Corsin on 10/14/26.
+//
+
+#pragma once
+
+#include "utils/base/NonCopyable.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/StringBox.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Valdi {
+
+class Value;
+
+/**
+ * The kinds of work which are timed while the process starts.
+ */
+enum class StartupSpanType : uint8_t {
+    // From the creation of the RuntimeManager until the platform reports it as initialized
+    RuntimeManagerInit = 0,
+    // From the creation of a Runtime until the platform reports it as initialized
+    RuntimeInit,
+    // Creation and initialization of a JS context, including the runtime bindings
+    JSEngineInit,
+    // Load of a module archive, named after the module
+    BundleLoad,
+    // Evaluation of a JS module, named after its import path
+    ModuleEvaluation,
+    // Processing of a render request, named after the module of the Context
+    RenderRequest,
+    // Layout calculation of a view node tree, named after the module of the tree
+    Layout,
+    // Draw and commit of a batch of snap_drawing frames
+    Draw,
+};
+
+constexpr size_t kStartupSpanTypesCount = static_cast<size_t>(StartupSpanType::Draw) + 1;
+
+const char* startupSpanTypeToString(StartupSpanType type);
+
+/**
+ * Points in time which are only recorded the first time they are reached.
+ */
+enum class StartupMilestone : uint8_t {
+    FirstRenderRequest = 0,
+    FirstLayout,
+    // The first render request of a Context was applied to its view node tree
+    FirstRender,
+    // The first frame was drawn and committed by snap_drawing
+    FirstDraw,
+};
+
+constexpr size_t kStartupMilestonesCount = static_cast<size_t>(StartupMilestone::FirstDraw) + 1;
+
+const char* startupMilestoneToString(StartupMilestone milestone);
+
+struct StartupSpan {
+    StartupSpanType type;
+    StringBox name;
+    // Times are relative to the start of the timeline
+    std::chrono::steady_clock::duration start;
+    std::chrono::steady_clock::duration end;
+};
+
+/**
+ * The startup of the process up to its first frame, along with the spans which blocked that frame.
+ */
+struct StartupTimelineReport {
+    // Sorted by start time
+    std::vector<StartupSpan> spans;
+    std::array<std::optional<std::chrono::steady_clock::duration>, kStartupMilestonesCount> milestones;
+    std::chrono::steady_clock::duration firstFrameTime = std::chrono::steady_clock::duration::zero();
+
+    // Indexes in spans of the spans on the critical path to the first frame, in chronological order
+    std::vector<size_t> criticalPath;
+    // For each span of the critical path, how long it delayed the first frame
+    std::vector<std::chrono::steady_clock::duration> criticalPathBlockingTimes;
+    // Time on the critical path which no span accounts for
+    std::chrono::steady_clock::duration unattributedTime = std::chrono::steady_clock::duration::zero();
+
+    // Spans which were not recorded because the timeline was full
+    size_t droppedSpansCount = 0;
+
+    std::chrono::steady_clock::duration getCriticalPathTime(StartupSpanType type) const;
+
+    /**
+     * Convert the report into a Value suitable to be sent to the debugger.
+     */
+    Value toValue() const;
+};
+
+using StartupTimelineCompletionCallback = Valdi::Function<void(const StartupTimelineReport&)>;
+
+/**
+ * Records the milestones and spans of the process startup, from the creation of the RuntimeManager
+ * until the first frame, and reports them once with the critical path which led to that frame.
+ *
+ * The first frame is the first snap_drawing draw when a snap_drawing runtime expects to draw,
+ * the first render of a Context otherwise. Once the timeline is complete, recording a span
+ * costs a relaxed load.
+ */
+class StartupTimeline : public snap::NonCopyable {
+public:
+    StartupTimeline();
+    ~StartupTimeline();
+
+    /**
+     * Start the timeline at the given time. Only the first call has an effect.
+     */
+    void start(std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now());
+
+    bool isRecording() const {
+        return _recording.load(std::memory_order_relaxed);
+    }
+
+    void recordSpan(StartupSpanType type,
+                    const StringBox& name,
+                    std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end);
+
+    void markMilestone(StartupMilestone milestone,
+                       std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now());
+
+    /**
+     * Set whether the first frame is to be drawn by snap_drawing, in which case the timeline
+     * completes on the first draw instead of the first render.
+     */
+    void setExpectsFirstDraw(bool expectsFirstDraw);
+
+    /**
+     * Set the callback invoked with the report once the timeline completes. The callback is invoked
+     * right away if the timeline already completed without being reported.
+     */
+    void setCompletionCallback(StartupTimelineCompletionCallback completionCallback);
+
+    /**
+     * Build the report of the given spans, computing the critical path which ended at firstFrameTime.
+     * Going backward from the first frame, the span ending last before each point in time is assumed
+     * to have blocked what came after it.
+     */
+    static StartupTimelineReport makeReport(std::vector<StartupSpan> spans,
+                                            std::chrono::steady_clock::duration firstFrameTime);
+
+    static StartupTimeline& shared();
+
+    static constexpr size_t kMaxSpans = 512;
+
+private:
+    std::mutex _mutex;
+    std::atomic_bool _recording = false;
+    bool _started = false;
+    bool _expectsFirstDraw = false;
+    std::optional<StartupTimelineReport> _pendingReport;
+    StartupTimelineCompletionCallback _completionCallback;
+    std::chrono::steady_clock::time_point _startTime;
+    std::vector<StartupSpan> _spans;
+    std::array<std::optional<std::chrono::steady_clock::duration>, kStartupMilestonesCount> _milestones;
+    size_t _droppedSpansCount = 0;
+
+    void complete(std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::duration firstFrameTime);
+};
+
+/**
+ * Records a span on the shared StartupTimeline for the lifetime of the object,
+ * if the timeline is recording when the object is created.
+ */
+class ScopedStartupSpan : public snap::NonCopyable {
+public:
+    explicit ScopedStartupSpan(StartupSpanType type, const StringBox& name = StringBox());
+    ~ScopedStartupSpan();
+
+private:
+    StartupSpanType _type;
+    bool _recording;
+    StringBox _name;
+    std::chrono::steady_clock::time_point _startTime;
+};
+
+} // namespace Valdi
@@ -10,6 +10,7 @@
 #include "valdi_core/cpp/Attributes/AttributeUtils.hpp"
 #include "valdi_core/cpp/Utils/AutoMalloc.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include "valdi_core/cpp/Utils/StringHash.hpp"
 #include <charconv>
 #include <fmt/ostream.h>
 #include <sstream>
@@ -176,12 +177,7 @@ size_t StringBox::makeHash(const char* str, size_t len) noexcept {
 }
 
 size_t StringBox::makeHash(const std::string_view& str) noexcept {
-    if (str.empty()) {
-        // Keeping 0 as hash for empty string to make them equals to null strings
-        return 0;
-    }
-
-    return std::hash<std::string_view>()(str);
+    return hashString(str);
 }
 
 size_t StringBox::makeHash(const char16_t* str, size_t len) noexcept {
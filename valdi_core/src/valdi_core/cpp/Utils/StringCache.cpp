@@ -56,21 +56,29 @@ StringBox StringCache::makeString(std::string_view strView) noexcept {
         return StringBox();
     }
 
-    auto hash = StringBox::makeHash(strView);
+    return makeStringWithHash(strView, StringBox::makeHash(strView));
+}
+
+StringBox StringCache::makeStringWithHash(std::string_view strView, size_t hash) noexcept {
+    if (strView.empty()) {
+        return StringBox();
+    }
+
+    auto& shard = getShard(hash);
 
-    std::lock_guard<Mutex> guard(_mutex);
+    std::lock_guard<Mutex> guard(shard.mutex);
 
-    const auto& it = findEntry(strView, hash);
-    if (it != _table.end()) {
+    const auto& it = findEntry(shard, strView, hash);
+    if (it != shard.table.end()) {
         auto locked = it->impl->lock();
         if (locked != nullptr) {
             return StringBox(Ref<InternedStringImpl>(std::move(locked)));
         } else {
-            _table.erase(it);
+            shard.table.erase(it);
         }
     }
 
-    return insertString(strView, hash);
+    return insertString(shard, strView, hash);
 }
 
 StringBox StringCache::makeStringFromUTF16(const char16_t* utf16String, size_t len) noexcept {
@@ -87,45 +95,63 @@ StringBox StringCache::makeStringFromCLiteral(const char* cStr) noexcept {
     return getGlobal().makeStringFromLiteral(cStr);
 }
 
-StringBox StringCache::insertString(std::string_view str, size_t hash) {
+StringBox StringCache::makeStringFromCLiteral(const StringLiteral& literal) noexcept {
+    return getGlobal().makeStringWithHash(literal.getStringView(), literal.getHash());
+}
+
+StringCache::Shard& StringCache::getShard(size_t hash) {
+    // The table mixes the hash and probes from its low bits, so the shard is selected
+    // from the high bits of the mixed hash to keep both independent.
+    auto mixedHash = makePHMapHash(hash);
+    return _shards[mixedHash >> (sizeof(size_t) * 8 - kShardCountBits)];
+}
+
+StringBox StringCache::insertString(Shard& shard, std::string_view str, size_t hash) {
     auto internedString = InternedStringImpl::make(str.data(), str.size(), hash);
 
-    _table.emplace(internedString.get());
+    shard.table.emplace(internedString.get());
 
     return StringBox(Ref<InternedStringImpl>(std::move(internedString)));
 }
 
 void StringCache::removeString(const InternedStringImpl* internedString) {
-    std::lock_guard<Mutex> guard(_mutex);
+    auto hash = internedString->getHash();
+    auto& shard = getShard(hash);
+
+    std::lock_guard<Mutex> guard(shard.mutex);
 
-    const auto& it = _table.find(internedString, makePHMapHash(internedString->getHash()));
-    if (it != _table.end()) {
-        _table.erase(it);
+    const auto& it = shard.table.find(internedString, makePHMapHash(hash));
+    if (it != shard.table.end()) {
+        shard.table.erase(it);
     }
 }
 
-std::unique_lock<Mutex> StringCache::lock() {
-    return std::unique_lock<Mutex>(_mutex);
+std::unique_lock<Mutex> StringCache::lock(std::string_view str) {
+    return std::unique_lock<Mutex>(getShard(StringBox::makeHash(str)).mutex);
 }
 
 std::vector<StringBox> StringCache::all() const {
     std::vector<StringBox> out;
 
-    std::lock_guard<Mutex> guard(_mutex);
-    out.reserve(_table.size());
+    for (const auto& shard : _shards) {
+        std::lock_guard<Mutex> guard(shard.mutex);
+        out.reserve(out.size() + shard.table.size());
 
-    for (const auto& it : _table) {
-        auto locked = it.impl->lock();
-        if (locked != nullptr) {
-            out.emplace_back(Ref<InternedStringImpl>(std::move(locked)));
+        for (const auto& it : shard.table) {
+            auto locked = it.impl->lock();
+            if (locked != nullptr) {
+                out.emplace_back(Ref<InternedStringImpl>(std::move(locked)));
+            }
         }
     }
 
     return out;
 }
 
-StringCache::StringTable::const_iterator StringCache::findEntry(const std::string_view& str, size_t hash) const {
-    return _table.find(str, makePHMapHash(hash));
+StringCache::StringTable::const_iterator StringCache::findEntry(const Shard& shard,
+                                                                const std::string_view& str,
+                                                                size_t hash) {
+    return shard.table.find(str, makePHMapHash(hash));
 }
 
 } // namespace Valdi
@@ -11,8 +11,12 @@
 #include "valdi_core/cpp/Utils/InternedStringImpl.hpp"
 #include "valdi_core/cpp/Utils/Mutex.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
+#include "valdi_core/cpp/Utils/StringHash.hpp"
 
-#define STRING_LITERAL(str) Valdi::StringCache::makeStringFromCLiteral(str)
+#include <array>
+#include <type_traits>
+
+#define STRING_LITERAL(str) Valdi::StringCache::makeStringFromCLiteral(Valdi::StringLiteral(str))
 #define STRING_FORMAT(__format, ...) Valdi::StringCache::getGlobal().makeString(fmt::format((__format), __VA_ARGS__))
 
 #define STRING_CONST(name, str)                                                                                        \
@@ -39,6 +43,36 @@ static inline std::string_view convertInline(const std::string_view& str) {
     return str;
 }
 
+/**
+ Argument of STRING_LITERAL. When given a string literal, its length and hash are
+ computed at compile time so that interning it only costs the table lookup.
+ Any other C string is measured and hashed at runtime.
+ */
+class StringLiteral {
+public:
+    template<size_t N>
+    consteval StringLiteral(const char (&str)[N]) noexcept // NOLINT(google-explicit-constructor)
+        : _str(str, std::char_traits<char>::length(str)), _hash(hashString(_str)) {}
+
+    template<typename T,
+             std::enable_if_t<!std::is_array_v<std::remove_reference_t<T>> && std::is_convertible_v<T, const char*>,
+                              int> = 0>
+    StringLiteral(T&& str) noexcept // NOLINT(google-explicit-constructor)
+        : _str(static_cast<const char*>(str)), _hash(hashString(_str)) {}
+
+    constexpr std::string_view getStringView() const noexcept {
+        return _str;
+    }
+
+    constexpr size_t getHash() const noexcept {
+        return _hash;
+    }
+
+private:
+    std::string_view _str;
+    size_t _hash;
+};
+
 struct StringCacheEntry {
     InternedStringImpl* impl;
 
@@ -82,15 +116,22 @@ public:
      */
     StringBox makeString(std::string_view strView) noexcept;
 
+    /**
+     Returns a string from the given string view, using a hash previously
+     computed with StringBox::makeHash().
+     */
+    StringBox makeStringWithHash(std::string_view strView, size_t hash) noexcept;
+
     /**
      Make a string given the given utf16 string.
      */
     StringBox makeStringFromUTF16(const char16_t* utf16String, size_t len) noexcept;
 
     /**
-     Exposed for tests only, DO NOT USE
+     Exposed for tests only, DO NOT USE.
+     Locks the shard of the string table which holds the given string.
      */
-    std::unique_lock<Mutex> lock();
+    std::unique_lock<Mutex> lock(std::string_view str);
 
     /**
      Returns all of the strings inside the StringCache
@@ -101,24 +142,39 @@ public:
 
     // Shortcut for getGlobal().makeStringFromLiteral()
     static StringBox makeStringFromCLiteral(const char* cStr) noexcept;
+    static StringBox makeStringFromCLiteral(const StringLiteral& literal) noexcept;
 
 private:
     using StringTable =
         phmap::flat_hash_set<StringCacheEntry, StringCacheHash, StringCacheEqual, phmap::Allocator<StringCacheEntry>>;
 
-    StringTable _table;
-    mutable Mutex _mutex;
+    /**
+     The table is split into shards selected by the string hash, each with their own lock,
+     so that threads interning different strings don't contend on a single mutex.
+     Shards are aligned so that their locks don't share a cache line.
+     */
+    struct alignas(64) Shard {
+        StringTable table;
+        mutable Mutex mutex{"StringCache"};
+    };
+
+    static constexpr size_t kShardCountBits = 4;
+    static constexpr size_t kShardCount = static_cast<size_t>(1) << kShardCountBits;
+
+    std::array<Shard, kShardCount> _shards;
 
     StringCache();
 
-    // Should be called with a lock already acquired
-    StringBox insertString(std::string_view str, size_t hash);
+    Shard& getShard(size_t hash);
+
+    // Should be called with the lock of the shard already acquired
+    static StringBox insertString(Shard& shard, std::string_view str, size_t hash);
     // Should be called without a lock
     void removeString(const InternedStringImpl* internedString);
 
     friend InternedStringImpl;
 
-    StringTable::const_iterator findEntry(const std::string_view& str, size_t hash) const;
+    static StringTable::const_iterator findEntry(const Shard& shard, const std::string_view& str, size_t hash);
 };
 
 } // namespace Valdi
@@ -0,0 +1,59 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Valdi {
+
+/**
+ * MurmurHash64A, written so that it can be evaluated at compile time.
+ * Used as the hash of interned strings, which allows STRING_LITERAL to hash
+ * its literal during compilation. Bytes are assembled in little endian order
+ * which compilers turn into a single load at runtime.
+ */
+constexpr size_t hashString(std::string_view str) noexcept {
+    if (str.empty()) {
+        // Keeping 0 as hash for empty string to make them equals to null strings
+        return 0;
+    }
+
+    constexpr uint64_t kMultiplier = 0xc6a4a7935bd1e995ULL;
+    constexpr int kShift = 47;
+    constexpr uint64_t kSeed = 0xc70f6907ULL;
+
+    const auto length = str.size();
+    uint64_t hash = kSeed ^ (static_cast<uint64_t>(length) * kMultiplier);
+
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t k = 0;
+        for (size_t j = 0; j < 8; j++) {
+            k |= static_cast<uint64_t>(static_cast<uint8_t>(str[i + j])) << (j * 8);
+        }
+
+        k *= kMultiplier;
+        k ^= k >> kShift;
+        k *= kMultiplier;
+
+        hash ^= k;
+        hash *= kMultiplier;
+    }
+
+    if (i < length) {
+        for (size_t j = 0; i + j < length; j++) {
+            hash ^= static_cast<uint64_t>(static_cast<uint8_t>(str[i + j])) << (j * 8);
+        }
+        hash *= kMultiplier;
+    }
+
+    hash ^= hash >> kShift;
+    hash *= kMultiplier;
+    hash ^= hash >> kShift;
+
+    return static_cast<size_t>(hash);
+}
+
+} // namespace Valdi
@@ -7,6 +7,7 @@
 
 #include "valdi_core/cpp/Utils/TextParser.hpp"
 #include "valdi_core/cpp/Utils/StringCache.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <fmt/format.h>
 
@@ -64,11 +65,12 @@ bool TextParser::skip() {
 }
 
 bool TextParser::skipCount(size_t count) {
-    for (size_t i = 0; i < count; i++) {
-        if (!skip()) {
-            return false;
-        }
+    if (count > _str.size() - std::min(_position, _str.size())) {
+        _position = _str.size();
+        return ensureNotAtEnd();
     }
+
+    _position += count;
     return true;
 }
 
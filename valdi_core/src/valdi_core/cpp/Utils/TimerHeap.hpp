@@ -0,0 +1,279 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "utils/debugging/Assert.hpp"
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Valdi {
+
+/**
+ * Handle to an item inserted in a TimerHeap. Handles stay valid until the item
+ * is popped or removed, and are never reused for another item.
+ */
+struct TimerHeapHandle {
+    uint32_t slot = 0;
+    uint32_t generation = 0;
+
+    constexpr TimerHeapHandle() = default;
+    constexpr TimerHeapHandle(uint32_t slot, uint32_t generation) : slot(slot), generation(generation) {}
+
+    constexpr bool isNull() const {
+        return generation == 0;
+    }
+
+    constexpr bool operator==(const TimerHeapHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+
+    constexpr bool operator!=(const TimerHeapHandle& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * A binary min-heap of items ordered by deadline with index tracking,
+ * so that items can be removed through their handle without scanning.
+ * Items with the same deadline are returned in insertion order.
+ *
+ * insert(), remove() and pop() are O(log n), peeking at the next deadline is O(1).
+ * The heap itself only stores the deadlines and slot indexes so that sifting
+ * does not touch the items.
+ */
+template<typename Time, typename T>
+class TimerHeap {
+public:
+    TimerHeap() = default;
+    TimerHeap(const TimerHeap& other) = delete;
+    TimerHeap(TimerHeap&& other) noexcept = default;
+    TimerHeap& operator=(const TimerHeap& other) = delete;
+    TimerHeap& operator=(TimerHeap&& other) noexcept = default;
+
+    /**
+     * Insert an item which expires at the given time, returns a handle
+     * which can be used to remove the item later.
+     */
+    TimerHeapHandle insert(Time time, T item) {
+        return insert(time, ++_sequence, std::move(item));
+    }
+
+    /**
+     * Insert an item with a caller provided sequence used to order items
+     * with the same deadline. The sequence must be unique.
+     */
+    TimerHeapHandle insert(Time time, uint64_t sequence, T item) {
+        uint32_t slotIndex;
+        if (_freeSlots.empty()) {
+            slotIndex = static_cast<uint32_t>(_slots.size());
+            _slots.emplace_back();
+        } else {
+            slotIndex = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+
+        auto& slot = _slots[slotIndex];
+        slot.generation = nextGeneration(slot.generation);
+        slot.item.emplace(std::move(item));
+
+        auto heapIndex = _heap.size();
+        _heap.emplace_back(HeapEntry{time, sequence, slotIndex});
+        slot.heapIndex = static_cast<uint32_t>(heapIndex);
+        siftUp(heapIndex);
+
+        return TimerHeapHandle(slotIndex, slot.generation);
+    }
+
+    /**
+     * Remove the item associated with the given handle. Returns the removed item,
+     * or an empty optional if the handle is no longer valid.
+     */
+    std::optional<T> remove(const TimerHeapHandle& handle) {
+        auto* slot = getSlot(handle);
+        if (slot == nullptr) {
+            return std::nullopt;
+        }
+
+        auto heapIndex = static_cast<size_t>(slot->heapIndex);
+        auto item = std::move(slot->item);
+        releaseSlot(handle.slot);
+        removeHeapEntry(heapIndex);
+
+        return item;
+    }
+
+    bool contains(const TimerHeapHandle& handle) const {
+        return getSlot(handle) != nullptr;
+    }
+
+    T* get(const TimerHeapHandle& handle) {
+        auto* slot = getSlot(handle);
+        return slot != nullptr ? &(*slot->item) : nullptr;
+    }
+
+    bool empty() const {
+        return _heap.empty();
+    }
+
+    size_t size() const {
+        return _heap.size();
+    }
+
+    /**
+     * Returns the deadline of the earliest item. The heap must not be empty.
+     */
+    const Time& topTime() const {
+        SC_ASSERT(!_heap.empty());
+        return _heap.front().time;
+    }
+
+    T& top() {
+        SC_ASSERT(!_heap.empty());
+        return *_slots[_heap.front().slot].item;
+    }
+
+    const T& top() const {
+        SC_ASSERT(!_heap.empty());
+        return *_slots[_heap.front().slot].item;
+    }
+
+    TimerHeapHandle topHandle() const {
+        SC_ASSERT(!_heap.empty());
+        auto slotIndex = _heap.front().slot;
+        return TimerHeapHandle(slotIndex, _slots[slotIndex].generation);
+    }
+
+    /**
+     * Remove and return the earliest item. The heap must not be empty.
+     */
+    T pop() {
+        SC_ASSERT(!_heap.empty());
+        auto slotIndex = _heap.front().slot;
+        auto item = std::move(*_slots[slotIndex].item);
+        releaseSlot(slotIndex);
+        removeHeapEntry(0);
+
+        return item;
+    }
+
+    void clear() {
+        _heap.clear();
+        _freeSlots.clear();
+        for (uint32_t i = 0; i < static_cast<uint32_t>(_slots.size()); i++) {
+            if (_slots[i].item) {
+                _slots[i].item.reset();
+            }
+            _freeSlots.emplace_back(i);
+        }
+    }
+
+private:
+    struct HeapEntry {
+        Time time;
+        uint64_t sequence;
+        uint32_t slot;
+
+        bool isBefore(const HeapEntry& other) const {
+            if (time == other.time) {
+                return sequence < other.sequence;
+            }
+            return time < other.time;
+        }
+    };
+
+    struct Slot {
+        std::optional<T> item;
+        uint32_t heapIndex = 0;
+        uint32_t generation = 0;
+    };
+
+    std::vector<HeapEntry> _heap;
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeSlots;
+    uint64_t _sequence = 0;
+
+    static uint32_t nextGeneration(uint32_t generation) {
+        // 0 is reserved for null handles
+        auto next = generation + 1;
+        return next == 0 ? 1 : next;
+    }
+
+    const Slot* getSlot(const TimerHeapHandle& handle) const {
+        if (handle.isNull() || handle.slot >= _slots.size()) {
+            return nullptr;
+        }
+        const auto& slot = _slots[handle.slot];
+        if (slot.generation != handle.generation || !slot.item) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    Slot* getSlot(const TimerHeapHandle& handle) {
+        return const_cast<Slot*>(static_cast<const TimerHeap*>(this)->getSlot(handle));
+    }
+
+    void releaseSlot(uint32_t slotIndex) {
+        _slots[slotIndex].item.reset();
+        _freeSlots.emplace_back(slotIndex);
+    }
+
+    void removeHeapEntry(size_t heapIndex) {
+        auto lastIndex = _heap.size() - 1;
+        if (heapIndex != lastIndex) {
+            moveEntry(lastIndex, heapIndex);
+            _heap.pop_back();
+            if (heapIndex > 0 && _heap[heapIndex].isBefore(_heap[(heapIndex - 1) / 2])) {
+                siftUp(heapIndex);
+            } else {
+                siftDown(heapIndex);
+            }
+        } else {
+            _heap.pop_back();
+        }
+    }
+
+    void moveEntry(size_t from, size_t to) {
+        _heap[to] = _heap[from];
+        _slots[_heap[to].slot].heapIndex = static_cast<uint32_t>(to);
+    }
+
+    void siftUp(size_t index) {
+        auto entry = _heap[index];
+        while (index > 0) {
+            auto parent = (index - 1) / 2;
+            if (!entry.isBefore(_heap[parent])) {
+                break;
+            }
+            moveEntry(parent, index);
+            index = parent;
+        }
+        _heap[index] = entry;
+        _slots[entry.slot].heapIndex = static_cast<uint32_t>(index);
+    }
+
+    void siftDown(size_t index) {
+        auto size = _heap.size();
+        auto entry = _heap[index];
+        for (;;) {
+            auto child = index * 2 + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && _heap[child + 1].isBefore(_heap[child])) {
+                child++;
+            }
+            if (!_heap[child].isBefore(entry)) {
+                break;
+            }
+            moveEntry(child, index);
+            index = child;
+        }
+        _heap[index] = entry;
+        _slots[entry.slot].heapIndex = static_cast<uint32_t>(index);
+    }
+};
+
+} // namespace Valdi
@@ -6,8 +6,12 @@
 //
 
 #include "valdi_core/cpp/Utils/Trace.hpp"
+#include "valdi_core/cpp/Constants.hpp"
+#include "valdi_core/cpp/Utils/AllocationProfiler.hpp"
 #include "valdi_core/cpp/Utils/StringBox.hpp"
 
+#include <algorithm>
+
 namespace Valdi {
 
 std::string getTraceName(std::string_view prefix, const StringBox& suffix) {
@@ -47,7 +51,7 @@ ScopedTrace::ScopedTrace(std::string&& trace) : _trace(std::move(trace)), _snapT
 ScopedTrace::~ScopedTrace() {
     if (_startTime) {
         auto endTime = std::chrono::steady_clock::now();
-        Tracer::shared().append(std::move(_trace), _startTime.value(), endTime);
+        Tracer::shared().append(_trace, _startTime.value(), endTime);
     }
 
     end();
@@ -58,6 +62,7 @@ void ScopedTrace::begin() {
     traceBegin.name = _trace;
 
     _osEmitter.begin(traceBegin);
+    _previousAllocationTraceScope = AllocationProfiler::exchangeTraceScope(&_trace);
 }
 
 void ScopedTrace::end() {
@@ -65,9 +70,149 @@ void ScopedTrace::end() {
     traceEnd.name = _trace;
 
     _osEmitter.end(traceEnd);
+    AllocationProfiler::exchangeTraceScope(_previousAllocationTraceScope);
 }
 
-Tracer::Tracer() = default;
+// Number of traces each thread can hold before it starts overwriting its oldest traces.
+constexpr size_t kTraceThreadBufferCapacity = 8192;
+
+struct BufferedTrace {
+    TraceNameId nameId;
+    size_t recordingSequence;
+    TraceTimePoint start;
+    TraceTimePoint end;
+};
+
+/**
+ * Single producer ring buffer of traces owned by one thread. The owner thread appends without locking,
+ * the Tracer collects the appended traces while holding its mutex. The collector validates what it read
+ * against the claimed write position, so that slots which the owner overwrote concurrently are discarded.
+ */
+class TraceThreadBuffer : public SharedPtrRefCountable {
+public:
+    explicit TraceThreadBuffer(ThreadId threadId)
+        : _threadId(threadId), _slots(std::make_unique<Slot[]>(kTraceThreadBufferCapacity)) {}
+
+    ThreadId getThreadId() const {
+        return _threadId;
+    }
+
+    // Owner thread only
+    void append(TraceNameId nameId, size_t recordingSequence, const TraceTimePoint& start, const TraceTimePoint& end) {
+        auto position = _writePosition.load(std::memory_order_relaxed);
+        _claimedPosition.store(position + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& slot = _slots[position % kTraceThreadBufferCapacity];
+        slot.nameId.store(nameId, std::memory_order_relaxed);
+        slot.recordingSequence.store(recordingSequence, std::memory_order_relaxed);
+        slot.start.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+        slot.end.store(end.time_since_epoch().count(), std::memory_order_relaxed);
+
+        _writePosition.store(position + 1, std::memory_order_release);
+    }
+
+    /**
+     * Collect the traces appended since the last consume() at the end of the given output.
+     * Must be called with the Tracer mutex held.
+     */
+    void collect(std::vector<BufferedTrace>& output) {
+        auto end = _writePosition.load(std::memory_order_acquire);
+        auto begin = std::max(_readPosition, end > kTraceThreadBufferCapacity ? end - kTraceThreadBufferCapacity : 0);
+
+        auto outputStart = output.size();
+        for (auto position = begin; position < end; position++) {
+            const auto& slot = _slots[position % kTraceThreadBufferCapacity];
+            auto& trace = output.emplace_back();
+            trace.nameId = slot.nameId.load(std::memory_order_relaxed);
+            trace.recordingSequence = slot.recordingSequence.load(std::memory_order_relaxed);
+            trace.start = TraceTimePoint(TraceTimePoint::duration(slot.start.load(std::memory_order_relaxed)));
+            trace.end = TraceTimePoint(TraceTimePoint::duration(slot.end.load(std::memory_order_relaxed)));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto claimed = _claimedPosition.load(std::memory_order_relaxed);
+        auto firstValid = claimed > kTraceThreadBufferCapacity ? claimed - kTraceThreadBufferCapacity : 0;
+        if (firstValid > begin) {
+            // The owner lapped us while we were reading, the first slots might be torn
+            auto overwritten = std::min(firstValid, end) - begin;
+            output.erase(output.begin() + static_cast<std::ptrdiff_t>(outputStart),
+                         output.begin() + static_cast<std::ptrdiff_t>(outputStart + overwritten));
+            begin += overwritten;
+        }
+
+        _collectedBegin = begin;
+        _collectedEnd = end;
+    }
+
+    /**
+     * Release the collected traces until the first one recorded with or after the given sequence,
+     * which might still be needed by an active recorder. Must be called with the Tracer mutex held,
+     * with the traces returned by the last collect().
+     */
+    void consume(const BufferedTrace* collectedBegin, const BufferedTrace* collectedEnd, size_t untilSequence) {
+        auto readPosition = _collectedBegin;
+        for (const auto* it = collectedBegin; it != collectedEnd && it->recordingSequence < untilSequence; it++) {
+            readPosition++;
+        }
+        _readPosition = readPosition;
+    }
+
+    void consumeAll() {
+        _readPosition = _collectedEnd;
+    }
+
+    bool isOwnerAlive() const {
+        return _ownerAlive.load(std::memory_order_relaxed);
+    }
+
+    void setOwnerAlive(bool ownerAlive) {
+        _ownerAlive.store(ownerAlive, std::memory_order_relaxed);
+    }
+
+    // Owner thread only
+    FlatMap<std::string_view, TraceNameId>& getNameIdsCache() {
+        return _nameIdsCache;
+    }
+
+private:
+    struct Slot {
+        std::atomic<TraceNameId> nameId;
+        std::atomic<size_t> recordingSequence;
+        std::atomic<TraceTimePoint::rep> start;
+        std::atomic<TraceTimePoint::rep> end;
+    };
+
+    ThreadId _threadId;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<uint64_t> _writePosition = 0;
+    std::atomic<uint64_t> _claimedPosition = 0;
+    std::atomic_bool _ownerAlive = true;
+    uint64_t _readPosition = 0;
+    uint64_t _collectedBegin = 0;
+    uint64_t _collectedEnd = 0;
+    FlatMap<std::string_view, TraceNameId> _nameIdsCache;
+};
+
+namespace {
+
+struct CurrentThreadBuffer {
+    uint64_t tracerId = 0;
+    Ref<TraceThreadBuffer> buffer;
+
+    ~CurrentThreadBuffer() {
+        if (buffer != nullptr) {
+            buffer->setOwnerAlive(false);
+        }
+    }
+};
+
+} // namespace
+
+static thread_local CurrentThreadBuffer currentThreadBuffer;
+static std::atomic<uint64_t> tracerIdCounter = 0;
+
+Tracer::Tracer() : _tracerId(++tracerIdCounter) {}
 Tracer::~Tracer() = default;
 
 Tracer& Tracer::shared() {
@@ -75,13 +220,84 @@ Tracer& Tracer::shared() {
     return *kInstance;
 }
 
-void Tracer::append(std::string&& trace, const TraceTimePoint& start, const TraceTimePoint& end) {
+TraceThreadBuffer& Tracer::getCurrentThreadBuffer() {
+    if (VALDI_LIKELY(currentThreadBuffer.tracerId == _tracerId)) {
+        return *currentThreadBuffer.buffer;
+    }
+
+    auto threadId = getCurrentThreadId();
+
     std::lock_guard<std::mutex> lock(_mutex);
-    if (_recorders.empty()) {
+    Ref<TraceThreadBuffer> buffer;
+    for (const auto& threadBuffer : _threadBuffers) {
+        if (threadBuffer->getThreadId() == threadId) {
+            buffer = threadBuffer;
+            break;
+        }
+    }
+
+    if (buffer == nullptr) {
+        buffer = makeShared<TraceThreadBuffer>(threadId);
+        _threadBuffers.emplace_back(buffer);
+    } else {
+        buffer->setOwnerAlive(true);
+    }
+
+    if (currentThreadBuffer.buffer != nullptr) {
+        currentThreadBuffer.buffer->setOwnerAlive(false);
+    }
+    currentThreadBuffer.tracerId = _tracerId;
+    currentThreadBuffer.buffer = buffer;
+
+    return *buffer;
+}
+
+TraceNameId Tracer::internTraceName(std::string_view trace) {
+    std::lock_guard<std::mutex> lock(_namesMutex);
+    return lockFreeInternTraceName(trace);
+}
+
+TraceNameId Tracer::lockFreeInternTraceName(std::string_view trace) {
+    const auto& it = _nameIds.find(trace);
+    if (it != _nameIds.end()) {
+        return it->second;
+    }
+
+    auto nameId = static_cast<TraceNameId>(_names.size());
+    const auto& name = _names.emplace_back(trace);
+    _nameIds[std::string_view(name)] = nameId;
+
+    return nameId;
+}
+
+void Tracer::append(std::string_view trace, const TraceTimePoint& start, const TraceTimePoint& end) {
+    if (!_recording.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    auto& threadBuffer = getCurrentThreadBuffer();
+    auto& nameIdsCache = threadBuffer.getNameIdsCache();
+    TraceNameId nameId;
+
+    const auto& it = nameIdsCache.find(trace);
+    if (it != nameIdsCache.end()) {
+        nameId = it->second;
+    } else {
+        std::lock_guard<std::mutex> lock(_namesMutex);
+        nameId = lockFreeInternTraceName(trace);
+        // Keys point to the interned names, which live as long as the Tracer
+        nameIdsCache[std::string_view(_names[nameId])] = nameId;
+    }
+
+    threadBuffer.append(nameId, _recordingSequence.load(std::memory_order_relaxed), start, end);
+}
+
+void Tracer::append(TraceNameId traceNameId, const TraceTimePoint& start, const TraceTimePoint& end) {
+    if (!_recording.load(std::memory_order_relaxed)) {
         return;
     }
 
-    _pendingTraces.emplace_back(std::move(trace), start, end, getCurrentThreadId(), _recordingSequence);
+    getCurrentThreadBuffer().append(traceNameId, _recordingSequence.load(std::memory_order_relaxed), start, end);
 }
 
 size_t Tracer::startRecording() {
@@ -104,35 +320,64 @@ std::vector<RecordedTrace> Tracer::stopRecording(size_t recordingIdentifier) {
 
     _recorders.erase(it);
 
-    // Simple case, we only have one recorder we can return all the recorded traces
+    // Traces that occured before the lowest remaining recording identifier can be released,
+    // the ones after need to stay around for the remaining recorders.
+    size_t lowestRecordingIdentifier = 0;
     if (_recorders.empty()) {
         _recording = false;
-        return std::move(_pendingTraces);
+    } else {
+        lowestRecordingIdentifier = *std::min_element(_recorders.begin(), _recorders.end());
     }
 
-    // We still have one active recorder. We collect the traces that ocurreded with or after
-    // this identifier
-
-    std::vector<RecordedTrace> outTraces;
-
-    for (const auto& trace : _pendingTraces) {
-        if (trace.recordingSequence >= recordingIdentifier) {
-            outTraces.emplace_back(trace);
+    std::vector<BufferedTrace> collectedTraces;
+    std::vector<std::pair<ThreadId, size_t>> threadRanges;
+    threadRanges.reserve(_threadBuffers.size());
+
+    for (const auto& threadBuffer : _threadBuffers) {
+        auto offset = collectedTraces.size();
+        threadBuffer->collect(collectedTraces);
+        threadRanges.emplace_back(threadBuffer->getThreadId(), offset);
+
+        if (_recorders.empty()) {
+            threadBuffer->consumeAll();
+        } else {
+            threadBuffer->consume(collectedTraces.data() + offset,
+                                  collectedTraces.data() + collectedTraces.size(),
+                                  lowestRecordingIdentifier);
         }
     }
 
-    auto lowestRecordingIdentifier = *_recorders.begin();
-    if (lowestRecordingIdentifier > recordingIdentifier) {
-        // If the next lowest recording identifier is above the ending identifier,
-        // we might have dangling traces to remove.
-        // Remove all the traces that occured before the new lowest recording identifier.
-        auto newStartIt = _pendingTraces.begin();
-        while (newStartIt != _pendingTraces.end() && newStartIt->recordingSequence < lowestRecordingIdentifier) {
-            newStartIt++;
+    if (_recorders.empty()) {
+        // Buffers of threads which have exited won't receive new traces
+        _threadBuffers.erase(std::remove_if(_threadBuffers.begin(),
+                                            _threadBuffers.end(),
+                                            [](const auto& threadBuffer) { return !threadBuffer->isOwnerAlive(); }),
+                             _threadBuffers.end());
+    }
+
+    std::vector<RecordedTrace> outTraces;
+    outTraces.reserve(collectedTraces.size());
+
+    std::lock_guard<std::mutex> namesLock(_namesMutex);
+    for (size_t i = 0; i < threadRanges.size(); i++) {
+        auto threadId = threadRanges[i].first;
+        auto begin = threadRanges[i].second;
+        auto end = i + 1 < threadRanges.size() ? threadRanges[i + 1].second : collectedTraces.size();
+
+        for (auto j = begin; j < end; j++) {
+            const auto& trace = collectedTraces[j];
+            // Only return the traces that ocurred with or after this identifier
+            if (trace.recordingSequence >= recordingIdentifier) {
+                outTraces.emplace_back(
+                    std::string(_names[trace.nameId]), trace.start, trace.end, threadId, trace.recordingSequence);
+            }
         }
-        _pendingTraces.erase(_pendingTraces.begin(), newStartIt);
     }
 
+    std::stable_sort(outTraces.begin(), outTraces.end(), [](const RecordedTrace& left, const RecordedTrace& right) {
+        return left.start < right.start;
+    });
+
     return outTraces;
 }
 
@@ -11,9 +11,12 @@
 #include "utils/time/StopWatch.hpp"
 #include "valdi_core/cpp/Threading/ThreadBase.hpp"
 #include "valdi_core/cpp/Utils/Defer.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
 
 #include <atomic>
+#include <deque>
 #include <mutex>
 #include <optional>
 #include <thread>
@@ -22,6 +25,9 @@
 namespace Valdi {
 
 class StringBox;
+class TraceThreadBuffer;
+
+using TraceNameId = uint32_t;
 
 std::string getTraceName(std::string_view prefix, std::string_view suffix);
 std::string getTraceName(std::string_view prefix, const StringBox& suffix);
@@ -46,6 +52,15 @@ struct RecordedTrace {
     TraceDuration duration() const;
 };
 
+/**
+ * Records the traces emitted by ScopedTrace while at least one recorder is active.
+ *
+ * Each thread appends into its own fixed size ring buffer, indexed by trace name ids
+ * interned once per thread, so appending a trace does not take any lock or allocate.
+ * The per thread buffers are only merged when a recorder stops. If a thread emits more
+ * traces than its buffer can hold during a recording, the oldest traces of that thread
+ * are dropped.
+ */
 class Tracer {
 public:
     Tracer();
@@ -58,16 +73,32 @@ public:
     size_t startRecording();
     std::vector<RecordedTrace> stopRecording(size_t recordingIdentifier);
 
-    void append(std::string&& trace, const TraceTimePoint& start, const TraceTimePoint& end);
+    void append(std::string_view trace, const TraceTimePoint& start, const TraceTimePoint& end);
+    void append(TraceNameId traceNameId, const TraceTimePoint& start, const TraceTimePoint& end);
+
+    /**
+     * Returns a stable identifier for the given trace name, which can be passed to append()
+     * to avoid hashing the name on every trace.
+     */
+    TraceNameId internTraceName(std::string_view trace);
 
     static Tracer& shared();
 
 private:
     std::mutex _mutex;
     std::atomic_bool _recording = false;
-    size_t _recordingSequence = 0;
-    std::vector<RecordedTrace> _pendingTraces;
+    std::atomic<size_t> _recordingSequence = 0;
     std::vector<size_t> _recorders;
+    std::vector<Ref<TraceThreadBuffer>> _threadBuffers;
+    uint64_t _tracerId;
+
+    std::mutex _namesMutex;
+    // Deque so that the string_view keys of _nameIds stay valid as names are added
+    std::deque<std::string> _names;
+    FlatMap<std::string_view, TraceNameId> _nameIds;
+
+    TraceThreadBuffer& getCurrentThreadBuffer();
+    TraceNameId lockFreeInternTraceName(std::string_view trace);
 };
 
 class ScopedTrace {
@@ -83,6 +114,8 @@ protected:
     snap::profiling::OsTraceEmitter _osEmitter;
 
 private:
+    const std::string* _previousAllocationTraceScope = nullptr;
+
     void begin();
     void end();
 };
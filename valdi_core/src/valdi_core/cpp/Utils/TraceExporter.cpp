@@ -0,0 +1,50 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_core/cpp/Utils/TraceExporter.hpp"
+#include "valdi_core/cpp/Utils/JSONWriter.hpp"
+
+namespace Valdi {
+
+static double toMicroseconds(TraceTimePoint::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+Ref<ByteBuffer> exportTracesToChromeTraceJSON(const std::vector<RecordedTrace>& traces, int64_t processId) {
+    auto output = makeShared<ByteBuffer>();
+    JSONWriter writer(*output);
+
+    writer.writeBeginObject();
+    writer.writeProperty("traceEvents");
+    writer.writeArray(traces, [&](const RecordedTrace& trace) {
+        writer.writeBeginObject();
+        writer.writeProperty("name");
+        writer.writeString(trace.trace);
+        writer.writeComma();
+        writer.writeProperty("cat");
+        writer.writeString("valdi");
+        writer.writeComma();
+        writer.writeProperty("ph");
+        writer.writeString("X");
+        writer.writeComma();
+        writer.writeProperty("ts");
+        writer.writeDouble(toMicroseconds(trace.start.time_since_epoch()));
+        writer.writeComma();
+        writer.writeProperty("dur");
+        writer.writeDouble(toMicroseconds(trace.end - trace.start));
+        writer.writeComma();
+        writer.writeProperty("pid");
+        writer.writeInt(processId);
+        writer.writeComma();
+        writer.writeProperty("tid");
+        writer.writeInt(static_cast<int64_t>(trace.threadId));
+        writer.writeEndObject();
+    });
+    writer.writeComma();
+    writer.writeProperty("displayTimeUnit");
+    writer.writeString("ms");
+    writer.writeEndObject();
+
+    return output;
+}
+
+} // namespace Valdi
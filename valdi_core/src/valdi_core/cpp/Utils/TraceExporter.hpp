@@ -0,0 +1,19 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Trace.hpp"
+
+#include <vector>
+
+namespace Valdi {
+
+/**
+ * Serializes the given recorded traces into the Chrome Trace Event JSON format,
+ * which can be loaded directly into Perfetto (ui.perfetto.dev) or chrome://tracing.
+ * Each trace is emitted as a complete event ("ph": "X") with microsecond timestamps.
+ */
+Ref<ByteBuffer> exportTracesToChromeTraceJSON(const std::vector<RecordedTrace>& traces, int64_t processId);
+
+} // namespace Valdi
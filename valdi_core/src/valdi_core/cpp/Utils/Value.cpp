@@ -108,12 +108,6 @@ Value::Value(const Void& /*v*/) noexcept : _type(ValueType::Undefined) {
     _data.l = 0;
 }
 
-Value::~Value() noexcept {
-    if (_isShared) {
-        unsafeRelease(_data.p);
-    }
-}
-
 Value::Value(int32_t anInt) noexcept : _type(ValueType::Int) {
     _data.i = anInt;
 }
@@ -144,12 +138,6 @@ Value::Value(const char* aString) noexcept
 
 Value::Value(const Ref<ValueFunction>& aFunction) noexcept : Value(aFunction.get(), ValueType::Function) {}
 
-Value::Value(const Value& other) noexcept : _data(other._data), _type(other._type), _isShared(other._isShared) {
-    if (_isShared) {
-        unsafeRetain(_data.p);
-    }
-}
-
 Value::Value(const Ref<InternedStringImpl>& aString) noexcept : Value(aString.get(), ValueType::InternedString) {
     _type = ValueType::InternedString;
 }
@@ -181,12 +169,6 @@ Value::Value(RefCountable* refCountable, ValueType valueType) noexcept {
     }
 }
 
-Value::Value(Value&& other) noexcept : _data(other._data), _type(other._type), _isShared(other._isShared) {
-    other._data.l = 0;
-    other._type = ValueType::Null;
-    other._isShared = false;
-}
-
 const Value& Value::undefinedRef() noexcept {
     static auto undefined = Value::undefined();
     return undefined;
@@ -196,42 +178,6 @@ const Value& Value::undefinedRef() noexcept {
  Operator overloads
  */
 
-Value& Value::operator=(Value&& other) noexcept {
-    if (this != &other) {
-        if (_isShared) {
-            unsafeRelease(_data.p);
-        }
-
-        _data = other._data;
-        _type = other._type;
-        _isShared = other._isShared;
-
-        other._data.l = 0;
-        other._type = ValueType::Null;
-        other._isShared = false;
-    }
-
-    return *this;
-}
-
-Value& Value::operator=(const Value& other) noexcept {
-    if (this != &other) {
-        if (_isShared) {
-            unsafeRelease(_data.p);
-        }
-
-        _data = other._data;
-        _type = other._type;
-        _isShared = other._isShared;
-
-        if (_isShared) {
-            unsafeRetain(_data.p);
-        }
-    }
-
-    return *this;
-}
-
 bool Value::operator==(const Value& other) const noexcept {
     if (this == &other) {
         return true;
@@ -335,6 +335,64 @@ private:
 std::ostream& operator<<(std::ostream& os, const Value& value);
 std::ostream& operator<<(std::ostream& os, const ValueType& valueType);
 
+// Copies, moves and destruction are defined inline since they are on the hot path of
+// attribute processing. Values that don't hold a pointer are copied without any call.
+
+inline Value::~Value() noexcept {
+    if (_isShared) {
+        unsafeRelease(_data.p);
+    }
+}
+
+inline Value::Value(const Value& other) noexcept
+    : _data(other._data), _type(other._type), _isShared(other._isShared) {
+    if (_isShared) {
+        unsafeRetain(_data.p);
+    }
+}
+
+inline Value::Value(Value&& other) noexcept : _data(other._data), _type(other._type), _isShared(other._isShared) {
+    other._data.l = 0;
+    other._type = ValueType::Null;
+    other._isShared = false;
+}
+
+inline Value& Value::operator=(Value&& other) noexcept {
+    if (this != &other) {
+        if (_isShared) {
+            unsafeRelease(_data.p);
+        }
+
+        _data = other._data;
+        _type = other._type;
+        _isShared = other._isShared;
+
+        other._data.l = 0;
+        other._type = ValueType::Null;
+        other._isShared = false;
+    }
+
+    return *this;
+}
+
+inline Value& Value::operator=(const Value& other) noexcept {
+    if (this != &other) {
+        // Retain first, the other value might be owned by what this value holds
+        if (other._isShared) {
+            unsafeRetain(other._data.p);
+        }
+        if (_isShared) {
+            unsafeRelease(_data.p);
+        }
+
+        _data = other._data;
+        _type = other._type;
+        _isShared = other._isShared;
+    }
+
+    return *this;
+}
+
 } // namespace Valdi
 
 namespace std {
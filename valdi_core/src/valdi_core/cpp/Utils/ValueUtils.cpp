@@ -7,6 +7,8 @@
 //
 
 #include "valdi_core/cpp/Utils/ValueUtils.hpp"
+#include "valdi_core/cpp/Utils/Base64Codec.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/JSONReader.hpp"
 #include "valdi_core/cpp/Utils/JSONWriter.hpp"
 #include "valdi_core/cpp/Utils/ValueArrayBuilder.hpp"
@@ -22,7 +24,6 @@
 
 #include <fmt/format.h>
 
-#include "utils/encoding/Base64Utils.hpp"
 #include "json/reader.h"
 #include "json/writer.h"
 
@@ -158,7 +159,7 @@ void writeValueToJSONWriter(const Value& value, JSONWriter& writer) {
         case ValueType::TypedArray: {
             auto bytes = value.getTypedArray()->getBuffer();
 
-            auto base64 = snap::utils::encoding::binaryToBase64(bytes.data(), bytes.size());
+            auto base64 = Base64Codec::encode(bytes.data(), bytes.size());
 
             writer.writeString(base64);
         } break;
@@ -249,8 +250,39 @@ Result<Value> jsonToValue(const Byte* data, size_t size) {
     return jsonToValue(std::string_view(reinterpret_cast<const char*>(data), size));
 }
 
-Value readValueFromJSONReader(JSONReader& reader) {
-    std::string str;
+namespace {
+
+/**
+ Interns the keys of the objects of a single parse. JSON documents often repeat the same keys,
+ like in arrays of objects, which are then resolved without going through the global StringCache.
+ Only keys pointing into the input are cached, as the input outlives the parse.
+ */
+class JSONKeyCache {
+public:
+    StringBox makeKey(std::string_view key, bool isInInput) {
+        if (!isInInput) {
+            return StringCache::getGlobal().makeString(key);
+        }
+
+        const auto& it = _keys.find(key);
+        if (it != _keys.end()) {
+            return it->second;
+        }
+
+        auto stringBox = StringCache::getGlobal().makeString(key);
+        _keys[key] = stringBox;
+        return stringBox;
+    }
+
+private:
+    FlatMap<std::string_view, StringBox> _keys;
+};
+
+} // namespace
+
+static Value readValueFromJSONReader(JSONReader& reader, JSONKeyCache& keyCache) {
+    std::string_view str;
+    bool isInInput;
     double d;
     bool b;
 
@@ -265,16 +297,19 @@ Value readValueFromJSONReader(JSONReader& reader) {
                     return Value();
                 }
 
-                str.clear();
-                if (!reader.parseString(str) || !reader.parseColon()) {
+                if (!reader.parseStringView(str, isInInput)) {
+                    return Value();
+                }
+                auto key = keyCache.makeKey(str, isInInput);
+                if (!reader.parseColon()) {
                     return Value();
                 }
 
-                auto value = readValueFromJSONReader(reader);
+                auto value = readValueFromJSONReader(reader, keyCache);
                 if (reader.hasError()) {
                     return Value();
                 }
-                (*valueMap)[StringCache::getGlobal().makeString(str)] = std::move(value);
+                (*valueMap)[std::move(key)] = std::move(value);
             }
             return Value(valueMap);
         }
@@ -287,7 +322,7 @@ Value readValueFromJSONReader(JSONReader& reader) {
                 if ((!arrayBuilder.empty() && !reader.parseComma()) || reader.hasError()) {
                     return Value();
                 }
-                auto value = readValueFromJSONReader(reader);
+                auto value = readValueFromJSONReader(reader, keyCache);
                 if (reader.hasError()) {
                     return Value();
                 }
@@ -296,7 +331,7 @@ Value readValueFromJSONReader(JSONReader& reader) {
             return Value(arrayBuilder.build());
         }
         case JSONReader::Token::String: {
-            if (!reader.parseString(str)) {
+            if (!reader.parseStringView(str, isInInput)) {
                 return Value();
             }
             return Value(str);
@@ -319,4 +354,9 @@ Value readValueFromJSONReader(JSONReader& reader) {
     }
 }
 
+Value readValueFromJSONReader(JSONReader& reader) {
+    JSONKeyCache keyCache;
+    return readValueFromJSONReader(reader, keyCache);
+}
+
 } // namespace Valdi
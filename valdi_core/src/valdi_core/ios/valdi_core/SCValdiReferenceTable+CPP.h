@@ -36,6 +36,11 @@ public:
      */
     void remove(SequenceID objectId);
 
+    /**
+     * Remove all the given previously stored objects at once.
+     */
+    void removeAll(const std::vector<SequenceID>& objectIds);
+
     /**
      * Load an object instance from its id.
      */
@@ -40,6 +40,27 @@ void ObjCReferenceTable::remove(SequenceID objectId) {
     }
 }
 
+void ObjCReferenceTable::removeAll(const std::vector<SequenceID> &objectIds) {
+    std::vector<SequenceID> expiredIds;
+    std::vector<const void *> oldObjects;
+    {
+        auto writeAccess = _table.writeAccess();
+        writeAccess.releaseRefs(objectIds, expiredIds);
+
+        oldObjects.reserve(expiredIds.size());
+        for (const auto &expiredId : expiredIds) {
+            const auto *oldObject = onRemove(expiredId.getIndex());
+            if (oldObject != nullptr) {
+                oldObjects.emplace_back(oldObject);
+            }
+        }
+    }
+
+    for (const auto *oldObject : oldObjects) {
+        CFRelease(oldObject);
+    }
+}
+
 id ObjCReferenceTable::load(SequenceID objectId) __attribute__((ns_returns_retained)) {
     auto readAccess = _table.readAccess();
     auto ref = readAccess.getEntry(objectId);
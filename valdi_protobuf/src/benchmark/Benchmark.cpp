@@ -109,22 +109,27 @@ BENCHMARK(EncodeProtobufReflectionCpp);
 
 static void DecodeValdiProtobuf(benchmark::State& state) {
     auto protoData = makeProtoData();
-    const auto& descriptor = *test::Message::GetDescriptor();
+    const auto* descriptor = test::Message::GetDescriptor();
 
     for (auto _ : state) {
         auto message = Protobuf::Message::parse(protoData, descriptor);
         if (!message) {
             SC_ABORT("Message failed to parse");
         }
+        SimpleExceptionTracker exceptionTracker;
+        if (!message.value()->postprocess(true, exceptionTracker)) {
+            SC_ABORT("Message failed to postprocess");
+        }
     }
 }
 BENCHMARK(DecodeValdiProtobuf);
 
 static void DecodeValdiProtobufNoPostprocess(benchmark::State& state) {
     auto protoData = makeProtoData();
+    const auto* descriptor = test::Message::GetDescriptor();
 
     for (auto _ : state) {
-        auto message = Protobuf::Message::parse(protoData);
+        auto message = Protobuf::Message::parse(protoData, descriptor);
         if (!message) {
             SC_ABORT("Message failed to parse");
         }
@@ -132,9 +137,159 @@ static void DecodeValdiProtobufNoPostprocess(benchmark::State& state) {
 }
 BENCHMARK(DecodeValdiProtobufNoPostprocess);
 
+static BytesView makeRepeatedProtoData() {
+    test::RepeatedMessage message;
+
+    for (uint64_t i = 0; i < 1024; i++) {
+        // Spread the values over all the varint lengths
+        auto value = static_cast<int64_t>(i << (i % 54));
+        message.add_int64(value);
+        message.add_sint64(-value);
+        message.add_fixed64(i);
+    }
+
+    auto bytes = message.ByteSizeLong();
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(bytes);
+
+    SC_ASSERT(message.SerializeToArray(buffer->data(), buffer->size()));
+
+    return buffer->toBytesView();
+}
+
+static void DecodeRepeatedProtobufCpp(benchmark::State& state) {
+    auto protoData = makeRepeatedProtoData();
+
+    for (auto _ : state) {
+        auto message = makeShared<test::RepeatedMessage>();
+        if (!message->ParseFromArray(protoData.data(), protoData.size())) {
+            SC_ABORT("Message failed to parse");
+        }
+    }
+}
+BENCHMARK(DecodeRepeatedProtobufCpp);
+
+static void DecodeRepeatedValdiProtobuf(benchmark::State& state) {
+    auto protoData = makeRepeatedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    for (auto _ : state) {
+        auto message = Protobuf::Message::parse(protoData, descriptor);
+        if (!message) {
+            SC_ABORT("Message failed to parse");
+        }
+        SimpleExceptionTracker exceptionTracker;
+        if (!message.value()->postprocess(true, exceptionTracker)) {
+            SC_ABORT("Message failed to postprocess");
+        }
+    }
+}
+BENCHMARK(DecodeRepeatedValdiProtobuf);
+
+static BytesView makeUnpackedRepeatedProtoData() {
+    // Encode int64 = 2 as 100k unpacked entries, as emitted by proto2 writers
+    auto buffer = makeShared<ByteBuffer>();
+    for (uint64_t i = 0; i < 100000; i++) {
+        buffer->append(static_cast<Byte>(0x10));
+        auto value = i << (i % 54);
+        while (value >= 0x80) {
+            buffer->append(static_cast<Byte>(value | 0x80));
+            value >>= 7;
+        }
+        buffer->append(static_cast<Byte>(value));
+    }
+
+    return buffer->toBytesView();
+}
+
+static void DecodeUnpackedRepeatedValdiProtobuf(benchmark::State& state) {
+    auto protoData = makeUnpackedRepeatedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    for (auto _ : state) {
+        auto message = Protobuf::Message::parse(protoData, descriptor);
+        if (!message) {
+            SC_ABORT("Message failed to parse");
+        }
+        SimpleExceptionTracker exceptionTracker;
+        if (!message.value()->postprocess(true, exceptionTracker)) {
+            SC_ABORT("Message failed to postprocess");
+        }
+    }
+}
+BENCHMARK(DecodeUnpackedRepeatedValdiProtobuf);
+
+static BytesView makeFeedProtoData() {
+    test::RepeatedMessage message;
+
+    for (size_t i = 0; i < 10000; i++) {
+        auto* item = message.add_self_message();
+        item->add_int64(static_cast<int64_t>(i));
+        item->add_string("Feed item title");
+        item->add_other_message()->set_value("Feed item description");
+    }
+
+    auto bytes = message.ByteSizeLong();
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(bytes);
+
+    SC_ASSERT(message.SerializeToArray(buffer->data(), buffer->size()));
+
+    return buffer->toBytesView();
+}
+
+static void DecodeFeedValdiProtobuf(benchmark::State& state) {
+    auto protoData = makeFeedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    for (auto _ : state) {
+        SimpleExceptionTracker exceptionTracker;
+        auto message = Protobuf::Message::parse(protoData, descriptor, exceptionTracker);
+        if (message == nullptr || !message->postprocess(true, exceptionTracker)) {
+            SC_ABORT("Message failed to parse");
+        }
+    }
+}
+BENCHMARK(DecodeFeedValdiProtobuf);
+
+static void DecodeFeedValdiProtobufLazily(benchmark::State& state) {
+    auto protoData = makeFeedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    for (auto _ : state) {
+        SimpleExceptionTracker exceptionTracker;
+        auto message = Protobuf::Message::parse(protoData, descriptor, exceptionTracker);
+        if (message == nullptr || !message->postprocessLazily(exceptionTracker)) {
+            SC_ABORT("Message failed to parse");
+        }
+
+        // Only read the header of the first item
+        auto* item = message->getMessageAt(17, 0, exceptionTracker);
+        if (item == nullptr) {
+            SC_ABORT("Message failed to parse");
+        }
+        benchmark::DoNotOptimize(item->getFieldIterator(14).begin()->getRaw());
+    }
+}
+BENCHMARK(DecodeFeedValdiProtobufLazily);
+
+static void DecodeFeedValdiProtobufInArena(benchmark::State& state) {
+    auto protoData = makeFeedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    for (auto _ : state) {
+        SimpleExceptionTracker exceptionTracker;
+        auto message = Protobuf::Message::parseInArena(protoData, descriptor, exceptionTracker);
+        if (message == nullptr) {
+            SC_ABORT("Message failed to parse");
+        }
+    }
+}
+BENCHMARK(DecodeFeedValdiProtobufInArena);
+
 static void EncodeValdiProtobuf(benchmark::State& state) {
     auto protoData = makeProtoData();
-    const auto& descriptor = *test::Message::GetDescriptor();
+    const auto* descriptor = test::Message::GetDescriptor();
     auto result = Protobuf::Message::parse(protoData, descriptor);
     if (!result) {
         SC_ABORT("Message failed to parse");
@@ -150,4 +305,65 @@ static void EncodeValdiProtobuf(benchmark::State& state) {
 }
 BENCHMARK(EncodeValdiProtobuf);
 
+static void EncodeFeedValdiProtobuf(benchmark::State& state) {
+    auto protoData = makeFeedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    SimpleExceptionTracker exceptionTracker;
+    auto message = Protobuf::Message::parse(protoData, descriptor, exceptionTracker);
+    if (message == nullptr || !message->postprocess(true, exceptionTracker)) {
+        SC_ABORT("Message failed to parse");
+    }
+
+    for (auto _ : state) {
+        auto result = message->encode();
+        if (result.size() != protoData.size()) {
+            SC_ABORT("Message failed to serialize");
+        }
+    }
+}
+BENCHMARK(EncodeFeedValdiProtobuf);
+
+static void DecodeFeedJSONValdiProtobuf(benchmark::State& state) {
+    auto protoData = makeFeedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    SimpleExceptionTracker exceptionTracker;
+    auto message = Protobuf::Message::parse(protoData, descriptor, exceptionTracker);
+    if (message == nullptr || !message->postprocess(true, exceptionTracker)) {
+        SC_ABORT("Message failed to parse");
+    }
+    auto json = message->toJSON(Protobuf::JSONPrintOptions(), exceptionTracker);
+    if (!exceptionTracker) {
+        SC_ABORT("Message failed to convert to JSON");
+    }
+
+    for (auto _ : state) {
+        auto result = Protobuf::Message::parseFromJSON(json, descriptor, exceptionTracker);
+        if (result == nullptr || !result->postprocess(true, exceptionTracker)) {
+            SC_ABORT("Message failed to parse from JSON");
+        }
+    }
+}
+BENCHMARK(DecodeFeedJSONValdiProtobuf);
+
+static void EncodeFeedJSONValdiProtobuf(benchmark::State& state) {
+    auto protoData = makeFeedProtoData();
+    const auto* descriptor = test::RepeatedMessage::GetDescriptor();
+
+    SimpleExceptionTracker exceptionTracker;
+    auto message = Protobuf::Message::parse(protoData, descriptor, exceptionTracker);
+    if (message == nullptr || !message->postprocess(true, exceptionTracker)) {
+        SC_ABORT("Message failed to parse");
+    }
+
+    for (auto _ : state) {
+        auto json = message->toJSON(Protobuf::JSONPrintOptions(), exceptionTracker);
+        if (json.empty()) {
+            SC_ABORT("Message failed to convert to JSON");
+        }
+    }
+}
+BENCHMARK(EncodeFeedJSONValdiProtobuf);
+
 BENCHMARK_MAIN();
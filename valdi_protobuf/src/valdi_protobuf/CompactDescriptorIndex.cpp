@@ -0,0 +1,415 @@
+// Copyright © 2025 Snap, Inc. All rights reserved.
+
+#include "valdi_protobuf/CompactDescriptorIndex.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/ExceptionTracker.hpp"
+#include "valdi_protobuf/protos/DescriptorIndex.pb.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace Valdi::Protobuf {
+
+constexpr uint32_t kVersion = 1;
+
+// Offsets of the values in the header, in words. Table offsets are also in words,
+// except for the strings pool whose offset is in bytes.
+enum HeaderWord : size_t {
+    kHeaderVersion = 0,
+    kHeaderFilesCount,
+    kHeaderSymbolsCount,
+    kHeaderPackagesCount,
+    kHeaderFilesOffset,
+    kHeaderSymbolsOffset,
+    kHeaderPackagesOffset,
+    kHeaderIndexesOffset,
+    kHeaderIndexesCount,
+    kHeaderFileHashOffset,
+    kHeaderSymbolHashOffset,
+    kHeaderPackageHashOffset,
+    kHeaderStringsOffset,
+    kHeaderStringsSize,
+    kHeaderSize,
+};
+
+// name offset, name length, data offset low bits, data offset high bits, data length
+constexpr size_t kFileEntrySize = 5;
+// name offset, name length, file index
+constexpr size_t kSymbolEntrySize = 3;
+// name offset, name length, symbol indexes start, symbol indexes count, nested package indexes start,
+// nested package indexes count
+constexpr size_t kPackageEntrySize = 6;
+
+// Number of keys per bucket of the perfect hashes, on average
+constexpr size_t kKeysPerBucket = 2;
+constexpr uint32_t kMaxHashSeed = 1 << 20;
+
+static uint32_t hashName(std::string_view name, uint32_t seed) {
+    // FNV-1a followed by a finalizer, so that different seeds give unrelated slots
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (auto c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ Build a minimal perfect hash of the given names using hash and displace: names are first
+ distributed into buckets, then starting from the largest bucket, a seed is searched for each
+ bucket so that the names of the bucket all fall into free slots. The output table holds the
+ buckets count, the seed of every bucket, and the index of the name that occupies each slot.
+ */
+static bool buildPerfectHash(const std::vector<std::string_view>& names,
+                             std::vector<uint32_t>& output,
+                             ExceptionTracker& exceptionTracker) {
+    auto count = names.size();
+    auto bucketsCount = count == 0 ? 0 : (count + kKeysPerBucket - 1) / kKeysPerBucket;
+
+    std::vector<std::vector<uint32_t>> buckets(bucketsCount);
+    for (size_t i = 0; i < count; i++) {
+        buckets[hashName(names[i], 0) % bucketsCount].emplace_back(static_cast<uint32_t>(i));
+    }
+
+    std::vector<size_t> bucketOrder(bucketsCount);
+    for (size_t i = 0; i < bucketsCount; i++) {
+        bucketOrder[i] = i;
+    }
+    std::stable_sort(bucketOrder.begin(), bucketOrder.end(), [&](size_t lhs, size_t rhs) {
+        return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    std::vector<uint32_t> seeds(bucketsCount, 0);
+    std::vector<uint32_t> slots(count, 0);
+    std::vector<bool> takenSlots(count, false);
+    std::vector<size_t> bucketSlots;
+
+    for (auto bucketIndex : bucketOrder) {
+        const auto& bucket = buckets[bucketIndex];
+        if (bucket.empty()) {
+            break;
+        }
+
+        uint32_t seed = 1;
+        for (; seed < kMaxHashSeed; seed++) {
+            bucketSlots.clear();
+            for (auto nameIndex : bucket) {
+                auto slot = hashName(names[nameIndex], seed) % count;
+                if (takenSlots[slot] ||
+                    std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end()) {
+                    break;
+                }
+                bucketSlots.emplace_back(slot);
+            }
+            if (bucketSlots.size() == bucket.size()) {
+                break;
+            }
+        }
+
+        if (seed == kMaxHashSeed) {
+            exceptionTracker.onError(fmt::format("Unable to build the hash of name '{}', it might be duplicated",
+                                                 names[bucket.front()]));
+            return false;
+        }
+
+        seeds[bucketIndex] = seed;
+        for (size_t i = 0; i < bucket.size(); i++) {
+            takenSlots[bucketSlots[i]] = true;
+            slots[bucketSlots[i]] = bucket[i];
+        }
+    }
+
+    output.emplace_back(static_cast<uint32_t>(bucketsCount));
+    output.insert(output.end(), seeds.begin(), seeds.end());
+    output.insert(output.end(), slots.begin(), slots.end());
+
+    return true;
+}
+
+static bool isInRange(uint64_t offset, uint64_t size, uint64_t limit) {
+    return offset <= limit && size <= limit - offset;
+}
+
+CompactDescriptorIndex::CompactDescriptorIndex() = default;
+CompactDescriptorIndex::~CompactDescriptorIndex() = default;
+
+bool CompactDescriptorIndex::load(const BytesView& index,
+                                  const Byte* body,
+                                  size_t bodySize,
+                                  ExceptionTracker& exceptionTracker) {
+    auto onError = [&](std::string_view message) {
+        exceptionTracker.onError(fmt::format("Invalid compact descriptor index: {}", message));
+        return false;
+    };
+
+    if (index.size() < kHeaderSize * sizeof(uint32_t)) {
+        return onError("truncated header");
+    }
+    if (reinterpret_cast<uintptr_t>(index.data()) % alignof(uint32_t) != 0) {
+        return onError("misaligned data");
+    }
+
+    const auto* words = reinterpret_cast<const uint32_t*>(index.data());
+    if (words[kHeaderVersion] != kVersion) {
+        return onError(fmt::format("unsupported version {}", words[kHeaderVersion]));
+    }
+
+    auto stringsOffset = words[kHeaderStringsOffset];
+    auto stringsSize = words[kHeaderStringsSize];
+    if (stringsOffset % sizeof(uint32_t) != 0 || !isInRange(stringsOffset, stringsSize, index.size()) ||
+        stringsOffset < kHeaderSize * sizeof(uint32_t)) {
+        return onError("invalid strings pool");
+    }
+
+    uint64_t wordsCount = stringsOffset / sizeof(uint32_t);
+    uint64_t filesCount = words[kHeaderFilesCount];
+    uint64_t symbolsCount = words[kHeaderSymbolsCount];
+    uint64_t packagesCount = words[kHeaderPackagesCount];
+    uint64_t indexesCount = words[kHeaderIndexesCount];
+
+    if (!isInRange(words[kHeaderFilesOffset], filesCount * kFileEntrySize, wordsCount) ||
+        !isInRange(words[kHeaderSymbolsOffset], symbolsCount * kSymbolEntrySize, wordsCount) ||
+        !isInRange(words[kHeaderPackagesOffset], packagesCount * kPackageEntrySize, wordsCount) ||
+        !isInRange(words[kHeaderIndexesOffset], indexesCount, wordsCount)) {
+        return onError("truncated tables");
+    }
+
+    for (auto [hashOffsetWord, count] : {std::make_pair(kHeaderFileHashOffset, filesCount),
+                                         std::make_pair(kHeaderSymbolHashOffset, symbolsCount),
+                                         std::make_pair(kHeaderPackageHashOffset, packagesCount)}) {
+        auto hashOffset = words[hashOffsetWord];
+        if (!isInRange(hashOffset, 1, wordsCount)) {
+            return onError("truncated hash table");
+        }
+        uint64_t bucketsCount = words[hashOffset];
+        if ((bucketsCount == 0) != (count == 0) || !isInRange(hashOffset + 1, bucketsCount + count, wordsCount)) {
+            return onError("truncated hash table");
+        }
+        const auto* slots = words + hashOffset + 1 + bucketsCount;
+        for (uint64_t i = 0; i < count; i++) {
+            if (slots[i] >= count) {
+                return onError("invalid hash table");
+            }
+        }
+    }
+
+    // Validate the entries once, so that the accessors don't need to
+    auto isNameValid = [&](const uint32_t* entry) { return isInRange(entry[0], entry[1], stringsSize); };
+    const auto* indexes = words + words[kHeaderIndexesOffset];
+
+    for (uint64_t i = 0; i < filesCount; i++) {
+        const auto* entry = words + words[kHeaderFilesOffset] + i * kFileEntrySize;
+        auto dataOffset = static_cast<uint64_t>(entry[2]) | (static_cast<uint64_t>(entry[3]) << 32);
+        if (!isNameValid(entry) || (body != nullptr && !isInRange(dataOffset, entry[4], bodySize))) {
+            return onError("invalid file entry");
+        }
+    }
+
+    for (uint64_t i = 0; i < symbolsCount; i++) {
+        const auto* entry = words + words[kHeaderSymbolsOffset] + i * kSymbolEntrySize;
+        if (!isNameValid(entry) || entry[2] >= filesCount) {
+            return onError("invalid symbol entry");
+        }
+    }
+
+    for (uint64_t i = 0; i < packagesCount; i++) {
+        const auto* entry = words + words[kHeaderPackagesOffset] + i * kPackageEntrySize;
+        if (!isNameValid(entry) || !isInRange(entry[2], entry[3], indexesCount) ||
+            !isInRange(entry[4], entry[5], indexesCount)) {
+            return onError("invalid package entry");
+        }
+        for (uint32_t j = 0; j < entry[3]; j++) {
+            if (indexes[entry[2] + j] >= symbolsCount) {
+                return onError("invalid package symbol index");
+            }
+        }
+        for (uint32_t j = 0; j < entry[5]; j++) {
+            if (indexes[entry[4] + j] >= packagesCount) {
+                return onError("invalid nested package index");
+            }
+        }
+    }
+
+    _storage = index;
+    _words = words;
+    _strings = reinterpret_cast<const char*>(index.data() + stringsOffset);
+    _body = body;
+
+    return true;
+}
+
+std::string_view CompactDescriptorIndex::getString(uint32_t offset, uint32_t length) const {
+    return std::string_view(_strings + offset, length);
+}
+
+size_t CompactDescriptorIndex::getFilesSize() const {
+    return _words != nullptr ? _words[kHeaderFilesCount] : 0;
+}
+
+CompactDescriptorIndex::File CompactDescriptorIndex::getFile(size_t index) const {
+    const auto* entry = _words + _words[kHeaderFilesOffset] + index * kFileEntrySize;
+    auto dataOffset = static_cast<uint64_t>(entry[2]) | (static_cast<uint64_t>(entry[3]) << 32);
+    const auto* data = _body != nullptr ? _body + dataOffset : reinterpret_cast<const Byte*>(dataOffset);
+
+    return File{getString(entry[0], entry[1]), data, entry[4]};
+}
+
+std::string_view CompactDescriptorIndex::getFileName(size_t index) const {
+    const auto* entry = _words + _words[kHeaderFilesOffset] + index * kFileEntrySize;
+    return getString(entry[0], entry[1]);
+}
+
+std::optional<size_t> CompactDescriptorIndex::findFile(std::string_view name) const {
+    return find(kHeaderFileHashOffset, getFilesSize(), name, &CompactDescriptorIndex::getFileName);
+}
+
+size_t CompactDescriptorIndex::getSymbolsSize() const {
+    return _words != nullptr ? _words[kHeaderSymbolsCount] : 0;
+}
+
+CompactDescriptorIndex::Symbol CompactDescriptorIndex::getSymbol(size_t index) const {
+    const auto* entry = _words + _words[kHeaderSymbolsOffset] + index * kSymbolEntrySize;
+    return Symbol{getString(entry[0], entry[1]), entry[2]};
+}
+
+std::string_view CompactDescriptorIndex::getSymbolName(size_t index) const {
+    const auto* entry = _words + _words[kHeaderSymbolsOffset] + index * kSymbolEntrySize;
+    return getString(entry[0], entry[1]);
+}
+
+std::optional<size_t> CompactDescriptorIndex::findSymbol(std::string_view fullName) const {
+    return find(kHeaderSymbolHashOffset, getSymbolsSize(), fullName, &CompactDescriptorIndex::getSymbolName);
+}
+
+size_t CompactDescriptorIndex::getPackagesSize() const {
+    return _words != nullptr ? _words[kHeaderPackagesCount] : 0;
+}
+
+CompactDescriptorIndex::Package CompactDescriptorIndex::getPackage(size_t index) const {
+    const auto* entry = _words + _words[kHeaderPackagesOffset] + index * kPackageEntrySize;
+    const auto* indexes = _words + _words[kHeaderIndexesOffset];
+
+    return Package{getString(entry[0], entry[1]),
+                   IndexList(indexes + entry[2], entry[3]),
+                   IndexList(indexes + entry[4], entry[5])};
+}
+
+std::string_view CompactDescriptorIndex::getPackageName(size_t index) const {
+    const auto* entry = _words + _words[kHeaderPackagesOffset] + index * kPackageEntrySize;
+    return getString(entry[0], entry[1]);
+}
+
+std::optional<size_t> CompactDescriptorIndex::findPackage(std::string_view fullName) const {
+    return find(kHeaderPackageHashOffset, getPackagesSize(), fullName, &CompactDescriptorIndex::getPackageName);
+}
+
+std::optional<size_t> CompactDescriptorIndex::find(size_t hashOffsetWord,
+                                                   size_t count,
+                                                   std::string_view name,
+                                                   std::string_view (CompactDescriptorIndex::*getName)(size_t)
+                                                       const) const {
+    if (count == 0) {
+        return std::nullopt;
+    }
+
+    const auto* hashTable = _words + _words[hashOffsetWord];
+    auto bucketsCount = hashTable[0];
+    const auto* seeds = hashTable + 1;
+    const auto* slots = seeds + bucketsCount;
+
+    auto seed = seeds[hashName(name, 0) % bucketsCount];
+    auto index = slots[hashName(name, seed) % count];
+
+    // The hash only tells where the name would be, it still needs to be compared
+    if ((this->*getName)(index) != name) {
+        return std::nullopt;
+    }
+    return index;
+}
+
+BytesView CompactDescriptorIndex::serialize(const DescriptorIndex::DescriptorIndex& index,
+                                            ExceptionTracker& exceptionTracker) {
+    std::vector<uint32_t> words(kHeaderSize, 0);
+    std::string strings;
+
+    auto appendName = [&](const std::string& name) {
+        words.emplace_back(static_cast<uint32_t>(strings.size()));
+        words.emplace_back(static_cast<uint32_t>(name.size()));
+        strings.append(name);
+    };
+
+    std::vector<std::string_view> fileNames;
+    std::vector<std::string_view> symbolNames;
+    std::vector<std::string_view> packageNames;
+
+    words[kHeaderVersion] = kVersion;
+    words[kHeaderFilesCount] = static_cast<uint32_t>(index.files_size());
+    words[kHeaderFilesOffset] = static_cast<uint32_t>(words.size());
+    for (const auto& file : index.files()) {
+        appendName(file.file_name());
+        words.emplace_back(static_cast<uint32_t>(file.data_offset()));
+        words.emplace_back(static_cast<uint32_t>(file.data_offset() >> 32));
+        words.emplace_back(file.length());
+        fileNames.emplace_back(file.file_name());
+    }
+
+    words[kHeaderSymbolsCount] = static_cast<uint32_t>(index.symbols_size());
+    words[kHeaderSymbolsOffset] = static_cast<uint32_t>(words.size());
+    for (const auto& symbol : index.symbols()) {
+        appendName(symbol.full_name());
+        words.emplace_back(symbol.file_index());
+        symbolNames.emplace_back(symbol.full_name());
+    }
+
+    std::vector<uint32_t> indexes;
+    words[kHeaderPackagesCount] = static_cast<uint32_t>(index.packages_size());
+    words[kHeaderPackagesOffset] = static_cast<uint32_t>(words.size());
+    for (const auto& package : index.packages()) {
+        appendName(package.full_name());
+        words.emplace_back(static_cast<uint32_t>(indexes.size()));
+        words.emplace_back(static_cast<uint32_t>(package.symbol_indexes_size()));
+        indexes.insert(indexes.end(), package.symbol_indexes().begin(), package.symbol_indexes().end());
+        words.emplace_back(static_cast<uint32_t>(indexes.size()));
+        words.emplace_back(static_cast<uint32_t>(package.nested_package_indexes_size()));
+        indexes.insert(
+            indexes.end(), package.nested_package_indexes().begin(), package.nested_package_indexes().end());
+        packageNames.emplace_back(package.full_name());
+    }
+
+    words[kHeaderIndexesCount] = static_cast<uint32_t>(indexes.size());
+    words[kHeaderIndexesOffset] = static_cast<uint32_t>(words.size());
+    words.insert(words.end(), indexes.begin(), indexes.end());
+
+    words[kHeaderFileHashOffset] = static_cast<uint32_t>(words.size());
+    if (!buildPerfectHash(fileNames, words, exceptionTracker)) {
+        return BytesView();
+    }
+    words[kHeaderSymbolHashOffset] = static_cast<uint32_t>(words.size());
+    if (!buildPerfectHash(symbolNames, words, exceptionTracker)) {
+        return BytesView();
+    }
+    words[kHeaderPackageHashOffset] = static_cast<uint32_t>(words.size());
+    if (!buildPerfectHash(packageNames, words, exceptionTracker)) {
+        return BytesView();
+    }
+
+    words[kHeaderStringsOffset] = static_cast<uint32_t>(words.size() * sizeof(uint32_t));
+    words[kHeaderStringsSize] = static_cast<uint32_t>(strings.size());
+
+    auto output = makeShared<ByteBuffer>();
+    output->append(reinterpret_cast<const Byte*>(words.data()),
+                   reinterpret_cast<const Byte*>(words.data() + words.size()));
+    output->append(std::string_view(strings));
+
+    return output->toBytesView();
+}
+
+} // namespace Valdi::Protobuf
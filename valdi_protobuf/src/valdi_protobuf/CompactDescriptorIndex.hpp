@@ -0,0 +1,125 @@
+// Copyright © 2025 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace DescriptorIndex {
+class DescriptorIndex;
+}
+
+namespace Valdi {
+class ExceptionTracker;
+}
+
+namespace Valdi::Protobuf {
+
+/**
+ A CompactDescriptorIndex is a flat binary representation of a DescriptorIndex, which is
+ used in place without being parsed or copied. It can be loaded straight from a memory
+ mapped file: loading it only validates its bounds, and files, symbols and packages are
+ looked up by name through minimal perfect hashes stored in the index, so that no hash
+ map needs to be built at startup.
+
+ All the values are 32 bits little endian integers, 4 bytes aligned relative to the
+ beginning of the index, followed by a pool of the names.
+ */
+class CompactDescriptorIndex {
+public:
+    class IndexList {
+    public:
+        constexpr IndexList() = default;
+        constexpr IndexList(const uint32_t* begin, size_t size) : _begin(begin), _size(size) {}
+
+        constexpr const uint32_t* begin() const {
+            return _begin;
+        }
+
+        constexpr const uint32_t* end() const {
+            return _begin + _size;
+        }
+
+        constexpr size_t size() const {
+            return _size;
+        }
+
+        constexpr bool empty() const {
+            return _size == 0;
+        }
+
+        constexpr uint32_t operator[](size_t index) const {
+            return _begin[index];
+        }
+
+    private:
+        const uint32_t* _begin = nullptr;
+        size_t _size = 0;
+    };
+
+    struct File {
+        std::string_view name;
+        const Byte* data;
+        size_t length;
+    };
+
+    struct Symbol {
+        std::string_view fullName;
+        size_t fileIndex;
+    };
+
+    struct Package {
+        std::string_view fullName;
+        IndexList symbolIndexes;
+        IndexList nestedPackageIndexes;
+    };
+
+    CompactDescriptorIndex();
+    ~CompactDescriptorIndex();
+
+    /**
+     Load the index from the given bytes, which are retained and used in place.
+     The data offsets of the files are resolved relative to the given body, they are
+     absolute addresses when body is nullptr.
+     */
+    bool load(const BytesView& index, const Byte* body, size_t bodySize, ExceptionTracker& exceptionTracker);
+
+    size_t getFilesSize() const;
+    File getFile(size_t index) const;
+    std::optional<size_t> findFile(std::string_view name) const;
+
+    size_t getSymbolsSize() const;
+    Symbol getSymbol(size_t index) const;
+    std::optional<size_t> findSymbol(std::string_view fullName) const;
+
+    size_t getPackagesSize() const;
+    Package getPackage(size_t index) const;
+    std::optional<size_t> findPackage(std::string_view fullName) const;
+
+    /**
+     Serialize the given DescriptorIndex into the compact format. The data offsets
+     of its files are written as is.
+     */
+    static BytesView serialize(const DescriptorIndex::DescriptorIndex& index, ExceptionTracker& exceptionTracker);
+
+private:
+    BytesView _storage;
+    const uint32_t* _words = nullptr;
+    const char* _strings = nullptr;
+    const Byte* _body = nullptr;
+
+    std::string_view getString(uint32_t offset, uint32_t length) const;
+    std::optional<size_t> find(size_t hashOffsetWord,
+                               size_t count,
+                               std::string_view name,
+                               std::string_view (CompactDescriptorIndex::*getName)(size_t) const) const;
+
+    std::string_view getFileName(size_t index) const;
+    std::string_view getSymbolName(size_t index) const;
+    std::string_view getPackageName(size_t index) const;
+};
+
+} // namespace Valdi::Protobuf
@@ -5,6 +5,7 @@
 #include "valdi_core/cpp/Utils/ValueArray.hpp"
 #include "valdi_protobuf/DescriptorDatabaseBuilder.hpp"
 #include "valdi_protobuf/Message.hpp"
+#include "valdi_protobuf/MessageParseTable.hpp"
 
 #include <google/protobuf/compiler/parser.h>
 #include <google/protobuf/descriptor.pb.h>
@@ -17,39 +18,54 @@ namespace Valdi::Protobuf {
 
 DescriptorDatabase::DescriptorDatabase(bool skipProtoIndex) : _skipProtoIndex(skipProtoIndex) {}
 
+// Header of the prebuilt descriptor sets: signature (8 bytes), index size (4 bytes).
+// The index is followed by the FileDescriptorSet that it indexes.
+constexpr size_t kPrebuiltHeaderSize = 12;
+// Prebuilt descriptor sets whose index is a DescriptorIndex proto
+constexpr std::string_view kProtoIndexSignature = "VALDIPRO";
+// Prebuilt descriptor sets whose index is a CompactDescriptorIndex
+constexpr std::string_view kCompactIndexSignature = "VALDIPRC";
+
 bool DescriptorDatabase::addFileDescriptorSet(const BytesView& data, ExceptionTracker& exceptionTracker) {
     // prebuilt index can only be loaded once. Supporting loading things in
     // multiple batches increase the complexity considerably but not much
     // benefit because all of Snap's use cases only load descriptor set once.
     assert(!_prebuiltIndexLoaded);
 
-    if (data.size() > 12 /*header*/) {
+    if (data.size() > kPrebuiltHeaderSize) {
         std::string_view signature(reinterpret_cast<const char*>(data.data()), 8);
-        if (signature == "VALDIPRO") { // signature match
+        if (signature == kProtoIndexSignature || signature == kCompactIndexSignature) { // signature match
             uint32_t indexSize = *reinterpret_cast<const uint32_t*>(data.data() + 8);
-            const uint8_t* pIndex = reinterpret_cast<const uint8_t*>(data.data() + 12);
+            if (indexSize > data.size() - kPrebuiltHeaderSize) {
+                exceptionTracker.onError("Truncated prebuilt descriptor set");
+                return false;
+            }
+            const uint8_t* pIndex = reinterpret_cast<const uint8_t*>(data.data() + kPrebuiltHeaderSize);
             const uint8_t* pBody = pIndex + indexSize;
-            size_t bodySize = data.size() - 12 /*header*/ - indexSize;
+            size_t bodySize = data.size() - kPrebuiltHeaderSize - indexSize;
 
             // index disabled by tweak
             if (_skipProtoIndex) {
-                return addFileDescriptorSetWithBuilder(data.subrange(12 + indexSize, bodySize), exceptionTracker);
+                return addFileDescriptorSetWithBuilder(data.subrange(kPrebuiltHeaderSize + indexSize, bodySize),
+                                                       exceptionTracker);
             }
 
             // load from prebuilt index
             _retainedBuffers.emplace_back(data);
-            if (!_index.ParseFromArray(pIndex, static_cast<int>(indexSize))) {
-                return false;
-            }
-            // patch file pointers
-            for (auto& f : *_index.mutable_files()) {
-                if (f.data_offset() > bodySize) {
-                    assert(false);
+            if (signature == kCompactIndexSignature) {
+                // The compact index is used in place
+                if (!finaliseIndex(data.subrange(kPrebuiltHeaderSize, indexSize), pBody, bodySize, exceptionTracker)) {
+                    return false;
+                }
+            } else {
+                DescriptorIndex::DescriptorIndex index;
+                if (!index.ParseFromArray(pIndex, static_cast<int>(indexSize))) {
+                    return false;
+                }
+                if (!finaliseIndex(index, pBody, bodySize, exceptionTracker)) {
                     return false;
                 }
-                f.set_data_offset(reinterpret_cast<uint64_t>(pBody + f.data_offset()));
             }
-            finaliseIndex();
             _prebuiltIndexLoaded = true;
             return true;
         }
@@ -59,6 +75,43 @@ bool DescriptorDatabase::addFileDescriptorSet(const BytesView& data, ExceptionTr
     return addFileDescriptorSetWithBuilder(data, exceptionTracker);
 }
 
+BytesView DescriptorDatabase::compileFileDescriptorSet(const BytesView& data, ExceptionTracker& exceptionTracker) {
+    DescriptorDatabaseBuilder builder;
+    if (!builder.addFileDescriptorSet(data, exceptionTracker)) {
+        return BytesView();
+    }
+
+    std::vector<BytesView> retainedBuffers;
+    DescriptorIndex::DescriptorIndex index;
+    if (!builder.build(retainedBuffers, index)) {
+        return BytesView();
+    }
+
+    // The builder references the files by address, make them relative to the FileDescriptorSet
+    auto baseAddress = reinterpret_cast<uintptr_t>(data.data());
+    for (auto& file : *index.mutable_files()) {
+        file.set_data_offset(file.data_offset() - baseAddress);
+    }
+
+    auto compactIndex = CompactDescriptorIndex::serialize(index, exceptionTracker);
+    if (compactIndex.empty()) {
+        return BytesView();
+    }
+
+    // The compact index must be 4 bytes aligned, which holds as it is right after the header
+    static_assert(kPrebuiltHeaderSize % sizeof(uint32_t) == 0);
+
+    auto output = makeShared<ByteBuffer>();
+    output->reserve(kPrebuiltHeaderSize + compactIndex.size() + data.size());
+    output->append(kCompactIndexSignature);
+    auto indexSize = static_cast<uint32_t>(compactIndex.size());
+    output->append(reinterpret_cast<const Byte*>(&indexSize), reinterpret_cast<const Byte*>(&indexSize + 1));
+    output->append(compactIndex.begin(), compactIndex.end());
+    output->append(data.begin(), data.end());
+
+    return output->toBytesView();
+}
+
 bool DescriptorDatabase::parseAndAddFileDescriptorSet(const std::string& filename,
                                                       std::string_view protoFileContent,
                                                       ExceptionTracker& exceptionTracker) {
@@ -72,28 +125,29 @@ bool DescriptorDatabase::parseAndAddFileDescriptorSet(const std::string& filenam
     if (!_builder->parseAndAddFileDescriptorSet(filename, protoFileContent, exceptionTracker)) {
         return false;
     }
-    if (!_builder->build(_retainedBuffers, _index)) {
+    DescriptorIndex::DescriptorIndex index;
+    if (!_builder->build(_retainedBuffers, index)) {
         return false;
     }
-    finaliseIndex();
-    return true;
+    // The builder references the files by address
+    return finaliseIndex(index, nullptr, 0, exceptionTracker);
 }
 
 bool DescriptorDatabase::FindFileByName(const std::string& filename, google::protobuf::FileDescriptorProto* output) {
-    const auto& it = _fileIndexByName.find(filename);
-    if (it == _fileIndexByName.end()) {
+    auto fileIndex = _index.findFile(filename);
+    if (!fileIndex) {
         return false;
     }
-    return copyProtoOfFile(it->second, output);
+    return copyProtoOfFile(fileIndex.value(), output);
 }
 
 bool DescriptorDatabase::FindFileContainingSymbol(const std::string& symbolName,
                                                   google::protobuf::FileDescriptorProto* output) {
-    const auto& it = _symbolIndexByName.find(symbolName);
-    if (it == _symbolIndexByName.end()) {
+    auto symbolIndex = _index.findSymbol(symbolName);
+    if (!symbolIndex) {
         return false;
     }
-    return copyProtoOfFile(_index.symbols(static_cast<int>(it->second)).file_index(), output);
+    return copyProtoOfFile(_index.getSymbol(symbolIndex.value()).fileIndex, output);
 }
 
 bool DescriptorDatabase::FindFileContainingExtension(const std::string& /* containingType */,
@@ -108,74 +162,76 @@ bool DescriptorDatabase::FindAllExtensionNumbers(const std::string& /* extendeeT
 }
 
 bool DescriptorDatabase::FindAllFileNames(std::vector<std::string>* output) {
-    for (const auto& it : _index.files()) {
-        output->push_back(it.file_name());
+    auto filesSize = _index.getFilesSize();
+    for (size_t i = 0; i < filesSize; i++) {
+        output->emplace_back(_index.getFile(i).name);
     }
     return true;
 }
 
 std::vector<std::string> DescriptorDatabase::getAllSymbolNames() const {
+    auto symbolsSize = _index.getSymbolsSize();
     std::vector<std::string> output;
-    output.reserve(_index.symbols_size());
-    for (const auto& symbol : _index.symbols()) {
-        output.push_back(symbol.full_name());
+    output.reserve(symbolsSize);
+    for (size_t i = 0; i < symbolsSize; i++) {
+        output.emplace_back(_index.getSymbol(i).fullName);
     }
     return output;
 }
 
 size_t DescriptorDatabase::getSymbolsSize() const {
-    return _index.symbols_size();
+    return _index.getSymbolsSize();
 }
 
 const google::protobuf::Descriptor* DescriptorDatabase::getDescriptorOfSymbolAtIndex(size_t index) const {
     return _descriptors[index];
 }
 
-const std::string& DescriptorDatabase::getSymbolNameAtIndex(size_t index) const {
-    return _index.symbols(static_cast<int>(index)).full_name();
+std::string_view DescriptorDatabase::getSymbolNameAtIndex(size_t index) const {
+    return _index.getSymbol(index).fullName;
 }
 
 void DescriptorDatabase::setDescriptorOfSymbolAtIndex(size_t index, const google::protobuf::Descriptor* descriptor) {
     _descriptors[index] = descriptor;
+    if (descriptor != nullptr) {
+        // Compile the parse table once when the symbol is resolved, so that it is ready for decoding
+        MessageParseTable::get(*descriptor);
+    }
 }
 
 size_t DescriptorDatabase::getPackagesSize() const {
-    return _index.packages_size();
+    return _index.getPackagesSize();
 }
 
-const DescriptorIndex::Package& DescriptorDatabase::getPackageAtIndex(size_t index) const {
-    return _index.packages(static_cast<int>(index));
+CompactDescriptorIndex::Package DescriptorDatabase::getPackageAtIndex(size_t index) const {
+    return _index.getPackage(index);
 }
 
-const DescriptorIndex::Package& DescriptorDatabase::getRootPackage() const {
-    return _index.packages(0);
+CompactDescriptorIndex::Package DescriptorDatabase::getRootPackage() const {
+    return _index.getPackage(0);
 }
 
 std::optional<size_t> DescriptorDatabase::getSymbolIndexForName(std::string_view name) {
-    const auto& it = _symbolIndexByName.find(name);
-    if (it == _symbolIndexByName.end()) {
-        return std::nullopt;
-    }
-    return it->second;
+    return _index.findSymbol(name);
 }
 
 bool DescriptorDatabase::copyProtoOfFile(size_t fileIndex, google::protobuf::FileDescriptorProto* output) {
-    const auto& file = _index.files(static_cast<int>(fileIndex));
-    return output->ParseFromArray(reinterpret_cast<const void*>(file.data_offset()), static_cast<int>(file.length()));
+    auto file = _index.getFile(fileIndex);
+    return output->ParseFromArray(file.data, static_cast<int>(file.length));
 }
 
 Value DescriptorDatabase::toDebugJSON() const {
     return packageToDebugJSON(getRootPackage());
 }
 
-Value DescriptorDatabase::packageToDebugJSON(const DescriptorIndex::Package& package) const {
-    auto out = Value().setMapValue("name", Value(package.full_name()));
+Value DescriptorDatabase::packageToDebugJSON(const CompactDescriptorIndex::Package& package) const {
+    auto out = Value().setMapValue("name", Value(package.fullName));
 
-    if (package.symbol_indexes_size() != 0) {
-        auto symbols = ValueArray::make(package.symbol_indexes_size());
-        for (int i = 0; i < package.symbol_indexes_size(); i++) {
-            auto symbolIndex = package.symbol_indexes(i);
-            const auto& symbolName = getSymbolNameAtIndex(symbolIndex);
+    if (!package.symbolIndexes.empty()) {
+        auto symbols = ValueArray::make(package.symbolIndexes.size());
+        for (size_t i = 0; i < package.symbolIndexes.size(); i++) {
+            auto symbolIndex = package.symbolIndexes[i];
+            auto symbolName = getSymbolNameAtIndex(symbolIndex);
             symbols->emplace(i, Value(symbolName));
         }
         symbols->sort();
@@ -183,12 +239,12 @@ Value DescriptorDatabase::packageToDebugJSON(const DescriptorIndex::Package& pac
         out.setMapValue("symbols", Value(symbols));
     }
 
-    if (package.nested_package_indexes_size() != 0) {
-        auto packages = ValueArray::make(package.nested_package_indexes_size());
-        for (int i = 0; i < package.nested_package_indexes_size(); i++) {
-            auto packageIndex = package.nested_package_indexes(i);
-            const auto& package = getPackageAtIndex(packageIndex);
-            packages->emplace(i, packageToDebugJSON(package));
+    if (!package.nestedPackageIndexes.empty()) {
+        auto packages = ValueArray::make(package.nestedPackageIndexes.size());
+        for (size_t i = 0; i < package.nestedPackageIndexes.size(); i++) {
+            auto packageIndex = package.nestedPackageIndexes[i];
+            auto nestedPackage = getPackageAtIndex(packageIndex);
+            packages->emplace(i, packageToDebugJSON(nestedPackage));
         }
 
         out.setMapValue("packages", Value(packages));
@@ -197,23 +253,26 @@ Value DescriptorDatabase::packageToDebugJSON(const DescriptorIndex::Package& pac
     return out;
 }
 
-void DescriptorDatabase::finaliseIndex() {
-    _fileIndexByName.clear();
-    _fileIndexByName.reserve(_index.files_size());
-    _symbolIndexByName.clear();
-    _symbolIndexByName.reserve(_index.symbols_size());
-    _packageIndexByName.clear();
-    _packageIndexByName.reserve(_index.packages_size());
-    for (int i = 0; i < _index.files_size(); ++i) {
-        _fileIndexByName[_index.files(i).file_name()] = static_cast<size_t>(i);
-    }
-    for (int i = 0; i < _index.symbols_size(); ++i) {
-        _symbolIndexByName[_index.symbols(i).full_name()] = static_cast<size_t>(i);
+bool DescriptorDatabase::finaliseIndex(const DescriptorIndex::DescriptorIndex& index,
+                                       const Byte* body,
+                                       size_t bodySize,
+                                       ExceptionTracker& exceptionTracker) {
+    auto compactIndex = CompactDescriptorIndex::serialize(index, exceptionTracker);
+    if (compactIndex.empty()) {
+        return false;
     }
-    for (int i = 0; i < _index.packages_size(); ++i) {
-        _packageIndexByName[_index.packages(i).full_name()] = static_cast<size_t>(i);
+    return finaliseIndex(compactIndex, body, bodySize, exceptionTracker);
+}
+
+bool DescriptorDatabase::finaliseIndex(const BytesView& compactIndex,
+                                       const Byte* body,
+                                       size_t bodySize,
+                                       ExceptionTracker& exceptionTracker) {
+    if (!_index.load(compactIndex, body, bodySize, exceptionTracker)) {
+        return false;
     }
-    _descriptors = std::vector<const google::protobuf::Descriptor*>(_index.symbols_size(), nullptr);
+    _descriptors = std::vector<const google::protobuf::Descriptor*>(_index.getSymbolsSize(), nullptr);
+    return true;
 }
 
 bool DescriptorDatabase::addFileDescriptorSetWithBuilder(const BytesView& data, ExceptionTracker& exceptionTracker) {
@@ -223,11 +282,12 @@ bool DescriptorDatabase::addFileDescriptorSetWithBuilder(const BytesView& data,
     if (!_builder->addFileDescriptorSet(data, exceptionTracker)) {
         return false;
     }
-    if (!_builder->build(_retainedBuffers, _index)) {
+    DescriptorIndex::DescriptorIndex index;
+    if (!_builder->build(_retainedBuffers, index)) {
         return false;
     }
-    finaliseIndex();
-    return true;
+    // The builder references the files by address
+    return finaliseIndex(index, nullptr, 0, exceptionTracker);
 }
 
 } // namespace Valdi::Protobuf
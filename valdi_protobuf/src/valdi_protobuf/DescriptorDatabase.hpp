@@ -3,8 +3,8 @@
 #pragma once
 
 #include "valdi_core/cpp/Utils/Bytes.hpp"
-#include "valdi_core/cpp/Utils/FlatMap.hpp"
 #include "valdi_core/cpp/Utils/Value.hpp"
+#include "valdi_protobuf/CompactDescriptorIndex.hpp"
 #include "valdi_protobuf/protos/DescriptorIndex.pb.h"
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/descriptor_database.h>
@@ -23,6 +23,11 @@ class DescriptorDatabaseBuilder;
  * that is similar to Protobuf's builtin EncodedDescriptorDatabase but is faster to ingest
  * and exposes public APIs to query about the ingested types which won't induce parsing the
  * files.
+ *
+ * The index of the ingested types is held in a CompactDescriptorIndex. A descriptor set prebuilt
+ * with compileFileDescriptorSet() carries its compact index, which is used in place: the data
+ * can be memory mapped, and loading it doesn't parse nor copy anything. The file descriptors
+ * are then only parsed once the pool looks up a symbol that they contain.
  */
 class DescriptorDatabase : public google::protobuf::DescriptorDatabase {
 public:
@@ -30,6 +35,13 @@ public:
 
     bool addFileDescriptorSet(const BytesView& data, ExceptionTracker& exceptionTracker);
 
+    /**
+     * Compile the given FileDescriptorSet into the prebuilt format that addFileDescriptorSet()
+     * loads without parsing: a header, the compact index and the FileDescriptorSet itself.
+     * Meant to be called at build time.
+     */
+    static BytesView compileFileDescriptorSet(const BytesView& data, ExceptionTracker& exceptionTracker);
+
     bool parseAndAddFileDescriptorSet(const std::string& filename,
                                       std::string_view protoFileContent,
                                       ExceptionTracker& exceptionTracker);
@@ -52,15 +64,15 @@ public:
 
     const google::protobuf::Descriptor* getDescriptorOfSymbolAtIndex(size_t index) const;
 
-    const std::string& getSymbolNameAtIndex(size_t index) const;
+    std::string_view getSymbolNameAtIndex(size_t index) const;
 
     void setDescriptorOfSymbolAtIndex(size_t index, const google::protobuf::Descriptor* descriptor);
 
     size_t getPackagesSize() const;
 
-    const DescriptorIndex::Package& getPackageAtIndex(size_t index) const;
+    CompactDescriptorIndex::Package getPackageAtIndex(size_t index) const;
 
-    const DescriptorIndex::Package& getRootPackage() const;
+    CompactDescriptorIndex::Package getRootPackage() const;
 
     std::optional<size_t> getSymbolIndexForName(std::string_view name);
 
@@ -68,18 +80,22 @@ public:
 
 private:
     std::vector<BytesView> _retainedBuffers;
-    DescriptorIndex::DescriptorIndex _index;
+    CompactDescriptorIndex _index;
     std::vector<const google::protobuf::Descriptor*> _descriptors;
-    FlatMap<std::string, size_t> _fileIndexByName;
-    FlatMap<std::string, size_t> _symbolIndexByName;
-    FlatMap<std::string, size_t> _packageIndexByName;
     bool _prebuiltIndexLoaded = false;
     std::shared_ptr<DescriptorDatabaseBuilder> _builder;
     const bool _skipProtoIndex;
 
-    void finaliseIndex();
+    bool finaliseIndex(const DescriptorIndex::DescriptorIndex& index,
+                       const Byte* body,
+                       size_t bodySize,
+                       ExceptionTracker& exceptionTracker);
+    bool finaliseIndex(const BytesView& compactIndex,
+                       const Byte* body,
+                       size_t bodySize,
+                       ExceptionTracker& exceptionTracker);
     bool copyProtoOfFile(size_t fileIndex, google::protobuf::FileDescriptorProto* output);
-    Value packageToDebugJSON(const DescriptorIndex::Package& package) const;
+    Value packageToDebugJSON(const CompactDescriptorIndex::Package& package) const;
     bool addIndexedFileDescriptorSet(const BytesView& data, ExceptionTracker& exceptionTracker);
     bool addFileDescriptorSetWithBuilder(const BytesView& data, ExceptionTracker& exceptionTracker);
 };
@@ -1,6 +1,10 @@
 #include "valdi_protobuf/Field.hpp"
 #include "valdi_protobuf/Message.hpp"
 #include "valdi_protobuf/RepeatedField.hpp"
+#include "valdi_protobuf/WireReader.hpp"
+#include "valdi_protobuf/WireWriter.hpp"
+
+#include <algorithm>
 
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/io/coded_stream.h>
@@ -387,6 +391,180 @@ Byte* Field::write(FieldNumber fieldNumber,
     }
 }
 
+void Field::write(const MessageParseTable::EncodedField& encodedField,
+                  bool writeEvenIfEmpty,
+                  bool writeEvenIfEmptyForNestedFields,
+                  WireWriter& writer) const {
+    if (encodedField.isRepeated && _type == InternalType::Ref) {
+        const auto* repeated = getRepeated();
+        if (repeated != nullptr) {
+            writeRepeated(*repeated, encodedField, writeEvenIfEmptyForNestedFields, writer);
+            return;
+        }
+    }
+
+    writeValue(encodedField, writeEvenIfEmpty, writeEvenIfEmptyForNestedFields, writer);
+}
+
+void Field::writeValue(const MessageParseTable::EncodedField& encodedField,
+                       bool writeEvenIfEmpty,
+                       bool writeEvenIfEmptyForNestedFields,
+                       WireWriter& writer) const {
+    writeEvenIfEmpty |= _isOneOf;
+    const auto& tag = encodedField.tag;
+
+    switch (_type) {
+        case InternalType::Unset:
+            return;
+        case InternalType::Varint:
+            if (!writeEvenIfEmpty && _data.varint == 0) {
+                return;
+            }
+            writer.writeTag(tag, WireFormat::WIRETYPE_VARINT);
+            writer.writeVarint(_data.varint);
+            return;
+        case InternalType::Fixed64:
+            if (!writeEvenIfEmpty && _data.fixed64 == 0) {
+                return;
+            }
+            writer.writeTag(tag, WireFormat::WIRETYPE_FIXED64);
+            writer.writeFixed64(_data.fixed64);
+            return;
+        case InternalType::Fixed32:
+            if (!writeEvenIfEmpty && _data.fixed32 == 0) {
+                return;
+            }
+            writer.writeTag(tag, WireFormat::WIRETYPE_FIXED32);
+            writer.writeFixed32(_data.fixed32);
+            return;
+        case InternalType::Raw:
+            writer.writeTag(tag, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+            writer.writeLengthDelimited(_data.raw, static_cast<size_t>(_rawLength));
+            return;
+        case InternalType::Ref:
+            break;
+    }
+
+    // The serialization plan tells which kind of ref the field most likely holds,
+    // so that it can be resolved with a single cast
+    switch (encodedField.kind) {
+        case MessageParseTable::EncodedFieldKind::Message:
+            if (writeRefAsMessage(tag, writeEvenIfEmptyForNestedFields, writer)) {
+                return;
+            }
+            break;
+        case MessageParseTable::EncodedFieldKind::String:
+            if (writeRefAsString(tag, writeEvenIfEmpty, writer)) {
+                return;
+            }
+            break;
+        case MessageParseTable::EncodedFieldKind::Bytes:
+            if (writeRefAsTypedArray(tag, writeEvenIfEmpty, writer)) {
+                return;
+            }
+            break;
+        case MessageParseTable::EncodedFieldKind::Unknown:
+        case MessageParseTable::EncodedFieldKind::Scalar:
+            break;
+    }
+
+    if (writeRefAsMessage(tag, writeEvenIfEmptyForNestedFields, writer)) {
+        return;
+    }
+
+    const auto* repeated = getRepeated();
+    if (repeated != nullptr) {
+        writeRepeated(*repeated, encodedField, writeEvenIfEmptyForNestedFields, writer);
+        return;
+    }
+
+    if (!writeRefAsString(tag, writeEvenIfEmpty, writer)) {
+        writeRefAsTypedArray(tag, writeEvenIfEmpty, writer);
+    }
+}
+
+void Field::writeRepeated(const RepeatedField& repeated,
+                          const MessageParseTable::EncodedField& encodedField,
+                          bool writeEvenIfEmptyForNestedFields,
+                          WireWriter& writer) {
+    const auto& tag = encodedField.tag;
+
+    switch (resolvePackedRepeatedType(repeated)) {
+        case PackedRepeatedType::PackedRepeatedTypeUnpacked:
+            for (const auto& value : repeated) {
+                value.writeValue(encodedField, true, writeEvenIfEmptyForNestedFields, writer);
+            }
+            return;
+        case PackedRepeatedType::PackedRepeatedTypeVarint: {
+            writer.writeTag(tag, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+            auto prefixPosition = writer.beginLengthDelimited();
+            for (const auto& value : repeated) {
+                writer.writeVarint(value._data.varint);
+            }
+            writer.endLengthDelimited(prefixPosition);
+            return;
+        }
+        case PackedRepeatedType::PackedRepeatedTypeFixed64:
+            writer.writeTag(tag, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+            writer.writeVarint(static_cast<uint64_t>(sizeof(uint64_t) * repeated.size()));
+            for (const auto& value : repeated) {
+                writer.writeFixed64(value._data.fixed64);
+            }
+            return;
+        case PackedRepeatedType::PackedRepeatedTypeFixed32:
+            writer.writeTag(tag, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+            writer.writeVarint(static_cast<uint64_t>(sizeof(uint32_t) * repeated.size()));
+            for (const auto& value : repeated) {
+                writer.writeFixed32(value._data.fixed32);
+            }
+            return;
+    }
+}
+
+bool Field::writeRefAsMessage(const EncodedTag& tag, bool writeEvenIfEmptyForNestedFields, WireWriter& writer) const {
+    auto* message = getMessage();
+    if (message == nullptr) {
+        return false;
+    }
+
+    writer.writeTag(tag, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+    auto prefixPosition = writer.beginLengthDelimited();
+    message->encode(writeEvenIfEmptyForNestedFields, writer);
+    writer.endLengthDelimited(prefixPosition);
+
+    return true;
+}
+
+bool Field::writeRefAsString(const EncodedTag& tag, bool writeEvenIfEmpty, WireWriter& writer) const {
+    const auto* string = getString();
+    if (string == nullptr) {
+        return false;
+    }
+
+    auto utf8Storage = string->utf8Storage();
+    if (writeEvenIfEmpty || utf8Storage.length != 0) {
+        writer.writeTag(tag, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+        writer.writeLengthDelimited(reinterpret_cast<const Byte*>(utf8Storage.data), utf8Storage.length);
+    }
+
+    return true;
+}
+
+bool Field::writeRefAsTypedArray(const EncodedTag& tag, bool writeEvenIfEmpty, WireWriter& writer) const {
+    const auto* typedArray = getTypedArray();
+    if (typedArray == nullptr) {
+        return false;
+    }
+
+    const auto& buffer = typedArray->getBuffer();
+    if (writeEvenIfEmpty || buffer.size() != 0) {
+        writer.writeTag(tag, WireFormat::WIRETYPE_LENGTH_DELIMITED);
+        writer.writeLengthDelimited(buffer.data(), buffer.size());
+    }
+
+    return true;
+}
+
 void Field::setIsOneOf(bool isOneOf) {
     _isOneOf = isOneOf;
 }
@@ -752,32 +930,59 @@ static RepeatedField* toPackedRepeated(Field* field, RepeatedParser parser) {
         }
     }
 
+    auto* repeated = field->getRepeated();
+    if (repeated != nullptr) {
+        auto hasPackedEntries = std::any_of(repeated->begin(), repeated->end(), [](const Field& entry) {
+            return entry.getInternalType() == Field::InternalType::Raw;
+        });
+
+        if (hasPackedEntries) {
+            // The array was split into multiple packed chunks, or mixes packed and unpacked entries
+            auto repeatedField = makeShared<RepeatedField>();
+            for (const auto& entry : *repeated) {
+                if (entry.getInternalType() == Field::InternalType::Raw) {
+                    auto raw = entry.getRaw();
+                    parser(repeatedField.get(), raw.data, raw.length);
+                } else {
+                    repeatedField->append(entry);
+                }
+            }
+            field->setRepeated(repeatedField.get());
+            return repeatedField.get();
+        }
+
+        return repeated;
+    }
+
     return field->toRepeated();
 }
 
 static void parseVarintRepeated(RepeatedField* repeated, const Byte* data, size_t length) {
-    google::protobuf::io::CodedInputStream inputStream(data, static_cast<int>(length));
+    WireReader inputStream(data, length);
+    repeated->reserve(repeated->size() + WireReader::countVarints(data, length));
 
     uint64_t varint;
-    while (inputStream.ReadVarint64(&varint)) {
+    while (inputStream.readVarint64(&varint)) {
         repeated->append(Field::varint(varint));
     }
 }
 
 static void parseFixed64Repeated(RepeatedField* repeated, const Byte* data, size_t length) {
-    google::protobuf::io::CodedInputStream inputStream(data, static_cast<int>(length));
+    WireReader inputStream(data, length);
+    repeated->reserve(repeated->size() + length / sizeof(uint64_t));
 
     uint64_t value;
-    while (inputStream.ReadLittleEndian64(&value)) {
+    while (inputStream.readLittleEndian64(&value)) {
         repeated->append(Field::fixed64(value));
     }
 }
 
 static void parseFixed32Repeated(RepeatedField* repeated, const Byte* data, size_t length) {
-    google::protobuf::io::CodedInputStream inputStream(data, static_cast<int>(length));
+    WireReader inputStream(data, length);
+    repeated->reserve(repeated->size() + length / sizeof(uint32_t));
 
     uint32_t value;
-    while (inputStream.ReadLittleEndian32(&value)) {
+    while (inputStream.readLittleEndian32(&value)) {
         repeated->append(Field::fixed32(value));
     }
 }
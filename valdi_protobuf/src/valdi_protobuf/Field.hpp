@@ -5,6 +5,7 @@
 #include "valdi_core/cpp/Utils/StaticString.hpp"
 #include "valdi_core/cpp/Utils/ValueTypedArray.hpp"
 #include "valdi_protobuf/FieldNumber.hpp"
+#include "valdi_protobuf/MessageParseTable.hpp"
 
 namespace google::protobuf {
 class FieldDescriptor;
@@ -14,6 +15,7 @@ namespace Valdi::Protobuf {
 
 class Message;
 class RepeatedField;
+class WireWriter;
 
 using EnumValue = uint32_t;
 
@@ -56,6 +58,15 @@ public:
                 Byte* bufferStart,
                 Byte* bufferEnd) const;
 
+    /**
+     Write the field in a single pass using its serialization plan, the length prefixes
+     of nested messages are patched in place once they have been written.
+     */
+    void write(const MessageParseTable::EncodedField& encodedField,
+               bool writeEvenIfEmpty,
+               bool writeEvenIfEmptyForNestedFields,
+               WireWriter& writer) const;
+
     int32_t getInt32() const;
     void setInt32(int32_t v);
 
@@ -169,6 +180,18 @@ private:
 
     void setRef(RefCountable* ref);
 
+    void writeValue(const MessageParseTable::EncodedField& encodedField,
+                    bool writeEvenIfEmpty,
+                    bool writeEvenIfEmptyForNestedFields,
+                    WireWriter& writer) const;
+    static void writeRepeated(const RepeatedField& repeated,
+                              const MessageParseTable::EncodedField& encodedField,
+                              bool writeEvenIfEmptyForNestedFields,
+                              WireWriter& writer);
+    bool writeRefAsMessage(const EncodedTag& tag, bool writeEvenIfEmptyForNestedFields, WireWriter& writer) const;
+    bool writeRefAsString(const EncodedTag& tag, bool writeEvenIfEmpty, WireWriter& writer) const;
+    bool writeRefAsTypedArray(const EncodedTag& tag, bool writeEvenIfEmpty, WireWriter& writer) const;
+
     template<typename T>
     T* getRefPtr() {
         if (_type == InternalType::Ref) {
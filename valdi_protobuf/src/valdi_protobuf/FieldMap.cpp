@@ -43,8 +43,8 @@ FieldMap::FieldMap(FieldMap&& other) noexcept : _isMap(other._isMap) {
         new (&_storage)(Vector)(std::move(other.getVec()));
     }
 
-    other._isMap = false;
-    new (&other._storage)(Vector)(other.getVec());
+    other.destruct();
+    new (&other._storage)(Vector)();
 }
 
 FieldMap& FieldMap::operator=(const FieldMap& other) {
@@ -73,8 +73,8 @@ FieldMap& FieldMap::operator=(FieldMap&& other) noexcept {
             new (&_storage)(Vector)(std::move(other.getVec()));
         }
 
-        other._isMap = false;
-        new (&other._storage)(Vector)(other.getVec());
+        other.destruct();
+        new (&other._storage)(Vector)();
     }
 
     return *this;
@@ -96,6 +96,12 @@ Field& FieldMap::operator[](FieldNumber i) {
     }
 }
 
+void FieldMap::reserve(FieldNumber maxFieldNumber) {
+    if (!_isMap && maxFieldNumber < FieldMap::kMaxVecSize) {
+        getVec().reserve(maxFieldNumber + 1);
+    }
+}
+
 bool FieldMap::erase(FieldNumber i) {
     if (VALDI_UNLIKELY(_isMap)) {
         auto& map = getMap();
@@ -208,6 +214,7 @@ bool FieldMap::isUsingMap() const {
 FieldMap::Map& FieldMap::toMap() {
     FieldMap::Vector vec(std::move(getVec()));
 
+    getVec().~Vector();
     new (&_storage)(FieldMap::Map)();
     _isMap = true;
     auto& map = getMap();
@@ -13,6 +13,7 @@
 
 #include "valdi_protobuf/Field.hpp"
 #include "valdi_protobuf/FieldNumber.hpp"
+#include "valdi_protobuf/MessageArena.hpp"
 
 #include <utility>
 #include <vector>
@@ -42,7 +43,7 @@ public:
 
     using EntryList = Valdi::SmallVector<Entry, 32>;
 
-    using Vector = std::vector<Field>;
+    using Vector = std::vector<Field, MessageArenaAllocator<Field>>;
     using Map = FlatMap<FieldNumber, Field>;
 
     FieldMap();
@@ -58,6 +59,12 @@ public:
 
     bool erase(FieldNumber i);
 
+    /**
+     Reserve storage for the fields up to the given field number, if it
+     can fit in the vector storage.
+     */
+    void reserve(FieldNumber maxFieldNumber);
+
     Field* find(FieldNumber i);
     const Field* find(FieldNumber i) const;
 
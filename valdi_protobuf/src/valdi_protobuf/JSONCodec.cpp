@@ -0,0 +1,1442 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_protobuf/JSONCodec.hpp"
+#include "utils/encoding/Base64Utils.hpp"
+#include "valdi_core/cpp/Constants.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_protobuf/MessageParseTable.hpp"
+#include "valdi_protobuf/WireReader.hpp"
+#include "valdi_protobuf/WireWriter.hpp"
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <fmt/format.h>
+
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace Valdi::Protobuf {
+
+using WireFormatLite = google::protobuf::internal::WireFormatLite;
+using WireType = WireFormatLite::WireType;
+using FieldDescriptor = google::protobuf::FieldDescriptor;
+
+// Same as the default recursion limit of the generic converter
+constexpr size_t kMaxDepth = 100;
+// Longest number which is converted, the generic converter handles the longer ones
+constexpr size_t kMaxNumberLength = 64;
+
+static bool isWellKnownType(const google::protobuf::Descriptor& descriptor) {
+    return descriptor.file()->package() == "google.protobuf";
+}
+
+static inline bool isWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static inline bool isStringDelimiter(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+#if defined(__ARM_NEON)
+/**
+ Return a mask with 4 bits set for each matching byte, since NEON has no movemask.
+ */
+static inline uint64_t toMask(uint8x16_t matches) {
+    auto narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+#endif
+
+/**
+ Return the first character at or after current which is not a whitespace.
+ The input is scanned 16 bytes at a time, which matters for indented JSON.
+ */
+static inline const char* skipWhitespaces(const char* current, const char* end) {
+    if (VALDI_LIKELY(current == end || !isWhitespace(*current))) {
+        return current;
+    }
+
+#if defined(__SSE2__)
+    while (end - current >= 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+        auto whitespaces = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\n'))),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t'))));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(whitespaces)) ^ 0xFFFFu;
+        if (mask != 0) {
+            return current + __builtin_ctz(mask);
+        }
+        current += 16;
+    }
+#elif defined(__ARM_NEON)
+    while (end - current >= 16) {
+        auto chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(current));
+        auto whitespaces = vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(' ')), vceqq_u8(chunk, vdupq_n_u8('\n'))),
+                                    vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\r')), vceqq_u8(chunk, vdupq_n_u8('\t'))));
+        auto mask = toMask(vmvnq_u8(whitespaces));
+        if (mask != 0) {
+            return current + (__builtin_ctzll(mask) >> 2);
+        }
+        current += 16;
+    }
+#endif
+
+    while (current != end && isWhitespace(*current)) {
+        current++;
+    }
+    return current;
+}
+
+/**
+ Return the first quote, backslash or control character at or after current,
+ scanning the input 16 bytes at a time.
+ */
+static inline const char* findStringDelimiter(const char* current, const char* end) {
+#if defined(__SSE2__)
+    while (end - current >= 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+        auto controls = _mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+        auto delimiters = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\'))),
+            controls);
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(delimiters));
+        if (mask != 0) {
+            return current + __builtin_ctz(mask);
+        }
+        current += 16;
+    }
+#elif defined(__ARM_NEON)
+    while (end - current >= 16) {
+        auto chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(current));
+        auto delimiters = vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('"')), vceqq_u8(chunk, vdupq_n_u8('\\'))),
+                                   vcltq_u8(chunk, vdupq_n_u8(0x20)));
+        auto mask = toMask(delimiters);
+        if (mask != 0) {
+            return current + (__builtin_ctzll(mask) >> 2);
+        }
+        current += 16;
+    }
+#endif
+
+    while (current != end && !isStringDelimiter(*current)) {
+        current++;
+    }
+    return current;
+}
+
+/**
+ Decode the UTF-8 sequence starting at current, which must start with a non ASCII byte.
+ Returns its length, or 0 if the sequence is not valid UTF-8.
+ */
+static size_t decodeUTF8(const unsigned char* current, const unsigned char* end, uint32_t& codePoint) {
+    auto remaining = static_cast<size_t>(end - current);
+    auto lead = current[0];
+    size_t length;
+    uint32_t minCodePoint;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        minCodePoint = 0x80;
+        codePoint = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        minCodePoint = 0x800;
+        codePoint = lead & 0x0F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        minCodePoint = 0x10000;
+        codePoint = lead & 0x07;
+    } else {
+        return 0;
+    }
+
+    if (remaining < length) {
+        return 0;
+    }
+    for (size_t i = 1; i < length; i++) {
+        if ((current[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        codePoint = (codePoint << 6) | (current[i] & 0x3F);
+    }
+
+    // Reject overlong sequences, surrogates and code points past the Unicode range
+    if (codePoint < minCodePoint || (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF) {
+        return 0;
+    }
+    return length;
+}
+
+static bool isValidUTF8(std::string_view str) {
+    const auto* current = reinterpret_cast<const unsigned char*>(str.data());
+    const auto* end = current + str.size();
+    while (current != end) {
+        // Skip the ASCII characters 8 at a time
+        if (static_cast<size_t>(end - current) >= sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, current, sizeof(uint64_t));
+            if ((word & 0x8080808080808080ULL) == 0) {
+                current += sizeof(uint64_t);
+                continue;
+            }
+        }
+
+        if (*current < 0x80) {
+            current++;
+            continue;
+        }
+
+        uint32_t codePoint;
+        auto length = decodeUTF8(current, end, codePoint);
+        if (length == 0) {
+            return false;
+        }
+        current += length;
+    }
+    return true;
+}
+
+static void appendUTF8(std::string& output, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        output.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        output.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        output.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        output.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/**
+ Parse an integer, which must not have a fraction or an exponent.
+ */
+static bool parseInteger(const char*& current, const char* end, bool& negative, uint64_t& magnitude) {
+    negative = current != end && *current == '-';
+    if (negative) {
+        current++;
+    }
+
+    if (current == end || *current < '0' || *current > '9') {
+        return false;
+    }
+
+    magnitude = 0;
+    if (*current == '0') {
+        current++;
+    } else {
+        while (current != end && *current >= '0' && *current <= '9') {
+            auto digit = static_cast<uint64_t>(*current - '0');
+            if (magnitude > (UINT64_MAX - digit) / 10) {
+                return false;
+            }
+            magnitude = magnitude * 10 + digit;
+            current++;
+        }
+    }
+
+    return current == end || (*current != '.' && *current != 'e' && *current != 'E' && (*current < '0' || *current > '9'));
+}
+
+static bool toSigned(bool negative, uint64_t magnitude, int64_t min, int64_t max, int64_t& output) {
+    if (negative) {
+        if (magnitude > static_cast<uint64_t>(-(min + 1)) + 1) {
+            return false;
+        }
+        output = static_cast<int64_t>(~magnitude + 1);
+    } else {
+        if (magnitude > static_cast<uint64_t>(max)) {
+            return false;
+        }
+        output = static_cast<int64_t>(magnitude);
+    }
+    return true;
+}
+
+static bool toUnsigned(bool negative, uint64_t magnitude, uint64_t max, uint64_t& output) {
+    if ((negative && magnitude != 0) || magnitude > max) {
+        return false;
+    }
+    output = magnitude;
+    return true;
+}
+
+/**
+ Parse a number following the JSON grammar.
+ */
+static bool parseNumber(const char*& current, const char* end, double& output) {
+    const auto* start = current;
+    auto isDigit = [&]() { return current != end && *current >= '0' && *current <= '9'; };
+    auto skipDigits = [&]() {
+        if (!isDigit()) {
+            return false;
+        }
+        while (isDigit()) {
+            current++;
+        }
+        return true;
+    };
+
+    if (current != end && *current == '-') {
+        current++;
+    }
+    if (current != end && *current == '0') {
+        current++;
+    } else if (!skipDigits()) {
+        return false;
+    }
+    if (current != end && *current == '.') {
+        current++;
+        if (!skipDigits()) {
+            return false;
+        }
+    }
+    if (current != end && (*current == 'e' || *current == 'E')) {
+        current++;
+        if (current != end && (*current == '+' || *current == '-')) {
+            current++;
+        }
+        if (!skipDigits()) {
+            return false;
+        }
+    }
+
+    auto length = static_cast<size_t>(current - start);
+    if (length > kMaxNumberLength) {
+        return false;
+    }
+
+    // The token is validated, strtod only needs it to be null terminated
+    char buffer[kMaxNumberLength + 1];
+    std::memcpy(buffer, start, length);
+    buffer[length] = 0;
+
+    char* parsedEnd = nullptr;
+    output = std::strtod(buffer, &parsedEnd);
+    return parsedEnd == buffer + length && std::isfinite(output);
+}
+
+class JSONToBinaryConverter {
+public:
+    JSONToBinaryConverter(std::string_view json, ByteBuffer& output)
+        : _current(json.data()), _end(json.data() + json.size()), _writer(output) {}
+
+    bool convert(const google::protobuf::Descriptor& descriptor) {
+        skipWhitespaces();
+        if (!parseMessage(descriptor)) {
+            return false;
+        }
+        skipWhitespaces();
+        return _current == _end;
+    }
+
+private:
+    const char* _current;
+    const char* _end;
+    WireWriter _writer;
+    size_t _depth = 0;
+    std::string _decodedString;
+    std::string _enumName;
+    std::vector<uint8_t> _decodedBytes;
+    FlatMap<const google::protobuf::Descriptor*, const MessageParseTable*> _parseTables;
+
+    void skipWhitespaces() {
+        _current = Protobuf::skipWhitespaces(_current, _end);
+    }
+
+    bool consume(char c) {
+        if (_current != _end && *_current == c) {
+            _current++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consume(std::string_view literal) {
+        if (static_cast<size_t>(_end - _current) < literal.size() ||
+            std::string_view(_current, literal.size()) != literal) {
+            return false;
+        }
+        _current += literal.size();
+        return true;
+    }
+
+    const MessageParseTable& getParseTable(const google::protobuf::Descriptor& descriptor) {
+        auto& parseTable = _parseTables[&descriptor];
+        if (parseTable == nullptr) {
+            parseTable = &MessageParseTable::get(descriptor);
+        }
+        return *parseTable;
+    }
+
+    bool parseMessage(const google::protobuf::Descriptor& descriptor) {
+        if (isWellKnownType(descriptor) || _depth >= kMaxDepth || !consume('{')) {
+            return false;
+        }
+
+        _depth++;
+        const auto& parseTable = getParseTable(descriptor);
+        std::vector<bool> setOneOfs;
+
+        skipWhitespaces();
+        if (!consume('}')) {
+            for (;;) {
+                std::string_view key;
+                if (!parseString(key)) {
+                    return false;
+                }
+                const auto* encodedField = parseTable.findEncodedFieldByJSONName(key);
+                if (encodedField == nullptr) {
+                    return false;
+                }
+
+                skipWhitespaces();
+                if (!consume(':')) {
+                    return false;
+                }
+                skipWhitespaces();
+
+                // Null values leave the field unset
+                if (!consume("null")) {
+                    const auto* oneOf = encodedField->descriptor->real_containing_oneof();
+                    if (oneOf != nullptr) {
+                        setOneOfs.resize(static_cast<size_t>(descriptor.oneof_decl_count()));
+                        auto oneOfIndex = static_cast<size_t>(oneOf->index());
+                        if (setOneOfs[oneOfIndex]) {
+                            return false;
+                        }
+                        setOneOfs[oneOfIndex] = true;
+                    }
+
+                    if (!parseField(*encodedField)) {
+                        return false;
+                    }
+                }
+
+                skipWhitespaces();
+                if (consume('}')) {
+                    break;
+                }
+                if (!consume(',')) {
+                    return false;
+                }
+                skipWhitespaces();
+            }
+        }
+
+        _depth--;
+        return true;
+    }
+
+    bool parseField(const MessageParseTable::EncodedField& encodedField) {
+        const auto& fieldDescriptor = *encodedField.descriptor;
+        if (fieldDescriptor.is_map()) {
+            return parseMap(encodedField);
+        }
+        if (fieldDescriptor.is_repeated()) {
+            return parseRepeated(encodedField);
+        }
+        return parseValue(fieldDescriptor, encodedField.tag);
+    }
+
+    bool parseRepeated(const MessageParseTable::EncodedField& encodedField) {
+        const auto& fieldDescriptor = *encodedField.descriptor;
+        if (!consume('[')) {
+            return false;
+        }
+        skipWhitespaces();
+        if (consume(']')) {
+            return true;
+        }
+
+        auto isPacked = fieldDescriptor.is_packed();
+        size_t prefixPosition = 0;
+        if (isPacked) {
+            _writer.writeTag(encodedField.tag, WireType::WIRETYPE_LENGTH_DELIMITED);
+            prefixPosition = _writer.beginLengthDelimited();
+        }
+
+        for (;;) {
+            if (!(isPacked ? parseScalar(fieldDescriptor) : parseValue(fieldDescriptor, encodedField.tag))) {
+                return false;
+            }
+            skipWhitespaces();
+            if (consume(']')) {
+                break;
+            }
+            if (!consume(',')) {
+                return false;
+            }
+            skipWhitespaces();
+        }
+
+        if (isPacked) {
+            _writer.endLengthDelimited(prefixPosition);
+        }
+        return true;
+    }
+
+    bool parseMap(const MessageParseTable::EncodedField& encodedField) {
+        const auto& entryDescriptor = *encodedField.descriptor->message_type();
+        const auto& keyDescriptor = *entryDescriptor.map_key();
+        const auto& valueDescriptor = *entryDescriptor.map_value();
+        auto keyTag = WireWriter::encodeTag(static_cast<FieldNumber>(keyDescriptor.number()));
+        auto valueTag = WireWriter::encodeTag(static_cast<FieldNumber>(valueDescriptor.number()));
+
+        if (!consume('{')) {
+            return false;
+        }
+        skipWhitespaces();
+        if (consume('}')) {
+            return true;
+        }
+
+        for (;;) {
+            std::string_view key;
+            if (!parseString(key)) {
+                return false;
+            }
+
+            _writer.writeTag(encodedField.tag, WireType::WIRETYPE_LENGTH_DELIMITED);
+            auto prefixPosition = _writer.beginLengthDelimited();
+            if (!writeMapKey(keyDescriptor, keyTag, key)) {
+                return false;
+            }
+
+            skipWhitespaces();
+            if (!consume(':')) {
+                return false;
+            }
+            skipWhitespaces();
+            if (!parseValue(valueDescriptor, valueTag)) {
+                return false;
+            }
+            _writer.endLengthDelimited(prefixPosition);
+
+            skipWhitespaces();
+            if (consume('}')) {
+                break;
+            }
+            if (!consume(',')) {
+                return false;
+            }
+            skipWhitespaces();
+        }
+
+        return true;
+    }
+
+    bool writeMapKey(const FieldDescriptor& keyDescriptor, const EncodedTag& tag, std::string_view key) {
+        switch (keyDescriptor.type()) {
+            case FieldDescriptor::TYPE_STRING:
+                if (!isValidUTF8(key)) {
+                    return false;
+                }
+                _writer.writeTag(tag, WireType::WIRETYPE_LENGTH_DELIMITED);
+                _writer.writeLengthDelimited(reinterpret_cast<const Byte*>(key.data()), key.size());
+                return true;
+            case FieldDescriptor::TYPE_BOOL:
+                if (key != "true" && key != "false") {
+                    return false;
+                }
+                _writer.writeTag(tag, WireType::WIRETYPE_VARINT);
+                _writer.writeVarint(key == "true" ? 1 : 0);
+                return true;
+            default: {
+                const auto* current = key.data();
+                const auto* end = current + key.size();
+                bool negative;
+                uint64_t magnitude;
+                if (!parseInteger(current, end, negative, magnitude) || current != end) {
+                    return false;
+                }
+                _writer.writeTag(tag, getWireType(keyDescriptor));
+                return writeInteger(keyDescriptor, negative, magnitude);
+            }
+        }
+    }
+
+    static WireType getWireType(const FieldDescriptor& fieldDescriptor) {
+        return WireFormatLite::WireTypeForFieldType(static_cast<WireFormatLite::FieldType>(fieldDescriptor.type()));
+    }
+
+    /**
+     Parse a value of a non repeated field, or an element of a repeated field, and write it with its tag.
+     */
+    bool parseValue(const FieldDescriptor& fieldDescriptor, const EncodedTag& tag) {
+        switch (fieldDescriptor.type()) {
+            case FieldDescriptor::TYPE_MESSAGE: {
+                _writer.writeTag(tag, WireType::WIRETYPE_LENGTH_DELIMITED);
+                auto prefixPosition = _writer.beginLengthDelimited();
+                if (!parseMessage(*fieldDescriptor.message_type())) {
+                    return false;
+                }
+                _writer.endLengthDelimited(prefixPosition);
+                return true;
+            }
+            case FieldDescriptor::TYPE_GROUP:
+                return false;
+            case FieldDescriptor::TYPE_STRING: {
+                std::string_view value;
+                if (!parseString(value) || !isValidUTF8(value)) {
+                    return false;
+                }
+                _writer.writeTag(tag, WireType::WIRETYPE_LENGTH_DELIMITED);
+                _writer.writeLengthDelimited(reinterpret_cast<const Byte*>(value.data()), value.size());
+                return true;
+            }
+            case FieldDescriptor::TYPE_BYTES: {
+                std::string_view value;
+                if (!parseString(value)) {
+                    return false;
+                }
+                if (value.empty()) {
+                    _decodedBytes.clear();
+                } else if (!snap::utils::encoding::base64ToBinary(value, _decodedBytes)) {
+                    return false;
+                }
+                _writer.writeTag(tag, WireType::WIRETYPE_LENGTH_DELIMITED);
+                _writer.writeLengthDelimited(_decodedBytes.data(), _decodedBytes.size());
+                return true;
+            }
+            default:
+                _writer.writeTag(tag, getWireType(fieldDescriptor));
+                return parseScalar(fieldDescriptor);
+        }
+    }
+
+    /**
+     Parse a scalar value and write it without its tag.
+     */
+    bool parseScalar(const FieldDescriptor& fieldDescriptor) {
+        switch (fieldDescriptor.type()) {
+            case FieldDescriptor::TYPE_BOOL:
+                if (consume("true")) {
+                    _writer.writeVarint(1);
+                    return true;
+                }
+                if (consume("false")) {
+                    _writer.writeVarint(0);
+                    return true;
+                }
+                return false;
+            case FieldDescriptor::TYPE_ENUM:
+                return parseEnum(fieldDescriptor);
+            case FieldDescriptor::TYPE_FLOAT: {
+                double value;
+                if (!parseFloatingPoint(value) || (std::isfinite(value) && std::fabs(value) > FLT_MAX)) {
+                    return false;
+                }
+                _writer.writeFixed32(WireFormatLite::EncodeFloat(static_cast<float>(value)));
+                return true;
+            }
+            case FieldDescriptor::TYPE_DOUBLE: {
+                double value;
+                if (!parseFloatingPoint(value)) {
+                    return false;
+                }
+                _writer.writeFixed64(WireFormatLite::EncodeDouble(value));
+                return true;
+            }
+            default: {
+                // Integers can be either numbers or strings
+                auto isQuoted = consume('"');
+                bool negative;
+                uint64_t magnitude;
+                if (!parseInteger(_current, _end, negative, magnitude) || (isQuoted && !consume('"'))) {
+                    return false;
+                }
+                return writeInteger(fieldDescriptor, negative, magnitude);
+            }
+        }
+    }
+
+    bool writeInteger(const FieldDescriptor& fieldDescriptor, bool negative, uint64_t magnitude) {
+        int64_t signedValue;
+        uint64_t unsignedValue;
+        switch (fieldDescriptor.type()) {
+            case FieldDescriptor::TYPE_INT32:
+                if (!toSigned(negative, magnitude, INT32_MIN, INT32_MAX, signedValue)) {
+                    return false;
+                }
+                _writer.writeVarint(static_cast<uint64_t>(signedValue));
+                return true;
+            case FieldDescriptor::TYPE_SINT32:
+                if (!toSigned(negative, magnitude, INT32_MIN, INT32_MAX, signedValue)) {
+                    return false;
+                }
+                _writer.writeVarint(WireFormatLite::ZigZagEncode32(static_cast<int32_t>(signedValue)));
+                return true;
+            case FieldDescriptor::TYPE_SFIXED32:
+                if (!toSigned(negative, magnitude, INT32_MIN, INT32_MAX, signedValue)) {
+                    return false;
+                }
+                _writer.writeFixed32(static_cast<uint32_t>(static_cast<int32_t>(signedValue)));
+                return true;
+            case FieldDescriptor::TYPE_INT64:
+                if (!toSigned(negative, magnitude, INT64_MIN, INT64_MAX, signedValue)) {
+                    return false;
+                }
+                _writer.writeVarint(static_cast<uint64_t>(signedValue));
+                return true;
+            case FieldDescriptor::TYPE_SINT64:
+                if (!toSigned(negative, magnitude, INT64_MIN, INT64_MAX, signedValue)) {
+                    return false;
+                }
+                _writer.writeVarint(WireFormatLite::ZigZagEncode64(signedValue));
+                return true;
+            case FieldDescriptor::TYPE_SFIXED64:
+                if (!toSigned(negative, magnitude, INT64_MIN, INT64_MAX, signedValue)) {
+                    return false;
+                }
+                _writer.writeFixed64(static_cast<uint64_t>(signedValue));
+                return true;
+            case FieldDescriptor::TYPE_UINT32:
+                if (!toUnsigned(negative, magnitude, UINT32_MAX, unsignedValue)) {
+                    return false;
+                }
+                _writer.writeVarint(unsignedValue);
+                return true;
+            case FieldDescriptor::TYPE_FIXED32:
+                if (!toUnsigned(negative, magnitude, UINT32_MAX, unsignedValue)) {
+                    return false;
+                }
+                _writer.writeFixed32(static_cast<uint32_t>(unsignedValue));
+                return true;
+            case FieldDescriptor::TYPE_UINT64:
+                if (!toUnsigned(negative, magnitude, UINT64_MAX, unsignedValue)) {
+                    return false;
+                }
+                _writer.writeVarint(unsignedValue);
+                return true;
+            case FieldDescriptor::TYPE_FIXED64:
+                if (!toUnsigned(negative, magnitude, UINT64_MAX, unsignedValue)) {
+                    return false;
+                }
+                _writer.writeFixed64(unsignedValue);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool parseEnum(const FieldDescriptor& fieldDescriptor) {
+        const auto& enumDescriptor = *fieldDescriptor.enum_type();
+        const google::protobuf::EnumValueDescriptor* enumValue;
+
+        if (_current != _end && *_current == '"') {
+            std::string_view name;
+            if (!parseString(name)) {
+                return false;
+            }
+            _enumName.assign(name.data(), name.size());
+            enumValue = enumDescriptor.FindValueByName(_enumName);
+        } else {
+            bool negative;
+            uint64_t magnitude;
+            int64_t number;
+            if (!parseInteger(_current, _end, negative, magnitude) ||
+                !toSigned(negative, magnitude, INT32_MIN, INT32_MAX, number)) {
+                return false;
+            }
+            enumValue = enumDescriptor.FindValueByNumber(static_cast<int>(number));
+        }
+
+        // Unknown values are left to the generic converter
+        if (enumValue == nullptr) {
+            return false;
+        }
+        _writer.writeVarint(static_cast<uint64_t>(static_cast<int64_t>(enumValue->number())));
+        return true;
+    }
+
+    bool parseFloatingPoint(double& output) {
+        if (_current == _end || *_current != '"') {
+            return parseNumber(_current, _end, output);
+        }
+
+        std::string_view value;
+        if (!parseString(value)) {
+            return false;
+        }
+        if (value == "NaN") {
+            output = std::nan("");
+            return true;
+        }
+        if (value == "Infinity") {
+            output = INFINITY;
+            return true;
+        }
+        if (value == "-Infinity") {
+            output = -INFINITY;
+            return true;
+        }
+
+        const auto* current = value.data();
+        const auto* end = current + value.size();
+        return parseNumber(current, end, output) && current == end;
+    }
+
+    /**
+     Parse a string. The returned string references the input, unless the string has
+     escape sequences, in which case it references a buffer reused across calls.
+     */
+    bool parseString(std::string_view& output) {
+        if (!consume('"')) {
+            return false;
+        }
+
+        const auto* delimiter = findStringDelimiter(_current, _end);
+        if (VALDI_LIKELY(delimiter != _end && *delimiter == '"')) {
+            output = std::string_view(_current, static_cast<size_t>(delimiter - _current));
+            _current = delimiter + 1;
+            return true;
+        }
+
+        _decodedString.clear();
+        for (;;) {
+            if (delimiter == _end) {
+                return false;
+            }
+            _decodedString.append(_current, delimiter);
+            _current = delimiter;
+
+            if (*_current == '"') {
+                _current++;
+                output = _decodedString;
+                return true;
+            }
+            if (*_current != '\\' || !parseEscapeSequence()) {
+                return false;
+            }
+
+            delimiter = findStringDelimiter(_current, _end);
+        }
+    }
+
+    bool parseEscapeSequence() {
+        // Skip the backslash
+        _current++;
+        if (_current == _end) {
+            return false;
+        }
+
+        auto c = *_current;
+        _current++;
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                _decodedString.push_back(c);
+                return true;
+            case 'b':
+                _decodedString.push_back('\b');
+                return true;
+            case 'f':
+                _decodedString.push_back('\f');
+                return true;
+            case 'n':
+                _decodedString.push_back('\n');
+                return true;
+            case 'r':
+                _decodedString.push_back('\r');
+                return true;
+            case 't':
+                _decodedString.push_back('\t');
+                return true;
+            case 'u': {
+                uint32_t codePoint;
+                if (!parseHex4(codePoint)) {
+                    return false;
+                }
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    uint32_t lowSurrogate;
+                    if (!consume("\\u") || !parseHex4(lowSurrogate) || lowSurrogate < 0xDC00 ||
+                        lowSurrogate > 0xDFFF) {
+                        return false;
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+                } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    return false;
+                }
+                appendUTF8(_decodedString, codePoint);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool parseHex4(uint32_t& output) {
+        if (_end - _current < 4) {
+            return false;
+        }
+        output = 0;
+        for (size_t i = 0; i < 4; i++) {
+            auto c = *_current;
+            uint32_t digit;
+            if (c >= '0' && c <= '9') {
+                digit = static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                digit = static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                digit = static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                return false;
+            }
+            output = (output << 4) | digit;
+            _current++;
+        }
+        return true;
+    }
+};
+
+/**
+ Return whether the code point is escaped by the generic converter, which escapes
+ the characters which are invisible or which could be interpreted as HTML.
+ */
+static bool needsUnicodeEscape(uint32_t codePoint) {
+    return (codePoint >= 0x80 && codePoint <= 0x9F) || codePoint == 0xAD ||
+           (codePoint >= 0x600 && codePoint <= 0x603) || codePoint == 0x6DD || codePoint == 0x70F ||
+           codePoint == 0x17B4 || codePoint == 0x17B5 || (codePoint >= 0x200B && codePoint <= 0x200F) ||
+           (codePoint >= 0x2028 && codePoint <= 0x202E) || (codePoint >= 0x2060 && codePoint <= 0x2064) ||
+           (codePoint >= 0x206A && codePoint <= 0x206F) || codePoint == 0xFEFF ||
+           (codePoint >= 0xFFF9 && codePoint <= 0xFFFB) || codePoint == 0x110BD ||
+           (codePoint >= 0x1D173 && codePoint <= 0x1D17A) || codePoint == 0xE0001 ||
+           (codePoint >= 0xE0020 && codePoint <= 0xE007F);
+}
+
+static inline bool needsEscape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\' || c == '<' || c == '>' || c >= 0x7F;
+}
+
+class BinaryToJSONConverter {
+public:
+    BinaryToJSONConverter(std::string& output, bool enumsAsInts) : _output(output), _enumsAsInts(enumsAsInts) {}
+
+    bool writeMessage(const Byte* data, size_t length, const google::protobuf::Descriptor& descriptor) {
+        if (isWellKnownType(descriptor) || _depth >= kMaxDepth) {
+            return false;
+        }
+
+        _depth++;
+        const auto& parseTable = getParseTable(descriptor);
+        WireReader reader(data, length);
+        auto isFirst = true;
+
+        _output.push_back('{');
+        while (!reader.isAtEnd()) {
+            auto tag = reader.readTag();
+            if (tag == 0) {
+                return false;
+            }
+
+            const auto* encodedField = parseTable.findEncodedField(static_cast<FieldNumber>(tag >> 3));
+            if (encodedField == nullptr) {
+                // Unknown fields are not printed
+                if (!skipValue(reader, static_cast<WireType>(tag & 0x7))) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (!isFirst) {
+                _output.push_back(',');
+            }
+            isFirst = false;
+
+            const auto& fieldDescriptor = *encodedField->descriptor;
+            writeString(fieldDescriptor.json_name());
+            _output.push_back(':');
+
+            bool success;
+            if (fieldDescriptor.is_map()) {
+                success = writeMap(reader, tag, fieldDescriptor);
+            } else if (fieldDescriptor.is_repeated()) {
+                success = writeRepeated(reader, tag, fieldDescriptor);
+            } else {
+                success = writeValue(reader, static_cast<WireType>(tag & 0x7), fieldDescriptor, false);
+            }
+            if (!success) {
+                return false;
+            }
+        }
+        _output.push_back('}');
+
+        _depth--;
+        return true;
+    }
+
+private:
+    std::string& _output;
+    bool _enumsAsInts;
+    size_t _depth = 0;
+    FlatMap<const google::protobuf::Descriptor*, const MessageParseTable*> _parseTables;
+
+    const MessageParseTable& getParseTable(const google::protobuf::Descriptor& descriptor) {
+        auto& parseTable = _parseTables[&descriptor];
+        if (parseTable == nullptr) {
+            parseTable = &MessageParseTable::get(descriptor);
+        }
+        return *parseTable;
+    }
+
+    /**
+     Move the reader to the next occurrence of the given field if it is the next field,
+     like the generic converter which prints consecutive occurrences as a single list.
+     */
+    static bool readNextOccurrence(WireReader& reader, uint32_t& tag) {
+        if (reader.isAtEnd()) {
+            return false;
+        }
+        auto next = reader;
+        auto nextTag = next.readTag();
+        if ((nextTag >> 3) != (tag >> 3)) {
+            return false;
+        }
+        reader = next;
+        tag = nextTag;
+        return true;
+    }
+
+    static bool skipValue(WireReader& reader, WireType wireType) {
+        switch (wireType) {
+            case WireType::WIRETYPE_VARINT: {
+                uint64_t value;
+                return reader.readVarint64(&value);
+            }
+            case WireType::WIRETYPE_FIXED64:
+                return reader.skip(sizeof(uint64_t));
+            case WireType::WIRETYPE_FIXED32:
+                return reader.skip(sizeof(uint32_t));
+            case WireType::WIRETYPE_LENGTH_DELIMITED: {
+                uint32_t length;
+                return reader.readVarint32(&length) && reader.skip(length);
+            }
+            default:
+                return false;
+        }
+    }
+
+    static bool readLengthDelimited(WireReader& reader, WireType wireType, const Byte*& data, uint32_t& length) {
+        if (wireType != WireType::WIRETYPE_LENGTH_DELIMITED || !reader.readVarint32(&length)) {
+            return false;
+        }
+        data = reader.current();
+        return reader.skip(length);
+    }
+
+    bool writeRepeated(WireReader& reader, uint32_t tag, const FieldDescriptor& fieldDescriptor) {
+        auto isPackable = FieldDescriptor::IsTypePackable(fieldDescriptor.type());
+        auto elementWireType = WireFormatLite::WireTypeForFieldType(
+            static_cast<WireFormatLite::FieldType>(fieldDescriptor.type()));
+        auto isFirst = true;
+
+        _output.push_back('[');
+        do {
+            auto wireType = static_cast<WireType>(tag & 0x7);
+            if (isPackable && wireType == WireType::WIRETYPE_LENGTH_DELIMITED) {
+                const Byte* data;
+                uint32_t length;
+                if (!readLengthDelimited(reader, wireType, data, length)) {
+                    return false;
+                }
+                WireReader packedReader(data, length);
+                while (!packedReader.isAtEnd()) {
+                    if (!isFirst) {
+                        _output.push_back(',');
+                    }
+                    isFirst = false;
+                    if (!writeValue(packedReader, elementWireType, fieldDescriptor, false)) {
+                        return false;
+                    }
+                }
+            } else {
+                if (!isFirst) {
+                    _output.push_back(',');
+                }
+                isFirst = false;
+                if (!writeValue(reader, wireType, fieldDescriptor, false)) {
+                    return false;
+                }
+            }
+        } while (readNextOccurrence(reader, tag));
+        _output.push_back(']');
+
+        return true;
+    }
+
+    bool writeMap(WireReader& reader, uint32_t tag, const FieldDescriptor& fieldDescriptor) {
+        const auto& entryDescriptor = *fieldDescriptor.message_type();
+        const auto& keyDescriptor = *entryDescriptor.map_key();
+        const auto& valueDescriptor = *entryDescriptor.map_value();
+        auto isFirst = true;
+
+        _output.push_back('{');
+        do {
+            const Byte* entryData;
+            uint32_t entryLength;
+            if (!readLengthDelimited(reader, static_cast<WireType>(tag & 0x7), entryData, entryLength)) {
+                return false;
+            }
+
+            // Locate the last occurrence of the key and of the value within the entry
+            WireReader entryReader(entryData, entryLength);
+            WireReader keyReader(nullptr, 0);
+            WireReader valueReader(nullptr, 0);
+            WireType keyWireType = WireType::WIRETYPE_VARINT;
+            WireType valueWireType = WireType::WIRETYPE_VARINT;
+            auto hasKey = false;
+            auto hasValue = false;
+            while (!entryReader.isAtEnd()) {
+                auto entryTag = entryReader.readTag();
+                if (entryTag == 0) {
+                    return false;
+                }
+                auto wireType = static_cast<WireType>(entryTag & 0x7);
+                const auto* valueStart = entryReader.current();
+                if (!skipValue(entryReader, wireType)) {
+                    return false;
+                }
+                auto valueLength = static_cast<size_t>(entryReader.current() - valueStart);
+
+                auto number = static_cast<int>(entryTag >> 3);
+                if (number == keyDescriptor.number()) {
+                    keyReader = WireReader(valueStart, valueLength);
+                    keyWireType = wireType;
+                    hasKey = true;
+                } else if (number == valueDescriptor.number()) {
+                    valueReader = WireReader(valueStart, valueLength);
+                    valueWireType = wireType;
+                    hasValue = true;
+                }
+            }
+
+            if (!isFirst) {
+                _output.push_back(',');
+            }
+            isFirst = false;
+
+            if (hasKey) {
+                if (!writeValue(keyReader, keyWireType, keyDescriptor, true)) {
+                    return false;
+                }
+            } else {
+                writeDefaultValue(keyDescriptor, true);
+            }
+            _output.push_back(':');
+            if (hasValue) {
+                if (!writeValue(valueReader, valueWireType, valueDescriptor, false)) {
+                    return false;
+                }
+            } else {
+                writeDefaultValue(valueDescriptor, false);
+            }
+        } while (readNextOccurrence(reader, tag));
+        _output.push_back('}');
+
+        return true;
+    }
+
+    template<typename T>
+    void writeInteger(T value, bool quoted) {
+        fmt::format_int formatted(value);
+        if (quoted) {
+            _output.push_back('"');
+        }
+        _output.append(formatted.data(), formatted.size());
+        if (quoted) {
+            _output.push_back('"');
+        }
+    }
+
+    template<typename T>
+    void writeFloatingPoint(T value) {
+        if (std::isnan(value)) {
+            _output.append("\"NaN\"");
+        } else if (std::isinf(value)) {
+            _output.append(value > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+        } else {
+            // Formats the shortest representation which round trips
+            fmt::format_to(std::back_inserter(_output), "{}", value);
+        }
+    }
+
+    void writeEnum(const FieldDescriptor& fieldDescriptor, int32_t number) {
+        if (!_enumsAsInts) {
+            const auto* enumValue = fieldDescriptor.enum_type()->FindValueByNumber(number);
+            if (enumValue != nullptr) {
+                writeString(enumValue->name());
+                return;
+            }
+        }
+        writeInteger(number, false);
+    }
+
+    /**
+     Write a value read from the reader. Map keys are always written as strings.
+     */
+    bool writeValue(WireReader& reader, WireType wireType, const FieldDescriptor& fieldDescriptor, bool isMapKey) {
+        uint64_t varint;
+        uint32_t fixed32;
+        uint64_t fixed64;
+        const Byte* data;
+        uint32_t length;
+
+        switch (fieldDescriptor.type()) {
+            case FieldDescriptor::TYPE_INT32:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                writeInteger(static_cast<int32_t>(varint), isMapKey);
+                return true;
+            case FieldDescriptor::TYPE_INT64:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                writeInteger(static_cast<int64_t>(varint), true);
+                return true;
+            case FieldDescriptor::TYPE_UINT32:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                writeInteger(static_cast<uint32_t>(varint), isMapKey);
+                return true;
+            case FieldDescriptor::TYPE_UINT64:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                writeInteger(varint, true);
+                return true;
+            case FieldDescriptor::TYPE_SINT32:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                writeInteger(WireFormatLite::ZigZagDecode32(static_cast<uint32_t>(varint)), isMapKey);
+                return true;
+            case FieldDescriptor::TYPE_SINT64:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                writeInteger(WireFormatLite::ZigZagDecode64(varint), true);
+                return true;
+            case FieldDescriptor::TYPE_BOOL:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                if (isMapKey) {
+                    _output.append(varint != 0 ? "\"true\"" : "\"false\"");
+                } else {
+                    _output.append(varint != 0 ? "true" : "false");
+                }
+                return true;
+            case FieldDescriptor::TYPE_ENUM:
+                if (wireType != WireType::WIRETYPE_VARINT || !reader.readVarint64(&varint)) {
+                    return false;
+                }
+                writeEnum(fieldDescriptor, static_cast<int32_t>(varint));
+                return true;
+            case FieldDescriptor::TYPE_FIXED32:
+                if (wireType != WireType::WIRETYPE_FIXED32 || !reader.readLittleEndian32(&fixed32)) {
+                    return false;
+                }
+                writeInteger(fixed32, isMapKey);
+                return true;
+            case FieldDescriptor::TYPE_SFIXED32:
+                if (wireType != WireType::WIRETYPE_FIXED32 || !reader.readLittleEndian32(&fixed32)) {
+                    return false;
+                }
+                writeInteger(static_cast<int32_t>(fixed32), isMapKey);
+                return true;
+            case FieldDescriptor::TYPE_FLOAT:
+                if (wireType != WireType::WIRETYPE_FIXED32 || !reader.readLittleEndian32(&fixed32)) {
+                    return false;
+                }
+                writeFloatingPoint(WireFormatLite::DecodeFloat(fixed32));
+                return true;
+            case FieldDescriptor::TYPE_FIXED64:
+                if (wireType != WireType::WIRETYPE_FIXED64 || !reader.readLittleEndian64(&fixed64)) {
+                    return false;
+                }
+                writeInteger(fixed64, true);
+                return true;
+            case FieldDescriptor::TYPE_SFIXED64:
+                if (wireType != WireType::WIRETYPE_FIXED64 || !reader.readLittleEndian64(&fixed64)) {
+                    return false;
+                }
+                writeInteger(static_cast<int64_t>(fixed64), true);
+                return true;
+            case FieldDescriptor::TYPE_DOUBLE:
+                if (wireType != WireType::WIRETYPE_FIXED64 || !reader.readLittleEndian64(&fixed64)) {
+                    return false;
+                }
+                writeFloatingPoint(WireFormatLite::DecodeDouble(fixed64));
+                return true;
+            case FieldDescriptor::TYPE_STRING:
+                if (!readLengthDelimited(reader, wireType, data, length)) {
+                    return false;
+                }
+                return writeString(std::string_view(reinterpret_cast<const char*>(data), length));
+            case FieldDescriptor::TYPE_BYTES:
+                if (!readLengthDelimited(reader, wireType, data, length)) {
+                    return false;
+                }
+                _output.push_back('"');
+                _output.append(snap::utils::encoding::binaryToBase64(data, length));
+                _output.push_back('"');
+                return true;
+            case FieldDescriptor::TYPE_MESSAGE:
+                if (!readLengthDelimited(reader, wireType, data, length)) {
+                    return false;
+                }
+                return writeMessage(data, length, *fieldDescriptor.message_type());
+            default:
+                return false;
+        }
+    }
+
+    void writeDefaultValue(const FieldDescriptor& fieldDescriptor, bool isMapKey) {
+        switch (fieldDescriptor.type()) {
+            case FieldDescriptor::TYPE_MESSAGE:
+                _output.append("{}");
+                break;
+            case FieldDescriptor::TYPE_STRING:
+            case FieldDescriptor::TYPE_BYTES:
+                _output.append("\"\"");
+                break;
+            case FieldDescriptor::TYPE_BOOL:
+                _output.append(isMapKey ? "\"false\"" : "false");
+                break;
+            case FieldDescriptor::TYPE_ENUM:
+                writeEnum(fieldDescriptor, fieldDescriptor.default_value_enum()->number());
+                break;
+            case FieldDescriptor::TYPE_INT64:
+            case FieldDescriptor::TYPE_UINT64:
+            case FieldDescriptor::TYPE_SINT64:
+            case FieldDescriptor::TYPE_FIXED64:
+            case FieldDescriptor::TYPE_SFIXED64:
+                _output.append("\"0\"");
+                break;
+            default:
+                _output.append(isMapKey ? "\"0\"" : "0");
+                break;
+        }
+    }
+
+    /**
+     Write the string with quotes, escaping it like the generic converter.
+     Returns false if the string is not valid UTF-8.
+     */
+    bool writeString(std::string_view str) {
+        const auto* current = reinterpret_cast<const unsigned char*>(str.data());
+        const auto* end = current + str.size();
+
+        _output.push_back('"');
+        while (current != end) {
+            const auto* runStart = current;
+            while (current != end && !needsEscape(*current)) {
+                current++;
+            }
+            _output.append(reinterpret_cast<const char*>(runStart), static_cast<size_t>(current - runStart));
+            if (current == end) {
+                break;
+            }
+
+            auto c = *current;
+            uint32_t codePoint = c;
+            size_t length = 1;
+            if (c >= 0x80) {
+                length = decodeUTF8(current, end, codePoint);
+                if (length == 0) {
+                    return false;
+                }
+                if (!needsUnicodeEscape(codePoint)) {
+                    _output.append(reinterpret_cast<const char*>(current), length);
+                    current += length;
+                    continue;
+                }
+            }
+            current += length;
+
+            switch (codePoint) {
+                case '"':
+                    _output.append("\\\"");
+                    break;
+                case '\\':
+                    _output.append("\\\\");
+                    break;
+                case '\b':
+                    _output.append("\\b");
+                    break;
+                case '\f':
+                    _output.append("\\f");
+                    break;
+                case '\n':
+                    _output.append("\\n");
+                    break;
+                case '\r':
+                    _output.append("\\r");
+                    break;
+                case '\t':
+                    _output.append("\\t");
+                    break;
+                default:
+                    writeUnicodeEscape(codePoint);
+                    break;
+            }
+        }
+        _output.push_back('"');
+
+        return true;
+    }
+
+    void writeUnicodeEscape(uint32_t codePoint) {
+        if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            writeUnicodeEscape(0xD800 + (codePoint >> 10));
+            writeUnicodeEscape(0xDC00 + (codePoint & 0x3FF));
+            return;
+        }
+
+        static constexpr char kHexDigits[] = "0123456789abcdef";
+        char escape[6] = {'\\',
+                          'u',
+                          kHexDigits[(codePoint >> 12) & 0xF],
+                          kHexDigits[(codePoint >> 8) & 0xF],
+                          kHexDigits[(codePoint >> 4) & 0xF],
+                          kHexDigits[codePoint & 0xF]};
+        _output.append(escape, sizeof(escape));
+    }
+};
+
+bool JSONCodec::jsonToBinary(std::string_view json, const google::protobuf::Descriptor& descriptor, ByteBuffer& output) {
+    JSONToBinaryConverter converter(json, output);
+    return converter.convert(descriptor);
+}
+
+bool JSONCodec::binaryToJSON(const Byte* data,
+                             size_t length,
+                             const google::protobuf::Descriptor& descriptor,
+                             bool enumsAsInts,
+                             std::string& output) {
+    BinaryToJSONConverter converter(output, enumsAsInts);
+    return converter.writeMessage(data, length, descriptor);
+}
+
+} // namespace Valdi::Protobuf
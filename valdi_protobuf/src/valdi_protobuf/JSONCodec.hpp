@@ -0,0 +1,48 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+
+#include <string>
+#include <string_view>
+
+namespace google::protobuf {
+class Descriptor;
+} // namespace google::protobuf
+
+namespace Valdi::Protobuf {
+
+/**
+ A converter between the Protobuf wire format and the canonical JSON mapping, which
+ resolves fields through the MessageParseTable of each Descriptor and writes its output
+ directly, without going through the generic TypeResolver based converter.
+
+ The codec only handles the common subset of the JSON mapping: well known types, groups,
+ and inputs which are either malformed or not in their canonical form are not handled.
+ The conversion then returns false, and the caller is expected to fall back to the
+ generic converter, which handles them or reports the appropriate error.
+ */
+class JSONCodec {
+public:
+    /**
+     Convert the given JSON object into the wire format of the given message type,
+     appending the encoded message into output. Returns false if the JSON could not
+     be converted, in which case the content of output is unspecified.
+     */
+    static bool jsonToBinary(std::string_view json, const google::protobuf::Descriptor& descriptor, ByteBuffer& output);
+
+    /**
+     Convert the given encoded message into compact JSON, appending it into output.
+     Returns false if the message could not be converted, in which case the content
+     of output is unspecified.
+     */
+    static bool binaryToJSON(const Byte* data,
+                             size_t length,
+                             const google::protobuf::Descriptor& descriptor,
+                             bool enumsAsInts,
+                             std::string& output);
+};
+
+} // namespace Valdi::Protobuf
@@ -3,7 +3,13 @@
 #include "utils/platform/BuildOptions.hpp"
 #include "valdi_core/cpp/Utils/Format.hpp"
 #include "valdi_core/cpp/Utils/LoggerUtils.hpp"
+#include "valdi_protobuf/JSONCodec.hpp"
+#include "valdi_protobuf/MessageParseTable.hpp"
+#include "valdi_protobuf/WireReader.hpp"
+#include "valdi_protobuf/WireWriter.hpp"
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/io/coded_stream.h>
@@ -49,22 +55,40 @@ struct JSONHelper {
     }
 };
 
-Message::Message() = default;
+Message::Message() : _arena(MessageArena::current()) {}
 Message::Message(const google::protobuf::Descriptor* descriptor, const Ref<RefCountable>& dataSource)
-    : _descriptor(descriptor), _dataSource(dataSource) {}
+    : _descriptor(descriptor), _dataSource(dataSource), _arena(MessageArena::current()) {}
 
 Message::~Message() = default;
 
 BytesView Message::encode(bool includeEmptyFields) {
-    auto length = encodedByteSize(includeEmptyFields);
     auto byteBuffer = makeShared<ByteBuffer>();
-    byteBuffer->resize(length);
+    // The size of the last encoding, if any, is a good estimate of the size of this one
+    byteBuffer->reserve(_cachedEncodedByteSize);
 
-    encode(includeEmptyFields, byteBuffer->begin(), byteBuffer->end());
+    WireWriter writer(*byteBuffer);
+    encode(includeEmptyFields, writer);
 
     return byteBuffer->toBytesView();
 }
 
+void Message::encode(bool includeEmptyFields, WireWriter& writer) {
+    auto startPosition = writer.position();
+    const auto* parseTable = getParseTable();
+
+    _fieldMap.forEachSorted([&](const FieldMap::Entry& entry) {
+        const auto* encodedField = parseTable != nullptr ? parseTable->findEncodedField(entry.number) : nullptr;
+        if (VALDI_LIKELY(encodedField != nullptr)) {
+            entry.value->write(*encodedField, includeEmptyFields, includeEmptyFields, writer);
+        } else {
+            entry.value->write(
+                MessageParseTable::EncodedField::unknown(entry.number), includeEmptyFields, includeEmptyFields, writer);
+        }
+    });
+
+    _cachedEncodedByteSize = writer.position() - startPosition;
+}
+
 Byte* Message::encode(bool includeEmptyFields, Byte* bufferStart, Byte* bufferEnd) const {
     _fieldMap.forEachSorted([&](const FieldMap::Entry& entry) {
         bufferStart = entry.value->write(entry.number, includeEmptyFields, includeEmptyFields, bufferStart, bufferEnd);
@@ -191,6 +215,10 @@ const Ref<RefCountable>& Message::getDataSource() const {
     return _dataSource;
 }
 
+const Ref<MessageArena>& Message::getArena() const {
+    return _arena;
+}
+
 const google::protobuf::Descriptor* Message::getDescriptor() const {
     return _descriptor;
 }
@@ -203,6 +231,16 @@ std::string Message::toJSON(const JSONPrintOptions& options, ExceptionTracker& e
 
     auto encoded = encode(options.alwaysPrintPrimitiveFields);
 
+    // The JSONCodec only writes compact JSON, and only prints the fields which are set
+    if (!options.pretty && !options.alwaysPrintPrimitiveFields) {
+        std::string output;
+        output.reserve(encoded.size() * 2 + 2);
+        if (JSONCodec::binaryToJSON(
+                encoded.data(), encoded.size(), *_descriptor, options.alwaysPrintEnumsAsInts, output)) {
+            return output;
+        }
+    }
+
     JSONHelper jsonHelper(_descriptor, encoded.data(), encoded.size());
 
     auto outputOptions = google::protobuf::util::JsonPrintOptions();
@@ -227,21 +265,27 @@ bool Message::decodeFromJSON(std::string_view json, ExceptionTracker& exceptionT
         return false;
     }
 
-    JSONHelper jsonHelper(_descriptor, reinterpret_cast<const Byte*>(json.data()), json.size());
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->reserve(json.size());
+
+    // Inputs which the JSONCodec doesn't handle go through the generic converter,
+    // which also reports the errors
+    if (!JSONCodec::jsonToBinary(json, *_descriptor, *buffer)) {
+        JSONHelper jsonHelper(_descriptor, reinterpret_cast<const Byte*>(json.data()), json.size());
+
+        auto result = google::protobuf::util::JsonToBinaryStream(jsonHelper.typeResolver,
+                                                                 jsonHelper.typeUrl,
+                                                                 &jsonHelper.inputStream,
+                                                                 &jsonHelper.outputStream,
+                                                                 google::protobuf::util::JsonParseOptions());
+        if (!result.ok()) {
+            exceptionTracker.onError(result.message().ToString());
+            return false;
+        }
 
-    auto result = google::protobuf::util::JsonToBinaryStream(jsonHelper.typeResolver,
-                                                             jsonHelper.typeUrl,
-                                                             &jsonHelper.inputStream,
-                                                             &jsonHelper.outputStream,
-                                                             google::protobuf::util::JsonParseOptions());
-    if (!result.ok()) {
-        exceptionTracker.onError(result.message().ToString());
-        return false;
+        buffer->set(reinterpret_cast<const Byte*>(jsonHelper.output.data()),
+                    reinterpret_cast<const Byte*>(jsonHelper.output.data() + jsonHelper.output.size()));
     }
-
-    auto buffer = makeShared<ByteBuffer>();
-    buffer->set(reinterpret_cast<const Byte*>(jsonHelper.output.data()),
-                reinterpret_cast<const Byte*>(jsonHelper.output.data() + jsonHelper.output.size()));
     _dataSource = buffer;
 
     return decode(buffer->data(), buffer->size(), exceptionTracker);
@@ -249,6 +293,7 @@ bool Message::decodeFromJSON(std::string_view json, ExceptionTracker& exceptionT
 
 Ref<Message> Message::clone() const {
     auto out = makeShared<Message>(_descriptor, _dataSource);
+    out->_parseTable = _parseTable;
     out->_fieldMap = _fieldMap;
     _fieldMap.forEach([&](const auto& it) { out->_fieldMap[it.number] = it.value->clone(); });
 
@@ -272,6 +317,25 @@ Result<Ref<Message>> Message::parse(const BytesView& bytes, const google::protob
     return exceptionTracker.toResult(parse(bytes, descriptor, exceptionTracker));
 }
 
+Ref<Message> Message::parseInArena(const BytesView& bytes,
+                                   const google::protobuf::Descriptor* descriptor,
+                                   ExceptionTracker& exceptionTracker) {
+    auto arena = makeShared<MessageArena>();
+    MessageArena::Scope scope(arena.get());
+
+    auto out = makeShared<Message>(descriptor, bytes.getSource());
+    if (!out->decode(bytes.data(), bytes.size(), exceptionTracker)) {
+        return nullptr;
+    }
+
+    if (!out->postprocess(true, exceptionTracker)) {
+        return nullptr;
+    }
+
+    // The arena is now retained by the objects that were allocated in it
+    return out;
+}
+
 Ref<Message> Message::parseFromJSON(std::string_view json,
                                     const google::protobuf::Descriptor* descriptor,
                                     ExceptionTracker& exceptionTracker) {
@@ -315,11 +379,46 @@ bool Message::onDecodeError(
     return false;
 }
 
+const MessageParseTable* Message::getParseTable() {
+    if (_parseTable == nullptr && _descriptor != nullptr) {
+        _parseTable = &MessageParseTable::get(*_descriptor);
+    }
+    return _parseTable;
+}
+
 bool Message::decode(const Byte* data, size_t length, ExceptionTracker& exceptionTracker) {
-    google::protobuf::io::CodedInputStream inputStream(data, static_cast<int>(length));
+    MessageArena::Scope arenaScope(_arena.get());
+    WireReader inputStream(data, length);
+
+    const auto* parseTable = getParseTable();
+    if (parseTable != nullptr) {
+        _fieldMap.reserve(parseTable->getMaxFieldNumber());
+    }
+
+    // Unpacked repeated fields are encoded as consecutive entries with the same field number,
+    // the repeated field of the last field number is kept around so that each entry can be
+    // appended without looking up the field again.
+    FieldNumber lastFieldNumber = 0;
+    RepeatedField* lastRepeatedField = nullptr;
+    auto appendField = [&](FieldNumber fieldNumber, Field field) {
+        if (fieldNumber == lastFieldNumber && lastRepeatedField != nullptr) {
+            lastRepeatedField->append(std::move(field));
+            return;
+        }
+
+        auto& it = getOrCreateField(fieldNumber);
+        if (it.isUnset()) {
+            it = std::move(field);
+            lastRepeatedField = nullptr;
+        } else {
+            lastRepeatedField = it.toRepeated();
+            lastRepeatedField->append(std::move(field));
+        }
+        lastFieldNumber = fieldNumber;
+    };
 
     for (;;) {
-        auto tag = inputStream.ReadTag();
+        auto tag = inputStream.readTag();
         if (tag == 0) {
             break;
         }
@@ -329,7 +428,7 @@ bool Message::decode(const Byte* data, size_t length, ExceptionTracker& exceptio
         switch (wireType) {
             case WireType::WIRETYPE_VARINT:
                 uint64_t varint;
-                if (!inputStream.ReadVarint64(&varint)) {
+                if (!inputStream.readVarint64(&varint)) {
                     return onDecodeError("Unable to read varint", fieldNumber, data, length, exceptionTracker);
                 }
 
@@ -337,7 +436,7 @@ bool Message::decode(const Byte* data, size_t length, ExceptionTracker& exceptio
                 break;
             case WireType::WIRETYPE_FIXED64:
                 uint64_t fixed64;
-                if (!inputStream.ReadLittleEndian64(&fixed64)) {
+                if (!inputStream.readLittleEndian64(&fixed64)) {
                     return onDecodeError("Unable to read fixed64", fieldNumber, data, length, exceptionTracker);
                 }
 
@@ -345,34 +444,24 @@ bool Message::decode(const Byte* data, size_t length, ExceptionTracker& exceptio
                 break;
             case WireType::WIRETYPE_LENGTH_DELIMITED: {
                 uint32_t innerLength;
-                if (!inputStream.ReadVarint32(&innerLength)) {
+                if (!inputStream.readVarint32(&innerLength)) {
                     return onDecodeError("Unable to read varint32", fieldNumber, data, length, exceptionTracker);
                 }
 
-                if (innerLength > 0) {
-                    const void* dataPtr;
-                    int sizeToEndOfBuffer;
-                    if (!inputStream.GetDirectBufferPointer(&dataPtr, &sizeToEndOfBuffer)) {
-                        return onDecodeError(
-                            "Unable to get direct buffer", fieldNumber, data, length, exceptionTracker);
-                    }
-
-                    if (!inputStream.Skip(static_cast<int>(innerLength))) {
-                        return onDecodeError(
-                            "Out of bounds length delimited", fieldNumber, data, length, exceptionTracker);
-                    }
-
-                    appendField(fieldNumber, Field::raw(reinterpret_cast<const Byte*>(dataPtr), innerLength));
-                } else {
-                    appendField(fieldNumber, Field::raw(&data[static_cast<size_t>(inputStream.CurrentPosition())], 0));
+                const auto* dataPtr = inputStream.current();
+                if (!inputStream.skip(innerLength)) {
+                    return onDecodeError(
+                        "Out of bounds length delimited", fieldNumber, data, length, exceptionTracker);
                 }
+
+                appendField(fieldNumber, Field::raw(dataPtr, innerLength));
             } break;
             case WireType::WIRETYPE_START_GROUP:
             case WireType::WIRETYPE_END_GROUP:
                 return onDecodeError("group wiretype are not supported", fieldNumber, data, length, exceptionTracker);
             case WireType::WIRETYPE_FIXED32:
                 uint32_t fixed32;
-                if (!inputStream.ReadLittleEndian32(&fixed32)) {
+                if (!inputStream.readLittleEndian32(&fixed32)) {
                     return onDecodeError("Unable to read fixed32", fieldNumber, data, length, exceptionTracker);
                 }
 
@@ -383,7 +472,7 @@ bool Message::decode(const Byte* data, size_t length, ExceptionTracker& exceptio
         }
     }
 
-    if (!inputStream.ExpectAtEnd()) {
+    if (!inputStream.isAtEnd()) {
         exceptionTracker.onError(Error("Invalid end of stream"));
         return false;
     }
@@ -394,19 +483,15 @@ bool Message::decode(const Byte* data, size_t length, ExceptionTracker& exceptio
 }
 
 bool Message::populateFieldFlags() {
-    if (_descriptor == nullptr) {
+    const auto* parseTable = getParseTable();
+    if (parseTable == nullptr) {
         return false;
     }
-    auto oneOfCount = _descriptor->oneof_decl_count();
-    for (int i = 0; i < oneOfCount; i++) {
-        const auto* oneOfFieldDescriptor = _descriptor->oneof_decl(i);
-        auto fieldsCount = oneOfFieldDescriptor->field_count();
-        for (int j = 0; j < fieldsCount; j++) {
-            const auto* field = oneOfFieldDescriptor->field(j);
-            auto* fieldValue = getField(static_cast<Protobuf::FieldNumber>(field->number()));
-            if (fieldValue != nullptr) {
-                fieldValue->setIsOneOf(true);
-            }
+
+    for (auto fieldNumber : parseTable->getOneOfFieldNumbers()) {
+        auto* fieldValue = getField(fieldNumber);
+        if (fieldValue != nullptr) {
+            fieldValue->setIsOneOf(true);
         }
     }
 
@@ -422,20 +507,25 @@ static bool onPopulateFieldError(const google::protobuf::FieldDescriptor& fieldD
 
 bool Message::postprocessForField(const google::protobuf::FieldDescriptor& fieldDescriptor,
                                   Field& fieldValue,
-                                  bool recursive,
+                                  PostprocessMode mode,
                                   IMessageFactory& messageFactory,
                                   ExceptionTracker& exceptionTracker) {
     for (;;) {
         auto internalFieldType = fieldValue.getInternalType();
 
         if (internalFieldType == Field::InternalType::Raw) {
+            if (mode == PostprocessMode::Lazy) {
+                // The bytes are kept as is until the message is accessed
+                return true;
+            }
+
             auto raw = fieldValue.getRaw();
             auto childMessage = messageFactory.newMessage(fieldDescriptor.message_type(), _dataSource);
             if (!childMessage->decode(raw.data, raw.length, exceptionTracker)) {
                 return onPopulateFieldError(fieldDescriptor, "Failed to decode", exceptionTracker);
             }
 
-            if (recursive) {
+            if (mode == PostprocessMode::Recursive) {
                 if (!childMessage->postprocess(true, messageFactory, exceptionTracker)) {
                     return onPopulateFieldError(fieldDescriptor, "Failed to populate child messages", exceptionTracker);
                 }
@@ -457,7 +547,7 @@ bool Message::postprocessForField(const google::protobuf::FieldDescriptor& field
                 return onPopulateFieldError(fieldDescriptor, "Expected message type", exceptionTracker);
             }
 
-            if (recursive) {
+            if (mode == PostprocessMode::Recursive) {
                 if (!childMessage->postprocess(true, exceptionTracker)) {
                     return onPopulateFieldError(fieldDescriptor, "Failed to populate child messages", exceptionTracker);
                 }
@@ -476,22 +566,31 @@ bool Message::postprocess(bool recursive, ExceptionTracker& exceptionTracker) {
 }
 
 bool Message::postprocess(bool recursive, IMessageFactory& messageFactory, ExceptionTracker& exceptionTracker) {
-    if (_descriptor == nullptr) {
+    return postprocess(
+        recursive ? PostprocessMode::Recursive : PostprocessMode::Shallow, messageFactory, exceptionTracker);
+}
+
+bool Message::postprocessLazily(ExceptionTracker& exceptionTracker) {
+    DefaultMessageFactory messageFactory;
+    return postprocess(PostprocessMode::Lazy, messageFactory, exceptionTracker);
+}
+
+bool Message::postprocess(PostprocessMode mode, IMessageFactory& messageFactory, ExceptionTracker& exceptionTracker) {
+    MessageArena::Scope arenaScope(_arena.get());
+
+    const auto* parseTable = getParseTable();
+    if (parseTable == nullptr) {
         exceptionTracker.onError("Cannot postprocess Message without a Descriptor set");
         return false;
     }
 
-    auto fieldCount = _descriptor->field_count();
-    for (int i = 0; i < fieldCount; i++) {
-        const auto& fieldDescriptor = *_descriptor->field(i);
-        auto isRepeated = fieldDescriptor.is_repeated();
-        auto isMessage = fieldDescriptor.cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE;
-        if (!(isRepeated || isMessage)) {
-            // Standard field that doesn't need to be processed
-            continue;
-        }
+    // Only the repeated and message fields need to be processed
+    for (const auto& postprocessedField : parseTable->getPostprocessedFields()) {
+        const auto& fieldDescriptor = *postprocessedField.descriptor;
+        auto isRepeated = postprocessedField.isRepeated;
+        auto isMessage = postprocessedField.isMessage;
 
-        auto* it = _fieldMap.find(static_cast<size_t>(fieldDescriptor.number()));
+        auto* it = _fieldMap.find(postprocessedField.number);
         if (it == nullptr) {
             continue;
         }
@@ -504,19 +603,396 @@ bool Message::postprocess(bool recursive, IMessageFactory& messageFactory, Excep
             if (isMessage) {
                 for (auto& repeatedFieldValue : *repeated) {
                     if (!postprocessForField(
-                            fieldDescriptor, repeatedFieldValue, recursive, messageFactory, exceptionTracker)) {
+                            fieldDescriptor, repeatedFieldValue, mode, messageFactory, exceptionTracker)) {
                         return false;
                     }
                 }
             }
         } else {
-            if (!postprocessForField(fieldDescriptor, fieldValue, recursive, messageFactory, exceptionTracker)) {
+            if (!postprocessForField(fieldDescriptor, fieldValue, mode, messageFactory, exceptionTracker)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+const google::protobuf::FieldDescriptor* Message::getMessageFieldDescriptor(FieldNumber fieldNumber,
+                                                                            ExceptionTracker& exceptionTracker) const {
+    if (_descriptor == nullptr) {
+        exceptionTracker.onError("Cannot resolve nested Message without a Descriptor set");
+        return nullptr;
+    }
+
+    const auto* fieldDescriptor = _descriptor->FindFieldByNumber(static_cast<int>(fieldNumber));
+    if (fieldDescriptor == nullptr ||
+        fieldDescriptor->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+        exceptionTracker.onError(fmt::format(
+            "Field number {} of message type '{}' is not a message field", fieldNumber, _descriptor->full_name()));
+        return nullptr;
+    }
+
+    return fieldDescriptor;
+}
+
+static Message* resolveLazyMessage(const google::protobuf::FieldDescriptor& fieldDescriptor,
+                                   Field& fieldValue,
+                                   const Ref<RefCountable>& dataSource,
+                                   IMessageFactory& messageFactory,
+                                   ExceptionTracker& exceptionTracker) {
+    if (fieldValue.getInternalType() != Field::InternalType::Raw) {
+        auto* childMessage = fieldValue.getMessage();
+        if (childMessage == nullptr) {
+            onPopulateFieldError(fieldDescriptor, "Expected message type", exceptionTracker);
+        }
+        return childMessage;
+    }
+
+    auto raw = fieldValue.getRaw();
+    auto childMessage = messageFactory.newMessage(fieldDescriptor.message_type(), dataSource);
+    if (!childMessage->decode(raw.data, raw.length, exceptionTracker) ||
+        !childMessage->postprocessLazily(exceptionTracker)) {
+        onPopulateFieldError(fieldDescriptor, "Failed to decode", exceptionTracker);
+        return nullptr;
+    }
+
+    fieldValue.setMessage(childMessage.get());
+    return childMessage.get();
+}
+
+Message* Message::getMessage(FieldNumber fieldNumber,
+                             IMessageFactory& messageFactory,
+                             ExceptionTracker& exceptionTracker) {
+    auto* fieldValue = getField(fieldNumber);
+    if (fieldValue == nullptr) {
+        return nullptr;
+    }
+
+    const auto* fieldDescriptor = getMessageFieldDescriptor(fieldNumber, exceptionTracker);
+    if (fieldDescriptor == nullptr) {
+        return nullptr;
+    }
+
+    const auto* repeated = fieldValue->getRepeated();
+    if (repeated != nullptr) {
+        if (fieldDescriptor->is_repeated()) {
+            onPopulateFieldError(*fieldDescriptor, "Expected non repeated field", exceptionTracker);
+            return nullptr;
+        }
+        // The last occurrence of a non repeated field wins
+        *fieldValue = repeated->last();
+    }
+
+    MessageArena::Scope arenaScope(_arena.get());
+    return resolveLazyMessage(*fieldDescriptor, *fieldValue, _dataSource, messageFactory, exceptionTracker);
+}
+
+Message* Message::getMessage(FieldNumber fieldNumber, ExceptionTracker& exceptionTracker) {
+    DefaultMessageFactory messageFactory;
+    return getMessage(fieldNumber, messageFactory, exceptionTracker);
+}
+
+Message* Message::getMessageAt(FieldNumber fieldNumber,
+                               size_t index,
+                               IMessageFactory& messageFactory,
+                               ExceptionTracker& exceptionTracker) {
+    auto* fieldValue = getField(fieldNumber);
+    if (fieldValue == nullptr) {
+        exceptionTracker.onError(fmt::format("Field number {} is not set", fieldNumber));
+        return nullptr;
+    }
+
+    const auto* fieldDescriptor = getMessageFieldDescriptor(fieldNumber, exceptionTracker);
+    if (fieldDescriptor == nullptr) {
+        return nullptr;
+    }
+
+    auto* repeated = fieldValue->getRepeated();
+    auto size = repeated != nullptr ? repeated->size() : 1;
+    if (index >= size) {
+        exceptionTracker.onError(
+            fmt::format("Index {} is out of bounds of field number {} with {} entries", index, fieldNumber, size));
+        return nullptr;
+    }
+
+    auto& entry = repeated != nullptr ? (*repeated)[index] : *fieldValue;
+
+    MessageArena::Scope arenaScope(_arena.get());
+    return resolveLazyMessage(*fieldDescriptor, entry, _dataSource, messageFactory, exceptionTracker);
+}
+
+Message* Message::getMessageAt(FieldNumber fieldNumber, size_t index, ExceptionTracker& exceptionTracker) {
+    DefaultMessageFactory messageFactory;
+    return getMessageAt(fieldNumber, index, messageFactory, exceptionTracker);
+}
+
+MessageParseTable::EncodedField Message::getEncodedField(FieldNumber fieldNumber) const {
+    if (_descriptor != nullptr) {
+        const auto* parseTable = _parseTable != nullptr ? _parseTable : &MessageParseTable::get(*_descriptor);
+        const auto* encodedField = parseTable->findEncodedField(fieldNumber);
+        if (encodedField != nullptr) {
+            return *encodedField;
+        }
+    }
+    return MessageParseTable::EncodedField::unknown(fieldNumber);
+}
+
+static std::vector<FieldNumber> unionOfFieldNumbers(const Message& lhs, const Message& rhs) {
+    auto lhsFieldNumbers = lhs.sortedFieldNumbers();
+    auto rhsFieldNumbers = rhs.sortedFieldNumbers();
+
+    std::vector<FieldNumber> output;
+    output.reserve(std::max(lhsFieldNumbers.size(), rhsFieldNumbers.size()));
+    std::set_union(lhsFieldNumbers.begin(),
+                   lhsFieldNumbers.end(),
+                   rhsFieldNumbers.begin(),
+                   rhsFieldNumbers.end(),
+                   std::back_inserter(output));
+    return output;
+}
+
+static bool isSingularMessageField(const MessageParseTable::EncodedField& encodedField) {
+    return encodedField.kind == MessageParseTable::EncodedFieldKind::Message && !encodedField.isRepeated;
+}
+
+struct FieldComparator {
+    ByteBuffer lhsBuffer;
+    ByteBuffer rhsBuffer;
+
+    bool isEqual(const MessageParseTable::EncodedField& encodedField, const Field* lhs, const Field* rhs) {
+        if (lhs == rhs) {
+            return true;
+        }
+
+        if (lhs != nullptr && rhs != nullptr && isSingularMessageField(encodedField)) {
+            const auto* lhsMessage = lhs->getMessage();
+            const auto* rhsMessage = rhs->getMessage();
+            if (lhsMessage != nullptr && rhsMessage != nullptr) {
+                return lhsMessage == rhsMessage || lhsMessage->isEqual(*rhsMessage);
+            }
+        }
+
+        // Nested messages which are still encoded, repeated and scalar fields are
+        // compared through their encoded bytes
+        encode(encodedField, lhs, lhsBuffer);
+        encode(encodedField, rhs, rhsBuffer);
+
+        return lhsBuffer.size() == rhsBuffer.size() &&
+               std::memcmp(lhsBuffer.data(), rhsBuffer.data(), lhsBuffer.size()) == 0;
+    }
+
+private:
+    static void encode(const MessageParseTable::EncodedField& encodedField, const Field* field, ByteBuffer& output) {
+        output.clear();
+        if (field != nullptr) {
+            WireWriter writer(output);
+            field->write(encodedField, false, false, writer);
+        }
+    }
+};
+
+bool Message::isEqual(const Message& other) const {
+    if (this == &other) {
+        return true;
+    }
+
+    FieldComparator comparator;
+    for (auto fieldNumber : unionOfFieldNumbers(*this, other)) {
+        if (!comparator.isEqual(getEncodedField(fieldNumber), getField(fieldNumber), other.getField(fieldNumber))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<FieldNumber> Message::diff(const Message& other) const {
+    std::vector<FieldNumber> changedFieldNumbers;
+    if (this == &other) {
+        return changedFieldNumbers;
+    }
+
+    FieldComparator comparator;
+    for (auto fieldNumber : unionOfFieldNumbers(*this, other)) {
+        if (!comparator.isEqual(getEncodedField(fieldNumber), getField(fieldNumber), other.getField(fieldNumber))) {
+            changedFieldNumbers.emplace_back(fieldNumber);
+        }
+    }
+
+    return changedFieldNumbers;
+}
+
+std::vector<FieldNumber> Message::shareUnchangedMessages(const Message& previous) {
+    std::vector<FieldNumber> changedFieldNumbers;
+    if (this == &previous) {
+        return changedFieldNumbers;
+    }
+
+    FieldComparator comparator;
+    for (auto fieldNumber : unionOfFieldNumbers(*this, previous)) {
+        auto encodedField = getEncodedField(fieldNumber);
+        auto* field = getField(fieldNumber);
+        const auto* previousField = previous.getField(fieldNumber);
+
+        if (field == nullptr || previousField == nullptr || !isSingularMessageField(encodedField)) {
+            if (!comparator.isEqual(encodedField, field, previousField)) {
+                changedFieldNumbers.emplace_back(fieldNumber);
+            }
+            continue;
+        }
+
+        auto* message = field->getMessage();
+        auto* previousMessage = previousField->getMessage();
+        if (previousMessage == nullptr) {
+            // Nothing to share with if the previous version was never decoded
+            if (!comparator.isEqual(encodedField, field, previousField)) {
+                changedFieldNumbers.emplace_back(fieldNumber);
+            }
+            continue;
+        }
+
+        bool changed;
+        if (message != nullptr) {
+            changed = !message->shareUnchangedMessages(*previousMessage).empty();
+        } else {
+            changed = !comparator.isEqual(encodedField, field, previousField);
+        }
+
+        if (changed) {
+            changedFieldNumbers.emplace_back(fieldNumber);
+        } else if (message != previousMessage) {
+            *field = *previousField;
+        }
+    }
+
+    return changedFieldNumbers;
+}
+
+/**
+ The data source of a message to which a patch was applied, which retains both the data
+ source of the message and the one of the patch, which copied raw fields point into.
+ */
+class PatchedDataSource : public SimpleRefCountable {
+public:
+    PatchedDataSource(const Ref<RefCountable>& dataSource, const Ref<RefCountable>& patchDataSource)
+        : _dataSource(dataSource), _patchDataSource(patchDataSource) {}
+    ~PatchedDataSource() override = default;
+
+private:
+    Ref<RefCountable> _dataSource;
+    Ref<RefCountable> _patchDataSource;
+};
+
+bool Message::applyPatchForPath(Message& patch,
+                                std::string_view path,
+                                IMessageFactory& messageFactory,
+                                ExceptionTracker& exceptionTracker) {
+    if (_descriptor == nullptr) {
+        exceptionTracker.onError("Cannot apply a patch without a Descriptor set");
+        return false;
+    }
+
+    auto separator = path.find('.');
+    auto fieldName = path.substr(0, separator);
+    const auto* fieldDescriptor = _descriptor->FindFieldByName(std::string(fieldName));
+    if (fieldDescriptor == nullptr) {
+        exceptionTracker.onError(
+            fmt::format("Unknown field '{}' in message type '{}'", fieldName, _descriptor->full_name()));
+        return false;
+    }
+
+    auto fieldNumber = static_cast<FieldNumber>(fieldDescriptor->number());
+    Field patchedField;
+
+    if (separator == std::string_view::npos) {
+        const auto* patchField = patch.getField(fieldNumber);
+        if (patchField == nullptr) {
+            clearField(fieldNumber);
+            return true;
+        }
+
+        patchedField = patchField->clone();
+        if (patch._dataSource != nullptr && patch._dataSource != _dataSource) {
+            _dataSource = makeShared<PatchedDataSource>(_dataSource, patch._dataSource);
+        }
+    } else {
+        if (fieldDescriptor->is_repeated() ||
+            fieldDescriptor->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+            exceptionTracker.onError(fmt::format("Field '{}' of message type '{}' is not a singular message field",
+                                                 fieldName,
+                                                 _descriptor->full_name()));
+            return false;
+        }
+
+        Ref<Message> emptyPatchMessage;
+        Message* patchMessage = nullptr;
+        if (patch.getField(fieldNumber) != nullptr) {
+            patchMessage = patch.getMessage(fieldNumber, messageFactory, exceptionTracker);
+            if (patchMessage == nullptr) {
+                return false;
+            }
+        } else {
+            emptyPatchMessage = messageFactory.newMessage(fieldDescriptor->message_type(), nullptr);
+            patchMessage = emptyPatchMessage.get();
+        }
+
+        // The nested message is copied, it might be shared with other versions of the message
+        Ref<Message> message;
+        if (getField(fieldNumber) != nullptr) {
+            const auto* existingMessage = getMessage(fieldNumber, messageFactory, exceptionTracker);
+            if (existingMessage == nullptr) {
                 return false;
             }
+            message = messageFactory.newMessage(existingMessage->_descriptor, existingMessage->_dataSource);
+            message->_parseTable = existingMessage->_parseTable;
+            message->_fieldMap = existingMessage->_fieldMap;
+        } else {
+            message = messageFactory.newMessage(fieldDescriptor->message_type(), nullptr);
+        }
+
+        if (!message->applyPatchForPath(*patchMessage, path.substr(separator + 1), messageFactory, exceptionTracker)) {
+            return false;
         }
+
+        patchedField = Field::message(message);
     }
 
+    const auto* oneOf = fieldDescriptor->real_containing_oneof();
+    if (oneOf != nullptr) {
+        for (int i = 0; i < oneOf->field_count(); i++) {
+            clearField(static_cast<FieldNumber>(oneOf->field(i)->number()));
+        }
+        patchedField.setIsOneOf(true);
+    }
+
+    getOrCreateField(fieldNumber) = std::move(patchedField);
     return true;
 }
 
+bool Message::applyPatch(Message& patch,
+                         const std::vector<std::string>& paths,
+                         IMessageFactory& messageFactory,
+                         ExceptionTracker& exceptionTracker) {
+    if (patch._descriptor != _descriptor) {
+        exceptionTracker.onError("Cannot apply a patch of a different message type");
+        return false;
+    }
+
+    for (const auto& path : paths) {
+        if (!applyPatchForPath(patch, path, messageFactory, exceptionTracker)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Message::applyPatch(Message& patch,
+                         const std::vector<std::string>& paths,
+                         ExceptionTracker& exceptionTracker) {
+    DefaultMessageFactory messageFactory;
+    return applyPatch(patch, paths, messageFactory, exceptionTracker);
+}
+
 } // namespace Valdi::Protobuf
@@ -9,6 +9,7 @@
 #include "valdi_protobuf/Field.hpp"
 #include "valdi_protobuf/FieldMap.hpp"
 #include "valdi_protobuf/FieldNumber.hpp"
+#include "valdi_protobuf/MessageArena.hpp"
 #include "valdi_protobuf/RepeatedField.hpp"
 #include "valdi_protobuf/RepeatedFieldIterator.hpp"
 
@@ -26,6 +27,8 @@ class FieldDescriptor;
 namespace Valdi::Protobuf {
 
 class IMessageFactory;
+class MessageParseTable;
+class WireWriter;
 
 struct JSONPrintOptions {
     // Whether to add spaces, line breaks and indentation to make the JSON output
@@ -46,7 +49,7 @@ struct JSONPrintOptions {
  bytes. This implementation is designed to offer the best performance possible
  in an entirely reflection based environment.
  */
-class Message : public SimpleRefCountable {
+class Message : public SimpleRefCountable, public ArenaAllocatable {
 public:
     Message();
     Message(const google::protobuf::Descriptor* descriptor, const Ref<RefCountable>& dataSource);
@@ -55,7 +58,18 @@ public:
     size_t encodedByteSize(bool includeEmptyFields = false);
     size_t getCachedEncodedByteSize() const;
 
+    /**
+     Encode the message in a single pass into a new buffer, using the serialization plan
+     of its Descriptor. The encoded byte size of the message and its nested messages are
+     cached as part of the encoding.
+     */
     BytesView encode(bool includeEmptyFields = false);
+    void encode(bool includeEmptyFields, WireWriter& writer);
+
+    /**
+     Encode the message into the given buffer, which must be at least as large as
+     the byte size last returned by encodedByteSize().
+     */
     Byte* encode(bool includeEmptyFields, Byte* bufferStart, Byte* bufferEnd) const;
 
     bool decode(const Byte* data, size_t length, ExceptionTracker& exceptionTracker);
@@ -88,6 +102,13 @@ public:
 
     const Ref<RefCountable>& getDataSource() const;
 
+    /**
+     Return the arena in which the message was created, if any. The nested messages
+     and repeated fields created while decoding or postprocessing the message are
+     allocated in the same arena.
+     */
+    const Ref<MessageArena>& getArena() const;
+
     /**
      Postprocess will validate the parsed Message and transform Message fields from raw bytes into Message objects.
      If recursive is true, nested messages will also be postprocessed.
@@ -100,6 +121,62 @@ public:
      */
     bool postprocess(bool recursive, ExceptionTracker& exceptionTracker);
 
+    /**
+     Postprocess the message without decoding its nested messages. Message fields are kept
+     as raw bytes until they are first accessed through getMessage() or getMessageAt().
+     Nested messages which are never accessed are re-encoded byte for byte.
+     */
+    bool postprocessLazily(ExceptionTracker& exceptionTracker);
+
+    /**
+     Return the nested message stored in the given field, decoding and lazily postprocessing
+     it from its raw bytes on first access. Returns nullptr if the field is not set or
+     if the nested message failed to decode.
+     */
+    Message* getMessage(FieldNumber fieldNumber, IMessageFactory& messageFactory, ExceptionTracker& exceptionTracker);
+    Message* getMessage(FieldNumber fieldNumber, ExceptionTracker& exceptionTracker);
+
+    /**
+     Return the nested message at the given index of a repeated message field, decoding and
+     lazily postprocessing it from its raw bytes on first access.
+     */
+    Message* getMessageAt(FieldNumber fieldNumber,
+                          size_t index,
+                          IMessageFactory& messageFactory,
+                          ExceptionTracker& exceptionTracker);
+    Message* getMessageAt(FieldNumber fieldNumber, size_t index, ExceptionTracker& exceptionTracker);
+
+    /**
+     Compare the message with another message of the same type, field by field, and return
+     the numbers of the fields whose value differ, sorted. Fields are compared through their
+     encoded value, such that a field set to its default value is equal to an unset field.
+     Nested messages which are decoded on both sides are compared recursively.
+     */
+    std::vector<FieldNumber> diff(const Message& other) const;
+    bool isEqual(const Message& other) const;
+
+    /**
+     Compare the message with a previous version of it, and replace the nested messages
+     which did not change by the ones of the previous version, recursively, such that the
+     untouched subtrees are shared by reference between both versions. Returns the numbers
+     of the fields which changed, sorted. Repeated fields are compared as a whole.
+     */
+    std::vector<FieldNumber> shareUnchangedMessages(const Message& previous);
+
+    /**
+     Apply a patch in place: each field designated by the given paths, which are dot separated
+     field names like in a google.protobuf.FieldMask, is replaced by its value in the patch, or
+     cleared if the patch doesn't have it. The nested messages along a path are copied before
+     being modified, such that messages shared with other versions are left untouched.
+     The message retains the data of the patch, whose nested messages along the paths are
+     decoded. Returns false if a path is invalid.
+     */
+    bool applyPatch(Message& patch,
+                    const std::vector<std::string>& paths,
+                    IMessageFactory& messageFactory,
+                    ExceptionTracker& exceptionTracker);
+    bool applyPatch(Message& patch, const std::vector<std::string>& paths, ExceptionTracker& exceptionTracker);
+
     const google::protobuf::Descriptor* getDescriptor() const;
 
     std::string toJSON(const JSONPrintOptions& options, ExceptionTracker& exceptionTracker);
@@ -109,6 +186,15 @@ public:
                               ExceptionTracker& exceptionTracker);
     static Result<Ref<Message>> parse(const BytesView& bytes, const google::protobuf::Descriptor* descriptor);
 
+    /**
+     Parse the message and eagerly postprocess its entire tree into a single MessageArena,
+     which is freed in bulk once the returned message and all the nested messages that
+     were retained from it are destroyed.
+     */
+    static Ref<Message> parseInArena(const BytesView& bytes,
+                                     const google::protobuf::Descriptor* descriptor,
+                                     ExceptionTracker& exceptionTracker);
+
     static Ref<Message> parseFromJSON(std::string_view json,
                                       const google::protobuf::Descriptor* descriptor,
                                       ExceptionTracker& exceptionTracker);
@@ -120,21 +206,43 @@ public:
 private:
     const google::protobuf::Descriptor* _descriptor = nullptr;
     Ref<RefCountable> _dataSource;
+    Ref<MessageArena> _arena;
+    const MessageParseTable* _parseTable = nullptr;
     FieldMap _fieldMap;
     size_t _cachedEncodedByteSize = 0;
 
     friend Message;
 
+    const MessageParseTable* getParseTable();
+
     bool populateFieldFlags();
 
     bool onDecodeError(
         std::string_view message, int fieldNumber, const Byte* data, size_t length, ExceptionTracker& exceptionTracker);
 
+    enum class PostprocessMode {
+        Shallow,
+        Recursive,
+        Lazy,
+    };
+
+    bool postprocess(PostprocessMode mode, IMessageFactory& messageFactory, ExceptionTracker& exceptionTracker);
+
     bool postprocessForField(const google::protobuf::FieldDescriptor& fieldDescriptor,
                              Field& fieldValue,
-                             bool recursive,
+                             PostprocessMode mode,
                              IMessageFactory& messageFactory,
                              ExceptionTracker& exceptionTracker);
+
+    MessageParseTable::EncodedField getEncodedField(FieldNumber fieldNumber) const;
+
+    bool applyPatchForPath(Message& patch,
+                           std::string_view path,
+                           IMessageFactory& messageFactory,
+                           ExceptionTracker& exceptionTracker);
+
+    const google::protobuf::FieldDescriptor* getMessageFieldDescriptor(FieldNumber fieldNumber,
+                                                                       ExceptionTracker& exceptionTracker) const;
 };
 
 class IMessageFactory {
@@ -0,0 +1,106 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_protobuf/MessageArena.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace Valdi::Protobuf {
+
+constexpr size_t kAlignment = alignof(std::max_align_t);
+constexpr size_t kInitialBlockSize = 4 * 1024;
+constexpr size_t kMaxBlockSize = 1024 * 1024;
+// Every ArenaAllocatable object is prefixed by a header holding the arena it was allocated in
+constexpr size_t kObjectHeaderSize = kAlignment;
+
+static_assert(sizeof(MessageArena*) <= kObjectHeaderSize);
+static_assert(kAlignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+static thread_local MessageArena* tCurrentArena = nullptr;
+
+static size_t alignSize(size_t size) {
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+MessageArena::MessageArena() : _nextBlockSize(kInitialBlockSize) {}
+
+MessageArena::~MessageArena() = default;
+
+void* MessageArena::allocate(size_t size) {
+    size = alignSize(std::max(size, static_cast<size_t>(1)));
+
+    std::lock_guard<Mutex> guard(_mutex);
+    _allocatedBytes += size;
+
+    if (static_cast<size_t>(_end - _current) >= size) {
+        auto* ptr = _current;
+        _current += size;
+        return ptr;
+    }
+
+    if (size > _nextBlockSize / 4) {
+        // Large allocations get their own block, so that the current block can still be filled
+        auto& block = _blocks.emplace_back(new Byte[size]);
+        return block.get();
+    }
+
+    auto& block = _blocks.emplace_back(new Byte[_nextBlockSize]);
+    _current = block.get() + size;
+    _end = block.get() + _nextBlockSize;
+    _nextBlockSize = std::min(_nextBlockSize * 2, kMaxBlockSize);
+
+    return block.get();
+}
+
+size_t MessageArena::getAllocatedBytes() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    return _allocatedBytes;
+}
+
+size_t MessageArena::getBlocksCount() const {
+    std::lock_guard<Mutex> guard(_mutex);
+    return _blocks.size();
+}
+
+MessageArena* MessageArena::current() {
+    return tCurrentArena;
+}
+
+MessageArena::Scope::Scope(MessageArena* arena) : _previous(tCurrentArena) {
+    tCurrentArena = arena;
+}
+
+MessageArena::Scope::~Scope() {
+    tCurrentArena = _previous;
+}
+
+void* ArenaAllocatable::operator new(size_t size) {
+    auto* arena = MessageArena::current();
+    Byte* ptr;
+    if (arena != nullptr) {
+        ptr = reinterpret_cast<Byte*>(arena->allocate(size + kObjectHeaderSize));
+        // The object keeps its arena alive until it is deleted
+        arena->unsafeRetainInner();
+    } else {
+        ptr = reinterpret_cast<Byte*>(::operator new(size + kObjectHeaderSize));
+    }
+
+    *reinterpret_cast<MessageArena**>(ptr) = arena;
+    return ptr + kObjectHeaderSize;
+}
+
+void ArenaAllocatable::operator delete(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    auto* allocation = reinterpret_cast<Byte*>(ptr) - kObjectHeaderSize;
+    auto* arena = *reinterpret_cast<MessageArena**>(allocation);
+    if (arena != nullptr) {
+        arena->unsafeReleaseInner();
+    } else {
+        ::operator delete(allocation);
+    }
+}
+
+} // namespace Valdi::Protobuf
@@ -0,0 +1,146 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Valdi::Protobuf {
+
+/**
+ A MessageArena is a growable bump allocator in which a decoded message tree can be
+ allocated: the Message and RepeatedField instances, and the storage of their fields.
+ Objects allocated in the arena are ref counted as usual, but their memory is only
+ reclaimed when the arena itself is destroyed, which happens once the last object
+ allocated in it is destroyed. Freeing a decoded tree is then a handful of bulk frees
+ instead of one free per object.
+
+ Objects are allocated into the arena while a MessageArena::Scope is active on the
+ current thread. Note that keeping any object of the tree alive keeps the memory of
+ the entire tree alive.
+ */
+class MessageArena : public SimpleRefCountable {
+public:
+    MessageArena();
+    ~MessageArena() override;
+
+    /**
+     Allocate the given number of bytes, aligned to alignof(std::max_align_t).
+     Can be called from any thread.
+     */
+    void* allocate(size_t size);
+
+    /**
+     Return the total number of bytes allocated from the arena.
+     */
+    size_t getAllocatedBytes() const;
+
+    /**
+     Return the number of memory blocks that the arena allocated.
+     */
+    size_t getBlocksCount() const;
+
+    /**
+     Return the arena in which objects are currently allocated on this thread, if any.
+     */
+    static MessageArena* current();
+
+    /**
+     Make the given arena the current arena of the calling thread while the Scope
+     is alive. Passing nullptr makes subsequent allocations go to the heap.
+     */
+    class Scope {
+    public:
+        explicit Scope(MessageArena* arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        MessageArena* _previous;
+    };
+
+private:
+    mutable Mutex _mutex;
+    std::vector<std::unique_ptr<Byte[]>> _blocks;
+    Byte* _current = nullptr;
+    Byte* _end = nullptr;
+    size_t _nextBlockSize;
+    size_t _allocatedBytes = 0;
+};
+
+/**
+ Base class for the objects which can be allocated inside a MessageArena.
+ Instances are allocated in the current arena of the thread when there is one,
+ or in the heap otherwise.
+ */
+class ArenaAllocatable {
+public:
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
+};
+
+/**
+ A std allocator which allocates in the arena that was current when it was created.
+ Deallocations are no-ops when allocating in an arena. The allocator retains its arena,
+ so that containers can safely outlive the objects of the arena.
+ */
+template<typename T>
+class MessageArenaAllocator {
+public:
+    using value_type = T;
+
+    MessageArenaAllocator() : _arena(MessageArena::current()) {}
+    // Allocators must be left unchanged when moved from, so moves are copies
+    MessageArenaAllocator(const MessageArenaAllocator& other) = default;
+
+    template<typename U>
+    MessageArenaAllocator(const MessageArenaAllocator<U>& other) // NOLINT(google-explicit-constructor)
+        : _arena(other.getArena()) {}
+
+    T* allocate(size_t n) {
+        if (_arena != nullptr) {
+            return static_cast<T*>(_arena->allocate(n * sizeof(T)));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        if (_arena == nullptr) {
+            std::allocator<T>().deallocate(ptr, n);
+        }
+    }
+
+    const Ref<MessageArena>& getArena() const {
+        return _arena;
+    }
+
+    /**
+     Copies of a container allocate in the arena that is current at the time of the copy,
+     rather than in the arena of the container they are copied from.
+     */
+    MessageArenaAllocator select_on_container_copy_construction() const { // NOLINT(readability-identifier-naming)
+        return MessageArenaAllocator();
+    }
+
+    template<typename U>
+    bool operator==(const MessageArenaAllocator<U>& other) const {
+        return _arena == other.getArena();
+    }
+
+    template<typename U>
+    bool operator!=(const MessageArenaAllocator<U>& other) const {
+        return !(*this == other);
+    }
+
+private:
+    Ref<MessageArena> _arena;
+};
+
+} // namespace Valdi::Protobuf
@@ -0,0 +1,180 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_protobuf/MessageParseTable.hpp"
+#include "valdi_core/cpp/Utils/FlatMap.hpp"
+#include "valdi_core/cpp/Utils/Mutex.hpp"
+
+#include <google/protobuf/descriptor.h>
+
+#include <algorithm>
+#include <memory>
+
+namespace Valdi::Protobuf {
+
+struct MessageParseTableCache {
+    Mutex mutex;
+    FlatMap<const google::protobuf::Descriptor*, std::unique_ptr<MessageParseTable>> tables;
+};
+
+// Field numbers up to this value are looked up by index when encoding, larger ones through a binary search
+constexpr FieldNumber kMaxIndexedFieldNumber = 1024;
+constexpr uint16_t kNoEncodedFieldIndex = UINT16_MAX;
+
+static MessageParseTableCache& getCache() {
+    // Intentionally leaked, as tables can be requested from any thread until the process exits
+    static auto* kCache = new MessageParseTableCache();
+    return *kCache;
+}
+
+static MessageParseTable::EncodedFieldKind getEncodedFieldKind(const google::protobuf::FieldDescriptor& fieldDescriptor) {
+    switch (fieldDescriptor.type()) {
+        case google::protobuf::FieldDescriptor::TYPE_STRING:
+            return MessageParseTable::EncodedFieldKind::String;
+        case google::protobuf::FieldDescriptor::TYPE_BYTES:
+            return MessageParseTable::EncodedFieldKind::Bytes;
+        case google::protobuf::FieldDescriptor::TYPE_MESSAGE:
+        case google::protobuf::FieldDescriptor::TYPE_GROUP:
+            return MessageParseTable::EncodedFieldKind::Message;
+        default:
+            return MessageParseTable::EncodedFieldKind::Scalar;
+    }
+}
+
+MessageParseTable::EncodedField MessageParseTable::EncodedField::unknown(FieldNumber number) {
+    return EncodedField{number, WireWriter::encodeTag(number), EncodedFieldKind::Unknown, false, nullptr};
+}
+
+MessageParseTable::MessageParseTable(const google::protobuf::Descriptor& descriptor) : _descriptor(descriptor) {
+    auto fieldCount = descriptor.field_count();
+    for (int i = 0; i < fieldCount; i++) {
+        const auto* fieldDescriptor = descriptor.field(i);
+        auto number = static_cast<FieldNumber>(fieldDescriptor->number());
+        _maxFieldNumber = std::max(_maxFieldNumber, number);
+
+        auto isRepeated = fieldDescriptor->is_repeated();
+        auto isMessage = fieldDescriptor->cpp_type() == google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE;
+        if (isRepeated || isMessage) {
+            _postprocessedFields.emplace_back(PostprocessedField{number, fieldDescriptor, isRepeated, isMessage});
+        }
+
+        _encodedFields.emplace_back(
+            EncodedField{number,
+                         WireWriter::encodeTag(number),
+                         getEncodedFieldKind(*fieldDescriptor),
+                         isRepeated,
+                         fieldDescriptor});
+    }
+
+    std::sort(_encodedFields.begin(), _encodedFields.end(), [](const EncodedField& lhs, const EncodedField& rhs) {
+        return lhs.number < rhs.number;
+    });
+
+    if (_maxFieldNumber <= kMaxIndexedFieldNumber) {
+        _encodedFieldIndexes.resize(_maxFieldNumber + 1, kNoEncodedFieldIndex);
+        for (size_t i = 0; i < _encodedFields.size(); i++) {
+            _encodedFieldIndexes[_encodedFields[i].number] = static_cast<uint16_t>(i);
+        }
+    }
+
+    for (const auto& encodedField : _encodedFields) {
+        const auto& name = encodedField.descriptor->name();
+        const auto& jsonName = encodedField.descriptor->json_name();
+        _jsonFields.emplace_back(JSONField{name, &encodedField});
+        if (jsonName != name) {
+            _jsonFields.emplace_back(JSONField{jsonName, &encodedField});
+        }
+    }
+    std::sort(_jsonFields.begin(), _jsonFields.end(), [](const JSONField& lhs, const JSONField& rhs) {
+        return lhs.name < rhs.name;
+    });
+
+    auto oneOfCount = descriptor.oneof_decl_count();
+    for (int i = 0; i < oneOfCount; i++) {
+        const auto* oneOfDescriptor = descriptor.oneof_decl(i);
+        auto oneOfFieldCount = oneOfDescriptor->field_count();
+        for (int j = 0; j < oneOfFieldCount; j++) {
+            _oneOfFieldNumbers.emplace_back(static_cast<FieldNumber>(oneOfDescriptor->field(j)->number()));
+        }
+    }
+}
+
+MessageParseTable::~MessageParseTable() = default;
+
+const google::protobuf::Descriptor& MessageParseTable::getDescriptor() const {
+    return _descriptor;
+}
+
+FieldNumber MessageParseTable::getMaxFieldNumber() const {
+    return _maxFieldNumber;
+}
+
+const std::vector<FieldNumber>& MessageParseTable::getOneOfFieldNumbers() const {
+    return _oneOfFieldNumbers;
+}
+
+const std::vector<MessageParseTable::PostprocessedField>& MessageParseTable::getPostprocessedFields() const {
+    return _postprocessedFields;
+}
+
+const std::vector<MessageParseTable::EncodedField>& MessageParseTable::getEncodedFields() const {
+    return _encodedFields;
+}
+
+const MessageParseTable::EncodedField* MessageParseTable::findEncodedField(FieldNumber number) const {
+    if (!_encodedFieldIndexes.empty()) {
+        if (number >= _encodedFieldIndexes.size() || _encodedFieldIndexes[number] == kNoEncodedFieldIndex) {
+            return nullptr;
+        }
+        return &_encodedFields[_encodedFieldIndexes[number]];
+    }
+
+    auto it = std::lower_bound(_encodedFields.begin(),
+                               _encodedFields.end(),
+                               number,
+                               [](const EncodedField& field, FieldNumber number) { return field.number < number; });
+    if (it == _encodedFields.end() || it->number != number) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+const MessageParseTable::EncodedField* MessageParseTable::findEncodedFieldByJSONName(std::string_view name) const {
+    auto it = std::lower_bound(_jsonFields.begin(),
+                               _jsonFields.end(),
+                               name,
+                               [](const JSONField& field, std::string_view name) { return field.name < name; });
+    if (it == _jsonFields.end() || it->name != name) {
+        return nullptr;
+    }
+    return it->encodedField;
+}
+
+const MessageParseTable& MessageParseTable::get(const google::protobuf::Descriptor& descriptor) {
+    auto& cache = getCache();
+    std::lock_guard<Mutex> guard(cache.mutex);
+
+    auto& table = cache.tables[&descriptor];
+    if (table == nullptr) {
+        table = std::make_unique<MessageParseTable>(descriptor);
+    }
+
+    // Tables are never removed while their pool is alive, so the reference
+    // remains valid after the lock is released.
+    return *table;
+}
+
+void MessageParseTable::removeTablesForPool(const google::protobuf::DescriptorPool* pool) {
+    auto& cache = getCache();
+    std::lock_guard<Mutex> guard(cache.mutex);
+
+    auto it = cache.tables.begin();
+    while (it != cache.tables.end()) {
+        if (it->first->file()->pool() == pool) {
+            cache.tables.erase(it++);
+        } else {
+            it++;
+        }
+    }
+}
+
+} // namespace Valdi::Protobuf
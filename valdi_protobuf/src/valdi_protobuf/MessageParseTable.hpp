@@ -0,0 +1,130 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_protobuf/FieldNumber.hpp"
+#include "valdi_protobuf/WireWriter.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace google::protobuf {
+class Descriptor;
+class DescriptorPool;
+class FieldDescriptor;
+} // namespace google::protobuf
+
+namespace Valdi::Protobuf {
+
+/**
+ A MessageParseTable holds the information about a Descriptor that the Message
+ needs when decoding, postprocessing and encoding, flattened into compact arrays.
+ It is compiled once per Descriptor and cached, so that decoding a message doesn't
+ need to walk the Descriptor and its FieldDescriptors every time.
+ */
+class MessageParseTable {
+public:
+    struct PostprocessedField {
+        FieldNumber number;
+        const google::protobuf::FieldDescriptor* descriptor;
+        bool isRepeated;
+        bool isMessage;
+    };
+
+    enum class EncodedFieldKind : uint8_t {
+        Unknown,
+        Scalar,
+        String,
+        Bytes,
+        Message,
+    };
+
+    /**
+     The serialization plan of a field: its tag already encoded, and which kind of
+     value the field holds, so that the encoder can write it without resolving its type.
+     */
+    struct EncodedField {
+        FieldNumber number;
+        EncodedTag tag;
+        EncodedFieldKind kind;
+        bool isRepeated;
+        // nullptr when the field is not declared in the Descriptor
+        const google::protobuf::FieldDescriptor* descriptor;
+
+        /**
+         Return the serialization plan of a field which is not declared in the Descriptor.
+         */
+        static EncodedField unknown(FieldNumber number);
+    };
+
+    /**
+     A field looked up by one of its JSON names, which are both its JSON name
+     and its original name in the proto file.
+     */
+    struct JSONField {
+        std::string_view name;
+        const EncodedField* encodedField;
+    };
+
+    explicit MessageParseTable(const google::protobuf::Descriptor& descriptor);
+    ~MessageParseTable();
+
+    const google::protobuf::Descriptor& getDescriptor() const;
+
+    /**
+     The highest field number declared in the message, used to size the FieldMap upfront.
+     */
+    FieldNumber getMaxFieldNumber() const;
+
+    /**
+     The numbers of all the fields which are part of a oneof.
+     */
+    const std::vector<FieldNumber>& getOneOfFieldNumbers() const;
+
+    /**
+     The repeated and message fields, which need to be processed after decoding.
+     */
+    const std::vector<PostprocessedField>& getPostprocessedFields() const;
+
+    /**
+     The serialization plans of all the fields, sorted by field number.
+     */
+    const std::vector<EncodedField>& getEncodedFields() const;
+
+    /**
+     Return the serialization plan of the given field, or nullptr if the field
+     is not declared in the Descriptor.
+     */
+    const EncodedField* findEncodedField(FieldNumber number) const;
+
+    /**
+     Return the serialization plan of the field with the given JSON name or original
+     name, or nullptr if no such field is declared in the Descriptor.
+     */
+    const EncodedField* findEncodedFieldByJSONName(std::string_view name) const;
+
+    /**
+     Return the parse table compiled for the given Descriptor, compiling it if needed.
+     Can be called from any thread.
+     */
+    static const MessageParseTable& get(const google::protobuf::Descriptor& descriptor);
+
+    /**
+     Remove the cached parse tables of the Descriptors owned by the given pool.
+     Must be called before the pool is destroyed.
+     */
+    static void removeTablesForPool(const google::protobuf::DescriptorPool* pool);
+
+private:
+    const google::protobuf::Descriptor& _descriptor;
+    FieldNumber _maxFieldNumber = 0;
+    std::vector<FieldNumber> _oneOfFieldNumbers;
+    std::vector<PostprocessedField> _postprocessedFields;
+    std::vector<EncodedField> _encodedFields;
+    // Index of the encoded field of each field number, when the field numbers are small enough
+    std::vector<uint16_t> _encodedFieldIndexes;
+    // Sorted by name, the names are owned by the FieldDescriptors
+    std::vector<JSONField> _jsonFields;
+};
+
+} // namespace Valdi::Protobuf
@@ -0,0 +1,205 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#include "valdi_protobuf/MessageStreamDecoder.hpp"
+#include "valdi_protobuf/Message.hpp"
+#include "valdi_protobuf/WireReader.hpp"
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include <fmt/format.h>
+
+namespace Valdi::Protobuf {
+
+using WireType = google::protobuf::internal::WireFormatLite::WireType;
+
+// A varint which fails to decode while this many bytes are available is malformed,
+// otherwise it might just be missing its remaining bytes.
+constexpr size_t kMaxVarintLength = 10;
+
+MessageStreamDecoder::MessageStreamDecoder(const google::protobuf::Descriptor* descriptor)
+    : _descriptor(descriptor), _retainedBytes(makeShared<ByteBuffer>()) {}
+
+MessageStreamDecoder::~MessageStreamDecoder() = default;
+
+bool MessageStreamDecoder::setElementCallback(FieldNumber fieldNumber,
+                                              ElementCallback callback,
+                                              ExceptionTracker& exceptionTracker) {
+    if (_started) {
+        return onError("Element callback must be set before decoding", exceptionTracker);
+    }
+
+    const auto* fieldDescriptor = _descriptor->FindFieldByNumber(static_cast<int>(fieldNumber));
+    if (fieldDescriptor == nullptr || !fieldDescriptor->is_repeated() ||
+        fieldDescriptor->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+        return onError(fmt::format("Field number {} of message type '{}' is not a repeated message field",
+                                   fieldNumber,
+                                   _descriptor->full_name()),
+                       exceptionTracker);
+    }
+
+    _streamedFieldNumber = fieldNumber;
+    _elementDescriptor = fieldDescriptor->message_type();
+    _elementCallback = std::move(callback);
+
+    return true;
+}
+
+bool MessageStreamDecoder::append(const BytesView& chunk, ExceptionTracker& exceptionTracker) {
+    if (_failed) {
+        return onError("Cannot append to a failed decoder", exceptionTracker);
+    }
+    _started = true;
+
+    size_t consumed = 0;
+    if (_pendingBytes.empty()) {
+        // Decode directly from the chunk, and only keep what is left of it
+        if (!decodeFields(chunk.data(), chunk.size(), chunk.getSource(), consumed, exceptionTracker)) {
+            return false;
+        }
+        _pendingBytes.append(chunk.data() + consumed, chunk.data() + chunk.size());
+    } else {
+        _pendingBytes.append(chunk.data(), chunk.data() + chunk.size());
+        // The pending bytes are shifted after decoding, so the elements cannot reference them
+        if (!decodeFields(_pendingBytes.data(), _pendingBytes.size(), nullptr, consumed, exceptionTracker)) {
+            return false;
+        }
+        _pendingBytes.shift(consumed);
+    }
+
+    return true;
+}
+
+Ref<Message> MessageStreamDecoder::finish(ExceptionTracker& exceptionTracker) {
+    if (_failed) {
+        onError("Cannot finish a failed decoder", exceptionTracker);
+        return nullptr;
+    }
+
+    if (!_pendingBytes.empty()) {
+        onError("Truncated message", exceptionTracker);
+        return nullptr;
+    }
+
+    _started = true;
+    auto retainedBytes = std::move(_retainedBytes);
+    _retainedBytes = makeShared<ByteBuffer>();
+
+    return Message::parse(retainedBytes->toBytesView(), _descriptor, exceptionTracker);
+}
+
+size_t MessageStreamDecoder::getStreamedElementsCount() const {
+    return _streamedElementsCount;
+}
+
+size_t MessageStreamDecoder::getBufferedBytes() const {
+    return _pendingBytes.size() + _retainedBytes->size();
+}
+
+bool MessageStreamDecoder::decodeFields(const Byte* data,
+                                        size_t length,
+                                        const Ref<RefCountable>& source,
+                                        size_t& consumed,
+                                        ExceptionTracker& exceptionTracker) {
+    WireReader reader(data, length);
+
+    for (;;) {
+        // Everything before the current field has been fully decoded
+        consumed = reader.position();
+        if (reader.isAtEnd()) {
+            return true;
+        }
+
+        const auto* fieldStart = reader.current();
+        auto tag = reader.readTag();
+        if (tag == 0) {
+            if (*fieldStart != 0 && reader.remaining() < kMaxVarintLength) {
+                return true;
+            }
+            return onError("Invalid tag", exceptionTracker);
+        }
+
+        auto wireType = static_cast<WireType>(tag & 0x7);
+        auto fieldNumber = static_cast<FieldNumber>(tag >> 3);
+        const Byte* payload = nullptr;
+        uint32_t payloadLength = 0;
+
+        switch (wireType) {
+            case WireType::WIRETYPE_VARINT: {
+                uint64_t varint;
+                if (!reader.readVarint64(&varint)) {
+                    if (reader.remaining() < kMaxVarintLength) {
+                        return true;
+                    }
+                    return onError("Unable to read varint", exceptionTracker);
+                }
+            } break;
+            case WireType::WIRETYPE_FIXED64:
+                if (!reader.skip(sizeof(uint64_t))) {
+                    return true;
+                }
+                break;
+            case WireType::WIRETYPE_FIXED32:
+                if (!reader.skip(sizeof(uint32_t))) {
+                    return true;
+                }
+                break;
+            case WireType::WIRETYPE_LENGTH_DELIMITED:
+                if (!reader.readVarint32(&payloadLength)) {
+                    if (reader.remaining() < kMaxVarintLength) {
+                        return true;
+                    }
+                    return onError("Unable to read varint32", exceptionTracker);
+                }
+                payload = reader.current();
+                if (!reader.skip(payloadLength)) {
+                    return true;
+                }
+                break;
+            default:
+                return onError("Unsupported wiretype", exceptionTracker);
+        }
+
+        if (fieldNumber == _streamedFieldNumber && payload != nullptr) {
+            if (!emitElement(payload, payloadLength, source, exceptionTracker)) {
+                return false;
+            }
+        } else {
+            _retainedBytes->append(fieldStart, reader.current());
+        }
+    }
+}
+
+bool MessageStreamDecoder::emitElement(const Byte* data,
+                                       size_t length,
+                                       const Ref<RefCountable>& source,
+                                       ExceptionTracker& exceptionTracker) {
+    BytesView bytes;
+    if (source != nullptr) {
+        bytes = BytesView(source, data, length);
+    } else {
+        auto buffer = makeShared<ByteBuffer>(data, data + length);
+        bytes = buffer->toBytesView();
+    }
+
+    auto element = Message::parse(bytes, _elementDescriptor, exceptionTracker);
+    if (element == nullptr) {
+        _failed = true;
+        return false;
+    }
+
+    _streamedElementsCount++;
+    _elementCallback(element);
+
+    return true;
+}
+
+bool MessageStreamDecoder::onError(std::string_view message, ExceptionTracker& exceptionTracker) {
+    _failed = true;
+    exceptionTracker.onError(fmt::format("While stream decoding message type '{}': {}",
+                                         _descriptor != nullptr ? _descriptor->full_name() : "<Unknown>",
+                                         message));
+    return false;
+}
+
+} // namespace Valdi::Protobuf
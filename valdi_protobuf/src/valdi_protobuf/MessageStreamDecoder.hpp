@@ -0,0 +1,95 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+#include "valdi_core/cpp/Utils/ExceptionTracker.hpp"
+#include "valdi_core/cpp/Utils/Function.hpp"
+#include "valdi_core/cpp/Utils/Shared.hpp"
+#include "valdi_protobuf/FieldNumber.hpp"
+
+namespace google::protobuf {
+class Descriptor;
+} // namespace google::protobuf
+
+namespace Valdi::Protobuf {
+
+class Message;
+
+/**
+ A MessageStreamDecoder decodes a Message from bytes which are received in chunks,
+ for instance while a response is being downloaded. The decoder can resume from
+ any chunk boundary: bytes of a field which is not complete yet are kept until
+ the next chunks arrive.
+
+ The elements of one top level repeated message field can be streamed: each element
+ is decoded and passed to the element callback as soon as all of its bytes are
+ received, and is not retained by the decoder nor added to the final message.
+ The other fields are kept and decoded into the message returned by finish().
+ */
+class MessageStreamDecoder {
+public:
+    using ElementCallback = Function<void(const Ref<Message>&)>;
+
+    explicit MessageStreamDecoder(const google::protobuf::Descriptor* descriptor);
+    ~MessageStreamDecoder();
+
+    /**
+     Stream the elements of the given repeated message field to the callback.
+     Must be called before any chunk is appended.
+     */
+    bool setElementCallback(FieldNumber fieldNumber, ElementCallback callback, ExceptionTracker& exceptionTracker);
+
+    /**
+     Decode the given chunk, emitting the streamed elements which are complete.
+     The chunk's bytes are referenced without copy by the emitted elements when
+     they are entirely contained in the chunk and the chunk has a source.
+     */
+    bool append(const BytesView& chunk, ExceptionTracker& exceptionTracker);
+
+    /**
+     Finish the decoding, and return the message holding all the fields that were
+     not streamed. Fails if the received bytes ended in the middle of a field.
+     The returned message is not postprocessed.
+     */
+    Ref<Message> finish(ExceptionTracker& exceptionTracker);
+
+    /**
+     Return the number of elements that were streamed to the element callback.
+     */
+    size_t getStreamedElementsCount() const;
+
+    /**
+     Return the number of bytes currently held by the decoder.
+     */
+    size_t getBufferedBytes() const;
+
+private:
+    const google::protobuf::Descriptor* _descriptor;
+    const google::protobuf::Descriptor* _elementDescriptor = nullptr;
+    FieldNumber _streamedFieldNumber = 0;
+    ElementCallback _elementCallback;
+    // Bytes of the last field, which was not entirely received yet
+    ByteBuffer _pendingBytes;
+    // Encoded fields which are not streamed, decoded in finish()
+    Ref<ByteBuffer> _retainedBytes;
+    size_t _streamedElementsCount = 0;
+    bool _started = false;
+    bool _failed = false;
+
+    bool decodeFields(const Byte* data,
+                      size_t length,
+                      const Ref<RefCountable>& source,
+                      size_t& consumed,
+                      ExceptionTracker& exceptionTracker);
+
+    bool emitElement(const Byte* data,
+                     size_t length,
+                     const Ref<RefCountable>& source,
+                     ExceptionTracker& exceptionTracker);
+
+    bool onError(std::string_view message, ExceptionTracker& exceptionTracker);
+};
+
+} // namespace Valdi::Protobuf
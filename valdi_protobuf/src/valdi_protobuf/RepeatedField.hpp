@@ -1,11 +1,12 @@
 #pragma once
 
 #include "valdi_protobuf/Field.hpp"
+#include "valdi_protobuf/MessageArena.hpp"
 #include <vector>
 
 namespace Valdi::Protobuf {
 
-class RepeatedField : public SimpleRefCountable {
+class RepeatedField : public SimpleRefCountable, public ArenaAllocatable {
 public:
     RepeatedField();
     ~RepeatedField() override;
@@ -33,7 +34,7 @@ public:
     Field* end();
 
 private:
-    std::vector<Field> _values;
+    std::vector<Field, MessageArenaAllocator<Field>> _values;
 };
 
 } // namespace Valdi::Protobuf
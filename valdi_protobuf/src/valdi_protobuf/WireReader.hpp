@@ -0,0 +1,199 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Constants.hpp"
+#include "valdi_core/cpp/Utils/Bytes.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Valdi::Protobuf {
+
+/**
+ A minimal reader of the Protobuf wire format, operating directly on a contiguous buffer.
+ Varints are decoded 8 bytes at a time when enough bytes are available: the terminating
+ byte is found from the continuation bits of the loaded word, and the 7 bits payloads are
+ compacted together with a few masks and shifts instead of a loop with one branch per byte.
+ */
+class WireReader {
+public:
+    inline WireReader(const Byte* data, size_t length) : _begin(data), _current(data), _end(data + length) {}
+
+    inline bool isAtEnd() const {
+        return _current == _end;
+    }
+
+    inline const Byte* current() const {
+        return _current;
+    }
+
+    inline size_t remaining() const {
+        return static_cast<size_t>(_end - _current);
+    }
+
+    inline size_t position() const {
+        return static_cast<size_t>(_current - _begin);
+    }
+
+    /**
+     Read a tag. Returns 0 when reaching the end of the buffer, or when the tag is malformed.
+     */
+    inline uint32_t readTag() {
+        if (VALDI_UNLIKELY(_current == _end)) {
+            return 0;
+        }
+
+        // Most tags fit in a single byte
+        auto firstByte = *_current;
+        if (VALDI_LIKELY(firstByte < 0x80)) {
+            _current++;
+            return firstByte;
+        }
+
+        uint64_t tag;
+        if (!readVarint64(&tag) || tag > UINT32_MAX) {
+            return 0;
+        }
+        return static_cast<uint32_t>(tag);
+    }
+
+    inline bool readVarint32(uint32_t* output) {
+        uint64_t value;
+        if (!readVarint64(&value)) {
+            return false;
+        }
+        // Like CodedInputStream, the upper bits of varints longer than 32 bits are discarded
+        *output = static_cast<uint32_t>(value);
+        return true;
+    }
+
+    inline bool readVarint64(uint64_t* output) {
+        if (VALDI_LIKELY(_current != _end && *_current < 0x80)) {
+            *output = *_current;
+            _current++;
+            return true;
+        }
+
+        if (VALDI_LIKELY(remaining() >= sizeof(uint64_t))) {
+            uint64_t word;
+            std::memcpy(&word, _current, sizeof(uint64_t));
+            word = toLittleEndian(word);
+
+            auto terminators = ~word & 0x8080808080808080ULL;
+            if (VALDI_LIKELY(terminators != 0)) {
+                auto length = (static_cast<size_t>(__builtin_ctzll(terminators)) >> 3) + 1;
+                // length is at most 8, the payload of the bytes past the terminating byte is cleared
+                auto payload = length == sizeof(uint64_t) ? word : word & ((1ULL << (length * 8)) - 1);
+                *output = compactVarint(payload);
+                _current += length;
+                return true;
+            }
+        }
+
+        return readVarint64Slow(output);
+    }
+
+    inline bool readLittleEndian32(uint32_t* output) {
+        if (VALDI_UNLIKELY(remaining() < sizeof(uint32_t))) {
+            return false;
+        }
+        uint32_t value;
+        std::memcpy(&value, _current, sizeof(uint32_t));
+        *output = toLittleEndian(value);
+        _current += sizeof(uint32_t);
+        return true;
+    }
+
+    inline bool readLittleEndian64(uint64_t* output) {
+        if (VALDI_UNLIKELY(remaining() < sizeof(uint64_t))) {
+            return false;
+        }
+        uint64_t value;
+        std::memcpy(&value, _current, sizeof(uint64_t));
+        *output = toLittleEndian(value);
+        _current += sizeof(uint64_t);
+        return true;
+    }
+
+    inline bool skip(size_t length) {
+        if (VALDI_UNLIKELY(remaining() < length)) {
+            return false;
+        }
+        _current += length;
+        return true;
+    }
+
+    /**
+     Return the number of varints which end within the given buffer, i.e. the number of
+     bytes without a continuation bit. Used to size the output of packed varint arrays
+     before decoding them.
+     */
+    static inline size_t countVarints(const Byte* data, size_t length) {
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(uint64_t));
+            count += static_cast<size_t>(__builtin_popcountll(~word & 0x8080808080808080ULL));
+        }
+        for (; i < length; i++) {
+            if (data[i] < 0x80) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+private:
+    const Byte* _begin;
+    const Byte* _current;
+    const Byte* _end;
+
+    /**
+     Gather the 7 bits payloads of up to 8 varint bytes held in a little endian word.
+     */
+    static inline uint64_t compactVarint(uint64_t word) {
+        word &= 0x7f7f7f7f7f7f7f7fULL;
+        word = ((word & 0x7f007f007f007f00ULL) >> 1) | (word & 0x007f007f007f007fULL);
+        word = ((word & 0x3fff00003fff0000ULL) >> 2) | (word & 0x00003fff00003fffULL);
+        word = ((word & 0x0fffffff00000000ULL) >> 4) | (word & 0x000000000fffffffULL);
+        return word;
+    }
+
+    template<typename T>
+    static inline T toLittleEndian(T value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        if constexpr (sizeof(T) == sizeof(uint64_t)) {
+            return __builtin_bswap64(value);
+        } else {
+            return __builtin_bswap32(value);
+        }
+#else
+        return value;
+#endif
+    }
+
+    bool readVarint64Slow(uint64_t* output) {
+        uint64_t value = 0;
+        const auto* current = _current;
+        for (size_t i = 0; i < 10; i++) {
+            if (VALDI_UNLIKELY(current == _end)) {
+                return false;
+            }
+            auto byte = *current;
+            current++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+            if (byte < 0x80) {
+                *output = value;
+                _current = current;
+                return true;
+            }
+        }
+
+        // Varints cannot be longer than 10 bytes
+        return false;
+    }
+};
+
+} // namespace Valdi::Protobuf
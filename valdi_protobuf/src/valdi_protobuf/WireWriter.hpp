@@ -0,0 +1,142 @@
+// Copyright © 2024 Snap, Inc. All rights reserved.
+
+#pragma once
+
+#include "valdi_core/cpp/Constants.hpp"
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
+#include "valdi_protobuf/FieldNumber.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Valdi::Protobuf {
+
+/**
+ The encoded bytes of a field tag with a wire type of 0. Since the wire type is held by
+ the lowest 3 bits of the first byte, the tag of any wire type can be written from it
+ by or'ing the wire type into the first byte.
+ */
+struct EncodedTag {
+    static constexpr size_t kMaxLength = 5;
+
+    Byte bytes[kMaxLength];
+    uint8_t length;
+};
+
+/**
+ A minimal writer of the Protobuf wire format, which appends directly into a growing ByteBuffer.
+ Length delimited values whose size is not known upfront, like nested messages, are written in a
+ single pass: a one byte length prefix is reserved before writing the value and patched in place
+ once the value is written. Only values of 128 bytes or more need to be moved to make room for
+ their longer length prefix.
+ */
+class WireWriter {
+public:
+    inline explicit WireWriter(ByteBuffer& output) : _output(output) {}
+
+    inline size_t position() const {
+        return _output.size();
+    }
+
+    inline void writeTag(const EncodedTag& tag, uint32_t wireType) {
+        auto* output = _output.appendWritable(tag.length);
+        std::memcpy(output, tag.bytes, tag.length);
+        output[0] |= static_cast<Byte>(wireType);
+    }
+
+    inline void writeVarint(uint64_t value) {
+        auto* output = _output.appendWritable(varintSize(value));
+        while (value >= 0x80) {
+            *output = static_cast<Byte>(value | 0x80);
+            value >>= 7;
+            output++;
+        }
+        *output = static_cast<Byte>(value);
+    }
+
+    inline void writeFixed64(uint64_t value) {
+        value = toLittleEndian(value);
+        std::memcpy(_output.appendWritable(sizeof(uint64_t)), &value, sizeof(uint64_t));
+    }
+
+    inline void writeFixed32(uint32_t value) {
+        value = toLittleEndian(value);
+        std::memcpy(_output.appendWritable(sizeof(uint32_t)), &value, sizeof(uint32_t));
+    }
+
+    inline void writeLengthDelimited(const Byte* data, size_t length) {
+        writeVarint(static_cast<uint64_t>(length));
+        if (length > 0) {
+            std::memcpy(_output.appendWritable(length), data, length);
+        }
+    }
+
+    /**
+     Reserve the length prefix of a length delimited value whose size is not known yet.
+     Returns the position of the prefix, which must be passed to endLengthDelimited()
+     once the value has been written.
+     */
+    inline size_t beginLengthDelimited() {
+        auto position = _output.size();
+        *_output.appendWritable(1) = 0;
+        return position;
+    }
+
+    inline void endLengthDelimited(size_t prefixPosition) {
+        auto valuePosition = prefixPosition + 1;
+        auto length = _output.size() - valuePosition;
+        if (VALDI_LIKELY(length < 0x80)) {
+            *_output[prefixPosition] = static_cast<Byte>(length);
+            return;
+        }
+
+        // The prefix needs more than one byte, move the value to make room for it
+        auto prefixSize = varintSize(static_cast<uint64_t>(length));
+        _output.appendWritable(prefixSize - 1);
+        std::memmove(_output[prefixPosition + prefixSize], _output[valuePosition], length);
+
+        auto* output = _output[prefixPosition];
+        while (length >= 0x80) {
+            *output = static_cast<Byte>(length | 0x80);
+            length >>= 7;
+            output++;
+        }
+        *output = static_cast<Byte>(length);
+    }
+
+    static inline size_t varintSize(uint64_t value) {
+        // Number of 7 bits groups needed to hold the significant bits of the value
+        auto log2Value = static_cast<size_t>(63 - __builtin_clzll(value | 1));
+        return (log2Value * 9 + 73) / 64;
+    }
+
+    static inline EncodedTag encodeTag(FieldNumber fieldNumber) {
+        EncodedTag tag;
+        tag.length = 0;
+        auto value = static_cast<uint32_t>(fieldNumber) << 3;
+        while (value >= 0x80) {
+            tag.bytes[tag.length++] = static_cast<Byte>(value | 0x80);
+            value >>= 7;
+        }
+        tag.bytes[tag.length++] = static_cast<Byte>(value);
+        return tag;
+    }
+
+private:
+    ByteBuffer& _output;
+
+    template<typename T>
+    static inline T toLittleEndian(T value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        if constexpr (sizeof(T) == sizeof(uint64_t)) {
+            return __builtin_bswap64(value);
+        } else {
+            return __builtin_bswap32(value);
+        }
+#else
+        return value;
+#endif
+    }
+};
+
+} // namespace Valdi::Protobuf
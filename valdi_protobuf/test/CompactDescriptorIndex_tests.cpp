@@ -0,0 +1,118 @@
+#include "valdi_core/cpp/Utils/ExceptionTracker.hpp"
+#include "valdi_protobuf/CompactDescriptorIndex.hpp"
+#include "valdi_protobuf/protos/DescriptorIndex.pb.h"
+#include "gtest/gtest.h"
+
+#include <string>
+
+using namespace Valdi;
+namespace {
+
+constexpr size_t kSymbolsCount = 1000;
+
+DescriptorIndex::DescriptorIndex makeIndex() {
+    DescriptorIndex::DescriptorIndex index;
+
+    auto* rootPackage = index.add_packages();
+    rootPackage->set_full_name("<root>");
+    rootPackage->add_nested_package_indexes(1);
+
+    auto* package = index.add_packages();
+    package->set_full_name("test");
+
+    for (size_t i = 0; i < 2; i++) {
+        auto* file = index.add_files();
+        file->set_file_name("file" + std::to_string(i) + ".proto");
+        file->set_data_offset(i * 10);
+        file->set_length(10);
+    }
+
+    for (size_t i = 0; i < kSymbolsCount; i++) {
+        auto* symbol = index.add_symbols();
+        symbol->set_full_name("test.Message" + std::to_string(i));
+        symbol->set_file_index(static_cast<uint32_t>(i % 2));
+        package->add_symbol_indexes(static_cast<uint32_t>(i));
+    }
+
+    return index;
+}
+
+TEST(CompactDescriptorIndex, canFindAllNames) {
+    SimpleExceptionTracker exceptionTracker;
+    auto serialized = Protobuf::CompactDescriptorIndex::serialize(makeIndex(), exceptionTracker);
+    ASSERT_FALSE(serialized.empty()) << exceptionTracker.extractError();
+
+    Byte body[20] = {0};
+    Protobuf::CompactDescriptorIndex index;
+    ASSERT_TRUE(index.load(serialized, body, sizeof(body), exceptionTracker)) << exceptionTracker.extractError();
+
+    ASSERT_EQ(kSymbolsCount, index.getSymbolsSize());
+    for (size_t i = 0; i < kSymbolsCount; i++) {
+        auto name = "test.Message" + std::to_string(i);
+        auto symbolIndex = index.findSymbol(name);
+        ASSERT_TRUE(symbolIndex.has_value()) << name;
+        ASSERT_EQ(i, symbolIndex.value());
+        ASSERT_EQ(name, index.getSymbol(i).fullName);
+        ASSERT_EQ(i % 2, index.getSymbol(i).fileIndex);
+    }
+    ASSERT_FALSE(index.findSymbol("test.Message").has_value());
+    ASSERT_FALSE(index.findSymbol("test.Message1000").has_value());
+
+    ASSERT_EQ(static_cast<size_t>(2), index.getFilesSize());
+    ASSERT_EQ(std::optional<size_t>(1), index.findFile("file1.proto"));
+    ASSERT_FALSE(index.findFile("file2.proto").has_value());
+    auto file = index.getFile(1);
+    ASSERT_EQ("file1.proto", file.name);
+    ASSERT_EQ(body + 10, file.data);
+    ASSERT_EQ(static_cast<size_t>(10), file.length);
+
+    ASSERT_EQ(static_cast<size_t>(2), index.getPackagesSize());
+    ASSERT_EQ(std::optional<size_t>(1), index.findPackage("test"));
+    auto rootPackage = index.getPackage(0);
+    ASSERT_EQ("<root>", rootPackage.fullName);
+    ASSERT_TRUE(rootPackage.symbolIndexes.empty());
+    ASSERT_EQ(static_cast<size_t>(1), rootPackage.nestedPackageIndexes.size());
+    ASSERT_EQ(static_cast<uint32_t>(1), rootPackage.nestedPackageIndexes[0]);
+    auto package = index.getPackage(1);
+    ASSERT_EQ(kSymbolsCount, package.symbolIndexes.size());
+    ASSERT_EQ(static_cast<uint32_t>(999), package.symbolIndexes[999]);
+}
+
+TEST(CompactDescriptorIndex, canLoadEmptyIndex) {
+    SimpleExceptionTracker exceptionTracker;
+    auto serialized = Protobuf::CompactDescriptorIndex::serialize(DescriptorIndex::DescriptorIndex(), exceptionTracker);
+
+    Protobuf::CompactDescriptorIndex index;
+    ASSERT_TRUE(index.load(serialized, nullptr, 0, exceptionTracker)) << exceptionTracker.extractError();
+    ASSERT_EQ(static_cast<size_t>(0), index.getSymbolsSize());
+    ASSERT_FALSE(index.findSymbol("test.Message").has_value());
+}
+
+TEST(CompactDescriptorIndex, rejectsInvalidIndex) {
+    SimpleExceptionTracker exceptionTracker;
+    auto serialized = Protobuf::CompactDescriptorIndex::serialize(makeIndex(), exceptionTracker);
+
+    Byte body[20] = {0};
+    Protobuf::CompactDescriptorIndex index;
+    ASSERT_FALSE(index.load(serialized.subrange(0, serialized.size() - 1), body, sizeof(body), exceptionTracker));
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+
+    // The body doesn't hold the files
+    ASSERT_FALSE(index.load(serialized, body, 10, exceptionTracker));
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+}
+
+TEST(CompactDescriptorIndex, rejectsDuplicatedNames) {
+    auto descriptorIndex = makeIndex();
+    descriptorIndex.add_symbols()->set_full_name("test.Message0");
+
+    SimpleExceptionTracker exceptionTracker;
+    auto serialized = Protobuf::CompactDescriptorIndex::serialize(descriptorIndex, exceptionTracker);
+    ASSERT_TRUE(serialized.empty());
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+}
+
+} // namespace
@@ -1,5 +1,7 @@
+#include "valdi_core/cpp/Utils/ByteBuffer.hpp"
 #include "valdi_core/cpp/Utils/ExceptionTracker.hpp"
 #include "valdi_core/cpp/Utils/ValueArray.hpp"
+#include "protogen/test.pb.h"
 #include "valdi_protobuf/DescriptorDatabase.hpp"
 #include "gtest/gtest.h"
 
@@ -181,4 +183,34 @@ TEST(DescriptorDatabase, canRetrievePackages) {
         database.toDebugJSON());
 }
 
+TEST(DescriptorDatabase, canLoadCompiledFileDescriptorSet) {
+    google::protobuf::FileDescriptorSet fileDescriptorSet;
+    test::Message::GetDescriptor()->file()->CopyTo(fileDescriptorSet.add_file());
+    auto fileDescriptorSetBytes = makeShared<ByteBuffer>(fileDescriptorSet.SerializeAsString());
+
+    SimpleExceptionTracker exceptionTracker;
+    auto compiled =
+        Protobuf::DescriptorDatabase::compileFileDescriptorSet(fileDescriptorSetBytes->toBytesView(), exceptionTracker);
+    ASSERT_FALSE(compiled.empty()) << exceptionTracker.extractError();
+    ASSERT_EQ("VALDIPRC", compiled.asStringView().substr(0, 8));
+
+    Protobuf::DescriptorDatabase database(false);
+    ASSERT_TRUE(database.addFileDescriptorSet(compiled, exceptionTracker)) << exceptionTracker.extractError();
+
+    google::protobuf::FileDescriptorProto fileDescriptor;
+    ASSERT_TRUE(database.FindFileContainingSymbol("test.ParentMessage.ChildMessage", &fileDescriptor));
+    ASSERT_EQ("test.proto", fileDescriptor.name());
+    ASSERT_FALSE(database.FindFileContainingSymbol("test.MissingMessage", &fileDescriptor));
+
+    auto symbolIndex = database.getSymbolIndexForName("test.OtherMessage");
+    ASSERT_TRUE(symbolIndex.has_value());
+    ASSERT_EQ("test.OtherMessage", database.getSymbolNameAtIndex(symbolIndex.value()));
+
+    // The symbols resolve through a pool backed by the database
+    google::protobuf::DescriptorPool pool(&database);
+    const auto* descriptor = pool.FindMessageTypeByName("test.RepeatedMessage");
+    ASSERT_TRUE(descriptor != nullptr);
+    ASSERT_EQ(18, descriptor->field_count());
+}
+
 } // namespace
@@ -0,0 +1,180 @@
+#include "protogen/test.pb.h"
+#include "valdi_protobuf/JSONCodec.hpp"
+#include "gtest/gtest.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/json_util.h>
+
+using namespace Valdi;
+namespace {
+
+std::string toJSON(const google::protobuf::Message& message, bool enumsAsInts = false) {
+    auto encoded = message.SerializeAsString();
+    std::string output;
+    SC_ASSERT(Protobuf::JSONCodec::binaryToJSON(reinterpret_cast<const Byte*>(encoded.data()),
+                                                encoded.size(),
+                                                *message.GetDescriptor(),
+                                                enumsAsInts,
+                                                output));
+    return output;
+}
+
+std::string toJSONWithGenericConverter(const google::protobuf::Message& message, bool enumsAsInts = false) {
+    google::protobuf::util::JsonPrintOptions options;
+    options.always_print_enums_as_ints = enumsAsInts;
+    std::string output;
+    SC_ASSERT(google::protobuf::util::MessageToJsonString(message, &output, options).ok());
+    return output;
+}
+
+bool fromJSON(std::string_view json, google::protobuf::Message& message) {
+    ByteBuffer buffer;
+    if (!Protobuf::JSONCodec::jsonToBinary(json, *message.GetDescriptor(), buffer)) {
+        return false;
+    }
+    return message.ParseFromArray(buffer.data(), static_cast<int>(buffer.size()));
+}
+
+std::string serializeDeterministically(const google::protobuf::Message& message) {
+    std::string output;
+    google::protobuf::io::StringOutputStream outputStream(&output);
+    google::protobuf::io::CodedOutputStream codedOutputStream(&outputStream);
+    // Map entries are otherwise serialized in an unspecified order
+    codedOutputStream.SetSerializationDeterministic(true);
+    message.SerializeToCodedStream(&codedOutputStream);
+    codedOutputStream.Trim();
+    return output;
+}
+
+void checkParsesLikeGenericConverter(std::string_view json, const google::protobuf::Message& prototype) {
+    std::unique_ptr<google::protobuf::Message> expected(prototype.New());
+    ASSERT_TRUE(google::protobuf::util::JsonStringToMessage(std::string(json), expected.get()).ok()) << json;
+
+    std::unique_ptr<google::protobuf::Message> message(prototype.New());
+    ASSERT_TRUE(fromJSON(json, *message)) << json;
+
+    // Compared through their serialized bytes, since NaN values are not equal to each other
+    ASSERT_EQ(serializeDeterministically(*expected), serializeDeterministically(*message))
+        << expected->DebugString() << " vs " << message->DebugString();
+}
+
+TEST(JSONCodec, printsScalarsLikeGenericConverter) {
+    test::Message message;
+    message.set_int32(-42);
+    message.set_int64(-1337133713371337);
+    message.set_uint32(4000000000u);
+    message.set_uint64(18000000000000000000u);
+    message.set_sint32(-7);
+    message.set_sint64(-8);
+    message.set_fixed32(42u);
+    message.set_fixed64(10429496729600u);
+    message.set_sfixed32(-9);
+    message.set_sfixed64(-10);
+    message.set_float_(1.5f);
+    message.set_double_(0.987654321);
+    message.set_bool_(true);
+    message.set_string("Hello \"world\"\n\t<tag> \\ \x01 caf\xc3\xa9 \xe2\x80\xa8 \xf0\x9f\x98\x80");
+    message.set_bytes(std::string("\x00\x01\xff binary", 10));
+    message.set_enum_(test::VALUE_1);
+    message.mutable_other_message()->set_value("nested");
+    message.mutable_self_message()->set_int32(1);
+    message.mutable_self_message()->mutable_self_message();
+
+    ASSERT_EQ(toJSONWithGenericConverter(message), toJSON(message));
+    ASSERT_EQ(toJSONWithGenericConverter(message, true), toJSON(message, true));
+}
+
+TEST(JSONCodec, printsRepeatedFieldsLikeGenericConverter) {
+    test::RepeatedMessage message;
+    message.add_int32(1);
+    message.add_int32(-2);
+    message.add_int64(3);
+    message.add_double_(0.5);
+    message.add_double_(-1.25);
+    message.add_float_(2.0f);
+    message.add_bool_(true);
+    message.add_bool_(false);
+    message.add_string("a");
+    message.add_string("b");
+    message.add_bytes("c");
+    message.add_enum_(test::VALUE_0);
+    message.add_enum_(test::VALUE_1);
+    message.add_enum_(static_cast<test::Enum>(42));
+    message.add_other_message()->set_value("first");
+    message.add_other_message();
+
+    ASSERT_EQ(toJSONWithGenericConverter(message), toJSON(message));
+}
+
+TEST(JSONCodec, printsMapsLikeGenericConverter) {
+    test::MapMessage message;
+    (*message.mutable_stringtostring())["key"] = "value";
+    (*message.mutable_stringtonumber())["one"] = 1;
+    (*message.mutable_stringtosignedlong())["minus"] = -1;
+    (*message.mutable_stringtounsignedlong())["large"] = 18000000000000000000u;
+    (*message.mutable_stringtodouble())["half"] = 0.5;
+    (*message.mutable_stringtomessage())["message"].set_value("nested");
+    (*message.mutable_stringtomessage())["empty"];
+    (*message.mutable_inttostring())[-3] = "minus three";
+    (*message.mutable_longtostring())[1337133713371337] = "long";
+
+    ASSERT_EQ(toJSONWithGenericConverter(message), toJSON(message));
+}
+
+TEST(JSONCodec, printsSpecialFloatingPointValues) {
+    test::RepeatedMessage message;
+    message.add_double_(std::numeric_limits<double>::quiet_NaN());
+    message.add_double_(std::numeric_limits<double>::infinity());
+    message.add_double_(-std::numeric_limits<double>::infinity());
+
+    ASSERT_EQ("{\"double\":[\"NaN\",\"Infinity\",\"-Infinity\"]}", toJSON(message));
+}
+
+TEST(JSONCodec, parsesLikeGenericConverter) {
+    checkParsesLikeGenericConverter(
+        "{\"int32\":-42,\"int64\":\"-1337133713371337\",\"uint32\":\"4000000000\",\"uint64\":"
+        "\"18000000000000000000\",\"sint32\":-7,\"sint64\":-8,\"fixed32\":42,\"fixed64\":\"10429496729600\","
+        "\"sfixed32\":-9,\"sfixed64\":\"-10\",\"float\":1.5,\"double\":0.987654321,\"bool\":true,\"string\":"
+        "\"Hello \\\"world\\\"\\n\\u00e9\\ud83d\\ude00 /\\/\",\"bytes\":\"AAH/IGJpbmFyeQ==\",\"enum\":\"VALUE_1\"}",
+        test::Message());
+
+    checkParsesLikeGenericConverter(
+        " {\n  \"selfMessage\" : { \"self_message\": {}, \"enum\": 1 },\n  \"other_message\": {\"value\": \"nested\"},\n"
+        "  \"double\": \"NaN\", \"float\": \"-Infinity\", \"int32\": null\n}\n",
+        test::Message());
+
+    checkParsesLikeGenericConverter("{\"int32\":[1,-2,3],\"double\":[0.5,1e10],\"string\":[\"a\",\"b\"],\"enum\":["
+                                    "\"VALUE_0\",1],\"otherMessage\":[{\"value\":\"first\"},{}],\"bytes\":[\"\"]}",
+                                    test::RepeatedMessage());
+
+    checkParsesLikeGenericConverter(
+        "{\"stringToString\":{\"key\":\"value\",\"other\":\"\"},\"stringToNumber\":{\"one\":1},\"stringToMessage\":{"
+        "\"message\":{\"value\":\"nested\"}},\"intToString\":{\"-3\":\"minus three\"},\"longToString\":{"
+        "\"1337133713371337\":\"long\"}}",
+        test::MapMessage());
+}
+
+TEST(JSONCodec, rejectsInputsLeftToTheGenericConverter) {
+    test::Message message;
+
+    ASSERT_FALSE(fromJSON("", message));
+    ASSERT_FALSE(fromJSON("[]", message));
+    ASSERT_FALSE(fromJSON("{\"int32\":1", message));
+    ASSERT_FALSE(fromJSON("{\"int32\":1} {}", message));
+    ASSERT_FALSE(fromJSON("{\"unknown\":1}", message));
+    ASSERT_FALSE(fromJSON("{\"int32\":2147483648}", message));
+    ASSERT_FALSE(fromJSON("{\"uint32\":-1}", message));
+    ASSERT_FALSE(fromJSON("{\"int32\":1.5}", message));
+    ASSERT_FALSE(fromJSON("{\"int32\":01}", message));
+    ASSERT_FALSE(fromJSON("{\"float\":1e39}", message));
+    ASSERT_FALSE(fromJSON("{\"enum\":\"UNKNOWN\"}", message));
+    ASSERT_FALSE(fromJSON("{\"string\":\"\\ud83d\"}", message));
+    ASSERT_FALSE(fromJSON("{\"string\":\"\xff\"}", message));
+
+    test::OneOfMessage oneOfMessage;
+    ASSERT_TRUE(fromJSON("{\"string0\":\"a\",\"message1\":{}}", oneOfMessage));
+    ASSERT_FALSE(fromJSON("{\"string0\":\"a\",\"string1\":\"b\"}", oneOfMessage));
+}
+
+} // namespace
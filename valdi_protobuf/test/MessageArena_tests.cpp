@@ -0,0 +1,57 @@
+#include "valdi_protobuf/MessageArena.hpp"
+#include "valdi_protobuf/RepeatedField.hpp"
+#include "gtest/gtest.h"
+
+using namespace Valdi;
+namespace {
+
+TEST(MessageArena, allocatesObjectsInCurrentArena) {
+    auto arena = makeShared<Protobuf::MessageArena>();
+    Ref<Protobuf::RepeatedField> repeated;
+    {
+        Protobuf::MessageArena::Scope scope(arena.get());
+        repeated = makeShared<Protobuf::RepeatedField>();
+        for (size_t i = 0; i < 100; i++) {
+            repeated->append(Protobuf::Field::varint(i));
+        }
+    }
+
+    ASSERT_TRUE(arena->getAllocatedBytes() > 100 * sizeof(Protobuf::Field));
+    // Retained by the object itself and by its values storage
+    ASSERT_EQ(3, arena->retainCount());
+    ASSERT_EQ(static_cast<size_t>(99), (*repeated)[99].getUInt64());
+
+    repeated = nullptr;
+    ASSERT_EQ(1, arena->retainCount());
+}
+
+TEST(MessageArena, allocatesInHeapOutsideOfScope) {
+    auto arena = makeShared<Protobuf::MessageArena>();
+    {
+        Protobuf::MessageArena::Scope scope(arena.get());
+        {
+            Protobuf::MessageArena::Scope heapScope(nullptr);
+            ASSERT_EQ(nullptr, Protobuf::MessageArena::current());
+            auto repeated = makeShared<Protobuf::RepeatedField>();
+            repeated->append(Protobuf::Field::varint(1));
+        }
+        ASSERT_EQ(arena.get(), Protobuf::MessageArena::current());
+    }
+
+    ASSERT_EQ(nullptr, Protobuf::MessageArena::current());
+    ASSERT_EQ(static_cast<size_t>(0), arena->getAllocatedBytes());
+}
+
+TEST(MessageArena, growsBlocks) {
+    auto arena = makeShared<Protobuf::MessageArena>();
+
+    for (size_t i = 0; i < 1000; i++) {
+        auto* ptr = arena->allocate(100);
+        ASSERT_EQ(static_cast<uintptr_t>(0), reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t));
+    }
+
+    // Blocks double in size, so 100KB should fit in a handful of them
+    ASSERT_TRUE(arena->getBlocksCount() < 8);
+}
+
+} // namespace
@@ -0,0 +1,112 @@
+#include "protogen/test.pb.h"
+#include "valdi_protobuf/Message.hpp"
+#include "valdi_protobuf/MessageStreamDecoder.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Valdi;
+namespace {
+
+Ref<ByteBuffer> makeFeed(size_t itemsCount) {
+    test::RepeatedMessage message;
+    message.add_int32(42);
+    for (size_t i = 0; i < itemsCount; i++) {
+        message.add_other_message()->set_value("Item " + std::to_string(i));
+    }
+    message.add_string("After items");
+
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(message.ByteSizeLong());
+    SC_ASSERT(message.SerializeToArray(buffer->data(), buffer->size()));
+    return buffer;
+}
+
+void checkDecodesInChunksOfSize(size_t chunkSize) {
+    auto buffer = makeFeed(32);
+
+    SimpleExceptionTracker exceptionTracker;
+    Protobuf::MessageStreamDecoder decoder(test::RepeatedMessage::GetDescriptor());
+
+    std::vector<std::string> items;
+    ASSERT_TRUE(decoder.setElementCallback(
+        18,
+        [&](const Ref<Protobuf::Message>& item) { items.emplace_back(item->getFieldAsString(1)); },
+        exceptionTracker));
+
+    for (size_t offset = 0; offset < buffer->size(); offset += chunkSize) {
+        auto length = std::min(chunkSize, buffer->size() - offset);
+        // Chunks without a source force the decoder to copy the bytes it keeps
+        ASSERT_TRUE(decoder.append(BytesView(nullptr, buffer->data() + offset, length), exceptionTracker))
+            << exceptionTracker.extractError();
+    }
+
+    auto message = decoder.finish(exceptionTracker);
+    ASSERT_TRUE(message != nullptr) << exceptionTracker.extractError();
+    ASSERT_TRUE(message->postprocess(true, exceptionTracker));
+
+    ASSERT_EQ(static_cast<size_t>(32), items.size());
+    ASSERT_EQ(static_cast<size_t>(32), decoder.getStreamedElementsCount());
+    for (size_t i = 0; i < items.size(); i++) {
+        ASSERT_EQ("Item " + std::to_string(i), items[i]);
+    }
+
+    // Streamed elements are not part of the final message
+    ASSERT_EQ(std::vector<Protobuf::FieldNumber>({1, 14}), message->sortedFieldNumbers());
+    ASSERT_EQ(42, message->getFieldIterator(1).begin()->getInt32());
+    ASSERT_EQ("After items", message->getFieldIterator(14).begin()->getRaw().toStringView());
+}
+
+TEST(MessageStreamDecoder, canDecodeInOneChunk) {
+    checkDecodesInChunksOfSize(1024 * 1024);
+}
+
+TEST(MessageStreamDecoder, canDecodeInSmallChunks) {
+    for (size_t chunkSize : {1, 2, 3, 7, 16}) {
+        checkDecodesInChunksOfSize(chunkSize);
+    }
+}
+
+TEST(MessageStreamDecoder, emitsElementsBeforeTheEndOfTheStream) {
+    auto buffer = makeFeed(4);
+
+    SimpleExceptionTracker exceptionTracker;
+    Protobuf::MessageStreamDecoder decoder(test::RepeatedMessage::GetDescriptor());
+
+    size_t itemsCount = 0;
+    ASSERT_TRUE(decoder.setElementCallback(
+        18, [&](const Ref<Protobuf::Message>& /*item*/) { itemsCount++; }, exceptionTracker));
+
+    auto bytes = buffer->toBytesView();
+    ASSERT_TRUE(decoder.append(bytes.subrange(0, bytes.size() / 2), exceptionTracker));
+    ASSERT_TRUE(itemsCount > 0);
+    ASSERT_TRUE(itemsCount < 4);
+
+    ASSERT_TRUE(decoder.append(bytes.subrange(bytes.size() / 2, bytes.size() - bytes.size() / 2), exceptionTracker));
+    ASSERT_EQ(static_cast<size_t>(4), itemsCount);
+
+    ASSERT_TRUE(decoder.finish(exceptionTracker) != nullptr);
+}
+
+TEST(MessageStreamDecoder, failsOnTruncatedMessage) {
+    auto buffer = makeFeed(4);
+
+    SimpleExceptionTracker exceptionTracker;
+    Protobuf::MessageStreamDecoder decoder(test::RepeatedMessage::GetDescriptor());
+
+    ASSERT_TRUE(decoder.append(BytesView(nullptr, buffer->data(), buffer->size() - 1), exceptionTracker));
+    ASSERT_TRUE(decoder.finish(exceptionTracker) == nullptr);
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+}
+
+TEST(MessageStreamDecoder, rejectsFieldsWhichAreNotRepeatedMessages) {
+    SimpleExceptionTracker exceptionTracker;
+    Protobuf::MessageStreamDecoder decoder(test::RepeatedMessage::GetDescriptor());
+
+    ASSERT_FALSE(decoder.setElementCallback(1, [](const Ref<Protobuf::Message>& /*item*/) {}, exceptionTracker));
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+}
+
+} // namespace
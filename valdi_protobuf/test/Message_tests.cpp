@@ -82,6 +82,33 @@ TEST(Message, canDecodeSingle) {
     ASSERT_EQ("<some bytes here>", parsedMessage->getOrCreateField(15).getRaw().toStringView());
 }
 
+TEST(Message, failsToDecodeTruncatedMessage) {
+    test::Message message;
+    message.set_int64(1337133713371337);
+    message.set_string("Hello World and Welcome!");
+
+    auto bytes = message.ByteSizeLong();
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(bytes);
+
+    ASSERT_TRUE(message.SerializeToArray(buffer->data(), buffer->size()));
+
+    // Cut in the middle of the string
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage =
+        Protobuf::Message::parse(buffer->toBytesView().subrange(0, bytes - 4), message.GetDescriptor(), exceptionTracker);
+    ASSERT_TRUE(parsedMessage == nullptr);
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+
+    // Cut in the middle of the varint
+    parsedMessage =
+        Protobuf::Message::parse(buffer->toBytesView().subrange(0, 3), message.GetDescriptor(), exceptionTracker);
+    ASSERT_TRUE(parsedMessage == nullptr);
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+}
+
 TEST(Message, canEncodeSingle) {
     auto message = makeShared<Protobuf::Message>();
 
@@ -176,6 +203,119 @@ TEST(Message, canDecodeNested) {
     ASSERT_EQ("Hello World!", parsedOtherMessage->getOrCreateField(1).getRaw().toStringView());
 }
 
+TEST(Message, canDecodeTreeInArena) {
+    test::RepeatedMessage message;
+    message.add_int32(10);
+    message.add_int32(20);
+    for (size_t i = 0; i < 16; i++) {
+        message.add_other_message()->set_value("Hello World!");
+    }
+
+    auto bytes = message.ByteSizeLong();
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(bytes);
+
+    ASSERT_TRUE(message.SerializeToArray(buffer->data(), buffer->size()));
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage =
+        Protobuf::Message::parseInArena(buffer->toBytesView(), message.GetDescriptor(), exceptionTracker);
+
+    ASSERT_TRUE(parsedMessage != nullptr);
+    ASSERT_TRUE(exceptionTracker);
+
+    auto arena = parsedMessage->getArena();
+    ASSERT_TRUE(arena != nullptr);
+
+    auto* repeated = parsedMessage->getOrCreateField(1).toVarintRepeated();
+    ASSERT_EQ(static_cast<size_t>(2), repeated->size());
+    ASSERT_EQ(20, (*repeated)[1].getInt32());
+
+    auto otherMessages = parsedMessage->getFieldIterator(18);
+    ASSERT_EQ(static_cast<size_t>(16), static_cast<size_t>(otherMessages.end() - otherMessages.begin()));
+    auto* otherMessage = otherMessages.begin()->getMessage();
+    ASSERT_TRUE(otherMessage != nullptr);
+    ASSERT_EQ(arena, otherMessage->getArena());
+    ASSERT_EQ("Hello World!", otherMessage->getFieldAsString(1));
+
+    // The arena is freed once the tree is gone
+    parsedMessage = nullptr;
+    ASSERT_EQ(1, arena->retainCount());
+}
+
+TEST(Message, canDecodeNestedLazily) {
+    test::RepeatedMessage message;
+    message.add_int32(42);
+    for (size_t i = 0; i < 4; i++) {
+        auto* selfMessage = message.add_self_message();
+        selfMessage->add_string("Header");
+        selfMessage->add_other_message()->set_value("Body");
+    }
+
+    auto bytes = message.ByteSizeLong();
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(bytes);
+
+    ASSERT_TRUE(message.SerializeToArray(buffer->data(), buffer->size()));
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage = Protobuf::Message::parse(buffer->toBytesView(), message.GetDescriptor(), exceptionTracker);
+
+    ASSERT_TRUE(parsedMessage != nullptr);
+    ASSERT_TRUE(parsedMessage->postprocessLazily(exceptionTracker));
+
+    // Nested messages are kept as raw bytes until accessed
+    auto selfMessages = parsedMessage->getFieldIterator(17);
+    ASSERT_EQ(static_cast<size_t>(4), static_cast<size_t>(selfMessages.end() - selfMessages.begin()));
+    ASSERT_EQ(Protobuf::Field::InternalType::Raw, selfMessages.begin()->getInternalType());
+
+    auto* selfMessage = parsedMessage->getMessageAt(17, 2, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+    ASSERT_TRUE(selfMessage != nullptr);
+    ASSERT_EQ(selfMessage, parsedMessage->getMessageAt(17, 2, exceptionTracker));
+    ASSERT_EQ("Header", selfMessage->getFieldIterator(14).begin()->getRaw().toStringView());
+
+    ASSERT_EQ(Protobuf::Field::InternalType::Raw, selfMessages.begin()->getInternalType());
+    ASSERT_EQ(Protobuf::Field::InternalType::Raw, selfMessage->getFieldIterator(18).begin()->getInternalType());
+
+    auto* otherMessage = selfMessage->getMessageAt(18, 0, exceptionTracker);
+    ASSERT_TRUE(otherMessage != nullptr);
+    ASSERT_EQ("Body", otherMessage->getFieldAsString(1));
+
+    ASSERT_TRUE(parsedMessage->getMessageAt(17, 4, exceptionTracker) == nullptr);
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+}
+
+TEST(Message, reencodesUntouchedLazyMessagesAsIs) {
+    test::Message message;
+    message.set_int32(42);
+    message.mutable_other_message()->set_value("Hello World!");
+    message.mutable_self_message()->set_string("Nested");
+    message.mutable_self_message()->mutable_other_message()->set_value("Deeply nested");
+
+    auto bytes = message.ByteSizeLong();
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(bytes);
+
+    ASSERT_TRUE(message.SerializeToArray(buffer->data(), buffer->size()));
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage = Protobuf::Message::parse(buffer->toBytesView(), message.GetDescriptor(), exceptionTracker);
+
+    ASSERT_TRUE(parsedMessage != nullptr);
+    ASSERT_TRUE(parsedMessage->postprocessLazily(exceptionTracker));
+
+    auto* otherMessage = parsedMessage->getMessage(18, exceptionTracker);
+    ASSERT_TRUE(otherMessage != nullptr);
+    ASSERT_EQ("Hello World!", otherMessage->getFieldAsString(1));
+    ASSERT_EQ(Protobuf::Field::InternalType::Raw, parsedMessage->getOrCreateField(17).getInternalType());
+
+    auto encoded = parsedMessage->encode();
+
+    ASSERT_EQ(buffer->toBytesView(), encoded);
+}
+
 TEST(Message, canEncodeNested) {
     auto message = makeShared<Protobuf::Message>();
     message->getOrCreateField(1).setInt32(42);
@@ -241,6 +381,37 @@ TEST(Message, encodesEmptyNestedMessage) {
     ASSERT_EQ(result.asStringView(), std::string_view(emptyMessageEncoded));
 }
 
+TEST(Message, canEncodeLargeNestedMessages) {
+    test::RepeatedMessage expectedMessage;
+    for (int32_t i = 0; i < 1000; i++) {
+        expectedMessage.add_int32(i * 1000);
+    }
+    // Nested messages with length prefixes of 1, 2 and 3 bytes
+    for (size_t length : {10, 200, 20000}) {
+        auto* child = expectedMessage.add_self_message();
+        child->add_string(std::string(length, 'a'));
+        child->add_self_message()->add_bytes(std::string(length, 'b'));
+        child->add_other_message()->set_value("Hello World");
+    }
+    auto expectedEncoded = expectedMessage.SerializeAsString();
+
+    SimpleExceptionTracker exceptionTracker;
+    auto bytes = makeShared<ByteBuffer>(expectedEncoded);
+    auto message = Protobuf::Message::parse(bytes->toBytesView(), test::RepeatedMessage::GetDescriptor(), exceptionTracker);
+    ASSERT_TRUE(message != nullptr);
+    ASSERT_TRUE(message->postprocess(true, exceptionTracker));
+
+    auto result = message->encode();
+    ASSERT_EQ(std::string_view(expectedEncoded), result.asStringView());
+    ASSERT_EQ(result.size(), message->getCachedEncodedByteSize());
+
+    // Encoding through the byte size pass produces the same output
+    ByteBuffer output;
+    output.resize(message->encodedByteSize());
+    ASSERT_EQ(output.end(), message->encode(false, output.begin(), output.end()));
+    ASSERT_EQ(std::string_view(expectedEncoded), output.toStringView());
+}
+
 TEST(Message, canEncodeRepeated) {
     auto message = makeShared<Protobuf::Message>();
 
@@ -294,6 +465,32 @@ TEST(Message, canDecodeRepeated) {
     ASSERT_EQ(30, (*repeated)[2].getInt32());
 }
 
+TEST(Message, canDecodeUnpackedAndSplitRepeated) {
+    // int32 = 1 as unpacked entries interleaved with int64 = 2, followed by two packed chunks of int32
+    std::vector<Byte> data = {0x08, 0x01, 0x08, 0x02, 0x10, 0x2a, 0x08, 0x03, 0x0a, 0x02, 0x04, 0x05, 0x0a, 0x01, 0x06};
+
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->set(data.data(), data.data() + data.size());
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage =
+        Protobuf::Message::parse(buffer->toBytesView(), test::RepeatedMessage::GetDescriptor(), exceptionTracker);
+
+    ASSERT_TRUE(parsedMessage != nullptr);
+    ASSERT_TRUE(parsedMessage->postprocess(true, exceptionTracker));
+
+    auto* repeated = parsedMessage->getOrCreateField(1).toVarintRepeated();
+
+    ASSERT_EQ(static_cast<size_t>(6), repeated->size());
+    for (size_t i = 0; i < repeated->size(); i++) {
+        ASSERT_EQ(static_cast<int32_t>(i + 1), (*repeated)[i].getInt32());
+    }
+
+    auto* otherRepeated = parsedMessage->getOrCreateField(2).toVarintRepeated();
+    ASSERT_EQ(static_cast<size_t>(1), otherRepeated->size());
+    ASSERT_EQ(42, (*otherRepeated)[0].getInt64());
+}
+
 TEST(Message, serializesOneOfFieldEvenWithDefaultValue) {
     test::OneOfMessage message;
 
@@ -426,4 +623,180 @@ TEST(Message, canParseFromJSON) {
     ASSERT_EQ(true, message->getOrCreateField(13).getBool());
 }
 
+TEST(Message, reportsErrorsWhenParsingInvalidJSON) {
+    test::Message messagePrototype;
+
+    auto result = Protobuf::Message::parseFromJSON("{\"unknownField\":42}", messagePrototype.GetDescriptor());
+    ASSERT_FALSE(result);
+
+    result = Protobuf::Message::parseFromJSON("{\"int32\":", messagePrototype.GetDescriptor());
+    ASSERT_FALSE(result);
+}
+
+Ref<Protobuf::Message> parseLazily(const google::protobuf::Message& message, ExceptionTracker& exceptionTracker) {
+    auto buffer = makeShared<ByteBuffer>();
+    buffer->resize(message.ByteSizeLong());
+    SC_ASSERT(message.SerializeToArray(buffer->data(), static_cast<int>(buffer->size())));
+
+    auto parsedMessage = Protobuf::Message::parse(buffer->toBytesView(), message.GetDescriptor(), exceptionTracker);
+    if (parsedMessage == nullptr || !parsedMessage->postprocessLazily(exceptionTracker)) {
+        return nullptr;
+    }
+    return parsedMessage;
+}
+
+template<typename T>
+T decodeAs(Protobuf::Message& message) {
+    auto encoded = message.encode();
+    T output;
+    SC_ASSERT(output.ParseFromArray(encoded.data(), static_cast<int>(encoded.size())));
+    return output;
+}
+
+TEST(Message, canDiffMessages) {
+    test::Message message;
+    message.set_int32(1);
+    message.set_string("a");
+    message.mutable_other_message()->set_value("nested");
+
+    test::Message otherMessage = message;
+    otherMessage.set_string("b");
+    otherMessage.set_double_(0.0);
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage = parseLazily(message, exceptionTracker);
+    auto parsedOtherMessage = parseLazily(otherMessage, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+
+    ASSERT_EQ(std::vector<Protobuf::FieldNumber>({14}), parsedMessage->diff(*parsedOtherMessage));
+    ASSERT_FALSE(parsedMessage->isEqual(*parsedOtherMessage));
+    ASSERT_TRUE(parsedMessage->isEqual(*parsedMessage));
+
+    otherMessage.set_string("a");
+    otherMessage.mutable_other_message()->set_value("changed");
+    otherMessage.set_enum_(test::VALUE_1);
+    parsedOtherMessage = parseLazily(otherMessage, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+
+    // Nested messages are compared whether they are decoded or not
+    ASSERT_EQ(std::vector<Protobuf::FieldNumber>({16, 18}), parsedMessage->diff(*parsedOtherMessage));
+    ASSERT_TRUE(parsedMessage->getMessage(18, exceptionTracker) != nullptr);
+    ASSERT_EQ(std::vector<Protobuf::FieldNumber>({16, 18}), parsedMessage->diff(*parsedOtherMessage));
+    ASSERT_TRUE(parsedOtherMessage->getMessage(18, exceptionTracker) != nullptr);
+    ASSERT_EQ(std::vector<Protobuf::FieldNumber>({16, 18}), parsedMessage->diff(*parsedOtherMessage));
+    ASSERT_TRUE(exceptionTracker);
+}
+
+TEST(Message, sharesUnchangedNestedMessages) {
+    test::Message message;
+    message.set_int32(1);
+    message.mutable_self_message()->set_int32(2);
+    message.mutable_self_message()->mutable_other_message()->set_value("deep");
+    message.mutable_other_message()->set_value("nested");
+
+    test::Message nextMessage = message;
+    nextMessage.mutable_self_message()->set_int32(3);
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage = parseLazily(message, exceptionTracker);
+    auto parsedNextMessage = parseLazily(nextMessage, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+    ASSERT_TRUE(parsedMessage->postprocess(true, exceptionTracker));
+    ASSERT_TRUE(parsedNextMessage->postprocess(true, exceptionTracker));
+
+    auto* selfMessage = parsedMessage->getMessage(17, exceptionTracker);
+    auto* otherMessage = parsedMessage->getMessage(18, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+
+    ASSERT_EQ(std::vector<Protobuf::FieldNumber>({17}), parsedNextMessage->shareUnchangedMessages(*parsedMessage));
+
+    ASSERT_EQ(otherMessage, parsedNextMessage->getMessage(18, exceptionTracker));
+    auto* nextSelfMessage = parsedNextMessage->getMessage(17, exceptionTracker);
+    ASSERT_NE(selfMessage, nextSelfMessage);
+    ASSERT_EQ(selfMessage->getMessage(18, exceptionTracker), nextSelfMessage->getMessage(18, exceptionTracker));
+    ASSERT_TRUE(exceptionTracker);
+
+    ASSERT_EQ(nextMessage.SerializeAsString(), decodeAs<test::Message>(*parsedNextMessage).SerializeAsString());
+    ASSERT_TRUE(parsedNextMessage->shareUnchangedMessages(*parsedNextMessage).empty());
+}
+
+TEST(Message, canApplyPatch) {
+    test::Message message;
+    message.set_int32(1);
+    message.set_string("value");
+    message.mutable_self_message()->set_int32(2);
+    message.mutable_self_message()->set_string("kept");
+
+    test::Message patch;
+    patch.set_int32(3);
+    patch.set_bytes("patched");
+    patch.mutable_self_message()->set_int32(4);
+    patch.mutable_self_message()->set_string("ignored");
+    patch.mutable_other_message()->set_value("created");
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage = parseLazily(message, exceptionTracker);
+    auto parsedPatch = parseLazily(patch, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+
+    Ref<Protobuf::Message> selfMessage(parsedMessage->getMessage(17, exceptionTracker));
+    ASSERT_TRUE(selfMessage != nullptr);
+
+    ASSERT_TRUE(parsedMessage->applyPatch(
+        *parsedPatch, {"int32", "string", "bytes", "self_message.int32", "other_message.value"}, exceptionTracker));
+    ASSERT_TRUE(exceptionTracker);
+    parsedPatch = nullptr;
+
+    test::Message expectedMessage;
+    expectedMessage.set_int32(3);
+    expectedMessage.set_bytes("patched");
+    expectedMessage.mutable_self_message()->set_int32(4);
+    expectedMessage.mutable_self_message()->set_string("kept");
+    expectedMessage.mutable_other_message()->set_value("created");
+
+    ASSERT_EQ(expectedMessage.SerializeAsString(), decodeAs<test::Message>(*parsedMessage).SerializeAsString());
+
+    // The nested message along the path was copied before being patched
+    ASSERT_EQ(2, selfMessage->getOrCreateField(1).getInt32());
+}
+
+TEST(Message, clearsOtherOneOfFieldsWhenApplyingPatch) {
+    test::OneOfMessage message;
+    message.set_string_0("value");
+    message.mutable_message_0()->set_value("nested");
+
+    test::OneOfMessage patch;
+    patch.set_string_1("");
+    patch.mutable_message_1();
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage = parseLazily(message, exceptionTracker);
+    auto parsedPatch = parseLazily(patch, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+
+    ASSERT_TRUE(parsedMessage->applyPatch(*parsedPatch, {"string_1", "message_1.value"}, exceptionTracker));
+    ASSERT_TRUE(exceptionTracker);
+
+    auto output = decodeAs<test::OneOfMessage>(*parsedMessage);
+    ASSERT_EQ(test::OneOfMessage::kString1, output.strings_case());
+    ASSERT_EQ(test::OneOfMessage::kMessage1, output.messages_case());
+}
+
+TEST(Message, failsToApplyPatchWithInvalidPath) {
+    test::Message message;
+    message.set_int32(1);
+
+    SimpleExceptionTracker exceptionTracker;
+    auto parsedMessage = parseLazily(message, exceptionTracker);
+    ASSERT_TRUE(exceptionTracker);
+
+    ASSERT_FALSE(parsedMessage->applyPatch(*parsedMessage, {"unknown"}, exceptionTracker));
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+
+    ASSERT_FALSE(parsedMessage->applyPatch(*parsedMessage, {"int32.value"}, exceptionTracker));
+    ASSERT_FALSE(exceptionTracker);
+    exceptionTracker.clearError();
+}
+
 } // namespace
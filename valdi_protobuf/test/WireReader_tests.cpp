@@ -0,0 +1,101 @@
+#include "valdi_protobuf/WireReader.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Valdi;
+namespace {
+
+std::vector<Byte> encodeVarint(uint64_t value) {
+    std::vector<Byte> output;
+    do {
+        auto byte = static_cast<Byte>(value & 0x7f);
+        value >>= 7;
+        if (value != 0) {
+            byte |= 0x80;
+        }
+        output.emplace_back(byte);
+    } while (value != 0);
+    return output;
+}
+
+TEST(WireReader, canReadVarintsOfAllLengths) {
+    for (size_t shift = 0; shift < 64; shift++) {
+        auto value = (static_cast<uint64_t>(1) << shift) | 1;
+        auto encoded = encodeVarint(value);
+        auto encodedLength = encoded.size();
+
+        // Read with and without enough trailing bytes for the word at a time path
+        for (size_t padding : {0, 16}) {
+            auto data = encoded;
+            data.resize(encodedLength + padding, 0xff);
+
+            Protobuf::WireReader reader(data.data(), data.size());
+            uint64_t output = 0;
+            ASSERT_TRUE(reader.readVarint64(&output));
+            ASSERT_EQ(value, output);
+            ASSERT_EQ(encodedLength, reader.position());
+        }
+    }
+}
+
+TEST(WireReader, canReadMultipleValues) {
+    std::vector<Byte> data = encodeVarint(300);
+    auto second = encodeVarint(UINT64_MAX);
+    data.insert(data.end(), second.begin(), second.end());
+    data.insert(data.end(), {0x01, 0x02, 0x03, 0x04});
+
+    Protobuf::WireReader reader(data.data(), data.size());
+    uint32_t varint32 = 0;
+    uint64_t varint64 = 0;
+    uint32_t fixed32 = 0;
+
+    ASSERT_TRUE(reader.readVarint32(&varint32));
+    ASSERT_EQ(static_cast<uint32_t>(300), varint32);
+    ASSERT_TRUE(reader.readVarint64(&varint64));
+    ASSERT_EQ(UINT64_MAX, varint64);
+    ASSERT_TRUE(reader.readLittleEndian32(&fixed32));
+    ASSERT_EQ(static_cast<uint32_t>(0x04030201), fixed32);
+    ASSERT_TRUE(reader.isAtEnd());
+    ASSERT_EQ(static_cast<uint32_t>(0), reader.readTag());
+}
+
+TEST(WireReader, canCountVarints) {
+    std::vector<Byte> data;
+    size_t count = 0;
+    for (size_t shift = 0; shift < 64; shift += 3) {
+        auto encoded = encodeVarint(static_cast<uint64_t>(1) << shift);
+        data.insert(data.end(), encoded.begin(), encoded.end());
+        count++;
+
+        ASSERT_EQ(count, Protobuf::WireReader::countVarints(data.data(), data.size()));
+    }
+
+    // Bytes of an unterminated varint are not counted
+    data.emplace_back(0x80);
+    ASSERT_EQ(count, Protobuf::WireReader::countVarints(data.data(), data.size()));
+}
+
+TEST(WireReader, failsOnTruncatedValues) {
+    std::vector<Byte> data = {0x80, 0x80, 0x80};
+    Protobuf::WireReader reader(data.data(), data.size());
+    uint64_t varint = 0;
+
+    ASSERT_FALSE(reader.readVarint64(&varint));
+    ASSERT_EQ(static_cast<size_t>(0), reader.position());
+
+    uint64_t fixed64 = 0;
+    ASSERT_FALSE(reader.readLittleEndian64(&fixed64));
+    ASSERT_FALSE(reader.skip(4));
+    ASSERT_TRUE(reader.skip(3));
+}
+
+TEST(WireReader, failsOnOverlongVarint) {
+    std::vector<Byte> data(16, 0x80);
+    Protobuf::WireReader reader(data.data(), data.size());
+    uint64_t varint = 0;
+
+    ASSERT_FALSE(reader.readVarint64(&varint));
+}
+
+} // namespace
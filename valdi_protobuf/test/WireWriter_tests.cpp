@@ -0,0 +1,74 @@
+#include "valdi_protobuf/WireReader.hpp"
+#include "valdi_protobuf/WireWriter.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Valdi;
+namespace {
+
+TEST(WireWriter, canWriteVarintsOfAllLengths) {
+    for (size_t shift = 0; shift < 64; shift++) {
+        auto value = (static_cast<uint64_t>(1) << shift) | 1;
+
+        ByteBuffer buffer;
+        Protobuf::WireWriter writer(buffer);
+        writer.writeVarint(value);
+
+        ASSERT_EQ(shift / 7 + 1, buffer.size());
+        ASSERT_EQ(buffer.size(), Protobuf::WireWriter::varintSize(value));
+
+        Protobuf::WireReader reader(buffer.data(), buffer.size());
+        uint64_t output = 0;
+        ASSERT_TRUE(reader.readVarint64(&output));
+        ASSERT_EQ(value, output);
+        ASSERT_TRUE(reader.isAtEnd());
+    }
+}
+
+TEST(WireWriter, canWriteTagsOfAnyWireType) {
+    for (Protobuf::FieldNumber fieldNumber : {1, 15, 16, 2047, 2048, 536870911}) {
+        auto tag = Protobuf::WireWriter::encodeTag(fieldNumber);
+        for (uint32_t wireType = 0; wireType < 6; wireType++) {
+            ByteBuffer buffer;
+            Protobuf::WireWriter writer(buffer);
+            writer.writeTag(tag, wireType);
+
+            Protobuf::WireReader reader(buffer.data(), buffer.size());
+            ASSERT_EQ(static_cast<uint32_t>(fieldNumber << 3) | wireType, reader.readTag());
+            ASSERT_TRUE(reader.isAtEnd());
+        }
+    }
+}
+
+TEST(WireWriter, patchesLengthPrefixes) {
+    for (size_t length : {0, 1, 127, 128, 16383, 16384, 100000}) {
+        ByteBuffer buffer;
+        Protobuf::WireWriter writer(buffer);
+        writer.writeFixed32(0x04030201);
+
+        auto prefixPosition = writer.beginLengthDelimited();
+        for (size_t i = 0; i < length; i++) {
+            writer.writeVarint(i % 128);
+        }
+        writer.endLengthDelimited(prefixPosition);
+        writer.writeFixed32(0x08070605);
+
+        Protobuf::WireReader reader(buffer.data(), buffer.size());
+        uint32_t fixed32 = 0;
+        uint32_t outputLength = 0;
+        ASSERT_TRUE(reader.readLittleEndian32(&fixed32));
+        ASSERT_TRUE(reader.readVarint32(&outputLength));
+        ASSERT_EQ(length, static_cast<size_t>(outputLength));
+        for (size_t i = 0; i < length; i++) {
+            uint64_t value = 0;
+            ASSERT_TRUE(reader.readVarint64(&value));
+            ASSERT_EQ(i % 128, value);
+        }
+        ASSERT_TRUE(reader.readLittleEndian32(&fixed32));
+        ASSERT_EQ(static_cast<uint32_t>(0x08070605), fixed32);
+        ASSERT_TRUE(reader.isAtEnd());
+    }
+}
+
+} // namespace